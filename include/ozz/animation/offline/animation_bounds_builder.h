@@ -0,0 +1,83 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_OFFLINE_ANIMATION_BOUNDS_BUILDER_H_
+#define OZZ_OZZ_ANIMATION_OFFLINE_ANIMATION_BOUNDS_BUILDER_H_
+
+#include "ozz/animation/offline/export.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+namespace ozz {
+namespace animation {
+
+// Forward declares the runtime bounds and skeleton types.
+class AnimationBounds;
+class Skeleton;
+
+namespace offline {
+
+// Forward declare offline animation type.
+struct RawAnimation;
+
+// Defines the class responsible for building runtime AnimationBounds objects,
+// the time-bucketed model-space bounding boxes used to cull animated
+// characters. The clip timeline is split in num_intervals equal buckets. Each
+// bucket box is computed by sampling the raw animation at sample_rate
+// (boundary times of the bucket included), composing model-space joint
+// positions up the skeleton hierarchy, and merging them. Boxes enclose joint
+// positions only: the margin parameter uniformly expands them to account for
+// the mesh extent around bones (and for joints moving between two samples).
+class OZZ_ANIMOFFLINE_DLL AnimationBoundsBuilder {
+ public:
+  // Initializes the builder.
+  AnimationBoundsBuilder();
+
+  // Creates an AnimationBounds based on _animation and *this builder
+  // parameters. _skeleton provides the hierarchy used to compute model-space
+  // joint positions, and must match _animation tracks.
+  // Returns a valid AnimationBounds on success, nullptr otherwise:
+  // - if _animation is invalid, or its tracks don't match _skeleton joints,
+  // or _skeleton is empty.
+  // - if num_intervals isn't positive, sample_rate isn't positive, or margin
+  // is negative.
+  unique_ptr<AnimationBounds> operator()(const Skeleton& _skeleton,
+                                         const RawAnimation& _animation) const;
+
+  // Number of time buckets the clip timeline is split in. More intervals
+  // follow the animation tighter but grow the serialized size linearly.
+  int num_intervals;
+
+  // Rate (Hz) at which the animation is sampled within each bucket.
+  float sample_rate;
+
+  // Distance added to every side of the computed boxes.
+  float margin;
+};
+}  // namespace offline
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_OFFLINE_ANIMATION_BOUNDS_BUILDER_H_
@@ -29,9 +29,17 @@
 #define OZZ_OZZ_ANIMATION_OFFLINE_ANIMATION_BUILDER_H_
 
 #include "ozz/animation/offline/export.h"
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/base/containers/string.h"
+#include "ozz/base/containers/vector.h"
 #include "ozz/base/memory/unique_ptr.h"
+#include "ozz/base/span.h"
 
 namespace ozz {
+
+// Forward declares the scheduler interface.
+class Scheduler;
+
 namespace animation {
 
 // Forward declares the runtime animation type.
@@ -39,9 +47,6 @@ class Animation;
 
 namespace offline {
 
-// Forward declares the offline animation type.
-struct RawAnimation;
-
 // Defines the class responsible of building runtime animation instances from
 // offline raw animations.
 // No optimization at all is performed on the raw animation.
@@ -54,6 +59,41 @@ class OZZ_ANIMOFFLINE_DLL AnimationBuilder {
   // the caller.
   unique_ptr<Animation> operator()(const RawAnimation& _raw_animation) const;
 
+  // Builds a batch of animations, dispatching _raw_animations across
+  // _num_threads worker threads (hardware concurrency if 0). Each animation
+  // is built as per single input operator(). The returned vector matches
+  // _raw_animations size and order, entries that failed to build are nullptr.
+  ozz::vector<unique_ptr<Animation>> operator()(
+      const span<const RawAnimation>& _raw_animations,
+      size_t _num_threads = 0) const;
+
+  // Provides raw tracks to the streaming build path, one at a time. This
+  // allows the caller (an importer typically) to materialize a single track
+  // worth of raw keyframes at a time, bounding peak memory to one track plus
+  // the compact sorting buffers, rather than a whole RawAnimation.
+  class OZZ_ANIMOFFLINE_DLL TrackProvider {
+   public:
+    virtual ~TrackProvider() {}
+
+    // Fills _track with the keyframes of track _track_index. _track is given
+    // emptied, and must be valid for the animation duration once filled, see
+    // RawAnimation::JointTrack::Validate. Called once per track, in order.
+    // Returns false to abort the build.
+    virtual bool GetTrack(int _track_index,
+                          RawAnimation::JointTrack* _track) = 0;
+  };
+
+  // Streaming variant of the single RawAnimation operator(). Builds an
+  // animation named _name, of duration _duration (seconds) and _num_tracks
+  // tracks, pulling each track from _provider instead of a fully
+  // materialized RawAnimation. Tracks are consumed (validated, filtered and
+  // sorted) as they are provided. Returns a valid Animation on success, or
+  // nullptr if an argument is invalid, if _provider aborted, or if a
+  // provided track failed validation.
+  unique_ptr<Animation> operator()(const char* _name, float _duration,
+                                   int _num_tracks,
+                                   TrackProvider* _provider) const;
+
   // IFrames allow the sampler to instantly seek to a point in time in the
   // animation. If no iframe is available, the sampler needs to read
   // sequentially forward or backward to reach a point. So that's useful for
@@ -61,7 +101,76 @@ class OZZ_ANIMOFFLINE_DLL AnimationBuilder {
   // the end. A 0 interval means no iframe is generated. Any positive number is
   // the interval between iframes, with a guaranted one at the end of the
   // animation if interval is bigger than animation duration.
+  // With iframes, the cost of a random seek is bounded by the number of
+  // keyframes within an interval (the sampler restores the closest iframe and
+  // catches up from there), instead of growing with the distance to the
+  // previously sampled time. This matters for random access patterns like
+  // replays or rollback, at the price of a bigger animation memory footprint.
   float iframe_interval = 0.f;
+
+  // Deduplicates keyframes. A key whose value strictly equals both its
+  // neighbours' is dropped, as interpolating between equal values is
+  // constant. This collapses constant tracks (rest-pose identical tracks
+  // typically, which DCC exporters commonly sample at full rate) to the 2
+  // mandatory boundary keys, reducing both animation size and sampling cost.
+  // Sampled values are unchanged, contrary to AnimationOptimizer which trades
+  // precision (within tolerances) for size. Disabled by default as this
+  // builder otherwise performs no optimization at all.
+  bool deduplicate = false;
+
+  // Enforces loop-safe clips: the key at t = duration of every track and
+  // component is forced to the value of the key at t = 0 (boundary keys are
+  // added by the builder anyway when raw tracks miss them). Sampling then
+  // lands on the exact same pose on both sides of the loop seam, so wrapping
+  // playback doesn't pop nor require a seam crossfade. Whether enforced here
+  // or already present in raw tracks, loop safety is detected and recorded
+  // on the built animation, see Animation::looping(). Disabled by default as
+  // it alters sampled values near the seam of non looping raw clips.
+  bool enforce_loop = false;
+
+  // Sampling density profile, used to pack keyframes for the access pattern
+  // production actually exhibits instead of the assumed full-clip playback.
+  // Each entry is the relative sampling density of a uniform ratio bucket
+  // (entry i of n covers ratio range [i/n, (i+1)/n]), as captured from
+  // production telemetry (see SamplingJob::Context statistics). Buckets
+  // reaching half of the peak density are considered hot. Keyframe intervals
+  // that are active within a hot range but extend more than a bucket past its
+  // end are split at the range end, with an interpolated key (the same
+  // injection mechanism used to bound previous-key offsets, so sampled values
+  // are preserved within compression precision). The working set of keys the
+  // sampler holds while playing a hot range then stays contiguous in memory,
+  // instead of spanning up to the whole key buffer through long-lived keys,
+  // at the price of one extra key per crossing track per hot range.
+  // Empty (default) disables profile-guided packing. Negative or non-finite
+  // densities fail the build.
+  ozz::vector<float> sampling_profile;
+
+  // Rig signature stamped on built animations, see Animation::rig(). The
+  // signature names the skeleton convention (joint set and ordering) the
+  // animation tracks are built for, so that runtime code can match animations
+  // and skeletons sharing a convention, and permute tracks
+  // (Animation::PermuteTracks) when orderings differ. Empty (default) stamps
+  // no signature.
+  ozz::string rig_signature;
+
+  // Scheduler used to parallelize the build of a single animation: raw
+  // animation validation is dispatched per track, and keyframe sorting uses a
+  // parallel merge sort, so build time of one huge clip scales with cores.
+  // The output animation is strictly identical to a serial build. nullptr
+  // (default) keeps the build single threaded. Note that this is orthogonal
+  // to the batch operator() below, which parallelizes across animations.
+  Scheduler* scheduler = nullptr;
+
+ private:
+  // Sorting keys gathered by the build paths, defined internally.
+  struct SortingKeys;
+
+  // Finishes a build from gathered sorting keys, shared by the RawAnimation
+  // and the streaming build paths. _looping is the loop safety detected
+  // while gathering keys, recorded on the built animation.
+  unique_ptr<Animation> Build(const char* _name, float _duration,
+                              uint16_t _num_tracks, SortingKeys& _keys,
+                              bool _looping) const;
 };
 }  // namespace offline
 }  // namespace animation
@@ -0,0 +1,73 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_OFFLINE_ANIMATION_JOINT_FILTER_H_
+#define OZZ_OZZ_ANIMATION_OFFLINE_ANIMATION_JOINT_FILTER_H_
+
+#include "ozz/animation/offline/export.h"
+#include "ozz/base/containers/vector.h"
+
+namespace ozz {
+namespace animation {
+namespace offline {
+
+// Forward declare offline animation type.
+struct RawAnimation;
+
+// Filters a raw animation down to a subset of its joints. Tracks of joints
+// that are not part of the subset are collapsed to a single key (their first
+// key's value), which the runtime builder stores as a constant track of 2
+// boundary keys, whatever the number of keys the source track had. The
+// output animation keeps the input's duration and track count, so it stays
+// compatible with the same skeleton and can be sampled, blended... exactly
+// like the unfiltered one.
+// This is the way to produce stripped animation assets for consumers that
+// only need a few joints (a headless game server needing root and hit
+// reaction joints typically): both the serialized animation and its runtime
+// memory footprint shrink roughly to the kept joints' share of the keys.
+// Filtering is performed offline as the runtime animation format is a single
+// time-sorted compressed key stream, which cannot be partially loaded
+// per joint.
+class OZZ_ANIMOFFLINE_DLL AnimationJointFilter {
+ public:
+  // Filters _input using *this parameters. Returns true on success and fills
+  // _output animation with the filtered version of _input animation.
+  // *_output must be a valid RawAnimation instance.
+  // Returns false on failure: invalid _input animation, or a joint index out
+  // of _input tracks range. See RawAnimation::Validate() for more details
+  // about failure reasons.
+  bool operator()(const RawAnimation& _input, RawAnimation* _output) const;
+
+  // Indices of the joints (tracks) whose keys are kept. Order doesn't matter
+  // and duplicates are allowed. Tracks of all other joints are collapsed to a
+  // constant first-key value.
+  ozz::vector<int> joints;
+};
+}  // namespace offline
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_OFFLINE_ANIMATION_JOINT_FILTER_H_
@@ -0,0 +1,91 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_OFFLINE_ANIMATION_LOD_BUILDER_H_
+#define OZZ_OZZ_ANIMATION_OFFLINE_ANIMATION_LOD_BUILDER_H_
+
+#include "ozz/animation/offline/animation_builder.h"
+#include "ozz/animation/offline/animation_optimizer.h"
+#include "ozz/animation/offline/export.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+namespace ozz {
+namespace animation {
+
+// Forward declare runtime types.
+class Animation;
+class Skeleton;
+
+namespace offline {
+
+// Forward declare offline animation type.
+struct RawAnimation;
+
+// Builds mip-style temporal levels of detail for an animation: a set of
+// runtime animations sharing duration and tracks, each level decimating the
+// keyframes of the previous one with AnimationOptimizer tolerances of its
+// own. Resolutions are hence nested, from the full-resolution input (level 0)
+// down to the coarsest level. Distant characters can sample a coarse level
+// and touch a fraction of the key data, while close-ups keep full temporal
+// resolution. This is orthogonal to joint based lod (see
+// AnimationJointFilter): key density is reduced over time, not joint count.
+// Levels are selected at runtime with AnimationLod, see animation_lod.h.
+class OZZ_ANIMOFFLINE_DLL AnimationLodBuilder {
+ public:
+  // Initializes the builder with default levels: two decimated levels at 4x
+  // and 16x the default optimizer tolerance, for 3 resolutions in total.
+  AnimationLodBuilder();
+
+  // Builds one runtime animation per resolution, coarsest last, from
+  // _raw_animation and *this builder parameters. _skeleton is required by the
+  // optimizer to evaluate decimation error along the joint hierarchy.
+  // Returns levels.size() + 1 animations on success (level 0 plus one per
+  // levels entry), or an empty vector if _raw_animation fails validation or
+  // if any level fails to build.
+  ozz::vector<unique_ptr<Animation>> operator()(
+      const RawAnimation& _raw_animation, const Skeleton& _skeleton) const;
+
+  // Optimizer settings of each decimated level, finest first. Level 0 is
+  // always built from the input as-is and isn't listed here. Each entry
+  // decimates the output of the previous level, so tolerances should grow
+  // with the level index for levels to actually shed keyframes.
+  ozz::vector<AnimationOptimizer::Setting> levels;
+
+  // Per joint overrides of optimization settings, shared by all levels. Same
+  // semantic as AnimationOptimizer::joints_setting_override, allowing chains
+  // (hands, head...) to keep precision across every level.
+  AnimationOptimizer::JointsSetting joints_setting_override;
+
+  // The builder used to compile every level to its runtime format. Its
+  // settings (iframe_interval...) apply to all levels.
+  AnimationBuilder builder;
+};
+}  // namespace offline
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_OFFLINE_ANIMATION_LOD_BUILDER_H_
@@ -28,6 +28,8 @@
 #ifndef OZZ_OZZ_ANIMATION_OFFLINE_ANIMATION_OPTIMIZER_H_
 #define OZZ_OZZ_ANIMATION_OFFLINE_ANIMATION_OPTIMIZER_H_
 
+#include <cstddef>
+
 #include "ozz/animation/offline/export.h"
 #include "ozz/base/containers/map.h"
 
@@ -70,6 +72,26 @@ class OZZ_ANIMOFFLINE_DLL AnimationOptimizer {
   bool operator()(const RawAnimation& _input, const Skeleton& _skeleton,
                   RawAnimation* _output) const;
 
+  // Tolerance search mode. Optimizes _input so the total number of keyframes
+  // (translation, rotation and scale keys summed over all tracks) doesn't
+  // exceed _max_keyframes, using the smallest (hence best quality) tolerances
+  // that honor the budget. The search bisects a single scale factor applied
+  // to *this settings tolerances (joint overrides included), preserving the
+  // relative importance of each joint. Hierarchy analysis and keyframe
+  // decimation order are computed once and shared by all search iterations,
+  // so an internal search costs barely more than a single optimization pass,
+  // where an external tuning loop pays the full cost per probed tolerance.
+  // If the budget is smaller than what full decimation can reach (2 keyframes
+  // per animated track), the animation is decimated as much as possible and
+  // the function still succeeds.
+  // If _factor isn't nullptr, *_factor is set to the selected scale factor.
+  // Tuning pipelines can serialize it and apply it back to tolerances on a
+  // later import of the same asset, skipping the search cold-start.
+  // Returns false on the same failure cases as the fixed tolerance overload.
+  bool operator()(const RawAnimation& _input, const Skeleton& _skeleton,
+                  size_t _max_keyframes, RawAnimation* _output,
+                  float* _factor = nullptr) const;
+
   // Optimization settings.
   struct Setting {
     // Default settings
@@ -0,0 +1,103 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_OFFLINE_MOTION_EXTRACTOR_H_
+#define OZZ_OZZ_ANIMATION_OFFLINE_MOTION_EXTRACTOR_H_
+
+#include "ozz/animation/offline/export.h"
+
+namespace ozz {
+namespace animation {
+
+// Forward declares the runtime skeleton type.
+class Skeleton;
+
+namespace offline {
+
+// Forward declare offline animation and track types.
+struct RawAnimation;
+struct RawFloat3Track;
+struct RawQuaternionTrack;
+
+// Defines the class responsible for extracting root motion from a raw
+// animation into dedicated position and rotation motion tracks. Extracted
+// motion is removed from the root joint track of the output animation, so the
+// animation plays in place while motion tracks drive the character entity
+// transform. Motion tracks can then be converted to runtime tracks with a
+// TrackBuilder and queried with a MotionExtractionJob, which computes exact
+// accumulated deltas (including across loop boundaries) without sampling the
+// full pose. Extracting motion to its own channel also allows the animation
+// optimizer to decimate joint tracks aggressively without degrading root
+// trajectory precision.
+class OZZ_ANIMOFFLINE_DLL MotionExtractor {
+ public:
+  // Defines the reference transform extracted motion is expressed from.
+  struct Reference {
+    enum Value {
+      kAbsolute,   // Original track values, no reference.
+      kSkeleton,   // Relative to the skeleton rest pose.
+      kAnimation,  // Relative to the animation's first frame.
+    };
+  };
+
+  // Per channel (position / rotation) extraction settings.
+  struct Settings {
+    // Extracted components for the position channel, or the axis motion
+    // rotation twists around for the rotation channel. A rotation axis built
+    // from more than one component is normalized. A channel with no component
+    // selected extracts nothing, its motion track is a constant reference
+    // value.
+    bool x, y, z;
+
+    // Reference the extracted motion is expressed from.
+    Reference::Value reference;
+  };
+
+  // Position is extracted on the ground plane by default, rotation around the
+  // vertical axis (aka yaw).
+  Settings position_settings = {true, false, true, Reference::kSkeleton};
+  Settings rotation_settings = {false, true, false, Reference::kSkeleton};
+
+  // Index of the joint motion is extracted from, usually the root.
+  int root_joint = 0;
+
+  // Extracts motion from _input root joint track to _motion_position and
+  // _motion_rotation tracks, and fills _output with a copy of _input where
+  // extracted motion is removed from the root joint track (_output and
+  // &_input can be the same object). Motion track keyframe ratios map to
+  // input keyframe times, relative to animation duration.
+  // Returns false and resets outputs if _input is invalid or root_joint
+  // isn't a valid joint index for both _input and _skeleton.
+  bool operator()(const RawAnimation& _input, const Skeleton& _skeleton,
+                  RawFloat3Track* _motion_position,
+                  RawQuaternionTrack* _motion_rotation,
+                  RawAnimation* _output) const;
+};
+}  // namespace offline
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_OFFLINE_MOTION_EXTRACTOR_H_
@@ -0,0 +1,77 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_OFFLINE_PAGED_ANIMATION_BUILDER_H_
+#define OZZ_OZZ_ANIMATION_OFFLINE_PAGED_ANIMATION_BUILDER_H_
+
+#include "ozz/animation/offline/animation_builder.h"
+#include "ozz/animation/offline/export.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+namespace ozz {
+namespace animation {
+
+// Forward declares the paged runtime animation type.
+class PagedAnimation;
+
+namespace offline {
+
+// Forward declare offline animation type.
+struct RawAnimation;
+
+// Defines the class responsible for building runtime paged animation
+// instances from offline raw animations. Long clips (cinematics) are sliced
+// into fixed duration pages, each compiled into a self contained runtime
+// Animation, so sampling and streaming only ever touch the active page. Keys
+// within a page time window are kept, and boundary keyframes are sampled at
+// page transitions so each page interpolates exactly as the source clip.
+class OZZ_ANIMOFFLINE_DLL PagedAnimationBuilder {
+ public:
+  // Initializes the builder.
+  PagedAnimationBuilder();
+
+  // Creates a PagedAnimation based on _input and *this builder parameters.
+  // Returns a valid PagedAnimation on success, nullptr otherwise, if _input
+  // doesn't validate (see RawAnimation::Validate) or if page_duration isn't
+  // positive.
+  // The animation is returned as an unique_ptr as ownership is given back to
+  // the caller.
+  unique_ptr<PagedAnimation> operator()(const RawAnimation& _input) const;
+
+  // Duration (in seconds) covered by each page. The last page covers the
+  // clip remainder. Smaller pages bound sampling and streaming working set
+  // tighter, at the cost of duplicated boundary keyframes.
+  float page_duration;
+
+  // Builder used to compile each page. Its iframe_interval applies within
+  // pages, seeks across pages are already bounded by page lookup.
+  AnimationBuilder builder;
+};
+}  // namespace offline
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_OFFLINE_PAGED_ANIMATION_BUILDER_H_
@@ -0,0 +1,85 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_OFFLINE_POSE_DATABASE_BUILDER_H_
+#define OZZ_OZZ_ANIMATION_OFFLINE_POSE_DATABASE_BUILDER_H_
+
+#include "ozz/animation/offline/export.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/memory/unique_ptr.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+namespace animation {
+
+// Forward declares the runtime pose database and skeleton types.
+class PoseDatabase;
+class Skeleton;
+
+namespace offline {
+
+// Forward declare offline animation type.
+struct RawAnimation;
+
+// Defines the class responsible for building runtime pose databases, for
+// motion-matching style pose search, from a set of offline raw animations.
+// Animations are sampled at a fixed rate, and each sampled frame contributes
+// one database entry: the model-space position and velocity of every tracked
+// joint (usually the feet, optionally hips or hands). Velocities are finite
+// differences between consecutive frames, so they capture the motion the
+// runtime would actually play. Entries are laid out as a kd-tree for fast
+// runtime nearest-neighbor queries.
+class OZZ_ANIMOFFLINE_DLL PoseDatabaseBuilder {
+ public:
+  // Initializes the builder.
+  PoseDatabaseBuilder();
+
+  // Creates a PoseDatabase based on the animation set and *this builder
+  // parameters. _skeleton provides the hierarchy used to compute tracked
+  // joint model-space features, and must match the animations.
+  // Returns a valid PoseDatabase on success, nullptr otherwise:
+  // - if _animations is empty, or contains a null or invalid animation, or
+  // an animation whose tracks don't match _skeleton joints.
+  // - if sample_rate isn't positive.
+  // - if joints is empty or contains an out of range joint index.
+  unique_ptr<PoseDatabase> operator()(
+      const Skeleton& _skeleton,
+      const span<const RawAnimation* const>& _animations) const;
+
+  // Rate (Hz) at which animations are sampled into database entries. Higher
+  // rates match finer but grow the database linearly.
+  float sample_rate;
+
+  // Indices of the joints whose model-space position and velocity make up
+  // pose features. Must not be empty. Feet are the usual choice for
+  // locomotion matching.
+  ozz::vector<uint16_t> joints;
+};
+}  // namespace offline
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_OFFLINE_POSE_DATABASE_BUILDER_H_
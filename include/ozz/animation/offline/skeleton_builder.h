@@ -53,6 +53,16 @@ class OZZ_ANIMOFFLINE_DLL SkeletonBuilder {
   // caller.
   ozz::unique_ptr<ozz::animation::Skeleton> operator()(
       const RawSkeleton& _raw_skeleton) const;
+
+  // Reorders sibling sub-hierarchies from the smallest to the biggest while
+  // traversing the raw skeleton. This minimizes the distance between a joint
+  // and its parent in the output buffers, hence improving cache locality of
+  // jobs that walk the hierarchy (LocalToModelJob typically), on rigs with
+  // unbalanced sibling sub-hierarchies. The output remains in depth-first
+  // order, as documented by the runtime Skeleton, with parents and names
+  // remapped consistently. Disabled by default as it changes joint indices
+  // compared to the raw skeleton traversal order.
+  bool minimize_parent_distance = false;
 };
 }  // namespace offline
 }  // namespace animation
@@ -29,17 +29,26 @@
 #define OZZ_OZZ_ANIMATION_OFFLINE_TRACK_BUILDER_H_
 
 #include "ozz/animation/offline/export.h"
+#include "ozz/animation/runtime/quantized_track.h"
 #include "ozz/base/memory/unique_ptr.h"
+#include "ozz/base/span.h"
 
 namespace ozz {
 namespace animation {
 
 // Forward declares the runtime tracks type.
 class FloatTrack;
+class FloatTrackSoA;
+class TrackEdgeIndex;
 class Float2Track;
 class Float3Track;
 class Float4Track;
 class QuaternionTrack;
+class FloatTrackBundle;
+class Float2TrackBundle;
+class Float3TrackBundle;
+class Float4TrackBundle;
+class QuaternionTrackBundle;
 
 namespace offline {
 
@@ -68,9 +77,97 @@ class OZZ_ANIMOFFLINE_DLL TrackBuilder {
   ozz::unique_ptr<QuaternionTrack> operator()(
       const RawQuaternionTrack& _input) const;
 
+  // Move-semantics build path, consuming _input. Keyframes are first sorted
+  // in place, the only validity requirement a consumed input is exempted
+  // from, then begin/end keys are patched directly into the consumed buffer
+  // instead of the intermediate copy the const overloads make. A conversion
+  // hence costs a single allocation: the runtime track one. _input is left
+  // in a valid but unspecified state.
+  ozz::unique_ptr<FloatTrack> operator()(RawFloatTrack&& _input) const;
+  ozz::unique_ptr<Float2Track> operator()(RawFloat2Track&& _input) const;
+  ozz::unique_ptr<Float3Track> operator()(RawFloat3Track&& _input) const;
+  ozz::unique_ptr<Float4Track> operator()(RawFloat4Track&& _input) const;
+  ozz::unique_ptr<QuaternionTrack> operator()(
+      RawQuaternionTrack&& _input) const;
+
+  // Bulk build path, consuming every track of _inputs with the
+  // move-semantics overloads, for editors round-tripping many tracks per
+  // save. Track i of _inputs is built into _outputs[i]. _outputs must be at
+  // least _inputs sized, otherwise no track is built.
+  // Returns the number of successfully built tracks. Tracks that fail to
+  // validate (see Raw*Track::Validate()) leave their output empty, without
+  // interrupting the remaining conversions.
+  size_t operator()(const span<RawFloatTrack>& _inputs,
+                    const span<ozz::unique_ptr<FloatTrack>>& _outputs) const;
+  size_t operator()(const span<RawFloat2Track>& _inputs,
+                    const span<ozz::unique_ptr<Float2Track>>& _outputs) const;
+  size_t operator()(const span<RawFloat3Track>& _inputs,
+                    const span<ozz::unique_ptr<Float3Track>>& _outputs) const;
+  size_t operator()(const span<RawFloat4Track>& _inputs,
+                    const span<ozz::unique_ptr<Float4Track>>& _outputs) const;
+  size_t operator()(
+      const span<RawQuaternionTrack>& _inputs,
+      const span<ozz::unique_ptr<QuaternionTrack>>& _outputs) const;
+
+  // Creates a FloatTrackSoA aggregating all _inputs tracks, resampled on the
+  // union of their keyframe ratios (which is lossless), for sampling with
+  // TrackSoASamplingJob. Track i of the aggregate matches _inputs[i].
+  // Returns an empty unique_ptr if _inputs is empty or if any input track
+  // fails to validate.
+  ozz::unique_ptr<FloatTrackSoA> operator()(
+      const span<const RawFloatTrack>& _inputs) const;
+
+  // Creates a TrackEdgeIndex precomputing all the edges of _input track
+  // crossing _threshold, for triggering with TrackEdgeTriggeringJob. Edges are
+  // the same as TrackTriggeringJob would detect on the built track with the
+  // same threshold.
+  // Returns an empty unique_ptr if _input fails to validate.
+  ozz::unique_ptr<TrackEdgeIndex> operator()(const RawFloatTrack& _input,
+                                             float _threshold) const;
+
+  // Creates a QuantizedFloatTrack based on _input, with values stored
+  // according to _format. Quantization is lossy, see QuantizedFloatTrack for
+  // more details.
+  // Returns an empty unique_ptr if _input fails to validate.
+  ozz::unique_ptr<QuantizedFloatTrack> operator()(
+      const RawFloatTrack& _input, QuantizedFloatTrack::Format _format) const;
+
+  // Creates a TrackBundle deduplicating the timeline (keyframe ratios and
+  // interpolations) shared by all _inputs tracks, for sampling with
+  // *TrackBundleSamplingJob. Track i of the bundle matches _inputs[i].
+  // Returns an empty unique_ptr if _inputs is empty, if any input track fails
+  // to validate, or if tracks timelines aren't strictly identical (once
+  // begin/end keys are patched). Tracks with heterogeneous timelines can be
+  // aggregated with the FloatTrackSoA overload instead.
+  ozz::unique_ptr<FloatTrackBundle> Bundle(
+      const span<const RawFloatTrack>& _inputs) const;
+  ozz::unique_ptr<Float2TrackBundle> Bundle(
+      const span<const RawFloat2Track>& _inputs) const;
+  ozz::unique_ptr<Float3TrackBundle> Bundle(
+      const span<const RawFloat3Track>& _inputs) const;
+  ozz::unique_ptr<Float4TrackBundle> Bundle(
+      const span<const RawFloat4Track>& _inputs) const;
+  ozz::unique_ptr<QuaternionTrackBundle> Bundle(
+      const span<const RawQuaternionTrack>& _inputs) const;
+
  private:
   template <typename _RawTrack, typename _Track>
   ozz::unique_ptr<_Track> Build(const _RawTrack& _input) const;
+
+  template <typename _RawTrack, typename _Track>
+  ozz::unique_ptr<_Track> Build(_RawTrack&& _input) const;
+
+  template <typename _RawTrack, typename _Track>
+  size_t BuildBulk(const span<_RawTrack>& _inputs,
+                   const span<ozz::unique_ptr<_Track>>& _outputs) const;
+
+  template <typename _Keyframes, typename _Track>
+  void Fill(const _Keyframes& _keyframes, const char* _name,
+            _Track* _track) const;
+
+  template <typename _RawTrack, typename _TrackBundle>
+  ozz::unique_ptr<_TrackBundle> BuildBundle(
+      const span<const _RawTrack>& _inputs) const;
 };
 }  // namespace offline
 }  // namespace animation
@@ -0,0 +1,129 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_AIM_CHAIN_JOB_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_AIM_CHAIN_JOB_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/base/platform.h"
+#include "ozz/base/span.h"
+
+#include "ozz/base/maths/simd_math.h"
+
+namespace ozz {
+// Forward declaration of math structures.
+namespace math {
+struct SimdQuaternion;
+}
+
+namespace animation {
+
+// ozz::animation::AimChainJob distributes an aim constraint over a chain of
+// weighted joints (aka look-at), so a forward vector (defined in the first
+// joint local-space) aims at a single target position. This productizes the
+// algorithm demonstrated by the look_at sample: aim IK is applied iteratively
+// from the first joint (the aimed one, ex: the head) to the last (the further
+// ancestor, ex: a spine root), each joint contributing a part of the rotation
+// according to its weight. The effect of each joint correction is propagated
+// to the next joint analytically (fused into the iteration), so the job runs
+// from a single model-space snapshot: no LocalToModelJob update is needed
+// between joints, a single one (from the last chain joint) is enough once
+// output corrections have been applied.
+// The chain joints must be ordered from the aimed joint up to its ancestors.
+// They must be ancestors, but don't need to be direct ancestors.
+struct OZZ_ANIMATION_DLL AimChainJob {
+  // Constructor, initializes default values.
+  AimChainJob();
+
+  // Validates job parameters. Returns true for a valid job, or false
+  // otherwise:
+  // -if the chain is empty.
+  // -if joint_corrections hasn't a correction per joint.
+  // -if joint_ups or joint_weights aren't empty nor joints sized.
+  // -if forward vector isn't normalized.
+  bool Validate() const;
+
+  // Runs job's execution task.
+  // The job is validated before any operation is performed, see Validate() for
+  // more details.
+  // Returns false if *this job is not valid.
+  bool Run() const;
+
+  // Job input.
+
+  // Target position to aim at, in model-space.
+  math::SimdFloat4 target;
+
+  // Forward vector, in first joint local-space, to be aimed at target
+  // position. Must be normalized.
+  math::SimdFloat4 forward;
+
+  // Offset position from the first joint, in first joint local-space, from
+  // where the forward vector should aim the target (ex: eyes offset from the
+  // head joint).
+  math::SimdFloat4 offset;
+
+  // Pole vector, in model-space. The pole vector defines the direction the up
+  // vectors should point to, shared by the whole chain.
+  math::SimdFloat4 pole_vector;
+
+  // Weight given to the whole chain aim, clamped in range [0,1]. This allows
+  // to blend / interpolate from no correction applied (0 weight) to a full
+  // aim (1).
+  float chain_weight;
+
+  // Model-space matrices of the chain joints, ordered from the aimed joint up
+  // to its ancestors.
+  span<const math::Float4x4> joints;
+
+  // Optional per joint up vectors, in each joint local-space, used to keep
+  // joints oriented in the direction of the pole vector. Leave empty to use y
+  // axis for every joint, otherwise it must be joints sized.
+  span<const math::SimdFloat4> joint_ups;
+
+  // Optional per joint weights in range [0,1], defining how much of the
+  // remaining rotation each joint contributes. The last chain joint ignores
+  // its entry and uses a full weight, which guarantees the chain aims at the
+  // target (if chain_weight is 1). Leave empty to give a full weight to every
+  // joint (the first joint then does all the aiming), otherwise it must be
+  // joints sized.
+  span<const float> joint_weights;
+
+  // Job output.
+
+  // Per joint local-space corrections to apply to chain joints. These
+  // quaternions must be multiplied to the local-space quaternion of their
+  // respective joints. Must be at least joints sized.
+  span<math::SimdQuaternion> joint_corrections;
+
+  // Optional boolean output value, set to true if the target can be aimed at.
+  // It is not reachable when the target is at joint or offset position.
+  bool* reached;
+};
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_AIM_CHAIN_JOB_H_
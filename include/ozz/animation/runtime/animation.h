@@ -38,6 +38,12 @@ namespace io {
 class IArchive;
 class OArchive;
 }  // namespace io
+
+// Forward declaration of math structures.
+namespace math {
+struct Transform;
+}
+
 namespace animation {
 
 // Forward declares the AnimationBuilder, used to instantiate an Animation.
@@ -90,6 +96,23 @@ class OZZ_ANIMATION_DLL Animation {
   // Gets animation name.
   const char* name() const { return name_ ? name_ : ""; }
 
+  // Gets the rig signature, a name identifying the skeleton convention (joint
+  // set and ordering) this animation's tracks were built for, set offline
+  // through AnimationBuilder::rig_signature and carried through
+  // serialization. Animations sharing a signature can be sampled on any
+  // skeleton with that convention, others need their tracks permuted first,
+  // see PermuteTracks. Empty when no signature was set.
+  const char* rig() const { return rig_ ? rig_ : ""; }
+
+  // Tests whether the clip is loop-safe: for every track, the first and last
+  // keys of every component hold the same value, so a playback cursor
+  // wrapping at the loop seam lands on the exact pose it left, without a pop
+  // nor a seam crossfade. Recorded offline by AnimationBuilder (which can
+  // also enforce it, see AnimationBuilder::enforce_loop) and carried through
+  // serialization. Looping animations accept out-of-range sampling ratios,
+  // wrapped back into the unit interval, see SamplingJob::ratio.
+  bool looping() const { return looping_; }
+
   // Gets the buffer of time points.
   span<const float> timepoints() const { return timepoints_; }
 
@@ -154,6 +177,23 @@ class OZZ_ANIMATION_DLL Animation {
     return scales_values_;
   }
 
+  // Gets the animated joints bitmask, built by the AnimationBuilder: bit i of
+  // byte i / 8 is set when track i has at least one non constant channel.
+  // Tracks with a clear bit sample to the same transform for the whole clip,
+  // so downstream consumers (blending, joint LOD, tooling...) can substitute
+  // constant or rest pose fast paths. The bit layout is the same as sampling
+  // and local-to-model joint masks.
+  span<const byte> animated_joints() const { return animated_joints_; }
+
+  // Gets rotation decompression classes, one byte per soa group of 4 rotation
+  // tracks, built by the AnimationBuilder from compressed key statistics.
+  // Sampling dispatches each group to the specialized quaternion
+  // decompression kernel matching its class: groups whose tracks never leave
+  // a small arc, or keep a constant largest component, skip part of the
+  // generic per-key unpack work. See internal::QuaternionClass for class
+  // semantics, 0 always selects the generic kernel.
+  span<const byte> rotation_classes() const { return rotation_classes_; }
+
   // Get the estimated animation's size in bytes.
   size_t size() const;
 
@@ -162,6 +202,73 @@ class OZZ_ANIMATION_DLL Animation {
   void Save(ozz::io::OArchive& _archive) const;
   void Load(ozz::io::IArchive& _archive, uint32_t _version);
 
+  // Relocatable image support, aka zero-copy loading. A relocatable image is
+  // a flat buffer (small header followed by the animation data block) that
+  // can be stored to disk and later reused in place: LoadRaw fixes up keyframe
+  // spans to point directly into the image, with no allocation nor copy. The
+  // intended use case is loading from a memory-mapped file, making animation
+  // loading instant and paging OS-managed. In counterpart, images are not
+  // portable across architectures (native endianness and type layout), as
+  // opposed to archive-based serialization.
+
+  // Size in bytes of the relocatable image of this animation.
+  size_t raw_size() const;
+
+  // Writes the relocatable image to _buffer, which must be at least
+  // raw_size() bytes. Returns false if the buffer is too small.
+  bool SaveRaw(span<byte> _buffer) const;
+
+  // Binds this animation to the relocatable image stored in _buffer, which
+  // usually maps a file. The buffer is referenced, not copied: it must remain
+  // valid (and unmodified) for the lifetime of this animation, and be aligned
+  // on 4 bytes boundaries. Returns false if the buffer doesn't contain a
+  // compatible image, leaving the animation empty.
+  bool LoadRaw(span<const byte> _buffer);
+
+  // Two-phase archive loading into caller-provided memory, for builds with
+  // strict memory budgets where animation data must live in a specific pool
+  // or arena rather than going through the default allocator.
+
+  // Probes _archive for the size in bytes of the data block of the animation
+  // that follows, leaving the archive read position untouched. Returns 0 if
+  // the next object isn't an animation of a supported version.
+  static size_t SizeOf(ozz::io::IArchive& _archive);
+
+  // Deserializes the next animation from _archive into _buffer, which must be
+  // at least SizeOf() bytes, aligned on 4 bytes boundaries, and must remain
+  // valid (the animation doesn't own it) until the animation is destroyed or
+  // reused. Returns false, leaving the animation empty, if the archive
+  // doesn't contain a loadable animation or if _buffer is too small or
+  // misaligned.
+  bool Load(ozz::io::IArchive& _archive, span<byte> _buffer);
+
+  // Reorders tracks in place so that new track i is current track
+  // _permutation[i]. This lets an animation authored for one skeleton be
+  // sampled on another one that has the same joints in a different order
+  // (structurally identical rigs, see rig()): the permutation is applied
+  // once, typically at load time, instead of remapping joints at every
+  // sample. _permutation size must be num_tracks() and each track must be
+  // listed exactly once. Keyframes are relocated and rechained, iframes are
+  // rebuilt, sampled values are unchanged. Returns false, leaving the
+  // animation unmodified, if the permutation is invalid or if reordering
+  // would overflow the keyframe format previous-key offset limit.
+  bool PermuteTracks(const span<const uint16_t>& _permutation);
+
+  // Rewrites keyframe values in place so that the clip becomes an additive
+  // delta animation relative to _reference_pose, with the same delta
+  // convention as the offline AdditiveAnimationBuilder (translations
+  // subtracted, rotations left-multiplied by the conjugate reference,
+  // scales divided). This lets a single absolute clip ship once and be bound
+  // to any number of per-layer reference poses at load time, instead of
+  // cooking one additive variant per reference. Key layout, time points and
+  // iframes are untouched, only values are transcoded (decompressed, rebased,
+  // re-quantized with the same precision as the offline build).
+  // _reference_pose size must be num_tracks(), one local-space transform per
+  // track. Returns false, leaving the animation unmodified, if sizes don't
+  // match or if a reference scale component is null (the delta would not be
+  // invertible).
+  bool MakeAdditive(const span<const math::Transform>& _reference_pose);
+
  private:
   // AnimationBuilder class is allowed to instantiate an Animation.
   friend class offline::AnimationBuilder;
@@ -169,6 +276,7 @@ class OZZ_ANIMATION_DLL Animation {
   // Internal memory management functions.
   struct AllocateParams {
     size_t name_len;
+    size_t rig_len;
     size_t timepoints;
 
     size_t translations;
@@ -183,10 +291,22 @@ class OZZ_ANIMATION_DLL Animation {
     IFrames translation_iframes;
     IFrames rotation_iframes;
     IFrames scale_iframes;
+
+    size_t tracks;
   };
+  // Size in bytes of the data block described by _params.
+  static size_t RequiredSize(const AllocateParams& _params);
+  // Fixes up keyframe spans into _buffer, whose size must be RequiredSize().
+  void Bind(const AllocateParams& _params, span<byte> _buffer);
   void Allocate(const AllocateParams& _params);
   void Deallocate();
 
+  // Reads the version dependent header (counts) that follows the version
+  // number, filling _params. Returns false for unsupported versions. Shared by
+  // Load and SizeOf so both agree on memory requirements.
+  static bool LoadHeader(ozz::io::IArchive& _archive, uint32_t _version,
+                         float* _duration, AllocateParams* _params);
+
   // Duration of the animation clip.
   float duration_;
 
@@ -197,6 +317,21 @@ class OZZ_ANIMATION_DLL Animation {
   // Animation name.
   char* name_;
 
+  // Rig signature, see rig().
+  char* rig_;
+
+  // Loop safety flag, see looping().
+  bool looping_;
+
+  // True when the animation owns (and must deallocate) its data block, false
+  // when the block lives in external memory (relocatable image or placement
+  // load), see LoadRaw and the placement Load overload.
+  bool owns_buffer_;
+
+  // Caller-provided buffer the next Allocate call binds to instead of
+  // allocating, only set for the duration of a placement Load.
+  span<byte> placement_buffer_;
+
   // Stores all translation/rotation/scale keys.
   span<float> timepoints_;
 
@@ -209,11 +344,17 @@ class OZZ_ANIMATION_DLL Animation {
   span<internal::Float3Key> translations_values_;
   span<internal::QuaternionKey> rotations_values_;
   span<internal::Float3Key> scales_values_;
+
+  // Animated joints bitmask, see animated_joints().
+  span<byte> animated_joints_;
+
+  // Rotation decompression classes, see rotation_classes().
+  span<byte> rotation_classes_;
 };
 }  // namespace animation
 
 namespace io {
-OZZ_IO_TYPE_VERSION(7, animation::Animation)
+OZZ_IO_TYPE_VERSION(12, animation::Animation)
 OZZ_IO_TYPE_TAG("ozz-animation", animation::Animation)
 }  // namespace io
 }  // namespace ozz
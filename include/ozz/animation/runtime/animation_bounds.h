@@ -0,0 +1,103 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_ANIMATION_BOUNDS_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_ANIMATION_BOUNDS_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/io/archive_traits.h"
+#include "ozz/base/maths/box.h"
+
+namespace ozz {
+namespace animation {
+
+// Forward declares the AnimationBoundsBuilder, used to instantiate an
+// AnimationBounds.
+namespace offline {
+class AnimationBoundsBuilder;
+}
+
+// Time-bucketed model-space bounding boxes of an animated skeleton, used to
+// cull skinned characters with bounds that follow the animation instead of a
+// gross whole-clip static box. The clip timeline is split in equal intervals,
+// and each interval stores the axis aligned box enclosing every joint
+// position reached during that interval (see AnimationBoundsBuilder). A
+// runtime query is then a single indexed lookup from the sampling time ratio,
+// cheap enough for per-character per-pass culling.
+// Bounds enclose joint positions, not the skinned mesh surface: the builder
+// margin parameter is there to compensate for mesh extent around bones.
+class OZZ_ANIMATION_DLL AnimationBounds {
+ public:
+  // Builds a default, empty, bounds object.
+  AnimationBounds();
+
+  // Allow moves.
+  AnimationBounds(AnimationBounds&&);
+  AnimationBounds& operator=(AnimationBounds&&);
+
+  // Delete copies.
+  AnimationBounds(AnimationBounds const&) = delete;
+  AnimationBounds& operator=(AnimationBounds const&) = delete;
+
+  // Declares the public non-virtual destructor.
+  ~AnimationBounds();
+
+  // Gets the number of time intervals the clip timeline was split in.
+  int num_intervals() const { return static_cast<int>(intervals_.size()); }
+
+  // Gets the bounds of the interval containing sampling time _ratio. _ratio
+  // is clamped to the [0, 1] timeline, matching SamplingJob behavior. Returns
+  // an invalid box if *this is empty.
+  math::Box GetBounds(float _ratio) const;
+
+  // Gets the merged bounds of every interval intersecting ratio range
+  // [_from, _to] (unordered, both clamped), for queries spanning several
+  // frames like interpolated culling or shadow casting during a blend.
+  math::Box GetBounds(float _from, float _to) const;
+
+  // Serialization functions.
+  // Should not be called directly but through io::Archive << and >> operators.
+  void Save(ozz::io::OArchive& _archive) const;
+  void Load(ozz::io::IArchive& _archive, uint32_t _version);
+
+ private:
+  // AnimationBoundsBuilder class is allowed to instantiate an AnimationBounds.
+  friend class offline::AnimationBoundsBuilder;
+
+  // Per interval joint-extent boxes, interval i covering ratio range
+  // [i / size, (i + 1) / size].
+  vector<math::Box> intervals_;
+};
+}  // namespace animation
+
+namespace io {
+OZZ_IO_TYPE_VERSION(1, animation::AnimationBounds)
+OZZ_IO_TYPE_TAG("ozz-animation_bounds", animation::AnimationBounds)
+}  // namespace io
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_ANIMATION_BOUNDS_H_
@@ -0,0 +1,80 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_ANIMATION_LOD_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_ANIMATION_LOD_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+namespace ozz {
+namespace animation {
+
+class Animation;
+
+// Owns the temporal levels of detail of an animation, as built by
+// AnimationLodBuilder: nested keyframe resolutions sharing duration and
+// tracks, finest first. Select() picks the stream for a level, to be plugged
+// straight into SamplingJob::animation: switching level switches which key
+// stream the sampling cursor walks, and the job detects the animation change
+// and restarts its context cursor automatically. Levels being separate
+// animations, instances of the same character can sample different levels
+// concurrently (each with its own context) without any synchronization.
+class OZZ_ANIMATION_DLL AnimationLod {
+ public:
+  // Constructs an empty set, with no level to select.
+  AnimationLod();
+
+  // Constructs a set from _levels, taking ownership. _levels is expected
+  // finest first, as returned by AnimationLodBuilder. Null entries are
+  // rejected, leaving the set empty.
+  explicit AnimationLod(ozz::vector<unique_ptr<Animation>> _levels);
+
+  // Disables copy and assignation, as the set owns its animations.
+  AnimationLod(const AnimationLod&) = delete;
+  AnimationLod& operator=(const AnimationLod&) = delete;
+
+  // Move support.
+  AnimationLod(AnimationLod&&) = default;
+  AnimationLod& operator=(AnimationLod&&) = default;
+
+  // Selects the key stream for _level. _level is clamped to the available
+  // range: negative values select the finest level (0), values from
+  // num_levels() up select the coarsest. Returns nullptr for an empty set.
+  const Animation* Select(int _level) const;
+
+  // Number of levels in the set, 0 for an empty set.
+  int num_levels() const { return static_cast<int>(levels_.size()); }
+
+ private:
+  // Levels, finest (full resolution) first. All non null.
+  ozz::vector<unique_ptr<Animation>> levels_;
+};
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_ANIMATION_LOD_H_
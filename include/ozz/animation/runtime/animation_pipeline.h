@@ -0,0 +1,126 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_ANIMATION_PIPELINE_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_ANIMATION_PIPELINE_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+
+// Forward declares the task scheduler interface.
+class Scheduler;
+
+namespace animation {
+
+// Executes a per-character animation stage chain (sample -> blend -> IK ->
+// local-to-model -> skinning-palette...) over a batch of instances, without
+// a synchronization point between stages. Stages are declared once, each as a
+// function running one stage for one instance, bound to the buffers it reads
+// and writes through its context. Because each stage consumes the previous
+// stage's output for the same instance only, the pipeline fuses stages: an
+// instance runs its whole chain back to back on a single thread, keeping
+// intermediate buffers (local poses...) hot in cache. Instances are
+// independent, so the batch is distributed across a Scheduler, pipelining
+// characters instead of joining all threads between stages.
+// Stages that don't permit fusion, because they read buffers written by other
+// instances (crowd adaptive blending, shared palette compaction...), are
+// declared as barriers: all previous stages complete for every instance
+// before a barrier stage runs.
+struct OZZ_ANIMATION_DLL AnimationPipeline {
+  // Default constructor, initializes default values.
+  AnimationPipeline();
+
+  // Function running one stage for instance _instance, returning false on
+  // failure. _context is the stage declared context.
+  typedef bool (*StageFn)(void* _context, int _instance);
+
+  // A declared pipeline stage.
+  struct Stage {
+    // Stage debug name, never nullptr.
+    const char* name;
+
+    // Stage function and its context (buffers, jobs parameters...). The
+    // context must remain valid until Run returns, and must support
+    // concurrent invocations for different instances.
+    StageFn fn;
+    void* context;
+
+    // True if the stage reads buffers written for other instances, hence
+    // can't be fused with the previous stage. All previous stages complete
+    // for all instances before this stage runs for any of them.
+    bool barrier;
+  };
+
+  // Builds a stage from a callable of signature bool(int _instance). The
+  // callable must outlive the stage, as it's captured by address.
+  template <typename _Fct>
+  static Stage MakeStage(const char* _name, const _Fct& _fct,
+                         bool _barrier = false) {
+    const Stage stage = {
+        _name, &InvokeStage<_Fct>,
+        const_cast<void*>(static_cast<const void*>(&_fct)), _barrier};
+    return stage;
+  }
+
+  // Validates pipeline parameters. Returns true for a valid pipeline, or
+  // false otherwise:
+  // -if the number of instances is negative.
+  // -if any stage has a nullptr function or name.
+  bool Validate() const;
+
+  // Runs every stage for every instance, distributing instances across the
+  // scheduler. Returns false if the pipeline is not valid, or if any stage
+  // invocation failed. A failing stage skips the remaining fused stages for
+  // that instance.
+  bool Run() const;
+
+  // Number of instances (characters) the pipeline processes.
+  int num_instances;
+
+  // Pipeline stages, executed in order for each instance.
+  span<const Stage> stages;
+
+  // Scheduler instances are distributed across. nullptr executes the whole
+  // batch on the calling thread.
+  Scheduler* scheduler;
+
+  // Number of instances each scheduler task processes, trading scheduling
+  // overhead for load-balancing accuracy.
+  int granularity;
+
+ private:
+  // Type erased invocation of a _Fct callable.
+  template <typename _Fct>
+  static bool InvokeStage(void* _context, int _instance) {
+    return (*static_cast<const _Fct*>(_context))(_instance);
+  }
+};
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_ANIMATION_PIPELINE_H_
@@ -0,0 +1,404 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_ANIMATION_REGISTRY_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_ANIMATION_REGISTRY_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/memory/allocator.h"
+#include "ozz/base/memory/unique_ptr.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+namespace animation {
+
+class Animation;
+class Skeleton;
+
+namespace internal {
+// Per thread NUMA node storage, see SetThreadNumaNode.
+inline int& ThreadNumaNodeStorage() {
+  static thread_local int node = memory::Allocator::kAnyNode;
+  return node;
+}
+}  // namespace internal
+
+// The NUMA node the calling thread runs on, as declared with
+// SetThreadNumaNode. Defaults to kAnyNode (no declared node), in which case
+// node-local resolution falls back to the primary resource.
+inline int ThreadNumaNode() { return internal::ThreadNumaNodeStorage(); }
+
+// Declares the NUMA node the calling thread runs on, enabling automatic
+// resolution of registry handles to node-local replicas, see
+// Registry::GetLocal. Worker threads pinned to a node declare it once at
+// startup. Returns the previously declared node.
+inline int SetThreadNumaNode(int _node) {
+  int& node = internal::ThreadNumaNodeStorage();
+  const int previous = node;
+  node = _node;
+  return previous;
+}
+
+// Registry mapping stable 32-bit handles to shared animation resources
+// (animations, skeletons, tracks...). Resolving a handle to a pointer is
+// lock-free and wait-free, so any number of worker threads can resolve
+// handles concurrently (typically once per instance per frame) without
+// contending on a lock. Handles are also half the size of a pointer on 64
+// bits targets, which matters for large per-instance state arrays.
+// The registry is insert-only: handles are never removed nor reused, they
+// remain valid for the registry lifetime. Hot-reloading is supported by
+// swapping the resource a handle resolves to, see Replace(). Mutations (Add,
+// Replace, Collect) are serialized with a lock, as they belong to the loading
+// path where contention isn't a concern.
+//
+// Replaced resources are reclaimed with an epoch scheme: Replace() retires
+// the previous resource instead of deleting it, as concurrent readers can
+// still be using it. Collect() declares a quiescent point (typically once per
+// frame, between update batches) advancing the registry epoch, and deletes
+// resources retired two or more epochs ago. A resolved pointer hence remains
+// valid as long as it isn't held across two Collect() calls.
+//
+// On NUMA systems, hot read-only resources can be duplicated per node with
+// Duplicate(), so workers sample a node-local copy instead of stalling on
+// remote memory. Threads declare their node once (SetThreadNumaNode), then
+// GetLocal() resolves handles to the local replica, falling back to the
+// primary resource on nodes without one. Replicas are typically placement
+// loaded (Animation::Load with a caller-provided buffer) into memory obtained
+// from Allocator::AllocateOnNode, so the copy is actually resident on the
+// targeted node.
+template <typename _Ty>
+class Registry {
+ public:
+  // Handles are stable, never reused, and fit per-instance state in 4 bytes.
+  // kInvalidHandle (aka 0) is never returned by a successful Add.
+  typedef uint32_t Handle;
+  enum : Handle { kInvalidHandle = 0 };
+
+  Registry() {
+    for (size_t i = 0; i < kMaxPages; ++i) {
+      pages_[i].store(nullptr, std::memory_order_relaxed);
+    }
+    for (size_t i = 0; i < kMaxNodes; ++i) {
+      node_tables_[i].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  ~Registry() {
+    // No concurrent access is allowed during destruction.
+    for (size_t i = 0; i < retired_.size(); ++i) {
+      ozz::Delete(retired_[i].resource);
+    }
+    for (size_t i = 0; i < kMaxPages; ++i) {
+      Page* page = pages_[i].load(std::memory_order_relaxed);
+      if (!page) {
+        continue;
+      }
+      for (size_t j = 0; j < kPageSize; ++j) {
+        ozz::Delete(page->slots[j].load(std::memory_order_relaxed));
+      }
+      ozz::Delete(page);
+    }
+    for (size_t n = 0; n < kMaxNodes; ++n) {
+      NodeTable* table = node_tables_[n].load(std::memory_order_relaxed);
+      if (!table) {
+        continue;
+      }
+      for (size_t i = 0; i < kMaxPages; ++i) {
+        Page* page = table->pages[i].load(std::memory_order_relaxed);
+        if (!page) {
+          continue;
+        }
+        for (size_t j = 0; j < kPageSize; ++j) {
+          ozz::Delete(page->slots[j].load(std::memory_order_relaxed));
+        }
+        ozz::Delete(page);
+      }
+      ozz::Delete(table);
+    }
+  }
+
+  // Transfers _resource ownership to the registry and returns its handle.
+  // Returns kInvalidHandle if _resource is nullptr or if the registry is full.
+  Handle Add(unique_ptr<_Ty> _resource) {
+    if (!_resource) {
+      return kInvalidHandle;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    const uint32_t index = size_;
+    const uint32_t page_index = index / kPageSize;
+    if (page_index >= kMaxPages) {
+      return kInvalidHandle;
+    }
+    // Pages are allocated on demand, so unused capacity costs nothing but the
+    // page pointer table.
+    Page* page = pages_[page_index].load(std::memory_order_relaxed);
+    if (!page) {
+      page = ozz::New<Page>();
+      pages_[page_index].store(page, std::memory_order_release);
+    }
+    page->slots[index % kPageSize].store(_resource.release(),
+                                         std::memory_order_release);
+    size_ = index + 1;
+    return index + 1;  // 0 is reserved for kInvalidHandle.
+  }
+
+  // Resolves _handle to its resource. Lock-free, safe to call from any number
+  // of threads concurrently with any registry operation. Returns nullptr for
+  // kInvalidHandle or a handle this registry never returned.
+  _Ty* Get(Handle _handle) const {
+    if (_handle == kInvalidHandle) {
+      return nullptr;
+    }
+    const uint32_t index = _handle - 1;
+    const uint32_t page_index = index / kPageSize;
+    if (page_index >= kMaxPages) {
+      return nullptr;
+    }
+    const Page* page = pages_[page_index].load(std::memory_order_acquire);
+    if (!page) {
+      return nullptr;
+    }
+    return page->slots[index % kPageSize].load(std::memory_order_acquire);
+  }
+
+  // Resolves _handle to its replica on NUMA node _node, falling back to the
+  // primary resource when _node has no replica (or is kAnyNode / out of
+  // range). Lock-free like Get, at the price of one extra indirection when a
+  // node is targeted.
+  _Ty* Get(Handle _handle, int _node) const {
+    if (_node >= 0 && _node < kMaxNodes) {
+      const NodeTable* table =
+          node_tables_[_node].load(std::memory_order_acquire);
+      if (table && _handle != kInvalidHandle) {
+        const uint32_t index = _handle - 1;
+        const uint32_t page_index = index / kPageSize;
+        if (page_index < kMaxPages) {
+          const Page* page =
+              table->pages[page_index].load(std::memory_order_acquire);
+          if (page) {
+            _Ty* replica =
+                page->slots[index % kPageSize].load(std::memory_order_acquire);
+            if (replica) {
+              return replica;
+            }
+          }
+        }
+      }
+    }
+    return Get(_handle);
+  }
+
+  // Resolves _handle to the replica local to the calling thread's declared
+  // NUMA node, see SetThreadNumaNode. Threads that never declared a node get
+  // the primary resource, so code can use GetLocal unconditionally.
+  _Ty* GetLocal(Handle _handle) const { return Get(_handle, ThreadNumaNode()); }
+
+  // Registers _replica as the copy of _handle's resource on NUMA node _node,
+  // taking ownership. The replica is expected to be an identical copy of the
+  // primary resource, built into node-local memory (see
+  // Allocator::AllocateOnNode). Calling Duplicate again for the same handle
+  // and node swaps the replica, retiring the previous one like Replace does.
+  // When the primary is hot-reloaded with Replace, replicas must be refreshed
+  // (or retired by duplicating the new version) by the caller, as the
+  // registry doesn't copy resources itself. Returns false if _handle,
+  // _replica or _node is invalid.
+  bool Duplicate(Handle _handle, int _node, unique_ptr<_Ty> _replica) {
+    if (_handle == kInvalidHandle || !_replica || _node < 0 ||
+        _node >= kMaxNodes) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    const uint32_t index = _handle - 1;
+    if (index >= size_) {
+      return false;
+    }
+    // Node tables and their pages are allocated on demand, registries that
+    // never duplicate only pay for the table pointer array.
+    NodeTable* table = node_tables_[_node].load(std::memory_order_relaxed);
+    if (!table) {
+      table = ozz::New<NodeTable>();
+      node_tables_[_node].store(table, std::memory_order_release);
+    }
+    Page* page = table->pages[index / kPageSize].load(std::memory_order_relaxed);
+    if (!page) {
+      page = ozz::New<Page>();
+      table->pages[index / kPageSize].store(page, std::memory_order_release);
+    }
+    _Ty* previous = page->slots[index % kPageSize].exchange(
+        _replica.release(), std::memory_order_release);
+    if (previous) {
+      const Retired retired = {previous, epoch_};
+      retired_.push_back(retired);
+    }
+    return true;
+  }
+
+  // Swaps the resource _handle resolves to, for hot-reload use cases. The
+  // handle remains stable, readers see either the previous or the new
+  // resource. The previous resource is retired, and deleted by the second
+  // Collect() call from now. Returns false if _handle or _resource is
+  // invalid.
+  bool Replace(Handle _handle, unique_ptr<_Ty> _resource) {
+    if (_handle == kInvalidHandle || !_resource) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    const uint32_t index = _handle - 1;
+    if (index >= size_) {
+      return false;
+    }
+    Page* page = pages_[index / kPageSize].load(std::memory_order_relaxed);
+    _Ty* previous = page->slots[index % kPageSize].exchange(
+        _resource.release(), std::memory_order_release);
+    const Retired retired = {previous, epoch_};
+    retired_.push_back(retired);
+    return true;
+  }
+
+  // Declares a quiescent point and advances the registry epoch, deleting
+  // resources retired two or more epochs ago. Typically called once per
+  // frame, from a point where update batches of the previous epoch are known
+  // to be complete. Never calling Collect() is valid, replaced resources then
+  // accumulate until destruction.
+  void Collect() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const uint64_t epoch = ++epoch_;
+    size_t kept = 0;
+    for (size_t i = 0; i < retired_.size(); ++i) {
+      if (retired_[i].epoch + 2 <= epoch) {
+        ozz::Delete(retired_[i].resource);
+      } else {
+        retired_[kept++] = retired_[i];
+      }
+    }
+    retired_.resize(kept);
+  }
+
+  // Number of resources added to the registry.
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return size_;
+  }
+
+ private:
+  Registry(const Registry&) = delete;
+  Registry& operator=(const Registry&) = delete;
+
+  // Slots are grouped in fixed size pages allocated on demand. Pages are
+  // never moved nor freed (before destruction), which is what allows readers
+  // to resolve handles without synchronizing with concurrent insertions.
+  enum {
+    kPageSize = 512,
+    kMaxPages = 2048,  // Caps the registry at ~1M resources.
+    kMaxNodes = 8,     // Supported NUMA nodes, plenty for current servers.
+  };
+  struct Page {
+    Page() {
+      for (size_t i = 0; i < kPageSize; ++i) {
+        slots[i].store(nullptr, std::memory_order_relaxed);
+      }
+    }
+    std::atomic<_Ty*> slots[kPageSize];
+  };
+
+  // A resource replaced at a given epoch, awaiting deletion.
+  struct Retired {
+    _Ty* resource;
+    uint64_t epoch;
+  };
+
+  // Per node replica page tables, mirroring the primary table layout so
+  // node-local resolution shares its lock-free properties. Allocated on
+  // demand, see Duplicate().
+  struct NodeTable {
+    NodeTable() {
+      for (size_t i = 0; i < kMaxPages; ++i) {
+        pages[i].store(nullptr, std::memory_order_relaxed);
+      }
+    }
+    std::atomic<Page*> pages[kMaxPages];
+  };
+
+  // Page pointer table, fixed size so it never reallocates.
+  std::atomic<Page*> pages_[kMaxPages];
+
+  // Replica tables, one (lazily allocated) per NUMA node.
+  std::atomic<NodeTable*> node_tables_[kMaxNodes];
+
+  // Serializes mutations. Mutable to allow size() to be const.
+  mutable std::mutex mutex_;
+
+  // All members below are only accessed with mutex_ held.
+
+  // Number of allocated slots.
+  uint32_t size_ = 0;
+
+  // Current reclamation epoch, see Collect().
+  uint64_t epoch_ = 0;
+
+  // Resources awaiting reclamation.
+  ozz::vector<Retired> retired_;
+};
+
+// Registry aliases for the common shared resource types. Track registries can
+// be instantiated the same way, ex: Registry<FloatTrack>.
+typedef Registry<Animation> AnimationRegistry;
+typedef Registry<Skeleton> SkeletonRegistry;
+
+// Hot-reloads the animation _handle resolves to, migrating the live sampling
+// contexts in _contexts that were bound to the previous version. Contexts
+// bound to other animations, and null entries, are left untouched. Migrated
+// contexts keep their cursors when the new animation has the same key layout,
+// and are invalidated otherwise, see SamplingJob::Context::Migrate. Must be
+// called from the loading path, synchronized with the jobs running these
+// contexts. Returns false if Replace() fails, in which case no context is
+// touched.
+inline bool ReplaceAndMigrate(
+    AnimationRegistry& _registry, AnimationRegistry::Handle _handle,
+    unique_ptr<Animation> _animation,
+    const span<SamplingJob::Context* const>& _contexts) {
+  Animation* next = _animation.get();
+  Animation* previous = _registry.Get(_handle);
+  if (!_registry.Replace(_handle, std::move(_animation))) {
+    return false;
+  }
+  for (size_t i = 0; i < _contexts.size(); ++i) {
+    SamplingJob::Context* context = _contexts[i];
+    if (context && context->animation() == previous) {
+      context->Migrate(*next);
+    }
+  }
+  return true;
+}
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_ANIMATION_REGISTRY_H_
@@ -30,8 +30,16 @@
 
 #include "ozz/animation/runtime/export.h"
 #include "ozz/animation/runtime/animation.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/span.h"
 
 namespace ozz {
+
+// Forward declaration of math structures.
+namespace math {
+struct SoaTransform;
+}
+
 namespace animation {
 
 // Count translation, rotation or scale keyframes for a given track number. Use
@@ -42,6 +50,175 @@ OZZ_ANIMATION_DLL int CountRotationKeyframes(const Animation& _animation,
                                              int _track = -1);
 OZZ_ANIMATION_DLL int CountScaleKeyframes(const Animation& _animation,
                                           int _track = -1);
+
+// Fixed-point time ratio, for simulations that need bit-identical sampling
+// across machines (lockstep multiplayer...). Accumulating a float ratio from
+// per-frame deltas rounds differently depending on accumulation history, so
+// peers drift apart. Accumulating an integer tick count is exact, and
+// converting it to a float ratio is a single correctly rounded operation that
+// yields the same value on every IEEE 754 machine.
+// A whole animation spans kFixedRatioOne ticks. It is a power of two small
+// enough that every tick count in range [0, kFixedRatioOne] converts to float
+// losslessly, while still offering sub-microsecond resolution on hours-long
+// clips.
+static const uint32_t kFixedRatioOne = 1u << 24;
+
+// Converts fixed-point ratio _fixed to the float ratio expected by sampling
+// jobs. The conversion is exact (lossless) for any _fixed in range
+// [0, kFixedRatioOne].
+OZZ_ANIMATION_DLL float FixedRatioToFloat(uint32_t _fixed);
+
+// Converts float ratio _ratio, clamped to range [0, 1], to the nearest
+// fixed-point ratio.
+OZZ_ANIMATION_DLL uint32_t FloatToFixedRatio(float _ratio);
+
+// Advances fixed-point ratio _ratio by _delta ticks, negative to play
+// backward. _ratio must be in range [0, kFixedRatioOne]. If _loop is true the
+// result wraps into range [0, kFixedRatioOne[, otherwise it saturates to
+// range [0, kFixedRatioOne]. Stepping only involves integer arithmetic, hence
+// is exact and identical on all machines.
+OZZ_ANIMATION_DLL uint32_t StepFixedRatio(uint32_t _ratio, int _delta,
+                                          bool _loop);
+
+// Samples _animation local-space pose at _ratio without any caller maintained
+// context, for random access workloads (thumbnail rendering, pose baking,
+// optimization...) where sampling coherence doesn't exist and keeping a
+// context alive is just noise. A transient context is set up internally for
+// the duration of the call, seeking straight to _ratio through the animation
+// iframes. _output rules are the ones of SamplingJob. Returns false if
+// _output is empty or _animation has no track. Prefer SamplingJob with a
+// persistent context whenever consecutive ratios are close, as stateless
+// calls always pay a full seek and decompression.
+OZZ_ANIMATION_DLL bool SampleAnimation(const Animation& _animation,
+                                       float _ratio,
+                                       const span<math::SoaTransform>& _output);
+
+// Same as above, with the transient context backed by caller-provided
+// _buffer instead of the default allocator. _buffer must be at least
+// SamplingJob::Context::RequiredSize bytes for _animation track count,
+// aligned on 16 bytes, making the call allocation free (stack or arena
+// buffer). Returns false if _buffer is too small or misaligned.
+OZZ_ANIMATION_DLL bool SampleAnimation(const Animation& _animation,
+                                       float _ratio,
+                                       const span<math::SoaTransform>& _output,
+                                       const span<byte>& _buffer);
+
+// Memory layout profile of one or more animations, used to understand where
+// animation memory goes and to drive optimizer tolerance tuning. Filled by
+// ProfileMemory, which can be called with multiple animations to aggregate a
+// whole animation set into a single profile.
+struct OZZ_ANIMATION_DLL MemoryProfile {
+  // Number of buckets keyframes are distributed into over the animation time
+  // ratio range [0, 1], to expose key density over time.
+  enum { kTimeBuckets = 10 };
+
+  // Breakdown of a single component (translations, rotations or scales).
+  struct OZZ_ANIMATION_DLL Component {
+    // Total size in bytes for this component.
+    size_t size() const {
+      return values_size + ratios_size + previouses_size + iframes_size;
+    }
+
+    // Number of keyframes.
+    size_t keyframes = 0;
+
+    // Size in bytes of compressed keyframe values.
+    size_t values_size = 0;
+
+    // Size in bytes of keyframe time ratios (timepoint indices).
+    size_t ratios_size = 0;
+
+    // Size in bytes of previous keyframe offsets.
+    size_t previouses_size = 0;
+
+    // Size in bytes of iframes (compressed entries and descriptors).
+    size_t iframes_size = 0;
+
+    // Number of keyframes per track, soa padding tracks included. Per track
+    // bytes are keyframes * (values + ratios + previouses per-key cost).
+    ozz::vector<size_t> track_keyframes;
+
+    // Number of keyframes per time ratio bucket, kTimeBuckets buckets.
+    ozz::vector<size_t> time_histogram;
+  };
+
+  // Overall compression ratio, size of the equivalent raw (uncompressed
+  // float) keyframes over runtime size.
+  float compression_ratio() const {
+    return size != 0 ? static_cast<float>(raw_size) / size : 0.f;
+  }
+
+  // Number of animations aggregated into this profile.
+  size_t animations = 0;
+
+  // Total runtime size in bytes, as per Animation::size().
+  size_t size = 0;
+
+  // Size in bytes of the equivalent raw keyframes (float time and
+  // uncompressed float values), before compression and optimization.
+  size_t raw_size = 0;
+
+  // Size in bytes of the time points buffer.
+  size_t timepoints_size = 0;
+
+  // Per component breakdowns.
+  Component translations;
+  Component rotations;
+  Component scales;
+};
+
+// Profiles _animation memory layout and keyframe distribution, accumulating
+// into _profile. Call with every animation of a set to build an aggregated
+// profile.
+OZZ_ANIMATION_DLL void ProfileMemory(const Animation& _animation,
+                                     MemoryProfile* _profile);
+
+// Schedules time-sliced animation updates across a large number of instances.
+// Each instance has an update period (1 / update rate), usually derived from
+// its importance (distance to camera, screen coverage...), and a staleness,
+// the time elapsed since its last full update. Every frame, Update collects
+// the instances whose staleness exceeded their period, most stale first, up
+// to a caller provided budget. Collected instances are expected to be fully
+// updated (sampled) by the caller, others are interpolated from their two
+// stored poses with PoseLerpJob, using Alpha as interpolation coefficient.
+class OZZ_ANIMATION_DLL UpdateScheduler {
+ public:
+  // Resizes the scheduler to _num_instances instances, all with update period
+  // _period (seconds) and a staleness making them immediately due.
+  void Resize(int _num_instances, float _period = 0.f);
+
+  // Gets number of scheduled instances.
+  int num_instances() const { return static_cast<int>(instances_.size()); }
+
+  // Sets _instance update period to _period seconds. A zero period makes the
+  // instance due on every Update call.
+  void set_period(int _instance, float _period);
+
+  // Gets _instance update period.
+  float period(int _instance) const;
+
+  // Advances all instances staleness by _dt seconds and collects those due
+  // for a full update into _updates, most stale first, at most
+  // _updates.size() of them. Collected instances staleness is reset. Returns
+  // the number of instances collected.
+  int Update(float _dt, const span<int>& _updates);
+
+  // Gets the interpolation coefficient for _instance, its staleness over its
+  // period, clamped to range [0, 1]. Suitable as PoseLerpJob alpha between
+  // the last two fully updated poses.
+  float Alpha(int _instance) const;
+
+ private:
+  struct Instance {
+    float period;
+    float staleness;
+  };
+  ozz::vector<Instance> instances_;
+
+  // Due instances collection, a member to reuse its allocation across Update
+  // calls.
+  ozz::vector<int> due_;
+};
 }  // namespace animation
 }  // namespace ozz
 #endif  // OZZ_OZZ_ANIMATION_RUNTIME_ANIMATION_UTILS_H_
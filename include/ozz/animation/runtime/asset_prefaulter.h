@@ -0,0 +1,138 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_ASSET_PREFAULTER_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_ASSET_PREFAULTER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/base/containers/deque.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/platform.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+namespace animation {
+
+class PagedAnimation;
+
+// Warms up memory-mapped asset images before gameplay touches them. Mapped
+// loading (Animation::LoadRaw on a mmapped file) moves load cost from an
+// upfront copy to first-touch page faults, which land in the first sampled
+// frames if unmanaged. The prefaulter touches an image's pages from a
+// background thread, rate limited so warming doesn't saturate the storage or
+// memory bus, and exposes a completion ticket so spawn systems can gate
+// character activation on warm data.
+// Requests are processed in queueing order. For paged clips, the paged
+// overload uses the page directory to only queue the pages the first seconds
+// of playback will touch, in playback order.
+class OZZ_ANIMATION_DLL AssetPrefaulter {
+ public:
+  // Identifies a warm-up request. Tickets are served in order, so a done
+  // ticket implies every earlier one is done too.
+  typedef uint64_t Ticket;
+
+  // The invalid ticket, returned when a request is refused. It is always
+  // "done", so gating on it doesn't deadlock.
+  static const Ticket kInvalidTicket = 0;
+
+  // Builds the prefaulter and starts its background thread.
+  // _bytes_per_second caps the warming rate.
+  explicit AssetPrefaulter(size_t _bytes_per_second = size_t(64) << 20);
+
+  // Abandons requests not yet processed and joins the background thread.
+  // Tickets from this prefaulter must not be queried anymore.
+  ~AssetPrefaulter();
+
+  // Queues prefaulting of _buffer, the mapped image backing an asset
+  // (an Animation::LoadRaw buffer typically). The buffer must remain mapped
+  // until the returned ticket is done (it usually outlives the asset
+  // anyway). Returns kInvalidTicket if _buffer is empty.
+  Ticket Warm(span<const byte> _buffer);
+
+  // Queues prefaulting of the pages of _animation that playback starting at
+  // _from_ratio will touch within _seconds, in playback order, wrapping over
+  // the clip end (looping playback). _page_buffers gives the mapped byte
+  // range backing each page of the clip, in page order, as mapping layout
+  // belongs to the caller. Returns kInvalidTicket if _page_buffers doesn't
+  // provide one buffer per page.
+  Ticket Warm(const PagedAnimation& _animation,
+              span<const span<const byte>> _page_buffers, float _from_ratio,
+              float _seconds);
+
+  // Completion signal: true once every page of _ticket has been touched.
+  bool IsDone(Ticket _ticket) const;
+
+  // Blocks until _ticket is done. Mostly for loading screens and tests,
+  // spawn systems would rather poll IsDone.
+  void Wait(Ticket _ticket);
+
+ private:
+  AssetPrefaulter(const AssetPrefaulter&) = delete;
+  AssetPrefaulter& operator=(const AssetPrefaulter&) = delete;
+
+  // A queued request: the mapped ranges to touch, in order.
+  struct Request {
+    vector<span<const byte>> ranges;
+    Ticket ticket;
+  };
+
+  // Queues _request, waking the background thread up.
+  Ticket Queue(Request&& _request);
+
+  // Background thread entry point.
+  void Run();
+
+  // Warming rate cap, in bytes per second.
+  size_t bytes_per_second_;
+
+  // Pending requests, served front first.
+  deque<Request> pending_;
+
+  // Guards pending_, signaled when requests are queued or quit_ raised.
+  std::mutex mutex_;
+  std::condition_variable condition_;
+
+  // Last ticket issued, guarded by mutex_.
+  Ticket last_issued_ = kInvalidTicket;
+
+  // Last ticket completed by the background thread.
+  std::atomic<Ticket> last_completed_;
+
+  // Raised (under mutex_) to terminate the background thread.
+  bool quit_ = false;
+
+  // The background thread, doing the actual touching.
+  std::thread thread_;
+};
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_ASSET_PREFAULTER_H_
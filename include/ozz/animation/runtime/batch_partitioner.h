@@ -0,0 +1,173 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_BATCH_PARTITIONER_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_BATCH_PARTITIONER_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/platform.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+
+// Forward declares math structures.
+namespace math {
+struct SoaTransform;
+struct Float4x4;
+}  // namespace math
+
+namespace animation {
+
+class Animation;
+class Skeleton;
+
+// Partitions a heterogeneous set of animation instances into buckets of
+// instances sharing the same (skeleton, animation) pair. Batch jobs assume
+// homogeneous trip counts (LocalToModelBatchJob walks a single hierarchy for
+// all instances), which a crowd mixing skeletons cannot provide directly.
+// Partitioning is a flat sort-by-key over an index table, no per-frame node
+// allocation nor map lookups, and internal buffers are reused across calls.
+// Buckets reference ranges of the reordered index table, so per-instance data
+// (ratios, contexts, poses...) stays where the caller owns it, in original
+// instance order.
+class OZZ_ANIMATION_DLL BatchPartitioner {
+ public:
+  // A range of instances sharing the same skeleton and animation, hence the
+  // same trip counts. Instances of a bucket are the indices() table entries
+  // in range [begin, begin + count).
+  struct Bucket {
+    const Skeleton* skeleton;
+    const Animation* animation;
+    int begin;
+    int count;
+  };
+
+  // Partitions instances defined by per-instance skeleton and animation
+  // pointers, both ranges in instance order and of the same size (or no
+  // bucket is emitted). Instances of a bucket keep their relative order.
+  // Returned buckets (also available from buckets()) are valid until the next
+  // Partition call.
+  span<const Bucket> Partition(span<const Skeleton* const> _skeletons,
+                               span<const Animation* const> _animations);
+
+  // Buckets emitted by the last Partition call.
+  span<const Bucket> buckets() const { return make_span(buckets_); }
+
+  // Instance index reorder table, grouping instances of a same bucket
+  // contiguously. Values index the ranges given to the last Partition call.
+  span<const int> indices() const { return make_span(indices_); }
+
+ private:
+  // Sort key of one instance.
+  struct Key {
+    const Skeleton* skeleton;
+    const Animation* animation;
+    int index;
+  };
+
+  // Sort working buffer, retained to avoid per-frame allocations.
+  ozz::vector<Key> keys_;
+
+  // See indices().
+  ozz::vector<int> indices_;
+
+  // See buckets().
+  ozz::vector<Bucket> buckets_;
+};
+
+// Samples every instance of a bucket, forwarding to SamplingBatchJob chunk by
+// chunk. Per-instance inputs and outputs are indexed in original instance
+// order, through the partitioner reorder table, so the caller doesn't have to
+// shuffle its own data to match bucket layout.
+struct OZZ_ANIMATION_DLL SamplingBucketJob {
+  // Validates job parameters. Returns true for a valid job, or false otherwise:
+  // -if bucket is nullptr, or references an invalid indices range.
+  // -if per-instance ranges don't all have the same size.
+  // -if any bucket instance index is out of per-instance ranges.
+  bool Validate() const;
+
+  // Runs job's sampling task for every bucket instance.
+  // The job is validated before any sampling is performed.
+  // Returns false if *this job is not valid, or if sampling fails for a chunk
+  // (nullptr context, context too small... see SamplingBatchJob).
+  bool Run() const;
+
+  // The bucket to process. Its animation is sampled for every instance.
+  const BatchPartitioner::Bucket* bucket = nullptr;
+
+  // Instance index reorder table the bucket was built against, see
+  // BatchPartitioner::indices().
+  span<const int> indices;
+
+  // Per-instance time ratios, in original instance order.
+  span<const float> ratios;
+
+  // Per-instance sampling contexts, in original instance order.
+  span<SamplingJob::Context* const> contexts;
+
+  // Per-instance output ranges, in original instance order.
+  span<const span<math::SoaTransform>> outputs;
+};
+
+// Converts every instance of a bucket to model-space, forwarding to
+// LocalToModelBatchJob chunk by chunk with the bucket skeleton. Per-instance
+// inputs and outputs are indexed in original instance order, like
+// SamplingBucketJob does.
+struct OZZ_ANIMATION_DLL LocalToModelBucketJob {
+  // Validates job parameters. Returns true for a valid job, or false otherwise:
+  // -if bucket is nullptr, has a nullptr skeleton, or references an invalid
+  // indices range.
+  // -if per-instance ranges don't all have the same size.
+  // -if any bucket instance index is out of per-instance ranges.
+  bool Validate() const;
+
+  // Runs job's local-to-model task for every bucket instance.
+  // The job is validated before any operation is performed.
+  // Returns false if *this job is not valid, or if conversion fails for a
+  // chunk (range smaller than the skeleton requires...).
+  bool Run() const;
+
+  // The bucket to process. Its skeleton is shared by every instance.
+  const BatchPartitioner::Bucket* bucket = nullptr;
+
+  // Instance index reorder table the bucket was built against, see
+  // BatchPartitioner::indices().
+  span<const int> indices;
+
+  // Per-instance input ranges of local-space transforms, in original instance
+  // order.
+  span<const span<const math::SoaTransform>> inputs;
+
+  // Per-instance output ranges of model-space matrices, in original instance
+  // order.
+  span<const span<math::Float4x4>> outputs;
+};
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_BATCH_PARTITIONER_H_
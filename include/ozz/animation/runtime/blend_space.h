@@ -0,0 +1,121 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_BLEND_SPACE_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_BLEND_SPACE_H_
+
+#include "ozz/animation/runtime/blending_job.h"
+#include "ozz/animation/runtime/export.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/maths/vec_float.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+namespace animation {
+
+// Maps a 1d or 2d parameter (speed, movement direction...) to blending
+// weights over a set of clips, each clip pinned at a parameter coordinate.
+// The space is triangulated (Delaunay in 2d, sorted segments in 1d) at
+// construction, with simplex adjacency precomputed, so per-frame evaluation
+// is a barycentric computation plus an O(1) simplex walk when queries are
+// coherent (a cursor remembers the last simplex, and parameters move little
+// from one frame to the next). Weights are barycentric coordinates of the
+// parameter in its simplex: at most 3 clips (2 in 1d) get a non zero weight,
+// and weights reproduce the parameter exactly inside the space hull.
+// Parameters outside the hull are clamped to its boundary.
+class OZZ_ANIMATION_DLL BlendSpace {
+ public:
+  // Remembers the simplex a parameter was last found in, the walk start point
+  // of the next query. One cursor per animated character, default constructed
+  // cursors are valid cold starts.
+  struct Cursor {
+    int simplex = 0;
+  };
+
+  // Builds a 1d space from per-clip parameter coordinates. Construction
+  // fails, leaving the space invalid, if _coordinates is empty or holds
+  // duplicated values.
+  explicit BlendSpace(span<const float> _coordinates);
+
+  // Builds a 2d space from per-clip parameter coordinates. Construction
+  // fails, leaving the space invalid, if _coordinates holds duplicated
+  // points, or if points don't span a 2d area (less than 3 points, all
+  // collinear...).
+  explicit BlendSpace(span<const math::Float2> _coordinates);
+
+  // Returns true if construction succeeded. Sampling an invalid space fails.
+  bool valid() const { return valid_; }
+
+  // Number of clips the space was built from.
+  int num_points() const { return static_cast<int>(points_.size()); }
+
+  // Computes per-clip blending weights for _parameter (y is ignored by 1d
+  // spaces), matched with construction coordinates in order. _weights size
+  // must be num_points(), entries outside the parameter simplex are zeroed.
+  // _cursor can be nullptr, losing walk coherency.
+  // Returns false if the space is invalid or if _weights size doesn't match.
+  bool Sample(math::Float2 _parameter, span<float> _weights,
+              Cursor* _cursor = nullptr) const;
+
+  // Same as Sample, but writes weights straight to BlendingJob layers, one
+  // per clip in construction coordinates order.
+  bool Sample(math::Float2 _parameter, span<BlendingJob::Layer> _layers,
+              Cursor* _cursor = nullptr) const;
+
+ private:
+  // A triangle in 2d, a segment in 1d.
+  struct Simplex {
+    // Clip indices of simplex vertices, points[2] is unused in 1d.
+    int points[3];
+
+    // Adjacent simplices, -1 on the space boundary. In 2d, neighbors[i] is
+    // the triangle across the edge opposite to points[i]. In 1d,
+    // neighbors[0/1] are the previous/next segments.
+    int neighbors[3];
+  };
+
+  // Samples simplex weights for _parameter, filling _indices and _weights
+  // with the (up to 3) contributing clips. Returns the number of
+  // contributions, or 0 if the space is invalid.
+  int SampleSimplex(math::Float2 _parameter, Cursor* _cursor, int* _indices,
+                    float* _weights) const;
+
+  // Clip parameter coordinates, in construction order, y is 0 for 1d spaces.
+  ozz::vector<math::Float2> points_;
+
+  // Precomputed triangulation with adjacency.
+  ozz::vector<Simplex> simplices_;
+
+  // Space dimension, 1 or 2.
+  int dimension_;
+
+  // Construction success flag.
+  bool valid_;
+};
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_BLEND_SPACE_H_
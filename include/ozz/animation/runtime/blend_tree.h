@@ -0,0 +1,117 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_BLEND_TREE_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_BLEND_TREE_H_
+
+#include "ozz/animation/runtime/blending_job.h"
+#include "ozz/animation/runtime/export.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+namespace animation {
+
+// Forward declares the Skeleton object, source of the rest pose fallback.
+class Skeleton;
+
+// Precompiled evaluator for a fixed blending topology. Games usually evaluate
+// the same topology (same pose sources, per-joint masks and additive
+// overlays) every frame for every character, with only weights changing.
+// Rebuilding BlendingJob layer arrays and re-validating them each frame is
+// then pure overhead. A BlendTree is built once from a declarative
+// description: layer spans, per-joint weight masks, the skeleton rest pose
+// fallback and the threshold are resolved and validated at construction, so
+// per-frame evaluation reduces to storing weights and running the blend
+// kernels.
+// The tree doesn't own any pose buffer: inputs captured at construction must
+// outlive it, which also means a tree instance is bound to one character.
+class OZZ_ANIMATION_DLL BlendTree {
+ public:
+  // Describes one blend input, aka one layer of the compiled topology.
+  struct Input {
+    // The local-space pose buffer this input blends, usually the output of a
+    // sampling job. Must be at least as big as the skeleton rest pose buffer.
+    span<const math::SoaTransform> transform;
+
+    // Optional per-joint blending weights, with the semantics of
+    // BlendingJob::Layer::joint_weights. Empty disables per-joint weighting.
+    span<const math::SimdFloat4> joint_weights;
+
+    // True for layers blended additively on top of the normalized output.
+    bool additive = false;
+  };
+
+  // Compiles the topology described by _inputs for _skeleton. _threshold has
+  // the semantics of BlendingJob::threshold, defaulting to the same value.
+  // Inputs are captured in order, evaluation weights use that same order.
+  // Construction can fail, leaving the tree invalid, if any input buffer is
+  // smaller than the skeleton rest pose, or if _threshold isn't positive.
+  BlendTree(const Skeleton& _skeleton, const span<const Input>& _inputs,
+            float _threshold = .1f);
+
+  // Returns true if construction succeeded. Running an invalid tree fails.
+  bool valid() const { return valid_; }
+
+  // Number of inputs the tree was compiled from.
+  int num_inputs() const { return static_cast<int>(weight_slots_.size()); }
+
+  // Evaluates the blend, writing the result to _output. _weights are matched
+  // with construction inputs in order, so its size must be num_inputs().
+  // Negative weights are considered as 0.
+  // Returns false if the tree is invalid, if _weights size doesn't match
+  // num_inputs(), or if _output is smaller than the skeleton rest pose.
+  bool Run(const span<const float>& _weights,
+           const span<math::SoaTransform>& _output);
+
+ private:
+  // Maps an input to the compiled layer its weight must be stored to.
+  struct WeightSlot {
+    uint16_t index;  // Index within the (additive or not) layer vector.
+    bool additive;
+  };
+
+  // The skeleton the tree was compiled for, providing the rest pose fallback.
+  const Skeleton* skeleton_;
+
+  // Pre-resolved layers, split as BlendingJob expects them. Only weights are
+  // written at evaluation time.
+  vector<BlendingJob::Layer> layers_;
+  vector<BlendingJob::Layer> additive_layers_;
+
+  // Per-input weight storage location, in construction order.
+  vector<WeightSlot> weight_slots_;
+
+  // Blending threshold, see BlendingJob::threshold.
+  float threshold_;
+
+  // Construction success flag.
+  bool valid_;
+};
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_BLEND_TREE_H_
@@ -39,6 +39,10 @@ namespace math {
 struct SoaTransform;
 }
 
+// Forward declares the validate-once job handle, see base/compiled_job.h.
+template <typename _Job>
+class CompiledJob;
+
 namespace animation {
 
 // ozz::animation::BlendingJob is in charge of blending (mixing) multiple poses
@@ -74,6 +78,21 @@ struct OZZ_ANIMATION_DLL BlendingJob {
   // Returns false if *this job is not valid.
   bool Run() const;
 
+ private:
+  // BlendTree evaluates pre-validated jobs, skipping per-run validation.
+  friend class BlendTree;
+  friend class ozz::CompiledJob<BlendingJob>;
+
+  // Runs job's blending task, skipping validation. To be used through a
+  // CompiledJob handle, which maintains job validity.
+  void RunValidated() const;
+
+  // Runs the blending task of an already validated job. This is the
+  // implementation of Run(), available to friends that maintain job validity
+  // across runs.
+  static void RunValidated(const BlendingJob& _job);
+
+ public:
   // Defines a layer of blending input data (local space transforms) and
   // parameters (weights).
   struct OZZ_ANIMATION_DLL Layer {
@@ -112,6 +131,16 @@ struct OZZ_ANIMATION_DLL BlendingJob {
   // Must be greater than 0.f.
   float threshold;
 
+  // Defines the range [from, to[ of soa transform blocks to blend, mirroring
+  // LocalToModelJob's partial update range. Values are soa block indices (4
+  // joints per block), clamped to the rest pose buffer size. Default values
+  // process the whole pose. Blocks outside the range are left untouched in
+  // the output, so separate body regions (upper/lower body typically) can be
+  // blended independently, possibly from different threads, into the same
+  // output pose, the join happening naturally at the local-to-model stage.
+  int from;
+  int to;
+
   // Job input layers, can be empty or nullptr.
   // The range of layers that must be blended.
   span<const Layer> layers;
@@ -134,6 +163,35 @@ struct OZZ_ANIMATION_DLL BlendingJob {
   // transforms defined by the rest pose buffer size will be processed.
   span<ozz::math::SoaTransform> output;
 };
+
+// Applies additive layers (recoil, breathing...) directly onto an existing
+// local-space pose, in place. This is equivalent to running a BlendingJob
+// with a single full-weight base layer plus these additive layers, without
+// paying the base copy, weight accumulation and normalization stages, nor a
+// separate output buffer.
+struct OZZ_ANIMATION_DLL ApplyAdditiveJob {
+  // Validates job parameters.
+  // Returns true for a valid job, false otherwise:
+  // -if any layer is not valid, see BlendingJob layers validation.
+  // -if any layer buffer is smaller than the pose buffer.
+  bool Validate() const;
+
+  // Runs job's additive task.
+  // The job is validated before any operation is performed, see Validate()
+  // for more details.
+  // Returns false if *this job is not valid.
+  bool Run() const;
+
+  // Job input layers, can be empty or nullptr.
+  // The range of layers to apply additively, with the semantics (weights,
+  // optional per-joint weights, negative weights subtracting) of
+  // BlendingJob::additive_layers.
+  span<const BlendingJob::Layer> layers;
+
+  // Job input and output: the local-space pose layers are applied to. Its
+  // size defines the number of transforms to process.
+  span<ozz::math::SoaTransform> pose;
+};
 }  // namespace animation
 }  // namespace ozz
 #endif  // OZZ_OZZ_ANIMATION_RUNTIME_BLENDING_JOB_H_
@@ -0,0 +1,237 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_CHARACTER_UPDATE_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_CHARACTER_UPDATE_H_
+
+#include "ozz/animation/runtime/animation_pipeline.h"
+#include "ozz/animation/runtime/blending_job.h"
+#include "ozz/animation/runtime/export.h"
+#include "ozz/animation/runtime/local_to_model_job.h"
+#include "ozz/animation/runtime/pose_codec.h"
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/base/compiled_job.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/memory/unique_ptr.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+
+// Forward declares the task scheduler interface.
+class Scheduler;
+
+namespace animation {
+
+// Forward declaration of runtime animation and skeleton types.
+class Animation;
+class Skeleton;
+
+// Reference implementation of the per-frame character update chain, sample ->
+// blend -> pose modification (IK...) -> local-to-model, over a batch of
+// instances sharing a skeleton. Assembling the chain by hand is where
+// recurring performance mistakes creep in: per-frame job validation, one heap
+// allocation per buffer per instance, or a synchronization point between
+// stages. This module owns the hardened assembly so applications only fill
+// per-frame layer parameters (animation, time ratio, weight):
+// - all intermediate buffers (per-layer local poses, blended pose, model
+//   space matrices) are pooled into one allocation per kind at Initialize
+//   time, instances laid out contiguously.
+// - jobs whose setup is immutable across frames (local-to-model) are compiled
+//   once (see base/compiled_job.h), so release builds skip their validation
+//   entirely.
+// - stages run through an AnimationPipeline: an instance executes its whole
+//   chain back to back on one thread, keeping its pose buffers hot in cache,
+//   and the batch distributes across an optional Scheduler without a join
+//   between stages.
+// Each stage is timed (total cpu time across all instances and threads), and
+// checked against an optional per-stage budget: an exceeded budget is flagged
+// through the exceeded() accessor and a log warning. The check is a soft
+// assertion, it reports rather than aborts, so a frame spike doesn't take an
+// assert-enabled build down.
+// Skinning isn't part of the chain as mesh data isn't an animation runtime
+// concept: models() exposes the model-space palette geometry::SkinningJob
+// consumes, and an extra stage can be fused through the pose modifier hook.
+class OZZ_ANIMATION_DLL CharacterUpdate {
+ public:
+  // Update stages, in execution order. kPose only runs when a pose modifier
+  // is provided.
+  enum Stage { kSample, kBlend, kPose, kLocalToModel, kNumStages };
+
+  // Per-instance animation layer, to refresh before each Run. A layer with no
+  // animation, or a weight <= 0, isn't sampled nor blended.
+  struct Layer {
+    // Animation to sample, nullptr disables the layer. The animation must
+    // match the skeleton the module was initialized with.
+    const Animation* animation = nullptr;
+
+    // Sampling time ratio, in the unit interval [0, 1].
+    float ratio = 0.f;
+
+    // Blending weight of the layer.
+    float weight = 0.f;
+  };
+
+  // Initialization parameters.
+  struct Setup {
+    // Skeleton all instances share. Must remain valid until *this is
+    // re-initialized or destroyed.
+    const Skeleton* skeleton = nullptr;
+
+    // Number of character instances.
+    int num_instances = 0;
+
+    // Number of animation layers per instance. Must be greater than 0.
+    int num_layers = 0;
+
+    // Optional scheduler instances are distributed across. nullptr runs the
+    // whole batch on the calling thread.
+    Scheduler* scheduler = nullptr;
+
+    // Number of instances each scheduler task processes, see
+    // AnimationPipeline::granularity.
+    int granularity = 1;
+
+    // Optional pose modification stage (IK, look-at, procedural noise...),
+    // fused between blending and local-to-model. The function receives
+    // pose_context and the instance index, and can modify the instance
+    // locals() buffer in place. It must support concurrent invocations for
+    // different instances.
+    AnimationPipeline::StageFn pose_fn = nullptr;
+    void* pose_context = nullptr;
+
+    // Blending threshold, see BlendingJob::threshold.
+    float threshold = .1f;
+
+    // Optional per-stage cpu time budgets, in microseconds, 0 (the default)
+    // disables the check. A budget covers the stage's total cpu time across
+    // all instances and threads for one Run.
+    float budgets[kNumStages] = {};
+  };
+
+  CharacterUpdate();
+  ~CharacterUpdate();
+
+  // Allocates pooled buffers and compiles immutable jobs for _setup. Returns
+  // false, leaving *this uninitialized, if the setup is invalid: no skeleton,
+  // negative instance count or no layer.
+  bool Initialize(const Setup& _setup);
+
+  // Runs the whole chain for every instance. Returns false if *this isn't
+  // initialized, or if any stage failed, which is a setup issue (a layer
+  // animation not matching the skeleton...) as compute stages don't fail.
+  bool Run();
+
+  // Per-frame layer parameters for instance _instance, to fill before Run.
+  span<Layer> layers(int _instance);
+
+  // Blended local-space pose of instance _instance, valid after Run. Mutable
+  // so a pose modifier stage can process it in place.
+  span<math::SoaTransform> locals(int _instance);
+
+  // Model-space matrices of instance _instance, valid after Run. This is the
+  // palette to feed skinning with, once multiplied with inverse bind-pose
+  // matrices.
+  span<const math::Float4x4> models(int _instance) const;
+
+  // Visibility culling hooks. Freeze takes _instance out of the update: Run
+  // skips all its stages, and its blended pose is stored compactly (see
+  // PoseSnapshotCodec) at freeze time. The caller keeps advancing layer
+  // parameters while frozen, as if the instance were visible, so its logical
+  // timeline progresses. Thaw puts the instance back: the frozen pose is
+  // decoded back to locals(), making the instance consistent immediately, and
+  // the next Run performs the catch-up evaluation at the caller's current
+  // layer ratios, which resumes without popping since timelines kept
+  // advancing. Sampling contexts are deliberately left untouched across the
+  // whole cycle: a catch-up after a long freeze seeks through the animation
+  // iframes (cache restore points) instead of the cold per-track cursor walk,
+  // and a short freeze stays on the incremental path.
+  // While frozen, locals() and models() keep their last evaluated content,
+  // but the authoritative pose is the snapshot, restored on Thaw: a pose
+  // modifier must not rely on writes made to a frozen instance buffers.
+  // Freezing an already frozen instance or thawing a running one is a no-op.
+  void Freeze(int _instance);
+  void Thaw(int _instance);
+
+  // True if _instance is currently frozen.
+  bool frozen(int _instance) const;
+
+  // Total cpu time spent in _stage across all instances and threads during
+  // the last Run, in microseconds.
+  float duration(Stage _stage) const { return durations_[_stage]; }
+
+  // True if _stage exceeded its configured budget during the last Run.
+  bool exceeded(Stage _stage) const { return exceeded_[_stage]; }
+
+ private:
+  CharacterUpdate(const CharacterUpdate&) = delete;
+  CharacterUpdate& operator=(const CharacterUpdate&) = delete;
+
+  // Stage implementations, running one stage for one instance.
+  bool Sample(int _instance);
+  bool Blend(int _instance);
+  bool LocalToModel(int _instance);
+
+  // Initialization parameters, skeleton_ is nullptr until initialized.
+  Setup setup_;
+
+  // Sampling contexts, one per layer per instance. Contexts aren't copyable,
+  // hence the indirection.
+  vector<unique_ptr<SamplingJob::Context>> contexts_;
+
+  // Per-frame layer parameters, num_layers per instance.
+  vector<Layer> layers_;
+
+  // Pooled intermediate buffers, instances laid out contiguously: sampled
+  // local poses (one per layer per instance), blended local poses and model
+  // space matrices (one per instance).
+  vector<math::SoaTransform> locals_;
+  vector<math::SoaTransform> blended_;
+  vector<math::Float4x4> models_;
+
+  // Blending layers scratch, rebuilt each Run, num_layers per instance.
+  vector<BlendingJob::Layer> blend_layers_;
+
+  // Local-to-model jobs, compiled once at initialization time as their setup
+  // never changes.
+  vector<CompiledJob<LocalToModelJob>> ltm_jobs_;
+
+  // Per-instance freeze state. Snapshot storage (one compact frozen pose per
+  // instance, max_encoded_size apart) is allocated on first Freeze, so the
+  // feature is free until used.
+  vector<bool> frozen_;
+  PoseSnapshotCodec snapshot_codec_;
+  vector<byte> snapshots_;
+  vector<size_t> snapshot_sizes_;
+
+  // Last Run per-stage timings (microseconds) and budget check results.
+  float durations_[kNumStages] = {};
+  bool exceeded_[kNumStages] = {};
+};
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_CHARACTER_UPDATE_H_
@@ -0,0 +1,153 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_DYNAMIC_TRACK_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_DYNAMIC_TRACK_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/animation/runtime/track.h"
+#include "ozz/animation/runtime/track_sampling_job.h"
+#include "ozz/base/containers/string.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+namespace ozz {
+namespace animation {
+
+namespace internal {
+
+// Editable user-channel track, for live editing tools (cutscene editors,
+// curve tweaking...) that modify keyframes interactively. Unlike the
+// immutable Track, keyframes can be inserted, removed and moved in place:
+// every edit incrementally maintains the sorted ratio array and the step
+// bitset, instead of round-tripping through a RawTrack and the TrackBuilder
+// rebuild (and its allocations) at every change.
+// A DynamicTrack always satisfies the invariants sampling relies on: at
+// least 2 keyframes, sorted ratios in range [0,1], with boundary keyframes
+// at ratios 0 and 1. Boundary keyframes can be edited but not removed. It
+// exposes the same keyframe accessors as the immutable Track, so it can be
+// sampled directly (see DynamicFloatTrackSamplingJob and siblings below),
+// and bakes to an immutable track for shipping.
+template <typename _ValueType>
+class OZZ_ANIMATION_DLL DynamicTrack {
+ public:
+  typedef _ValueType ValueType;
+
+  // Builds a default track: identity value, linear boundary keyframes.
+  DynamicTrack() { Reset(); }
+
+  // Keyframe accessors, same interface as the immutable Track.
+  span<const float> ratios() const { return make_span(ratios_); }
+  span<const _ValueType> values() const { return make_span(values_); }
+  span<const uint8_t> steps() const { return make_span(steps_); }
+
+  // Get track name.
+  const char* name() const { return name_.c_str(); }
+  void set_name(const char* _name) { name_ = _name; }
+
+  // Number of keyframes, boundary keyframes included.
+  size_t num_keys() const { return ratios_.size(); }
+
+  // Inserts a keyframe and returns its index. _ratio is clamped to [0,1],
+  // and the keyframe is inserted after any existing keyframe with the same
+  // ratio. _step selects step interpolation mode (as opposed to linear) for
+  // the interval this keyframe opens.
+  size_t AddKey(float _ratio, const _ValueType& _value, bool _step = false);
+
+  // Removes the keyframe at _index. Returns false if _index is out of range
+  // or points to a boundary (first or last) keyframe.
+  bool RemoveKey(size_t _index);
+
+  // Moves the keyframe at _index to _ratio (clamped to [0,1]), preserving
+  // its value and interpolation mode, and returns its new index. Returns
+  // num_keys(), aka an invalid index, if _index is out of range or points to
+  // a boundary keyframe.
+  size_t MoveKey(size_t _index, float _ratio);
+
+  // Overwrites the value of the keyframe at _index. Returns false if _index
+  // is out of range.
+  bool SetValue(size_t _index, const _ValueType& _value);
+
+  // Overwrites the interpolation mode of the keyframe at _index. Returns
+  // false if _index is out of range.
+  bool SetStep(size_t _index, bool _step);
+
+  // Resets the track to its default state, releasing no memory so a long
+  // editing session doesn't churn the heap.
+  void Reset();
+
+  // Copies _source keyframes and name, so an already built (shipped) track
+  // can be brought back to editing.
+  void Assign(const Track<_ValueType>& _source);
+
+  // Bakes to an immutable track for shipping. _Track must be the concrete
+  // runtime track type of the same ValueType, ex:
+  //   dynamic_track.Bake<FloatTrack>();
+  template <typename _Track>
+  unique_ptr<_Track> Bake() const;
+
+ private:
+  // Keyframe ratios, values and modes, mirroring the immutable Track layout
+  // (1 step bit per key) so accessors can expose the same views.
+  ozz::vector<float> ratios_;
+  ozz::vector<_ValueType> values_;
+  ozz::vector<uint8_t> steps_;
+
+  // Track name.
+  ozz::string name_;
+};
+}  // namespace internal
+
+// Editable track instantiations, mirroring the immutable ones.
+class OZZ_ANIMATION_DLL DynamicFloatTrack
+    : public internal::DynamicTrack<float> {};
+class OZZ_ANIMATION_DLL DynamicFloat2Track
+    : public internal::DynamicTrack<math::Float2> {};
+class OZZ_ANIMATION_DLL DynamicFloat3Track
+    : public internal::DynamicTrack<math::Float3> {};
+class OZZ_ANIMATION_DLL DynamicFloat4Track
+    : public internal::DynamicTrack<math::Float4> {};
+class OZZ_ANIMATION_DLL DynamicQuaternionTrack
+    : public internal::DynamicTrack<math::Quaternion> {};
+
+// Sampling jobs over editable tracks, behaving like their immutable
+// counterparts from track_sampling_job.h. Editing doesn't invalidate a
+// sampling context: the cached interval is validated against track ratios at
+// every sample.
+struct OZZ_ANIMATION_DLL DynamicFloatTrackSamplingJob
+    : public internal::TrackSamplingJob<DynamicFloatTrack> {};
+struct OZZ_ANIMATION_DLL DynamicFloat2TrackSamplingJob
+    : public internal::TrackSamplingJob<DynamicFloat2Track> {};
+struct OZZ_ANIMATION_DLL DynamicFloat3TrackSamplingJob
+    : public internal::TrackSamplingJob<DynamicFloat3Track> {};
+struct OZZ_ANIMATION_DLL DynamicFloat4TrackSamplingJob
+    : public internal::TrackSamplingJob<DynamicFloat4Track> {};
+struct OZZ_ANIMATION_DLL DynamicQuaternionTrackSamplingJob
+    : public internal::TrackSamplingJob<DynamicQuaternionTrack> {};
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_DYNAMIC_TRACK_H_
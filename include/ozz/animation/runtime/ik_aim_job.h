@@ -30,6 +30,7 @@
 
 #include "ozz/animation/runtime/export.h"
 #include "ozz/base/platform.h"
+#include "ozz/base/span.h"
 
 #include "ozz/base/maths/simd_math.h"
 
@@ -96,6 +97,12 @@ struct OZZ_ANIMATION_DLL IKAimJob {
   // blend / interpolate from no IK applied (0 weight) to full IK (1).
   float weight;
 
+  // Selects estimated (faster, lower precision) transcendental math functions
+  // to build the correction quaternion. Error remains below 1e-3 radian, which
+  // is usually acceptable when solving at crowd scale. twist_angle must be
+  // within [-2pi, 2pi] range when enabled. Default is false (full precision).
+  bool estimated;
+
   // Joint model-space matrix.
   const math::Float4x4* joint;
 
@@ -110,6 +117,62 @@ struct OZZ_ANIMATION_DLL IKAimJob {
   // joint and offset position.
   bool* reached;
 };
+
+// Batched variant of IKAimJob, solving any number of independent joints (one
+// per character when running crowds) aiming at a single shared target, the
+// highest volume aim scenario (a stadium of heads tracking one ball). Rig
+// parameters (forward, offset, up, pole_vector and twist_angle) are shared by
+// all instances. Per-instance inputs and outputs are packed in parallel
+// arrays: instance i is made of joints[i], optional weights[i] and outputs
+// correction i. Results are identical to running IKAimJob on each joint,
+// batching amortizes validation and setup, and keeps memory accesses
+// contiguous. Use estimated mode to trade precision for speed at crowd scale.
+struct OZZ_ANIMATION_DLL IKAimBatchJob {
+  // Constructor, initializes default values.
+  IKAimBatchJob();
+
+  // Validates job parameters. Returns true for a valid job, or false
+  // otherwise:
+  // -if forward isn't normalized.
+  // -if output corrections span is smaller than joints one.
+  // -if weights or reached aren't empty nor joints sized.
+  bool Validate() const;
+
+  // Runs job's execution task. See IKAimJob for more details.
+  // Returns false if *this job is not valid.
+  bool Run() const;
+
+  // Job input.
+
+  // Per-instance model-space joint matrices. Defines the number of instances
+  // to solve.
+  span<const math::Float4x4> joints;
+
+  // Optional per-instance IK weights, overriding the shared weight. Leave
+  // empty to apply weight to every instance, otherwise it must be joints
+  // sized.
+  span<const float> weights;
+
+  // Aim parameters, shared by all instances. See IKAimJob for details.
+  math::SimdFloat4 target;
+  math::SimdFloat4 forward;
+  math::SimdFloat4 offset;
+  math::SimdFloat4 up;
+  math::SimdFloat4 pole_vector;
+  float twist_angle;
+  float weight;
+  bool estimated;
+
+  // Job output.
+
+  // Per-instance local-space correction quaternions. Must be at least joints
+  // sized.
+  span<math::SimdQuaternion> joint_corrections;
+
+  // Optional per-instance reachability output. Leave empty if not needed,
+  // otherwise it must be joints sized.
+  span<bool> reached;
+};
 }  // namespace animation
 }  // namespace ozz
 #endif  // OZZ_OZZ_ANIMATION_RUNTIME_IK_AIM_JOB_H_
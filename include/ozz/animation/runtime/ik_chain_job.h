@@ -0,0 +1,129 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_IK_CHAIN_JOB_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_IK_CHAIN_JOB_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/base/platform.h"
+#include "ozz/base/span.h"
+
+#include "ozz/base/maths/simd_math.h"
+
+namespace ozz {
+// Forward declaration of math structures.
+namespace math {
+struct SimdQuaternion;
+}
+
+namespace animation {
+
+// ozz::animation::IKChainJob performs inverse kinematic on a joint chain of
+// arbitrary length (spine, tail...), using a cyclic coordinate descent (CCD)
+// solver. The job computes the rotations that need to be applied to every
+// joint of the chain (except the last one, the end effector) such that the end
+// effector reaches the provided target position (if possible). All
+// intermediate model-space updates are performed internally (incrementally, on
+// joint positions and rotations), so a single LocalToModelJob update is needed
+// once corrections have been applied, where chaining IKTwoBoneJob or IKAimJob
+// per segment would require one in between every link.
+// The chain joints must be ordered from the closest to the root down to the
+// end effector. They must be ancestors, but don't need to be direct ancestors
+// (joints in-between will simply remain fixed).
+// Per joint rotation limits can optionally be provided, clamping the total
+// corrected angle of each joint relative to its chain parent.
+struct OZZ_ANIMATION_DLL IKChainJob {
+  // Maximum number of joints in the chain, including the end effector. The
+  // solver maintains its transient chain state (positions, rotations) on the
+  // stack to avoid any allocation, which caps supported chain length.
+  enum { kMaxChainLength = 16 };
+
+  // Constructor, initializes default values.
+  IKChainJob();
+
+  // Validates job parameters. Returns true for a valid job, or false
+  // otherwise:
+  // -if the chain has less than 2 joints, or more than kMaxChainLength.
+  // -if joint_corrections hasn't a correction per joint (chain size - 1, the
+  // end effector isn't rotated).
+  // -if joint_limits isn't empty nor sized like joint_corrections.
+  // -if iterations isn't greater than 0.
+  bool Validate() const;
+
+  // Runs job's execution task.
+  // The job is validated before any operation is performed, see Validate() for
+  // more details.
+  // Returns false if *this job is not valid.
+  bool Run() const;
+
+  // Job input.
+
+  // Target IK position, in model-space. This is the position the chain end
+  // effector will try to reach.
+  math::SimdFloat4 target;
+
+  // Model-space matrices of the chain joints, ordered from the closest to the
+  // root down to the end effector. At least 2 joints (a single bone) are
+  // required, at most kMaxChainLength are supported.
+  span<const math::Float4x4> joints;
+
+  // Optional per joint rotation limits, as a maximum correction angle in
+  // radians for each joint of the chain but the end effector. The angle limits
+  // the total correction of a joint relatively to its chain parent, not a per
+  // iteration step. Leave empty for unlimited rotations, otherwise it must
+  // have joints size - 1 elements.
+  span<const float> joint_limits;
+
+  // Maximum number of CCD iterations. The solver early outs as soon as the
+  // end effector is within tolerance of the target. Default is 10.
+  int iterations;
+
+  // Distance to the target below which the end effector is considered to have
+  // reached it, stopping iterations. Default is 1e-3.
+  float tolerance;
+
+  // Weight given to the IK correction clamped in range [0,1]. This allows to
+  // blend / interpolate from no IK applied (0 weight) to full IK (1).
+  float weight;
+
+  // Job output.
+
+  // Local-space corrections to apply to the chain joints (but the end
+  // effector) in order for the end effector to reach target position.
+  // These quaternions must be multiplied to the local-space quaternion of
+  // their respective joints. Must have at least joints size - 1 elements.
+  span<math::SimdQuaternion> joint_corrections;
+
+  // Optional boolean output value, set to true if target can be reached with
+  // IK computations. Reachability is driven by chain length, joint limits,
+  // iterations count and target distance. Target is considered unreached if
+  // weight is less than 1.
+  bool* reached;
+};
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_IK_CHAIN_JOB_H_
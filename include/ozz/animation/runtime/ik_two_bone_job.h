@@ -30,6 +30,7 @@
 
 #include "ozz/animation/runtime/export.h"
 #include "ozz/base/platform.h"
+#include "ozz/base/span.h"
 
 #include "ozz/base/maths/simd_math.h"
 
@@ -103,6 +104,13 @@ struct OZZ_ANIMATION_DLL IKTwoBoneJob {
   // blend / interpolate from no IK applied (0 weight) to full IK (1).
   float weight;
 
+  // Selects estimated (faster, lower precision) transcendental math functions
+  // to solve the chain. Error on correction quaternion angles remains below
+  // 1e-3 radian, which is usually acceptable when solving at crowd scale.
+  // twist_angle must be within [-2pi, 2pi] range when enabled. Default is
+  // false (full precision).
+  bool estimated;
+
   // Model-space matrices of the start, middle and end joints of the chain.
   // The 3 joints should be ancestors. They don't need to be direct
   // ancestors though.
@@ -124,6 +132,62 @@ struct OZZ_ANIMATION_DLL IKTwoBoneJob {
   // target distance. Target is considered unreached if weight is less than 1.
   bool* reached;
 };
+
+// Batched variant of IKTwoBoneJob, solving any number of independent chains
+// (one per character when running crowds) in a single call. Chain parameters
+// (mid_axis, pole_vector, twist_angle, soften and weight) are shared by all
+// chains, as they usually depend on the rig, not on the instance. Per chain
+// inputs and outputs are packed in parallel arrays: chain i is made of
+// targets[i], start/mid/end_joints[i] and outputs corrections i. Results are
+// identical to running IKTwoBoneJob on each chain, batching amortizes
+// validation and setup, and keeps memory accesses contiguous.
+struct OZZ_ANIMATION_DLL IKTwoBoneBatchJob {
+  // Constructor, initializes default values.
+  IKTwoBoneBatchJob();
+
+  // Validates job parameters. Returns true for a valid job, or false
+  // otherwise:
+  // -if mid_axis isn't normalized.
+  // -if per-chain input spans don't all have the same size.
+  // -if output spans are smaller than input ones, or reached isn't empty nor
+  // input sized.
+  bool Validate() const;
+
+  // Runs job's execution task. See IKTwoBoneJob for more details.
+  // Returns false if *this job is not valid.
+  bool Run() const;
+
+  // Job input.
+
+  // Per-chain target IK positions, in each chain model-space. Defines the
+  // number of chains to solve.
+  span<const math::SimdFloat4> targets;
+
+  // Per-chain model-space matrices of the start, middle and end joints. Must
+  // all be targets sized.
+  span<const math::Float4x4> start_joints;
+  span<const math::Float4x4> mid_joints;
+  span<const math::Float4x4> end_joints;
+
+  // Chain parameters, shared by all chains. See IKTwoBoneJob for details.
+  math::SimdFloat4 mid_axis;
+  math::SimdFloat4 pole_vector;
+  float twist_angle;
+  float soften;
+  float weight;
+  bool estimated;
+
+  // Job output.
+
+  // Per-chain local-space corrections to apply to start and middle joints.
+  // Must be at least targets sized.
+  span<math::SimdQuaternion> start_joint_corrections;
+  span<math::SimdQuaternion> mid_joint_corrections;
+
+  // Optional per-chain reachability output. Leave empty if not needed,
+  // otherwise it must be targets sized.
+  span<bool> reached;
+};
 }  // namespace animation
 }  // namespace ozz
 #endif  // OZZ_OZZ_ANIMATION_RUNTIME_IK_TWO_BONE_JOB_H_
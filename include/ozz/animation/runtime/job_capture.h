@@ -0,0 +1,149 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_JOB_CAPTURE_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_JOB_CAPTURE_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/io/archive_traits.h"
+#include "ozz/base/platform.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+namespace animation {
+
+// Forward declares the captured job descriptors.
+struct SamplingJob;
+struct BlendingJob;
+struct LocalToModelJob;
+
+// Records the input descriptors of runtime jobs as they are run in
+// production, so the workload of a captured frame can be re-executed offline
+// for profiling (see the ozz_job_replay benchmark tool). Capture is opt-in:
+// the application owns a JobCapture instance and hands each job descriptor
+// over, right before running it, whenever capture is armed.
+// Jobs are plain descriptors (spans and PODs), so a capture records their
+// scalar parameters and the identity and shape of referenced assets
+// (animation name hash and track count, skeleton structural hash and joint
+// count...), not buffer contents. The log is compact enough to be flushed
+// from a live session, and the replay tool rebuilds synthetic assets of the
+// captured shapes.
+class OZZ_ANIMATION_DLL JobCapture {
+ public:
+  // Captured SamplingJob descriptor.
+  struct Sampling {
+    uint32_t animation_id;  // CRC32C of the animation name.
+    int num_tracks;         // Animation number of tracks.
+    float duration;         // Animation duration, in seconds.
+    float ratio;            // Sampling time ratio.
+    int num_output_soa;     // Output buffer size, in soa elements.
+    bool has_joint_mask;    // A joint mask was provided.
+    bool deterministic;     // Deterministic sampling was requested.
+    int components;         // Sampled components mask.
+  };
+
+  // Captured BlendingJob layer descriptor, additive layers included.
+  struct BlendingLayer {
+    float weight;            // Layer blending weight.
+    bool additive;           // Layer comes from the additive layers range.
+    bool has_joint_weights;  // Per-joint weights were provided.
+  };
+
+  // Captured BlendingJob descriptor. Layers are stored contiguously for all
+  // captured blending jobs, this descriptor references its range.
+  struct Blending {
+    float threshold;     // Normalization threshold.
+    int num_output_soa;  // Output buffer size, in soa elements.
+    int first_layer;     // Index of the first layer in layers().
+    int num_layers;      // Number of layers, additive ones included.
+  };
+
+  // Captured LocalToModelJob descriptor.
+  struct LocalToModel {
+    uint32_t skeleton_id;  // Skeleton structural hash.
+    int num_joints;        // Skeleton number of joints.
+    int from;              // Conversion range begin joint.
+    int to;                // Conversion range end joint.
+    bool from_excluded;    // "from" joint update was excluded.
+    bool has_root;         // A root matrix was provided.
+    bool has_joint_mask;   // A joint mask was provided.
+  };
+
+  JobCapture() {}
+
+  // Records _job descriptor. The job isn't run nor validated, capturing an
+  // invalid descriptor is allowed and replay will skip it.
+  void Capture(const SamplingJob& _job);
+  void Capture(const BlendingJob& _job);
+  void Capture(const LocalToModelJob& _job);
+
+  // Captured descriptors, in capture order per job type.
+  span<const Sampling> sampling_jobs() const {
+    return make_span(sampling_jobs_);
+  }
+  span<const Blending> blending_jobs() const {
+    return make_span(blending_jobs_);
+  }
+  span<const BlendingLayer> layers() const { return make_span(layers_); }
+  span<const LocalToModel> local_to_model_jobs() const {
+    return make_span(local_to_model_jobs_);
+  }
+
+  // Total number of captured jobs, all types included.
+  size_t num_jobs() const {
+    return sampling_jobs_.size() + blending_jobs_.size() +
+           local_to_model_jobs_.size();
+  }
+
+  // Discards all captured descriptors, keeping allocations for reuse.
+  void Clear();
+
+  // Serialization functions.
+  // Should not be called directly but through io::Archive << and >>
+  // operators.
+  void Save(ozz::io::OArchive& _archive) const;
+  void Load(ozz::io::IArchive& _archive, uint32_t _version);
+
+ private:
+  JobCapture(const JobCapture&) = delete;
+  JobCapture& operator=(const JobCapture&) = delete;
+
+  // Captured descriptors, per job type.
+  vector<Sampling> sampling_jobs_;
+  vector<Blending> blending_jobs_;
+  vector<BlendingLayer> layers_;
+  vector<LocalToModel> local_to_model_jobs_;
+};
+}  // namespace animation
+
+namespace io {
+OZZ_IO_TYPE_VERSION(1, animation::JobCapture)
+OZZ_IO_TYPE_TAG("ozz-job_capture", animation::JobCapture)
+}  // namespace io
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_JOB_CAPTURE_H_
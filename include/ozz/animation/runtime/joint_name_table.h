@@ -0,0 +1,108 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_JOINT_NAME_TABLE_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_JOINT_NAME_TABLE_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+namespace animation {
+
+// Forward declares the Skeleton object, target of joint name resolutions.
+class Skeleton;
+
+// Interned table of joint names, shared across skeletons, with a bulk
+// name-to-joint resolution API. Gameplay data (attachment sockets, hitboxes,
+// physics shapes...) typically references joints by name, and binding it with
+// one Skeleton::FindJoint call per reference hashes and searches every name
+// again for every skeleton. The table factors that work: each unique name is
+// interned once, getting a stable id and a cached hash, and ResolveJoints
+// maps all interned names to the joints of a skeleton in a single merge walk
+// of the table and the skeleton's sorted name index (as exposed by
+// Skeleton::joint_name_hashes). Resolution cost is thus one pass per
+// skeleton, independent of how many bindings reference each name.
+// The table only grows, so ids remain valid for its whole lifetime. Interning
+// is not thread-safe; concurrent ResolveJoints calls on a table that is no
+// longer mutated are.
+class OZZ_ANIMATION_DLL JointNameTable {
+ public:
+  // Interns _name, returning its id in the range [0, count()). Interning an
+  // already known name returns the existing id, hence ids can be compared to
+  // test name equality. The name characters are copied.
+  int Intern(const char* _name);
+
+  // Returns the id of _name if it was interned, or -1 otherwise. Doesn't
+  // mutate the table, as opposed to Intern.
+  int Find(const char* _name) const;
+
+  // Number of interned names, also the id past the last valid one.
+  int count() const { return static_cast<int>(offsets_.size()); }
+
+  // Returns the name interned with id _id, which must be in range.
+  const char* name(int _id) const;
+
+  // Returns the hash of the name interned with id _id, as computed by
+  // Skeleton::JointNameHash.
+  uint32_t hash(int _id) const { return hashes_[_id]; }
+
+  // Resolves every interned name against _skeleton joint names, in a single
+  // pass over the table and the skeleton's name index. _joints must be at
+  // least count() big and is filled with, for each id, the index of the
+  // _skeleton joint with that name, or -1 if no joint matches. Returns false
+  // if _joints is too small.
+  bool ResolveJoints(const Skeleton& _skeleton,
+                     const span<int16_t>& _joints) const;
+
+  // Gather variant for a subset of interned names, in any order and with
+  // duplicates: _joints[i] is filled with the joint matching interned name
+  // _ids[i]. Internally resolves the whole table once, so it shares the one
+  // pass per skeleton property. Returns false if _joints is smaller than
+  // _ids, or if any id is out of range.
+  bool ResolveJoints(const Skeleton& _skeleton, const span<const int>& _ids,
+                     const span<int16_t>& _joints) const;
+
+ private:
+  // Interned name characters. Names are stored back to back, null terminated,
+  // and located by offsets_ as the pool can relocate when it grows.
+  vector<char> chars_;
+
+  // Per id offset of the name first character in chars_.
+  vector<uint32_t> offsets_;
+
+  // Per id name hash (Skeleton::JointNameHash), cached at interning time.
+  vector<uint32_t> hashes_;
+
+  // Ids sorted by hash then by name, mirroring the skeleton name index order.
+  // Backs Find binary searches and ResolveJoints merge walks.
+  vector<int> sorted_;
+};
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_JOINT_NAME_TABLE_H_
@@ -0,0 +1,110 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_JOINT_TRAJECTORY_JOB_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_JOINT_TRAJECTORY_JOB_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/base/platform.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+
+// Forward declaration of math structures.
+namespace math {
+struct Float4x4;
+}
+
+namespace animation {
+
+// Forward declares the runtime types the job reads from.
+class Animation;
+class Skeleton;
+
+// ozz::animation::JointTrajectoryJob computes the model-space trajectory of a
+// single joint over a window of animation ratios: the joint transform at
+// trajectory.size() evenly spaced ratios from 'from' to 'to'. This is what
+// attachment points need (motion blur, trail VFX, predictive aim...) without
+// the cost of a full pipeline evaluation per subsample: only the soa blocks
+// traversed by the joint ancestor chain are decompressed and interpolated
+// (through SamplingJob joint masking), and only that chain goes through
+// local-to-model multiplication, skipping every other joint of the skeleton.
+// Subsamples are taken in increasing ratio order from a single context, so
+// all but the first benefit from coherent (warm) sampling.
+struct OZZ_ANIMATION_DLL JointTrajectoryJob {
+  // Constructor, initializes default values.
+  JointTrajectoryJob();
+
+  // Validates job parameters. Returns true for a valid job, or false
+  // otherwise:
+  // -if any input pointer is nullptr.
+  // -if trajectory is empty.
+  // -if animation and skeleton don't have the same number of joints.
+  // -if joint is not a valid skeleton joint index.
+  // -if context is too small for animation.
+  bool Validate() const;
+
+  // Runs job's execution task.
+  // The job is validated before any operation is performed, see Validate() for
+  // more details.
+  // Returns false if *this job is not valid.
+  bool Run() const;
+
+  // Job input.
+
+  // Animation to sample the trajectory from. Must animate skeleton joints,
+  // aka have one track per skeleton joint.
+  const Animation* animation;
+
+  // Skeleton providing the joint hierarchy the ancestor chain is walked from.
+  const Skeleton* skeleton;
+
+  // A context object that must be big enough to sample animation. Reusing the
+  // same context across frames keeps subsampling coherent.
+  SamplingJob::Context* context;
+
+  // Index of the joint whose model-space trajectory is computed.
+  int joint;
+
+  // Animation ratios (in range [0,1] like SamplingJob ratio) at the first and
+  // last trajectory samples. Intermediate samples are evenly spaced in
+  // between. from doesn't have to be lower than to, a backward window is
+  // sampled backward.
+  float from;
+  float to;
+
+  // Job output.
+
+  // Model-space transform of the joint at each sampled ratio. The number of
+  // subsamples is defined by the size of this range, which must not be empty.
+  // A single entry outputs the transform at ratio from.
+  span<math::Float4x4> trajectory;
+};
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_JOINT_TRAJECTORY_JOB_H_
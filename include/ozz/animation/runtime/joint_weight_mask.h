@@ -0,0 +1,101 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_JOINT_WEIGHT_MASK_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_JOINT_WEIGHT_MASK_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/maths/simd_math.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+namespace animation {
+
+class Skeleton;
+
+// Compiled per-joint weight mask, ready to be plugged as a
+// BlendingJob::Layer::joint_weights buffer. Masks are built once (from scalar
+// weights or a joint name pattern) and stored SoA-packed, so partial-blend
+// configurations can be cached and reused across frames and characters
+// instead of re-packing scalar weights into SimdFloat4 every time a blend
+// setup changes. Combine operations (Multiply, Max, Invert) allow layering
+// cached masks, ex: a cached "Spine*" mask multiplied by a cached arms mask,
+// without going back to scalar weights.
+class OZZ_ANIMATION_DLL JointWeightMask {
+ public:
+  // Constructs an empty mask. Initialize must be called before use.
+  JointWeightMask();
+
+  // Builds a uniform mask of _weight for every joint of _skeleton. Returns
+  // false and empties the mask if _skeleton has no joint.
+  bool Initialize(const Skeleton& _skeleton, float _weight);
+
+  // Builds the mask from per joint scalar _weights. Returns false and empties
+  // the mask if _weights size doesn't match _skeleton number of joints.
+  bool Initialize(const Skeleton& _skeleton, const span<const float>& _weights);
+
+  // Builds the mask from a joint name _pattern, matched against _skeleton
+  // joint names with strmatch (supports * and ? wildcards, case sensitive).
+  // Matched joints get _match_weight, others get _default_weight. Note that
+  // matching a joint doesn't propagate to its children: patterns are usually
+  // authored to match the whole chain ("Spine*" matches Spine, Spine1...).
+  // Returns false and empties the mask if _skeleton has no joint or _pattern
+  // is nullptr.
+  bool Initialize(const Skeleton& _skeleton, const char* _pattern,
+                  float _match_weight, float _default_weight);
+
+  // In-place per joint combine operations with _other mask. Both masks must
+  // have been initialized for the same number of joints, returns false
+  // otherwise.
+  bool Multiply(const JointWeightMask& _other);
+  bool Max(const JointWeightMask& _other);
+
+  // Replaces every weight w with 1 - w, turning a mask into its complement,
+  // ex: the lower body mask of an upper body one.
+  void Invert();
+
+  // Number of joints the mask was built for, 0 if not initialized.
+  int num_joints() const { return num_joints_; }
+
+  // SoA-packed weights, to be assigned to BlendingJob::Layer::joint_weights.
+  // Weight of joint i is the i%4 lane of entry i/4. Padding lanes of the last
+  // entry are kept to 0 and take no part in blending.
+  span<const math::SimdFloat4> joint_weights() const {
+    return make_span(weights_);
+  }
+
+ private:
+  // SoA-packed per joint weights.
+  vector<math::SimdFloat4> weights_;
+
+  // Number of (aos) joints the mask was built for.
+  int num_joints_;
+};
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_JOINT_WEIGHT_MASK_H_
@@ -42,6 +42,10 @@ namespace math {
 struct Float4x4;
 }
 
+// Forward declares the validate-once job handle, see base/compiled_job.h.
+template <typename _Job>
+class CompiledJob;
+
 namespace animation {
 
 // Forward declares the Skeleton object used to describe joint hierarchy.
@@ -66,6 +70,7 @@ struct OZZ_ANIMATION_DLL LocalToModelJob {
   // Note that this input has a SoA format.
   // -if the size of of the output is smaller than the skeleton's number of
   // joints.
+  // -if a joint mask is provided but is smaller than the skeleton requires.
   bool Validate() const;
 
   // Runs job's local-to-model task.
@@ -74,6 +79,17 @@ struct OZZ_ANIMATION_DLL LocalToModelJob {
   // Returns false if job is not valid. See Validate() function.
   bool Run() const;
 
+  // Incremental variant of Run() that only recomputes the subtrees rooted at
+  // _modified_joints, reusing the output matrices of untouched branches. The
+  // output range must hold the result of a previous full update, and
+  // _modified_joints must be sorted in ascending order. Joints covered by the
+  // subtree of a previous entry are skipped, so passing nested joints is
+  // allowed. This is typically used to propagate a small post-process (IK...)
+  // that modified a few local-space transforms, without paying a full
+  // hierarchy update. from/to/from_excluded job inputs are ignored.
+  // Returns false if job is not valid.
+  bool RunDirty(span<const int16_t> _modified_joints) const;
+
   // Job input.
 
   // The Skeleton object describing the joint hierarchy used for local to
@@ -108,6 +124,18 @@ struct OZZ_ANIMATION_DLL LocalToModelJob {
   // Default value is false.
   bool from_excluded;
 
+  // Optional joint mask, empty by default which means all joints are
+  // processed. If not empty, the mask must provide one bit per soa joint block
+  // (8 blocks, aka 32 joints, per byte), where bit i of byte j masks block
+  // j * 8 + i. This layout is the same as SamplingJob::joint_mask one. Blocks
+  // whose bit is unset are entirely skipped, and their output matrices are
+  // left unchanged. The mask must be closed over parents at block granularity
+  // (a selected block only has parents in selected blocks), as produced by
+  // BuildLodJointMask, otherwise skipped parent matrices would be read. This
+  // allows LOD'ed characters to only pay for the subset of joints they
+  // actually use. The mask composes with the from/to partial update range.
+  span<const byte> joint_mask;
+
   // The input range that store local transforms.
   span<const ozz::math::SoaTransform> input;
 
@@ -115,6 +143,102 @@ struct OZZ_ANIMATION_DLL LocalToModelJob {
 
   // The output range to be filled with model-space matrices.
   span<ozz::math::Float4x4> output;
+
+ private:
+  friend class ozz::CompiledJob<LocalToModelJob>;
+  friend struct LocalToModelGraftJob;
+
+  // Runs job's local-to-model task, skipping validation. To be used through a
+  // CompiledJob handle, which maintains job validity.
+  void RunValidated() const;
+};
+
+// Computes model-space joint matrices for many instances sharing a single
+// skeleton, in one call. The hierarchy (parent indices, loop control) is
+// walked once per soa joint block for all instances, instead of once per
+// instance, so the parent-index stream and the conversion code stay hot while
+// only per-instance pose data streams through the caches.
+// Unlike LocalToModelJob, the batch doesn't support partial updates (from/to)
+// nor a per-instance root matrix: it always processes full hierarchies.
+struct OZZ_ANIMATION_DLL LocalToModelBatchJob {
+  // Validates job parameters. Returns true for a valid job, or false otherwise:
+  // -if skeleton is nullptr.
+  // -if input and output ranges don't have the same number of instances.
+  // -if any instance input/output is smaller than the skeleton requires, see
+  // LocalToModelJob::Validate().
+  bool Validate() const;
+
+  // Runs job's local-to-model task for every instance.
+  // The whole batch is validated before any operation is performed.
+  // Returns false if *this job is not valid.
+  bool Run() const;
+
+  // The Skeleton object describing the joint hierarchy, shared by all
+  // instances.
+  const Skeleton* skeleton = nullptr;
+
+  // Per-instance input ranges of local-space transforms.
+  span<const span<const ozz::math::SoaTransform>> inputs;
+
+  // Per-instance output ranges, filled with model-space matrices.
+  span<const span<ozz::math::Float4x4>> outputs;
+};
+
+// Computes model-space joint matrices for a base skeleton and a set of
+// sub-skeletons grafted onto its joints (weapon rigs, props, cloth
+// appendages...), in a single call. Each graft roots a pre-built sub-skeleton
+// at one base joint: the sub-skeleton's own roots behave as children of that
+// joint, and its model-space matrices compose with the base joint's one. This
+// replaces the offline alternative, rebuilding a composite Skeleton per
+// attachment combination, and the runtime one, chaining separate
+// LocalToModelJob passes and re-deriving the attach transform by hand. Base
+// and sub-skeletons data is referenced, never copied, so grafting is a
+// per-frame decision with no setup cost.
+// The base hierarchy is evaluated first, then each graft, rooted at the base
+// joint's just-computed model-space matrix. Grafts are independent from each
+// other and can attach to the same base joint.
+struct OZZ_ANIMATION_DLL LocalToModelGraftJob {
+  // Describes a sub-skeleton grafted onto a base skeleton joint.
+  struct Graft {
+    // The grafted sub-skeleton. Must be a complete, pre-built Skeleton.
+    const Skeleton* skeleton = nullptr;
+
+    // Index of the base skeleton joint the sub-skeleton is rooted at.
+    int joint = -1;
+
+    // Sub-skeleton local-space transforms, ordered like its joints.
+    span<const ozz::math::SoaTransform> input;
+
+    // Sub-skeleton model-space matrices output, expressed in the base
+    // skeleton model space.
+    span<ozz::math::Float4x4> output;
+  };
+
+  // Validates job parameters. Returns true for a valid job, or false
+  // otherwise:
+  // -if the base skeleton, input and output don't form a valid
+  // LocalToModelJob.
+  // -if any graft skeleton is nullptr, or its joint index is outside of the
+  // base skeleton range.
+  // -if any graft input/output is smaller than its skeleton requires.
+  bool Validate() const;
+
+  // Runs the base local-to-model task, then every graft one.
+  // The whole job is validated before any operation is performed.
+  // Returns false if *this job is not valid.
+  bool Run() const;
+
+  // The base Skeleton object describing the joint hierarchy grafts attach to.
+  const Skeleton* skeleton = nullptr;
+
+  // Base skeleton local-space transforms.
+  span<const ozz::math::SoaTransform> input;
+
+  // Base skeleton model-space matrices output.
+  span<ozz::math::Float4x4> output;
+
+  // Grafted sub-skeletons, can be empty.
+  span<const Graft> grafts;
 };
 }  // namespace animation
 }  // namespace ozz
@@ -0,0 +1,111 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_LOCAL_TO_MODEL_JOB_T_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_LOCAL_TO_MODEL_JOB_T_H_
+
+#include "ozz/animation/runtime/local_to_model_job.h"
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/maths/soa_float4x4.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/profile.h"
+
+namespace ozz {
+namespace animation {
+
+// Compile-time sized variant of LocalToModelJob, for skeletons whose soa size
+// (number of 4 joints blocks) is known at build time. The full hierarchy loop
+// trip count becomes a compile-time constant, letting the compiler fully
+// unroll it and fold block indexing away, which helps small fixed-size rigs
+// updated in large numbers. Partial updates (from/to/from_excluded) and joint
+// masks fall back to the generic runtime loop, as those paths gain nothing
+// from a constant size.
+// Run() is defined in this header, so every used size gets compiled in every
+// translation unit that runs it. To keep a single instantiation per binary,
+// declare the sizes in use as extern templates in a shared header:
+//   extern template struct ozz::animation::LocalToModelJobT<6>;
+// and instantiate them in a single compilation unit:
+//   template struct ozz::animation::LocalToModelJobT<6>;
+template <int _SoaBlocks>
+struct LocalToModelJobT : LocalToModelJob {
+  static_assert(_SoaBlocks > 0 && _SoaBlocks * 4 <= Skeleton::kMaxJoints,
+                "Invalid soa joint blocks count.");
+
+  // Runs job's local-to-model task, like LocalToModelJob::Run().
+  // Returns false if the job is not valid, or if the skeleton soa size isn't
+  // _SoaBlocks.
+  bool Run() const;
+};
+
+template <int _SoaBlocks>
+bool LocalToModelJobT<_SoaBlocks>::Run() const {
+  if (!Validate() || skeleton->num_soa_joints() != _SoaBlocks) {
+    return false;
+  }
+
+  // The compile-time size only pays off on the full hierarchy path, partial
+  // updates are forwarded to the generic implementation.
+  if (from != Skeleton::kNoParent || to < skeleton->num_joints() - 1 ||
+      from_excluded || !joint_mask.empty()) {
+    return LocalToModelJob::Run();
+  }
+  OZZ_PROFILE_JOB("LocalToModelJobT", skeleton->num_joints());
+
+  const span<const int16_t>& parents = skeleton->joint_parents();
+
+  // Initializes an identity matrix that will be used to compute roots model
+  // matrices without requiring a branch.
+  const math::Float4x4 identity = math::Float4x4::identity();
+  const math::Float4x4* root_matrix = (root == nullptr) ? &identity : root;
+
+  const int num_joints = skeleton->num_joints();
+  for (int b = 0; b < _SoaBlocks; ++b) {
+    // Builds soa matrices from soa transforms.
+    const math::SoaTransform& transform = input[b];
+    const math::SoaFloat4x4 local_soa_matrices = math::SoaFloat4x4::FromAffine(
+        transform.translation, transform.rotation, transform.scale);
+
+    // Converts to aos matrices.
+    math::Float4x4 local_aos_matrices[4];
+    math::Transpose16x16(&local_soa_matrices.cols[0].x,
+                         local_aos_matrices->cols);
+
+    // Only the last block can be partially used, all others get a constant 4
+    // joints trip count.
+    const int soa_end = b + 1 < _SoaBlocks ? b * 4 + 4 : num_joints;
+    for (int i = b * 4; i < soa_end; ++i) {
+      const int parent = parents[i];
+      const math::Float4x4* parent_matrix =
+          parent == Skeleton::kNoParent ? root_matrix : &output[parent];
+      output[i] = *parent_matrix * local_aos_matrices[i & 3];
+    }
+  }
+  return true;
+}
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_LOCAL_TO_MODEL_JOB_T_H_
@@ -0,0 +1,79 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_MAKE_ADDITIVE_JOB_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_MAKE_ADDITIVE_JOB_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/base/platform.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+
+// Forward declaration of math structures.
+namespace math {
+struct SoaTransform;
+}
+
+namespace animation {
+
+// Computes the additive delta of a local-space pose versus a reference pose,
+// the runtime counterpart of offline AdditiveAnimationBuilder for poses
+// generated procedurally (ragdoll blending, slope adaptation...). The output
+// delta follows the additive animation convention, and is hence suitable for
+// BlendingJob::additive_layers: translations are subtracted, rotations are
+// multiplied by the conjugate reference, scales are divided. Reference scales
+// must not be null.
+struct OZZ_ANIMATION_DLL MakeAdditiveJob {
+  // Validates job parameters. Returns true for a valid job, or false
+  // otherwise:
+  // -if input and reference ranges don't have the same size.
+  // -if output range is smaller than the input ones.
+  // -if input range is empty.
+  bool Validate() const;
+
+  // Runs job's delta computation task.
+  // The job is validated before any operation is performed, see Validate()
+  // for more details.
+  // Returns false if *this job is not valid.
+  bool Run() const;
+
+  // The local-space pose to compute the delta of.
+  span<const math::SoaTransform> input;
+
+  // The reference local-space pose the delta is relative to, usually the
+  // animation first frame or the skeleton rest pose. Must have the same size
+  // as input.
+  span<const math::SoaTransform> reference;
+
+  // The output additive delta pose. Can alias input or reference. Must be at
+  // least as big as input.
+  span<math::SoaTransform> output;
+};
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_MAKE_ADDITIVE_JOB_H_
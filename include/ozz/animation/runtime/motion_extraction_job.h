@@ -0,0 +1,93 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_MOTION_EXTRACTION_JOB_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_MOTION_EXTRACTION_JOB_H_
+
+#include "ozz/animation/runtime/export.h"
+
+namespace ozz {
+
+// Forward declaration of math structures.
+namespace math {
+struct Transform;
+}
+
+namespace animation {
+
+// Forward declares the runtime motion track types.
+class Float3Track;
+class QuaternionTrack;
+
+// Computes the root motion delta accumulated between two animation ratios,
+// from the motion tracks extracted by an offline MotionExtractor. The delta
+// is exact (it doesn't depend on update frequency) and supports looping: when
+// "to" is before "from", motion is accumulated from "from" to the end of the
+// track, then from the beginning of the track to "to". Only the motion tracks
+// are sampled, no full pose sampling is required. The delta is expressed in
+// motion track space: translation delta is the difference of track positions,
+// rotation delta is relative to the rotation at "from" ratio. It is typically
+// applied to the character entity transform every frame.
+struct OZZ_ANIMATION_DLL MotionExtractionJob {
+  // Default constructor, initializes default values.
+  MotionExtractionJob();
+
+  // Validates job parameters. Returns true for a valid job, or false
+  // otherwise:
+  // -if delta output pointer is nullptr.
+  // Position and rotation tracks are both optional, a missing track
+  // contributes a null translation / identity rotation to the delta.
+  bool Validate() const;
+
+  // Runs motion delta extraction.
+  // The job is validated before any operation is performed, see Validate()
+  // for more details.
+  // Returns false if job is not valid. See Validate() function.
+  bool Run() const;
+
+  // Ratio motion is accumulated from, clamped in range [0,1] before job
+  // execution.
+  float from;
+
+  // Ratio motion is accumulated to, clamped in range [0,1] before job
+  // execution. A "to" ratio smaller than "from" is interpreted as a loop.
+  float to;
+
+  // Motion position track, optional.
+  const Float3Track* position_track;
+
+  // Motion rotation track, optional.
+  const QuaternionTrack* rotation_track;
+
+  // Job output.
+
+  // The accumulated motion delta, scale is left to one.
+  math::Transform* delta;
+};
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_MOTION_EXTRACTION_JOB_H_
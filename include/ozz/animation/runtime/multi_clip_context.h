@@ -0,0 +1,97 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_MULTI_CLIP_CONTEXT_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_MULTI_CLIP_CONTEXT_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+namespace ozz {
+namespace animation {
+
+class Animation;
+
+// Keeps sampling contexts resident for the last num_clips() animations a
+// character sampled, so switching back to a recently played clip resumes
+// from live cursors instead of cold-starting. A single context reused across
+// alternating clips (a state machine ping-ponging between idle variants)
+// pays the full invalidation path on every switch: seeking every track from
+// the beginning and re-decompressing all keyframes. With residency, only a
+// clip that hasn't been played for num_clips() switches pays that cost.
+// Contexts returned by Select() must only be used to sample the animation
+// they were selected for, as residency relies on the animation each context
+// is bound to.
+class OZZ_ANIMATION_DLL MultiClipContext {
+ public:
+  // Builds a residency set of _num_clips contexts, each sized to sample any
+  // animation with at most _max_tracks tracks.
+  MultiClipContext(int _max_tracks, size_t _num_clips);
+
+  // Returns the context to sample _animation with, marking it most recently
+  // used. When _animation is resident, the returned context still holds its
+  // cursors and decompressed keyframes, so sampling resumes warm. Otherwise
+  // the least recently selected context is recycled and invalidated, and the
+  // next sample pays a standard cold start.
+  SamplingJob::Context* Select(const Animation* _animation);
+
+  // Drops all residencies, invalidating every context.
+  void Invalidate();
+
+  // The maximum number of tracks every resident context can handle.
+  int max_tracks() const { return max_tracks_; }
+
+  // Number of clips the context set keeps resident.
+  size_t num_clips() const { return residents_.size(); }
+
+ private:
+  MultiClipContext(const MultiClipContext&) = delete;
+  MultiClipContext& operator=(const MultiClipContext&) = delete;
+
+  // A resident context and the animation it was selected for, which can
+  // differ from the animation the context is bound to until it gets sampled.
+  // tick orders residents for LRU recycling.
+  struct Resident {
+    SamplingJob::Context context;
+    const Animation* animation = nullptr;
+    uint64_t tick = 0;
+  };
+
+  // The maximum number of tracks every resident context can handle.
+  int max_tracks_;
+
+  // Monotonic use counter, stamped on every Select.
+  uint64_t tick_ = 0;
+
+  // Resident contexts, unordered.
+  vector<unique_ptr<Resident>> residents_;
+};
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_MULTI_CLIP_CONTEXT_H_
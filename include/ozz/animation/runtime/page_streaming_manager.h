@@ -0,0 +1,123 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_PAGE_STREAMING_MANAGER_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_PAGE_STREAMING_MANAGER_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/base/containers/map.h"
+#include "ozz/base/platform.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+namespace animation {
+
+class PagedAnimation;
+
+// Streaming policy layer for paged animations: decides which pages to
+// prefetch and which to evict, from per instance playback state. Each
+// Update, the manager walks every instance's cursor forward (at its playback
+// speed) over a configurable deadline, and requests prefetch of the pages
+// the cursor will reach within that window, so page data is resident before
+// sampling needs it. Pages no instance will reach soon are evicted least
+// recently needed first once the resident budget is exceeded. Actual io is
+// delegated to a Backend (madvise on a mmapped clip, async loader requests,
+// simple touches...), keeping the policy reusable across titles and
+// streaming schemes.
+class OZZ_ANIMATION_DLL PageStreamingManager {
+ public:
+  // Executes streaming decisions issued by the manager. Prefetch and Evict
+  // are called from within Update, at most once per page per Update.
+  class OZZ_ANIMATION_DLL Backend {
+   public:
+    virtual ~Backend();
+
+    // Makes _animation's page _page resident: madvise(WILLNEED) its range of
+    // a mmapped clip, queue an AsyncLoader request, touch its memory...
+    virtual void Prefetch(const PagedAnimation& _animation, size_t _page) = 0;
+
+    // Releases page memory: madvise(DONTNEED), free a loaded buffer...
+    // Eviction is a policy decision, a page can be prefetched again later.
+    virtual void Evict(const PagedAnimation& _animation, size_t _page) = 0;
+  };
+
+  // Playback state of one sampling instance.
+  struct Instance {
+    // The paged animation the instance samples.
+    const PagedAnimation* animation;
+
+    // Current playback ratio of the whole clip, in unit interval.
+    float ratio;
+
+    // Playback speed multiplier, negative for backward playback. The cursor
+    // is assumed to wrap (looping playback) when its prefetch window crosses
+    // clip boundaries.
+    float speed;
+  };
+
+  PageStreamingManager();
+
+  // Disables copy and assignation.
+  PageStreamingManager(const PageStreamingManager&) = delete;
+  PageStreamingManager& operator=(const PageStreamingManager&) = delete;
+
+  ~PageStreamingManager();
+
+  // Runs one streaming update: prefetches the pages every instance's cursor
+  // will reach within deadline seconds of playback (including the page it is
+  // currently on), then evicts least recently needed pages down to the
+  // budget. Instances with a null animation are skipped.
+  void Update(span<const Instance> _instances, Backend* _backend);
+
+  // Forgets all residency state, without calling Evict. To be used when the
+  // backend released everything itself (clip unload typically).
+  void Clear();
+
+  // Number of pages the manager currently considers resident.
+  size_t num_resident() const { return resident_.size(); }
+
+  // Playback time window, in seconds, that prefetch runs ahead of every
+  // cursor. Must cover io latency at the highest playback speed in use.
+  float deadline = .5f;
+
+  // Maximum number of resident pages. Pages needed by the current Update are
+  // never evicted, even above budget.
+  size_t budget = 64;
+
+ private:
+  // A resident page of a clip.
+  typedef std::pair<const PagedAnimation*, size_t> Page;
+
+  // Resident pages, mapped to the last update tick that needed them.
+  ozz::map<Page, uint64_t> resident_;
+
+  // Update counter, the recency clock of eviction.
+  uint64_t tick_ = 0;
+};
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_PAGE_STREAMING_MANAGER_H_
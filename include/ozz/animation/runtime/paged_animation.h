@@ -0,0 +1,158 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_PAGED_ANIMATION_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_PAGED_ANIMATION_H_
+
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/animation/runtime/export.h"
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/io/archive_traits.h"
+#include "ozz/base/platform.h"
+
+namespace ozz {
+namespace animation {
+
+// Forward declares the PagedAnimationBuilder, used to instantiate a
+// PagedAnimation.
+namespace offline {
+class PagedAnimationBuilder;
+}
+
+// Stores a long clip as fixed duration time pages, each one a self contained
+// Animation. Sampling a long clip through a flat keyframe array means cursor
+// state and seeks operate over the whole clip range, and streaming has to
+// keep the whole clip resident. Paging bounds the range the sampling cursor
+// walks to the current page, turns random seeks into a page lookup followed
+// by a short in-page seek, and lets streaming schemes load or fault in
+// active pages only.
+// PagedAnimation instances are built with a PagedAnimationBuilder, which
+// slices an offline raw animation at page boundaries. See PagedSamplingJob
+// below for sampling.
+class OZZ_ANIMATION_DLL PagedAnimation {
+ public:
+  // Builds a default (empty) animation.
+  PagedAnimation();
+
+  // Allow moves.
+  PagedAnimation(PagedAnimation&&);
+  PagedAnimation& operator=(PagedAnimation&&);
+
+  ~PagedAnimation();
+
+  // Gets the animation clip duration, in seconds.
+  float duration() const { return duration_; }
+
+  // Gets the duration covered by a page, in seconds. The last page can cover
+  // less.
+  float page_duration() const { return page_duration_; }
+
+  // Gets the number of animated tracks.
+  int num_tracks() const { return num_tracks_; }
+
+  // Gets the number of pages.
+  size_t num_pages() const { return pages_.size(); }
+
+  // Gets a page, a self contained Animation covering the time range
+  // [_page * page_duration, (_page + 1) * page_duration].
+  const Animation& page(size_t _page) const { return pages_[_page]; }
+
+  // Coordinates of a clip time ratio within the page directory.
+  struct PagedRatio {
+    // Index of the page containing the ratio.
+    size_t page;
+
+    // Ratio local to that page, in unit interval.
+    float ratio;
+  };
+
+  // Maps _ratio (of the whole clip, clamped to unit interval) to the page
+  // containing it and the equivalent ratio local to that page.
+  PagedRatio Remap(float _ratio) const;
+
+  // Serialization functions.
+  // Should not be called directly but through io::Archive << and >> operators.
+  void Save(ozz::io::OArchive& _archive) const;
+  void Load(ozz::io::IArchive& _archive, uint32_t _version);
+
+ private:
+  // PagedAnimationBuilder instantiates PagedAnimation.
+  friend class offline::PagedAnimationBuilder;
+
+  // Disables copy and assignation.
+  PagedAnimation(const PagedAnimation&) = delete;
+  PagedAnimation& operator=(const PagedAnimation&) = delete;
+
+  // Duration of the whole clip, in seconds.
+  float duration_;
+
+  // Duration covered by a page, in seconds.
+  float page_duration_;
+
+  // The number of animated tracks.
+  int num_tracks_;
+
+  // Clip pages, in time order.
+  ozz::vector<Animation> pages_;
+};
+
+// Samples a PagedAnimation, forwarding to a SamplingJob on the page
+// containing the requested ratio. The context follows page switches like any
+// animation switch (cursors are rebuilt), so coherent playback pays a
+// context reset once per page only.
+struct OZZ_ANIMATION_DLL PagedSamplingJob {
+  // Default constructor, initializes default values.
+  PagedSamplingJob();
+
+  // Validates job parameters, see SamplingJob::Validate.
+  bool Validate() const;
+
+  // Runs job's sampling task, see SamplingJob::Run.
+  // Returns false if *this job is not valid.
+  bool Run() const;
+
+  // Time ratio of the whole clip, in unit interval.
+  float ratio;
+
+  // The paged animation to sample.
+  const PagedAnimation* animation;
+
+  // A context object that must be big enough to sample *this animation.
+  SamplingJob::Context* context;
+
+  // Job output, sampled animation data in soa format.
+  span<math::SoaTransform> output;
+};
+}  // namespace animation
+
+namespace io {
+OZZ_IO_TYPE_VERSION(1, animation::PagedAnimation)
+OZZ_IO_TYPE_TAG("ozz-paged_animation", animation::PagedAnimation)
+}  // namespace io
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_PAGED_ANIMATION_H_
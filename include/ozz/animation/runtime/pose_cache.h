@@ -0,0 +1,142 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_POSE_CACHE_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_POSE_CACHE_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+namespace animation {
+
+// Shares sampled poses between instances playing the same clip at nearly the
+// same time ratio. Sampling time ratios are quantized into intervals, and
+// poses are cached by (animation, quantized ratio, lod) key: all instances
+// falling in the same interval get a copy of the same cached pose, so a crowd
+// of n agents playing c clips pays for the number of distinct (clip, interval,
+// lod) tuples instead of n samplings per frame. Instances don't need a
+// per-instance SamplingJob::Context anymore, the cache samples misses with
+// its own internal context.
+// The counterpart is staleness: returned poses can be off by up to half an
+// interval of the requested ratio, which foreground characters would notice
+// but distant crowd agents don't. Entries are kept in a direct-mapped table,
+// a colliding key simply overwrites the previous entry, so capacity should
+// exceed the expected number of distinct tuples per frame.
+// The cache isn't thread safe. Concurrent crowd updates should shard
+// instances across one cache per worker, which also keeps each table hot in
+// its core's cache.
+class OZZ_ANIMATION_DLL PoseCache {
+ public:
+  // Constructs an empty cache. The cache needs to be resized with the
+  // appropriate number of tracks and entries before it can be used.
+  PoseCache();
+
+  // Constructs a cache that can sample animations with at most _max_tracks
+  // tracks, and store _max_entries poses (rounded up to a power of two).
+  PoseCache(int _max_tracks, int _max_entries);
+
+  // Disables copy and assignation.
+  PoseCache(PoseCache const&) = delete;
+  PoseCache& operator=(PoseCache const&) = delete;
+
+  // Resizes the cache, invalidating all cached poses.
+  void Resize(int _max_tracks, int _max_entries);
+
+  // Invalidates all cached poses. Must be called when an animation whose
+  // poses might be cached is deleted, as entries are keyed by animation
+  // address.
+  void Invalidate();
+
+  // Samples _animation at _ratio, serving the pose from the cache when an
+  // instance already sampled the same interval, sampling and caching it
+  // otherwise. Cached poses are sampled at the nearest interval boundary, so the
+  // returned pose can be off by up to half an interval of _ratio.
+  // _lod distinguishes cached poses sampled with different joint masks: every
+  // instance must pass the same _joint_mask for a given (animation, lod)
+  // pair. Masked out soa tracks are left unchanged in _output, like
+  // SamplingJob does, but are copied as is from the cached pose buffer.
+  // Returns false if the cache is empty, if the animation has more tracks
+  // than the cache supports, or if _output is smaller than the animation
+  // needs.
+  bool Sample(const Animation& _animation, float _ratio,
+              const span<math::SoaTransform>& _output,
+              const span<const byte>& _joint_mask = {}, int _lod = 0);
+
+  // Number of time intervals ratios are quantized to, defaults to 256.
+  // Fewer intervals increase sharing (and thus staleness, up to half an
+  // interval), more intervals increase accuracy.
+  int intervals() const { return intervals_; }
+  void set_intervals(int _intervals);
+
+  // The maximum number of tracks that the cache can handle.
+  int max_tracks() const { return max_soa_tracks_ * 4; }
+
+  // Number of poses the cache can store.
+  int max_entries() const { return static_cast<int>(entries_.size()); }
+
+  // Cache efficiency counters, accumulated across Sample calls. A hit ratio
+  // close to the number of instances per distinct (clip, interval, lod)
+  // tuple means sharing works, a low one means the table is too small
+  // (collisions evict live entries) or intervals is too high.
+  size_t hits() const { return hits_; }
+  size_t misses() const { return misses_; }
+  void ResetStatistics() { hits_ = misses_ = 0; }
+
+ private:
+  // A cached pose and its key. Empty entries have a nullptr animation.
+  struct Entry {
+    const Animation* animation;
+    int bucket;
+    int lod;
+  };
+
+  // Cached poses keys, all-clear when invalidated.
+  vector<Entry> entries_;
+
+  // Cached poses storage, max_soa_tracks_ transforms per entry.
+  vector<math::SoaTransform> poses_;
+
+  // Context used to sample cache misses.
+  SamplingJob::Context context_;
+
+  // Quantization, see intervals().
+  int intervals_;
+
+  // The maximum number of soa tracks the cache can handle.
+  int max_soa_tracks_;
+
+  // Efficiency counters, see hits().
+  size_t hits_;
+  size_t misses_;
+};
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_POSE_CACHE_H_
@@ -0,0 +1,162 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_POSE_CODEC_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_POSE_CODEC_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/maths/transform.h"
+#include "ozz/base/platform.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+
+// Forward declaration of math structures.
+namespace math {
+struct SoaTransform;
+}
+
+namespace animation {
+
+class Skeleton;
+
+// Quantizing pose codec, for use cases like network replication where poses
+// are exchanged every frame for many characters. Local-space transforms are
+// encoded as deltas against the skeleton rest pose: translation and scale
+// deltas are quantized over a configurable range, rotation deltas use the
+// same smallest-three quantization scheme as animation compression. Bit
+// budgets are configurable per joint class (a per-joint index into a set of
+// Quantization settings), so leaf joints can be cheaper than spine or root
+// joints.
+// Encoding and decoding only use IEEE 754 multiply, add and round-to-nearest
+// operations, so a given pose encodes and decodes to the same bits on every
+// platform, as required by lockstep and rollback schemes.
+class OZZ_ANIMATION_DLL PoseCodec {
+ public:
+  // Per joint class quantization settings. Bit budgets are per component, in
+  // range [1, 23]. Ranges are the maximum absolute delta from the rest pose
+  // that can be encoded, deltas are clamped beyond.
+  struct Quantization {
+    int translation_bits = 16;
+    float translation_range = 1.f;
+    int rotation_bits = 12;
+    int scale_bits = 8;
+    float scale_range = 1.f;
+  };
+
+  PoseCodec();
+
+  // Prepares the codec for _skeleton, with a single default Quantization
+  // class for all joints. Returns false and leaves the codec uninitialized
+  // if _skeleton is nullptr.
+  bool Initialize(const Skeleton* _skeleton);
+
+  // Prepares the codec for _skeleton. _joint_classes provides one entry per
+  // skeleton joint, indexing _classes. Returns false and leaves the codec
+  // uninitialized if any setting is out of range or sizes don't match.
+  bool Initialize(const Skeleton* _skeleton,
+                  const span<const Quantization>& _classes,
+                  const span<const uint8_t>& _joint_classes);
+
+  // Size in bytes of an encoded pose, valid once initialized.
+  size_t encoded_size() const { return encoded_size_; }
+
+  // Encodes _pose to _encoded. _pose must be at least as big as the skeleton
+  // number of soa joints, _encoded at least encoded_size() bytes. Returns
+  // false if the codec is not initialized or a span is too small.
+  bool Encode(const span<const math::SoaTransform>& _pose,
+              const span<byte>& _encoded) const;
+
+  // Decodes _encoded, as output by Encode with the same codec setup, back to
+  // _pose. Same size requirements as Encode.
+  bool Decode(const span<const byte>& _encoded,
+              const span<math::SoaTransform>& _pose) const;
+
+ private:
+  // Skeleton the codec was initialized for.
+  const Skeleton* skeleton_;
+
+  // Quantization settings, indexed by joint_classes_.
+  ozz::vector<Quantization> classes_;
+
+  // Per joint class index.
+  ozz::vector<uint8_t> joint_classes_;
+
+  // Local-space rest pose, the prediction every joint is encoded against.
+  ozz::vector<math::Transform> rest_pose_;
+
+  // Size in bytes of an encoded pose.
+  size_t encoded_size_;
+};
+
+// Lossless pose snapshot codec, for use cases like rollback save states
+// where hundreds of poses are recorded every tick into a ring buffer, and
+// must be restored bit-identical. Unlike PoseCodec, nothing is quantized:
+// local-space transforms are xor'ed against the skeleton rest pose, and
+// all-zero 16 bytes blocks (transform components at rest) are elided
+// through a per 8 blocks occupancy mask. Encoding is a single simd pass
+// over the pose, keeping throughput in memcpy territory, while idle or
+// partially animated characters shrink to a fraction of the raw pose size.
+class OZZ_ANIMATION_DLL PoseSnapshotCodec {
+ public:
+  PoseSnapshotCodec();
+
+  // Prepares the codec for _skeleton. Returns false and leaves the codec
+  // uninitialized if _skeleton is nullptr.
+  bool Initialize(const Skeleton* _skeleton);
+
+  // Worst case size in bytes of an encoded pose (no block elided), valid
+  // once initialized. Sizing _encoded buffers with it makes Encode
+  // infallible.
+  size_t max_encoded_size() const { return max_encoded_size_; }
+
+  // Encodes _pose to _encoded and returns the number of bytes written.
+  // Returns 0 if the codec isn't initialized, if _pose is smaller than the
+  // skeleton number of soa joints, or if _encoded is too small for this
+  // very pose (see max_encoded_size).
+  size_t Encode(const span<const math::SoaTransform>& _pose,
+                const span<byte>& _encoded) const;
+
+  // Decodes _encoded, the exact span output by Encode with the same codec
+  // setup, overwriting _pose entirely. Returns false if the codec isn't
+  // initialized, if _pose is smaller than the skeleton number of soa
+  // joints, or if _encoded size doesn't match its content.
+  bool Decode(const span<const byte>& _encoded,
+              const span<math::SoaTransform>& _pose) const;
+
+ private:
+  // Skeleton the codec was initialized for, whose rest pose is the
+  // prediction every block is xor'ed against.
+  const Skeleton* skeleton_;
+
+  // Worst case size in bytes of an encoded pose.
+  size_t max_encoded_size_;
+};
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_POSE_CODEC_H_
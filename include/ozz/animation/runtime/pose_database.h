@@ -0,0 +1,130 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_POSE_DATABASE_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_POSE_DATABASE_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/io/archive_traits.h"
+#include "ozz/base/platform.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+namespace animation {
+
+// Forward declares the PoseDatabaseBuilder, used to instantiate a
+// PoseDatabase.
+namespace offline {
+class PoseDatabaseBuilder;
+}
+
+// Runtime pose feature database, used for motion-matching style pose search.
+// The database stores one feature vector per sampled frame of a set of
+// animations (tracked joint model-space positions and velocities, see
+// PoseDatabaseBuilder), laid out as an implicit kd-tree so nearest-neighbor
+// queries prune most of the entries. A query returns the (animation, ratio)
+// pair whose pose features are closest to the queried ones, which the caller
+// then samples with the matching runtime Animation. Keeping the database in
+// ozz ensures features are computed with the same sampling code as the
+// runtime, so matched poses line up with sampled ones.
+class OZZ_ANIMATION_DLL PoseDatabase {
+ public:
+  // Builds a default, empty, database.
+  PoseDatabase();
+
+  // Allow moves.
+  PoseDatabase(PoseDatabase&&);
+  PoseDatabase& operator=(PoseDatabase&&);
+
+  // Delete copies.
+  PoseDatabase(PoseDatabase const&) = delete;
+  PoseDatabase& operator=(PoseDatabase const&) = delete;
+
+  // Declares the public non-virtual destructor.
+  ~PoseDatabase();
+
+  // Gets the number of float features per entry (6 per tracked joint:
+  // position xyz and velocity xyz).
+  int num_features() const { return num_features_; }
+
+  // Gets the number of pose entries in the database.
+  int num_entries() const {
+    return num_features_ != 0
+               ? static_cast<int>(features_.size()) / num_features_
+               : 0;
+  }
+
+  // A query result, locating the matched pose in the animation set the
+  // database was built from.
+  struct Match {
+    // Index of the matched animation, in the builder's animation set order.
+    int animation;
+
+    // Sampling time ratio of the matched pose in that animation.
+    float ratio;
+
+    // Squared euclidean feature distance between the query and the match.
+    float distance_sq;
+  };
+
+  // Finds the entry whose feature vector is the closest (euclidean distance)
+  // to _query, whose size must be num_features(). Returns false if the
+  // database is empty or if _query size doesn't match.
+  bool Nearest(const span<const float>& _query, Match* _match) const;
+
+  // Serialization functions.
+  // Should not be called directly but through io::Archive << and >> operators.
+  void Save(ozz::io::OArchive& _archive) const;
+  void Load(ozz::io::IArchive& _archive, uint32_t _version);
+
+ private:
+  // PoseDatabaseBuilder class is allowed to instantiate a PoseDatabase.
+  friend class offline::PoseDatabaseBuilder;
+
+  // Number of float features per entry.
+  int num_features_;
+
+  // Feature vectors, num_features_ floats per entry. Entries are ordered as a
+  // balanced implicit kd-tree: the median of a node's range is the node, its
+  // halves are the sub-trees, and the split dimension cycles with depth.
+  vector<float> features_;
+
+  // Per-entry animation index, in kd-tree order.
+  vector<uint16_t> animations_;
+
+  // Per-entry sampling time ratio, in kd-tree order.
+  vector<float> ratios_;
+};
+}  // namespace animation
+
+namespace io {
+OZZ_IO_TYPE_VERSION(1, animation::PoseDatabase)
+OZZ_IO_TYPE_TAG("ozz-pose_database", animation::PoseDatabase)
+}  // namespace io
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_POSE_DATABASE_H_
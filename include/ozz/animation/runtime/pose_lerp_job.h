@@ -0,0 +1,84 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_POSE_LERP_JOB_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_POSE_LERP_JOB_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/base/platform.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+
+// Forward declaration of math structures.
+namespace math {
+struct SoaTransform;
+}
+
+namespace animation {
+
+// Interpolates between two stored local-space poses, the building block of
+// time-sliced updates: background characters are sampled at a reduced rate
+// (two poses kept per instance), and cheap interpolation fills the frames in
+// between. Translations and scales are lerped, rotations are nlerped along
+// the shortest path, all in SoA simd form, equivalent to the two equal-weight
+// layers blend of BlendingJob without its layer and weight machinery.
+struct OZZ_ANIMATION_DLL PoseLerpJob {
+  // Default constructor, initializes default values.
+  PoseLerpJob();
+
+  // Validates job parameters. Returns true for a valid job, or false
+  // otherwise:
+  // -if from and to ranges don't have the same size.
+  // -if output range is smaller than the input ones.
+  // -if from range is empty.
+  bool Validate() const;
+
+  // Runs job's interpolation task.
+  // The job is validated before any operation is performed, see Validate()
+  // for more details.
+  // Returns false if *this job is not valid.
+  bool Run() const;
+
+  // Interpolation coefficient in the unit interval [0,1], clamped before
+  // execution. 0 outputs "from" pose, 1 outputs "to" pose.
+  float alpha;
+
+  // The pose interpolated from, usually the last fully updated one.
+  span<const math::SoaTransform> from;
+
+  // The pose interpolated to, usually the next sampled one. Must have the
+  // same size as from.
+  span<const math::SoaTransform> to;
+
+  // The output interpolated pose. Can alias from or to. Must be at least as
+  // big as from.
+  span<math::SoaTransform> output;
+};
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_POSE_LERP_JOB_H_
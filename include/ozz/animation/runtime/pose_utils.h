@@ -0,0 +1,105 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_POSE_UTILS_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_POSE_UTILS_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/base/maths/simd_math.h"
+#include "ozz/base/span.h"
+
+// Bulk local-space pose initialization kernels, for use cases like spawning
+// waves of entities where per-joint scalar loops show up in profiles. All
+// functions operate on SoaTransform spans, the format sampling and blending
+// jobs exchange.
+
+namespace ozz {
+
+// Forward declaration of math structures.
+namespace math {
+struct SoaTransform;
+}
+
+namespace animation {
+
+class Skeleton;
+
+// Pose components, used to select which of translation, rotation or scale a
+// masked copy affects. Values can be or-ed together.
+enum PoseComponents {
+  kPoseTranslation = 1 << 0,
+  kPoseRotation = 1 << 1,
+  kPoseScale = 1 << 2,
+  kAllPoseComponents = kPoseTranslation | kPoseRotation | kPoseScale
+};
+
+// Fills _pose with identity transforms.
+OZZ_ANIMATION_DLL void FillIdentityPose(const span<math::SoaTransform>& _pose);
+
+// Fills _pose with _skeleton rest pose. _pose must be at least as big as
+// _skeleton number of soa joints.
+OZZ_ANIMATION_DLL void FillRestPose(const Skeleton& _skeleton,
+                                    const span<math::SoaTransform>& _pose);
+
+// Fills masked joints of _pose with _skeleton rest pose, leaving the others
+// untouched. _mask provides one simd lane per joint (soa order, same layout
+// as _pose), where an all-bits-set lane selects the rest pose. _mask and
+// _pose must be at least as big as _skeleton number of soa joints.
+OZZ_ANIMATION_DLL void FillRestPose(const Skeleton& _skeleton,
+                                    const span<const math::SimdInt4>& _mask,
+                                    const span<math::SoaTransform>& _pose);
+
+// Copies the components of _from selected by _components (any combination of
+// PoseComponents values) into _to, leaving other components of _to untouched.
+// _to must be at least as big as _from, and can alias it.
+OZZ_ANIMATION_DLL void CopyPose(const span<const math::SoaTransform>& _from,
+                                int _components,
+                                const span<math::SoaTransform>& _to);
+
+// Number of uint16_t elements required to store a compressed pose of
+// _num_soa_joints SoaTransform. Each transform is 10 components (3
+// translation, 4 rotation, 3 scale) of 4 half floats.
+inline size_t CompressedPoseSize(size_t _num_soa_joints) {
+  return _num_soa_joints * 40;
+}
+
+// Compresses _pose to packed half floats, for use cases like network
+// replication or GPU upload where pose memory footprint matters more than the
+// (~1e-3 relative) precision lost. _compressed must be at least
+// CompressedPoseSize(_pose.size()) big. Conversions are vectorized, 8 half
+// floats at a time.
+OZZ_ANIMATION_DLL void CompressPose(const span<const math::SoaTransform>& _pose,
+                                    const span<uint16_t>& _compressed);
+
+// Decompresses _compressed, as output by CompressPose, back to _pose. _pose
+// must be at least as big as the number of SoaTransform _compressed was built
+// from, aka _compressed.size() / 40.
+OZZ_ANIMATION_DLL void DecompressPose(const span<const uint16_t>& _compressed,
+                                      const span<math::SoaTransform>& _pose);
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_POSE_UTILS_H_
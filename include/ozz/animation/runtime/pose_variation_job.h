@@ -0,0 +1,102 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_POSE_VARIATION_JOB_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_POSE_VARIATION_JOB_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/base/maths/simd_math.h"
+#include "ozz/base/platform.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+
+// Forward declaration of math structures.
+namespace math {
+struct SoaTransform;
+}
+
+namespace animation {
+
+// Applies deterministic procedural variation to a local-space pose, so crowd
+// instances sharing one clip don't move in lockstep without baking clip
+// variants. Each joint is perturbed by seeded value noise: smooth over time,
+// fully determined by (seed, time), so the same instance always gets the
+// same variation and networked or replayed runs stay reproducible. Rotations
+// get a small-angle perturbation, translations an offset, both scaled by the
+// per-joint weights of an optional mask (a JointWeightMask typically, to
+// keep feet or hands untouched). Runs on SoA poses straight out of
+// SamplingJob, before blending or local-to-model.
+struct OZZ_ANIMATION_DLL PoseVariationJob {
+  // Default constructor, initializes default values.
+  PoseVariationJob();
+
+  // Validates job parameters. Returns true for a valid job, or false
+  // otherwise:
+  // -if input range is empty.
+  // -if output range is smaller than the input one.
+  // -if a joint_weights range is provided but is smaller than the input one.
+  bool Validate() const;
+
+  // Runs job's variation task.
+  // The job is validated before any operation is performed, see Validate()
+  // for more details.
+  // Returns false if *this job is not valid.
+  bool Run() const;
+
+  // Per-instance noise seed. Instances with different seeds get decorrelated
+  // variations, the same seed always reproduces the same variation.
+  uint32_t seed;
+
+  // Variation time in seconds, usually the instance's animation or world
+  // time. Noise is continuous in time: close times give close variations.
+  float time;
+
+  // Noise frequency in hertz, the rate at which the variation drifts.
+  float frequency;
+
+  // Maximum rotation perturbation angle per axis, in radians.
+  float rotation_amplitude;
+
+  // Maximum translation offset per axis, in length units.
+  float translation_amplitude;
+
+  // Optional SoA-packed per-joint amplitude scales, as exposed by
+  // JointWeightMask::joint_weights(). Weight of joint i is the i%4 lane of
+  // entry i/4. An empty range applies full amplitude to every joint.
+  span<const math::SimdFloat4> joint_weights;
+
+  // The pose to perturb.
+  span<const math::SoaTransform> input;
+
+  // The output perturbed pose. Can alias input. Must be at least as big as
+  // input.
+  span<math::SoaTransform> output;
+};
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_POSE_VARIATION_JOB_H_
@@ -0,0 +1,128 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_QUANTIZED_TRACK_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_QUANTIZED_TRACK_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/base/io/archive_traits.h"
+#include "ozz/base/platform.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+namespace animation {
+
+// Forward declares the TrackBuilder, used to instantiate a
+// QuantizedFloatTrack.
+namespace offline {
+class TrackBuilder;
+}
+
+// Runtime float track with 16 bits quantized storage, as built by TrackBuilder
+// from a raw float track. Keyframe ratios are stored normalized over the [0,1]
+// ratio range, values are stored either as half floats or normalized over the
+// track value range, halving track memory and bandwidth compared to a
+// FloatTrack. Quantization is lossy, it suits tracks whose values don't need
+// full float precision (blend-shape weights, ik weights...). Use
+// QuantizedFloatTrackSamplingJob to sample it.
+class OZZ_ANIMATION_DLL QuantizedFloatTrack {
+ public:
+  // Quantized values storage format.
+  enum Format {
+    kFloat16,     // IEEE 754-2008 half floats.
+    kNormalized,  // 16 bits normalized over the track value range.
+  };
+
+  QuantizedFloatTrack();
+
+  // Allow move.
+  QuantizedFloatTrack(QuantizedFloatTrack&& _other);
+  QuantizedFloatTrack& operator=(QuantizedFloatTrack&& _other);
+
+  // Disables copy and assignation.
+  QuantizedFloatTrack(QuantizedFloatTrack const&) = delete;
+  void operator=(QuantizedFloatTrack const&) = delete;
+
+  ~QuantizedFloatTrack();
+
+  // Values storage format.
+  Format format() const { return static_cast<Format>(format_); }
+
+  // Keyframe ratios, normalized over the [0,1] ratio range (0 maps to 0,
+  // 65535 maps to 1).
+  span<const uint16_t> ratios() const { return ratios_; }
+
+  // Keyframe values, encoded according to format().
+  span<const uint16_t> values() const { return values_; }
+
+  // Keyframe modes (1 bit per key): 1 for step, 0 for linear.
+  span<const uint8_t> steps() const { return steps_; }
+
+  // Minimum and extent of track values, used to decode kNormalized values
+  // (value = value_min + encoded * value_extent / 65535).
+  float value_min() const { return value_min_; }
+  float value_extent() const { return value_extent_; }
+
+  // Get the estimated size in bytes.
+  size_t size() const;
+
+  // Serialization functions.
+  // Should not be called directly but through io::Archive << and >> operators.
+  void Save(ozz::io::OArchive& _archive) const;
+  void Load(ozz::io::IArchive& _archive, uint32_t _version);
+
+ private:
+  // TrackBuilder class is allowed to allocate a QuantizedFloatTrack.
+  friend class offline::TrackBuilder;
+
+  // Internal memory management functions.
+  void Allocate(size_t _keys_count);
+  void Deallocate();
+
+  // Quantized keyframe ratios.
+  span<uint16_t> ratios_;
+
+  // Quantized keyframe values.
+  span<uint16_t> values_;
+
+  // Keyframe modes, bit packed.
+  span<uint8_t> steps_;
+
+  // kNormalized decoding range.
+  float value_min_ = 0.f;
+  float value_extent_ = 0.f;
+
+  // Values storage format, stored as its serialized type.
+  uint8_t format_ = kFloat16;
+};
+}  // namespace animation
+namespace io {
+OZZ_IO_TYPE_VERSION(1, animation::QuantizedFloatTrack)
+OZZ_IO_TYPE_TAG("ozz-quantized_float_track", animation::QuantizedFloatTrack)
+}  // namespace io
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_QUANTIZED_TRACK_H_
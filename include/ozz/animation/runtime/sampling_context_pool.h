@@ -0,0 +1,148 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_SAMPLING_CONTEXT_POOL_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_SAMPLING_CONTEXT_POOL_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/platform.h"
+
+namespace ozz {
+namespace animation {
+
+// Shares a fixed budget of sampling context backing buffers across many
+// contexts, reclaiming the least recently used one when the budget is
+// reached. A SamplingJob::Context sized for a full skeleton holds tens of
+// kilobytes of decompressed keyframes, which large crowds of mostly-idle
+// background characters keep cold: pooling caps total interpolation cache
+// memory to capacity() buffers whatever the crowd size, instead of one
+// buffer per character.
+// Contexts managed by the pool stay default constructed (no storage of their
+// own) and are backed on demand: Touch() before sampling hands the context a
+// buffer if it lost its own, evicting the least recently touched context
+// when none is free. An evicted context is invalidated and left empty, so
+// idle characters hold no decompressed keys; their next Touch re-backs them
+// and the following sample pays a standard cold start.
+// Pool managed contexts must only be resized through the pool, and must be
+// Release()'d before they are destroyed. Like PoseBufferPool, the pool is
+// not thread-safe.
+class OZZ_ANIMATION_DLL SamplingContextPool {
+ public:
+  // Builds a pool whose buffers can back any animation with at most
+  // _max_tracks tracks, and which backs at most _capacity contexts at once.
+  // Buffers are allocated lazily, so an oversized capacity only costs its
+  // bookkeeping.
+  SamplingContextPool(int _max_tracks, size_t _capacity);
+
+  // Evicts every context still backed and frees all buffers.
+  ~SamplingContextPool();
+
+  // Ensures _context is backed with interpolation storage and marks it most
+  // recently used. Returns true if the context was already backed, in which
+  // case its decompressed keyframes are intact and sampling stays coherent.
+  // Returns false if a buffer had to be (re)assigned, possibly evicting the
+  // least recently touched context of the pool: the next sample then pays a
+  // cold start (seek and full decompression).
+  bool Touch(SamplingJob::Context* _context);
+
+  // Gives _context buffer back to the pool, invalidating and emptying the
+  // context. No-op if _context isn't currently backed.
+  void Release(SamplingJob::Context* _context);
+
+  // The maximum number of tracks pooled buffers can back.
+  int max_tracks() const { return max_tracks_; }
+
+  // Maximum number of contexts backed at once.
+  size_t capacity() const { return capacity_; }
+
+  // Number of contexts currently backed.
+  size_t num_backed() const { return entries_.size(); }
+
+ private:
+  SamplingContextPool(const SamplingContextPool&) = delete;
+  SamplingContextPool& operator=(const SamplingContextPool&) = delete;
+
+  // A backed context and its buffer. tick orders entries for LRU eviction.
+  struct Entry {
+    SamplingJob::Context* context;
+    byte* buffer;
+    uint64_t tick;
+  };
+
+  // Finds the entry backing _context, nullptr if there's none.
+  Entry* Find(const SamplingJob::Context* _context);
+
+  // The maximum number of tracks pooled buffers can back, and the matching
+  // buffer size.
+  int max_tracks_;
+  size_t buffer_size_;
+
+  // Maximum number of contexts backed at once.
+  size_t capacity_;
+
+  // Monotonic use counter, stamped on every Touch.
+  uint64_t tick_ = 0;
+
+  // Backed contexts, unordered.
+  vector<Entry> entries_;
+
+  // Released buffers, available for reuse.
+  vector<byte*> free_buffers_;
+};
+// Thread-local pooling of whole SamplingJob::Context objects, for task
+// systems where worker threads acquire and release contexts constantly as
+// characters migrate between threads. Contexts are pooled at power-of-two
+// track granularity, per thread: the hot path (a thread re-acquiring a
+// capacity it recently released) is allocation-free and touches no shared
+// state. When a thread's cache for a bucket is empty (or full), contexts are
+// stolen from (or spilled to) a fixed set of shared lock-free slots, so
+// capacity migrates between threads without any mutex. Contexts are
+// allocated at bucket granularity and handed out as is, so a pooled context
+// always reuses its existing allocation: Resize is only paid when a brand
+// new context must be allocated.
+
+// Acquires a context able to sample any animation with at most _max_tracks
+// tracks. The context is invalidated, so the first sample pays a standard
+// cold start. Must be given back with ReleaseContext, from any thread.
+OZZ_ANIMATION_DLL SamplingJob::Context* AcquireContext(int _max_tracks);
+
+// Releases a context acquired with AcquireContext back to the calling
+// thread's cache, or to the shared slots when the cache is full. Releasing
+// nullptr is a no-op.
+OZZ_ANIMATION_DLL void ReleaseContext(SamplingJob::Context* _context);
+
+// Frees every context held by the shared slots and by the calling thread's
+// cache. Pooled contexts otherwise live for the whole process, which leak
+// trackers would report: call this once workers are done (each worker thread
+// drains its own cache on exit already).
+OZZ_ANIMATION_DLL void DrainContextPool();
+
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_SAMPLING_CONTEXT_POOL_H_
@@ -29,16 +29,25 @@
 #define OZZ_OZZ_ANIMATION_RUNTIME_SAMPLING_JOB_H_
 
 #include "ozz/animation/runtime/export.h"
+#include "ozz/base/io/archive_traits.h"
 #include "ozz/base/platform.h"
 #include "ozz/base/span.h"
 
 namespace ozz {
+namespace io {
+class IArchive;
+class OArchive;
+}  // namespace io
 
 // Forward declaration of math structures.
 namespace math {
 struct SoaTransform;
 }
 
+// Forward declares the validate-once job handle, see base/compiled_job.h.
+template <typename _Job>
+class CompiledJob;
+
 namespace animation {
 
 // Forward declares the animation type to sample.
@@ -54,12 +63,21 @@ class Animation;
 // optimized through the context. The job does not owned the buffers (in/output)
 // and will thus not delete them during job's destruction.
 struct OZZ_ANIMATION_DLL SamplingJob {
+  // Transform component selection flags, see components member.
+  enum Components {
+    kTranslations = 1 << 0,
+    kRotations = 1 << 1,
+    kScales = 1 << 2,
+    kAllComponents = kTranslations | kRotations | kScales,
+  };
+
   // Default constructor, initializes default values.
   SamplingJob();
 
   // Validates job parameters. Returns true for a valid job, or false otherwise:
   // -if any input pointer is nullptr
   // -if output range is invalid.
+  // -if components selects no valid component.
   bool Validate() const;
 
   // Runs job's sampling task.
@@ -72,7 +90,10 @@ struct OZZ_ANIMATION_DLL SamplingJob {
   // the beginning of the animation, 1 is the end). It should be computed as the
   // current time in the animation , divided by animation duration.
   // This ratio is clamped before job execution in order to resolves any
-  // approximation issue on range bounds.
+  // approximation issue on range bounds. Loop-safe animations (see
+  // Animation::looping) wrap out-of-range ratios across the loop seam
+  // instead, so a looping cursor stepping from 0.999 to 1.001 keeps
+  // interpolating seamlessly in a single Run.
   float ratio;
 
   // The animation to sample.
@@ -91,6 +112,153 @@ struct OZZ_ANIMATION_DLL SamplingJob {
   // If there are more joints in the animation, then the last joints are not
   // sampled.
   span<ozz::math::SoaTransform> output;
+
+  // Optional joint mask, empty by default which means all joints are sampled.
+  // If not empty, the mask must provide one bit per soa track (8 soa tracks,
+  // aka 32 joints, per byte), where bit i of byte j masks soa track j * 8 + i.
+  // Soa tracks whose bit is unset are neither decompressed nor interpolated,
+  // and their output SoaTransform is left unchanged. This allows partial
+  // animations (upper-body overlays...) to only pay for the joints they
+  // actually animate.
+  span<const byte> joint_mask;
+
+  // Deterministic sampling mode, disabled by default. When enabled,
+  // decompression and interpolation only rely on correctly rounded IEEE 754
+  // operations (add, multiply, divide, square root) instead of reciprocal
+  // estimate instructions, whose results differ across SIMD backends (SSE,
+  // NEON, reference...). Sampled poses are then bit-identical whatever the
+  // backend, as required by lockstep simulations. Time accumulation must be
+  // deterministic too, see fixed-point ratio helpers in animation_utils.h.
+  // The flag must be kept consistent across all runs sharing a context, as
+  // decompressed keyframes are cached: invalidate the context when changing
+  // it. Deterministic sampling trades some interpolation performance for
+  // reproducibility.
+  bool deterministic;
+
+  // Transform components to sample, oring Components flags. Skipped
+  // components are left completely untouched: their keyframe cursor doesn't
+  // advance, nothing is decompressed nor interpolated, and their part of
+  // output transforms is preserved as given. This lets systems consuming a
+  // subset of the animation (rotation-only procedural rigs typically) pay
+  // for that subset only. A skipped component's cursor simply catches up on
+  // the next run that samples it. Defaults to kAllComponents.
+  int components;
+
+ private:
+  friend struct SamplingBatchJob;
+  friend struct CrossfadeSamplingJob;
+  friend class ozz::CompiledJob<SamplingJob>;
+
+  // Runs job's sampling task, skipping validation. To be used through a
+  // CompiledJob handle, which maintains job validity.
+  void RunValidated() const;
+
+  // Sampling implementation, shared with SamplingBatchJob. Inputs must have
+  // been validated upfront, as no validation is performed at this level.
+  static void RunValidated(const Animation& _animation, float _ratio,
+                           Context* _context,
+                           const span<math::SoaTransform>& _output,
+                           const span<const byte>& _joint_mask,
+                           bool _deterministic,
+                           int _components = kAllComponents);
+
+  // Steps the context and decompresses outdated keyframes for _ratio, leaving
+  // interpolation to the caller. Inputs must have been validated upfront.
+  static void DecompressValidated(const Animation& _animation, float _ratio,
+                                  Context* _context,
+                                  const span<const byte>& _joint_mask,
+                                  bool _deterministic,
+                                  int _components = kAllComponents);
+};
+
+// Samples a batch of animations in a single call, writing each sampled posture
+// to its own output range. Running a batch amortizes per-job setup costs
+// (validation, context stepping) over all entries, and keeps sampling code hot
+// in instruction cache when hundreds of characters are updated back to back.
+// All input ranges must have the same number of entries, each index across
+// ranges defining one sampling task equivalent to a single SamplingJob.
+struct OZZ_ANIMATION_DLL SamplingBatchJob {
+  // Validates job parameters. Returns true for a valid job, or false otherwise:
+  // -if input/output ranges don't all have the same size.
+  // -if any animation or context pointer is nullptr.
+  // -if any context is too small for its animation.
+  // -if any output range is empty.
+  bool Validate() const;
+
+  // Runs job's sampling task for every batch entry.
+  // The whole batch is validated before any sampling is performed, see
+  // Validate() for more details.
+  // Returns false if *this job is not valid.
+  bool Run() const;
+
+  // Time ratios in the unit interval [0,1], one per batch entry. Each ratio is
+  // clamped before sampling, like SamplingJob::ratio.
+  span<const float> ratios;
+
+  // The animations to sample, one per batch entry. Entries can share the same
+  // animation, but then must each use a dedicated context.
+  span<const Animation* const> animations;
+
+  // The contexts used while sampling, one per batch entry.
+  span<SamplingJob::Context* const> contexts;
+
+  // The output ranges to fill with sampled joints, one per batch entry. See
+  // SamplingJob::output for size requirements of each range.
+  span<const span<math::SoaTransform>> outputs;
+};
+
+// Samples a crossfade between two animations of the same skeleton, fusing the
+// two sampling passes and the blending pass into one. Keyframes of both clips
+// are decompressed like SamplingJob does, then interpolation and blending are
+// processed block by block while sampled values are still in registers. This
+// avoids writing, then re-reading, the two intermediate SoaTransform buffers
+// that sampling each clip and running a 2 layers BlendingJob would require.
+// Note that blending differs from BlendingJob on one point: it doesn't
+// normalize scales by accumulated weights, as a crossfade is a plain two-way
+// lerp (weights sum to 1 by construction).
+struct OZZ_ANIMATION_DLL CrossfadeSamplingJob {
+  // Default constructor, initializes default values.
+  CrossfadeSamplingJob();
+
+  // Validates job parameters. Returns true for a valid job, or false otherwise:
+  // -if any animation or context pointer is nullptr.
+  // -if any context is too small for its animation.
+  // -if both animations don't have the same number of tracks.
+  // -if output range is empty.
+  bool Validate() const;
+
+  // Runs job's sampling and blending task.
+  // The job is validated before any operation is performed, see Validate() for
+  // more details.
+  // Returns false if *this job is not valid.
+  bool Run() const;
+
+  // Defines the sampling inputs of one of the two crossfaded clips. Same
+  // requirements as the matching SamplingJob members.
+  struct Clip {
+    // Time ratio in the unit interval [0,1], clamped before sampling.
+    float ratio;
+
+    // The animation to sample.
+    const Animation* animation;
+
+    // The context used while sampling this clip.
+    SamplingJob::Context* context;
+  };
+
+  // The clip faded from, fully weighted when blend_ratio is 0.
+  Clip from;
+
+  // The clip faded to, fully weighted when blend_ratio is 1.
+  Clip to;
+
+  // Blending coefficient in the unit interval [0,1], clamped before execution.
+  // 0 outputs "from" clip pose, 1 outputs "to" clip pose.
+  float blend_ratio;
+
+  // The output range to be filled with the blended posture. Same requirements
+  // as SamplingJob::output.
+  span<math::SoaTransform> output;
 };
 
 namespace internal {
@@ -124,6 +292,88 @@ class OZZ_ANIMATION_DLL SamplingJob::Context {
   // This also implicitly invalidate the context.
   void Resize(int _max_tracks);
 
+  // Resize the number of joints that the context can support, using
+  // caller-provided memory instead of the default allocator. _buffer must be
+  // at least RequiredSize(_max_tracks) bytes, aligned on 16 bytes
+  // (alignof(SimdFloat4)), and must outlive the context (or its next Resize).
+  // The context doesn't take ownership of the buffer and will never deallocate
+  // it, allowing contexts to be backed by frame arenas or any externally
+  // managed memory, without touching any allocator.
+  // This also implicitly invalidate the context.
+  void Resize(int _max_tracks, span<byte> _buffer);
+
+  // Returns the buffer size (in bytes) required to support _max_tracks tracks,
+  // to be used with the caller-provided memory version of Resize().
+  static size_t RequiredSize(int _max_tracks);
+
+  // Copies the complete state (cursors, decompressed keyframes) of _other
+  // context, resizing *this context if needed.
+  // Many instances playing the same clip at similar time ratios have nearly
+  // identical context states. Cloning a freshly sampled context rather than
+  // sampling from an invalidated one allows such instances to share the cost
+  // of seeking and decompressing keyframes, which dominates sampling time for
+  // crowds.
+  void CopyFrom(const Context& _other);
+
+  // Serialization functions, see ozz::io::Archive. Saves a pre-warmed
+  // snapshot of the context state: cursors and decompressed interpolation
+  // caches for the time ratio it was last sampled at. Loading the snapshot
+  // back (Load then Bind) spares the first Run the cost of seeking and
+  // decompressing every track, which spikes when a clip starts mid-timeline.
+  // The warming procedure is simply sampling the animation at the wanted
+  // start ratio before saving the context. Statistics are transient and not
+  // serialized.
+  void Save(ozz::io::OArchive& _archive) const;
+  void Load(ozz::io::IArchive& _archive, uint32_t _version);
+
+  // Re-binds a loaded snapshot to its animation, to be called right after
+  // Load. The context caches raw keyframe indices, so the snapshot is only
+  // valid for the very animation it was warmed with: binding checks track
+  // count and duration and fails (invalidating the context) on mismatch.
+  // Returns true if the snapshot was bound, in which case the first Run at
+  // the snapshot's ratio costs the same as a steady-state one.
+  bool Bind(const Animation& _animation);
+
+  // Relocatable image support, mirroring Animation::LoadRaw, for sharing
+  // pre-warmed contexts across processes of a host. The context internal
+  // buffer holds no pointer, so SaveRaw writes a position independent image
+  // of the complete warmed state. A cooperating process maps the image
+  // copy-on-write (MAP_PRIVATE) and binds a context over it with LoadRaw:
+  // nothing is copied, the context samples directly from the shared pages
+  // and the kernel only duplicates those the context actually diverges on.
+  // Like other raw images, context images are not portable across
+  // architectures (native endianness and type layout).
+
+  // Size in bytes of the relocatable image of this context.
+  size_t raw_size() const;
+
+  // Writes the relocatable image to _buffer, which must be at least
+  // raw_size() bytes. Returns false if the buffer is too small.
+  bool SaveRaw(span<byte> _buffer) const;
+
+  // Binds this context to the image stored in _buffer, which must be aligned
+  // on 16 bytes (alignof(SimdFloat4)) and remain valid for the lifetime of
+  // the context (or its next Resize). The buffer is referenced, not copied.
+  // It is written to once sampling moves the context away from the warmed
+  // state, hence it must be writable: a copy-on-write mapping, or plain
+  // private memory. Returns false if the buffer doesn't contain a compatible
+  // image, invalidating the context. As with an archive snapshot, Bind must
+  // then re-attach the context to the animation it was warmed with.
+  bool LoadRaw(span<byte> _buffer);
+
+  // Migrates the context to _animation, a new version of the animation it is
+  // currently bound to, as required for hot-reloading clips that live
+  // contexts are sampling. When the new version has the same key layout
+  // (same tracks, time points and per-track key sequences, ie only key
+  // values were edited), cached key indices remain valid for the new value
+  // streams: the context keeps its cursors and simply flags every entry
+  // outdated, so the next Run re-decompresses cached keys from _animation
+  // instead of seeking from the beginning of every track. Returns true in
+  // that case. When layouts differ (keys were added or removed), migration
+  // is not possible and the context is invalidated, returning false. The
+  // next Run then pays a standard cold start.
+  bool Migrate(const Animation& _animation);
+
   // Invalidate the context.
   // The SamplingJob automatically invalidates a context when required
   // during sampling. This automatic mechanism is based on the animation
@@ -138,6 +388,9 @@ class OZZ_ANIMATION_DLL SamplingJob::Context {
   int max_tracks() const { return max_soa_tracks_ * 4; }
   int max_soa_tracks() const { return max_soa_tracks_; }
 
+  // The animation this context is bound to, nullptr when invalid.
+  const Animation* animation() const { return animation_; }
+
   struct Cache {
     // Points to the keys in the animation that are valid for the current time
     // ratio.
@@ -150,8 +403,44 @@ class OZZ_ANIMATION_DLL SamplingJob::Context {
     uint32_t next;
   };
 
+  // Sampling coherency counters, accumulated across all runs using *this
+  // context. Context performance depends entirely on cursor coherence:
+  // sampling forward advances cursors incrementally, while animation
+  // switches, fast seeks or rewinds restart them and re-read keyframes.
+  // These counters expose which case each run hits, so the gameplay systems
+  // destroying coherence (rollback, random clip switching...) can be
+  // detected from production telemetry. Maintaining them costs a few
+  // increments in loops that are already memory bound.
+  struct Statistics {
+    // Number of cache cursor re-initializations (first run, animation
+    // switch, seek further than half an iframe interval), counted per
+    // translation/rotation/scale cache. A reset flags all soa entries
+    // outdated, hence re-decompresses every track.
+    size_t cursor_resets;
+
+    // Number of keyframes consumed stepping cursors forward. Coherent
+    // forward playback only pays for keyframes the animation actually
+    // crosses, so a sudden increase reveals re-reads.
+    size_t keys_advanced;
+
+    // Number of keyframes consumed stepping cursors backward (short rewinds
+    // that don't trigger a reset).
+    size_t keys_rewound;
+
+    // Number of outdated soa entries decompressed, aka outdated-flag churn.
+    size_t entries_decompressed;
+  };
+
+  // Returns accumulated sampling statistics.
+  const Statistics& statistics() const { return statistics_; }
+
+  // Clears accumulated sampling statistics, typically once they've been
+  // reported to telemetry.
+  void ResetStatistics() { statistics_ = Statistics(); }
+
  private:
   friend struct SamplingJob;
+  friend struct CrossfadeSamplingJob;
 
   // Steps the context in order to use it for a potentially new animation. If
   // the _animation is different from the animation currently cached, then the
@@ -169,6 +458,10 @@ class OZZ_ANIMATION_DLL SamplingJob::Context {
   // The number of soa tracks that can store this context.
   int max_soa_tracks_;
 
+  // True when the context buffer was allocated by the context itself, false
+  // when it's caller-provided memory that shall not be deallocated.
+  bool owns_buffer_;
+
   // Context cache instances per component.
   Cache translations_cache_;
   Cache rotations_cache_;
@@ -178,7 +471,21 @@ class OZZ_ANIMATION_DLL SamplingJob::Context {
   span<internal::InterpSoaFloat3> translations_;
   span<internal::InterpSoaQuaternion> rotations_;
   span<internal::InterpSoaFloat3> scales_;
+
+  // Accumulated sampling statistics.
+  Statistics statistics_;
+
+  // Layout of the animation a loaded snapshot was warmed with, used by Bind
+  // to verify the snapshot matches its animation. Only meaningful between
+  // Load and Bind, 0 otherwise.
+  int warm_soa_tracks_;
+  float warm_duration_;
 };
 }  // namespace animation
+
+namespace io {
+OZZ_IO_TYPE_VERSION(1, animation::SamplingJob::Context)
+OZZ_IO_TYPE_TAG("ozz-sampling_context", animation::SamplingJob::Context)
+}  // namespace io
 }  // namespace ozz
 #endif  // OZZ_OZZ_ANIMATION_RUNTIME_SAMPLING_JOB_H_
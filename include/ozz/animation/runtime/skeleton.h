@@ -39,8 +39,9 @@ class IArchive;
 class OArchive;
 }  // namespace io
 namespace math {
+struct Float4x4;
 struct SoaTransform;
-}
+}  // namespace math
 namespace animation {
 
 // Forward declaration of SkeletonBuilder, used to instantiate a skeleton.
@@ -108,22 +109,143 @@ class OZZ_ANIMATION_DLL Skeleton {
   // Returns joint's parent indices range.
   span<const int16_t> joint_parents() const { return joint_parents_; }
 
+  // Returns, for each joint, the index just past its last descendant. Joints
+  // are stored in depth-first order, so the subtree rooted at joint i is the
+  // contiguous index range [i, joint_subtree_ends()[i]): subtree masks, LOD
+  // sets or partial-update ranges are O(1) range constructions, with no
+  // hierarchy traversal (see IterateJointsDF from skeleton_utils.h). A leaf
+  // joint's end is its own index + 1.
+  span<const int16_t> joint_subtree_ends() const { return joint_subtree_ends_; }
+
+  // Returns each joint's depth in the hierarchy, 0 for root joints.
+  span<const int16_t> joint_depths() const { return joint_depths_; }
+
+  // Returns joint's model-space bind pose matrices, aka the result of running
+  // LocalToModelJob over the rest pose. One matrix per joint.
+  span<const math::Float4x4> joint_bind_poses() const {
+    return joint_bind_poses_;
+  }
+
+  // Returns joint's inverse bind pose matrices, the inverse of
+  // joint_bind_poses(). These are the matrices skinning needs to bring
+  // skinned vertices back to joint local space before applying model-space
+  // joint matrices. They are computed once by the SkeletonBuilder and
+  // serialized with the skeleton, so consumers don't have to rebuild them at
+  // load time. One matrix per joint.
+  span<const math::Float4x4> joint_inverse_bind_poses() const {
+    return joint_inverse_bind_poses_;
+  }
+
   // Returns joint's name collection.
   span<const char* const> joint_names() const {
     return span<const char* const>(joint_names_.begin(), joint_names_.end());
   }
 
+  // Returns a hash of *this skeleton structure (joint count and parent
+  // indices). Two skeletons with the same hierarchy share the same hash, so
+  // compatibility of skeleton-shaped buffers can be asserted with a single
+  // integer compare instead of an O(joints) parents comparison. Names and
+  // rest poses don't contribute, as they don't affect buffer compatibility.
+  uint32_t structural_hash() const { return structural_hash_; }
+
+  // Finds a joint by name, using a case sensitive comparison. Returns the
+  // joint index, or -1 if no joint has that name.
+  // Lookup goes through a sorted hash index over joint names, built by the
+  // SkeletonBuilder and serialized with the skeleton, making it suitable for
+  // frequent queries (attachment points, scripting...) where a linear scan of
+  // joint_names() would not be.
+  int FindJoint(const char* _name) const;
+
+  // Hash function (fnv1a) of the sorted name index that backs FindJoint.
+  // Exposed so external name tables (see JointNameTable) can precompute
+  // hashes once and reuse them against any skeleton's index.
+  static uint32_t JointNameHash(const char* _name);
+
+  // Read access to the sorted name index: joint_name_hashes() stores joint
+  // name hashes in ascending order, joint_name_sorted() the index of the
+  // joint each entry refers to. Exposed for bulk name resolution (see
+  // JointNameTable::ResolveJoints), which merge-walks the index in a single
+  // pass instead of binary searching per name.
+  span<const uint32_t> joint_name_hashes() const { return joint_name_hashes_; }
+  span<const int16_t> joint_name_sorted() const { return joint_name_sorted_; }
+
   // Serialization functions.
   // Should not be called directly but through io::Archive << and >> operators.
   void Save(ozz::io::OArchive& _archive) const;
   void Load(ozz::io::IArchive& _archive, uint32_t _version);
 
+  // Relocatable image support, aka zero-copy loading, mirroring
+  // Animation::LoadRaw. Skeletons are immutable at runtime, so an image
+  // mapped read-only can be shared by every process of a host: LoadRaw binds
+  // hierarchy, rest poses and names directly into the mapping. The only
+  // per-process allocation is the joint name pointer array, which cannot be
+  // relocated from a read-only image. Like animation images, skeleton images
+  // are not portable across architectures (native endianness and type
+  // layout), as opposed to archive-based serialization.
+
+  // Size in bytes of the relocatable image of this skeleton.
+  size_t raw_size() const;
+
+  // Writes the relocatable image to _buffer, which must be at least
+  // raw_size() bytes. Returns false if the buffer is too small.
+  bool SaveRaw(span<byte> _buffer) const;
+
+  // Binds this skeleton to the relocatable image stored in _buffer, which
+  // usually maps a file. The buffer is referenced, not copied: it must remain
+  // valid (and unmodified) for the lifetime of this skeleton, and be aligned
+  // on 16 bytes boundaries (alignof(math::SoaTransform)). Returns false if
+  // the buffer doesn't contain a compatible image, leaving the skeleton
+  // empty.
+  bool LoadRaw(span<const byte> _buffer);
+
+  // Two-phase archive loading into caller-provided memory, mirroring
+  // Animation::SizeOf and its placement Load overload.
+
+  // Probes _archive for the size in bytes of the data block of the skeleton
+  // that follows, leaving the archive read position untouched. Returns 0 if
+  // the next object isn't a skeleton of a supported version, or if the
+  // skeleton is empty (an empty skeleton needs no buffer, deserialize it with
+  // the >> operator).
+  static size_t SizeOf(ozz::io::IArchive& _archive);
+
+  // Deserializes the next skeleton from _archive into _buffer, which must be
+  // at least SizeOf() bytes, aligned on 16 bytes boundaries
+  // (alignof(math::SoaTransform)), and must remain valid (the skeleton
+  // doesn't own it) until the skeleton is destroyed or reused. Returns false,
+  // leaving the skeleton empty, if the archive doesn't contain a loadable
+  // skeleton or if _buffer is too small or misaligned.
+  bool Load(ozz::io::IArchive& _archive, span<byte> _buffer);
+
  private:
   // Internal allocation/deallocation function.
   // Allocate returns the beginning of the contiguous buffer of names.
   char* Allocate(size_t _char_count, size_t _num_joints);
   void Deallocate();
 
+  // Distributes _buffer to the skeleton spans, without copying anything.
+  // _buffer must be RequiredSize(_chars_size, _num_joints) bytes. Returns the
+  // beginning of the joint names character buffer, which closes the layout.
+  char* Bind(span<byte> _buffer, size_t _chars_size, size_t _num_joints);
+
+  // Builds the sorted hash index over joint names, used by FindJoint. Called
+  // by the SkeletonBuilder, and when loading archives that predate the index.
+  void BuildJointNameIndex();
+
+  // Computes the structural hash from joint parent indices. Called by the
+  // SkeletonBuilder and when loading archives, once the hierarchy is set.
+  void ComputeStructuralHash();
+
+  // Computes model-space bind pose and inverse bind pose matrices from the
+  // rest pose and hierarchy. Called by the SkeletonBuilder, and when loading
+  // archives that predate these matrices.
+  void ComputeBindPoses();
+
+  // Computes per joint subtree end indices and depths from the hierarchy.
+  // They are deterministic from the parents, so they are recomputed rather
+  // than serialized. Called by the SkeletonBuilder and when loading archives,
+  // once the hierarchy is set.
+  void ComputeSubtreeRanges();
+
   // SkeletonBuilder class is allowed to instantiate an Skeleton.
   friend class offline::SkeletonBuilder;
 
@@ -133,16 +255,51 @@ class OZZ_ANIMATION_DLL Skeleton {
   // Rest pose of every joint in local space.
   span<math::SoaTransform> joint_rest_poses_;
 
+  // Model-space bind pose matrices and their inverses, see
+  // joint_bind_poses() and joint_inverse_bind_poses().
+  span<math::Float4x4> joint_bind_poses_;
+  span<math::Float4x4> joint_inverse_bind_poses_;
+
   // Array of joint parent indexes.
   span<int16_t> joint_parents_;
 
+  // Per joint subtree end indices and depths, see joint_subtree_ends() and
+  // joint_depths().
+  span<int16_t> joint_subtree_ends_;
+  span<int16_t> joint_depths_;
+
   // Stores the name of every joint in an array of c-strings.
   span<char*> joint_names_;
+
+  // Sorted hash index over joint names: joint_name_hashes_ stores name hashes
+  // in ascending order, joint_name_sorted_ the index of the joint each entry
+  // refers to. Hash collisions are solved by FindJoint with a string
+  // comparison over the (sorted) equal hashes run.
+  span<uint32_t> joint_name_hashes_;
+  span<int16_t> joint_name_sorted_;
+
+  // Hash of the hierarchy structure, see structural_hash().
+  uint32_t structural_hash_ = 0;
+
+  // True when the skeleton owns its buffer, false when its data block lives
+  // in external memory (relocatable image or placement load), see LoadRaw and
+  // the placement Load overload.
+  bool owns_buffer_ = true;
+
+  // True when the skeleton owns its joint name pointer array. Only relevant
+  // when owns_buffer_ is false: a skeleton bound to a read-only image
+  // allocates its own pointer array (see LoadRaw), while a placement loaded
+  // one carves it from the caller-provided buffer.
+  bool owns_names_ = true;
+
+  // Caller-provided buffer the next Allocate call binds to instead of
+  // allocating, only set for the duration of a placement Load.
+  span<byte> placement_buffer_;
 };
 }  // namespace animation
 
 namespace io {
-OZZ_IO_TYPE_VERSION(2, animation::Skeleton)
+OZZ_IO_TYPE_VERSION(4, animation::Skeleton)
 OZZ_IO_TYPE_TAG("ozz-skeleton", animation::Skeleton)
 }  // namespace io
 }  // namespace ozz
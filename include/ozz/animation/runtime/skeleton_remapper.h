@@ -0,0 +1,100 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_SKELETON_REMAPPER_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_SKELETON_REMAPPER_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+namespace animation {
+
+// Forward declares the Skeleton object, source of joint names and rest poses.
+class Skeleton;
+
+// Maps local-space poses sampled for a source skeleton onto a destination
+// skeleton, allowing animation clips to be shared across skeletons with
+// differing joint counts instead of resampling them offline per skeleton.
+// Joint correspondence is established once at construction, matching
+// destination joint_names() against source ones (case sensitive, using the
+// same comparison as FindJoint). Rest poses are used to precompute per joint
+// translation length ratios, so bone lengths (and character proportions) of
+// the destination skeleton are preserved when copying translations.
+// Per-frame remapping is then a plain gather: rotations and scales of matched
+// joints are copied, translations are copied scaled by the precomputed ratio,
+// and unmatched destination joints fall back to their rest pose.
+class OZZ_ANIMATION_DLL SkeletonRemapper {
+ public:
+  // Builds joint correspondence from _source to _dest skeletons. Construction
+  // can fail, leaving the remapper invalid, if any skeleton is empty or if no
+  // joint name matches at all.
+  SkeletonRemapper(const Skeleton& _source, const Skeleton& _dest);
+
+  // Returns true if construction succeeded. Running an invalid remapper
+  // fails.
+  bool valid() const { return valid_; }
+
+  // Number of destination joints that found a source match by name.
+  int num_matches() const { return num_matches_; }
+
+  // Maps _source_pose, a local-space pose sampled for the source skeleton, to
+  // _dest_pose for the destination skeleton.
+  // _source_pose must be at least as big as the source skeleton soa joints
+  // count, _dest_pose as the destination one.
+  // Returns false if *this remapper is invalid, or if pose buffer sizes don't
+  // match the skeletons the remapper was built from.
+  bool Run(const span<const math::SoaTransform>& _source_pose,
+           const span<math::SoaTransform>& _dest_pose) const;
+
+ private:
+  // Per destination joint matched source joint index, -1 for joints with no
+  // source correspondence.
+  vector<int16_t> source_joints_;
+
+  // Per destination joint translation length ratio (destination rest length
+  // over source rest length), applied to source translations.
+  vector<float> ratios_;
+
+  // Copy of the destination skeleton rest pose, the fallback pose for
+  // unmatched joints.
+  vector<math::SoaTransform> rest_poses_;
+
+  // Source skeleton soa joints count, for source pose buffer validation.
+  size_t source_num_soa_joints_;
+
+  // Number of matched joints.
+  int num_matches_;
+
+  // Construction success flag.
+  bool valid_;
+};
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_SKELETON_REMAPPER_H_
@@ -41,6 +41,24 @@ namespace animation {
 OZZ_ANIMATION_DLL ozz::math::Transform GetJointLocalRestPose(
     const Skeleton& _skeleton, int _joint);
 
+// Tests whether _a and _b skeletons share the same hierarchy structure
+// (joint count and parent indices), with a single compare of their
+// structural hashes. Suitable as a per-call (debug assertion) compatibility
+// check before mixing skeleton-shaped buffers, where comparing
+// joint_parents() would cost O(joints). Names and rest poses may differ.
+inline bool AreCompatible(const Skeleton& _a, const Skeleton& _b) {
+  return _a.structural_hash() == _b.structural_hash();
+}
+
+// Get rest-poses of a range of skeleton joints, starting at joint _from.
+// Fills _rest_poses with as many consecutive joints as it has room for, which
+// must not exceed the number of remaining joints. Transposes each SoA block
+// only once, which is significantly cheaper than extracting joints one by one
+// with GetJointLocalRestPose when iterating hierarchies.
+OZZ_ANIMATION_DLL void GetJointLocalRestPoses(
+    const Skeleton& _skeleton, const span<ozz::math::Transform>& _rest_poses,
+    int _from = 0);
+
 // Test if a joint is a leaf. _joint number must be in range [0, num joints].
 // "_joint" is a leaf if it's the last joint, or next joint's parent isn't
 // "_joint".
@@ -52,9 +70,67 @@ inline bool IsLeaf(const Skeleton& _skeleton, int _joint) {
   return next == num_joints || parents[next] != _joint;
 }
 
-// Finds joint index by name. Uses a case sensitive comparison.
+// Finds joint index by name. Uses a case sensitive comparison. Defers to
+// Skeleton::FindJoint precomputed name index.
 OZZ_ANIMATION_DLL int FindJoint(const Skeleton& _skeleton, const char* _name);
 
+// Builds the track permutation mapping _source joint order to _target joint
+// order, by matching joint names: _permutation[i] is the _source joint with
+// the same name as _target joint i. The permutation is meant to be fed to
+// Animation::PermuteTracks, to share an animation built for _source with the
+// structurally identical _target. _permutation must be big enough to store
+// one entry per joint. Returns false if the skeletons don't have the same
+// number of joints, or if a _target joint name isn't found in _source
+// (skeletons aren't the same rig).
+OZZ_ANIMATION_DLL bool BuildJointPermutation(
+    const Skeleton& _source, const Skeleton& _target,
+    const span<uint16_t>& _permutation);
+
+// Range of joints, expressed with the semantics of LocalToModelJob partial
+// updates: "from" is the subtree root joint (or kNoParent for a leading range
+// starting at the first joint) and "to" the last joint (inclusive).
+struct JointsRange {
+  int16_t from;
+  int16_t to;
+};
+
+// Partitions skeleton joints into ranges that can be processed as independent
+// partial LocalToModelJob updates, to fan the model-space computation of very
+// large skeletons across threads.
+// The first output range is a sequential "trunk" (from is kNoParent) that must
+// be processed first. All following ranges are disjoint subtrees that only
+// depend on the trunk, hence can run concurrently once the trunk is done. The
+// trunk is chosen as small as possible while maximizing the number of
+// subtrees, bounded by _ranges capacity (at least 2 entries are required).
+// Returns the number of ranges written, 0 for an empty skeleton. The
+// partition only depends on the skeleton's depth-first joint ordering, so it
+// can be computed once and reused for every frame / instance.
+OZZ_ANIMATION_DLL int PartitionJoints(const Skeleton& _skeleton,
+                                      const span<JointsRange>& _ranges);
+
+// Computes the hierarchy depth of every joint: 0 for roots, 1 more than their
+// parent for all other joints. _depths must be big enough to store one entry
+// per joint. Returns the maximum depth, or -1 for an empty skeleton.
+OZZ_ANIMATION_DLL int GetJointDepths(const Skeleton& _skeleton,
+                                     const span<int16_t>& _depths);
+
+// Builds the joint mask selecting all the joints whose level is lower or
+// equal to _level. Joint levels are usually hierarchy depths as computed by
+// GetJointDepths, but any per-joint value that isn't smaller than the
+// parent's one (an authored importance...) works too. Masks built for
+// increasing levels are nested subsets, which makes them suitable as LOD
+// levels: a distant character can be sampled and converted to model-space
+// with a low level mask, paying only for the few soa blocks it selects.
+// The mask has 1 bit per soa joint block, the layout consumed by
+// SamplingJob::joint_mask and LocalToModelJob::joint_mask, hence _mask must
+// be at least (num_soa_joints + 7) / 8 bytes. A block is selected if any of
+// its joints is in the subset. Selected blocks are then closed over parents
+// (blocks containing the parents of a selected block's joints are selected
+// too), as LocalToModelJob requires. Returns the number of selected blocks.
+OZZ_ANIMATION_DLL int BuildLodJointMask(const Skeleton& _skeleton,
+                                        const span<const int16_t>& _levels,
+                                        int _level, const span<byte>& _mask);
+
 // Applies a specified functor to each joint in a depth-first order.
 // _Fct is of type void(int _current, int _parent) where the first argument
 // is the child of the second argument. _parent is kNoParent if the _current
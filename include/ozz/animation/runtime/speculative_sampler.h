@@ -0,0 +1,130 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_SPECULATIVE_SAMPLER_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_SPECULATIVE_SAMPLER_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+namespace animation {
+
+class Animation;
+
+// Samples poses speculatively during idle worker time, ahead of the frame
+// that needs them. Presample() is run when workers would otherwise idle
+// (after render submission typically), sampling the animation at the
+// predicted next-frame ratio (current + dt * speed) into a back pose buffer,
+// with a speculative cursor forked from the authoritative one so mispredicted
+// speculation never corrupts the authoritative timeline. Resolve() is run
+// next frame with the actual ratio: an exact prediction consumes the
+// presampled pose for free and promotes the speculative cursor, a near miss
+// is corrected with the pose-lerp kernel (interpolating between the last
+// resolved pose and the speculative one), and anything else falls back to a
+// regular authoritative sample. Looping clips advance deterministically, so
+// prediction hit rates are close to 100% in practice.
+class OZZ_ANIMATION_DLL SpeculativeSampler {
+ public:
+  // Constructs an empty sampler, Resize must be called before any sampling.
+  SpeculativeSampler();
+
+  // Disables copy and assignation, contexts aren't copyable.
+  SpeculativeSampler(const SpeculativeSampler&) = delete;
+  SpeculativeSampler& operator=(const SpeculativeSampler&) = delete;
+
+  ~SpeculativeSampler();
+
+  // Resizes internal contexts and pose buffers to support animations with at
+  // most _max_tracks tracks. Drops any pending speculation.
+  void Resize(int _max_tracks);
+
+  // Speculatively samples _animation at _predicted_ratio into the back pose
+  // buffer, from a copy of the authoritative cursor. To be called during
+  // idle time, after the frame's authoritative Resolve. Any previous pending
+  // speculation is overwritten. Returns false if the sampler is too small
+  // for _animation, or if sampling fails.
+  bool Presample(const Animation& _animation, float _predicted_ratio);
+
+  // How a Resolve() produced its pose.
+  enum Result {
+    kInvalid,    // Invalid inputs, no pose was produced.
+    kConsumed,   // Exact prediction, the presampled pose was consumed as is.
+    kCorrected,  // Near miss, corrected with a pose lerp.
+    kSampled,    // Miss (or no speculation), a regular sample was run.
+  };
+
+  // Produces the authoritative pose of _animation at _ratio into _output,
+  // consuming or correcting the pending speculation when it matches, see
+  // Result. _output must be big enough for _animation, and the sampler
+  // resized for it. The speculation is consumed whatever the outcome: a new
+  // Presample is needed for the next frame.
+  Result Resolve(const Animation& _animation, float _ratio,
+                 span<math::SoaTransform> _output);
+
+  // Maximum prediction error (in the ratio unit interval) correctable with a
+  // pose lerp rather than a full resample. The default covers small dt
+  // fluctuations; 0 disables correction, leaving exact consume only.
+  float max_correction = 5e-2f;
+
+ private:
+  // Runs an authoritative sample at _ratio into _output.
+  bool Sample(const Animation& _animation, float _ratio,
+              span<math::SoaTransform> _output);
+
+  // Double-buffered sampling contexts. contexts_[authoritative_] tracks the
+  // authoritative timeline, the other one is the speculation scratch,
+  // promoted on successful speculation.
+  SamplingJob::Context contexts_[2];
+  int authoritative_ = 0;
+
+  // Pose sampled by the pending speculation.
+  ozz::vector<math::SoaTransform> speculative_pose_;
+
+  // Last resolved pose, the lerp start point when correcting a near miss.
+  ozz::vector<math::SoaTransform> last_pose_;
+
+  // Pending speculation, nullptr when none.
+  const Animation* speculated_animation_ = nullptr;
+
+  // Ratio the pending speculation was sampled at.
+  float speculated_ratio_ = 0.f;
+
+  // Ratio of the last resolved pose, defining the lerp range with
+  // speculated_ratio_ when correcting.
+  float last_ratio_ = 0.f;
+
+  // The animation last_pose_ was resolved from, nullptr before the first
+  // Resolve (or after a Resize).
+  const Animation* last_animation_ = nullptr;
+};
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_SPECULATIVE_SAMPLER_H_
@@ -0,0 +1,124 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_TIME_TO_RATIO_JOB_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_TIME_TO_RATIO_JOB_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/base/platform.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+namespace animation {
+
+// Batched time-to-ratio conversion for crowds of animated instances. Every
+// instance advances its playback phase by the job time step, scaled by a
+// per-instance speed and normalized by a per-instance animation duration,
+// then wraps according to the job loop mode. Instances are processed 4 at a
+// time in simd registers, moving the per-character fmod and branching of
+// scalar playback controllers into a single vectorized pass.
+// Beyond sampling ratios, the job outputs the event triggering window each
+// instance crossed during the step, with an unwrapped end: feeding
+// [previous ratio, trigger_tos[i]] to TrackTriggeringJob processes loop seams
+// exactly once, where wrapping both window ends fires seam events twice.
+struct OZZ_ANIMATION_DLL TimeToRatioJob {
+  // How phases wrap at track boundaries.
+  enum LoopMode {
+    // Phase saturates to range [0,1], playback stops at the ends.
+    kClamp,
+    // Phase wraps into range [0,1[, playback loops.
+    kLoop,
+    // Phase wraps into range [0,2[ and the ratio folds back from the end,
+    // playback bounces back and forth.
+    kPingPong,
+  };
+
+  // Default constructor, initializes default values.
+  TimeToRatioJob();
+
+  // Validates job parameters. Returns true for a valid job, or false
+  // otherwise:
+  // -if phases is empty.
+  // -if durations size doesn't match phases size.
+  // -if speeds is not empty and doesn't match phases size.
+  // -if output_phases or ratios are smaller than phases.
+  // -if trigger_tos is not empty and smaller than phases, or used with
+  // kPingPong (a reflected window cannot be expressed as a single linear
+  // triggering range).
+  // -if wrap_flags is not empty and smaller than one bit per instance.
+  bool Validate() const;
+
+  // Runs job's conversion task.
+  // The job is validated before any operation is performed, see Validate()
+  // for more details.
+  // Returns false if *this job is not valid.
+  bool Run() const;
+
+  // Time step in seconds, shared by the whole batch, negative to play
+  // backward.
+  float dt;
+
+  // Loop mode, shared by the whole batch. Instances with different loop modes
+  // belong to different batches.
+  LoopMode loop_mode;
+
+  // Per-instance playback phases, the state the job advances. Initial phase
+  // is 0. Phase equals the sampling ratio for kClamp and kLoop, while
+  // kPingPong phases span [0,2[ with the ratio folding back from the end.
+  span<const float> phases;
+
+  // Per-instance animation durations in seconds, must be positive.
+  span<const float> durations;
+
+  // Optional per-instance playback speed factors, negative to play backward.
+  // Every instance runs at speed 1 when empty.
+  span<const float> speeds;
+
+  // Updated phases, to be fed back as phases on the next step. Can alias
+  // phases.
+  span<float> output_phases;
+
+  // Output sampling ratios in range [0,1], what sampling jobs consume. Can
+  // alias output_phases for kClamp and kLoop, where both are equal.
+  span<float> ratios;
+
+  // Optional unwrapped end of the event triggering window crossed during this
+  // step. The window starts at the instance previous ratio (its value before
+  // the update): run TrackTriggeringJob with from = previous ratio and
+  // to = trigger_tos[i]. The end is left unwrapped (it can exceed [0,1]), so
+  // the triggering job crosses loop seams exactly once. Must be empty with
+  // kPingPong.
+  span<float> trigger_tos;
+
+  // Optional wrap flags, one bit per instance (bit i%8 of byte i/8), set when
+  // the instance crossed a track boundary during this step: loop seam, clamp
+  // saturation or ping-pong reflection. Cleared otherwise.
+  span<byte> wrap_flags;
+};
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_TIME_TO_RATIO_JOB_H_
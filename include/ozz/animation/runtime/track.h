@@ -43,7 +43,20 @@ namespace offline {
 class TrackBuilder;
 }
 
+// Forward declares two-phase loading functions, declared after the track
+// classes they are templated on.
+template <typename _Track>
+size_t SizeOfTrack(ozz::io::IArchive& _archive);
+template <typename _Track>
+bool LoadTrack(ozz::io::IArchive& _archive, _Track* _track, span<byte> _buffer);
+
 namespace internal {
+
+// Forward declares the editable track, which bakes immutable tracks. See
+// dynamic_track.h.
+template <typename _ValueType>
+class DynamicTrack;
+
 // Runtime user-channel track internal implementation.
 // The runtime track data structure exists for 1 to 4 float types (FloatTrack,
 // ..., Float4Track) and quaternions (QuaternionTrack). See RawTrack for more
@@ -90,6 +103,22 @@ class OZZ_ANIMATION_DLL Track {
   // TrackBuilder class is allowed to allocate a Track.
   friend class offline::TrackBuilder;
 
+  // DynamicTrack is allowed to allocate a Track when baking an edited track
+  // to an immutable one, see dynamic_track.h.
+  friend class DynamicTrack<_ValueType>;
+
+  // Two-phase loading functions need access to RequiredSize and the
+  // placement buffer, see SizeOfTrack and LoadTrack.
+  template <typename _Track>
+  friend size_t animation::SizeOfTrack(ozz::io::IArchive& _archive);
+  template <typename _Track>
+  friend bool animation::LoadTrack(ozz::io::IArchive& _archive, _Track* _track,
+                                   span<byte> _buffer);
+
+  // Size in bytes of the single data block for _keys_count keyframes and a
+  // _name_len characters name.
+  static size_t RequiredSize(size_t _keys_count, size_t _name_len);
+
   // Internal destruction function.
   void Allocate(size_t _keys_count, size_t _name_len);
   void Deallocate();
@@ -105,6 +134,14 @@ class OZZ_ANIMATION_DLL Track {
 
   // Track name.
   char* name_ = nullptr;
+
+  // True when the track owns (and must deallocate) its data block, false when
+  // the block lives in caller-provided memory, see LoadTrack.
+  bool owns_buffer_ = true;
+
+  // Caller-provided buffer the next Allocate call binds to instead of
+  // allocating, only set for the duration of a placement load, see LoadTrack.
+  span<byte> placement_buffer_;
 };
 
 // Definition of operations policies per track value type.
@@ -158,6 +195,29 @@ class OZZ_ANIMATION_DLL Float4Track : public internal::Track<math::Float4> {};
 class OZZ_ANIMATION_DLL QuaternionTrack
     : public internal::Track<math::Quaternion> {};
 
+// Two-phase archive loading into caller-provided memory, mirroring
+// Animation::SizeOf and its placement Load overload. Free functions templated
+// on the concrete (tagged) track type, ex:
+//   const size_t size = ozz::animation::SizeOfTrack<FloatTrack>(archive);
+//   ... place a buffer of that size ...
+//   ozz::animation::LoadTrack(archive, &track, buffer);
+
+// Probes _archive for the size in bytes of the data block of the _Track that
+// follows, leaving the archive read position untouched. Returns 0 if the next
+// object isn't a _Track of a supported version, or if the track is empty (an
+// empty track needs no buffer, deserialize it with the >> operator).
+template <typename _Track>
+OZZ_ANIMATION_DLL size_t SizeOfTrack(ozz::io::IArchive& _archive);
+
+// Deserializes the next _Track from _archive into _buffer, which must be at
+// least SizeOfTrack() bytes, aligned on the track value type alignment, and
+// must remain valid (the track doesn't own it) until the track is destroyed
+// or reused. Returns false, leaving the track empty, if the archive doesn't
+// contain a loadable _Track or if _buffer is too small or misaligned.
+template <typename _Track>
+OZZ_ANIMATION_DLL bool LoadTrack(ozz::io::IArchive& _archive, _Track* _track,
+                                 span<byte> _buffer);
+
 }  // namespace animation
 namespace io {
 OZZ_IO_TYPE_VERSION(1, animation::FloatTrack)
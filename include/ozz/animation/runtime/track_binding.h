@@ -0,0 +1,128 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_TRACK_BINDING_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_TRACK_BINDING_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/platform.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+namespace animation {
+
+// Forward declares the SoA track aggregate bindings are evaluated against.
+class FloatTrackSoA;
+
+// Binds named tracks of a FloatTrackSoA to offsets in a packed float output
+// block. The intended use is driving gameplay/user properties from animation
+// channels (see samples/user_channel): instead of looking tracks up by name
+// and scattering values with per-track scalar code every frame, targets
+// describe the properties once, Bind resolves each target name against the
+// track names the aggregate was built from, and TrackBindingJob evaluates
+// every bound track of a character in a single batched call.
+class OZZ_ANIMATION_DLL TrackBindingSet {
+ public:
+  // A bindable target property: the name of the track driving it (case
+  // sensitive), and the offset (in floats) where the sampled value is
+  // written in the output block.
+  struct Target {
+    const char* name;
+    size_t offset;
+  };
+
+  // Resolves _targets against _track_names, where _track_names[i] names
+  // track i of the FloatTrackSoA this set will be evaluated against (the
+  // order tracks were given to TrackBuilder). Any previous binding is lost.
+  // Returns false, leaving the set empty, if a target name isn't found
+  // (likely an authoring error that would otherwise silently freeze the
+  // property) or if two targets collide on the same offset.
+  bool Bind(const span<const char* const>& _track_names,
+            const span<const Target>& _targets);
+
+  // Number of resolved bindings, matching the number of bound targets.
+  size_t num_bindings() const { return bindings_.size(); }
+
+  // Smallest output block size (in floats) evaluation can write to.
+  size_t required_size() const { return required_size_; }
+
+ private:
+  // TrackBindingJob reads resolved bindings directly.
+  friend struct TrackBindingJob;
+
+  // A resolved binding, from track index to output offset.
+  struct Binding {
+    uint32_t track;
+    uint32_t offset;
+  };
+
+  // Resolved bindings, in targets order.
+  ozz::vector<Binding> bindings_;
+
+  // Biggest bound track index, validated against evaluated tracks.
+  size_t max_track_ = 0;
+
+  // Smallest valid output block size, in floats.
+  size_t required_size_ = 0;
+};
+
+// Evaluates all the tracks bound by a TrackBindingSet at a single ratio,
+// scattering each value to its bound offset of the output block. As with
+// TrackSoASamplingJob the keyframe search is done once and shared by every
+// binding, but only bound tracks are interpolated and written: unbound
+// tracks cost nothing, and unbound output floats are left untouched.
+struct OZZ_ANIMATION_DLL TrackBindingJob {
+  TrackBindingJob();
+
+  // Validates all parameters.
+  // Returns true for a valid job, false otherwise:
+  // - if tracks or bindings is nullptr.
+  // - if a binding refers to a track beyond tracks' range.
+  // - if output doesn't store at least bindings' required_size() floats.
+  bool Validate() const;
+
+  // Validates and evaluates bindings.
+  bool Run() const;
+
+  // Ratio used to sample tracks, clamped in range [0,1] before job execution.
+  // 0 is the beginning of the tracks, 1 is the end.
+  float ratio;
+
+  // Aggregated tracks to sample.
+  const FloatTrackSoA* tracks;
+
+  // Resolved track to offset bindings.
+  const TrackBindingSet* bindings;
+
+  // Packed output block sampled values are scattered to. Must store at least
+  // bindings' required_size() floats.
+  span<float> output;
+};
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_TRACK_BINDING_H_
@@ -0,0 +1,145 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_TRACK_BUNDLE_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_TRACK_BUNDLE_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/base/io/archive_traits.h"
+#include "ozz/base/maths/quaternion.h"
+#include "ozz/base/maths/vec_float.h"
+#include "ozz/base/platform.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+namespace animation {
+
+// Forward declares the TrackBuilder, used to instantiate a TrackBundle.
+namespace offline {
+class TrackBuilder;
+}
+
+namespace internal {
+// Runtime bundle of tracks sharing a single timeline, as built by TrackBuilder
+// from co-exported raw tracks. Tracks exported from one clip usually all have
+// the same keyframe ratios and interpolation modes, yet each Track stores its
+// own copy. A bundle stores ratios and steps once, deduplicating them across
+// any number of tracks, so memory drops proportionally to the number of
+// bundled tracks. Values are interleaved per keyframe (values of keyframe i
+// are stored at [i * num_tracks, (i + 1) * num_tracks)), so
+// TrackBundleSamplingJob samples all tracks with a single keyframe search.
+// Building a bundle requires all tracks to have strictly identical keyframe
+// ratios and interpolations. Tracks with heterogeneous timelines can be
+// aggregated with FloatTrackSoA instead, at the cost of union resampling.
+template <typename _ValueType>
+class OZZ_ANIMATION_DLL TrackBundle {
+ public:
+  typedef _ValueType ValueType;
+
+  TrackBundle();
+
+  // Allow move.
+  TrackBundle(TrackBundle&& _other);
+  TrackBundle& operator=(TrackBundle&& _other);
+
+  // Disables copy and assignation.
+  TrackBundle(TrackBundle const&) = delete;
+  void operator=(TrackBundle const&) = delete;
+
+  ~TrackBundle();
+
+  // Number of bundled tracks.
+  size_t num_tracks() const { return num_tracks_; }
+
+  // Keyframe ratios (0 is the beginning of the tracks, 1 is the end), shared
+  // by all tracks.
+  span<const float> ratios() const { return ratios_; }
+
+  // Keyframe values, num_tracks values per keyframe, interleaved per keyframe.
+  span<const _ValueType> values() const { return values_; }
+
+  // Keyframe modes (1 bit per key): 1 for step, 0 for linear, shared by all
+  // tracks.
+  span<const uint8_t> steps() const { return steps_; }
+
+  // Get the estimated size in bytes.
+  size_t size() const;
+
+  // Serialization functions.
+  // Should not be called directly but through io::Archive << and >> operators.
+  void Save(ozz::io::OArchive& _archive) const;
+  void Load(ozz::io::IArchive& _archive, uint32_t _version);
+
+ private:
+  // TrackBuilder class is allowed to allocate a TrackBundle.
+  friend class offline::TrackBuilder;
+
+  // Internal memory management functions.
+  void Allocate(size_t _keys_count, size_t _num_tracks);
+  void Deallocate();
+
+  // Keyframe ratios, shared by all tracks.
+  span<float> ratios_;
+
+  // Interleaved keyframe values.
+  span<_ValueType> values_;
+
+  // Keyframe modes, shared by all tracks.
+  span<uint8_t> steps_;
+
+  // Number of bundled tracks.
+  size_t num_tracks_ = 0;
+};
+}  // namespace internal
+
+// Runtime track bundle data structure instantiation.
+class OZZ_ANIMATION_DLL FloatTrackBundle : public internal::TrackBundle<float> {
+};
+class OZZ_ANIMATION_DLL Float2TrackBundle
+    : public internal::TrackBundle<math::Float2> {};
+class OZZ_ANIMATION_DLL Float3TrackBundle
+    : public internal::TrackBundle<math::Float3> {};
+class OZZ_ANIMATION_DLL Float4TrackBundle
+    : public internal::TrackBundle<math::Float4> {};
+class OZZ_ANIMATION_DLL QuaternionTrackBundle
+    : public internal::TrackBundle<math::Quaternion> {};
+
+}  // namespace animation
+namespace io {
+OZZ_IO_TYPE_VERSION(1, animation::FloatTrackBundle)
+OZZ_IO_TYPE_TAG("ozz-float_track_bundle", animation::FloatTrackBundle)
+OZZ_IO_TYPE_VERSION(1, animation::Float2TrackBundle)
+OZZ_IO_TYPE_TAG("ozz-float2_track_bundle", animation::Float2TrackBundle)
+OZZ_IO_TYPE_VERSION(1, animation::Float3TrackBundle)
+OZZ_IO_TYPE_TAG("ozz-float3_track_bundle", animation::Float3TrackBundle)
+OZZ_IO_TYPE_VERSION(1, animation::Float4TrackBundle)
+OZZ_IO_TYPE_TAG("ozz-float4_track_bundle", animation::Float4TrackBundle)
+OZZ_IO_TYPE_VERSION(1, animation::QuaternionTrackBundle)
+OZZ_IO_TYPE_TAG("ozz-quat_track_bundle", animation::QuaternionTrackBundle)
+}  // namespace io
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_TRACK_BUNDLE_H_
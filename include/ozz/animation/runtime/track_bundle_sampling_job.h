@@ -0,0 +1,82 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_TRACK_BUNDLE_SAMPLING_JOB_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_TRACK_BUNDLE_SAMPLING_JOB_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/animation/runtime/track_bundle.h"
+
+namespace ozz {
+namespace animation {
+
+namespace internal {
+
+// TrackBundleSamplingJob internal implementation. See *TrackBundleSamplingJob
+// for more details.
+template <typename _TrackBundle>
+struct TrackBundleSamplingJob {
+  typedef typename _TrackBundle::ValueType ValueType;
+
+  TrackBundleSamplingJob();
+
+  // Validates all parameters.
+  bool Validate() const;
+
+  // Validates and executes sampling.
+  bool Run() const;
+
+  // Ratio used to sample the bundle, clamped in range [0,1] before job
+  // execution. All bundled tracks are sampled at the same ratio.
+  float ratio;
+
+  // Track bundle to sample.
+  const _TrackBundle* bundle;
+
+  // Job output, must be at least bundle->num_tracks() big. Result i is the
+  // sampled value of track i.
+  span<ValueType> results;
+};
+}  // namespace internal
+
+// Track bundle sampling job implementation. Samples all the tracks of a
+// bundle at a ratio, with a single keyframe search amortized across tracks,
+// where sampling tracks individually pays one binary search per track.
+struct OZZ_ANIMATION_DLL FloatTrackBundleSamplingJob
+    : public internal::TrackBundleSamplingJob<FloatTrackBundle> {};
+struct OZZ_ANIMATION_DLL Float2TrackBundleSamplingJob
+    : public internal::TrackBundleSamplingJob<Float2TrackBundle> {};
+struct OZZ_ANIMATION_DLL Float3TrackBundleSamplingJob
+    : public internal::TrackBundleSamplingJob<Float3TrackBundle> {};
+struct OZZ_ANIMATION_DLL Float4TrackBundleSamplingJob
+    : public internal::TrackBundleSamplingJob<Float4TrackBundle> {};
+struct OZZ_ANIMATION_DLL QuaternionTrackBundleSamplingJob
+    : public internal::TrackBundleSamplingJob<QuaternionTrackBundle> {};
+
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_TRACK_BUNDLE_SAMPLING_JOB_H_
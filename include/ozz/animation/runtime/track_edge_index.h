@@ -0,0 +1,126 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_TRACK_EDGE_INDEX_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_TRACK_EDGE_INDEX_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/base/io/archive_traits.h"
+#include "ozz/base/platform.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+namespace animation {
+
+// Forward declares the TrackBuilder, used to instantiate a TrackEdgeIndex.
+namespace offline {
+class TrackBuilder;
+}
+
+// Precomputed edge index of a float track, as built by TrackBuilder from a
+// raw float track and a threshold value. It stores the sorted ratios at which
+// the track curve crosses the threshold within a single track loop, along with
+// edge directions (rising or falling when traversing the track forward). This
+// allows TrackEdgeTriggeringJob to collect all edges of a [from, to[ range
+// with a binary search, where TrackTriggeringJob scans every keyframe. The
+// counterpart is that the threshold is baked at build time. Edges are detected
+// the same way TrackTriggeringJob does, including the looping edge between the
+// track last and first keys.
+class OZZ_ANIMATION_DLL TrackEdgeIndex {
+ public:
+  TrackEdgeIndex();
+
+  // Allow move.
+  TrackEdgeIndex(TrackEdgeIndex&& _other);
+  TrackEdgeIndex& operator=(TrackEdgeIndex&& _other);
+
+  // Disables copy and assignation.
+  TrackEdgeIndex(TrackEdgeIndex const&) = delete;
+  void operator=(TrackEdgeIndex const&) = delete;
+
+  ~TrackEdgeIndex();
+
+  // Threshold value the index was built for.
+  float threshold() const { return threshold_; }
+
+  // Sorted ratios (in range [0,1]) at which the track crosses the threshold.
+  span<const float> ratios() const { return ratios_; }
+
+  // Edge directions (1 bit per edge): 1 for rising, 0 for falling, considering
+  // a forward traversal of the track. Edge i direction is bit i & 7 of byte
+  // i / 8.
+  span<const uint8_t> risings() const { return risings_; }
+
+  // Number of uniform ratio buckets of the coarse edge summary below.
+  enum { kNumEdgeBuckets = 64 };
+
+  // Coarse edge density summary: bit i is set if any edge lies in ratio
+  // bucket [i / kNumEdgeBuckets, (i + 1) / kNumEdgeBuckets[. Allows
+  // TrackEdgePrefilterJob to cheaply reject ratio windows that provably
+  // contain no edge, without touching the ratios array. Derived from ratios,
+  // hence not serialized.
+  uint64_t edge_buckets() const { return edge_buckets_; }
+
+  // Get the estimated size in bytes.
+  size_t size() const;
+
+  // Serialization functions.
+  // Should not be called directly but through io::Archive << and >> operators.
+  void Save(ozz::io::OArchive& _archive) const;
+  void Load(ozz::io::IArchive& _archive, uint32_t _version);
+
+ private:
+  // TrackBuilder class is allowed to allocate a TrackEdgeIndex.
+  friend class offline::TrackBuilder;
+
+  // Internal memory management functions.
+  void Allocate(size_t _edges_count);
+  void Deallocate();
+
+  // Rebuilds the edge_buckets_ summary from ratios_, called once ratios are
+  // filled by the builder or the archive load.
+  void BuildEdgeBuckets();
+
+  // Sorted edge ratios.
+  span<float> ratios_;
+
+  // Edge directions, bit packed.
+  span<uint8_t> risings_;
+
+  // Baked threshold value.
+  float threshold_ = 0.f;
+
+  // Coarse per ratio bucket edge summary, see edge_buckets().
+  uint64_t edge_buckets_ = 0;
+};
+}  // namespace animation
+namespace io {
+OZZ_IO_TYPE_VERSION(1, animation::TrackEdgeIndex)
+OZZ_IO_TYPE_TAG("ozz-track_edge_index", animation::TrackEdgeIndex)
+}  // namespace io
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_TRACK_EDGE_INDEX_H_
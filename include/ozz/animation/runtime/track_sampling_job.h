@@ -34,6 +34,36 @@
 namespace ozz {
 namespace animation {
 
+namespace internal {
+template <typename _Track>
+struct TrackSamplingJob;
+}  // namespace internal
+
+// Declares the optional context object used by TrackSamplingJob to take
+// advantage of the coherency of consecutive sample ratios. It caches the
+// keyframe interval found by the previous sample, so sequential playback
+// usually skips the binary search over track ratios, falling back to it when
+// the cached interval doesn't match (seek, loop, track change...). The cached
+// interval is validated against the sampled track ratios, so sharing a
+// context between tracks is safe, but defeats its purpose.
+class OZZ_ANIMATION_DLL TrackSamplingContext {
+ public:
+  TrackSamplingContext();
+
+  // Invalidates the cached keyframe interval.
+  void Invalidate();
+
+ private:
+  // Sampling jobs are allowed to access the cached interval.
+  template <typename _Track>
+  friend struct internal::TrackSamplingJob;
+  friend struct QuantizedFloatTrackSamplingJob;
+  friend struct QuaternionTrackMultiSamplingJob;
+
+  // Index of the first keyframe of the interval used by the previous sample.
+  uint32_t id_;
+};
+
 namespace internal {
 
 // TrackSamplingJob internal implementation. See *TrackSamplingJob for more
@@ -58,6 +88,10 @@ struct TrackSamplingJob {
   // Track to sample.
   const _Track* track;
 
+  // Optional context, making sampling O(1) when consecutive sample ratios
+  // remain in the same or the next keyframe interval.
+  TrackSamplingContext* context;
+
   // Job output.
   typename _Track::ValueType* result;
 };
@@ -77,6 +111,69 @@ struct OZZ_ANIMATION_DLL Float4TrackSamplingJob
 struct OZZ_ANIMATION_DLL QuaternionTrackSamplingJob
     : public internal::TrackSamplingJob<QuaternionTrack> {};
 
+// Samples a quaternion track at several ratios in a single run, for callers
+// evaluating smoothing windows (procedural aim blending...) that sample the
+// same track 4 to 8 times per frame. The keyframe search runs once per
+// sampled ratio but reuses the interval found by the previous one through the
+// context cache, so coherent ratio sets locate their window in O(1). The
+// quaternion nlerp (lerp and normalization) is then vectorized 4 samples at a
+// time, instead of running scalar normalization once per sample like
+// QuaternionTrackSamplingJob does. Results match QuaternionTrackSamplingJob
+// for every ratio.
+struct OZZ_ANIMATION_DLL QuaternionTrackMultiSamplingJob {
+  QuaternionTrackMultiSamplingJob();
+
+  // Validates all parameters.
+  bool Validate() const;
+
+  // Validates and executes sampling.
+  bool Run() const;
+
+  // Ratios used to sample track, each clamped in range [0,1] before job
+  // execution. Sorted (or at least coherent) ratios sample faster, thanks to
+  // the context cache, but any order is valid.
+  span<const float> ratios;
+
+  // Track to sample.
+  const QuaternionTrack* track;
+
+  // Optional context, caching the last sampled keyframe interval across
+  // ratios and runs.
+  TrackSamplingContext* context;
+
+  // Job output, one quaternion per sampled ratio. Size must be at least
+  // ratios size.
+  span<math::Quaternion> results;
+};
+
+class QuantizedFloatTrack;
+
+// Samples a quantized float track, decompressing the keyframes relevant to the
+// sampled ratio on the fly. Behaves like FloatTrackSamplingJob, within
+// quantization precision.
+struct OZZ_ANIMATION_DLL QuantizedFloatTrackSamplingJob {
+  QuantizedFloatTrackSamplingJob();
+
+  // Validates all parameters.
+  bool Validate() const;
+
+  // Validates and executes sampling.
+  bool Run() const;
+
+  // Ratio used to sample track, clamped in range [0,1] before job execution.
+  float ratio;
+
+  // Track to sample.
+  const QuantizedFloatTrack* track;
+
+  // Optional context, making sampling O(1) when consecutive sample ratios
+  // remain in the same or the next keyframe interval.
+  TrackSamplingContext* context;
+
+  // Job output.
+  float* result;
+};
+
 }  // namespace animation
 }  // namespace ozz
 #endif  // OZZ_OZZ_ANIMATION_RUNTIME_TRACK_SAMPLING_JOB_H_
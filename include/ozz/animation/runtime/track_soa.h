@@ -0,0 +1,118 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_TRACK_SOA_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_TRACK_SOA_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/base/io/archive_traits.h"
+#include "ozz/base/platform.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+namespace animation {
+
+// Forward declares the TrackBuilder, used to instantiate a FloatTrackSoA.
+namespace offline {
+class TrackBuilder;
+}
+
+// Runtime aggregate of parallel float tracks, as built by TrackBuilder from a
+// set of raw float tracks. All tracks are resampled on the union of their
+// keyframe ratios, which is lossless for both linear and step interpolation,
+// so they share a single sorted ratios buffer. Values are interleaved per
+// keyframe (values of keyframe i are stored at [i * num_tracks,
+// (i + 1) * num_tracks)). This allows TrackSoASamplingJob to sample any number
+// of tracks with a single keyframe search, where sampling tracks individually
+// pays one binary search per track. The counterpart of sharing ratios is that
+// each track stores a value for every keyframe of the union, trading memory
+// for sampling speed. This suits sets of channels that are sampled together
+// every frame (blend-shape weights...).
+class OZZ_ANIMATION_DLL FloatTrackSoA {
+ public:
+  FloatTrackSoA();
+
+  // Allow move.
+  FloatTrackSoA(FloatTrackSoA&& _other);
+  FloatTrackSoA& operator=(FloatTrackSoA&& _other);
+
+  // Disables copy and assignation.
+  FloatTrackSoA(FloatTrackSoA const&) = delete;
+  void operator=(FloatTrackSoA const&) = delete;
+
+  ~FloatTrackSoA();
+
+  // Number of aggregated tracks (aka channels).
+  size_t num_tracks() const { return num_tracks_; }
+
+  // Keyframe ratios (0 is the beginning of the tracks, 1 is the end), shared
+  // by all tracks.
+  span<const float> ratios() const { return ratios_; }
+
+  // Keyframe values, num_tracks values per keyframe, interleaved per keyframe.
+  span<const float> values() const { return values_; }
+
+  // Keyframe modes (1 bit per key and per track): 1 for step, 0 for linear.
+  // Each keyframe owns a row of (num_tracks + 7) / 8 bytes, track i mode is
+  // bit i & 7 of byte i / 8 of its keyframe row.
+  span<const uint8_t> steps() const { return steps_; }
+
+  // Get the estimated size in bytes.
+  size_t size() const;
+
+  // Serialization functions.
+  // Should not be called directly but through io::Archive << and >> operators.
+  void Save(ozz::io::OArchive& _archive) const;
+  void Load(ozz::io::IArchive& _archive, uint32_t _version);
+
+ private:
+  // TrackBuilder class is allowed to allocate a FloatTrackSoA.
+  friend class offline::TrackBuilder;
+
+  // Internal memory management functions.
+  void Allocate(size_t _keys_count, size_t _num_tracks);
+  void Deallocate();
+
+  // Keyframe ratios, shared by all tracks.
+  span<float> ratios_;
+
+  // Interleaved keyframe values.
+  span<float> values_;
+
+  // Keyframe modes, one row of bits per keyframe.
+  span<uint8_t> steps_;
+
+  // Number of aggregated tracks.
+  size_t num_tracks_ = 0;
+};
+}  // namespace animation
+namespace io {
+OZZ_IO_TYPE_VERSION(1, animation::FloatTrackSoA)
+OZZ_IO_TYPE_TAG("ozz-float_track_soa", animation::FloatTrackSoA)
+}  // namespace io
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_TRACK_SOA_H_
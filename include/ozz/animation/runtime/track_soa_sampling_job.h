@@ -0,0 +1,71 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_TRACK_SOA_SAMPLING_JOB_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_TRACK_SOA_SAMPLING_JOB_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/base/platform.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+namespace animation {
+
+class FloatTrackSoA;
+
+// Samples all the tracks aggregated in a FloatTrackSoA at a single ratio,
+// with a single keyframe search shared by all tracks, where sampling the same
+// channels as individual FloatTrack pays one binary search per track.
+// Interpolation is then vectorized over the interleaved values layout. The
+// output is a contiguous span of values, one per track, ready for upload
+// (blend-shape weights...).
+struct OZZ_ANIMATION_DLL TrackSoASamplingJob {
+  TrackSoASamplingJob();
+
+  // Validates all parameters.
+  // Returns true for a valid job, false otherwise:
+  // - if tracks is nullptr.
+  // - if results doesn't store at least tracks' num_tracks values.
+  bool Validate() const;
+
+  // Validates and executes sampling.
+  bool Run() const;
+
+  // Ratio used to sample tracks, clamped in range [0,1] before job execution.
+  // 0 is the beginning of the tracks, 1 is the end.
+  float ratio;
+
+  // Aggregated tracks to sample.
+  const FloatTrackSoA* tracks;
+
+  // Job output, one value per track. Must store at least tracks' num_tracks
+  // values.
+  span<float> results;
+};
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_TRACK_SOA_SAMPLING_JOB_H_
@@ -30,11 +30,13 @@
 
 #include "ozz/animation/runtime/export.h"
 #include "ozz/base/platform.h"
+#include "ozz/base/span.h"
 
 namespace ozz {
 namespace animation {
 
 class FloatTrack;
+class TrackEdgeIndex;
 
 // Track edge triggering job implementation. Edge triggering wording refers to
 // signal processing, where a signal edge is a transition from low to high or
@@ -157,6 +159,114 @@ class OZZ_ANIMATION_DLL TrackTriggeringJob::Iterator {
 inline TrackTriggeringJob::Iterator TrackTriggeringJob::end() const {
   return Iterator(this, Iterator::End());
 }
+
+// Edge triggering job variant working on a TrackEdgeIndex, as precomputed by
+// TrackBuilder from a raw float track and a threshold value. Where
+// TrackTriggeringJob scans every keyframe lazily, this job binary searches the
+// precomputed edges and outputs all edges of the [from, to[ range at once, as
+// a span. It detects the exact same edges as TrackTriggeringJob would on the
+// same track with the index threshold, in the same order, with the same
+// from/to semantic (any sign, any order, any range).
+struct OZZ_ANIMATION_DLL TrackEdgeTriggeringJob {
+  TrackEdgeTriggeringJob();
+
+  // Validates job parameters.
+  bool Validate() const;
+
+  // Validates and executes job. Returns false if validation failed, or if the
+  // edges buffer is too small to store all the edges of the range, in which
+  // case the buffer is filled to its capacity.
+  bool Run() const;
+
+  // Input range. 0 is the beginning of the track, 1 is the end. Follows
+  // TrackTriggeringJob from/to semantic.
+  float from;
+  float to;
+
+  // Edge index to search. The detection threshold is baked in the index.
+  const TrackEdgeIndex* index;
+
+  // Edge type, shared with TrackTriggeringJob.
+  typedef TrackTriggeringJob::Edge Edge;
+
+  // In/out edges buffer. The caller provides the buffer capacity, the job
+  // shrinks the span to the edges actually found, ordered from "from" to "to".
+  span<Edge>* edges;
+};
+
+// Collects edges of many tracks over a single [from, to[ window into one time
+// sorted event stream. Game logic typically consumes events from several
+// tracks per character (footsteps, audio, fx...): running this job spares
+// iterating each track separately and merging the results, and is allocation
+// free. Each track is identified by a TrackEdgeIndex, as precomputed by
+// TrackBuilder. Edges are detected per track exactly like
+// TrackEdgeTriggeringJob, then ordered from "from" to "to", with edges
+// triggering at the very same ratio ordered by track index.
+struct OZZ_ANIMATION_DLL MultiTrackEdgeTriggeringJob {
+  MultiTrackEdgeTriggeringJob();
+
+  // Validates job parameters.
+  bool Validate() const;
+
+  // Validates and executes job. Returns false if validation failed, or if the
+  // edges buffer is too small to store all the edges of the range, in which
+  // case the buffer is filled (and sorted) to its capacity.
+  bool Run() const;
+
+  // Input range. 0 is the beginning of the tracks, 1 is the end. Follows
+  // TrackTriggeringJob from/to semantic.
+  float from;
+  float to;
+
+  // Edge indices of all the tracks to collect. The detection thresholds are
+  // baked in the indices. None can be nullptr.
+  span<const TrackEdgeIndex* const> indices;
+
+  // An edge, tagged with the track it was detected on.
+  struct TrackEdge {
+    float ratio;  // Ratio at which track value crossed threshold.
+    bool rising;  // true is edge is rising (getting higher than threshold).
+    int track;    // Index of the edge's track within the indices range.
+  };
+
+  // In/out edges buffer. The caller provides the buffer capacity, the job
+  // shrinks the span to the edges actually found.
+  span<TrackEdge>* edges;
+};
+
+// Batched prefilter for edge triggering across many characters. Most frames,
+// most characters cross no edge within their tick window: this job tests each
+// entry's [from, to[ window against the coarse bucket summary of its track
+// edge index (see TrackEdgeIndex::edge_buckets), and outputs a bitset of the
+// entries that may contain edges. Entries with a cleared bit provably contain
+// none and can skip edge triggering entirely, so per frame triggering work
+// becomes proportional to actual events rather than to character count. The
+// filter is conservative: a set bit only means the window overlaps a bucket
+// that contains edges, triggering jobs remain responsible for exact
+// detection.
+struct OZZ_ANIMATION_DLL TrackEdgePrefilterJob {
+  TrackEdgePrefilterJob();
+
+  // Validates job parameters.
+  bool Validate() const;
+
+  // Validates and executes job.
+  bool Run() const;
+
+  // Edge index of each entry (aka character). The same index can be
+  // referenced by multiple entries. None can be nullptr.
+  span<const TrackEdgeIndex* const> indices;
+
+  // Per entry range, following TrackTriggeringJob from/to semantic (any sign,
+  // any order, any range). Both ranges must have the same size as indices.
+  span<const float> froms;
+  span<const float> tos;
+
+  // Output bitset, 1 bit per entry: bit i & 7 of byte i / 8 is set if entry
+  // i window may contain edges, cleared if it provably contains none. Must
+  // have at least one bit per entry.
+  span<byte> candidates;
+};
 }  // namespace animation
 }  // namespace ozz
 #endif  // OZZ_OZZ_ANIMATION_RUNTIME_TRACK_TRIGGERING_JOB_H_
@@ -0,0 +1,113 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_ANIMATION_RUNTIME_WORKING_SET_IMAGE_H_
+#define OZZ_OZZ_ANIMATION_RUNTIME_WORKING_SET_IMAGE_H_
+
+#include "ozz/animation/runtime/export.h"
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+namespace animation {
+
+class Animation;
+
+// Relocatable image of a process animation working set: a collection of
+// pre-warmed sampling contexts, each keyed by the animation it was warmed
+// with. A warm process writes the image into a buffer it places in shared
+// memory, and new processes on the same host attach it copy-on-write
+// (MAP_PRIVATE): contexts are bound directly over the shared pages (see
+// SamplingJob::Context::LoadRaw), so spin-up skips state reconstruction
+// entirely and the kernel only duplicates pages a context actually diverges
+// on.
+// Pointers and registry handles are meaningless across processes, so entries
+// are identified by a caller-defined 64 bits key (content hash, path
+// hash...) that the attaching process resolves against its own asset
+// registry to find the animation each context must be re-bound to. Like
+// other raw images, working set images are not portable across
+// architectures.
+class OZZ_ANIMATION_DLL WorkingSetImage {
+ public:
+  // A working set entry to capture: a warmed context and the key identifying
+  // the animation it was warmed with.
+  struct Entry {
+    uint64_t key;
+    const SamplingJob::Context* context;
+  };
+
+  // Size in bytes of the image of _entries, to be used to allocate (or map)
+  // the buffer Write stores the image to.
+  static size_t RequiredSize(const span<const Entry>& _entries);
+
+  // Writes the image of _entries to _buffer, which must be at least
+  // RequiredSize(_entries) bytes, aligned on 16 bytes (alignof(SimdFloat4)).
+  // Returns false if the buffer is too small, misaligned, or if any entry
+  // context is null.
+  static bool Write(const span<const Entry>& _entries, span<byte> _buffer);
+
+  // Attaches *this to the image stored in _buffer, which usually maps shared
+  // memory. The buffer is referenced, not copied: it must be aligned on 16
+  // bytes and remain valid for the lifetime of every context bound from the
+  // image. It must be writable without affecting other processes, aka a
+  // copy-on-write mapping or private memory. Returns false if the buffer
+  // doesn't contain a compatible image, leaving the image empty.
+  bool Attach(span<byte> _buffer);
+
+  // Number of entries of the attached image.
+  int count() const { return static_cast<int>(entries_.size()); }
+
+  // Returns the key of the _entry-th image entry, which must be in range.
+  // Keys are stored in the order they were written.
+  uint64_t key(int _entry) const { return entries_[_entry].key; }
+
+  // Binds _context over the _entry-th image entry and to _animation, the
+  // animation the entry key resolves to in the attaching process. Nothing is
+  // copied, the context references the image pages. Returns false if the
+  // entry image is corrupt or if _animation layout doesn't match the one the
+  // context was warmed with, leaving the context invalidated.
+  bool Bind(int _entry, const Animation& _animation,
+            SamplingJob::Context* _context) const;
+
+ private:
+  // Offset and size in buffer_ of an entry context image, with its key.
+  struct EntryRange {
+    uint64_t key;
+    size_t offset;
+    size_t size;
+  };
+
+  // The attached image buffer, referenced only.
+  span<byte> buffer_;
+
+  // Per entry context image location, indexed by Attach.
+  vector<EntryRange> entries_;
+};
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_OZZ_ANIMATION_RUNTIME_WORKING_SET_IMAGE_H_
@@ -0,0 +1,98 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_BASE_COMPILED_JOB_H_
+#define OZZ_OZZ_BASE_COMPILED_JOB_H_
+
+#include "ozz/base/platform.h"
+
+namespace ozz {
+
+// Validate-once handle over an ozz job (animation::SamplingJob,
+// animation::BlendingJob, animation::LocalToModelJob, geometry::SkinningJob).
+// Job setups that are immutable across frames pay job validation (null
+// checks, range size checks...) on every Run call, although nothing changed
+// since the previous frame. Compiling a job (see Compile below) validates it
+// once and binds a copy of it to a handle whose Run goes straight to the job
+// task: debug builds still assert the job is valid on every run, release
+// builds skip validation entirely. Later changes to the original job don't
+// affect the handle, a modified setup must be bound again with Rebind, which
+// re-validates.
+// Note that validation covers the job setup (pointers, range sizes), not the
+// lifetime of pointed buffers, which must outlive the handle's runs as they
+// would the job's.
+template <typename _Job>
+class CompiledJob {
+ public:
+  // Constructs an unbound handle. Run fails until a valid job is bound.
+  CompiledJob() : valid_(false) {}
+
+  // Validates _job and binds a copy of it to *this handle.
+  explicit CompiledJob(const _Job& _job)
+      : job_(_job), valid_(job_.Validate()) {}
+
+  // Re-validates and binds a copy of _job, replacing the currently bound one.
+  // Returns true if _job is valid.
+  bool Rebind(const _Job& _job) {
+    job_ = _job;
+    valid_ = job_.Validate();
+    return valid_;
+  }
+
+  // Returns true if the bound job passed validation.
+  bool valid() const { return valid_; }
+
+  // Read access to the bound job.
+  const _Job& job() const { return job_; }
+
+  // Runs the bound job's task, skipping validation.
+  // Returns false if the handle isn't bound to a valid job.
+  bool Run() const {
+    if (!valid_) {
+      return false;
+    }
+    assert(job_.Validate() && "Bound job isn't valid anymore.");
+    job_.RunValidated();
+    return true;
+  }
+
+ private:
+  // The job copy that Run executes, validated at bind time.
+  _Job job_;
+
+  // True when job_ passed validation.
+  bool valid_;
+};
+
+// Returns a CompiledJob handle bound to _job. The handle is valid, hence its
+// Run functional, only if _job validates.
+template <typename _Job>
+inline CompiledJob<_Job> Compile(const _Job& _job) {
+  return CompiledJob<_Job>(_job);
+}
+}  // namespace ozz
+#endif  // OZZ_OZZ_BASE_COMPILED_JOB_H_
@@ -0,0 +1,193 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_BASE_CONTAINERS_FIXED_VECTOR_H_
+#define OZZ_OZZ_BASE_CONTAINERS_FIXED_VECTOR_H_
+
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ozz {
+
+// Vector with a fixed compile-time capacity and inline storage, aka it never
+// allocates. Exceeding the capacity asserts. Intended for job setup code and
+// other per-frame scratch data with small bounded element counts, where
+// ozz::vector heap traffic is measurable. The subset of std::vector interface
+// needed for such scratch usage is provided, including compatibility with
+// ozz::span and make_span.
+template <typename _Ty, size_t _Capacity>
+class fixed_vector {
+  static_assert(_Capacity > 0, "Capacity must be positive.");
+
+ public:
+  typedef _Ty value_type;
+  typedef _Ty* iterator;
+  typedef const _Ty* const_iterator;
+  typedef size_t size_type;
+
+  fixed_vector() : size_(0) {}
+
+  explicit fixed_vector(size_t _size) : size_(0) { resize(_size); }
+
+  fixed_vector(size_t _size, const _Ty& _value) : size_(0) {
+    resize(_size, _value);
+  }
+
+  fixed_vector(std::initializer_list<_Ty> _list) : size_(0) {
+    assert(_list.size() <= _Capacity && "Capacity exceeded.");
+    for (const _Ty& value : _list) {
+      push_back(value);
+    }
+  }
+
+  fixed_vector(const fixed_vector& _other) : size_(0) {
+    for (size_t i = 0; i < _other.size_; ++i) {
+      push_back(_other[i]);
+    }
+  }
+
+  fixed_vector(fixed_vector&& _other) : size_(0) {
+    for (size_t i = 0; i < _other.size_; ++i) {
+      push_back(std::move(_other[i]));
+    }
+    _other.clear();
+  }
+
+  fixed_vector& operator=(const fixed_vector& _other) {
+    if (this != &_other) {
+      clear();
+      for (size_t i = 0; i < _other.size_; ++i) {
+        push_back(_other[i]);
+      }
+    }
+    return *this;
+  }
+
+  fixed_vector& operator=(fixed_vector&& _other) {
+    if (this != &_other) {
+      clear();
+      for (size_t i = 0; i < _other.size_; ++i) {
+        push_back(std::move(_other[i]));
+      }
+      _other.clear();
+    }
+    return *this;
+  }
+
+  ~fixed_vector() { clear(); }
+
+  void push_back(const _Ty& _value) {
+    assert(size_ < _Capacity && "Capacity exceeded.");
+    new (data() + size_) _Ty(_value);
+    ++size_;
+  }
+
+  void push_back(_Ty&& _value) {
+    assert(size_ < _Capacity && "Capacity exceeded.");
+    new (data() + size_) _Ty(std::move(_value));
+    ++size_;
+  }
+
+  template <typename... _Args>
+  void emplace_back(_Args&&... _args) {
+    assert(size_ < _Capacity && "Capacity exceeded.");
+    new (data() + size_) _Ty(std::forward<_Args>(_args)...);
+    ++size_;
+  }
+
+  void pop_back() {
+    assert(size_ > 0 && "Vector is empty.");
+    --size_;
+    data()[size_].~_Ty();
+  }
+
+  void resize(size_t _size) {
+    assert(_size <= _Capacity && "Capacity exceeded.");
+    while (size_ > _size) {
+      pop_back();
+    }
+    while (size_ < _size) {
+      new (data() + size_) _Ty();
+      ++size_;
+    }
+  }
+
+  void resize(size_t _size, const _Ty& _value) {
+    assert(_size <= _Capacity && "Capacity exceeded.");
+    while (size_ > _size) {
+      pop_back();
+    }
+    while (size_ < _size) {
+      push_back(_value);
+    }
+  }
+
+  void clear() {
+    while (size_ > 0) {
+      pop_back();
+    }
+  }
+
+  _Ty& operator[](size_t _i) {
+    assert(_i < size_ && "Index out of range.");
+    return data()[_i];
+  }
+  const _Ty& operator[](size_t _i) const {
+    assert(_i < size_ && "Index out of range.");
+    return data()[_i];
+  }
+
+  _Ty& front() { return (*this)[0]; }
+  const _Ty& front() const { return (*this)[0]; }
+  _Ty& back() { return (*this)[size_ - 1]; }
+  const _Ty& back() const { return (*this)[size_ - 1]; }
+
+  _Ty* data() { return reinterpret_cast<_Ty*>(buffer_); }
+  const _Ty* data() const { return reinterpret_cast<const _Ty*>(buffer_); }
+
+  iterator begin() { return data(); }
+  const_iterator begin() const { return data(); }
+  iterator end() { return data() + size_; }
+  const_iterator end() const { return data() + size_; }
+
+  size_t size() const { return size_; }
+  static constexpr size_t capacity() { return _Capacity; }
+  static constexpr size_t max_size() { return _Capacity; }
+  bool empty() const { return size_ == 0; }
+
+ private:
+  // Uninitialized inline storage, elements are constructed in place.
+  typename std::aligned_storage<sizeof(_Ty), alignof(_Ty)>::type
+      buffer_[_Capacity];
+  size_t size_;
+};
+}  // namespace ozz
+#endif  // OZZ_OZZ_BASE_CONTAINERS_FIXED_VECTOR_H_
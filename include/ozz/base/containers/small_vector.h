@@ -0,0 +1,263 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_BASE_CONTAINERS_SMALL_VECTOR_H_
+#define OZZ_OZZ_BASE_CONTAINERS_SMALL_VECTOR_H_
+
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "ozz/base/memory/allocator.h"
+
+namespace ozz {
+
+// Vector with inline storage for its first _InlineCapacity elements, spilling
+// to the (redirected) heap only beyond that. Sized for the common case, it
+// makes small bounded collections (blend layer lists, IK chain scratch,
+// triggering edges...) allocation-free in per-frame code, while remaining
+// correct for the uncommon bigger cases. The subset of std::vector interface
+// needed for such usage is provided, including compatibility with ozz::span
+// and make_span. Unlike ozz::vector, moving a small_vector moves elements
+// when they are stored inline, so data() stability across moves isn't
+// guaranteed.
+template <typename _Ty, size_t _InlineCapacity>
+class small_vector {
+  static_assert(_InlineCapacity > 0, "Inline capacity must be positive.");
+
+ public:
+  typedef _Ty value_type;
+  typedef _Ty* iterator;
+  typedef const _Ty* const_iterator;
+  typedef size_t size_type;
+
+  small_vector() : data_(inline_data()), size_(0), capacity_(_InlineCapacity) {}
+
+  explicit small_vector(size_t _size) : small_vector() { resize(_size); }
+
+  small_vector(size_t _size, const _Ty& _value) : small_vector() {
+    resize(_size, _value);
+  }
+
+  small_vector(std::initializer_list<_Ty> _list) : small_vector() {
+    reserve(_list.size());
+    for (const _Ty& value : _list) {
+      push_back(value);
+    }
+  }
+
+  small_vector(const small_vector& _other) : small_vector() {
+    reserve(_other.size_);
+    for (size_t i = 0; i < _other.size_; ++i) {
+      push_back(_other[i]);
+    }
+  }
+
+  small_vector(small_vector&& _other) : small_vector() {
+    if (!_other.is_inline()) {
+      // Steals the heap buffer.
+      data_ = _other.data_;
+      size_ = _other.size_;
+      capacity_ = _other.capacity_;
+      _other.data_ = _other.inline_data();
+      _other.size_ = 0;
+      _other.capacity_ = _InlineCapacity;
+    } else {
+      for (size_t i = 0; i < _other.size_; ++i) {
+        push_back(std::move(_other[i]));
+      }
+      _other.clear();
+    }
+  }
+
+  small_vector& operator=(const small_vector& _other) {
+    if (this != &_other) {
+      clear();
+      reserve(_other.size_);
+      for (size_t i = 0; i < _other.size_; ++i) {
+        push_back(_other[i]);
+      }
+    }
+    return *this;
+  }
+
+  small_vector& operator=(small_vector&& _other) {
+    if (this != &_other) {
+      clear();
+      if (!_other.is_inline()) {
+        // Steals the heap buffer, releasing any previous one.
+        if (!is_inline()) {
+          memory::default_allocator()->Deallocate(data_);
+        }
+        data_ = _other.data_;
+        size_ = _other.size_;
+        capacity_ = _other.capacity_;
+        _other.data_ = _other.inline_data();
+        _other.size_ = 0;
+        _other.capacity_ = _InlineCapacity;
+      } else {
+        for (size_t i = 0; i < _other.size_; ++i) {
+          push_back(std::move(_other[i]));
+        }
+        _other.clear();
+      }
+    }
+    return *this;
+  }
+
+  ~small_vector() {
+    clear();
+    if (!is_inline()) {
+      memory::default_allocator()->Deallocate(data_);
+    }
+  }
+
+  void push_back(const _Ty& _value) {
+    reserve(size_ + 1);
+    new (data_ + size_) _Ty(_value);
+    ++size_;
+  }
+
+  void push_back(_Ty&& _value) {
+    reserve(size_ + 1);
+    new (data_ + size_) _Ty(std::move(_value));
+    ++size_;
+  }
+
+  template <typename... _Args>
+  void emplace_back(_Args&&... _args) {
+    reserve(size_ + 1);
+    new (data_ + size_) _Ty(std::forward<_Args>(_args)...);
+    ++size_;
+  }
+
+  void pop_back() {
+    assert(size_ > 0 && "Vector is empty.");
+    --size_;
+    data_[size_].~_Ty();
+  }
+
+  // Grows storage to hold at least _capacity elements. Never shrinks, nor
+  // goes back to inline storage once spilled.
+  void reserve(size_t _capacity) {
+    if (_capacity <= capacity_) {
+      return;
+    }
+    // Doubles capacity to amortize growth, as std::vector does.
+    size_t new_capacity = capacity_ * 2;
+    if (new_capacity < _capacity) {
+      new_capacity = _capacity;
+    }
+    _Ty* new_data = static_cast<_Ty*>(memory::default_allocator()->Allocate(
+        sizeof(_Ty) * new_capacity, alignof(_Ty)));
+    for (size_t i = 0; i < size_; ++i) {
+      new (new_data + i) _Ty(std::move(data_[i]));
+      data_[i].~_Ty();
+    }
+    if (!is_inline()) {
+      memory::default_allocator()->Deallocate(data_);
+    }
+    data_ = new_data;
+    capacity_ = new_capacity;
+  }
+
+  void resize(size_t _size) {
+    reserve(_size);
+    while (size_ > _size) {
+      pop_back();
+    }
+    while (size_ < _size) {
+      new (data_ + size_) _Ty();
+      ++size_;
+    }
+  }
+
+  void resize(size_t _size, const _Ty& _value) {
+    reserve(_size);
+    while (size_ > _size) {
+      pop_back();
+    }
+    while (size_ < _size) {
+      push_back(_value);
+    }
+  }
+
+  void clear() {
+    while (size_ > 0) {
+      pop_back();
+    }
+  }
+
+  _Ty& operator[](size_t _i) {
+    assert(_i < size_ && "Index out of range.");
+    return data_[_i];
+  }
+  const _Ty& operator[](size_t _i) const {
+    assert(_i < size_ && "Index out of range.");
+    return data_[_i];
+  }
+
+  _Ty& front() { return (*this)[0]; }
+  const _Ty& front() const { return (*this)[0]; }
+  _Ty& back() { return (*this)[size_ - 1]; }
+  const _Ty& back() const { return (*this)[size_ - 1]; }
+
+  _Ty* data() { return data_; }
+  const _Ty* data() const { return data_; }
+
+  iterator begin() { return data_; }
+  const_iterator begin() const { return data_; }
+  iterator end() { return data_ + size_; }
+  const_iterator end() const { return data_ + size_; }
+
+  size_t size() const { return size_; }
+  size_t capacity() const { return capacity_; }
+  bool empty() const { return size_ == 0; }
+
+  // True as long as elements are stored inline, aka no allocation happened.
+  bool is_inline() const { return data_ == inline_data(); }
+
+ private:
+  _Ty* inline_data() { return reinterpret_cast<_Ty*>(buffer_); }
+  const _Ty* inline_data() const {
+    return reinterpret_cast<const _Ty*>(buffer_);
+  }
+
+  // Points to inline or heap storage.
+  _Ty* data_;
+  size_t size_;
+  size_t capacity_;
+
+  // Uninitialized inline storage, elements are constructed in place.
+  typename std::aligned_storage<sizeof(_Ty), alignof(_Ty)>::type
+      buffer_[_InlineCapacity];
+};
+}  // namespace ozz
+#endif  // OZZ_OZZ_BASE_CONTAINERS_SMALL_VECTOR_H_
@@ -32,6 +32,7 @@
 
 #include <cstddef>
 
+#include "ozz/base/maths/internal/simd_math_config.h"
 #include "ozz/base/platform.h"
 
 namespace ozz {
@@ -72,6 +73,105 @@ OZZ_INLINE void _in_place_byte_swap(byte& _a, byte& _b) {
   _a = _a ^ _b;
 }
 
+#if defined(OZZ_SIMD_SSEx)
+// Internal bulk byte swap helpers, reversing bytes within each element of a
+// buffer 32 then 16 bytes at a time with simd shuffles, instead of byte by
+// byte. Cooking assets for a target with a foreign endianness funnels every
+// array through these swaps, which dominate swap+copy time when scalar.
+// Helpers process as many whole simd registers as the buffer holds and
+// return the number of bytes swapped, trailing elements are left to the
+// caller's scalar loop.
+
+// Reverses bytes within each 2 bytes element of the _size bytes buffer.
+OZZ_INLINE size_t _bulk_byte_swap2(byte* _alias, size_t _size) {
+  size_t i = 0;
+  for (; i + 32 <= _size; i += 32) {
+    const __m128i lo =
+        _mm_loadu_si128(reinterpret_cast<__m128i*>(_alias + i));
+    const __m128i hi =
+        _mm_loadu_si128(reinterpret_cast<__m128i*>(_alias + i + 16));
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(_alias + i),
+        _mm_or_si128(_mm_slli_epi16(lo, 8), _mm_srli_epi16(lo, 8)));
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(_alias + i + 16),
+        _mm_or_si128(_mm_slli_epi16(hi, 8), _mm_srli_epi16(hi, 8)));
+  }
+  if (i + 16 <= _size) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i*>(_alias + i));
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(_alias + i),
+        _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+    i += 16;
+  }
+  return i;
+}
+
+// Reverses bytes within each 4 bytes element of a single register: swaps
+// bytes within each 16 bits word, then the 2 words of each element.
+OZZ_INLINE __m128i _register_byte_swap4(const __m128i& _v) {
+  const __m128i halves =
+      _mm_or_si128(_mm_slli_epi16(_v, 8), _mm_srli_epi16(_v, 8));
+  return _mm_shufflehi_epi16(
+      _mm_shufflelo_epi16(halves, _MM_SHUFFLE(2, 3, 0, 1)),
+      _MM_SHUFFLE(2, 3, 0, 1));
+}
+
+// Reverses bytes within each 4 bytes element of the _size bytes buffer.
+OZZ_INLINE size_t _bulk_byte_swap4(byte* _alias, size_t _size) {
+  size_t i = 0;
+  for (; i + 32 <= _size; i += 32) {
+    const __m128i lo =
+        _mm_loadu_si128(reinterpret_cast<__m128i*>(_alias + i));
+    const __m128i hi =
+        _mm_loadu_si128(reinterpret_cast<__m128i*>(_alias + i + 16));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(_alias + i),
+                     _register_byte_swap4(lo));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(_alias + i + 16),
+                     _register_byte_swap4(hi));
+  }
+  if (i + 16 <= _size) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i*>(_alias + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(_alias + i),
+                     _register_byte_swap4(v));
+    i += 16;
+  }
+  return i;
+}
+
+// Reverses bytes within each 8 bytes element of a single register: swaps
+// bytes within each 16 bits word, then reverses the 4 words of each element.
+OZZ_INLINE __m128i _register_byte_swap8(const __m128i& _v) {
+  const __m128i halves =
+      _mm_or_si128(_mm_slli_epi16(_v, 8), _mm_srli_epi16(_v, 8));
+  return _mm_shufflehi_epi16(
+      _mm_shufflelo_epi16(halves, _MM_SHUFFLE(0, 1, 2, 3)),
+      _MM_SHUFFLE(0, 1, 2, 3));
+}
+
+// Reverses bytes within each 8 bytes element of the _size bytes buffer.
+OZZ_INLINE size_t _bulk_byte_swap8(byte* _alias, size_t _size) {
+  size_t i = 0;
+  for (; i + 32 <= _size; i += 32) {
+    const __m128i lo =
+        _mm_loadu_si128(reinterpret_cast<__m128i*>(_alias + i));
+    const __m128i hi =
+        _mm_loadu_si128(reinterpret_cast<__m128i*>(_alias + i + 16));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(_alias + i),
+                     _register_byte_swap8(lo));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(_alias + i + 16),
+                     _register_byte_swap8(hi));
+  }
+  if (i + 16 <= _size) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i*>(_alias + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(_alias + i),
+                     _register_byte_swap8(v));
+    i += 16;
+  }
+  return i;
+}
+#endif  // OZZ_SIMD_SSEx
+
 // EndianSwapper specialization for 1 byte types.
 template <typename _Ty>
 struct EndianSwapper<_Ty, 1> {
@@ -84,7 +184,11 @@ template <typename _Ty>
 struct EndianSwapper<_Ty, 2> {
   OZZ_INLINE static void Swap(_Ty* _ty, size_t _count) {
     byte* alias = reinterpret_cast<byte*>(_ty);
-    for (size_t i = 0; i < _count * 2; i += 2) {
+    size_t i = 0;
+#if defined(OZZ_SIMD_SSEx)
+    i = _bulk_byte_swap2(alias, _count * 2);
+#endif  // OZZ_SIMD_SSEx
+    for (; i < _count * 2; i += 2) {
       _in_place_byte_swap(alias[i + 0], alias[i + 1]);
     }
   }
@@ -100,7 +204,11 @@ template <typename _Ty>
 struct EndianSwapper<_Ty, 4> {
   OZZ_INLINE static void Swap(_Ty* _ty, size_t _count) {
     byte* alias = reinterpret_cast<byte*>(_ty);
-    for (size_t i = 0; i < _count * 4; i += 4) {
+    size_t i = 0;
+#if defined(OZZ_SIMD_SSEx)
+    i = _bulk_byte_swap4(alias, _count * 4);
+#endif  // OZZ_SIMD_SSEx
+    for (; i < _count * 4; i += 4) {
       _in_place_byte_swap(alias[i + 0], alias[i + 3]);
       _in_place_byte_swap(alias[i + 1], alias[i + 2]);
     }
@@ -118,7 +226,11 @@ template <typename _Ty>
 struct EndianSwapper<_Ty, 8> {
   OZZ_INLINE static void Swap(_Ty* _ty, size_t _count) {
     byte* alias = reinterpret_cast<byte*>(_ty);
-    for (size_t i = 0; i < _count * 8; i += 8) {
+    size_t i = 0;
+#if defined(OZZ_SIMD_SSEx)
+    i = _bulk_byte_swap8(alias, _count * 8);
+#endif  // OZZ_SIMD_SSEx
+    for (; i < _count * 8; i += 8) {
       _in_place_byte_swap(alias[i + 0], alias[i + 7]);
       _in_place_byte_swap(alias[i + 1], alias[i + 6]);
       _in_place_byte_swap(alias[i + 2], alias[i + 5]);
@@ -0,0 +1,179 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_BASE_IO_ARCHIVE_BUNDLE_H_
+#define OZZ_OZZ_BASE_IO_ARCHIVE_BUNDLE_H_
+
+#include "ozz/base/containers/string.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/endianness.h"
+#include "ozz/base/io/archive.h"
+#include "ozz/base/io/stream.h"
+
+namespace ozz {
+namespace io {
+
+// Writes a bundle of named archived objects to a single stream, typically a
+// .ozzpak file. A bundle packs many objects (skeletons, animations,
+// tracks...) in one file, with a front-loaded name->offset index, so that a
+// whole level's assets are read through a single open and a few seeks rather
+// than thousands of per-file open/tag/version round trips.
+// Objects are accumulated with Add, then the index and all objects are
+// written at Close time. Each object is stored as a standalone archive, so
+// tag and version checks still protect every entry at read time.
+class OZZ_BASE_DLL ArchiveBundleWriter {
+ public:
+  // Constructs a writer that will output the bundle to _stream, serializing
+  // objects with _endianness.
+  explicit ArchiveBundleWriter(
+      Stream* _stream, Endianness _endianness = GetNativeEndianness());
+
+  // Closes the bundle, see Close.
+  ~ArchiveBundleWriter();
+
+  // Serializes _object under _name. Names must be unique within a bundle,
+  // adding a duplicated name fails. Returns false if the bundle is already
+  // closed or the name is duplicated.
+  template <typename _Ty>
+  bool Add(const char* _name, const _Ty& _object) {
+    if (closed_ || Find(_name) != -1) {
+      return false;
+    }
+    const size_t begin = static_cast<size_t>(blobs_.Tell());
+    {
+      // Entries use the type table format, objects with many tagged
+      // sub-objects only store each tag string once.
+      OArchive archive(&blobs_, endianness_, true);
+      archive << _object;
+    }
+    const size_t end = static_cast<size_t>(blobs_.Tell());
+    entries_.push_back({_name, begin, end - begin});
+    return true;
+  }
+
+  // Writes the bundle (index followed by all objects) to the output stream.
+  // Called from the destructor if not done explicitly. Returns false if
+  // already closed.
+  bool Close();
+
+ private:
+  ArchiveBundleWriter(const ArchiveBundleWriter&) = delete;
+  ArchiveBundleWriter& operator=(const ArchiveBundleWriter&) = delete;
+
+  // Returns the index of the entry named _name, -1 if not found.
+  int Find(const char* _name) const;
+
+  // An object added to the bundle, with its byte range within blobs_.
+  struct Entry {
+    string name;
+    size_t offset;
+    size_t size;
+  };
+
+  // Output stream, written at Close time.
+  Stream* stream_;
+
+  // Serialization endianness of bundled objects.
+  Endianness endianness_;
+
+  // Buffers serialized objects until Close.
+  MemoryStream blobs_;
+
+  // Index of added objects.
+  vector<Entry> entries_;
+
+  // Set once the bundle has been written out.
+  bool closed_ = false;
+};
+
+// Reads objects from a bundle written by ArchiveBundleWriter. The index is
+// read at construction time, objects are deserialized on demand by Get,
+// seeking straight to the requested entry. The stream must remain valid for
+// the lifetime of the bundle, and isn't used concurrently by the bundle.
+class OZZ_BASE_DLL ArchiveBundle {
+ public:
+  // Reads the bundle index from _stream, which must be positioned at the
+  // beginning of a bundle.
+  explicit ArchiveBundle(Stream* _stream);
+
+  // Returns true if a valid bundle index was read at construction time.
+  bool valid() const { return valid_; }
+
+  // Number of objects in the bundle.
+  size_t size() const { return entries_.size(); }
+
+  // Name of the _index'th object, in bundle order.
+  const char* name(size_t _index) const { return entries_[_index].name.c_str(); }
+
+  // Deserializes the object named _name to _object. Returns false if the
+  // bundle is invalid, if no entry matches _name, or if the entry's archive
+  // tag doesn't match _Ty.
+  template <typename _Ty>
+  bool Get(const char* _name, _Ty* _object) {
+    const int found = Find(_name);
+    if (found == -1) {
+      return false;
+    }
+    const Entry& entry = entries_[found];
+    stream_->Seek(static_cast<int>(begin_ + entry.offset), Stream::kSet);
+    IArchive archive(stream_);
+    if (!archive.TestTag<_Ty>()) {
+      return false;
+    }
+    archive >> *_object;
+    return true;
+  }
+
+ private:
+  ArchiveBundle(const ArchiveBundle&) = delete;
+  ArchiveBundle& operator=(const ArchiveBundle&) = delete;
+
+  // Returns the index of the entry named _name, -1 if not found.
+  int Find(const char* _name) const;
+
+  // An indexed object, with its byte range relative to the blob section.
+  struct Entry {
+    string name;
+    size_t offset;
+    size_t size;
+  };
+
+  // The bundle stream.
+  Stream* stream_;
+
+  // Absolute offset of the blob section within the stream.
+  size_t begin_ = 0;
+
+  // Index read at construction time.
+  vector<Entry> entries_;
+
+  // Index validity, see valid().
+  bool valid_ = false;
+};
+}  // namespace io
+}  // namespace ozz
+#endif  // OZZ_OZZ_BASE_IO_ARCHIVE_BUNDLE_H_
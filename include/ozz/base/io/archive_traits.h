@@ -201,6 +201,22 @@ struct Extern;
   };                                                                  \
   }  // internal
 
+// Declares that _type's serialized form is its exact in-memory layout: no
+// padding, no pointer, no per-member conversion beside endianness. Arrays of
+// raw types are read and written with a single stream access when the archive
+// endianness matches the native one, instead of going through element-wise
+// serialization. This doesn't change the archive format: the element-wise
+// (endian swapping) path must produce the very same bytes.
+// This macro must be used inside namespace ozz::io.
+// Syntax is: OZZ_IO_TYPE_RAW(Foo).
+#define OZZ_IO_TYPE_RAW(_type) \
+  namespace internal {         \
+  template <>                  \
+  struct Raw<const _type> {    \
+    enum { kValue = 1 };       \
+  };                           \
+  }  // internal
+
 namespace internal {
 // Definition of version specializable template struct.
 // There's no default implementation in order to force user to define it, which
@@ -214,6 +230,12 @@ template <typename _Ty>
 struct Tag {
   enum { kTagLength = 0 };
 };
+
+// Defines default raw serialization value, which is disabled.
+template <typename _Ty>
+struct Raw {
+  enum { kValue = 0 };
+};
 }  // namespace internal
 }  // namespace io
 }  // namespace ozz
@@ -0,0 +1,156 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_BASE_IO_ASYNC_LOADER_H_
+#define OZZ_OZZ_BASE_IO_ASYNC_LOADER_H_
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "ozz/base/containers/deque.h"
+#include "ozz/base/containers/string.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/io/archive.h"
+#include "ozz/base/io/stream.h"
+
+namespace ozz {
+namespace io {
+
+// Loads archived ozz objects (Skeleton, Animation, Track...) from files on a
+// background worker thread, so file reads, tag/version checks and
+// deserialization don't block the requesting (usually main) thread.
+// Requests are identified by tickets. Completion can be polled per ticket
+// (status), popped from the completion queue in completion order
+// (PopCompleted), or waited for (Wait, WaitAll).
+// Objects being loaded must not be read nor destroyed until their request
+// completes. All public functions must be called from a single thread,
+// loading itself is the only concurrent part.
+class OZZ_BASE_DLL AsyncLoader {
+ public:
+  // Identifies a load request. Tickets are never reused by a same loader.
+  typedef size_t Ticket;
+
+  // Completion state of a request.
+  enum Status {
+    kPending,  // Not completed yet.
+    kSuccess,  // Completed, the object was loaded.
+    kFailed,   // Completed, the file couldn't be open, its tag didn't match
+               // the requested type, or deserialization failed.
+  };
+
+  // Starts the worker thread.
+  AsyncLoader();
+
+  // Waits for all pending requests and stops the worker thread.
+  ~AsyncLoader();
+
+  // Schedules loading of _object from the archive file at _path. The file
+  // must start with the tag of _Ty, as written by an OArchive. _object must
+  // remain valid until the request completes, and must not be accessed before
+  // that. Returns the request ticket.
+  template <typename _Ty>
+  Ticket Load(const char* _path, _Ty* _object) {
+    return Schedule(_path, _object, &LoadObject<_Ty>);
+  }
+
+  // Polls the completion state of a request. Doesn't block.
+  Status status(Ticket _ticket) const;
+
+  // Pops the next completed request from the completion queue, in completion
+  // order. Returns false if no request has completed since the last pop.
+  // _ticket and _success are optional outputs.
+  bool PopCompleted(Ticket* _ticket = nullptr, bool* _success = nullptr);
+
+  // Blocks until the request identified by _ticket completes. Returns true if
+  // the object was successfully loaded.
+  bool Wait(Ticket _ticket);
+
+  // Blocks until all scheduled requests have completed.
+  void WaitAll();
+
+ private:
+  AsyncLoader(const AsyncLoader&) = delete;
+  AsyncLoader& operator=(const AsyncLoader&) = delete;
+
+  // Type erased loading function, deserializing a file into an object.
+  typedef bool (*LoadFn)(const char* _path, void* _object);
+
+  // Performs the actual loading of a _Ty object, on the worker thread.
+  template <typename _Ty>
+  static bool LoadObject(const char* _path, void* _object) {
+    File file(_path, "rb");
+    if (!file.opened()) {
+      return false;
+    }
+    IArchive archive(&file);
+    if (!archive.TestTag<_Ty>()) {
+      return false;
+    }
+    archive >> *static_cast<_Ty*>(_object);
+    return true;
+  }
+
+  // Queues a request and wakes the worker up.
+  Ticket Schedule(const char* _path, void* _object, LoadFn _fn);
+
+  // Worker thread loop.
+  void Loop();
+
+  // A scheduled request.
+  struct Request {
+    string path;
+    void* object;
+    LoadFn fn;
+    Ticket ticket;
+  };
+
+  // Protects all following members, which are shared with the worker.
+  mutable std::mutex mutex_;
+
+  // Signaled when a request is queued or completed, and at exit time.
+  std::condition_variable condition_;
+
+  // Requests waiting for the worker, in scheduling order.
+  deque<Request> pending_;
+
+  // Completion state of every request ever scheduled, indexed by ticket.
+  vector<Status> statuses_;
+
+  // Completed requests not popped yet, in completion order.
+  deque<Ticket> completed_;
+
+  // Worker exit request, set by the destructor.
+  bool exit_ = false;
+
+  // The worker thread, last member so it starts after other members are
+  // initialized.
+  std::thread worker_;
+};
+}  // namespace io
+}  // namespace ozz
+#endif  // OZZ_OZZ_BASE_IO_ASYNC_LOADER_H_
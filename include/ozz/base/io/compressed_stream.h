@@ -0,0 +1,144 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_BASE_IO_COMPRESSED_STREAM_H_
+#define OZZ_OZZ_BASE_IO_COMPRESSED_STREAM_H_
+
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/io/stream.h"
+
+namespace ozz {
+namespace io {
+
+// Stream adapter layering block-based fast-decode compression (lz77 with a
+// byte-oriented lz4-class encoding) over any other Stream. Data written
+// through the adapter is buffered, compressed and emitted per block, so
+// reading back is chunked too: only one block is ever inflated in memory,
+// keeping IArchive reads streaming rather than requiring the whole payload
+// decompressed up front. Incompressible blocks are stored raw.
+// The adapter is either a write (compressing) or read (decompressing) end,
+// selected at construction. Seeking is supported on the read end: forward
+// seeks skip whole compressed blocks without inflating them, backward seeks
+// restart from the first block.
+// The compressed container header is stored with native endianness, it is
+// not meant to be exchanged across architectures of different endianness.
+// The payload itself is opaque, an embedded archive handles its own
+// endianness as usual.
+class OZZ_BASE_DLL CompressedStream : public Stream {
+ public:
+  // Adapter end type.
+  enum Mode {
+    kRead,   // Decompresses data from _stream.
+    kWrite,  // Compresses data to _stream.
+  };
+
+  // Constructs an adapter over _stream, which must remain valid for the
+  // lifetime of the adapter and must not be used concurrently. On kRead mode,
+  // _stream must be positioned at the beginning of a compressed container.
+  // Use opened() to test construction success.
+  CompressedStream(Stream* _stream, Mode _mode);
+
+  // Flushes pending data on the write end, see Flush.
+  virtual ~CompressedStream();
+
+  // Compresses and writes out pending data, and finalizes the container
+  // header. Automatically called at destruction time. The stream remains
+  // usable for writing, following data starts a new block.
+  // Returns false on the read end, or if writing to the underlying stream
+  // failed.
+  bool Flush();
+
+  // See Stream::opened for details.
+  virtual bool opened() const;
+
+  // See Stream::Read for details. Read end only.
+  virtual size_t Read(void* _buffer, size_t _size);
+
+  // See Stream::Write for details. Write end only.
+  virtual size_t Write(const void* _buffer, size_t _size);
+
+  // See Stream::Seek for details. Read end only, offsets are expressed in
+  // uncompressed bytes.
+  virtual int Seek(int _offset, Origin _origin);
+
+  // See Stream::Tell for details. Position is expressed in uncompressed
+  // bytes.
+  virtual int Tell() const;
+
+  // See Stream::Size for details. Size is the total uncompressed payload
+  // size.
+  virtual size_t Size() const;
+
+ private:
+  // Moves to the next block. The block is inflated if it contains the
+  // logical offset _target, otherwise its compressed content is skipped
+  // without being decompressed. Returns false at end of container or on
+  // error.
+  bool NextBlock(size_t _target);
+
+  // Compresses and writes out the pending block. Returns false on write
+  // error.
+  bool WriteBlock();
+
+  // The underlying stream.
+  Stream* stream_;
+
+  // Adapter end type.
+  Mode mode_;
+
+  // False as soon as a container or io error was met.
+  bool valid_ = false;
+
+  // Position of the container header in the underlying stream, needed to
+  // finalize the total size at flush time.
+  int header_pos_ = 0;
+
+  // Uncompressed block size of the container being read.
+  size_t block_size_ = 0;
+
+  // Total uncompressed payload size. Grows with writes on the write end,
+  // read from the container header on the read end.
+  size_t total_ = 0;
+
+  // Logical (uncompressed) offset of the first byte of block_.
+  size_t block_start_ = 0;
+
+  // Read cursor within block_.
+  size_t cursor_ = 0;
+
+  // Inflated current block (read end).
+  vector<byte> block_;
+
+  // Uncompressed data waiting to fill a block (write end).
+  vector<byte> pending_;
+
+  // Compressed data scratch buffer.
+  vector<byte> cbuffer_;
+};
+}  // namespace io
+}  // namespace ozz
+#endif  // OZZ_OZZ_BASE_IO_COMPRESSED_STREAM_H_
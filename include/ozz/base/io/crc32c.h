@@ -0,0 +1,52 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_BASE_IO_CRC32C_H_
+#define OZZ_OZZ_BASE_IO_CRC32C_H_
+
+#include <stdint.h>
+
+#include <cstddef>
+
+#include "ozz/base/export.h"
+
+namespace ozz {
+namespace io {
+
+// Computes the CRC32C (Castagnoli polynomial) checksum of _size bytes of
+// _data, continuing from _crc. Pass 0 for the first buffer, and the previous
+// return value to checksum a stream of buffers incrementally: feeding buffers
+// piecewise gives the same result as a single call over the concatenation.
+// CRC32C was chosen over the historical CRC32 polynomial because x86 (SSE4.2)
+// and ARMv8 expose instructions for it, making checksum cost negligible
+// compared to the I/O it validates. A portable implementation is used on
+// platforms without these instructions.
+OZZ_BASE_DLL uint32_t CRC32C(uint32_t _crc, const void* _data, size_t _size);
+
+}  // namespace io
+}  // namespace ozz
+#endif  // OZZ_OZZ_BASE_IO_CRC32C_H_
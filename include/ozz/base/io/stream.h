@@ -131,6 +131,58 @@ class OZZ_BASE_DLL File : public Stream {
   void* file_;
 };
 
+// Write-buffering decorator over any other Stream. Serialization code
+// (OArchive) writes primitives one by one, which makes millions of tiny
+// backend writes when cooking large assets to a File. BufferedStream
+// coalesces writes into block-sized backend accesses. Reads and seeks flush
+// pending data first, so the decorated stream can be used transparently.
+// Buffered bytes are acknowledged before reaching the backend: errors are
+// reported by Flush (called from the destructor too), call it explicitly to
+// get a write status.
+class OZZ_BASE_DLL BufferedStream : public Stream {
+ public:
+  // Constructs a buffered stream writing to _stream, which must remain valid
+  // for the lifetime of the buffered stream. _buffer_size is the backend
+  // write block size.
+  explicit BufferedStream(Stream* _stream, size_t _buffer_size = 64 << 10);
+
+  // Flushes pending writes, see Flush.
+  virtual ~BufferedStream();
+
+  // Writes pending buffered data to the backend stream. Returns false if the
+  // backend failed to write it all.
+  bool Flush();
+
+  // See Stream::opened for details.
+  virtual bool opened() const;
+
+  // See Stream::Read for details. Flushes pending writes first.
+  virtual size_t Read(void* _buffer, size_t _size);
+
+  // See Stream::Write for details.
+  virtual size_t Write(const void* _buffer, size_t _size);
+
+  // See Stream::Seek for details. Flushes pending writes first.
+  virtual int Seek(int _offset, Origin _origin);
+
+  // See Stream::Tell for details, accounts for pending writes.
+  virtual int Tell() const;
+
+  // See Stream::Size for details, accounts for pending writes.
+  virtual size_t Size() const;
+
+ private:
+  // The decorated stream.
+  Stream* stream_;
+
+  // Write coalescing buffer, of size buffer_size_.
+  byte* buffer_;
+  size_t buffer_size_;
+
+  // Number of buffered bytes not yet written to the backend.
+  size_t pending_;
+};
+
 // Implements an in-memory Stream. Allows to use a memory buffer as a Stream.
 // The opening mode is equivalent to fopen w+b (binary read/write).
 class OZZ_BASE_DLL MemoryStream : public Stream {
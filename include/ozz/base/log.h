@@ -93,6 +93,11 @@ class OZZ_BASE_DLL Logger {
   Logger(const Logger&);
   void operator=(Logger&);
 
+  // Destination stream when an AsyncSink defers the output, nullptr
+  // otherwise. The formatted message is forwarded to the sink at destruction
+  // time.
+  std::ostream* deferred_;
+
   // Selected output stream.
   std::ostream& stream_;
 
@@ -129,6 +134,31 @@ class OZZ_BASE_DLL Err : public Logger {
   Err();
 };
 
+// Defers log output to a background thread. While an AsyncSink exists, log
+// statements format their message to a local in-memory stream and enqueue it
+// to a lock-free ring buffer, the sink's thread writes queued messages to
+// their destination stream. This keeps the (comparatively very slow)
+// synchronized console output off the logging thread, making verbose logging
+// cheap enough to leave enabled in live diagnostics builds. Logging level
+// filtering still applies before any message is queued.
+// If the ring buffer is full, messages fall back to a synchronous write
+// rather than being dropped. Pending messages are drained at sink destruction
+// time. A single sink can be installed at a time, and it must outlive any
+// concurrent log statement.
+class OZZ_BASE_DLL AsyncSink {
+ public:
+  // Installs the sink. _max_pending is the ring buffer capacity, rounded up
+  // to a power of 2.
+  explicit AsyncSink(size_t _max_pending = 256);
+
+  // Drains pending messages and restores synchronous logging.
+  ~AsyncSink();
+
+ private:
+  AsyncSink(const AsyncSink&);
+  void operator=(const AsyncSink&);
+};
+
 // RAII helper that modifies float logging precision, and restores default
 // settings when exiting scope.
 // User is reponsible for making sure stream still exist upon RAII destruction.
@@ -31,6 +31,7 @@
 #include <cstddef>
 
 #include "ozz/base/maths/vec_float.h"
+#include "ozz/base/span.h"
 
 namespace ozz {
 namespace math {
@@ -79,6 +80,24 @@ OZZ_INLINE Box Merge(const Box& _a, const Box& _b) {
 
 // Compute box transformation by a matrix.
 OZZ_BASE_DLL Box TransformBox(const Float4x4& _matrix, const Box& _box);
+
+// Builds the smallest box containing the translations (3rd column) of all
+// _matrices, the joint extent pattern for model-space matrix palettes. Simd
+// accumulation processes 4 matrices per iteration. Returns an invalid box if
+// _matrices is empty.
+OZZ_BASE_DLL Box TranslationsBox(const span<const Float4x4>& _matrices);
+
+// Merges all _boxes, the simd equivalent of folding Merge over the span.
+// Invalid boxes are ignored. Returns an invalid box if _boxes is empty or
+// only contains invalid boxes.
+OZZ_BASE_DLL Box Merge(const span<const Box>& _boxes);
+
+// Transforms every box of _input by _matrix into _output, which must be at
+// least _input sized. In place transformation (_output == _input) is
+// supported.
+OZZ_BASE_DLL void TransformBoxes(const Float4x4& _matrix,
+                                 const span<const Box>& _input,
+                                 const span<Box>& _output);
 }  // namespace math
 }  // namespace ozz
 #endif  // OZZ_OZZ_BASE_MATHS_BOX_H_
@@ -34,7 +34,28 @@
 // forced.
 #if !defined(OZZ_BUILD_SIMD_REF)
 
-// Try to match a SSE2+ version.
+// Arm NEON is supported by translating the SSE implementation with the
+// sse2neon header (https://github.com/DLTcollab/sse2neon). It is opt-in, as
+// ozz doesn't embed sse2neon: define OZZ_SIMD_SSE2NEON and make sse2neon.h
+// available in include paths to enable it. Otherwise NEON builds fall back to
+// the reference implementation.
+#if (defined(__ARM_NEON) || defined(__ARM_NEON__)) && \
+    defined(OZZ_SIMD_SSE2NEON)
+#include "sse2neon.h"
+#define OZZ_SIMD_SSE2
+#define OZZ_SIMD_SSEx
+#endif
+
+// WebAssembly simd128 proposal, enabled with emscripten/clang -msimd128.
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define OZZ_SIMD_WASM
+#endif
+
+// Try to match a SSE2+ version, unless SSE support is already provided by a
+// translation layer (see sse2neon above) or wasm simd128 was detected.
+#if !defined(OZZ_SIMD_SSEx) && !defined(OZZ_SIMD_WASM)
+
 #if defined(__AVX2__) || defined(OZZ_SIMD_AVX2)
 #include <immintrin.h>
 #define OZZ_SIMD_AVX2
@@ -85,11 +106,7 @@
 #define OZZ_SIMD_SSEx  // OZZ_SIMD_SSEx is the generic flag for SSE support
 #endif
 
-// Try to match a Arm NEON
-#if defined(__ARM_NEON) || defined(OZZ_SIMD_ARM_NEON)
-// #include <arm_neon.h>
-// #define OZZ_SIMD_ARM_NEON
-#endif
+#endif  // !OZZ_SIMD_SSEx && !OZZ_SIMD_WASM
 
 // End of SIMD instruction detection
 #endif  // !OZZ_BUILD_SIMD_REF
@@ -114,6 +131,32 @@ typedef const __m128i _SimdInt4;
 }  // namespace math
 }  // namespace ozz
 
+#elif defined(OZZ_SIMD_WASM)  // Wasm simd128 intrinsics available
+
+#include <stdint.h>
+
+namespace ozz {
+namespace math {
+
+// Vectors are defined as gcc/clang vector extension types rather than v128_t,
+// as v128_t is a single typeless vector that would defeat float/integer
+// function overloading. Such types implicitly convert to v128_t when calling
+// wasm intrinsics.
+
+// Vector of four floating point values.
+typedef float SimdFloat4 __attribute__((__vector_size__(16), __aligned__(16)));
+
+// Argument type for Float4.
+typedef const SimdFloat4 _SimdFloat4;
+
+// Vector of four integer values.
+typedef int32_t SimdInt4 __attribute__((__vector_size__(16), __aligned__(16)));
+
+// Argument type for Int4.
+typedef const SimdInt4 _SimdInt4;
+}  // namespace math
+}  // namespace ozz
+
 #else  // No builtin simd available
 
 // No simd instruction set detected, switch back to reference implementation.
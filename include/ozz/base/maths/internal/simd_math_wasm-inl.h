@@ -0,0 +1,1670 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_BASE_MATHS_INTERNAL_SIMD_MATH_WASM_INL_H_
+#define OZZ_OZZ_BASE_MATHS_INTERNAL_SIMD_MATH_WASM_INL_H_
+
+// WebAssembly SIMD128 implementation.
+// SimdFloat4 and SimdInt4 are gcc/clang vector extension types (see
+// simd_math_config.h), so lanes can be subscripted, arithmetic and comparison
+// operators are native, and __builtin_shufflevector implements swizzles.
+// wasm_simd128.h intrinsics are used where an operation maps to a dedicated
+// wasm instruction that the vector extensions can't express.
+
+#include <stdint.h>
+
+#include <cassert>
+
+// Temporarly needed while trigonometric functions aren't implemented.
+#include <cmath>
+
+#include "ozz/base/maths/math_constant.h"
+
+namespace ozz {
+namespace math {
+
+namespace simd_float4 {
+
+// Internal macros.
+// Unused components of the result vector are replicated from the first input
+// argument.
+
+#define OZZ_WASM_SPLAT_F(_v, _i) __builtin_shufflevector(_v, _v, _i, _i, _i, _i)
+
+#define OZZ_WASM_SPLAT_I(_v, _i) __builtin_shufflevector(_v, _v, _i, _i, _i, _i)
+
+// a.x, b.x, a.y, b.y
+#define OZZ_WASM_UNPACKLO_F(_a, _b) __builtin_shufflevector(_a, _b, 0, 4, 1, 5)
+
+// a.z, b.z, a.w, b.w
+#define OZZ_WASM_UNPACKHI_F(_a, _b) __builtin_shufflevector(_a, _b, 2, 6, 3, 7)
+
+// a.x, a.y, b.x, b.y
+#define OZZ_WASM_MOVELH_F(_a, _b) __builtin_shufflevector(_a, _b, 0, 1, 4, 5)
+
+// b.z, b.w, a.z, a.w
+#define OZZ_WASM_MOVEHL_F(_a, _b) __builtin_shufflevector(_a, _b, 6, 7, 2, 3)
+
+// Per bit selection of _true (_b bit set) and _false vectors.
+#define OZZ_WASM_SELECT_F(_b, _true, _false)                              \
+  ((SimdFloat4)wasm_v128_bitselect((v128_t)(_true), (v128_t)(_false), \
+                                   (v128_t)(_b)))
+
+#define OZZ_WASM_SELECT_I(_b, _true, _false)                            \
+  ((SimdInt4)wasm_v128_bitselect((v128_t)(_true), (v128_t)(_false), \
+                                 (v128_t)(_b)))
+
+OZZ_INLINE SimdFloat4 zero() {
+  const SimdFloat4 ret = {0.f, 0.f, 0.f, 0.f};
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 one() {
+  const SimdFloat4 ret = {1.f, 1.f, 1.f, 1.f};
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 x_axis() {
+  const SimdFloat4 ret = {1.f, 0.f, 0.f, 0.f};
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 y_axis() {
+  const SimdFloat4 ret = {0.f, 1.f, 0.f, 0.f};
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 z_axis() {
+  const SimdFloat4 ret = {0.f, 0.f, 1.f, 0.f};
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 w_axis() {
+  const SimdFloat4 ret = {0.f, 0.f, 0.f, 1.f};
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 Load(float _x, float _y, float _z, float _w) {
+  const SimdFloat4 ret = {_x, _y, _z, _w};
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 LoadX(float _x) {
+  const SimdFloat4 ret = {_x, 0.f, 0.f, 0.f};
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 Load1(float _x) {
+  const SimdFloat4 ret = {_x, _x, _x, _x};
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 LoadPtr(const float* _f) {
+  assert(!(reinterpret_cast<uintptr_t>(_f) & 0xf) && "Invalid alignment");
+  return *reinterpret_cast<const SimdFloat4*>(_f);
+}
+
+OZZ_INLINE SimdFloat4 LoadPtrU(const float* _f) {
+  assert(!(reinterpret_cast<uintptr_t>(_f) & 0x3) && "Invalid alignment");
+  return (SimdFloat4)wasm_v128_load(_f);
+}
+
+OZZ_INLINE SimdFloat4 LoadXPtrU(const float* _f) {
+  assert(!(reinterpret_cast<uintptr_t>(_f) & 0x3) && "Invalid alignment");
+  const SimdFloat4 ret = {*_f, 0.f, 0.f, 0.f};
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 Load1PtrU(const float* _f) {
+  assert(!(reinterpret_cast<uintptr_t>(_f) & 0x3) && "Invalid alignment");
+  return (SimdFloat4)wasm_v128_load32_splat(_f);
+}
+
+OZZ_INLINE SimdFloat4 Load2PtrU(const float* _f) {
+  assert(!(reinterpret_cast<uintptr_t>(_f) & 0x3) && "Invalid alignment");
+  const SimdFloat4 ret = {_f[0], _f[1], 0.f, 0.f};
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 Load3PtrU(const float* _f) {
+  assert(!(reinterpret_cast<uintptr_t>(_f) & 0x3) && "Invalid alignment");
+  const SimdFloat4 ret = {_f[0], _f[1], _f[2], 0.f};
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 FromInt(_SimdInt4 _i) {
+  return __builtin_convertvector(_i, SimdFloat4);
+}
+}  // namespace simd_float4
+
+OZZ_INLINE float GetX(_SimdFloat4 _v) { return _v[0]; }
+
+OZZ_INLINE float GetY(_SimdFloat4 _v) { return _v[1]; }
+
+OZZ_INLINE float GetZ(_SimdFloat4 _v) { return _v[2]; }
+
+OZZ_INLINE float GetW(_SimdFloat4 _v) { return _v[3]; }
+
+OZZ_INLINE SimdFloat4 SetX(_SimdFloat4 _v, _SimdFloat4 _f) {
+  SimdFloat4 ret = _v;
+  ret[0] = _f[0];
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 SetY(_SimdFloat4 _v, _SimdFloat4 _f) {
+  SimdFloat4 ret = _v;
+  ret[1] = _f[0];
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 SetZ(_SimdFloat4 _v, _SimdFloat4 _f) {
+  SimdFloat4 ret = _v;
+  ret[2] = _f[0];
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 SetW(_SimdFloat4 _v, _SimdFloat4 _f) {
+  SimdFloat4 ret = _v;
+  ret[3] = _f[0];
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 SetI(_SimdFloat4 _v, _SimdFloat4 _f, int _ith) {
+  assert(_ith >= 0 && _ith <= 3 && "Invalid index, out of range.");
+  SimdFloat4 ret = _v;
+  ret[_ith] = _f[0];
+  return ret;
+}
+
+OZZ_INLINE void StorePtr(_SimdFloat4 _v, float* _f) {
+  assert(!(reinterpret_cast<uintptr_t>(_f) & 0xf) && "Invalid alignment");
+  *reinterpret_cast<SimdFloat4*>(_f) = _v;
+}
+
+OZZ_INLINE void Store1Ptr(_SimdFloat4 _v, float* _f) {
+  assert(!(reinterpret_cast<uintptr_t>(_f) & 0xf) && "Invalid alignment");
+  _f[0] = _v[0];
+}
+
+OZZ_INLINE void Store2Ptr(_SimdFloat4 _v, float* _f) {
+  assert(!(reinterpret_cast<uintptr_t>(_f) & 0xf) && "Invalid alignment");
+  _f[0] = _v[0];
+  _f[1] = _v[1];
+}
+
+OZZ_INLINE void Store3Ptr(_SimdFloat4 _v, float* _f) {
+  assert(!(reinterpret_cast<uintptr_t>(_f) & 0xf) && "Invalid alignment");
+  _f[0] = _v[0];
+  _f[1] = _v[1];
+  _f[2] = _v[2];
+}
+
+OZZ_INLINE void StorePtrU(_SimdFloat4 _v, float* _f) {
+  assert(!(reinterpret_cast<uintptr_t>(_f) & 0x3) && "Invalid alignment");
+  wasm_v128_store(_f, (v128_t)_v);
+}
+
+OZZ_INLINE void Store1PtrU(_SimdFloat4 _v, float* _f) {
+  assert(!(reinterpret_cast<uintptr_t>(_f) & 0x3) && "Invalid alignment");
+  _f[0] = _v[0];
+}
+
+OZZ_INLINE void Store2PtrU(_SimdFloat4 _v, float* _f) {
+  assert(!(reinterpret_cast<uintptr_t>(_f) & 0x3) && "Invalid alignment");
+  _f[0] = _v[0];
+  _f[1] = _v[1];
+}
+
+OZZ_INLINE void Store3PtrU(_SimdFloat4 _v, float* _f) {
+  assert(!(reinterpret_cast<uintptr_t>(_f) & 0x3) && "Invalid alignment");
+  _f[0] = _v[0];
+  _f[1] = _v[1];
+  _f[2] = _v[2];
+}
+
+OZZ_INLINE SimdFloat4 SplatX(_SimdFloat4 _v) { return OZZ_WASM_SPLAT_F(_v, 0); }
+
+OZZ_INLINE SimdFloat4 SplatY(_SimdFloat4 _v) { return OZZ_WASM_SPLAT_F(_v, 1); }
+
+OZZ_INLINE SimdFloat4 SplatZ(_SimdFloat4 _v) { return OZZ_WASM_SPLAT_F(_v, 2); }
+
+OZZ_INLINE SimdFloat4 SplatW(_SimdFloat4 _v) { return OZZ_WASM_SPLAT_F(_v, 3); }
+
+template <size_t _X, size_t _Y, size_t _Z, size_t _W>
+OZZ_INLINE SimdFloat4 Swizzle(_SimdFloat4 _v) {
+  static_assert(_X <= 3 && _Y <= 3 && _Z <= 3 && _W <= 3,
+                "Indices must be between 0 and 3");
+  return __builtin_shufflevector(_v, _v, _X, _Y, _Z, _W);
+}
+
+OZZ_INLINE void Transpose4x1(const SimdFloat4 _in[4], SimdFloat4 _out[1]) {
+  const SimdFloat4 xz = OZZ_WASM_UNPACKLO_F(_in[0], _in[2]);
+  const SimdFloat4 yw = OZZ_WASM_UNPACKLO_F(_in[1], _in[3]);
+  _out[0] = OZZ_WASM_UNPACKLO_F(xz, yw);
+}
+
+OZZ_INLINE void Transpose1x4(const SimdFloat4 _in[1], SimdFloat4 _out[4]) {
+  const SimdFloat4 o0 = {_in[0][0], 0.f, 0.f, 0.f};
+  const SimdFloat4 o1 = {_in[0][1], 0.f, 0.f, 0.f};
+  const SimdFloat4 o2 = {_in[0][2], 0.f, 0.f, 0.f};
+  const SimdFloat4 o3 = {_in[0][3], 0.f, 0.f, 0.f};
+  _out[0] = o0;
+  _out[1] = o1;
+  _out[2] = o2;
+  _out[3] = o3;
+}
+
+OZZ_INLINE void Transpose4x2(const SimdFloat4 _in[4], SimdFloat4 _out[2]) {
+  const SimdFloat4 tmp0 = OZZ_WASM_UNPACKLO_F(_in[0], _in[2]);
+  const SimdFloat4 tmp1 = OZZ_WASM_UNPACKLO_F(_in[1], _in[3]);
+  _out[0] = OZZ_WASM_UNPACKLO_F(tmp0, tmp1);
+  _out[1] = OZZ_WASM_UNPACKHI_F(tmp0, tmp1);
+}
+
+OZZ_INLINE void Transpose2x4(const SimdFloat4 _in[2], SimdFloat4 _out[4]) {
+  const SimdFloat4 tmp0 = OZZ_WASM_UNPACKLO_F(_in[0], _in[1]);
+  const SimdFloat4 tmp1 = OZZ_WASM_UNPACKHI_F(_in[0], _in[1]);
+  const SimdFloat4 zero = simd_float4::zero();
+  _out[0] = OZZ_WASM_MOVELH_F(tmp0, zero);
+  _out[1] = OZZ_WASM_MOVEHL_F(zero, tmp0);
+  _out[2] = OZZ_WASM_MOVELH_F(tmp1, zero);
+  _out[3] = OZZ_WASM_MOVEHL_F(zero, tmp1);
+}
+
+OZZ_INLINE void Transpose4x3(const SimdFloat4 _in[4], SimdFloat4 _out[3]) {
+  const SimdFloat4 tmp0 = OZZ_WASM_UNPACKLO_F(_in[0], _in[2]);
+  const SimdFloat4 tmp1 = OZZ_WASM_UNPACKLO_F(_in[1], _in[3]);
+  const SimdFloat4 tmp2 = OZZ_WASM_UNPACKHI_F(_in[0], _in[2]);
+  const SimdFloat4 tmp3 = OZZ_WASM_UNPACKHI_F(_in[1], _in[3]);
+  _out[0] = OZZ_WASM_UNPACKLO_F(tmp0, tmp1);
+  _out[1] = OZZ_WASM_UNPACKHI_F(tmp0, tmp1);
+  _out[2] = OZZ_WASM_UNPACKLO_F(tmp2, tmp3);
+}
+
+OZZ_INLINE void Transpose3x4(const SimdFloat4 _in[3], SimdFloat4 _out[4]) {
+  const SimdFloat4 zero = simd_float4::zero();
+  const SimdFloat4 temp0 = OZZ_WASM_UNPACKLO_F(_in[0], _in[1]);
+  const SimdFloat4 temp1 = OZZ_WASM_UNPACKLO_F(_in[2], zero);
+  const SimdFloat4 temp2 = OZZ_WASM_UNPACKHI_F(_in[0], _in[1]);
+  const SimdFloat4 temp3 = OZZ_WASM_UNPACKHI_F(_in[2], zero);
+  _out[0] = OZZ_WASM_MOVELH_F(temp0, temp1);
+  _out[1] = OZZ_WASM_MOVEHL_F(temp1, temp0);
+  _out[2] = OZZ_WASM_MOVELH_F(temp2, temp3);
+  _out[3] = OZZ_WASM_MOVEHL_F(temp3, temp2);
+}
+
+OZZ_INLINE void Transpose4x4(const SimdFloat4 _in[4], SimdFloat4 _out[4]) {
+  const SimdFloat4 tmp0 = OZZ_WASM_UNPACKLO_F(_in[0], _in[2]);
+  const SimdFloat4 tmp1 = OZZ_WASM_UNPACKLO_F(_in[1], _in[3]);
+  const SimdFloat4 tmp2 = OZZ_WASM_UNPACKHI_F(_in[0], _in[2]);
+  const SimdFloat4 tmp3 = OZZ_WASM_UNPACKHI_F(_in[1], _in[3]);
+  _out[0] = OZZ_WASM_UNPACKLO_F(tmp0, tmp1);
+  _out[1] = OZZ_WASM_UNPACKHI_F(tmp0, tmp1);
+  _out[2] = OZZ_WASM_UNPACKLO_F(tmp2, tmp3);
+  _out[3] = OZZ_WASM_UNPACKHI_F(tmp2, tmp3);
+}
+
+OZZ_INLINE void Transpose16x16(const SimdFloat4 _in[16], SimdFloat4 _out[16]) {
+  for (int i = 0; i < 4; ++i) {
+    const SimdFloat4 tmp0 = OZZ_WASM_UNPACKLO_F(_in[i * 4 + 0], _in[i * 4 + 2]);
+    const SimdFloat4 tmp1 = OZZ_WASM_UNPACKLO_F(_in[i * 4 + 1], _in[i * 4 + 3]);
+    const SimdFloat4 tmp2 = OZZ_WASM_UNPACKHI_F(_in[i * 4 + 0], _in[i * 4 + 2]);
+    const SimdFloat4 tmp3 = OZZ_WASM_UNPACKHI_F(_in[i * 4 + 1], _in[i * 4 + 3]);
+    _out[i + 0] = OZZ_WASM_UNPACKLO_F(tmp0, tmp1);
+    _out[i + 4] = OZZ_WASM_UNPACKHI_F(tmp0, tmp1);
+    _out[i + 8] = OZZ_WASM_UNPACKLO_F(tmp2, tmp3);
+    _out[i + 12] = OZZ_WASM_UNPACKHI_F(tmp2, tmp3);
+  }
+}
+
+OZZ_INLINE SimdFloat4 MAdd(_SimdFloat4 _a, _SimdFloat4 _b, _SimdFloat4 _c) {
+  return _a * _b + _c;
+}
+
+OZZ_INLINE SimdFloat4 MSub(_SimdFloat4 _a, _SimdFloat4 _b, _SimdFloat4 _c) {
+  return _a * _b - _c;
+}
+
+OZZ_INLINE SimdFloat4 NMAdd(_SimdFloat4 _a, _SimdFloat4 _b, _SimdFloat4 _c) {
+  return _c - _a * _b;
+}
+
+OZZ_INLINE SimdFloat4 NMSub(_SimdFloat4 _a, _SimdFloat4 _b, _SimdFloat4 _c) {
+  return -(_a * _b + _c);
+}
+
+OZZ_INLINE SimdFloat4 DivX(_SimdFloat4 _a, _SimdFloat4 _b) {
+  SimdFloat4 ret = _a;
+  ret[0] = _a[0] / _b[0];
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 HAdd2(_SimdFloat4 _v) {
+  SimdFloat4 ret = _v;
+  ret[0] = _v[0] + _v[1];
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 HAdd3(_SimdFloat4 _v) {
+  SimdFloat4 ret = _v;
+  ret[0] = _v[0] + _v[1] + _v[2];
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 HAdd4(_SimdFloat4 _v) {
+  SimdFloat4 ret = _v;
+  ret[0] = _v[0] + _v[1] + _v[2] + _v[3];
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 Dot2(_SimdFloat4 _a, _SimdFloat4 _b) {
+  SimdFloat4 ret = _a;
+  ret[0] = _a[0] * _b[0] + _a[1] * _b[1];
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 Dot3(_SimdFloat4 _a, _SimdFloat4 _b) {
+  SimdFloat4 ret = _a;
+  ret[0] = _a[0] * _b[0] + _a[1] * _b[1] + _a[2] * _b[2];
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 Dot4(_SimdFloat4 _a, _SimdFloat4 _b) {
+  SimdFloat4 ret = _a;
+  ret[0] = _a[0] * _b[0] + _a[1] * _b[1] + _a[2] * _b[2] + _a[3] * _b[3];
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 Cross3(_SimdFloat4 _a, _SimdFloat4 _b) {
+  // Implementation with 3 shuffles only is based on:
+  // https://geometrian.com/programming/tutorials/cross-product
+  const SimdFloat4 shufa = __builtin_shufflevector(_a, _a, 1, 2, 0, 3);
+  const SimdFloat4 shufb = __builtin_shufflevector(_b, _b, 1, 2, 0, 3);
+  const SimdFloat4 shufc = _a * shufb - _b * shufa;
+  return __builtin_shufflevector(shufc, shufc, 1, 2, 0, 3);
+}
+
+// Wasm simd128 has no reciprocal (nor reciprocal square root) estimate
+// opcodes, so estimate functions fall back to the exact computation. This
+// keeps the contract (estimates only guarantee a minimum precision) while
+// remaining a single division/sqrt instruction.
+OZZ_INLINE SimdFloat4 RcpEst(_SimdFloat4 _v) { return simd_float4::one() / _v; }
+
+OZZ_INLINE SimdFloat4 RcpEstNR(_SimdFloat4 _v) {
+  return simd_float4::one() / _v;
+}
+
+OZZ_INLINE SimdFloat4 RcpEstX(_SimdFloat4 _v) {
+  SimdFloat4 ret = _v;
+  ret[0] = 1.f / _v[0];
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 RcpEstXNR(_SimdFloat4 _v) {
+  SimdFloat4 ret = _v;
+  ret[0] = 1.f / _v[0];
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 Sqrt(_SimdFloat4 _v) {
+  return (SimdFloat4)wasm_f32x4_sqrt((v128_t)_v);
+}
+
+OZZ_INLINE SimdFloat4 SqrtX(_SimdFloat4 _v) {
+  SimdFloat4 ret = _v;
+  ret[0] = std::sqrt(_v[0]);
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 RSqrtEst(_SimdFloat4 _v) {
+  return simd_float4::one() / (SimdFloat4)wasm_f32x4_sqrt((v128_t)_v);
+}
+
+OZZ_INLINE SimdFloat4 RSqrtEstNR(_SimdFloat4 _v) {
+  return simd_float4::one() / (SimdFloat4)wasm_f32x4_sqrt((v128_t)_v);
+}
+
+OZZ_INLINE SimdFloat4 RSqrtEstX(_SimdFloat4 _v) {
+  SimdFloat4 ret = _v;
+  ret[0] = 1.f / std::sqrt(_v[0]);
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 RSqrtEstXNR(_SimdFloat4 _v) {
+  SimdFloat4 ret = _v;
+  ret[0] = 1.f / std::sqrt(_v[0]);
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 Abs(_SimdFloat4 _v) {
+  return (SimdFloat4)wasm_f32x4_abs((v128_t)_v);
+}
+
+OZZ_INLINE SimdInt4 Sign(_SimdFloat4 _v) {
+  return ((SimdInt4)_v >> 31) << 31;
+}
+
+OZZ_INLINE SimdFloat4 Length2(_SimdFloat4 _v) {
+  SimdFloat4 ret = _v;
+  ret[0] = std::sqrt(_v[0] * _v[0] + _v[1] * _v[1]);
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 Length3(_SimdFloat4 _v) {
+  SimdFloat4 ret = _v;
+  ret[0] = std::sqrt(_v[0] * _v[0] + _v[1] * _v[1] + _v[2] * _v[2]);
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 Length4(_SimdFloat4 _v) {
+  SimdFloat4 ret = _v;
+  ret[0] = std::sqrt(_v[0] * _v[0] + _v[1] * _v[1] + _v[2] * _v[2] +
+                     _v[3] * _v[3]);
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 Length2Sqr(_SimdFloat4 _v) {
+  SimdFloat4 ret = _v;
+  ret[0] = _v[0] * _v[0] + _v[1] * _v[1];
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 Length3Sqr(_SimdFloat4 _v) {
+  SimdFloat4 ret = _v;
+  ret[0] = _v[0] * _v[0] + _v[1] * _v[1] + _v[2] * _v[2];
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 Length4Sqr(_SimdFloat4 _v) {
+  SimdFloat4 ret = _v;
+  ret[0] = _v[0] * _v[0] + _v[1] * _v[1] + _v[2] * _v[2] + _v[3] * _v[3];
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 Normalize2(_SimdFloat4 _v) {
+  const float sq_len = _v[0] * _v[0] + _v[1] * _v[1];
+  assert(sq_len != 0.f && "_v is not normalizable");
+  const float inv_len = 1.f / std::sqrt(sq_len);
+  const SimdFloat4 ret = {_v[0] * inv_len, _v[1] * inv_len, _v[2], _v[3]};
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 Normalize3(_SimdFloat4 _v) {
+  const float sq_len = _v[0] * _v[0] + _v[1] * _v[1] + _v[2] * _v[2];
+  assert(sq_len != 0.f && "_v is not normalizable");
+  const float inv_len = 1.f / std::sqrt(sq_len);
+  const SimdFloat4 ret = {_v[0] * inv_len, _v[1] * inv_len, _v[2] * inv_len,
+                          _v[3]};
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 Normalize4(_SimdFloat4 _v) {
+  const float sq_len =
+      _v[0] * _v[0] + _v[1] * _v[1] + _v[2] * _v[2] + _v[3] * _v[3];
+  assert(sq_len != 0.f && "_v is not normalizable");
+  const SimdFloat4 inv_len = simd_float4::Load1(1.f / std::sqrt(sq_len));
+  return _v * inv_len;
+}
+
+OZZ_INLINE SimdFloat4 NormalizeEst2(_SimdFloat4 _v) { return Normalize2(_v); }
+
+OZZ_INLINE SimdFloat4 NormalizeEst3(_SimdFloat4 _v) { return Normalize3(_v); }
+
+OZZ_INLINE SimdFloat4 NormalizeEst4(_SimdFloat4 _v) { return Normalize4(_v); }
+
+OZZ_INLINE SimdInt4 IsNormalized2(_SimdFloat4 _v) {
+  const float sq_len = _v[0] * _v[0] + _v[1] * _v[1];
+  const bool normalized = std::abs(sq_len - 1.f) < kNormalizationToleranceSq;
+  const SimdInt4 ret = {-static_cast<int32_t>(normalized), 0, 0, 0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 IsNormalized3(_SimdFloat4 _v) {
+  const float sq_len = _v[0] * _v[0] + _v[1] * _v[1] + _v[2] * _v[2];
+  const bool normalized = std::abs(sq_len - 1.f) < kNormalizationToleranceSq;
+  const SimdInt4 ret = {-static_cast<int32_t>(normalized), 0, 0, 0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 IsNormalized4(_SimdFloat4 _v) {
+  const float sq_len =
+      _v[0] * _v[0] + _v[1] * _v[1] + _v[2] * _v[2] + _v[3] * _v[3];
+  const bool normalized = std::abs(sq_len - 1.f) < kNormalizationToleranceSq;
+  const SimdInt4 ret = {-static_cast<int32_t>(normalized), 0, 0, 0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 IsNormalizedEst2(_SimdFloat4 _v) {
+  const float sq_len = _v[0] * _v[0] + _v[1] * _v[1];
+  const bool normalized = std::abs(sq_len - 1.f) < kNormalizationToleranceEstSq;
+  const SimdInt4 ret = {-static_cast<int32_t>(normalized), 0, 0, 0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 IsNormalizedEst3(_SimdFloat4 _v) {
+  const float sq_len = _v[0] * _v[0] + _v[1] * _v[1] + _v[2] * _v[2];
+  const bool normalized = std::abs(sq_len - 1.f) < kNormalizationToleranceEstSq;
+  const SimdInt4 ret = {-static_cast<int32_t>(normalized), 0, 0, 0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 IsNormalizedEst4(_SimdFloat4 _v) {
+  const float sq_len =
+      _v[0] * _v[0] + _v[1] * _v[1] + _v[2] * _v[2] + _v[3] * _v[3];
+  const bool normalized = std::abs(sq_len - 1.f) < kNormalizationToleranceEstSq;
+  const SimdInt4 ret = {-static_cast<int32_t>(normalized), 0, 0, 0};
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 NormalizeSafe2(_SimdFloat4 _v, _SimdFloat4 _safe) {
+  const float sq_len = _v[0] * _v[0] + _v[1] * _v[1];
+  if (sq_len <= 0.f) {
+    return _safe;
+  }
+  const float inv_len = 1.f / std::sqrt(sq_len);
+  const SimdFloat4 ret = {_v[0] * inv_len, _v[1] * inv_len, _v[2], _v[3]};
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 NormalizeSafe3(_SimdFloat4 _v, _SimdFloat4 _safe) {
+  const float sq_len = _v[0] * _v[0] + _v[1] * _v[1] + _v[2] * _v[2];
+  if (sq_len <= 0.f) {
+    return _safe;
+  }
+  const float inv_len = 1.f / std::sqrt(sq_len);
+  const SimdFloat4 ret = {_v[0] * inv_len, _v[1] * inv_len, _v[2] * inv_len,
+                          _v[3]};
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 NormalizeSafe4(_SimdFloat4 _v, _SimdFloat4 _safe) {
+  const float sq_len =
+      _v[0] * _v[0] + _v[1] * _v[1] + _v[2] * _v[2] + _v[3] * _v[3];
+  if (sq_len <= 0.f) {
+    return _safe;
+  }
+  const SimdFloat4 inv_len = simd_float4::Load1(1.f / std::sqrt(sq_len));
+  return _v * inv_len;
+}
+
+OZZ_INLINE SimdFloat4 NormalizeSafeEst2(_SimdFloat4 _v, _SimdFloat4 _safe) {
+  return NormalizeSafe2(_v, _safe);
+}
+
+OZZ_INLINE SimdFloat4 NormalizeSafeEst3(_SimdFloat4 _v, _SimdFloat4 _safe) {
+  return NormalizeSafe3(_v, _safe);
+}
+
+OZZ_INLINE SimdFloat4 NormalizeSafeEst4(_SimdFloat4 _v, _SimdFloat4 _safe) {
+  return NormalizeSafe4(_v, _safe);
+}
+
+OZZ_INLINE SimdFloat4 Lerp(_SimdFloat4 _a, _SimdFloat4 _b, _SimdFloat4 _alpha) {
+  return _alpha * (_b - _a) + _a;
+}
+
+OZZ_INLINE SimdFloat4 Min(_SimdFloat4 _a, _SimdFloat4 _b) {
+  return (SimdFloat4)wasm_f32x4_pmin((v128_t)_a, (v128_t)_b);
+}
+
+OZZ_INLINE SimdFloat4 Max(_SimdFloat4 _a, _SimdFloat4 _b) {
+  return (SimdFloat4)wasm_f32x4_pmax((v128_t)_a, (v128_t)_b);
+}
+
+OZZ_INLINE SimdFloat4 Min0(_SimdFloat4 _v) {
+  return Min(simd_float4::zero(), _v);
+}
+
+OZZ_INLINE SimdFloat4 Max0(_SimdFloat4 _v) {
+  return Max(simd_float4::zero(), _v);
+}
+
+OZZ_INLINE SimdFloat4 Clamp(_SimdFloat4 _a, _SimdFloat4 _v, _SimdFloat4 _b) {
+  return Max(_a, Min(_v, _b));
+}
+
+OZZ_INLINE SimdFloat4 Select(_SimdInt4 _b, _SimdFloat4 _true,
+                             _SimdFloat4 _false) {
+  return OZZ_WASM_SELECT_F(_b, _true, _false);
+}
+
+OZZ_INLINE SimdInt4 CmpEq(_SimdFloat4 _a, _SimdFloat4 _b) {
+  return (SimdInt4)(_a == _b);
+}
+
+OZZ_INLINE SimdInt4 CmpNe(_SimdFloat4 _a, _SimdFloat4 _b) {
+  return (SimdInt4)(_a != _b);
+}
+
+OZZ_INLINE SimdInt4 CmpLt(_SimdFloat4 _a, _SimdFloat4 _b) {
+  return (SimdInt4)(_a < _b);
+}
+
+OZZ_INLINE SimdInt4 CmpLe(_SimdFloat4 _a, _SimdFloat4 _b) {
+  return (SimdInt4)(_a <= _b);
+}
+
+OZZ_INLINE SimdInt4 CmpGt(_SimdFloat4 _a, _SimdFloat4 _b) {
+  return (SimdInt4)(_a > _b);
+}
+
+OZZ_INLINE SimdInt4 CmpGe(_SimdFloat4 _a, _SimdFloat4 _b) {
+  return (SimdInt4)(_a >= _b);
+}
+
+OZZ_INLINE SimdFloat4 And(_SimdFloat4 _a, _SimdFloat4 _b) {
+  return (SimdFloat4)((SimdInt4)_a & (SimdInt4)_b);
+}
+
+OZZ_INLINE SimdFloat4 Or(_SimdFloat4 _a, _SimdFloat4 _b) {
+  return (SimdFloat4)((SimdInt4)_a | (SimdInt4)_b);
+}
+
+OZZ_INLINE SimdFloat4 Xor(_SimdFloat4 _a, _SimdFloat4 _b) {
+  return (SimdFloat4)((SimdInt4)_a ^ (SimdInt4)_b);
+}
+
+OZZ_INLINE SimdFloat4 And(_SimdFloat4 _a, _SimdInt4 _b) {
+  return (SimdFloat4)((SimdInt4)_a & _b);
+}
+
+OZZ_INLINE SimdFloat4 AndNot(_SimdFloat4 _a, _SimdInt4 _b) {
+  return (SimdFloat4)((SimdInt4)_a & ~_b);
+}
+
+OZZ_INLINE SimdFloat4 Or(_SimdFloat4 _a, _SimdInt4 _b) {
+  return (SimdFloat4)((SimdInt4)_a | _b);
+}
+
+OZZ_INLINE SimdFloat4 Xor(_SimdFloat4 _a, _SimdInt4 _b) {
+  return (SimdFloat4)((SimdInt4)_a ^ _b);
+}
+
+OZZ_INLINE SimdFloat4 Cos(_SimdFloat4 _v) {
+  const SimdFloat4 ret = {std::cos(_v[0]), std::cos(_v[1]), std::cos(_v[2]),
+                          std::cos(_v[3])};
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 CosX(_SimdFloat4 _v) {
+  SimdFloat4 ret = _v;
+  ret[0] = std::cos(_v[0]);
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 ACos(_SimdFloat4 _v) {
+  const SimdFloat4 ret = {std::acos(_v[0]), std::acos(_v[1]), std::acos(_v[2]),
+                          std::acos(_v[3])};
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 ACosX(_SimdFloat4 _v) {
+  SimdFloat4 ret = _v;
+  ret[0] = std::acos(_v[0]);
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 Sin(_SimdFloat4 _v) {
+  const SimdFloat4 ret = {std::sin(_v[0]), std::sin(_v[1]), std::sin(_v[2]),
+                          std::sin(_v[3])};
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 SinX(_SimdFloat4 _v) {
+  SimdFloat4 ret = _v;
+  ret[0] = std::sin(_v[0]);
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 ASin(_SimdFloat4 _v) {
+  const SimdFloat4 ret = {std::asin(_v[0]), std::asin(_v[1]), std::asin(_v[2]),
+                          std::asin(_v[3])};
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 ASinX(_SimdFloat4 _v) {
+  SimdFloat4 ret = _v;
+  ret[0] = std::asin(_v[0]);
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 Tan(_SimdFloat4 _v) {
+  const SimdFloat4 ret = {std::tan(_v[0]), std::tan(_v[1]), std::tan(_v[2]),
+                          std::tan(_v[3])};
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 TanX(_SimdFloat4 _v) {
+  SimdFloat4 ret = _v;
+  ret[0] = std::tan(_v[0]);
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 ATan(_SimdFloat4 _v) {
+  const SimdFloat4 ret = {std::atan(_v[0]), std::atan(_v[1]), std::atan(_v[2]),
+                          std::atan(_v[3])};
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 ATanX(_SimdFloat4 _v) {
+  SimdFloat4 ret = _v;
+  ret[0] = std::atan(_v[0]);
+  return ret;
+}
+
+namespace simd_int4 {
+
+OZZ_INLINE SimdInt4 zero() {
+  const SimdInt4 ret = {0, 0, 0, 0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 one() {
+  const SimdInt4 ret = {1, 1, 1, 1};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 x_axis() {
+  const SimdInt4 ret = {1, 0, 0, 0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 y_axis() {
+  const SimdInt4 ret = {0, 1, 0, 0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 z_axis() {
+  const SimdInt4 ret = {0, 0, 1, 0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 w_axis() {
+  const SimdInt4 ret = {0, 0, 0, 1};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 all_true() {
+  const SimdInt4 ret = {~0, ~0, ~0, ~0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 all_false() {
+  const SimdInt4 ret = {0, 0, 0, 0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 mask_sign() {
+  const SimdInt4 ret = {
+      static_cast<int32_t>(0x80000000), static_cast<int32_t>(0x80000000),
+      static_cast<int32_t>(0x80000000), static_cast<int32_t>(0x80000000)};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 mask_sign_xyz() {
+  const SimdInt4 ret = {static_cast<int32_t>(0x80000000),
+                        static_cast<int32_t>(0x80000000),
+                        static_cast<int32_t>(0x80000000), 0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 mask_sign_w() {
+  const SimdInt4 ret = {0, 0, 0, static_cast<int32_t>(0x80000000)};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 mask_not_sign() {
+  const SimdInt4 ret = {0x7fffffff, 0x7fffffff, 0x7fffffff, 0x7fffffff};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 mask_ffff() {
+  const SimdInt4 ret = {~0, ~0, ~0, ~0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 mask_0000() {
+  const SimdInt4 ret = {0, 0, 0, 0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 mask_fff0() {
+  const SimdInt4 ret = {~0, ~0, ~0, 0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 mask_f000() {
+  const SimdInt4 ret = {~0, 0, 0, 0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 mask_0f00() {
+  const SimdInt4 ret = {0, ~0, 0, 0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 mask_00f0() {
+  const SimdInt4 ret = {0, 0, ~0, 0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 mask_000f() {
+  const SimdInt4 ret = {0, 0, 0, ~0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 Load(int _x, int _y, int _z, int _w) {
+  const SimdInt4 ret = {_x, _y, _z, _w};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 LoadX(int _x) {
+  const SimdInt4 ret = {_x, 0, 0, 0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 Load1(int _x) {
+  const SimdInt4 ret = {_x, _x, _x, _x};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 Load(bool _x, bool _y, bool _z, bool _w) {
+  const SimdInt4 ret = {
+      -static_cast<int32_t>(_x), -static_cast<int32_t>(_y),
+      -static_cast<int32_t>(_z), -static_cast<int32_t>(_w)};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 LoadX(bool _x) {
+  const SimdInt4 ret = {-static_cast<int32_t>(_x), 0, 0, 0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 Load1(bool _x) {
+  const int32_t i = -static_cast<int32_t>(_x);
+  const SimdInt4 ret = {i, i, i, i};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 LoadPtr(const int* _i) {
+  assert(!(uintptr_t(_i) & 0xf) && "Invalid alignment");
+  return *reinterpret_cast<const SimdInt4*>(_i);
+}
+
+OZZ_INLINE SimdInt4 LoadXPtr(const int* _i) {
+  assert(!(uintptr_t(_i) & 0xf) && "Invalid alignment");
+  const SimdInt4 ret = {*_i, 0, 0, 0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 Load1Ptr(const int* _i) {
+  assert(!(uintptr_t(_i) & 0xf) && "Invalid alignment");
+  const SimdInt4 ret = {*_i, *_i, *_i, *_i};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 Load2Ptr(const int* _i) {
+  assert(!(uintptr_t(_i) & 0xf) && "Invalid alignment");
+  const SimdInt4 ret = {_i[0], _i[1], 0, 0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 Load3Ptr(const int* _i) {
+  assert(!(uintptr_t(_i) & 0xf) && "Invalid alignment");
+  const SimdInt4 ret = {_i[0], _i[1], _i[2], 0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 LoadPtrU(const int* _i) {
+  assert(!(uintptr_t(_i) & 0x3) && "Invalid alignment");
+  return (SimdInt4)wasm_v128_load(_i);
+}
+
+OZZ_INLINE SimdInt4 LoadXPtrU(const int* _i) {
+  assert(!(uintptr_t(_i) & 0x3) && "Invalid alignment");
+  const SimdInt4 ret = {*_i, 0, 0, 0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 Load1PtrU(const int* _i) {
+  assert(!(uintptr_t(_i) & 0x3) && "Invalid alignment");
+  return (SimdInt4)wasm_v128_load32_splat(_i);
+}
+
+OZZ_INLINE SimdInt4 Load2PtrU(const int* _i) {
+  assert(!(uintptr_t(_i) & 0x3) && "Invalid alignment");
+  const SimdInt4 ret = {_i[0], _i[1], 0, 0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 Load3PtrU(const int* _i) {
+  assert(!(uintptr_t(_i) & 0x3) && "Invalid alignment");
+  const SimdInt4 ret = {_i[0], _i[1], _i[2], 0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 FromFloatRound(_SimdFloat4 _f) {
+  return (SimdInt4)wasm_i32x4_trunc_sat_f32x4(wasm_f32x4_nearest((v128_t)_f));
+}
+
+OZZ_INLINE SimdInt4 FromFloatTrunc(_SimdFloat4 _f) {
+  return (SimdInt4)wasm_i32x4_trunc_sat_f32x4((v128_t)_f);
+}
+}  // namespace simd_int4
+
+OZZ_INLINE int GetX(_SimdInt4 _v) { return _v[0]; }
+
+OZZ_INLINE int GetY(_SimdInt4 _v) { return _v[1]; }
+
+OZZ_INLINE int GetZ(_SimdInt4 _v) { return _v[2]; }
+
+OZZ_INLINE int GetW(_SimdInt4 _v) { return _v[3]; }
+
+OZZ_INLINE SimdInt4 SetX(_SimdInt4 _v, _SimdInt4 _i) {
+  SimdInt4 ret = _v;
+  ret[0] = _i[0];
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 SetY(_SimdInt4 _v, _SimdInt4 _i) {
+  SimdInt4 ret = _v;
+  ret[1] = _i[0];
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 SetZ(_SimdInt4 _v, _SimdInt4 _i) {
+  SimdInt4 ret = _v;
+  ret[2] = _i[0];
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 SetW(_SimdInt4 _v, _SimdInt4 _i) {
+  SimdInt4 ret = _v;
+  ret[3] = _i[0];
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 SetI(_SimdInt4 _v, _SimdInt4 _i, int _ith) {
+  assert(_ith >= 0 && _ith <= 3 && "Invalid index, out of range.");
+  SimdInt4 ret = _v;
+  ret[_ith] = _i[0];
+  return ret;
+}
+
+OZZ_INLINE void StorePtr(_SimdInt4 _v, int* _i) {
+  assert(!(uintptr_t(_i) & 0xf) && "Invalid alignment");
+  *reinterpret_cast<SimdInt4*>(_i) = _v;
+}
+
+OZZ_INLINE void Store1Ptr(_SimdInt4 _v, int* _i) {
+  assert(!(uintptr_t(_i) & 0xf) && "Invalid alignment");
+  _i[0] = _v[0];
+}
+
+OZZ_INLINE void Store2Ptr(_SimdInt4 _v, int* _i) {
+  assert(!(uintptr_t(_i) & 0xf) && "Invalid alignment");
+  _i[0] = _v[0];
+  _i[1] = _v[1];
+}
+
+OZZ_INLINE void Store3Ptr(_SimdInt4 _v, int* _i) {
+  assert(!(uintptr_t(_i) & 0xf) && "Invalid alignment");
+  _i[0] = _v[0];
+  _i[1] = _v[1];
+  _i[2] = _v[2];
+}
+
+OZZ_INLINE void StorePtrU(_SimdInt4 _v, int* _i) {
+  assert(!(uintptr_t(_i) & 0x3) && "Invalid alignment");
+  wasm_v128_store(_i, (v128_t)_v);
+}
+
+OZZ_INLINE void Store1PtrU(_SimdInt4 _v, int* _i) {
+  assert(!(uintptr_t(_i) & 0x3) && "Invalid alignment");
+  _i[0] = _v[0];
+}
+
+OZZ_INLINE void Store2PtrU(_SimdInt4 _v, int* _i) {
+  assert(!(uintptr_t(_i) & 0x3) && "Invalid alignment");
+  _i[0] = _v[0];
+  _i[1] = _v[1];
+}
+
+OZZ_INLINE void Store3PtrU(_SimdInt4 _v, int* _i) {
+  assert(!(uintptr_t(_i) & 0x3) && "Invalid alignment");
+  _i[0] = _v[0];
+  _i[1] = _v[1];
+  _i[2] = _v[2];
+}
+
+OZZ_INLINE SimdInt4 SplatX(_SimdInt4 _a) { return OZZ_WASM_SPLAT_I(_a, 0); }
+
+OZZ_INLINE SimdInt4 SplatY(_SimdInt4 _a) { return OZZ_WASM_SPLAT_I(_a, 1); }
+
+OZZ_INLINE SimdInt4 SplatZ(_SimdInt4 _a) { return OZZ_WASM_SPLAT_I(_a, 2); }
+
+OZZ_INLINE SimdInt4 SplatW(_SimdInt4 _a) { return OZZ_WASM_SPLAT_I(_a, 3); }
+
+template <size_t _X, size_t _Y, size_t _Z, size_t _W>
+OZZ_INLINE SimdInt4 Swizzle(_SimdInt4 _v) {
+  static_assert(_X <= 3 && _Y <= 3 && _Z <= 3 && _W <= 3,
+                "Indices must be between 0 and 3");
+  return __builtin_shufflevector(_v, _v, _X, _Y, _Z, _W);
+}
+
+OZZ_INLINE int MoveMask(_SimdInt4 _v) {
+  return wasm_i32x4_bitmask((v128_t)_v);
+}
+
+OZZ_INLINE bool AreAllTrue(_SimdInt4 _v) {
+  return wasm_i32x4_bitmask((v128_t)_v) == 0xf;
+}
+
+OZZ_INLINE bool AreAllTrue3(_SimdInt4 _v) {
+  return (wasm_i32x4_bitmask((v128_t)_v) & 0x7) == 0x7;
+}
+
+OZZ_INLINE bool AreAllTrue2(_SimdInt4 _v) {
+  return (wasm_i32x4_bitmask((v128_t)_v) & 0x3) == 0x3;
+}
+
+OZZ_INLINE bool AreAllTrue1(_SimdInt4 _v) {
+  return (wasm_i32x4_bitmask((v128_t)_v) & 0x1) == 0x1;
+}
+
+OZZ_INLINE bool AreAllFalse(_SimdInt4 _v) {
+  return wasm_i32x4_bitmask((v128_t)_v) == 0;
+}
+
+OZZ_INLINE bool AreAllFalse3(_SimdInt4 _v) {
+  return (wasm_i32x4_bitmask((v128_t)_v) & 0x7) == 0;
+}
+
+OZZ_INLINE bool AreAllFalse2(_SimdInt4 _v) {
+  return (wasm_i32x4_bitmask((v128_t)_v) & 0x3) == 0;
+}
+
+OZZ_INLINE bool AreAllFalse1(_SimdInt4 _v) {
+  return (wasm_i32x4_bitmask((v128_t)_v) & 0x1) == 0;
+}
+
+OZZ_INLINE SimdInt4 HAdd2(_SimdInt4 _v) {
+  SimdInt4 ret = _v;
+  ret[0] = _v[0] + _v[1];
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 HAdd3(_SimdInt4 _v) {
+  SimdInt4 ret = _v;
+  ret[0] = _v[0] + _v[1] + _v[2];
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 HAdd4(_SimdInt4 _v) {
+  SimdInt4 ret = _v;
+  ret[0] = _v[0] + _v[1] + _v[2] + _v[3];
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 Abs(_SimdInt4 _v) {
+  return (SimdInt4)wasm_i32x4_abs((v128_t)_v);
+}
+
+OZZ_INLINE SimdInt4 Sign(_SimdInt4 _v) { return (_v >> 31) << 31; }
+
+OZZ_INLINE SimdInt4 Min(_SimdInt4 _a, _SimdInt4 _b) {
+  return (SimdInt4)wasm_i32x4_min((v128_t)_a, (v128_t)_b);
+}
+
+OZZ_INLINE SimdInt4 Max(_SimdInt4 _a, _SimdInt4 _b) {
+  return (SimdInt4)wasm_i32x4_max((v128_t)_a, (v128_t)_b);
+}
+
+OZZ_INLINE SimdInt4 Min0(_SimdInt4 _v) { return Min(simd_int4::zero(), _v); }
+
+OZZ_INLINE SimdInt4 Max0(_SimdInt4 _v) { return Max(simd_int4::zero(), _v); }
+
+OZZ_INLINE SimdInt4 Clamp(_SimdInt4 _a, _SimdInt4 _v, _SimdInt4 _b) {
+  return Min(Max(_a, _v), _b);
+}
+
+OZZ_INLINE SimdInt4 Select(_SimdInt4 _b, _SimdInt4 _true, _SimdInt4 _false) {
+  return OZZ_WASM_SELECT_I(_b, _true, _false);
+}
+
+OZZ_INLINE SimdInt4 And(_SimdInt4 _a, _SimdInt4 _b) { return _a & _b; }
+
+OZZ_INLINE SimdInt4 AndNot(_SimdInt4 _a, _SimdInt4 _b) { return _a & ~_b; }
+
+OZZ_INLINE SimdInt4 Or(_SimdInt4 _a, _SimdInt4 _b) { return _a | _b; }
+
+OZZ_INLINE SimdInt4 Xor(_SimdInt4 _a, _SimdInt4 _b) { return _a ^ _b; }
+
+OZZ_INLINE SimdInt4 Not(_SimdInt4 _v) { return ~_v; }
+
+OZZ_INLINE SimdInt4 ShiftL(_SimdInt4 _v, int _bits) {
+  return (SimdInt4)wasm_i32x4_shl((v128_t)_v, _bits);
+}
+
+OZZ_INLINE SimdInt4 ShiftR(_SimdInt4 _v, int _bits) {
+  return (SimdInt4)wasm_i32x4_shr((v128_t)_v, _bits);
+}
+
+OZZ_INLINE SimdInt4 ShiftRu(_SimdInt4 _v, int _bits) {
+  return (SimdInt4)wasm_u32x4_shr((v128_t)_v, _bits);
+}
+
+OZZ_INLINE SimdInt4 CmpEq(_SimdInt4 _a, _SimdInt4 _b) {
+  return (SimdInt4)(_a == _b);
+}
+
+OZZ_INLINE SimdInt4 CmpNe(_SimdInt4 _a, _SimdInt4 _b) {
+  return (SimdInt4)(_a != _b);
+}
+
+OZZ_INLINE SimdInt4 CmpLt(_SimdInt4 _a, _SimdInt4 _b) {
+  return (SimdInt4)(_a < _b);
+}
+
+OZZ_INLINE SimdInt4 CmpLe(_SimdInt4 _a, _SimdInt4 _b) {
+  return (SimdInt4)(_a <= _b);
+}
+
+OZZ_INLINE SimdInt4 CmpGt(_SimdInt4 _a, _SimdInt4 _b) {
+  return (SimdInt4)(_a > _b);
+}
+
+OZZ_INLINE SimdInt4 CmpGe(_SimdInt4 _a, _SimdInt4 _b) {
+  return (SimdInt4)(_a >= _b);
+}
+
+OZZ_INLINE Float4x4 Float4x4::identity() {
+  const Float4x4 ret = {{{1.f, 0.f, 0.f, 0.f},
+                         {0.f, 1.f, 0.f, 0.f},
+                         {0.f, 0.f, 1.f, 0.f},
+                         {0.f, 0.f, 0.f, 1.f}}};
+  return ret;
+}
+
+OZZ_INLINE Float4x4 Transpose(const Float4x4& _m) {
+  const SimdFloat4 tmp0 = OZZ_WASM_UNPACKLO_F(_m.cols[0], _m.cols[2]);
+  const SimdFloat4 tmp1 = OZZ_WASM_UNPACKLO_F(_m.cols[1], _m.cols[3]);
+  const SimdFloat4 tmp2 = OZZ_WASM_UNPACKHI_F(_m.cols[0], _m.cols[2]);
+  const SimdFloat4 tmp3 = OZZ_WASM_UNPACKHI_F(_m.cols[1], _m.cols[3]);
+  const Float4x4 ret = {
+      {OZZ_WASM_UNPACKLO_F(tmp0, tmp1), OZZ_WASM_UNPACKHI_F(tmp0, tmp1),
+       OZZ_WASM_UNPACKLO_F(tmp2, tmp3), OZZ_WASM_UNPACKHI_F(tmp2, tmp3)}};
+  return ret;
+}
+
+inline Float4x4 Invert(const Float4x4& _m, SimdInt4* _invertible) {
+  const SimdFloat4* cols = _m.cols;
+  const float a00 = cols[2][2] * cols[3][3] - cols[3][2] * cols[2][3];
+  const float a01 = cols[2][1] * cols[3][3] - cols[3][1] * cols[2][3];
+  const float a02 = cols[2][1] * cols[3][2] - cols[3][1] * cols[2][2];
+  const float a03 = cols[2][0] * cols[3][3] - cols[3][0] * cols[2][3];
+  const float a04 = cols[2][0] * cols[3][2] - cols[3][0] * cols[2][2];
+  const float a05 = cols[2][0] * cols[3][1] - cols[3][0] * cols[2][1];
+  const float a06 = cols[1][2] * cols[3][3] - cols[3][2] * cols[1][3];
+  const float a07 = cols[1][1] * cols[3][3] - cols[3][1] * cols[1][3];
+  const float a08 = cols[1][1] * cols[3][2] - cols[3][1] * cols[1][2];
+  const float a09 = cols[1][0] * cols[3][3] - cols[3][0] * cols[1][3];
+  const float a10 = cols[1][0] * cols[3][2] - cols[3][0] * cols[1][2];
+  const float a11 = cols[1][1] * cols[3][3] - cols[3][1] * cols[1][3];
+  const float a12 = cols[1][0] * cols[3][1] - cols[3][0] * cols[1][1];
+  const float a13 = cols[1][2] * cols[2][3] - cols[2][2] * cols[1][3];
+  const float a14 = cols[1][1] * cols[2][3] - cols[2][1] * cols[1][3];
+  const float a15 = cols[1][1] * cols[2][2] - cols[2][1] * cols[1][2];
+  const float a16 = cols[1][0] * cols[2][3] - cols[2][0] * cols[1][3];
+  const float a17 = cols[1][0] * cols[2][2] - cols[2][0] * cols[1][2];
+  const float a18 = cols[1][0] * cols[2][1] - cols[2][0] * cols[1][1];
+
+  const float b0x = cols[1][1] * a00 - cols[1][2] * a01 + cols[1][3] * a02;
+  const float b1x = -cols[1][0] * a00 + cols[1][2] * a03 - cols[1][3] * a04;
+  const float b2x = cols[1][0] * a01 - cols[1][1] * a03 + cols[1][3] * a05;
+  const float b3x = -cols[1][0] * a02 + cols[1][1] * a04 - cols[1][2] * a05;
+
+  const float b0y = -cols[0][1] * a00 + cols[0][2] * a01 - cols[0][3] * a02;
+  const float b1y = cols[0][0] * a00 - cols[0][2] * a03 + cols[0][3] * a04;
+  const float b2y = -cols[0][0] * a01 + cols[0][1] * a03 - cols[0][3] * a05;
+  const float b3y = cols[0][0] * a02 - cols[0][1] * a04 + cols[0][2] * a05;
+
+  const float b0z = cols[0][1] * a06 - cols[0][2] * a07 + cols[0][3] * a08;
+  const float b1z = -cols[0][0] * a06 + cols[0][2] * a09 - cols[0][3] * a10;
+  const float b2z = cols[0][0] * a11 - cols[0][1] * a09 + cols[0][3] * a12;
+  const float b3z = -cols[0][0] * a08 + cols[0][1] * a10 - cols[0][2] * a12;
+
+  const float b0w = -cols[0][1] * a13 + cols[0][2] * a14 - cols[0][3] * a15;
+  const float b1w = cols[0][0] * a13 - cols[0][2] * a16 + cols[0][3] * a17;
+  const float b2w = -cols[0][0] * a14 + cols[0][1] * a16 - cols[0][3] * a18;
+  const float b3w = cols[0][0] * a15 - cols[0][1] * a17 + cols[0][2] * a18;
+
+  const float det =
+      cols[0][0] * b0x + cols[0][1] * b1x + cols[0][2] * b2x + cols[0][3] * b3x;
+  const bool invertible = det != 0.f;
+  assert((_invertible || invertible) && "Matrix is not invertible");
+  if (_invertible != nullptr) {
+    *_invertible = simd_int4::LoadX(invertible);
+  }
+  const float inv_det = invertible ? 1.f / det : 0.f;
+
+  const Float4x4 ret = {
+      {{b0x * inv_det, b0y * inv_det, b0z * inv_det, b0w * inv_det},
+       {b1x * inv_det, b1y * inv_det, b1z * inv_det, b1w * inv_det},
+       {b2x * inv_det, b2y * inv_det, b2z * inv_det, b2w * inv_det},
+       {b3x * inv_det, b3y * inv_det, b3z * inv_det, b3w * inv_det}}};
+  return ret;
+}
+
+Float4x4 Float4x4::Translation(_SimdFloat4 _v) {
+  const Float4x4 ret = {{{1.f, 0.f, 0.f, 0.f},
+                         {0.f, 1.f, 0.f, 0.f},
+                         {0.f, 0.f, 1.f, 0.f},
+                         {_v[0], _v[1], _v[2], 1.f}}};
+  return ret;
+}
+
+Float4x4 Float4x4::Scaling(_SimdFloat4 _v) {
+  const Float4x4 ret = {{{_v[0], 0.f, 0.f, 0.f},
+                         {0.f, _v[1], 0.f, 0.f},
+                         {0.f, 0.f, _v[2], 0.f},
+                         {0.f, 0.f, 0.f, 1.f}}};
+  return ret;
+}
+
+OZZ_INLINE Float4x4 Translate(const Float4x4& _m, _SimdFloat4 _v) {
+  const SimdFloat4 a01 = _m.cols[0] * OZZ_WASM_SPLAT_F(_v, 0) +
+                         _m.cols[1] * OZZ_WASM_SPLAT_F(_v, 1);
+  const SimdFloat4 m3 = _m.cols[2] * OZZ_WASM_SPLAT_F(_v, 2) + _m.cols[3];
+  const Float4x4 ret = {{_m.cols[0], _m.cols[1], _m.cols[2], a01 + m3}};
+  return ret;
+}
+
+OZZ_INLINE Float4x4 Scale(const Float4x4& _m, _SimdFloat4 _v) {
+  const Float4x4 ret = {{_m.cols[0] * OZZ_WASM_SPLAT_F(_v, 0),
+                         _m.cols[1] * OZZ_WASM_SPLAT_F(_v, 1),
+                         _m.cols[2] * OZZ_WASM_SPLAT_F(_v, 2), _m.cols[3]}};
+  return ret;
+}
+
+OZZ_INLINE Float4x4 ColumnMultiply(const Float4x4& _m, _SimdFloat4 _v) {
+  const Float4x4 ret = {{_m.cols[0] * _v, _m.cols[1] * _v, _m.cols[2] * _v,
+                         _m.cols[3] * _v}};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 IsNormalized(const Float4x4& _m) {
+  const SimdInt4 ret = {IsNormalized3(_m.cols[0])[0],
+                        IsNormalized3(_m.cols[1])[0],
+                        IsNormalized3(_m.cols[2])[0], 0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 IsNormalizedEst(const Float4x4& _m) {
+  const SimdInt4 ret = {IsNormalizedEst3(_m.cols[0])[0],
+                        IsNormalizedEst3(_m.cols[1])[0],
+                        IsNormalizedEst3(_m.cols[2])[0], 0};
+  return ret;
+}
+
+OZZ_INLINE SimdInt4 IsOrthogonal(const Float4x4& _m) {
+  // Use simd_float4::zero() if one of the normalization fails. _m will then be
+  // considered not orthogonal.
+  const SimdFloat4 cross =
+      NormalizeSafe3(Cross3(_m.cols[0], _m.cols[1]), simd_float4::zero());
+  const SimdFloat4 at = NormalizeSafe3(_m.cols[2], simd_float4::zero());
+
+  const float sq_len =
+      cross[0] * at[0] + cross[1] * at[1] + cross[2] * at[2];
+  const bool same = std::abs(sq_len - 1.f) < kNormalizationToleranceSq;
+  const SimdInt4 ret = {-static_cast<int32_t>(same), 0, 0, 0};
+  return ret;
+}
+
+inline SimdFloat4 ToQuaternion(const Float4x4& _m) {
+  assert(AreAllTrue3(IsNormalized(_m)));
+  assert(AreAllTrue1(IsOrthogonal(_m)));
+  // Cf From Quaternion to Matrix and Back, J.M.P. van Waveren 2005.
+  SimdFloat4 ret;
+  if (_m.cols[0][0] + _m.cols[1][1] + _m.cols[2][2] > .0f) {
+    const float t = _m.cols[0][0] + _m.cols[1][1] + _m.cols[2][2] + 1.0f;
+    const float s = (1.f / std::sqrt(t)) * .5f;
+    ret[0] = (_m.cols[1][2] - _m.cols[2][1]) * s;
+    ret[1] = (_m.cols[2][0] - _m.cols[0][2]) * s;
+    ret[2] = (_m.cols[0][1] - _m.cols[1][0]) * s;
+    ret[3] = s * t;
+  } else if (_m.cols[0][0] > _m.cols[1][1] && _m.cols[0][0] > _m.cols[2][2]) {
+    const float t = _m.cols[0][0] - _m.cols[1][1] - _m.cols[2][2] + 1.0f;
+    const float s = (1.f / std::sqrt(t)) * .5f;
+    ret[0] = s * t;
+    ret[1] = (_m.cols[0][1] + _m.cols[1][0]) * s;
+    ret[2] = (_m.cols[2][0] + _m.cols[0][2]) * s;
+    ret[3] = (_m.cols[1][2] - _m.cols[2][1]) * s;
+  } else if (_m.cols[1][1] > _m.cols[2][2]) {
+    const float t = -_m.cols[0][0] + _m.cols[1][1] - _m.cols[2][2] + 1.0f;
+    const float s = (1.f / std::sqrt(t)) * .5f;
+    ret[0] = (_m.cols[0][1] + _m.cols[1][0]) * s;
+    ret[1] = s * t;
+    ret[2] = (_m.cols[1][2] + _m.cols[2][1]) * s;
+    ret[3] = (_m.cols[2][0] - _m.cols[0][2]) * s;
+  } else {
+    const float t = -_m.cols[0][0] - _m.cols[1][1] + _m.cols[2][2] + 1.0f;
+    const float s = (1.f / std::sqrt(t)) * .5f;
+    ret[0] = (_m.cols[2][0] + _m.cols[0][2]) * s;
+    ret[1] = (_m.cols[1][2] + _m.cols[2][1]) * s;
+    ret[2] = s * t;
+    ret[3] = (_m.cols[0][1] - _m.cols[1][0]) * s;
+  }
+  assert(AreAllTrue1(IsNormalizedEst4(ret)));
+  return ret;
+}
+
+inline bool ToAffine(const Float4x4& _m, SimdFloat4* _translation,
+                     SimdFloat4* _quaternion, SimdFloat4* _scale) {
+  const SimdFloat4 translation = {_m.cols[3][0], _m.cols[3][1], _m.cols[3][2],
+                                  1.f};
+  *_translation = translation;
+
+  // Extracts scale.
+  const float sq_scale_x = Length3Sqr(_m.cols[0])[0];
+  const float scale_x = std::sqrt(sq_scale_x);
+  const float sq_scale_y = Length3Sqr(_m.cols[1])[0];
+  const float scale_y = std::sqrt(sq_scale_y);
+  const float sq_scale_z = Length3Sqr(_m.cols[2])[0];
+  const float scale_z = std::sqrt(sq_scale_z);
+
+  // Builds an orthonormal matrix in order to support quaternion extraction.
+  const bool x_zero = std::abs(sq_scale_x) < kOrthogonalisationToleranceSq;
+  const bool y_zero = std::abs(sq_scale_y) < kOrthogonalisationToleranceSq;
+  const bool z_zero = std::abs(sq_scale_z) < kOrthogonalisationToleranceSq;
+
+  Float4x4 orthonormal;
+  if (x_zero) {
+    if (y_zero || z_zero) {
+      return false;
+    }
+    orthonormal.cols[1] = _m.cols[1] * simd_float4::Load1(1.f / scale_y);
+    orthonormal.cols[1][3] = 0.f;
+    orthonormal.cols[0] = Normalize3(Cross3(orthonormal.cols[1], _m.cols[2]));
+    orthonormal.cols[2] =
+        Normalize3(Cross3(orthonormal.cols[0], orthonormal.cols[1]));
+  } else if (z_zero) {
+    if (x_zero || y_zero) {
+      return false;
+    }
+    orthonormal.cols[0] = _m.cols[0] * simd_float4::Load1(1.f / scale_x);
+    orthonormal.cols[0][3] = 0.f;
+    orthonormal.cols[2] = Normalize3(Cross3(orthonormal.cols[0], _m.cols[1]));
+    orthonormal.cols[1] =
+        Normalize3(Cross3(orthonormal.cols[2], orthonormal.cols[0]));
+  } else {  // Favor z axis in the default case
+    if (x_zero || z_zero) {
+      return false;
+    }
+    orthonormal.cols[2] = _m.cols[2] * simd_float4::Load1(1.f / scale_z);
+    orthonormal.cols[2][3] = 0.f;
+    orthonormal.cols[1] = Normalize3(Cross3(orthonormal.cols[2], _m.cols[0]));
+    orthonormal.cols[0] =
+        Normalize3(Cross3(orthonormal.cols[1], orthonormal.cols[2]));
+  }
+  orthonormal.cols[3] = simd_float4::w_axis();
+
+  // Get back scale signs in case of reflexions
+  const SimdFloat4 scale = {
+      Dot3(orthonormal.cols[0], _m.cols[0])[0] > 0.f ? scale_x : -scale_x,
+      Dot3(orthonormal.cols[1], _m.cols[1])[0] > 0.f ? scale_y : -scale_y,
+      Dot3(orthonormal.cols[2], _m.cols[2])[0] > 0.f ? scale_z : -scale_z, 1.f};
+  *_scale = scale;
+
+  // Extracts quaternion.
+  *_quaternion = ToQuaternion(orthonormal);
+  return true;
+}
+
+inline Float4x4 Float4x4::FromEuler(_SimdFloat4 _v) {
+  return Float4x4::FromAxisAngle(simd_float4::y_axis(), SplatX(_v)) *
+         Float4x4::FromAxisAngle(simd_float4::x_axis(), SplatY(_v)) *
+         Float4x4::FromAxisAngle(simd_float4::z_axis(), SplatZ(_v));
+}
+
+inline Float4x4 Float4x4::FromAxisAngle(_SimdFloat4 _axis, _SimdFloat4 _angle) {
+  assert(AreAllTrue1(IsNormalizedEst3(_axis)));
+
+  const float cos = std::cos(_angle[0]);
+  const float sin = std::sin(_angle[0]);
+  const float t = 1.f - cos;
+
+  const float a = _axis[0] * _axis[1] * t;
+  const float b = _axis[2] * sin;
+  const float c = _axis[0] * _axis[2] * t;
+  const float d = _axis[1] * sin;
+  const float e = _axis[1] * _axis[2] * t;
+  const float f = _axis[0] * sin;
+
+  const Float4x4 ret = {{{cos + _axis[0] * _axis[0] * t, a + b, c - d, 0.f},
+                         {a - b, cos + _axis[1] * _axis[1] * t, e + f, 0.f},
+                         {c + d, e - f, cos + _axis[2] * _axis[2] * t, 0.f},
+                         {0.f, 0.f, 0.f, 1.f}}};
+  return ret;
+}
+
+inline Float4x4 Float4x4::FromQuaternion(_SimdFloat4 _quaternion) {
+  assert(AreAllTrue1(IsNormalizedEst4(_quaternion)));
+
+  const float xx = _quaternion[0] * _quaternion[0];
+  const float xy = _quaternion[0] * _quaternion[1];
+  const float xz = _quaternion[0] * _quaternion[2];
+  const float xw = _quaternion[0] * _quaternion[3];
+  const float yy = _quaternion[1] * _quaternion[1];
+  const float yz = _quaternion[1] * _quaternion[2];
+  const float yw = _quaternion[1] * _quaternion[3];
+  const float zz = _quaternion[2] * _quaternion[2];
+  const float zw = _quaternion[2] * _quaternion[3];
+
+  const Float4x4 ret = {
+      {{1.f - 2.f * (yy + zz), 2.f * (xy + zw), 2.f * (xz - yw), 0.f},
+       {2.f * (xy - zw), 1.f - 2.f * (xx + zz), 2.f * (yz + xw), 0.f},
+       {2.f * (xz + yw), 2.f * (yz - xw), 1.f - 2.f * (xx + yy), 0.f},
+       {0.f, 0.f, 0.f, 1.f}}};
+  return ret;
+}
+
+inline Float4x4 Float4x4::FromAffine(_SimdFloat4 _translation,
+                                     _SimdFloat4 _quaternion,
+                                     _SimdFloat4 _scale) {
+  assert(AreAllTrue1(IsNormalizedEst4(_quaternion)));
+
+  const float xx = _quaternion[0] * _quaternion[0];
+  const float xy = _quaternion[0] * _quaternion[1];
+  const float xz = _quaternion[0] * _quaternion[2];
+  const float xw = _quaternion[0] * _quaternion[3];
+  const float yy = _quaternion[1] * _quaternion[1];
+  const float yz = _quaternion[1] * _quaternion[2];
+  const float yw = _quaternion[1] * _quaternion[3];
+  const float zz = _quaternion[2] * _quaternion[2];
+  const float zw = _quaternion[2] * _quaternion[3];
+
+  const Float4x4 ret = {
+      {{_scale[0] * (1.f - 2.f * (yy + zz)), _scale[0] * 2.f * (xy + zw),
+        _scale[0] * 2.f * (xz - yw), 0.f},
+       {_scale[1] * 2.f * (xy - zw), _scale[1] * (1.f - 2.f * (xx + zz)),
+        _scale[1] * (2.f * (yz + xw)), 0.f},
+       {_scale[2] * 2.f * (xz + yw), _scale[2] * 2.f * (yz - xw),
+        _scale[2] * (1.f - 2.f * (xx + yy)), 0.f},
+       {_translation[0], _translation[1], _translation[2], 1.f}}};
+  return ret;
+}
+
+OZZ_INLINE ozz::math::SimdFloat4 TransformPoint(const ozz::math::Float4x4& _m,
+                                                ozz::math::_SimdFloat4 _v) {
+  const SimdFloat4 xxxx = _m.cols[0] * OZZ_WASM_SPLAT_F(_v, 0);
+  const SimdFloat4 a23 = _m.cols[2] * OZZ_WASM_SPLAT_F(_v, 2) + _m.cols[3];
+  const SimdFloat4 a01 = _m.cols[1] * OZZ_WASM_SPLAT_F(_v, 1) + xxxx;
+  return a01 + a23;
+}
+
+OZZ_INLINE ozz::math::SimdFloat4 TransformVector(const ozz::math::Float4x4& _m,
+                                                 ozz::math::_SimdFloat4 _v) {
+  const SimdFloat4 xxxx = _m.cols[0] * OZZ_WASM_SPLAT_F(_v, 0);
+  const SimdFloat4 zzzz = _m.cols[1] * OZZ_WASM_SPLAT_F(_v, 1);
+  const SimdFloat4 a21 = _m.cols[2] * OZZ_WASM_SPLAT_F(_v, 2) + xxxx;
+  return zzzz + a21;
+}
+
+OZZ_INLINE ozz::math::SimdFloat4 operator*(const ozz::math::Float4x4& _m,
+                                           ozz::math::_SimdFloat4 _v) {
+  const SimdFloat4 xxxx = _m.cols[0] * OZZ_WASM_SPLAT_F(_v, 0);
+  const SimdFloat4 zzzz = _m.cols[2] * OZZ_WASM_SPLAT_F(_v, 2);
+  const SimdFloat4 a01 = _m.cols[1] * OZZ_WASM_SPLAT_F(_v, 1) + xxxx;
+  const SimdFloat4 a23 = _m.cols[3] * OZZ_WASM_SPLAT_F(_v, 3) + zzzz;
+  return a01 + a23;
+}
+
+inline ozz::math::Float4x4 operator*(const ozz::math::Float4x4& _a,
+                                     const ozz::math::Float4x4& _b) {
+  ozz::math::Float4x4 ret;
+  for (int i = 0; i < 4; ++i) {
+    const SimdFloat4 xxxx = _a.cols[0] * OZZ_WASM_SPLAT_F(_b.cols[i], 0);
+    const SimdFloat4 zzzz = _a.cols[2] * OZZ_WASM_SPLAT_F(_b.cols[i], 2);
+    const SimdFloat4 a01 = _a.cols[1] * OZZ_WASM_SPLAT_F(_b.cols[i], 1) + xxxx;
+    const SimdFloat4 a23 = _a.cols[3] * OZZ_WASM_SPLAT_F(_b.cols[i], 3) + zzzz;
+    ret.cols[i] = a01 + a23;
+  }
+  return ret;
+}
+
+OZZ_INLINE ozz::math::Float4x4 operator+(const ozz::math::Float4x4& _a,
+                                         const ozz::math::Float4x4& _b) {
+  const ozz::math::Float4x4 ret = {
+      {_a.cols[0] + _b.cols[0], _a.cols[1] + _b.cols[1],
+       _a.cols[2] + _b.cols[2], _a.cols[3] + _b.cols[3]}};
+  return ret;
+}
+
+OZZ_INLINE ozz::math::Float4x4 operator-(const ozz::math::Float4x4& _a,
+                                         const ozz::math::Float4x4& _b) {
+  const ozz::math::Float4x4 ret = {
+      {_a.cols[0] - _b.cols[0], _a.cols[1] - _b.cols[1],
+       _a.cols[2] - _b.cols[2], _a.cols[3] - _b.cols[3]}};
+  return ret;
+}
+
+// Half <-> Float implementation is based on:
+// http://fgiesen.wordpress.com/2012/03/28/half-to-float-done-quic/.
+OZZ_INLINE uint16_t FloatToHalf(float _f) {
+  const uint32_t f32infty = 255 << 23;
+  const uint32_t f16infty = 31 << 23;
+  const union {
+    uint32_t u;
+    float f;
+  } magic = {15 << 23};
+  const uint32_t sign_mask = 0x80000000u;
+  const uint32_t round_mask = ~0x00000fffu;
+
+  const union {
+    float f;
+    uint32_t u;
+  } f = {_f};
+  const uint32_t sign = f.u & sign_mask;
+  const uint32_t f_nosign = f.u & ~sign_mask;
+
+  if (f_nosign >= f32infty) {  // Inf or NaN (all exponent bits set)
+    // NaN->qNaN and Inf->Inf
+    const uint32_t result =
+        ((f_nosign > f32infty) ? 0x7e00 : 0x7c00) | (sign >> 16);
+    return static_cast<uint16_t>(result);
+  } else {  // (De)normalized number or zero
+    const union {
+      uint32_t u;
+      float f;
+    } rounded = {f_nosign & round_mask};
+    const union {
+      float f;
+      uint32_t u;
+    } exp = {rounded.f * magic.f};
+    const uint32_t re_rounded = exp.u - round_mask;
+    // Clamp to signed infinity if overflowed
+    const uint32_t result =
+        ((re_rounded > f16infty ? f16infty : re_rounded) >> 13) | (sign >> 16);
+    return static_cast<uint16_t>(result);
+  }
+}
+
+OZZ_INLINE float HalfToFloat(uint16_t _h) {
+  const union {
+    uint32_t u;
+    float f;
+  } magic = {(254 - 15) << 23};
+  const union {
+    uint32_t u;
+    float f;
+  } infnan = {(127 + 16) << 23};
+
+  const uint32_t sign = _h & 0x8000;
+  const union {
+    int32_t u;
+    float f;
+  } exp_mant = {(_h & 0x7fff) << 13};
+  const union {
+    float f;
+    uint32_t u;
+  } adjust = {exp_mant.f * magic.f};
+  // Make sure Inf/NaN survive
+  const union {
+    uint32_t u;
+    float f;
+  } result = {(adjust.f >= infnan.f ? (adjust.u | 255 << 23) : adjust.u) |
+              (sign << 16)};
+  return result.f;
+}
+
+OZZ_INLINE SimdInt4 FloatToHalf(_SimdFloat4 _f) {
+  const SimdInt4 ret = {FloatToHalf(_f[0]), FloatToHalf(_f[1]),
+                        FloatToHalf(_f[2]), FloatToHalf(_f[3])};
+  return ret;
+}
+
+OZZ_INLINE SimdFloat4 HalfToFloat(_SimdInt4 _h) {
+  const SimdFloat4 ret = {
+      HalfToFloat(static_cast<uint16_t>(_h[0] & 0x0000ffff)),
+      HalfToFloat(static_cast<uint16_t>(_h[1] & 0x0000ffff)),
+      HalfToFloat(static_cast<uint16_t>(_h[2] & 0x0000ffff)),
+      HalfToFloat(static_cast<uint16_t>(_h[3] & 0x0000ffff))};
+  return ret;
+}
+}  // namespace math
+}  // namespace ozz
+
+#undef OZZ_WASM_SPLAT_F
+#undef OZZ_WASM_SPLAT_I
+#undef OZZ_WASM_UNPACKLO_F
+#undef OZZ_WASM_UNPACKHI_F
+#undef OZZ_WASM_MOVELH_F
+#undef OZZ_WASM_MOVEHL_F
+#undef OZZ_WASM_SELECT_F
+#undef OZZ_WASM_SELECT_I
+#endif  // OZZ_OZZ_BASE_MATHS_INTERNAL_SIMD_MATH_WASM_INL_H_
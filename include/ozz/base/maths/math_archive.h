@@ -44,6 +44,7 @@ struct RectInt;
 }  // namespace math
 namespace io {
 OZZ_IO_TYPE_NOT_VERSIONABLE(math::Float2)
+OZZ_IO_TYPE_RAW(math::Float2)
 template <>
 struct OZZ_BASE_DLL Extern<math::Float2> {
   static void Save(OArchive& _archive, const math::Float2* _values,
@@ -53,6 +54,7 @@ struct OZZ_BASE_DLL Extern<math::Float2> {
 };
 
 OZZ_IO_TYPE_NOT_VERSIONABLE(math::Float3)
+OZZ_IO_TYPE_RAW(math::Float3)
 template <>
 struct OZZ_BASE_DLL Extern<math::Float3> {
   static void Save(OArchive& _archive, const math::Float3* _values,
@@ -62,6 +64,7 @@ struct OZZ_BASE_DLL Extern<math::Float3> {
 };
 
 OZZ_IO_TYPE_NOT_VERSIONABLE(math::Float4)
+OZZ_IO_TYPE_RAW(math::Float4)
 template <>
 struct OZZ_BASE_DLL Extern<math::Float4> {
   static void Save(OArchive& _archive, const math::Float4* _values,
@@ -71,6 +74,7 @@ struct OZZ_BASE_DLL Extern<math::Float4> {
 };
 
 OZZ_IO_TYPE_NOT_VERSIONABLE(math::Quaternion)
+OZZ_IO_TYPE_RAW(math::Quaternion)
 template <>
 struct OZZ_BASE_DLL Extern<math::Quaternion> {
   static void Save(OArchive& _archive, const math::Quaternion* _values,
@@ -80,6 +84,7 @@ struct OZZ_BASE_DLL Extern<math::Quaternion> {
 };
 
 OZZ_IO_TYPE_NOT_VERSIONABLE(math::Transform)
+OZZ_IO_TYPE_RAW(math::Transform)
 template <>
 struct OZZ_BASE_DLL Extern<math::Transform> {
   static void Save(OArchive& _archive, const math::Transform* _values,
@@ -89,6 +94,7 @@ struct OZZ_BASE_DLL Extern<math::Transform> {
 };
 
 OZZ_IO_TYPE_NOT_VERSIONABLE(math::Box)
+OZZ_IO_TYPE_RAW(math::Box)
 template <>
 struct OZZ_BASE_DLL Extern<math::Box> {
   static void Save(OArchive& _archive, const math::Box* _values, size_t _count);
@@ -97,6 +103,7 @@ struct OZZ_BASE_DLL Extern<math::Box> {
 };
 
 OZZ_IO_TYPE_NOT_VERSIONABLE(math::RectFloat)
+OZZ_IO_TYPE_RAW(math::RectFloat)
 template <>
 struct OZZ_BASE_DLL Extern<math::RectFloat> {
   static void Save(OArchive& _archive, const math::RectFloat* _values,
@@ -106,6 +113,7 @@ struct OZZ_BASE_DLL Extern<math::RectFloat> {
 };
 
 OZZ_IO_TYPE_NOT_VERSIONABLE(math::RectInt)
+OZZ_IO_TYPE_RAW(math::RectInt)
 template <>
 struct OZZ_BASE_DLL Extern<math::RectInt> {
   static void Save(OArchive& _archive, const math::RectInt* _values,
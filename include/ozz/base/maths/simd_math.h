@@ -585,6 +585,36 @@ OZZ_INLINE SimdFloat4 ATan(_SimdFloat4 _v);
 // same as their respective components in _v.
 OZZ_INLINE SimdFloat4 ATanX(_SimdFloat4 _v);
 
+// Computes the per element estimated sine of _v, which must be within [-pi,
+// pi] range. Maximum error is around 1e-6 radian.
+OZZ_INLINE SimdFloat4 SinEst(_SimdFloat4 _v);
+
+// Computes the estimated sine of the x component of _v, which must be within
+// [-pi, pi] range, and stores it in the x component of the returned vector. y,
+// z and w of the returned vector are the same as their respective components
+// in _v.
+OZZ_INLINE SimdFloat4 SinEstX(_SimdFloat4 _v);
+
+// Computes the per element estimated cosine of _v, which must be within [-pi,
+// pi] range. Maximum error is around 1e-6 radian.
+OZZ_INLINE SimdFloat4 CosEst(_SimdFloat4 _v);
+
+// Computes the estimated cosine of the x component of _v, which must be
+// within [-pi, pi] range, and stores it in the x component of the returned
+// vector. y, z and w of the returned vector are the same as their respective
+// components in _v.
+OZZ_INLINE SimdFloat4 CosEstX(_SimdFloat4 _v);
+
+// Computes the per element estimated arccosine of _v, which must be within
+// [-1, 1] range. Maximum error is around 7e-5 radian.
+OZZ_INLINE SimdFloat4 ACosEst(_SimdFloat4 _v);
+
+// Computes the estimated arccosine of the x component of _v, which must be
+// within [-1, 1] range, and stores it in the x component of the returned
+// vector. y, z and w of the returned vector are the same as their respective
+// components in _v.
+OZZ_INLINE SimdFloat4 ACosEstX(_SimdFloat4 _v);
+
 // Returns boolean selection of vectors _true and _false according to condition
 // _b. All bits a each component of _b must have the same value (O or
 // 0xffffffff) to ensure portability.
@@ -1218,9 +1248,74 @@ OZZ_INLINE SimdFloat4 HalfToFloat(_SimdInt4 _h);
 
 #if defined(OZZ_SIMD_SSEx)
 #include "ozz/base/maths/internal/simd_math_sse-inl.h"
+#elif defined(OZZ_SIMD_WASM)
+#include "ozz/base/maths/internal/simd_math_wasm-inl.h"
 #elif defined(OZZ_SIMD_REF)
 #include "ozz/base/maths/internal/simd_math_ref-inl.h"
 #else
 #error No simd_math implementation detected
 #endif
+
+// Implements estimated transcendental functions. They are built on top of the
+// primitive operations only, as polynomial approximations don't benefit from
+// platform specific instructions, hence a single implementation for all
+// platforms.
+namespace ozz {
+namespace math {
+
+OZZ_INLINE SimdFloat4 SinEst(_SimdFloat4 _v) {
+  const SimdFloat4 pi = simd_float4::Load1(3.1415926535f);
+  const SimdFloat4 half_pi = simd_float4::Load1(1.5707963268f);
+
+  // Reflects _v around +/-pi/2 (sin(pi - x) == sin(x)) so the polynomial is
+  // evaluated within its [-pi/2, pi/2] validity range.
+  const SimdFloat4 reflected = Xor(pi, Sign(_v)) - _v;
+  const SimdFloat4 x = Select(CmpGt(Abs(_v), half_pi), reflected, _v);
+
+  // Degree 7 minimax polynomial approximation of sine on [-pi/2, pi/2].
+  const SimdFloat4 x2 = x * x;
+  const SimdFloat4 p =
+      MAdd(x2,
+           MAdd(x2,
+                MAdd(x2, simd_float4::Load1(-1.84477486e-4f),
+                     simd_float4::Load1(8.3109378e-3f)),
+                simd_float4::Load1(-1.6665578e-1f)),
+           simd_float4::one());
+  return x * p;
+}
+
+OZZ_INLINE SimdFloat4 SinEstX(_SimdFloat4 _v) { return SetX(_v, SinEst(_v)); }
+
+OZZ_INLINE SimdFloat4 CosEst(_SimdFloat4 _v) {
+  // cos(x) == sin(pi/2 - |x|), with pi/2 - |x| within the sine polynomial
+  // [-pi/2, pi/2] validity range for any |x| <= pi.
+  const SimdFloat4 half_pi = simd_float4::Load1(1.5707963268f);
+  return SinEst(half_pi - Abs(_v));
+}
+
+OZZ_INLINE SimdFloat4 CosEstX(_SimdFloat4 _v) { return SetX(_v, CosEst(_v)); }
+
+OZZ_INLINE SimdFloat4 ACosEst(_SimdFloat4 _v) {
+  // Polynomial minimax approximation from Abramowitz & Stegun 4.4.45, of the
+  // form acos(|x|) == sqrt(1 - |x|) * p(|x|).
+  const SimdFloat4 abs_v = Abs(_v);
+  const SimdFloat4 p =
+      MAdd(abs_v,
+           MAdd(abs_v,
+                MAdd(abs_v, simd_float4::Load1(-.0187293f),
+                     simd_float4::Load1(.0742610f)),
+                simd_float4::Load1(-.2121144f)),
+           simd_float4::Load1(1.5707288f));
+  const SimdFloat4 r = Sqrt(simd_float4::one() - abs_v) * p;
+
+  // Mirrors the result for negative inputs, acos(-x) == pi - acos(x).
+  const SimdFloat4 pi = simd_float4::Load1(3.1415926535f);
+  return Select(CmpLt(_v, simd_float4::zero()), pi - r, r);
+}
+
+OZZ_INLINE SimdFloat4 ACosEstX(_SimdFloat4 _v) {
+  return SetX(_v, ACosEst(_v));
+}
+}  // namespace math
+}  // namespace ozz
 #endif  // OZZ_OZZ_BASE_MATHS_SIMD_MATH_H_
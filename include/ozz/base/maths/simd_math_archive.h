@@ -35,6 +35,7 @@
 namespace ozz {
 namespace io {
 OZZ_IO_TYPE_NOT_VERSIONABLE(math::SimdFloat4)
+OZZ_IO_TYPE_RAW(math::SimdFloat4)
 template <>
 struct OZZ_BASE_DLL Extern<math::SimdFloat4> {
   static void Save(OArchive& _archive, const math::SimdFloat4* _values,
@@ -44,6 +45,7 @@ struct OZZ_BASE_DLL Extern<math::SimdFloat4> {
 };
 
 OZZ_IO_TYPE_NOT_VERSIONABLE(math::SimdInt4)
+OZZ_IO_TYPE_RAW(math::SimdInt4)
 template <>
 struct OZZ_BASE_DLL Extern<math::SimdInt4> {
   static void Save(OArchive& _archive, const math::SimdInt4* _values,
@@ -53,6 +55,7 @@ struct OZZ_BASE_DLL Extern<math::SimdInt4> {
 };
 
 OZZ_IO_TYPE_NOT_VERSIONABLE(math::Float4x4)
+OZZ_IO_TYPE_RAW(math::Float4x4)
 template <>
 struct OZZ_BASE_DLL Extern<math::Float4x4> {
   static void Save(OArchive& _archive, const math::Float4x4* _values,
@@ -49,6 +49,12 @@ struct SimdQuaternion {
   static OZZ_INLINE SimdQuaternion FromAxisAngle(_SimdFloat4 _axis,
                                                  _SimdFloat4 _angle);
 
+  // Estimated variant of FromAxisAngle, using estimated trigonometric
+  // functions. _angle.x must be within [-2pi, 2pi] range. See SinEst for
+  // precision details.
+  static OZZ_INLINE SimdQuaternion FromAxisAngleEst(_SimdFloat4 _axis,
+                                                    _SimdFloat4 _angle);
+
   // Returns a normalized quaternion initialized from an axis and angle cosine
   // representation.
   // Assumes the axis part (x, y, z) of _axis_angle is normalized.
@@ -168,6 +174,16 @@ OZZ_INLINE SimdQuaternion SimdQuaternion::FromAxisAngle(_SimdFloat4 _axis,
   return quat;
 }
 
+OZZ_INLINE SimdQuaternion SimdQuaternion::FromAxisAngleEst(_SimdFloat4 _axis,
+                                                           _SimdFloat4 _angle) {
+  assert(AreAllTrue1(IsNormalizedEst3(_axis)) && "axis is not normalized.");
+  const SimdFloat4 half_angle = _angle * simd_float4::Load1(.5f);
+  const SimdFloat4 half_sin = SinEstX(half_angle);
+  const SimdFloat4 half_cos = CosEstX(half_angle);
+  const SimdQuaternion quat = {SetW(_axis * SplatX(half_sin), half_cos)};
+  return quat;
+}
+
 OZZ_INLINE SimdQuaternion SimdQuaternion::FromAxisCosAngle(_SimdFloat4 _axis,
                                                            _SimdFloat4 _cos) {
   const SimdFloat4 one = simd_float4::one();
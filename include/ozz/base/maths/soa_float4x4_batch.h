@@ -0,0 +1,151 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_BASE_MATHS_SOA_FLOAT4X4_BATCH_H_
+#define OZZ_OZZ_BASE_MATHS_SOA_FLOAT4X4_BATCH_H_
+
+// Provides span level kernels over SoaFloat4x4 arrays, for consumers
+// processing whole pose arrays (attachment propagation, palette setup, GPU
+// upload preparation...). Compared with looping over the single block
+// operations of soa_float4x4.h, the kernels process 2 independent soa blocks
+// per iteration, so loads and arithmetic of consecutive blocks pipeline, and
+// can optionally use non-temporal stores for outputs that go straight to an
+// upload heap and would otherwise evict useful cache lines.
+
+#include <cassert>
+
+#include "ozz/base/maths/soa_float4x4.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/platform.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+namespace math {
+
+namespace internal {
+// Stores _m to _dest, bypassing caches when _streaming is true. Streaming
+// falls back to a regular store on non-sse targets.
+OZZ_INLINE void StoreBatch(const SoaFloat4x4& _m, SoaFloat4x4* _dest,
+                           bool _streaming) {
+#if defined(OZZ_SIMD_SSEx)
+  if (_streaming) {
+    const SimdFloat4* src = reinterpret_cast<const SimdFloat4*>(&_m);
+    float* dest = reinterpret_cast<float*>(_dest);
+    for (size_t i = 0; i < 16; ++i) {
+      _mm_stream_ps(dest + i * 4, src[i]);
+    }
+    return;
+  }
+#endif  // OZZ_SIMD_SSEx
+  *_dest = _m;
+}
+
+// Makes non-temporal stores visible to other cores before outputs are
+// consumed (GPU upload kick, other threads...). No-op for regular stores.
+OZZ_INLINE void EndStoreBatch(bool _streaming) {
+#if defined(OZZ_SIMD_SSEx)
+  if (_streaming) {
+    _mm_sfence();
+  }
+#else   // OZZ_SIMD_SSEx
+  (void)_streaming;
+#endif  // OZZ_SIMD_SSEx
+}
+}  // namespace internal
+
+// Multiplies _a and _b blocks pairwise: _out[i] = _a[i] * _b[i]. _a and _b
+// sizes must match, _out must be at least as big. _out can alias the inputs,
+// unless _streaming is true, which requests non-temporal output stores.
+inline void Multiply(const span<const SoaFloat4x4>& _a,
+                     const span<const SoaFloat4x4>& _b,
+                     const span<SoaFloat4x4>& _out, bool _streaming = false) {
+  assert(_a.size() == _b.size() && _a.size() <= _out.size());
+  size_t i = 0;
+  for (; i + 2 <= _a.size(); i += 2) {
+    // 2 independent blocks per iteration, their loads and arithmetic
+    // pipeline. operator* is declared at global scope, hence the explicit
+    // qualification from within ozz::math.
+    const SoaFloat4x4 m0 = ::operator*(_a[i + 0], _b[i + 0]);
+    const SoaFloat4x4 m1 = ::operator*(_a[i + 1], _b[i + 1]);
+    internal::StoreBatch(m0, &_out[i + 0], _streaming);
+    internal::StoreBatch(m1, &_out[i + 1], _streaming);
+  }
+  if (i < _a.size()) {
+    internal::StoreBatch(::operator*(_a[i], _b[i]), &_out[i], _streaming);
+  }
+  internal::EndStoreBatch(_streaming);
+}
+
+// Inverts every block: _out[i] = Invert(_in[i]). Like the single block
+// Invert, matrices must be invertible, asserted in debug builds. _out can
+// alias _in, unless _streaming is true, which requests non-temporal output
+// stores.
+inline void Invert(const span<const SoaFloat4x4>& _in,
+                   const span<SoaFloat4x4>& _out, bool _streaming = false) {
+  assert(_in.size() <= _out.size());
+  size_t i = 0;
+  for (; i + 2 <= _in.size(); i += 2) {
+    const SoaFloat4x4 m0 = Invert(_in[i + 0]);
+    const SoaFloat4x4 m1 = Invert(_in[i + 1]);
+    internal::StoreBatch(m0, &_out[i + 0], _streaming);
+    internal::StoreBatch(m1, &_out[i + 1], _streaming);
+  }
+  if (i < _in.size()) {
+    internal::StoreBatch(Invert(_in[i]), &_out[i], _streaming);
+  }
+  internal::EndStoreBatch(_streaming);
+}
+
+// Builds affine matrices from every transform block: _out[i] =
+// FromAffine(_transforms[i]). _streaming requests non-temporal output
+// stores.
+inline void FromAffine(const span<const SoaTransform>& _transforms,
+                       const span<SoaFloat4x4>& _out, bool _streaming = false) {
+  assert(_transforms.size() <= _out.size());
+  size_t i = 0;
+  for (; i + 2 <= _transforms.size(); i += 2) {
+    const SoaTransform& t0 = _transforms[i + 0];
+    const SoaTransform& t1 = _transforms[i + 1];
+    const SoaFloat4x4 m0 =
+        SoaFloat4x4::FromAffine(t0.translation, t0.rotation, t0.scale);
+    const SoaFloat4x4 m1 =
+        SoaFloat4x4::FromAffine(t1.translation, t1.rotation, t1.scale);
+    internal::StoreBatch(m0, &_out[i + 0], _streaming);
+    internal::StoreBatch(m1, &_out[i + 1], _streaming);
+  }
+  if (i < _transforms.size()) {
+    const SoaTransform& transform = _transforms[i];
+    internal::StoreBatch(
+        SoaFloat4x4::FromAffine(transform.translation, transform.rotation,
+                                transform.scale),
+        &_out[i], _streaming);
+  }
+  internal::EndStoreBatch(_streaming);
+}
+}  // namespace math
+}  // namespace ozz
+#endif  // OZZ_OZZ_BASE_MATHS_SOA_FLOAT4X4_BATCH_H_
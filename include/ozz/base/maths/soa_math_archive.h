@@ -42,6 +42,7 @@ struct SoaTransform;
 }  // namespace math
 namespace io {
 OZZ_IO_TYPE_NOT_VERSIONABLE(math::SoaFloat2)
+OZZ_IO_TYPE_RAW(math::SoaFloat2)
 template <>
 struct OZZ_BASE_DLL Extern<math::SoaFloat2> {
   static void Save(OArchive& _archive, const math::SoaFloat2* _values,
@@ -51,6 +52,7 @@ struct OZZ_BASE_DLL Extern<math::SoaFloat2> {
 };
 
 OZZ_IO_TYPE_NOT_VERSIONABLE(math::SoaFloat3)
+OZZ_IO_TYPE_RAW(math::SoaFloat3)
 template <>
 struct OZZ_BASE_DLL Extern<math::SoaFloat3> {
   static void Save(OArchive& _archive, const math::SoaFloat3* _values,
@@ -60,6 +62,7 @@ struct OZZ_BASE_DLL Extern<math::SoaFloat3> {
 };
 
 OZZ_IO_TYPE_NOT_VERSIONABLE(math::SoaFloat4)
+OZZ_IO_TYPE_RAW(math::SoaFloat4)
 template <>
 struct OZZ_BASE_DLL Extern<math::SoaFloat4> {
   static void Save(OArchive& _archive, const math::SoaFloat4* _values,
@@ -69,6 +72,7 @@ struct OZZ_BASE_DLL Extern<math::SoaFloat4> {
 };
 
 OZZ_IO_TYPE_NOT_VERSIONABLE(math::SoaQuaternion)
+OZZ_IO_TYPE_RAW(math::SoaQuaternion)
 template <>
 struct OZZ_BASE_DLL Extern<math::SoaQuaternion> {
   static void Save(OArchive& _archive, const math::SoaQuaternion* _values,
@@ -78,6 +82,7 @@ struct OZZ_BASE_DLL Extern<math::SoaQuaternion> {
 };
 
 OZZ_IO_TYPE_NOT_VERSIONABLE(math::SoaFloat4x4)
+OZZ_IO_TYPE_RAW(math::SoaFloat4x4)
 template <>
 struct OZZ_BASE_DLL Extern<math::SoaFloat4x4> {
   static void Save(OArchive& _archive, const math::SoaFloat4x4* _values,
@@ -87,6 +92,7 @@ struct OZZ_BASE_DLL Extern<math::SoaFloat4x4> {
 };
 
 OZZ_IO_TYPE_NOT_VERSIONABLE(math::SoaTransform)
+OZZ_IO_TYPE_RAW(math::SoaTransform)
 template <>
 struct OZZ_BASE_DLL Extern<math::SoaTransform> {
   static void Save(OArchive& _archive, const math::SoaTransform* _values,
@@ -32,6 +32,7 @@
 
 #include "ozz/base/maths/soa_float.h"
 #include "ozz/base/platform.h"
+#include "ozz/base/span.h"
 
 namespace ozz {
 namespace math {
@@ -155,6 +156,148 @@ OZZ_INLINE SoaQuaternion NLerpEst(const SoaQuaternion& _a,
                            lerp.w * inv_len};
   return r;
 }
+
+// Normalizes a whole range of quaternions from _input to _output, which can
+// alias. Two blocks are processed per iteration so two independent
+// computation chains remain in flight during the square root latency.
+OZZ_INLINE void NormalizeN(const span<const SoaQuaternion>& _input,
+                           const span<SoaQuaternion>& _output) {
+  assert(_output.size() >= _input.size() && "Output is too small.");
+  const SimdFloat4 one = simd_float4::one();
+  const size_t count = _input.size();
+  size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    const SoaQuaternion q0 = _input[i + 0];
+    const SoaQuaternion q1 = _input[i + 1];
+    const SimdFloat4 len2_0 =
+        q0.x * q0.x + q0.y * q0.y + q0.z * q0.z + q0.w * q0.w;
+    const SimdFloat4 len2_1 =
+        q1.x * q1.x + q1.y * q1.y + q1.z * q1.z + q1.w * q1.w;
+    const SimdFloat4 inv_len0 = one / Sqrt(len2_0);
+    const SimdFloat4 inv_len1 = one / Sqrt(len2_1);
+    const SoaQuaternion r0 = {q0.x * inv_len0, q0.y * inv_len0,
+                              q0.z * inv_len0, q0.w * inv_len0};
+    const SoaQuaternion r1 = {q1.x * inv_len1, q1.y * inv_len1,
+                              q1.z * inv_len1, q1.w * inv_len1};
+    _output[i + 0] = r0;
+    _output[i + 1] = r1;
+  }
+  if (i != count) {
+    _output[i] = Normalize(_input[i]);
+  }
+}
+
+// Normalizes a whole range of quaternions from _input to _output, which can
+// alias, using the estimated reciprocal square root path. See NormalizeN for
+// scheduling details.
+OZZ_INLINE void NormalizeEstN(const span<const SoaQuaternion>& _input,
+                              const span<SoaQuaternion>& _output) {
+  assert(_output.size() >= _input.size() && "Output is too small.");
+  const size_t count = _input.size();
+  size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    const SoaQuaternion q0 = _input[i + 0];
+    const SoaQuaternion q1 = _input[i + 1];
+    const SimdFloat4 len2_0 =
+        q0.x * q0.x + q0.y * q0.y + q0.z * q0.z + q0.w * q0.w;
+    const SimdFloat4 len2_1 =
+        q1.x * q1.x + q1.y * q1.y + q1.z * q1.z + q1.w * q1.w;
+    // Uses RSqrtEstNR (with one more Newton-Raphson step) as quaternions
+    // loose much precision due to normalization.
+    const SimdFloat4 inv_len0 = RSqrtEstNR(len2_0);
+    const SimdFloat4 inv_len1 = RSqrtEstNR(len2_1);
+    const SoaQuaternion r0 = {q0.x * inv_len0, q0.y * inv_len0,
+                              q0.z * inv_len0, q0.w * inv_len0};
+    const SoaQuaternion r1 = {q1.x * inv_len1, q1.y * inv_len1,
+                              q1.z * inv_len1, q1.w * inv_len1};
+    _output[i + 0] = r0;
+    _output[i + 1] = r1;
+  }
+  if (i != count) {
+    _output[i] = NormalizeEst(_input[i]);
+  }
+}
+
+// Computes the normalized linear interpolation of quaternion ranges _a and _b
+// with coefficient _f, into _output which can alias _a or _b. See NormalizeN
+// for scheduling details.
+OZZ_INLINE void NLerpN(const span<const SoaQuaternion>& _a,
+                       const span<const SoaQuaternion>& _b, _SimdFloat4 _f,
+                       const span<SoaQuaternion>& _output) {
+  assert(_a.size() == _b.size() && "Input ranges must have the same size.");
+  assert(_output.size() >= _a.size() && "Output is too small.");
+  const SimdFloat4 one = simd_float4::one();
+  const size_t count = _a.size();
+  size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    const SoaQuaternion a0 = _a[i + 0];
+    const SoaQuaternion a1 = _a[i + 1];
+    const SoaQuaternion b0 = _b[i + 0];
+    const SoaQuaternion b1 = _b[i + 1];
+    const SoaFloat4 lerp0 = {
+        (b0.x - a0.x) * _f + a0.x, (b0.y - a0.y) * _f + a0.y,
+        (b0.z - a0.z) * _f + a0.z, (b0.w - a0.w) * _f + a0.w};
+    const SoaFloat4 lerp1 = {
+        (b1.x - a1.x) * _f + a1.x, (b1.y - a1.y) * _f + a1.y,
+        (b1.z - a1.z) * _f + a1.z, (b1.w - a1.w) * _f + a1.w};
+    const SimdFloat4 len2_0 = lerp0.x * lerp0.x + lerp0.y * lerp0.y +
+                              lerp0.z * lerp0.z + lerp0.w * lerp0.w;
+    const SimdFloat4 len2_1 = lerp1.x * lerp1.x + lerp1.y * lerp1.y +
+                              lerp1.z * lerp1.z + lerp1.w * lerp1.w;
+    const SimdFloat4 inv_len0 = one / Sqrt(len2_0);
+    const SimdFloat4 inv_len1 = one / Sqrt(len2_1);
+    const SoaQuaternion r0 = {lerp0.x * inv_len0, lerp0.y * inv_len0,
+                              lerp0.z * inv_len0, lerp0.w * inv_len0};
+    const SoaQuaternion r1 = {lerp1.x * inv_len1, lerp1.y * inv_len1,
+                              lerp1.z * inv_len1, lerp1.w * inv_len1};
+    _output[i + 0] = r0;
+    _output[i + 1] = r1;
+  }
+  if (i != count) {
+    _output[i] = NLerp(_a[i], _b[i], _f);
+  }
+}
+
+// Computes the estimated normalized linear interpolation of quaternion ranges
+// _a and _b with coefficient _f, into _output which can alias _a or _b. See
+// NormalizeN for scheduling details.
+OZZ_INLINE void NLerpEstN(const span<const SoaQuaternion>& _a,
+                          const span<const SoaQuaternion>& _b, _SimdFloat4 _f,
+                          const span<SoaQuaternion>& _output) {
+  assert(_a.size() == _b.size() && "Input ranges must have the same size.");
+  assert(_output.size() >= _a.size() && "Output is too small.");
+  const size_t count = _a.size();
+  size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    const SoaQuaternion a0 = _a[i + 0];
+    const SoaQuaternion a1 = _a[i + 1];
+    const SoaQuaternion b0 = _b[i + 0];
+    const SoaQuaternion b1 = _b[i + 1];
+    const SoaFloat4 lerp0 = {
+        (b0.x - a0.x) * _f + a0.x, (b0.y - a0.y) * _f + a0.y,
+        (b0.z - a0.z) * _f + a0.z, (b0.w - a0.w) * _f + a0.w};
+    const SoaFloat4 lerp1 = {
+        (b1.x - a1.x) * _f + a1.x, (b1.y - a1.y) * _f + a1.y,
+        (b1.z - a1.z) * _f + a1.z, (b1.w - a1.w) * _f + a1.w};
+    const SimdFloat4 len2_0 = lerp0.x * lerp0.x + lerp0.y * lerp0.y +
+                              lerp0.z * lerp0.z + lerp0.w * lerp0.w;
+    const SimdFloat4 len2_1 = lerp1.x * lerp1.x + lerp1.y * lerp1.y +
+                              lerp1.z * lerp1.z + lerp1.w * lerp1.w;
+    // Uses RSqrtEstNR (with one more Newton-Raphson step) as quaternions
+    // loose much precision due to normalization.
+    const SimdFloat4 inv_len0 = RSqrtEstNR(len2_0);
+    const SimdFloat4 inv_len1 = RSqrtEstNR(len2_1);
+    const SoaQuaternion r0 = {lerp0.x * inv_len0, lerp0.y * inv_len0,
+                              lerp0.z * inv_len0, lerp0.w * inv_len0};
+    const SoaQuaternion r1 = {lerp1.x * inv_len1, lerp1.y * inv_len1,
+                              lerp1.z * inv_len1, lerp1.w * inv_len1};
+    _output[i + 0] = r0;
+    _output[i + 1] = r1;
+  }
+  if (i != count) {
+    _output[i] = NLerpEst(_a[i], _b[i], _f);
+  }
+}
 }  // namespace math
 }  // namespace ozz
 
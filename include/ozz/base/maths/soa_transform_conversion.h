@@ -0,0 +1,165 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_BASE_MATHS_SOA_TRANSFORM_CONVERSION_H_
+#define OZZ_OZZ_BASE_MATHS_SOA_TRANSFORM_CONVERSION_H_
+
+#include <cassert>
+
+#include "ozz/base/maths/simd_math.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/maths/transform.h"
+#include "ozz/base/platform.h"
+#include "ozz/base/span.h"
+
+// Provides conversion utilities between the AoS Transform type and the SoA
+// pose layout (4 transforms per SoaTransform block) consumed by animation
+// jobs. Converting happens constantly at engine boundaries (physics hand-off,
+// gameplay reading or poking a joint), where scalar per-element inserts
+// dominate: these converters transpose whole soa blocks with simd registers
+// instead.
+
+namespace ozz {
+namespace math {
+
+// Gathers the transform stored in the _lane lane of soa _block. _lane is the
+// index within the block (aka joint index % 4, where the block is joint
+// index / 4) and must be in range [0,3].
+OZZ_INLINE Transform GatherTransform(const SoaTransform& _block, int _lane) {
+  assert(_lane >= 0 && _lane < 4 && "Lane index out of range");
+
+  // Transposes SoA data back to AoS.
+  SimdFloat4 translations[4];
+  Transpose3x4(&_block.translation.x, translations);
+  SimdFloat4 rotations[4];
+  Transpose4x4(&_block.rotation.x, rotations);
+  SimdFloat4 scales[4];
+  Transpose3x4(&_block.scale.x, scales);
+
+  Transform transform;
+  Store3PtrU(translations[_lane], &transform.translation.x);
+  StorePtrU(rotations[_lane], &transform.rotation.x);
+  Store3PtrU(scales[_lane], &transform.scale.x);
+  return transform;
+}
+
+// Scatters _transform to the _lane lane of soa _block, preserving the other
+// lanes. _lane must be in range [0,3].
+OZZ_INLINE void ScatterTransform(const Transform& _transform, int _lane,
+                                 SoaTransform* _block) {
+  assert(_lane >= 0 && _lane < 4 && "Lane index out of range");
+  assert(_block != nullptr);
+
+  const SimdFloat4 translation =
+      simd_float4::Load3PtrU(&_transform.translation.x);
+  _block->translation.x = SetI(_block->translation.x, SplatX(translation), _lane);
+  _block->translation.y = SetI(_block->translation.y, SplatY(translation), _lane);
+  _block->translation.z = SetI(_block->translation.z, SplatZ(translation), _lane);
+
+  const SimdFloat4 rotation = simd_float4::LoadPtrU(&_transform.rotation.x);
+  _block->rotation.x = SetI(_block->rotation.x, SplatX(rotation), _lane);
+  _block->rotation.y = SetI(_block->rotation.y, SplatY(rotation), _lane);
+  _block->rotation.z = SetI(_block->rotation.z, SplatZ(rotation), _lane);
+  _block->rotation.w = SetI(_block->rotation.w, SplatW(rotation), _lane);
+
+  const SimdFloat4 scale = simd_float4::Load3PtrU(&_transform.scale.x);
+  _block->scale.x = SetI(_block->scale.x, SplatX(scale), _lane);
+  _block->scale.y = SetI(_block->scale.y, SplatY(scale), _lane);
+  _block->scale.z = SetI(_block->scale.z, SplatZ(scale), _lane);
+}
+
+// Packs a span of AoS transforms to soa blocks. _output must store at least
+// (_input.size() + 3) / 4 blocks. Remaining lanes of an incomplete last
+// block are set to identity, keeping the whole block valid for animation
+// jobs (normalized quaternions, unit scales).
+OZZ_INLINE void PackSoaTransforms(const span<const Transform>& _input,
+                                  const span<SoaTransform>& _output) {
+  const size_t num_blocks = (_input.size() + 3) / 4;
+  assert(_output.size() >= num_blocks && "Output is too small");
+
+  const Transform identity = Transform::identity();
+  for (size_t i = 0; i < num_blocks; ++i) {
+    // Pads an incomplete last block with identity lanes.
+    const Transform* in = _input.data() + i * 4;
+    const size_t remaining = _input.size() - i * 4;
+    const Transform* t1 = remaining > 1 ? in + 1 : &identity;
+    const Transform* t2 = remaining > 2 ? in + 2 : &identity;
+    const Transform* t3 = remaining > 3 ? in + 3 : &identity;
+
+    const SimdFloat4 translations[4] = {
+        simd_float4::Load3PtrU(&in->translation.x),
+        simd_float4::Load3PtrU(&t1->translation.x),
+        simd_float4::Load3PtrU(&t2->translation.x),
+        simd_float4::Load3PtrU(&t3->translation.x)};
+    Transpose4x3(translations, &_output[i].translation.x);
+
+    const SimdFloat4 rotations[4] = {simd_float4::LoadPtrU(&in->rotation.x),
+                                     simd_float4::LoadPtrU(&t1->rotation.x),
+                                     simd_float4::LoadPtrU(&t2->rotation.x),
+                                     simd_float4::LoadPtrU(&t3->rotation.x)};
+    Transpose4x4(rotations, &_output[i].rotation.x);
+
+    const SimdFloat4 scales[4] = {simd_float4::Load3PtrU(&in->scale.x),
+                                  simd_float4::Load3PtrU(&t1->scale.x),
+                                  simd_float4::Load3PtrU(&t2->scale.x),
+                                  simd_float4::Load3PtrU(&t3->scale.x)};
+    Transpose4x3(scales, &_output[i].scale.x);
+  }
+}
+
+// Unpacks soa blocks to a span of AoS transforms, mirroring
+// PackSoaTransforms. _output.size() transforms are written, reading
+// (_output.size() + 3) / 4 blocks from _input: lanes beyond _output size
+// (the padding lanes of an incomplete last block) are ignored.
+OZZ_INLINE void UnpackSoaTransforms(const span<const SoaTransform>& _input,
+                                    const span<Transform>& _output) {
+  assert(_input.size() >= (_output.size() + 3) / 4 && "Input is too small");
+
+  for (size_t i = 0; i < _output.size(); i += 4) {
+    const SoaTransform& block = _input[i / 4];
+
+    // Transposes SoA data back to AoS.
+    SimdFloat4 translations[4];
+    Transpose3x4(&block.translation.x, translations);
+    SimdFloat4 rotations[4];
+    Transpose4x4(&block.rotation.x, rotations);
+    SimdFloat4 scales[4];
+    Transpose3x4(&block.scale.x, scales);
+
+    const size_t remaining = _output.size() - i;
+    const size_t end = remaining < 4 ? remaining : 4;
+    for (size_t j = 0; j < end; ++j) {
+      Transform& transform = _output[i + j];
+      Store3PtrU(translations[j], &transform.translation.x);
+      StorePtrU(rotations[j], &transform.rotation.x);
+      Store3PtrU(scales[j], &transform.scale.x);
+    }
+  }
+}
+}  // namespace math
+}  // namespace ozz
+#endif  // OZZ_OZZ_BASE_MATHS_SOA_TRANSFORM_CONVERSION_H_
@@ -47,6 +47,65 @@ OZZ_BASE_DLL Allocator* default_allocator();
 // Returns current memory allocator, such that in can be restored if needed.
 OZZ_BASE_DLL Allocator* SetDefaulAllocator(Allocator* _allocator);
 
+// Subsystem tags used to attribute tracked allocations, so allocation storms
+// and memory budgets can be blamed on a subsystem rather than on a mangled
+// callstack from an external heap profiler.
+struct AllocationTag {
+  enum Value {
+    kDefault,          // Untagged allocations (containers, user code...).
+    kAnimation,        // Runtime animation and track data.
+    kSkeleton,         // Runtime skeleton data.
+    kSamplingContext,  // Sampling job contexts.
+    kBuilder,          // Offline builders scratch memory.
+    kCount
+  };
+};
+
+// Snapshot of a tag's allocation statistics, as returned by
+// GetAllocationStats.
+struct AllocationStats {
+  // Bytes currently allocated.
+  size_t live_bytes;
+
+  // Highest live_bytes value reached since tracking was enabled.
+  size_t peak_bytes;
+
+  // Number of blocks currently allocated.
+  size_t live_count;
+
+  // Number of allocations performed since tracking was enabled.
+  size_t total_count;
+};
+
+// Enables or disables allocation tracking, returning the previous state.
+// Tracking is disabled by default. Enabling it resets all statistics.
+// Tracking instruments the default heap allocator: a custom allocator
+// installed with SetDefaulAllocator bypasses it. The per-allocation cost is a
+// few relaxed atomic updates, cheap enough for production builds.
+OZZ_BASE_DLL bool SetAllocationTracking(bool _enabled);
+
+// Returns allocation statistics for _tag. Thread-safe, though statistics are
+// sampled independently of running allocations.
+OZZ_BASE_DLL AllocationStats GetAllocationStats(AllocationTag::Value _tag);
+
+// Scoped allocation tag: allocations performed by the current thread while
+// the scope is alive are attributed to _tag. Scopes nest, restoring the
+// previous tag on destruction. ozz runtime classes tag their own persistent
+// allocations (animations, skeletons, sampling contexts...), remaining ones
+// fall into the enclosing scope, or kDefault.
+class OZZ_BASE_DLL AllocationScope {
+ public:
+  explicit AllocationScope(AllocationTag::Value _tag);
+  ~AllocationScope();
+
+ private:
+  AllocationScope(const AllocationScope&) = delete;
+  void operator=(const AllocationScope&) = delete;
+
+  // Tag to restore at end of scope.
+  AllocationTag::Value previous_;
+};
+
 // Defines an abstract allocator class.
 // Implements helper methods to allocate/deallocate POD typed objects instead of
 // raw memory.
@@ -68,6 +127,22 @@ class OZZ_BASE_DLL Allocator {
   // Argument _block can be nullptr.
   // Deallocate function conforms with standard free function specifications.
   virtual void Deallocate(void* _block) = 0;
+
+  // Node hint meaning no placement preference, see AllocateOnNode.
+  enum { kAnyNode = -1 };
+
+  // Allocates _size bytes on the specified _alignment boundaries, with a hint
+  // to place the block on NUMA node _node. The default implementation ignores
+  // the hint and forwards to Allocate, which on most operating systems ends up
+  // on the first-touching thread's node anyway (first-touch policy). NUMA
+  // aware applications override this with node-targeted primitives
+  // (numa_alloc_onnode, VirtualAllocExNuma...) so read-only assets duplicated
+  // per node (see animation Registry::Duplicate) are actually resident where
+  // their readers run. Blocks are freed with Deallocate, whatever the node.
+  virtual void* AllocateOnNode(size_t _size, size_t _alignment, int _node) {
+    (void)_node;
+    return Allocate(_size, _alignment);
+  }
 };
 }  // namespace memory
 
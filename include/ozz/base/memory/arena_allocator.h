@@ -0,0 +1,155 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_BASE_MEMORY_ARENA_ALLOCATOR_H_
+#define OZZ_OZZ_BASE_MEMORY_ARENA_ALLOCATOR_H_
+
+#include "ozz/base/memory/allocator.h"
+#include "ozz/base/platform.h"
+
+namespace ozz {
+namespace memory {
+
+// Implements a monotonic (aka arena, aka linear) allocator. Allocations are
+// served by bumping a cursor inside large chunks obtained from a backing
+// allocator, so each allocation is O(1) and allocation count on the backing
+// allocator stays proportional to total size, not to allocation count.
+// Deallocate is a no-op: all memory is released at once by Reset or at
+// destruction time, in O(number of chunks).
+// This is suited to graph-of-containers workloads like offline raw types
+// (RawAnimation holds three vectors per joint track), where thousands of
+// short-lived container allocations share a single lifetime. As ozz
+// containers route their allocations through default_allocator(), a whole
+// raw clip can be bound to an arena by installing it as the default
+// allocator for the scope that builds the clip:
+//   ozz::memory::ArenaAllocator arena;
+//   ozz::memory::Allocator* previous =
+//       ozz::memory::SetDefaulAllocator(&arena);
+//   {  // Raw types allocated in this scope must not outlive the arena.
+//     ozz::animation::offline::RawAnimation raw;
+//     ...  // Import and consume the raw clip.
+//   }
+//   ozz::memory::SetDefaulAllocator(previous);
+// The same pattern turns the arena into a per-frame scratch allocator for
+// runtime transient allocations (IK temporaries, blend accumulators...),
+// using a Scope to rewind the whole frame at once:
+//   {  // Allocations done within the scope don't outlive it.
+//     ozz::memory::ArenaAllocator::Scope frame(arena);
+//     ...  // Animation phase.
+//   }  // Frame memory is rewound at once, ready for the next frame.
+// The arena is not thread-safe.
+class OZZ_BASE_DLL ArenaAllocator : public Allocator {
+ private:
+  // Chunks are chained through an intrusive header, defined internally, so
+  // the arena doesn't allocate any bookkeeping on its own.
+  struct Chunk;
+
+ public:
+  // Default size of the chunks requested from the backing allocator.
+  static const size_t kDefaultChunkSize = 1 << 20;
+
+  // Scoped rewind point. Construction captures the arena cursor, destruction
+  // rewinds it: every allocation performed while the scope is alive is
+  // released at once. Scopes must be destroyed in reverse construction order
+  // (LIFO), which the natural C++ scoping enforces. Rewinding is O(1) when
+  // the scope fits in the current chunk, which is the expected steady state
+  // of an arena sized for its workload. Chunks opened within the scope are
+  // returned to the backing allocator.
+  class OZZ_BASE_DLL Scope {
+   public:
+    explicit Scope(ArenaAllocator& _arena);
+    ~Scope();
+
+   private:
+    Scope(const Scope&) = delete;
+    void operator=(const Scope&) = delete;
+
+    // Arena to rewind at end of scope.
+    ArenaAllocator& arena_;
+
+    // Captured arena state, see ArenaAllocator::Rewind.
+    Chunk* chunk_;
+    Chunk* next_;
+    byte* cursor_;
+    byte* end_;
+  };
+
+  // Constructs an arena growing by chunks of _chunk_size bytes, allocated
+  // from _backing, or from default_allocator() if _backing is nullptr. No
+  // memory is allocated until the first Allocate call.
+  explicit ArenaAllocator(size_t _chunk_size = kDefaultChunkSize,
+                          Allocator* _backing = nullptr);
+
+  // Releases all chunks back to the backing allocator.
+  virtual ~ArenaAllocator();
+
+  // See Allocator::Allocate for details. Allocations bigger than the chunk
+  // payload get a dedicated chunk.
+  virtual void* Allocate(size_t _size, size_t _alignment);
+
+  // No-op, memory is only released as a whole by Reset or destruction.
+  virtual void Deallocate(void* _block);
+
+  // Releases all chunks back to the backing allocator at once. Every pointer
+  // obtained from this arena is invalidated.
+  void Reset();
+
+  // Total number of bytes currently reserved from the backing allocator.
+  size_t reserved() const { return reserved_; }
+
+ private:
+  ArenaAllocator(const ArenaAllocator&) = delete;
+  ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+
+  // Allocates a chunk of _capacity payload bytes from the backing allocator.
+  Chunk* NewChunk(size_t _capacity);
+
+  // Rewinds the arena to a state captured by a Scope: restores the bump
+  // cursor and releases the chunks opened since the capture. _chunk is the
+  // chunk that was current at capture time (nullptr if the arena was empty),
+  // _next its successor, used to spot oversized chunks linked behind it.
+  void Rewind(Chunk* _chunk, Chunk* _next, byte* _cursor, byte* _end);
+
+  // Allocator chunks are obtained from.
+  Allocator* backing_;
+
+  // Size of the chunks requested from the backing allocator.
+  size_t chunk_size_;
+
+  // Head of the chunk list, most recent first.
+  Chunk* chunks_ = nullptr;
+
+  // Bump cursor and end of the current chunk payload.
+  byte* cursor_ = nullptr;
+  byte* end_ = nullptr;
+
+  // Bytes reserved from the backing allocator, headers included.
+  size_t reserved_ = 0;
+};
+}  // namespace memory
+}  // namespace ozz
+#endif  // OZZ_OZZ_BASE_MEMORY_ARENA_ALLOCATOR_H_
@@ -0,0 +1,117 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_BASE_MEMORY_POSE_BUFFER_POOL_H_
+#define OZZ_OZZ_BASE_MEMORY_POSE_BUFFER_POOL_H_
+
+#include <type_traits>
+
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/platform.h"
+#include "ozz/base/span.h"
+
+namespace ozz {
+namespace memory {
+
+// Recycles cache-line aligned buffers, typically animation pose buffers
+// (local-space SoaTransform, model-space Float4x4, skinning matrices...)
+// whose sizes repeat across instances of the same few skeletons. Buffers are
+// bucketed by size (power of two buckets), acquired and released in O(1) from
+// per-bucket free lists. Released buffers are not returned to the allocator
+// but kept for reuse, in LIFO order so the most recently touched memory is
+// handed out first. This takes per-instance buffer allocations out of the
+// global heap during spawn/despawn storms.
+// Underlying memory comes from ozz::memory::default_allocator(), so pool
+// grows are visible to a tracking allocator installed with
+// SetDefaulAllocator. The pool is not thread-safe.
+class OZZ_BASE_DLL PoseBufferPool {
+ public:
+  // All buffers are aligned on cache line boundaries, which also satisfies
+  // SoA math simd alignment requirements.
+  static const size_t kAlignment = 64;
+
+  PoseBufferPool() {}
+
+  // Frees all recycled buffers. Every acquired buffer must have been released
+  // back before destruction.
+  ~PoseBufferPool();
+
+  // Acquires a buffer of _size bytes, aligned on kAlignment boundaries.
+  // Reuses a recycled buffer of the matching bucket when available, otherwise
+  // allocates a new one. Returns an empty span if _size is 0.
+  span<byte> Acquire(size_t _size);
+
+  // Typed variant, acquires a buffer of _count _Ty elements. The returned
+  // span carries the pool's alignment guarantee in its type.
+  template <typename _Ty>
+  aligned_span<_Ty, kAlignment> Acquire(size_t _count) {
+    static_assert(alignof(_Ty) <= kAlignment,
+                  "Element alignment exceeds pool alignment.");
+    const span<byte> buffer = Acquire(_count * sizeof(_Ty));
+    return {reinterpret_cast<_Ty*>(buffer.data()), _count};
+  }
+
+  // Releases a buffer acquired from this pool, making it available for reuse.
+  // The buffer memory isn't freed, use Trim to return it to the allocator.
+  // Releasing an empty span is a no-op.
+  void Release(const span<byte>& _buffer);
+
+  // Typed variant, releases a buffer obtained from the typed Acquire.
+  template <typename _Ty>
+  void Release(const span<_Ty>& _buffer) {
+    Release(span<byte>(reinterpret_cast<byte*>(
+                           const_cast<typename std::remove_const<_Ty>::type*>(
+                               _buffer.data())),
+                       _buffer.size_bytes()));
+  }
+
+  // Frees all recycled buffers back to the allocator. Acquired buffers are
+  // not affected.
+  void Trim();
+
+  // Number of buffers currently recycled, waiting for reuse.
+  size_t num_recycled() const;
+
+ private:
+  PoseBufferPool(const PoseBufferPool&) = delete;
+  PoseBufferPool& operator=(const PoseBufferPool&) = delete;
+
+  // Sizes are bucketed to powers of two, from kAlignment (bucket 0) up to
+  // kAlignment << (kNumBuckets - 1) (32MB). Bigger buffers aren't pooled:
+  // they are allocated and freed straight from the allocator.
+  static const size_t kNumBuckets = 20;
+
+  // Per-bucket LIFO free lists of recycled buffers.
+  vector<byte*> free_lists_[kNumBuckets];
+
+  // Number of acquired buffers not yet released, to assert correct usage at
+  // destruction time.
+  OZZ_IF_DEBUG(size_t num_acquired_ = 0;)
+};
+}  // namespace memory
+}  // namespace ozz
+#endif  // OZZ_OZZ_BASE_MEMORY_POSE_BUFFER_POOL_H_
@@ -73,6 +73,30 @@ typedef uint8_t byte;
 // Syntax is: void function(int* OZZ_RESTRICT _p);"
 #define OZZ_RESTRICT __restrict
 
+// Hints the processor to prefetch the cache line containing _address, ahead
+// of its actual use. This is a best effort hint: it expands to nothing on
+// compilers with no prefetch support, and prefetching an invalid address is
+// allowed (no memory access is performed).
+// Syntax is: "OZZ_PREFETCH(_array + _ahead_index);"
+#if defined(__GNUC__) || defined(__clang__)
+#define OZZ_PREFETCH(_address) __builtin_prefetch(_address)
+#else
+#define OZZ_PREFETCH(_address) static_cast<void>(_address)
+#endif
+
+// Tells the optimizer it can assume _address is aligned on _alignment bytes,
+// allowing aligned (potentially wider) load and store instruction selection.
+// Evaluates to _address as a void pointer. Behavior is undefined if the
+// address doesn't satisfy the alignment, which debug builds shall assert.
+// Syntax is: "float* af = static_cast<float*>(OZZ_ASSUME_ALIGNED(f, 16));"
+#if defined(__GNUC__) || defined(__clang__)
+#define OZZ_ASSUME_ALIGNED(_address, _alignment) \
+  __builtin_assume_aligned(_address, _alignment)
+#else
+#define OZZ_ASSUME_ALIGNED(_address, _alignment) \
+  const_cast<void*>(static_cast<const void*>(_address))
+#endif
+
 // Defines macro to help with DEBUG/NDEBUG syntax.
 #if defined(NDEBUG)
 #define OZZ_IF_DEBUG(...)
@@ -0,0 +1,98 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_BASE_PROFILE_H_
+#define OZZ_OZZ_BASE_PROFILE_H_
+
+// Lightweight profiling hooks, instrumenting job Run() boundaries so
+// animation CPU cost can be attributed per stage without wrapping every call
+// site. Instrumentation is compiled in when OZZ_PROFILE is defined (see
+// ozz_profile build option), and emits begin/end events, with job name and
+// processed element count, to a user registered sink. The sink is meant to
+// forward events to an external profiler (Tracy, Perfetto, in-house
+// telemetry...), which pairs begin/end events into zones. Element counts
+// allow per-joint/per-vertex cost trends to be derived from zone durations.
+// When OZZ_PROFILE is not defined, the instrumentation macro expands to
+// nothing, hence has strictly no overhead.
+
+#include "ozz/base/export.h"
+
+namespace ozz {
+
+// Profile event sink function. _begin is true when a zone opens, false when
+// it closes. _name is a static string identifying the instrumented job, valid
+// for the whole program lifetime, so it can be stored without copy. _count is
+// the number of elements (tracks, joints, vertices...) the zone processes,
+// only meaningful on begin events (0 on end events). Events can be emitted
+// from any thread running jobs, the sink must support it. _context is the
+// context registered along with the function.
+typedef void (*ProfileFn)(void* _context, const char* _name, int _count,
+                          bool _begin);
+
+// Registers the profile event sink, replacing the previous one. A nullptr
+// _fn disables event emission, which is the default. Registration isn't
+// synchronized with emission: the sink must be registered before jobs are
+// dispatched, especially from multiple threads.
+OZZ_BASE_DLL void SetProfileHandler(ProfileFn _fn, void* _context);
+
+namespace internal {
+
+// Forwards a begin/end event to the registered sink, if any. These are the
+// ProfileScope implementation, always compiled into ozz_base so user code
+// can enable OZZ_PROFILE without rebuilding the library.
+OZZ_BASE_DLL void BeginProfile(const char* _name, int _count);
+OZZ_BASE_DLL void EndProfile(const char* _name);
+
+// Scoped profile zone, emitting the begin event on construction and the end
+// event on destruction.
+class ProfileScope {
+ public:
+  ProfileScope(const char* _name, int _count) : name_(_name) {
+    BeginProfile(_name, _count);
+  }
+  ~ProfileScope() { EndProfile(name_); }
+
+ private:
+  ProfileScope(const ProfileScope&) = delete;
+  void operator=(const ProfileScope&) = delete;
+
+  const char* name_;
+};
+}  // namespace internal
+}  // namespace ozz
+
+// Opens a profile zone, closed at the end of the enclosing scope. _name must
+// be a static string literal. Expands to nothing when OZZ_PROFILE is not
+// defined.
+#ifdef OZZ_PROFILE
+#define OZZ_PROFILE_JOB(_name, _count) \
+  const ozz::internal::ProfileScope ozz_profile_scope(_name, _count)
+#else  // OZZ_PROFILE
+#define OZZ_PROFILE_JOB(_name, _count) static_cast<void>(0)
+#endif  // OZZ_PROFILE
+
+#endif  // OZZ_OZZ_BASE_PROFILE_H_
@@ -0,0 +1,158 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_BASE_SCHEDULER_H_
+#define OZZ_OZZ_BASE_SCHEDULER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "ozz/base/containers/deque.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/export.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+namespace ozz {
+
+// Interface of a task scheduler, as expected by ozz parallel utilities. Its
+// single primitive is a blocking parallel-for over an integer range, which
+// maps naturally to batches of animation jobs (instances, joints, vertices).
+// Implementing this interface on top of the application's own task system
+// (TBB, enkiTS, a custom engine scheduler...) is the expected way to
+// integrate ozz parallel execution with an existing job graph. Ozz provides
+// two implementations: SerialScheduler and ThreadPoolScheduler.
+class OZZ_BASE_DLL Scheduler {
+ public:
+  virtual ~Scheduler();
+
+  // Function processing the subrange [_begin, _end[ of a parallel-for.
+  // _context is the untyped user argument given to ParallelFor.
+  typedef void (*RangeFn)(void* _context, int _begin, int _end);
+
+  // Splits range [_begin, _end[ into subranges of at least _granularity
+  // elements (the last one can be smaller) and invokes _fn for each of them,
+  // possibly concurrently. Returns once the whole range has been processed.
+  // _granularity is the smallest range worth dispatching, used to amortize
+  // scheduling overhead for cheap per-element work.
+  virtual void ParallelFor(int _begin, int _end, int _granularity, RangeFn _fn,
+                           void* _context) = 0;
+
+  // Typed helper, forwarding to ParallelFor with _fct as context. _fct is any
+  // callable of signature void(int _begin, int _end). It must remain valid
+  // until the call returns, which is guaranteed for temporary lambdas as
+  // ParallelFor blocks.
+  template <typename _Fct>
+  void ParallelForFct(int _begin, int _end, int _granularity,
+                      const _Fct& _fct) {
+    ParallelFor(_begin, _end, _granularity, &Invoke<_Fct>,
+                const_cast<void*>(static_cast<const void*>(&_fct)));
+  }
+
+ private:
+  // Type erased invocation of a _Fct callable.
+  template <typename _Fct>
+  static void Invoke(void* _context, int _begin, int _end) {
+    (*static_cast<const _Fct*>(_context))(_begin, _end);
+  }
+};
+
+// Serial implementation, processing the whole range on the calling thread.
+// Useful as a drop-in replacement to compare performances, or run
+// deterministic single threaded updates.
+class OZZ_BASE_DLL SerialScheduler : public Scheduler {
+ public:
+  void ParallelFor(int _begin, int _end, int _granularity, RangeFn _fn,
+                   void* _context) override;
+};
+
+// Work-stealing thread pool implementation. Workers are persistent threads
+// (no per-call thread creation), each owning a deque of range tasks: a worker
+// pops tasks from the front of its own deque, and steals from the back of
+// other workers' when its own is empty. The calling thread participates too,
+// so ParallelFor never blocks idle. ParallelFor can be called from multiple
+// threads concurrently, and from within a task (nested parallelism), at the
+// cost of the nested call potentially executing unrelated pending tasks.
+class OZZ_BASE_DLL ThreadPoolScheduler : public Scheduler {
+ public:
+  // Starts worker threads. _num_workers is the number of pool threads, in
+  // addition to the calling thread which always participates. The default 0
+  // uses the number of concurrent threads supported by the hardware, minus
+  // one for the calling thread.
+  explicit ThreadPoolScheduler(int _num_workers = 0);
+
+  // Waits for running tasks and stops all workers. Tasks submitted by a
+  // ParallelFor call are always completed before it returns, hence none can
+  // be pending at destruction time.
+  ~ThreadPoolScheduler() override;
+
+  void ParallelFor(int _begin, int _end, int _granularity, RangeFn _fn,
+                   void* _context) override;
+
+  // Number of pool worker threads, not including calling threads.
+  int num_workers() const { return static_cast<int>(workers_.size()); }
+
+ private:
+  ThreadPoolScheduler(const ThreadPoolScheduler&) = delete;
+  ThreadPoolScheduler& operator=(const ThreadPoolScheduler&) = delete;
+
+  // A subrange of a ParallelFor call, the work stealing unit.
+  struct Task {
+    int begin;
+    int end;
+    RangeFn fn;
+    void* context;
+    std::atomic<int>* remaining;  // Unprocessed task count of the call.
+  };
+
+  // Per worker thread state.
+  struct Worker;
+
+  // Worker thread entry point.
+  void WorkerLoop(int _index);
+
+  // Pops a task from the front of worker _index deque, or steals one from the
+  // back of any other deque. _index is -1 for threads that don't own a deque
+  // (ParallelFor callers), which can only steal. Returns false if no task is
+  // available.
+  bool PopOrSteal(int _index, Task* _task);
+
+  // Pool threads and their deques.
+  ozz::vector<ozz::unique_ptr<Worker>> workers_;
+
+  // Number of tasks in all deques, used to put idle workers to sleep.
+  // Modified under mutex_ when transitioning from 0.
+  std::atomic<int> num_pending_;
+
+  // Guards workers sleep/wake-up and shutdown.
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool quit_ = false;
+};
+}  // namespace ozz
+#endif  // OZZ_OZZ_BASE_SCHEDULER_H_
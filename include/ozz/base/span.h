@@ -137,6 +137,87 @@ struct span {
   size_t size_;
 };
 
+// Defines a span whose data address is guaranteed to be aligned on _Alignment
+// bytes. The guarantee is established at construction, asserted in debug
+// builds, then carried by the type: accessors funnel the data pointer through
+// OZZ_ASSUME_ALIGNED so kernels taking an aligned_span can issue aligned
+// (potentially wider) simd loads without runtime checks. An aligned_span
+// converts freely to a span, so it is accepted anywhere a span is, job inputs
+// included.
+template <typename _Ty, size_t _Alignment>
+struct aligned_span : public span<_Ty> {
+  static_assert((_Alignment & (_Alignment - 1)) == 0,
+                "Alignment must be a power of two.");
+  static_assert(_Alignment >= alignof(_Ty),
+                "Alignment must be at least element natural alignment.");
+
+  // Alignment guarantee, in bytes, carried by this span type.
+  static const size_t alignment = _Alignment;
+
+  // Default constructor initializes range to empty.
+  aligned_span() {}
+
+  // Constructs a range from its extreme values.
+  aligned_span(_Ty* _begin, _Ty* _end) : span<_Ty>(_begin, _end) {
+    assert(IsAligned(_begin, _Alignment) && "Invalid alignment.");
+  }
+
+  // Construct a range from a pointer to a buffer and its size, ie its number
+  // of elements.
+  aligned_span(_Ty* _begin, size_t _size) : span<_Ty>(_begin, _size) {
+    assert(IsAligned(_begin, _Alignment) && "Invalid alignment.");
+  }
+
+  // Converting constructor retaining or relaxing the guarantee: from a span
+  // of mutable elements and/or a span with a greater alignment.
+  template <typename _OTy, size_t _OAlignment>
+  aligned_span(const aligned_span<_OTy, _OAlignment>& _other)
+      : span<_Ty>(_other.data(), _other.size()) {
+    static_assert(_OAlignment % _Alignment == 0,
+                  "Cannot increase span alignment guarantee.");
+  }
+
+  // Returns the data pointer, carrying the alignment guarantee to the
+  // optimizer.
+  _Ty* data() const {
+    return static_cast<_Ty*>(
+        OZZ_ASSUME_ALIGNED(span<_Ty>::data(), _Alignment));
+  }
+
+  // Iterator support, aligned variants.
+  _Ty* begin() const { return data(); }
+  _Ty* end() const { return data() + span<_Ty>::size(); }
+
+  // First elements keep the data pointer, hence the guarantee. Other subspan
+  // variants inherit from span and return unaligned spans.
+  aligned_span first(size_t _count) const {
+    assert(_count <= span<_Ty>::size() && "Count out of range");
+    return {data(), _count};
+  }
+};
+
+// Promotes a span to an aligned_span, for callers who know the spanned buffer
+// satisfies _Alignment. The guarantee is asserted in debug builds.
+template <size_t _Alignment, typename _Ty>
+inline aligned_span<_Ty, _Alignment> assume_aligned(const span<_Ty>& _span) {
+  return {_span.data(), _span.size()};
+}
+
+// Returns the begin of the array of elements referenced by a span, or nullptr
+// if span's empty. Complies with container array_begin helpers.
+template <typename _Ty>
+inline _Ty* array_begin(const span<_Ty>& _span) {
+  return _span.begin();
+}
+
+// Returns the end of the array of elements referenced by a span, or nullptr
+// if span's empty. Array end is one element past the last element of the
+// array, it cannot be dereferenced. Complies with container array_end helpers.
+template <typename _Ty>
+inline _Ty* array_end(const span<_Ty>& _span) {
+  return _span.end();
+}
+
 // Returns a span from an array.
 template <typename _Ty, size_t _Size>
 inline span<_Ty> make_span(_Ty (&_arr)[_Size]) {
@@ -0,0 +1,91 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_GEOMETRY_OFFLINE_SKINNING_PARTITION_H_
+#define OZZ_OZZ_GEOMETRY_OFFLINE_SKINNING_PARTITION_H_
+
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/span.h"
+#include "ozz/geometry/offline/export.h"
+
+namespace ozz {
+namespace geometry {
+namespace offline {
+
+// SkinningJob dispatches to loops specialized per influences count, but can
+// only pick one for a whole job: meshes interleaving 1 to n influences
+// vertices pay the most expensive path for every vertex. These utilities
+// partition vertices by influences count at build time, so each partition
+// runs the optimal specialized kernel through its own SkinningJob.
+
+// Describes a run of contiguous vertices sharing the same influences count,
+// in partitioned vertex order.
+struct SkinningPartition {
+  // Number of joints influencing every vertex of the partition.
+  int influences_count;
+
+  // First vertex of the partition, in partitioned order.
+  size_t begin;
+
+  // Number of vertices in the partition.
+  size_t count;
+};
+
+// Partitions vertices by increasing influences count. Vertex order is
+// preserved inside each partition.
+// _influences_counts is the per-vertex number of joints influences.
+// On success, _remap maps each vertex index to its partitioned index
+// (_remap[old] == new), and _partitions describes the resulting runs,
+// ordered by increasing influences count. Index buffers are rewritten
+// through RemapIndices, vertex buffers through ReorderVertices.
+// Returns false if any influences count is lower than 1, or if an output
+// argument is nullptr.
+OZZ_GEOMOFFLINE_DLL bool PartitionVertices(
+    const span<const int>& _influences_counts, ozz::vector<uint32_t>* _remap,
+    ozz::vector<SkinningPartition>* _partitions);
+
+// Rewrites an index buffer in place through the _remap table built by
+// PartitionVertices. Returns false if an index is out of the remap table
+// range.
+OZZ_GEOMOFFLINE_DLL bool RemapIndices(const span<const uint32_t>& _remap,
+                                      const span<uint16_t>& _indices);
+OZZ_GEOMOFFLINE_DLL bool RemapIndices(const span<const uint32_t>& _remap,
+                                      const span<uint32_t>& _indices);
+
+// Copies strided vertex attributes from _input to their partitioned position
+// in _output, as per the _remap table built by PartitionVertices. _stride is
+// the size in bytes from a vertex to the next, for both buffers. Buffers
+// cannot overlap. Returns false if a buffer is smaller than
+// _remap.size() * _stride bytes.
+OZZ_GEOMOFFLINE_DLL bool ReorderVertices(const span<const uint32_t>& _remap,
+                                         size_t _stride,
+                                         const span<const byte>& _input,
+                                         const span<byte>& _output);
+}  // namespace offline
+}  // namespace geometry
+}  // namespace ozz
+#endif  // OZZ_OZZ_GEOMETRY_OFFLINE_SKINNING_PARTITION_H_
@@ -0,0 +1,97 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_GEOMETRY_RUNTIME_MATRIX_PALETTE_JOB_H_
+#define OZZ_OZZ_GEOMETRY_RUNTIME_MATRIX_PALETTE_JOB_H_
+
+#include "ozz/base/platform.h"
+#include "ozz/base/span.h"
+#include "ozz/geometry/runtime/export.h"
+
+namespace ozz {
+namespace math {
+struct Float4x4;
+}
+namespace geometry {
+
+// Builds the skinning matrices palette from model-space joint matrices, as
+// output by LocalToModelJob, and mesh inverse bind-pose matrices. The job
+// fuses in a single pass the per-joint multiplication and the remapping from
+// skeleton joints to mesh joints (meshes usually use a subset of the skeleton
+// joints), saving a full sweep over the matrices compared to doing both in
+// application code.
+// The palette can be output as Float4x4 matrices, ready to be consumed by
+// SkinningJob joint_matrices, and/or as transposed 3x4 matrices (3 lines of 4
+// floats per joint, the 4th matrix line being trivially (0, 0, 0, 1) for
+// affine transformations), the compact layout GPU skinning uploads expect.
+struct OZZ_GEOMETRY_DLL MatrixPaletteJob {
+  // Default constructor, initializes default values.
+  MatrixPaletteJob();
+
+  // Validates job parameters.
+  // Returns true for a valid job, false otherwise:
+  // - if input is empty.
+  // - if inverse_bind_poses is empty.
+  // - if joint_remap is provided but smaller than inverse_bind_poses.
+  // - if no output is provided, or an output is provided but smaller than
+  // inverse_bind_poses (x12 floats for transposed_output).
+  bool Validate() const;
+
+  // Runs job's palette building task.
+  // The job is validated before any operation is performed, see Validate()
+  // for more details.
+  // Returns false if *this job is not valid.
+  bool Run() const;
+
+  // Job input.
+
+  // Model-space joint matrices, ordered like skeleton's joints.
+  span<const math::Float4x4> input;
+
+  // Mesh inverse bind-pose matrices, one per palette entry (aka mesh joint).
+  // Defines the size of the palette.
+  span<const math::Float4x4> inverse_bind_poses;
+
+  // Optional indices of the skeleton joint each palette entry maps to.
+  // Content must be at least as big as inverse_bind_poses, and each index
+  // must be smaller than input size. If empty, palette entry i maps to
+  // skeleton joint i.
+  span<const uint16_t> joint_remap;
+
+  // Job output, at least one of them must be provided.
+
+  // Optional output palette of matrices, as consumed by SkinningJob. Must
+  // store at least one matrix per palette entry.
+  span<math::Float4x4> output;
+
+  // Optional output palette of transposed 3x4 matrices, 12 floats per palette
+  // entry. Must store at least 12 floats per palette entry.
+  span<float> transposed_output;
+};
+}  // namespace geometry
+}  // namespace ozz
+#endif  // OZZ_OZZ_GEOMETRY_RUNTIME_MATRIX_PALETTE_JOB_H_
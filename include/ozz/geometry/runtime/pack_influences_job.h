@@ -0,0 +1,103 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_GEOMETRY_RUNTIME_PACK_INFLUENCES_JOB_H_
+#define OZZ_OZZ_GEOMETRY_RUNTIME_PACK_INFLUENCES_JOB_H_
+
+#include "ozz/base/platform.h"
+#include "ozz/base/span.h"
+#include "ozz/geometry/runtime/export.h"
+
+namespace ozz {
+namespace geometry {
+
+// Reorganizes per-vertex joint influence streams (indices and weights, as
+// consumed by SkinningJob) into slot-major buffers suited to gpu compute
+// skinning: all vertices' influence 0, then all vertices' influence 1, and so
+// on. With this layout, consecutive gpu threads (one per vertex) read
+// consecutive memory addresses for each influence slot, so loads coalesce,
+// whereas the interleaved cpu layout scatters them across the warp.
+// The weights convention is the same as SkinningJob: influences_count - 1
+// weights per vertex, the last weight being restored on the gpu as 1 minus
+// the sum of the others. Weights are copied bit exact, so a gpu kernel
+// mirroring SkinningJob arithmetic produces identical results.
+// Packed buffers pair with MatrixPaletteJob transposed_output, which uploads
+// the matching 3x4 matrices palette.
+struct OZZ_GEOMETRY_DLL PackInfluencesJob {
+  // Default constructor, initializes default values.
+  PackInfluencesJob();
+
+  // Validates job parameters.
+  // Returns true for a valid job, false otherwise:
+  // - if influences_count isn't greater than 0.
+  // - if input indices (or weights when influences_count > 1) are too small,
+  // considering vertex_count, influences_count and strides.
+  // - if an output is too small, considering vertex_count and
+  // influences_count.
+  bool Validate() const;
+
+  // Runs job's packing task.
+  // The job is validated before any operation is performed, see Validate()
+  // for more details.
+  // Returns false if *this job is not valid.
+  bool Run() const;
+
+  // Number of vertices to pack. All input and output arrays must store at
+  // least this number of vertices.
+  int vertex_count;
+
+  // Maximum number of joints influencing each vertex. Must be greater than 0.
+  // Follows SkinningJob conventions: influences_count indices and
+  // influences_count - 1 weights per vertex.
+  int influences_count;
+
+  // Input array of joints indices and stride (number of bytes between the
+  // indices of two consecutive vertices), as fed to
+  // SkinningJob::joint_indices.
+  span<const uint16_t> joint_indices;
+  size_t joint_indices_stride;
+
+  // Input array of joints weights and stride (number of bytes between the
+  // weights of two consecutive vertices), as fed to
+  // SkinningJob::joint_weights. Unused if influences_count is 1.
+  span<const float> joint_weights;
+  size_t joint_weights_stride;
+
+  // Output slot-major joint indices: entry s * vertex_count + v is the s-th
+  // joint index of vertex v. Must store at least influences_count *
+  // vertex_count entries.
+  span<uint16_t> packed_indices;
+
+  // Output slot-major joint weights: entry s * vertex_count + v is the s-th
+  // joint weight of vertex v. Must store at least (influences_count - 1) *
+  // vertex_count entries. Unused (can be left empty) if influences_count
+  // is 1.
+  span<float> packed_weights;
+};
+}  // namespace geometry
+}  // namespace ozz
+#endif  // OZZ_OZZ_GEOMETRY_RUNTIME_PACK_INFLUENCES_JOB_H_
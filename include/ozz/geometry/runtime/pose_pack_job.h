@@ -0,0 +1,88 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_GEOMETRY_RUNTIME_POSE_PACK_JOB_H_
+#define OZZ_OZZ_GEOMETRY_RUNTIME_POSE_PACK_JOB_H_
+
+#include "ozz/base/platform.h"
+#include "ozz/base/span.h"
+#include "ozz/geometry/runtime/export.h"
+
+namespace ozz {
+namespace math {
+struct Float4x4;
+}
+namespace geometry {
+
+// Packs a pose of Float4x4 matrices, as output by LocalToModelJob, to the
+// compact layouts renderers upload: transposed 3x4 matrices (3 rows of 4
+// floats per matrix, the 4th row being trivially (0, 0, 0, 1) for affine
+// transformations), as full floats and/or half floats. The conversion is done
+// with simd transpose and float-to-half instructions, replacing the scalar
+// shuffling application code usually does per frame.
+// Outputs are plain spans, so they can map straight into caller-provided
+// (persistently mapped) upload buffers, writing the gpu visible memory
+// directly with no intermediate copy.
+// Unlike MatrixPaletteJob, which fuses inverse bind-pose multiplication and
+// joint remapping into its palette, this job is a pure layout conversion for
+// poses that are uploaded as is (object transforms, already built palettes,
+// debug rendering...).
+struct OZZ_GEOMETRY_DLL PosePackJob {
+  // Default constructor, initializes default values.
+  PosePackJob();
+
+  // Validates job parameters.
+  // Returns true for a valid job, false otherwise:
+  // - if input is empty.
+  // - if no output is provided, or an output is provided but smaller than 12
+  // elements per input matrix.
+  bool Validate() const;
+
+  // Runs job's packing task.
+  // The job is validated before any operation is performed, see Validate()
+  // for more details.
+  // Returns false if *this job is not valid.
+  bool Run() const;
+
+  // Input matrices to pack. Must be affine transformations, as the 4th row
+  // isn't stored.
+  span<const math::Float4x4> input;
+
+  // Job output, at least one of them must be provided.
+
+  // Optional output of transposed 3x4 float matrices. Must store at least 12
+  // floats per input matrix.
+  span<float> output;
+
+  // Optional output of transposed 3x4 half-float matrices. Must store at
+  // least 12 halfs per input matrix. Half floats roughly hold 3 decimal
+  // digits, enough for skinning palettes of human scale characters.
+  span<uint16_t> half_output;
+};
+}  // namespace geometry
+}  // namespace ozz
+#endif  // OZZ_OZZ_GEOMETRY_RUNTIME_POSE_PACK_JOB_H_
@@ -28,14 +28,17 @@
 #ifndef OZZ_OZZ_GEOMETRY_RUNTIME_SKINNING_JOB_H_
 #define OZZ_OZZ_GEOMETRY_RUNTIME_SKINNING_JOB_H_
 
+#include "ozz/base/maths/simd_quaternion.h"
 #include "ozz/base/platform.h"
 #include "ozz/base/span.h"
 #include "ozz/geometry/runtime/export.h"
 
 namespace ozz {
-namespace math {
-struct Float4x4;
-}
+
+// Forward declares the validate-once job handle, see base/compiled_job.h.
+template <typename _Job>
+class CompiledJob;
+
 namespace geometry {
 
 // Provides per-vertex matrix palette skinning job implementation.
@@ -72,6 +75,13 @@ namespace geometry {
 // joints matrices (see http://www.glprogramming.com/red/appendixf.html). This
 // code path is less efficient than the one without this matrices set, and
 // should only be used when input matrices have non uniform scaling or shearing.
+// The job also implements dual quaternion skinning, which avoids the candy
+// wrapper and volume loss artifacts of linear blend skinning around twisting
+// joints. It is activated by providing joint_dual_quaternions (built from
+// joint matrices with ToDualQuaternions), in addition to joint_matrices. An
+// optional per-vertex blend factor then mixes linear blend (0) and dual
+// quaternion (1) results, so artifact-prone regions can use dual quaternions
+// while the rest of the mesh keeps the cheaper linear path.
 // The job does not owned the buffers (in/output) and will thus not delete them
 // during job's destruction.
 struct OZZ_GEOMETRY_DLL SkinningJob {
@@ -85,6 +95,9 @@ struct OZZ_GEOMETRY_DLL SkinningJob {
   // - if tangents are provided but normals aren't.
   // - if no output is provided while an input is. For example, if input normals
   // are provided, then output normals must also.
+  // - if joint_dual_quaternions is provided but doesn't have the same size as
+  // joint_matrices.
+  // - if blend_factors are provided without joint_dual_quaternions.
   bool Validate() const;
 
   // Runs job's skinning task.
@@ -93,6 +106,26 @@ struct OZZ_GEOMETRY_DLL SkinningJob {
   // Returns false if *this job is not valid.
   bool Run() const;
 
+  // Splits *this job into _jobs.size() independent sub jobs, each one set up
+  // to process its own contiguous range of vertices (distributed evenly).
+  // Sub jobs share *this job joint matrices but get correctly offset
+  // input/output spans, so they can be dispatched concurrently across a task
+  // system without the caller hand-slicing stride and span fields. Sub jobs
+  // are valid and ready to Run, strides and influences count are unchanged.
+  // Returns false, leaving _jobs unchanged, if *this job is not valid, if
+  // _jobs is empty, or if a stride is not a multiple of its buffer element
+  // size (ranges couldn't be offset).
+  bool Split(span<SkinningJob> _jobs) const;
+
+  // Rigid transformation (rotation and translation) stored as a dual
+  // quaternion, as expected by joint_dual_quaternions. The real part encodes
+  // the rotation, the dual part encodes the translation. Use ToDualQuaternions
+  // to build them from joint matrices.
+  struct DualQuaternion {
+    math::SimdQuaternion real;
+    math::SimdQuaternion dual;
+  };
+
   // Number of vertices to transform. All input and output arrays must store at
   // least this number of vertices.
   int vertex_count;
@@ -121,6 +154,13 @@ struct OZZ_GEOMETRY_DLL SkinningJob {
   // fall into a more costly code path in the skinning algorithm.
   span<const math::Float4x4> joint_inverse_transpose_matrices;
 
+  // Optional array of dual quaternions for each joint. If provided, the job
+  // uses the dual quaternion skinning algorithm instead of matrix palette
+  // skinning, and this array must have the same size as joint_matrices. Dual
+  // quaternions can only represent rigid transformations, so joint matrices
+  // with scaling or shearing aren't supported by this code path.
+  span<const DualQuaternion> joint_dual_quaternions;
+
   // Array of joints indices. This array is used to indexes matrices in joints
   // array.
   // Each vertex has influences_max number of indices, meaning that the size of
@@ -138,6 +178,15 @@ struct OZZ_GEOMETRY_DLL SkinningJob {
   span<const float> joint_weights;
   size_t joint_weights_stride;
 
+  // Optional array of per-vertex blend factors (1 float value per vertex) and
+  // stride (number of bytes between each factor), mixing linear blend (0) and
+  // dual quaternion (1) skinning results. Requires joint_dual_quaternions. If
+  // left empty while joint_dual_quaternions is provided, all vertices use the
+  // dual quaternion result.
+  // Array length must be at least vertex_count * blend_factors_stride.
+  span<const float> blend_factors;
+  size_t blend_factors_stride;
+
   // Input vertex positions array (3 float values per vertex) and stride (number
   // of bytes between each position).
   // Array length must be at least vertex_count * in_positions_stride.
@@ -179,7 +228,34 @@ struct OZZ_GEOMETRY_DLL SkinningJob {
   // Array length must be at least vertex_count * out_tangents_stride.
   span<float> out_tangents;
   size_t out_tangents_stride;
+
+  // Writes output buffers with non-temporal (streaming) stores, bypassing the
+  // cache hierarchy. Skinned outputs are typically written once by the CPU
+  // and consumed by the GPU only: pulling their cache lines in (read for
+  // ownership) evicts the matrix palette and source vertices the loop
+  // actually re-reads. Only activate when outputs are not read back by the
+  // CPU, as reading them right after the job defeats the purpose. Outputs
+  // are globally visible when Run returns (stores are fenced). Falls back to
+  // regular stores on targets without streaming store support.
+  bool streaming_stores;
+
+ private:
+  friend class ozz::CompiledJob<SkinningJob>;
+
+  // Runs job's skinning task, skipping validation. To be used through a
+  // CompiledJob handle, which maintains job validity.
+  void RunValidated() const;
 };
+
+// Converts joint transformation matrices to the dual quaternions expected by
+// SkinningJob::joint_dual_quaternions. Matrices must be rigid transformations
+// (rotation and translation), as dual quaternions cannot represent scaling or
+// shearing, which is thus ignored.
+// Returns false if _dual_quaternions size doesn't match _matrices size, or if
+// a matrix couldn't be decomposed.
+OZZ_GEOMETRY_DLL bool ToDualQuaternions(
+    const span<const math::Float4x4>& _matrices,
+    const span<SkinningJob::DualQuaternion>& _dual_quaternions);
 }  // namespace geometry
 }  // namespace ozz
 #endif  // OZZ_OZZ_GEOMETRY_RUNTIME_SKINNING_JOB_H_
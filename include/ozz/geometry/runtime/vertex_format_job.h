@@ -0,0 +1,197 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_OZZ_GEOMETRY_RUNTIME_VERTEX_FORMAT_JOB_H_
+#define OZZ_OZZ_GEOMETRY_RUNTIME_VERTEX_FORMAT_JOB_H_
+
+#include "ozz/base/platform.h"
+#include "ozz/base/span.h"
+#include "ozz/geometry/runtime/export.h"
+#include "ozz/geometry/runtime/skinning_job.h"
+
+namespace ozz {
+namespace geometry {
+
+// Packed vertex attribute formats understood by the conversion jobs below.
+// All formats decode to the 3 floats per vertex layout SkinningJob consumes.
+// The 4th component of 4 components formats is ignored when unpacking, and
+// written as 0 when packing. Normalized formats store the [-1,1] interval and
+// target unit-range attributes (normals, tangents); positions usually stay
+// kFloat3 or kHalf4.
+struct VertexFormat {
+  enum Value {
+    kFloat3,           // 3 floats, 12 bytes, SkinningJob native layout.
+    kHalf4,            // 4 half floats (ieee 754 binary16), 8 bytes.
+    kSnorm16x4,        // 4 signed normalized 16 bits integers, 8 bytes.
+    kSnorm10_10_10_2,  // 3 signed normalized 10 bits fields (x in the low
+                       // bits) plus 2 unused bits, 4 bytes.
+  };
+};
+
+// Returns the packed size (bytes) of a vertex attribute in _format.
+OZZ_GEOMETRY_DLL size_t VertexFormatSize(VertexFormat::Value _format);
+
+// Unpacks a stream of packed vertex attributes to the 3 floats per vertex
+// layout SkinningJob consumes, converting the whole stream in one pass
+// instead of scalar per-component application code.
+struct OZZ_GEOMETRY_DLL UnpackVerticesJob {
+  // Default constructor, initializes default values.
+  UnpackVerticesJob();
+
+  // Validates job parameters.
+  // Returns true for a valid job, false otherwise:
+  // - if vertex_count is negative.
+  // - if input_stride is smaller than the packed format size, or input too
+  // small considering vertex_count and input_stride.
+  // - if output_stride is smaller than 3 floats, or output too small
+  // considering vertex_count and output_stride.
+  bool Validate() const;
+
+  // Runs job's conversion task.
+  // The job is validated before any operation is performed, see Validate()
+  // for more details.
+  // Returns false if *this job is not valid.
+  bool Run() const;
+
+  // Number of vertices to unpack.
+  int vertex_count;
+
+  // Format of the packed input stream.
+  VertexFormat::Value format;
+
+  // Packed input stream and stride (number of bytes between two consecutive
+  // vertices).
+  span<const byte> input;
+  size_t input_stride;
+
+  // Output float stream (3 floats per vertex) and stride (number of bytes
+  // between two consecutive vertices), as fed to SkinningJob inputs.
+  span<float> output;
+  size_t output_stride;
+};
+
+// Packs a stream of 3 floats per vertex attributes (SkinningJob outputs
+// typically) back to a packed gpu format. Values are clamped to [-1,1] by
+// normalized formats.
+struct OZZ_GEOMETRY_DLL PackVerticesJob {
+  // Default constructor, initializes default values.
+  PackVerticesJob();
+
+  // Validates job parameters. Same rules as UnpackVerticesJob, with input
+  // and output roles swapped.
+  bool Validate() const;
+
+  // Runs job's conversion task.
+  // The job is validated before any operation is performed, see Validate()
+  // for more details.
+  // Returns false if *this job is not valid.
+  bool Run() const;
+
+  // Number of vertices to pack.
+  int vertex_count;
+
+  // Format of the packed output stream.
+  VertexFormat::Value format;
+
+  // Input float stream (3 floats per vertex) and stride (number of bytes
+  // between two consecutive vertices).
+  span<const float> input;
+  size_t input_stride;
+
+  // Packed output stream and stride (number of bytes between two consecutive
+  // vertices).
+  span<byte> output;
+  size_t output_stride;
+};
+
+// Fuses unpack, skinning and repack into a single pass over the mesh,
+// processing vertices by fixed size blocks through small stack buffers. This
+// avoids materializing whole-mesh intermediate float streams, whose transient
+// memory cost dominates when many characters are skinned per frame, and keeps
+// the block's vertices hot in L1 across the three stages.
+struct OZZ_GEOMETRY_DLL ConvertSkinningJob {
+  // Default constructor, initializes default values.
+  ConvertSkinningJob();
+
+  // Validates job parameters.
+  // Returns true for a valid job, false otherwise:
+  // - if skinning's float vertex streams aren't all empty (they are managed
+  // per block by this job).
+  // - if a packed input is provided without its output (and conversely), or
+  // tangents without normals, or no position stream.
+  // - if a packed stream is too small considering skinning.vertex_count,
+  // its stride and format.
+  // - if an influences stream stride is not a multiple of its element size
+  // (blocks couldn't be offset).
+  // - if the skinning setup itself is invalid, see SkinningJob::Validate.
+  bool Validate() const;
+
+  // Runs the fused conversion and skinning task.
+  // The job is validated before any operation is performed, see Validate()
+  // for more details.
+  // Returns false if *this job is not valid, or if a block fails to skin.
+  bool Run() const;
+
+  // Skinning setup: vertex_count, influences_count, joint matrices and
+  // per-vertex influence streams are used as is. Vertex attribute streams
+  // (in/out positions, normals, tangents) must be left empty, the job feeds
+  // them block by block from the packed streams below.
+  SkinningJob skinning;
+
+  // Packed input vertex positions, required.
+  VertexFormat::Value in_positions_format;
+  span<const byte> in_positions;
+  size_t in_positions_stride;
+
+  // Packed input vertex normals, optional.
+  VertexFormat::Value in_normals_format;
+  span<const byte> in_normals;
+  size_t in_normals_stride;
+
+  // Packed input vertex tangents, optional, requires normals.
+  VertexFormat::Value in_tangents_format;
+  span<const byte> in_tangents;
+  size_t in_tangents_stride;
+
+  // Packed output vertex positions, required.
+  VertexFormat::Value out_positions_format;
+  span<byte> out_positions;
+  size_t out_positions_stride;
+
+  // Packed output vertex normals, required when input normals are provided.
+  VertexFormat::Value out_normals_format;
+  span<byte> out_normals;
+  size_t out_normals_stride;
+
+  // Packed output vertex tangents, required when input tangents are provided.
+  VertexFormat::Value out_tangents_format;
+  span<byte> out_tangents;
+  size_t out_tangents_stride;
+};
+}  // namespace geometry
+}  // namespace ozz
+#endif  // OZZ_OZZ_GEOMETRY_RUNTIME_VERTEX_FORMAT_JOB_H_
@@ -82,6 +82,7 @@
 
 #include "ozz/options/export.h"
 #include "ozz/base/containers/string.h"
+#include "ozz/base/containers/unordered_map.h"
 
 namespace ozz {
 namespace options {
@@ -297,6 +298,21 @@ typedef TypedOption<int> IntOption;
 typedef TypedOption<float> FloatOption;
 typedef TypedOption<const char*> StringOption;
 
+namespace internal {
+// Hashes an option name for the parser lookup table. std::hash has no
+// specialization for strings using a non default allocator, hence this
+// functor.
+struct StringHash {
+  size_t operator()(const ozz::string& _str) const noexcept {
+    size_t hash = 5381;
+    for (size_t i = 0; i < _str.size(); ++i) {
+      hash = hash * 33 + static_cast<unsigned char>(_str[i]);
+    }
+    return hash;
+  }
+};
+}  // namespace internal
+
 // Declares the option parser class.
 // Option are registered by the parser and updated when command line arguments
 // are parsed.
@@ -365,9 +381,25 @@ class OZZ_OPTIONS_DLL Parser {
   // Get end of registered options array.
   Option** options_end() { return options_ + options_count_; }
 
+  // Builds the hashed option lookup table, see FindOption.
+  void BuildLookup();
+
+  // Finds the registered option matching _argv option name, or nullptr. Uses
+  // the hashed lookup table so matching a token doesn't scan all registered
+  // options.
+  Option* FindOption(const char* _argv) const;
+
   // Collection of registered options.
   Option* options_[32];
 
+  // Maps lower case option names to registered options. It is rebuilt lazily
+  // at Parse time, so that static-init time registration remains a plain
+  // array append.
+  ozz::unordered_map<ozz::string, Option*, internal::StringHash> lookup_;
+
+  // Set when a registration change invalidates lookup_.
+  bool lookup_dirty_;
+
   // Number of registered options, including built-in options.
   int options_count_;
 
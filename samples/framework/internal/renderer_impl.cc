@@ -456,8 +456,12 @@ bool RendererImpl::InitCheckeredTexture() {
 }
 
 namespace {
+// Fills bone/joint rendering uniforms for a single posture. _transform (the
+// world transform of the character) is baked into each instance matrix, so
+// that postures of many characters can share a single instanced draw.
 int DrawPosture_FillUniforms(const ozz::animation::Skeleton& _skeleton,
                              ozz::span<const ozz::math::Float4x4> _matrices,
+                             const ozz::math::Float4x4& _transform,
                              float* _uniforms, int _max_instances) {
   assert(IsAligned(_uniforms, alignof(math::SimdFloat4)));
 
@@ -474,8 +478,8 @@ int DrawPosture_FillUniforms(const ozz::animation::Skeleton& _skeleton,
     }
 
     // Selects joint matrices.
-    const math::Float4x4& parent = _matrices[parent_id];
-    const math::Float4x4& current = _matrices[i];
+    const math::Float4x4 parent = _transform * _matrices[parent_id];
+    const math::Float4x4 current = _transform * _matrices[i];
 
     // Copy parent joint's raw matrix, to render a bone between the parent
     // and current matrix.
@@ -621,14 +625,68 @@ bool RendererImpl::DrawPosture(const ozz::animation::Skeleton& _skeleton,
       static_cast<float*>(scratch_buffer_.Resize(max_uniforms_size));
 
   const int instance_count = DrawPosture_FillUniforms(
-      _skeleton, _matrices, uniforms, max_skeleton_pieces);
+      _skeleton, _matrices, _transform, uniforms, max_skeleton_pieces);
   assert(instance_count <= max_skeleton_pieces);
 
+  // The world transform is baked into instance matrices by
+  // DrawPosture_FillUniforms.
+  const ozz::math::Float4x4 identity = ozz::math::Float4x4::identity();
   if (GL_ARB_instanced_arrays_supported) {
-    DrawPosture_InstancedImpl(_transform, uniforms, instance_count,
+    DrawPosture_InstancedImpl(identity, uniforms, instance_count,
                               _draw_joints);
   } else {
-    DrawPosture_Impl(_transform, uniforms, instance_count, _draw_joints);
+    DrawPosture_Impl(identity, uniforms, instance_count, _draw_joints);
+  }
+
+  return true;
+}
+
+// Batches postures of a whole crowd into chunked instanced draw calls. Each
+// character's world transform is baked into its instance matrices, so
+// characters differ only by instance data and can share submissions.
+bool RendererImpl::DrawPostures(
+    const ozz::animation::Skeleton& _skeleton,
+    ozz::span<const ozz::span<const ozz::math::Float4x4>> _matrices,
+    ozz::span<const ozz::math::Float4x4> _transforms, bool _draw_joints) {
+  if (_matrices.size() != _transforms.size()) {
+    return false;
+  }
+
+  // Bones and leaf joints, see DrawPosture_FillUniforms.
+  const int max_skeleton_pieces = _skeleton.num_joints() * 2;
+
+  // Batches characters into chunks of at least kChunkInstances instances,
+  // bounding scratch buffer and dynamic vbo sizes whatever the crowd size.
+  const int kChunkInstances = 4096;
+  const int chars_per_chunk =
+      math::Max(1, kChunkInstances / max_skeleton_pieces);
+  const int chunk_capacity = chars_per_chunk * max_skeleton_pieces;
+  float* uniforms = static_cast<float*>(
+      scratch_buffer_.Resize(chunk_capacity * 16 * sizeof(float)));
+
+  const size_t num_joints = static_cast<size_t>(_skeleton.num_joints());
+  const ozz::math::Float4x4 identity = ozz::math::Float4x4::identity();
+  int instance_count = 0;
+  for (size_t c = 0; c < _matrices.size(); ++c) {
+    if (_matrices[c].size() < num_joints) {
+      return false;
+    }
+    instance_count += DrawPosture_FillUniforms(
+        _skeleton, _matrices[c], _transforms[c],
+        uniforms + instance_count * 16, max_skeleton_pieces);
+    assert(instance_count <= chunk_capacity);
+
+    // Flushes the chunk once full, or at the last character.
+    if (instance_count + max_skeleton_pieces > chunk_capacity ||
+        c + 1 == _matrices.size()) {
+      if (GL_ARB_instanced_arrays_supported) {
+        DrawPosture_InstancedImpl(identity, uniforms, instance_count,
+                                  _draw_joints);
+      } else {
+        DrawPosture_Impl(identity, uniforms, instance_count, _draw_joints);
+      }
+      instance_count = 0;
+    }
   }
 
   return true;
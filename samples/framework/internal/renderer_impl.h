@@ -127,6 +127,11 @@ class RendererImpl : public Renderer {
                            const ozz::math::Float4x4& _transform,
                            bool _draw_joints);
 
+  virtual bool DrawPostures(
+      const animation::Skeleton& _skeleton,
+      ozz::span<const ozz::span<const ozz::math::Float4x4>> _matrices,
+      ozz::span<const ozz::math::Float4x4> _transforms, bool _draw_joints);
+
   virtual bool DrawPoints(const ozz::span<const float>& _positions,
                           const ozz::span<const float>& _sizes,
                           const ozz::span<const Color>& _colors,
@@ -27,6 +27,9 @@
 
 #include "mesh.h"
 
+#include <cstring>
+#include <utility>
+
 #include "ozz/base/containers/vector_archive.h"
 #include "ozz/base/memory/allocator.h"
 
@@ -36,13 +39,229 @@
 #include "ozz/base/maths/simd_math_archive.h"
 
 namespace ozz {
+namespace sample {
+
+namespace {
+
+// Copies a whole raw vertex array into its carved mesh span.
+template <typename _Ty, typename _Allocator>
+void CopyArray(const std::vector<_Ty, _Allocator>& _src,
+               const span<_Ty>& _dest) {
+  assert(_src.size() == _dest.size());
+  if (!_src.empty()) {
+    std::memcpy(_dest.data(), _src.data(), _dest.size_bytes());
+  }
+}
+}  // namespace
+
+Mesh::Mesh() : buffer_(nullptr) {}
+
+Mesh::Mesh(const RawMesh& _raw) : buffer_(nullptr) {
+  // Gathers raw array counts and carves the single buffer accordingly.
+  ozz::vector<PartCounts> counts(_raw.parts.size());
+  for (size_t i = 0; i < _raw.parts.size(); ++i) {
+    const RawMesh::Part& part = _raw.parts[i];
+    counts[i].positions = static_cast<uint32_t>(part.positions.size());
+    counts[i].normals = static_cast<uint32_t>(part.normals.size());
+    counts[i].tangents = static_cast<uint32_t>(part.tangents.size());
+    counts[i].uvs = static_cast<uint32_t>(part.uvs.size());
+    counts[i].colors = static_cast<uint32_t>(part.colors.size());
+    counts[i].joint_indices = static_cast<uint32_t>(part.joint_indices.size());
+    counts[i].joint_weights = static_cast<uint32_t>(part.joint_weights.size());
+  }
+  Allocate(make_span(counts), _raw.triangle_indices.size(),
+           _raw.joint_remaps.size(), _raw.inverse_bind_poses.size());
+
+  // Copies raw arrays into the carved spans.
+  for (size_t i = 0; i < _raw.parts.size(); ++i) {
+    const RawMesh::Part& raw_part = _raw.parts[i];
+    Part& part = parts[i];
+    CopyArray(raw_part.positions, part.positions);
+    CopyArray(raw_part.normals, part.normals);
+    CopyArray(raw_part.tangents, part.tangents);
+    CopyArray(raw_part.uvs, part.uvs);
+    CopyArray(raw_part.colors, part.colors);
+    CopyArray(raw_part.joint_indices, part.joint_indices);
+    CopyArray(raw_part.joint_weights, part.joint_weights);
+  }
+  CopyArray(_raw.triangle_indices, triangle_indices);
+  CopyArray(_raw.joint_remaps, joint_remaps);
+  CopyArray(_raw.inverse_bind_poses, inverse_bind_poses);
+}
+
+Mesh::Mesh(Mesh&& _mesh) : buffer_(nullptr) { *this = std::move(_mesh); }
+
+Mesh& Mesh::operator=(Mesh&& _mesh) {
+  std::swap(parts, _mesh.parts);
+  std::swap(triangle_indices, _mesh.triangle_indices);
+  std::swap(joint_remaps, _mesh.joint_remaps);
+  std::swap(inverse_bind_poses, _mesh.inverse_bind_poses);
+  std::swap(buffer_, _mesh.buffer_);
+  return *this;
+}
+
+Mesh::~Mesh() { Deallocate(); }
+
+void Mesh::Allocate(const span<const PartCounts>& _parts,
+                    size_t _triangle_indices, size_t _joint_remaps,
+                    size_t _inverse_bind_poses) {
+  Deallocate();
+
+  // Arrays are carved by decreasing alignment order, so no padding is needed
+  // between them.
+  static_assert(alignof(math::Float4x4) >= alignof(float) &&
+                    alignof(float) >= alignof(uint16_t) &&
+                    alignof(uint16_t) >= alignof(uint8_t),
+                "Must serve larger alignment values first");
+
+  // Computes the single buffer size.
+  size_t size = _inverse_bind_poses * sizeof(math::Float4x4);
+  size_t num_uint16s = _triangle_indices + _joint_remaps;
+  size_t num_uint8s = 0;
+  for (size_t i = 0; i < _parts.size(); ++i) {
+    const PartCounts& counts = _parts[i];
+    size += (counts.positions + counts.normals + counts.tangents + counts.uvs +
+             counts.joint_weights) *
+            sizeof(float);
+    num_uint16s += counts.joint_indices;
+    num_uint8s += counts.colors;
+  }
+  size += num_uint16s * sizeof(uint16_t) + num_uint8s * sizeof(uint8_t);
+
+  buffer_ =
+      memory::default_allocator()->Allocate(size, alignof(math::Float4x4));
+  byte* cursor = static_cast<byte*>(buffer_);
+
+  // Carves mesh and part spans, in the same order as the archive data block.
+  inverse_bind_poses = {reinterpret_cast<math::Float4x4*>(cursor),
+                        _inverse_bind_poses};
+  cursor += _inverse_bind_poses * sizeof(math::Float4x4);
+
+  parts.resize(_parts.size());
+  for (size_t i = 0; i < _parts.size(); ++i) {
+    const PartCounts& counts = _parts[i];
+    Part& part = parts[i];
+    part.positions = {reinterpret_cast<float*>(cursor), counts.positions};
+    cursor += counts.positions * sizeof(float);
+    part.normals = {reinterpret_cast<float*>(cursor), counts.normals};
+    cursor += counts.normals * sizeof(float);
+    part.tangents = {reinterpret_cast<float*>(cursor), counts.tangents};
+    cursor += counts.tangents * sizeof(float);
+    part.uvs = {reinterpret_cast<float*>(cursor), counts.uvs};
+    cursor += counts.uvs * sizeof(float);
+    part.joint_weights = {reinterpret_cast<float*>(cursor),
+                          counts.joint_weights};
+    cursor += counts.joint_weights * sizeof(float);
+  }
+  for (size_t i = 0; i < _parts.size(); ++i) {
+    Part& part = parts[i];
+    part.joint_indices = {reinterpret_cast<uint16_t*>(cursor),
+                          _parts[i].joint_indices};
+    cursor += _parts[i].joint_indices * sizeof(uint16_t);
+  }
+  triangle_indices = {reinterpret_cast<uint16_t*>(cursor), _triangle_indices};
+  cursor += _triangle_indices * sizeof(uint16_t);
+  joint_remaps = {reinterpret_cast<uint16_t*>(cursor), _joint_remaps};
+  cursor += _joint_remaps * sizeof(uint16_t);
+  for (size_t i = 0; i < _parts.size(); ++i) {
+    parts[i].colors = {cursor, _parts[i].colors};
+    cursor += _parts[i].colors * sizeof(uint8_t);
+  }
+  assert(cursor == static_cast<byte*>(buffer_) + size);
+}
+
+void Mesh::Deallocate() {
+  memory::default_allocator()->Deallocate(buffer_);
+  buffer_ = nullptr;
+  parts.clear();
+  triangle_indices = {};
+  joint_remaps = {};
+  inverse_bind_poses = {};
+}
+}  // namespace sample
+
 namespace io {
 
-void Extern<sample::Mesh::Part>::Save(OArchive& _archive,
-                                      const sample::Mesh::Part* _parts,
-                                      size_t _count) {
+namespace {
+
+// Guarded array serialization helpers, as MakeArray streaming expects a non
+// empty array.
+template <typename _Ty>
+void SaveArray(OArchive& _archive, const _Ty* _data, size_t _count) {
+  if (_count > 0) {
+    _archive << MakeArray(_data, _count);
+  }
+}
+
+template <typename _Ty>
+void LoadArray(IArchive& _archive, _Ty* _data, size_t _count) {
+  if (_count > 0) {
+    _archive >> MakeArray(_data, _count);
+  }
+}
+
+// Saves a mesh as a counts header followed by a single data block holding
+// every array, ordered as the buffer carved by Mesh::Allocate. Loading needs
+// a single allocation and no seek. Both RawMesh and Mesh serialize to this
+// same format (version 2), as their parts and arrays mirror each other.
+template <typename _Mesh>
+void SaveMesh(OArchive& _archive, const _Mesh& _mesh) {
+  // Counts header.
+  const uint32_t part_count = static_cast<uint32_t>(_mesh.parts.size());
+  _archive << part_count;
+  for (size_t i = 0; i < _mesh.parts.size(); ++i) {
+    const typename _Mesh::Part& part = _mesh.parts[i];
+    _archive << static_cast<uint32_t>(part.positions.size());
+    _archive << static_cast<uint32_t>(part.normals.size());
+    _archive << static_cast<uint32_t>(part.tangents.size());
+    _archive << static_cast<uint32_t>(part.uvs.size());
+    _archive << static_cast<uint32_t>(part.colors.size());
+    _archive << static_cast<uint32_t>(part.joint_indices.size());
+    _archive << static_cast<uint32_t>(part.joint_weights.size());
+  }
+  _archive << static_cast<uint32_t>(_mesh.triangle_indices.size());
+  _archive << static_cast<uint32_t>(_mesh.joint_remaps.size());
+  _archive << static_cast<uint32_t>(_mesh.inverse_bind_poses.size());
+
+  // Data block.
+  SaveArray(_archive, _mesh.inverse_bind_poses.data(),
+                        _mesh.inverse_bind_poses.size());
+  for (size_t i = 0; i < _mesh.parts.size(); ++i) {
+    const typename _Mesh::Part& part = _mesh.parts[i];
+    SaveArray(_archive, part.positions.data(), part.positions.size());
+    SaveArray(_archive, part.normals.data(), part.normals.size());
+    SaveArray(_archive, part.tangents.data(), part.tangents.size());
+    SaveArray(_archive, part.uvs.data(), part.uvs.size());
+    SaveArray(_archive, part.joint_weights.data(), part.joint_weights.size());
+  }
+  for (size_t i = 0; i < _mesh.parts.size(); ++i) {
+    const typename _Mesh::Part& part = _mesh.parts[i];
+    SaveArray(_archive, part.joint_indices.data(), part.joint_indices.size());
+  }
+  SaveArray(_archive, _mesh.triangle_indices.data(),
+                        _mesh.triangle_indices.size());
+  SaveArray(_archive, _mesh.joint_remaps.data(), _mesh.joint_remaps.size());
+  for (size_t i = 0; i < _mesh.parts.size(); ++i) {
+    const typename _Mesh::Part& part = _mesh.parts[i];
+    SaveArray(_archive, part.colors.data(), part.colors.size());
+  }
+}
+
+// Loads a version 1 mesh, whose arrays were serialized as interleaved
+// vectors. Kept to load pre-existing mesh files.
+void LoadLegacyMesh(IArchive& _archive, sample::RawMesh* _mesh) {
+  _archive >> _mesh->parts;
+  _archive >> _mesh->triangle_indices;
+  _archive >> _mesh->joint_remaps;
+  _archive >> _mesh->inverse_bind_poses;
+}
+}  // namespace
+
+void Extern<sample::RawMesh::Part>::Save(OArchive& _archive,
+                                         const sample::RawMesh::Part* _parts,
+                                         size_t _count) {
   for (size_t i = 0; i < _count; ++i) {
-    const sample::Mesh::Part& part = _parts[i];
+    const sample::RawMesh::Part& part = _parts[i];
     _archive << part.positions;
     _archive << part.normals;
     _archive << part.tangents;
@@ -53,12 +272,12 @@ void Extern<sample::Mesh::Part>::Save(OArchive& _archive,
   }
 }
 
-void Extern<sample::Mesh::Part>::Load(IArchive& _archive,
-                                      sample::Mesh::Part* _parts, size_t _count,
-                                      uint32_t _version) {
+void Extern<sample::RawMesh::Part>::Load(IArchive& _archive,
+                                         sample::RawMesh::Part* _parts,
+                                         size_t _count, uint32_t _version) {
   (void)_version;
   for (size_t i = 0; i < _count; ++i) {
-    sample::Mesh::Part& part = _parts[i];
+    sample::RawMesh::Part& part = _parts[i];
     _archive >> part.positions;
     _archive >> part.normals;
     _archive >> part.tangents;
@@ -69,26 +288,142 @@ void Extern<sample::Mesh::Part>::Load(IArchive& _archive,
   }
 }
 
-void Extern<sample::Mesh>::Save(OArchive& _archive, const sample::Mesh* _meshes,
-                                size_t _count) {
+void Extern<sample::RawMesh>::Save(OArchive& _archive,
+                                   const sample::RawMesh* _meshes,
+                                   size_t _count) {
+  for (size_t i = 0; i < _count; ++i) {
+    SaveMesh(_archive, _meshes[i]);
+  }
+}
+
+void Extern<sample::RawMesh>::Load(IArchive& _archive,
+                                   sample::RawMesh* _meshes, size_t _count,
+                                   uint32_t _version) {
+  for (size_t i = 0; i < _count; ++i) {
+    sample::RawMesh& mesh = _meshes[i];
+    if (_version == 1) {
+      LoadLegacyMesh(_archive, &mesh);
+      continue;
+    }
+
+    // Counts header.
+    uint32_t part_count;
+    _archive >> part_count;
+    mesh.parts.resize(part_count);
+    for (size_t p = 0; p < part_count; ++p) {
+      sample::RawMesh::Part& part = mesh.parts[p];
+      uint32_t size;
+      _archive >> size;
+      part.positions.resize(size);
+      _archive >> size;
+      part.normals.resize(size);
+      _archive >> size;
+      part.tangents.resize(size);
+      _archive >> size;
+      part.uvs.resize(size);
+      _archive >> size;
+      part.colors.resize(size);
+      _archive >> size;
+      part.joint_indices.resize(size);
+      _archive >> size;
+      part.joint_weights.resize(size);
+    }
+    uint32_t size;
+    _archive >> size;
+    mesh.triangle_indices.resize(size);
+    _archive >> size;
+    mesh.joint_remaps.resize(size);
+    _archive >> size;
+    mesh.inverse_bind_poses.resize(size);
+
+    // Data block.
+    LoadArray(_archive, mesh.inverse_bind_poses.data(),
+                          mesh.inverse_bind_poses.size());
+    for (size_t p = 0; p < part_count; ++p) {
+      sample::RawMesh::Part& part = mesh.parts[p];
+      LoadArray(_archive, part.positions.data(), part.positions.size());
+      LoadArray(_archive, part.normals.data(), part.normals.size());
+      LoadArray(_archive, part.tangents.data(), part.tangents.size());
+      LoadArray(_archive, part.uvs.data(), part.uvs.size());
+      LoadArray(_archive, part.joint_weights.data(), part.joint_weights.size());
+    }
+    for (size_t p = 0; p < part_count; ++p) {
+      sample::RawMesh::Part& part = mesh.parts[p];
+      LoadArray(_archive, part.joint_indices.data(), part.joint_indices.size());
+    }
+    LoadArray(_archive, mesh.triangle_indices.data(),
+                          mesh.triangle_indices.size());
+    LoadArray(_archive, mesh.joint_remaps.data(), mesh.joint_remaps.size());
+    for (size_t p = 0; p < part_count; ++p) {
+      sample::RawMesh::Part& part = mesh.parts[p];
+      LoadArray(_archive, part.colors.data(), part.colors.size());
+    }
+  }
+}
+
+void Extern<sample::Mesh>::Save(OArchive& _archive,
+                                const sample::Mesh* _meshes, size_t _count) {
   for (size_t i = 0; i < _count; ++i) {
-    const sample::Mesh& mesh = _meshes[i];
-    _archive << mesh.parts;
-    _archive << mesh.triangle_indices;
-    _archive << mesh.joint_remaps;
-    _archive << mesh.inverse_bind_poses;
+    SaveMesh(_archive, _meshes[i]);
   }
 }
 
 void Extern<sample::Mesh>::Load(IArchive& _archive, sample::Mesh* _meshes,
                                 size_t _count, uint32_t _version) {
-  (void)_version;
   for (size_t i = 0; i < _count; ++i) {
     sample::Mesh& mesh = _meshes[i];
-    _archive >> mesh.parts;
-    _archive >> mesh.triangle_indices;
-    _archive >> mesh.joint_remaps;
-    _archive >> mesh.inverse_bind_poses;
+    if (_version == 1) {
+      // Loads the interleaved legacy format through the raw representation,
+      // then packs it into the single buffer layout.
+      sample::RawMesh raw;
+      LoadLegacyMesh(_archive, &raw);
+      mesh = sample::Mesh(raw);
+      continue;
+    }
+
+    // Counts header.
+    uint32_t part_count;
+    _archive >> part_count;
+    ozz::vector<sample::Mesh::PartCounts> counts(part_count);
+    for (size_t p = 0; p < part_count; ++p) {
+      _archive >> counts[p].positions;
+      _archive >> counts[p].normals;
+      _archive >> counts[p].tangents;
+      _archive >> counts[p].uvs;
+      _archive >> counts[p].colors;
+      _archive >> counts[p].joint_indices;
+      _archive >> counts[p].joint_weights;
+    }
+    uint32_t triangle_index_count, joint_remap_count, inverse_bind_pose_count;
+    _archive >> triangle_index_count;
+    _archive >> joint_remap_count;
+    _archive >> inverse_bind_pose_count;
+
+    // Single allocation, then direct reads of the data block into the carved
+    // spans, in the same order it was saved.
+    mesh.Allocate(make_span(counts), triangle_index_count, joint_remap_count,
+                  inverse_bind_pose_count);
+    LoadArray(_archive, mesh.inverse_bind_poses.data(),
+                          mesh.inverse_bind_poses.size());
+    for (size_t p = 0; p < part_count; ++p) {
+      sample::Mesh::Part& part = mesh.parts[p];
+      LoadArray(_archive, part.positions.data(), part.positions.size());
+      LoadArray(_archive, part.normals.data(), part.normals.size());
+      LoadArray(_archive, part.tangents.data(), part.tangents.size());
+      LoadArray(_archive, part.uvs.data(), part.uvs.size());
+      LoadArray(_archive, part.joint_weights.data(), part.joint_weights.size());
+    }
+    for (size_t p = 0; p < part_count; ++p) {
+      sample::Mesh::Part& part = mesh.parts[p];
+      LoadArray(_archive, part.joint_indices.data(), part.joint_indices.size());
+    }
+    LoadArray(_archive, mesh.triangle_indices.data(),
+                          mesh.triangle_indices.size());
+    LoadArray(_archive, mesh.joint_remaps.data(), mesh.joint_remaps.size());
+    for (size_t p = 0; p < part_count; ++p) {
+      sample::Mesh::Part& part = mesh.parts[p];
+      LoadArray(_archive, part.colors.data(), part.colors.size());
+    }
   }
 }
 }  // namespace io
@@ -33,14 +33,19 @@
 #include "ozz/base/maths/simd_math.h"
 #include "ozz/base/maths/vec_float.h"
 #include "ozz/base/platform.h"
+#include "ozz/base/span.h"
 
 namespace ozz {
 namespace sample {
 
-// Defines a mesh with skinning information (joint indices and weights).
-// The mesh is subdivided into parts that group vertices according to their
-// number of influencing joints. Triangle indices are shared across mesh parts.
-struct Mesh {
+// Authoring representation of a mesh with skinning information (joint indices
+// and weights). The mesh is subdivided into parts that group vertices
+// according to their number of influencing joints. Triangle indices are
+// shared across mesh parts.
+// Vertex arrays are independently growable vectors, suited to mesh building
+// and processing tools (see fbx2mesh). The runtime representation below
+// packs them into a single allocation.
+struct RawMesh {
   // Number of triangle indices for the mesh.
   int triangle_index_count() const {
     return static_cast<int>(triangle_indices.size());
@@ -68,9 +73,7 @@ struct Mesh {
   }
 
   // Test if the mesh has skinning informations.
-  bool skinned() const {
-    return !inverse_bind_poses.empty();
-  }
+  bool skinned() const { return !inverse_bind_poses.empty(); }
 
   // Returns the number of joints used to skin the mesh.
   int num_joints() const { return static_cast<int>(inverse_bind_poses.size()); }
@@ -137,23 +140,173 @@ struct Mesh {
   typedef ozz::vector<ozz::math::Float4x4> InversBindPoses;
   InversBindPoses inverse_bind_poses;
 };
+
+// Runtime representation of a mesh, sharing RawMesh subdivision into parts.
+// All vertex and index arrays of the mesh live in a single relocatable
+// allocation that the mesh owns, which part and mesh spans point into.
+// Loading a mesh from an archive is thus a counts header read, a single
+// allocation, and direct stream reads into the carved buffer, instead of one
+// allocation per vertex array as with RawMesh.
+struct Mesh {
+  Mesh();
+
+  // Packs _raw vertex and index arrays into a single buffer mesh.
+  explicit Mesh(const RawMesh& _raw);
+
+  // Moves the buffer ownership, _mesh is left empty.
+  Mesh(Mesh&& _mesh);
+  Mesh& operator=(Mesh&& _mesh);
+
+  ~Mesh();
+
+  // Number of triangle indices for the mesh.
+  int triangle_index_count() const {
+    return static_cast<int>(triangle_indices.size());
+  }
+
+  // Number of vertices for all mesh parts.
+  int vertex_count() const {
+    int vertex_count = 0;
+    for (size_t i = 0; i < parts.size(); ++i) {
+      vertex_count += parts[i].vertex_count();
+    }
+    return vertex_count;
+  }
+
+  // Maximum number of joints influences for all mesh parts.
+  int max_influences_count() const {
+    int max_influences_count = 0;
+    for (size_t i = 0; i < parts.size(); ++i) {
+      const int influences_count = parts[i].influences_count();
+      max_influences_count = influences_count > max_influences_count
+                                 ? influences_count
+                                 : max_influences_count;
+    }
+    return max_influences_count;
+  }
+
+  // Test if the mesh has skinning informations.
+  bool skinned() const { return !inverse_bind_poses.empty(); }
+
+  // Returns the number of joints used to skin the mesh.
+  int num_joints() const { return static_cast<int>(inverse_bind_poses.size()); }
+
+  // Returns the highest joint number used in the skeleton.
+  int highest_joint_index() const {
+    // Takes advantage that joint_remaps is sorted.
+    return joint_remaps.size() != 0
+               ? static_cast<int>(joint_remaps[joint_remaps.size() - 1])
+               : 0;
+  }
+
+  // Defines a portion of the mesh. A mesh is subdivided in sets of vertices
+  // with the same number of joint influences. All spans point into the single
+  // buffer owned by the mesh.
+  struct Part {
+    int vertex_count() const { return static_cast<int>(positions.size()) / 3; }
+
+    int influences_count() const {
+      const int _vertex_count = vertex_count();
+      if (_vertex_count == 0) {
+        return 0;
+      }
+      return static_cast<int>(joint_indices.size()) / _vertex_count;
+    }
+
+    span<float> positions;
+    enum { kPositionsCpnts = 3 };  // x, y, z components
+
+    span<float> normals;
+    enum { kNormalsCpnts = 3 };  // x, y, z components
+
+    span<float> tangents;
+    enum { kTangentsCpnts = 4 };  // x, y, z, right or left handed.
+
+    span<float> uvs;  // u, v components
+    enum { kUVsCpnts = 2 };
+
+    span<uint8_t> colors;
+    enum { kColorsCpnts = 4 };  // r, g, b, a components
+
+    span<uint16_t> joint_indices;  // Stride equals influences_count
+
+    span<float> joint_weights;  // Stride equals influences_count - 1
+  };
+  typedef ozz::vector<Part> Parts;
+  Parts parts;
+
+  // Triangles indices. Indices are shared across all parts.
+  typedef span<uint16_t> TriangleIndices;
+  TriangleIndices triangle_indices;
+
+  // Joints remapping indices. As a skin might be influenced by a part of the
+  // skeleton only, joint indices and inverse bind pose matrices are reordered
+  // to contain only used ones. Note that this array is sorted.
+  typedef span<uint16_t> JointRemaps;
+  JointRemaps joint_remaps;
+
+  // Inverse bind-pose matrices. These are only available for skinned meshes.
+  typedef span<ozz::math::Float4x4> InversBindPoses;
+  InversBindPoses inverse_bind_poses;
+
+ private:
+  // Spans would be left dangling on the source buffer.
+  Mesh(const Mesh&) = delete;
+  Mesh& operator=(const Mesh&) = delete;
+
+  // Archive load binds spans into the buffer.
+  friend struct io::Extern<Mesh>;
+
+  // Per part vertex array element counts, used to size and carve the buffer.
+  struct PartCounts {
+    uint32_t positions;
+    uint32_t normals;
+    uint32_t tangents;
+    uint32_t uvs;
+    uint32_t colors;
+    uint32_t joint_indices;
+    uint32_t joint_weights;
+  };
+
+  // Allocates the single data buffer for the provided array counts and binds
+  // part and mesh spans into it. Previous buffer is deallocated, spans
+  // content is left uninitialized.
+  void Allocate(const span<const PartCounts>& _parts,
+                size_t _triangle_indices, size_t _joint_remaps,
+                size_t _inverse_bind_poses);
+  void Deallocate();
+
+  // The single allocation all spans point into.
+  void* buffer_;
+};
 }  // namespace sample
 
 namespace io {
 
-OZZ_IO_TYPE_TAG("ozz-sample-Mesh-Part", sample::Mesh::Part)
-OZZ_IO_TYPE_VERSION(1, sample::Mesh::Part)
+OZZ_IO_TYPE_TAG("ozz-sample-Mesh-Part", sample::RawMesh::Part)
+OZZ_IO_TYPE_VERSION(1, sample::RawMesh::Part)
 
 template <>
-struct Extern<sample::Mesh::Part> {
-  static void Save(OArchive& _archive, const sample::Mesh::Part* _parts,
+struct Extern<sample::RawMesh::Part> {
+  static void Save(OArchive& _archive, const sample::RawMesh::Part* _parts,
                    size_t _count);
-  static void Load(IArchive& _archive, sample::Mesh::Part* _parts,
+  static void Load(IArchive& _archive, sample::RawMesh::Part* _parts,
                    size_t _count, uint32_t _version);
 };
 
+OZZ_IO_TYPE_TAG("ozz-sample-Mesh", sample::RawMesh)
+OZZ_IO_TYPE_VERSION(2, sample::RawMesh)
+
+template <>
+struct Extern<sample::RawMesh> {
+  static void Save(OArchive& _archive, const sample::RawMesh* _meshes,
+                   size_t _count);
+  static void Load(IArchive& _archive, sample::RawMesh* _meshes, size_t _count,
+                   uint32_t _version);
+};
+
 OZZ_IO_TYPE_TAG("ozz-sample-Mesh", sample::Mesh)
-OZZ_IO_TYPE_VERSION(1, sample::Mesh)
+OZZ_IO_TYPE_VERSION(2, sample::Mesh)
 
 template <>
 struct Extern<sample::Mesh> {
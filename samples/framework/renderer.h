@@ -93,6 +93,21 @@ class Renderer {
                            const ozz::math::Float4x4& _transform,
                            bool _draw_joints = true) = 0;
 
+  // Renders postures of many characters sharing the same skeleton, batched
+  // into a minimal number of (instanced) draw submissions. _matrices provides
+  // one model-space matrices range per character, _transforms one world
+  // transform per character, both ranges must have the same size. Crowd
+  // samples should prefer this to per-character DrawPosture calls, whose
+  // submission overhead becomes the bottleneck long before animation CPU
+  // does.
+  // Returns true on success, or false if ranges sizes don't match, or if any
+  // matrices range does not match with the _skeleton.
+  virtual bool DrawPostures(
+      const animation::Skeleton& _skeleton,
+      ozz::span<const ozz::span<const ozz::math::Float4x4>> _matrices,
+      ozz::span<const ozz::math::Float4x4> _transforms,
+      bool _draw_joints = true) = 0;
+
   // Renders points.
   // _sizes and _colors must be either of ize 1 or equal to _positions' size.
   // If _screen_space is true, then points size is fixed in screen-space,
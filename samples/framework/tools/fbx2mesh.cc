@@ -130,7 +130,7 @@ bool Compare(const _T* _a, const _T* _b, size_t _count) {
 bool BuildVertices(FbxMesh* _fbx_mesh,
                    ozz::animation::offline::fbx::FbxSystemConverter* _converter,
                    ControlPointsRemap* _remap,
-                   ozz::sample::Mesh* _output_mesh) {
+                   ozz::sample::RawMesh* _output_mesh) {
   // This function treat all layers like if they were using mapping mode
   // eByPolygonVertex. This allow to use a single code path for all mapping
   // modes. It requires one more pass (compare to eByControlPoint mode), which
@@ -183,19 +183,19 @@ bool BuildVertices(FbxMesh* _fbx_mesh,
 
   // Reserve vertex buffers. Real size is unknown as redundant vertices will be
   // rejected.
-  ozz::sample::Mesh::Part& part = _output_mesh->parts[0];
+  ozz::sample::RawMesh::Part& part = _output_mesh->parts[0];
   part.positions.reserve(vertex_count *
-                         ozz::sample::Mesh::Part::kPositionsCpnts);
-  part.normals.reserve(vertex_count * ozz::sample::Mesh::Part::kNormalsCpnts);
+                         ozz::sample::RawMesh::Part::kPositionsCpnts);
+  part.normals.reserve(vertex_count * ozz::sample::RawMesh::Part::kNormalsCpnts);
   if (element_tangents) {
     part.tangents.reserve(vertex_count *
-                          ozz::sample::Mesh::Part::kTangentsCpnts);
+                          ozz::sample::RawMesh::Part::kTangentsCpnts);
   }
   if (element_uvs) {
-    part.uvs.reserve(vertex_count * ozz::sample::Mesh::Part::kUVsCpnts);
+    part.uvs.reserve(vertex_count * ozz::sample::RawMesh::Part::kUVsCpnts);
   }
   if (element_colors) {
-    part.colors.reserve(vertex_count * ozz::sample::Mesh::Part::kColorsCpnts);
+    part.colors.reserve(vertex_count * ozz::sample::RawMesh::Part::kColorsCpnts);
   }
 
   // Resize triangle indices, as their size is known.
@@ -279,16 +279,16 @@ bool BuildVertices(FbxMesh* _fbx_mesh,
         // Check for identical normals.
         if (!Compare(
                 &normal.x,
-                &part.normals[to_test * ozz::sample::Mesh::Part::kNormalsCpnts],
-                ozz::sample::Mesh::Part::kNormalsCpnts)) {
+                &part.normals[to_test * ozz::sample::RawMesh::Part::kNormalsCpnts],
+                ozz::sample::RawMesh::Part::kNormalsCpnts)) {
           continue;  // Next vertex.
         }
 
         // Check for identical uvs.
         if (element_uvs) {
           if (!Compare(&uv.x,
-                       &part.uvs[to_test * ozz::sample::Mesh::Part::kUVsCpnts],
-                       ozz::sample::Mesh::Part::kUVsCpnts)) {
+                       &part.uvs[to_test * ozz::sample::RawMesh::Part::kUVsCpnts],
+                       ozz::sample::RawMesh::Part::kUVsCpnts)) {
             continue;  // Next vertex.
           }
         }
@@ -297,8 +297,8 @@ bool BuildVertices(FbxMesh* _fbx_mesh,
         if (element_colors) {
           if (!Compare(
                   color,
-                  &part.colors[to_test * ozz::sample::Mesh::Part::kColorsCpnts],
-                  ozz::sample::Mesh::Part::kColorsCpnts)) {
+                  &part.colors[to_test * ozz::sample::RawMesh::Part::kColorsCpnts],
+                  ozz::sample::RawMesh::Part::kColorsCpnts)) {
             continue;  // Next vertex.
           }
         }
@@ -307,8 +307,8 @@ bool BuildVertices(FbxMesh* _fbx_mesh,
         if (element_tangents) {
           if (!Compare(&tangent.x,
                        &part.tangents[to_test *
-                                      ozz::sample::Mesh::Part::kTangentsCpnts],
-                       ozz::sample::Mesh::Part::kColorsCpnts)) {
+                                      ozz::sample::RawMesh::Part::kTangentsCpnts],
+                       ozz::sample::RawMesh::Part::kColorsCpnts)) {
             continue;  // Next vertex.
           }
         }
@@ -338,7 +338,7 @@ bool BuildVertices(FbxMesh* _fbx_mesh,
 
         // Deduce this vertex offset in the output vertex buffer.
         uint16_t vertex_index = static_cast<uint16_t>(
-            part.positions.size() / ozz::sample::Mesh::Part::kPositionsCpnts);
+            part.positions.size() / ozz::sample::RawMesh::Part::kPositionsCpnts);
 
         // Build triangle indices.
         _output_mesh->triangle_indices[p * 3 + v] = vertex_index;
@@ -402,10 +402,10 @@ bool BuildSkin(FbxMesh* _fbx_mesh,
                ozz::animation::offline::fbx::FbxSystemConverter* _converter,
                const ControlPointsRemap& _remap,
                const ozz::animation::Skeleton& _skeleton,
-               ozz::sample::Mesh* _output_mesh) {
+               ozz::sample::RawMesh* _output_mesh) {
   assert(_output_mesh->parts.size() == 1 &&
          _output_mesh->parts[0].vertex_count() != 0);
-  ozz::sample::Mesh::Part& part = _output_mesh->parts[0];
+  ozz::sample::RawMesh::Part& part = _output_mesh->parts[0];
 
   const int skin_count = _fbx_mesh->GetDeformerCount(FbxDeformer::eSkin);
   if (skin_count == 0) {
@@ -586,10 +586,10 @@ bool BuildSkin(FbxMesh* _fbx_mesh,
 }
 
 // Limits the number of joints influencing a vertex.
-bool LimitInfluences(ozz::sample::Mesh& _skinned_mesh, int _limit) {
+bool LimitInfluences(ozz::sample::RawMesh& _skinned_mesh, int _limit) {
   assert(_skinned_mesh.parts.size() == 1);
 
-  ozz::sample::Mesh::Part& in_part = _skinned_mesh.parts.front();
+  ozz::sample::RawMesh::Part& in_part = _skinned_mesh.parts.front();
 
   // Check if it's actually needed to limit the number of influences.
   const int max_influences = in_part.influences_count();
@@ -630,25 +630,25 @@ bool LimitInfluences(ozz::sample::Mesh& _skinned_mesh, int _limit) {
 // The mesh might not use all skeleton joints, so this function remaps joint
 // indices to the subset of used joints. It also reorders inverse bin pose
 // matrices.
-bool RemapIndices(ozz::sample::Mesh* _skinned_mesh) {
+bool RemapIndices(ozz::sample::RawMesh* _skinned_mesh) {
   assert(_skinned_mesh->parts.size() == 1);
 
-  ozz::sample::Mesh::Part& in_part = _skinned_mesh->parts.front();
+  ozz::sample::RawMesh::Part& in_part = _skinned_mesh->parts.front();
   assert(in_part.influences_count() > 0);
 
   // Collects all unique indices.
-  ozz::sample::Mesh::Part::JointIndices local_indices = in_part.joint_indices;
+  ozz::sample::RawMesh::Part::JointIndices local_indices = in_part.joint_indices;
   std::sort(local_indices.begin(), local_indices.end());
   local_indices.erase(std::unique(local_indices.begin(), local_indices.end()),
                       local_indices.end());
 
   // Build mapping table of mesh original joints to the new ones. Unused joints
   // are set to 0.
-  ozz::sample::Mesh::Part::JointIndices original_remap(
+  ozz::sample::RawMesh::Part::JointIndices original_remap(
       _skinned_mesh->num_joints(), 0);
   for (size_t i = 0; i < local_indices.size(); ++i) {
     original_remap[local_indices[i]] =
-        static_cast<ozz::sample::Mesh::Part::JointIndices::value_type>(i);
+        static_cast<ozz::sample::RawMesh::Part::JointIndices::value_type>(i);
   }
 
   // Reset all joints in the mesh.
@@ -671,12 +671,12 @@ bool RemapIndices(ozz::sample::Mesh* _skinned_mesh) {
 
 // Split the skinned mesh into parts. For each part, all vertices has the same
 // number of influencing joints.
-bool SplitParts(const ozz::sample::Mesh& _skinned_mesh,
-                ozz::sample::Mesh* _partitionned_mesh) {
+bool SplitParts(const ozz::sample::RawMesh& _skinned_mesh,
+                ozz::sample::RawMesh* _partitionned_mesh) {
   assert(_skinned_mesh.parts.size() == 1);
   assert(_partitionned_mesh->parts.size() == 0);
 
-  const ozz::sample::Mesh::Part& in_part = _skinned_mesh.parts.front();
+  const ozz::sample::RawMesh::Part& in_part = _skinned_mesh.parts.front();
   const size_t vertex_count = in_part.vertex_count();
 
   // Creates one mesh part per influence.
@@ -732,25 +732,25 @@ bool SplitParts(const ozz::sample::Mesh& _skinned_mesh,
 
     // Adds a new part.
     _partitionned_mesh->parts.resize(_partitionned_mesh->parts.size() + 1);
-    ozz::sample::Mesh::Part& out_part = _partitionned_mesh->parts.back();
+    ozz::sample::RawMesh::Part& out_part = _partitionned_mesh->parts.back();
 
     // Resize output part.
     const int influences = i + 1;
     out_part.positions.resize(bucket_vertex_count *
-                              ozz::sample::Mesh::Part::kPositionsCpnts);
+                              ozz::sample::RawMesh::Part::kPositionsCpnts);
     out_part.normals.resize(bucket_vertex_count *
-                            ozz::sample::Mesh::Part::kNormalsCpnts);
+                            ozz::sample::RawMesh::Part::kNormalsCpnts);
     if (in_part.uvs.size()) {
       out_part.uvs.resize(bucket_vertex_count *
-                          ozz::sample::Mesh::Part::kUVsCpnts);
+                          ozz::sample::RawMesh::Part::kUVsCpnts);
     }
     if (in_part.colors.size()) {
       out_part.colors.resize(bucket_vertex_count *
-                             ozz::sample::Mesh::Part::kColorsCpnts);
+                             ozz::sample::RawMesh::Part::kColorsCpnts);
     }
     if (in_part.tangents.size()) {
       out_part.tangents.resize(bucket_vertex_count *
-                               ozz::sample::Mesh::Part::kTangentsCpnts);
+                               ozz::sample::RawMesh::Part::kTangentsCpnts);
     }
     out_part.joint_indices.resize(bucket_vertex_count * influences);
     out_part.joint_weights.resize(bucket_vertex_count * influences);
@@ -761,40 +761,40 @@ bool SplitParts(const ozz::sample::Mesh& _skinned_mesh,
 
       // Fills positions.
       float* out_pos =
-          &out_part.positions[j * ozz::sample::Mesh::Part::kPositionsCpnts];
+          &out_part.positions[j * ozz::sample::RawMesh::Part::kPositionsCpnts];
       const float* in_pos =
           &in_part.positions[bucket_vertex_index *
-                             ozz::sample::Mesh::Part::kPositionsCpnts];
+                             ozz::sample::RawMesh::Part::kPositionsCpnts];
       out_pos[0] = in_pos[0];
       out_pos[1] = in_pos[1];
       out_pos[2] = in_pos[2];
 
       // Fills normals.
       float* out_normal =
-          &out_part.normals[j * ozz::sample::Mesh::Part::kNormalsCpnts];
+          &out_part.normals[j * ozz::sample::RawMesh::Part::kNormalsCpnts];
       const float* in_normal =
           &in_part.normals[bucket_vertex_index *
-                           ozz::sample::Mesh::Part::kNormalsCpnts];
+                           ozz::sample::RawMesh::Part::kNormalsCpnts];
       out_normal[0] = in_normal[0];
       out_normal[1] = in_normal[1];
       out_normal[2] = in_normal[2];
 
       // Fills uvs.
       if (in_part.uvs.size()) {
-        float* out_uv = &out_part.uvs[j * ozz::sample::Mesh::Part::kUVsCpnts];
+        float* out_uv = &out_part.uvs[j * ozz::sample::RawMesh::Part::kUVsCpnts];
         const float* in_uv =
             &in_part
-                 .uvs[bucket_vertex_index * ozz::sample::Mesh::Part::kUVsCpnts];
+                 .uvs[bucket_vertex_index * ozz::sample::RawMesh::Part::kUVsCpnts];
         out_uv[0] = in_uv[0];
         out_uv[1] = in_uv[1];
       }
       // Fills colors.
       if (in_part.colors.size()) {
         uint8_t* out_color =
-            &out_part.colors[j * ozz::sample::Mesh::Part::kColorsCpnts];
+            &out_part.colors[j * ozz::sample::RawMesh::Part::kColorsCpnts];
         const uint8_t* in_color =
             &in_part.colors[bucket_vertex_index *
-                            ozz::sample::Mesh::Part::kColorsCpnts];
+                            ozz::sample::RawMesh::Part::kColorsCpnts];
         out_color[0] = in_color[0];
         out_color[1] = in_color[1];
         out_color[2] = in_color[2];
@@ -803,10 +803,10 @@ bool SplitParts(const ozz::sample::Mesh& _skinned_mesh,
       // Fills tangents.
       if (in_part.tangents.size()) {
         float* out_tangent =
-            &out_part.tangents[j * ozz::sample::Mesh::Part::kTangentsCpnts];
+            &out_part.tangents[j * ozz::sample::RawMesh::Part::kTangentsCpnts];
         const float* in_tangent =
             &in_part.tangents[bucket_vertex_index *
-                              ozz::sample::Mesh::Part::kTangentsCpnts];
+                              ozz::sample::RawMesh::Part::kTangentsCpnts];
         out_tangent[0] = in_tangent[0];
         out_tangent[1] = in_tangent[1];
         out_tangent[2] = in_tangent[2];
@@ -864,9 +864,9 @@ bool SplitParts(const ozz::sample::Mesh& _skinned_mesh,
 
 // Removes the less significant weight, which is recomputed at runtime (sum of
 // weights equals 1).
-bool StripWeights(ozz::sample::Mesh* _mesh) {
+bool StripWeights(ozz::sample::RawMesh* _mesh) {
   for (size_t i = 0; i < _mesh->parts.size(); ++i) {
-    ozz::sample::Mesh::Part& part = _mesh->parts[i];
+    ozz::sample::RawMesh::Part& part = _mesh->parts[i];
     const int influence_count = part.influences_count();
     const int vertex_count = part.vertex_count();
     if (influence_count <= 1) {
@@ -955,14 +955,14 @@ int main(int _argc, const char** _argv) {
   }
 
   // Take all meshes
-  ozz::vector<ozz::sample::Mesh> meshes;
+  ozz::vector<ozz::sample::RawMesh> meshes;
   meshes.resize(num_meshes);
 
   for (int m = 0; m < num_meshes; ++m) {
     FbxMesh* mesh = scene_loader.scene()->GetSrcObject<FbxMesh>(m);
 
     // Allocates output mesh.
-    ozz::sample::Mesh& output_mesh = meshes[m];
+    ozz::sample::RawMesh& output_mesh = meshes[m];
     output_mesh.parts.resize(1);
 
     ControlPointsRemap remap;
@@ -981,7 +981,7 @@ int main(int _argc, const char** _argv) {
 
       // Limiting number of joint influences per vertex.
       if (OPTIONS_max_influences > 0) {
-        ozz::sample::Mesh partitioned_meshes;
+        ozz::sample::RawMesh partitioned_meshes;
         if (!LimitInfluences(output_mesh, OPTIONS_max_influences)) {
           ozz::log::Err() << "Failed to limit number of joint influences."
                           << std::endl;
@@ -999,7 +999,7 @@ int main(int _argc, const char** _argv) {
 
       // Split the mesh if option is true (default)
       if (OPTIONS_split) {
-        ozz::sample::Mesh partitioned_meshes;
+        ozz::sample::RawMesh partitioned_meshes;
         if (!SplitParts(output_mesh, &partitioned_meshes)) {
           ozz::log::Err() << "Failed to partitioned meshes." << std::endl;
           return EXIT_FAILURE;
@@ -28,10 +28,11 @@
 #include <algorithm>
 #include <atomic>
 #include <cstdlib>
-#include <future>
+#include <thread>
 
 #include "framework/application.h"
 #include "framework/imgui.h"
+#include "framework/profile.h"
 #include "framework/renderer.h"
 #include "framework/utils.h"
 #include "ozz/animation/runtime/animation.h"
@@ -45,6 +46,8 @@
 #include "ozz/base/maths/simd_math.h"
 #include "ozz/base/maths/soa_transform.h"
 #include "ozz/base/maths/vec_float.h"
+#include "ozz/base/memory/unique_ptr.h"
+#include "ozz/base/scheduler.h"
 #include "ozz/options/options.h"
 
 #if EMSCRIPTEN
@@ -69,8 +72,11 @@ const float kInterval = 2.f;
 const int kWidth = 16;
 const int kDepth = 16;
 
-// The maximum number of characters.
-const int kMaxCharacters = 4096;
+// The maximum number of characters, aka the last scaling curve point.
+const int kMaxCharacters = 10000;
+
+// Scaling curve points exposed as presets in the GUI.
+const int kScalingPresets[] = {100, 1000, 10000};
 
 // The minimum number of characters per task.
 const int kMinGrainSize = 32;
@@ -88,10 +94,11 @@ class MultithreadSampleApplication : public ozz::sample::Application {
  public:
   MultithreadSampleApplication()
       : characters_(kMaxCharacters),
-        num_characters_(kMaxCharacters / 4),
+        num_characters_(kScalingPresets[1]),
         has_threading_support_(HasThreadingSupport()),
         enable_theading_(has_threading_support_),
-        grain_size_(128) {
+        grain_size_(128),
+        update_record_(256) {
     if (has_threading_support_) {
       ozz::log::Out() << "Platform has threading support." << std::endl;
     } else {
@@ -133,27 +140,15 @@ class MultithreadSampleApplication : public ozz::sample::Application {
     return true;
   }
 
-  // Data structure used to pass const arguments to parallel tasks.
-  struct ParallelArgs {
-    const ozz::animation::Animation* animation;
-    const ozz::animation::Skeleton* skeleton;
-    float dt;
-    int grain_size;  // Maximum number of characters that can be processed by a
-                     // task.
-  };
-
   // Data used to monitor and analyze threading.
   // Every task will push its thread id to an array. We can then process it to
   // find how many threads were used.
   class ParallelMonitor {
    public:
     ParallelMonitor() {
-      // Finds the maximum possible number of tasks considering kMinGrain grain
-      // size for kMaxCharacters characters.
-      int max_tasks = 1;
-      for (int processed = kMinGrainSize; processed < kMaxCharacters;
-           processed *= 2, max_tasks *= 2) {
-      }
+      // The scheduler splits the character range into subranges of at least
+      // kMinGrainSize characters, which bounds the number of tasks.
+      const int max_tasks = kMaxCharacters / kMinGrainSize + 1;
       thread_ids_.resize(max_tasks);
       num_async_tasks_.store(0);
     }
@@ -183,65 +178,57 @@ class MultithreadSampleApplication : public ozz::sample::Application {
     std::atomic_uint num_async_tasks_;
   };
 
-  static bool ParallelUpdate(const ParallelArgs& _args, Character* _characters,
-                             int _num, ParallelMonitor* _monitor) {
-    bool success = true;
-    if (_num <= _args.grain_size) {
-      _monitor->PushTask();
-
-      for (int i = 0; i < _num; ++i) {
-        success &= UpdateCharacter(*_args.animation, *_args.skeleton, _args.dt,
-                                   &_characters[i]);
-      }
-    } else {
-      // Run half the job on an async task, possibly another thread.
-      const int half = _num / 2;
-      auto handle = std::async(std::launch::async, ParallelUpdate, _args,
-                               _characters + half, _num - half, _monitor);
-
-      // The other half is processed by this thread.
-      success &= ParallelUpdate(_args, _characters, half, _monitor);
-
-      // Get result of the async task or process it if it's not started yet.
-      success &= handle.get();
-    }
-    return success;
-  }
-
   // Updates current animation time.
   virtual bool OnUpdate(float _dt, float) {
-    bool success = true;
-    if (enable_theading_) {
-      // Initialize task counter. It's only used to monitor threading behavior.
-      monitor_.Reset();
-
-      const ParallelArgs args = {&animation_, &skeleton_, _dt, grain_size_};
-      success = ParallelUpdate(args, array_begin(characters_), num_characters_,
-                               &monitor_);
-    } else {
-      for (int i = 0; i < num_characters_; ++i) {
-        success &= UpdateCharacter(animation_, skeleton_, _dt,
-                                   array_begin(characters_) + i);
-      }
+    // Initialize task counter. It's only used to monitor threading behavior.
+    monitor_.Reset();
+
+    // Selects the persistent worker pool, or the serial fallback when
+    // threading is disabled. Workers outlive frames: distributing a frame
+    // only costs pushing range tasks, not spawning threads.
+    ozz::Scheduler* scheduler =
+        enable_theading_ && pool_ ? static_cast<ozz::Scheduler*>(pool_.get())
+                                  : &serial_scheduler_;
+
+    std::atomic<bool> success(true);
+    {
+      // Records update time, charted by the GUI to expose scaling behavior.
+      ozz::sample::Profiler profile(&update_record_);
+
+      Character* characters = array_begin(characters_);
+      scheduler->ParallelForFct(
+          0, num_characters_, grain_size_, [&](int _begin, int _end) {
+            monitor_.PushTask();
+            bool ok = true;
+            for (int i = _begin; i < _end; ++i) {
+              ok &= UpdateCharacter(animation_, skeleton_, _dt,
+                                    characters + i);
+            }
+            if (!ok) {
+              success.store(false);
+            }
+          });
     }
-    return success;
+    return success.load();
   }
 
-  // Renders all skeletons.
+  // Renders all skeletons, batched into instanced draw calls so render
+  // submission overhead doesn't hide animation CPU time at crowd scale.
   virtual bool OnDisplay(ozz::sample::Renderer* _renderer) {
-    bool success = true;
-    for (int c = 0; success && c < num_characters_; ++c) {
+    render_matrices_.resize(num_characters_);
+    render_transforms_.resize(num_characters_);
+    for (int c = 0; c < num_characters_; ++c) {
       const ozz::math::Float4 position(
           ((c % kWidth) - kWidth / 2) * kInterval,
           ((c / kWidth) / kDepth) * kInterval,
           (((c / kWidth) % kDepth) - kDepth / 2) * kInterval, 1.f);
-      const ozz::math::Float4x4 transform = ozz::math::Float4x4::Translation(
+      render_transforms_[c] = ozz::math::Float4x4::Translation(
           ozz::math::simd_float4::LoadPtrU(&position.x));
-      success &= _renderer->DrawPosture(
-          skeleton_, make_span(characters_[c].models), transform, false);
+      render_matrices_[c] = make_span(characters_[c].models);
     }
 
-    return true;
+    return _renderer->DrawPostures(skeleton_, make_span(render_matrices_),
+                                   make_span(render_transforms_), false);
   }
 
   virtual bool OnInitialize() {
@@ -258,6 +245,12 @@ class MultithreadSampleApplication : public ozz::sample::Application {
     // Allocate a default number of characters.
     AllocateCharaters();
 
+    // Starts the persistent worker pool once for the whole application
+    // lifetime.
+    if (has_threading_support_) {
+      pool_ = ozz::make_unique<ozz::ThreadPoolScheduler>();
+    }
+
     return true;
   }
 
@@ -292,6 +285,31 @@ class MultithreadSampleApplication : public ozz::sample::Application {
         const int num_joints = num_characters_ * skeleton_.num_joints();
         std::snprintf(label, sizeof(label), "Number of joints: %d", num_joints);
         _im_gui->DoLabel(label);
+
+        // Scaling curve presets.
+        for (size_t i = 0; i < OZZ_ARRAY_SIZE(kScalingPresets); ++i) {
+          std::snprintf(label, sizeof(label), "%d characters",
+                        kScalingPresets[i]);
+          if (_im_gui->DoButton(label)) {
+            num_characters_ = kScalingPresets[i];
+          }
+        }
+      }
+    }
+    // Charts update time, so scaling can be compared across character counts
+    // and threading setups.
+    {
+      static bool oc_open = true;
+      ozz::sample::ImGui::OpenClose oc(_im_gui, "Update time", &oc_open);
+      if (oc_open) {
+        char label[64];
+        const ozz::sample::Record::Statistics statistics =
+            update_record_.GetStatistics();
+        std::snprintf(label, sizeof(label), "Update time: %.2fms",
+                      statistics.latest);
+        _im_gui->DoGraph(label, 0.f, statistics.max, statistics.latest,
+                         update_record_.cursor(), update_record_.record_begin(),
+                         update_record_.record_end());
       }
     }
     // Exposes multi-threading parameters.
@@ -369,6 +387,21 @@ class MultithreadSampleApplication : public ozz::sample::Application {
 
   // Data used to monitor and analyze threading.
   ParallelMonitor monitor_;
+
+  // Persistent worker pool, created once at initialization time. Null on
+  // platforms without threading support.
+  ozz::unique_ptr<ozz::ThreadPoolScheduler> pool_;
+
+  // Serial fallback, used when threading is disabled from the GUI.
+  ozz::SerialScheduler serial_scheduler_;
+
+  // Records update times for the scaling chart.
+  ozz::sample::Record update_record_;
+
+  // Per frame batched rendering inputs, members to avoid per-frame
+  // reallocation.
+  ozz::vector<ozz::span<const ozz::math::Float4x4>> render_matrices_;
+  ozz::vector<ozz::math::Float4x4> render_transforms_;
 };
 
 int main(int _argc, const char** _argv) {
@@ -0,0 +1,118 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/offline/animation_bounds_builder.h"
+
+#include <cassert>
+
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/offline/raw_animation_utils.h"
+#include "ozz/animation/runtime/animation_bounds.h"
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/maths/simd_math.h"
+#include "ozz/base/maths/transform.h"
+
+namespace ozz {
+namespace animation {
+namespace offline {
+
+namespace {
+
+// Merges the model-space position of every joint of the local pose _locals
+// into _box, composing transformations up the hierarchy.
+void MergeJointPositions(const Skeleton& _skeleton,
+                         const ozz::vector<math::Transform>& _locals,
+                         ozz::vector<math::Float4x4>* _models,
+                         math::Box* _box) {
+  const span<const int16_t>& parents = _skeleton.joint_parents();
+  for (int i = 0; i < _skeleton.num_joints(); ++i) {
+    const math::Transform& local = _locals[i];
+    const math::Float4x4 local_matrix = math::Float4x4::FromAffine(
+        math::simd_float4::Load3PtrU(&local.translation.x),
+        math::simd_float4::LoadPtrU(&local.rotation.x),
+        math::simd_float4::Load3PtrU(&local.scale.x));
+    const int16_t parent = parents[i];
+    (*_models)[i] = parent == Skeleton::kNoParent
+                        ? local_matrix
+                        : (*_models)[parent] * local_matrix;
+
+    math::Float3 position;
+    math::Store3PtrU((*_models)[i].cols[3], &position.x);
+    *_box = Merge(*_box, math::Box(position));
+  }
+}
+}  // namespace
+
+AnimationBoundsBuilder::AnimationBoundsBuilder()
+    : num_intervals(16), sample_rate(30.f), margin(0.f) {}
+
+unique_ptr<AnimationBounds> AnimationBoundsBuilder::operator()(
+    const Skeleton& _skeleton, const RawAnimation& _animation) const {
+  unique_ptr<AnimationBounds> bounds;
+
+  // Tests inputs and builder parameters validity.
+  const int num_joints = _skeleton.num_joints();
+  if (!_animation.Validate() || _animation.num_tracks() != num_joints ||
+      num_joints == 0 || num_intervals <= 0 || !(sample_rate > 0.f) ||
+      margin < 0.f) {
+    return bounds;
+  }
+
+  ozz::vector<math::Box> intervals(num_intervals);
+  ozz::vector<math::Transform> locals(num_joints);
+  ozz::vector<math::Float4x4> models(num_joints);
+
+  // Samples each bucket at fixed rate, bucket boundary times included, so
+  // consecutive buckets share their boundary pose and a query falling on an
+  // interval edge is enclosed whichever side it lands on.
+  const float duration = _animation.duration;
+  const float step = 1.f / sample_rate;
+  for (int i = 0; i < num_intervals; ++i) {
+    const float begin = duration * i / num_intervals;
+    const float end = duration * (i + 1) / num_intervals;
+    math::Box box;
+    bool last = false;
+    for (float time = begin; !last; time += step) {
+      last = time >= end;
+      const bool success =
+          SampleAnimation(_animation, last ? end : time, make_span(locals));
+      assert(success);
+      (void)success;
+      MergeJointPositions(_skeleton, locals, &models, &box);
+    }
+    assert(box.is_valid());
+    const math::Float3 margin3(margin);
+    intervals[i] = math::Box(box.min - margin3, box.max + margin3);
+  }
+
+  bounds = make_unique<AnimationBounds>();
+  bounds->intervals_ = std::move(intervals);
+  return bounds;
+}
+}  // namespace offline
+}  // namespace animation
+}  // namespace ozz
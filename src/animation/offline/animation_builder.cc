@@ -28,19 +28,23 @@
 #include "ozz/animation/offline/animation_builder.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <cstring>
 #include <limits>
 #include <numeric>
+#include <thread>
 
 #include "ozz/animation/offline/raw_animation.h"
 #include "ozz/animation/offline/raw_animation_utils.h"
 #include "ozz/animation/runtime/animation.h"
+#include "ozz/animation/runtime/skeleton.h"
 #include "ozz/base/containers/vector.h"
 #include "ozz/base/encode/group_varint.h"
 #include "ozz/base/maths/simd_math.h"
 #include "ozz/base/memory/allocator.h"
+#include "ozz/base/scheduler.h"
 
 // Internal include file
 #define OZZ_INCLUDE_PRIVATE_HEADER  // Allows to include private headers.
@@ -49,8 +53,6 @@
 namespace ozz {
 namespace animation {
 namespace offline {
-namespace {
-
 template <typename _Key>
 struct SortingKey {
   uint16_t track;
@@ -62,6 +64,16 @@ typedef SortingKey<RawAnimation::TranslationKey> SortingTranslationKey;
 typedef SortingKey<RawAnimation::RotationKey> SortingQuaternionKey;
 typedef SortingKey<RawAnimation::ScaleKey> SortingScaleKey;
 
+// Sorting keys gathered by the build paths, definition of the private nested
+// type forward declared in the builder class.
+struct AnimationBuilder::SortingKeys {
+  ozz::vector<SortingTranslationKey> translations;
+  ozz::vector<SortingQuaternionKey> rotations;
+  ozz::vector<SortingScaleKey> scales;
+};
+
+namespace {
+
 // Keyframe sorting. Stores first by time and then track number.
 template <typename _Key>
 bool SortingKeyLess(const _Key& _left, const _Key& _right) {
@@ -82,12 +94,21 @@ void PushBackIdentityKey(uint16_t _track, float _time, _DestTrack* _dest) {
 
 // Copies a track from a RawAnimation to an Animation.
 // Also fixes up the front (t = 0) and back keys (t = duration).
+// If _deduplicate is true, keys whose value strictly equals both their
+// neighbours' are dropped, as interpolating between equal values is constant.
+// This collapses constant (rest-pose typically) tracks down to the 2 mandatory
+// boundary keys, whatever the number of keys the raw track was exported with.
+// If _enforce_loop is true, the last key value is forced to the first key's,
+// making the track loop-safe. *_looping is anded with the track's resulting
+// loop safety (first and last values equal), accumulating it clip wide.
 template <typename _SrcTrack, typename _DestTrack>
 void CopyRaw(const _SrcTrack& _src, uint16_t _track, float _duration,
+             bool _deduplicate, bool _enforce_loop, bool* _looping,
              _DestTrack* _dest) {
   typedef typename _SrcTrack::value_type SrcKey;
   typedef typename _DestTrack::value_type DestKey;
 
+  const size_t begin = _dest->size();
   if (_src.size() == 0) {  // Adds 2 new keys.
     PushBackIdentityKey<SrcKey, _DestTrack>(_track, 0.f, _dest);
     PushBackIdentityKey<SrcKey, _DestTrack>(_track, _duration, _dest);
@@ -108,6 +129,12 @@ void CopyRaw(const _SrcTrack& _src, uint16_t _track, float _duration,
     for (size_t k = 0; k < _src.size(); ++k) {  // Copies all keys.
       const SrcKey& raw_key = _src[k];
       assert(raw_key.time >= 0 && raw_key.time <= _duration);
+      if (_deduplicate && k != 0 && k + 1 != _src.size() &&
+          raw_key.value == _src[k - 1].value &&
+          raw_key.value == _src[k + 1].value) {
+        // Interior key of a constant run, lossless to drop.
+        continue;
+      }
       const DestKey key = {_track, prev_time, {raw_key.time, raw_key.value}};
       _dest->push_back(key);
       prev_time = raw_key.time;
@@ -119,13 +146,69 @@ void CopyRaw(const _SrcTrack& _src, uint16_t _track, float _duration,
   }
   assert(_dest->front().key.time == 0.f &&
          _dest->back().key.time - _duration == 0.f);
+
+  if (_enforce_loop) {
+    _dest->back().key.value = (*_dest)[begin].key.value;
+  }
+  *_looping &= (*_dest)[begin].key.value == _dest->back().key.value;
+}
+
+// Sorts _src, dispatching work to _scheduler when one is provided and the
+// vector is worth it: chunks are sorted concurrently, then merged pairwise
+// (each pass halves the number of sorted runs, merges within a pass are
+// independent). SortingKeyLess is a strict total order (time ties are broken
+// by track, and times are strictly increasing within a track), so the merge
+// sort output is strictly identical to std::sort's.
+template <typename _SortingKey, class _Compare>
+void SortKeys(ozz::vector<_SortingKey>& _src, const _Compare& _comp,
+              Scheduler* _scheduler) {
+  // Below this chunk size, scheduling overhead exceeds sorting cost.
+  const size_t kMinChunkSize = 1 << 14;
+  if (!_scheduler || _src.size() < kMinChunkSize * 2) {
+    std::sort(_src.begin(), _src.end(), _comp);
+    return;
+  }
+
+  // Chunk boundaries, evenly distributed.
+  const size_t num_chunks = math::Min<size_t>(_src.size() / kMinChunkSize, 64);
+  ozz::vector<size_t> bounds(num_chunks + 1);
+  for (size_t i = 0; i <= num_chunks; ++i) {
+    bounds[i] = _src.size() * i / num_chunks;
+  }
+
+  // Sorts each chunk concurrently.
+  _scheduler->ParallelForFct(
+      0, static_cast<int>(num_chunks), 1, [&](int _begin, int _end) {
+        for (int i = _begin; i < _end; ++i) {
+          std::sort(_src.begin() + bounds[i], _src.begin() + bounds[i + 1],
+                    _comp);
+        }
+      });
+
+  // Merges sorted runs pairwise until a single one remains.
+  for (size_t width = 1; width < num_chunks; width *= 2) {
+    const size_t num_merges = (num_chunks + 2 * width - 1) / (2 * width);
+    _scheduler->ParallelForFct(
+        0, static_cast<int>(num_merges), 1, [&](int _begin, int _end) {
+          for (int m = _begin; m < _end; ++m) {
+            const size_t lo = m * 2 * width;
+            const size_t mid = math::Min(lo + width, num_chunks);
+            const size_t hi = math::Min(lo + 2 * width, num_chunks);
+            if (mid < hi) {
+              std::inplace_merge(_src.begin() + bounds[lo],
+                                 _src.begin() + bounds[mid],
+                                 _src.begin() + bounds[hi], _comp);
+            }
+          }
+        });
+  }
 }
 
 template <typename _SortingKey, class _Lerp, class _Compare>
 void Sort(ozz::vector<_SortingKey>& _src, size_t _num_tracks,
-          const _Lerp& _lerp, const _Compare& _comp) {
+          const _Lerp& _lerp, const _Compare& _comp, Scheduler* _scheduler) {
   // Sorts whole vector
-  std::sort(_src.begin(), _src.end(), _comp);
+  SortKeys(_src, _comp, _scheduler);
 
   // Will store last 2 keys (last and penultimate) for a track.
   ozz::vector<std::pair<int, int>> previouses(_num_tracks);
@@ -187,6 +270,87 @@ void Sort(ozz::vector<_SortingKey>& _src, size_t _num_tracks,
   }
 }
 
+// A contiguous run of hot profile buckets, in animation time (seconds).
+struct HotRange {
+  float begin;
+  float end;
+};
+
+// Extracts hot time ranges from a sampling density profile: contiguous runs
+// of buckets whose density reaches half of the peak one. Returns no range if
+// every density is null.
+ozz::vector<HotRange> BuildHotRanges(const span<const float>& _profile,
+                                     float _duration) {
+  ozz::vector<HotRange> ranges;
+  float peak = 0.f;
+  for (size_t i = 0; i < _profile.size(); ++i) {
+    peak = math::Max(peak, _profile[i]);
+  }
+  if (!(peak > 0.f)) {
+    return ranges;
+  }
+  const float threshold = peak * .5f;
+  const float bucket = _duration / _profile.size();
+  for (size_t i = 0; i < _profile.size();) {
+    if (_profile[i] < threshold) {
+      ++i;
+      continue;
+    }
+    size_t end = i + 1;
+    for (; end < _profile.size() && _profile[end] >= threshold; ++end) {
+    }
+    const HotRange range = {bucket * i, bucket * end};
+    ranges.push_back(range);
+    i = end;
+  }
+  return ranges;
+}
+
+// Splits keyframe intervals crossing hot sampling ranges, so the working set
+// of keys held by the sampler while playing a hot range stays contiguous in
+// memory. An interval active within a hot range, but ending more than _slack
+// past it, gets an interpolated key injected at the range end: while the
+// sampler stays within the range, every track's cached keys then point at
+// most one range past it, instead of anywhere up to the end of the key
+// buffer. _src tracks are stored contiguously in time order, as built by the
+// CopyRaw paths, and remain so.
+template <typename _SortingKey, typename _Lerp>
+void SplitForProfile(ozz::vector<_SortingKey>* _src,
+                     const ozz::vector<HotRange>& _ranges, float _slack,
+                     const _Lerp& _lerp) {
+  if (_ranges.empty()) {
+    return;
+  }
+  ozz::vector<_SortingKey> dest;
+  dest.reserve(_src->size());
+  for (size_t i = 0; i < _src->size(); ++i) {
+    _SortingKey key = (*_src)[i];
+    // First keys of a track (negative previous time) aren't an interpolation
+    // interval, nothing to split.
+    if (key.prev_key_time >= 0.f) {
+      for (size_t r = 0; r < _ranges.size(); ++r) {
+        const HotRange& range = _ranges[r];
+        if (key.prev_key_time < range.end &&
+            key.key.time >= range.end + _slack) {
+          // The previous key of the same track is the last pushed one, as
+          // tracks are contiguous and time ordered.
+          const _SortingKey& previous = dest.back();
+          const float alpha = (range.end - previous.key.time) /
+                              (key.key.time - previous.key.time);
+          const _SortingKey insert = {
+              key.track,
+              key.prev_key_time,
+              {range.end, _lerp(previous.key.value, key.key.value, alpha)}};
+          dest.push_back(insert);
+          key.prev_key_time = range.end;
+        }
+      }
+    }
+    dest.push_back(key);
+  }
+  _src->swap(dest);
+}
+
 void CopyTimePoints(const span<const float>& _times, float _inv_duration,
                     const span<float>& _ratios) {
   assert(_times.size() == _ratios.size());
@@ -237,48 +401,6 @@ void Compress(const span<const float>& _timepoints,
   }
 }
 
-void CompressFloat3(const ozz::math::Float3& _src,
-                    ozz::animation::internal::Float3Key* _dest) {
-  _dest->values[0] = ozz::math::FloatToHalf(_src.x);
-  _dest->values[1] = ozz::math::FloatToHalf(_src.y);
-  _dest->values[2] = ozz::math::FloatToHalf(_src.z);
-}
-
-// Compares float absolute values.
-bool LessAbs(float _left, float _right) {
-  return std::abs(_left) < std::abs(_right);
-}
-
-// Compresses quaternion to ozz::animation::RotationKey format.
-// The 3 smallest components of the quaternion are quantized to x bits
-// integers, while the largest is recomputed thanks to quaternion
-// normalization property (x^2+y^2+z^2+w^2 = 1). Because the 3 components are
-// the 3 smallest, their value cannot be greater than sqrt(2)/2. Thus
-// quantization quality is improved by pre-multiplying each componenent by
-// sqrt(2).
-void CompressQuaternion(const ozz::math::Quaternion& _src,
-                        ozz::animation::internal::QuaternionKey* _dest) {
-  // Finds the largest quaternion component.
-  const float quat[4] = {_src.x, _src.y, _src.z, _src.w};
-  const ptrdiff_t largest = std::max_element(quat, quat + 4, LessAbs) - quat;
-  assert(largest <= 3);
-
-  // Quantize the 3 smallest components on x bits signed integers.
-  const float kScale = internal::QuaternionKey::kfScale / math::kSqrt2;
-  const float kOffset = -math::kSqrt2_2;
-  const int kMapping[4][3] = {{1, 2, 3}, {0, 2, 3}, {0, 1, 3}, {0, 1, 2}};
-  const int* map = kMapping[largest];
-  const int cpnt[3] = {
-      math::Min(static_cast<int>((quat[map[0]] - kOffset) * kScale + .5f),
-                internal::QuaternionKey::kiScale),
-      math::Min(static_cast<int>((quat[map[1]] - kOffset) * kScale + .5f),
-                internal::QuaternionKey::kiScale),
-      math::Min(static_cast<int>((quat[map[2]] - kOffset) * kScale + .5f),
-                internal::QuaternionKey::kiScale)};
-
-  pack(static_cast<int>(largest), quat[largest] < 0.f, cpnt, _dest);
-}  // namespace
-
 // Normalize quaternions. Fixes-up successive opposite quaternions that would
 // fail to take the shortest path during the normalized-lerp. Note that keys
 // are still sorted per-track at that point, which allows this algorithm to
@@ -424,91 +546,104 @@ void CopyIFrames(const BuilderIFrames& _src, Animation::KeyframesCtrl& _dest) {
   std::copy(_src.desc.begin(), _src.desc.end(), _dest.iframe_desc.begin());
   _dest.iframe_interval = _src.interval;
 }
-}  // namespace
-
-// Ensures _input's validity and allocates _animation.
-// An animation needs to have at least two key frames per joint, the first at
-// t = 0 and the last at t = duration. If at least one of those keys are not
-// in the RawAnimation then the builder creates it.
-unique_ptr<Animation> AnimationBuilder::operator()(
-    const RawAnimation& _input) const {
-  // Tests _raw_animation validity.
-  if (!_input.Validate()) {
-    return nullptr;
-  }
 
-  // Everything is fine, allocates and fills the animation.
-  // Nothing can fail now.
-  unique_ptr<Animation> animation = make_unique<Animation>();
-
-  // Sets duration.
-  const float duration = _input.duration;
-  // A _duration == 0 would create some division by 0 during sampling.
-  // Also we need at least to keys with different times, which cannot be done
-  // if duration is 0.
-  assert(duration > 0.f);  // This case is handled by Validate().
-  const float inv_duration = 1.f / _input.duration;
-  animation->duration_ = duration;
-
-  // Sets tracks count. Can be safely casted to uint16_t as number of tracks as
-  // already been validated.
-  const uint16_t num_tracks = static_cast<uint16_t>(_input.num_tracks());
-  animation->num_tracks_ = num_tracks;
-  const uint16_t num_soa_tracks = Align(num_tracks, 4);
-
-  // Declares and preallocates tracks to sort.
-  size_t translations = 0, rotations = 0, scales = 0;
-  for (uint16_t i = 0; i < num_tracks; ++i) {
-    const RawAnimation::JointTrack& raw_track = _input.tracks[i];
-    translations += raw_track.translations.size() + 2;  // +2 because worst case
-    rotations += raw_track.rotations.size() + 2;        // needs to add the
-    scales += raw_track.scales.size() + 2;              // first and last keys.
-  }
-  ozz::vector<SortingTranslationKey> sorting_translations;
-  sorting_translations.reserve(translations);
-  ozz::vector<SortingQuaternionKey> sorting_rotations;
-  sorting_rotations.reserve(rotations);
-  ozz::vector<SortingScaleKey> sorting_scales;
-  sorting_scales.reserve(scales);
-
-  // Filters RawAnimation keys and copies them to the output sorting structure.
-  uint16_t i = 0;
-  for (; i < num_tracks; ++i) {
-    const RawAnimation::JointTrack& raw_track = _input.tracks[i];
-    CopyRaw(raw_track.translations, i, duration, &sorting_translations);
-    CopyRaw(raw_track.rotations, i, duration, &sorting_rotations);
-    CopyRaw(raw_track.scales, i, duration, &sorting_scales);
+// Flags tracks with a non constant channel into the animated joints bitmask.
+// Keys are compared against the first key of their track: single key and
+// constant channels leave the track bit clear.
+template <typename _Key>
+void FlagAnimatedTracks(const ozz::vector<SortingKey<_Key>>& _keys,
+                        uint16_t _num_tracks, const span<byte>& _mask) {
+  const size_t kInvalid = ~size_t(0);
+  ozz::vector<size_t> firsts(_num_tracks, kInvalid);
+  for (size_t i = 0; i < _keys.size(); ++i) {
+    const SortingKey<_Key>& key = _keys[i];
+    if (key.track >= _num_tracks) {
+      continue;  // Soa padding track.
+    }
+    size_t& first = firsts[key.track];
+    if (first == kInvalid) {
+      first = i;
+    } else if (key.key.value != _keys[first].key.value) {
+      _mask[key.track / 8] =
+          static_cast<byte>(_mask[key.track / 8] | (1 << (key.track & 7)));
+    }
   }
+}
 
-  // Add enough identity keys to match soa requirements.
-  for (; i < num_soa_tracks; ++i) {
+// Add enough identity keys to match soa requirements.
+void PushBackSoaPadding(uint16_t _begin, uint16_t _end, float _duration,
+                        ozz::vector<SortingTranslationKey>* _translations,
+                        ozz::vector<SortingQuaternionKey>* _rotations,
+                        ozz::vector<SortingScaleKey>* _scales) {
+  for (uint16_t i = _begin; i < _end; ++i) {
     typedef RawAnimation::TranslationKey SrcTKey;
-    PushBackIdentityKey<SrcTKey>(i, 0.f, &sorting_translations);
-    PushBackIdentityKey<SrcTKey>(i, duration, &sorting_translations);
+    PushBackIdentityKey<SrcTKey>(i, 0.f, _translations);
+    PushBackIdentityKey<SrcTKey>(i, _duration, _translations);
 
     typedef RawAnimation::RotationKey SrcRKey;
-    PushBackIdentityKey<SrcRKey>(i, 0.f, &sorting_rotations);
-    PushBackIdentityKey<SrcRKey>(i, duration, &sorting_rotations);
+    PushBackIdentityKey<SrcRKey>(i, 0.f, _rotations);
+    PushBackIdentityKey<SrcRKey>(i, _duration, _rotations);
 
     typedef RawAnimation::ScaleKey SrcSKey;
-    PushBackIdentityKey<SrcSKey>(i, 0.f, &sorting_scales);
-    PushBackIdentityKey<SrcSKey>(i, duration, &sorting_scales);
+    PushBackIdentityKey<SrcSKey>(i, 0.f, _scales);
+    PushBackIdentityKey<SrcSKey>(i, _duration, _scales);
   }
+}
+}  // namespace
+
+// Finishes a build from the filled sorting keys, whatever the way they were
+// gathered. Keys must already contain soa padding tracks. Nothing can fail
+// from there, but reaching animation format limits.
+unique_ptr<Animation> AnimationBuilder::Build(const char* _name,
+                                              float _duration,
+                                              uint16_t _num_tracks,
+                                              SortingKeys& _keys,
+                                              bool _looping) const {
+  unique_ptr<Animation> animation = make_unique<Animation>();
 
-  FixupQuaternions(&sorting_rotations);
+  // Sets duration.
+  // A _duration == 0 would create some division by 0 during sampling.
+  // Also we need at least to keys with different times, which cannot be done
+  // if duration is 0.
+  assert(_duration > 0.f);  // This case is handled by validation.
+  const float inv_duration = 1.f / _duration;
+  animation->duration_ = _duration;
+  animation->num_tracks_ = _num_tracks;
+  animation->looping_ = _looping;
+  const uint16_t num_soa_tracks = Align(_num_tracks, 4);
+
+  FixupQuaternions(&_keys.rotations);
+
+  // Profile-guided packing: splits key intervals crossing hot sampling
+  // ranges, after quaternion fixup so injected rotations interpolate
+  // neighborhood-consistent keys.
+  if (!sampling_profile.empty()) {
+    for (size_t i = 0; i < sampling_profile.size(); ++i) {
+      const float density = sampling_profile[i];
+      if (!(density >= 0.f)) {  // Also rejects NaN.
+        return nullptr;
+      }
+    }
+    const ozz::vector<HotRange> ranges =
+        BuildHotRanges(make_span(sampling_profile), _duration);
+    const float slack = _duration / sampling_profile.size();
+    SplitForProfile(&_keys.translations, ranges, slack, &LerpTranslation);
+    SplitForProfile(&_keys.rotations, ranges, slack, &LerpRotation);
+    SplitForProfile(&_keys.scales, ranges, slack, &LerpScale);
+  }
 
   // Sort animation keys to favor cache coherency.
-  Sort(sorting_translations, num_soa_tracks, &LerpTranslation,
-       &SortingKeyLess<SortingTranslationKey>);
-  Sort(sorting_rotations, num_soa_tracks, &LerpRotation,
-       &SortingKeyLess<SortingQuaternionKey>);
-  Sort(sorting_scales, num_soa_tracks, &LerpScale,
-       &SortingKeyLess<SortingScaleKey>);
-
-  // Get all timepoints. Shall be done on sorting keys as time points might have
-  // been added during the process.
+  Sort(_keys.translations, num_soa_tracks, &LerpTranslation,
+       &SortingKeyLess<SortingTranslationKey>, scheduler);
+  Sort(_keys.rotations, num_soa_tracks, &LerpRotation,
+       &SortingKeyLess<SortingQuaternionKey>, scheduler);
+  Sort(_keys.scales, num_soa_tracks, &LerpScale,
+       &SortingKeyLess<SortingScaleKey>, scheduler);
+
+  // Get all timepoints. Shall be done on sorting keys as time points might
+  // have been added during the process.
   const ozz::vector<float>& time_points =
-      BuildTimePoints(sorting_translations, sorting_rotations, sorting_scales);
+      BuildTimePoints(_keys.translations, _keys.rotations, _keys.scales);
 
   // Maximum time points reached.
   if (time_points.size() > std::numeric_limits<uint16_t>::max()) {
@@ -516,31 +651,33 @@ unique_ptr<Animation> AnimationBuilder::operator()(
   }
 
   // Maximum number of keys reached.
-  if (sorting_translations.size() > std::numeric_limits<uint32_t>::max() &&
-      sorting_rotations.size() > std::numeric_limits<uint32_t>::max() &&
-      sorting_scales.size() > std::numeric_limits<uint32_t>::max()) {
+  if (_keys.translations.size() > std::numeric_limits<uint32_t>::max() &&
+      _keys.rotations.size() > std::numeric_limits<uint32_t>::max() &&
+      _keys.scales.size() > std::numeric_limits<uint32_t>::max()) {
     return nullptr;
   }
 
   // Build cache snaphots/iframes.
-  const auto& translation_ss =
-      BuildIFrames(make_span(sorting_translations), num_soa_tracks,
-                   iframe_interval, duration);
+  const auto& translation_ss = BuildIFrames(
+      make_span(_keys.translations), num_soa_tracks, iframe_interval,
+      _duration);
   const auto& rotation_ss = BuildIFrames(
-      make_span(sorting_rotations), num_soa_tracks, iframe_interval, duration);
-  const auto& scale_ss = BuildIFrames(make_span(sorting_scales), num_soa_tracks,
-                                      iframe_interval, duration);
+      make_span(_keys.rotations), num_soa_tracks, iframe_interval, _duration);
+  const auto& scale_ss = BuildIFrames(make_span(_keys.scales), num_soa_tracks,
+                                      iframe_interval, _duration);
 
   // Allocate animation members.
   const Animation::AllocateParams params{
-      _input.name.length(),
+      std::strlen(_name),
+      rig_signature.length(),
       time_points.size(),
-      sorting_translations.size(),
-      sorting_rotations.size(),
-      sorting_scales.size(),
+      _keys.translations.size(),
+      _keys.rotations.size(),
+      _keys.scales.size(),
       {translation_ss.entries.size(), translation_ss.desc.size()},
       {rotation_ss.entries.size(), rotation_ss.desc.size()},
-      {scale_ss.entries.size(), scale_ss.desc.size()}};
+      {scale_ss.entries.size(), scale_ss.desc.size()},
+      _num_tracks};
   animation->Allocate(params);
 
   CopyIFrames(translation_ss, animation->translations_ctrl_);
@@ -548,27 +685,214 @@ unique_ptr<Animation> AnimationBuilder::operator()(
   CopyIFrames(scale_ss, animation->scales_ctrl_);
 
   // Copy sorted keys to final animation.
-  Compress(make_span(time_points), make_span(sorting_translations),
+  Compress(make_span(time_points), make_span(_keys.translations),
            num_soa_tracks, make_span(animation->translations_values_),
-           animation->translations_ctrl_, &CompressFloat3);
-  Compress(make_span(time_points), make_span(sorting_rotations), num_soa_tracks,
+           animation->translations_ctrl_, &internal::CompressFloat3);
+  Compress(make_span(time_points), make_span(_keys.rotations), num_soa_tracks,
            make_span(animation->rotations_values_), animation->rotations_ctrl_,
-           &CompressQuaternion);
-  Compress(make_span(time_points), make_span(sorting_scales), num_soa_tracks,
+           &internal::CompressQuaternion);
+  Compress(make_span(time_points), make_span(_keys.scales), num_soa_tracks,
            make_span(animation->scales_values_), animation->scales_ctrl_,
-           &CompressFloat3);
+           &internal::CompressFloat3);
 
   // Converts timepoints to ratio and copy to animation. Must be done once
   // indices have been set.
   CopyTimePoints(make_span(time_points), inv_duration, animation->timepoints_);
 
+  // Flags actually animated tracks, allowing downstream consumers (blending,
+  // joint LOD, tooling...) to skip constant ones.
+  std::memset(animation->animated_joints_.data(), 0,
+              animation->animated_joints_.size_bytes());
+  FlagAnimatedTracks(_keys.translations, _num_tracks,
+                     animation->animated_joints_);
+  FlagAnimatedTracks(_keys.rotations, _num_tracks,
+                     animation->animated_joints_);
+  FlagAnimatedTracks(_keys.scales, _num_tracks, animation->animated_joints_);
+
+  // Classifies rotation tracks from the compressed keys, so sampling can
+  // dispatch each soa group to a specialized decompression kernel.
+  internal::ClassifyQuaternionTracks(
+      num_soa_tracks,
+      span<const internal::QuaternionKey>(animation->rotations_values_),
+      span<const uint16_t>(animation->rotations_ctrl_.previouses),
+      animation->rotation_classes_);
+
   // Copy animation's name.
   if (animation->name_) {
-    strcpy(animation->name_, _input.name.c_str());
+    strcpy(animation->name_, _name);
+  }
+
+  // Copy rig signature.
+  if (animation->rig_) {
+    strcpy(animation->rig_, rig_signature.c_str());
   }
 
   return animation;  // Success.
 }
+
+// Ensures _input's validity and allocates _animation.
+// An animation needs to have at least two key frames per joint, the first at
+// t = 0 and the last at t = duration. If at least one of those keys are not
+// in the RawAnimation then the builder creates it.
+unique_ptr<Animation> AnimationBuilder::operator()(
+    const RawAnimation& _input) const {
+  // Tests _raw_animation validity. When a scheduler is provided, tracks are
+  // validated concurrently, as walking every key of every track dominates
+  // validation time on big clips.
+  if (scheduler) {
+    if (_input.duration <= 0.f ||
+        _input.tracks.size() > Skeleton::kMaxJoints) {
+      return nullptr;
+    }
+    std::atomic<bool> valid(true);
+    scheduler->ParallelForFct(
+        0, static_cast<int>(_input.tracks.size()), 1,
+        [&](int _begin, int _end) {
+          bool local = true;
+          for (int i = _begin; i < _end && local; ++i) {
+            local = _input.tracks[i].Validate(_input.duration);
+          }
+          if (!local) {
+            valid.store(false, std::memory_order_relaxed);
+          }
+        });
+    if (!valid.load(std::memory_order_relaxed)) {
+      return nullptr;
+    }
+  } else if (!_input.Validate()) {
+    return nullptr;
+  }
+
+  // Attributes builder scratch allocations (vectors below), while the output
+  // animation tags its own buffer.
+  const memory::AllocationScope scope(memory::AllocationTag::kBuilder);
+
+  // Everything is fine, fills sorting keys and builds the animation.
+  const float duration = _input.duration;
+
+  // Gets tracks count. Can be safely casted to uint16_t as number of tracks as
+  // already been validated.
+  const uint16_t num_tracks = static_cast<uint16_t>(_input.num_tracks());
+  const uint16_t num_soa_tracks = Align(num_tracks, 4);
+
+  // Declares and preallocates tracks to sort.
+  size_t translations = 0, rotations = 0, scales = 0;
+  for (uint16_t i = 0; i < num_tracks; ++i) {
+    const RawAnimation::JointTrack& raw_track = _input.tracks[i];
+    translations += raw_track.translations.size() + 2;  // +2 because worst case
+    rotations += raw_track.rotations.size() + 2;        // needs to add the
+    scales += raw_track.scales.size() + 2;              // first and last keys.
+  }
+  SortingKeys keys;
+  keys.translations.reserve(translations);
+  keys.rotations.reserve(rotations);
+  keys.scales.reserve(scales);
+
+  // Filters RawAnimation keys and copies them to the output sorting structure.
+  bool looping = true;
+  uint16_t i = 0;
+  for (; i < num_tracks; ++i) {
+    const RawAnimation::JointTrack& raw_track = _input.tracks[i];
+    CopyRaw(raw_track.translations, i, duration, deduplicate, enforce_loop,
+            &looping, &keys.translations);
+    CopyRaw(raw_track.rotations, i, duration, deduplicate, enforce_loop,
+            &looping, &keys.rotations);
+    CopyRaw(raw_track.scales, i, duration, deduplicate, enforce_loop,
+            &looping, &keys.scales);
+  }
+
+  // Add enough identity keys to match soa requirements.
+  PushBackSoaPadding(i, num_soa_tracks, duration, &keys.translations,
+                     &keys.rotations, &keys.scales);
+
+  return Build(_input.name.c_str(), duration, num_tracks, keys, looping);
+}
+
+// Streaming build path. Pulls, validates and consumes one raw track at a
+// time, so a single track worth of raw keyframes is resident at any time,
+// besides the compact sorting buffers the regular path allocates too.
+unique_ptr<Animation> AnimationBuilder::operator()(
+    const char* _name, float _duration, int _num_tracks,
+    TrackProvider* _provider) const {
+  // Tests arguments validity, mirroring RawAnimation::Validate checks.
+  if (!_name || !_provider || _duration <= 0.f || _num_tracks < 0 ||
+      static_cast<size_t>(_num_tracks) > Skeleton::kMaxJoints) {
+    return nullptr;
+  }
+
+  // Attributes builder scratch allocations (vectors below), while the output
+  // animation tags its own buffer.
+  const memory::AllocationScope scope(memory::AllocationTag::kBuilder);
+
+  const uint16_t num_tracks = static_cast<uint16_t>(_num_tracks);
+  const uint16_t num_soa_tracks = Align(num_tracks, 4);
+
+  SortingKeys keys;
+
+  // Filters provided keys and copies them to the output sorting structure,
+  // one track at a time.
+  bool looping = true;
+  RawAnimation::JointTrack track;
+  for (uint16_t i = 0; i < num_tracks; ++i) {
+    track.translations.clear();
+    track.rotations.clear();
+    track.scales.clear();
+    if (!_provider->GetTrack(i, &track) || !track.Validate(_duration)) {
+      return nullptr;
+    }
+    CopyRaw(track.translations, i, _duration, deduplicate, enforce_loop,
+            &looping, &keys.translations);
+    CopyRaw(track.rotations, i, _duration, deduplicate, enforce_loop,
+            &looping, &keys.rotations);
+    CopyRaw(track.scales, i, _duration, deduplicate, enforce_loop,
+            &looping, &keys.scales);
+  }
+
+  // Add enough identity keys to match soa requirements.
+  PushBackSoaPadding(num_tracks, num_soa_tracks, _duration,
+                     &keys.translations, &keys.rotations, &keys.scales);
+
+  return Build(_name, _duration, num_tracks, keys, looping);
+}
+
+// Builds each animation independently, as operator() only touches local
+// state. Worker threads pull the next input from a shared atomic index, so
+// clips of uneven sizes balance naturally across threads.
+ozz::vector<unique_ptr<Animation>> AnimationBuilder::operator()(
+    const span<const RawAnimation>& _raw_animations,
+    size_t _num_threads) const {
+  ozz::vector<unique_ptr<Animation>> animations(_raw_animations.size());
+  if (_raw_animations.empty()) {
+    return animations;
+  }
+
+  // Finds the number of workers, bounded by the number of inputs. Note that
+  // hardware_concurrency can return 0 if it fails to detect it.
+  size_t num_threads =
+      _num_threads != 0 ? _num_threads : std::thread::hardware_concurrency();
+  num_threads = math::Max<size_t>(num_threads, 1);
+  num_threads = math::Min(num_threads, _raw_animations.size());
+
+  std::atomic<size_t> next(0);
+  auto build = [this, &_raw_animations, &animations, &next]() {
+    for (size_t i; (i = next++) < _raw_animations.size();) {
+      animations[i] = (*this)(_raw_animations[i]);
+    }
+  };
+
+  // This thread is a worker too, only spawns the num_threads - 1 others.
+  ozz::vector<std::thread> workers;
+  workers.reserve(num_threads - 1);
+  for (size_t i = 1; i < num_threads; ++i) {
+    workers.emplace_back(build);
+  }
+  build();
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  return animations;
+}
 }  // namespace offline
 }  // namespace animation
 }  // namespace ozz
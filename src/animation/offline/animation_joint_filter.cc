@@ -0,0 +1,98 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/offline/animation_joint_filter.h"
+
+#include "ozz/animation/offline/raw_animation.h"
+
+namespace ozz {
+namespace animation {
+namespace offline {
+
+namespace {
+// Collapses _src to a single key holding its first key's value, at t = 0. The
+// runtime builder completes constant tracks with the mandatory boundary keys.
+// Empty tracks remain empty (identity).
+template <typename _RawTrack>
+void Collapse(const _RawTrack& _src, _RawTrack* _dest) {
+  if (_src.empty()) {
+    return;
+  }
+  const typename _RawTrack::value_type first = {0.f, _src.front().value};
+  _dest->push_back(first);
+}
+}  // namespace
+
+bool AnimationJointFilter::operator()(const RawAnimation& _input,
+                                      RawAnimation* _output) const {
+  if (!_output) {
+    return false;
+  }
+  // Reset output animation to default.
+  *_output = RawAnimation();
+
+  // Validate animation.
+  if (!_input.Validate()) {
+    return false;
+  }
+
+  // Validates joint indices range.
+  for (size_t i = 0; i < joints.size(); ++i) {
+    if (joints[i] < 0 || joints[i] >= _input.num_tracks()) {
+      return false;
+    }
+  }
+
+  // Flags kept tracks.
+  ozz::vector<bool> kept(_input.tracks.size(), false);
+  for (size_t i = 0; i < joints.size(); ++i) {
+    kept[joints[i]] = true;
+  }
+
+  // Rebuilds output animation.
+  _output->name = _input.name;
+  _output->duration = _input.duration;
+  _output->tracks.resize(_input.tracks.size());
+
+  for (size_t i = 0; i < _input.tracks.size(); ++i) {
+    const RawAnimation::JointTrack& track_in = _input.tracks[i];
+    RawAnimation::JointTrack& track_out = _output->tracks[i];
+    if (kept[i]) {  // Kept tracks are copied as is.
+      track_out = track_in;
+    } else {  // Others are collapsed to a constant first-key value.
+      Collapse(track_in.translations, &track_out.translations);
+      Collapse(track_in.rotations, &track_out.rotations);
+      Collapse(track_in.scales, &track_out.scales);
+    }
+  }
+
+  // Output animation is always valid though.
+  return _output->Validate();
+}
+}  // namespace offline
+}  // namespace animation
+}  // namespace ozz
@@ -0,0 +1,83 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/offline/animation_lod_builder.h"
+
+#include <utility>
+
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/runtime/animation.h"
+
+namespace ozz {
+namespace animation {
+namespace offline {
+
+AnimationLodBuilder::AnimationLodBuilder() {
+  // Defaults to 3 resolutions: the full-resolution input, plus two levels at
+  // 4x and 16x the default optimizer tolerance.
+  const AnimationOptimizer::Setting default_setting;
+  levels.push_back(AnimationOptimizer::Setting(default_setting.tolerance * 4.f,
+                                               default_setting.distance));
+  levels.push_back(AnimationOptimizer::Setting(default_setting.tolerance * 16.f,
+                                               default_setting.distance));
+}
+
+ozz::vector<unique_ptr<Animation>> AnimationLodBuilder::operator()(
+    const RawAnimation& _raw_animation, const Skeleton& _skeleton) const {
+  ozz::vector<unique_ptr<Animation>> output;
+
+  // Level 0 is the input resolution, built as-is.
+  unique_ptr<Animation> level0 = builder(_raw_animation);
+  if (!level0) {
+    return output;
+  }
+  output.push_back(std::move(level0));
+
+  // Each level decimates the output of the previous one, nesting resolutions.
+  AnimationOptimizer optimizer;
+  optimizer.joints_setting_override = joints_setting_override;
+  RawAnimation current = _raw_animation;
+  for (size_t i = 0; i < levels.size(); ++i) {
+    optimizer.setting = levels[i];
+    RawAnimation decimated;
+    if (!optimizer(current, _skeleton, &decimated)) {
+      output.clear();
+      return output;
+    }
+    unique_ptr<Animation> level = builder(decimated);
+    if (!level) {
+      output.clear();
+      return output;
+    }
+    output.push_back(std::move(level));
+    current = std::move(decimated);
+  }
+  return output;
+}
+}  // namespace offline
+}  // namespace animation
+}  // namespace ozz
@@ -27,9 +27,12 @@
 
 #include "ozz/animation/offline/animation_optimizer.h"
 
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <functional>
+#include <limits>
+#include <thread>
 
 // Internal include file
 #define OZZ_INCLUDE_PRIVATE_HEADER  // Allows to include private headers.
@@ -239,6 +242,124 @@ class ScaleAdapter {
  private:
   float length_;
 };
+
+// Ranks keys in the order the Ramer-Douglas-Peucker recursion would select
+// them, recording for each key the biggest tolerance at which it's included.
+// Importances are nested: a key importance never exceeds its segment ends
+// ones, so thresholding them at any tolerance yields a consistent decimation.
+// This lets the tolerance search rank once and probe many tolerances at the
+// cost of a comparison per key, instead of a full decimation per probe.
+template <typename _Track, typename _Adapter>
+void RankKeys(const _Track& _src, const _Adapter& _adapter,
+              ozz::vector<float>* _importances) {
+  const float kAlways = std::numeric_limits<float>::max();
+  _importances->assign(_src.size(), kAlways);
+
+  // Not enough data to decimate anything.
+  if (_src.size() < 2) {
+    return;
+  }
+
+  // Stack of segments to process, as in Decimate.
+  typedef std::pair<size_t, size_t> Segment;
+  ozz::stack<Segment> segments;
+  segments.push(Segment(0, _src.size() - 1));
+
+  while (!segments.empty()) {
+    const Segment segment = segments.top();
+    segments.pop();
+
+    // Looks for the furthest point from the segment.
+    float max = -1.f;
+    size_t candidate = segment.first;
+    typename _Track::const_reference left = _src[segment.first];
+    typename _Track::const_reference right = _src[segment.second];
+    for (size_t i = segment.first + 1; i < segment.second; ++i) {
+      typename _Track::const_reference test = _src[i];
+      if (!_adapter.Decimable(test)) {
+        candidate = i;
+        max = kAlways;
+        break;
+      } else {
+        const float distance =
+            _adapter.Distance(_adapter.Lerp(left, right, test), test);
+        if (distance > max) {
+          max = distance;
+          candidate = i;
+        }
+      }
+    }
+
+    // Records candidate importance, nested below its segment ends ones, and
+    // pushes the 2 new segments (before and after the new point).
+    if (candidate != segment.first) {
+      (*_importances)[candidate] =
+          math::Min(max, math::Min((*_importances)[segment.first],
+                                   (*_importances)[segment.second]));
+      if (candidate - segment.first > 1) {
+        segments.push(Segment(segment.first, candidate));
+      }
+      if (segment.second - candidate > 1) {
+        segments.push(Segment(candidate, segment.second));
+      }
+    }
+  }
+}
+
+// Counts keys that a _tolerance threshold on ranked importances retains,
+// replicating Decimate output size, last-key-if-constant removal included.
+template <typename _Track, typename _Adapter>
+size_t CountAtTolerance(const _Track& _src,
+                        const ozz::vector<float>& _importances,
+                        const _Adapter& _adapter, float _tolerance) {
+  if (_src.size() < 2) {
+    return _src.size();
+  }
+  size_t count = 0;
+  size_t last = 0, penultimate = 0;
+  for (size_t i = 0; i < _src.size(); ++i) {
+    if (_importances[i] > _tolerance) {
+      ++count;
+      penultimate = last;
+      last = i;
+    }
+  }
+  // Removes last key if constant.
+  if (count > 1 && _adapter.Decimable(_src[last]) &&
+      _adapter.Distance(_src[penultimate], _src[last]) <= _tolerance) {
+    --count;
+  }
+  return count;
+}
+
+// Extracts keys that a _tolerance threshold on ranked importances retains.
+// Must match CountAtTolerance.
+template <typename _Track, typename _Adapter>
+void ExtractAtTolerance(const _Track& _src,
+                        const ozz::vector<float>& _importances,
+                        const _Adapter& _adapter, float _tolerance,
+                        _Track* _dest) {
+  if (_src.size() < 2) {
+    *_dest = _src;
+    return;
+  }
+  _dest->clear();
+  for (size_t i = 0; i < _src.size(); ++i) {
+    if (_importances[i] > _tolerance) {
+      _dest->push_back(_src[i]);
+    }
+  }
+  // Removes last key if constant.
+  if (_dest->size() > 1) {
+    typename _Track::const_iterator end = _dest->end();
+    typename _Track::const_reference last = *(--end);
+    typename _Track::const_reference penultimate = *(--end);
+    if (_adapter.Decimable(last) &&
+        _adapter.Distance(penultimate, last) <= _tolerance) {
+      _dest->pop_back();
+    }
+  }
+}
 }  // namespace
 
 bool AnimationOptimizer::operator()(const RawAnimation& _input,
@@ -270,27 +391,224 @@ bool AnimationOptimizer::operator()(const RawAnimation& _input,
   _output->duration = _input.duration;
   _output->tracks.resize(num_tracks);
 
+  // Joints are decimated independently: hierarchical specs were fully
+  // precomputed by HierarchyBuilder, and each joint only reads its own input
+  // track and writes its own output track. This allows to dispatch joints
+  // across worker threads, pulling the next one from a shared atomic index.
+  // The result doesn't depend on scheduling.
+  // Work items are individual tracks (joint x component) rather than whole
+  // joints, so that the few heavy tracks of an unbalanced rig (facialocap...)
+  // don't serialize behind a single worker.
+  std::atomic<int> next(0);
+  auto decimate = [&_input, &_skeleton, &hierarchy, &next, num_tracks,
+                   _output]() {
+    for (int item; (item = next++) < num_tracks * 3;) {
+      const int i = item / 3;
+      const RawAnimation::JointTrack& input = _input.tracks[i];
+      RawAnimation::JointTrack& output = _output->tracks[i];
+
+      // Gets joint specs back.
+      const float joint_length = hierarchy.specs[i].length;
+      const int parent = _skeleton.joint_parents()[i];
+      const float parent_scale =
+          (parent != Skeleton::kNoParent) ? hierarchy.specs[parent].scale : 1.f;
+      const float tolerance = hierarchy.specs[i].tolerance;
+
+      // Filters independently T, R and S tracks.
+      switch (item % 3) {
+        case 0: {
+          // This joint translation is affected by parent scale.
+          const PositionAdapter tadap(parent_scale);
+          Decimate(input.translations, tadap, tolerance, &output.translations);
+          break;
+        }
+        case 1: {
+          // This joint rotation affects children translations/length.
+          const RotationAdapter radap(joint_length);
+          Decimate(input.rotations, radap, tolerance, &output.rotations);
+          break;
+        }
+        default: {
+          // This joint scale affects children translations/length.
+          const ScaleAdapter sadap(joint_length);
+          Decimate(input.scales, sadap, tolerance, &output.scales);
+          break;
+        }
+      }
+    }
+  };
+
+  // This thread is a worker too, only spawns the others. Note that
+  // hardware_concurrency can return 0 if it fails to detect it.
+  const size_t num_threads = math::Clamp<size_t>(
+      1, std::thread::hardware_concurrency(), math::Max(num_tracks, 1));
+  ozz::vector<std::thread> workers;
+  workers.reserve(num_threads - 1);
+  for (size_t i = 1; i < num_threads; ++i) {
+    workers.emplace_back(decimate);
+  }
+  decimate();
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  // Output animation is always valid though.
+  return _output->Validate();
+}
+
+bool AnimationOptimizer::operator()(const RawAnimation& _input,
+                                    const Skeleton& _skeleton,
+                                    size_t _max_keyframes,
+                                    RawAnimation* _output,
+                                    float* _factor) const {
+  if (!_output) {
+    return false;
+  }
+  // Reset output animation to default.
+  *_output = RawAnimation();
+
+  // Validate animation.
+  if (!_input.Validate()) {
+    return false;
+  }
+
+  const int num_tracks = _input.num_tracks();
+
+  // Validates the skeleton matches the animation.
+  if (num_tracks != _skeleton.num_joints()) {
+    return false;
+  }
+
+  // Hierarchy analysis is shared by all search iterations.
+  const HierarchyBuilder hierarchy(&_input, &_skeleton, this);
+
+  // Ranks every track once, the expensive part of the search, dispatched
+  // across worker threads like fixed tolerance decimation. Probing a
+  // tolerance afterward only costs a comparison per key.
+  ozz::vector<ozz::vector<float>> importances(num_tracks * 3);
+  std::atomic<int> next(0);
+  auto rank = [&_input, &_skeleton, &hierarchy, &importances, &next,
+               num_tracks]() {
+    for (int item; (item = next++) < num_tracks * 3;) {
+      const int i = item / 3;
+      const RawAnimation::JointTrack& input = _input.tracks[i];
+      const float joint_length = hierarchy.specs[i].length;
+      const int parent = _skeleton.joint_parents()[i];
+      const float parent_scale =
+          (parent != Skeleton::kNoParent) ? hierarchy.specs[parent].scale : 1.f;
+      switch (item % 3) {
+        case 0: {
+          const PositionAdapter tadap(parent_scale);
+          RankKeys(input.translations, tadap, &importances[item]);
+          break;
+        }
+        case 1: {
+          const RotationAdapter radap(joint_length);
+          RankKeys(input.rotations, radap, &importances[item]);
+          break;
+        }
+        default: {
+          const ScaleAdapter sadap(joint_length);
+          RankKeys(input.scales, sadap, &importances[item]);
+          break;
+        }
+      }
+    }
+  };
+  const size_t num_threads = math::Clamp<size_t>(
+      1, std::thread::hardware_concurrency(), math::Max(num_tracks, 1));
+  ozz::vector<std::thread> workers;
+  workers.reserve(num_threads - 1);
+  for (size_t i = 1; i < num_threads; ++i) {
+    workers.emplace_back(rank);
+  }
+  rank();
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  // Counts keyframes that decimating at scaled tolerances would retain.
+  auto count_keyframes = [&_input, &_skeleton, &hierarchy, &importances,
+                          num_tracks](float _scale) {
+    size_t total = 0;
+    for (int i = 0; i < num_tracks; ++i) {
+      const RawAnimation::JointTrack& input = _input.tracks[i];
+      const float tolerance = hierarchy.specs[i].tolerance * _scale;
+      const float joint_length = hierarchy.specs[i].length;
+      const int parent = _skeleton.joint_parents()[i];
+      const float parent_scale =
+          (parent != Skeleton::kNoParent) ? hierarchy.specs[parent].scale : 1.f;
+      const PositionAdapter tadap(parent_scale);
+      total += CountAtTolerance(input.translations, importances[i * 3 + 0],
+                                tadap, tolerance);
+      const RotationAdapter radap(joint_length);
+      total += CountAtTolerance(input.rotations, importances[i * 3 + 1], radap,
+                                tolerance);
+      const ScaleAdapter sadap(joint_length);
+      total += CountAtTolerance(input.scales, importances[i * 3 + 2], sadap,
+                                tolerance);
+    }
+    return total;
+  };
+
+  // Bisects the scale factor applied to settings tolerances. 0 is lossless
+  // decimation: only exactly interpolable keys are removed.
+  float factor = 0.f;
+  if (count_keyframes(0.f) > _max_keyframes) {
+    // Grows the upper bound until the budget fits. It might never fit, if the
+    // budget is below what full decimation can reach.
+    float lo = 0.f, hi = 1.f;
+    bool fits = false;
+    for (int i = 0; i < 40; ++i, lo = hi, hi *= 2.f) {
+      if (count_keyframes(hi) <= _max_keyframes) {
+        fits = true;
+        break;
+      }
+    }
+    if (!fits) {
+      // Budget is unreachable, decimates as much as possible.
+      factor = hi;
+    } else {
+      // Bisects down to the smallest factor that honors the budget.
+      for (int i = 0; i < 32; ++i) {
+        const float mid = (lo + hi) * .5f;
+        if (count_keyframes(mid) <= _max_keyframes) {
+          hi = mid;
+        } else {
+          lo = mid;
+        }
+      }
+      factor = hi;
+    }
+  }
+
+  // Rebuilds output animation from the selected factor and ranked keys.
+  _output->name = _input.name;
+  _output->duration = _input.duration;
+  _output->tracks.resize(num_tracks);
   for (int i = 0; i < num_tracks; ++i) {
     const RawAnimation::JointTrack& input = _input.tracks[i];
     RawAnimation::JointTrack& output = _output->tracks[i];
-
-    // Gets joint specs back.
+    const float tolerance = hierarchy.specs[i].tolerance * factor;
     const float joint_length = hierarchy.specs[i].length;
     const int parent = _skeleton.joint_parents()[i];
     const float parent_scale =
         (parent != Skeleton::kNoParent) ? hierarchy.specs[parent].scale : 1.f;
-    const float tolerance = hierarchy.specs[i].tolerance;
-
-    // Filters independently T, R and S tracks.
-    // This joint translation is affected by parent scale.
     const PositionAdapter tadap(parent_scale);
-    Decimate(input.translations, tadap, tolerance, &output.translations);
-    // This joint rotation affects children translations/length.
+    ExtractAtTolerance(input.translations, importances[i * 3 + 0], tadap,
+                       tolerance, &output.translations);
     const RotationAdapter radap(joint_length);
-    Decimate(input.rotations, radap, tolerance, &output.rotations);
-    // This joint scale affects children translations/length.
+    ExtractAtTolerance(input.rotations, importances[i * 3 + 1], radap,
+                       tolerance, &output.rotations);
     const ScaleAdapter sadap(joint_length);
-    Decimate(input.scales, sadap, tolerance, &output.scales);
+    ExtractAtTolerance(input.scales, importances[i * 3 + 2], sadap, tolerance,
+                       &output.scales);
+  }
+
+  // Outputs the factor the search selected, so callers can serialize it and
+  // warm-start a later import.
+  if (_factor) {
+    *_factor = factor;
   }
 
   // Output animation is always valid though.
@@ -36,6 +36,7 @@
 #include "ozz/base/log.h"
 #include "ozz/base/maths/math_ex.h"
 #include "ozz/base/maths/transform.h"
+#include "ozz/base/scheduler.h"
 
 namespace ozz {
 namespace animation {
@@ -100,7 +101,8 @@ SamplingInfo ExtractSamplingInfo(FbxScene* _scene, FbxAnimStack* _anim_stack,
 }
 
 bool ExtractAnimation(FbxSceneLoader& _scene_loader, const SamplingInfo& _info,
-                      const Skeleton& _skeleton, RawAnimation* _animation) {
+                      const Skeleton& _skeleton, Scheduler* _scheduler,
+                      RawAnimation* _animation) {
   FbxScene* scene = _scene_loader.scene();
   assert(scene);
 
@@ -183,66 +185,90 @@ bool ExtractAnimation(FbxSceneLoader& _scene_loader, const SamplingInfo& _info,
     }
   }
 
+  // From this point on the sdk isn't accessed anymore, only the extracted
+  // world matrices are processed. This math heavy post-pass is independent
+  // per joint, so it's distributed across joints with _scheduler. The sdk
+  // evaluation above has to remain serial, as FbxAnimEvaluator caches
+  // evaluation state per scene and doesn't support concurrent queries.
+
   // Builds world inverse matrices.
   ozz::vector<ozz::vector<ozz::math::Float4x4>> world_inv_matrices;
   world_inv_matrices.resize(_skeleton.num_joints());
-  for (int i = 0; i < _skeleton.num_joints(); i++) {
-    const ozz::vector<math::Float4x4>& node_world_matrices = world_matrices[i];
-    ozz::vector<math::Float4x4>& node_world_inv_matrices =
-        world_inv_matrices[i];
-    node_world_inv_matrices.resize(fixed_it.num_keys());
-    for (size_t p = 0; p < fixed_it.num_keys(); ++p) {
-      node_world_inv_matrices[p] = Invert(node_world_matrices[p]);
-    }
-  }
+  _scheduler->ParallelForFct(
+      0, _skeleton.num_joints(), 1, [&](int _begin, int _end) {
+        for (int i = _begin; i < _end; i++) {
+          const ozz::vector<math::Float4x4>& node_world_matrices =
+              world_matrices[i];
+          ozz::vector<math::Float4x4>& node_world_inv_matrices =
+              world_inv_matrices[i];
+          node_world_inv_matrices.resize(fixed_it.num_keys());
+          for (size_t p = 0; p < fixed_it.num_keys(); ++p) {
+            node_world_inv_matrices[p] = Invert(node_world_matrices[p]);
+          }
+        }
+      });
 
   // Builds local space animation tracks.
   // Allocates all tracks with the same number of joints as the skeleton.
   // Tracks that would not be found will be set to skeleton rest-pose
   // transformation.
+  // Failures are collected per joint, as joints are converted concurrently.
   _animation->tracks.resize(_skeleton.num_joints());
+  ozz::vector<char> succeeded(_skeleton.num_joints(), 1);
+  _scheduler->ParallelForFct(
+      0, _skeleton.num_joints(), 1, [&](int _begin, int _end) {
+        for (int i = _begin; i < _end; i++) {
+          RawAnimation::JointTrack& track = _animation->tracks[i];
+          track.rotations.resize(fixed_it.num_keys());
+          track.translations.resize(fixed_it.num_keys());
+          track.scales.resize(fixed_it.num_keys());
+
+          const int16_t parent = _skeleton.joint_parents()[i];
+          ozz::vector<math::Float4x4>& node_world_matrices = world_matrices[i];
+          ozz::vector<math::Float4x4>& node_world_inv_matrices =
+              world_inv_matrices[parent != Skeleton::kNoParent ? parent : 0];
+
+          for (size_t n = 0; n < fixed_it.num_keys(); ++n) {
+            // Builds local matrix;
+            math::Float4x4 local_matrix;
+            if (parent != Skeleton::kNoParent) {
+              local_matrix =
+                  node_world_inv_matrices[n] * node_world_matrices[n];
+            } else {
+              local_matrix = node_world_matrices[n];
+            }
+
+            // Convert to transform structure.
+            math::SimdFloat4 t, q, s;
+            if (!ToAffine(local_matrix, &t, &q, &s)) {
+              ozz::log::Err()
+                  << "Failed to extract animation transform for joint\""
+                  << _skeleton.joint_names()[i] << "\" at t = " << times[n]
+                  << "s." << std::endl;
+              succeeded[i] = 0;
+              break;
+            }
+
+            ozz::math::Transform transform;
+            math::Store3PtrU(t, &transform.translation.x);
+            math::StorePtrU(math::Normalize4(q), &transform.rotation.x);
+            math::Store3PtrU(s, &transform.scale.x);
+
+            // Fills corresponding track.
+            const float time = times[n];
+            const RawAnimation::TranslationKey tkey = {time,
+                                                       transform.translation};
+            track.translations[n] = tkey;
+            const RawAnimation::RotationKey rkey = {time, transform.rotation};
+            track.rotations[n] = rkey;
+            const RawAnimation::ScaleKey skey = {time, transform.scale};
+            track.scales[n] = skey;
+          }
+        }
+      });
   for (int i = 0; i < _skeleton.num_joints(); i++) {
-    RawAnimation::JointTrack& track = _animation->tracks[i];
-    track.rotations.resize(fixed_it.num_keys());
-    track.translations.resize(fixed_it.num_keys());
-    track.scales.resize(fixed_it.num_keys());
-
-    const int16_t parent = _skeleton.joint_parents()[i];
-    ozz::vector<math::Float4x4>& node_world_matrices = world_matrices[i];
-    ozz::vector<math::Float4x4>& node_world_inv_matrices =
-        world_inv_matrices[parent != Skeleton::kNoParent ? parent : 0];
-
-    for (size_t n = 0; n < fixed_it.num_keys(); ++n) {
-      // Builds local matrix;
-      math::Float4x4 local_matrix;
-      if (parent != Skeleton::kNoParent) {
-        local_matrix = node_world_inv_matrices[n] * node_world_matrices[n];
-      } else {
-        local_matrix = node_world_matrices[n];
-      }
-
-      // Convert to transform structure.
-      math::SimdFloat4 t, q, s;
-      if (!ToAffine(local_matrix, &t, &q, &s)) {
-        ozz::log::Err() << "Failed to extract animation transform for joint\""
-                        << _skeleton.joint_names()[i]
-                        << "\" at t = " << times[n] << "s." << std::endl;
-        return false;
-      }
-
-      ozz::math::Transform transform;
-      math::Store3PtrU(t, &transform.translation.x);
-      math::StorePtrU(math::Normalize4(q), &transform.rotation.x);
-      math::Store3PtrU(s, &transform.scale.x);
-
-      // Fills corresponding track.
-      const float time = times[n];
-      const RawAnimation::TranslationKey tkey = {time, transform.translation};
-      track.translations[n] = tkey;
-      const RawAnimation::RotationKey rkey = {time, transform.rotation};
-      track.rotations[n] = rkey;
-      const RawAnimation::ScaleKey skey = {time, transform.scale};
-      track.scales[n] = skey;
+    if (!succeeded[i]) {
+      return false;
     }
   }
   return _animation->Validate();
@@ -657,7 +683,10 @@ bool ExtractAnimation(const char* _animation_name,
     // Setup Fbx animation evaluator.
     scene->SetCurrentAnimationStack(anim_stack);
 
-    success = ExtractAnimation(_scene_loader, info, _skeleton, _animation);
+    // Distributes the math post-pass of the extraction across joints.
+    ThreadPoolScheduler scheduler;
+    success = ExtractAnimation(_scene_loader, info, _skeleton, &scheduler,
+                               _animation);
   }
 
   // Clears output if something failed during import, avoids partial data.
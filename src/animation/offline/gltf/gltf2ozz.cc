@@ -106,6 +106,48 @@ bool FixupNames(_VectorType& _data, const char* _pretty_name,
   return true;
 }
 
+// Releases the memory of buffers that aren't referenced by any animation
+// sampler accessor. Mesh, image and skinning data usually dominate document
+// size but are never sampled during import, so freeing them right after
+// parsing keeps resident memory proportional to animation data for the whole
+// import. Skeleton import only reads node hierarchy and transforms, which
+// don't live in buffers.
+void ReleaseUnusedBuffers(tinygltf::Model* _model) {
+  // Collects the indices of buffers backing animation sampler accessors.
+  ozz::set<int> used;
+  for (const tinygltf::Animation& animation : _model->animations) {
+    for (const tinygltf::AnimationSampler& sampler : animation.samplers) {
+      for (const int accessor_index : {sampler.input, sampler.output}) {
+        if (accessor_index < 0) {
+          continue;
+        }
+        const tinygltf::Accessor& accessor = _model->accessors[accessor_index];
+        if (accessor.bufferView < 0) {
+          continue;
+        }
+        used.insert(_model->bufferViews[accessor.bufferView].buffer);
+      }
+    }
+  }
+
+  // Frees the remaining ones.
+  size_t released = 0;
+  for (size_t i = 0; i < _model->buffers.size(); ++i) {
+    if (used.count(static_cast<int>(i)) != 0) {
+      continue;
+    }
+    std::vector<unsigned char>& data = _model->buffers[i].data;
+    released += data.size();
+    std::vector<unsigned char>().swap(data);
+  }
+
+  if (released != 0) {
+    ozz::log::LogV() << "Released " << released
+                     << " bytes of buffer data unused by animation import."
+                     << std::endl;
+  }
+}
+
 // Returns the address of a gltf buffer given an accessor.
 // Performs basic checks to ensure the data is in the correct format
 template <typename T>
@@ -518,6 +560,12 @@ class GltfImporter : public ozz::animation::offline::OzzImporter {
       success &= FixupNames(m_model.animations, "Animation", "animation_");
     }
 
+    if (success) {
+      // Drops buffer data that animation import will never sample, so peak
+      // resident memory tracks animation data rather than document size.
+      ReleaseUnusedBuffers(&m_model);
+    }
+
     return success;
   }
 
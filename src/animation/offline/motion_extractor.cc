@@ -0,0 +1,172 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/offline/motion_extractor.h"
+
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/offline/raw_track.h"
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/animation/runtime/skeleton_utils.h"
+#include "ozz/base/maths/transform.h"
+
+namespace ozz {
+namespace animation {
+namespace offline {
+
+namespace {
+
+// Selects extracted components of _delta, leaving others to 0.
+math::Float3 Select(const MotionExtractor::Settings& _settings,
+                    const math::Float3& _delta) {
+  return math::Float3(_settings.x ? _delta.x : 0.f, _settings.y ? _delta.y : 0.f,
+                      _settings.z ? _delta.z : 0.f);
+}
+
+// Extracts the twist of _q around _axis, aka the part of the rotation that
+// cannot be represented with an axis orthogonal to _axis.
+math::Quaternion Twist(const math::Quaternion& _q, const math::Float3& _axis) {
+  const float proj = _q.x * _axis.x + _q.y * _axis.y + _q.z * _axis.z;
+  const math::Quaternion twist(_axis.x * proj, _axis.y * proj, _axis.z * proj,
+                               _q.w);
+  // Falls back to identity when _q is a half turn orthogonal to _axis, which
+  // has no twist component.
+  return NormalizeSafe(twist, math::Quaternion::identity());
+}
+}  // namespace
+
+bool MotionExtractor::operator()(const RawAnimation& _input,
+                                 const Skeleton& _skeleton,
+                                 RawFloat3Track* _motion_position,
+                                 RawQuaternionTrack* _motion_rotation,
+                                 RawAnimation* _output) const {
+  if (!_motion_position || !_motion_rotation || !_output) {
+    return false;
+  }
+
+  // Resets motion tracks.
+  *_motion_position = RawFloat3Track();
+  *_motion_rotation = RawQuaternionTrack();
+
+  // Validates animation and root joint index, which must be valid for both
+  // the animation and the skeleton (used as rest pose reference).
+  if (!_input.Validate() || root_joint < 0 ||
+      root_joint >= static_cast<int>(_input.tracks.size()) ||
+      root_joint >= _skeleton.num_joints()) {
+    *_output = RawAnimation();
+    return false;
+  }
+
+  // Copies input to output (supports in-place extraction), then removes
+  // extracted motion from the output root track.
+  *_output = _input;
+  RawAnimation::JointTrack& root_track = _output->tracks[root_joint];
+
+  const math::Transform rest_pose =
+      GetJointLocalRestPose(_skeleton, root_joint);
+
+  // Position channel. An empty root track isn't animated, hence there's no
+  // motion to extract.
+  const RawAnimation::JointTrack::Translations& translations =
+      root_track.translations;
+  if (translations.empty()) {
+    const RawFloat3Track::Keyframe key = {RawTrackInterpolation::kLinear, 0.f,
+                                          math::Float3::zero()};
+    _motion_position->keyframes.push_back(key);
+  } else {
+    // Selects the reference position motion is expressed from.
+    math::Float3 position_reference = math::Float3::zero();
+    switch (position_settings.reference) {
+      case Reference::kSkeleton:
+        position_reference = rest_pose.translation;
+        break;
+      case Reference::kAnimation:
+        position_reference = translations.front().value;
+        break;
+      default:
+        break;
+    }
+
+    _motion_position->keyframes.reserve(translations.size());
+    for (size_t i = 0; i < translations.size(); ++i) {
+      RawAnimation::TranslationKey& src = root_track.translations[i];
+      const math::Float3 motion =
+          Select(position_settings, src.value - position_reference);
+      const RawFloat3Track::Keyframe key = {RawTrackInterpolation::kLinear,
+                                            src.time / _input.duration, motion};
+      _motion_position->keyframes.push_back(key);
+      src.value = src.value - motion;
+    }
+  }
+
+  // Rotation channel. The twist axis is built from selected components, no
+  // component means no rotation extraction.
+  const math::Float3 axis(rotation_settings.x ? 1.f : 0.f,
+                          rotation_settings.y ? 1.f : 0.f,
+                          rotation_settings.z ? 1.f : 0.f);
+  const RawAnimation::JointTrack::Rotations& rotations = root_track.rotations;
+  if (rotations.empty() || Length(axis) == 0.f) {
+    const RawQuaternionTrack::Keyframe key = {
+        RawTrackInterpolation::kLinear, 0.f, math::Quaternion::identity()};
+    _motion_rotation->keyframes.push_back(key);
+  } else {
+    const math::Float3 twist_axis = Normalize(axis);
+
+    // Selects the reference rotation motion is expressed from, reduced to its
+    // twist component.
+    math::Quaternion rotation_reference = math::Quaternion::identity();
+    switch (rotation_settings.reference) {
+      case Reference::kSkeleton:
+        rotation_reference = Twist(rest_pose.rotation, twist_axis);
+        break;
+      case Reference::kAnimation:
+        rotation_reference = Twist(rotations.front().value, twist_axis);
+        break;
+      default:
+        break;
+    }
+
+    _motion_rotation->keyframes.reserve(rotations.size());
+    for (size_t i = 0; i < rotations.size(); ++i) {
+      RawAnimation::RotationKey& src = root_track.rotations[i];
+      const math::Quaternion motion =
+          Twist(src.value, twist_axis) * Conjugate(rotation_reference);
+      const RawQuaternionTrack::Keyframe key = {
+          RawTrackInterpolation::kLinear, src.time / _input.duration, motion};
+      _motion_rotation->keyframes.push_back(key);
+      // Remainder rotation, so that motion * remainder reconstructs the
+      // original rotation.
+      src.value = Conjugate(motion) * src.value;
+    }
+  }
+
+  // Output animation and motion tracks are valid by construction.
+  return _output->Validate() && _motion_position->Validate() &&
+         _motion_rotation->Validate();
+}
+}  // namespace offline
+}  // namespace animation
+}  // namespace ozz
@@ -0,0 +1,137 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/offline/paged_animation_builder.h"
+
+#include <cmath>
+
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/offline/raw_animation_utils.h"
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/animation/runtime/paged_animation.h"
+#include "ozz/base/maths/math_ex.h"
+#include "ozz/base/maths/transform.h"
+
+namespace ozz {
+namespace animation {
+namespace offline {
+
+namespace {
+// Extracts from _src the keys of a page time window [_begin, _end], remapped
+// to page local times. Boundary keyframes are sampled (_begin_value and
+// _end_value) so the page interpolates exactly as the source clip. An empty
+// channel stays empty, preserving rest pose semantics per page.
+template <typename _Key>
+void SlicePageChannel(const ozz::vector<_Key>& _src, float _begin, float _end,
+                      const typename _Key::Value& _begin_value,
+                      const typename _Key::Value& _end_value,
+                      ozz::vector<_Key>* _dest) {
+  if (_src.empty()) {
+    return;
+  }
+  const _Key first = {0.f, _begin_value};
+  _dest->push_back(first);
+  for (const _Key& key : _src) {
+    if (key.time > _begin && key.time < _end) {
+      const _Key local = {key.time - _begin, key.value};
+      _dest->push_back(local);
+    }
+  }
+  const _Key last = {_end - _begin, _end_value};
+  _dest->push_back(last);
+}
+}  // namespace
+
+PagedAnimationBuilder::PagedAnimationBuilder() : page_duration(10.f) {}
+
+unique_ptr<PagedAnimation> PagedAnimationBuilder::operator()(
+    const RawAnimation& _input) const {
+  unique_ptr<PagedAnimation> paged;
+
+  // Tests _input validity and page duration.
+  if (!_input.Validate() || !(page_duration > 0.f)) {
+    return paged;
+  }
+
+  const int num_tracks = _input.num_tracks();
+  size_t num_pages = math::Max<size_t>(
+      1, static_cast<size_t>(std::ceil(_input.duration / page_duration)));
+  // Guards against a rounded up page count that would leave an empty last
+  // page.
+  for (; num_pages > 1 && (num_pages - 1) * page_duration >= _input.duration;
+       --num_pages) {
+  }
+
+  paged = make_unique<PagedAnimation>();
+  paged->duration_ = _input.duration;
+  paged->page_duration_ = page_duration;
+  paged->num_tracks_ = num_tracks;
+  paged->pages_.reserve(num_pages);
+
+  for (size_t i = 0; i < num_pages; ++i) {
+    const float begin = i * page_duration;
+    const float end = math::Min(begin + page_duration, _input.duration);
+
+    // Slices the source clip over the page time window.
+    RawAnimation page_raw;
+    page_raw.name = _input.name;
+    page_raw.duration = end - begin;
+    page_raw.tracks.resize(_input.tracks.size());
+    for (int j = 0; j < num_tracks; ++j) {
+      const RawAnimation::JointTrack& track = _input.tracks[j];
+      RawAnimation::JointTrack& page_track = page_raw.tracks[j];
+
+      // Samples boundary values at page transitions.
+      math::Transform begin_transform;
+      math::Transform end_transform;
+      if (!SampleTrack(track, begin, &begin_transform) ||
+          !SampleTrack(track, end, &end_transform)) {
+        return nullptr;
+      }
+
+      SlicePageChannel(track.translations, begin, end,
+                       begin_transform.translation, end_transform.translation,
+                       &page_track.translations);
+      SlicePageChannel(track.rotations, begin, end, begin_transform.rotation,
+                       end_transform.rotation, &page_track.rotations);
+      SlicePageChannel(track.scales, begin, end, begin_transform.scale,
+                       end_transform.scale, &page_track.scales);
+    }
+
+    // Compiles the page to its runtime format.
+    unique_ptr<Animation> page = builder(page_raw);
+    if (!page) {
+      return nullptr;
+    }
+    paged->pages_.push_back(std::move(*page));
+  }
+
+  return paged;
+}
+}  // namespace offline
+}  // namespace animation
+}  // namespace ozz
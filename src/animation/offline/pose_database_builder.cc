@@ -0,0 +1,207 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/offline/pose_database_builder.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/offline/raw_animation_utils.h"
+#include "ozz/animation/runtime/pose_database.h"
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/maths/simd_math.h"
+#include "ozz/base/maths/transform.h"
+
+namespace ozz {
+namespace animation {
+namespace offline {
+
+namespace {
+
+// One database entry before kd-tree ordering.
+struct PoseEntry {
+  uint16_t animation;
+  float ratio;
+};
+
+// Compares entries along one feature dimension, used by kd-tree splits.
+struct PoseFeatureLess {
+  bool operator()(int _a, int _b) const {
+    return features[_a * num_features + dim] <
+           features[_b * num_features + dim];
+  }
+  const float* features;
+  int num_features;
+  int dim;
+};
+
+// Recursively orders entry indices [_begin, _end) as an implicit kd-tree:
+// the median of a range is the node, the split dimension cycles with depth.
+void SortPoseKdRange(const float* _features, int _num_features, int* _begin,
+                     int* _end, int _depth) {
+  if (_end - _begin <= 1) {
+    return;
+  }
+  int* median = _begin + (_end - _begin) / 2;
+  const PoseFeatureLess less = {_features, _num_features,
+                                _depth % _num_features};
+  std::nth_element(_begin, median, _end, less);
+  SortPoseKdRange(_features, _num_features, _begin, median, _depth + 1);
+  SortPoseKdRange(_features, _num_features, median + 1, _end, _depth + 1);
+}
+
+// Computes the model-space position of every tracked joint for the local
+// pose _locals, composing transformations up the hierarchy.
+void ComputeJointPositions(const Skeleton& _skeleton,
+                           const ozz::vector<math::Transform>& _locals,
+                           const span<const uint16_t>& _joints,
+                           ozz::vector<math::Float4x4>* _models,
+                           float* _positions) {
+  const span<const int16_t>& parents = _skeleton.joint_parents();
+  for (int i = 0; i < _skeleton.num_joints(); ++i) {
+    const math::Transform& local = _locals[i];
+    const math::Float4x4 local_matrix = math::Float4x4::FromAffine(
+        math::simd_float4::Load3PtrU(&local.translation.x),
+        math::simd_float4::LoadPtrU(&local.rotation.x),
+        math::simd_float4::Load3PtrU(&local.scale.x));
+    const int16_t parent = parents[i];
+    (*_models)[i] = parent == Skeleton::kNoParent
+                        ? local_matrix
+                        : (*_models)[parent] * local_matrix;
+  }
+  for (size_t j = 0; j < _joints.size(); ++j) {
+    math::Store3PtrU((*_models)[_joints[j]].cols[3], _positions + j * 3);
+  }
+}
+}  // namespace
+
+PoseDatabaseBuilder::PoseDatabaseBuilder() : sample_rate(30.f) {}
+
+unique_ptr<PoseDatabase> PoseDatabaseBuilder::operator()(
+    const Skeleton& _skeleton,
+    const span<const RawAnimation* const>& _animations) const {
+  unique_ptr<PoseDatabase> database;
+
+  // Tests inputs and builder parameters validity.
+  if (_animations.empty() || !(sample_rate > 0.f) || joints.empty() ||
+      _animations.size() > 0xffff) {
+    return database;
+  }
+  const int num_joints = _skeleton.num_joints();
+  for (const RawAnimation* animation : _animations) {
+    if (animation == nullptr || !animation->Validate() ||
+        animation->num_tracks() != num_joints) {
+      return database;
+    }
+  }
+  for (uint16_t joint : joints) {
+    if (joint >= num_joints) {
+      return database;
+    }
+  }
+
+  const int num_features = static_cast<int>(joints.size()) * 6;
+
+  // Samples every animation at fixed rate, stacking features and entries in
+  // animation order. Each frame feature is the tracked joints model-space
+  // position, followed by its velocity, the finite difference with the
+  // previous frame (next frame for the first one, so boundary velocities
+  // aren't null).
+  ozz::vector<float> features;
+  ozz::vector<PoseEntry> entries;
+  ozz::vector<math::Transform> locals(num_joints);
+  ozz::vector<math::Float4x4> models(num_joints);
+  ozz::vector<float> positions;
+  for (size_t a = 0; a < _animations.size(); ++a) {
+    const RawAnimation& animation = *_animations[a];
+    const FixedRateSamplingTime sampling(animation.duration, sample_rate);
+    const size_t num_keys = sampling.num_keys();
+
+    positions.resize(num_keys * joints.size() * 3);
+    for (size_t k = 0; k < num_keys; ++k) {
+      if (!SampleAnimation(animation, sampling.time(k), make_span(locals))) {
+        return database;
+      }
+      ComputeJointPositions(_skeleton, locals, make_span(joints), &models,
+                            positions.data() + k * joints.size() * 3);
+    }
+
+    for (size_t k = 0; k < num_keys; ++k) {
+      const float* current = positions.data() + k * joints.size() * 3;
+      const size_t previous_key = k > 0 ? k - 1 : (num_keys > 1 ? 1 : 0);
+      const float* previous =
+          positions.data() + previous_key * joints.size() * 3;
+      const float dt = sampling.time(k) - sampling.time(previous_key);
+      const float inv_dt = dt != 0.f ? 1.f / dt : 0.f;
+
+      for (size_t j = 0; j < joints.size(); ++j) {
+        features.push_back(current[j * 3 + 0]);
+        features.push_back(current[j * 3 + 1]);
+        features.push_back(current[j * 3 + 2]);
+        features.push_back((current[j * 3 + 0] - previous[j * 3 + 0]) * inv_dt);
+        features.push_back((current[j * 3 + 1] - previous[j * 3 + 1]) * inv_dt);
+        features.push_back((current[j * 3 + 2] - previous[j * 3 + 2]) * inv_dt);
+      }
+
+      const float ratio =
+          animation.duration > 0.f ? sampling.time(k) / animation.duration
+                                   : 0.f;
+      const PoseEntry entry = {static_cast<uint16_t>(a), ratio};
+      entries.push_back(entry);
+    }
+  }
+
+  // Orders entries as an implicit kd-tree, through an indirection table so
+  // feature vectors are only moved once.
+  const int num_entries = static_cast<int>(entries.size());
+  ozz::vector<int> order(num_entries);
+  for (int i = 0; i < num_entries; ++i) {
+    order[i] = i;
+  }
+  SortPoseKdRange(features.data(), num_features, order.data(),
+                  order.data() + num_entries, 0);
+
+  database = make_unique<PoseDatabase>();
+  database->num_features_ = num_features;
+  database->features_.resize(entries.size() * num_features);
+  database->animations_.resize(entries.size());
+  database->ratios_.resize(entries.size());
+  for (int i = 0; i < num_entries; ++i) {
+    const int source = order[i];
+    std::copy(features.data() + source * num_features,
+              features.data() + (source + 1) * num_features,
+              database->features_.data() + i * num_features);
+    database->animations_[i] = entries[source].animation;
+    database->ratios_[i] = entries[source].ratio;
+  }
+
+  return database;
+}
+}  // namespace offline
+}  // namespace animation
+}  // namespace ozz
@@ -27,6 +27,7 @@
 
 #include "ozz/animation/offline/skeleton_builder.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include "ozz/animation/offline/raw_skeleton.h"
@@ -68,6 +69,43 @@ struct JointLister {
   // Array of joints in the traversed DAG order.
   ozz::vector<Joint> linear_joints;
 };
+
+// Counts the number of joints of _joint sub-hierarchy, _joint included.
+size_t SubHierarchySize(const RawSkeleton::Joint& _joint) {
+  size_t size = 1;
+  for (size_t i = 0; i < _joint.children.size(); ++i) {
+    size += SubHierarchySize(_joint.children[i]);
+  }
+  return size;
+}
+
+// Traverses _children depth-first, like RawSkeleton::IterateJointsDF, but
+// visits sibling sub-hierarchies from the smallest to the biggest. In
+// depth-first order the distance from a joint to its parent is the size of its
+// preceding sibling sub-hierarchies, so this ordering minimizes the sum of
+// parent distances while preserving the depth-first invariant that runtime
+// algorithms rely on.
+void IterateJointsDFSorted(const RawSkeleton::Joint::Children& _children,
+                           const RawSkeleton::Joint* _parent,
+                           JointLister& _lister) {
+  // Collects children with their sub-hierarchy size.
+  ozz::vector<std::pair<size_t, const RawSkeleton::Joint*>> sorted;
+  sorted.reserve(_children.size());
+  for (size_t i = 0; i < _children.size(); ++i) {
+    sorted.emplace_back(SubHierarchySize(_children[i]), &_children[i]);
+  }
+  // Stable sort preserves raw skeleton order for equally sized siblings.
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [](const std::pair<size_t, const RawSkeleton::Joint*>& _a,
+                      const std::pair<size_t, const RawSkeleton::Joint*>& _b) {
+                     return _a.first < _b.first;
+                   });
+  for (size_t i = 0; i < sorted.size(); ++i) {
+    const RawSkeleton::Joint& current = *sorted[i].second;
+    _lister(current, _parent);
+    IterateJointsDFSorted(current.children, &current, _lister);
+  }
+}
 }  // namespace
 
 // Validates the RawSkeleton and fills a Skeleton.
@@ -81,6 +119,10 @@ unique_ptr<ozz::animation::Skeleton> SkeletonBuilder::operator()(
     return nullptr;
   }
 
+  // Attributes builder scratch allocations, while the output skeleton tags
+  // its own buffer.
+  const memory::AllocationScope scope(memory::AllocationTag::kBuilder);
+
   // Everything is fine, allocates and fills the skeleton.
   // Will not fail.
   unique_ptr<ozz::animation::Skeleton> skeleton = make_unique<Skeleton>();
@@ -90,7 +132,11 @@ unique_ptr<ozz::animation::Skeleton> SkeletonBuilder::operator()(
   // list.
   // Iteration order defines runtime skeleton joint ordering.
   JointLister lister(num_joints);
-  IterateJointsDF<JointLister&>(_raw_skeleton, lister);
+  if (minimize_parent_distance) {
+    IterateJointsDFSorted(_raw_skeleton.roots, nullptr, lister);
+  } else {
+    IterateJointsDF<JointLister&>(_raw_skeleton, lister);
+  }
   assert(static_cast<int>(lister.linear_joints.size()) == num_joints);
 
   // Computes name's buffer size.
@@ -112,11 +158,19 @@ unique_ptr<ozz::animation::Skeleton> SkeletonBuilder::operator()(
     cursor += (current.name.size() + 1) * sizeof(char);
   }
 
+  // Builds the joint name lookup index, now that all names are set.
+  skeleton->BuildJointNameIndex();
+
   // Transfers sorted joints hierarchy to the new skeleton.
   for (int i = 0; i < num_joints; ++i) {
     skeleton->joint_parents_[i] = lister.linear_joints[i].parent;
   }
 
+  // Hierarchy is final, computes the structural hash and subtree ranges from
+  // it.
+  skeleton->ComputeStructuralHash();
+  skeleton->ComputeSubtreeRanges();
+
   // Transfers t-poses.
   const math::SimdFloat4 w_axis = math::simd_float4::w_axis();
   const math::SimdFloat4 zero = math::simd_float4::zero();
@@ -149,6 +203,10 @@ unique_ptr<ozz::animation::Skeleton> SkeletonBuilder::operator()(
     math::Transpose4x3(scales, &skeleton->joint_rest_poses_[i].scale.x);
   }
 
+  // Rest pose and hierarchy are final, computes model-space bind pose and
+  // inverse bind pose matrices from them.
+  skeleton->ComputeBindPoses();
+
   return skeleton;  // Success.
 }
 }  // namespace offline
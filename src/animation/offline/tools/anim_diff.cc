@@ -0,0 +1,174 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+// Compares two cooked clip archives (raw or runtime animations), for cook
+// incrementality: per track content hashes and a structural diff for raw
+// clips, a sampled semantic diff for runtime clips. Exit code is 0 when clips
+// are identical (within tolerance for runtime clips), 1 when they differ, 2
+// on error.
+
+#include <cstdlib>
+#include <iostream>
+
+#include "animation/offline/tools/clip_diff.h"
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/base/io/archive.h"
+#include "ozz/base/io/stream.h"
+#include "ozz/base/log.h"
+#include "ozz/base/memory/unique_ptr.h"
+#include "ozz/options/options.h"
+
+OZZ_OPTIONS_DECLARE_STRING(left, "Path to the left clip archive to compare.",
+                           "", true)
+OZZ_OPTIONS_DECLARE_STRING(right, "Path to the right clip archive to compare.",
+                           "", true)
+OZZ_OPTIONS_DECLARE_FLOAT(
+    tolerance,
+    "Maximum sampled difference for runtime clips to compare identical.",
+    1e-5f, false)
+OZZ_OPTIONS_DECLARE_INT(
+    samples, "Number of evenly spread samples of the runtime semantic diff.",
+    101, false)
+
+namespace {
+
+using ozz::animation::Animation;
+using ozz::animation::offline::ClipDiff;
+using ozz::animation::offline::RawAnimation;
+
+// A clip archive content: either a raw or a runtime animation.
+struct Clip {
+  RawAnimation raw;
+  ozz::unique_ptr<Animation> runtime;
+  bool is_raw;
+};
+
+// Loads a clip archive, accepting both raw and runtime animations, like
+// import2ozz does for skeletons.
+bool Load(const char* _filename, Clip* _clip) {
+  ozz::io::File file(_filename, "rb");
+  if (!file.opened()) {
+    ozz::log::Err() << "Failed to open file \"" << _filename << "\"."
+                    << std::endl;
+    return false;
+  }
+  ozz::io::IArchive archive(&file);
+  if (archive.TestTag<RawAnimation>()) {
+    archive >> _clip->raw;
+    _clip->is_raw = true;
+    return true;
+  }
+  if (archive.TestTag<Animation>()) {
+    _clip->runtime = ozz::make_unique<Animation>();
+    archive >> *_clip->runtime;
+    _clip->is_raw = false;
+    return true;
+  }
+  ozz::log::Err() << "File \"" << _filename
+                  << "\" doesn't contain a raw or runtime animation."
+                  << std::endl;
+  return false;
+}
+
+int Diff() {
+  Clip left, right;
+  if (!Load(OPTIONS_left.value(), &left) ||
+      !Load(OPTIONS_right.value(), &right)) {
+    return 2;
+  }
+  if (left.is_raw != right.is_raw) {
+    ozz::log::Err() << "Clips types don't match (raw vs runtime animation)."
+                    << std::endl;
+    return 2;
+  }
+
+  if (left.is_raw) {
+    // Structural diff, per track hashes.
+    const ClipDiff diff =
+        ozz::animation::offline::DiffClips(left.raw, right.raw);
+    ozz::log::Log() << "Left clip hash: " << std::hex
+                    << ozz::animation::offline::HashClip(left.raw)
+                    << ", right clip hash: "
+                    << ozz::animation::offline::HashClip(right.raw) << std::dec
+                    << std::endl;
+    if (!diff.Changed()) {
+      ozz::log::Log() << "Clips are identical." << std::endl;
+      return 0;
+    }
+    if (diff.name_changed) {
+      ozz::log::Log() << "Clip names differ: \"" << left.raw.name << "\" vs \""
+                      << right.raw.name << "\"." << std::endl;
+    }
+    if (diff.duration_changed) {
+      ozz::log::Log() << "Clip durations differ: " << left.raw.duration
+                      << " vs " << right.raw.duration << "." << std::endl;
+    }
+    if (diff.num_tracks[0] != diff.num_tracks[1]) {
+      ozz::log::Log() << "Clip track counts differ: " << diff.num_tracks[0]
+                      << " vs " << diff.num_tracks[1] << "." << std::endl;
+    }
+    for (size_t i = 0; i < diff.modified_tracks.size(); ++i) {
+      ozz::log::Log() << "Track " << diff.modified_tracks[i]
+                      << " keyframes differ." << std::endl;
+    }
+    ozz::log::Log() << "Clips differ." << std::endl;
+    return 1;
+  }
+
+  // Semantic diff of built clips.
+  float max_error = 0.f;
+  if (!ozz::animation::offline::DiffBuiltClips(*left.runtime, *right.runtime,
+                                               OPTIONS_samples.value(),
+                                               &max_error)) {
+    ozz::log::Log() << "Clips metadata differ (name, duration or tracks)."
+                    << std::endl;
+    ozz::log::Log() << "Clips differ." << std::endl;
+    return 1;
+  }
+  ozz::log::Log() << "Maximum sampled difference: " << max_error << "."
+                  << std::endl;
+  if (max_error > OPTIONS_tolerance.value()) {
+    ozz::log::Log() << "Clips differ." << std::endl;
+    return 1;
+  }
+  ozz::log::Log() << "Clips are identical." << std::endl;
+  return 0;
+}
+}  // namespace
+
+int main(int _argc, const char** _argv) {
+  ozz::options::ParseResult parse_result = ozz::options::ParseCommandLine(
+      _argc, _argv, "1.0",
+      "Compares two clip archives (raw or runtime animations) and reports "
+      "content hashes and differences.");
+  if (parse_result != ozz::options::kSuccess) {
+    return parse_result == ozz::options::kExitSuccess ? EXIT_SUCCESS
+                                                      : EXIT_FAILURE;
+  }
+  return Diff();
+}
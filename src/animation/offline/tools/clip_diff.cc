@@ -0,0 +1,173 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "animation/offline/tools/clip_diff.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/io/stream.h"
+#include "ozz/base/maths/math_ex.h"
+#include "ozz/base/maths/simd_math.h"
+#include "ozz/base/maths/soa_transform.h"
+
+namespace ozz {
+namespace animation {
+namespace offline {
+
+namespace {
+
+// 64 bits fnv-1a primitives.
+const uint64_t kFnvBasis = 14695981039346656037ull;
+const uint64_t kFnvPrime = 1099511628211ull;
+
+uint64_t HashBytes(uint64_t _hash, const void* _bytes, size_t _size) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(_bytes);
+  for (size_t i = 0; i < _size; ++i) {
+    _hash = (_hash ^ bytes[i]) * kFnvPrime;
+  }
+  return _hash;
+}
+
+template <typename _Keys>
+uint64_t HashKeys(uint64_t _hash, const _Keys& _keys) {
+  const size_t count = _keys.size();
+  _hash = HashBytes(_hash, &count, sizeof(count));
+  if (count != 0) {
+    _hash = HashBytes(_hash, _keys.data(), count * sizeof(_keys[0]));
+  }
+  return _hash;
+}
+}  // namespace
+
+uint64_t HashJointTrack(const RawAnimation::JointTrack& _track) {
+  uint64_t hash = kFnvBasis;
+  hash = HashKeys(hash, _track.translations);
+  hash = HashKeys(hash, _track.rotations);
+  hash = HashKeys(hash, _track.scales);
+  return hash;
+}
+
+uint64_t HashClip(const RawAnimation& _animation) {
+  uint64_t hash = kFnvBasis;
+  hash = HashBytes(hash, _animation.name.c_str(), _animation.name.size());
+  hash = HashBytes(hash, &_animation.duration, sizeof(_animation.duration));
+  for (size_t i = 0; i < _animation.tracks.size(); ++i) {
+    const uint64_t track_hash = HashJointTrack(_animation.tracks[i]);
+    hash = HashBytes(hash, &track_hash, sizeof(track_hash));
+  }
+  return hash;
+}
+
+ClipDiff DiffClips(const RawAnimation& _left, const RawAnimation& _right) {
+  ClipDiff diff;
+  diff.name_changed = _left.name != _right.name;
+  diff.duration_changed = _left.duration != _right.duration;
+  diff.num_tracks[0] = _left.num_tracks();
+  diff.num_tracks[1] = _right.num_tracks();
+  const int common = math::Min(diff.num_tracks[0], diff.num_tracks[1]);
+  for (int i = 0; i < common; ++i) {
+    if (HashJointTrack(_left.tracks[i]) != HashJointTrack(_right.tracks[i])) {
+      diff.modified_tracks.push_back(i);
+    }
+  }
+  return diff;
+}
+
+bool DiffBuiltClips(const Animation& _left, const Animation& _right,
+                    int _samples, float* _max_error) {
+  // Metadata must match for clips to be comparable.
+  if (std::strcmp(_left.name(), _right.name()) != 0 ||
+      _left.duration() != _right.duration() ||
+      _left.num_tracks() != _right.num_tracks() || _samples < 2 ||
+      !_max_error) {
+    return false;
+  }
+
+  const int num_soa_tracks = _left.num_soa_tracks();
+  SamplingJob::Context contexts[2];
+  contexts[0].Resize(_left.num_tracks());
+  contexts[1].Resize(_right.num_tracks());
+  ozz::vector<math::SoaTransform> poses[2];
+  poses[0].resize(num_soa_tracks);
+  poses[1].resize(num_soa_tracks);
+
+  float max_error = 0.f;
+  for (int s = 0; s < _samples; ++s) {
+    const float ratio = static_cast<float>(s) / (_samples - 1);
+    const Animation* animations[2] = {&_left, &_right};
+    for (int a = 0; a < 2; ++a) {
+      SamplingJob job;
+      job.animation = animations[a];
+      job.context = &contexts[a];
+      job.ratio = ratio;
+      job.output = make_span(poses[a]);
+      if (!job.Run()) {
+        return false;
+      }
+    }
+    // Compares all components of all sampled soa transforms.
+    const float* left = reinterpret_cast<const float*>(poses[0].data());
+    const float* right = reinterpret_cast<const float*>(poses[1].data());
+    const size_t components =
+        num_soa_tracks * sizeof(math::SoaTransform) / sizeof(float);
+    for (size_t i = 0; i < components; ++i) {
+      max_error = math::Max(max_error, std::abs(left[i] - right[i]));
+    }
+  }
+  *_max_error = max_error;
+  return true;
+}
+
+bool MatchesFileContent(ozz::io::Stream* _stream, const char* _filename) {
+  ozz::io::File file(_filename, "rb");
+  if (!file.opened()) {
+    return false;
+  }
+  const int position = _stream->Tell();
+  _stream->Seek(0, ozz::io::Stream::kSet);
+
+  bool matches = file.Size() == _stream->Size();
+  char stream_buffer[4096];
+  char file_buffer[4096];
+  while (matches) {
+    const size_t read = _stream->Read(stream_buffer, sizeof(stream_buffer));
+    if (read == 0) {
+      break;
+    }
+    matches = file.Read(file_buffer, read) == read &&
+              std::memcmp(stream_buffer, file_buffer, read) == 0;
+  }
+  _stream->Seek(position, ozz::io::Stream::kSet);
+  return matches;
+}
+}  // namespace offline
+}  // namespace animation
+}  // namespace ozz
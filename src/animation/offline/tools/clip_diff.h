@@ -0,0 +1,108 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_ANIMATION_OFFLINE_TOOLS_CLIP_DIFF_H_
+#define OZZ_ANIMATION_OFFLINE_TOOLS_CLIP_DIFF_H_
+
+#include <cstdint>
+
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/offline/tools/export.h"
+#include "ozz/base/containers/vector.h"
+
+namespace ozz {
+namespace io {
+class Stream;
+}
+namespace animation {
+
+class Animation;
+
+namespace offline {
+
+// Clip comparison utilities backing cook incrementality: content hashes
+// detect byte-identical rebuilds cheaply, structural and semantic diffs
+// explain what actually changed when they don't match. Shared by the
+// anim_diff tool and import2ozz emit-if-changed support.
+
+// Content hash (64 bits fnv-1a) of a joint track keyframes: times and values
+// of translation, rotation and scale keys. Deterministic for a given
+// platform, suited to cook caches, not to cross-platform distribution.
+OZZ_ANIMTOOLS_DLL uint64_t HashJointTrack(
+    const RawAnimation::JointTrack& _track);
+
+// Content hash of a whole clip: name, duration and every track hash.
+OZZ_ANIMTOOLS_DLL uint64_t HashClip(const RawAnimation& _animation);
+
+// Structural diff between two raw clips, per track hash granularity.
+struct ClipDiff {
+  // True if any field below reports a difference.
+  bool Changed() const {
+    return name_changed || duration_changed ||
+           num_tracks[0] != num_tracks[1] || !modified_tracks.empty();
+  }
+
+  // Clip names differ.
+  bool name_changed;
+
+  // Clip durations differ.
+  bool duration_changed;
+
+  // Number of tracks of each clip.
+  int num_tracks[2];
+
+  // Indices of common tracks whose keyframes hash differently.
+  ozz::vector<int> modified_tracks;
+};
+
+// Compares _left and _right raw clips, hashing each track once.
+OZZ_ANIMTOOLS_DLL ClipDiff DiffClips(const RawAnimation& _left,
+                                     const RawAnimation& _right);
+
+// Semantic diff between two built (runtime) animations: compares metadata
+// (name, duration, track count) and samples both clips at _samples evenly
+// spread ratios, reporting the maximum absolute difference over all sampled
+// soa transform components in *_max_error. Returns true if metadata matches
+// and sampling succeeded, false otherwise (*_max_error is left untouched).
+// Clips built from different keyframe layouts but equivalent content (a
+// re-optimized clip typically) compare equal within tolerance here while
+// hashes differ.
+OZZ_ANIMTOOLS_DLL bool DiffBuiltClips(const Animation& _left,
+                                      const Animation& _right, int _samples,
+                                      float* _max_error);
+
+// Returns true if _stream content (from its beginning to its end) is byte
+// identical to _filename content. Returns false if the file can't be read.
+// _stream position is restored before returning. This is the emit-if-changed
+// test: cooking to memory then skipping the disk write (and its mtime bump)
+// when the file wouldn't change.
+OZZ_ANIMTOOLS_DLL bool MatchesFileContent(ozz::io::Stream* _stream,
+                                          const char* _filename);
+}  // namespace offline
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_ANIMATION_OFFLINE_TOOLS_CLIP_DIFF_H_
@@ -34,15 +34,29 @@
 #include <cstring>
 
 #include "animation/offline/tools/import2ozz_anim.h"
+#include "animation/offline/tools/import2ozz_cache.h"
 #include "animation/offline/tools/import2ozz_config.h"
 #include "animation/offline/tools/import2ozz_skel.h"
+#include "ozz/base/containers/string.h"
+#include "ozz/base/containers/vector.h"
 #include "ozz/base/io/stream.h"
 #include "ozz/base/log.h"
 #include "ozz/options/options.h"
 
+// Tool version, reported by the command line and part of the build cache
+// key: bumping it invalidates every cached import.
+static const char kVersion[] = "2.0";
+
 // Declares command line options.
 OZZ_OPTIONS_DECLARE_STRING(file, "Specifies input file", "", true)
 
+OZZ_OPTIONS_DECLARE_STRING(
+    cache,
+    "Specifies build cache directory. When set, imports whose source file, "
+    "configuration and tool version are unchanged restore their outputs from "
+    "the cache instead of re-importing. An empty value disables caching.",
+    "", false)
+
 static bool ValidateEndianness(const ozz::options::Option& _option,
                                int /*_argc*/) {
   const ozz::options::StringOption& option =
@@ -115,7 +129,7 @@ namespace offline {
 int OzzImporter::operator()(int _argc, const char** _argv) {
   // Parses arguments.
   ozz::options::ParseResult parse_result = ozz::options::ParseCommandLine(
-      _argc, _argv, "2.0",
+      _argc, _argv, kVersion,
       "Imports skeleton and animations from a file and converts it to ozz "
       "binary raw or runtime data format.");
   if (parse_result != ozz::options::kSuccess) {
@@ -133,29 +147,66 @@ int OzzImporter::operator()(int _argc, const char** _argv) {
     return EXIT_FAILURE;
   }
 
-  // Ensures file to import actually exist.
-  if (!ozz::io::File::Exist(OPTIONS_file)) {
-    ozz::log::Err() << "File \"" << OPTIONS_file << "\" doesn't exist."
-                    << std::endl;
-    return EXIT_FAILURE;
-  }
-
-  // Imports animations from the document.
-  ozz::log::Log() << "Importing file \"" << OPTIONS_file << "\"" << std::endl;
-  if (!Load(OPTIONS_file)) {
-    ozz::log::Err() << "Failed to import file \"" << OPTIONS_file << "\"."
-                    << std::endl;
-    return EXIT_FAILURE;
+  // Builds the list of documents to import: the --file option one, followed
+  // by the optional config "inputs" batch entries. Batching imports many
+  // documents with a single process launch, each parsed once whatever the
+  // number of animations it contains.
+  ozz::vector<ozz::string> inputs;
+  inputs.push_back(OPTIONS_file.value());
+  const Json::Value& config_inputs = config["inputs"];
+  for (Json::ArrayIndex i = 0; i < config_inputs.size(); ++i) {
+    const char* input = config_inputs[i].asCString();
+    if (*input == 0) {
+      // Unset (default configuration) entries are skipped.
+      continue;
+    }
+    inputs.push_back(input);
   }
 
-  // Handles skeleton import processing
-  if (!ImportSkeleton(config, this, endianness)) {
-    return EXIT_FAILURE;
+  // Ensures files to import actually exist before starting any import.
+  for (const ozz::string& input : inputs) {
+    if (!ozz::io::File::Exist(input.c_str())) {
+      ozz::log::Err() << "File \"" << input << "\" doesn't exist."
+                      << std::endl;
+      return EXIT_FAILURE;
+    }
   }
 
-  // Handles animations import processing
-  if (!ImportAnimations(config, this, endianness)) {
-    return EXIT_FAILURE;
+  for (const ozz::string& input : inputs) {
+    // Probes the build cache: an identical import (same source content,
+    // configuration and tool version) already ran if its entry is found, and
+    // restoring its outputs short-circuits the whole import.
+    BuildCache cache;
+    const bool cached = cache.Key(OPTIONS_cache, input.c_str(), config,
+                                  endianness, kVersion);
+    if (cached && cache.Restore()) {
+      ozz::log::Log() << "Build cache hit for file \"" << input
+                      << "\", import skipped." << std::endl;
+      continue;
+    }
+
+    // Imports animations from the document.
+    ozz::log::Log() << "Importing file \"" << input << "\"" << std::endl;
+    if (!Load(input.c_str())) {
+      ozz::log::Err() << "Failed to import file \"" << input << "\"."
+                      << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Handles skeleton import processing
+    if (!ImportSkeleton(config, this, endianness)) {
+      return EXIT_FAILURE;
+    }
+
+    // Handles animations import processing
+    if (!ImportAnimations(config, this, endianness)) {
+      return EXIT_FAILURE;
+    }
+
+    // Caches this import's outputs for identical future runs.
+    if (cached) {
+      cache.Store();
+    }
   }
 
   return EXIT_SUCCESS;
@@ -31,7 +31,10 @@
 
 #include <cstdlib>
 #include <cstring>
+#include <utility>
 
+#include "animation/offline/tools/clip_diff.h"
+#include "animation/offline/tools/import2ozz_cache.h"
 #include "animation/offline/tools/import2ozz_config.h"
 #include "animation/offline/tools/import2ozz_track.h"
 #include "ozz/animation/offline/additive_animation_builder.h"
@@ -48,6 +51,7 @@
 #include "ozz/base/log.h"
 #include "ozz/base/maths/soa_transform.h"
 #include "ozz/base/memory/unique_ptr.h"
+#include "ozz/base/scheduler.h"
 #include "ozz/options/options.h"
 
 namespace ozz {
@@ -278,14 +282,39 @@ bool Export(OzzImporter& _importer, const RawAnimation& _input_animation,
   }
 
   {
-    // Prepares output stream. File is a RAII so it will close automatically
-    // at the end of this scope. Once the file is opened, nothing should fail
-    // as it would leave an invalid file on the disk.
-
     // Builds output filename.
     ozz::string filename = _importer.BuildFilename(
         _config["filename"].asCString(), raw_animation.name.c_str());
 
+    // Cooks the archive to memory first, so byte identical outputs can be
+    // detected (and skipped) before touching the file.
+    ozz::io::MemoryStream cooked;
+    {
+      ozz::io::OArchive archive(&cooked, _endianness);
+      if (_config["raw"].asBool()) {
+        ozz::log::Log() << "Outputs RawAnimation to binary archive."
+                        << std::endl;
+        archive << raw_animation;
+      } else {
+        ozz::log::Log() << "Outputs Animation to binary archive." << std::endl;
+        archive << *animation;
+      }
+    }
+
+    // Emit-if-changed support: an output identical to the existing file is
+    // not rewritten, so its timestamp is preserved and downstream
+    // distribution only ships real changes.
+    if (_config["emit_if_changed"].asBool() &&
+        MatchesFileContent(&cooked, filename.c_str())) {
+      ozz::log::Log() << "Output file \"" << filename
+                      << "\" is unchanged, skipping write." << std::endl;
+      RecordBuildOutput(filename.c_str());
+      return true;
+    }
+
+    // Prepares output stream. File is a RAII so it will close automatically
+    // at the end of this scope. Once the file is opened, nothing should fail
+    // as it would leave an invalid file on the disk.
     ozz::log::LogV() << "Opens output file: \"" << filename << "\""
                      << std::endl;
     ozz::io::File file(filename.c_str(), "wb");
@@ -295,17 +324,17 @@ bool Export(OzzImporter& _importer, const RawAnimation& _input_animation,
       return false;
     }
 
-    // Initializes output archive.
-    ozz::io::OArchive archive(&file, _endianness);
-
-    // Fills output archive with the animation.
-    if (_config["raw"].asBool()) {
-      ozz::log::Log() << "Outputs RawAnimation to binary archive." << std::endl;
-      archive << raw_animation;
-    } else {
-      ozz::log::Log() << "Outputs Animation to binary archive." << std::endl;
-      archive << *animation;
+    // Copies the cooked archive to the file.
+    cooked.Seek(0, ozz::io::Stream::kSet);
+    char buffer[4096];
+    for (size_t read = 0; (read = cooked.Read(buffer, sizeof(buffer))) != 0;) {
+      if (file.Write(buffer, read) != read) {
+        ozz::log::Err() << "Failed to write output file: \"" << filename
+                        << "\"" << std::endl;
+        return false;
+      }
     }
+    RecordBuildOutput(filename.c_str());
   }
 
   ozz::log::LogV() << "Animation binary archive successfully outputted."
@@ -314,25 +343,29 @@ bool Export(OzzImporter& _importer, const RawAnimation& _input_animation,
   return true;
 }  // namespace
 
-bool ProcessAnimation(OzzImporter& _importer, const char* _animation_name,
-                      const Skeleton& _skeleton, const Json::Value& _config,
-                      const ozz::Endianness _endianness) {
-  RawAnimation animation;
-
+bool ImportAnimation(OzzImporter& _importer, const char* _animation_name,
+                     const Skeleton& _skeleton, const Json::Value& _config,
+                     RawAnimation* _animation) {
   ozz::log::Log() << "Extracting animation \"" << _animation_name << "\""
                   << std::endl;
 
   if (!_importer.Import(_animation_name, _skeleton,
-                        _config["sampling_rate"].asFloat(), &animation)) {
+                        _config["sampling_rate"].asFloat(), _animation)) {
     ozz::log::Err() << "Failed to import animation \"" << _animation_name
                     << "\"" << std::endl;
     return false;
   }
 
   // Give animation a name
-  animation.name = _animation_name;
-  return Export(_importer, animation, _skeleton, _config, _endianness);
+  _animation->name = _animation_name;
+  return true;
 }
+
+// An animation extracted from the scene, waiting to be built and exported.
+struct PendingAnimation {
+  RawAnimation animation;
+  const Json::Value* config;
+};
 }  // namespace
 
 AdditiveReference::EnumNames AdditiveReference::GetNames() {
@@ -375,8 +408,12 @@ bool ImportAnimations(const Json::Value& _config, OzzImporter* _importer,
     return false;
   }
 
-  // Loop though all existing animations, and export those who match
-  // configuration.
+  // Loop though all existing animations, and extract those who match
+  // configuration. Scene extraction must stay on this thread, as importers
+  // (fbx sdk...) aren't thread safe, but extracted animations are
+  // independent: they are built and exported concurrently once the loop
+  // completes.
+  ozz::vector<PendingAnimation> pending;
   for (Json::ArrayIndex i = 0; i < animations_config.size(); ++i) {
     const Json::Value& animation_config = animations_config[i];
     const char* clip_match = animation_config["clip"].asCString();
@@ -395,9 +432,13 @@ bool ImportAnimations(const Json::Value& _config, OzzImporter* _importer,
         continue;
       }
       ++num_not_clip_animation;
-      if (ProcessAnimation(*_importer, animation_name, *skeleton,
-                           animation_config, _endianness)) {
+      RawAnimation animation;
+      if (ImportAnimation(*_importer, animation_name, *skeleton,
+                          animation_config, &animation)) {
         ++num_valid_animation;
+        pending.resize(pending.size() + 1);
+        pending.back().animation = std::move(animation);
+        pending.back().config = &animation_config;
       }
 
       size_t num_valid_track = 0;
@@ -429,6 +470,28 @@ bool ImportAnimations(const Json::Value& _config, OzzImporter* _importer,
     }
   }
 
+  // Builds and exports extracted animations concurrently: optimization,
+  // runtime compression and archive output dominate import time and only
+  // read shared data (skeleton, configuration).
+  if (!pending.empty()) {
+    ozz::vector<char> exported(pending.size(), 0);
+    ThreadPoolScheduler scheduler;
+    scheduler.ParallelForFct(
+        0, static_cast<int>(pending.size()), 1, [&](int _begin, int _end) {
+          for (int p = _begin; p < _end; ++p) {
+            exported[p] = Export(*_importer, pending[p].animation, *skeleton,
+                                 *pending[p].config, _endianness);
+          }
+        });
+    for (size_t p = 0; p < pending.size(); ++p) {
+      if (!exported[p]) {
+        ozz::log::Err() << "Failed to export animation \""
+                        << pending[p].animation.name << "\"." << std::endl;
+        success = false;
+      }
+    }
+  }
+
   return success;
 }
 }  // namespace offline
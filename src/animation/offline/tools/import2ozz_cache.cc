@@ -0,0 +1,267 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "animation/offline/tools/import2ozz_cache.h"
+
+#include <json/json.h>
+
+#include <cstdio>
+#include <cstring>
+
+#include "animation/offline/tools/clip_diff.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/io/stream.h"
+#include "ozz/base/log.h"
+
+namespace ozz {
+namespace animation {
+namespace offline {
+
+namespace {
+
+// 64-bit FNV-1a, the content-addressing hash. Key collisions map different
+// imports to the same entry, so 32 bits (the only hash the runtime ships)
+// would be too narrow for farm sized asset sets.
+const uint64_t kCacheFnvBasis = 14695981039346656037ull;
+const uint64_t kCacheFnvPrime = 1099511628211ull;
+uint64_t HashCacheBytes(uint64_t _hash, const void* _data, size_t _size) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(_data);
+  for (size_t i = 0; i < _size; ++i) {
+    _hash = (_hash ^ bytes[i]) * kCacheFnvPrime;
+  }
+  return _hash;
+}
+
+// Cache entry format identification. The magic rejects foreign files found
+// in the cache directory, the version stale entries from older tools.
+const char kEntryMagic[8] = {'o', 'z', 'z', 'c', 'a', 'c', 'h', 'e'};
+const uint32_t kEntryVersion = 1;
+
+// Outputs recorded since the last BuildCache::Key, none while recording is
+// disabled. Imports run sequentially, so a single recording is live at once.
+bool g_recording = false;
+ozz::vector<ozz::string> g_outputs;
+
+// Reads the whole content of _filename into _content.
+bool ReadCacheFileContent(const char* _filename, ozz::vector<char>* _content) {
+  ozz::io::File file(_filename, "rb");
+  if (!file.opened()) {
+    return false;
+  }
+  _content->resize(file.Size());
+  return _content->empty() ||
+         file.Read(_content->data(), _content->size()) == _content->size();
+}
+}  // namespace
+
+BuildCache::BuildCache() {}
+
+bool BuildCache::Key(const char* _directory, const char* _filename,
+                     const Json::Value& _config, Endianness _endianness,
+                     const char* _version) {
+  entry_.clear();
+  g_recording = false;
+  g_outputs.clear();
+
+  if (_directory == nullptr || *_directory == 0) {
+    return false;  // Caching wasn't requested.
+  }
+
+  // Hashes the source document content. An unreadable source will fail the
+  // import with its own error message, no need for one here.
+  ozz::io::File file(_filename, "rb");
+  if (!file.opened()) {
+    return false;
+  }
+  uint64_t hash = kCacheFnvBasis;
+  char buffer[4096];
+  for (size_t read = 0; (read = file.Read(buffer, sizeof(buffer))) != 0;) {
+    hash = HashCacheBytes(hash, buffer, read);
+  }
+
+  // Hashes everything else an import's outputs depend on: the sanitized
+  // configuration (which embeds output filenames and build settings), output
+  // endianness and tool version.
+  Json::StreamWriterBuilder writer;
+  writer["indentation"] = "";
+  const std::string config = Json::writeString(writer, _config);
+  hash = HashCacheBytes(hash, config.data(), config.size());
+  const uint8_t endianness = static_cast<uint8_t>(_endianness);
+  hash = HashCacheBytes(hash, &endianness, sizeof(endianness));
+  hash = HashCacheBytes(hash, _version, std::strlen(_version));
+
+  // Entry path is the key in hexadecimal, within the cache directory.
+  char name[32];
+  std::snprintf(name, sizeof(name), "%016llx.ozzcache",
+                static_cast<unsigned long long>(hash));
+  entry_ = _directory;
+  if (!entry_.empty() && entry_.back() != '/' && entry_.back() != '\\') {
+    entry_ += '/';
+  }
+  entry_ += name;
+
+  g_recording = true;
+  return true;
+}
+
+bool BuildCache::Restore() const {
+  if (entry_.empty() || !ozz::io::File::Exist(entry_.c_str())) {
+    return false;  // Disabled, or cache miss.
+  }
+  ozz::io::File file(entry_.c_str(), "rb");
+  if (!file.opened()) {
+    return false;
+  }
+
+  // Any malformed read (foreign file, truncated entry) turns into a miss.
+  char magic[sizeof(kEntryMagic)];
+  uint32_t version = 0;
+  uint32_t count = 0;
+  if (file.Read(magic, sizeof(magic)) != sizeof(magic) ||
+      std::memcmp(magic, kEntryMagic, sizeof(magic)) != 0 ||
+      file.Read(&version, sizeof(version)) != sizeof(version) ||
+      version != kEntryVersion ||
+      file.Read(&count, sizeof(count)) != sizeof(count)) {
+    ozz::log::LogV() << "Invalid cache entry \"" << entry_ << "\", ignored."
+                     << std::endl;
+    return false;
+  }
+
+  for (uint32_t i = 0; i < count; ++i) {
+    // Reads output path and content.
+    uint32_t path_size = 0;
+    uint64_t content_size = 0;
+    if (file.Read(&path_size, sizeof(path_size)) != sizeof(path_size)) {
+      return false;
+    }
+    ozz::string path(path_size, 0);
+    if (file.Read(&path[0], path_size) != path_size ||
+        file.Read(&content_size, sizeof(content_size)) !=
+            sizeof(content_size)) {
+      return false;
+    }
+    ozz::io::MemoryStream content;
+    {
+      char buffer[4096];
+      for (uint64_t left = content_size; left != 0;) {
+        const size_t chunk =
+            left < sizeof(buffer) ? static_cast<size_t>(left) : sizeof(buffer);
+        if (file.Read(buffer, chunk) != chunk ||
+            content.Write(buffer, chunk) != chunk) {
+          return false;
+        }
+        left -= chunk;
+      }
+    }
+
+    // Skips outputs already up to date on disk, preserving their timestamp.
+    if (MatchesFileContent(&content, path.c_str())) {
+      ozz::log::LogV() << "Cached output \"" << path
+                       << "\" is unchanged, skipping write." << std::endl;
+      continue;
+    }
+
+    // Restores the output file.
+    ozz::io::File output(path.c_str(), "wb");
+    if (!output.opened()) {
+      ozz::log::Err() << "Failed to open output file: \"" << path << "\""
+                      << std::endl;
+      return false;
+    }
+    content.Seek(0, ozz::io::Stream::kSet);
+    char buffer[4096];
+    for (size_t read = 0; (read = content.Read(buffer, sizeof(buffer))) != 0;) {
+      if (output.Write(buffer, read) != read) {
+        ozz::log::Err() << "Failed to write output file: \"" << path << "\""
+                        << std::endl;
+        return false;
+      }
+    }
+    ozz::log::LogV() << "Restored output \"" << path << "\" from cache."
+                     << std::endl;
+  }
+  return true;
+}
+
+bool BuildCache::Store() const {
+  if (entry_.empty()) {
+    return false;
+  }
+
+  // Collects every recorded output content upfront, so a vanished output
+  // doesn't leave a partial entry behind.
+  ozz::vector<ozz::vector<char>> contents(g_outputs.size());
+  for (size_t i = 0; i < g_outputs.size(); ++i) {
+    if (!ReadCacheFileContent(g_outputs[i].c_str(), &contents[i])) {
+      ozz::log::LogV() << "Failed to read back output \"" << g_outputs[i]
+                       << "\", import not cached." << std::endl;
+      return false;
+    }
+  }
+
+  ozz::io::File file(entry_.c_str(), "wb");
+  if (!file.opened()) {
+    ozz::log::LogV() << "Failed to write cache entry \"" << entry_ << "\"."
+                     << std::endl;
+    return false;
+  }
+  const uint32_t count = static_cast<uint32_t>(g_outputs.size());
+  bool success = file.Write(kEntryMagic, sizeof(kEntryMagic)) ==
+                     sizeof(kEntryMagic) &&
+                 file.Write(&kEntryVersion, sizeof(kEntryVersion)) ==
+                     sizeof(kEntryVersion) &&
+                 file.Write(&count, sizeof(count)) == sizeof(count);
+  for (size_t i = 0; success && i < g_outputs.size(); ++i) {
+    const uint32_t path_size = static_cast<uint32_t>(g_outputs[i].size());
+    const uint64_t content_size = contents[i].size();
+    success =
+        file.Write(&path_size, sizeof(path_size)) == sizeof(path_size) &&
+        file.Write(g_outputs[i].data(), path_size) == path_size &&
+        file.Write(&content_size, sizeof(content_size)) ==
+            sizeof(content_size) &&
+        (contents[i].empty() ||
+         file.Write(contents[i].data(), contents[i].size()) ==
+             contents[i].size());
+  }
+  if (!success) {
+    ozz::log::LogV() << "Failed to write cache entry \"" << entry_ << "\"."
+                     << std::endl;
+    return false;
+  }
+  ozz::log::LogV() << "Cached " << count << " import output(s) to \"" << entry_
+                   << "\"." << std::endl;
+  return true;
+}
+
+void RecordBuildOutput(const char* _filename) {
+  if (g_recording) {
+    g_outputs.push_back(_filename);
+  }
+}
+}  // namespace offline
+}  // namespace animation
+}  // namespace ozz
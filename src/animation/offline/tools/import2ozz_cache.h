@@ -0,0 +1,93 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#ifndef OZZ_ANIMATION_OFFLINE_TOOLS_IMPORT2OZZ_CACHE_H_
+#define OZZ_ANIMATION_OFFLINE_TOOLS_IMPORT2OZZ_CACHE_H_
+
+#include "ozz/animation/offline/tools/export.h"
+#include "ozz/base/containers/string.h"
+#include "ozz/base/endianness.h"
+#include "ozz/base/platform.h"
+
+#include <json/json-forwards.h>
+
+namespace ozz {
+namespace animation {
+namespace offline {
+
+// Content-addressed build cache for import outputs. An import is keyed by the
+// hash of its source file content, its sanitized configuration, output
+// endianness and tool version: a matching cache entry means an identical
+// import already ran, and its outputs are restored without loading the source
+// document at all. Cache entries replay exact output paths and bytes, so
+// filename patterns (asterisks resolved from animation names) are covered.
+// Cache failures (unreadable entries, full disk...) only disable caching for
+// the import at hand, they never fail it.
+class OZZ_ANIMTOOLS_DLL BuildCache {
+ public:
+  // Builds a disabled cache. Key() must be called to enable it.
+  BuildCache();
+
+  // Keys the cache for the import of _filename: hashes the source file
+  // content, _config, _endianness and _version to the cache entry of an
+  // identical import. Also resets output recording for this import. Returns
+  // false, leaving the cache disabled, if _directory is empty (caching not
+  // requested) or the source file can't be read.
+  bool Key(const char* _directory, const char* _filename,
+           const Json::Value& _config, Endianness _endianness,
+           const char* _version);
+
+  // Restores the outputs of a previous identical import. Returns true on a
+  // cache hit with every output restored, in which case the whole import can
+  // be skipped. Returns false on a miss or a restore failure, the import must
+  // then run normally. Outputs already up to date on disk aren't rewritten,
+  // preserving their timestamp like emit_if_changed does.
+  bool Restore() const;
+
+  // Stores the outputs recorded (RecordBuildOutput) since Key was called as
+  // this import's cache entry. Returns false if the cache is disabled or the
+  // entry couldn't be written.
+  bool Store() const;
+
+ private:
+  BuildCache(const BuildCache&) = delete;
+  BuildCache& operator=(const BuildCache&) = delete;
+
+  // Path of the keyed cache entry file, empty while the cache is disabled.
+  ozz::string entry_;
+};
+
+// Records _filename as an output file of the running import, for
+// BuildCache::Store to collect. Called by skeleton, animation and track
+// output writers once the file is successfully written (or confirmed
+// unchanged). No-op when no import is keyed.
+OZZ_ANIMTOOLS_DLL void RecordBuildOutput(const char* _filename);
+
+}  // namespace offline
+}  // namespace animation
+}  // namespace ozz
+#endif  // OZZ_ANIMATION_OFFLINE_TOOLS_IMPORT2OZZ_CACHE_H_
@@ -389,6 +389,11 @@ bool SanitizeAnimation(Json::Value& _root, bool _all_options) {
   MakeDefault(_root, "optimize", true,
               "Activates keyframes reduction optimization.");
 
+  MakeDefault(_root, "emit_if_changed", false,
+              "Skips writing the output file when its content would be "
+              "identical to the existing one, preserving its timestamp so "
+              "downstream distribution only ships real changes.");
+
   SanitizeOptimizationSettings(_root["optimization_settings"], _all_options);
 
   MakeDefaultArray(_root, "tracks", "Tracks to build.", !_all_options);
@@ -402,7 +407,31 @@ bool SanitizeAnimation(Json::Value& _root, bool _all_options) {
   return true;
 }  // namespace
 
+bool SanitizeInputs(Json::Value& _root, bool _all_options) {
+  MakeDefaultArray(_root, "inputs",
+                   "Additional source files to import in the same run (batch "
+                   "mode), processed with this same configuration after the "
+                   "--file option one. Batching amortizes process launch and "
+                   "scene parsing costs when cooking many documents.",
+                   !_all_options);
+  Json::Value& inputs = _root["inputs"];
+  for (Json::ArrayIndex i = 0; i < inputs.size(); ++i) {
+    Json::Value& input = inputs[i];
+    if (input.isNull()) {
+      // Default (reference configuration) array element. Element types are
+      // validated against the reference configuration.
+      input = "";
+    }
+  }
+  return true;
+}
+
 bool SanitizeRoot(Json::Value& _root, bool _all_options) {
+  // Batch inputs.
+  if (!SanitizeInputs(_root, _all_options)) {
+    return false;
+  }
+
   // Skeleton
   MakeDefaultObject(_root, "skeleton", "Skeleton to import");
   SanitizeSkeleton(_root["skeleton"], _all_options);
@@ -31,6 +31,7 @@
 #include <cstring>
 #include <iomanip>
 
+#include "animation/offline/tools/import2ozz_cache.h"
 #include "animation/offline/tools/import2ozz_config.h"
 
 #include "ozz/animation/offline/tools/import2ozz.h"
@@ -176,8 +177,10 @@ bool ImportSkeleton(const Json::Value& _config, OzzImporter* _importer,
       return false;
     }
 
-    // Initializes output archive.
-    ozz::io::OArchive archive(&file, _endianness);
+    // Initializes output archive, buffering the many small archive writes
+    // into block sized file accesses.
+    ozz::io::BufferedStream buffered(&file);
+    ozz::io::OArchive archive(&buffered, _endianness);
 
     // Fills output archive with the skeleton.
     if (import_config["raw"].asBool()) {
@@ -190,6 +193,7 @@ bool ImportSkeleton(const Json::Value& _config, OzzImporter* _importer,
     ozz::log::Log() << "Skeleton binary archive successfully outputted."
                     << std::endl;
   }
+  RecordBuildOutput(skeleton_config["filename"].asCString());
 
   return true;
 }
@@ -32,6 +32,7 @@
 #include <cstdlib>
 #include <cstring>
 
+#include "animation/offline/tools/import2ozz_cache.h"
 #include "animation/offline/tools/import2ozz_config.h"
 #include "ozz/animation/offline/raw_track.h"
 #include "ozz/animation/offline/tools/import2ozz.h"
@@ -140,14 +141,13 @@ bool Export(OzzImporter& _importer, const _RawTrack& _raw_track,
     }
   }
 
+  // Builds output filename.
+  const ozz::string filename = _importer.BuildFilename(
+      _config["filename"].asCString(), _raw_track.name.c_str());
+
   {
     // Prepares output stream. Once the file is opened, nothing should fail as
     // it would leave an invalid file on the disk.
-
-    // Builds output filename.
-    const ozz::string filename = _importer.BuildFilename(
-        _config["filename"].asCString(), _raw_track.name.c_str());
-
     ozz::log::LogV() << "Opens output file: " << filename << std::endl;
     ozz::io::File file(filename.c_str(), "wb");
     if (!file.opened()) {
@@ -156,8 +156,10 @@ bool Export(OzzImporter& _importer, const _RawTrack& _raw_track,
       return false;
     }
 
-    // Initializes output archive.
-    ozz::io::OArchive archive(&file, _endianness);
+    // Initializes output archive, buffering the many small archive writes
+    // into block sized file accesses.
+    ozz::io::BufferedStream buffered(&file);
+    ozz::io::OArchive archive(&buffered, _endianness);
 
     // Fills output archive with the track.
     if (_config["raw"].asBool()) {
@@ -168,6 +170,7 @@ bool Export(OzzImporter& _importer, const _RawTrack& _raw_track,
       archive << *track;
     }
   }
+  RecordBuildOutput(filename.c_str());
 
   ozz::log::LogV() << "Track binary archive successfully outputted."
                    << std::endl;
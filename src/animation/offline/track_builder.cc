@@ -27,16 +27,25 @@
 
 #include "ozz/animation/offline/track_builder.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <cstring>
 #include <limits>
+#include <utility>
 
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/maths/math_ex.h"
+#include "ozz/base/maths/simd_math.h"
 #include "ozz/base/memory/allocator.h"
 
 #include "ozz/animation/offline/raw_track.h"
 
+#include "ozz/animation/runtime/quantized_track.h"
 #include "ozz/animation/runtime/track.h"
+#include "ozz/animation/runtime/track_bundle.h"
+#include "ozz/animation/runtime/track_edge_index.h"
+#include "ozz/animation/runtime/track_soa.h"
 
 namespace ozz {
 namespace animation {
@@ -87,6 +96,44 @@ void PatchBeginEndKeys(const _RawTrack& _input,
   }
 }
 
+// In place variant of PatchBeginEndKeys, for the move-semantics build path:
+// begin and end keys are patched directly into the consumed track keyframes.
+template <typename _RawTrack>
+void PatchBeginEndKeysInPlace(_RawTrack* _track) {
+  typename _RawTrack::Keyframes& keyframes = _track->keyframes;
+  if (keyframes.empty()) {
+    const typename _RawTrack::ValueType default_value =
+        animation::internal::TrackPolicy<
+            typename _RawTrack::ValueType>::identity();
+    const typename _RawTrack::Keyframe begin = {RawTrackInterpolation::kLinear,
+                                                0.f, default_value};
+    keyframes.push_back(begin);
+    const typename _RawTrack::Keyframe end = {RawTrackInterpolation::kLinear,
+                                              1.f, default_value};
+    keyframes.push_back(end);
+  } else if (keyframes.size() == 1) {
+    const typename _RawTrack::ValueType value = keyframes.front().value;
+    const typename _RawTrack::Keyframe begin = {RawTrackInterpolation::kLinear,
+                                                0.f, value};
+    keyframes.front() = begin;
+    const typename _RawTrack::Keyframe end = {RawTrackInterpolation::kLinear,
+                                              1.f, value};
+    keyframes.push_back(end);
+  } else {
+    // Push an initial and last keys if they don't exist.
+    if (keyframes.front().ratio != 0.f) {
+      const typename _RawTrack::Keyframe begin = {
+          RawTrackInterpolation::kLinear, 0.f, keyframes.front().value};
+      keyframes.insert(keyframes.begin(), begin);
+    }
+    if (keyframes.back().ratio != 1.f) {
+      const typename _RawTrack::Keyframe end = {RawTrackInterpolation::kLinear,
+                                                1.f, keyframes.back().value};
+      keyframes.push_back(end);
+    }
+  }
+}
+
 template <typename _Keyframes>
 void Fixup(_Keyframes* _keyframes) {
   // Nothing to do by default.
@@ -125,29 +172,157 @@ unique_ptr<_Track> TrackBuilder::Build(const _RawTrack& _input) const {
   // the shortest path during the normalized-lerp.
   Fixup(&keyframes);
 
-  // Allocates output track.
-  const size_t name_len = _input.name.size();
-  track->Allocate(keyframes.size(), _input.name.size());
+  // Allocates output track and copies prepared keys.
+  Fill(keyframes, _input.name.c_str(), track.get());
+
+  return track;  // Success.
+}
+
+// Move-semantics variant of Build. The consumed _input keyframes vector is
+// the working buffer: sorting, begin/end patching and fixup all happen in
+// place, so a conversion costs a single allocation, the runtime track one
+// (plus a possible grow of the consumed vector when begin or end keys are
+// missing).
+template <typename _RawTrack, typename _Track>
+unique_ptr<_Track> TrackBuilder::Build(_RawTrack&& _input) const {
+  // Sorts keyframes in place. Ordering is the only validity requirement a
+  // consumed input is exempted from.
+  std::stable_sort(_input.keyframes.begin(), _input.keyframes.end(),
+                   [](const typename _RawTrack::Keyframe& _a,
+                      const typename _RawTrack::Keyframe& _b) {
+                     return _a.ratio < _b.ratio;
+                   });
+
+  // Tests remaining validity requirements (ranges, duplicated ratios...).
+  if (!_input.Validate()) {
+    return unique_ptr<_Track>();
+  }
+
+  // Everything is fine, allocates and fills the track.
+  // Nothing can fail now.
+  unique_ptr<_Track> track = make_unique<_Track>();
+
+  // Ensure there's a key frame at the start and end of the track (required
+  // for sampling).
+  PatchBeginEndKeysInPlace(&_input);
+
+  // Fixup values, ex: successive opposite quaternions that would fail to take
+  // the shortest path during the normalized-lerp.
+  Fixup(&_input.keyframes);
+
+  // Allocates output track and copies prepared keys.
+  Fill(_input.keyframes, _input.name.c_str(), track.get());
+
+  return track;  // Success.
+}
+
+// Bulk variant, forwarding each consumed input to the move-semantics Build.
+template <typename _RawTrack, typename _Track>
+size_t TrackBuilder::BuildBulk(
+    const span<_RawTrack>& _inputs,
+    const span<unique_ptr<_Track>>& _outputs) const {
+  // Tests output is big enough for all inputs.
+  if (_outputs.size() < _inputs.size()) {
+    return 0;
+  }
+  size_t built = 0;
+  for (size_t i = 0; i < _inputs.size(); ++i) {
+    _outputs[i] = Build<_RawTrack, _Track>(std::move(_inputs[i]));
+    built += _outputs[i] != nullptr;
+  }
+  return built;
+}
+
+// Allocates _track and fills it from prepared _keyframes.
+template <typename _Keyframes, typename _Track>
+void TrackBuilder::Fill(const _Keyframes& _keyframes, const char* _name,
+                        _Track* _track) const {
+  const size_t name_len = strlen(_name);
+  _track->Allocate(_keyframes.size(), name_len);
 
   // Copy all keys to output.
-  assert(keyframes.size() == track->ratios_.size() &&
-         keyframes.size() == track->values_.size() &&
-         keyframes.size() <= track->steps_.size() * 8);
-  memset(track->steps_.data(), 0, track->steps_.size_bytes());
-  for (size_t i = 0; i < keyframes.size(); ++i) {
-    const typename _RawTrack::Keyframe& src_key = keyframes[i];
-    track->ratios_[i] = src_key.ratio;
-    track->values_[i] = src_key.value;
-    track->steps_[i / 8] |=
+  assert(_keyframes.size() == _track->ratios_.size() &&
+         _keyframes.size() == _track->values_.size() &&
+         _keyframes.size() <= _track->steps_.size() * 8);
+  memset(_track->steps_.data(), 0, _track->steps_.size_bytes());
+  for (size_t i = 0; i < _keyframes.size(); ++i) {
+    const typename _Keyframes::value_type& src_key = _keyframes[i];
+    _track->ratios_[i] = src_key.ratio;
+    _track->values_[i] = src_key.value;
+    _track->steps_[i / 8] |=
         (src_key.interpolation == RawTrackInterpolation::kStep) << (i & 7);
   }
 
   // Copy track's name.
   if (name_len) {
-    strcpy(track->name_, _input.name.c_str());
+    strcpy(_track->name_, _name);
   }
+}
 
-  return track;  // Success.
+// Ensures _inputs' validity and timeline consistency, and allocates the
+// bundle. All tracks must share the same keyframe ratios and interpolations
+// once begin/end keys are patched, so the timeline is stored once for all of
+// them.
+template <typename _RawTrack, typename _TrackBundle>
+unique_ptr<_TrackBundle> TrackBuilder::BuildBundle(
+    const span<const _RawTrack>& _inputs) const {
+  // Tests _inputs validity.
+  if (_inputs.empty()) {
+    return nullptr;
+  }
+  for (const _RawTrack& input : _inputs) {
+    if (!input.Validate()) {
+      return nullptr;
+    }
+  }
+
+  const size_t num_tracks = _inputs.size();
+
+  // Ensure every track has a key frame at its start and end (required for
+  // sampling), and fixup values.
+  ozz::vector<typename _RawTrack::Keyframes> keyframes(num_tracks);
+  for (size_t i = 0; i < num_tracks; ++i) {
+    keyframes[i].reserve(_inputs[i].keyframes.size() + 2);
+    PatchBeginEndKeys(_inputs[i], &keyframes[i]);
+    Fixup(&keyframes[i]);
+  }
+
+  // Tests that all tracks share the exact same timeline, the condition for
+  // storing ratios and steps once.
+  const typename _RawTrack::Keyframes& timeline = keyframes.front();
+  for (size_t i = 1; i < num_tracks; ++i) {
+    const typename _RawTrack::Keyframes& track = keyframes[i];
+    if (track.size() != timeline.size()) {
+      return nullptr;
+    }
+    for (size_t k = 0; k < timeline.size(); ++k) {
+      if (track[k].ratio != timeline[k].ratio ||
+          track[k].interpolation != timeline[k].interpolation) {
+        return nullptr;
+      }
+    }
+  }
+
+  // Everything is fine, allocates and fills the bundle.
+  // Nothing can fail now.
+  unique_ptr<_TrackBundle> bundle = make_unique<_TrackBundle>();
+  bundle->Allocate(timeline.size(), num_tracks);
+
+  // Copy shared timeline to output.
+  memset(bundle->steps_.data(), 0, bundle->steps_.size_bytes());
+  for (size_t k = 0; k < timeline.size(); ++k) {
+    bundle->ratios_[k] = timeline[k].ratio;
+    bundle->steps_[k / 8] |=
+        (timeline[k].interpolation == RawTrackInterpolation::kStep) << (k & 7);
+  }
+
+  // Copy all tracks values, interleaved per keyframe.
+  for (size_t i = 0; i < num_tracks; ++i) {
+    for (size_t k = 0; k < timeline.size(); ++k) {
+      bundle->values_[k * num_tracks + i] = keyframes[i][k].value;
+    }
+  }
+  return bundle;  // Success.
 }
 
 unique_ptr<FloatTrack> TrackBuilder::operator()(
@@ -167,6 +342,255 @@ unique_ptr<Float4Track> TrackBuilder::operator()(
   return Build<RawFloat4Track, Float4Track>(_input);
 }
 
+unique_ptr<FloatTrack> TrackBuilder::operator()(RawFloatTrack&& _input) const {
+  return Build<RawFloatTrack, FloatTrack>(std::move(_input));
+}
+unique_ptr<Float2Track> TrackBuilder::operator()(
+    RawFloat2Track&& _input) const {
+  return Build<RawFloat2Track, Float2Track>(std::move(_input));
+}
+unique_ptr<Float3Track> TrackBuilder::operator()(
+    RawFloat3Track&& _input) const {
+  return Build<RawFloat3Track, Float3Track>(std::move(_input));
+}
+unique_ptr<Float4Track> TrackBuilder::operator()(
+    RawFloat4Track&& _input) const {
+  return Build<RawFloat4Track, Float4Track>(std::move(_input));
+}
+
+size_t TrackBuilder::operator()(
+    const span<RawFloatTrack>& _inputs,
+    const span<unique_ptr<FloatTrack>>& _outputs) const {
+  return BuildBulk(_inputs, _outputs);
+}
+size_t TrackBuilder::operator()(
+    const span<RawFloat2Track>& _inputs,
+    const span<unique_ptr<Float2Track>>& _outputs) const {
+  return BuildBulk(_inputs, _outputs);
+}
+size_t TrackBuilder::operator()(
+    const span<RawFloat3Track>& _inputs,
+    const span<unique_ptr<Float3Track>>& _outputs) const {
+  return BuildBulk(_inputs, _outputs);
+}
+size_t TrackBuilder::operator()(
+    const span<RawFloat4Track>& _inputs,
+    const span<unique_ptr<Float4Track>>& _outputs) const {
+  return BuildBulk(_inputs, _outputs);
+}
+
+unique_ptr<FloatTrackBundle> TrackBuilder::Bundle(
+    const span<const RawFloatTrack>& _inputs) const {
+  return BuildBundle<RawFloatTrack, FloatTrackBundle>(_inputs);
+}
+unique_ptr<Float2TrackBundle> TrackBuilder::Bundle(
+    const span<const RawFloat2Track>& _inputs) const {
+  return BuildBundle<RawFloat2Track, Float2TrackBundle>(_inputs);
+}
+unique_ptr<Float3TrackBundle> TrackBuilder::Bundle(
+    const span<const RawFloat3Track>& _inputs) const {
+  return BuildBundle<RawFloat3Track, Float3TrackBundle>(_inputs);
+}
+unique_ptr<Float4TrackBundle> TrackBuilder::Bundle(
+    const span<const RawFloat4Track>& _inputs) const {
+  return BuildBundle<RawFloat4Track, Float4TrackBundle>(_inputs);
+}
+
+unique_ptr<FloatTrackSoA> TrackBuilder::operator()(
+    const span<const RawFloatTrack>& _inputs) const {
+  // Tests _inputs validity.
+  if (_inputs.empty()) {
+    return nullptr;
+  }
+  for (const RawFloatTrack& input : _inputs) {
+    if (!input.Validate()) {
+      return nullptr;
+    }
+  }
+
+  // Everything is fine, allocates and fills the tracks.
+  // Nothing can fail now.
+  const size_t num_tracks = _inputs.size();
+
+  // Ensure every track has a key frame at its start and end (required for
+  // sampling).
+  ozz::vector<RawFloatTrack::Keyframes> keyframes(num_tracks);
+  for (size_t i = 0; i < num_tracks; ++i) {
+    keyframes[i].reserve(_inputs[i].keyframes.size() + 2);
+    PatchBeginEndKeys(_inputs[i], &keyframes[i]);
+  }
+
+  // Builds the sorted union of all tracks' keyframe ratios, which always
+  // contains 0 and 1 thanks to patching. Resampling tracks on the union is
+  // lossless, as every union interval lies inside a single interval of each
+  // track, for both linear and step interpolation.
+  ozz::vector<float> ratios;
+  for (const RawFloatTrack::Keyframes& track : keyframes) {
+    for (const RawFloatTrack::Keyframe& key : track) {
+      ratios.push_back(key.ratio);
+    }
+  }
+  std::sort(ratios.begin(), ratios.end());
+  ratios.erase(std::unique(ratios.begin(), ratios.end()), ratios.end());
+
+  // Allocates output tracks.
+  unique_ptr<FloatTrackSoA> tracks = make_unique<FloatTrackSoA>();
+  tracks->Allocate(ratios.size(), num_tracks);
+  std::copy(ratios.begin(), ratios.end(), tracks->ratios_.begin());
+  memset(tracks->steps_.data(), 0, tracks->steps_.size_bytes());
+
+  // Resamples each track at every union ratio. The union interval starting at
+  // a ratio is a step one if the track key governing that ratio is a step key.
+  const size_t steps_stride = (num_tracks + 7) / 8;
+  for (size_t i = 0; i < num_tracks; ++i) {
+    const RawFloatTrack::Keyframes& track = keyframes[i];
+    size_t id1 = 0;  // Union ratios are processed in order, moves forward.
+    for (size_t k = 0; k < ratios.size(); ++k) {
+      const float ratio = ratios[k];
+
+      // Finds the first track key with a ratio greater than the union ratio.
+      // The first track key ratio is 0, so id1 can't stay 0.
+      while (id1 != track.size() && track[id1].ratio <= ratio) {
+        ++id1;
+      }
+      assert(id1 > 0);
+      const RawFloatTrack::Keyframe& k0 = track[id1 - 1];
+
+      float value;
+      bool step;
+      if (id1 == track.size() ||
+          k0.interpolation == RawTrackInterpolation::kStep) {
+        value = k0.value;
+        step = k0.interpolation == RawTrackInterpolation::kStep;
+      } else {
+        const RawFloatTrack::Keyframe& k1 = track[id1];
+        const float alpha = (ratio - k0.ratio) / (k1.ratio - k0.ratio);
+        value = animation::internal::TrackPolicy<float>::Lerp(k0.value,
+                                                              k1.value, alpha);
+        step = false;
+      }
+      tracks->values_[k * num_tracks + i] = value;
+      tracks->steps_[k * steps_stride + i / 8] |= step << (i & 7);
+    }
+  }
+  return tracks;  // Success.
+}
+
+unique_ptr<TrackEdgeIndex> TrackBuilder::operator()(const RawFloatTrack& _input,
+                                                    float _threshold) const {
+  // Tests _input validity.
+  if (!_input.Validate()) {
+    return nullptr;
+  }
+
+  // Everything is fine, detects and stores edges.
+  // Nothing can fail now.
+
+  // Ensure there's a key frame at the start and end of the track, as done when
+  // building the runtime track, so edges are detected on the same keys
+  // TrackTriggeringJob would process.
+  RawFloatTrack::Keyframes keyframes;
+  keyframes.reserve(_input.keyframes.size() + 2);
+  PatchBeginEndKeys(_input, &keyframes);
+
+  // Detects all edges of a single track loop, in forward order, replicating
+  // TrackTriggeringJob detection. Pair (last key, first key) is the looping
+  // edge candidate. Edges come out sorted, as the edge of a pair of keys lies
+  // within the pair ratio interval.
+  ozz::vector<float> ratios;
+  ozz::vector<bool> risings;
+  const size_t num_keys = keyframes.size();
+  for (size_t i1 = 0; i1 < num_keys; ++i1) {
+    const size_t i0 = i1 == 0 ? num_keys - 1 : i1 - 1;
+    const RawFloatTrack::Keyframe& k0 = keyframes[i0];
+    const RawFloatTrack::Keyframe& k1 = keyframes[i1];
+
+    bool rising;
+    if (k0.value <= _threshold && k1.value > _threshold) {
+      rising = true;
+    } else if (k0.value > _threshold && k1.value <= _threshold) {
+      rising = false;
+    } else {
+      continue;  // No edge for this pair of keys.
+    }
+
+    float ratio;
+    if (k0.interpolation == RawTrackInterpolation::kStep) {
+      ratio = k1.ratio;
+    } else if (i1 == 0) {
+      ratio = 0.f;  // Looping edge of a non step key.
+    } else {
+      // Finds where the curve crosses threshold value, aka un-lerp.
+      assert(k0.value != k1.value);  // Won't divide by 0.
+      const float alpha = (_threshold - k0.value) / (k1.value - k0.value);
+      ratio = math::Lerp(k0.ratio, k1.ratio, alpha);
+    }
+    ratios.push_back(ratio);
+    risings.push_back(rising);
+  }
+
+  // Allocates and fills output index.
+  unique_ptr<TrackEdgeIndex> index = make_unique<TrackEdgeIndex>();
+  index->Allocate(ratios.size());
+  index->threshold_ = _threshold;
+  std::copy(ratios.begin(), ratios.end(), index->ratios_.begin());
+  memset(index->risings_.data(), 0, index->risings_.size_bytes());
+  for (size_t i = 0; i < risings.size(); ++i) {
+    index->risings_[i / 8] |= static_cast<uint8_t>(risings[i]) << (i & 7);
+  }
+  index->BuildEdgeBuckets();
+  return index;  // Success.
+}
+
+unique_ptr<QuantizedFloatTrack> TrackBuilder::operator()(
+    const RawFloatTrack& _input, QuantizedFloatTrack::Format _format) const {
+  // Tests _input validity.
+  if (!_input.Validate()) {
+    return nullptr;
+  }
+
+  // Everything is fine, allocates and fills the track.
+  // Nothing can fail now.
+
+  // Ensure there's a key frame at the start and end of the track (required for
+  // sampling).
+  RawFloatTrack::Keyframes keyframes;
+  keyframes.reserve(_input.keyframes.size() + 2);
+  PatchBeginEndKeys(_input, &keyframes);
+
+  // Finds the track value range, used to encode kNormalized values.
+  float value_min = keyframes.front().value;
+  float value_max = value_min;
+  for (size_t i = 1; i < keyframes.size(); ++i) {
+    value_min = math::Min(value_min, keyframes[i].value);
+    value_max = math::Max(value_max, keyframes[i].value);
+  }
+  const float value_extent = value_max - value_min;
+
+  // Allocates output track and quantizes all keys.
+  unique_ptr<QuantizedFloatTrack> track = make_unique<QuantizedFloatTrack>();
+  track->Allocate(keyframes.size());
+  track->format_ = static_cast<uint8_t>(_format);
+  track->value_min_ = value_min;
+  track->value_extent_ = value_extent;
+  memset(track->steps_.data(), 0, track->steps_.size_bytes());
+  for (size_t i = 0; i < keyframes.size(); ++i) {
+    const RawFloatTrack::Keyframe& src_key = keyframes[i];
+    // Ratios are validated in range [0,1].
+    track->ratios_[i] = static_cast<uint16_t>(src_key.ratio * 65535.f + .5f);
+    if (_format == QuantizedFloatTrack::kFloat16) {
+      track->values_[i] = math::FloatToHalf(src_key.value);
+    } else {
+      const float normalized =
+          value_extent == 0.f ? 0.f : (src_key.value - value_min) / value_extent;
+      track->values_[i] = static_cast<uint16_t>(normalized * 65535.f + .5f);
+    }
+    track->steps_[i / 8] |=
+        (src_key.interpolation == RawTrackInterpolation::kStep) << (i & 7);
+  }
+  return track;  // Success.
+}
+
 namespace {
 // Fixes-up successive opposite quaternions that would fail to take the shortest
 // path during the lerp.
@@ -203,6 +627,22 @@ unique_ptr<QuaternionTrack> TrackBuilder::operator()(
     const RawQuaternionTrack& _input) const {
   return Build<RawQuaternionTrack, QuaternionTrack>(_input);
 }
+
+unique_ptr<QuaternionTrack> TrackBuilder::operator()(
+    RawQuaternionTrack&& _input) const {
+  return Build<RawQuaternionTrack, QuaternionTrack>(std::move(_input));
+}
+
+size_t TrackBuilder::operator()(
+    const span<RawQuaternionTrack>& _inputs,
+    const span<unique_ptr<QuaternionTrack>>& _outputs) const {
+  return BuildBulk(_inputs, _outputs);
+}
+
+unique_ptr<QuaternionTrackBundle> TrackBuilder::Bundle(
+    const span<const RawQuaternionTrack>& _inputs) const {
+  return BuildBundle<RawQuaternionTrack, QuaternionTrackBundle>(_inputs);
+}
 }  // namespace offline
 }  // namespace animation
 }  // namespace ozz
@@ -0,0 +1,141 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/aim_chain_job.h"
+
+#include <cassert>
+
+#include "ozz/animation/runtime/ik_aim_job.h"
+#include "ozz/base/maths/math_ex.h"
+#include "ozz/base/maths/simd_quaternion.h"
+
+using namespace ozz::math;
+
+namespace ozz {
+namespace animation {
+AimChainJob::AimChainJob()
+    : target(math::simd_float4::zero()),
+      forward(math::simd_float4::x_axis()),
+      offset(math::simd_float4::zero()),
+      pole_vector(math::simd_float4::y_axis()),
+      chain_weight(1.f),
+      reached(nullptr) {}
+
+bool AimChainJob::Validate() const {
+  bool valid = true;
+  valid &= !joints.empty();
+  valid &= joint_corrections.size() >= joints.size();
+  valid &= joint_ups.empty() || joint_ups.size() == joints.size();
+  valid &= joint_weights.empty() || joint_weights.size() == joints.size();
+  valid &= ozz::math::AreAllTrue1(ozz::math::IsNormalizedEst3(forward));
+  return valid;
+}
+
+bool AimChainJob::Run() const {
+  if (!Validate()) {
+    return false;
+  }
+
+  const size_t num_joints = joints.size();
+
+  // Setups the aim job that will be used for the whole chain. Target and pole
+  // vector are constant for the whole algorithm, in model-space.
+  IKAimJob job;
+  job.target = target;
+  job.pole_vector = pole_vector;
+
+  // The same correction quaternion is re-read each iteration to propagate
+  // previous joint rotation to the next one.
+  SimdQuaternion correction;
+  job.joint_correction = &correction;
+  bool lreached = false;
+  job.reached = &lreached;
+
+  // Aim is applied iteratively from the first joint (the aimed one) to the
+  // last. For the first joint, forward and offset are used as provided. For
+  // the remaining joints, they are brought to each joint local-space, with the
+  // previous joint correction applied, so no model-space update is needed
+  // in-between:
+  // 1. Rotates forward and offset position based on the result of the previous
+  // joint aim.
+  // 2. Brings forward and offset back in joint local-space.
+  for (size_t i = 0; i < num_joints; ++i) {
+    // Setups the model-space matrix of the joint being processed.
+    job.joint = &joints[i];
+
+    // Setups joint local-space up vector.
+    job.up = joint_ups.empty() ? simd_float4::y_axis() : joint_ups[i];
+
+    // Setups joint weight. The last joint being processed needs a full weight
+    // (1.f) to ensure the chain aims at the target.
+    const bool last = i == num_joints - 1;
+    job.weight =
+        chain_weight *
+        ((last || joint_weights.empty()) ? 1.f : joint_weights[i]);
+
+    // Setups offset and forward vector for the current joint being processed.
+    if (i == 0) {
+      // First joint, uses provided forward and offset.
+      job.offset = offset;
+      job.forward = forward;
+    } else {
+      // Applies previous correction to "forward" and "offset", before bringing
+      // them to model-space (_ms).
+      const SimdFloat4 corrected_forward_ms = TransformVector(
+          joints[i - 1], TransformVector(correction, job.forward));
+      const SimdFloat4 corrected_offset_ms = TransformPoint(
+          joints[i - 1], TransformVector(correction, job.offset));
+
+      // Brings "forward" and "offset" to joint local-space. Normalizes forward
+      // again as joint matrices could embed scale.
+      SimdInt4 invertible;
+      (void)invertible;
+      const Float4x4 inv_joint = Invert(joints[i], &invertible);
+      job.forward = NormalizeSafe3(
+          TransformVector(inv_joint, corrected_forward_ms), forward);
+      job.offset = TransformPoint(inv_joint, corrected_offset_ms);
+    }
+
+    // Runs aim job. It can't fail as parameters are all validated.
+    if (!job.Run()) {
+      return false;
+    }
+
+    // Stores joint correction.
+    joint_corrections[i] = correction;
+  }
+
+  // Aim is reached if the last chain joint (the one with a full weight)
+  // reached it.
+  if (reached) {
+    *reached = lreached;
+  }
+
+  return true;
+}
+}  // namespace animation
+}  // namespace ozz
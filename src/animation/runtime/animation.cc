@@ -31,10 +31,13 @@
 #include <cstring>
 #include <limits>
 
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/encode/group_varint.h"
 #include "ozz/base/io/archive.h"
 #include "ozz/base/log.h"
 #include "ozz/base/maths/math_archive.h"
 #include "ozz/base/maths/math_ex.h"
+#include "ozz/base/maths/transform.h"
 #include "ozz/base/memory/allocator.h"
 
 // Internal include file
@@ -44,7 +47,13 @@
 namespace ozz {
 namespace animation {
 
-Animation::Animation() : duration_(0.f), num_tracks_(0), name_(nullptr) {}
+Animation::Animation()
+    : duration_(0.f),
+      num_tracks_(0),
+      name_(nullptr),
+      rig_(nullptr),
+      looping_(false),
+      owns_buffer_(true) {}
 
 Animation::Animation(Animation&& _other) { *this = std::move(_other); }
 
@@ -52,6 +61,9 @@ Animation& Animation::operator=(Animation&& _other) {
   std::swap(duration_, _other.duration_);
   std::swap(num_tracks_, _other.num_tracks_);
   std::swap(name_, _other.name_);
+  std::swap(rig_, _other.rig_);
+  std::swap(looping_, _other.looping_);
+  std::swap(owns_buffer_, _other.owns_buffer_);
   std::swap(timepoints_,_other.timepoints_);
   std::swap(translations_ctrl_, _other.translations_ctrl_);
   std::swap(rotations_ctrl_, _other.rotations_ctrl_);
@@ -59,15 +71,85 @@ Animation& Animation::operator=(Animation&& _other) {
   std::swap(translations_values_, _other.translations_values_);
   std::swap(rotations_values_, _other.rotations_values_);
   std::swap(scales_values_, _other.scales_values_);
+  std::swap(animated_joints_, _other.animated_joints_);
+  std::swap(rotation_classes_, _other.rotation_classes_);
 
   return *this;
 }
 
 Animation::~Animation() { Deallocate(); }
 
-void Animation::Allocate(const AllocateParams& _params) {
+namespace {
+// Size of a component region, see Animation::Bind for the layout.
+template <typename _Key>
+size_t ComponentRegionSize(size_t _keys, size_t _sizeof_ratio,
+                           size_t _iframe_entries, size_t _iframe_offsets) {
+  return _iframe_offsets * sizeof(uint32_t) +
+         _keys * (sizeof(uint16_t) + sizeof(_Key) + _sizeof_ratio) +
+         _iframe_entries * sizeof(byte);
+}
+}  // namespace
+
+size_t Animation::RequiredSize(const AllocateParams& _params) {
+  assert(_params.timepoints <= std::numeric_limits<uint16_t>::max());
+  const size_t sizeof_ratio =
+      _params.timepoints <= std::numeric_limits<uint8_t>::max()
+          ? sizeof(uint8_t)
+          : sizeof(uint16_t);
+
+  // Component regions are packed independently, each starting float aligned,
+  // hence the padding between regions. Keep in sync with Bind.
+  size_t buffer_size = _params.timepoints * sizeof(float);
+  buffer_size += ComponentRegionSize<internal::QuaternionKey>(
+      _params.rotations, sizeof_ratio, _params.rotation_iframes.entries,
+      _params.rotation_iframes.offsets);
+  buffer_size = Align(buffer_size, alignof(float));
+  buffer_size += ComponentRegionSize<internal::Float3Key>(
+      _params.translations, sizeof_ratio, _params.translation_iframes.entries,
+      _params.translation_iframes.offsets);
+  buffer_size = Align(buffer_size, alignof(float));
+  buffer_size += ComponentRegionSize<internal::Float3Key>(
+      _params.scales, sizeof_ratio, _params.scale_iframes.entries,
+      _params.scale_iframes.offsets);
+  buffer_size = Align(buffer_size, alignof(float));
+  buffer_size += (_params.tracks + 7) / 8;
+  buffer_size += (_params.tracks + 3) / 4;  // Rotation classes, 1 per group.
+  buffer_size += _params.name_len > 0 ? _params.name_len + 1 : 0;
+  buffer_size += _params.rig_len > 0 ? _params.rig_len + 1 : 0;
+  return buffer_size;
+}
+
+namespace {
+// Fixes up one component region spans: all the buffers a cursor advance and
+// decompression touch for a component are packed together, so sampling a
+// component doesn't pull another component's data into cache. Serves larger
+// alignment values first within the region. iframe_entries are compressed
+// with gv4 which accesses 3 bytes further than compressed entries, they are
+// followed by the ratios buffer (and further regions) rather than ending the
+// region.
+template <typename _Key>
+void BindComponentRegion(span<byte>& _buffer, size_t _keys,
+                         size_t _sizeof_ratio, size_t _iframe_entries,
+                         size_t _iframe_offsets,
+                         Animation::KeyframesCtrl& _ctrl,
+                         span<_Key>& _values) {
+  _ctrl.iframe_desc = fill_span<uint32_t>(_buffer, _iframe_offsets);
+  _ctrl.previouses = fill_span<uint16_t>(_buffer, _keys);
+  _values = fill_span<_Key>(_buffer, _keys);
+  _ctrl.iframe_entries = fill_span<byte>(_buffer, _iframe_entries);
+  _ctrl.ratios = fill_span<byte>(_buffer, _keys * _sizeof_ratio);
+
+  // Next region starts float aligned, padding is accounted for by
+  // RequiredSize.
+  const size_t pad =
+      Align(_buffer.data(), alignof(float)) - _buffer.data();
+  fill_span<byte>(_buffer, pad);
+}
+}  // namespace
+
+void Animation::Bind(const AllocateParams& _params, span<byte> _buffer) {
   // Distributes buffer memory while ensuring proper alignment (serves larger
-  // alignment values first).
+  // alignment values first within each region).
   static_assert(
       alignof(float) >= alignof(uint32_t) &&
           alignof(uint32_t) >= alignof(uint16_t) &&
@@ -76,88 +158,78 @@ void Animation::Allocate(const AllocateParams& _params) {
           alignof(internal::QuaternionKey) >= alignof(char),
       "Must serve larger alignment values first)");
 
-  assert(timepoints_.empty() && "Animation must be unallocated");
+  assert(IsAligned(_buffer.data(), alignof(float)) && "Invalid alignment");
+  span<byte>& buffer = _buffer;
 
-  // Compute overall size and allocate a single buffer for all the data.
-  assert(_params.timepoints <= std::numeric_limits<uint16_t>::max());
   const size_t sizeof_ratio =
       _params.timepoints <= std::numeric_limits<uint8_t>::max()
           ? sizeof(uint8_t)
           : sizeof(uint16_t);
-  const size_t sizeof_previous = sizeof(uint16_t);
-  const size_t buffer_size =
-      (_params.name_len > 0 ? _params.name_len + 1 : 0) +
-      _params.timepoints * sizeof(float) +
-      _params.translations *
-          (sizeof(internal::Float3Key) + sizeof_ratio + sizeof_previous) +
-      _params.rotations *
-          (sizeof(internal::QuaternionKey) + sizeof_ratio + sizeof_previous) +
-      _params.scales *
-          (sizeof(internal::Float3Key) + sizeof_ratio + sizeof_previous) +
-      _params.translation_iframes.entries * sizeof(byte) +
-      _params.translation_iframes.offsets * sizeof(uint32_t) +
-      _params.rotation_iframes.entries * sizeof(byte) +
-      _params.rotation_iframes.offsets * sizeof(uint32_t) +
-      _params.scale_iframes.entries * sizeof(byte) +
-      _params.scale_iframes.offsets * sizeof(uint32_t);
-  span<byte> buffer = {static_cast<byte*>(memory::default_allocator()->Allocate(
-                           buffer_size, alignof(float))),
-                       buffer_size};
-
-  // Fix up pointers. Serves larger alignment values first.
-
-  // 32b alignment
+
+  // Fix up pointers. Timepoints are shared by every cursor, then component
+  // regions are laid out hottest first: rotations dominate cursor traffic,
+  // scales are mostly constant hence coldest. Keep in sync with RequiredSize.
   timepoints_ = fill_span<float>(buffer, _params.timepoints);
-  translations_ctrl_.iframe_desc =
-      fill_span<uint32_t>(buffer, _params.translation_iframes.offsets);
-  rotations_ctrl_.iframe_desc =
-      fill_span<uint32_t>(buffer, _params.rotation_iframes.offsets);
-  scales_ctrl_.iframe_desc =
-      fill_span<uint32_t>(buffer, _params.scale_iframes.offsets);
-
-  // 16b alignment
-  translations_ctrl_.previouses =
-      fill_span<uint16_t>(buffer, _params.translations);
-  rotations_ctrl_.previouses = fill_span<uint16_t>(buffer, _params.rotations);
-  scales_ctrl_.previouses = fill_span<uint16_t>(buffer, _params.scales);
-  translations_values_ =
-      fill_span<internal::Float3Key>(buffer, _params.translations);
-  rotations_values_ =
-      fill_span<internal::QuaternionKey>(buffer, _params.rotations);
-  scales_values_ = fill_span<internal::Float3Key>(buffer, _params.scales);
-
-  // 16b / 8b alignment
-  translations_ctrl_.ratios =
-      fill_span<byte>(buffer, _params.translations * sizeof_ratio);
-  rotations_ctrl_.ratios =
-      fill_span<byte>(buffer, _params.rotations * sizeof_ratio);
-  scales_ctrl_.ratios = fill_span<byte>(buffer, _params.scales * sizeof_ratio);
-
-  // 8b alignment
-
-  // iframe_entries are compressed with gv4, they must not be at the end of the
-  // buffer, as gv4 will access 3 bytes further than compressed entries.
-  translations_ctrl_.iframe_entries =
-      fill_span<byte>(buffer, _params.translation_iframes.entries);
-  rotations_ctrl_.iframe_entries =
-      fill_span<byte>(buffer, _params.rotation_iframes.entries);
-  scales_ctrl_.iframe_entries =
-      fill_span<byte>(buffer, _params.scale_iframes.entries);
+  BindComponentRegion(buffer, _params.rotations, sizeof_ratio,
+                      _params.rotation_iframes.entries,
+                      _params.rotation_iframes.offsets, rotations_ctrl_,
+                      rotations_values_);
+  BindComponentRegion(buffer, _params.translations, sizeof_ratio,
+                      _params.translation_iframes.entries,
+                      _params.translation_iframes.offsets, translations_ctrl_,
+                      translations_values_);
+  BindComponentRegion(buffer, _params.scales, sizeof_ratio,
+                      _params.scale_iframes.entries,
+                      _params.scale_iframes.offsets, scales_ctrl_,
+                      scales_values_);
+
+  animated_joints_ = fill_span<byte>(buffer, (_params.tracks + 7) / 8);
+  rotation_classes_ = fill_span<byte>(buffer, (_params.tracks + 3) / 4);
 
   // Let name be nullptr if animation has no name. Allows to avoid allocating
   // this buffer in the constructor of empty animations.
   name_ = _params.name_len > 0
               ? fill_span<char>(buffer, _params.name_len + 1).data()
               : nullptr;
+  rig_ = _params.rig_len > 0
+             ? fill_span<char>(buffer, _params.rig_len + 1).data()
+             : nullptr;
 
   assert(buffer.empty() && "Whole buffer should be consumned");
 }
 
+void Animation::Allocate(const AllocateParams& _params) {
+  assert(timepoints_.empty() && "Animation must be unallocated");
+
+  // Compute overall size and allocate a single buffer for all the data.
+  const size_t buffer_size = RequiredSize(_params);
+  span<byte> buffer;
+  if (placement_buffer_.empty()) {
+    const memory::AllocationScope scope(memory::AllocationTag::kAnimation);
+    buffer = {static_cast<byte*>(memory::default_allocator()->Allocate(
+                  buffer_size, alignof(float))),
+              buffer_size};
+    owns_buffer_ = true;
+  } else {
+    // Placement load path, binds into the caller-provided buffer which was
+    // already validated against SizeOf, see the placement Load overload.
+    assert(placement_buffer_.size() >= buffer_size &&
+           IsAligned(placement_buffer_.data(), alignof(float)));
+    buffer = {placement_buffer_.data(), buffer_size};
+    owns_buffer_ = false;
+  }
+  Bind(_params, buffer);
+}
+
 void Animation::Deallocate() {
-  memory::default_allocator()->Deallocate(
-      as_writable_bytes(timepoints_).data());
+  if (owns_buffer_) {
+    memory::default_allocator()->Deallocate(
+        as_writable_bytes(timepoints_).data());
+  }
+  owns_buffer_ = true;
 
   name_ = nullptr;
+  rig_ = nullptr;
   timepoints_ = {};
   translations_ctrl_ = {};
   rotations_ctrl_ = {};
@@ -165,6 +237,456 @@ void Animation::Deallocate() {
   translations_values_ = {};
   rotations_values_ = {};
   scales_values_ = {};
+  animated_joints_ = {};
+  rotation_classes_ = {};
+}
+
+namespace {
+// Header of a relocatable animation image, followed by the animation data
+// block. All fields are stored with native endianness and layout.
+struct RawImageHeader {
+  char tag[12];
+  uint32_t version;
+  float duration;
+  uint32_t num_tracks;
+  uint32_t name_len;
+  uint32_t rig_len;
+  uint32_t timepoints;
+  uint32_t translations;
+  uint32_t rotations;
+  uint32_t scales;
+  uint32_t t_iframe_entries;
+  uint32_t t_iframe_desc;
+  uint32_t r_iframe_entries;
+  uint32_t r_iframe_desc;
+  uint32_t s_iframe_entries;
+  uint32_t s_iframe_desc;
+  float t_iframe_interval;
+  float r_iframe_interval;
+  float s_iframe_interval;
+  uint32_t looping;
+};
+static_assert(sizeof(RawImageHeader) % alignof(float) == 0,
+              "Data block alignment follows from header size.");
+
+const char kRawImageTag[12] = "ozz-raw-ani";
+// Version 2: component data blocks are segregated into per-component regions,
+// see Bind.
+// Version 3: appends the animated joints bitmask.
+// Version 4: adds the rig signature.
+// Version 5: adds the loop safety flag.
+// Version 6: appends the per-group rotation decompression classes.
+const uint32_t kRawImageVersion = 6;
+}  // namespace
+
+size_t Animation::raw_size() const {
+  const AllocateParams params{
+      name_ ? std::strlen(name_) : 0,
+      rig_ ? std::strlen(rig_) : 0,
+      timepoints_.size(),
+      translations_values_.size(),
+      rotations_values_.size(),
+      scales_values_.size(),
+      {translations_ctrl_.iframe_entries.size(),
+       translations_ctrl_.iframe_desc.size()},
+      {rotations_ctrl_.iframe_entries.size(),
+       rotations_ctrl_.iframe_desc.size()},
+      {scales_ctrl_.iframe_entries.size(), scales_ctrl_.iframe_desc.size()},
+      static_cast<size_t>(num_tracks_)};
+  return sizeof(RawImageHeader) + RequiredSize(params);
+}
+
+bool Animation::SaveRaw(span<byte> _buffer) const {
+  const size_t size = raw_size();
+  if (_buffer.size() < size) {
+    return false;
+  }
+
+  // Fills and stores the header.
+  RawImageHeader header;
+  std::memcpy(header.tag, kRawImageTag, sizeof(header.tag));
+  header.version = kRawImageVersion;
+  header.duration = duration_;
+  header.num_tracks = static_cast<uint32_t>(num_tracks_);
+  header.name_len = static_cast<uint32_t>(name_ ? std::strlen(name_) : 0);
+  header.rig_len = static_cast<uint32_t>(rig_ ? std::strlen(rig_) : 0);
+  header.timepoints = static_cast<uint32_t>(timepoints_.size());
+  header.translations = static_cast<uint32_t>(translations_values_.size());
+  header.rotations = static_cast<uint32_t>(rotations_values_.size());
+  header.scales = static_cast<uint32_t>(scales_values_.size());
+  header.t_iframe_entries =
+      static_cast<uint32_t>(translations_ctrl_.iframe_entries.size());
+  header.t_iframe_desc =
+      static_cast<uint32_t>(translations_ctrl_.iframe_desc.size());
+  header.r_iframe_entries =
+      static_cast<uint32_t>(rotations_ctrl_.iframe_entries.size());
+  header.r_iframe_desc =
+      static_cast<uint32_t>(rotations_ctrl_.iframe_desc.size());
+  header.s_iframe_entries =
+      static_cast<uint32_t>(scales_ctrl_.iframe_entries.size());
+  header.s_iframe_desc = static_cast<uint32_t>(scales_ctrl_.iframe_desc.size());
+  header.t_iframe_interval = translations_ctrl_.iframe_interval;
+  header.r_iframe_interval = rotations_ctrl_.iframe_interval;
+  header.s_iframe_interval = scales_ctrl_.iframe_interval;
+  header.looping = looping_;
+  std::memcpy(_buffer.data(), &header, sizeof(header));
+
+  // Copies the data block verbatim. It is contiguous by construction,
+  // starting at the timepoints buffer, see Bind.
+  const size_t data_size = size - sizeof(header);
+  if (data_size > 0) {
+    std::memcpy(_buffer.data() + sizeof(header),
+                as_bytes(timepoints_).data(), data_size);
+  }
+  return true;
+}
+
+bool Animation::LoadRaw(span<const byte> _buffer) {
+  // Destroy animation in case it was already used before.
+  Deallocate();
+  duration_ = 0.f;
+  num_tracks_ = 0;
+  looping_ = false;
+
+  // Validates header.
+  if (_buffer.size() < sizeof(RawImageHeader) ||
+      !IsAligned(_buffer.data(), alignof(float))) {
+    return false;
+  }
+  RawImageHeader header;
+  std::memcpy(&header, _buffer.data(), sizeof(header));
+  if (std::memcmp(header.tag, kRawImageTag, sizeof(header.tag)) != 0 ||
+      header.version != kRawImageVersion) {
+    return false;
+  }
+
+  const AllocateParams params{header.name_len,
+                              header.rig_len,
+                              header.timepoints,
+                              header.translations,
+                              header.rotations,
+                              header.scales,
+                              {header.t_iframe_entries, header.t_iframe_desc},
+                              {header.r_iframe_entries, header.r_iframe_desc},
+                              {header.s_iframe_entries, header.s_iframe_desc},
+                              header.num_tracks};
+  const size_t data_size = RequiredSize(params);
+  if (_buffer.size() < sizeof(header) + data_size) {
+    return false;
+  }
+
+  duration_ = header.duration;
+  num_tracks_ = header.num_tracks;
+
+  // Binds spans into the image data block. The buffer is referenced but never
+  // written, it's only reachable through const accessors.
+  Bind(params, {const_cast<byte*>(_buffer.data()) + sizeof(header), data_size});
+  owns_buffer_ = false;
+
+  // Iframe intervals and the loop flag aren't part of the data block.
+  translations_ctrl_.iframe_interval = header.t_iframe_interval;
+  rotations_ctrl_.iframe_interval = header.r_iframe_interval;
+  scales_ctrl_.iframe_interval = header.s_iframe_interval;
+  looping_ = header.looping != 0;
+
+  return true;
+}
+
+namespace {
+// Iframes of one component, rebuilt for permuted tracks by PermuteIFrames.
+struct PermutedIFrames {
+  ozz::vector<byte> entries;
+  ozz::vector<uint32_t> desc;
+};
+
+// Rebuilds a component's iframes for permuted tracks. Each iframe stores the
+// latest key index per track (gv4 compressed), so both the track slot and the
+// stored key index must be remapped. Re-encoding remapped indices can change
+// compressed sizes, hence offsets (desc) are rebuilt as well.
+void PermuteIFrames(const Animation::KeyframesCtrlConst& _ctrl,
+                    const span<const uint16_t>& _old_tracks,
+                    const span<const uint32_t>& _new_positions,
+                    PermutedIFrames* _out) {
+  const size_t num_tracks = _old_tracks.size();
+  ozz::vector<uint32_t> old_entries(num_tracks);
+  ozz::vector<uint32_t> new_entries(num_tracks);
+  for (size_t i = 0; i < _ctrl.iframe_desc.size(); i += 2) {
+    const size_t offset = _ctrl.iframe_desc[i];
+    ozz::DecodeGV4Stream(_ctrl.iframe_entries.subspan(
+                             offset, _ctrl.iframe_entries.size() - offset),
+                         make_span(old_entries));
+    uint32_t last = 0;
+    for (size_t j = 0; j < num_tracks; ++j) {
+      const uint32_t key = old_entries[_old_tracks[j]];
+      const uint32_t new_key =
+          key < _new_positions.size() ? _new_positions[key] : key;
+      new_entries[j] = new_key;
+      last = math::Max(last, new_key);
+    }
+
+    // Compresses and appends the remapped entries.
+    const size_t begin = _out->entries.size();
+    const size_t worst_size =
+        ozz::ComputeGV4WorstBufferSize(make_span(new_entries));
+    _out->entries.resize(begin + worst_size);
+    const auto remain = ozz::EncodeGV4Stream(
+        make_span(new_entries),
+        make_span(_out->entries).subspan(begin, worst_size));
+    _out->entries.resize(_out->entries.size() - remain.size_bytes());
+    _out->desc.push_back(static_cast<uint32_t>(begin));
+    _out->desc.push_back(last);
+  }
+}
+
+// Copies one component's keyframes to their permuted positions. Keys are
+// sorted so that the first 2 keyframes of each track lay in the 2 leading
+// track-ordered blocks (see sorting in AnimationBuilder): those are the only
+// keys that move, and previous-key offsets are rechained accordingly. Returns
+// false if a rechained offset overflows the keyframe format.
+template <typename _Key>
+bool PermuteComponentKeys(const Animation::KeyframesCtrlConst& _src,
+                          const span<const _Key>& _src_values,
+                          size_t _sizeof_ratio,
+                          const span<const uint32_t>& _new_positions,
+                          const Animation::KeyframesCtrl& _dest,
+                          const span<_Key>& _dest_values) {
+  const size_t moved = _new_positions.size();
+  for (size_t i = 0; i < _src_values.size(); ++i) {
+    const size_t dest = i < moved ? _new_positions[i] : i;
+    _dest_values[dest] = _src_values[i];
+    std::memcpy(_dest.ratios.data() + dest * _sizeof_ratio,
+                _src.ratios.data() + i * _sizeof_ratio, _sizeof_ratio);
+
+    // First keys of a track (null offset) have no previous to chain to.
+    const uint16_t previous = _src.previouses[i];
+    if (previous == 0) {
+      _dest.previouses[dest] = 0;
+      continue;
+    }
+    const size_t target = i - previous;
+    const size_t dest_target =
+        target < moved ? _new_positions[target] : target;
+    assert(dest > dest_target && "Sorting, hence chaining order, is preserved");
+    const size_t dest_previous = dest - dest_target;
+    if (dest_previous >= internal::kMaxPreviousOffset) {
+      return false;
+    }
+    _dest.previouses[dest] = static_cast<uint16_t>(dest_previous);
+  }
+  return true;
+}
+
+void CopyPermutedIFrames(const PermutedIFrames& _src,
+                         Animation::KeyframesCtrl& _dest, float _interval) {
+  assert(_dest.iframe_entries.size() == _src.entries.size());
+  std::copy(_src.entries.begin(), _src.entries.end(),
+            _dest.iframe_entries.begin());
+  assert(_dest.iframe_desc.size() == _src.desc.size());
+  std::copy(_src.desc.begin(), _src.desc.end(), _dest.iframe_desc.begin());
+  _dest.iframe_interval = _interval;
+}
+}  // namespace
+
+bool Animation::PermuteTracks(const span<const uint16_t>& _permutation) {
+  const size_t num_tracks = static_cast<size_t>(num_tracks_);
+  if (num_tracks == 0 || _permutation.size() != num_tracks) {
+    return false;
+  }
+
+  // Validates bijectivity and extends the permutation with identity soa
+  // padding tracks (which hold repeated keys of the last valid track).
+  const size_t padded = Align(num_tracks, size_t(4));
+  ozz::vector<uint16_t> old_tracks(padded);
+  {
+    ozz::vector<bool> seen(num_tracks, false);
+    for (size_t i = 0; i < num_tracks; ++i) {
+      const uint16_t track = _permutation[i];
+      if (track >= num_tracks || seen[track]) {
+        return false;
+      }
+      seen[track] = true;
+      old_tracks[i] = track;
+    }
+  }
+  for (size_t i = num_tracks; i < padded; ++i) {
+    old_tracks[i] = static_cast<uint16_t>(i);
+  }
+
+  // New position of each key of the 2 leading blocks of first and second
+  // track keys, which are laid out in track order. Later keys don't move,
+  // only their previous-key offsets may be rechained.
+  ozz::vector<uint32_t> new_positions(padded * 2);
+  for (size_t i = 0; i < padded; ++i) {
+    new_positions[old_tracks[i]] = static_cast<uint32_t>(i);
+    new_positions[padded + old_tracks[i]] = static_cast<uint32_t>(padded + i);
+  }
+
+  const memory::AllocationScope scope(memory::AllocationTag::kAnimation);
+
+  // Rebuilds iframes upfront, as re-encoded sizes drive allocation.
+  PermutedIFrames t_iframes, r_iframes, s_iframes;
+  PermuteIFrames(translations_ctrl_, make_span(old_tracks),
+                 make_span(new_positions), &t_iframes);
+  PermuteIFrames(rotations_ctrl_, make_span(old_tracks),
+                 make_span(new_positions), &r_iframes);
+  PermuteIFrames(scales_ctrl_, make_span(old_tracks), make_span(new_positions),
+                 &s_iframes);
+
+  const AllocateParams params{name_ ? std::strlen(name_) : 0,
+                              rig_ ? std::strlen(rig_) : 0,
+                              timepoints_.size(),
+                              translations_values_.size(),
+                              rotations_values_.size(),
+                              scales_values_.size(),
+                              {t_iframes.entries.size(), t_iframes.desc.size()},
+                              {r_iframes.entries.size(), r_iframes.desc.size()},
+                              {s_iframes.entries.size(), s_iframes.desc.size()},
+                              num_tracks};
+  Animation permuted;
+  permuted.duration_ = duration_;
+  permuted.num_tracks_ = num_tracks_;
+  permuted.Allocate(params);
+
+  std::copy(timepoints_.begin(), timepoints_.end(),
+            permuted.timepoints_.begin());
+  if (permuted.name_) {
+    strcpy(permuted.name_, name_);
+  }
+  if (permuted.rig_) {
+    strcpy(permuted.rig_, rig_);
+  }
+
+  CopyPermutedIFrames(t_iframes, permuted.translations_ctrl_,
+                      translations_ctrl_.iframe_interval);
+  CopyPermutedIFrames(r_iframes, permuted.rotations_ctrl_,
+                      rotations_ctrl_.iframe_interval);
+  CopyPermutedIFrames(s_iframes, permuted.scales_ctrl_,
+                      scales_ctrl_.iframe_interval);
+
+  const size_t sizeof_ratio =
+      timepoints_.size() <= std::numeric_limits<uint8_t>::max()
+          ? sizeof(uint8_t)
+          : sizeof(uint16_t);
+  if (!PermuteComponentKeys(
+          Animation::KeyframesCtrlConst(translations_ctrl_),
+          span<const internal::Float3Key>(translations_values_), sizeof_ratio,
+          make_span(new_positions), permuted.translations_ctrl_,
+          permuted.translations_values_) ||
+      !PermuteComponentKeys(
+          Animation::KeyframesCtrlConst(rotations_ctrl_),
+          span<const internal::QuaternionKey>(rotations_values_), sizeof_ratio,
+          make_span(new_positions), permuted.rotations_ctrl_,
+          permuted.rotations_values_) ||
+      !PermuteComponentKeys(
+          Animation::KeyframesCtrlConst(scales_ctrl_),
+          span<const internal::Float3Key>(scales_values_), sizeof_ratio,
+          make_span(new_positions), permuted.scales_ctrl_,
+          permuted.scales_values_)) {
+    return false;
+  }
+
+  // Animated joints bitmask follows track order.
+  std::memset(permuted.animated_joints_.data(), 0,
+              permuted.animated_joints_.size_bytes());
+  for (size_t i = 0; i < num_tracks; ++i) {
+    const size_t old_track = old_tracks[i];
+    if ((animated_joints_[old_track / 8] >> (old_track & 7)) & 1) {
+      permuted.animated_joints_[i / 8] =
+          static_cast<byte>(permuted.animated_joints_[i / 8] | (1 << (i & 7)));
+    }
+  }
+
+  // Rotation classes are per soa group of 4 tracks: permutation regroups
+  // tracks, so classes are recomputed from the permuted key stream.
+  internal::ClassifyQuaternionTracks(
+      Align(num_tracks, size_t(4)),
+      span<const internal::QuaternionKey>(permuted.rotations_values_),
+      span<const uint16_t>(permuted.rotations_ctrl_.previouses),
+      permuted.rotation_classes_);
+
+  *this = std::move(permuted);
+  return true;
+}
+
+namespace {
+// Transcodes each key value of a component with _rebase, resolving each key's
+// track on the fly: the 2 leading blocks of soa-padded first and second track
+// keys are laid out in track order (see sorting in AnimationBuilder), later
+// keys belong to the track of the key their previous offset chains to. Soa
+// padding tracks (track >= _num_tracks) hold identity keys, which already are
+// additive identities and are left untouched.
+template <typename _Key, typename _Rebaser>
+void RebaseComponentKeys(const Animation::KeyframesCtrlConst& _ctrl,
+                         const span<_Key>& _values, size_t _num_tracks,
+                         const _Rebaser& _rebase) {
+  const size_t padded = Align(_num_tracks, size_t(4));
+  ozz::vector<uint16_t> tracks(_values.size());
+  for (size_t i = 0; i < _values.size(); ++i) {
+    const uint16_t track = i < padded * 2
+                               ? static_cast<uint16_t>(i % padded)
+                               : tracks[i - _ctrl.previouses[i]];
+    tracks[i] = track;
+    if (track < _num_tracks) {
+      _rebase(track, &_values[i]);
+    }
+  }
+}
+}  // namespace
+
+bool Animation::MakeAdditive(
+    const span<const math::Transform>& _reference_pose) {
+  const size_t num_tracks = static_cast<size_t>(num_tracks_);
+  if (num_tracks == 0 || _reference_pose.size() != num_tracks) {
+    return false;
+  }
+  // A null reference scale component cannot be inverted into a delta.
+  for (size_t i = 0; i < num_tracks; ++i) {
+    const math::Float3& scale = _reference_pose[i].scale;
+    if (scale.x == 0.f || scale.y == 0.f || scale.z == 0.f) {
+      return false;
+    }
+  }
+
+  const memory::AllocationScope scope(memory::AllocationTag::kAnimation);
+
+  // Rebases each component stream, with the same delta convention as the
+  // offline AdditiveAnimationBuilder.
+  RebaseComponentKeys(
+      Animation::KeyframesCtrlConst(translations_ctrl_), translations_values_,
+      num_tracks,
+      [&_reference_pose](uint16_t _track, internal::Float3Key* _key) {
+        const math::Float3 delta = internal::DecompressFloat3(*_key) -
+                                   _reference_pose[_track].translation;
+        internal::CompressFloat3(delta, _key);
+      });
+  RebaseComponentKeys(
+      Animation::KeyframesCtrlConst(rotations_ctrl_), rotations_values_,
+      num_tracks,
+      [&_reference_pose](uint16_t _track, internal::QuaternionKey* _key) {
+        // Normalizes the delta, as decompressed quaternions deviate from unit
+        // length by their quantization error and compression expects
+        // normalized inputs.
+        const math::Quaternion delta =
+            Normalize(Conjugate(_reference_pose[_track].rotation) *
+                      internal::DecompressQuaternion(*_key));
+        internal::CompressQuaternion(delta, _key);
+      });
+  RebaseComponentKeys(
+      Animation::KeyframesCtrlConst(scales_ctrl_), scales_values_, num_tracks,
+      [&_reference_pose](uint16_t _track, internal::Float3Key* _key) {
+        const math::Float3 delta =
+            internal::DecompressFloat3(*_key) / _reference_pose[_track].scale;
+        internal::CompressFloat3(delta, _key);
+      });
+
+  // Delta rotations don't share the source keys largest component and sign
+  // statistics, decompression classes are recomputed for the transcoded
+  // stream.
+  internal::ClassifyQuaternionTracks(
+      Align(num_tracks, size_t(4)),
+      span<const internal::QuaternionKey>(rotations_values_),
+      span<const uint16_t>(rotations_ctrl_.previouses), rotation_classes_);
+  return true;
 }
 
 size_t Animation::size() const {
@@ -172,9 +694,74 @@ size_t Animation::size() const {
       sizeof(*this) + timepoints_.size_bytes() +
       translations_ctrl_.size_bytes() + rotations_ctrl_.size_bytes() +
       scales_ctrl_.size_bytes() + translations_values_.size_bytes() +
-      rotations_values_.size_bytes() + scales_values_.size_bytes();
+      rotations_values_.size_bytes() + scales_values_.size_bytes() +
+      animated_joints_.size_bytes() + rotation_classes_.size_bytes();
   return size;
 }
+
+namespace {
+// On-disk keyframe streams are delta encoded: uint16 lanes hold slowly
+// varying quantized values (and previous key offsets), so residuals against
+// the previous key of the same lane are small, and compress well with group
+// varint encoding. Residuals are zigzag mapped to unsigned first.
+inline uint32_t EncodeZigZag(int32_t _v) {
+  return (static_cast<uint32_t>(_v) << 1) ^ static_cast<uint32_t>(_v >> 31);
+}
+inline int32_t DecodeZigZag(uint32_t _v) {
+  return static_cast<int32_t>(_v >> 1) ^ -static_cast<int32_t>(_v & 1);
+}
+
+// Stores _stream to _archive as gv4 packed deltas, where each element is
+// delta encoded against the previous element of its lane (_lanes elements
+// back, eg. the matching component of the previous key).
+void SaveDeltaU16Stream(ozz::io::OArchive& _archive,
+                        const span<const uint16_t>& _stream, size_t _lanes) {
+  // Group varint encodes 4 values at once, deltas are padded with zeros.
+  const size_t padded = Align(_stream.size(), size_t(4));
+  ozz::vector<uint32_t> deltas(padded, 0);
+  for (size_t i = 0; i < _stream.size(); ++i) {
+    const int32_t previous =
+        i >= _lanes ? static_cast<int32_t>(_stream[i - _lanes]) : 0;
+    deltas[i] = EncodeZigZag(static_cast<int32_t>(_stream[i]) - previous);
+  }
+
+  // Worst case gv4 size is 17 bytes per group of 4.
+  ozz::vector<byte> encoded(padded / 4 * 17);
+  span<byte> remaining = {encoded.data(), encoded.size()};
+  for (size_t i = 0; i < padded; i += 4) {
+    remaining = EncodeGV4({&deltas[i], 4}, remaining);
+  }
+
+  const size_t encoded_size = encoded.size() - remaining.size();
+  _archive << static_cast<uint32_t>(encoded_size);
+  _archive << ozz::io::MakeArray(encoded.data(), encoded_size);
+}
+
+// Mirrors SaveDeltaU16Stream. _stream must already be sized, as counts are
+// stored upfront by Animation::Save.
+void LoadDeltaU16Stream(ozz::io::IArchive& _archive,
+                        const span<uint16_t>& _stream, size_t _lanes) {
+  uint32_t encoded_size;
+  _archive >> encoded_size;
+
+  // gv4 decoding can read up to 3 bytes further than encoded data.
+  ozz::vector<byte> encoded(encoded_size + 3);
+  _archive >> ozz::io::MakeArray(encoded.data(), encoded_size);
+
+  const size_t padded = Align(_stream.size(), size_t(4));
+  ozz::vector<uint32_t> deltas(padded, 0);
+  span<const byte> remaining = {encoded.data(), encoded.size()};
+  for (size_t i = 0; i < padded; i += 4) {
+    remaining = DecodeGV4(remaining, {&deltas[i], 4});
+  }
+
+  for (size_t i = 0; i < _stream.size(); ++i) {
+    const int32_t previous =
+        i >= _lanes ? static_cast<int32_t>(_stream[i - _lanes]) : 0;
+    _stream[i] = static_cast<uint16_t>(previous + DecodeZigZag(deltas[i]));
+  }
+}
+}  // namespace
 }  // namespace animation
 
 namespace io {
@@ -209,6 +796,7 @@ struct Extern<animation::Animation::KeyframesCtrl> {
 };
 
 OZZ_IO_TYPE_NOT_VERSIONABLE(animation::internal::Float3Key)
+OZZ_IO_TYPE_RAW(animation::internal::Float3Key)
 template <>
 struct Extern<animation::internal::Float3Key> {
   static void Save(OArchive& _archive,
@@ -224,6 +812,7 @@ struct Extern<animation::internal::Float3Key> {
   }
 };
 OZZ_IO_TYPE_NOT_VERSIONABLE(animation::internal::QuaternionKey)
+OZZ_IO_TYPE_RAW(animation::internal::QuaternionKey)
 template <>
 struct Extern<animation::internal::QuaternionKey> {
   static void Save(OArchive& _archive,
@@ -248,6 +837,8 @@ void Animation::Save(ozz::io::OArchive& _archive) const {
 
   const size_t name_len = name_ ? std::strlen(name_) : 0;
   _archive << static_cast<uint32_t>(name_len);
+  const size_t rig_len = rig_ ? std::strlen(rig_) : 0;
+  _archive << static_cast<uint32_t>(rig_len);
 
   const size_t timepoints_count = timepoints_.size();
   _archive << static_cast<uint32_t>(timepoints_count);
@@ -272,37 +863,52 @@ void Animation::Save(ozz::io::OArchive& _archive) const {
   _archive << static_cast<uint32_t>(s_iframe_desc_count);
 
   _archive << ozz::io::MakeArray(name_, name_len);
+  _archive << ozz::io::MakeArray(rig_, rig_len);
   _archive << ozz::io::MakeArray(timepoints_);
 
   _archive << translations_ctrl_;
-  _archive << io::MakeArray(translations_values_);
+  SaveDeltaU16Stream(
+      _archive,
+      {reinterpret_cast<const uint16_t*>(translations_values_.data()),
+       translations_values_.size() * 3},
+      3);
   _archive << rotations_ctrl_;
-  _archive << io::MakeArray(rotations_values_);
+  SaveDeltaU16Stream(
+      _archive,
+      {reinterpret_cast<const uint16_t*>(rotations_values_.data()),
+       rotations_values_.size() * 3},
+      3);
   _archive << scales_ctrl_;
-  _archive << io::MakeArray(scales_values_);
-}
+  SaveDeltaU16Stream(
+      _archive,
+      {reinterpret_cast<const uint16_t*>(scales_values_.data()),
+       scales_values_.size() * 3},
+      3);
 
-void Animation::Load(ozz::io::IArchive& _archive, uint32_t _version) {
-  // Destroy animation in case it was already used before.
-  Deallocate();
-  duration_ = 0.f;
-  num_tracks_ = 0;
+  _archive << ozz::io::MakeArray(animated_joints_);
+  _archive << ozz::io::MakeArray(rotation_classes_);
+
+  _archive << static_cast<uint32_t>(looping_);
+}
 
+bool Animation::LoadHeader(ozz::io::IArchive& _archive, uint32_t _version,
+                           float* _duration, AllocateParams* _params) {
   // No retro-compatibility with anterior versions.
-  if (_version != 7) {
-    log::Err() << "Unsupported animation version " << _version << "."
-               << std::endl;
-    return;
+  if (_version < 7 || _version > 12) {
+    return false;
   }
 
-  _archive >> duration_;
+  _archive >> *_duration;
 
   uint32_t num_tracks;
   _archive >> num_tracks;
-  num_tracks_ = num_tracks;
 
   uint32_t name_len;
   _archive >> name_len;
+  uint32_t rig_len = 0;  // Anterior versions don't carry a rig signature.
+  if (_version >= 10) {
+    _archive >> rig_len;
+  }
   uint32_t timepoints_count;
   _archive >> timepoints_count;
   uint32_t translation_count;
@@ -324,29 +930,132 @@ void Animation::Load(ozz::io::IArchive& _archive, uint32_t _version) {
   uint32_t s_iframe_desc_count;
   _archive >> s_iframe_desc_count;
 
-  const AllocateParams params{name_len,
-                              timepoints_count,
-                              translation_count,
-                              rotation_count,
-                              scale_count,
-                              {t_iframe_entries_count, t_iframe_desc_count},
-                              {r_iframe_entries_count, r_iframe_desc_count},
-                              {s_iframe_entries_count, s_iframe_desc_count}};
+  *_params = AllocateParams{name_len,
+                            rig_len,
+                            timepoints_count,
+                            translation_count,
+                            rotation_count,
+                            scale_count,
+                            {t_iframe_entries_count, t_iframe_desc_count},
+                            {r_iframe_entries_count, r_iframe_desc_count},
+                            {s_iframe_entries_count, s_iframe_desc_count},
+                            num_tracks};
+  return true;
+}
+
+size_t Animation::SizeOf(ozz::io::IArchive& _archive) {
+  // Reads ahead (tag, version and header counts), then rewinds as if nothing
+  // was read, so the upcoming load still finds the whole animation.
+  const ozz::io::IArchive::ReadState state = _archive.Mark();
+  size_t size = 0;
+  if (ozz::io::internal::Tagger<const Animation>::Validate(_archive)) {
+    uint32_t version;
+    _archive >> version;
+    float duration;
+    AllocateParams params;
+    if (LoadHeader(_archive, version, &duration, &params)) {
+      size = RequiredSize(params);
+    }
+  }
+  _archive.Rewind(state);
+  return size;
+}
+
+bool Animation::Load(ozz::io::IArchive& _archive, span<byte> _buffer) {
+  const size_t required = SizeOf(_archive);
+  if (required == 0 || _buffer.size() < required ||
+      !IsAligned(_buffer.data(), alignof(float))) {
+    return false;
+  }
+
+  // Routes the regular load path to the caller-provided buffer, see Allocate.
+  placement_buffer_ = _buffer;
+  _archive >> *this;
+  placement_buffer_ = {};
+  return true;
+}
+
+void Animation::Load(ozz::io::IArchive& _archive, uint32_t _version) {
+  // Destroy animation in case it was already used before.
+  Deallocate();
+  duration_ = 0.f;
+  num_tracks_ = 0;
+
+  AllocateParams params;
+  if (!LoadHeader(_archive, _version, &duration_, &params)) {
+    log::Err() << "Unsupported animation version " << _version << "."
+               << std::endl;
+    return;
+  }
+  num_tracks_ = static_cast<int>(params.tracks);
+
   Allocate(params);
 
   if (name_) {  // nullptr name_ is supported.
-    _archive >> ozz::io::MakeArray(name_, name_len);
-    name_[name_len] = 0;
+    _archive >> ozz::io::MakeArray(name_, params.name_len);
+    name_[params.name_len] = 0;
+  }
+  if (rig_) {  // nullptr rig_ is supported.
+    _archive >> ozz::io::MakeArray(rig_, params.rig_len);
+    rig_[params.rig_len] = 0;
   }
 
   _archive >> ozz::io::MakeArray(timepoints_);
 
   _archive >> translations_ctrl_;
-  _archive >> io::MakeArray(translations_values_);
+  if (_version >= 8) {
+    LoadDeltaU16Stream(
+        _archive,
+        {reinterpret_cast<uint16_t*>(translations_values_.data()),
+         translations_values_.size() * 3},
+        3);
+  } else {
+    _archive >> io::MakeArray(translations_values_);
+  }
   _archive >> rotations_ctrl_;
-  _archive >> io::MakeArray(rotations_values_);
+  if (_version >= 8) {
+    LoadDeltaU16Stream(
+        _archive,
+        {reinterpret_cast<uint16_t*>(rotations_values_.data()),
+         rotations_values_.size() * 3},
+        3);
+  } else {
+    _archive >> io::MakeArray(rotations_values_);
+  }
   _archive >> scales_ctrl_;
-  _archive >> io::MakeArray(scales_values_);
+  if (_version >= 8) {
+    LoadDeltaU16Stream(
+        _archive,
+        {reinterpret_cast<uint16_t*>(scales_values_.data()),
+         scales_values_.size() * 3},
+        3);
+  } else {
+    _archive >> io::MakeArray(scales_values_);
+  }
+
+  if (_version >= 9) {
+    _archive >> ozz::io::MakeArray(animated_joints_);
+  } else {
+    // Anterior versions don't carry the mask, conservatively considers all
+    // joints animated.
+    std::memset(animated_joints_.data(), 0xff, animated_joints_.size_bytes());
+  }
+
+  if (_version >= 12) {
+    _archive >> ozz::io::MakeArray(rotation_classes_);
+  } else {
+    // Anterior versions don't carry rotation classes, the generic
+    // decompression kernel remains correct for every group.
+    std::memset(rotation_classes_.data(), 0, rotation_classes_.size_bytes());
+  }
+
+  // Anterior versions don't carry the loop safety flag.
+  looping_ = false;
+  if (_version >= 11) {
+    uint32_t looping;
+    _archive >> looping;
+    looping_ = looping != 0;
+  }
 }
 }  // namespace animation
 }  // namespace ozz
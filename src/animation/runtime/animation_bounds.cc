@@ -0,0 +1,101 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/animation_bounds.h"
+
+#include <utility>
+
+#include "ozz/base/io/archive.h"
+#include "ozz/base/maths/math_ex.h"
+
+namespace ozz {
+namespace animation {
+
+AnimationBounds::AnimationBounds() {}
+
+AnimationBounds::AnimationBounds(AnimationBounds&& _other)
+    : intervals_(std::move(_other.intervals_)) {}
+
+AnimationBounds& AnimationBounds::operator=(AnimationBounds&& _other) {
+  intervals_ = std::move(_other.intervals_);
+  return *this;
+}
+
+AnimationBounds::~AnimationBounds() {}
+
+math::Box AnimationBounds::GetBounds(float _ratio) const {
+  if (intervals_.empty()) {
+    return math::Box();
+  }
+  const int num_intervals = static_cast<int>(intervals_.size());
+  const int interval = math::Clamp(
+      0, static_cast<int>(math::Clamp(0.f, _ratio, 1.f) * num_intervals),
+      num_intervals - 1);
+  return intervals_[interval];
+}
+
+math::Box AnimationBounds::GetBounds(float _from, float _to) const {
+  if (intervals_.empty()) {
+    return math::Box();
+  }
+  const int num_intervals = static_cast<int>(intervals_.size());
+  const float from = math::Clamp(0.f, math::Min(_from, _to), 1.f);
+  const float to = math::Clamp(0.f, math::Max(_from, _to), 1.f);
+  const int first = math::Clamp(0, static_cast<int>(from * num_intervals),
+                                num_intervals - 1);
+  const int last =
+      math::Clamp(0, static_cast<int>(to * num_intervals), num_intervals - 1);
+  math::Box bounds = intervals_[first];
+  for (int i = first + 1; i <= last; ++i) {
+    bounds = Merge(bounds, intervals_[i]);
+  }
+  return bounds;
+}
+
+void AnimationBounds::Save(ozz::io::OArchive& _archive) const {
+  _archive << static_cast<uint32_t>(intervals_.size());
+  _archive << ozz::io::MakeArray(
+      reinterpret_cast<const float*>(intervals_.data()),
+      intervals_.size() * 6);
+}
+
+void AnimationBounds::Load(ozz::io::IArchive& _archive, uint32_t _version) {
+  // Resets bounds in case the object was already used before.
+  intervals_.clear();
+
+  if (_version != 1) {
+    return;
+  }
+
+  uint32_t num_intervals;
+  _archive >> num_intervals;
+  intervals_.resize(num_intervals);
+  _archive >> ozz::io::MakeArray(reinterpret_cast<float*>(intervals_.data()),
+                                 intervals_.size() * 6);
+}
+}  // namespace animation
+}  // namespace ozz
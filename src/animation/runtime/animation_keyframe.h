@@ -28,8 +28,18 @@
 #ifndef OZZ_ANIMATION_RUNTIME_ANIMATION_KEYFRAME_H_
 #define OZZ_ANIMATION_RUNTIME_ANIMATION_KEYFRAME_H_
 
+#include <algorithm>
+#include <cmath>
+
 #include "ozz/animation/runtime/export.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/maths/math_constant.h"
+#include "ozz/base/maths/math_ex.h"
+#include "ozz/base/maths/quaternion.h"
+#include "ozz/base/maths/simd_math.h"
+#include "ozz/base/maths/vec_float.h"
 #include "ozz/base/platform.h"
+#include "ozz/base/span.h"
 
 #ifndef OZZ_INCLUDE_PRIVATE_HEADER
 #error "This header is private, it cannot be included from public headers."
@@ -102,6 +112,176 @@ inline void unpack(const QuaternionKey& _key, int& _biggest, int& _sign,
   _cpnt[2] = _key.values[2] >> 1;
 }
 
+// Scalar keyframe value codec, shared by the AnimationBuilder and the
+// load-time passes that transcode keyframe values of a built animation (see
+// Animation::MakeAdditive). Sampling uses its own soa decompression.
+
+// math::FloatToHalf truncates the mantissa. Compression quality improves
+// (maximum quantization error is halved) by picking the nearest of the 2
+// surrounding half values instead, at no runtime decompression cost.
+inline uint16_t FloatToHalfNearest(float _f) {
+  const uint16_t truncated = ozz::math::FloatToHalf(_f);
+  // Incrementing the bit pattern gives the next representable half away from
+  // zero, including across mantissa to exponent carries.
+  const uint16_t next = static_cast<uint16_t>(truncated + 1);
+  if ((next & 0x7c00) == 0x7c00) {  // Next overflows to infinity (or nan).
+    return truncated;
+  }
+  const float lower = ozz::math::HalfToFloat(truncated);
+  const float upper = ozz::math::HalfToFloat(next);
+  return std::abs(_f - lower) <= std::abs(upper - _f) ? truncated : next;
+}
+
+inline void CompressFloat3(const math::Float3& _src, Float3Key* _dest) {
+  _dest->values[0] = FloatToHalfNearest(_src.x);
+  _dest->values[1] = FloatToHalfNearest(_src.y);
+  _dest->values[2] = FloatToHalfNearest(_src.z);
+}
+
+inline math::Float3 DecompressFloat3(const Float3Key& _key) {
+  return math::Float3(math::HalfToFloat(_key.values[0]),
+                      math::HalfToFloat(_key.values[1]),
+                      math::HalfToFloat(_key.values[2]));
+}
+
+// Maps the largest quaternion component index to the 3 smallest ones.
+const int kQuaternionKeyMapping[4][3] = {
+    {1, 2, 3}, {0, 2, 3}, {0, 1, 3}, {0, 1, 2}};
+
+// Compresses quaternion to QuaternionKey format.
+// The 3 smallest components of the quaternion are quantized to x bits
+// integers, while the largest is recomputed thanks to quaternion
+// normalization property (x^2+y^2+z^2+w^2 = 1). Because the 3 components are
+// the 3 smallest, their value cannot be greater than sqrt(2)/2. Thus
+// quantization quality is improved by pre-multiplying each componenent by
+// sqrt(2).
+inline void CompressQuaternion(const math::Quaternion& _src,
+                               QuaternionKey* _dest) {
+  // Finds the largest quaternion component.
+  const float quat[4] = {_src.x, _src.y, _src.z, _src.w};
+  const ptrdiff_t largest =
+      std::max_element(quat, quat + 4,
+                       [](float _left, float _right) {
+                         return std::abs(_left) < std::abs(_right);
+                       }) -
+      quat;
+  assert(largest <= 3);
+
+  // Quantize the 3 smallest components on x bits signed integers.
+  const float kScale = QuaternionKey::kfScale / math::kSqrt2;
+  const float kOffset = -math::kSqrt2_2;
+  const int* map = kQuaternionKeyMapping[largest];
+  const int cpnt[3] = {
+      math::Min(static_cast<int>((quat[map[0]] - kOffset) * kScale + .5f),
+                QuaternionKey::kiScale),
+      math::Min(static_cast<int>((quat[map[1]] - kOffset) * kScale + .5f),
+                QuaternionKey::kiScale),
+      math::Min(static_cast<int>((quat[map[2]] - kOffset) * kScale + .5f),
+                QuaternionKey::kiScale)};
+
+  pack(static_cast<int>(largest), quat[largest] < 0.f, cpnt, _dest);
+}
+
+// Restores the quaternion compressed in _key, rebuilding the largest
+// component from the normalization property.
+inline math::Quaternion DecompressQuaternion(const QuaternionKey& _key) {
+  int largest, sign;
+  int cpnt[3];
+  unpack(_key, largest, sign, cpnt);
+
+  const float kScale = math::kSqrt2 / QuaternionKey::kfScale;
+  const float kOffset = -math::kSqrt2_2;
+  const int* map = kQuaternionKeyMapping[largest];
+  float quat[4];
+  quat[map[0]] = cpnt[0] * kScale + kOffset;
+  quat[map[1]] = cpnt[1] * kScale + kOffset;
+  quat[map[2]] = cpnt[2] * kScale + kOffset;
+  const float dot = quat[map[0]] * quat[map[0]] +
+                    quat[map[1]] * quat[map[1]] + quat[map[2]] * quat[map[2]];
+  quat[largest] =
+      (sign ? -1.f : 1.f) * std::sqrt(dot < 1.f ? 1.f - dot : 0.f);
+  return math::Quaternion(quat[0], quat[1], quat[2], quat[3]);
+}
+
+// Rotation decompression classes. The AnimationBuilder classifies each soa
+// group of 4 rotation tracks from compressed key statistics, and sampling
+// dispatches each group to a matching specialized soa decompression kernel
+// (see sampling_job.cc). Every class shares the QuaternionKey storage: the
+// key stream is a single ratio-sorted sequence with a fixed stride and
+// uint16 previous-key offsets, so per-class key sizes aren't an option.
+// Classes specialize the unpack work instead.
+enum QuaternionClass {
+  // Largest component indices and/or signs vary across keys, the generic
+  // kernel remaps components and restores the sign per key.
+  kQuaternionClassGeneral = 0,
+
+  // Every key of the 4 tracks keeps w as its largest, positive, component:
+  // rotations never leave a +w hemisphere arc. This is the dominant case
+  // (small arcs around the rest pose, identity padding tracks) and the
+  // cheapest kernel: no component remapping, no sign restoration.
+  kQuaternionClassSmallArc = 1,
+
+  // kQuaternionClassUniform + i: every key of the 4 tracks has the same
+  // largest component i, the stable signature of tracks rotating about (or
+  // resting near) a fixed axis. Component remapping is hoisted out of the
+  // per-key path, signs are still restored.
+  kQuaternionClassUniform = 2,
+};
+
+// Classifies each soa group of 4 rotation tracks, writing one class byte per
+// group to _classes, sized _num_tracks (soa padded track count) / 4. Key
+// tracks are resolved the same way as load-time transcoding passes: the 2
+// leading blocks of first and second track keys are laid out in track order,
+// later keys belong to the track of the key their previous offset chains to.
+inline void ClassifyQuaternionTracks(size_t _num_tracks,
+                                     const span<const QuaternionKey>& _keys,
+                                     const span<const uint16_t>& _previouses,
+                                     const span<byte>& _classes) {
+  assert(_num_tracks % 4 == 0 && _classes.size() == _num_tracks / 4);
+
+  // Per track statistics: largest component index if uniform across the
+  // track's keys (-1 before the first key, -2 when mixed), and whether every
+  // key's largest component is positive.
+  ozz::vector<int8_t> largests(_num_tracks, int8_t(-1));
+  ozz::vector<bool> positives(_num_tracks, true);
+
+  ozz::vector<uint16_t> tracks(_keys.size());
+  for (size_t i = 0; i < _keys.size(); ++i) {
+    const uint16_t track = i < _num_tracks * 2
+                               ? static_cast<uint16_t>(i % _num_tracks)
+                               : tracks[i - _previouses[i]];
+    tracks[i] = track;
+
+    int largest, sign, cpnt[3];
+    unpack(_keys[i], largest, sign, cpnt);
+    int8_t& track_largest = largests[track];
+    if (track_largest == -1) {
+      track_largest = static_cast<int8_t>(largest);
+    } else if (track_largest != largest) {
+      track_largest = -2;
+    }
+    positives[track] = positives[track] && sign == 0;
+  }
+
+  // Folds the 4 tracks of each group into the weakest matching class.
+  for (size_t i = 0; i < _classes.size(); ++i) {
+    const int8_t largest = largests[i * 4];
+    bool uniform = largest >= 0;
+    bool positive = positives[i * 4];
+    for (size_t j = 1; j < 4; ++j) {
+      uniform = uniform && largests[i * 4 + j] == largest;
+      positive = positive && positives[i * 4 + j];
+    }
+    if (uniform && largest == 3 && positive) {
+      _classes[i] = kQuaternionClassSmallArc;
+    } else if (uniform) {
+      _classes[i] = static_cast<byte>(kQuaternionClassUniform + largest);
+    } else {
+      _classes[i] = kQuaternionClassGeneral;
+    }
+  }
+}
+
 }  // namespace internal
 }  // namespace animation
 }  // namespace ozz
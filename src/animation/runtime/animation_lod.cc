@@ -0,0 +1,59 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/animation_lod.h"
+
+#include <utility>
+
+#include "ozz/animation/runtime/animation.h"
+
+namespace ozz {
+namespace animation {
+
+AnimationLod::AnimationLod() {}
+
+AnimationLod::AnimationLod(ozz::vector<unique_ptr<Animation>> _levels)
+    : levels_(std::move(_levels)) {
+  // Rejects sets with null entries, Select relies on all levels being valid.
+  for (size_t i = 0; i < levels_.size(); ++i) {
+    if (!levels_[i]) {
+      levels_.clear();
+      break;
+    }
+  }
+}
+
+const Animation* AnimationLod::Select(int _level) const {
+  if (levels_.empty()) {
+    return nullptr;
+  }
+  const int max_level = static_cast<int>(levels_.size()) - 1;
+  const int clamped = _level < 0 ? 0 : (_level > max_level ? max_level : _level);
+  return levels_[clamped].get();
+}
+}  // namespace animation
+}  // namespace ozz
@@ -0,0 +1,98 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/animation_pipeline.h"
+
+#include <atomic>
+
+#include "ozz/base/scheduler.h"
+
+namespace ozz {
+namespace animation {
+
+namespace {
+
+// Runs a group of fused stages for instances [_begin, _end[. A failing stage
+// skips the remaining stages of the group for that instance only.
+void RunGroup(const span<const AnimationPipeline::Stage>& _group, int _begin,
+              int _end, std::atomic<bool>* _success) {
+  for (int i = _begin; i < _end; ++i) {
+    for (size_t s = 0; s < _group.size(); ++s) {
+      const AnimationPipeline::Stage& stage = _group[s];
+      if (!stage.fn(stage.context, i)) {
+        _success->store(false, std::memory_order_relaxed);
+        break;
+      }
+    }
+  }
+}
+}  // namespace
+
+AnimationPipeline::AnimationPipeline()
+    : num_instances(0), scheduler(nullptr), granularity(1) {}
+
+bool AnimationPipeline::Validate() const {
+  bool valid = num_instances >= 0;
+  for (size_t i = 0; i < stages.size(); ++i) {
+    valid &= stages[i].fn != nullptr;
+    valid &= stages[i].name != nullptr;
+  }
+  return valid;
+}
+
+bool AnimationPipeline::Run() const {
+  if (!Validate()) {
+    return false;
+  }
+
+  std::atomic<bool> success(true);
+
+  // Splits the stage chain into groups of fused stages, delimited by barrier
+  // stages. A barrier stage opens a new group, so all previous stages
+  // complete for every instance (the parallel-for below is blocking) before
+  // it runs for any of them.
+  for (size_t begin = 0; begin < stages.size();) {
+    size_t end = begin + 1;
+    for (; end < stages.size() && !stages[end].barrier; ++end) {
+    }
+    const span<const Stage> group = stages.subspan(begin, end - begin);
+
+    if (scheduler) {
+      scheduler->ParallelForFct(0, num_instances, granularity,
+                                [&group, &success](int _begin, int _end) {
+                                  RunGroup(group, _begin, _end, &success);
+                                });
+    } else {
+      RunGroup(group, 0, num_instances, &success);
+    }
+    begin = end;
+  }
+
+  return success.load(std::memory_order_relaxed);
+}
+}  // namespace animation
+}  // namespace ozz
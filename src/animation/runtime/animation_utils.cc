@@ -27,6 +27,14 @@
 
 #include "ozz/animation/runtime/animation_utils.h"
 
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/base/maths/math_ex.h"
+#include "ozz/base/maths/soa_transform.h"
+
 // Internal include file
 #define OZZ_INCLUDE_PRIVATE_HEADER  // Allows to include private headers.
 #include "animation/runtime/animation_keyframe.h"
@@ -51,6 +59,88 @@ inline int CountKeyframesImpl(const Animation::KeyframesCtrlConst& _ctrl,
   return count;
 }
 
+namespace {
+
+// Accumulates one component's memory breakdown and keyframe distribution.
+// _num_tracks is the soa aligned track count, as padding tracks own keyframes
+// too.
+void ProfileComponent(const Animation::KeyframesCtrlConst& _ctrl,
+                      size_t _values_size, size_t _num_tracks,
+                      const span<const float>& _timepoints,
+                      MemoryProfile::Component* _component) {
+  const size_t keyframes = _ctrl.previouses.size();
+  _component->keyframes += keyframes;
+  _component->values_size += _values_size;
+  _component->ratios_size += _ctrl.ratios.size_bytes();
+  _component->previouses_size += _ctrl.previouses.size_bytes();
+  _component->iframes_size +=
+      _ctrl.iframe_entries.size_bytes() + _ctrl.iframe_desc.size_bytes();
+
+  // Grows aggregated distributions as needed.
+  if (_component->track_keyframes.size() < _num_tracks) {
+    _component->track_keyframes.resize(_num_tracks, 0);
+  }
+  if (_component->time_histogram.empty()) {
+    _component->time_histogram.resize(MemoryProfile::kTimeBuckets, 0);
+  }
+
+  // Ratios are stored on 1 or 2 bytes, depending on timepoints count.
+  const bool small_ratios = _ctrl.ratios.size() == keyframes;
+
+  // Keys are sorted by ratio, not per track. Tracks are recovered walking
+  // previous key offsets: the first keys match track order, any further key
+  // belongs to the track of the key it offsets to.
+  ozz::vector<uint16_t> tracks(keyframes);
+  for (size_t i = 0; i < keyframes; ++i) {
+    const size_t track = i < _num_tracks ? i : tracks[i - _ctrl.previouses[i]];
+    tracks[i] = static_cast<uint16_t>(track);
+    ++_component->track_keyframes[track];
+
+    const size_t timepoint =
+        small_ratios
+            ? _ctrl.ratios[i]
+            : reinterpret_cast<const uint16_t*>(_ctrl.ratios.data())[i];
+    const float ratio = _timepoints[timepoint];
+    const size_t bucket = static_cast<size_t>(
+        ratio * MemoryProfile::kTimeBuckets);
+    ++_component->time_histogram[bucket < MemoryProfile::kTimeBuckets
+                                     ? bucket
+                                     : MemoryProfile::kTimeBuckets - 1];
+  }
+}
+
+// Raw (uncompressed) keyframe sizes, a float time and a float3 or quaternion
+// value, used to report compression ratio versus raw keyframes.
+enum RawKeySizes {
+  kRawFloat3KeySize = sizeof(float) * 4,
+  kRawQuaternionKeySize = sizeof(float) * 5
+};
+}  // namespace
+
+void ProfileMemory(const Animation& _animation, MemoryProfile* _profile) {
+  assert(_profile != nullptr);
+
+  ++_profile->animations;
+  _profile->size += _animation.size();
+  _profile->timepoints_size += _animation.timepoints().size_bytes();
+
+  const size_t num_tracks = static_cast<size_t>(_animation.num_soa_tracks()) * 4;
+  ProfileComponent(_animation.translations_ctrl(),
+                   _animation.translations_values().size_bytes(), num_tracks,
+                   _animation.timepoints(), &_profile->translations);
+  ProfileComponent(_animation.rotations_ctrl(),
+                   _animation.rotations_values().size_bytes(), num_tracks,
+                   _animation.timepoints(), &_profile->rotations);
+  ProfileComponent(_animation.scales_ctrl(),
+                   _animation.scales_values().size_bytes(), num_tracks,
+                   _animation.timepoints(), &_profile->scales);
+
+  _profile->raw_size +=
+      _animation.translations_ctrl().previouses.size() * kRawFloat3KeySize +
+      _animation.rotations_ctrl().previouses.size() * kRawQuaternionKeySize +
+      _animation.scales_ctrl().previouses.size() * kRawFloat3KeySize;
+}
+
 int CountTranslationKeyframes(const Animation& _animation, int _track) {
   return CountKeyframesImpl(_animation.translations_ctrl(), _track);
 }
@@ -60,5 +150,129 @@ int CountRotationKeyframes(const Animation& _animation, int _track) {
 int CountScaleKeyframes(const Animation& _animation, int _track) {
   return CountKeyframesImpl(_animation.scales_ctrl(), _track);
 }
+
+namespace {
+// Shared tail of the SampleAnimation overloads, runs a sampling job from the
+// transient _context.
+bool SampleAnimationImpl(const Animation& _animation, float _ratio,
+                         const span<math::SoaTransform>& _output,
+                         SamplingJob::Context* _context) {
+  SamplingJob job;
+  job.animation = &_animation;
+  job.context = _context;
+  job.ratio = _ratio;
+  job.output = _output;
+  return job.Run();
+}
+}  // namespace
+
+bool SampleAnimation(const Animation& _animation, float _ratio,
+                     const span<math::SoaTransform>& _output) {
+  SamplingJob::Context context(_animation.num_tracks());
+  return SampleAnimationImpl(_animation, _ratio, _output, &context);
+}
+
+bool SampleAnimation(const Animation& _animation, float _ratio,
+                     const span<math::SoaTransform>& _output,
+                     const span<byte>& _buffer) {
+  if (_buffer.size() <
+          SamplingJob::Context::RequiredSize(_animation.num_tracks()) ||
+      !IsAligned(_buffer.data(), alignof(math::SimdFloat4))) {
+    return false;
+  }
+  SamplingJob::Context context;
+  context.Resize(_animation.num_tracks(), _buffer);
+  return SampleAnimationImpl(_animation, _ratio, _output, &context);
+}
+
+float FixedRatioToFloat(uint32_t _fixed) {
+  // kFixedRatioOne is a power of two, so the scale only offsets the exponent
+  // and the conversion loses no bit of _fixed (which fits a float mantissa).
+  return static_cast<float>(_fixed) * (1.f / kFixedRatioOne);
+}
+
+uint32_t FloatToFixedRatio(float _ratio) {
+  const float clamped = math::Clamp(0.f, _ratio, 1.f);
+  // Rounds to the nearest tick.
+  return static_cast<uint32_t>(clamped * static_cast<float>(kFixedRatioOne) +
+                               .5f);
+}
+
+uint32_t StepFixedRatio(uint32_t _ratio, int _delta, bool _loop) {
+  assert(_ratio <= kFixedRatioOne);
+  // A negative _delta relies on unsigned wraparound.
+  const uint32_t stepped = _ratio + static_cast<uint32_t>(_delta);
+  if (_loop) {
+    // 2^32 is a multiple of kFixedRatioOne, so the wraparound of the signed
+    // step above is transparent to the modulo.
+    return stepped % kFixedRatioOne;
+  }
+  if (_delta < 0) {
+    // Saturates to 0 on underflow.
+    return stepped > _ratio ? 0 : stepped;
+  }
+  // Saturates to 1 (kFixedRatioOne ticks) on overflow.
+  return stepped < _ratio || stepped > kFixedRatioOne ? kFixedRatioOne
+                                                      : stepped;
+}
+
+void UpdateScheduler::Resize(int _num_instances, float _period) {
+  assert(_num_instances >= 0 && _period >= 0.f);
+  // Infinite staleness makes every instance due on the next Update call,
+  // whatever its period.
+  const Instance reset = {_period, std::numeric_limits<float>::max()};
+  instances_.assign(static_cast<size_t>(_num_instances), reset);
+}
+
+void UpdateScheduler::set_period(int _instance, float _period) {
+  assert(_instance >= 0 && _instance < num_instances() && _period >= 0.f);
+  instances_[_instance].period = _period;
+}
+
+float UpdateScheduler::period(int _instance) const {
+  assert(_instance >= 0 && _instance < num_instances());
+  return instances_[_instance].period;
+}
+
+int UpdateScheduler::Update(float _dt, const span<int>& _updates) {
+  assert(_dt >= 0.f);
+
+  // Ages all instances and collects the due ones. Collection usually remains
+  // well below instance count, as periods spread updates over frames.
+  due_.clear();
+  for (size_t i = 0; i < instances_.size(); ++i) {
+    Instance& instance = instances_[i];
+    instance.staleness += _dt;
+    if (instance.staleness >= instance.period) {
+      due_.push_back(static_cast<int>(i));
+    }
+  }
+
+  // Most stale instances are served first, so when the budget (_updates
+  // capacity) is exhausted, the instances that can least afford to wait
+  // aren't the ones postponed.
+  const size_t count = math::Min(due_.size(), _updates.size());
+  std::partial_sort(due_.begin(), due_.begin() + count, due_.end(),
+                    [this](int _a, int _b) {
+                      return instances_[_a].staleness >
+                             instances_[_b].staleness;
+                    });
+
+  // Resets collected instances, they're fully updated by the caller.
+  for (size_t i = 0; i < count; ++i) {
+    _updates[i] = due_[i];
+    instances_[due_[i]].staleness = 0.f;
+  }
+  return static_cast<int>(count);
+}
+
+float UpdateScheduler::Alpha(int _instance) const {
+  assert(_instance >= 0 && _instance < num_instances());
+  const Instance& instance = instances_[_instance];
+  if (instance.period <= 0.f) {
+    return 1.f;
+  }
+  return math::Clamp(0.f, instance.staleness / instance.period, 1.f);
+}
 }  // namespace animation
 }  // namespace ozz
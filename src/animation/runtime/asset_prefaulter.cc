@@ -0,0 +1,166 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/asset_prefaulter.h"
+
+#include <chrono>
+
+#include "ozz/animation/runtime/paged_animation.h"
+#include "ozz/base/maths/math_ex.h"
+
+namespace ozz {
+namespace animation {
+
+namespace {
+// OS page granularity touching assumes. A conservative lower bound: touching
+// every 4KiB also faults in systems using larger pages, just with redundant
+// (cheap) reads.
+const size_t kOsPageSize = 4096;
+
+// Bytes touched between two rate limit checks, a few pages so sleeps stay
+// coarse enough to be schedulable.
+const size_t kTouchChunkSize = 64 * kOsPageSize;
+
+// Reads one byte per OS page of _range. The volatile sink prevents the
+// compiler from discarding the loads.
+void TouchRange(span<const byte> _range) {
+  volatile byte sink = 0;
+  for (size_t offset = 0; offset < _range.size(); offset += kOsPageSize) {
+    sink = _range[offset];
+  }
+  (void)sink;
+}
+}  // namespace
+
+const AssetPrefaulter::Ticket AssetPrefaulter::kInvalidTicket;
+
+AssetPrefaulter::AssetPrefaulter(size_t _bytes_per_second)
+    : bytes_per_second_(math::Max<size_t>(1, _bytes_per_second)),
+      last_completed_(kInvalidTicket),
+      thread_(&AssetPrefaulter::Run, this) {}
+
+AssetPrefaulter::~AssetPrefaulter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    quit_ = true;
+  }
+  condition_.notify_all();
+  thread_.join();
+}
+
+AssetPrefaulter::Ticket AssetPrefaulter::Queue(Request&& _request) {
+  Ticket ticket;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ticket = _request.ticket = ++last_issued_;
+    pending_.push_back(std::move(_request));
+  }
+  condition_.notify_all();
+  return ticket;
+}
+
+AssetPrefaulter::Ticket AssetPrefaulter::Warm(span<const byte> _buffer) {
+  if (_buffer.empty()) {
+    return kInvalidTicket;
+  }
+  Request request;
+  request.ranges.push_back(_buffer);
+  return Queue(std::move(request));
+}
+
+AssetPrefaulter::Ticket AssetPrefaulter::Warm(
+    const PagedAnimation& _animation, span<const span<const byte>> _page_buffers,
+    float _from_ratio, float _seconds) {
+  const size_t num_pages = _animation.num_pages();
+  if (num_pages == 0 || _page_buffers.size() != num_pages) {
+    return kInvalidTicket;
+  }
+
+  // Number of pages the playback window covers, starting from the page
+  // containing _from_ratio. One extra page as the window rarely starts on a
+  // page boundary. Caps at a single directory lap.
+  const size_t window_pages = math::Min(
+      num_pages,
+      static_cast<size_t>(math::Max(0.f, _seconds) / _animation.page_duration()) + 1);
+
+  // Queues pages in playback order, wrapping over the clip end so looping
+  // playback finds its first pages warm too.
+  Request request;
+  const size_t first = _animation.Remap(_from_ratio).page;
+  for (size_t i = 0; i < window_pages; ++i) {
+    const span<const byte>& buffer = _page_buffers[(first + i) % num_pages];
+    if (!buffer.empty()) {
+      request.ranges.push_back(buffer);
+    }
+  }
+  return Queue(std::move(request));
+}
+
+bool AssetPrefaulter::IsDone(Ticket _ticket) const {
+  // Tickets complete in issuing order.
+  return _ticket <= last_completed_.load(std::memory_order_acquire);
+}
+
+void AssetPrefaulter::Wait(Ticket _ticket) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  condition_.wait(lock, [this, _ticket] {
+    return IsDone(_ticket) || quit_;
+  });
+}
+
+void AssetPrefaulter::Run() {
+  for (;;) {
+    Request request;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      condition_.wait(lock, [this] { return !pending_.empty() || quit_; });
+      if (quit_) {
+        return;  // Abandons requests still pending.
+      }
+      request = std::move(pending_.front());
+      pending_.pop_front();
+    }
+
+    // Touches the request's ranges in order, pacing every chunk so warming
+    // stays at bytes_per_second_ whatever the chunk actually costs (a fault
+    // and its IO, or a mere cached read).
+    for (const span<const byte>& range : request.ranges) {
+      for (size_t begin = 0; begin < range.size(); begin += kTouchChunkSize) {
+        const size_t chunk = math::Min(kTouchChunkSize, range.size() - begin);
+        TouchRange(range.subspan(begin, chunk));
+        std::this_thread::sleep_for(std::chrono::duration<double>(
+            static_cast<double>(chunk) / static_cast<double>(bytes_per_second_)));
+      }
+    }
+
+    // Publishes completion and wakes waiters up.
+    last_completed_.store(request.ticket, std::memory_order_release);
+    condition_.notify_all();
+  }
+}
+}  // namespace animation
+}  // namespace ozz
@@ -0,0 +1,183 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/batch_partitioner.h"
+
+#include <algorithm>
+
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/animation/runtime/local_to_model_job.h"
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/maths/math_ex.h"
+
+namespace ozz {
+namespace animation {
+
+namespace {
+
+// Number of bucket instances gathered per batch job submission. Gather
+// buffers of that many entries live on the stack.
+enum { kBucketChunkSize = 64 };
+
+// Validates bucket and per-instance ranges, shared by both bucket jobs.
+// _instances is the common size of per-instance ranges.
+bool ValidateBucket(const BatchPartitioner::Bucket* _bucket,
+                    const span<const int>& _indices, size_t _instances) {
+  bool valid = _bucket != nullptr;
+  if (!valid) {
+    return false;
+  }
+  valid &= _bucket->begin >= 0 && _bucket->count >= 0;
+  valid &= static_cast<size_t>(_bucket->begin) + _bucket->count <=
+           _indices.size();
+  if (!valid) {
+    return false;
+  }
+  for (int i = 0; i < _bucket->count; ++i) {
+    const int index = _indices[_bucket->begin + i];
+    valid &= index >= 0 && static_cast<size_t>(index) < _instances;
+  }
+  return valid;
+}
+}  // namespace
+
+span<const BatchPartitioner::Bucket> BatchPartitioner::Partition(
+    span<const Skeleton* const> _skeletons,
+    span<const Animation* const> _animations) {
+  buckets_.clear();
+  indices_.clear();
+  if (_skeletons.size() != _animations.size()) {
+    return make_span(buckets_);
+  }
+
+  // Flat sort-by-key: builds one key per instance, sorts, then scans sorted
+  // keys once to emit buckets. The original index breaks ties, so instances
+  // of a bucket keep their relative order whatever the sort implementation.
+  const int count = static_cast<int>(_skeletons.size());
+  keys_.resize(count);
+  for (int i = 0; i < count; ++i) {
+    const Key key = {_skeletons[i], _animations[i], i};
+    keys_[i] = key;
+  }
+  std::sort(keys_.begin(), keys_.end(), [](const Key& _a, const Key& _b) {
+    if (_a.skeleton != _b.skeleton) {
+      return _a.skeleton < _b.skeleton;
+    }
+    if (_a.animation != _b.animation) {
+      return _a.animation < _b.animation;
+    }
+    return _a.index < _b.index;
+  });
+
+  indices_.resize(count);
+  for (int i = 0; i < count; ++i) {
+    const Key& key = keys_[i];
+    indices_[i] = key.index;
+    if (i == 0 || key.skeleton != keys_[i - 1].skeleton ||
+        key.animation != keys_[i - 1].animation) {
+      const Bucket bucket = {key.skeleton, key.animation, i, 1};
+      buckets_.push_back(bucket);
+    } else {
+      ++buckets_.back().count;
+    }
+  }
+  return make_span(buckets_);
+}
+
+bool SamplingBucketJob::Validate() const {
+  bool valid = ratios.size() == contexts.size();
+  valid &= outputs.size() == contexts.size();
+  return valid && ValidateBucket(bucket, indices, contexts.size());
+}
+
+bool SamplingBucketJob::Run() const {
+  if (!Validate()) {
+    return false;
+  }
+
+  // Gathers bucket instances into per-chunk batch entries, then submits them
+  // to SamplingBatchJob. All instances sample the same animation, so the
+  // batch streams through identical trip counts.
+  const Animation* animations[kBucketChunkSize];
+  float chunk_ratios[kBucketChunkSize];
+  SamplingJob::Context* chunk_contexts[kBucketChunkSize];
+  span<math::SoaTransform> chunk_outputs[kBucketChunkSize];
+  for (int begin = 0; begin < bucket->count; begin += kBucketChunkSize) {
+    const int size = math::Min<int>(bucket->count - begin, kBucketChunkSize);
+    for (int i = 0; i < size; ++i) {
+      const int index = indices[bucket->begin + begin + i];
+      animations[i] = bucket->animation;
+      chunk_ratios[i] = ratios[index];
+      chunk_contexts[i] = contexts[index];
+      chunk_outputs[i] = outputs[index];
+    }
+    SamplingBatchJob job;
+    job.ratios = {chunk_ratios, static_cast<size_t>(size)};
+    job.animations = {animations, static_cast<size_t>(size)};
+    job.contexts = {chunk_contexts, static_cast<size_t>(size)};
+    job.outputs = {chunk_outputs, static_cast<size_t>(size)};
+    if (!job.Run()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool LocalToModelBucketJob::Validate() const {
+  bool valid = inputs.size() == outputs.size();
+  valid &= ValidateBucket(bucket, indices, inputs.size());
+  return valid && bucket->skeleton != nullptr;
+}
+
+bool LocalToModelBucketJob::Run() const {
+  if (!Validate()) {
+    return false;
+  }
+
+  // Gathers bucket instances into per-chunk batch entries, then submits them
+  // to LocalToModelBatchJob which walks the shared hierarchy once per chunk.
+  span<const math::SoaTransform> chunk_inputs[kBucketChunkSize];
+  span<math::Float4x4> chunk_outputs[kBucketChunkSize];
+  for (int begin = 0; begin < bucket->count; begin += kBucketChunkSize) {
+    const int size = math::Min<int>(bucket->count - begin, kBucketChunkSize);
+    for (int i = 0; i < size; ++i) {
+      const int index = indices[bucket->begin + begin + i];
+      chunk_inputs[i] = inputs[index];
+      chunk_outputs[i] = outputs[index];
+    }
+    LocalToModelBatchJob job;
+    job.skeleton = bucket->skeleton;
+    job.inputs = {chunk_inputs, static_cast<size_t>(size)};
+    job.outputs = {chunk_outputs, static_cast<size_t>(size)};
+    if (!job.Run()) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace animation
+}  // namespace ozz
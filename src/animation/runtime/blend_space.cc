@@ -0,0 +1,423 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/blend_space.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "ozz/base/containers/map.h"
+#include "ozz/base/maths/math_ex.h"
+
+namespace ozz {
+namespace animation {
+
+namespace {
+
+// Tolerance under which a barycentric coordinate counts as inside, absorbing
+// float noise on simplex edges.
+const float kBarycentricTolerance = 1e-5f;
+
+// Tests if _p lies inside the circumcircle of ccw triangle (_a, _b, _c).
+bool InCircumcircle(const math::Float2& _a, const math::Float2& _b,
+                    const math::Float2& _c, const math::Float2& _p) {
+  const float ax = _a.x - _p.x, ay = _a.y - _p.y;
+  const float bx = _b.x - _p.x, by = _b.y - _p.y;
+  const float cx = _c.x - _p.x, cy = _c.y - _p.y;
+  const float det = (ax * ax + ay * ay) * (bx * cy - cx * by) -
+                    (bx * bx + by * by) * (ax * cy - cx * ay) +
+                    (cx * cx + cy * cy) * (ax * by - bx * ay);
+  return det > 0.f;
+}
+
+// Barycentric coordinates of _p in triangle (_a, _b, _c).
+void Barycentric(const math::Float2& _a, const math::Float2& _b,
+                 const math::Float2& _c, const math::Float2& _p,
+                 float _weights[3]) {
+  const math::Float2 v0(_b.x - _a.x, _b.y - _a.y);
+  const math::Float2 v1(_c.x - _a.x, _c.y - _a.y);
+  const math::Float2 v2(_p.x - _a.x, _p.y - _a.y);
+  const float d00 = v0.x * v0.x + v0.y * v0.y;
+  const float d01 = v0.x * v1.x + v0.y * v1.y;
+  const float d11 = v1.x * v1.x + v1.y * v1.y;
+  const float d20 = v2.x * v0.x + v2.y * v0.y;
+  const float d21 = v2.x * v1.x + v2.y * v1.y;
+  const float denom = d00 * d11 - d01 * d01;
+  _weights[1] = (d11 * d20 - d01 * d21) / denom;
+  _weights[2] = (d00 * d21 - d01 * d20) / denom;
+  _weights[0] = 1.f - _weights[1] - _weights[2];
+}
+
+// Computes the closest point to _p inside triangle (_a, _b, _c), expressed
+// as barycentric coordinates in _weights. Returns the squared distance from
+// _p to that point. Voronoi region based, see "Real-Time Collision
+// Detection" closest point on triangle.
+float ClosestPoint(const math::Float2& _a, const math::Float2& _b,
+                   const math::Float2& _c, const math::Float2& _p,
+                   float _weights[3]) {
+  const math::Float2 ab(_b.x - _a.x, _b.y - _a.y);
+  const math::Float2 ac(_c.x - _a.x, _c.y - _a.y);
+  const math::Float2 ap(_p.x - _a.x, _p.y - _a.y);
+  const float d1 = ab.x * ap.x + ab.y * ap.y;
+  const float d2 = ac.x * ap.x + ac.y * ap.y;
+  const math::Float2 bp(_p.x - _b.x, _p.y - _b.y);
+  const float d3 = ab.x * bp.x + ab.y * bp.y;
+  const float d4 = ac.x * bp.x + ac.y * bp.y;
+  const math::Float2 cp(_p.x - _c.x, _p.y - _c.y);
+  const float d5 = ab.x * cp.x + ab.y * cp.y;
+  const float d6 = ac.x * cp.x + ac.y * cp.y;
+
+  const float vc = d1 * d4 - d3 * d2;
+  const float vb = d5 * d2 - d1 * d6;
+  const float va = d3 * d6 - d5 * d4;
+  if (d1 <= 0.f && d2 <= 0.f) {  // Vertex a region.
+    _weights[0] = 1.f, _weights[1] = 0.f, _weights[2] = 0.f;
+  } else if (d3 >= 0.f && d4 <= d3) {  // Vertex b region.
+    _weights[0] = 0.f, _weights[1] = 1.f, _weights[2] = 0.f;
+  } else if (d6 >= 0.f && d5 <= d6) {  // Vertex c region.
+    _weights[0] = 0.f, _weights[1] = 0.f, _weights[2] = 1.f;
+  } else if (vc <= 0.f && d1 >= 0.f && d3 <= 0.f) {  // Edge ab region.
+    const float v = d1 / (d1 - d3);
+    _weights[0] = 1.f - v, _weights[1] = v, _weights[2] = 0.f;
+  } else if (vb <= 0.f && d2 >= 0.f && d6 <= 0.f) {  // Edge ac region.
+    const float v = d2 / (d2 - d6);
+    _weights[0] = 1.f - v, _weights[1] = 0.f, _weights[2] = v;
+  } else if (va <= 0.f && d4 - d3 >= 0.f && d5 - d6 >= 0.f) {  // Edge bc.
+    const float v = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+    _weights[0] = 0.f, _weights[1] = 1.f - v, _weights[2] = v;
+  } else {  // Inside.
+    const float denom = 1.f / (va + vb + vc);
+    _weights[1] = vb * denom;
+    _weights[2] = vc * denom;
+    _weights[0] = 1.f - _weights[1] - _weights[2];
+  }
+  const math::Float2 closest(
+      _weights[0] * _a.x + _weights[1] * _b.x + _weights[2] * _c.x,
+      _weights[0] * _a.y + _weights[1] * _b.y + _weights[2] * _c.y);
+  const math::Float2 delta(_p.x - closest.x, _p.y - closest.y);
+  return delta.x * delta.x + delta.y * delta.y;
+}
+
+// A triangle of the incremental (Bowyer-Watson) triangulation.
+struct DelaunayTriangle {
+  int v[3];
+};
+
+// Builds the ccw Delaunay triangulation of _points. Returns false if no
+// triangle survives (collinear or duplicated points).
+bool Triangulate(const span<const math::Float2>& _points,
+                 ozz::vector<DelaunayTriangle>* _triangles) {
+  // Scratch point array, with 3 super-triangle vertices appended. The super
+  // triangle encloses all points, so every insertion lands in a cavity.
+  const int count = static_cast<int>(_points.size());
+  ozz::vector<math::Float2> points(_points.begin(), _points.end());
+  math::Float2 min = points[0], max = points[0];
+  for (int i = 1; i < count; ++i) {
+    min.x = math::Min(min.x, points[i].x);
+    min.y = math::Min(min.y, points[i].y);
+    max.x = math::Max(max.x, points[i].x);
+    max.y = math::Max(max.y, points[i].y);
+  }
+  const float extent =
+      math::Max(math::Max(max.x - min.x, max.y - min.y), 1.f) * 16.f;
+  const math::Float2 center((min.x + max.x) * .5f, (min.y + max.y) * .5f);
+  points.push_back(math::Float2(center.x - extent, center.y - extent));
+  points.push_back(math::Float2(center.x + extent, center.y - extent));
+  points.push_back(math::Float2(center.x, center.y + extent));
+
+  ozz::vector<DelaunayTriangle> triangles;
+  const DelaunayTriangle super = {{count, count + 1, count + 2}};
+  triangles.push_back(super);
+
+  typedef std::pair<int, int> Edge;
+  ozz::vector<Edge> cavity;
+  for (int p = 0; p < count; ++p) {
+    // Collects edges of every triangle whose circumcircle contains the
+    // point. Edges shared by two such triangles are interior to the cavity
+    // and cancel out, remaining ones form the cavity boundary.
+    cavity.clear();
+    for (size_t t = 0; t < triangles.size();) {
+      const DelaunayTriangle& tri = triangles[t];
+      if (InCircumcircle(points[tri.v[0]], points[tri.v[1]], points[tri.v[2]],
+                         points[p])) {
+        for (int e = 0; e < 3; ++e) {
+          const Edge edge(tri.v[e], tri.v[(e + 1) % 3]);
+          const Edge reversed(edge.second, edge.first);
+          const ozz::vector<Edge>::iterator it =
+              std::find(cavity.begin(), cavity.end(), reversed);
+          if (it != cavity.end()) {
+            cavity.erase(it);
+          } else {
+            cavity.push_back(edge);
+          }
+        }
+        triangles[t] = triangles.back();
+        triangles.pop_back();
+      } else {
+        ++t;
+      }
+    }
+    // Re-triangulates the cavity as a fan around the inserted point. Cavity
+    // edges are ccw, so new triangles are too.
+    for (size_t e = 0; e < cavity.size(); ++e) {
+      const DelaunayTriangle tri = {{cavity[e].first, cavity[e].second, p}};
+      triangles.push_back(tri);
+    }
+  }
+
+  // Drops triangles connected to the super triangle.
+  _triangles->clear();
+  for (size_t t = 0; t < triangles.size(); ++t) {
+    const DelaunayTriangle& tri = triangles[t];
+    if (tri.v[0] < count && tri.v[1] < count && tri.v[2] < count) {
+      _triangles->push_back(tri);
+    }
+  }
+  return !_triangles->empty();
+}
+}  // namespace
+
+BlendSpace::BlendSpace(span<const float> _coordinates)
+    : dimension_(1), valid_(false) {
+  const int count = static_cast<int>(_coordinates.size());
+  if (count == 0) {
+    return;
+  }
+  points_.resize(count);
+  for (int i = 0; i < count; ++i) {
+    points_[i] = math::Float2(_coordinates[i], 0.f);
+  }
+
+  // Sorts clip indices by coordinate, segments chain them in that order.
+  ozz::vector<int> order(count);
+  for (int i = 0; i < count; ++i) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&_coordinates](int _a, int _b) {
+    return _coordinates[_a] < _coordinates[_b];
+  });
+  for (int i = 1; i < count; ++i) {
+    if (_coordinates[order[i - 1]] == _coordinates[order[i]]) {
+      points_.clear();  // Duplicated coordinates.
+      return;
+    }
+  }
+  simplices_.resize(count - 1);
+  for (int i = 0; i < count - 1; ++i) {
+    Simplex& segment = simplices_[i];
+    segment.points[0] = order[i];
+    segment.points[1] = order[i + 1];
+    segment.points[2] = -1;
+    segment.neighbors[0] = i - 1;
+    segment.neighbors[1] = i + 1 < count - 1 ? i + 1 : -1;
+    segment.neighbors[2] = -1;
+  }
+  valid_ = true;
+}
+
+BlendSpace::BlendSpace(span<const math::Float2> _coordinates)
+    : dimension_(2), valid_(false) {
+  const int count = static_cast<int>(_coordinates.size());
+  for (int i = 0; i < count; ++i) {
+    for (int j = i + 1; j < count; ++j) {
+      if (_coordinates[i].x == _coordinates[j].x &&
+          _coordinates[i].y == _coordinates[j].y) {
+        return;  // Duplicated coordinates.
+      }
+    }
+  }
+  ozz::vector<DelaunayTriangle> triangles;
+  if (count < 3 || !Triangulate(_coordinates, &triangles)) {
+    return;
+  }
+  points_.assign(_coordinates.begin(), _coordinates.end());
+
+  // Stores triangles and precomputes adjacency: edges (as ordered vertex
+  // pairs) are mapped to the simplex and slot they bound, pairing each edge
+  // with its reversed twin in the adjacent triangle.
+  simplices_.resize(triangles.size());
+  typedef std::pair<int, int> Edge;
+  typedef std::pair<int, int> Slot;  // Simplex index, opposite vertex slot.
+  ozz::map<Edge, Slot> edges;
+  for (size_t t = 0; t < triangles.size(); ++t) {
+    Simplex& simplex = simplices_[t];
+    for (int i = 0; i < 3; ++i) {
+      simplex.points[i] = triangles[t].v[i];
+      simplex.neighbors[i] = -1;
+    }
+    for (int i = 0; i < 3; ++i) {
+      // Edge opposite to vertex i.
+      const Edge edge(simplex.points[(i + 1) % 3], simplex.points[(i + 2) % 3]);
+      const ozz::map<Edge, Slot>::iterator twin =
+          edges.find(Edge(edge.second, edge.first));
+      if (twin != edges.end()) {
+        simplex.neighbors[i] = twin->second.first;
+        simplices_[twin->second.first].neighbors[twin->second.second] =
+            static_cast<int>(t);
+      } else {
+        edges[edge] = Slot(static_cast<int>(t), i);
+      }
+    }
+  }
+  valid_ = true;
+}
+
+int BlendSpace::SampleSimplex(math::Float2 _parameter, Cursor* _cursor,
+                              int* _indices, float* _weights) const {
+  if (!valid_) {
+    return 0;
+  }
+
+  // Single clip space, or single point 1d space.
+  if (simplices_.empty()) {
+    _indices[0] = 0;
+    _weights[0] = 1.f;
+    return 1;
+  }
+
+  Cursor local_cursor;
+  Cursor& cursor = _cursor ? *_cursor : local_cursor;
+  int current = math::Clamp(0, cursor.simplex,
+                            static_cast<int>(simplices_.size()) - 1);
+
+  if (dimension_ == 1) {
+    // Walks segments left or right until the parameter is covered, clamping
+    // at space boundaries.
+    for (;;) {
+      const Simplex& segment = simplices_[current];
+      const float left = points_[segment.points[0]].x;
+      const float right = points_[segment.points[1]].x;
+      if (_parameter.x < left && segment.neighbors[0] != -1) {
+        current = segment.neighbors[0];
+      } else if (_parameter.x > right && segment.neighbors[1] != -1) {
+        current = segment.neighbors[1];
+      } else {
+        cursor.simplex = current;
+        const float alpha =
+            math::Clamp(0.f, (_parameter.x - left) / (right - left), 1.f);
+        _indices[0] = segment.points[0];
+        _weights[0] = 1.f - alpha;
+        _indices[1] = segment.points[1];
+        _weights[1] = alpha;
+        return 2;
+      }
+    }
+  }
+
+  // 2d simplex walk: steps across the edge opposite to the most negative
+  // barycentric coordinate, until the parameter is inside a triangle or the
+  // walk exits the hull. The step count is bounded as a safety net against
+  // degenerate float cases.
+  bool inside = false;
+  float weights[3];
+  for (size_t step = 0; step <= simplices_.size(); ++step) {
+    const Simplex& triangle = simplices_[current];
+    Barycentric(points_[triangle.points[0]], points_[triangle.points[1]],
+                points_[triangle.points[2]], _parameter, weights);
+    int lowest = 0;
+    for (int i = 1; i < 3; ++i) {
+      lowest = weights[i] < weights[lowest] ? i : lowest;
+    }
+    inside = weights[lowest] >= -kBarycentricTolerance;
+    if (inside || triangle.neighbors[lowest] == -1) {
+      break;
+    }
+    current = triangle.neighbors[lowest];
+  }
+
+  if (!inside) {
+    // The parameter is outside the hull, clamps it to its boundary: finds
+    // the simplex holding the closest point. This scan is linear, but only
+    // paid when clamping, which coherent in-space parameters never hit.
+    float best = ClosestPoint(points_[simplices_[current].points[0]],
+                              points_[simplices_[current].points[1]],
+                              points_[simplices_[current].points[2]],
+                              _parameter, weights);
+    for (size_t t = 0; t < simplices_.size(); ++t) {
+      float candidate_weights[3];
+      const float distance = ClosestPoint(
+          points_[simplices_[t].points[0]], points_[simplices_[t].points[1]],
+          points_[simplices_[t].points[2]], _parameter, candidate_weights);
+      if (distance < best) {
+        current = static_cast<int>(t);
+        best = distance;
+        std::memcpy(weights, candidate_weights, sizeof(weights));
+      }
+    }
+  }
+  cursor.simplex = current;
+
+  const Simplex& triangle = simplices_[current];
+  for (int i = 0; i < 3; ++i) {
+    _indices[i] = triangle.points[i];
+    _weights[i] = math::Max(weights[i], 0.f);
+  }
+  return 3;
+}
+
+bool BlendSpace::Sample(math::Float2 _parameter, span<float> _weights,
+                        Cursor* _cursor) const {
+  if (_weights.size() != points_.size() || points_.empty()) {
+    return false;
+  }
+  int indices[3];
+  float weights[3];
+  const int contributions =
+      SampleSimplex(_parameter, _cursor, indices, weights);
+  if (contributions == 0) {
+    return false;
+  }
+  std::memset(_weights.data(), 0, _weights.size_bytes());
+  for (int i = 0; i < contributions; ++i) {
+    _weights[indices[i]] = weights[i];
+  }
+  return true;
+}
+
+bool BlendSpace::Sample(math::Float2 _parameter,
+                        span<BlendingJob::Layer> _layers,
+                        Cursor* _cursor) const {
+  if (_layers.size() != points_.size() || points_.empty()) {
+    return false;
+  }
+  int indices[3];
+  float weights[3];
+  const int contributions =
+      SampleSimplex(_parameter, _cursor, indices, weights);
+  if (contributions == 0) {
+    return false;
+  }
+  for (size_t i = 0; i < _layers.size(); ++i) {
+    _layers[i].weight = 0.f;
+  }
+  for (int i = 0; i < contributions; ++i) {
+    _layers[indices[i]].weight = weights[i];
+  }
+  return true;
+}
+}  // namespace animation
+}  // namespace ozz
@@ -0,0 +1,105 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/blend_tree.h"
+
+#include <cassert>
+
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/maths/soa_transform.h"
+
+namespace ozz {
+namespace animation {
+
+BlendTree::BlendTree(const Skeleton& _skeleton,
+                     const span<const Input>& _inputs, float _threshold)
+    : skeleton_(&_skeleton), threshold_(_threshold), valid_(false) {
+  // Performs once the validation that BlendingJob would otherwise redo every
+  // frame: threshold and per-layer buffer sizes against the rest pose.
+  const size_t num_soa_joints =
+      static_cast<size_t>(_skeleton.num_soa_joints());
+
+  bool valid = _threshold > 0.f;
+  for (const Input& input : _inputs) {
+    valid &= input.transform.size() >= num_soa_joints;
+    valid &= input.joint_weights.empty() ||
+             input.joint_weights.size() >= num_soa_joints;
+  }
+  if (!valid) {
+    return;
+  }
+
+  // Compiles inputs to pre-resolved layers, split as BlendingJob expects
+  // them, remembering where each input's weight must be stored.
+  weight_slots_.reserve(_inputs.size());
+  for (const Input& input : _inputs) {
+    vector<BlendingJob::Layer>& layers =
+        input.additive ? additive_layers_ : layers_;
+    WeightSlot slot = {static_cast<uint16_t>(layers.size()), input.additive};
+    weight_slots_.push_back(slot);
+
+    BlendingJob::Layer layer;
+    layer.transform = input.transform;
+    layer.joint_weights = input.joint_weights;
+    layers.push_back(layer);
+  }
+
+  valid_ = true;
+}
+
+bool BlendTree::Run(const span<const float>& _weights,
+                    const span<math::SoaTransform>& _output) {
+  // Only per-evaluation inputs need to be checked, everything else was
+  // validated at construction.
+  if (!valid_ || _weights.size() != weight_slots_.size() ||
+      _output.size() <
+          static_cast<size_t>(skeleton_->num_soa_joints())) {
+    return false;
+  }
+
+  // Stores evaluation weights to their pre-resolved layer.
+  for (size_t i = 0; i < _weights.size(); ++i) {
+    const WeightSlot& slot = weight_slots_[i];
+    vector<BlendingJob::Layer>& layers =
+        slot.additive ? additive_layers_ : layers_;
+    layers[slot.index].weight = _weights[i];
+  }
+
+  // Builds the pre-validated job and runs the blend kernels directly.
+  BlendingJob job;
+  job.threshold = threshold_;
+  job.layers = make_span(layers_);
+  job.additive_layers = make_span(additive_layers_);
+  job.rest_pose = skeleton_->joint_rest_poses();
+  job.output = _output;
+  assert(job.Validate() && "Compiled job is valid by construction.");
+  BlendingJob::RunValidated(job);
+
+  return true;
+}
+}  // namespace animation
+}  // namespace ozz
@@ -33,13 +33,15 @@
 #include "ozz/animation/runtime/skeleton.h"
 #include "ozz/base/maths/math_ex.h"
 #include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/profile.h"
 
 namespace ozz {
 namespace animation {
 
 BlendingJob::Layer::Layer() : weight(0.f) {}
 
-BlendingJob::BlendingJob() : threshold(.1f) {}
+BlendingJob::BlendingJob()
+    : threshold(.1f), from(0), to(Skeleton::kMaxSoAJoints) {}
 
 namespace {
 bool ValidateLayer(const BlendingJob::Layer& _layer, size_t _min_range) {
@@ -161,152 +163,155 @@ namespace {
         math::RcpEst(math::MAdd(_in.scale.z, _simd_weight, one_minus_weight)); \
   } while (void(0), 0)
 
-// Defines parameters that are passed through blending stages.
-struct ProcessArgs {
-  ProcessArgs(const BlendingJob& _job)
-      : job(_job),
-        num_soa_joints(_job.rest_pose.size()),
-        num_passes(0),
-        num_partial_passes(0),
-        accumulated_weight(0.f) {
-    // The range of all buffers has already been validated.
-    assert(job.output.size() >= num_soa_joints);
-    assert(OZZ_ARRAY_SIZE(accumulated_weights) >= num_soa_joints);
-  }
-
-  // Allocates enough space to store a accumulated weights per-joint.
-  // It will be initialized by the first pass processed, if any.
-  // This is quite big for a stack allocation (4 byte * maximum number of
-  // joints). This is one of the reasons why the number of joints is limited
-  // by the API.
-  // Note that this array is used with SoA data.
-  // This is the first argument in order to avoid wasting too much space with
-  // alignment padding.
-  math::SimdFloat4 accumulated_weights[Skeleton::kMaxSoAJoints];
-
-  // The job to process.
-  const BlendingJob& job;
-
-  // The number of transforms to process as defined by the size of the rest
-  // pose.
-  size_t num_soa_joints;
-
-  // Number of processed blended passes (excluding passes with a weight <= 0.f),
-  // including partial passes.
-  int num_passes;
+// Clamps the job's [from, to[ soa block range to the _num_soa_joints poses
+// actually blended, as defined by the rest pose buffer.
+inline size_t RangeBegin(const BlendingJob& _job, size_t _num_soa_joints) {
+  return static_cast<size_t>(
+      math::Clamp(0, _job.from, static_cast<int>(_num_soa_joints)));
+}
+inline size_t RangeEnd(const BlendingJob& _job, size_t _num_soa_joints) {
+  return static_cast<size_t>(
+      math::Clamp(_job.from, _job.to, static_cast<int>(_num_soa_joints)));
+}
 
-  // Number of processed partial blending passes (aka with a weight per-joint).
+// Number of soa blocks the multi-pass path processes per tile. The tile's
+// accumulators and per-joint weights live in a small stack scratch (8 blocks
+// of transforms = 1.25KB) that every stage (layers, rest pose, normalization)
+// runs through before moving to the next tile. This keeps the hot
+// accumulation state in L1 whatever the skeleton size, where walking the
+// whole output buffer once per stage re-streams it from L2 for big rigs
+// (a 400 joints pose buffer alone is 16KB).
+const size_t kTileBlocks = 8;
+
+// Blending statistics that don't depend on the processed block, computed
+// once upfront and shared by every tile.
+struct PassStats {
+  // Number of partial blending passes (aka with a weight per-joint).
   int num_partial_passes;
 
-  // The accumulated weight of all layers.
+  // The weight accumulated over all blending passes.
   float accumulated_weight;
 
- private:
-  // Disables assignment operators.
-  ProcessArgs(const ProcessArgs&);
-  void operator=(const ProcessArgs&);
+  // The global normalization weight, accumulated weight completed by the
+  // rest pose contribution. Only relevant when there's no partial pass
+  // (partial normalization is per-joint).
+  float normalization_weight;
 };
 
-// Blends all layers of the job to its output.
-void BlendLayers(ProcessArgs* _args) {
-  assert(_args);
+// Computes global pass statistics, mirroring the weight accumulation
+// performed while blending tiles.
+PassStats ComputePassStats(const BlendingJob& _job) {
+  int num_passes = 0;
+  PassStats stats = {0, 0.f, 0.f};
+  for (const BlendingJob::Layer& layer : _job.layers) {
+    if (layer.weight <= 0.f) {
+      continue;
+    }
+    ++num_passes;
+    stats.num_partial_passes += !layer.joint_weights.empty();
+    stats.accumulated_weight += layer.weight;
+  }
+
+  // The rest pose tops accumulated weight up to the threshold, or fully
+  // takes over (weight 1) when there's no blending pass at all.
+  stats.normalization_weight = stats.accumulated_weight;
+  if (stats.num_partial_passes == 0 &&
+      _job.threshold - stats.accumulated_weight > 0.f) {
+    stats.normalization_weight = num_passes == 0 ? 1.f : _job.threshold;
+  }
+  return stats;
+}
 
-  // Iterates through all layers and blend them to the output.
-  for (const BlendingJob::Layer& layer : _args->job.layers) {
+// Processes all blending stages for the [_begin, _end[ tile of soa blocks:
+// blends every layer to the tile scratch, applies the rest pose, normalizes
+// and stores the result to the job's output. Scratch accumulators are read
+// and written once per stage while they sit in L1.
+void ProcessTile(const BlendingJob& _job, size_t _begin, size_t _end,
+                 const PassStats& _stats) {
+  assert(_end - _begin <= kTileBlocks);
+
+  // Per-joint accumulated weights and transforms of the tile.
+  math::SimdFloat4 accumulated_weights[kTileBlocks];
+  math::SoaTransform transforms[kTileBlocks];
+
+  // Blends all layers to the tile scratch.
+  int num_passes = 0;
+  for (const BlendingJob::Layer& layer : _job.layers) {
     // Asserts buffer sizes, which must never fail as it has been validated.
-    assert(layer.transform.size() >= _args->num_soa_joints);
-    assert(layer.joint_weights.empty() ||
-           (layer.joint_weights.size() >= _args->num_soa_joints));
+    assert(layer.transform.size() >= _end);
+    assert(layer.joint_weights.empty() || (layer.joint_weights.size() >= _end));
 
     // Skip irrelevant layers.
     if (layer.weight <= 0.f) {
       continue;
     }
 
-    // Accumulates global weights.
-    _args->accumulated_weight += layer.weight;
     const math::SimdFloat4 layer_weight =
         math::simd_float4::Load1(layer.weight);
 
     if (!layer.joint_weights.empty()) {
       // This layer has per-joint weights.
-      ++_args->num_partial_passes;
-
-      if (_args->num_passes == 0) {
-        for (size_t i = 0; i < _args->num_soa_joints; ++i) {
+      if (num_passes == 0) {
+        for (size_t i = _begin; i < _end; ++i) {
           const math::SoaTransform& src = layer.transform[i];
-          math::SoaTransform& dest = _args->job.output[i];
+          math::SoaTransform& dest = transforms[i - _begin];
           const math::SimdFloat4 weight =
               layer_weight * math::Max0(layer.joint_weights[i]);
-          _args->accumulated_weights[i] = weight;
+          accumulated_weights[i - _begin] = weight;
           OZZ_BLEND_1ST_PASS(src, weight, dest);
         }
       } else {
-        for (size_t i = 0; i < _args->num_soa_joints; ++i) {
+        for (size_t i = _begin; i < _end; ++i) {
           const math::SoaTransform& src = layer.transform[i];
-          math::SoaTransform& dest = _args->job.output[i];
+          math::SoaTransform& dest = transforms[i - _begin];
           const math::SimdFloat4 weight =
               layer_weight * math::Max0(layer.joint_weights[i]);
-          _args->accumulated_weights[i] =
-              _args->accumulated_weights[i] + weight;
+          accumulated_weights[i - _begin] =
+              accumulated_weights[i - _begin] + weight;
           OZZ_BLEND_N_PASS(src, weight, dest);
         }
       }
     } else {
       // This is a full layer.
-      if (_args->num_passes == 0) {
-        for (size_t i = 0; i < _args->num_soa_joints; ++i) {
+      if (num_passes == 0) {
+        for (size_t i = _begin; i < _end; ++i) {
           const math::SoaTransform& src = layer.transform[i];
-          math::SoaTransform& dest = _args->job.output[i];
-          _args->accumulated_weights[i] = layer_weight;
+          math::SoaTransform& dest = transforms[i - _begin];
+          accumulated_weights[i - _begin] = layer_weight;
           OZZ_BLEND_1ST_PASS(src, layer_weight, dest);
         }
       } else {
-        for (size_t i = 0; i < _args->num_soa_joints; ++i) {
+        for (size_t i = _begin; i < _end; ++i) {
           const math::SoaTransform& src = layer.transform[i];
-          math::SoaTransform& dest = _args->job.output[i];
-          _args->accumulated_weights[i] =
-              _args->accumulated_weights[i] + layer_weight;
+          math::SoaTransform& dest = transforms[i - _begin];
+          accumulated_weights[i - _begin] =
+              accumulated_weights[i - _begin] + layer_weight;
           OZZ_BLEND_N_PASS(src, layer_weight, dest);
         }
       }
     }
     // One more pass blended.
-    ++_args->num_passes;
+    ++num_passes;
   }
-}
-
-// Blends rest pose to the output if accumulated weight is less than the
-// threshold value.
-void BlendRestPose(ProcessArgs* _args) {
-  assert(_args);
-
-  // Asserts buffer sizes, which must never fail as it has been validated.
-  assert(_args->job.rest_pose.size() >= _args->num_soa_joints);
 
-  if (_args->num_partial_passes == 0) {
+  // Blends rest pose to the tile if accumulated weight is less than the
+  // threshold value.
+  assert(_job.rest_pose.size() >= _end);
+  if (_stats.num_partial_passes == 0) {
     // No partial blending pass detected, threshold can be tested globally.
-    const float bp_weight = _args->job.threshold - _args->accumulated_weight;
-
+    const float bp_weight = _job.threshold - _stats.accumulated_weight;
     if (bp_weight > 0.f) {  // The rest-pose is needed if it has a weight.
-      if (_args->num_passes == 0) {
+      if (num_passes == 0) {
         // Strictly copying rest-pose.
-        _args->accumulated_weight = 1.f;
-        for (size_t i = 0; i < _args->num_soa_joints; ++i) {
-          _args->job.output[i] = _args->job.rest_pose[i];
+        for (size_t i = _begin; i < _end; ++i) {
+          transforms[i - _begin] = _job.rest_pose[i];
         }
       } else {
-        // Updates global accumulated weight, but not per-joint weight any more
-        // because normalization stage will be global also.
-        _args->accumulated_weight = _args->job.threshold;
-
         const math::SimdFloat4 simd_bp_weight =
             math::simd_float4::Load1(bp_weight);
-
-        for (size_t i = 0; i < _args->num_soa_joints; ++i) {
-          const math::SoaTransform& src = _args->job.rest_pose[i];
-          math::SoaTransform& dest = _args->job.output[i];
-          OZZ_BLEND_N_PASS(src, simd_bp_weight, dest);
+        for (size_t i = _begin; i < _end; ++i) {
+          const math::SoaTransform& src = _job.rest_pose[i];
+          OZZ_BLEND_N_PASS(src, simd_bp_weight, transforms[i - _begin]);
         }
       }
     }
@@ -314,143 +319,260 @@ void BlendRestPose(ProcessArgs* _args) {
     // Blending passes contain partial blending, threshold must be tested for
     // each joint.
     const math::SimdFloat4 threshold =
-        math::simd_float4::Load1(_args->job.threshold);
+        math::simd_float4::Load1(_job.threshold);
 
     // There's been at least 1 pass as num_partial_passes != 0.
-    assert(_args->num_passes != 0);
+    assert(num_passes != 0);
 
-    for (size_t i = 0; i < _args->num_soa_joints; ++i) {
-      const math::SoaTransform& src = _args->job.rest_pose[i];
-      math::SoaTransform& dest = _args->job.output[i];
+    for (size_t i = _begin; i < _end; ++i) {
+      const math::SoaTransform& src = _job.rest_pose[i];
       const math::SimdFloat4 bp_weight =
-          math::Max0(threshold - _args->accumulated_weights[i]);
-      _args->accumulated_weights[i] =
-          math::Max(threshold, _args->accumulated_weights[i]);
-      OZZ_BLEND_N_PASS(src, bp_weight, dest);
+          math::Max0(threshold - accumulated_weights[i - _begin]);
+      accumulated_weights[i - _begin] =
+          math::Max(threshold, accumulated_weights[i - _begin]);
+      OZZ_BLEND_N_PASS(src, bp_weight, transforms[i - _begin]);
     }
   }
-}
-
-// Normalizes output rotations. Quaternion length cannot be zero as opposed
-// quaternions have been fixed up during blending passes.
-// Translations and scales are already normalized because weights were
-// pre-multiplied by the normalization ratio.
-void Normalize(ProcessArgs* _args) {
-  assert(_args);
 
-  if (_args->num_partial_passes == 0) {
+  // Normalizes tile rotations and stores the result to the output buffer.
+  // Quaternion length cannot be zero as opposed quaternions have been fixed
+  // up during blending passes. Translations and scales are normalized by the
+  // accumulated weights.
+  if (_stats.num_partial_passes == 0) {
     // Normalization of a non-partial blending requires to apply the same
     // division to all joints.
     const math::SimdFloat4 ratio =
-        math::simd_float4::Load1(1.f / _args->accumulated_weight);
-    for (size_t i = 0; i < _args->num_soa_joints; ++i) {
-      math::SoaTransform& dest = _args->job.output[i];
-      dest.rotation = NormalizeEst(dest.rotation);
-      dest.translation = dest.translation * ratio;
-      dest.scale = dest.scale * ratio;
+        math::simd_float4::Load1(1.f / _stats.normalization_weight);
+    for (size_t i = _begin; i < _end; ++i) {
+      const math::SoaTransform& src = transforms[i - _begin];
+      math::SoaTransform& dest = _job.output[i];
+      dest.rotation = NormalizeEst(src.rotation);
+      dest.translation = src.translation * ratio;
+      dest.scale = src.scale * ratio;
     }
   } else {
     // Partial blending normalization requires to compute the divider per-joint.
     const math::SimdFloat4 one = math::simd_float4::one();
-    for (size_t i = 0; i < _args->num_soa_joints; ++i) {
-      const math::SimdFloat4 ratio = one / _args->accumulated_weights[i];
-      math::SoaTransform& dest = _args->job.output[i];
-      dest.rotation = NormalizeEst(dest.rotation);
-      dest.translation = dest.translation * ratio;
-      dest.scale = dest.scale * ratio;
+    for (size_t i = _begin; i < _end; ++i) {
+      const math::SimdFloat4 ratio = one / accumulated_weights[i - _begin];
+      const math::SoaTransform& src = transforms[i - _begin];
+      math::SoaTransform& dest = _job.output[i];
+      dest.rotation = NormalizeEst(src.rotation);
+      dest.translation = src.translation * ratio;
+      dest.scale = src.scale * ratio;
     }
   }
 }
 
 // Process additive blending pass.
-void AddLayers(ProcessArgs* _args) {
-  assert(_args);
-
-  // Iterates through all layers and blend them to the output.
-  for (const BlendingJob::Layer& layer : _args->job.additive_layers) {
-    // Asserts buffer sizes, which must never fail as it has been validated.
-    assert(layer.transform.size() >= _args->num_soa_joints);
-    assert(layer.joint_weights.empty() ||
-           (layer.joint_weights.size() >= _args->num_soa_joints));
+// Applies a single additive layer onto _output, which is both read and
+// written. Shared by the BlendingJob additive stage and ApplyAdditiveJob.
+void AddLayer(const BlendingJob::Layer& _layer, size_t _begin, size_t _end,
+              const span<math::SoaTransform>& _output) {
+  // Asserts buffer sizes, which must never fail as it has been validated.
+  assert(_layer.transform.size() >= _end);
+  assert(_layer.joint_weights.empty() ||
+         (_layer.joint_weights.size() >= _end));
 
-    // Prepares constants.
-    const math::SimdFloat4 one = math::simd_float4::one();
+  // Prepares constants.
+  const math::SimdFloat4 one = math::simd_float4::one();
 
-    if (layer.weight > 0.f) {
-      // Weight is positive, need to perform additive blending.
-      const math::SimdFloat4 layer_weight =
-          math::simd_float4::Load1(layer.weight);
+  if (_layer.weight > 0.f) {
+    // Weight is positive, need to perform additive blending.
+    const math::SimdFloat4 layer_weight =
+        math::simd_float4::Load1(_layer.weight);
 
-      if (!layer.joint_weights.empty()) {
-        // This layer has per-joint weights.
-        for (size_t i = 0; i < _args->num_soa_joints; ++i) {
-          const math::SoaTransform& src = layer.transform[i];
-          math::SoaTransform& dest = _args->job.output[i];
-          const math::SimdFloat4 weight =
-              layer_weight * math::Max0(layer.joint_weights[i]);
-          const math::SimdFloat4 one_minus_weight = one - weight;
-          OZZ_ADD_PASS(src, weight, dest);
-        }
-      } else {
-        // This is a full layer.
-        const math::SimdFloat4 one_minus_weight = one - layer_weight;
+    if (!_layer.joint_weights.empty()) {
+      // This layer has per-joint weights.
+      for (size_t i = _begin; i < _end; ++i) {
+        const math::SoaTransform& src = _layer.transform[i];
+        math::SoaTransform& dest = _output[i];
+        const math::SimdFloat4 weight =
+            layer_weight * math::Max0(_layer.joint_weights[i]);
+        const math::SimdFloat4 one_minus_weight = one - weight;
+        OZZ_ADD_PASS(src, weight, dest);
+      }
+    } else {
+      // This is a full layer.
+      const math::SimdFloat4 one_minus_weight = one - layer_weight;
 
-        for (size_t i = 0; i < _args->num_soa_joints; ++i) {
-          const math::SoaTransform& src = layer.transform[i];
-          math::SoaTransform& dest = _args->job.output[i];
-          OZZ_ADD_PASS(src, layer_weight, dest);
-        }
+      for (size_t i = _begin; i < _end; ++i) {
+        const math::SoaTransform& src = _layer.transform[i];
+        math::SoaTransform& dest = _output[i];
+        OZZ_ADD_PASS(src, layer_weight, dest);
       }
-    } else if (layer.weight < 0.f) {
-      // Weight is negative, need to perform subtractive blending.
-      const math::SimdFloat4 layer_weight =
-          math::simd_float4::Load1(-layer.weight);
-
-      if (!layer.joint_weights.empty()) {
-        // This layer has per-joint weights.
-        for (size_t i = 0; i < _args->num_soa_joints; ++i) {
-          const math::SoaTransform& src = layer.transform[i];
-          math::SoaTransform& dest = _args->job.output[i];
-          const math::SimdFloat4 weight =
-              layer_weight * math::Max0(layer.joint_weights[i]);
-          const math::SimdFloat4 one_minus_weight = one - weight;
-          OZZ_SUB_PASS(src, weight, dest);
-        }
-      } else {
-        // This is a full layer.
-        const math::SimdFloat4 one_minus_weight = one - layer_weight;
-        for (size_t i = 0; i < _args->num_soa_joints; ++i) {
-          const math::SoaTransform& src = layer.transform[i];
-          math::SoaTransform& dest = _args->job.output[i];
-          OZZ_SUB_PASS(src, layer_weight, dest);
-        }
+    }
+  } else if (_layer.weight < 0.f) {
+    // Weight is negative, need to perform subtractive blending.
+    const math::SimdFloat4 layer_weight =
+        math::simd_float4::Load1(-_layer.weight);
+
+    if (!_layer.joint_weights.empty()) {
+      // This layer has per-joint weights.
+      for (size_t i = _begin; i < _end; ++i) {
+        const math::SoaTransform& src = _layer.transform[i];
+        math::SoaTransform& dest = _output[i];
+        const math::SimdFloat4 weight =
+            layer_weight * math::Max0(_layer.joint_weights[i]);
+        const math::SimdFloat4 one_minus_weight = one - weight;
+        OZZ_SUB_PASS(src, weight, dest);
       }
     } else {
-      // Skip layer as its weight is 0.
+      // This is a full layer.
+      const math::SimdFloat4 one_minus_weight = one - layer_weight;
+      for (size_t i = _begin; i < _end; ++i) {
+        const math::SoaTransform& src = _layer.transform[i];
+        math::SoaTransform& dest = _output[i];
+        OZZ_SUB_PASS(src, layer_weight, dest);
+      }
     }
+  } else {
+    // Skip layer as its weight is 0.
   }
 }
+
+// Maximum number of layers supported by the fused blending path. Bounds the
+// per-block inner loop as well as the stack footprint of collected layers.
+const size_t kMaxFusedLayers = 8;
+
+// Fused blending path: processes all layers, the rest pose and normalization
+// in a single walk over soa blocks, accumulating in registers. This avoids
+// re-streaming the output accumulator buffer once per layer. Only the common
+// case is supported: full (non per-joint weighted) layers and no additive
+// layer. Returns false when the job doesn't fit, leaving the processing to
+// the multi-pass implementation.
+bool BlendLayersFused(const BlendingJob& _job) {
+  if (!_job.additive_layers.empty()) {
+    return false;
+  }
+
+  // Collects relevant layers and pre-splat weights.
+  const BlendingJob::Layer* active_layers[kMaxFusedLayers];
+  math::SimdFloat4 layer_weights[kMaxFusedLayers];
+  size_t num_active = 0;
+  float accumulated_weight = 0.f;
+  for (const BlendingJob::Layer& layer : _job.layers) {
+    if (!layer.joint_weights.empty()) {
+      return false;  // Per-joint weights require the multi-pass path.
+    }
+    if (layer.weight <= 0.f) {
+      continue;  // Skip irrelevant layers.
+    }
+    if (num_active == kMaxFusedLayers) {
+      return false;  // Too many layers for the bounded inner loop.
+    }
+    active_layers[num_active] = &layer;
+    layer_weights[num_active] = math::simd_float4::Load1(layer.weight);
+    ++num_active;
+    accumulated_weight += layer.weight;
+  }
+  if (num_active == 0) {
+    return false;  // Rest pose copy is left to the multi-pass path.
+  }
+
+  // The rest pose acts as one more layer when accumulated weight doesn't
+  // reach the threshold, mirroring BlendRestPose().
+  const float bp_weight = _job.threshold - accumulated_weight;
+  const bool blends_bp = bp_weight > 0.f;
+  const math::SimdFloat4 simd_bp_weight = math::simd_float4::Load1(bp_weight);
+  if (blends_bp) {
+    accumulated_weight = _job.threshold;
+  }
+
+  // Normalization ratio is global, as there's no partial pass.
+  const math::SimdFloat4 ratio =
+      math::simd_float4::Load1(1.f / accumulated_weight);
+
+  const size_t num_soa_joints = _job.rest_pose.size();
+  const size_t end = RangeEnd(_job, num_soa_joints);
+  for (size_t i = RangeBegin(_job, num_soa_joints); i < end; ++i) {
+    // First pass initializes the register accumulator.
+    math::SoaTransform dest;
+    OZZ_BLEND_1ST_PASS(active_layers[0]->transform[i], layer_weights[0], dest);
+
+    // Accumulates all remaining layers' contributions for this block.
+    for (size_t l = 1; l < num_active; ++l) {
+      const math::SoaTransform& src = active_layers[l]->transform[i];
+      OZZ_BLEND_N_PASS(src, layer_weights[l], dest);
+    }
+
+    // Applies rest pose.
+    if (blends_bp) {
+      const math::SoaTransform& src = _job.rest_pose[i];
+      OZZ_BLEND_N_PASS(src, simd_bp_weight, dest);
+    }
+
+    // Normalizes and stores, still within the same block walk.
+    dest.rotation = NormalizeEst(dest.rotation);
+    dest.translation = dest.translation * ratio;
+    dest.scale = dest.scale * ratio;
+    _job.output[i] = dest;
+  }
+
+  return true;
+}
 }  // namespace
 
 bool BlendingJob::Run() const {
   if (!Validate()) {
     return false;
   }
+  RunValidated();
+  return true;
+}
 
-  // Initializes blended parameters that are exchanged across blend stages.
-  ProcessArgs process_args(*this);
+void BlendingJob::RunValidated() const {
+  assert(Validate() && "Job is expected to be valid.");
+  OZZ_PROFILE_JOB("BlendingJob", static_cast<int>(rest_pose.size() * 4));
+  RunValidated(*this);
+}
 
-  // Blends all layers to the job output buffers.
-  BlendLayers(&process_args);
+void BlendingJob::RunValidated(const BlendingJob& _job) {
+  // Tries the fused single-walk path first, covering the most common jobs.
+  if (BlendLayersFused(_job)) {
+    return;
+  }
 
-  // Applies rest pose.
-  BlendRestPose(&process_args);
+  // Computes global pass statistics, shared by every tile.
+  const PassStats stats = ComputePassStats(_job);
+
+  // Processes all blending stages tile by tile, keeping each tile's
+  // accumulation state in a small stack scratch. Additive layers are applied
+  // right behind each stored tile, while its output blocks are still hot.
+  const size_t num_soa_joints = _job.rest_pose.size();
+  const size_t end = RangeEnd(_job, num_soa_joints);
+  for (size_t i = RangeBegin(_job, num_soa_joints); i < end;
+       i += kTileBlocks) {
+    const size_t tile_end = math::Min(i + kTileBlocks, end);
+    ProcessTile(_job, i, tile_end, stats);
+    for (const Layer& layer : _job.additive_layers) {
+      AddLayer(layer, i, tile_end, _job.output);
+    }
+  }
+}
 
-  // Normalizes output.
-  Normalize(&process_args);
+bool ApplyAdditiveJob::Validate() const {
+  bool valid = true;
+
+  // The pose buffer defines the number of transforms to process, so only
+  // layers need to be checked against it.
+  for (const BlendingJob::Layer& layer : layers) {
+    valid &= ValidateLayer(layer, pose.size());
+  }
+
+  return valid;
+}
 
-  // Process additive blending.
-  AddLayers(&process_args);
+bool ApplyAdditiveJob::Run() const {
+  if (!Validate()) {
+    return false;
+  }
+
+  // Applies each layer in place, there's no accumulation, rest pose nor
+  // normalization stage.
+  for (const BlendingJob::Layer& layer : layers) {
+    AddLayer(layer, 0, pose.size(), pose);
+  }
 
   return true;
 }
@@ -0,0 +1,325 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/character_update.h"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/log.h"
+
+namespace ozz {
+namespace animation {
+
+namespace {
+
+// Stage display names, indexed by CharacterUpdate::Stage.
+const char* kStageNames[CharacterUpdate::kNumStages] = {
+    "sample", "blend", "pose", "local-to-model"};
+
+// Accumulates the enclosing scope duration into a shared nanosecond counter.
+// Stages run concurrently for different instances, hence the atomic.
+class StageTimer {
+ public:
+  explicit StageTimer(std::atomic<uint64_t>* _accumulator)
+      : accumulator_(_accumulator),
+        begin_(std::chrono::steady_clock::now()) {}
+  ~StageTimer() {
+    const uint64_t ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - begin_)
+            .count());
+    accumulator_->fetch_add(ns, std::memory_order_relaxed);
+  }
+
+ private:
+  StageTimer(const StageTimer&) = delete;
+  void operator=(const StageTimer&) = delete;
+
+  std::atomic<uint64_t>* accumulator_;
+  std::chrono::steady_clock::time_point begin_;
+};
+}  // namespace
+
+CharacterUpdate::CharacterUpdate() {}
+
+CharacterUpdate::~CharacterUpdate() {}
+
+bool CharacterUpdate::Initialize(const Setup& _setup) {
+  if (_setup.skeleton == nullptr || _setup.num_instances < 0 ||
+      _setup.num_layers <= 0) {
+    return false;
+  }
+  setup_ = _setup;
+
+  const size_t num_instances = static_cast<size_t>(setup_.num_instances);
+  const size_t num_layers = static_cast<size_t>(setup_.num_layers);
+  const size_t num_soa_joints = setup_.skeleton->num_soa_joints();
+  const size_t num_joints = setup_.skeleton->num_joints();
+
+  // Pools every buffer kind into a single allocation, instances contiguous.
+  layers_.clear();
+  layers_.resize(num_instances * num_layers);
+  locals_.resize(num_instances * num_layers * num_soa_joints);
+  blended_.resize(num_instances * num_soa_joints);
+  models_.resize(num_instances * num_joints);
+  blend_layers_.resize(num_instances * num_layers);
+
+  // Sampling contexts are sized once for the skeleton, so no sampling resizes
+  // them per animation.
+  contexts_.resize(num_instances * num_layers);
+  for (size_t i = 0; i < contexts_.size(); ++i) {
+    if (!contexts_[i]) {
+      contexts_[i] = make_unique<SamplingJob::Context>();
+    }
+    contexts_[i]->Resize(static_cast<int>(num_joints));
+  }
+
+  // Local-to-model setups never change once buffers are allocated, compiles
+  // them now so per-frame runs skip validation.
+  ltm_jobs_.resize(num_instances);
+  for (size_t i = 0; i < num_instances; ++i) {
+    LocalToModelJob job;
+    job.skeleton = setup_.skeleton;
+    job.input = {blended_.data() + i * num_soa_joints, num_soa_joints};
+    job.output = {models_.data() + i * num_joints, num_joints};
+    ltm_jobs_[i] = Compile(job);
+    assert(ltm_jobs_[i].valid());
+  }
+
+  // All instances start running. Snapshot storage stays empty until the
+  // first Freeze.
+  frozen_.clear();
+  frozen_.resize(num_instances, false);
+  snapshots_.clear();
+  snapshot_sizes_.clear();
+
+  for (int s = 0; s < kNumStages; ++s) {
+    durations_[s] = 0.f;
+    exceeded_[s] = false;
+  }
+  return true;
+}
+
+void CharacterUpdate::Freeze(int _instance) {
+  assert(_instance >= 0 && _instance < setup_.num_instances);
+  if (frozen_[_instance]) {
+    return;
+  }
+
+  // Allocates compact pose storage on first freeze.
+  if (snapshots_.empty()) {
+    const bool initialized = snapshot_codec_.Initialize(setup_.skeleton);
+    (void)initialized;
+    assert(initialized);
+    snapshots_.resize(setup_.num_instances *
+                      snapshot_codec_.max_encoded_size());
+    snapshot_sizes_.resize(setup_.num_instances, 0);
+  }
+
+  // Stores the last blended pose compactly. Sampling contexts are left
+  // untouched, see Thaw.
+  const size_t max_size = snapshot_codec_.max_encoded_size();
+  snapshot_sizes_[_instance] = snapshot_codec_.Encode(
+      locals(_instance), {snapshots_.data() + _instance * max_size, max_size});
+  assert(snapshot_sizes_[_instance] != 0);
+  frozen_[_instance] = true;
+}
+
+void CharacterUpdate::Thaw(int _instance) {
+  assert(_instance >= 0 && _instance < setup_.num_instances);
+  if (!frozen_[_instance]) {
+    return;
+  }
+  frozen_[_instance] = false;
+
+  // Restores the frozen pose, so the instance is consistent before the next
+  // Run performs the catch-up evaluation. The preserved sampling contexts
+  // make that catch-up an iframe seek (or an incremental advance for short
+  // freezes) rather than a cold cursor walk.
+  const size_t max_size = snapshot_codec_.max_encoded_size();
+  const bool decoded = snapshot_codec_.Decode(
+      {snapshots_.data() + _instance * max_size, snapshot_sizes_[_instance]},
+      locals(_instance));
+  (void)decoded;
+  assert(decoded);
+}
+
+bool CharacterUpdate::frozen(int _instance) const {
+  assert(_instance >= 0 && _instance < setup_.num_instances);
+  return frozen_[_instance];
+}
+
+bool CharacterUpdate::Sample(int _instance) {
+  if (frozen_[_instance]) {
+    return true;  // Frozen instances aren't evaluated.
+  }
+  const size_t num_soa_joints = setup_.skeleton->num_soa_joints();
+  const size_t base = _instance * setup_.num_layers;
+  for (size_t l = 0; l < static_cast<size_t>(setup_.num_layers); ++l) {
+    const Layer& layer = layers_[base + l];
+    if (layer.animation == nullptr || layer.weight <= 0.f) {
+      continue;  // Disabled layers aren't sampled.
+    }
+    SamplingJob job;
+    job.animation = layer.animation;
+    job.context = contexts_[base + l].get();
+    job.ratio = layer.ratio;
+    job.output = {locals_.data() + (base + l) * num_soa_joints,
+                  num_soa_joints};
+    if (!job.Run()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CharacterUpdate::Blend(int _instance) {
+  if (frozen_[_instance]) {
+    return true;  // Frozen instances aren't evaluated.
+  }
+  const size_t num_soa_joints = setup_.skeleton->num_soa_joints();
+  const size_t base = _instance * setup_.num_layers;
+
+  // Gathers active layers. BlendingJob falls back to the rest pose when no
+  // layer reaches the threshold, so an all-disabled instance stays valid.
+  size_t num_active = 0;
+  for (size_t l = 0; l < static_cast<size_t>(setup_.num_layers); ++l) {
+    const Layer& layer = layers_[base + l];
+    if (layer.animation == nullptr || layer.weight <= 0.f) {
+      continue;
+    }
+    BlendingJob::Layer& blend_layer = blend_layers_[base + num_active++];
+    blend_layer.weight = layer.weight;
+    blend_layer.transform = {locals_.data() + (base + l) * num_soa_joints,
+                             num_soa_joints};
+    blend_layer.joint_weights = {};
+  }
+
+  BlendingJob job;
+  job.threshold = setup_.threshold;
+  job.layers = {blend_layers_.data() + base, num_active};
+  job.rest_pose = setup_.skeleton->joint_rest_poses();
+  job.output = {blended_.data() + _instance * num_soa_joints, num_soa_joints};
+  return job.Run();
+}
+
+bool CharacterUpdate::LocalToModel(int _instance) {
+  if (frozen_[_instance]) {
+    return true;  // Frozen instances aren't evaluated.
+  }
+  return ltm_jobs_[_instance].Run();
+}
+
+bool CharacterUpdate::Run() {
+  if (setup_.skeleton == nullptr) {
+    return false;  // Not initialized.
+  }
+
+  // Per-stage cpu time accumulators for this run, shared across threads.
+  std::atomic<uint64_t> accumulators[kNumStages];
+  for (int s = 0; s < kNumStages; ++s) {
+    accumulators[s].store(0, std::memory_order_relaxed);
+  }
+
+  // Stage callables live on the stack, the pipeline Run below is synchronous.
+  auto sample = [this, &accumulators](int _instance) {
+    StageTimer timer(&accumulators[kSample]);
+    return Sample(_instance);
+  };
+  auto blend = [this, &accumulators](int _instance) {
+    StageTimer timer(&accumulators[kBlend]);
+    return Blend(_instance);
+  };
+  auto pose = [this, &accumulators](int _instance) {
+    if (frozen_[_instance]) {
+      return true;  // Frozen instances aren't evaluated.
+    }
+    StageTimer timer(&accumulators[kPose]);
+    return setup_.pose_fn(setup_.pose_context, _instance);
+  };
+  auto local_to_model = [this, &accumulators](int _instance) {
+    StageTimer timer(&accumulators[kLocalToModel]);
+    return LocalToModel(_instance);
+  };
+
+  // All stages are fused: each instance runs its whole chain back to back on
+  // a single thread, its pose buffers staying hot in cache.
+  AnimationPipeline::Stage stages[kNumStages];
+  size_t num_stages = 0;
+  stages[num_stages++] = AnimationPipeline::MakeStage("sample", sample);
+  stages[num_stages++] = AnimationPipeline::MakeStage("blend", blend);
+  if (setup_.pose_fn != nullptr) {
+    stages[num_stages++] = AnimationPipeline::MakeStage("pose", pose);
+  }
+  stages[num_stages++] =
+      AnimationPipeline::MakeStage("local-to-model", local_to_model);
+
+  AnimationPipeline pipeline;
+  pipeline.num_instances = setup_.num_instances;
+  pipeline.stages = {stages, num_stages};
+  pipeline.scheduler = setup_.scheduler;
+  pipeline.granularity = setup_.granularity;
+  const bool success = pipeline.Run();
+
+  // Collects timings and flags exceeded budgets. The check reports (log and
+  // accessor) rather than aborts, see class documentation.
+  for (int s = 0; s < kNumStages; ++s) {
+    durations_[s] =
+        accumulators[s].load(std::memory_order_relaxed) * 1e-3f;
+    exceeded_[s] = setup_.budgets[s] > 0.f && durations_[s] > setup_.budgets[s];
+    if (exceeded_[s]) {
+      log::Log() << "CharacterUpdate stage \"" << kStageNames[s]
+                 << "\" exceeded its budget: " << durations_[s] << "us > "
+                 << setup_.budgets[s] << "us." << std::endl;
+    }
+  }
+  return success;
+}
+
+span<CharacterUpdate::Layer> CharacterUpdate::layers(int _instance) {
+  assert(_instance >= 0 && _instance < setup_.num_instances);
+  return {layers_.data() + _instance * setup_.num_layers,
+          static_cast<size_t>(setup_.num_layers)};
+}
+
+span<math::SoaTransform> CharacterUpdate::locals(int _instance) {
+  assert(_instance >= 0 && _instance < setup_.num_instances);
+  const size_t num_soa_joints = setup_.skeleton->num_soa_joints();
+  return {blended_.data() + _instance * num_soa_joints, num_soa_joints};
+}
+
+span<const math::Float4x4> CharacterUpdate::models(int _instance) const {
+  assert(_instance >= 0 && _instance < setup_.num_instances);
+  const size_t num_joints = setup_.skeleton->num_joints();
+  return {models_.data() + _instance * num_joints, num_joints};
+}
+}  // namespace animation
+}  // namespace ozz
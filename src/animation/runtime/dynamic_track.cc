@@ -0,0 +1,201 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/dynamic_track.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <type_traits>
+
+#include "ozz/base/maths/math_ex.h"
+#include "ozz/base/memory/allocator.h"
+
+namespace ozz {
+namespace animation {
+namespace internal {
+
+namespace {
+// Tests the step bit of keyframe _at.
+bool TestBit(const ozz::vector<uint8_t>& _bits, size_t _at) {
+  return (_bits[_at / 8] & (1 << (_at & 7))) != 0;
+}
+
+// Sets or clears the step bit of keyframe _at.
+void SetBit(ozz::vector<uint8_t>& _bits, size_t _at, bool _set) {
+  const uint8_t mask = static_cast<uint8_t>(1 << (_at & 7));
+  if (_set) {
+    _bits[_at / 8] = static_cast<uint8_t>(_bits[_at / 8] | mask);
+  } else {
+    _bits[_at / 8] = static_cast<uint8_t>(_bits[_at / 8] & ~mask);
+  }
+}
+
+// Inserts a bit at position _at of a _count bits set, shifting all the
+// following bits up.
+void InsertBit(ozz::vector<uint8_t>& _bits, size_t _count, size_t _at,
+               bool _set) {
+  _bits.resize((_count + 1 + 7) / 8, 0);
+  for (size_t i = _count; i > _at; --i) {
+    SetBit(_bits, i, TestBit(_bits, i - 1));
+  }
+  SetBit(_bits, _at, _set);
+}
+
+// Removes the bit at position _at of a _count bits set, shifting all the
+// following bits down.
+void RemoveBit(ozz::vector<uint8_t>& _bits, size_t _count, size_t _at) {
+  for (size_t i = _at; i + 1 < _count; ++i) {
+    SetBit(_bits, i, TestBit(_bits, i + 1));
+  }
+  _bits.resize((_count - 1 + 7) / 8);
+}
+}  // namespace
+
+template <typename _ValueType>
+size_t DynamicTrack<_ValueType>::AddKey(float _ratio, const _ValueType& _value,
+                                        bool _step) {
+  const float clamped = math::Clamp(0.f, _ratio, 1.f);
+
+  // Inserts after any existing keyframe with the same ratio, keeping the
+  // ratio array sorted.
+  const size_t index =
+      std::upper_bound(ratios_.begin(), ratios_.end(), clamped) -
+      ratios_.begin();
+  InsertBit(steps_, ratios_.size(), index, _step);
+  ratios_.insert(ratios_.begin() + index, clamped);
+  values_.insert(values_.begin() + index, _value);
+  return index;
+}
+
+template <typename _ValueType>
+bool DynamicTrack<_ValueType>::RemoveKey(size_t _index) {
+  // Boundary keyframes (front at ratio 0, back at ratio 1) are required for
+  // sampling and cannot be removed.
+  if (_index == 0 || _index + 1 >= ratios_.size()) {
+    return false;
+  }
+  RemoveBit(steps_, ratios_.size(), _index);
+  ratios_.erase(ratios_.begin() + _index);
+  values_.erase(values_.begin() + _index);
+  return true;
+}
+
+template <typename _ValueType>
+size_t DynamicTrack<_ValueType>::MoveKey(size_t _index, float _ratio) {
+  if (_index == 0 || _index + 1 >= ratios_.size()) {
+    return num_keys();  // Invalid or boundary keyframe.
+  }
+  const _ValueType value = values_[_index];
+  const bool step = TestBit(steps_, _index);
+  RemoveKey(_index);
+  return AddKey(_ratio, value, step);
+}
+
+template <typename _ValueType>
+bool DynamicTrack<_ValueType>::SetValue(size_t _index,
+                                        const _ValueType& _value) {
+  if (_index >= values_.size()) {
+    return false;
+  }
+  values_[_index] = _value;
+  return true;
+}
+
+template <typename _ValueType>
+bool DynamicTrack<_ValueType>::SetStep(size_t _index, bool _step) {
+  if (_index >= ratios_.size()) {
+    return false;
+  }
+  SetBit(steps_, _index, _step);
+  return true;
+}
+
+template <typename _ValueType>
+void DynamicTrack<_ValueType>::Reset() {
+  ratios_.clear();
+  values_.clear();
+  steps_.clear();
+  name_.clear();
+
+  // Linear identity boundary keyframes, what the TrackBuilder outputs for an
+  // empty RawTrack.
+  const _ValueType identity = TrackPolicy<_ValueType>::identity();
+  ratios_.assign({0.f, 1.f});
+  values_.assign({identity, identity});
+  steps_.assign({0});
+}
+
+template <typename _ValueType>
+void DynamicTrack<_ValueType>::Assign(const Track<_ValueType>& _source) {
+  ratios_.assign(_source.ratios().begin(), _source.ratios().end());
+  values_.assign(_source.values().begin(), _source.values().end());
+  steps_.assign(_source.steps().begin(), _source.steps().end());
+  name_ = _source.name();
+}
+
+template <typename _ValueType>
+template <typename _Track>
+unique_ptr<_Track> DynamicTrack<_ValueType>::Bake() const {
+  static_assert(
+      std::is_same<typename _Track::ValueType, _ValueType>::value,
+      "Baked track type must have the same ValueType as the dynamic track.");
+
+  unique_ptr<_Track> track = make_unique<_Track>();
+  track->Allocate(ratios_.size(), name_.size());
+
+  std::copy(ratios_.begin(), ratios_.end(), track->ratios_.begin());
+  std::copy(values_.begin(), values_.end(), track->values_.begin());
+  assert(steps_.size() == track->steps_.size());
+  std::copy(steps_.begin(), steps_.end(), track->steps_.begin());
+
+  if (!name_.empty()) {
+    strcpy(track->name_, name_.c_str());
+  }
+  return track;
+}
+
+// Explicitly instantiates supported tracks and bake targets.
+template class OZZ_ANIMATION_DLL DynamicTrack<float>;
+template class OZZ_ANIMATION_DLL DynamicTrack<math::Float2>;
+template class OZZ_ANIMATION_DLL DynamicTrack<math::Float3>;
+template class OZZ_ANIMATION_DLL DynamicTrack<math::Float4>;
+template class OZZ_ANIMATION_DLL DynamicTrack<math::Quaternion>;
+
+template OZZ_ANIMATION_DLL unique_ptr<FloatTrack>
+DynamicTrack<float>::Bake<FloatTrack>() const;
+template OZZ_ANIMATION_DLL unique_ptr<Float2Track>
+DynamicTrack<math::Float2>::Bake<Float2Track>() const;
+template OZZ_ANIMATION_DLL unique_ptr<Float3Track>
+DynamicTrack<math::Float3>::Bake<Float3Track>() const;
+template OZZ_ANIMATION_DLL unique_ptr<Float4Track>
+DynamicTrack<math::Float4>::Bake<Float4Track>() const;
+template OZZ_ANIMATION_DLL unique_ptr<QuaternionTrack>
+DynamicTrack<math::Quaternion>::Bake<QuaternionTrack>() const;
+}  // namespace internal
+}  // namespace animation
+}  // namespace ozz
@@ -44,6 +44,7 @@ IKAimJob::IKAimJob()
       pole_vector(simd_float4::y_axis()),
       twist_angle(0.f),
       weight(1.f),
+      estimated(false),
       joint(nullptr),
       joint_correction(nullptr),
       reached(nullptr) {}
@@ -92,13 +93,10 @@ bool ComputeOffsettedForward(_SimdFloat4 _forward, _SimdFloat4 _offset,
 
   return true;
 }
-}  // namespace
-
-bool IKAimJob::Run() const {
-  if (!Validate()) {
-    return false;
-  }
 
+// Solves a validated aim job. Skipping validation allows the batched variant
+// to validate once for a whole batch.
+void Solve(const IKAimJob& _job) {
   using math::Float4x4;
   using math::SimdFloat4;
   using math::SimdQuaternion;
@@ -106,30 +104,31 @@ bool IKAimJob::Run() const {
   // If matrices aren't invertible, they'll be all 0 (ozz::math
   // implementation), which will result in identity correction quaternions.
   SimdInt4 invertible;
-  const Float4x4 inv_joint = Invert(*joint, &invertible);
+  const Float4x4 inv_joint = Invert(*_job.joint, &invertible);
 
   // Computes joint to target vector, in joint local-space (_js).
-  const SimdFloat4 joint_to_target_js = TransformPoint(inv_joint, target);
+  const SimdFloat4 joint_to_target_js = TransformPoint(inv_joint, _job.target);
   const SimdFloat4 joint_to_target_js_len2 = Length3Sqr(joint_to_target_js);
 
   // Recomputes forward vector to account for offset.
   // If the offset is further than target, it won't be reachable.
   SimdFloat4 offsetted_forward;
-  bool lreached = ComputeOffsettedForward(forward, offset, joint_to_target_js,
+  bool lreached = ComputeOffsettedForward(_job.forward, _job.offset,
+                                          joint_to_target_js,
                                           &offsetted_forward);
   // Copies reachability result.
   // If offsetted forward vector doesn't exists, target position cannot be
   // aimed.
-  if (reached != nullptr) {
-    *reached = lreached;
+  if (_job.reached != nullptr) {
+    *_job.reached = lreached;
   }
 
   if (!lreached ||
       AreAllTrue1(CmpEq(joint_to_target_js_len2, simd_float4::zero()))) {
     // Target can't be reached or is too close to joint position to find a
     // direction.
-    *joint_correction = SimdQuaternion::identity();
-    return true;
+    *_job.joint_correction = SimdQuaternion::identity();
+    return;
   }
 
   // Calculates joint_to_target_rot_ss quaternion which solves for
@@ -140,10 +139,11 @@ bool IKAimJob::Run() const {
   // Calculates rotate_plane_js quaternion which aligns joint up to the pole
   // vector.
   const SimdFloat4 corrected_up_js =
-      TransformVector(joint_to_target_rot_js, up);
+      TransformVector(joint_to_target_rot_js, _job.up);
 
   // Compute (and normalize) reference and pole planes normals.
-  const SimdFloat4 pole_vector_js = TransformVector(inv_joint, pole_vector);
+  const SimdFloat4 pole_vector_js =
+      TransformVector(inv_joint, _job.pole_vector);
   const SimdFloat4 ref_joint_normal_js =
       Cross3(pole_vector_js, joint_to_target_js);
   const SimdFloat4 joint_normal_js =
@@ -187,11 +187,15 @@ bool IKAimJob::Run() const {
 
   // Twists rotation plane.
   SimdQuaternion twisted;
-  if (twist_angle != 0.f) {
+  if (_job.twist_angle != 0.f) {
     // If a twist angle is provided, rotation angle is rotated around joint to
     // target vector.
-    const SimdQuaternion twist_ss = SimdQuaternion::FromAxisAngle(
-        rotate_plane_axis_js, simd_float4::Load1(twist_angle));
+    const SimdFloat4 simd_twist_angle = simd_float4::Load1(_job.twist_angle);
+    const SimdQuaternion twist_ss =
+        _job.estimated ? SimdQuaternion::FromAxisAngleEst(rotate_plane_axis_js,
+                                                          simd_twist_angle)
+                       : SimdQuaternion::FromAxisAngle(rotate_plane_axis_js,
+                                                       simd_twist_angle);
     twisted = twist_ss * rotate_plane_js * joint_to_target_rot_js;
   } else {
     twisted = rotate_plane_js * joint_to_target_rot_js;
@@ -205,15 +209,74 @@ bool IKAimJob::Run() const {
       Xor(twisted.xyzw, And(simd_int4::mask_sign(),
                             CmpLt(SplatW(twisted.xyzw), simd_float4::zero())));
 
-  if (weight < 1.f) {
+  if (_job.weight < 1.f) {
     // NLerp start and mid joint rotations.
     const SimdFloat4 identity = simd_float4::w_axis();
-    const SimdFloat4 simd_weight = Max0(simd_float4::Load1(weight));
-    joint_correction->xyzw =
+    const SimdFloat4 simd_weight = Max0(simd_float4::Load1(_job.weight));
+    _job.joint_correction->xyzw =
         NormalizeEst4(Lerp(identity, twisted.xyzw, simd_weight));
   } else {
     // Quaternion doesn't need interpolation
-    joint_correction->xyzw = twisted_fu;
+    _job.joint_correction->xyzw = twisted_fu;
+  }
+}
+}  // namespace
+
+bool IKAimJob::Run() const {
+  if (!Validate()) {
+    return false;
+  }
+
+  Solve(*this);
+
+  return true;
+}
+
+IKAimBatchJob::IKAimBatchJob()
+    : target(simd_float4::zero()),
+      forward(simd_float4::x_axis()),
+      offset(simd_float4::zero()),
+      up(simd_float4::y_axis()),
+      pole_vector(simd_float4::y_axis()),
+      twist_angle(0.f),
+      weight(1.f),
+      estimated(false) {}
+
+bool IKAimBatchJob::Validate() const {
+  bool valid = true;
+  valid &= joint_corrections.size() >= joints.size();
+  valid &= weights.empty() || weights.size() == joints.size();
+  valid &= reached.empty() || reached.size() == joints.size();
+  valid &= ozz::math::AreAllTrue1(ozz::math::IsNormalizedEst3(forward));
+  return valid;
+}
+
+bool IKAimBatchJob::Run() const {
+  if (!Validate()) {
+    return false;
+  }
+
+  // Setups an aim job with batch shared parameters, validated once for the
+  // whole batch.
+  IKAimJob job;
+  job.target = target;
+  job.forward = forward;
+  job.offset = offset;
+  job.up = up;
+  job.pole_vector = pole_vector;
+  job.twist_angle = twist_angle;
+  job.weight = weight;
+  job.estimated = estimated;
+
+  // Solves every instance.
+  for (size_t i = 0; i < joints.size(); ++i) {
+    if (!weights.empty()) {
+      job.weight = weights[i];
+    }
+    job.joint = &joints[i];
+    job.joint_correction = &joint_corrections[i];
+    job.reached = reached.empty() ? nullptr : &reached[i];
+    Solve(job);
   }
 
   return true;
@@ -0,0 +1,217 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/ik_chain_job.h"
+
+#include <cassert>
+#include <cmath>
+
+#include "ozz/base/maths/math_ex.h"
+#include "ozz/base/maths/simd_quaternion.h"
+
+using namespace ozz::math;
+
+namespace ozz {
+namespace animation {
+IKChainJob::IKChainJob()
+    : target(math::simd_float4::zero()),
+      iterations(10),
+      tolerance(1e-3f),
+      weight(1.f),
+      reached(nullptr) {}
+
+bool IKChainJob::Validate() const {
+  bool valid = true;
+  valid &= joints.size() >= 2;
+  valid &= joints.size() <= kMaxChainLength;
+  valid &= joints.size() >= 2 &&  // Avoids overflowing subtraction.
+           joint_corrections.size() >= joints.size() - 1;
+  valid &= joint_limits.empty() ||
+           (joints.size() >= 2 && joint_limits.size() == joints.size() - 1);
+  valid &= iterations > 0;
+  return valid;
+}
+
+namespace {
+
+// Fixes up quaternion so w is positive, which ensures the shortest arc is
+// considered when comparing angles or NLerping with identity quaternion.
+OZZ_INLINE SimdQuaternion PositiveW(const SimdQuaternion& _q) {
+  const SimdQuaternion quat = {
+      Xor(_q.xyzw, And(simd_int4::mask_sign(),
+                       CmpLt(SplatW(_q.xyzw), simd_float4::zero())))};
+  return quat;
+}
+}  // namespace
+
+bool IKChainJob::Run() const {
+  if (!Validate()) {
+    return false;
+  }
+
+  const int num_joints = static_cast<int>(joints.size());
+  const int num_links = num_joints - 1;
+
+  // Early out if weight is 0.
+  if (weight <= 0.f) {
+    // No correction.
+    for (int i = 0; i < num_links; ++i) {
+      joint_corrections[i] = SimdQuaternion::identity();
+    }
+    // Target isn't reached.
+    if (reached) {
+      *reached = false;
+    }
+    return true;
+  }
+
+  // Initializes solver transient state from model-space matrices: joint
+  // positions and accumulated model-space rotation corrections. This state is
+  // updated incrementally while iterating, which avoids any local-to-model
+  // propagation between solver steps.
+  SimdFloat4 positions[kMaxChainLength];
+  SimdQuaternion rotations_ms[kMaxChainLength];
+  for (int i = 0; i < num_joints; ++i) {
+    positions[i] = joints[i].cols[3];
+    rotations_ms[i] = SimdQuaternion::identity();
+  }
+
+  // Precomputes joint limits half angle sine/cosine, aka the components of the
+  // maximum allowed correction quaternion.
+  float limits_half_cos[kMaxChainLength];
+  float limits_half_sin[kMaxChainLength];
+  for (size_t i = 0; i < joint_limits.size(); ++i) {
+    const float half_angle = joint_limits[i] * .5f;
+    limits_half_cos[i] = std::cos(half_angle);
+    limits_half_sin[i] = std::sin(half_angle);
+  }
+
+  // Iterates CCD sweeps, from the joint closest to the end effector up to the
+  // chain root, until the target is reached or iterations are exhausted.
+  const SimdFloat4 tolerance2 = simd_float4::Load1(tolerance * tolerance);
+  bool lreached = AreAllTrue1(
+      CmpLt(Length3Sqr(positions[num_links] - target), tolerance2));
+  for (int it = 0; it < iterations && !lreached; ++it) {
+    for (int i = num_links - 1; i >= 0; --i) {
+      // Finds the rotation that aims the end effector at the target, when
+      // rotating the whole remaining chain around joint i. FromVectors returns
+      // identity for degenerated (0 length) inputs.
+      SimdQuaternion rot = SimdQuaternion::FromVectors(
+          positions[num_links] - positions[i], target - positions[i]);
+
+      if (!joint_limits.empty()) {
+        // Measures the correction joint i would accumulate relatively to its
+        // chain parent. Note that corrections applied at ancestors rotate the
+        // whole remaining chain rigidly, hence don't affect this relative
+        // rotation: the limit only needs to be enforced here, when joint i
+        // itself is rotated.
+        SimdQuaternion relative = rot * rotations_ms[i];
+        if (i > 0) {
+          relative = Conjugate(rotations_ms[i - 1]) * relative;
+        }
+        const SimdQuaternion relative_fu = PositiveW(relative);
+        if (GetW(relative_fu.xyzw) < limits_half_cos[i]) {
+          // Clamps rotation angle to the limit, preserving rotation axis. The
+          // axis is valid (non 0) as the exceeded limit implies a non identity
+          // rotation.
+          SimdQuaternion clamped;
+          clamped.xyzw =
+              SetW(Normalize3(relative_fu.xyzw) *
+                       simd_float4::Load1(limits_half_sin[i]),
+                   simd_float4::Load1(limits_half_cos[i]));
+          // Deduces back the model-space rotation that accumulates to the
+          // clamped relative correction.
+          rot = clamped * Conjugate(rotations_ms[i]);
+          if (i > 0) {
+            rot = rotations_ms[i - 1] * rot;
+          }
+        }
+      }
+
+      // Applies the rotation to joint i and all its chain descendants:
+      // accumulates model-space rotations and rotates positions around joint
+      // i. This is the incremental equivalent of a model-space update of the
+      // sub-chain.
+      for (int j = i; j < num_links; ++j) {
+        rotations_ms[j] = rot * rotations_ms[j];
+      }
+      for (int j = i + 1; j < num_joints; ++j) {
+        positions[j] =
+            positions[i] + TransformVector(rot, positions[j] - positions[i]);
+      }
+    }
+    lreached = AreAllTrue1(
+        CmpLt(Length3Sqr(positions[num_links] - target), tolerance2));
+  }
+  if (reached) {
+    *reached = lreached && weight >= 1.f;
+  }
+
+  // Converts accumulated model-space rotations to per joint local-space
+  // corrections, to be applied on top of each joint local-space rotation.
+  const SimdFloat4 identity = simd_float4::w_axis();
+  const SimdFloat4 simd_weight =
+      Min(simd_float4::Load1(weight), simd_float4::one());
+  for (int i = 0; i < num_links; ++i) {
+    // Model-space correction of joint i, relative to its chain parent
+    // correction.
+    SimdQuaternion relative = rotations_ms[i];
+    if (i > 0) {
+      relative = Conjugate(rotations_ms[i - 1]) * relative;
+    }
+    const SimdQuaternion relative_fu = PositiveW(relative);
+
+    // Brings the correction to joint i local-space. Rotation angle is
+    // unchanged, only the axis (aka the quaternion vector part, of length
+    // sin(angle/2)) needs to be transformed.
+    // If the joint matrix isn't invertible, it'll be all 0 (ozz::math
+    // implementation), which will result in an identity correction quaternion.
+    SimdInt4 invertible;
+    (void)invertible;
+    const Float4x4 inv_joint = Invert(joints[i], &invertible);
+    const SimdFloat4 axis_ls = TransformVector(inv_joint, relative_fu.xyzw);
+    const SimdFloat4 axis_ls_len2 = Length3Sqr(axis_ls);
+
+    SimdQuaternion correction = SimdQuaternion::identity();
+    if (GetX(axis_ls_len2) > 0.f) {
+      const SimdFloat4 sin_half = SqrtX(Length3Sqr(relative_fu.xyzw));
+      correction.xyzw =
+          SetW(Normalize3(axis_ls) * SplatX(sin_half), SplatW(relative_fu.xyzw));
+    }
+
+    // Applies weight, NLerping with identity quaternion.
+    if (weight < 1.f) {
+      correction.xyzw =
+          Normalize4(Lerp(identity, correction.xyzw, simd_weight));
+    }
+    joint_corrections[i] = correction;
+  }
+
+  return true;
+}
+}  // namespace animation
+}  // namespace ozz
@@ -44,6 +44,7 @@ IKTwoBoneJob::IKTwoBoneJob()
       twist_angle(0.f),
       soften(1.f),
       weight(1.f),
+      estimated(false),
       start_joint(nullptr),
       mid_joint(nullptr),
       end_joint(nullptr),
@@ -214,7 +215,8 @@ SimdQuaternion ComputeMidJoint(const IKTwoBoneJob& _job,
       Clamp(_setup.m_one, mid_cos_angles_unclamped, _setup.one);
 
   // Computes corrected angle
-  const SimdFloat4 mid_corrected_angle = ACosX(mid_cos_angles);
+  const SimdFloat4 mid_corrected_angle =
+      _job.estimated ? ACosEstX(mid_cos_angles) : ACosX(mid_cos_angles);
 
   // Computes initial angle.
   // The sign of this angle needs to be decided. It's considered negative if
@@ -223,14 +225,20 @@ SimdQuaternion ComputeMidJoint(const IKTwoBoneJob& _job,
   const SimdFloat4 bent_side_ref = Cross3(_setup.start_mid_ms, _job.mid_axis);
   const SimdInt4 bent_side_flip = SplatX(
       CmpLt(Dot3(bent_side_ref, _setup.mid_end_ms), simd_float4::zero()));
+  const SimdFloat4 mid_unsigned_initial_angle = _job.estimated
+                                                    ? ACosEstX(SplatY(mid_cos_angles))
+                                                    : ACosX(SplatY(mid_cos_angles));
   const SimdFloat4 mid_initial_angle =
-      Xor(ACosX(SplatY(mid_cos_angles)), And(bent_side_flip, _setup.mask_sign));
+      Xor(mid_unsigned_initial_angle, And(bent_side_flip, _setup.mask_sign));
 
   // Finally deduces initial to corrected angle difference.
   const SimdFloat4 mid_angles_diff = mid_corrected_angle - mid_initial_angle;
 
-  // Builds queternion.
-  return SimdQuaternion::FromAxisAngle(_job.mid_axis, mid_angles_diff);
+  // Builds queternion. The angle difference remains within FromAxisAngleEst
+  // validity range, as both corrected and initial angles are within [-pi, pi].
+  return _job.estimated
+             ? SimdQuaternion::FromAxisAngleEst(_job.mid_axis, mid_angles_diff)
+             : SimdQuaternion::FromAxisAngle(_job.mid_axis, mid_angles_diff);
 }
 
 SimdQuaternion ComputeStartJoint(const IKTwoBoneJob& _job,
@@ -299,8 +307,13 @@ SimdQuaternion ComputeStartJoint(const IKTwoBoneJob& _job,
     if (_job.twist_angle != 0.f) {
       // If a twist angle is provided, rotation angle is rotated along
       // rotation plane axis.
-      const SimdQuaternion twist_ss = SimdQuaternion::FromAxisAngle(
-          rotate_plane_axis_ss, simd_float4::Load1(_job.twist_angle));
+      const SimdFloat4 twist_angle = simd_float4::Load1(_job.twist_angle);
+      const SimdQuaternion twist_ss =
+          _job.estimated
+              ? SimdQuaternion::FromAxisAngleEst(rotate_plane_axis_ss,
+                                                 twist_angle)
+              : SimdQuaternion::FromAxisAngle(rotate_plane_axis_ss,
+                                              twist_angle);
       start_rot_ss = twist_ss * rotate_plane_ss * end_to_target_rot_ss;
     } else {
       start_rot_ss = rotate_plane_ss * end_to_target_rot_ss;
@@ -342,49 +355,103 @@ void WeightOutput(const IKTwoBoneJob& _job, const IKConstantSetup& _setup,
     _job.mid_joint_correction->xyzw = mid_rot_fu;
   }
 }
-}  // namespace
-
-bool IKTwoBoneJob::Run() const {
-  if (!Validate()) {
-    return false;
-  }
-
+// Solves a validated chain, see IKTwoBoneJob::Run for the overall algorithm.
+void Solve(const IKTwoBoneJob& _job) {
   // Early out if weight is 0.
-  if (weight <= 0.f) {
+  if (_job.weight <= 0.f) {
     // No correction.
-    *start_joint_correction = *mid_joint_correction =
+    *_job.start_joint_correction = *_job.mid_joint_correction =
         SimdQuaternion::identity();
     // Target isn't reached.
-    if (reached) {
-      *reached = false;
+    if (_job.reached) {
+      *_job.reached = false;
     }
-    return true;
+    return;
   }
 
   // Prepares constant ik data.
-  const IKConstantSetup setup(*this);
+  const IKConstantSetup setup(_job);
 
   // Finds soften target position.
   SimdFloat4 start_target_ss;
   SimdFloat4 start_target_ss_len2;
   const bool lreached =
-      SoftenTarget(*this, setup, &start_target_ss, &start_target_ss_len2);
-  if (reached) {
-    *reached = lreached && weight >= 1.f;
+      SoftenTarget(_job, setup, &start_target_ss, &start_target_ss_len2);
+  if (_job.reached) {
+    *_job.reached = lreached && _job.weight >= 1.f;
   }
 
   // Calculate mid_rot_local quaternion which solves for the mid_ss joint
   // rotation.
   const SimdQuaternion mid_rot_ms =
-      ComputeMidJoint(*this, setup, start_target_ss_len2);
+      ComputeMidJoint(_job, setup, start_target_ss_len2);
 
   // Calculates end_to_target_rot_ss quaternion which solves for effector
   // rotating onto the target.
   const SimdQuaternion start_rot_ss = ComputeStartJoint(
-      *this, setup, mid_rot_ms, start_target_ss, start_target_ss_len2);
+      _job, setup, mid_rot_ms, start_target_ss, start_target_ss_len2);
 
   // Finally apply weight and output quaternions.
-  WeightOutput(*this, setup, start_rot_ss, mid_rot_ms);
+  WeightOutput(_job, setup, start_rot_ss, mid_rot_ms);
+}
+}  // namespace
+
+bool IKTwoBoneJob::Run() const {
+  if (!Validate()) {
+    return false;
+  }
+
+  Solve(*this);
+
+  return true;
+}
+
+IKTwoBoneBatchJob::IKTwoBoneBatchJob()
+    : mid_axis(math::simd_float4::z_axis()),
+      pole_vector(math::simd_float4::y_axis()),
+      twist_angle(0.f),
+      soften(1.f),
+      weight(1.f),
+      estimated(false) {}
+
+bool IKTwoBoneBatchJob::Validate() const {
+  bool valid = true;
+  valid &= start_joints.size() == targets.size();
+  valid &= mid_joints.size() == targets.size();
+  valid &= end_joints.size() == targets.size();
+  valid &= start_joint_corrections.size() >= targets.size();
+  valid &= mid_joint_corrections.size() >= targets.size();
+  valid &= reached.empty() || reached.size() == targets.size();
+  valid &= ozz::math::AreAllTrue1(ozz::math::IsNormalizedEst3(mid_axis));
+  return valid;
+}
+
+bool IKTwoBoneBatchJob::Run() const {
+  if (!Validate()) {
+    return false;
+  }
+
+  // Setups a chain job with batch shared parameters, validated once for the
+  // whole batch.
+  IKTwoBoneJob job;
+  job.mid_axis = mid_axis;
+  job.pole_vector = pole_vector;
+  job.twist_angle = twist_angle;
+  job.soften = soften;
+  job.weight = weight;
+  job.estimated = estimated;
+
+  // Solves every chain.
+  for (size_t i = 0; i < targets.size(); ++i) {
+    job.target = targets[i];
+    job.start_joint = &start_joints[i];
+    job.mid_joint = &mid_joints[i];
+    job.end_joint = &end_joints[i];
+    job.start_joint_correction = &start_joint_corrections[i];
+    job.mid_joint_correction = &mid_joint_corrections[i];
+    job.reached = reached.empty() ? nullptr : &reached[i];
+    Solve(job);
+  }
 
   return true;
 }
@@ -0,0 +1,250 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/job_capture.h"
+
+#include <cstring>
+
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/animation/runtime/blending_job.h"
+#include "ozz/animation/runtime/local_to_model_job.h"
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/containers/vector_archive.h"
+#include "ozz/base/io/archive.h"
+#include "ozz/base/io/crc32c.h"
+
+namespace ozz {
+namespace animation {
+
+void JobCapture::Capture(const SamplingJob& _job) {
+  Sampling entry = {};
+  if (_job.animation) {
+    const char* name = _job.animation->name();
+    entry.animation_id =
+        io::CRC32C(0, name, std::strlen(name));
+    entry.num_tracks = _job.animation->num_tracks();
+    entry.duration = _job.animation->duration();
+  }
+  entry.ratio = _job.ratio;
+  entry.num_output_soa = static_cast<int>(_job.output.size());
+  entry.has_joint_mask = !_job.joint_mask.empty();
+  entry.deterministic = _job.deterministic;
+  entry.components = _job.components;
+  sampling_jobs_.push_back(entry);
+}
+
+void JobCapture::Capture(const BlendingJob& _job) {
+  Blending entry = {};
+  entry.threshold = _job.threshold;
+  entry.num_output_soa = static_cast<int>(_job.output.size());
+  entry.first_layer = static_cast<int>(layers_.size());
+  entry.num_layers =
+      static_cast<int>(_job.layers.size() + _job.additive_layers.size());
+  for (const BlendingJob::Layer& layer : _job.layers) {
+    const BlendingLayer captured = {layer.weight, false,
+                                    !layer.joint_weights.empty()};
+    layers_.push_back(captured);
+  }
+  for (const BlendingJob::Layer& layer : _job.additive_layers) {
+    const BlendingLayer captured = {layer.weight, true,
+                                    !layer.joint_weights.empty()};
+    layers_.push_back(captured);
+  }
+  blending_jobs_.push_back(entry);
+}
+
+void JobCapture::Capture(const LocalToModelJob& _job) {
+  LocalToModel entry = {};
+  if (_job.skeleton) {
+    entry.skeleton_id = _job.skeleton->structural_hash();
+    entry.num_joints = _job.skeleton->num_joints();
+  }
+  entry.from = _job.from;
+  entry.to = _job.to;
+  entry.from_excluded = _job.from_excluded;
+  entry.has_root = _job.root != nullptr;
+  entry.has_joint_mask = !_job.joint_mask.empty();
+  local_to_model_jobs_.push_back(entry);
+}
+
+void JobCapture::Clear() {
+  sampling_jobs_.clear();
+  blending_jobs_.clear();
+  layers_.clear();
+  local_to_model_jobs_.clear();
+}
+
+void JobCapture::Save(ozz::io::OArchive& _archive) const {
+  _archive << sampling_jobs_;
+  _archive << blending_jobs_;
+  _archive << layers_;
+  _archive << local_to_model_jobs_;
+}
+
+void JobCapture::Load(ozz::io::IArchive& _archive, uint32_t _version) {
+  (void)_version;
+  _archive >> sampling_jobs_;
+  _archive >> blending_jobs_;
+  _archive >> layers_;
+  _archive >> local_to_model_jobs_;
+}
+}  // namespace animation
+
+namespace io {
+// Captured descriptors' versions can be declared locally as they are only
+// saved from this cpp file.
+
+OZZ_IO_TYPE_VERSION(1, animation::JobCapture::Sampling)
+
+template <>
+struct Extern<animation::JobCapture::Sampling> {
+  static void Save(OArchive& _archive,
+                   const animation::JobCapture::Sampling* _entries,
+                   size_t _count) {
+    for (size_t i = 0; i < _count; ++i) {
+      const animation::JobCapture::Sampling& entry = _entries[i];
+      _archive << entry.animation_id;
+      _archive << entry.num_tracks;
+      _archive << entry.duration;
+      _archive << entry.ratio;
+      _archive << entry.num_output_soa;
+      _archive << entry.has_joint_mask;
+      _archive << entry.deterministic;
+      _archive << entry.components;
+    }
+  }
+  static void Load(IArchive& _archive,
+                   animation::JobCapture::Sampling* _entries, size_t _count,
+                   uint32_t _version) {
+    (void)_version;
+    for (size_t i = 0; i < _count; ++i) {
+      animation::JobCapture::Sampling& entry = _entries[i];
+      _archive >> entry.animation_id;
+      _archive >> entry.num_tracks;
+      _archive >> entry.duration;
+      _archive >> entry.ratio;
+      _archive >> entry.num_output_soa;
+      _archive >> entry.has_joint_mask;
+      _archive >> entry.deterministic;
+      _archive >> entry.components;
+    }
+  }
+};
+
+OZZ_IO_TYPE_VERSION(1, animation::JobCapture::Blending)
+
+template <>
+struct Extern<animation::JobCapture::Blending> {
+  static void Save(OArchive& _archive,
+                   const animation::JobCapture::Blending* _entries,
+                   size_t _count) {
+    for (size_t i = 0; i < _count; ++i) {
+      const animation::JobCapture::Blending& entry = _entries[i];
+      _archive << entry.threshold;
+      _archive << entry.num_output_soa;
+      _archive << entry.first_layer;
+      _archive << entry.num_layers;
+    }
+  }
+  static void Load(IArchive& _archive,
+                   animation::JobCapture::Blending* _entries, size_t _count,
+                   uint32_t _version) {
+    (void)_version;
+    for (size_t i = 0; i < _count; ++i) {
+      animation::JobCapture::Blending& entry = _entries[i];
+      _archive >> entry.threshold;
+      _archive >> entry.num_output_soa;
+      _archive >> entry.first_layer;
+      _archive >> entry.num_layers;
+    }
+  }
+};
+
+OZZ_IO_TYPE_VERSION(1, animation::JobCapture::BlendingLayer)
+
+template <>
+struct Extern<animation::JobCapture::BlendingLayer> {
+  static void Save(OArchive& _archive,
+                   const animation::JobCapture::BlendingLayer* _entries,
+                   size_t _count) {
+    for (size_t i = 0; i < _count; ++i) {
+      const animation::JobCapture::BlendingLayer& entry = _entries[i];
+      _archive << entry.weight;
+      _archive << entry.additive;
+      _archive << entry.has_joint_weights;
+    }
+  }
+  static void Load(IArchive& _archive,
+                   animation::JobCapture::BlendingLayer* _entries,
+                   size_t _count, uint32_t _version) {
+    (void)_version;
+    for (size_t i = 0; i < _count; ++i) {
+      animation::JobCapture::BlendingLayer& entry = _entries[i];
+      _archive >> entry.weight;
+      _archive >> entry.additive;
+      _archive >> entry.has_joint_weights;
+    }
+  }
+};
+
+OZZ_IO_TYPE_VERSION(1, animation::JobCapture::LocalToModel)
+
+template <>
+struct Extern<animation::JobCapture::LocalToModel> {
+  static void Save(OArchive& _archive,
+                   const animation::JobCapture::LocalToModel* _entries,
+                   size_t _count) {
+    for (size_t i = 0; i < _count; ++i) {
+      const animation::JobCapture::LocalToModel& entry = _entries[i];
+      _archive << entry.skeleton_id;
+      _archive << entry.num_joints;
+      _archive << entry.from;
+      _archive << entry.to;
+      _archive << entry.from_excluded;
+      _archive << entry.has_root;
+      _archive << entry.has_joint_mask;
+    }
+  }
+  static void Load(IArchive& _archive,
+                   animation::JobCapture::LocalToModel* _entries,
+                   size_t _count, uint32_t _version) {
+    (void)_version;
+    for (size_t i = 0; i < _count; ++i) {
+      animation::JobCapture::LocalToModel& entry = _entries[i];
+      _archive >> entry.skeleton_id;
+      _archive >> entry.num_joints;
+      _archive >> entry.from;
+      _archive >> entry.to;
+      _archive >> entry.from_excluded;
+      _archive >> entry.has_root;
+      _archive >> entry.has_joint_mask;
+    }
+  }
+};
+}  // namespace io
+}  // namespace ozz
@@ -0,0 +1,159 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/joint_name_table.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "ozz/animation/runtime/skeleton.h"
+
+namespace ozz {
+namespace animation {
+
+const char* JointNameTable::name(int _id) const {
+  assert(_id >= 0 && _id < count());
+  return chars_.data() + offsets_[_id];
+}
+
+int JointNameTable::Intern(const char* _name) {
+  const uint32_t hash = Skeleton::JointNameHash(_name);
+
+  // Locates the insertion point in the sorted order, by hash then by name so
+  // the order matches the skeleton name index one.
+  const auto it = std::lower_bound(
+      sorted_.begin(), sorted_.end(), _name,
+      [this, hash](int _id, const char* _n) {
+        if (hashes_[_id] != hash) {
+          return hashes_[_id] < hash;
+        }
+        return std::strcmp(name(_id), _n) < 0;
+      });
+
+  // Returns the existing id if the name was already interned. Hash equality
+  // isn't enough, collisions are solved with a string comparison.
+  if (it != sorted_.end() && hashes_[*it] == hash &&
+      std::strcmp(name(*it), _name) == 0) {
+    return *it;
+  }
+
+  // Appends the name copy and its metadata, and keeps the sorted order.
+  const int id = count();
+  offsets_.push_back(static_cast<uint32_t>(chars_.size()));
+  chars_.insert(chars_.end(), _name, _name + std::strlen(_name) + 1);
+  hashes_.push_back(hash);
+  sorted_.insert(it, id);
+  return id;
+}
+
+int JointNameTable::Find(const char* _name) const {
+  const uint32_t hash = Skeleton::JointNameHash(_name);
+  const auto found =
+      std::lower_bound(sorted_.begin(), sorted_.end(), hash,
+                       [this](int _id, uint32_t _hash) {
+                         return hashes_[_id] < _hash;
+                       });
+  // Solves hash collisions with a string comparison over the equal hashes
+  // run. Runs are nearly always a single entry long.
+  for (auto it = found; it != sorted_.end() && hashes_[*it] == hash; ++it) {
+    if (std::strcmp(name(*it), _name) == 0) {
+      return *it;
+    }
+  }
+  return -1;
+}
+
+bool JointNameTable::ResolveJoints(const Skeleton& _skeleton,
+                                   const span<int16_t>& _joints) const {
+  if (_joints.size() < offsets_.size()) {
+    return false;
+  }
+
+  // Unmatched names resolve to -1, mirroring FindJoint misses.
+  for (size_t i = 0; i < offsets_.size(); ++i) {
+    _joints[i] = -1;
+  }
+
+  // Single merge walk of the two hash-sorted sequences: interned names on one
+  // side, the skeleton name index on the other.
+  const span<const uint32_t> skeleton_hashes = _skeleton.joint_name_hashes();
+  const span<const int16_t> skeleton_sorted = _skeleton.joint_name_sorted();
+  const span<const char* const> joint_names = _skeleton.joint_names();
+  size_t i = 0, j = 0;
+  while (i < sorted_.size() && j < skeleton_hashes.size()) {
+    const uint32_t hash = hashes_[sorted_[i]];
+    if (hash < skeleton_hashes[j]) {
+      ++i;
+    } else if (skeleton_hashes[j] < hash) {
+      ++j;
+    } else {
+      // Equal hashes run on both sides, nearly always a single entry long on
+      // each. Collisions are solved with string comparisons over the run.
+      size_t j_end = j + 1;
+      for (; j_end < skeleton_hashes.size() && skeleton_hashes[j_end] == hash;
+           ++j_end) {
+      }
+      for (; i < sorted_.size() && hashes_[sorted_[i]] == hash; ++i) {
+        const int id = sorted_[i];
+        for (size_t k = j; k < j_end; ++k) {
+          const int16_t joint = skeleton_sorted[k];
+          if (std::strcmp(name(id), joint_names[joint]) == 0) {
+            _joints[id] = joint;
+            break;
+          }
+        }
+      }
+      j = j_end;
+    }
+  }
+  return true;
+}
+
+bool JointNameTable::ResolveJoints(const Skeleton& _skeleton,
+                                   const span<const int>& _ids,
+                                   const span<int16_t>& _joints) const {
+  if (_joints.size() < _ids.size()) {
+    return false;
+  }
+
+  // Resolves the whole table once, then gathers requested ids from it, so the
+  // skeleton name index is still walked a single time whatever _ids size and
+  // content.
+  vector<int16_t> resolved(offsets_.size());
+  ResolveJoints(_skeleton, make_span(resolved));
+  for (size_t i = 0; i < _ids.size(); ++i) {
+    const int id = _ids[i];
+    if (id < 0 || id >= count()) {
+      return false;
+    }
+    _joints[i] = resolved[id];
+  }
+  return true;
+}
+}  // namespace animation
+}  // namespace ozz
@@ -0,0 +1,131 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/joint_trajectory_job.h"
+
+#include <cassert>
+
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/maths/simd_math.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/maths/soa_transform_conversion.h"
+#include "ozz/base/maths/transform.h"
+
+namespace ozz {
+namespace animation {
+
+JointTrajectoryJob::JointTrajectoryJob()
+    : animation(nullptr),
+      skeleton(nullptr),
+      context(nullptr),
+      joint(-1),
+      from(0.f),
+      to(1.f) {}
+
+bool JointTrajectoryJob::Validate() const {
+  bool valid = true;
+
+  // Test for nullptr pointers.
+  if (!animation || !skeleton || !context) {
+    return false;
+  }
+  valid &= !trajectory.empty();
+
+  // The chain walk requires animation tracks to map skeleton joints.
+  valid &= animation->num_tracks() == skeleton->num_joints();
+  valid &= joint >= 0 && joint < skeleton->num_joints();
+
+  // Tests context size.
+  valid &= context->max_soa_tracks() >= animation->num_soa_tracks();
+
+  return valid;
+}
+
+bool JointTrajectoryJob::Run() const {
+  if (!Validate()) {
+    return false;
+  }
+
+  // Collects the ancestor chain, from the joint up to its root. Joints are
+  // stored in depth-first order, so every ancestor has a lower index than
+  // the joint: the chain fully lives in the first soa blocks, up to the one
+  // containing the joint.
+  int16_t chain[Skeleton::kMaxJoints];
+  size_t chain_length = 0;
+  const span<const int16_t> parents = skeleton->joint_parents();
+  for (int16_t j = static_cast<int16_t>(joint); j != Skeleton::kNoParent;
+       j = parents[j]) {
+    assert(j <= joint && "Parents must be stored before their children.");
+    chain[chain_length++] = j;
+  }
+
+  // Masks out every soa block the chain doesn't traverse, so sampling
+  // neither decompresses nor interpolates them.
+  byte mask[(Skeleton::kMaxSoAJoints + 7) / 8] = {};
+  for (size_t i = 0; i < chain_length; ++i) {
+    const int block = chain[i] / 4;
+    mask[block / 8] |= static_cast<byte>(1 << (block & 7));
+  }
+
+  // Local-space scratch pose. Sampling stops at the soa block containing the
+  // joint, as output size bounds the number of interpolated blocks.
+  math::SoaTransform locals[Skeleton::kMaxSoAJoints];
+
+  SamplingJob sampling;
+  sampling.animation = animation;
+  sampling.context = context;
+  sampling.output = {locals, static_cast<size_t>(joint) / 4 + 1};
+  sampling.joint_mask = {
+      mask, (static_cast<size_t>(animation->num_soa_tracks()) + 7) / 8};
+
+  const size_t num_samples = trajectory.size();
+  const float step =
+      num_samples > 1 ? (to - from) / static_cast<float>(num_samples - 1) : 0.f;
+  for (size_t s = 0; s < num_samples; ++s) {
+    sampling.ratio = from + step * static_cast<float>(s);
+    if (!sampling.Run()) {
+      return false;
+    }
+
+    // Accumulates the chain from the root (last collected) down to the joint.
+    math::Float4x4 model;
+    for (size_t i = chain_length; i-- != 0;) {
+      const int16_t j = chain[i];
+      const math::Transform local = math::GatherTransform(locals[j / 4], j % 4);
+      const math::Float4x4 matrix = math::Float4x4::FromAffine(
+          math::simd_float4::Load3PtrU(&local.translation.x),
+          math::simd_float4::LoadPtrU(&local.rotation.x),
+          math::simd_float4::Load3PtrU(&local.scale.x));
+      model = i + 1 == chain_length ? matrix : model * matrix;
+    }
+    trajectory[s] = model;
+  }
+  return true;
+}
+}  // namespace animation
+}  // namespace ozz
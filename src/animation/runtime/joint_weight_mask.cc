@@ -0,0 +1,143 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/joint_weight_mask.h"
+
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/platform.h"
+
+namespace ozz {
+namespace animation {
+
+namespace {
+// Packs per joint scalar _weights to SoA entries in _soa. Padding lanes of the
+// last entry are set to 0.
+void Pack(const span<const float>& _weights,
+          const span<math::SimdFloat4>& _soa) {
+  const size_t num_joints = _weights.size();
+  for (size_t i = 0; i < _soa.size(); ++i) {
+    const size_t j = i * 4;
+    _soa[i] = math::simd_float4::Load(
+        _weights[j], j + 1 < num_joints ? _weights[j + 1] : 0.f,
+        j + 2 < num_joints ? _weights[j + 2] : 0.f,
+        j + 3 < num_joints ? _weights[j + 3] : 0.f);
+  }
+}
+}  // namespace
+
+JointWeightMask::JointWeightMask() : num_joints_(0) {}
+
+bool JointWeightMask::Initialize(const Skeleton& _skeleton, float _weight) {
+  weights_.clear();
+  num_joints_ = 0;
+
+  const int num_joints = _skeleton.num_joints();
+  if (num_joints == 0) {
+    return false;
+  }
+
+  const vector<float> scalars(num_joints, _weight);
+  weights_.resize(_skeleton.num_soa_joints());
+  Pack(make_span(scalars), make_span(weights_));
+  num_joints_ = num_joints;
+  return true;
+}
+
+bool JointWeightMask::Initialize(const Skeleton& _skeleton,
+                                 const span<const float>& _weights) {
+  weights_.clear();
+  num_joints_ = 0;
+
+  const int num_joints = _skeleton.num_joints();
+  if (num_joints == 0 || _weights.size() != static_cast<size_t>(num_joints)) {
+    return false;
+  }
+
+  weights_.resize(_skeleton.num_soa_joints());
+  Pack(_weights, make_span(weights_));
+  num_joints_ = num_joints;
+  return true;
+}
+
+bool JointWeightMask::Initialize(const Skeleton& _skeleton,
+                                 const char* _pattern, float _match_weight,
+                                 float _default_weight) {
+  weights_.clear();
+  num_joints_ = 0;
+
+  const int num_joints = _skeleton.num_joints();
+  if (num_joints == 0 || _pattern == nullptr) {
+    return false;
+  }
+
+  vector<float> scalars(num_joints);
+  const span<const char* const> names = _skeleton.joint_names();
+  for (int i = 0; i < num_joints; ++i) {
+    scalars[i] = strmatch(names[i], _pattern) ? _match_weight : _default_weight;
+  }
+  weights_.resize(_skeleton.num_soa_joints());
+  Pack(make_span(scalars), make_span(weights_));
+  num_joints_ = num_joints;
+  return true;
+}
+
+bool JointWeightMask::Multiply(const JointWeightMask& _other) {
+  if (num_joints_ == 0 || num_joints_ != _other.num_joints_) {
+    return false;
+  }
+  for (size_t i = 0; i < weights_.size(); ++i) {
+    weights_[i] = weights_[i] * _other.weights_[i];
+  }
+  return true;
+}
+
+bool JointWeightMask::Max(const JointWeightMask& _other) {
+  if (num_joints_ == 0 || num_joints_ != _other.num_joints_) {
+    return false;
+  }
+  for (size_t i = 0; i < weights_.size(); ++i) {
+    weights_[i] = math::Max(weights_[i], _other.weights_[i]);
+  }
+  return true;
+}
+
+void JointWeightMask::Invert() {
+  const math::SimdFloat4 one = math::simd_float4::one();
+  for (size_t i = 0; i < weights_.size(); ++i) {
+    weights_[i] = one - weights_[i];
+  }
+  // Restores 0 to padding lanes of the last entry, inverted to 1 above.
+  const int rem = num_joints_ & 3;
+  if (rem != 0) {
+    const math::SimdInt4 valid = math::CmpLt(
+        math::simd_float4::Load(0.f, 1.f, 2.f, 3.f),
+        math::simd_float4::Load1(static_cast<float>(rem)));
+    weights_.back() = math::And(weights_.back(), valid);
+  }
+}
+}  // namespace animation
+}  // namespace ozz
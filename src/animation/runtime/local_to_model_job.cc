@@ -35,6 +35,7 @@
 #include "ozz/base/maths/soa_transform.h"
 
 #include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/profile.h"
 
 namespace ozz {
 namespace animation {
@@ -64,13 +65,68 @@ bool LocalToModelJob::Validate() const {
   valid &= input.size() >= num_soa_joints;
   valid &= output.size() >= num_joints;
 
+  // Tests optional joint mask size, 1 bit per soa joint block.
+  valid &= joint_mask.empty() || joint_mask.size() >= (num_soa_joints + 7) / 8;
+
   return valid;
 }
 
+namespace {
+
+// Full hierarchy specialization, used when no partial update range is
+// requested. This is by far the most common case, and dropping the per-joint
+// range checks keeps the loop free of branches (but the unpredictable-free
+// root selection one).
+void RunFullHierarchy(const LocalToModelJob& _job) {
+  const span<const int16_t>& parents = _job.skeleton->joint_parents();
+
+  // Initializes an identity matrix that will be used to compute roots model
+  // matrices without requiring a branch.
+  const math::Float4x4 identity = math::Float4x4::identity();
+  const math::Float4x4* root_matrix =
+      (_job.root == nullptr) ? &identity : _job.root;
+
+  const int num_joints = _job.skeleton->num_joints();
+  for (int i = 0; i < num_joints;) {
+    // Builds soa matrices from soa transforms.
+    const math::SoaTransform& transform = _job.input[i / 4];
+    const math::SoaFloat4x4 local_soa_matrices = math::SoaFloat4x4::FromAffine(
+        transform.translation, transform.rotation, transform.scale);
+
+    // Converts to aos matrices.
+    math::Float4x4 local_aos_matrices[4];
+    math::Transpose16x16(&local_soa_matrices.cols[0].x,
+                         local_aos_matrices->cols);
+
+    for (const int soa_end = math::Min(i + 4, num_joints); i < soa_end; ++i) {
+      const int parent = parents[i];
+      const math::Float4x4* parent_matrix =
+          parent == Skeleton::kNoParent ? root_matrix : &_job.output[parent];
+      _job.output[i] = *parent_matrix * local_aos_matrices[i & 3];
+    }
+  }
+}
+}  // namespace
+
 bool LocalToModelJob::Run() const {
   if (!Validate()) {
     return false;
   }
+  RunValidated();
+  return true;
+}
+
+void LocalToModelJob::RunValidated() const {
+  assert(Validate() && "Job is expected to be valid.");
+  OZZ_PROFILE_JOB("LocalToModelJob", skeleton->num_joints());
+
+  // Dispatches to the full hierarchy specialization when no partial update
+  // range nor joint mask is requested.
+  if (from == Skeleton::kNoParent && to >= skeleton->num_joints() - 1 &&
+      !from_excluded && joint_mask.empty()) {
+    RunFullHierarchy(*this);
+    return;
+  }
 
   const span<const int16_t>& parents = skeleton->joint_parents();
 
@@ -88,6 +144,16 @@ bool LocalToModelJob::Run() const {
   for (int i = math::Max(from + from_excluded, 0),
            process = i < end && (!from_excluded || parents[i] >= from);
        process;) {
+    // Skips soa blocks masked out, stepping the hierarchy walk joint by joint
+    // so the subtree test remains valid. Skipped joints' output is unchanged.
+    if (!joint_mask.empty() &&
+        !((joint_mask[i / 32] >> ((i / 4) & 7)) & 1)) {
+      for (const int soa_end = (i + 4) & ~3; i < soa_end && process;
+           ++i, process = i < end && parents[i] >= from) {
+      }
+      continue;
+    }
+
     // Builds soa matrices from soa transforms.
     const math::SoaTransform& transform = input[i / 4];
     const math::SoaFloat4x4 local_soa_matrices = math::SoaFloat4x4::FromAffine(
@@ -107,6 +173,162 @@ bool LocalToModelJob::Run() const {
       output[i] = *parent_matrix * local_aos_matrices[i & 3];
     }
   }
+}
+
+bool LocalToModelJob::RunDirty(span<const int16_t> _modified_joints) const {
+  if (!Validate()) {
+    return false;
+  }
+
+  const int num_joints = skeleton->num_joints();
+  const span<const int16_t>& parents = skeleton->joint_parents();
+
+  // Updates each modified subtree with a ranged job. Subtrees are disjoint
+  // once nested entries are skipped, so every joint is processed at most once.
+  int covered_end = 0;  // End (exclusive) of the last updated subtree.
+  for (size_t i = 0; i < _modified_joints.size(); ++i) {
+    const int joint = _modified_joints[i];
+    assert(joint >= 0 && joint < num_joints && "Joint index out of range.");
+    assert((i == 0 || _modified_joints[i - 1] <= joint) &&
+           "Joints must be sorted in ascending order.");
+
+    // Skips joints already covered by a previously updated subtree.
+    if (joint < covered_end) {
+      continue;
+    }
+
+    // Finds subtree end, aka the first joint whose parent is before joint.
+    int end = joint + 1;
+    for (; end < num_joints && parents[end] >= joint; ++end) {
+    }
+    covered_end = end;
+
+    // Runs a ranged update for this subtree. The job was already validated,
+    // and the range is valid by construction.
+    LocalToModelJob subtree_job = *this;
+    subtree_job.from = joint;
+    subtree_job.to = end - 1;
+    subtree_job.from_excluded = false;
+    subtree_job.Run();
+  }
+
+  return true;
+}
+
+bool LocalToModelBatchJob::Validate() const {
+  bool valid = true;
+
+  // Test for nullptr begin pointers.
+  if (!skeleton) {
+    return false;
+  }
+
+  // Every instance must define a complete conversion task.
+  if (inputs.size() != outputs.size()) {
+    return false;
+  }
+
+  const size_t num_joints = static_cast<size_t>(skeleton->num_joints());
+  const size_t num_soa_joints = (num_joints + 3) / 4;
+
+  // Test input and output ranges, like a single LocalToModelJob would.
+  for (size_t k = 0; k < inputs.size(); ++k) {
+    valid &= inputs[k].size() >= num_soa_joints;
+    valid &= outputs[k].size() >= num_joints;
+  }
+
+  return valid;
+}
+
+bool LocalToModelBatchJob::Run() const {
+  if (!Validate()) {
+    return false;
+  }
+
+  const span<const int16_t>& parents = skeleton->joint_parents();
+  const math::Float4x4 identity = math::Float4x4::identity();
+
+  // Walks the hierarchy once per soa joint block, processing all instances
+  // before moving to the next block. Parent indices and loop control are thus
+  // read once and reused for the whole batch.
+  const int num_joints = skeleton->num_joints();
+  const size_t num_instances = inputs.size();
+  for (int i = 0; i < num_joints;) {
+    const int soa_end = math::Min(i + 4, num_joints);
+    for (size_t k = 0; k < num_instances; ++k) {
+      // Builds soa matrices from soa transforms.
+      const math::SoaTransform& transform = inputs[k][i / 4];
+      const math::SoaFloat4x4 local_soa_matrices =
+          math::SoaFloat4x4::FromAffine(transform.translation,
+                                        transform.rotation, transform.scale);
+
+      // Converts to aos matrices.
+      math::Float4x4 local_aos_matrices[4];
+      math::Transpose16x16(&local_soa_matrices.cols[0].x,
+                           local_aos_matrices->cols);
+
+      const span<math::Float4x4>& output = outputs[k];
+      for (int j = i; j < soa_end; ++j) {
+        const int parent = parents[j];
+        const math::Float4x4* parent_matrix =
+            parent == Skeleton::kNoParent ? &identity : &output[parent];
+        output[j] = *parent_matrix * local_aos_matrices[j & 3];
+      }
+    }
+    i = soa_end;
+  }
+  return true;
+}
+
+bool LocalToModelGraftJob::Validate() const {
+  // The base task must form a valid LocalToModelJob.
+  LocalToModelJob base;
+  base.skeleton = skeleton;
+  base.input = input;
+  base.output = output;
+  if (!base.Validate()) {
+    return false;
+  }
+
+  bool valid = true;
+  for (const Graft& graft : grafts) {
+    // Attach joint must be a base skeleton joint, so its model-space matrix
+    // is available as the graft root.
+    valid &= graft.joint >= 0 && graft.joint < skeleton->num_joints();
+
+    // Each graft must form a valid LocalToModelJob too.
+    LocalToModelJob sub;
+    sub.skeleton = graft.skeleton;
+    sub.input = graft.input;
+    sub.output = graft.output;
+    valid &= sub.Validate();
+  }
+  return valid;
+}
+
+bool LocalToModelGraftJob::Run() const {
+  if (!Validate()) {
+    return false;
+  }
+
+  // Evaluates the base hierarchy first, making attach joints model-space
+  // matrices available.
+  LocalToModelJob base;
+  base.skeleton = skeleton;
+  base.input = input;
+  base.output = output;
+  base.RunValidated();
+
+  // Then each graft, rooted at its base joint matrix straight from the base
+  // output, with no intermediate copy nor re-derivation.
+  for (const Graft& graft : grafts) {
+    LocalToModelJob sub;
+    sub.skeleton = graft.skeleton;
+    sub.root = &output[graft.joint];
+    sub.input = graft.input;
+    sub.output = graft.output;
+    sub.RunValidated();
+  }
   return true;
 }
 }  // namespace animation
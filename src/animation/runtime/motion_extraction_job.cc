@@ -0,0 +1,126 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/motion_extraction_job.h"
+
+#include <cassert>
+
+#include "ozz/animation/runtime/track.h"
+#include "ozz/animation/runtime/track_sampling_job.h"
+#include "ozz/base/maths/math_ex.h"
+#include "ozz/base/maths/transform.h"
+
+namespace ozz {
+namespace animation {
+
+namespace {
+
+// Samples the motion position track at _ratio, or returns a null translation
+// if there's no track.
+math::Float3 SamplePosition(const Float3Track* _track, float _ratio) {
+  math::Float3 position = math::Float3::zero();
+  if (_track) {
+    Float3TrackSamplingJob job;
+    job.track = _track;
+    job.ratio = _ratio;
+    job.result = &position;
+    const bool success = job.Run();
+    assert(success);
+    (void)success;
+  }
+  return position;
+}
+
+// Samples the motion rotation track at _ratio, or returns an identity
+// rotation if there's no track.
+math::Quaternion SampleRotation(const QuaternionTrack* _track, float _ratio) {
+  math::Quaternion rotation = math::Quaternion::identity();
+  if (_track) {
+    QuaternionTrackSamplingJob job;
+    job.track = _track;
+    job.ratio = _ratio;
+    job.result = &rotation;
+    const bool success = job.Run();
+    assert(success);
+    (void)success;
+  }
+  return rotation;
+}
+}  // namespace
+
+MotionExtractionJob::MotionExtractionJob()
+    : from(0.f),
+      to(0.f),
+      position_track(nullptr),
+      rotation_track(nullptr),
+      delta(nullptr) {}
+
+bool MotionExtractionJob::Validate() const {
+  // Position and rotation tracks are optional, only the output is required.
+  return delta != nullptr;
+}
+
+bool MotionExtractionJob::Run() const {
+  if (!Validate()) {
+    return false;
+  }
+
+  const float clamped_from = math::Clamp(0.f, from, 1.f);
+  const float clamped_to = math::Clamp(0.f, to, 1.f);
+
+  const math::Float3 position_from =
+      SamplePosition(position_track, clamped_from);
+  const math::Quaternion rotation_from =
+      SampleRotation(rotation_track, clamped_from);
+  const math::Float3 position_to = SamplePosition(position_track, clamped_to);
+  const math::Quaternion rotation_to =
+      SampleRotation(rotation_track, clamped_to);
+
+  if (clamped_to >= clamped_from) {
+    // Single segment, the delta is the difference between the two samples.
+    delta->translation = position_to - position_from;
+    delta->rotation = Conjugate(rotation_from) * rotation_to;
+  } else {
+    // Looping, accumulates motion from "from" to the end of the track, then
+    // from the beginning of the track to "to".
+    const math::Float3 position_end = SamplePosition(position_track, 1.f);
+    const math::Quaternion rotation_end = SampleRotation(rotation_track, 1.f);
+    const math::Float3 position_begin = SamplePosition(position_track, 0.f);
+    const math::Quaternion rotation_begin =
+        SampleRotation(rotation_track, 0.f);
+
+    delta->translation =
+        (position_end - position_from) + (position_to - position_begin);
+    delta->rotation = Conjugate(rotation_from) * rotation_end *
+                      Conjugate(rotation_begin) * rotation_to;
+  }
+  delta->scale = math::Float3::one();
+
+  return true;
+}
+}  // namespace animation
+}  // namespace ozz
@@ -0,0 +1,81 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/multi_clip_context.h"
+
+#include <cassert>
+
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/base/maths/math_ex.h"
+
+namespace ozz {
+namespace animation {
+
+MultiClipContext::MultiClipContext(int _max_tracks, size_t _num_clips)
+    : max_tracks_(math::Max(0, _max_tracks)) {
+  assert(_num_clips > 0 && "At least 1 resident clip is required.");
+  residents_.reserve(_num_clips);
+  for (size_t i = 0; i < _num_clips; ++i) {
+    auto resident = make_unique<Resident>();
+    resident->context.Resize(max_tracks_);
+    residents_.push_back(std::move(resident));
+  }
+}
+
+SamplingJob::Context* MultiClipContext::Select(const Animation* _animation) {
+  assert(_animation != nullptr);
+
+  // Looks for the context resident for _animation, tracking the least
+  // recently selected one as recycling candidate along the way.
+  Resident* lru = residents_[0].get();
+  for (const unique_ptr<Resident>& resident : residents_) {
+    if (resident->animation == _animation) {
+      resident->tick = tick_++;
+      return &resident->context;
+    }
+    if (resident->tick < lru->tick) {
+      lru = resident.get();
+    }
+  }
+
+  // _animation isn't resident: recycles the least recently selected context.
+  // Invalidation makes the next sample pay a cold start, and dropping the
+  // residency makes sure the evicted clip can't match it anymore.
+  lru->context.Invalidate();
+  lru->animation = _animation;
+  lru->tick = tick_++;
+  return &lru->context;
+}
+
+void MultiClipContext::Invalidate() {
+  for (const unique_ptr<Resident>& resident : residents_) {
+    resident->context.Invalidate();
+    resident->animation = nullptr;
+  }
+}
+}  // namespace animation
+}  // namespace ozz
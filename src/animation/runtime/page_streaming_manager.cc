@@ -0,0 +1,109 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/page_streaming_manager.h"
+
+#include <cmath>
+
+#include "ozz/animation/runtime/paged_animation.h"
+#include "ozz/base/maths/math_ex.h"
+
+namespace ozz {
+namespace animation {
+
+PageStreamingManager::Backend::~Backend() {}
+
+PageStreamingManager::PageStreamingManager() {}
+
+PageStreamingManager::~PageStreamingManager() {}
+
+void PageStreamingManager::Clear() {
+  resident_.clear();
+  tick_ = 0;
+}
+
+void PageStreamingManager::Update(span<const Instance> _instances,
+                                  Backend* _backend) {
+  if (!_backend) {
+    return;
+  }
+  ++tick_;
+
+  for (size_t i = 0; i < _instances.size(); ++i) {
+    const Instance& instance = _instances[i];
+    const PagedAnimation* animation = instance.animation;
+    if (!animation || animation->num_pages() == 0) {
+      continue;
+    }
+    const size_t num_pages = animation->num_pages();
+
+    // Current page, plus every page the cursor reaches within the deadline at
+    // the instance playback speed. The window is expressed in pages to bound
+    // the walk, wrapping at clip boundaries as looping playback does.
+    const size_t current = animation->Remap(instance.ratio).page;
+    const float window_s = math::Max(0.f, deadline) * instance.speed;
+    const float page_duration = animation->page_duration();
+    size_t ahead = static_cast<size_t>(std::abs(window_s) / page_duration) + 1;
+    ahead = math::Min(ahead, num_pages - 1);
+    const bool forward = instance.speed >= 0.f;
+
+    for (size_t p = 0; p <= ahead; ++p) {
+      const size_t page =
+          forward ? (current + p) % num_pages
+                  : (current + num_pages - p % num_pages) % num_pages;
+      const Page key(animation, page);
+      const ozz::map<Page, uint64_t>::iterator it = resident_.find(key);
+      if (it == resident_.end()) {
+        _backend->Prefetch(*animation, page);
+        resident_[key] = tick_;
+      } else {
+        it->second = tick_;
+      }
+    }
+  }
+
+  // Evicts least recently needed pages, down to the budget. Pages touched by
+  // this very update are kept resident whatever the budget, evicting data
+  // that's about to be sampled would only trash the streaming.
+  while (resident_.size() > budget) {
+    ozz::map<Page, uint64_t>::iterator coldest = resident_.end();
+    for (ozz::map<Page, uint64_t>::iterator it = resident_.begin();
+         it != resident_.end(); ++it) {
+      if (it->second != tick_ &&
+          (coldest == resident_.end() || it->second < coldest->second)) {
+        coldest = it;
+      }
+    }
+    if (coldest == resident_.end()) {
+      break;
+    }
+    _backend->Evict(*coldest->first.first, coldest->first.second);
+    resident_.erase(coldest);
+  }
+}
+}  // namespace animation
+}  // namespace ozz
@@ -0,0 +1,143 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/paged_animation.h"
+
+#include <cassert>
+
+#include "ozz/base/io/archive.h"
+#include "ozz/base/maths/math_ex.h"
+
+namespace ozz {
+namespace animation {
+
+PagedAnimation::PagedAnimation()
+    : duration_(0.f), page_duration_(0.f), num_tracks_(0) {}
+
+PagedAnimation::PagedAnimation(PagedAnimation&& _other) {
+  *this = std::move(_other);
+}
+
+PagedAnimation& PagedAnimation::operator=(PagedAnimation&& _other) {
+  std::swap(duration_, _other.duration_);
+  std::swap(page_duration_, _other.page_duration_);
+  std::swap(num_tracks_, _other.num_tracks_);
+  std::swap(pages_, _other.pages_);
+  return *this;
+}
+
+PagedAnimation::~PagedAnimation() {}
+
+PagedAnimation::PagedRatio PagedAnimation::Remap(float _ratio) const {
+  if (pages_.empty()) {
+    return {0, 0.f};
+  }
+
+  // Finds the page containing the requested clip time, a directory lookup
+  // thanks to the fixed page duration.
+  const float time = math::Clamp(0.f, _ratio, 1.f) * duration_;
+  const size_t max_page = pages_.size() - 1;
+  const size_t page =
+      math::Min(static_cast<size_t>(time / page_duration_), max_page);
+
+  // Remaps clip time to a ratio local to the page, whose duration can differ
+  // from page_duration_ for the last page.
+  const float local_time = time - page * page_duration_;
+  const float local_duration = pages_[page].duration();
+  const float ratio =
+      local_duration > 0.f ? math::Clamp(0.f, local_time / local_duration, 1.f)
+                           : 0.f;
+  return {page, ratio};
+}
+
+void PagedAnimation::Save(ozz::io::OArchive& _archive) const {
+  _archive << duration_;
+  _archive << page_duration_;
+  _archive << static_cast<int32_t>(num_tracks_);
+  _archive << static_cast<uint32_t>(pages_.size());
+  for (const Animation& page : pages_) {
+    _archive << page;
+  }
+}
+
+void PagedAnimation::Load(ozz::io::IArchive& _archive, uint32_t _version) {
+  // Resets animation in case it was already used before.
+  duration_ = 0.f;
+  page_duration_ = 0.f;
+  num_tracks_ = 0;
+  pages_.clear();
+
+  if (_version != 1) {
+    return;
+  }
+
+  _archive >> duration_;
+  _archive >> page_duration_;
+  int32_t num_tracks;
+  _archive >> num_tracks;
+  num_tracks_ = num_tracks;
+
+  // Reads the page directory, then every page as a regular animation.
+  uint32_t num_pages;
+  _archive >> num_pages;
+  pages_.resize(num_pages);
+  for (uint32_t i = 0; i < num_pages; ++i) {
+    _archive >> pages_[i];
+  }
+}
+
+namespace {
+// Forwards a paged job to a SamplingJob on the page containing its ratio.
+// Returns false if the paged animation isn't usable.
+bool SetupPageJob(const PagedSamplingJob& _paged, SamplingJob* _job) {
+  if (_paged.animation == nullptr || _paged.animation->num_pages() == 0) {
+    return false;
+  }
+  const PagedAnimation::PagedRatio remapped =
+      _paged.animation->Remap(_paged.ratio);
+  _job->ratio = remapped.ratio;
+  _job->animation = &_paged.animation->page(remapped.page);
+  _job->context = _paged.context;
+  _job->output = _paged.output;
+  return true;
+}
+}  // namespace
+
+PagedSamplingJob::PagedSamplingJob()
+    : ratio(0.f), animation(nullptr), context(nullptr) {}
+
+bool PagedSamplingJob::Validate() const {
+  SamplingJob job;
+  return SetupPageJob(*this, &job) && job.Validate();
+}
+
+bool PagedSamplingJob::Run() const {
+  SamplingJob job;
+  return SetupPageJob(*this, &job) && job.Run();
+}
+}  // namespace animation
+}  // namespace ozz
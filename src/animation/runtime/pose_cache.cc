@@ -0,0 +1,134 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/pose_cache.h"
+
+#include <cassert>
+#include <cstring>
+
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/base/maths/math_ex.h"
+
+namespace ozz {
+namespace animation {
+
+namespace {
+// Hashes a cached pose key to its table slot. Animation addresses are at
+// least 16 bytes aligned, low bits are shifted out before mixing.
+size_t HashPoseKey(const Animation* _animation, int _bucket, int _lod,
+                   size_t _mask) {
+  const size_t address = reinterpret_cast<size_t>(_animation) >> 4;
+  const size_t hash =
+      address * 2654435761u ^ static_cast<size_t>(_bucket) * 97u ^
+      static_cast<size_t>(_lod) * 193u;
+  return hash & _mask;
+}
+}  // namespace
+
+PoseCache::PoseCache()
+    : intervals_(256), max_soa_tracks_(0), hits_(0), misses_(0) {}
+
+PoseCache::PoseCache(int _max_tracks, int _max_entries) : PoseCache() {
+  Resize(_max_tracks, _max_entries);
+}
+
+void PoseCache::Resize(int _max_tracks, int _max_entries) {
+  assert(_max_tracks >= 0 && _max_entries >= 0);
+
+  // Aligns tracks to soa blocks and rounds capacity up to a power of two, so
+  // hashes are mapped to slots with a mask.
+  max_soa_tracks_ = (_max_tracks + 3) / 4;
+  int entries = 1;
+  for (; entries < _max_entries; entries *= 2) {
+  }
+  entries_.resize(_max_entries > 0 ? entries : 0);
+  poses_.resize(entries_.size() * max_soa_tracks_);
+  context_.Resize(_max_tracks);
+
+  Invalidate();
+}
+
+void PoseCache::Invalidate() {
+  for (Entry& entry : entries_) {
+    entry = {nullptr, 0, 0};
+  }
+  context_.Invalidate();
+}
+
+bool PoseCache::Sample(const Animation& _animation, float _ratio,
+                       const span<math::SoaTransform>& _output,
+                       const span<const byte>& _joint_mask, int _lod) {
+  const int num_soa_tracks = _animation.num_soa_tracks();
+  if (entries_.empty() || num_soa_tracks > max_soa_tracks_ ||
+      static_cast<int>(_output.size()) < num_soa_tracks) {
+    return false;
+  }
+
+  // Quantizes the requested ratio to the nearest interval boundary, so
+  // instances less than half an interval apart share the same pose.
+  const float clamped = math::Clamp(0.f, _ratio, 1.f);
+  const int bucket = static_cast<int>(clamped * intervals_ + .5f);
+
+  const size_t slot =
+      HashPoseKey(&_animation, bucket, _lod, entries_.size() - 1);
+  Entry& entry = entries_[slot];
+  math::SoaTransform* pose = poses_.data() + slot * max_soa_tracks_;
+
+  if (entry.animation != &_animation || entry.bucket != bucket ||
+      entry.lod != _lod) {
+    // Misses sample the quantized ratio with the internal context, then
+    // cache the pose. Colliding keys simply overwrite the slot.
+    SamplingJob job;
+    job.animation = &_animation;
+    job.ratio = static_cast<float>(bucket) / intervals_;
+    job.context = &context_;
+    job.output = {pose, static_cast<size_t>(num_soa_tracks)};
+    job.joint_mask = _joint_mask;
+    if (!job.Run()) {
+      return false;
+    }
+    entry = {&_animation, bucket, _lod};
+    ++misses_;
+  } else {
+    ++hits_;
+  }
+
+  std::memcpy(_output.data(), pose,
+              sizeof(math::SoaTransform) * num_soa_tracks);
+  return true;
+}
+
+void PoseCache::set_intervals(int _intervals) {
+  assert(_intervals > 0);
+  if (_intervals != intervals_) {
+    intervals_ = _intervals;
+    // Cached buckets are relative to the previous quantization.
+    Invalidate();
+  }
+}
+}  // namespace animation
+}  // namespace ozz
@@ -0,0 +1,452 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/pose_codec.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/animation/runtime/skeleton_utils.h"
+#include "ozz/base/maths/math_constant.h"
+#include "ozz/base/maths/math_ex.h"
+#include "ozz/base/maths/quaternion.h"
+#include "ozz/base/maths/simd_math.h"
+#include "ozz/base/maths/soa_transform.h"
+
+namespace ozz {
+namespace animation {
+
+namespace {
+
+// Bit budgets are per component, stored in [1, 23] bits fields.
+enum { kMinBits = 1, kMaxBits = 23 };
+
+// Writes lsb-first bit fields to a byte buffer. The buffer must be zeroed
+// beforehand, so the layout (hence padding bits) is deterministic.
+class BitWriter {
+ public:
+  explicit BitWriter(const span<byte>& _buffer) : buffer_(_buffer), bit_(0) {}
+
+  void Write(uint32_t _value, int _bits) {
+    assert(_bits >= kMinBits && _bits <= kMaxBits && _value < (1u << _bits));
+    assert(bit_ + _bits <= buffer_.size() * 8);
+    for (int written = 0; written < _bits;) {
+      const size_t byte_i = (bit_ + written) >> 3;
+      const int offset = (bit_ + written) & 7;
+      const int count = math::Min(8 - offset, _bits - written);
+      buffer_[byte_i] = static_cast<byte>(buffer_[byte_i] |
+                                          ((_value >> written) << offset));
+      written += count;
+    }
+    bit_ += _bits;
+  }
+
+ private:
+  span<byte> buffer_;
+  size_t bit_;
+};
+
+// Reads back bit fields written by BitWriter.
+class BitReader {
+ public:
+  explicit BitReader(const span<const byte>& _buffer)
+      : buffer_(_buffer), bit_(0) {}
+
+  uint32_t Read(int _bits) {
+    assert(_bits >= kMinBits && _bits <= kMaxBits);
+    assert(bit_ + _bits <= buffer_.size() * 8);
+    uint32_t value = 0;
+    for (int read = 0; read < _bits;) {
+      const size_t byte_i = (bit_ + read) >> 3;
+      const int offset = (bit_ + read) & 7;
+      const int count = math::Min(8 - offset, _bits - read);
+      value |= (static_cast<uint32_t>(buffer_[byte_i]) >> offset) << read;
+      read += count;
+    }
+    bit_ += _bits;
+    return value & ((1u << _bits) - 1);
+  }
+
+ private:
+  span<const byte> buffer_;
+  size_t bit_;
+};
+
+// Bit cost of a joint encoded with _quant settings: 3 translation and scale
+// delta components, 2 bits for the largest rotation component index plus the
+// 3 smallest components.
+size_t JointBitSize(const PoseCodec::Quantization& _quant) {
+  return 3 * _quant.translation_bits + 2 + 3 * _quant.rotation_bits +
+         3 * _quant.scale_bits;
+}
+
+// Quantizes the 3 first components of _v - _rest to _bits integers over the
+// [-_range, _range] delta range, and writes them to _writer.
+void WriteDelta3(BitWriter& _writer, math::_SimdFloat4 _v, const float* _rest,
+                 int _bits, float _range) {
+  const math::SimdFloat4 rest = math::simd_float4::Load3PtrU(_rest);
+  const math::SimdFloat4 range = math::simd_float4::Load1(_range);
+  const math::SimdFloat4 scale =
+      math::simd_float4::Load1(((1u << _bits) - 1) / (2.f * _range));
+  const math::SimdInt4 quantized = math::simd_int4::FromFloatRound(
+      (math::Clamp(-range, _v - rest, range) + range) * scale);
+  int q[4];
+  math::StorePtrU(quantized, q);
+  _writer.Write(static_cast<uint32_t>(q[0]), _bits);
+  _writer.Write(static_cast<uint32_t>(q[1]), _bits);
+  _writer.Write(static_cast<uint32_t>(q[2]), _bits);
+}
+
+// Reads back and dequantizes 3 delta components, returning _rest + delta in
+// the 3 first vector components (4th is 0).
+math::SimdFloat4 ReadDelta3(BitReader& _reader, const float* _rest, int _bits,
+                            float _range) {
+  const int q[4] = {static_cast<int>(_reader.Read(_bits)),
+                    static_cast<int>(_reader.Read(_bits)),
+                    static_cast<int>(_reader.Read(_bits)), 0};
+  const math::SimdFloat4 inv_scale =
+      math::simd_float4::Load1(2.f * _range / ((1u << _bits) - 1));
+  const math::SimdFloat4 range = math::simd_float4::Load1(_range);
+  const math::SimdFloat4 rest = math::simd_float4::Load3PtrU(_rest);
+  return math::simd_float4::FromInt(math::simd_int4::LoadPtrU(q)) * inv_scale -
+         range + rest;
+}
+
+// Maps the largest rotation component index to the 3 remaining ones.
+const int kQuatMapping[4][3] = {{1, 2, 3}, {0, 2, 3}, {0, 1, 3}, {0, 1, 2}};
+
+// Quantizes the rotation delta from the rest pose with the smallest-three
+// scheme used by animation compression: 2 bits select the largest component,
+// the 3 others are quantized to _bits integers over [-sqrt(2)/2, sqrt(2)/2].
+// The quaternion is negated when needed so the largest component is positive,
+// its sign doesn't have to be stored.
+void WriteRotation(BitWriter& _writer, const math::Quaternion& _q,
+                   const math::Quaternion& _rest, int _bits) {
+  const math::Quaternion delta = _q * Conjugate(_rest);
+  const float quat[4] = {delta.x, delta.y, delta.z, delta.w};
+
+  // Finds the largest component.
+  int largest = 0;
+  for (int i = 1; i < 4; ++i) {
+    if (std::abs(quat[i]) > std::abs(quat[largest])) {
+      largest = i;
+    }
+  }
+  const float sign = quat[largest] < 0.f ? -1.f : 1.f;
+
+  const float scale = ((1u << _bits) - 1) / (2.f * math::kSqrt2_2);
+  _writer.Write(static_cast<uint32_t>(largest), 2);
+  for (int i = 0; i < 3; ++i) {
+    const float component = quat[kQuatMapping[largest][i]] * sign;
+    const float clamped =
+        math::Clamp(-math::kSqrt2_2, component, math::kSqrt2_2);
+    const uint32_t quantized = static_cast<uint32_t>(
+        std::floor((clamped + math::kSqrt2_2) * scale + .5f));
+    _writer.Write(quantized, _bits);
+  }
+}
+
+// Reads back a rotation delta and recombines it with the rest pose rotation.
+// The largest component is restored from the quaternion normalization
+// property.
+math::Quaternion ReadRotation(BitReader& _reader, const math::Quaternion& _rest,
+                              int _bits) {
+  const int largest = static_cast<int>(_reader.Read(2));
+  const float inv_scale = 2.f * math::kSqrt2_2 / ((1u << _bits) - 1);
+  float quat[4];
+  float dot = 0.f;
+  for (int i = 0; i < 3; ++i) {
+    const float component = _reader.Read(_bits) * inv_scale - math::kSqrt2_2;
+    quat[kQuatMapping[largest][i]] = component;
+    dot += component * component;
+  }
+  quat[largest] = std::sqrt(math::Max(0.f, 1.f - dot));
+  const math::Quaternion delta(quat[0], quat[1], quat[2], quat[3]);
+  // Quantization slightly denormalizes the delta, renormalizes the output so
+  // downstream jobs get a valid rotation.
+  return Normalize(delta * _rest);
+}
+}  // namespace
+
+PoseCodec::PoseCodec() : skeleton_(nullptr), encoded_size_(0) {}
+
+bool PoseCodec::Initialize(const Skeleton* _skeleton) {
+  if (!_skeleton) {
+    return false;
+  }
+  const Quantization default_class;
+  const ozz::vector<uint8_t> joint_classes(_skeleton->num_joints(), 0);
+  return Initialize(_skeleton, {&default_class, 1}, make_span(joint_classes));
+}
+
+bool PoseCodec::Initialize(const Skeleton* _skeleton,
+                           const span<const Quantization>& _classes,
+                           const span<const uint8_t>& _joint_classes) {
+  // Resets the codec, so a failed setup doesn't leave a stale one.
+  skeleton_ = nullptr;
+  classes_.clear();
+  joint_classes_.clear();
+  rest_pose_.clear();
+  encoded_size_ = 0;
+
+  if (!_skeleton || _classes.empty() || _classes.size() > 256 ||
+      _joint_classes.size() !=
+          static_cast<size_t>(_skeleton->num_joints())) {
+    return false;
+  }
+  for (const Quantization& quant : _classes) {
+    if (quant.translation_bits < kMinBits ||
+        quant.translation_bits > kMaxBits || quant.rotation_bits < kMinBits ||
+        quant.rotation_bits > kMaxBits || quant.scale_bits < kMinBits ||
+        quant.scale_bits > kMaxBits || quant.translation_range <= 0.f ||
+        quant.scale_range <= 0.f) {
+      return false;
+    }
+  }
+  for (const uint8_t joint_class : _joint_classes) {
+    if (joint_class >= _classes.size()) {
+      return false;
+    }
+  }
+
+  skeleton_ = _skeleton;
+  classes_.assign(_classes.begin(), _classes.end());
+  joint_classes_.assign(_joint_classes.begin(), _joint_classes.end());
+
+  // Caches the AoS rest pose, the prediction used by both sides of the codec.
+  const int num_joints = _skeleton->num_joints();
+  rest_pose_.reserve(num_joints);
+  size_t bit_size = 0;
+  for (int i = 0; i < num_joints; ++i) {
+    rest_pose_.push_back(GetJointLocalRestPose(*_skeleton, i));
+    bit_size += JointBitSize(classes_[joint_classes_[i]]);
+  }
+  encoded_size_ = (bit_size + 7) / 8;
+  return true;
+}
+
+bool PoseCodec::Encode(const span<const math::SoaTransform>& _pose,
+                       const span<byte>& _encoded) const {
+  if (!skeleton_ ||
+      _pose.size() < static_cast<size_t>(skeleton_->num_soa_joints()) ||
+      _encoded.size() < encoded_size_) {
+    return false;
+  }
+
+  // BitWriter or-s bit fields in, padding bits must be deterministic.
+  std::memset(_encoded.data(), 0, encoded_size_);
+  BitWriter writer({_encoded.data(), encoded_size_});
+
+  const int num_joints = skeleton_->num_joints();
+  for (int i = 0; i < skeleton_->num_soa_joints(); ++i) {
+    // Transposes the soa block to per-joint vectors.
+    math::SimdFloat4 translations[4];
+    math::SimdFloat4 rotations[4];
+    math::SimdFloat4 scales[4];
+    math::Transpose3x4(&_pose[i].translation.x, translations);
+    math::Transpose4x4(&_pose[i].rotation.x, rotations);
+    math::Transpose3x4(&_pose[i].scale.x, scales);
+
+    for (int j = 0; j < 4 && i * 4 + j < num_joints; ++j) {
+      const int joint = i * 4 + j;
+      const Quantization& quant = classes_[joint_classes_[joint]];
+      const math::Transform& rest = rest_pose_[joint];
+
+      WriteDelta3(writer, translations[j], &rest.translation.x,
+                  quant.translation_bits, quant.translation_range);
+
+      float rotation[4];
+      math::StorePtrU(rotations[j], rotation);
+      WriteRotation(
+          writer,
+          math::Quaternion(rotation[0], rotation[1], rotation[2], rotation[3]),
+          rest.rotation, quant.rotation_bits);
+
+      WriteDelta3(writer, scales[j], &rest.scale.x, quant.scale_bits,
+                  quant.scale_range);
+    }
+  }
+  return true;
+}
+
+bool PoseCodec::Decode(const span<const byte>& _encoded,
+                       const span<math::SoaTransform>& _pose) const {
+  if (!skeleton_ ||
+      _pose.size() < static_cast<size_t>(skeleton_->num_soa_joints()) ||
+      _encoded.size() < encoded_size_) {
+    return false;
+  }
+
+  BitReader reader({_encoded.data(), encoded_size_});
+
+  const int num_joints = skeleton_->num_joints();
+  for (int i = 0; i < skeleton_->num_soa_joints(); ++i) {
+    math::SimdFloat4 translations[4];
+    math::SimdFloat4 rotations[4];
+    math::SimdFloat4 scales[4];
+
+    for (int j = 0; j < 4; ++j) {
+      const int joint = i * 4 + j;
+      if (joint < num_joints) {
+        const Quantization& quant = classes_[joint_classes_[joint]];
+        const math::Transform& rest = rest_pose_[joint];
+
+        translations[j] =
+            ReadDelta3(reader, &rest.translation.x, quant.translation_bits,
+                       quant.translation_range);
+
+        const math::Quaternion rotation =
+            ReadRotation(reader, rest.rotation, quant.rotation_bits);
+        rotations[j] = math::simd_float4::LoadPtrU(&rotation.x);
+
+        scales[j] = ReadDelta3(reader, &rest.scale.x, quant.scale_bits,
+                               quant.scale_range);
+      } else {
+        // Last block padding joints decode to identity, like the skeleton
+        // builder fills them.
+        translations[j] = math::simd_float4::zero();
+        rotations[j] = math::simd_float4::w_axis();
+        scales[j] = math::simd_float4::one();
+      }
+    }
+
+    // Transposes per-joint vectors back to the soa block.
+    math::Transpose4x3(translations, &_pose[i].translation.x);
+    math::Transpose4x4(rotations, &_pose[i].rotation.x);
+    math::Transpose4x3(scales, &_pose[i].scale.x);
+  }
+  return true;
+}
+
+namespace {
+// A SoaTransform is processed as 16 bytes simd blocks.
+enum { kBlocksPerSoa = sizeof(math::SoaTransform) / sizeof(math::SimdFloat4) };
+
+// Number of occupancy mask bytes for _blocks blocks, 1 bit per block.
+size_t MaskSize(size_t _blocks) { return (_blocks + 7) / 8; }
+}  // namespace
+
+PoseSnapshotCodec::PoseSnapshotCodec()
+    : skeleton_(nullptr), max_encoded_size_(0) {}
+
+bool PoseSnapshotCodec::Initialize(const Skeleton* _skeleton) {
+  skeleton_ = nullptr;
+  max_encoded_size_ = 0;
+  if (_skeleton == nullptr) {
+    return false;
+  }
+  skeleton_ = _skeleton;
+  const size_t blocks = _skeleton->joint_rest_poses().size() * kBlocksPerSoa;
+  max_encoded_size_ = MaskSize(blocks) + blocks * sizeof(math::SimdFloat4);
+  return true;
+}
+
+size_t PoseSnapshotCodec::Encode(const span<const math::SoaTransform>& _pose,
+                                 const span<byte>& _encoded) const {
+  if (skeleton_ == nullptr) {
+    return 0;
+  }
+  const span<const math::SoaTransform> rest = skeleton_->joint_rest_poses();
+  const size_t blocks = rest.size() * kBlocksPerSoa;
+  const size_t masks_size = MaskSize(blocks);
+  if (_pose.size() < rest.size() || _encoded.size() < masks_size) {
+    return 0;
+  }
+
+  // Masks come first, elided zero blocks make the block stream that follows
+  // shorter than the pose.
+  byte* const masks = _encoded.data();
+  std::memset(masks, 0, masks_size);
+  byte* cursor = masks + masks_size;
+  const byte* const end = _encoded.data() + _encoded.size();
+
+  // Pose and rest pose blocks are simd aligned, the encoded stream isn't.
+  const int* pose_blocks = reinterpret_cast<const int*>(_pose.data());
+  const int* rest_blocks = reinterpret_cast<const int*>(rest.data());
+  const math::SimdInt4 zero = math::simd_int4::zero();
+  for (size_t i = 0; i < blocks; ++i) {
+    const math::SimdInt4 delta =
+        math::Xor(math::simd_int4::LoadPtr(pose_blocks + i * 4),
+                  math::simd_int4::LoadPtr(rest_blocks + i * 4));
+    if (math::AreAllTrue(math::CmpEq(delta, zero))) {
+      // Block is at rest, elided from the stream.
+      continue;
+    }
+    if (cursor + sizeof(math::SimdFloat4) > end) {
+      return 0;
+    }
+    masks[i / 8] = static_cast<byte>(masks[i / 8] | (1 << (i & 7)));
+    alignas(16) int delta_aos[4];
+    math::StorePtr(delta, delta_aos);
+    std::memcpy(cursor, delta_aos, sizeof(delta_aos));
+    cursor += sizeof(delta_aos);
+  }
+  return static_cast<size_t>(cursor - _encoded.data());
+}
+
+bool PoseSnapshotCodec::Decode(const span<const byte>& _encoded,
+                               const span<math::SoaTransform>& _pose) const {
+  if (skeleton_ == nullptr) {
+    return false;
+  }
+  const span<const math::SoaTransform> rest = skeleton_->joint_rest_poses();
+  const size_t blocks = rest.size() * kBlocksPerSoa;
+  const size_t masks_size = MaskSize(blocks);
+  if (_pose.size() < rest.size() || _encoded.size() < masks_size) {
+    return false;
+  }
+
+  const byte* const masks = _encoded.data();
+  const byte* cursor = masks + masks_size;
+  const byte* const end = _encoded.data() + _encoded.size();
+
+  int* pose_blocks = reinterpret_cast<int*>(_pose.data());
+  const int* rest_blocks = reinterpret_cast<const int*>(rest.data());
+  for (size_t i = 0; i < blocks; ++i) {
+    const math::SimdInt4 rest_block = math::simd_int4::LoadPtr(rest_blocks + i * 4);
+    if ((masks[i / 8] >> (i & 7)) & 1) {
+      if (cursor + sizeof(math::SimdFloat4) > end) {
+        return false;
+      }
+      alignas(16) int delta_aos[4];
+      std::memcpy(delta_aos, cursor, sizeof(delta_aos));
+      cursor += sizeof(delta_aos);
+      math::StorePtr(math::Xor(math::simd_int4::LoadPtr(delta_aos), rest_block),
+                     pose_blocks + i * 4);
+    } else {
+      // Elided block decodes back to the rest pose.
+      math::StorePtr(rest_block, pose_blocks + i * 4);
+    }
+  }
+  // The whole stream must have been consumed, a trailing remain betrays an
+  // encoded pose that doesn't match this codec setup.
+  return cursor == end;
+}
+}  // namespace animation
+}  // namespace ozz
@@ -0,0 +1,146 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/pose_database.h"
+
+#include <limits>
+#include <utility>
+
+#include "ozz/base/io/archive.h"
+
+namespace ozz {
+namespace animation {
+
+namespace {
+// Recursively queries the implicit kd-tree stored in _db features, over entry
+// range [_begin, _end). The node of a range is its median, the split
+// dimension cycles with depth. The far side of the split is only visited if
+// the splitting plane is closer than the best match found so far.
+void KdNearest(const PoseDatabase& _db, const float* _features,
+               const float* _query, int _begin, int _end, int _depth,
+               PoseDatabase::Match* _best) {
+  if (_begin >= _end) {
+    return;
+  }
+  const int num_features = _db.num_features();
+  const int median = _begin + (_end - _begin) / 2;
+  const float* entry = _features + median * num_features;
+
+  // Updates best match with the node entry.
+  float distance_sq = 0.f;
+  for (int i = 0; i < num_features; ++i) {
+    const float delta = _query[i] - entry[i];
+    distance_sq += delta * delta;
+  }
+  if (distance_sq < _best->distance_sq) {
+    _best->animation = median;  // Stores the entry index, remapped by caller.
+    _best->distance_sq = distance_sq;
+  }
+
+  // Recurses the near side first, then the far side only if the splitting
+  // plane could hide a closer entry.
+  const int dim = _depth % num_features;
+  const float split_delta = _query[dim] - entry[dim];
+  const int near_begin = split_delta < 0.f ? _begin : median + 1;
+  const int near_end = split_delta < 0.f ? median : _end;
+  KdNearest(_db, _features, _query, near_begin, near_end, _depth + 1, _best);
+  if (split_delta * split_delta < _best->distance_sq) {
+    const int far_begin = split_delta < 0.f ? median + 1 : _begin;
+    const int far_end = split_delta < 0.f ? _end : median;
+    KdNearest(_db, _features, _query, far_begin, far_end, _depth + 1, _best);
+  }
+}
+}  // namespace
+
+PoseDatabase::PoseDatabase() : num_features_(0) {}
+
+PoseDatabase::PoseDatabase(PoseDatabase&& _other) : PoseDatabase() {
+  *this = std::move(_other);
+}
+
+PoseDatabase& PoseDatabase::operator=(PoseDatabase&& _other) {
+  std::swap(num_features_, _other.num_features_);
+  std::swap(features_, _other.features_);
+  std::swap(animations_, _other.animations_);
+  std::swap(ratios_, _other.ratios_);
+  return *this;
+}
+
+PoseDatabase::~PoseDatabase() {}
+
+bool PoseDatabase::Nearest(const span<const float>& _query,
+                           Match* _match) const {
+  const int entries = num_entries();
+  if (entries == 0 || static_cast<int>(_query.size()) != num_features_) {
+    return false;
+  }
+
+  Match best = {-1, 0.f, std::numeric_limits<float>::max()};
+  KdNearest(*this, features_.data(), _query.data(), 0, entries, 0, &best);
+
+  // Remaps the matched entry index to its animation and ratio.
+  const int entry = best.animation;
+  _match->animation = animations_[entry];
+  _match->ratio = ratios_[entry];
+  _match->distance_sq = best.distance_sq;
+  return true;
+}
+
+void PoseDatabase::Save(ozz::io::OArchive& _archive) const {
+  _archive << static_cast<int32_t>(num_features_);
+  _archive << static_cast<uint32_t>(animations_.size());
+  _archive << ozz::io::MakeArray(features_.data(), features_.size());
+  _archive << ozz::io::MakeArray(animations_.data(), animations_.size());
+  _archive << ozz::io::MakeArray(ratios_.data(), ratios_.size());
+}
+
+void PoseDatabase::Load(ozz::io::IArchive& _archive, uint32_t _version) {
+  // Resets database in case it was already used before.
+  num_features_ = 0;
+  features_.clear();
+  animations_.clear();
+  ratios_.clear();
+
+  if (_version != 1) {
+    return;
+  }
+
+  int32_t num_features;
+  _archive >> num_features;
+  num_features_ = num_features;
+  uint32_t entries;
+  _archive >> entries;
+
+  features_.resize(entries * num_features_);
+  animations_.resize(entries);
+  ratios_.resize(entries);
+  _archive >> ozz::io::MakeArray(features_.data(), features_.size());
+  _archive >> ozz::io::MakeArray(animations_.data(), animations_.size());
+  _archive >> ozz::io::MakeArray(ratios_.data(), ratios_.size());
+}
+}  // namespace animation
+}  // namespace ozz
@@ -0,0 +1,78 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/pose_lerp_job.h"
+
+#include "ozz/base/maths/math_ex.h"
+#include "ozz/base/maths/soa_transform.h"
+
+namespace ozz {
+namespace animation {
+
+PoseLerpJob::PoseLerpJob() : alpha(0.f) {}
+
+bool PoseLerpJob::Validate() const {
+  bool valid = true;
+  valid &= !from.empty();
+  valid &= from.size() == to.size();
+  valid &= output.size() >= from.size();
+  return valid;
+}
+
+bool PoseLerpJob::Run() const {
+  // Exit with an error if job is invalid.
+  if (!Validate()) {
+    return false;
+  }
+
+  const math::SimdFloat4 simd_alpha =
+      math::simd_float4::Load1(math::Clamp(0.f, alpha, 1.f));
+
+  for (size_t i = 0; i < from.size(); ++i) {
+    const math::SoaTransform& from_transform = from[i];
+    const math::SoaTransform& to_transform = to[i];
+    math::SoaTransform& dest = output[i];
+
+    dest.translation =
+        Lerp(from_transform.translation, to_transform.translation, simd_alpha);
+    dest.scale = Lerp(from_transform.scale, to_transform.scale, simd_alpha);
+
+    // Interpolates rotations along the shortest path, flipping "to" sign when
+    // quaternions are on opposite hemispheres.
+    const math::SimdInt4 sign =
+        math::Sign(Dot(from_transform.rotation, to_transform.rotation));
+    const math::SoaQuaternion to_rotation = {
+        math::Xor(to_transform.rotation.x, sign),
+        math::Xor(to_transform.rotation.y, sign),
+        math::Xor(to_transform.rotation.z, sign),
+        math::Xor(to_transform.rotation.w, sign)};
+    dest.rotation = NLerpEst(from_transform.rotation, to_rotation, simd_alpha);
+  }
+  return true;
+}
+}  // namespace animation
+}  // namespace ozz
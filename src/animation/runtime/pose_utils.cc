@@ -0,0 +1,157 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/pose_utils.h"
+
+#include <cassert>
+
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/maths/soa_transform.h"
+
+namespace ozz {
+namespace animation {
+
+void FillIdentityPose(const span<math::SoaTransform>& _pose) {
+  const math::SoaTransform identity = math::SoaTransform::identity();
+  for (size_t i = 0; i < _pose.size(); ++i) {
+    _pose[i] = identity;
+  }
+}
+
+void FillRestPose(const Skeleton& _skeleton,
+                  const span<math::SoaTransform>& _pose) {
+  const span<const math::SoaTransform> rest_poses =
+      _skeleton.joint_rest_poses();
+  assert(_pose.size() >= rest_poses.size() && "Pose is too small.");
+  for (size_t i = 0; i < rest_poses.size(); ++i) {
+    _pose[i] = rest_poses[i];
+  }
+}
+
+void FillRestPose(const Skeleton& _skeleton,
+                  const span<const math::SimdInt4>& _mask,
+                  const span<math::SoaTransform>& _pose) {
+  const span<const math::SoaTransform> rest_poses =
+      _skeleton.joint_rest_poses();
+  assert(_pose.size() >= rest_poses.size() &&
+         _mask.size() >= rest_poses.size() && "Pose or mask is too small.");
+  for (size_t i = 0; i < rest_poses.size(); ++i) {
+    const math::SimdInt4 mask = _mask[i];
+    const math::SoaTransform& rest = rest_poses[i];
+    math::SoaTransform& dest = _pose[i];
+    dest.translation.x = math::Select(mask, rest.translation.x,
+                                      dest.translation.x);
+    dest.translation.y = math::Select(mask, rest.translation.y,
+                                      dest.translation.y);
+    dest.translation.z = math::Select(mask, rest.translation.z,
+                                      dest.translation.z);
+    dest.rotation.x = math::Select(mask, rest.rotation.x, dest.rotation.x);
+    dest.rotation.y = math::Select(mask, rest.rotation.y, dest.rotation.y);
+    dest.rotation.z = math::Select(mask, rest.rotation.z, dest.rotation.z);
+    dest.rotation.w = math::Select(mask, rest.rotation.w, dest.rotation.w);
+    dest.scale.x = math::Select(mask, rest.scale.x, dest.scale.x);
+    dest.scale.y = math::Select(mask, rest.scale.y, dest.scale.y);
+    dest.scale.z = math::Select(mask, rest.scale.z, dest.scale.z);
+  }
+}
+
+void CopyPose(const span<const math::SoaTransform>& _from, int _components,
+              const span<math::SoaTransform>& _to) {
+  assert(_to.size() >= _from.size() && "Destination pose is too small.");
+  if ((_components & kAllPoseComponents) == kAllPoseComponents) {
+    for (size_t i = 0; i < _from.size(); ++i) {
+      _to[i] = _from[i];
+    }
+    return;
+  }
+  for (size_t i = 0; i < _from.size(); ++i) {
+    if (_components & kPoseTranslation) {
+      _to[i].translation = _from[i].translation;
+    }
+    if (_components & kPoseRotation) {
+      _to[i].rotation = _from[i].rotation;
+    }
+    if (_components & kPoseScale) {
+      _to[i].scale = _from[i].scale;
+    }
+  }
+}
+
+namespace {
+
+// Packs two vectors of 4 half floats (as output by math::FloatToHalf, in the
+// lower 16 bits of each lane) into a single store of 8 interleaved halves.
+OZZ_INLINE void StoreHalf8(math::_SimdFloat4 _a, math::_SimdFloat4 _b,
+                           uint16_t* _out) {
+  const math::SimdInt4 packed = math::Or(
+      math::FloatToHalf(_a), math::ShiftL(math::FloatToHalf(_b), 16));
+  math::StorePtrU(packed, reinterpret_cast<int*>(_out));
+}
+
+// Unpacks 8 interleaved halves, as packed by StoreHalf8.
+OZZ_INLINE void LoadHalf8(const uint16_t* _in, math::SimdFloat4* _a,
+                          math::SimdFloat4* _b) {
+  const math::SimdInt4 packed =
+      math::simd_int4::LoadPtrU(reinterpret_cast<const int*>(_in));
+  // HalfToFloat only considers the lower 16 bits of each lane, so the low
+  // halves don't need to be masked.
+  *_a = math::HalfToFloat(packed);
+  *_b = math::HalfToFloat(math::ShiftRu(packed, 16));
+}
+}  // namespace
+
+void CompressPose(const span<const math::SoaTransform>& _pose,
+                  const span<uint16_t>& _compressed) {
+  assert(_compressed.size() >= CompressedPoseSize(_pose.size()) &&
+         "Compressed buffer is too small.");
+  for (size_t i = 0; i < _pose.size(); ++i) {
+    const math::SoaTransform& transform = _pose[i];
+    uint16_t* out = _compressed.data() + i * 40;
+    StoreHalf8(transform.translation.x, transform.translation.y, out + 0);
+    StoreHalf8(transform.translation.z, transform.rotation.x, out + 8);
+    StoreHalf8(transform.rotation.y, transform.rotation.z, out + 16);
+    StoreHalf8(transform.rotation.w, transform.scale.x, out + 24);
+    StoreHalf8(transform.scale.y, transform.scale.z, out + 32);
+  }
+}
+
+void DecompressPose(const span<const uint16_t>& _compressed,
+                    const span<math::SoaTransform>& _pose) {
+  const size_t size = _compressed.size() / 40;
+  assert(_pose.size() >= size && "Pose is too small.");
+  for (size_t i = 0; i < size; ++i) {
+    math::SoaTransform& transform = _pose[i];
+    const uint16_t* in = _compressed.data() + i * 40;
+    LoadHalf8(in + 0, &transform.translation.x, &transform.translation.y);
+    LoadHalf8(in + 8, &transform.translation.z, &transform.rotation.x);
+    LoadHalf8(in + 16, &transform.rotation.y, &transform.rotation.z);
+    LoadHalf8(in + 24, &transform.rotation.w, &transform.scale.x);
+    LoadHalf8(in + 32, &transform.scale.y, &transform.scale.z);
+  }
+}
+}  // namespace animation
+}  // namespace ozz
@@ -0,0 +1,150 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/pose_variation_job.h"
+
+#include <cmath>
+
+#include "ozz/base/maths/soa_transform.h"
+
+namespace ozz {
+namespace animation {
+
+namespace {
+
+// Integer mixer (murmur3 finalizer), every input bit affects every output
+// bit.
+uint32_t Mix(uint32_t _h) {
+  _h ^= _h >> 16;
+  _h *= 0x85ebca6b;
+  _h ^= _h >> 13;
+  _h *= 0xc2b2ae35;
+  _h ^= _h >> 16;
+  return _h;
+}
+
+// Value noise lattice sample for _channel of instance _seed at integer time
+// _cell, in [-1, 1[.
+float NoiseSample(uint32_t _seed, uint32_t _channel, uint32_t _cell) {
+  const uint32_t h = Mix(_seed ^ Mix(_channel ^ Mix(_cell)));
+  return static_cast<float>(h >> 8) * (2.f / 0x1000000) - 1.f;
+}
+}  // namespace
+
+PoseVariationJob::PoseVariationJob()
+    : seed(0),
+      time(0.f),
+      frequency(1.f),
+      rotation_amplitude(0.f),
+      translation_amplitude(0.f) {}
+
+bool PoseVariationJob::Validate() const {
+  bool valid = true;
+  valid &= !input.empty();
+  valid &= output.size() >= input.size();
+  valid &= joint_weights.empty() || joint_weights.size() >= input.size();
+  return valid;
+}
+
+bool PoseVariationJob::Run() const {
+  // Exit with an error if job is invalid.
+  if (!Validate()) {
+    return false;
+  }
+
+  // Locates time within the noise lattice: lattice samples at cell and
+  // cell + 1 are interpolated with a smoothstep, so the variation is C1
+  // continuous as time drifts across cells.
+  const float t = time * frequency;
+  const float floored = std::floor(t);
+  const uint32_t cell = static_cast<uint32_t>(static_cast<int>(floored));
+  const float frac = t - floored;
+  const math::SimdFloat4 simd_alpha =
+      math::simd_float4::Load1(frac * frac * (3.f - 2.f * frac));
+
+  // Half angle for the small-angle rotation approximation below.
+  const math::SimdFloat4 half_angle =
+      math::simd_float4::Load1(rotation_amplitude * .5f);
+  const math::SimdFloat4 offset =
+      math::simd_float4::Load1(translation_amplitude);
+
+  for (size_t i = 0; i < input.size(); ++i) {
+    // Samples the noise lattice around time for the 3 axis channels of the 4
+    // joints of the SoA entry. Channels only depend on the joint index, so a
+    // joint's variation is stable whatever the pose size.
+    float n0[3][4];
+    float n1[3][4];
+    for (size_t lane = 0; lane < 4; ++lane) {
+      const uint32_t channel = static_cast<uint32_t>(i * 4 + lane) * 3;
+      for (uint32_t axis = 0; axis < 3; ++axis) {
+        n0[axis][lane] = NoiseSample(seed, channel + axis, cell);
+        n1[axis][lane] = NoiseSample(seed, channel + axis, cell + 1);
+      }
+    }
+    const math::SimdFloat4 nx = math::Lerp(math::simd_float4::LoadPtrU(n0[0]),
+                                           math::simd_float4::LoadPtrU(n1[0]),
+                                           simd_alpha);
+    const math::SimdFloat4 ny = math::Lerp(math::simd_float4::LoadPtrU(n0[1]),
+                                           math::simd_float4::LoadPtrU(n1[1]),
+                                           simd_alpha);
+    const math::SimdFloat4 nz = math::Lerp(math::simd_float4::LoadPtrU(n0[2]),
+                                           math::simd_float4::LoadPtrU(n1[2]),
+                                           simd_alpha);
+
+    const math::SimdFloat4 weight = joint_weights.empty()
+                                        ? math::simd_float4::one()
+                                        : joint_weights[i];
+
+    const math::SoaTransform& in = input[i];
+    math::SoaTransform& dest = output[i];
+
+    // Small-angle perturbation quaternion: for small angles (x*h, y*h, z*h,
+    // 1) normalized approximates the rotation of angle 2*h*|n| around axis
+    // n. Applied on the right, so the perturbation is local to the joint.
+    const math::SimdFloat4 rotation_scale = half_angle * weight;
+    const math::SoaQuaternion variation = NormalizeEst(
+        math::SoaQuaternion::Load(nx * rotation_scale, ny * rotation_scale,
+                                  nz * rotation_scale,
+                                  math::simd_float4::one()));
+    dest.rotation = in.rotation * variation;
+
+    // Translation offset reuses the rotation noise channels, scaled by its
+    // own amplitude: correlated but half the hashing cost.
+    const math::SimdFloat4 translation_scale = offset * weight;
+    const math::SoaFloat3 translation_offset = {
+        nx * translation_scale, ny * translation_scale,
+        nz * translation_scale};
+    dest.translation = in.translation + translation_offset;
+
+    // Scales are left untouched, noisy scaling reads as popping rather than
+    // variation.
+    dest.scale = in.scale;
+  }
+  return true;
+}
+}  // namespace animation
+}  // namespace ozz
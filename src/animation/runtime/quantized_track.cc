@@ -0,0 +1,132 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/quantized_track.h"
+
+#include <cassert>
+
+#include "ozz/base/io/archive.h"
+#include "ozz/base/log.h"
+#include "ozz/base/memory/allocator.h"
+
+namespace ozz {
+namespace animation {
+
+QuantizedFloatTrack::QuantizedFloatTrack() {}
+
+QuantizedFloatTrack::QuantizedFloatTrack(QuantizedFloatTrack&& _other) {
+  *this = std::move(_other);
+}
+
+QuantizedFloatTrack& QuantizedFloatTrack::operator=(
+    QuantizedFloatTrack&& _other) {
+  std::swap(ratios_, _other.ratios_);
+  std::swap(values_, _other.values_);
+  std::swap(steps_, _other.steps_);
+  std::swap(value_min_, _other.value_min_);
+  std::swap(value_extent_, _other.value_extent_);
+  std::swap(format_, _other.format_);
+  return *this;
+}
+
+QuantizedFloatTrack::~QuantizedFloatTrack() { Deallocate(); }
+
+void QuantizedFloatTrack::Allocate(size_t _keys_count) {
+  assert(ratios_.size() == 0 && values_.size() == 0);
+
+  // Compute overall size and allocate a single buffer for all the data.
+  const size_t buffer_size = _keys_count * sizeof(uint16_t) +  // ratios
+                             _keys_count * sizeof(uint16_t) +  // values
+                             (_keys_count + 7) / 8;            // steps
+  const memory::AllocationScope scope(memory::AllocationTag::kAnimation);
+  span<byte> buffer = {
+      static_cast<byte*>(memory::default_allocator()->Allocate(
+          buffer_size, alignof(uint16_t))),
+      buffer_size};
+
+  // Fix up pointers. Serves larger alignment values first.
+  ratios_ = fill_span<uint16_t>(buffer, _keys_count);
+  values_ = fill_span<uint16_t>(buffer, _keys_count);
+  steps_ = fill_span<uint8_t>(buffer, (_keys_count + 7) / 8);
+
+  assert(buffer.empty() && "Whole buffer should be consumned");
+}
+
+void QuantizedFloatTrack::Deallocate() {
+  // Deallocate everything at once.
+  memory::default_allocator()->Deallocate(as_writable_bytes(ratios_).data());
+
+  ratios_ = {};
+  values_ = {};
+  steps_ = {};
+}
+
+size_t QuantizedFloatTrack::size() const {
+  const size_t size = sizeof(*this) + ratios_.size_bytes() +
+                      values_.size_bytes() + steps_.size_bytes();
+  return size;
+}
+
+void QuantizedFloatTrack::Save(ozz::io::OArchive& _archive) const {
+  _archive << format_;
+  _archive << value_min_;
+  _archive << value_extent_;
+  const uint32_t num_keys = static_cast<uint32_t>(ratios_.size());
+  _archive << num_keys;
+
+  _archive << ozz::io::MakeArray(ratios_);
+  _archive << ozz::io::MakeArray(values_);
+  _archive << ozz::io::MakeArray(steps_);
+}
+
+void QuantizedFloatTrack::Load(ozz::io::IArchive& _archive, uint32_t _version) {
+  // Destroy the track in case it was already used before.
+  Deallocate();
+  value_min_ = 0.f;
+  value_extent_ = 0.f;
+  format_ = kFloat16;
+
+  if (_version > 1) {
+    log::Err() << "Unsupported QuantizedFloatTrack version " << _version << "."
+               << std::endl;
+    return;
+  }
+
+  _archive >> format_;
+  _archive >> value_min_;
+  _archive >> value_extent_;
+  uint32_t num_keys;
+  _archive >> num_keys;
+
+  Allocate(num_keys);
+
+  _archive >> ozz::io::MakeArray(ratios_);
+  _archive >> ozz::io::MakeArray(values_);
+  _archive >> ozz::io::MakeArray(steps_);
+}
+}  // namespace animation
+}  // namespace ozz
@@ -0,0 +1,280 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/sampling_context_pool.h"
+
+#include <atomic>
+#include <cassert>
+
+#include "ozz/base/maths/math_ex.h"
+#include "ozz/base/maths/simd_math.h"
+#include "ozz/base/memory/allocator.h"
+
+namespace ozz {
+namespace animation {
+
+namespace {
+// Detaches _context from its pooled buffer, leaving it empty and invalid.
+void Detach(SamplingJob::Context* _context) {
+  _context->Resize(0, {});
+}
+}  // namespace
+
+SamplingContextPool::SamplingContextPool(int _max_tracks, size_t _capacity)
+    : max_tracks_(math::Max(0, _max_tracks)),
+      buffer_size_(SamplingJob::Context::RequiredSize(max_tracks_)),
+      capacity_(_capacity) {}
+
+SamplingContextPool::~SamplingContextPool() {
+  const memory::AllocationScope scope(memory::AllocationTag::kSamplingContext);
+  memory::Allocator* allocator = memory::default_allocator();
+  for (const Entry& entry : entries_) {
+    Detach(entry.context);
+    allocator->Deallocate(entry.buffer);
+  }
+  for (byte* buffer : free_buffers_) {
+    allocator->Deallocate(buffer);
+  }
+}
+
+SamplingContextPool::Entry* SamplingContextPool::Find(
+    const SamplingJob::Context* _context) {
+  for (Entry& entry : entries_) {
+    if (entry.context == _context) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+bool SamplingContextPool::Touch(SamplingJob::Context* _context) {
+  assert(_context != nullptr);
+  assert(capacity_ > 0 && "Pool has no capacity.");
+
+  // Already backed, simply refreshes its use stamp.
+  Entry* entry = Find(_context);
+  if (entry != nullptr) {
+    entry->tick = tick_++;
+    return true;
+  }
+
+  // Finds a buffer: recycles a released one, grows the pool while under
+  // capacity, or evicts the least recently touched context otherwise.
+  byte* buffer;
+  if (!free_buffers_.empty()) {
+    buffer = free_buffers_.back();
+    free_buffers_.pop_back();
+  } else if (entries_.size() < capacity_) {
+    const memory::AllocationScope scope(
+        memory::AllocationTag::kSamplingContext);
+    buffer = static_cast<byte*>(memory::default_allocator()->Allocate(
+        buffer_size_, alignof(math::SimdFloat4)));
+  } else {
+    Entry* lru = &entries_[0];
+    for (Entry& candidate : entries_) {
+      if (candidate.tick < lru->tick) {
+        lru = &candidate;
+      }
+    }
+    Detach(lru->context);
+    buffer = lru->buffer;
+    *lru = entries_.back();
+    entries_.pop_back();
+  }
+
+  // Backs the context, which invalidates it: next sample pays a cold start.
+  _context->Resize(max_tracks_, {buffer, buffer_size_});
+  const Entry backed = {_context, buffer, tick_++};
+  entries_.push_back(backed);
+  return false;
+}
+
+void SamplingContextPool::Release(SamplingJob::Context* _context) {
+  Entry* entry = Find(_context);
+  if (entry == nullptr) {
+    return;
+  }
+  Detach(entry->context);
+  free_buffers_.push_back(entry->buffer);
+  *entry = entries_.back();
+  entries_.pop_back();
+}
+
+namespace {
+
+// Thread-local pooling granularity: contexts are allocated for power-of-two
+// track counts, from kContextBucketMinTracks (bucket 0, covering any small
+// skeleton) up to kContextBucketMinTracks << (kContextNumBuckets - 1), aka
+// 8192 tracks. Bigger requests aren't pooled.
+const int kContextBucketMinTracks = 64;
+const size_t kContextNumBuckets = 8;
+
+// Returns the bucket able to serve _max_tracks, kContextNumBuckets when the
+// request is too big to be pooled.
+size_t ContextBucket(int _max_tracks) {
+  size_t bucket = 0;
+  for (int tracks = kContextBucketMinTracks;
+       bucket < kContextNumBuckets && tracks < _max_tracks; tracks *= 2) {
+    ++bucket;
+  }
+  return bucket;
+}
+
+// Number of tracks contexts of _bucket are allocated for.
+int ContextBucketTracks(size_t _bucket) {
+  return kContextBucketMinTracks << _bucket;
+}
+
+// Shared spill slots, nullptr when empty. A slot changes hands with a single
+// compare-and-swap (push) or exchange (steal), so threads never block each
+// other: a lost race simply moves to the next slot. Pointers are unique and
+// swapped against nullptr only, so there's no ABA issue.
+const size_t kContextNumSharedSlots = 32;
+std::atomic<SamplingJob::Context*>
+    g_shared_contexts[kContextNumBuckets][kContextNumSharedSlots];
+
+// Per-thread context cache, a handful of contexts per bucket. On thread exit
+// cached contexts are spilled to the shared slots, so capacity built by a
+// terminated worker isn't lost.
+const size_t kContextNumLocalSlots = 4;
+struct LocalContextCache {
+  ~LocalContextCache() {
+    for (size_t bucket = 0; bucket < kContextNumBuckets; ++bucket) {
+      for (size_t i = 0; i < counts[bucket]; ++i) {
+        SamplingJob::Context* context = slots[bucket][i];
+        if (!PushSharedContext(bucket, context)) {
+          ozz::Delete(context);
+        }
+      }
+    }
+  }
+
+  // Pushes _context to an empty shared slot of _bucket, false if all taken.
+  static bool PushSharedContext(size_t _bucket,
+                                SamplingJob::Context* _context) {
+    for (size_t i = 0; i < kContextNumSharedSlots; ++i) {
+      SamplingJob::Context* expected = nullptr;
+      if (g_shared_contexts[_bucket][i].compare_exchange_strong(
+              expected, _context, std::memory_order_release,
+              std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Steals a context from a shared slot of _bucket, nullptr if all empty.
+  static SamplingJob::Context* StealSharedContext(size_t _bucket) {
+    for (size_t i = 0; i < kContextNumSharedSlots; ++i) {
+      if (g_shared_contexts[_bucket][i].load(std::memory_order_relaxed) !=
+          nullptr) {
+        SamplingJob::Context* context =
+            g_shared_contexts[_bucket][i].exchange(nullptr,
+                                                   std::memory_order_acquire);
+        if (context != nullptr) {
+          return context;
+        }
+      }
+    }
+    return nullptr;
+  }
+
+  SamplingJob::Context* slots[kContextNumBuckets][kContextNumLocalSlots] = {};
+  size_t counts[kContextNumBuckets] = {};
+};
+
+thread_local LocalContextCache tls_context_cache;
+}  // namespace
+
+SamplingJob::Context* AcquireContext(int _max_tracks) {
+  const size_t bucket = ContextBucket(_max_tracks);
+  if (bucket < kContextNumBuckets) {
+    // Hot path: the calling thread's own cache, no shared state touched.
+    LocalContextCache& cache = tls_context_cache;
+    if (cache.counts[bucket] > 0) {
+      SamplingJob::Context* context =
+          cache.slots[bucket][--cache.counts[bucket]];
+      context->Invalidate();
+      return context;
+    }
+
+    // Steals capacity released by other threads.
+    SamplingJob::Context* context =
+        LocalContextCache::StealSharedContext(bucket);
+    if (context != nullptr) {
+      context->Invalidate();
+      return context;
+    }
+  }
+
+  // Allocates a new context, at bucket granularity so it's poolable on
+  // release. This is the only path that pays Resize (and its allocation).
+  const int tracks = bucket < kContextNumBuckets ? ContextBucketTracks(bucket)
+                                                 : _max_tracks;
+  return New<SamplingJob::Context>(tracks);
+}
+
+void ReleaseContext(SamplingJob::Context* _context) {
+  if (_context == nullptr) {
+    return;
+  }
+
+  // Contexts allocated at bucket granularity are pooled, others (oversized
+  // requests, or contexts resized by the caller) are simply freed.
+  const size_t bucket = ContextBucket(_context->max_tracks());
+  if (bucket >= kContextNumBuckets ||
+      _context->max_tracks() != ContextBucketTracks(bucket)) {
+    ozz::Delete(_context);
+    return;
+  }
+
+  LocalContextCache& cache = tls_context_cache;
+  if (cache.counts[bucket] < kContextNumLocalSlots) {
+    cache.slots[bucket][cache.counts[bucket]++] = _context;
+    return;
+  }
+  if (!LocalContextCache::PushSharedContext(bucket, _context)) {
+    ozz::Delete(_context);  // Local cache and shared slots are full.
+  }
+}
+
+void DrainContextPool() {
+  LocalContextCache& cache = tls_context_cache;
+  for (size_t bucket = 0; bucket < kContextNumBuckets; ++bucket) {
+    for (size_t i = 0; i < cache.counts[bucket]; ++i) {
+      ozz::Delete(cache.slots[bucket][i]);
+    }
+    cache.counts[bucket] = 0;
+    for (SamplingJob::Context* context;
+         (context = LocalContextCache::StealSharedContext(bucket)) !=
+         nullptr;) {
+      ozz::Delete(context);
+    }
+  }
+}
+}  // namespace animation
+}  // namespace ozz
@@ -29,14 +29,18 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstring>
 #include <limits>
 
 #include "ozz/animation/runtime/animation.h"
 #include "ozz/base/encode/group_varint.h"
+#include "ozz/base/io/archive.h"
 #include "ozz/base/maths/math_constant.h"
 #include "ozz/base/maths/math_ex.h"
 #include "ozz/base/maths/soa_transform.h"
 #include "ozz/base/memory/allocator.h"
+#include "ozz/base/profile.h"
 
 // Internal include file
 #define OZZ_INCLUDE_PRIVATE_HEADER  // Allows to include private headers.
@@ -73,10 +77,32 @@ bool SamplingJob::Validate() const {
   // Tests context size.
   valid &= context->max_soa_tracks() >= num_soa_tracks;
 
+  // Tests joint mask size, when provided. One bit per soa track is required.
+  valid &= joint_mask.empty() ||
+           joint_mask.size() >= (static_cast<size_t>(num_soa_tracks) + 7) / 8;
+
+  // At least one valid component must be selected.
+  valid &= (components & kAllComponents) != 0;
+
   return valid;
 }
 
 namespace {
+
+// Brings a sampling ratio back into the unit interval. Loop-safe animations
+// (see Animation::looping) wrap out-of-range ratios across the seam, so a
+// cursor stepping from 0.999 to 1.001 keeps interpolating without a pop nor
+// a seam crossfade. Other animations clamp, as always.
+inline float ToClipRatio(const ozz::animation::Animation& _animation,
+                         float _ratio) {
+  if (!_animation.looping()) {
+    return ozz::math::Clamp(0.f, _ratio, 1.f);
+  }
+  const float wrapped = _ratio - std::floor(_ratio);
+  assert(wrapped >= 0.f && wrapped < 1.f);
+  return wrapped;
+}
+
 inline uint32_t TrackForward(const ozz::span<const uint32_t> _cache,
                              const ozz::span<const uint16_t>& _previouses,
                              uint32_t _key, uint32_t _last_track,
@@ -194,7 +220,8 @@ inline void OutdateCache(const ozz::span<byte>& _outdated,
 void UpdateCache(float _ratio, float _previous_ratio, size_t _num_soa_tracks,
                  const ozz::span<const float>& _timepoints,
                  const Animation::KeyframesCtrlConst& _ctrl,
-                 SamplingJob::Context::Cache& _cache) {
+                 SamplingJob::Context::Cache& _cache,
+                 SamplingJob::Context::Statistics& _statistics) {
   assert(_num_soa_tracks > 0);
   const uint32_t num_tracks = static_cast<uint32_t>(_num_soa_tracks * 4);
   assert(_ctrl.previouses.begin() + num_tracks * 2 <= _ctrl.previouses.end());
@@ -211,12 +238,15 @@ void UpdateCache(float _ratio, float _previous_ratio, size_t _num_soa_tracks,
       // First time, or fast seeking into animation.
       // Finds the closest iframe to the expected _ratio.
       iframe = static_cast<int>(.5f + _ratio / _ctrl.iframe_interval);
-    } else if (next == 0 || delta < 0.f) {
+    } else if (next == 0 || (delta < 0.f && _ratio < _previous_ratio - _ratio)) {
       // This handles the cases:
       // - First time, and no iframe
       // - Time is going backward, seeking toward 0, and no iframe is defined.
       // In this case it can still be valuable to reset cache to animation
-      // begining.
+      // begining, but only when the target _ratio is closer to the beginning
+      // than to the current cursor. Otherwise (short backward seeks, like
+      // rollback / rewind use cases), rewinding from the current cursor
+      // processes less keyframes than catching up from the start.
       iframe = 0;
     }
 
@@ -227,6 +257,7 @@ void UpdateCache(float _ratio, float _previous_ratio, size_t _num_soa_tracks,
 
       // Cache was overwritten, all entries must be flagged as outdated.
       OutdateCache(_cache.outdated, _num_soa_tracks);
+      ++_statistics.cursor_resets;
     }
   }
 
@@ -240,6 +271,11 @@ void UpdateCache(float _ratio, float _previous_ratio, size_t _num_soa_tracks,
   for (; next < num_keys && KeyRatio(_timepoints, _ctrl.ratios,
                                      next - _ctrl.previouses[next]) <= _ratio;
        ++next) {
+    // Prefetches the sequentially walked keyframe control stream a few cache
+    // lines ahead, as cursor advance on long clips is memory latency bound.
+    // Prefetching (potentially) past the end of the stream is allowed.
+    OZZ_PREFETCH(_ctrl.previouses.data() + next + 32);
+
     // Finds track index.
     track =
         TrackForward(_cache.entries, _ctrl.previouses, next, track, num_tracks);
@@ -251,6 +287,7 @@ void UpdateCache(float _ratio, float _previous_ratio, size_t _num_soa_tracks,
 
     // Updates cache.
     _cache.entries[track] = next;
+    ++_statistics.keys_advanced;
   }
 
   // Rewinds.
@@ -261,6 +298,10 @@ void UpdateCache(float _ratio, float _previous_ratio, size_t _num_soa_tracks,
        --next) {
     assert(next - 1 >= num_tracks * 2);
 
+    // Prefetches the backward walked keyframe control stream, see forward
+    // loop above.
+    OZZ_PREFETCH(_ctrl.previouses.data() + (next > 32 ? next - 32 : 0));
+
     // Finds track index.
     track = TrackBackward(_cache.entries, next - 1, track, num_tracks);
 
@@ -272,6 +313,7 @@ void UpdateCache(float _ratio, float _previous_ratio, size_t _num_soa_tracks,
     const uint32_t previous = _ctrl.previouses[_cache.entries[track]];
     assert(_cache.entries[track] >= previous + num_tracks);
     _cache.entries[track] -= previous;
+    ++_statistics.keys_rewound;
   }
 
   // Updates next output.
@@ -287,15 +329,22 @@ inline void Decompress(size_t _num_soa_tracks,
                        const ozz::span<const _CompressedKey>& _compressed,
                        const SamplingJob::Context::Cache& _cache,
                        const ozz::span<_DecompressedKey>& _decompressed,
+                       const ozz::span<const byte>& _joint_mask,
+                       SamplingJob::Context::Statistics& _statistics,
                        const _Decompress& _decompress) {
   const size_t num_outdated_flags = (_num_soa_tracks + 7) / 8;
   for (size_t j = 0; j < num_outdated_flags; ++j) {
-    byte outdated = _cache.outdated[j];  // Copy outdated flag
-    _cache.outdated[j] = 0;  // Reset outdated entries as all will be processed.
-    for (size_t i = j * 8; outdated != 0; ++i, outdated >>= 1) {
-      if (!(outdated & 1)) {
+    const byte outdated = _cache.outdated[j];  // Copy outdated flag
+    // Only processes outdated entries selected by the mask. Remaining ones are
+    // kept outdated, so they get decompressed whenever the mask selects them.
+    const byte mask = _joint_mask.empty() ? byte(0xff) : _joint_mask[j];
+    byte processed = outdated & mask;
+    _cache.outdated[j] = outdated & ~processed;
+    for (size_t i = j * 8; processed != 0; ++i, processed >>= 1) {
+      if (!(processed & 1)) {
         continue;
       }
+      ++_statistics.entries_decompressed;
 
       // Get cache sub part matching this outdated soa entry.
       const auto& rights = _cache.entries.subspan(i * 4, 4);
@@ -313,7 +362,7 @@ inline void Decompress(size_t _num_soa_tracks,
       const _CompressedKey& k20 = _compressed[lefts[2]];
       const _CompressedKey& k30 = _compressed[lefts[3]];
       _decompressed[i].ratio[0] = KeysRatio(_timepoints, _ctrl.ratios, lefts);
-      _decompress(k00, k10, k20, k30, &_decompressed[i].value[0]);
+      _decompress(i, k00, k10, k20, k30, &_decompressed[i].value[0]);
 
       // Decompress right side keyframes and store them in soa structures.
       const _CompressedKey& k01 = _compressed[rights[0]];
@@ -321,7 +370,7 @@ inline void Decompress(size_t _num_soa_tracks,
       const _CompressedKey& k21 = _compressed[rights[2]];
       const _CompressedKey& k31 = _compressed[rights[3]];
       _decompressed[i].ratio[1] = KeysRatio(_timepoints, _ctrl.ratios, rights);
-      _decompress(k01, k11, k21, k31, &_decompressed[i].value[1]);
+      _decompress(i, k01, k11, k21, k31, &_decompressed[i].value[1]);
     }
   }
 }
@@ -339,11 +388,24 @@ inline void DecompressFloat3(const internal::Float3Key& _k0,
       _k0.values[2], _k1.values[2], _k2.values[2], _k3.values[2]));
 }
 
+// Adapts DecompressFloat3 to the group-indexed decompression interface, the
+// float3 kernel doesn't specialize per group.
+struct Float3Decompressor {
+  void operator()(size_t, const internal::Float3Key& _k0,
+                  const internal::Float3Key& _k1,
+                  const internal::Float3Key& _k2,
+                  const internal::Float3Key& _k3,
+                  math::SoaFloat3* _soa_float3) const {
+    DecompressFloat3(_k0, _k1, _k2, _k3, _soa_float3);
+  }
+};
+
 // Defines a mapping table that defines components assignation in the output
 // quaternion.
 static constexpr uint8_t kCpntMapping[4][4] = {
     {0, 0, 1, 2}, {0, 0, 1, 2}, {0, 1, 0, 2}, {0, 1, 2, 0}};
 
+template <bool _kDeterministic>
 inline void DecompressQuaternion(const internal::QuaternionKey& _k0,
                                  const internal::QuaternionKey& _k1,
                                  const internal::QuaternionKey& _k2,
@@ -399,13 +461,15 @@ inline void DecompressQuaternion(const internal::QuaternionKey& _k0,
   cpnt[largests[3]] = math::AndNot(cpnt[largests[3]], mask_000f);
 
   // Get back length of 4th component. Favors performance over accuracy by using
-  // x * RSqrtEst(x) instead of Sqrt(x).
+  // x * RSqrtEst(x) instead of Sqrt(x), unless deterministic sampling was
+  // requested, as reciprocal estimates differ across SIMD backends.
   // ww0 cannot be 0 because we 're recomputing the largest component.
   const math::SimdFloat4 dot = cpnt[0] * cpnt[0] + cpnt[1] * cpnt[1] +
                                cpnt[2] * cpnt[2] + cpnt[3] * cpnt[3];
   // dot cannot be >= 1, because it does not include the largest component.
   const math::SimdFloat4 ww0 = math::simd_float4::one() - dot;
-  const math::SimdFloat4 w0 = ww0 * math::RSqrtEst(ww0);
+  const math::SimdFloat4 w0 =
+      _kDeterministic ? math::Sqrt(ww0) : ww0 * math::RSqrtEst(ww0);
 
   // Re-applies 4th component's sign.
   const math::SimdInt4 sign = math::ShiftL(
@@ -430,143 +494,576 @@ inline void DecompressQuaternion(const internal::QuaternionKey& _k0,
   _quaternion->w = cpnt[3];
 }
 
+// Specialized decompression for soa groups whose keys all share the same
+// largest component index _largest (see internal::QuaternionClass): component
+// remapping and largest masking are hoisted out of the per-key path. When
+// _kPositive, largest components are also known positive (small-arc class)
+// and sign restoration vanishes too.
+template <bool _kDeterministic, bool _kPositive>
+inline void DecompressQuaternionUniform(int _largest,
+                                        const internal::QuaternionKey& _k0,
+                                        const internal::QuaternionKey& _k1,
+                                        const internal::QuaternionKey& _k2,
+                                        const internal::QuaternionKey& _k3,
+                                        math::SoaQuaternion* _quaternion) {
+  int largests[4], signs[4], values[4][3];
+  internal::unpack(_k0, largests[0], signs[0], values[0]);
+  internal::unpack(_k1, largests[1], signs[1], values[1]);
+  internal::unpack(_k2, largests[2], signs[2], values[2]);
+  internal::unpack(_k3, largests[3], signs[3], values[3]);
+  assert(largests[0] == _largest && largests[1] == _largest &&
+         largests[2] == _largest && largests[3] == _largest);
+  (void)largests;
+
+  // The mapping is uniform, stored components transpose straight to soa rows.
+  alignas(16) int cmp_keys[3][4] = {
+      {values[0][0], values[1][0], values[2][0], values[3][0]},
+      {values[0][1], values[1][1], values[2][1], values[3][1]},
+      {values[0][2], values[1][2], values[2][2], values[3][2]},
+  };
+
+  // Rebuilds the 3 smallest components from quantized values.
+  const math::SimdFloat4 kScale =
+      math::simd_float4::Load1(math::kSqrt2 / internal::QuaternionKey::kfScale);
+  const math::SimdFloat4 kOffset = math::simd_float4::Load1(-math::kSqrt2_2);
+  const math::SimdFloat4 c0 =
+      kScale * math::simd_float4::FromInt(math::simd_int4::LoadPtr(cmp_keys[0])) +
+      kOffset;
+  const math::SimdFloat4 c1 =
+      kScale * math::simd_float4::FromInt(math::simd_int4::LoadPtr(cmp_keys[1])) +
+      kOffset;
+  const math::SimdFloat4 c2 =
+      kScale * math::simd_float4::FromInt(math::simd_int4::LoadPtr(cmp_keys[2])) +
+      kOffset;
+
+  // Restores the largest component from the normalization property, with the
+  // same deterministic trade-off as the generic kernel.
+  const math::SimdFloat4 dot = c0 * c0 + c1 * c1 + c2 * c2;
+  const math::SimdFloat4 ww0 = math::simd_float4::one() - dot;
+  const math::SimdFloat4 w0 =
+      _kDeterministic ? math::Sqrt(ww0) : ww0 * math::RSqrtEst(ww0);
+  math::SimdFloat4 restored = w0;
+  if (!_kPositive) {
+    const math::SimdInt4 sign = math::ShiftL(
+        math::simd_int4::Load(signs[0], signs[1], signs[2], signs[3]), 31);
+    restored = math::Or(w0, sign);
+  }
+
+  // Scatters the 3 smallest and the restored components to their soa rows.
+  const int* map = internal::kQuaternionKeyMapping[_largest];
+  math::SimdFloat4 cpnt[4];
+  cpnt[map[0]] = c0;
+  cpnt[map[1]] = c1;
+  cpnt[map[2]] = c2;
+  cpnt[_largest] = restored;
+
+  _quaternion->x = cpnt[0];
+  _quaternion->y = cpnt[1];
+  _quaternion->z = cpnt[2];
+  _quaternion->w = cpnt[3];
+}
+
+// Routes each outdated soa group to the decompression kernel matching its
+// class, built offline from compressed key statistics (see
+// internal::QuaternionClass). The generic kernel remains the fallback, and
+// handles every group of animations built before classes existed.
+template <bool _kDeterministic>
+struct QuaternionDecompressor {
+  ozz::span<const byte> classes;
+
+  void operator()(size_t _group, const internal::QuaternionKey& _k0,
+                  const internal::QuaternionKey& _k1,
+                  const internal::QuaternionKey& _k2,
+                  const internal::QuaternionKey& _k3,
+                  math::SoaQuaternion* _quaternion) const {
+    const int group_class = classes[_group];
+    if (group_class == internal::kQuaternionClassSmallArc) {
+      DecompressQuaternionUniform<_kDeterministic, true>(3, _k0, _k1, _k2, _k3,
+                                                         _quaternion);
+    } else if (group_class >= internal::kQuaternionClassUniform) {
+      DecompressQuaternionUniform<_kDeterministic, false>(
+          group_class - internal::kQuaternionClassUniform, _k0, _k1, _k2, _k3,
+          _quaternion);
+    } else {
+      DecompressQuaternion<_kDeterministic>(_k0, _k1, _k2, _k3, _quaternion);
+    }
+  }
+};
+
+template <bool _kDeterministic>
+inline void InterpolatesSoa(const math::SimdFloat4& _anim_ratio,
+                            const internal::InterpSoaFloat3& _translation,
+                            const internal::InterpSoaQuaternion& _rotation,
+                            const internal::InterpSoaFloat3& _scale,
+                            math::SoaTransform* _output) {
+  // Prepares interpolation coefficients. Deterministic sampling trades the
+  // reciprocal estimate for a correctly rounded (backend independent)
+  // division.
+  math::SimdFloat4 t_ratio, r_ratio, s_ratio;
+  if (_kDeterministic) {
+    t_ratio = (_anim_ratio - _translation.ratio[0]) /
+              (_translation.ratio[1] - _translation.ratio[0]);
+    r_ratio = (_anim_ratio - _rotation.ratio[0]) /
+              (_rotation.ratio[1] - _rotation.ratio[0]);
+    s_ratio = (_anim_ratio - _scale.ratio[0]) /
+              (_scale.ratio[1] - _scale.ratio[0]);
+  } else {
+    t_ratio = (_anim_ratio - _translation.ratio[0]) *
+              math::RcpEst(_translation.ratio[1] - _translation.ratio[0]);
+    r_ratio = (_anim_ratio - _rotation.ratio[0]) *
+              math::RcpEst(_rotation.ratio[1] - _rotation.ratio[0]);
+    s_ratio = (_anim_ratio - _scale.ratio[0]) *
+              math::RcpEst(_scale.ratio[1] - _scale.ratio[0]);
+  }
+
+  // Processes interpolations.
+  // The lerp of the rotation uses the shortest path, because opposed
+  // quaternions were negated during animation build stage (see
+  // AnimationBuilder). NLerp normalizes with a true square root and division,
+  // NLerpEst with backend specific estimates.
+  _output->translation =
+      Lerp(_translation.value[0], _translation.value[1], t_ratio);
+  _output->rotation =
+      _kDeterministic
+          ? NLerp(_rotation.value[0], _rotation.value[1], r_ratio)
+          : NLerpEst(_rotation.value[0], _rotation.value[1], r_ratio);
+  _output->scale = Lerp(_scale.value[0], _scale.value[1], s_ratio);
+}
+
+// Component selective variant of InterpolatesSoa: only the components
+// selected by _components are interpolated and written, the rest of the
+// output transform is preserved. Used by partial sampling only, the full
+// path goes through InterpolatesSoa and its branchless dual-block loop.
+template <bool _kDeterministic>
+inline void InterpolatesSoaPartial(int _components,
+                                   const math::SimdFloat4& _anim_ratio,
+                                   const internal::InterpSoaFloat3& _translation,
+                                   const internal::InterpSoaQuaternion& _rotation,
+                                   const internal::InterpSoaFloat3& _scale,
+                                   math::SoaTransform* _output) {
+  if (_components & SamplingJob::kTranslations) {
+    const math::SimdFloat4 t_ratio =
+        _kDeterministic
+            ? (_anim_ratio - _translation.ratio[0]) /
+                  (_translation.ratio[1] - _translation.ratio[0])
+            : (_anim_ratio - _translation.ratio[0]) *
+                  math::RcpEst(_translation.ratio[1] - _translation.ratio[0]);
+    _output->translation =
+        Lerp(_translation.value[0], _translation.value[1], t_ratio);
+  }
+  if (_components & SamplingJob::kRotations) {
+    const math::SimdFloat4 r_ratio =
+        _kDeterministic
+            ? (_anim_ratio - _rotation.ratio[0]) /
+                  (_rotation.ratio[1] - _rotation.ratio[0])
+            : (_anim_ratio - _rotation.ratio[0]) *
+                  math::RcpEst(_rotation.ratio[1] - _rotation.ratio[0]);
+    _output->rotation =
+        _kDeterministic
+            ? NLerp(_rotation.value[0], _rotation.value[1], r_ratio)
+            : NLerpEst(_rotation.value[0], _rotation.value[1], r_ratio);
+  }
+  if (_components & SamplingJob::kScales) {
+    const math::SimdFloat4 s_ratio =
+        _kDeterministic ? (_anim_ratio - _scale.ratio[0]) /
+                              (_scale.ratio[1] - _scale.ratio[0])
+                        : (_anim_ratio - _scale.ratio[0]) *
+                              math::RcpEst(_scale.ratio[1] - _scale.ratio[0]);
+    _output->scale = Lerp(_scale.value[0], _scale.value[1], s_ratio);
+  }
+}
+
+template <bool _kDeterministic>
 void Interpolates(float _anim_ratio, size_t _num_soa_tracks,
                   const span<const internal::InterpSoaFloat3>& _translations,
                   const span<const internal::InterpSoaQuaternion>& _rotations,
                   const span<const internal::InterpSoaFloat3>& _scales,
-                  const span<math::SoaTransform>& _output) {
+                  const span<const byte>& _joint_mask,
+                  const span<math::SoaTransform>& _output, int _components) {
   const math::SimdFloat4 anim_ratio = math::simd_float4::Load1(_anim_ratio);
-  for (size_t i = 0; i < _num_soa_tracks; ++i) {
-    // Prepares interpolation coefficients.
-    const internal::InterpSoaFloat3& t = _translations[i];
-    const math::SimdFloat4 t_ratio =
-        (anim_ratio - t.ratio[0]) * math::RcpEst(t.ratio[1] - t.ratio[0]);
-    const internal::InterpSoaQuaternion& r = _rotations[i];
-    const math::SimdFloat4 r_ratio =
-        (anim_ratio - r.ratio[0]) * math::RcpEst(r.ratio[1] - r.ratio[0]);
-    const internal::InterpSoaFloat3& s = _scales[i];
-    const math::SimdFloat4 s_ratio =
-        (anim_ratio - s.ratio[0]) * math::RcpEst(s.ratio[1] - s.ratio[0]);
-
-    // Processes interpolations.
-    // The lerp of the rotation uses the shortest path, because opposed
-    // quaternions were negated during animation build stage (see
-    // AnimationBuilder).
-    _output[i].translation = Lerp(t.value[0], t.value[1], t_ratio);
-    _output[i].rotation = NLerpEst(r.value[0], r.value[1], r_ratio);
-    _output[i].scale = Lerp(s.value[0], s.value[1], s_ratio);
+  if (_components != SamplingJob::kAllComponents) {
+    // Partial sampling: interpolates and writes selected components only.
+    for (size_t i = 0; i < _num_soa_tracks; ++i) {
+      if (!_joint_mask.empty() && !((_joint_mask[i / 8] >> (i & 7)) & 1)) {
+        continue;
+      }
+      InterpolatesSoaPartial<_kDeterministic>(_components, anim_ratio,
+                                              _translations[i], _rotations[i],
+                                              _scales[i], &_output[i]);
+    }
+    return;
+  }
+  if (_joint_mask.empty()) {
+    // Processes 2 independent soa blocks per iteration. This exposes enough
+    // instruction level parallelism to saturate wide execution units, as a
+    // single block chains dependent mul/add sequences.
+    size_t i = 0;
+    for (; i + 2 <= _num_soa_tracks; i += 2) {
+      InterpolatesSoa<_kDeterministic>(anim_ratio, _translations[i],
+                                       _rotations[i], _scales[i], &_output[i]);
+      InterpolatesSoa<_kDeterministic>(anim_ratio, _translations[i + 1],
+                                       _rotations[i + 1], _scales[i + 1],
+                                       &_output[i + 1]);
+    }
+    if (i < _num_soa_tracks) {
+      InterpolatesSoa<_kDeterministic>(anim_ratio, _translations[i],
+                                       _rotations[i], _scales[i], &_output[i]);
+    }
+  } else {
+    for (size_t i = 0; i < _num_soa_tracks; ++i) {
+      // Skips soa entries masked out, leaving their output unchanged.
+      if (!((_joint_mask[i / 8] >> (i & 7)) & 1)) {
+        continue;
+      }
+      InterpolatesSoa<_kDeterministic>(anim_ratio, _translations[i],
+                                       _rotations[i], _scales[i], &_output[i]);
+    }
   }
 }
 }  // namespace
 
-SamplingJob::SamplingJob() : ratio(0.f), animation(nullptr), context(nullptr) {}
+SamplingJob::SamplingJob()
+    : ratio(0.f),
+      animation(nullptr),
+      context(nullptr),
+      deterministic(false),
+      components(kAllComponents) {}
 
 bool SamplingJob::Run() const {
   if (!Validate()) {
     return false;
   }
+  RunValidated();
+  return true;
+}
 
-  // Checked during validation
-  assert(context->max_soa_tracks() >= animation->num_soa_tracks());
+void SamplingJob::RunValidated() const {
+  assert(Validate() && "Job is expected to be valid.");
+  OZZ_PROFILE_JOB("SamplingJob", animation->num_tracks());
+
+  RunValidated(*animation, ratio, context, output, joint_mask, deterministic,
+               components);
+}
 
+void SamplingJob::RunValidated(const Animation& _animation, float _ratio,
+                               Context* _context,
+                               const span<math::SoaTransform>& _output,
+                               const span<const byte>& _joint_mask,
+                               bool _deterministic, int _components) {
   // Early out if animation contains no joint.
   const size_t num_soa_tracks =
-      static_cast<size_t>(animation->num_soa_tracks());
+      static_cast<size_t>(_animation.num_soa_tracks());
   if (num_soa_tracks <= 0) {
-    return true;
+    return;
+  }
+
+  // Updates context and decompresses outdated keyframes.
+  DecompressValidated(_animation, _ratio, _context, _joint_mask,
+                      _deterministic, _components);
+
+  // Only interp as much as we have output for.
+  const size_t num_soa_interp_tracks =
+      math::Min(_output.size(), num_soa_tracks);
+
+  // Interpolates soa hot data.
+  const float clamped_ratio = ToClipRatio(_animation, _ratio);
+  if (_deterministic) {
+    Interpolates<true>(clamped_ratio, num_soa_interp_tracks,
+                       _context->translations_, _context->rotations_,
+                       _context->scales_, _joint_mask, _output, _components);
+  } else {
+    Interpolates<false>(clamped_ratio, num_soa_interp_tracks,
+                        _context->translations_, _context->rotations_,
+                        _context->scales_, _joint_mask, _output, _components);
   }
+}
+
+void SamplingJob::DecompressValidated(const Animation& _animation, float _ratio,
+                                      Context* _context,
+                                      const span<const byte>& _joint_mask,
+                                      bool _deterministic, int _components) {
+  // Checked during validation
+  assert(_context->max_soa_tracks() >= _animation.num_soa_tracks());
 
-  // Clamps ratio in range [0,duration].
-  const float clamped_ratio = math::Clamp(0.f, ratio, 1.f);
+  const size_t num_soa_tracks =
+      static_cast<size_t>(_animation.num_soa_tracks());
+  assert(num_soa_tracks > 0);
+
+  // Brings ratio back in range [0,1].
+  const float clamped_ratio = ToClipRatio(_animation, _ratio);
 
   // Step the context to this potentially new animation and ratio.
-  const float previous_ratio = context->Step(*animation, clamped_ratio);
+  const float previous_ratio = _context->Step(_animation, clamped_ratio);
 
   // Update cache with animation keyframe indexes for t = ratio.
   // Decompresses outdated soa hot values.
 
+  // Overlaps the three component streams: touches the rotation and scale
+  // cursor lines upfront so their loads are in flight while the translation
+  // stream is processed.
+  if (_components & kRotations) {
+    OZZ_PREFETCH(_animation.rotations_ctrl().previouses.data() +
+                 _context->rotations_cache_.next);
+  }
+  if (_components & kScales) {
+    OZZ_PREFETCH(_animation.scales_ctrl().previouses.data() +
+                 _context->scales_cache_.next);
+  }
+
+  // Skipped components don't advance their keyframe cursor at all. This is
+  // safe as each component stream has its own cursor, which catches up from
+  // where it was left the next time the component is selected.
+
   // Translations
-  const Animation::KeyframesCtrlConst& translations_ctrl =
-      animation->translations_ctrl();
-  UpdateCache(clamped_ratio, previous_ratio, num_soa_tracks,
-              animation->timepoints(), translations_ctrl,
-              context->translations_cache_);
-  Decompress(num_soa_tracks, animation->timepoints(), translations_ctrl,
-             animation->translations_values(), context->translations_cache_,
-             context->translations_, &DecompressFloat3);
+  if (_components & kTranslations) {
+    const Animation::KeyframesCtrlConst& translations_ctrl =
+        _animation.translations_ctrl();
+    UpdateCache(clamped_ratio, previous_ratio, num_soa_tracks,
+                _animation.timepoints(), translations_ctrl,
+                _context->translations_cache_, _context->statistics_);
+    Decompress(num_soa_tracks, _animation.timepoints(), translations_ctrl,
+               _animation.translations_values(), _context->translations_cache_,
+               _context->translations_, _joint_mask, _context->statistics_,
+               Float3Decompressor{});
+  }
 
   // Rotations
-  const Animation::KeyframesCtrlConst& rotations_ctrl =
-      animation->rotations_ctrl();
-  UpdateCache(clamped_ratio, previous_ratio, num_soa_tracks,
-              animation->timepoints(), rotations_ctrl,
-              context->rotations_cache_);
-  Decompress(num_soa_tracks, animation->timepoints(), rotations_ctrl,
-             animation->rotations_values(), context->rotations_cache_,
-             context->rotations_, &DecompressQuaternion);
+  if (_components & kRotations) {
+    const Animation::KeyframesCtrlConst& rotations_ctrl =
+        _animation.rotations_ctrl();
+    UpdateCache(clamped_ratio, previous_ratio, num_soa_tracks,
+                _animation.timepoints(), rotations_ctrl,
+                _context->rotations_cache_, _context->statistics_);
+    if (_deterministic) {
+      Decompress(num_soa_tracks, _animation.timepoints(), rotations_ctrl,
+                 _animation.rotations_values(), _context->rotations_cache_,
+                 _context->rotations_, _joint_mask, _context->statistics_,
+                 QuaternionDecompressor<true>{_animation.rotation_classes()});
+    } else {
+      Decompress(num_soa_tracks, _animation.timepoints(), rotations_ctrl,
+                 _animation.rotations_values(), _context->rotations_cache_,
+                 _context->rotations_, _joint_mask, _context->statistics_,
+                 QuaternionDecompressor<false>{_animation.rotation_classes()});
+    }
+  }
 
   // Scales
-  const Animation::KeyframesCtrlConst& scales_ctrl = animation->scales_ctrl();
-  UpdateCache(clamped_ratio, previous_ratio, num_soa_tracks,
-              animation->timepoints(), scales_ctrl, context->scales_cache_);
-  Decompress(num_soa_tracks, animation->timepoints(), scales_ctrl,
-             animation->scales_values(), context->scales_cache_,
-             context->scales_, &DecompressFloat3);
+  if (_components & kScales) {
+    const Animation::KeyframesCtrlConst& scales_ctrl = _animation.scales_ctrl();
+    UpdateCache(clamped_ratio, previous_ratio, num_soa_tracks,
+                _animation.timepoints(), scales_ctrl, _context->scales_cache_,
+                _context->statistics_);
+    Decompress(num_soa_tracks, _animation.timepoints(), scales_ctrl,
+               _animation.scales_values(), _context->scales_cache_,
+               _context->scales_, _joint_mask, _context->statistics_,
+               Float3Decompressor{});
+  }
+}
+
+bool SamplingBatchJob::Validate() const {
+  // Every batch entry must define a complete sampling task, hence all ranges
+  // must have the same size.
+  bool valid = true;
+  valid &= ratios.size() == animations.size();
+  valid &= contexts.size() == animations.size();
+  valid &= outputs.size() == animations.size();
+  if (!valid) {
+    return false;
+  }
+
+  // Validates each entry like a single SamplingJob would.
+  for (size_t i = 0; i < animations.size(); ++i) {
+    if (!animations[i] || !contexts[i]) {
+      return false;
+    }
+    valid &= !outputs[i].empty();
+    valid &= contexts[i]->max_soa_tracks() >= animations[i]->num_soa_tracks();
+  }
+
+  return valid;
+}
+
+bool SamplingBatchJob::Run() const {
+  if (!Validate()) {
+    return false;
+  }
+  OZZ_PROFILE_JOB("SamplingBatchJob", static_cast<int>(animations.size()));
+
+  // Samples all entries in a tight loop. Validation was done upfront for the
+  // whole batch, so per-entry sampling goes straight to the kernels.
+  for (size_t i = 0; i < animations.size(); ++i) {
+    SamplingJob::RunValidated(*animations[i], ratios[i], contexts[i],
+                              outputs[i], {}, false);
+  }
+
+  return true;
+}
+
+CrossfadeSamplingJob::CrossfadeSamplingJob()
+    : from{0.f, nullptr, nullptr},
+      to{0.f, nullptr, nullptr},
+      blend_ratio(0.f) {}
+
+bool CrossfadeSamplingJob::Validate() const {
+  bool valid = true;
+
+  // Test for nullptr pointers.
+  if (!from.animation || !from.context || !to.animation || !to.context) {
+    return false;
+  }
+  valid &= !output.empty();
+
+  // Tests contexts size.
+  valid &= from.context->max_soa_tracks() >= from.animation->num_soa_tracks();
+  valid &= to.context->max_soa_tracks() >= to.animation->num_soa_tracks();
+
+  // Fused blending requires both clips to animate the same tracks.
+  valid &= from.animation->num_tracks() == to.animation->num_tracks();
+
+  return valid;
+}
+
+bool CrossfadeSamplingJob::Run() const {
+  if (!Validate()) {
+    return false;
+  }
+  OZZ_PROFILE_JOB("CrossfadeSamplingJob", from.animation->num_tracks());
+
+  // Early out if animations contain no joint.
+  const size_t num_soa_tracks =
+      static_cast<size_t>(from.animation->num_soa_tracks());
+  if (num_soa_tracks <= 0) {
+    return true;
+  }
+
+  // Updates both contexts and decompresses outdated keyframes.
+  SamplingJob::DecompressValidated(*from.animation, from.ratio, from.context,
+                                   {}, false);
+  SamplingJob::DecompressValidated(*to.animation, to.ratio, to.context, {},
+                                   false);
 
   // Only interp as much as we have output for.
   const size_t num_soa_interp_tracks = math::Min(output.size(), num_soa_tracks);
 
-  // Interpolates soa hot data.
-  Interpolates(clamped_ratio, num_soa_interp_tracks, context->translations_,
-               context->rotations_, context->scales_, output);
+  // Interpolates and blends soa hot data, block by block, while sampled
+  // values are still in registers.
+  const math::SimdFloat4 from_ratio_simd =
+      math::simd_float4::Load1(math::Clamp(0.f, from.ratio, 1.f));
+  const math::SimdFloat4 to_ratio_simd =
+      math::simd_float4::Load1(math::Clamp(0.f, to.ratio, 1.f));
+  const math::SimdFloat4 blend =
+      math::simd_float4::Load1(math::Clamp(0.f, blend_ratio, 1.f));
+  const SamplingJob::Context& from_context = *from.context;
+  const SamplingJob::Context& to_context = *to.context;
+  for (size_t i = 0; i < num_soa_interp_tracks; ++i) {
+    math::SoaTransform from_transform;
+    InterpolatesSoa<false>(from_ratio_simd, from_context.translations_[i],
+                           from_context.rotations_[i], from_context.scales_[i],
+                           &from_transform);
+    math::SoaTransform to_transform;
+    InterpolatesSoa<false>(to_ratio_simd, to_context.translations_[i],
+                           to_context.rotations_[i], to_context.scales_[i],
+                           &to_transform);
+
+    // Blends translation and scale.
+    math::SoaTransform& dest = output[i];
+    dest.translation =
+        Lerp(from_transform.translation, to_transform.translation, blend);
+    dest.scale = Lerp(from_transform.scale, to_transform.scale, blend);
+
+    // Blends rotations, negating opposed quaternions to be sure to choose the
+    // shortest path between the two (same policy as BlendingJob).
+    const math::SimdInt4 sign =
+        math::Sign(Dot(from_transform.rotation, to_transform.rotation));
+    const math::SoaQuaternion to_rotation = {
+        math::Xor(to_transform.rotation.x, sign),
+        math::Xor(to_transform.rotation.y, sign),
+        math::Xor(to_transform.rotation.z, sign),
+        math::Xor(to_transform.rotation.w, sign)};
+    dest.rotation = NLerpEst(from_transform.rotation, to_rotation, blend);
+  }
 
   return true;
 }
 
-SamplingJob::Context::Context() : max_soa_tracks_(0) { Invalidate(); }
+SamplingJob::Context::Context()
+    : max_soa_tracks_(0), owns_buffer_(true), statistics_() {
+  Invalidate();
+}
 
-SamplingJob::Context::Context(int _max_tracks) : max_soa_tracks_(0) {
+SamplingJob::Context::Context(int _max_tracks)
+    : max_soa_tracks_(0), owns_buffer_(true), statistics_() {
   Resize(_max_tracks);
 }
 
 SamplingJob::Context::~Context() {
   // translations interp is the allocation pointer, so this deallocates
-  // everything at once.
-  memory::default_allocator()->Deallocate(translations_.data());
+  // everything at once. Caller-provided buffers aren't owned, hence never
+  // deallocated.
+  if (owns_buffer_) {
+    memory::default_allocator()->Deallocate(translations_.data());
+  }
+}
+
+size_t SamplingJob::Context::RequiredSize(int _max_tracks) {
+  using internal::InterpSoaFloat3;
+  using internal::InterpSoaQuaternion;
+
+  // Tracks value is aligned to a multiple of soa size, like max_soa_tracks_.
+  const size_t max_soa_tracks =
+      static_cast<size_t>((math::Max(0, _max_tracks) + 3) / 4);
+  const size_t max_tracks = max_soa_tracks * 4;
+  const size_t num_outdated = (max_soa_tracks + 7) / 8;
+  return sizeof(InterpSoaFloat3) * max_soa_tracks +
+         sizeof(InterpSoaQuaternion) * max_soa_tracks +
+         sizeof(InterpSoaFloat3) * max_soa_tracks +
+         sizeof(uint32_t) * max_tracks * 3 +  // trans + rot + scale.
+         sizeof(uint8_t) * 3 * num_outdated;
 }
 
 void SamplingJob::Context::Resize(int _max_tracks) {
   using internal::InterpSoaFloat3;
+
+  // Allocates a single buffer from the default allocator and hands it over to
+  // the caller-provided memory implementation.
+  const memory::AllocationScope scope(
+      memory::AllocationTag::kSamplingContext);
+  const size_t size = RequiredSize(_max_tracks);
+  memory::Allocator* allocator = memory::default_allocator();
+  span<byte> buffer = {
+      static_cast<byte*>(allocator->Allocate(size, alignof(InterpSoaFloat3))),
+      size};
+  Resize(_max_tracks, buffer);
+
+  // The buffer was allocated right above, *this context owns it.
+  owns_buffer_ = true;
+}
+
+void SamplingJob::Context::Resize(int _max_tracks, span<byte> _buffer) {
+  using internal::InterpSoaFloat3;
   using internal::InterpSoaQuaternion;
 
   // Reset existing data.
   Invalidate();
-  memory::default_allocator()->Deallocate(translations_.data());
+  if (owns_buffer_) {
+    memory::default_allocator()->Deallocate(translations_.data());
+  }
+  owns_buffer_ = false;
 
   // Updates maximum supported soa tracks.
   max_soa_tracks_ = (math::Max(0, _max_tracks) + 3) / 4;
   const size_t max_soa_tracks = static_cast<size_t>(max_soa_tracks_);
-
-  // Allocate all context data at once in a single allocation.
-  // Alignment is guaranteed because memory is dispatch from the highest
-  // alignment requirement (Soa data: SimdFloat4) to the lowest (outdated
-  // flag: unsigned char).
-
-  // Computes allocation size.
   const size_t max_tracks = max_soa_tracks * 4;
   const size_t num_outdated = (max_soa_tracks + 7) / 8;
-  const size_t size =
-      sizeof(InterpSoaFloat3) * max_soa_tracks +
-      sizeof(InterpSoaQuaternion) * max_soa_tracks +
-      sizeof(InterpSoaFloat3) * max_soa_tracks +
-      sizeof(uint32_t) * max_tracks * 3 +  // trans + rot + scale.
-      sizeof(uint8_t) * 3 * num_outdated;
-
-  // Allocates all at once.
-  memory::Allocator* allocator = memory::default_allocator();
-  span<byte> buffer = {
-      static_cast<byte*>(allocator->Allocate(size, alignof(InterpSoaFloat3))),
-      size};
+
+  // Checks the caller-provided buffer fulfills size and alignment
+  // requirements, then trims it to the exact required size so the final
+  // distribution assertion remains valid.
+  const size_t size = RequiredSize(_max_tracks);
+  assert(_buffer.size() >= size && "Buffer is too small.");
+  assert(ozz::IsAligned(_buffer.data(), alignof(InterpSoaFloat3)) &&
+         "Buffer alignment doesn't match simd types requirement.");
+  span<byte> buffer = _buffer.first(size);
 
   // Distributes buffer memory while ensuring proper alignment (serves larger
   // alignment values first).
@@ -591,6 +1088,274 @@ void SamplingJob::Context::Resize(int _max_tracks) {
   assert(buffer.empty());
 }
 
+void SamplingJob::Context::CopyFrom(const Context& _other) {
+  // Ensures both contexts have the same buffer layout.
+  if (max_soa_tracks_ != _other.max_soa_tracks_) {
+    Resize(_other.max_soa_tracks_ * 4);
+  }
+
+  // Copies sampling state.
+  animation_ = _other.animation_;
+  ratio_ = _other.ratio_;
+
+  // Copies cursor caches.
+  const Cache* const src_caches[3] = {&_other.translations_cache_,
+                                      &_other.rotations_cache_,
+                                      &_other.scales_cache_};
+  Cache* const dest_caches[3] = {&translations_cache_, &rotations_cache_,
+                                 &scales_cache_};
+  for (size_t i = 0; i < 3; ++i) {
+    std::copy(src_caches[i]->entries.begin(), src_caches[i]->entries.end(),
+              dest_caches[i]->entries.begin());
+    std::copy(src_caches[i]->outdated.begin(), src_caches[i]->outdated.end(),
+              dest_caches[i]->outdated.begin());
+    dest_caches[i]->next = src_caches[i]->next;
+  }
+
+  // Copies decompressed soa hot data.
+  std::copy(_other.translations_.begin(), _other.translations_.end(),
+            translations_.begin());
+  std::copy(_other.rotations_.begin(), _other.rotations_.end(),
+            rotations_.begin());
+  std::copy(_other.scales_.begin(), _other.scales_.end(), scales_.begin());
+}
+
+void SamplingJob::Context::Save(ozz::io::OArchive& _archive) const {
+  const int32_t max_soa_tracks = max_soa_tracks_;
+  _archive << max_soa_tracks;
+  _archive << ratio_;
+
+  // Stores the layout of the animation the snapshot was warmed with, checked
+  // by Bind at load time. An unwarmed context (no animation sampled yet)
+  // stores 0, making the snapshot unbindable.
+  const int32_t warm_soa_tracks = animation_ ? animation_->num_soa_tracks() : 0;
+  const float warm_duration = animation_ ? animation_->duration() : 0.f;
+  _archive << warm_soa_tracks;
+  _archive << warm_duration;
+
+  // Cursor caches.
+  const Cache* const caches[3] = {&translations_cache_, &rotations_cache_,
+                                  &scales_cache_};
+  for (size_t i = 0; i < 3; ++i) {
+    _archive << caches[i]->next;
+    _archive << ozz::io::MakeArray(caches[i]->entries.data(),
+                                   caches[i]->entries.size());
+    _archive << ozz::io::MakeArray(caches[i]->outdated.data(),
+                                   caches[i]->outdated.size());
+  }
+
+  // Decompressed soa hot data, all members are floats.
+  _archive << ozz::io::MakeArray(
+      reinterpret_cast<const float*>(translations_.data()),
+      translations_.size_bytes() / sizeof(float));
+  _archive << ozz::io::MakeArray(
+      reinterpret_cast<const float*>(rotations_.data()),
+      rotations_.size_bytes() / sizeof(float));
+  _archive << ozz::io::MakeArray(
+      reinterpret_cast<const float*>(scales_.data()),
+      scales_.size_bytes() / sizeof(float));
+}
+
+void SamplingJob::Context::Load(ozz::io::IArchive& _archive,
+                                uint32_t _version) {
+  (void)_version;
+
+  int32_t max_soa_tracks;
+  _archive >> max_soa_tracks;
+  if (max_soa_tracks != max_soa_tracks_) {
+    Resize(max_soa_tracks * 4);
+  } else {
+    // Resets cursors and warm data, the buffer layout is already correct.
+    Invalidate();
+  }
+  _archive >> ratio_;
+
+  int32_t warm_soa_tracks;
+  _archive >> warm_soa_tracks;
+  warm_soa_tracks_ = warm_soa_tracks;
+  _archive >> warm_duration_;
+
+  // Cursor caches.
+  Cache* const caches[3] = {&translations_cache_, &rotations_cache_,
+                            &scales_cache_};
+  for (size_t i = 0; i < 3; ++i) {
+    _archive >> caches[i]->next;
+    _archive >> ozz::io::MakeArray(caches[i]->entries.data(),
+                                   caches[i]->entries.size());
+    _archive >> ozz::io::MakeArray(caches[i]->outdated.data(),
+                                   caches[i]->outdated.size());
+  }
+
+  // Decompressed soa hot data.
+  _archive >> ozz::io::MakeArray(reinterpret_cast<float*>(translations_.data()),
+                                 translations_.size_bytes() / sizeof(float));
+  _archive >> ozz::io::MakeArray(reinterpret_cast<float*>(rotations_.data()),
+                                 rotations_.size_bytes() / sizeof(float));
+  _archive >> ozz::io::MakeArray(reinterpret_cast<float*>(scales_.data()),
+                                 scales_.size_bytes() / sizeof(float));
+
+  // Counters refer to runs performed by this very instance.
+  statistics_ = Statistics();
+}
+
+bool SamplingJob::Context::Bind(const Animation& _animation) {
+  if (warm_soa_tracks_ == 0 ||
+      warm_soa_tracks_ != _animation.num_soa_tracks() ||
+      warm_duration_ != _animation.duration()) {
+    Invalidate();
+    return false;
+  }
+  animation_ = &_animation;
+  // Binding is one shot, the snapshot can't be reused with another animation.
+  warm_soa_tracks_ = 0;
+  warm_duration_ = 0.f;
+  return true;
+}
+
+namespace {
+// Header of a relocatable context image, followed by the context data block.
+// All fields are stored with native endianness and layout.
+struct ContextImageHeader {
+  char tag[12];
+  uint32_t version;
+  int32_t max_soa_tracks;
+  float ratio;
+  int32_t warm_soa_tracks;
+  float warm_duration;
+  uint32_t nexts[3];  // translations, rotations, scales cursors.
+  uint32_t padding;
+};
+static_assert(
+    sizeof(ContextImageHeader) % alignof(internal::InterpSoaFloat3) == 0,
+    "Data block alignment follows from header size.");
+
+const char kContextImageTag[12] = "ozz-raw-ctx";
+const uint32_t kContextImageVersion = 1;
+}  // namespace
+
+size_t SamplingJob::Context::raw_size() const {
+  return sizeof(ContextImageHeader) + RequiredSize(max_soa_tracks_ * 4);
+}
+
+bool SamplingJob::Context::SaveRaw(span<byte> _buffer) const {
+  const size_t size = raw_size();
+  if (_buffer.size() < size) {
+    return false;
+  }
+
+  // Fills and stores the header. The layout of the animation the context was
+  // warmed with is stored for Bind to check at attach time, as with archive
+  // snapshots.
+  ContextImageHeader header = {};
+  std::memcpy(header.tag, kContextImageTag, sizeof(header.tag));
+  header.version = kContextImageVersion;
+  header.max_soa_tracks = max_soa_tracks_;
+  header.ratio = ratio_;
+  header.warm_soa_tracks = animation_ ? animation_->num_soa_tracks() : 0;
+  header.warm_duration = animation_ ? animation_->duration() : 0.f;
+  header.nexts[0] = translations_cache_.next;
+  header.nexts[1] = rotations_cache_.next;
+  header.nexts[2] = scales_cache_.next;
+  std::memcpy(_buffer.data(), &header, sizeof(header));
+
+  // Copies the data block verbatim. It is contiguous by construction,
+  // starting at the decompressed translations buffer, see Resize, and holds
+  // no pointer.
+  const size_t data_size = size - sizeof(header);
+  if (data_size > 0) {
+    std::memcpy(_buffer.data() + sizeof(header), translations_.data(),
+                data_size);
+  }
+  return true;
+}
+
+bool SamplingJob::Context::LoadRaw(span<byte> _buffer) {
+  // Validates header.
+  if (_buffer.size() < sizeof(ContextImageHeader) ||
+      !ozz::IsAligned(_buffer.data(), alignof(internal::InterpSoaFloat3))) {
+    Invalidate();
+    return false;
+  }
+  ContextImageHeader header;
+  std::memcpy(&header, _buffer.data(), sizeof(header));
+  if (std::memcmp(header.tag, kContextImageTag, sizeof(header.tag)) != 0 ||
+      header.version != kContextImageVersion || header.max_soa_tracks < 0) {
+    Invalidate();
+    return false;
+  }
+  const size_t data_size = RequiredSize(header.max_soa_tracks * 4);
+  if (_buffer.size() < sizeof(header) + data_size) {
+    Invalidate();
+    return false;
+  }
+
+  // Binds spans into the image data block. Resize only distributes the
+  // buffer, nothing is written: the warmed state the block holds stays
+  // shared until sampling diverges from it.
+  Resize(header.max_soa_tracks * 4, _buffer.subspan(sizeof(header), data_size));
+
+  // Restores the scalar state the header carries. The context is left
+  // unbound, Bind re-attaches it to the animation it was warmed with.
+  ratio_ = header.ratio;
+  warm_soa_tracks_ = header.warm_soa_tracks;
+  warm_duration_ = header.warm_duration;
+  translations_cache_.next = header.nexts[0];
+  rotations_cache_.next = header.nexts[1];
+  scales_cache_.next = header.nexts[2];
+
+  // Counters refer to runs performed by this very instance.
+  statistics_ = Statistics();
+  return true;
+}
+
+namespace {
+// Tests that two keyframes control streams describe the exact same key
+// layout: same time points indices and same per-track key sequences. When
+// they do, key indices cached by a context remain valid for the other
+// animation's value streams.
+bool SameLayout(const Animation::KeyframesCtrlConst& _a,
+                const Animation::KeyframesCtrlConst& _b) {
+  return _a.ratios.size() == _b.ratios.size() &&
+         _a.previouses.size() == _b.previouses.size() &&
+         std::equal(_a.ratios.begin(), _a.ratios.end(), _b.ratios.begin()) &&
+         std::equal(_a.previouses.begin(), _a.previouses.end(),
+                    _b.previouses.begin());
+}
+}  // namespace
+
+bool SamplingJob::Context::Migrate(const Animation& _animation) {
+  // Trivially migrated if already bound to _animation.
+  if (animation_ == &_animation) {
+    return true;
+  }
+
+  // Migration requires a bound context and an animation with the exact same
+  // key layout, so cached key indices can be reused against the new value
+  // streams.
+  if (animation_ == nullptr ||
+      max_soa_tracks_ < _animation.num_soa_tracks() ||
+      animation_->num_soa_tracks() != _animation.num_soa_tracks() ||
+      animation_->timepoints().size() != _animation.timepoints().size() ||
+      !SameLayout(animation_->translations_ctrl(),
+                  _animation.translations_ctrl()) ||
+      !SameLayout(animation_->rotations_ctrl(), _animation.rotations_ctrl()) ||
+      !SameLayout(animation_->scales_ctrl(), _animation.scales_ctrl())) {
+    Invalidate();
+    return false;
+  }
+
+  // Rebinds to the new animation, keeping cursors and ratio. Cached key
+  // indices are still valid, but decompressed values aren't anymore: flags
+  // every soa entry outdated so the next Run re-decompresses them from
+  // _animation value streams.
+  animation_ = &_animation;
+  const int num_soa_tracks = _animation.num_soa_tracks();
+  OutdateCache(translations_cache_.outdated, num_soa_tracks);
+  OutdateCache(rotations_cache_.outdated, num_soa_tracks);
+  OutdateCache(scales_cache_.outdated, num_soa_tracks);
+  return true;
+}
+
 float SamplingJob::Context::Step(const Animation& _animation, float _ratio) {
   // The cache is invalidated if animation has changed...
   if (animation_ != &_animation) {
@@ -608,6 +1373,8 @@ void SamplingJob::Context::Invalidate() {
   translations_cache_.next = 0;
   rotations_cache_.next = 0;
   scales_cache_.next = 0;
+  warm_soa_tracks_ = 0;
+  warm_duration_ = 0.f;
 }
 }  // namespace animation
 }  // namespace ozz
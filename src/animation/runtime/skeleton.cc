@@ -27,11 +27,15 @@
 
 #include "ozz/animation/runtime/skeleton.h"
 
+#include <algorithm>
 #include <cstring>
 
+#include "ozz/animation/runtime/local_to_model_job.h"
 #include "ozz/base/io/archive.h"
 #include "ozz/base/log.h"
 #include "ozz/base/maths/math_ex.h"
+#include "ozz/base/maths/simd_math.h"
+#include "ozz/base/maths/simd_math_archive.h"
 #include "ozz/base/maths/soa_math_archive.h"
 #include "ozz/base/maths/soa_transform.h"
 #include "ozz/base/memory/allocator.h"
@@ -45,22 +49,44 @@ Skeleton::Skeleton(Skeleton&& _other) { *this = std::move(_other); }
 
 Skeleton& Skeleton::operator=(Skeleton&& _other) {
   std::swap(joint_rest_poses_, _other.joint_rest_poses_);
+  std::swap(joint_bind_poses_, _other.joint_bind_poses_);
+  std::swap(joint_inverse_bind_poses_, _other.joint_inverse_bind_poses_);
   std::swap(joint_parents_, _other.joint_parents_);
+  std::swap(joint_subtree_ends_, _other.joint_subtree_ends_);
+  std::swap(joint_depths_, _other.joint_depths_);
   std::swap(joint_names_, _other.joint_names_);
+  std::swap(joint_name_hashes_, _other.joint_name_hashes_);
+  std::swap(joint_name_sorted_, _other.joint_name_sorted_);
+  std::swap(structural_hash_, _other.structural_hash_);
+  std::swap(owns_buffer_, _other.owns_buffer_);
+  std::swap(owns_names_, _other.owns_names_);
 
   return *this;
 }
 
 Skeleton::~Skeleton() { Deallocate(); }
 
-char* Skeleton::Allocate(size_t _chars_size, size_t _num_joints) {
-  // Distributes buffer memory while ensuring proper alignment (serves larger
-  // alignment values first).
-  static_assert(alignof(math::SoaTransform) >= alignof(char*) &&
-                    alignof(char*) >= alignof(int16_t) &&
-                    alignof(int16_t) >= alignof(char),
-                "Must serve larger alignment values first)");
+namespace {
+// Size in bytes of the skeleton data block for _num_joints joints and
+// _chars_size bytes of concatenated joint names, as distributed by Bind.
+size_t RequiredSize(size_t _chars_size, size_t _num_joints) {
+  const size_t num_soa_joints = (_num_joints + 3) / 4;
+  const size_t joint_rest_poses_size =
+      num_soa_joints * sizeof(math::SoaTransform);
+  const size_t bind_poses_size = 2 * _num_joints * sizeof(math::Float4x4);
+  const size_t names_size = _num_joints * sizeof(char*);
+  const size_t joint_parents_size = _num_joints * sizeof(int16_t);
+  const size_t subtree_ends_size = _num_joints * sizeof(int16_t);
+  const size_t depths_size = _num_joints * sizeof(int16_t);
+  const size_t name_hashes_size = _num_joints * sizeof(uint32_t);
+  const size_t name_sorted_size = _num_joints * sizeof(int16_t);
+  return names_size + _chars_size + joint_parents_size + subtree_ends_size +
+         depths_size + joint_rest_poses_size + bind_poses_size +
+         name_hashes_size + name_sorted_size;
+}
+}  // namespace
 
+char* Skeleton::Allocate(size_t _chars_size, size_t _num_joints) {
   assert(joint_rest_poses_.size() == 0 && joint_names_.size() == 0 &&
          joint_parents_.size() == 0);
 
@@ -69,42 +95,301 @@ char* Skeleton::Allocate(size_t _chars_size, size_t _num_joints) {
     return nullptr;
   }
 
+  // Allocates whole buffer.
+  const size_t buffer_size = RequiredSize(_chars_size, _num_joints);
+  span<byte> buffer;
+  if (placement_buffer_.empty()) {
+    const memory::AllocationScope scope(memory::AllocationTag::kSkeleton);
+    buffer = {static_cast<byte*>(memory::default_allocator()->Allocate(
+                  buffer_size, alignof(math::SoaTransform))),
+              buffer_size};
+  } else {
+    // Placement load path, binds into the caller-provided buffer which was
+    // already validated against SizeOf, see the placement Load overload.
+    assert(placement_buffer_.size() >= buffer_size &&
+           IsAligned(placement_buffer_.data(), alignof(math::SoaTransform)));
+    buffer = {placement_buffer_.data(), buffer_size};
+    owns_buffer_ = false;
+    owns_names_ = false;
+  }
+  return Bind(buffer, _chars_size, _num_joints);
+}
+
+char* Skeleton::Bind(span<byte> _buffer, size_t _chars_size,
+                     size_t _num_joints) {
+  // Distributes buffer memory while ensuring proper alignment (serves larger
+  // alignment values first).
+  static_assert(alignof(math::SoaTransform) >= alignof(math::Float4x4) &&
+                    alignof(math::Float4x4) >= alignof(char*) &&
+                    alignof(char*) >= alignof(uint32_t) &&
+                    alignof(uint32_t) >= alignof(int16_t) &&
+                    alignof(int16_t) >= alignof(char),
+                "Must serve larger alignment values first)");
+
   // Rest poses have SoA format
   const size_t num_soa_joints = (_num_joints + 3) / 4;
-  const size_t joint_rest_poses_size =
-      num_soa_joints * sizeof(math::SoaTransform);
-  const size_t names_size = _num_joints * sizeof(char*);
-  const size_t joint_parents_size = _num_joints * sizeof(int16_t);
-  const size_t buffer_size =
-      names_size + _chars_size + joint_parents_size + joint_rest_poses_size;
-
-  // Allocates whole buffer.
-  span<byte> buffer = {static_cast<byte*>(memory::default_allocator()->Allocate(
-                           buffer_size, alignof(math::SoaTransform))),
-                       buffer_size};
 
   // Serves larger alignment values first.
   // Rest pose first, biggest alignment.
-  joint_rest_poses_ = fill_span<math::SoaTransform>(buffer, num_soa_joints);
+  joint_rest_poses_ = fill_span<math::SoaTransform>(_buffer, num_soa_joints);
+
+  // Bind pose matrices share rest pose alignment.
+  joint_bind_poses_ = fill_span<math::Float4x4>(_buffer, _num_joints);
+  joint_inverse_bind_poses_ = fill_span<math::Float4x4>(_buffer, _num_joints);
 
   // Then names array, second biggest alignment.
-  joint_names_ = fill_span<char*>(buffer, _num_joints);
+  joint_names_ = fill_span<char*>(_buffer, _num_joints);
 
-  // Parents, third biggest alignment.
-  joint_parents_ = fill_span<int16_t>(buffer, _num_joints);
+  // Name hashes, third biggest alignment.
+  joint_name_hashes_ = fill_span<uint32_t>(_buffer, _num_joints);
+
+  // Parents, subtree ranges and sorted name index, fourth biggest alignment.
+  joint_parents_ = fill_span<int16_t>(_buffer, _num_joints);
+  joint_subtree_ends_ = fill_span<int16_t>(_buffer, _num_joints);
+  joint_depths_ = fill_span<int16_t>(_buffer, _num_joints);
+  joint_name_sorted_ = fill_span<int16_t>(_buffer, _num_joints);
 
   // Remaning buffer will be used to store joint names.
-  assert(buffer.size_bytes() == _chars_size &&
+  assert(_buffer.size_bytes() == _chars_size &&
          "Whole buffer should be consumned");
-  return reinterpret_cast<char*>(buffer.data());
+  return reinterpret_cast<char*>(_buffer.data());
 }
 
 void Skeleton::Deallocate() {
-  memory::default_allocator()->Deallocate(
-      as_writable_bytes(joint_rest_poses_).data());
+  if (owns_buffer_) {
+    memory::default_allocator()->Deallocate(
+        as_writable_bytes(joint_rest_poses_).data());
+  } else if (owns_names_) {
+    // The skeleton is bound to an external image, only the joint name
+    // pointer array was allocated, see LoadRaw.
+    memory::default_allocator()->Deallocate(joint_names_.data());
+  }
+  owns_buffer_ = true;
+  owns_names_ = true;
   joint_rest_poses_ = {};
+  joint_bind_poses_ = {};
+  joint_inverse_bind_poses_ = {};
   joint_names_ = {};
   joint_parents_ = {};
+  joint_subtree_ends_ = {};
+  joint_depths_ = {};
+  joint_name_hashes_ = {};
+  joint_name_sorted_ = {};
+  structural_hash_ = 0;
+}
+
+namespace {
+// Header of a relocatable skeleton image, followed by the skeleton data
+// block. All fields are stored with native endianness and layout.
+struct SkeletonImageHeader {
+  char tag[12];
+  uint32_t version;
+  uint32_t num_joints;
+  uint32_t chars_size;
+  uint32_t structural_hash;
+  uint32_t padding;
+};
+static_assert(sizeof(SkeletonImageHeader) % alignof(math::SoaTransform) == 0,
+              "Data block alignment follows from header size.");
+
+const char kSkeletonImageTag[12] = "ozz-raw-skl";
+// Version 2: adds subtree end and depth arrays to the data block.
+const uint32_t kSkeletonImageVersion = 2;
+
+// Size in bytes of the concatenated joint names of _skeleton.
+size_t CharsSize(const Skeleton& _skeleton) {
+  size_t chars_size = 0;
+  for (const char* name : _skeleton.joint_names()) {
+    chars_size += std::strlen(name) + 1;
+  }
+  return chars_size;
+}
+}  // namespace
+
+size_t Skeleton::raw_size() const {
+  const size_t num_joints = static_cast<size_t>(this->num_joints());
+  if (num_joints == 0) {
+    return sizeof(SkeletonImageHeader);
+  }
+  return sizeof(SkeletonImageHeader) + RequiredSize(CharsSize(*this), num_joints);
+}
+
+bool Skeleton::SaveRaw(span<byte> _buffer) const {
+  const size_t size = raw_size();
+  if (_buffer.size() < size) {
+    return false;
+  }
+
+  // Fills and stores the header.
+  SkeletonImageHeader header = {};
+  std::memcpy(header.tag, kSkeletonImageTag, sizeof(header.tag));
+  header.version = kSkeletonImageVersion;
+  header.num_joints = static_cast<uint32_t>(num_joints());
+  header.chars_size = static_cast<uint32_t>(num_joints() ? CharsSize(*this) : 0);
+  header.structural_hash = structural_hash_;
+  std::memcpy(_buffer.data(), &header, sizeof(header));
+
+  // Copies the data block verbatim. It is contiguous by construction,
+  // starting at the rest poses buffer, see Bind. The joint name pointer
+  // array it contains is meaningless in the image, LoadRaw rebuilds it.
+  const size_t data_size = size - sizeof(header);
+  if (data_size > 0) {
+    std::memcpy(_buffer.data() + sizeof(header),
+                as_bytes(joint_rest_poses_).data(), data_size);
+  }
+  return true;
+}
+
+bool Skeleton::LoadRaw(span<const byte> _buffer) {
+  // Destroy skeleton in case it was already used before.
+  Deallocate();
+
+  // Validates header.
+  if (_buffer.size() < sizeof(SkeletonImageHeader) ||
+      !IsAligned(_buffer.data(), alignof(math::SoaTransform))) {
+    return false;
+  }
+  SkeletonImageHeader header;
+  std::memcpy(&header, _buffer.data(), sizeof(header));
+  if (std::memcmp(header.tag, kSkeletonImageTag, sizeof(header.tag)) != 0 ||
+      header.version != kSkeletonImageVersion || header.num_joints > kMaxJoints) {
+    return false;
+  }
+
+  // Early out if skeleton's empty.
+  if (header.num_joints == 0) {
+    return true;
+  }
+
+  const size_t data_size = RequiredSize(header.chars_size, header.num_joints);
+  if (_buffer.size() < sizeof(header) + data_size || header.chars_size == 0 ||
+      _buffer[sizeof(header) + data_size - 1] != 0) {
+    return false;  // Names must close the data block with a terminator.
+  }
+
+  // Binds spans into the image data block. The buffer is referenced but
+  // never written, it's only reachable through const accessors.
+  const char* chars =
+      Bind({const_cast<byte*>(_buffer.data()) + sizeof(header), data_size},
+           header.chars_size, header.num_joints);
+
+  // Pointers can't be relocated from a read-only image, so the joint name
+  // pointer array is the only per-process allocation: rebuilt by walking the
+  // concatenated names.
+  const memory::AllocationScope scope(memory::AllocationTag::kSkeleton);
+  char** const names = static_cast<char**>(memory::default_allocator()->Allocate(
+      header.num_joints * sizeof(char*), alignof(char*)));
+  joint_names_ = {names, header.num_joints};
+  owns_buffer_ = false;
+
+  const char* cursor = chars;
+  const char* chars_end = chars + header.chars_size;
+  for (uint32_t i = 0; i < header.num_joints; ++i) {
+    if (cursor >= chars_end) {  // Not enough names in the image.
+      Deallocate();
+      return false;
+    }
+    joint_names_[i] = const_cast<char*>(cursor);
+    cursor += std::strlen(cursor) + 1;
+  }
+
+  structural_hash_ = header.structural_hash;
+  return true;
+}
+
+void Skeleton::ComputeStructuralHash() {
+  // fnv1a over every joint parent index. The joint count is implicit, as it
+  // drives the number of consumed parents.
+  uint32_t hash = 2166136261u;
+  for (const int16_t parent : joint_parents_) {
+    hash = (hash ^ static_cast<uint8_t>(parent)) * 16777619u;
+    hash = (hash ^ static_cast<uint8_t>(parent >> 8)) * 16777619u;
+  }
+  structural_hash_ = hash;
+}
+
+void Skeleton::ComputeSubtreeRanges() {
+  const int num_joints = this->num_joints();
+
+  // Depth is the parent's + 1. Parents are stored before their children
+  // (depth-first order), so a forward pass reads finalized parent depths.
+  for (int i = 0; i < num_joints; ++i) {
+    const int16_t parent = joint_parents_[i];
+    joint_depths_[i] = parent == kNoParent ? 0 : joint_depths_[parent] + 1;
+    joint_subtree_ends_[i] = static_cast<int16_t>(i + 1);
+  }
+
+  // A joint's subtree ends where its last child's subtree does. Children are
+  // stored after their parent, so a backward pass reads finalized children
+  // ends.
+  for (int i = num_joints - 1; i > 0; --i) {
+    const int16_t parent = joint_parents_[i];
+    if (parent != kNoParent) {
+      joint_subtree_ends_[parent] =
+          math::Max(joint_subtree_ends_[parent], joint_subtree_ends_[i]);
+    }
+  }
+}
+
+void Skeleton::ComputeBindPoses() {
+  // The model-space bind pose is the rest pose gone through local-to-model
+  // conversion, ie. what every skinning consumer used to recompute at load
+  // time.
+  LocalToModelJob ltm_job;
+  ltm_job.skeleton = this;
+  ltm_job.input = joint_rest_poses_;
+  ltm_job.output = joint_bind_poses_;
+  const bool success = ltm_job.Run();
+  (void)success;
+  assert(success);
+
+  for (size_t i = 0; i < joint_bind_poses_.size(); ++i) {
+    joint_inverse_bind_poses_[i] = math::Invert(joint_bind_poses_[i]);
+  }
+}
+
+uint32_t Skeleton::JointNameHash(const char* _name) {
+  uint32_t hash = 2166136261u;
+  for (; *_name; ++_name) {
+    hash = (hash ^ static_cast<uint8_t>(*_name)) * 16777619u;
+  }
+  return hash;
+}
+
+void Skeleton::BuildJointNameIndex() {
+  const int num_joints = this->num_joints();
+  for (int i = 0; i < num_joints; ++i) {
+    joint_name_sorted_[i] = static_cast<int16_t>(i);
+  }
+  // Sorts by hash, then by name so equal hashes runs are deterministic.
+  std::sort(joint_name_sorted_.begin(), joint_name_sorted_.end(),
+            [this](int16_t _left, int16_t _right) {
+              const uint32_t left_hash = JointNameHash(joint_names_[_left]);
+              const uint32_t right_hash = JointNameHash(joint_names_[_right]);
+              if (left_hash != right_hash) {
+                return left_hash < right_hash;
+              }
+              return std::strcmp(joint_names_[_left], joint_names_[_right]) < 0;
+            });
+  for (int i = 0; i < num_joints; ++i) {
+    joint_name_hashes_[i] = JointNameHash(joint_names_[joint_name_sorted_[i]]);
+  }
+}
+
+int Skeleton::FindJoint(const char* _name) const {
+  const uint32_t hash = JointNameHash(_name);
+  const uint32_t* found = std::lower_bound(joint_name_hashes_.begin(),
+                                           joint_name_hashes_.end(), hash);
+  // Solves hash collisions with a string comparison over the equal hashes
+  // run. Runs are nearly always a single entry long.
+  for (size_t i = found - joint_name_hashes_.begin();
+       i < joint_name_hashes_.size() && joint_name_hashes_[i] == hash; ++i) {
+    const int16_t joint = joint_name_sorted_[i];
+    if (std::strcmp(joint_names_[joint], _name) == 0) {
+      return joint;
+    }
+  }
+  return -1;
 }
 
 void Skeleton::Save(ozz::io::OArchive& _archive) const {
@@ -126,13 +411,17 @@ void Skeleton::Save(ozz::io::OArchive& _archive) const {
   _archive << ozz::io::MakeArray(joint_names_[0], chars_count);
   _archive << ozz::io::MakeArray(joint_parents_);
   _archive << ozz::io::MakeArray(joint_rest_poses_);
+  _archive << ozz::io::MakeArray(joint_name_hashes_);
+  _archive << ozz::io::MakeArray(joint_name_sorted_);
+  _archive << ozz::io::MakeArray(joint_bind_poses_);
+  _archive << ozz::io::MakeArray(joint_inverse_bind_poses_);
 }
 
 void Skeleton::Load(ozz::io::IArchive& _archive, uint32_t _version) {
   // Deallocate skeleton in case it was already used before.
   Deallocate();
 
-  if (_version != 2) {
+  if (_version < 2 || _version > 4) {
     log::Err() << "Unsupported Skeleton version " << _version << "."
                << std::endl;
     return;
@@ -163,6 +452,66 @@ void Skeleton::Load(ozz::io::IArchive& _archive, uint32_t _version) {
 
   _archive >> ozz::io::MakeArray(joint_parents_);
   _archive >> ozz::io::MakeArray(joint_rest_poses_);
+
+  // The structural hash and subtree ranges are deterministic from the
+  // parents, hence recomputed rather than serialized.
+  ComputeStructuralHash();
+  ComputeSubtreeRanges();
+
+  // Name index was introduced with version 3, it is rebuilt from names for
+  // older archives.
+  if (_version >= 3) {
+    _archive >> ozz::io::MakeArray(joint_name_hashes_);
+    _archive >> ozz::io::MakeArray(joint_name_sorted_);
+  } else {
+    BuildJointNameIndex();
+  }
+
+  // Bind pose matrices were introduced with version 4, they are recomputed
+  // from the rest pose for older archives.
+  if (_version >= 4) {
+    _archive >> ozz::io::MakeArray(joint_bind_poses_);
+    _archive >> ozz::io::MakeArray(joint_inverse_bind_poses_);
+  } else {
+    ComputeBindPoses();
+  }
+}
+
+size_t Skeleton::SizeOf(ozz::io::IArchive& _archive) {
+  // Reads ahead (tag, version, joint and name character counts), then rewinds
+  // as if nothing was read, so the upcoming load still finds the whole
+  // skeleton.
+  const ozz::io::IArchive::ReadState state = _archive.Mark();
+  size_t size = 0;
+  if (ozz::io::internal::Tagger<const Skeleton>::Validate(_archive)) {
+    uint32_t version;
+    _archive >> version;
+    if (version >= 2 && version <= 4) {
+      int32_t num_joints;
+      _archive >> num_joints;
+      if (num_joints) {
+        int32_t chars_count;
+        _archive >> chars_count;
+        size = RequiredSize(chars_count, num_joints);
+      }
+    }
+  }
+  _archive.Rewind(state);
+  return size;
+}
+
+bool Skeleton::Load(ozz::io::IArchive& _archive, span<byte> _buffer) {
+  const size_t required = SizeOf(_archive);
+  if (required == 0 || _buffer.size() < required ||
+      !IsAligned(_buffer.data(), alignof(math::SoaTransform))) {
+    return false;
+  }
+
+  // Routes the regular load path to the caller-provided buffer, see Allocate.
+  placement_buffer_ = _buffer;
+  _archive >> *this;
+  placement_buffer_ = {};
+  return true;
 }
 }  // namespace animation
 }  // namespace ozz
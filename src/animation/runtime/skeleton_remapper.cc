@@ -0,0 +1,141 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/skeleton_remapper.h"
+
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/animation/runtime/skeleton_utils.h"
+#include "ozz/base/maths/math_ex.h"
+#include "ozz/base/maths/simd_math.h"
+#include "ozz/base/maths/transform.h"
+
+namespace ozz {
+namespace animation {
+
+SkeletonRemapper::SkeletonRemapper(const Skeleton& _source,
+                                   const Skeleton& _dest)
+    : source_num_soa_joints_(static_cast<size_t>(_source.num_soa_joints())),
+      num_matches_(0),
+      valid_(false) {
+  const int num_joints = _dest.num_joints();
+  if (_source.num_joints() == 0 || num_joints == 0) {
+    return;
+  }
+
+  // Matches every destination joint with a source one by name, and
+  // precomputes translation length ratios from rest poses.
+  source_joints_.resize(num_joints, -1);
+  ratios_.resize(num_joints, 1.f);
+  const span<const char* const> dest_names = _dest.joint_names();
+  for (int i = 0; i < num_joints; ++i) {
+    const int source = FindJoint(_source, dest_names[i]);
+    if (source == -1) {
+      continue;
+    }
+    source_joints_[i] = static_cast<int16_t>(source);
+    ++num_matches_;
+
+    // The ratio adapts source bone length to the destination one. A 0 length
+    // source bone (like a root at origin) gets a 1 ratio, copying translation
+    // unscaled.
+    const math::Transform source_rest = GetJointLocalRestPose(_source, source);
+    const math::Transform dest_rest = GetJointLocalRestPose(_dest, i);
+    const float source_len = Length(source_rest.translation);
+    if (source_len > 0.f) {
+      ratios_[i] = Length(dest_rest.translation) / source_len;
+    }
+  }
+
+  // No correspondence at all between the 2 skeletons.
+  if (num_matches_ == 0) {
+    return;
+  }
+
+  // Copies destination rest pose, the fallback for unmatched joints.
+  const span<const math::SoaTransform> rest_poses = _dest.joint_rest_poses();
+  rest_poses_.assign(rest_poses.begin(), rest_poses.end());
+
+  valid_ = true;
+}
+
+bool SkeletonRemapper::Run(
+    const span<const math::SoaTransform>& _source_pose,
+    const span<math::SoaTransform>& _dest_pose) const {
+  if (!valid_) {
+    return false;
+  }
+  if (_source_pose.size() < source_num_soa_joints_ ||
+      _dest_pose.size() < rest_poses_.size()) {
+    return false;
+  }
+
+  const size_t num_joints = source_joints_.size();
+  for (size_t s = 0; s < rest_poses_.size(); ++s) {
+    // Transposes the destination rest pose soa element to aos lanes, the
+    // fallback for unmatched joints (and untouched padding lanes).
+    const math::SoaTransform& rest = rest_poses_[s];
+    math::SimdFloat4 translations[4];
+    math::Transpose3x4(&rest.translation.x, translations);
+    math::SimdFloat4 rotations[4];
+    math::Transpose4x4(&rest.rotation.x, rotations);
+    math::SimdFloat4 scales[4];
+    math::Transpose3x4(&rest.scale.x, scales);
+
+    // Gathers matched source joints into the 4 lanes.
+    const size_t lanes = math::Min(num_joints - s * 4, size_t(4));
+    for (size_t j = 0; j < lanes; ++j) {
+      const size_t dest_joint = s * 4 + j;
+      const int source = source_joints_[dest_joint];
+      if (source < 0) {
+        continue;
+      }
+      const math::SoaTransform& source_soa = _source_pose[source / 4];
+      math::SimdFloat4 source_translations[4];
+      math::Transpose3x4(&source_soa.translation.x, source_translations);
+      math::SimdFloat4 source_rotations[4];
+      math::Transpose4x4(&source_soa.rotation.x, source_rotations);
+      math::SimdFloat4 source_scales[4];
+      math::Transpose3x4(&source_soa.scale.x, source_scales);
+
+      const int lane = source % 4;
+      translations[j] = source_translations[lane] *
+                        math::simd_float4::Load1(ratios_[dest_joint]);
+      rotations[j] = source_rotations[lane];
+      scales[j] = source_scales[lane];
+    }
+
+    // Transposes lanes back to the destination soa element.
+    math::SoaTransform& dest = _dest_pose[s];
+    math::Transpose4x3(translations, &dest.translation.x);
+    math::Transpose4x4(rotations, &dest.rotation.x);
+    math::Transpose4x3(scales, &dest.scale.x);
+  }
+
+  return true;
+}
+}  // namespace animation
+}  // namespace ozz
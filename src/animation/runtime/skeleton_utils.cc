@@ -31,19 +31,158 @@
 
 #include <cstring>
 
+#include "ozz/base/maths/math_ex.h"
 #include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/maths/soa_transform_conversion.h"
 
 namespace ozz {
 namespace animation {
 
+int PartitionJoints(const Skeleton& _skeleton,
+                    const span<JointsRange>& _ranges) {
+  assert(_ranges.size() >= 2 && "At least 2 ranges are required.");
+
+  const int num_joints = _skeleton.num_joints();
+  if (num_joints == 0) {
+    return 0;
+  }
+
+  const span<const int16_t>& parents = _skeleton.joint_parents();
+  const int max_subtrees = static_cast<int>(_ranges.size()) - 1;
+
+  // For a trunk [0, s[, independent subtrees are rooted at every joint j >= s
+  // whose parent is inside the trunk. Thanks to the depth-first ordering,
+  // moving the split point from s to s + 1 removes joint s from the subtree
+  // roots (its parent is always < s) and promotes its direct children
+  // instead. This allows scanning all split points, looking for the smallest
+  // trunk that maximizes subtree count without exceeding _ranges capacity.
+  int best_split = 0;
+  int best_count = 0;
+  int count = 0;
+  for (int i = 0; i < num_joints; ++i) {
+    count += parents[i] == Skeleton::kNoParent;  // Split point 0: the roots.
+  }
+  for (int s = 0; s < num_joints; ++s) {
+    if (count > best_count && count <= max_subtrees) {
+      best_split = s;
+      best_count = count;
+      if (count == max_subtrees) {
+        break;  // Can't do any better.
+      }
+    }
+    // Steps split point to s + 1: removes joint s, adds its direct children.
+    --count;
+    for (int j = s + 1; j < num_joints; ++j) {
+      count += parents[j] == s;
+    }
+  }
+
+  // Writes the sequential trunk range. It can be empty (to == -1), in which
+  // case the matching job is a no-op.
+  int num_ranges = 0;
+  _ranges[num_ranges++] = {Skeleton::kNoParent,
+                           static_cast<int16_t>(best_split - 1)};
+
+  // Writes independent subtree ranges.
+  for (int j = best_split; j < num_joints;) {
+    // Joints of the subtree rooted at j are contiguous, ending at the first
+    // joint whose parent is before j.
+    int end = j + 1;
+    for (; end < num_joints && parents[end] >= j; ++end) {
+    }
+    assert(num_ranges <= max_subtrees && "Subtree count exceeds capacity.");
+    _ranges[num_ranges++] = {static_cast<int16_t>(j),
+                             static_cast<int16_t>(end - 1)};
+    j = end;
+  }
+
+  return num_ranges;
+}
+
+int GetJointDepths(const Skeleton& _skeleton, const span<int16_t>& _depths) {
+  const int num_joints = _skeleton.num_joints();
+  assert(static_cast<int>(_depths.size()) >= num_joints &&
+         "_depths is too small.");
+
+  const span<const int16_t>& parents = _skeleton.joint_parents();
+  int max_depth = -1;
+  for (int i = 0; i < num_joints; ++i) {
+    // Depth-first ordering guarantees parents are processed before children.
+    const int16_t parent = parents[i];
+    const int16_t depth =
+        parent == Skeleton::kNoParent ? 0 : _depths[parent] + 1;
+    _depths[i] = depth;
+    max_depth = math::Max(max_depth, static_cast<int>(depth));
+  }
+  return max_depth;
+}
+
+int BuildLodJointMask(const Skeleton& _skeleton,
+                      const span<const int16_t>& _levels, int _level,
+                      const span<byte>& _mask) {
+  const int num_joints = _skeleton.num_joints();
+  const int num_blocks = (num_joints + 3) / 4;
+  const int num_bytes = (num_blocks + 7) / 8;
+  assert(static_cast<int>(_levels.size()) >= num_joints &&
+         "_levels is too small.");
+  assert(static_cast<int>(_mask.size()) >= num_bytes &&
+         "_mask is too small.");
+
+  // Selects every block containing at least one joint of the subset.
+  memset(_mask.data(), 0, num_bytes);
+  for (int i = 0; i < num_joints; ++i) {
+    if (_levels[i] <= _level) {
+      const int block = i / 4;
+      _mask[block / 8] |= static_cast<byte>(1 << (block & 7));
+    }
+  }
+
+  // Closes the selection over parents: selecting a block selects its joints'
+  // lane mates too, whose parents can live in unselected blocks. Iterating in
+  // reverse order reaches the closure in a single pass, as a block selected
+  // while processing joint i only contains joints before i (a parent's block
+  // never comes after its child's one).
+  const span<const int16_t>& parents = _skeleton.joint_parents();
+  for (int i = num_joints - 1; i >= 0; --i) {
+    const int block = i / 4;
+    const int16_t parent = parents[i];
+    if (parent != Skeleton::kNoParent &&
+        (_mask[block / 8] >> (block & 7)) & 1) {
+      _mask[(parent / 4) / 8] |= static_cast<byte>(1 << ((parent / 4) & 7));
+    }
+  }
+
+  // Counts selected blocks.
+  int num_selected = 0;
+  for (int i = 0; i < num_blocks; ++i) {
+    num_selected += (_mask[i / 8] >> (i & 7)) & 1;
+  }
+  return num_selected;
+}
+
 int FindJoint(const Skeleton& _skeleton, const char* _name) {
-  const auto& names = _skeleton.joint_names();
-  for (size_t i = 0; i < names.size(); ++i) {
-    if (std::strcmp(names[i], _name) == 0) {
-      return static_cast<int>(i);
+  // Defers to the skeleton precomputed name index.
+  return _skeleton.FindJoint(_name);
+}
+
+bool BuildJointPermutation(const Skeleton& _source, const Skeleton& _target,
+                           const span<uint16_t>& _permutation) {
+  const int num_joints = _target.num_joints();
+  if (_source.num_joints() != num_joints ||
+      _permutation.size() < static_cast<size_t>(num_joints)) {
+    return false;
+  }
+
+  // Same joint count, so matching every target name guarantees a bijection.
+  const span<const char* const> names = _target.joint_names();
+  for (int i = 0; i < num_joints; ++i) {
+    const int source = _source.FindJoint(names[i]);
+    if (source < 0) {
+      return false;
     }
+    _permutation[i] = static_cast<uint16_t>(source);
   }
-  return -1;
+  return true;
 }
 
 // Unpacks skeleton rest pose stored in soa format by the skeleton.
@@ -52,25 +191,43 @@ ozz::math::Transform GetJointLocalRestPose(const Skeleton& _skeleton,
   assert(_joint >= 0 && _joint < _skeleton.num_joints() &&
          "Joint index out of range.");
 
-  const ozz::math::SoaTransform& soa_transform =
-      _skeleton.joint_rest_poses()[_joint / 4];
-
-  // Transpose SoA data to AoS.
-  ozz::math::SimdFloat4 translations[4];
-  ozz::math::Transpose3x4(&soa_transform.translation.x, translations);
-  ozz::math::SimdFloat4 rotations[4];
-  ozz::math::Transpose4x4(&soa_transform.rotation.x, rotations);
-  ozz::math::SimdFloat4 scales[4];
-  ozz::math::Transpose3x4(&soa_transform.scale.x, scales);
-
-  // Stores to the Transform object.
-  math::Transform rest_pose;
-  const int offset = _joint % 4;
-  ozz::math::Store3PtrU(translations[offset], &rest_pose.translation.x);
-  ozz::math::StorePtrU(rotations[offset], &rest_pose.rotation.x);
-  ozz::math::Store3PtrU(scales[offset], &rest_pose.scale.x);
-
-  return rest_pose;
+  // Defers to the soa gathering utility.
+  return ozz::math::GatherTransform(_skeleton.joint_rest_poses()[_joint / 4],
+                                    _joint % 4);
+}
+
+void GetJointLocalRestPoses(const Skeleton& _skeleton,
+                            const span<ozz::math::Transform>& _rest_poses,
+                            int _from) {
+  const int num = static_cast<int>(_rest_poses.size());
+  assert(_from >= 0 && _from + num <= _skeleton.num_joints() &&
+         "Joint range out of range.");
+
+  const span<const ozz::math::SoaTransform>& soa_transforms =
+      _skeleton.joint_rest_poses();
+
+  const int end = _from + num;
+  for (int i = _from; i < end;) {
+    // Transposes a whole SoA block to AoS at once.
+    const ozz::math::SoaTransform& soa_transform = soa_transforms[i / 4];
+    ozz::math::SimdFloat4 translations[4];
+    ozz::math::Transpose3x4(&soa_transform.translation.x, translations);
+    ozz::math::SimdFloat4 rotations[4];
+    ozz::math::Transpose4x4(&soa_transform.rotation.x, rotations);
+    ozz::math::SimdFloat4 scales[4];
+    ozz::math::Transpose3x4(&soa_transform.scale.x, scales);
+
+    // Stores the block joints that are in range, boundary blocks can be
+    // partial.
+    const int last = math::Min(end, i - i % 4 + 4);
+    for (; i < last; ++i) {
+      ozz::math::Transform& rest_pose = _rest_poses[i - _from];
+      const int offset = i % 4;
+      ozz::math::Store3PtrU(translations[offset], &rest_pose.translation.x);
+      ozz::math::StorePtrU(rotations[offset], &rest_pose.rotation.x);
+      ozz::math::Store3PtrU(scales[offset], &rest_pose.scale.x);
+    }
+  }
 }
 }  // namespace animation
 }  // namespace ozz
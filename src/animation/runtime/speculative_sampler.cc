@@ -0,0 +1,151 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/speculative_sampler.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/animation/runtime/pose_lerp_job.h"
+
+namespace ozz {
+namespace animation {
+
+namespace {
+// Prediction errors below this threshold count as exact matches, absorbing
+// float accumulation noise between the predicted and actual ratios.
+const float kSpeculationExactTolerance = 1e-6f;
+}  // namespace
+
+SpeculativeSampler::SpeculativeSampler() {}
+
+SpeculativeSampler::~SpeculativeSampler() {}
+
+void SpeculativeSampler::Resize(int _max_tracks) {
+  contexts_[0].Resize(_max_tracks);
+  contexts_[1].Resize(_max_tracks);
+  const size_t num_soa_tracks = (static_cast<size_t>(_max_tracks) + 3) / 4;
+  speculative_pose_.resize(num_soa_tracks);
+  last_pose_.resize(num_soa_tracks);
+  speculated_animation_ = nullptr;
+  last_animation_ = nullptr;
+  authoritative_ = 0;
+}
+
+bool SpeculativeSampler::Sample(const Animation& _animation, float _ratio,
+                                span<math::SoaTransform> _output) {
+  SamplingJob job;
+  job.animation = &_animation;
+  job.context = &contexts_[authoritative_];
+  job.ratio = _ratio;
+  job.output = _output;
+  return job.Run();
+}
+
+bool SpeculativeSampler::Presample(const Animation& _animation,
+                                   float _predicted_ratio) {
+  speculated_animation_ = nullptr;
+  if (_animation.num_soa_tracks() >
+      static_cast<int>(speculative_pose_.size())) {
+    return false;
+  }
+
+  // Forks the authoritative cursor, so stepping it for the speculated ratio
+  // leaves the authoritative timeline untouched.
+  SamplingJob::Context& speculative = contexts_[authoritative_ ^ 1];
+  speculative.CopyFrom(contexts_[authoritative_]);
+
+  SamplingJob job;
+  job.animation = &_animation;
+  job.context = &speculative;
+  job.ratio = _predicted_ratio;
+  job.output = make_span(speculative_pose_);
+  if (!job.Run()) {
+    return false;
+  }
+
+  speculated_animation_ = &_animation;
+  speculated_ratio_ = _predicted_ratio;
+  return true;
+}
+
+SpeculativeSampler::Result SpeculativeSampler::Resolve(
+    const Animation& _animation, float _ratio,
+    span<math::SoaTransform> _output) {
+  const size_t num_soa_tracks =
+      static_cast<size_t>(_animation.num_soa_tracks());
+  if (num_soa_tracks > last_pose_.size() || _output.size() < num_soa_tracks) {
+    return kInvalid;
+  }
+
+  // Speculation is consumed whatever the outcome.
+  const Animation* speculated = speculated_animation_;
+  speculated_animation_ = nullptr;
+
+  Result result = kSampled;
+  const span<math::SoaTransform> pose = _output.first(num_soa_tracks);
+  const float error =
+      speculated == &_animation ? std::abs(_ratio - speculated_ratio_) : 0.f;
+  if (speculated == &_animation && error <= kSpeculationExactTolerance) {
+    // Exact prediction, consumes the presampled pose and promotes the
+    // speculative cursor to authoritative.
+    std::memcpy(pose.data(), speculative_pose_.data(), pose.size_bytes());
+    authoritative_ ^= 1;
+    result = kConsumed;
+  } else if (speculated == &_animation && error <= max_correction &&
+             last_animation_ == &_animation &&
+             std::abs(speculated_ratio_ - last_ratio_) > 0.f) {
+    // Near miss, interpolates between the last resolved pose and the
+    // speculative one. The speculative cursor is promoted too, its next
+    // (forward) step from the speculated ratio is cheap.
+    PoseLerpJob lerp;
+    lerp.alpha = (_ratio - last_ratio_) / (speculated_ratio_ - last_ratio_);
+    lerp.from = make_span(last_pose_).first(num_soa_tracks);
+    lerp.to = make_span(speculative_pose_).first(num_soa_tracks);
+    lerp.output = pose;
+    if (!lerp.Run()) {
+      return kInvalid;
+    }
+    authoritative_ ^= 1;
+    result = kCorrected;
+  } else {
+    // Miss or no speculation, falls back to a regular sample on the
+    // authoritative cursor.
+    if (!Sample(_animation, _ratio, pose)) {
+      return kInvalid;
+    }
+  }
+
+  // Stores the resolved pose, the correction start point for next frame.
+  std::memcpy(last_pose_.data(), pose.data(), pose.size_bytes());
+  last_ratio_ = _ratio;
+  last_animation_ = &_animation;
+  return result;
+}
+}  // namespace animation
+}  // namespace ozz
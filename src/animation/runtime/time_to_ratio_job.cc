@@ -0,0 +1,165 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/time_to_ratio_job.h"
+
+#include <cstring>
+
+#include "ozz/base/maths/simd_math.h"
+
+namespace ozz {
+namespace animation {
+
+namespace {
+// Per lane floor, from truncation adjusted for negative non integer values.
+OZZ_INLINE math::SimdFloat4 Floor(math::_SimdFloat4 _v) {
+  const math::SimdFloat4 truncated =
+      math::simd_float4::FromInt(math::simd_int4::FromFloatTrunc(_v));
+  return math::Select(math::CmpGt(truncated, _v),
+                      truncated - math::simd_float4::one(), truncated);
+}
+}  // namespace
+
+TimeToRatioJob::TimeToRatioJob() : dt(0.f), loop_mode(kLoop) {}
+
+bool TimeToRatioJob::Validate() const {
+  bool valid = true;
+  valid &= !phases.empty();
+  valid &= durations.size() == phases.size();
+  valid &= speeds.empty() || speeds.size() == phases.size();
+  valid &= output_phases.size() >= phases.size();
+  valid &= ratios.size() >= phases.size();
+  valid &= trigger_tos.empty() ||
+           (trigger_tos.size() >= phases.size() && loop_mode != kPingPong);
+  valid &= wrap_flags.empty() || wrap_flags.size() >= (phases.size() + 7) / 8;
+  return valid;
+}
+
+bool TimeToRatioJob::Run() const {
+  // Exit with an error if job is invalid.
+  if (!Validate()) {
+    return false;
+  }
+
+  const math::SimdFloat4 zero = math::simd_float4::zero();
+  const math::SimdFloat4 one = math::simd_float4::one();
+  const math::SimdFloat4 two = one + one;
+  const math::SimdFloat4 dt4 = math::simd_float4::Load1(dt);
+
+  const size_t count = phases.size();
+  if (!wrap_flags.empty()) {
+    std::memset(wrap_flags.data(), 0, (count + 7) / 8);
+  }
+
+  for (size_t i = 0; i < count; i += 4) {
+    const size_t remaining = count - i;
+
+    // Loads 4 instances, going through a stack pad (neutral values, so pad
+    // lanes wrap and flag nothing) when fewer than 4 remain.
+    math::SimdFloat4 phase, duration, speed;
+    if (remaining >= 4) {
+      phase = math::simd_float4::LoadPtrU(phases.data() + i);
+      duration = math::simd_float4::LoadPtrU(durations.data() + i);
+      speed = speeds.empty() ? one
+                             : math::simd_float4::LoadPtrU(speeds.data() + i);
+    } else {
+      float pad_phase[4] = {};
+      float pad_duration[4] = {1.f, 1.f, 1.f, 1.f};
+      float pad_speed[4] = {};
+      for (size_t j = 0; j < remaining; ++j) {
+        pad_phase[j] = phases[i + j];
+        pad_duration[j] = durations[i + j];
+        pad_speed[j] = speeds.empty() ? 1.f : speeds[i + j];
+      }
+      phase = math::simd_float4::LoadPtrU(pad_phase);
+      duration = math::simd_float4::LoadPtrU(pad_duration);
+      speed = math::simd_float4::LoadPtrU(pad_speed);
+    }
+
+    const math::SimdFloat4 raw = phase + dt4 * speed / duration;
+
+    math::SimdFloat4 new_phase, ratio, trigger_to;
+    math::SimdInt4 wrapped;
+    switch (loop_mode) {
+      case kClamp: {
+        new_phase = math::Clamp(zero, raw, one);
+        ratio = new_phase;
+        trigger_to = new_phase;
+        // Saturation counts as a wrap only when the boundary is crossed
+        // during this step, not when pushing against it.
+        wrapped =
+            math::Or(math::And(math::CmpGt(raw, one), math::CmpLt(phase, one)),
+                     math::And(math::CmpLt(raw, zero), math::CmpGt(phase, zero)));
+      } break;
+      case kLoop: {
+        new_phase = raw - Floor(raw);
+        ratio = new_phase;
+        // Unwrapped window end, seams are crossed once by the triggering job.
+        trigger_to = raw;
+        wrapped = math::Or(math::CmpGe(raw, one), math::CmpLt(raw, zero));
+      } break;
+      default: {  // kPingPong
+        new_phase = raw - two * Floor(raw / two);
+        ratio = math::Select(math::CmpLe(new_phase, one), new_phase,
+                             two - new_phase);
+        trigger_to = ratio;  // Unused, trigger_tos is empty, see Validate.
+        // Reflections happen on every integer boundary of the [0,2[ cycle.
+        wrapped = math::CmpNe(Floor(raw), Floor(phase));
+      } break;
+    }
+
+    // Stores 4 instances, through the stack pad for the last partial chunk.
+    if (remaining >= 4) {
+      math::StorePtrU(new_phase, output_phases.data() + i);
+      math::StorePtrU(ratio, ratios.data() + i);
+      if (!trigger_tos.empty()) {
+        math::StorePtrU(trigger_to, trigger_tos.data() + i);
+      }
+    } else {
+      float pad_phase[4], pad_ratio[4], pad_trigger[4];
+      math::StorePtrU(new_phase, pad_phase);
+      math::StorePtrU(ratio, pad_ratio);
+      math::StorePtrU(trigger_to, pad_trigger);
+      for (size_t j = 0; j < remaining; ++j) {
+        output_phases[i + j] = pad_phase[j];
+        ratios[i + j] = pad_ratio[j];
+        if (!trigger_tos.empty()) {
+          trigger_tos[i + j] = pad_trigger[j];
+        }
+      }
+    }
+
+    if (!wrap_flags.empty()) {
+      wrap_flags[i / 8] = static_cast<byte>(
+          static_cast<int>(wrap_flags[i / 8]) |
+          (math::MoveMask(wrapped) << (i & 7)));
+    }
+  }
+  return true;
+}
+}  // namespace animation
+}  // namespace ozz
@@ -54,6 +54,7 @@ Track<_ValueType>& Track<_ValueType>::operator=(Track<_ValueType>&& _other) {
   std::swap(values_, _other.values_);
   std::swap(steps_, _other.steps_);
   std::swap(name_, _other.name_);
+  std::swap(owns_buffer_, _other.owns_buffer_);
   return *this;
 }
 
@@ -62,6 +63,14 @@ Track<_ValueType>::~Track() {
   Deallocate();
 }
 
+template <typename _ValueType>
+size_t Track<_ValueType>::RequiredSize(size_t _keys_count, size_t _name_len) {
+  return _keys_count * sizeof(_ValueType) +         // values
+         _keys_count * sizeof(float) +              // ratios
+         (_keys_count + 7) * sizeof(uint8_t) / 8 +  // steps
+         (_name_len > 0 ? _name_len + 1 : 0);       // name
+}
+
 template <typename _ValueType>
 void Track<_ValueType>::Allocate(size_t _keys_count, size_t _name_len) {
   assert(ratios_.size() == 0 && values_.size() == 0);
@@ -73,13 +82,22 @@ void Track<_ValueType>::Allocate(size_t _keys_count, size_t _name_len) {
                 "Must serve larger alignment values first)");
 
   // Compute overall size and allocate a single buffer for all the data.
-  const size_t buffer_size = _keys_count * sizeof(_ValueType) +  // values
-                             _keys_count * sizeof(float) +       // ratios
-                             (_keys_count + 7) * sizeof(uint8_t) / 8 +  // steps
-                             (_name_len > 0 ? _name_len + 1 : 0);
-  span<byte> buffer = {static_cast<byte*>(memory::default_allocator()->Allocate(
-                           buffer_size, alignof(_ValueType))),
-                       buffer_size};
+  const size_t buffer_size = RequiredSize(_keys_count, _name_len);
+  span<byte> buffer;
+  if (placement_buffer_.empty()) {
+    const memory::AllocationScope scope(memory::AllocationTag::kAnimation);
+    buffer = {static_cast<byte*>(memory::default_allocator()->Allocate(
+                  buffer_size, alignof(_ValueType))),
+              buffer_size};
+    owns_buffer_ = true;
+  } else {
+    // Placement load path, binds into the caller-provided buffer which was
+    // already validated against RequiredSize, see LoadTrack.
+    assert(placement_buffer_.size() >= buffer_size &&
+           IsAligned(placement_buffer_.data(), alignof(_ValueType)));
+    buffer = {placement_buffer_.data(), buffer_size};
+    owns_buffer_ = false;
+  }
 
   // Fix up pointers. Serves larger alignment values first.
   values_ = fill_span<_ValueType>(buffer, _keys_count);
@@ -96,8 +114,11 @@ void Track<_ValueType>::Allocate(size_t _keys_count, size_t _name_len) {
 
 template <typename _ValueType>
 void Track<_ValueType>::Deallocate() {
-  // Deallocate everything at once.
-  memory::default_allocator()->Deallocate(as_writable_bytes(values_).data());
+  if (owns_buffer_) {
+    // Deallocate everything at once.
+    memory::default_allocator()->Deallocate(as_writable_bytes(values_).data());
+  }
+  owns_buffer_ = true;
 
   values_ = {};
   ratios_ = {};
@@ -163,5 +184,61 @@ template class OZZ_ANIMATION_DLL Track<math::Float4>;
 template class OZZ_ANIMATION_DLL Track<math::Quaternion>;
 
 }  // namespace internal
+
+template <typename _Track>
+size_t SizeOfTrack(ozz::io::IArchive& _archive) {
+  // Reads ahead (tag, version, key and name counts), then rewinds as if
+  // nothing was read, so the upcoming load still finds the whole track.
+  const ozz::io::IArchive::ReadState state = _archive.Mark();
+  size_t size = 0;
+  if (ozz::io::internal::Tagger<const _Track>::Validate(_archive)) {
+    uint32_t version;
+    _archive >> version;
+    if (version <= 1) {
+      uint32_t num_keys;
+      _archive >> num_keys;
+      int32_t name_len;
+      _archive >> name_len;
+      size = internal::Track<typename _Track::ValueType>::RequiredSize(
+          num_keys, name_len);
+    }
+  }
+  _archive.Rewind(state);
+  return size;
+}
+
+template <typename _Track>
+bool LoadTrack(ozz::io::IArchive& _archive, _Track* _track,
+               span<byte> _buffer) {
+  assert(_track != nullptr);
+  const size_t required = SizeOfTrack<_Track>(_archive);
+  if (required == 0 || _buffer.size() < required ||
+      !IsAligned(_buffer.data(), alignof(typename _Track::ValueType))) {
+    return false;
+  }
+
+  // Routes the regular load path to the caller-provided buffer, see Allocate.
+  _track->placement_buffer_ = _buffer;
+  _archive >> *_track;
+  _track->placement_buffer_ = {};
+  return true;
+}
+
+// Explicitly instantiate two-phase loading for supported tracks.
+template size_t SizeOfTrack<FloatTrack>(ozz::io::IArchive&);
+template size_t SizeOfTrack<Float2Track>(ozz::io::IArchive&);
+template size_t SizeOfTrack<Float3Track>(ozz::io::IArchive&);
+template size_t SizeOfTrack<Float4Track>(ozz::io::IArchive&);
+template size_t SizeOfTrack<QuaternionTrack>(ozz::io::IArchive&);
+template bool LoadTrack<FloatTrack>(ozz::io::IArchive&, FloatTrack*,
+                                    span<byte>);
+template bool LoadTrack<Float2Track>(ozz::io::IArchive&, Float2Track*,
+                                     span<byte>);
+template bool LoadTrack<Float3Track>(ozz::io::IArchive&, Float3Track*,
+                                     span<byte>);
+template bool LoadTrack<Float4Track>(ozz::io::IArchive&, Float4Track*,
+                                     span<byte>);
+template bool LoadTrack<QuaternionTrack>(ozz::io::IArchive&, QuaternionTrack*,
+                                         span<byte>);
 }  // namespace animation
 }  // namespace ozz
@@ -0,0 +1,163 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/track_binding.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+
+#include "ozz/animation/runtime/track_soa.h"
+#include "ozz/base/maths/math_ex.h"
+
+namespace ozz {
+namespace animation {
+
+bool TrackBindingSet::Bind(const span<const char* const>& _track_names,
+                           const span<const Target>& _targets) {
+  bindings_.clear();
+  max_track_ = 0;
+  required_size_ = 0;
+
+  bindings_.reserve(_targets.size());
+  for (size_t i = 0; i < _targets.size(); ++i) {
+    const Target& target = _targets[i];
+
+    // Resolves target name to a track index, once for all evaluations.
+    size_t track = 0;
+    for (; track < _track_names.size() &&
+           std::strcmp(_track_names[track], target.name) != 0;
+         ++track) {
+    }
+    if (track == _track_names.size() ||
+        target.offset >= std::numeric_limits<uint32_t>::max()) {
+      bindings_.clear();
+      return false;
+    }
+
+    const Binding binding = {static_cast<uint32_t>(track),
+                             static_cast<uint32_t>(target.offset)};
+    bindings_.push_back(binding);
+    max_track_ = math::Max(max_track_, static_cast<size_t>(binding.track));
+    required_size_ = math::Max(required_size_, target.offset + 1);
+  }
+
+  // Rejects offset collisions, two tracks scattering to the same float is a
+  // target set authoring error. Duplicated names are fine though, a track can
+  // drive any number of properties.
+  ozz::vector<uint32_t> offsets(bindings_.size());
+  for (size_t i = 0; i < bindings_.size(); ++i) {
+    offsets[i] = bindings_[i].offset;
+  }
+  std::sort(offsets.begin(), offsets.end());
+  if (std::adjacent_find(offsets.begin(), offsets.end()) != offsets.end()) {
+    bindings_.clear();
+    max_track_ = 0;
+    required_size_ = 0;
+    return false;
+  }
+
+  return true;
+}
+
+TrackBindingJob::TrackBindingJob()
+    : ratio(0.f), tracks(nullptr), bindings(nullptr) {}
+
+bool TrackBindingJob::Validate() const {
+  bool success = true;
+  success &= tracks != nullptr;
+  success &= bindings != nullptr;
+  success &= tracks == nullptr || bindings == nullptr ||
+             bindings->num_bindings() == 0 ||
+             bindings->max_track_ < tracks->num_tracks();
+  success &= bindings == nullptr || output.size() >= bindings->required_size();
+  return success;
+}
+
+bool TrackBindingJob::Run() const {
+  if (!Validate()) {
+    return false;
+  }
+
+  const ozz::vector<TrackBindingSet::Binding>& bound = bindings->bindings_;
+
+  // Clamps ratio in range [0,1].
+  const float clamped_ratio = math::Clamp(0.f, ratio, 1.f);
+
+  const span<const float> ratios = tracks->ratios();
+  const span<const float> values = tracks->values();
+  const size_t num_tracks = tracks->num_tracks();
+
+  // Default tracks return identity.
+  if (ratios.size() == 0) {
+    for (size_t i = 0; i < bound.size(); ++i) {
+      output[bound[i].offset] = 0.f;
+    }
+    return true;
+  }
+
+  // Search for the first keyframe with a ratio value greater than input
+  // ratio. This single search is shared by all bindings, as all tracks use
+  // the same ratios.
+  const float* ptk1 =
+      std::upper_bound(ratios.begin(), ratios.end(), clamped_ratio);
+
+  // Deduce keys indices.
+  const size_t id1 = ptk1 - ratios.begin();
+  const size_t id0 = id1 - 1;
+  const float* v0 = values.data() + id0 * num_tracks;
+
+  // Beyond the last keyframe, all tracks stick to their last value.
+  if (ptk1 == ratios.end()) {
+    for (size_t i = 0; i < bound.size(); ++i) {
+      output[bound[i].offset] = v0[bound[i].track];
+    }
+    return true;
+  }
+
+  const float tk0 = ratios[id0];
+  const float tk1 = ratios[id1];
+  assert(clamped_ratio >= tk0 && clamped_ratio < tk1 && tk0 != tk1);
+  const float alpha = (clamped_ratio - tk0) / (tk1 - tk0);
+  const float* v1 = values.data() + id1 * num_tracks;
+
+  // Step bits of keyframe id0 select, per track, the held value instead of
+  // the interpolated one. Scattering is inherently scalar, but only bound
+  // tracks are visited.
+  const size_t steps_stride = (num_tracks + 7) / 8;
+  const uint8_t* steps = tracks->steps().data() + id0 * steps_stride;
+  for (size_t i = 0; i < bound.size(); ++i) {
+    const uint32_t track = bound[i].track;
+    const bool step = (steps[track / 8] & (1 << (track & 7))) != 0;
+    output[bound[i].offset] =
+        step ? v0[track] : math::Lerp(v0[track], v1[track], alpha);
+  }
+  return true;
+}
+}  // namespace animation
+}  // namespace ozz
@@ -0,0 +1,159 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/track_bundle.h"
+
+#include <cassert>
+
+#include "ozz/base/io/archive.h"
+#include "ozz/base/log.h"
+#include "ozz/base/maths/math_archive.h"
+#include "ozz/base/memory/allocator.h"
+
+namespace ozz {
+namespace animation {
+
+namespace internal {
+
+template <typename _ValueType>
+TrackBundle<_ValueType>::TrackBundle() {}
+
+template <typename _ValueType>
+TrackBundle<_ValueType>::TrackBundle(TrackBundle<_ValueType>&& _other) {
+  *this = std::move(_other);
+}
+
+template <typename _ValueType>
+TrackBundle<_ValueType>& TrackBundle<_ValueType>::operator=(
+    TrackBundle<_ValueType>&& _other) {
+  std::swap(ratios_, _other.ratios_);
+  std::swap(values_, _other.values_);
+  std::swap(steps_, _other.steps_);
+  std::swap(num_tracks_, _other.num_tracks_);
+  return *this;
+}
+
+template <typename _ValueType>
+TrackBundle<_ValueType>::~TrackBundle() {
+  Deallocate();
+}
+
+template <typename _ValueType>
+void TrackBundle<_ValueType>::Allocate(size_t _keys_count,
+                                       size_t _num_tracks) {
+  assert(ratios_.size() == 0 && values_.size() == 0);
+
+  // Distributes buffer memory while ensuring proper alignment (serves larger
+  // alignment values first).
+  static_assert(alignof(_ValueType) >= alignof(float) &&
+                    alignof(float) >= alignof(uint8_t),
+                "Must serve larger alignment values first)");
+
+  // Compute overall size and allocate a single buffer for all the data.
+  const size_t buffer_size =
+      _keys_count * _num_tracks * sizeof(_ValueType) +  // values
+      _keys_count * sizeof(float) +                     // ratios
+      (_keys_count + 7) / 8;                            // steps
+  const memory::AllocationScope scope(memory::AllocationTag::kAnimation);
+  span<byte> buffer = {static_cast<byte*>(memory::default_allocator()->Allocate(
+                           buffer_size, alignof(_ValueType))),
+                       buffer_size};
+
+  // Fix up pointers. Serves larger alignment values first.
+  values_ = fill_span<_ValueType>(buffer, _keys_count * _num_tracks);
+  ratios_ = fill_span<float>(buffer, _keys_count);
+  steps_ = fill_span<uint8_t>(buffer, (_keys_count + 7) / 8);
+
+  num_tracks_ = _num_tracks;
+
+  assert(buffer.empty() && "Whole buffer should be consumned");
+}
+
+template <typename _ValueType>
+void TrackBundle<_ValueType>::Deallocate() {
+  // Deallocate everything at once.
+  memory::default_allocator()->Deallocate(as_writable_bytes(values_).data());
+
+  values_ = {};
+  ratios_ = {};
+  steps_ = {};
+  num_tracks_ = 0;
+}
+
+template <typename _ValueType>
+size_t TrackBundle<_ValueType>::size() const {
+  const size_t size = sizeof(*this) + values_.size_bytes() +
+                      ratios_.size_bytes() + steps_.size_bytes();
+  return size;
+}
+
+template <typename _ValueType>
+void TrackBundle<_ValueType>::Save(ozz::io::OArchive& _archive) const {
+  const uint32_t num_keys = static_cast<uint32_t>(ratios_.size());
+  _archive << num_keys;
+  const uint32_t num_tracks = static_cast<uint32_t>(num_tracks_);
+  _archive << num_tracks;
+
+  _archive << ozz::io::MakeArray(ratios_);
+  _archive << ozz::io::MakeArray(values_);
+  _archive << ozz::io::MakeArray(steps_);
+}
+
+template <typename _ValueType>
+void TrackBundle<_ValueType>::Load(ozz::io::IArchive& _archive,
+                                   uint32_t _version) {
+  // Destroy the bundle in case it was already used before.
+  Deallocate();
+
+  if (_version > 1) {
+    log::Err() << "Unsupported TrackBundle version " << _version << "."
+               << std::endl;
+    return;
+  }
+
+  uint32_t num_keys;
+  _archive >> num_keys;
+  uint32_t num_tracks;
+  _archive >> num_tracks;
+
+  Allocate(num_keys, num_tracks);
+
+  _archive >> ozz::io::MakeArray(ratios_);
+  _archive >> ozz::io::MakeArray(values_);
+  _archive >> ozz::io::MakeArray(steps_);
+}
+
+// Explicitly instantiate supported track bundles.
+template class OZZ_ANIMATION_DLL TrackBundle<float>;
+template class OZZ_ANIMATION_DLL TrackBundle<math::Float2>;
+template class OZZ_ANIMATION_DLL TrackBundle<math::Float3>;
+template class OZZ_ANIMATION_DLL TrackBundle<math::Float4>;
+template class OZZ_ANIMATION_DLL TrackBundle<math::Quaternion>;
+
+}  // namespace internal
+}  // namespace animation
+}  // namespace ozz
@@ -0,0 +1,112 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/track_bundle_sampling_job.h"
+#include "ozz/animation/runtime/track.h"
+#include "ozz/base/maths/math_ex.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace ozz {
+namespace animation {
+namespace internal {
+
+template <typename _TrackBundle>
+TrackBundleSamplingJob<_TrackBundle>::TrackBundleSamplingJob()
+    : ratio(0.f), bundle(nullptr) {}
+
+template <typename _TrackBundle>
+bool TrackBundleSamplingJob<_TrackBundle>::Validate() const {
+  bool success = true;
+  success &= bundle != nullptr;
+  success &= bundle == nullptr || results.size() >= bundle->num_tracks();
+  return success;
+}
+
+template <typename _TrackBundle>
+bool TrackBundleSamplingJob<_TrackBundle>::Run() const {
+  if (!Validate()) {
+    return false;
+  }
+
+  // Clamps ratio in range [0,1].
+  const float clamped_ratio = math::Clamp(0.f, ratio, 1.f);
+
+  const span<const float> ratios = bundle->ratios();
+  const span<const ValueType> values = bundle->values();
+  const size_t num_tracks = bundle->num_tracks();
+  assert(ratios.size() * num_tracks == values.size() &&
+         bundle->steps().size() * 8 >= ratios.size());
+
+  // Default bundle returns identity.
+  if (ratios.size() == 0) {
+    for (size_t i = 0; i < num_tracks; ++i) {
+      results[i] = internal::TrackPolicy<ValueType>::identity();
+    }
+    return true;
+  }
+
+  // Search for the first key frame with a ratio value greater than input
+  // ratio. The search is done once for all bundled tracks, as they share the
+  // same timeline.
+  const size_t id1 =
+      std::upper_bound(ratios.begin(), ratios.end(), clamped_ratio) -
+      ratios.begin();
+
+  // Deduce keys indices.
+  const size_t id0 = id1 - 1;
+
+  const ValueType* vk0 = values.data() + id0 * num_tracks;
+  const bool id0step = (bundle->steps()[id0 / 8] & (1 << (id0 & 7))) != 0;
+  if (id0step || id1 == ratios.size()) {
+    for (size_t i = 0; i < num_tracks; ++i) {
+      results[i] = vk0[i];
+    }
+  } else {
+    // Lerp relevant keys of every track.
+    const float tk0 = ratios[id0];
+    const float tk1 = ratios[id1];
+    assert(clamped_ratio >= tk0 && clamped_ratio < tk1 && tk0 != tk1);
+    const float alpha = (clamped_ratio - tk0) / (tk1 - tk0);
+    const ValueType* vk1 = values.data() + id1 * num_tracks;
+    for (size_t i = 0; i < num_tracks; ++i) {
+      results[i] = internal::TrackPolicy<ValueType>::Lerp(vk0[i], vk1[i], alpha);
+    }
+  }
+  return true;
+}
+
+// Explicitly instantiate supported track bundles.
+template struct TrackBundleSamplingJob<FloatTrackBundle>;
+template struct TrackBundleSamplingJob<Float2TrackBundle>;
+template struct TrackBundleSamplingJob<Float3TrackBundle>;
+template struct TrackBundleSamplingJob<Float4TrackBundle>;
+template struct TrackBundleSamplingJob<QuaternionTrackBundle>;
+}  // namespace internal
+}  // namespace animation
+}  // namespace ozz
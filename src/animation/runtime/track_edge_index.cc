@@ -0,0 +1,132 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/track_edge_index.h"
+
+#include <cassert>
+
+#include "ozz/base/io/archive.h"
+#include "ozz/base/log.h"
+#include "ozz/base/maths/math_ex.h"
+#include "ozz/base/memory/allocator.h"
+
+namespace ozz {
+namespace animation {
+
+TrackEdgeIndex::TrackEdgeIndex() {}
+
+TrackEdgeIndex::TrackEdgeIndex(TrackEdgeIndex&& _other) {
+  *this = std::move(_other);
+}
+
+TrackEdgeIndex& TrackEdgeIndex::operator=(TrackEdgeIndex&& _other) {
+  std::swap(ratios_, _other.ratios_);
+  std::swap(risings_, _other.risings_);
+  std::swap(threshold_, _other.threshold_);
+  std::swap(edge_buckets_, _other.edge_buckets_);
+  return *this;
+}
+
+TrackEdgeIndex::~TrackEdgeIndex() { Deallocate(); }
+
+void TrackEdgeIndex::Allocate(size_t _edges_count) {
+  assert(ratios_.size() == 0 && risings_.size() == 0);
+
+  // Compute overall size and allocate a single buffer for all the data.
+  const size_t buffer_size = _edges_count * sizeof(float) +  // ratios
+                             (_edges_count + 7) / 8;         // risings
+  const memory::AllocationScope scope(memory::AllocationTag::kAnimation);
+  span<byte> buffer = {static_cast<byte*>(memory::default_allocator()->Allocate(
+                           buffer_size, alignof(float))),
+                       buffer_size};
+
+  // Fix up pointers. Serves larger alignment values first.
+  ratios_ = fill_span<float>(buffer, _edges_count);
+  risings_ = fill_span<uint8_t>(buffer, (_edges_count + 7) / 8);
+
+  assert(buffer.empty() && "Whole buffer should be consumned");
+}
+
+void TrackEdgeIndex::Deallocate() {
+  // Deallocate everything at once.
+  memory::default_allocator()->Deallocate(as_writable_bytes(ratios_).data());
+
+  ratios_ = {};
+  risings_ = {};
+  edge_buckets_ = 0;
+}
+
+void TrackEdgeIndex::BuildEdgeBuckets() {
+  edge_buckets_ = 0;
+  for (size_t i = 0; i < ratios_.size(); ++i) {
+    // Ratios are in range [0,1], an edge at ratio 1 lands in the last bucket.
+    const int bucket = math::Min(static_cast<int>(ratios_[i] * kNumEdgeBuckets),
+                                 kNumEdgeBuckets - 1);
+    edge_buckets_ |= uint64_t(1) << bucket;
+  }
+}
+
+size_t TrackEdgeIndex::size() const {
+  const size_t size =
+      sizeof(*this) + ratios_.size_bytes() + risings_.size_bytes();
+  return size;
+}
+
+void TrackEdgeIndex::Save(ozz::io::OArchive& _archive) const {
+  _archive << threshold_;
+  const uint32_t num_edges = static_cast<uint32_t>(ratios_.size());
+  _archive << num_edges;
+
+  _archive << ozz::io::MakeArray(ratios_);
+  _archive << ozz::io::MakeArray(risings_);
+}
+
+void TrackEdgeIndex::Load(ozz::io::IArchive& _archive, uint32_t _version) {
+  // Destroy the index in case it was already used before.
+  Deallocate();
+  threshold_ = 0.f;
+
+  if (_version > 1) {
+    log::Err() << "Unsupported TrackEdgeIndex version " << _version << "."
+               << std::endl;
+    return;
+  }
+
+  _archive >> threshold_;
+  uint32_t num_edges;
+  _archive >> num_edges;
+
+  Allocate(num_edges);
+
+  _archive >> ozz::io::MakeArray(ratios_);
+  _archive >> ozz::io::MakeArray(risings_);
+
+  // The coarse bucket summary is derived from ratios rather than serialized.
+  BuildEdgeBuckets();
+}
+}  // namespace animation
+}  // namespace ozz
@@ -26,19 +26,28 @@
 //----------------------------------------------------------------------------//
 
 #include "ozz/animation/runtime/track_sampling_job.h"
+#include "ozz/animation/runtime/dynamic_track.h"
+#include "ozz/animation/runtime/quantized_track.h"
 #include "ozz/animation/runtime/track.h"
 #include "ozz/base/maths/math_ex.h"
+#include "ozz/base/maths/simd_math.h"
+#include "ozz/base/maths/soa_quaternion.h"
 
 #include <algorithm>
 #include <cassert>
 
 namespace ozz {
 namespace animation {
+
+TrackSamplingContext::TrackSamplingContext() : id_(0) {}
+
+void TrackSamplingContext::Invalidate() { id_ = 0; }
+
 namespace internal {
 
 template <typename _Track>
 TrackSamplingJob<_Track>::TrackSamplingJob()
-    : ratio(0.f), track(nullptr), result(nullptr) {}
+    : ratio(0.f), track(nullptr), context(nullptr), result(nullptr) {}
 
 template <typename _Track>
 bool TrackSamplingJob<_Track>::Validate() const {
@@ -71,25 +80,50 @@ bool TrackSamplingJob<_Track>::Run() const {
 
   // Search for the first key frame with a ratio value greater than input ratio.
   // Our ratio is between this one and the previous one.
-  const float* ptk1 = std::upper_bound(ratios.begin(), ratios.end(), clamped_ratio);
+  // If a context was provided, first probes the interval it cached, as well as
+  // the next one, which covers coherent (sequential) sampling. The cached
+  // interval is checked against the actual track ratios, so a stale context
+  // (seek, loop, different track...) safely falls back to the binary search.
+  size_t id1 = 0;
+  const size_t cached = context ? context->id_ : ratios.size();
+  if (cached + 1 < ratios.size() && ratios[cached] <= clamped_ratio) {
+    if (clamped_ratio < ratios[cached + 1]) {
+      id1 = cached + 1;  // Same interval as the previous sample.
+    } else if (cached + 2 == ratios.size() ||
+               clamped_ratio < ratios[cached + 2]) {
+      id1 = cached + 2;  // Moved to the next interval.
+    }
+  }
+  if (id1 == 0) {  // Cache miss, searches the whole track.
+    id1 = std::upper_bound(ratios.begin(), ratios.end(), clamped_ratio) -
+          ratios.begin();
+  }
 
   // Deduce keys indices.
-  const size_t id1 = ptk1 - ratios.begin();
   const size_t id0 = id1 - 1;
 
-  const bool id0step = (track->steps()[id0 / 8] & (1 << (id0 & 7))) != 0;
-  if (id0step || ptk1 == ratios.end()) {
-    *result = values[id0];
-  } else {
-    // Lerp relevant keys.
-    const float tk0 = ratios[id0];
-    const float tk1 = ratios[id1];
-    assert(clamped_ratio >= tk0 && clamped_ratio < tk1 && tk0 != tk1);
-    const float alpha = (clamped_ratio - tk0) / (tk1 - tk0);
-    const ValueType& vk0 = values[id0];
-    const ValueType& vk1 = values[id1];
-    *result = internal::TrackPolicy<ValueType>::Lerp(vk0, vk1, alpha);
+  // Caches the interval for the next sample. The end of track case (id1 ==
+  // ratios.size()) is stored as the last interval, so it remains a cache hit.
+  if (context) {
+    context->id_ = static_cast<uint32_t>(math::Min(id0, ratios.size() - 2));
   }
+
+  // Interpolates through a single unified lerp, whatever the key mode. The
+  // step bit (and the sampling-past-the-last-key case) is decoded into
+  // selects that redirect the right key to the left one and zero alpha, so a
+  // stepped key lerps to itself. Mixed step/linear tracks thus don't pay an
+  // unpredictable branch per sample.
+  const bool id0step = (track->steps()[id0 / 8] & (1 << (id0 & 7))) != 0;
+  const bool lerps = !id0step & (id1 != ratios.size());
+  const size_t id1c = lerps ? id1 : id0;
+  const float tk0 = ratios[id0];
+  const float tk1 = ratios[id1c];
+  assert(!lerps || (clamped_ratio >= tk0 && clamped_ratio < tk1 && tk0 != tk1));
+  const float alpha =
+      (lerps ? clamped_ratio - tk0 : 0.f) / (lerps ? tk1 - tk0 : 1.f);
+  const ValueType& vk0 = values[id0];
+  const ValueType& vk1 = values[id1c];
+  *result = internal::TrackPolicy<ValueType>::Lerp(vk0, vk1, alpha);
   return true;
 }
 
@@ -99,6 +133,219 @@ template struct TrackSamplingJob<Float2Track>;
 template struct TrackSamplingJob<Float3Track>;
 template struct TrackSamplingJob<Float4Track>;
 template struct TrackSamplingJob<QuaternionTrack>;
+
+// Editable tracks expose the same keyframe views as immutable ones, see
+// dynamic_track.h.
+template struct TrackSamplingJob<DynamicFloatTrack>;
+template struct TrackSamplingJob<DynamicFloat2Track>;
+template struct TrackSamplingJob<DynamicFloat3Track>;
+template struct TrackSamplingJob<DynamicFloat4Track>;
+template struct TrackSamplingJob<DynamicQuaternionTrack>;
 }  // namespace internal
+
+namespace {
+// Decodes a quantized value according to track format.
+inline float Decode(const QuantizedFloatTrack& _track, uint16_t _value) {
+  if (_track.format() == QuantizedFloatTrack::kFloat16) {
+    return math::HalfToFloat(_value);
+  }
+  return _track.value_min() + _value * (_track.value_extent() / 65535.f);
+}
+
+// Locates the keyframe interval enclosing _ratio and decodes the step bit
+// into the effective lerp keys and alpha, mirroring TrackSamplingJob. The
+// optional _cached interval (from a TrackSamplingContext) is probed first,
+// and updated.
+inline void FindKeysAndAlpha(const QuaternionTrack& _track, float _ratio,
+                             uint32_t* _cached, size_t* _id0, size_t* _id1c,
+                             float* _alpha) {
+  const span<const float> ratios = _track.ratios();
+
+  size_t id1 = 0;
+  const size_t cached = _cached ? *_cached : ratios.size();
+  if (cached + 1 < ratios.size() && ratios[cached] <= _ratio) {
+    if (_ratio < ratios[cached + 1]) {
+      id1 = cached + 1;  // Same interval as the previous sample.
+    } else if (cached + 2 == ratios.size() || _ratio < ratios[cached + 2]) {
+      id1 = cached + 2;  // Moved to the next interval.
+    }
+  }
+  if (id1 == 0) {  // Cache miss, searches the whole track.
+    id1 = std::upper_bound(ratios.begin(), ratios.end(), _ratio) -
+          ratios.begin();
+  }
+
+  const size_t id0 = id1 - 1;
+
+  // Caches the interval for the next sample.
+  if (_cached) {
+    *_cached = static_cast<uint32_t>(math::Min(id0, ratios.size() - 2));
+  }
+
+  const bool id0step = (_track.steps()[id0 / 8] & (1 << (id0 & 7))) != 0;
+  const bool lerps = !id0step & (id1 != ratios.size());
+  *_id0 = id0;
+  *_id1c = lerps ? id1 : id0;
+  const float tk0 = ratios[id0];
+  const float tk1 = ratios[*_id1c];
+  *_alpha = (lerps ? _ratio - tk0 : 0.f) / (lerps ? tk1 - tk0 : 1.f);
+}
+}  // namespace
+
+QuantizedFloatTrackSamplingJob::QuantizedFloatTrackSamplingJob()
+    : ratio(0.f), track(nullptr), context(nullptr), result(nullptr) {}
+
+bool QuantizedFloatTrackSamplingJob::Validate() const {
+  bool success = true;
+  success &= result != nullptr;
+  success &= track != nullptr;
+  return success;
+}
+
+bool QuantizedFloatTrackSamplingJob::Run() const {
+  if (!Validate()) {
+    return false;
+  }
+
+  // Clamps ratio in range [0,1].
+  const float clamped_ratio = math::Clamp(0.f, ratio, 1.f);
+
+  // Search keyframes to interpolate.
+  const span<const uint16_t> ratios = track->ratios();
+  const span<const uint16_t> values = track->values();
+  assert(ratios.size() == values.size() &&
+         track->steps().size() * 8 >= values.size());
+
+  // Default track returns identity.
+  if (ratios.size() == 0) {
+    *result = internal::TrackPolicy<float>::identity();
+    return true;
+  }
+
+  // Searches in the quantized ratio domain, as decompressing ratios for
+  // comparisons isn't needed (quantization preserves ordering).
+  const uint16_t qratio = static_cast<uint16_t>(clamped_ratio * 65535.f + .5f);
+
+  // Probes the optional context cached interval first, like
+  // TrackSamplingJob does. Note that quantized ratios can have duplicates
+  // (keys closer than a ratio quantum), which the binary search handles, so
+  // the probe falls back to it around duplicated ratios.
+  size_t id1 = 0;
+  const size_t cached = context ? context->id_ : ratios.size();
+  if (cached + 1 < ratios.size() && ratios[cached] <= qratio) {
+    if (qratio < ratios[cached + 1]) {
+      id1 = cached + 1;  // Same interval as the previous sample.
+    } else if (cached + 2 == ratios.size() ||
+               qratio < ratios[cached + 2]) {
+      id1 = cached + 2;  // Moved to the next interval.
+    }
+  }
+  if (id1 == 0) {  // Cache miss, searches the whole track.
+    id1 = std::upper_bound(ratios.begin(), ratios.end(), qratio) -
+          ratios.begin();
+  }
+
+  // Deduce keys indices.
+  const size_t id0 = id1 - 1;
+
+  // Caches the interval for the next sample.
+  if (context) {
+    context->id_ = static_cast<uint32_t>(math::Min(id0, ratios.size() - 2));
+  }
+
+  // Decompresses and lerps relevant keys through a single unified path, the
+  // step bit being decoded into selects like TrackSamplingJob does. Alpha is
+  // clamped as the sampled ratio can exceed the decompressed keys interval
+  // by a rounding quantum.
+  const bool id0step = (track->steps()[id0 / 8] & (1 << (id0 & 7))) != 0;
+  const bool lerps = !id0step & (id1 != ratios.size());
+  const size_t id1c = lerps ? id1 : id0;
+  const float tk0 = ratios[id0] * (1.f / 65535.f);
+  const float tk1 = ratios[id1c] * (1.f / 65535.f);
+  assert(!lerps || tk0 != tk1);  // Won't divide by 0.
+  const float alpha = math::Clamp(
+      0.f, (lerps ? clamped_ratio - tk0 : 0.f) / (lerps ? tk1 - tk0 : 1.f),
+      1.f);
+  const float vk0 = Decode(*track, values[id0]);
+  const float vk1 = Decode(*track, values[id1c]);
+  *result = internal::TrackPolicy<float>::Lerp(vk0, vk1, alpha);
+  return true;
+}
+
+QuaternionTrackMultiSamplingJob::QuaternionTrackMultiSamplingJob()
+    : track(nullptr), context(nullptr) {}
+
+bool QuaternionTrackMultiSamplingJob::Validate() const {
+  bool success = true;
+  success &= track != nullptr;
+  success &= results.size() >= ratios.size();
+  return success;
+}
+
+bool QuaternionTrackMultiSamplingJob::Run() const {
+  if (!Validate()) {
+    return false;
+  }
+  uint32_t* const cached = context ? &context->id_ : nullptr;
+
+  const span<const math::Quaternion> values = track->values();
+  assert(track->ratios().size() == values.size() &&
+         track->steps().size() * 8 >= values.size());
+
+  // Default track returns identity.
+  if (track->ratios().size() == 0) {
+    for (size_t i = 0; i < ratios.size(); ++i) {
+      results[i] = internal::TrackPolicy<math::Quaternion>::identity();
+    }
+    return true;
+  }
+
+  // Vectorized path, 4 samples at a time: the searches locate the 4 sampled
+  // intervals (usually all the same for a smoothing window, hence context
+  // cache hits), then a single soa nlerp lerps and normalizes the 4 samples
+  // at once.
+  size_t i = 0;
+  for (; i + 4 <= ratios.size(); i += 4) {
+    math::SimdFloat4 k0[4], k1[4];
+    float alphas[4];
+    for (size_t j = 0; j < 4; ++j) {
+      const float clamped_ratio = math::Clamp(0.f, ratios[i + j], 1.f);
+      size_t id0, id1c;
+      FindKeysAndAlpha(*track, clamped_ratio, cached, &id0, &id1c,
+                       &alphas[j]);
+      k0[j] = math::simd_float4::LoadPtrU(&values[id0].x);
+      k1[j] = math::simd_float4::LoadPtrU(&values[id1c].x);
+    }
+
+    // Transposes the gathered keys to soa form, one sample per lane.
+    math::SimdFloat4 soa0[4], soa1[4];
+    math::Transpose4x4(k0, soa0);
+    math::Transpose4x4(k1, soa1);
+    const math::SoaQuaternion a = {soa0[0], soa0[1], soa0[2], soa0[3]};
+    const math::SoaQuaternion b = {soa1[0], soa1[1], soa1[2], soa1[3]};
+    const math::SoaQuaternion nlerped =
+        NLerp(a, b, math::simd_float4::LoadPtrU(alphas));
+
+    // Transposes the normalized samples back to the results.
+    const math::SimdFloat4 soa[4] = {nlerped.x, nlerped.y, nlerped.z,
+                                     nlerped.w};
+    math::SimdFloat4 out[4];
+    math::Transpose4x4(soa, out);
+    for (size_t j = 0; j < 4; ++j) {
+      math::StorePtrU(out[j], &results[i + j].x);
+    }
+  }
+
+  // Remaining samples take the scalar path, like QuaternionTrackSamplingJob.
+  for (; i < ratios.size(); ++i) {
+    const float clamped_ratio = math::Clamp(0.f, ratios[i], 1.f);
+    size_t id0, id1c;
+    float alpha;
+    FindKeysAndAlpha(*track, clamped_ratio, cached, &id0, &id1c, &alpha);
+    results[i] = internal::TrackPolicy<math::Quaternion>::Lerp(
+        values[id0], values[id1c], alpha);
+  }
+  return true;
+}
 }  // namespace animation
 }  // namespace ozz
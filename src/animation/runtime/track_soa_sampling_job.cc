@@ -0,0 +1,119 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/track_soa_sampling_job.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "ozz/animation/runtime/track_soa.h"
+#include "ozz/base/maths/math_ex.h"
+#include "ozz/base/maths/simd_math.h"
+
+namespace ozz {
+namespace animation {
+
+TrackSoASamplingJob::TrackSoASamplingJob() : ratio(0.f), tracks(nullptr) {}
+
+bool TrackSoASamplingJob::Validate() const {
+  bool success = true;
+  success &= tracks != nullptr;
+  success &= tracks == nullptr || results.size() >= tracks->num_tracks();
+  return success;
+}
+
+bool TrackSoASamplingJob::Run() const {
+  if (!Validate()) {
+    return false;
+  }
+
+  // Clamps ratio in range [0,1].
+  const float clamped_ratio = math::Clamp(0.f, ratio, 1.f);
+
+  const span<const float> ratios = tracks->ratios();
+  const span<const float> values = tracks->values();
+  const size_t num_tracks = tracks->num_tracks();
+  assert(ratios.size() * num_tracks == values.size());
+
+  // Default tracks return identity.
+  if (ratios.size() == 0) {
+    for (size_t i = 0; i < num_tracks; ++i) {
+      results[i] = 0.f;
+    }
+    return true;
+  }
+
+  // Search for the first key frame with a ratio value greater than input
+  // ratio. This single search is shared by all tracks, as they all use the
+  // same ratios.
+  const float* ptk1 =
+      std::upper_bound(ratios.begin(), ratios.end(), clamped_ratio);
+
+  // Deduce keys indices.
+  const size_t id1 = ptk1 - ratios.begin();
+  const size_t id0 = id1 - 1;
+  const float* v0 = values.data() + id0 * num_tracks;
+
+  // Beyond the last key frame, all tracks stick to their last value.
+  if (ptk1 == ratios.end()) {
+    std::memcpy(results.data(), v0, num_tracks * sizeof(float));
+    return true;
+  }
+
+  const float tk0 = ratios[id0];
+  const float tk1 = ratios[id1];
+  assert(clamped_ratio >= tk0 && clamped_ratio < tk1 && tk0 != tk1);
+  const float alpha = (clamped_ratio - tk0) / (tk1 - tk0);
+  const float* v1 = values.data() + id1 * num_tracks;
+
+  // Step bits of keyframe id0 select, per track, the held value instead of
+  // the interpolated one.
+  const size_t steps_stride = (num_tracks + 7) / 8;
+  const uint8_t* steps = tracks->steps().data() + id0 * steps_stride;
+
+  // Interpolates 4 tracks at a time, then the remaining ones.
+  const math::SimdFloat4 simd_alpha = math::simd_float4::Load1(alpha);
+  size_t i = 0;
+  for (; i + 4 <= num_tracks; i += 4) {
+    const int bits = steps[i / 8] >> (i & 7);
+    const math::SimdInt4 step_mask =
+        math::simd_int4::Load(-(bits & 1), -(bits >> 1 & 1), -(bits >> 2 & 1),
+                              -(bits >> 3 & 1));
+    const math::SimdFloat4 vk0 = math::simd_float4::LoadPtrU(v0 + i);
+    const math::SimdFloat4 vk1 = math::simd_float4::LoadPtrU(v1 + i);
+    const math::SimdFloat4 lerped = math::Lerp(vk0, vk1, simd_alpha);
+    math::StorePtrU(math::Select(step_mask, vk0, lerped), results.data() + i);
+  }
+  for (; i < num_tracks; ++i) {
+    const bool step = (steps[i / 8] & (1 << (i & 7))) != 0;
+    results[i] = step ? v0[i] : math::Lerp(v0[i], v1[i], alpha);
+  }
+  return true;
+}
+}  // namespace animation
+}  // namespace ozz
@@ -27,9 +27,11 @@
 
 #include "ozz/animation/runtime/track_triggering_job.h"
 #include "ozz/animation/runtime/track.h"
+#include "ozz/animation/runtime/track_edge_index.h"
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 
 namespace ozz {
 namespace animation {
@@ -177,5 +179,218 @@ const TrackTriggeringJob::Iterator& TrackTriggeringJob::Iterator::operator++() {
 
   return *this;
 }
+
+TrackEdgeTriggeringJob::TrackEdgeTriggeringJob()
+    : from(0.f), to(0.f), index(nullptr), edges(nullptr) {}
+
+bool TrackEdgeTriggeringJob::Validate() const {
+  bool valid = true;
+  valid &= index != nullptr;
+  valid &= edges != nullptr;
+  return valid;
+}
+
+namespace {
+// Invokes _emit(ratio, rising) for every edge of _index within the
+// [_from, _to[ range, following TrackTriggeringJob from/to semantic. _emit
+// returns false to stop collection (output buffer full), which is propagated.
+template <typename _Emit>
+bool CollectEdges(const TrackEdgeIndex& _index, float _from, float _to,
+                  const _Emit& _emit) {
+  const span<const float>& ratios = _index.ratios();
+  const span<const uint8_t>& risings = _index.risings();
+
+  if (_to > _from) {
+    for (float outer = floorf(_from); outer < _to; outer += 1.f) {
+      // Binary searches the sub-range of precomputed edges that belongs to
+      // [from, to[ within this loop. An edge at local ratio r triggers at
+      // global ratio r + outer. Edges up to local ratio 1 (included) belong to
+      // the range when "to" reaches the end of the loop, consistently with
+      // TrackTriggeringJob.
+      const float* lo =
+          std::lower_bound(ratios.begin(), ratios.end(), _from - outer);
+      const float* hi = _to - outer >= 1.f
+                            ? ratios.end()
+                            : std::lower_bound(lo, ratios.end(), _to - outer);
+      for (const float* edge = lo; edge != hi; ++edge) {
+        const size_t i = edge - ratios.begin();
+        const bool rising = (risings[i / 8] & (1 << (i & 7))) != 0;
+        if (!_emit(*edge + outer, rising)) {
+          return false;
+        }
+      }
+    }
+  } else if (_from > _to) {
+    // Backward triggering yields edges in reverse order, with reversed
+    // directions (rising edges in forward become falling ones).
+    for (float outer = floorf(_from); outer + 1.f > _to; outer -= 1.f) {
+      const float* lo =
+          std::lower_bound(ratios.begin(), ratios.end(), _to - outer);
+      const float* hi = _from - outer >= 1.f
+                            ? ratios.end()
+                            : std::lower_bound(lo, ratios.end(), _from - outer);
+      for (const float* edge = hi; edge != lo;) {
+        --edge;
+        const size_t i = edge - ratios.begin();
+        const bool rising = (risings[i / 8] & (1 << (i & 7))) == 0;
+        if (!_emit(*edge + outer, rising)) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+}  // namespace
+
+bool TrackEdgeTriggeringJob::Run() const {
+  if (!Validate()) {
+    return false;
+  }
+
+  Edge* out = edges->begin();
+  const Edge* const out_end = edges->end();
+  const bool collected =
+      CollectEdges(*index, from, to, [&](float _ratio, bool _rising) {
+        if (out == out_end) {
+          return false;
+        }
+        out->ratio = _ratio;
+        out->rising = _rising;
+        ++out;
+        return true;
+      });
+
+  // Shrinks the output span to the edges actually written.
+  *edges = edges->first(out - edges->begin());
+
+  return collected;
+}
+
+MultiTrackEdgeTriggeringJob::MultiTrackEdgeTriggeringJob()
+    : from(0.f), to(0.f), edges(nullptr) {}
+
+bool MultiTrackEdgeTriggeringJob::Validate() const {
+  bool valid = true;
+  valid &= edges != nullptr;
+  for (size_t i = 0; i < indices.size(); ++i) {
+    valid &= indices[i] != nullptr;
+  }
+  return valid;
+}
+
+bool MultiTrackEdgeTriggeringJob::Run() const {
+  if (!Validate()) {
+    return false;
+  }
+
+  // Collects edges of every track, tagged with their track index. Each
+  // track's edges land contiguously, already ordered within the track.
+  TrackEdge* out = edges->begin();
+  const TrackEdge* const out_end = edges->end();
+  bool collected = true;
+  for (size_t t = 0; t < indices.size() && collected; ++t) {
+    collected =
+        CollectEdges(*indices[t], from, to, [&](float _ratio, bool _rising) {
+          if (out == out_end) {
+            return false;
+          }
+          out->ratio = _ratio;
+          out->rising = _rising;
+          out->track = static_cast<int>(t);
+          ++out;
+          return true;
+        });
+  }
+
+  // Shrinks the output span to the edges actually written.
+  *edges = edges->first(out - edges->begin());
+
+  // Merges per-track streams into a single time ordered one. Edges at the
+  // very same ratio are ordered by track index, making the output
+  // deterministic. Sorting is done in place, the job never allocates.
+  if (to >= from) {
+    std::sort(edges->begin(), edges->end(),
+              [](const TrackEdge& _a, const TrackEdge& _b) {
+                return _a.ratio < _b.ratio ||
+                       (_a.ratio == _b.ratio && _a.track < _b.track);
+              });
+  } else {
+    // Backward triggering yields edges in reverse time order.
+    std::sort(edges->begin(), edges->end(),
+              [](const TrackEdge& _a, const TrackEdge& _b) {
+                return _a.ratio > _b.ratio ||
+                       (_a.ratio == _b.ratio && _a.track < _b.track);
+              });
+  }
+
+  return collected;
+}
+
+namespace {
+
+// Builds the bucket mask of a [_from, _to[ ratio window, conservatively
+// including the buckets containing both window boundaries. Follows
+// TrackTriggeringJob from/to semantic: windows longer than a loop cover every
+// bucket, backward windows cover the same buckets as their forward
+// counterpart.
+uint64_t WindowBucketMask(float _from, float _to) {
+  const int num_buckets = TrackEdgeIndex::kNumEdgeBuckets;
+  const float length = std::abs(_to - _from);
+  if (length >= 1.f) {
+    return ~uint64_t(0);  // Loops over the whole track.
+  }
+
+  // Wraps window begin back to [0,1[ and finds boundary buckets. The end
+  // bucket can land past the last bucket, in which case the mask wraps, as
+  // the window does on the track loop.
+  const float begin = _from < _to ? _from : _to;
+  const float wrapped = begin - std::floor(begin);
+  const int first = static_cast<int>(wrapped * num_buckets);
+  const int count =
+      static_cast<int>((wrapped + length) * num_buckets) - first + 1;
+  if (count >= num_buckets) {
+    return ~uint64_t(0);
+  }
+
+  // Rotates a mask of count bits by the first bucket index.
+  const uint64_t bits = (uint64_t(1) << count) - 1;
+  return (bits << first) | (first == 0 ? 0 : bits >> (num_buckets - first));
+}
+}  // namespace
+
+TrackEdgePrefilterJob::TrackEdgePrefilterJob() {}
+
+bool TrackEdgePrefilterJob::Validate() const {
+  bool valid = true;
+  valid &= froms.size() == indices.size();
+  valid &= tos.size() == indices.size();
+  valid &= candidates.size() >= (indices.size() + 7) / 8;
+  for (size_t i = 0; i < indices.size(); ++i) {
+    valid &= indices[i] != nullptr;
+  }
+  return valid;
+}
+
+bool TrackEdgePrefilterJob::Run() const {
+  if (!Validate()) {
+    return false;
+  }
+
+  for (size_t i = 0; i < indices.size(); ++i) {
+    const uint64_t buckets = indices[i]->edge_buckets();
+    // Empty windows trigger no edge, whatever the track.
+    const bool candidate =
+        froms[i] != tos[i] &&
+        (buckets & WindowBucketMask(froms[i], tos[i])) != 0;
+    const byte bit = byte(1) << (i & 7);
+    if (candidate) {
+      candidates[i / 8] |= bit;
+    } else {
+      candidates[i / 8] &= static_cast<byte>(~bit);
+    }
+  }
+  return true;
+}
 }  // namespace animation
 }  // namespace ozz
@@ -0,0 +1,158 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/working_set_image.h"
+
+#include <cassert>
+#include <cstring>
+
+#include "ozz/base/maths/simd_math.h"
+
+namespace ozz {
+namespace animation {
+
+namespace {
+// Image data alignment, propagated to every entry context image so contexts
+// can bind their simd spans directly into the mapping.
+const size_t kWorkingSetAlignment = alignof(math::SimdFloat4);
+
+// Header of a working set image, followed by count entries. Each entry is a
+// WorkingSetEntryHeader followed by the entry context image, padded so the
+// next entry header stays aligned. All fields are stored with native
+// endianness and layout.
+struct WorkingSetImageHeader {
+  char tag[12];
+  uint32_t version;
+  uint32_t count;
+  uint32_t padding[3];
+};
+struct WorkingSetEntryHeader {
+  uint64_t key;
+  uint64_t size;  // Context image size, without padding.
+};
+static_assert(sizeof(WorkingSetImageHeader) % 16 == 0 &&
+                  sizeof(WorkingSetEntryHeader) % 16 == 0,
+              "Entry alignment follows from header sizes.");
+
+const char kWorkingSetImageTag[12] = "ozz-raw-wks";
+const uint32_t kWorkingSetImageVersion = 1;
+}  // namespace
+
+size_t WorkingSetImage::RequiredSize(const span<const Entry>& _entries) {
+  size_t size = sizeof(WorkingSetImageHeader);
+  for (const Entry& entry : _entries) {
+    const size_t raw_size = entry.context ? entry.context->raw_size() : 0;
+    size += Align(sizeof(WorkingSetEntryHeader) + raw_size,
+                  kWorkingSetAlignment);
+  }
+  return size;
+}
+
+bool WorkingSetImage::Write(const span<const Entry>& _entries,
+                            span<byte> _buffer) {
+  if (_buffer.size() < RequiredSize(_entries) ||
+      !IsAligned(_buffer.data(), kWorkingSetAlignment)) {
+    return false;
+  }
+
+  // Fills and stores the header.
+  WorkingSetImageHeader header = {};
+  std::memcpy(header.tag, kWorkingSetImageTag, sizeof(header.tag));
+  header.version = kWorkingSetImageVersion;
+  header.count = static_cast<uint32_t>(_entries.size());
+  std::memcpy(_buffer.data(), &header, sizeof(header));
+
+  // Appends entries, keeping every context image aligned.
+  size_t offset = sizeof(header);
+  for (const Entry& entry : _entries) {
+    if (!entry.context) {
+      return false;
+    }
+    const size_t raw_size = entry.context->raw_size();
+    WorkingSetEntryHeader entry_header = {entry.key, raw_size};
+    std::memcpy(_buffer.data() + offset, &entry_header, sizeof(entry_header));
+    if (!entry.context->SaveRaw(
+            _buffer.subspan(offset + sizeof(entry_header), raw_size))) {
+      return false;
+    }
+    offset += Align(sizeof(entry_header) + raw_size, kWorkingSetAlignment);
+  }
+  return true;
+}
+
+bool WorkingSetImage::Attach(span<byte> _buffer) {
+  // Detaches in case *this was already attached.
+  buffer_ = {};
+  entries_.clear();
+
+  // Validates header.
+  if (_buffer.size() < sizeof(WorkingSetImageHeader) ||
+      !IsAligned(_buffer.data(), kWorkingSetAlignment)) {
+    return false;
+  }
+  WorkingSetImageHeader header;
+  std::memcpy(&header, _buffer.data(), sizeof(header));
+  if (std::memcmp(header.tag, kWorkingSetImageTag, sizeof(header.tag)) != 0 ||
+      header.version != kWorkingSetImageVersion) {
+    return false;
+  }
+
+  // Indexes entries, validating each one fits the buffer.
+  entries_.reserve(header.count);
+  size_t offset = sizeof(header);
+  for (uint32_t i = 0; i < header.count; ++i) {
+    WorkingSetEntryHeader entry_header;
+    if (_buffer.size() < offset + sizeof(entry_header)) {
+      entries_.clear();
+      return false;
+    }
+    std::memcpy(&entry_header, _buffer.data() + offset, sizeof(entry_header));
+    const size_t data_offset = offset + sizeof(entry_header);
+    if (_buffer.size() < data_offset + entry_header.size) {
+      entries_.clear();
+      return false;
+    }
+    const EntryRange range = {entry_header.key, data_offset,
+                              static_cast<size_t>(entry_header.size)};
+    entries_.push_back(range);
+    offset += Align(sizeof(entry_header) + static_cast<size_t>(entry_header.size),
+                    kWorkingSetAlignment);
+  }
+
+  buffer_ = _buffer;
+  return true;
+}
+
+bool WorkingSetImage::Bind(int _entry, const Animation& _animation,
+                           SamplingJob::Context* _context) const {
+  assert(_entry >= 0 && _entry < count() && _context != nullptr);
+  const EntryRange& range = entries_[_entry];
+  return _context->LoadRaw(buffer_.subspan(range.offset, range.size)) &&
+         _context->Bind(_animation);
+}
+}  // namespace animation
+}  // namespace ozz
@@ -29,29 +29,128 @@
 
 #include <cassert>
 
+#include "ozz/base/io/crc32c.h"
+
 namespace ozz {
 namespace io {
 
 // OArchive implementation.
 
-OArchive::OArchive(Stream* _stream, Endianness _endianness)
-    : stream_(_stream), endian_swap_(_endianness != GetNativeEndianness()) {
+OArchive::OArchive(Stream* _stream, Endianness _endianness, bool _type_table,
+                   bool _checksum)
+    : stream_(_stream),
+      endian_swap_(_endianness != GetNativeEndianness()),
+      type_table_enabled_(_type_table),
+      checksum_enabled_(false),
+      checksum_(0),
+      checksum_chunk_(0) {
   assert(stream_ && stream_->opened() &&
          "_stream argument must point a valid opened stream.");
-  // Save as a single byte as it does not need to be swapped.
-  uint8_t endianness = static_cast<uint8_t>(_endianness);
-  *this << endianness;
+  // Saves the header as a single byte as it does not need to be swapped. It
+  // carries the endianness, and the type table and checksum modes in flag
+  // bits that archives using none of these options never set, keeping them
+  // byte identical to the historical format.
+  uint8_t header = static_cast<uint8_t>(_endianness);
+  if (_type_table) {
+    header |= internal::kHeaderTypeTable;
+  }
+  if (_checksum) {
+    header |= internal::kHeaderChecksum;
+  }
+  *this << header;
+  // The header byte itself isn't checksummed, so checksum mode is only
+  // enabled once it's written.
+  checksum_enabled_ = _checksum;
+}
+
+size_t OArchive::SaveChecksummed(const void* _data, size_t _size) {
+  const byte* data = static_cast<const byte*>(_data);
+  size_t written = 0;
+  while (written != _size) {
+    // Writes up to the next crc word placement.
+    const size_t remaining = internal::kChecksumGranularity - checksum_chunk_;
+    const size_t count =
+        _size - written < remaining ? _size - written : remaining;
+    const size_t size = stream_->Write(data + written, count);
+    checksum_ = CRC32C(checksum_, data + written, size);
+    checksum_chunk_ += size;
+    written += size;
+    if (checksum_chunk_ == internal::kChecksumGranularity) {
+      FlushChecksum();
+    }
+    if (size != count) {  // Stream error, reports the short write.
+      break;
+    }
+  }
+  return written;
+}
+
+void OArchive::FlushChecksum() {
+  assert(checksum_enabled_ && "Archive wasn't opened in checksum mode.");
+  const uint32_t checksum =
+      endian_swap_ ? EndianSwapper<uint32_t>::Swap(checksum_) : checksum_;
+  OZZ_IF_DEBUG(size_t size =) stream_->Write(&checksum, sizeof(checksum));
+  assert(size == sizeof(checksum));
+  checksum_ = 0;
+  checksum_chunk_ = 0;
 }
 
 // IArchive implementation.
 
-IArchive::IArchive(Stream* _stream) : stream_(_stream), endian_swap_(false) {
+IArchive::IArchive(Stream* _stream)
+    : stream_(_stream),
+      endian_swap_(false),
+      type_table_enabled_(false),
+      checksum_enabled_(false),
+      checksum_(0),
+      checksum_chunk_(0),
+      checksum_valid_(true) {
   assert(stream_ && stream_->opened() &&
          "_stream argument must point a valid opened stream.");
-  // Endianness was saved as a single byte, as it does not need to be swapped.
-  uint8_t endianness;
-  *this >> endianness;
-  endian_swap_ = endianness != GetNativeEndianness();
+  // The header was saved as a single byte, as it does not need to be swapped.
+  uint8_t header;
+  *this >> header;
+  endian_swap_ =
+      (header & internal::kHeaderEndianness) != GetNativeEndianness();
+  type_table_enabled_ = (header & internal::kHeaderTypeTable) != 0;
+  checksum_enabled_ = (header & internal::kHeaderChecksum) != 0;
+}
+
+size_t IArchive::LoadChecksummed(void* _data, size_t _size) {
+  byte* data = static_cast<byte*>(_data);
+  size_t read = 0;
+  while (read != _size) {
+    // Reads up to the next crc word placement.
+    const size_t remaining = internal::kChecksumGranularity - checksum_chunk_;
+    const size_t count = _size - read < remaining ? _size - read : remaining;
+    const size_t size = stream_->Read(data + read, count);
+    checksum_ = CRC32C(checksum_, data + read, size);
+    checksum_chunk_ += size;
+    read += size;
+    if (checksum_chunk_ == internal::kChecksumGranularity) {
+      ValidateChecksum();
+    }
+    if (size != count) {  // Stream error, reports the short read.
+      break;
+    }
+  }
+  return read;
+}
+
+bool IArchive::ValidateChecksum() {
+  assert(checksum_enabled_ && "Archive wasn't opened in checksum mode.");
+  uint32_t checksum;
+  if (sizeof(checksum) != stream_->Read(&checksum, sizeof(checksum))) {
+    checksum_valid_ = false;  // Truncated stream.
+  } else {
+    if (endian_swap_) {
+      checksum = EndianSwapper<uint32_t>::Swap(checksum);
+    }
+    checksum_valid_ &= checksum == checksum_;
+  }
+  checksum_ = 0;
+  checksum_chunk_ = 0;
+  return checksum_valid_;
 }
 }  // namespace io
 }  // namespace ozz
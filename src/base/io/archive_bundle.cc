@@ -0,0 +1,146 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/base/io/archive_bundle.h"
+
+#include <cstring>
+
+namespace ozz {
+namespace io {
+
+namespace {
+// Bundle format identification.
+const char kBundleTag[7] = "ozzpak";
+const uint32_t kBundleVersion = 1;
+}  // namespace
+
+ArchiveBundleWriter::ArchiveBundleWriter(Stream* _stream,
+                                         Endianness _endianness)
+    : stream_(_stream), endianness_(_endianness) {}
+
+ArchiveBundleWriter::~ArchiveBundleWriter() {
+  if (!closed_) {
+    Close();
+  }
+}
+
+int ArchiveBundleWriter::Find(const char* _name) const {
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    if (std::strcmp(entries_[i].name.c_str(), _name) == 0) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+bool ArchiveBundleWriter::Close() {
+  if (closed_) {
+    return false;
+  }
+  closed_ = true;
+
+  {  // Writes the front-loaded index.
+    OArchive archive(stream_, endianness_);
+    archive << MakeArray(kBundleTag, OZZ_ARRAY_SIZE(kBundleTag));
+    archive << kBundleVersion;
+    archive << static_cast<uint32_t>(entries_.size());
+    for (const Entry& entry : entries_) {
+      const uint32_t name_len = static_cast<uint32_t>(entry.name.size());
+      archive << name_len;
+      archive << MakeArray(entry.name.c_str(), name_len);
+      archive << static_cast<uint64_t>(entry.offset);
+      archive << static_cast<uint64_t>(entry.size);
+    }
+  }
+
+  // Copies the blob section right after the index.
+  const size_t blobs_size = static_cast<size_t>(blobs_.Tell());
+  blobs_.Seek(0, Stream::kSet);
+  char buffer[4096];
+  for (size_t remaining = blobs_size; remaining > 0;) {
+    const size_t chunk =
+        remaining < sizeof(buffer) ? remaining : sizeof(buffer);
+    blobs_.Read(buffer, chunk);
+    stream_->Write(buffer, chunk);
+    remaining -= chunk;
+  }
+
+  return true;
+}
+
+ArchiveBundle::ArchiveBundle(Stream* _stream) : stream_(_stream) {
+  IArchive archive(_stream);
+
+  // Validates bundle tag and version.
+  char tag[OZZ_ARRAY_SIZE(kBundleTag)];
+  archive >> MakeArray(tag, OZZ_ARRAY_SIZE(tag));
+  if (std::memcmp(tag, kBundleTag, sizeof(tag)) != 0) {
+    return;
+  }
+  uint32_t version;
+  archive >> version;
+  if (version != kBundleVersion) {
+    return;
+  }
+
+  // Reads the index.
+  uint32_t count;
+  archive >> count;
+  entries_.resize(count);
+  for (Entry& entry : entries_) {
+    uint32_t name_len;
+    archive >> name_len;
+    entry.name.resize(name_len);
+    if (name_len > 0) {
+      archive >> MakeArray(&entry.name[0], name_len);
+    }
+    uint64_t offset;
+    archive >> offset;
+    entry.offset = static_cast<size_t>(offset);
+    uint64_t size;
+    archive >> size;
+    entry.size = static_cast<size_t>(size);
+  }
+
+  // The blob section follows the index, entry offsets are relative to it.
+  begin_ = static_cast<size_t>(_stream->Tell());
+  valid_ = true;
+}
+
+int ArchiveBundle::Find(const char* _name) const {
+  if (!valid_) {
+    return -1;
+  }
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    if (std::strcmp(entries_[i].name.c_str(), _name) == 0) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+}  // namespace io
+}  // namespace ozz
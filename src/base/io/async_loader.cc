@@ -0,0 +1,128 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/base/io/async_loader.h"
+
+#include <cassert>
+
+namespace ozz {
+namespace io {
+
+AsyncLoader::AsyncLoader() : worker_(&AsyncLoader::Loop, this) {}
+
+AsyncLoader::~AsyncLoader() {
+  {  // Requests worker exit. Pending requests are still processed.
+    std::lock_guard<std::mutex> lock(mutex_);
+    exit_ = true;
+  }
+  condition_.notify_all();
+  worker_.join();
+}
+
+AsyncLoader::Ticket AsyncLoader::Schedule(const char* _path, void* _object,
+                                          LoadFn _fn) {
+  assert(_path && _object && _fn);
+  Ticket ticket;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ticket = statuses_.size();
+    statuses_.push_back(kPending);
+    pending_.push_back({_path, _object, _fn, ticket});
+  }
+  condition_.notify_all();
+  return ticket;
+}
+
+AsyncLoader::Status AsyncLoader::status(Ticket _ticket) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  assert(_ticket < statuses_.size() && "Unknown ticket.");
+  return statuses_[_ticket];
+}
+
+bool AsyncLoader::PopCompleted(Ticket* _ticket, bool* _success) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (completed_.empty()) {
+    return false;
+  }
+  const Ticket ticket = completed_.front();
+  completed_.pop_front();
+  if (_ticket) {
+    *_ticket = ticket;
+  }
+  if (_success) {
+    *_success = statuses_[ticket] == kSuccess;
+  }
+  return true;
+}
+
+bool AsyncLoader::Wait(Ticket _ticket) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  assert(_ticket < statuses_.size() && "Unknown ticket.");
+  condition_.wait(lock, [this, _ticket] {
+    return statuses_[_ticket] != kPending;
+  });
+  return statuses_[_ticket] == kSuccess;
+}
+
+void AsyncLoader::WaitAll() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  condition_.wait(lock, [this] {
+    for (const Status status : statuses_) {
+      if (status == kPending) {
+        return false;
+      }
+    }
+    return true;
+  });
+}
+
+void AsyncLoader::Loop() {
+  for (;;) {
+    Request request;
+    {  // Waits for a request, or for exit once all requests are done.
+      std::unique_lock<std::mutex> lock(mutex_);
+      condition_.wait(lock, [this] { return !pending_.empty() || exit_; });
+      if (pending_.empty()) {
+        return;  // Exit requested and nothing left to process.
+      }
+      request = pending_.front();
+      pending_.pop_front();
+    }
+
+    // Loads without holding the lock, this is the expensive part.
+    const bool success = request.fn(request.path.c_str(), request.object);
+
+    {  // Publishes completion.
+      std::lock_guard<std::mutex> lock(mutex_);
+      statuses_[request.ticket] = success ? kSuccess : kFailed;
+      completed_.push_back(request.ticket);
+    }
+    condition_.notify_all();
+  }
+}
+}  // namespace io
+}  // namespace ozz
@@ -0,0 +1,461 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/base/io/compressed_stream.h"
+
+#include <cassert>
+#include <cstring>
+
+namespace ozz {
+namespace io {
+
+namespace {
+
+// Container header, stored with native endianness.
+struct ContainerHeader {
+  char tag[8];
+  uint32_t version;
+  uint32_t block_size;
+  uint64_t total;  // Total uncompressed payload size, finalized at flush.
+};
+static_assert(sizeof(ContainerHeader) == 24, "Unexpected header padding.");
+const char kContainerTag[9] = "ozz-cstm";
+const uint32_t kContainerVersion = 1;
+
+// Uncompressed block size. Big enough to give lz77 matching some context,
+// small enough to keep inflation memory and latency per read low.
+const size_t kBlockSize = 64 * 1024;
+
+// lz77 codec parameters, lz4-class byte-oriented encoding: each sequence is
+// a token (4 bits literal length, 4 bits match length), optional length
+// extension bytes (255-runs), literals, then a 2 bytes match offset and
+// optional match length extension bytes. The last sequence of a block holds
+// literals only.
+const size_t kMinMatch = 4;
+const int kHashBits = 13;
+const size_t kMaxOffset = 65535;
+
+uint32_t Hash(uint32_t _value) {
+  return (_value * 2654435761u) >> (32 - kHashBits);
+}
+
+uint32_t UnalignedRead32(const byte* _data) {
+  uint32_t value;
+  std::memcpy(&value, _data, sizeof(value));
+  return value;
+}
+
+// Maximum compressed size for a _size bytes block.
+size_t CompressBound(size_t _size) { return _size + _size / 255 + 16; }
+
+// Appends lz4-style length extension bytes for lengths >= 15.
+byte* WriteLengthExtension(byte* _op, size_t _length) {
+  for (size_t remaining = _length - 15; true; remaining -= 255) {
+    if (remaining < 255) {
+      *_op++ = static_cast<byte>(remaining);
+      return _op;
+    }
+    *_op++ = 255;
+  }
+}
+
+// Compresses _src to _dst. Returns the compressed size, or 0 if the result
+// doesn't fit _dst_capacity (incompressible block).
+size_t CompressBlock(const byte* _src, size_t _src_size, byte* _dst,
+                     size_t _dst_capacity) {
+  // Hash table of positions (+1, 0 means empty) of previously seen 4 bytes
+  // sequences.
+  uint32_t table[1 << kHashBits] = {};
+
+  const byte* ip = _src;
+  const byte* anchor = _src;
+  const byte* const end = _src + _src_size;
+  // Conservative bound keeping 4 bytes reads and match extension in range.
+  const byte* const match_limit = _src_size > 8 ? end - 8 : _src;
+
+  byte* op = _dst;
+  byte* const op_end = _dst + _dst_capacity;
+
+  while (ip < match_limit) {
+    // Looks up and registers the 4 bytes sequence at ip.
+    const uint32_t h = Hash(UnalignedRead32(ip));
+    const uint32_t candidate_pos = table[h];
+    table[h] = static_cast<uint32_t>(ip - _src) + 1;
+    const byte* candidate = _src + candidate_pos - 1;
+    if (candidate_pos == 0 ||
+        static_cast<size_t>(ip - candidate) > kMaxOffset ||
+        UnalignedRead32(candidate) != UnalignedRead32(ip)) {
+      ++ip;
+      continue;
+    }
+
+    // Extends the match as far as possible.
+    size_t match_len = kMinMatch;
+    while (ip + match_len < end && candidate[match_len] == ip[match_len]) {
+      ++match_len;
+    }
+
+    // Emits the sequence, checking the worst case output size upfront.
+    const size_t literals = ip - anchor;
+    const size_t extra = match_len - kMinMatch;
+    if (op + 1 + literals + literals / 255 + 1 + 2 + extra / 255 + 1 >
+        op_end) {
+      return 0;
+    }
+    byte* const token = op++;
+    if (literals >= 15) {
+      *token = 15 << 4;
+      op = WriteLengthExtension(op, literals);
+    } else {
+      *token = static_cast<byte>(literals << 4);
+    }
+    std::memcpy(op, anchor, literals);
+    op += literals;
+    const uint16_t offset = static_cast<uint16_t>(ip - candidate);
+    std::memcpy(op, &offset, sizeof(offset));
+    op += sizeof(offset);
+    if (extra >= 15) {
+      *token |= 15;
+      op = WriteLengthExtension(op, extra);
+    } else {
+      *token |= static_cast<byte>(extra);
+    }
+
+    ip += match_len;
+    anchor = ip;
+  }
+
+  // Emits last literals.
+  const size_t literals = end - anchor;
+  if (op + 1 + literals + literals / 255 + 1 > op_end) {
+    return 0;
+  }
+  byte* const token = op++;
+  if (literals >= 15) {
+    *token = 15 << 4;
+    op = WriteLengthExtension(op, literals);
+  } else {
+    *token = static_cast<byte>(literals << 4);
+  }
+  std::memcpy(op, anchor, literals);
+  op += literals;
+
+  return op - _dst;
+}
+
+// Decompresses _src to _dst, whose expected size is exactly _dst_size.
+// Returns false if the compressed data is corrupted.
+bool DecompressBlock(const byte* _src, size_t _src_size, byte* _dst,
+                     size_t _dst_size) {
+  const byte* ip = _src;
+  const byte* const iend = _src + _src_size;
+  byte* op = _dst;
+  byte* const oend = _dst + _dst_size;
+
+  while (ip < iend) {
+    const byte token = *ip++;
+
+    // Literals.
+    size_t literals = token >> 4;
+    if (literals == 15) {
+      byte extension;
+      do {
+        if (ip >= iend) {
+          return false;
+        }
+        extension = *ip++;
+        literals += extension;
+      } while (extension == 255);
+    }
+    if (ip + literals > iend || op + literals > oend) {
+      return false;
+    }
+    std::memcpy(op, ip, literals);
+    op += literals;
+    ip += literals;
+    if (ip >= iend) {
+      break;  // Last sequence of the block has no match.
+    }
+
+    // Match.
+    if (ip + 2 > iend) {
+      return false;
+    }
+    uint16_t offset;
+    std::memcpy(&offset, ip, sizeof(offset));
+    ip += sizeof(offset);
+    size_t match_len = (token & 15) + kMinMatch;
+    if ((token & 15) == 15) {
+      byte extension;
+      do {
+        if (ip >= iend) {
+          return false;
+        }
+        extension = *ip++;
+        match_len += extension;
+      } while (extension == 255);
+    }
+    if (offset == 0 || op - _dst < offset || op + match_len > oend) {
+      return false;
+    }
+    // Byte per byte copy, as the match can overlap the output.
+    const byte* match = op - offset;
+    for (size_t i = 0; i < match_len; ++i) {
+      op[i] = match[i];
+    }
+    op += match_len;
+  }
+
+  return op == oend;
+}
+}  // namespace
+
+CompressedStream::CompressedStream(Stream* _stream, Mode _mode)
+    : stream_(_stream), mode_(_mode) {
+  if (!stream_ || !stream_->opened()) {
+    return;
+  }
+  header_pos_ = stream_->Tell();
+
+  if (mode_ == kWrite) {
+    // Writes the container header, finalized (total size) at flush time.
+    ContainerHeader header;
+    std::memcpy(header.tag, kContainerTag, sizeof(header.tag));
+    header.version = kContainerVersion;
+    header.block_size = static_cast<uint32_t>(kBlockSize);
+    header.total = 0;
+    valid_ = stream_->Write(&header, sizeof(header)) == sizeof(header);
+    pending_.reserve(kBlockSize);
+  } else {
+    // Reads and validates the container header.
+    ContainerHeader header;
+    if (stream_->Read(&header, sizeof(header)) != sizeof(header) ||
+        std::memcmp(header.tag, kContainerTag, sizeof(header.tag)) != 0 ||
+        header.version != kContainerVersion || header.block_size == 0) {
+      return;
+    }
+    total_ = static_cast<size_t>(header.total);
+    block_size_ = header.block_size;
+    valid_ = true;
+  }
+}
+
+CompressedStream::~CompressedStream() {
+  if (mode_ == kWrite && valid_) {
+    Flush();
+  }
+}
+
+bool CompressedStream::opened() const { return valid_; }
+
+bool CompressedStream::WriteBlock() {
+  if (pending_.empty()) {
+    return true;
+  }
+  const size_t usize = pending_.size();
+  cbuffer_.resize(CompressBound(usize));
+
+  // Compression is only worth it if strictly smaller, otherwise the block is
+  // stored raw (csize == usize).
+  size_t csize =
+      CompressBlock(pending_.data(), usize, cbuffer_.data(), usize - 1);
+  const byte* payload = cbuffer_.data();
+  if (csize == 0) {
+    csize = usize;
+    payload = pending_.data();
+  }
+
+  const uint32_t block_header[2] = {static_cast<uint32_t>(csize),
+                                    static_cast<uint32_t>(usize)};
+  const bool success =
+      stream_->Write(block_header, sizeof(block_header)) ==
+          sizeof(block_header) &&
+      stream_->Write(payload, csize) == csize;
+  pending_.clear();
+  valid_ &= success;
+  return success;
+}
+
+bool CompressedStream::Flush() {
+  if (mode_ != kWrite || !valid_) {
+    return false;
+  }
+  if (!WriteBlock()) {
+    return false;
+  }
+
+  // Finalizes total uncompressed size in the container header.
+  const int current = stream_->Tell();
+  const uint64_t total = total_;
+  valid_ = stream_->Seek(header_pos_ + offsetof(ContainerHeader, total),
+                         kSet) == 0 &&
+           stream_->Write(&total, sizeof(total)) == sizeof(total) &&
+           stream_->Seek(current, kSet) == 0;
+  return valid_;
+}
+
+size_t CompressedStream::Write(const void* _buffer, size_t _size) {
+  if (mode_ != kWrite || !valid_) {
+    return 0;
+  }
+  const byte* in = static_cast<const byte*>(_buffer);
+  size_t remaining = _size;
+  while (remaining > 0) {
+    const size_t room = kBlockSize - pending_.size();
+    const size_t chunk = remaining < room ? remaining : room;
+    pending_.insert(pending_.end(), in, in + chunk);
+    in += chunk;
+    remaining -= chunk;
+    total_ += chunk;
+    if (pending_.size() == kBlockSize && !WriteBlock()) {
+      break;
+    }
+  }
+  return _size - remaining;
+}
+
+bool CompressedStream::NextBlock(size_t _target) {
+  block_start_ += block_.size();
+  block_.clear();
+  cursor_ = 0;
+
+  uint32_t block_header[2];
+  if (stream_->Read(block_header, sizeof(block_header)) !=
+      sizeof(block_header)) {
+    return false;  // End of container.
+  }
+  const size_t csize = block_header[0];
+  const size_t usize = block_header[1];
+  if (csize == 0 || usize == 0 || usize > block_size_ || csize > usize) {
+    valid_ = false;  // Corrupted block header.
+    return false;
+  }
+
+  if (_target >= block_start_ + usize) {
+    // The block isn't needed, skips it without inflating.
+    if (stream_->Seek(static_cast<int>(csize), kCurrent) != 0) {
+      valid_ = false;
+      return false;
+    }
+    block_start_ += usize;
+    return true;
+  }
+
+  // Reads and inflates the block.
+  cbuffer_.resize(csize);
+  if (stream_->Read(cbuffer_.data(), csize) != csize) {
+    valid_ = false;
+    return false;
+  }
+  block_.resize(usize);
+  if (csize == usize) {  // Stored raw.
+    std::memcpy(block_.data(), cbuffer_.data(), usize);
+  } else if (!DecompressBlock(cbuffer_.data(), csize, block_.data(), usize)) {
+    valid_ = false;
+    return false;
+  }
+  return true;
+}
+
+size_t CompressedStream::Read(void* _buffer, size_t _size) {
+  if (mode_ != kRead || !valid_) {
+    return 0;
+  }
+  byte* out = static_cast<byte*>(_buffer);
+  size_t remaining = _size;
+  while (remaining > 0) {
+    if (cursor_ < block_.size()) {
+      const size_t available = block_.size() - cursor_;
+      const size_t chunk = remaining < available ? remaining : available;
+      std::memcpy(out, block_.data() + cursor_, chunk);
+      cursor_ += chunk;
+      out += chunk;
+      remaining -= chunk;
+    } else if (!NextBlock(block_start_ + block_.size())) {
+      break;
+    }
+  }
+  return _size - remaining;
+}
+
+int CompressedStream::Seek(int _offset, Origin _origin) {
+  if (mode_ != kRead || !valid_) {
+    return -1;
+  }
+
+  // Computes target logical (uncompressed) offset.
+  ptrdiff_t target;
+  switch (_origin) {
+    case kCurrent:
+      target = Tell() + _offset;
+      break;
+    case kEnd:
+      target = total_ + _offset;
+      break;
+    case kSet:
+      target = _offset;
+      break;
+    default:
+      return -1;
+  }
+  if (target < 0 || static_cast<size_t>(target) > total_) {
+    return -1;
+  }
+  const size_t starget = static_cast<size_t>(target);
+
+  // Backward seeks before the current block restart from the first block.
+  if (starget < block_start_) {
+    if (stream_->Seek(header_pos_ + sizeof(ContainerHeader), kSet) != 0) {
+      valid_ = false;
+      return -1;
+    }
+    block_.clear();
+    block_start_ = 0;
+    cursor_ = 0;
+  }
+
+  // Walks blocks forward, skipping those before the target without inflating
+  // them.
+  while (starget > block_start_ + block_.size()) {
+    if (!NextBlock(starget)) {
+      return -1;
+    }
+  }
+  cursor_ = starget - block_start_;
+  return 0;
+}
+
+int CompressedStream::Tell() const {
+  if (!valid_) {
+    return -1;
+  }
+  return static_cast<int>(mode_ == kWrite ? total_ : block_start_ + cursor_);
+}
+
+size_t CompressedStream::Size() const { return total_; }
+}  // namespace io
+}  // namespace ozz
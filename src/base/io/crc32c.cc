@@ -0,0 +1,89 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/base/io/crc32c.h"
+
+#include <cstring>
+
+// Brings in OZZ_SIMD_* definitions and the matching intrinsic headers.
+#include "ozz/base/maths/internal/simd_math_config.h"
+
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif  // __ARM_FEATURE_CRC32
+
+namespace ozz {
+namespace io {
+
+uint32_t CRC32C(uint32_t _crc, const void* _data, size_t _size) {
+  // CRC32C instructions and the bitwise fallback below work on the inverted
+  // crc state, which is what makes incremental calls compose.
+  uint32_t crc = ~_crc;
+  const unsigned char* data = static_cast<const unsigned char*>(_data);
+
+#if defined(OZZ_SIMD_SSE4_2)
+#if defined(__x86_64__) || defined(_M_X64)
+  // Crunches 8 bytes at a time, which is how the instruction peaks.
+  uint64_t crc64 = crc;
+  for (; _size >= 8; _size -= 8, data += 8) {
+    uint64_t chunk;
+    std::memcpy(&chunk, data, sizeof(chunk));  // Alignment safe load.
+    crc64 = _mm_crc32_u64(crc64, chunk);
+  }
+  crc = static_cast<uint32_t>(crc64);
+#else   // The 64 bits crc instruction doesn't exist in 32 bits mode.
+  for (; _size >= 4; _size -= 4, data += 4) {
+    uint32_t chunk;
+    std::memcpy(&chunk, data, sizeof(chunk));  // Alignment safe load.
+    crc = _mm_crc32_u32(crc, chunk);
+  }
+#endif  // __x86_64__ || _M_X64
+  for (; _size != 0; --_size, ++data) {
+    crc = _mm_crc32_u8(crc, *data);
+  }
+#elif defined(__ARM_FEATURE_CRC32)
+  for (; _size >= 8; _size -= 8, data += 8) {
+    uint64_t chunk;
+    std::memcpy(&chunk, data, sizeof(chunk));  // Alignment safe load.
+    crc = __crc32cd(crc, chunk);
+  }
+  for (; _size != 0; --_size, ++data) {
+    crc = __crc32cb(crc, *data);
+  }
+#else   // Portable bitwise implementation, reflected Castagnoli polynomial.
+  for (; _size != 0; --_size, ++data) {
+    crc ^= *data;
+    for (int i = 0; i < 8; ++i) {
+      crc = (crc >> 1) ^ (0x82f63b78u & (0u - (crc & 1)));
+    }
+  }
+#endif  // OZZ_SIMD_SSE4_2
+
+  return ~crc;
+}
+}  // namespace io
+}  // namespace ozz
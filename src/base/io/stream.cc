@@ -107,6 +107,83 @@ size_t File::Size() const {
   return static_cast<size_t>(end);
 }
 
+// Starts BufferedStream implementation.
+BufferedStream::BufferedStream(Stream* _stream, size_t _buffer_size)
+    : stream_(_stream),
+      buffer_(reinterpret_cast<byte*>(
+          ozz::memory::default_allocator()->Allocate(_buffer_size, 16))),
+      buffer_size_(_buffer_size),
+      pending_(0) {
+  assert(stream_ && stream_->opened() &&
+         "_stream argument must point a valid opened stream.");
+  assert(_buffer_size > 0 && "Buffer size must be positive.");
+}
+
+BufferedStream::~BufferedStream() {
+  Flush();
+  ozz::memory::default_allocator()->Deallocate(buffer_);
+  buffer_ = nullptr;
+}
+
+bool BufferedStream::Flush() {
+  if (pending_ == 0) {
+    // Avoids a zero sized backend write, which would gap-fill a stream that
+    // was seeked beyond its end.
+    return true;
+  }
+  const size_t pending = pending_;
+  pending_ = 0;
+  return stream_->Write(buffer_, pending) == pending;
+}
+
+bool BufferedStream::opened() const { return stream_->opened(); }
+
+size_t BufferedStream::Read(void* _buffer, size_t _size) {
+  Flush();
+  return stream_->Read(_buffer, _size);
+}
+
+size_t BufferedStream::Write(const void* _buffer, size_t _size) {
+  if (pending_ + _size > buffer_size_) {
+    if (!Flush()) {
+      return 0;
+    }
+    if (_size >= buffer_size_) {
+      // Bigger-than-buffer payloads (POD arrays...) go straight to the
+      // backend, buffering them would only add a copy.
+      return stream_->Write(_buffer, _size);
+    }
+  }
+  std::memcpy(buffer_ + pending_, _buffer, _size);
+  pending_ += _size;
+  return _size;
+}
+
+int BufferedStream::Seek(int _offset, Origin _origin) {
+  if (!Flush()) {
+    return -1;
+  }
+  return stream_->Seek(_offset, _origin);
+}
+
+int BufferedStream::Tell() const {
+  const int tell = stream_->Tell();
+  return tell < 0 ? tell : tell + static_cast<int>(pending_);
+}
+
+size_t BufferedStream::Size() const {
+  size_t size = stream_->Size();
+  if (pending_ > 0) {
+    // Pending bytes will be written at the backend position, they extend the
+    // size if they reach past its current end.
+    const int tell = stream_->Tell();
+    if (tell >= 0 && tell + pending_ > size) {
+      size = tell + pending_;
+    }
+  }
+  return size;
+}
+
 // Starts MemoryStream implementation.
 const size_t MemoryStream::kBufferSizeIncrement = 16 << 10;
 const size_t MemoryStream::kMaxSize = std::numeric_limits<int>::max();
@@ -203,7 +280,11 @@ bool MemoryStream::Resize(size_t _size) {
     static_assert(
         (MemoryStream::kBufferSizeIncrement & (kBufferSizeIncrement - 1)) == 0,
         "kBufferSizeIncrement must be a power of 2");
-    const size_t new_size = ozz::Align(_size, kBufferSizeIncrement);
+    // Grows geometrically so that writing a stream of n bytes with small
+    // writes copies O(n) bytes overall, instead of O(n^2) with fixed size
+    // increments.
+    const size_t wanted = math::Max(_size, alloc_size_ + alloc_size_ / 2);
+    const size_t new_size = ozz::Align(wanted, kBufferSizeIncrement);
     byte* new_buffer = reinterpret_cast<byte*>(
         ozz::memory::default_allocator()->Allocate(new_size, 16));
     if (buffer_ != nullptr) {
@@ -27,8 +27,14 @@
 
 #include "ozz/base/log.h"
 
+#include <atomic>
+#include <cassert>
+#include <chrono>
 #include <iomanip>
+#include <new>
 #include <sstream>
+#include <string>
+#include <thread>
 
 #include "ozz/base/memory/allocator.h"
 
@@ -40,6 +46,132 @@ namespace {
 Level log_level = kStandard;
 }
 
+namespace {
+
+// Bounded multi-producer single-consumer message queue, based on D. Vyukov's
+// bounded mpmc queue algorithm. Logging threads enqueue formatted messages
+// without taking a lock, the background thread dequeues them and performs the
+// actual stream output.
+class AsyncQueue {
+ public:
+  explicit AsyncQueue(size_t _capacity) : enqueue_(0), dequeue_(0) {
+    // Rounds capacity up to a power of 2, as required by the index masking
+    // scheme.
+    size_t capacity = 16;
+    while (capacity < _capacity) {
+      capacity *= 2;
+    }
+    mask_ = capacity - 1;
+    cells_ = reinterpret_cast<Cell*>(memory::default_allocator()->Allocate(
+        sizeof(Cell) * capacity, alignof(Cell)));
+    for (size_t i = 0; i < capacity; ++i) {
+      new (cells_ + i) Cell();
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    exit_.store(false, std::memory_order_relaxed);
+    thread_ = std::thread(&AsyncQueue::Loop, this);
+  }
+
+  ~AsyncQueue() {
+    exit_.store(true, std::memory_order_release);
+    // Loop drains remaining messages before exiting.
+    thread_.join();
+    for (size_t i = 0; i <= mask_; ++i) {
+      cells_[i].~Cell();
+    }
+    memory::default_allocator()->Deallocate(cells_);
+  }
+
+  // Enqueues a message targeting _stream. Returns false if the queue is full,
+  // in which case the caller shall fall back to a synchronous write.
+  bool Push(std::ostream* _stream, std::string&& _text) {
+    size_t pos = enqueue_.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell& cell = cells_[pos & mask_];
+      const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      const intptr_t diff =
+          static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (enqueue_.compare_exchange_weak(pos, pos + 1,
+                                           std::memory_order_relaxed)) {
+          cell.stream = _stream;
+          cell.text = std::move(_text);
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;  // Queue is full.
+      } else {
+        pos = enqueue_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+ private:
+  AsyncQueue(const AsyncQueue&);
+  void operator=(const AsyncQueue&);
+
+  // Background thread entry, writes queued messages until exit is requested.
+  void Loop() {
+    for (;;) {
+      if (!Pop()) {
+        if (exit_.load(std::memory_order_acquire)) {
+          // Drains messages that were pushed before exit was requested.
+          while (Pop()) {
+          }
+          return;
+        }
+        // Sleep-polls rather than blocking on a condition variable, so
+        // producers never touch a lock.
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+  }
+
+  // Dequeues and outputs a single message. Returns false if the queue is
+  // empty. Called from the single consumer thread only.
+  bool Pop() {
+    const size_t pos = dequeue_.load(std::memory_order_relaxed);
+    Cell& cell = cells_[pos & mask_];
+    const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    if (sequence != pos + 1) {
+      return false;
+    }
+    *cell.stream << cell.text;
+    cell.text.clear();
+    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+    dequeue_.store(pos + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // A queue slot. sequence implements the queue protocol: it equals the
+  // enqueue position when the cell is free, position + 1 when it holds a
+  // message.
+  struct Cell {
+    std::atomic<size_t> sequence;
+    std::ostream* stream;
+    std::string text;
+  };
+
+  // Ring buffer of mask_ + 1 cells.
+  Cell* cells_;
+  size_t mask_;
+
+  // Producers and consumer positions.
+  std::atomic<size_t> enqueue_;
+  std::atomic<size_t> dequeue_;
+
+  // Exit request, set by the destructor.
+  std::atomic<bool> exit_;
+
+  // Consumer thread.
+  std::thread thread_;
+};
+
+// The installed queue, nullptr while no AsyncSink exists.
+std::atomic<AsyncQueue*> async_queue(nullptr);
+}  // namespace
+
 Level SetLevel(Level _level) {
   const Level previous_level = log_level;
   log_level = _level;
@@ -57,14 +189,44 @@ Out::Out() : Logger(std::cout, kStandard) {}
 Err::Err() : Logger(std::cerr, kStandard) {}
 
 Logger::Logger(std::ostream& _stream, Level _level)
-    : stream_(_level <= GetLevel() ? _stream : *ozz::New<std::ostringstream>()),
+    // The async queue is sampled once, so that construction and destruction
+    // take a consistent decision.
+    : deferred_(_level <= GetLevel() &&
+                        async_queue.load(std::memory_order_acquire) != nullptr
+                    ? &_stream
+                    : nullptr),
+      stream_(_level <= GetLevel() && !deferred_
+                  ? _stream
+                  : *ozz::New<std::ostringstream>()),
       local_stream_(&stream_ != &_stream) {}
 Logger::~Logger() {
+  if (deferred_) {
+    // Forwards the formatted message to the background sink. Falls back to a
+    // synchronous write if the sink is full or was removed meanwhile.
+    std::ostringstream& local = static_cast<std::ostringstream&>(stream_);
+    AsyncQueue* queue = async_queue.load(std::memory_order_acquire);
+    if (!queue || !queue->Push(deferred_, local.str())) {
+      *deferred_ << local.str();
+    }
+  }
   if (local_stream_) {
       ozz::Delete(&stream_);
   }
 }
 
+AsyncSink::AsyncSink(size_t _max_pending) {
+  assert(async_queue.load(std::memory_order_relaxed) == nullptr &&
+         "A single AsyncSink can be installed at a time.");
+  async_queue.store(ozz::New<AsyncQueue>(_max_pending),
+                    std::memory_order_release);
+}
+
+AsyncSink::~AsyncSink() {
+  AsyncQueue* queue = async_queue.exchange(nullptr, std::memory_order_acq_rel);
+  // Drains pending messages.
+  ozz::Delete(queue);
+}
+
 FloatPrecision::FloatPrecision(const Logger& _logger, int _precision)
     : precision_(_logger.stream().precision(_precision)),
       format_(_logger.stream().setf(std::ios_base::fixed,
@@ -56,6 +56,69 @@ Box::Box(const Float3* _points, size_t _stride, size_t _count) {
   max = local_max;
 }
 
+Box TranslationsBox(const span<const Float4x4>& _matrices) {
+  Box box;
+  if (_matrices.empty()) {
+    return box;
+  }
+
+  // 4 independent accumulator pairs break the min/max dependency chain,
+  // processing 4 matrices per iteration.
+  const SimdFloat4 fmax = simd_float4::Load1(std::numeric_limits<float>::max());
+  const SimdFloat4 fmin =
+      simd_float4::Load1(-std::numeric_limits<float>::max());
+  SimdFloat4 mins[4] = {fmax, fmax, fmax, fmax};
+  SimdFloat4 maxs[4] = {fmin, fmin, fmin, fmin};
+
+  const size_t count = _matrices.size();
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    for (size_t j = 0; j < 4; ++j) {
+      const SimdFloat4 translation = _matrices[i + j].cols[3];
+      mins[j] = Min(mins[j], translation);
+      maxs[j] = Max(maxs[j], translation);
+    }
+  }
+  for (; i < count; ++i) {  // Remaining matrices.
+    const SimdFloat4 translation = _matrices[i].cols[3];
+    mins[0] = Min(mins[0], translation);
+    maxs[0] = Max(maxs[0], translation);
+  }
+
+  // Reduces accumulators and stores them in box.
+  Store3PtrU(Min(Min(mins[0], mins[1]), Min(mins[2], mins[3])), &box.min.x);
+  Store3PtrU(Max(Max(maxs[0], maxs[1]), Max(maxs[2], maxs[3])), &box.max.x);
+  return box;
+}
+
+Box Merge(const span<const Box>& _boxes) {
+  SimdFloat4 min = simd_float4::Load1(std::numeric_limits<float>::max());
+  SimdFloat4 max = simd_float4::Load1(-std::numeric_limits<float>::max());
+  for (const Box& box : _boxes) {
+    const SimdFloat4 bmin = simd_float4::Load3PtrU(&box.min.x);
+    const SimdFloat4 bmax = simd_float4::Load3PtrU(&box.max.x);
+    // Ignores invalid boxes, as the 2 boxes Merge does.
+    if (!AreAllTrue3(CmpLe(bmin, bmax))) {
+      continue;
+    }
+    min = Min(min, bmin);
+    max = Max(max, bmax);
+  }
+  Box merged;
+  Store3PtrU(min, &merged.min.x);
+  Store3PtrU(max, &merged.max.x);
+  return merged;
+}
+
+void TransformBoxes(const Float4x4& _matrix, const span<const Box>& _input,
+                    const span<Box>& _output) {
+  assert(_output.size() >= _input.size() &&
+         "_output must be at least _input sized");
+  for (size_t i = 0; i < _input.size(); ++i) {
+    _output[i] = TransformBox(_matrix, _input[i]);
+  }
+}
+
 Box TransformBox(const Float4x4& _matrix, const Box& _box) {
   const SimdFloat4 min = simd_float4::Load3PtrU(&_box.min.x);
   const SimdFloat4 max = simd_float4::Load3PtrU(&_box.max.x);
@@ -42,9 +42,91 @@ namespace {
 struct Header {
   void* unaligned;
   size_t size;
+  size_t tag;  // Allocation tag, or kUntracked.
 };
+
+// Tag value stored in headers of allocations performed while tracking was
+// disabled, so they don't alter statistics when freed.
+const size_t kUntracked = static_cast<size_t>(AllocationTag::kCount);
+
+// Tracking state and per tag counters. Counters are relaxed atomics, peak is
+// maintained with a compare-exchange loop.
+std::atomic<bool> g_tracking(false);
+struct TagCounters {
+  std::atomic<size_t> live_bytes;
+  std::atomic<size_t> peak_bytes;
+  std::atomic<size_t> live_count;
+  std::atomic<size_t> total_count;
+};
+TagCounters g_counters[AllocationTag::kCount];
+
+// Current thread allocation tag, driven by AllocationScope.
+thread_local AllocationTag::Value tl_allocation_tag = AllocationTag::kDefault;
+
+// Accounts for a new _size bytes allocation, returning the tag to store in
+// the block header.
+size_t TrackAllocate(size_t _size) {
+  if (!g_tracking.load(std::memory_order_relaxed)) {
+    return kUntracked;
+  }
+  const size_t tag = static_cast<size_t>(tl_allocation_tag);
+  TagCounters& counters = g_counters[tag];
+  counters.total_count.fetch_add(1, std::memory_order_relaxed);
+  counters.live_count.fetch_add(1, std::memory_order_relaxed);
+  const size_t live =
+      counters.live_bytes.fetch_add(_size, std::memory_order_relaxed) + _size;
+  size_t peak = counters.peak_bytes.load(std::memory_order_relaxed);
+  while (live > peak && !counters.peak_bytes.compare_exchange_weak(
+                            peak, live, std::memory_order_relaxed)) {
+  }
+  return tag;
+}
+
+// Accounts for the deallocation of a block allocated with _tag. Blocks
+// allocated while tracking was disabled are ignored, so statistics cannot
+// underflow.
+void TrackDeallocate(size_t _tag, size_t _size) {
+  if (_tag == kUntracked) {
+    return;
+  }
+  TagCounters& counters = g_counters[_tag];
+  counters.live_bytes.fetch_sub(_size, std::memory_order_relaxed);
+  counters.live_count.fetch_sub(1, std::memory_order_relaxed);
+}
 }  // namespace
 
+bool SetAllocationTracking(bool _enabled) {
+  const bool previous = g_tracking.exchange(_enabled);
+  if (_enabled && !previous) {
+    // (Re)starts tracking from a clean state.
+    for (size_t i = 0; i < AllocationTag::kCount; ++i) {
+      g_counters[i].live_bytes.store(0);
+      g_counters[i].peak_bytes.store(0);
+      g_counters[i].live_count.store(0);
+      g_counters[i].total_count.store(0);
+    }
+  }
+  return previous;
+}
+
+AllocationStats GetAllocationStats(AllocationTag::Value _tag) {
+  assert(_tag < AllocationTag::kCount);
+  const TagCounters& counters = g_counters[_tag];
+  const AllocationStats stats = {
+      counters.live_bytes.load(std::memory_order_relaxed),
+      counters.peak_bytes.load(std::memory_order_relaxed),
+      counters.live_count.load(std::memory_order_relaxed),
+      counters.total_count.load(std::memory_order_relaxed)};
+  return stats;
+}
+
+AllocationScope::AllocationScope(AllocationTag::Value _tag)
+    : previous_(tl_allocation_tag) {
+  tl_allocation_tag = _tag;
+}
+
+AllocationScope::~AllocationScope() { tl_allocation_tag = previous_; }
+
 // Implements the basic heap allocator.
 // Will trace allocation count and assert in case of a memory leak.
 class HeapAllocator : public Allocator {
@@ -69,6 +151,7 @@ class HeapAllocator : public Allocator {
     assert(reinterpret_cast<char*>(header) >= unaligned);
     header->unaligned = unaligned;
     header->size = _size;
+    header->tag = TrackAllocate(_size);
     // Allocation's succeeded.
     ++allocation_count_;
     return aligned;
@@ -78,6 +161,7 @@ class HeapAllocator : public Allocator {
     if (_block) {
       Header* header = reinterpret_cast<Header*>(
           reinterpret_cast<char*>(_block) - sizeof(Header));
+      TrackDeallocate(header->tag, header->size);
       free(header->unaligned);
       // Deallocation completed.
       --allocation_count_;
@@ -0,0 +1,153 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/base/memory/arena_allocator.h"
+
+#include <cassert>
+
+#include "ozz/base/maths/math_ex.h"
+
+namespace ozz {
+namespace memory {
+
+// Intrusive chunk header, immediately followed by the chunk payload.
+struct ArenaAllocator::Chunk {
+  // Payload starts right after the header.
+  byte* payload() { return reinterpret_cast<byte*>(this) + sizeof(Chunk); }
+
+  Chunk* next;
+
+  // Total size allocated from the backing allocator, header included.
+  size_t size;
+};
+
+ArenaAllocator::ArenaAllocator(size_t _chunk_size, Allocator* _backing)
+    : backing_(_backing != nullptr ? _backing : default_allocator()),
+      chunk_size_(math::Max(_chunk_size, sizeof(Chunk) + 1)) {}
+
+ArenaAllocator::~ArenaAllocator() { Reset(); }
+
+void* ArenaAllocator::Allocate(size_t _size, size_t _alignment) {
+  assert(_alignment != 0 && (_alignment & (_alignment - 1)) == 0 &&
+         "Alignment must be a power of two.");
+  const size_t chunk_capacity = chunk_size_ - sizeof(Chunk);
+  byte* aligned = Align(cursor_, _alignment);
+  if (cursor_ == nullptr || aligned + _size > end_) {
+    // The current chunk is exhausted.
+    if (_size + _alignment - 1 > chunk_capacity) {
+      // Oversized allocations get a dedicated chunk, linked behind the
+      // current one so the remaining bump space isn't wasted.
+      Chunk* chunk = NewChunk(_size + _alignment - 1);
+      if (chunks_ != nullptr) {
+        chunk->next = chunks_->next;
+        chunks_->next = chunk;
+      } else {
+        chunks_ = chunk;
+      }
+      return Align(chunk->payload(), _alignment);
+    }
+    // Opens a new chunk and restarts bumping from its payload.
+    Chunk* chunk = NewChunk(chunk_capacity);
+    chunk->next = chunks_;
+    chunks_ = chunk;
+    cursor_ = chunk->payload();
+    end_ = cursor_ + chunk_capacity;
+    aligned = Align(cursor_, _alignment);
+  }
+  cursor_ = aligned + _size;
+  return aligned;
+}
+
+void ArenaAllocator::Deallocate(void*) {
+  // Individual deallocation is a no-op, see Reset.
+}
+
+void ArenaAllocator::Reset() {
+  for (Chunk* chunk = chunks_; chunk != nullptr;) {
+    Chunk* next = chunk->next;
+    backing_->Deallocate(chunk);
+    chunk = next;
+  }
+  chunks_ = nullptr;
+  cursor_ = nullptr;
+  end_ = nullptr;
+  reserved_ = 0;
+}
+
+void ArenaAllocator::Rewind(Chunk* _chunk, Chunk* _next, byte* _cursor,
+                            byte* _end) {
+  // Releases the chunks opened since the capture. They are all linked between
+  // the head and the captured chunk, but for oversized chunks which can have
+  // been inserted right behind a captured head (see Allocate), hence between
+  // the captured chunk and its captured successor.
+  Chunk* chunk = chunks_;
+  for (; chunk != _chunk;) {
+    assert(chunk != nullptr && "Scopes must be rewound in LIFO order.");
+    Chunk* next = chunk->next;
+    reserved_ -= chunk->size;
+    backing_->Deallocate(chunk);
+    chunk = next;
+  }
+  if (chunk != nullptr) {
+    for (chunk = chunk->next; chunk != _next;) {
+      assert(chunk != nullptr && "Scopes must be rewound in LIFO order.");
+      Chunk* next = chunk->next;
+      reserved_ -= chunk->size;
+      backing_->Deallocate(chunk);
+      chunk = next;
+    }
+    _chunk->next = _next;
+  }
+
+  // Restores the bump cursor.
+  chunks_ = _chunk;
+  cursor_ = _cursor;
+  end_ = _end;
+}
+
+ArenaAllocator::Chunk* ArenaAllocator::NewChunk(size_t _capacity) {
+  const size_t size = sizeof(Chunk) + _capacity;
+  Chunk* chunk =
+      static_cast<Chunk*>(backing_->Allocate(size, alignof(Chunk)));
+  chunk->next = nullptr;
+  chunk->size = size;
+  reserved_ += size;
+  return chunk;
+}
+
+ArenaAllocator::Scope::Scope(ArenaAllocator& _arena)
+    : arena_(_arena),
+      chunk_(_arena.chunks_),
+      next_(_arena.chunks_ != nullptr ? _arena.chunks_->next : nullptr),
+      cursor_(_arena.cursor_),
+      end_(_arena.end_) {}
+
+ArenaAllocator::Scope::~Scope() {
+  arena_.Rewind(chunk_, next_, cursor_, end_);
+}
+}  // namespace memory
+}  // namespace ozz
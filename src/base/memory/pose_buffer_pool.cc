@@ -0,0 +1,127 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/base/memory/pose_buffer_pool.h"
+
+#include <cassert>
+
+#include "ozz/base/memory/allocator.h"
+
+namespace ozz {
+namespace memory {
+
+// Definitions of class static constants, required as they are odr-used.
+const size_t PoseBufferPool::kAlignment;
+const size_t PoseBufferPool::kNumBuckets;
+
+namespace {
+// Finds the bucket whose size is the smallest power of two (starting from
+// kAlignment) that fits _size. Returns kNumBuckets for sizes too big to be
+// pooled.
+size_t BucketIndex(size_t _size) {
+  size_t bucket = 0;
+  for (size_t bucket_size = PoseBufferPool::kAlignment; bucket_size < _size;
+       bucket_size *= 2) {
+    ++bucket;
+  }
+  return bucket;
+}
+
+// Size of the bucket at _index.
+size_t BucketSize(size_t _index) {
+  return PoseBufferPool::kAlignment << _index;
+}
+}  // namespace
+
+PoseBufferPool::~PoseBufferPool() {
+  assert(num_acquired_ == 0 &&
+         "All acquired buffers must be released before pool destruction.");
+  Trim();
+}
+
+span<byte> PoseBufferPool::Acquire(size_t _size) {
+  if (_size == 0) {
+    return {};
+  }
+  OZZ_IF_DEBUG(++num_acquired_;)
+
+  const size_t bucket = BucketIndex(_size);
+  if (bucket < kNumBuckets) {
+    // Pops the most recently released buffer of this bucket, if any. LIFO
+    // reuse maximizes the chances of handing out cache-warm memory.
+    vector<byte*>& free_list = free_lists_[bucket];
+    if (!free_list.empty()) {
+      byte* buffer = free_list.back();
+      free_list.pop_back();
+      return {buffer, _size};
+    }
+  }
+
+  // No recycled buffer available, allocates a new one. Buffers too big to be
+  // pooled also end up here, they'll be freed at release time.
+  const size_t allocated_size =
+      bucket < kNumBuckets ? BucketSize(bucket) : _size;
+  byte* buffer = reinterpret_cast<byte*>(
+      default_allocator()->Allocate(allocated_size, kAlignment));
+  return {buffer, _size};
+}
+
+void PoseBufferPool::Release(const span<byte>& _buffer) {
+  if (_buffer.empty()) {
+    return;
+  }
+  assert(num_acquired_ > 0 && "More buffers released than acquired.");
+  OZZ_IF_DEBUG(--num_acquired_;)
+
+  const size_t bucket = BucketIndex(_buffer.size());
+  if (bucket < kNumBuckets) {
+    free_lists_[bucket].push_back(_buffer.data());
+  } else {
+    // Buffer wasn't pooled, returns it straight to the allocator.
+    default_allocator()->Deallocate(_buffer.data());
+  }
+}
+
+void PoseBufferPool::Trim() {
+  for (size_t bucket = 0; bucket < kNumBuckets; ++bucket) {
+    vector<byte*>& free_list = free_lists_[bucket];
+    for (byte* buffer : free_list) {
+      default_allocator()->Deallocate(buffer);
+    }
+    free_list.clear();
+  }
+}
+
+size_t PoseBufferPool::num_recycled() const {
+  size_t count = 0;
+  for (size_t bucket = 0; bucket < kNumBuckets; ++bucket) {
+    count += free_lists_[bucket].size();
+  }
+  return count;
+}
+}  // namespace memory
+}  // namespace ozz
@@ -0,0 +1,194 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/base/scheduler.h"
+
+#include <cassert>
+
+#include "ozz/base/maths/math_ex.h"
+#include "ozz/base/memory/allocator.h"
+
+namespace ozz {
+
+Scheduler::~Scheduler() {}
+
+void SerialScheduler::ParallelFor(int _begin, int _end, int _granularity,
+                                  RangeFn _fn, void* _context) {
+  (void)_granularity;
+  if (_begin < _end) {
+    _fn(_context, _begin, _end);
+  }
+}
+
+// Per worker thread state. The deque is guarded by its own mutex, keeping
+// contention local: a worker only contends with thieves targeting its deque.
+struct ThreadPoolScheduler::Worker {
+  std::thread thread;
+  std::mutex mutex;
+  ozz::deque<Task> tasks;
+};
+
+ThreadPoolScheduler::ThreadPoolScheduler(int _num_workers) : num_pending_(0) {
+  int num_workers = _num_workers;
+  if (num_workers <= 0) {
+    // Keeps one thread for the caller, which always participates.
+    num_workers =
+        math::Max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+  }
+
+  workers_.resize(num_workers);
+  for (int i = 0; i < num_workers; ++i) {
+    workers_[i] = make_unique<Worker>();
+  }
+  // Threads are started once all deques are allocated, as any worker can
+  // steal from any other.
+  for (int i = 0; i < num_workers; ++i) {
+    workers_[i]->thread = std::thread(&ThreadPoolScheduler::WorkerLoop, this, i);
+  }
+}
+
+ThreadPoolScheduler::~ThreadPoolScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    assert(num_pending_ == 0 && "Tasks can't outlive their ParallelFor call.");
+    quit_ = true;
+  }
+  cv_.notify_all();
+  for (size_t i = 0; i < workers_.size(); ++i) {
+    workers_[i]->thread.join();
+  }
+}
+
+void ThreadPoolScheduler::WorkerLoop(int _index) {
+  Task task;
+  for (;;) {
+    // Drains available tasks.
+    while (PopOrSteal(_index, &task)) {
+      task.fn(task.context, task.begin, task.end);
+      task.remaining->fetch_sub(1, std::memory_order_release);
+    }
+
+    // Out of work, goes to sleep until more tasks are submitted. num_pending_
+    // is re-tested under the mutex, so a submission can't be missed.
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (quit_) {
+      return;
+    }
+    if (num_pending_.load(std::memory_order_acquire) == 0) {
+      cv_.wait(lock);
+    }
+  }
+}
+
+bool ThreadPoolScheduler::PopOrSteal(int _index, Task* _task) {
+  // Pops from the front of this worker's own deque first.
+  if (_index >= 0) {
+    Worker& worker = *workers_[_index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (!worker.tasks.empty()) {
+      *_task = worker.tasks.front();
+      worker.tasks.pop_front();
+      num_pending_.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+
+  // Steals from the back of other workers' deques. Starts after this worker's
+  // own deque so thieves don't all hammer the same victim.
+  const int num_workers = static_cast<int>(workers_.size());
+  for (int i = 0; i < num_workers; ++i) {
+    const int victim = (_index + 1 + i) % num_workers;
+    if (victim == _index) {
+      continue;
+    }
+    Worker& worker = *workers_[victim];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (!worker.tasks.empty()) {
+      *_task = worker.tasks.back();
+      worker.tasks.pop_back();
+      num_pending_.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPoolScheduler::ParallelFor(int _begin, int _end, int _granularity,
+                                      RangeFn _fn, void* _context) {
+  if (_begin >= _end) {
+    return;
+  }
+
+  // Runs the whole range inline when it's not worth dispatching.
+  const int granularity = math::Max(_granularity, 1);
+  const int count = _end - _begin;
+  if (workers_.empty() || count <= granularity) {
+    _fn(_context, _begin, _end);
+    return;
+  }
+
+  // Splits the range into more tasks than threads, so that work stealing can
+  // re-balance uneven workloads.
+  const int num_threads = num_workers() + 1;
+  const int chunk =
+      math::Max(granularity, (count + num_threads * 4 - 1) / (num_threads * 4));
+  const int num_tasks = (count + chunk - 1) / chunk;
+
+  // Remaining task count lives on this stack frame, as the call blocks until
+  // it reaches 0. This allows concurrent and nested ParallelFor calls to
+  // share worker deques.
+  std::atomic<int> remaining(num_tasks);
+
+  // Distributes tasks round-robin to worker deques.
+  for (int begin = _begin, i = 0; begin < _end; begin += chunk, ++i) {
+    const Task task = {begin, math::Min(begin + chunk, _end), _fn, _context,
+                       &remaining};
+    Worker& worker = *workers_[i % workers_.size()];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.tasks.push_back(task);
+  }
+  {
+    // Publishes the new pending count under the mutex, so sleeping workers
+    // can't miss it, then wakes them all up.
+    std::lock_guard<std::mutex> lock(mutex_);
+    num_pending_.fetch_add(num_tasks, std::memory_order_release);
+  }
+  cv_.notify_all();
+
+  // The calling thread participates by stealing tasks, then waits for workers
+  // to complete the in-flight ones.
+  Task task;
+  while (remaining.load(std::memory_order_acquire) != 0) {
+    if (PopOrSteal(-1, &task)) {
+      task.fn(task.context, task.begin, task.end);
+      task.remaining->fetch_sub(1, std::memory_order_release);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+}  // namespace ozz
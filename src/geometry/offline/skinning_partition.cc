@@ -0,0 +1,125 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/geometry/offline/skinning_partition.h"
+
+#include <cstring>
+
+namespace ozz {
+namespace geometry {
+namespace offline {
+
+bool PartitionVertices(const span<const int>& _influences_counts,
+                       ozz::vector<uint32_t>* _remap,
+                       ozz::vector<SkinningPartition>* _partitions) {
+  if (_remap == nullptr || _partitions == nullptr) {
+    return false;
+  }
+  _remap->clear();
+  _partitions->clear();
+
+  // Finds the range of influences counts, rejecting invalid ones.
+  int max_influences = 0;
+  for (int count : _influences_counts) {
+    if (count < 1) {
+      return false;
+    }
+    max_influences = count > max_influences ? count : max_influences;
+  }
+  if (_influences_counts.empty()) {
+    return true;
+  }
+
+  // Counting sort, stable so vertex order is preserved inside partitions.
+  // Counts vertices per influences count (1 based).
+  ozz::vector<size_t> buckets(static_cast<size_t>(max_influences), 0);
+  for (int count : _influences_counts) {
+    ++buckets[count - 1];
+  }
+
+  // Converts counts to partition start indices, and emits partitions.
+  size_t begin = 0;
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    const size_t count = buckets[i];
+    buckets[i] = begin;
+    if (count != 0) {
+      const SkinningPartition partition = {static_cast<int>(i + 1), begin,
+                                           count};
+      _partitions->push_back(partition);
+    }
+    begin += count;
+  }
+
+  // Assigns each vertex its partitioned index.
+  _remap->resize(_influences_counts.size());
+  for (size_t i = 0; i < _influences_counts.size(); ++i) {
+    (*_remap)[i] =
+        static_cast<uint32_t>(buckets[_influences_counts[i] - 1]++);
+  }
+  return true;
+}
+
+namespace {
+template <typename _Ty>
+bool RemapIndicesImpl(const span<const uint32_t>& _remap,
+                      const span<_Ty>& _indices) {
+  for (_Ty& index : _indices) {
+    if (index >= _remap.size()) {
+      return false;
+    }
+    index = static_cast<_Ty>(_remap[index]);
+  }
+  return true;
+}
+}  // namespace
+
+bool RemapIndices(const span<const uint32_t>& _remap,
+                  const span<uint16_t>& _indices) {
+  return RemapIndicesImpl(_remap, _indices);
+}
+
+bool RemapIndices(const span<const uint32_t>& _remap,
+                  const span<uint32_t>& _indices) {
+  return RemapIndicesImpl(_remap, _indices);
+}
+
+bool ReorderVertices(const span<const uint32_t>& _remap, size_t _stride,
+                     const span<const byte>& _input,
+                     const span<byte>& _output) {
+  const size_t size = _remap.size() * _stride;
+  if (_input.size() < size || _output.size() < size) {
+    return false;
+  }
+  for (size_t i = 0; i < _remap.size(); ++i) {
+    std::memcpy(_output.data() + _remap[i] * _stride,
+                _input.data() + i * _stride, _stride);
+  }
+  return true;
+}
+}  // namespace offline
+}  // namespace geometry
+}  // namespace ozz
@@ -0,0 +1,100 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/geometry/runtime/matrix_palette_job.h"
+
+#include <cassert>
+
+#include "ozz/base/maths/simd_math.h"
+
+namespace ozz {
+namespace geometry {
+
+MatrixPaletteJob::MatrixPaletteJob() {}
+
+bool MatrixPaletteJob::Validate() const {
+  bool valid = true;
+
+  // Checks inputs, required.
+  valid &= !input.empty();
+  valid &= !inverse_bind_poses.empty();
+
+  // Checks remap, optional. When provided it must cover the whole palette.
+  if (!joint_remap.empty()) {
+    valid &= joint_remap.size() >= inverse_bind_poses.size();
+  } else {
+    // Palette entries map to joints directly.
+    valid &= input.size() >= inverse_bind_poses.size();
+  }
+
+  // Checks outputs, at least one must be provided.
+  valid &= !output.empty() || !transposed_output.empty();
+  if (!output.empty()) {
+    valid &= output.size() >= inverse_bind_poses.size();
+  }
+  if (!transposed_output.empty()) {
+    valid &= transposed_output.size() >= inverse_bind_poses.size() * 12;
+  }
+
+  return valid;
+}
+
+bool MatrixPaletteJob::Run() const {
+  // Exit with an error if job is invalid.
+  if (!Validate()) {
+    return false;
+  }
+
+  const bool remapped = !joint_remap.empty();
+  const bool has_output = !output.empty();
+  const bool has_transposed = !transposed_output.empty();
+  float* transposed = transposed_output.data();
+
+  for (size_t i = 0; i < inverse_bind_poses.size(); ++i) {
+    // Fuses remapping and inverse bind-pose multiplication, so matrices are
+    // read and written in a single pass.
+    const size_t joint = remapped ? joint_remap[i] : i;
+    assert(joint < input.size() && "Joint remap index out of range.");
+    const math::Float4x4 palette = input[joint] * inverse_bind_poses[i];
+
+    if (has_output) {
+      output[i] = palette;
+    }
+    if (has_transposed) {
+      // The 4th line of an affine transformation matrix is (0, 0, 0, 1), so
+      // only the 3 first lines of the transposed matrix are stored.
+      math::SimdFloat4 lines[3];
+      math::Transpose4x3(palette.cols, lines);
+      math::StorePtrU(lines[0], transposed + i * 12 + 0);
+      math::StorePtrU(lines[1], transposed + i * 12 + 4);
+      math::StorePtrU(lines[2], transposed + i * 12 + 8);
+    }
+  }
+  return true;
+}
+}  // namespace geometry
+}  // namespace ozz
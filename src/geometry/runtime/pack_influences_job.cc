@@ -0,0 +1,100 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/geometry/runtime/pack_influences_job.h"
+
+namespace ozz {
+namespace geometry {
+
+PackInfluencesJob::PackInfluencesJob()
+    : vertex_count(0),
+      influences_count(0),
+      joint_indices_stride(0),
+      joint_weights_stride(0) {}
+
+bool PackInfluencesJob::Validate() const {
+  // Start validation of all parameters.
+  bool valid = true;
+
+  // Checks influences bounds.
+  valid &= influences_count > 0;
+
+  // Prepares local variables used to compute buffer size.
+  const int vertex_count_minus_1 = vertex_count > 0 ? vertex_count - 1 : 0;
+  const int vertex_count_at_least_1 = vertex_count > 0;
+
+  // Checks input and output indices, required.
+  valid &= joint_indices.size_bytes() >=
+           joint_indices_stride * vertex_count_minus_1 +
+               sizeof(uint16_t) * influences_count * vertex_count_at_least_1;
+  valid &= packed_indices.size() >=
+           static_cast<size_t>(influences_count) * vertex_count;
+
+  // Checks input and output weights, required if influences_count > 1.
+  if (influences_count != 1) {
+    valid &=
+        joint_weights.size_bytes() >=
+        joint_weights_stride * vertex_count_minus_1 +
+            sizeof(float) * (influences_count - 1) * vertex_count_at_least_1;
+    valid &= packed_weights.size() >=
+             static_cast<size_t>(influences_count - 1) * vertex_count;
+  }
+
+  return valid;
+}
+
+bool PackInfluencesJob::Run() const {
+  // Exit with an error if job is invalid.
+  if (!Validate()) {
+    return false;
+  }
+
+  // Transposes the interleaved per-vertex streams to slot-major buffers. The
+  // inner loop writes each slot's entries contiguously, matching the
+  // coalesced read pattern of one gpu thread per vertex.
+  const byte* indices = reinterpret_cast<const byte*>(joint_indices.data());
+  for (int s = 0; s < influences_count; ++s) {
+    uint16_t* packed = packed_indices.data() + s * vertex_count;
+    for (int v = 0; v < vertex_count; ++v) {
+      packed[v] = reinterpret_cast<const uint16_t*>(
+          indices + joint_indices_stride * v)[s];
+    }
+  }
+
+  const byte* weights = reinterpret_cast<const byte*>(joint_weights.data());
+  for (int s = 0; s < influences_count - 1; ++s) {
+    float* packed = packed_weights.data() + s * vertex_count;
+    for (int v = 0; v < vertex_count; ++v) {
+      packed[v] = reinterpret_cast<const float*>(
+          weights + joint_weights_stride * v)[s];
+    }
+  }
+
+  return true;
+}
+}  // namespace geometry
+}  // namespace ozz
@@ -0,0 +1,92 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/geometry/runtime/pose_pack_job.h"
+
+#include "ozz/base/maths/simd_math.h"
+
+namespace ozz {
+namespace geometry {
+
+PosePackJob::PosePackJob() {}
+
+bool PosePackJob::Validate() const {
+  bool valid = true;
+
+  // Checks input, required.
+  valid &= !input.empty();
+
+  // Checks outputs, at least one must be provided.
+  valid &= !output.empty() || !half_output.empty();
+  if (!output.empty()) {
+    valid &= output.size() >= input.size() * 12;
+  }
+  if (!half_output.empty()) {
+    valid &= half_output.size() >= input.size() * 12;
+  }
+
+  return valid;
+}
+
+bool PosePackJob::Run() const {
+  // Exit with an error if job is invalid.
+  if (!Validate()) {
+    return false;
+  }
+
+  const bool has_output = !output.empty();
+  const bool has_half = !half_output.empty();
+
+  for (size_t i = 0; i < input.size(); ++i) {
+    // The 4th row of an affine transformation matrix is (0, 0, 0, 1), so
+    // only the 3 first rows of the transposed matrix are stored.
+    math::SimdFloat4 rows[3];
+    math::Transpose4x3(input[i].cols, rows);
+
+    if (has_output) {
+      float* packed = output.data() + i * 12;
+      math::StorePtrU(rows[0], packed + 0);
+      math::StorePtrU(rows[1], packed + 4);
+      math::StorePtrU(rows[2], packed + 8);
+    }
+    if (has_half) {
+      uint16_t* packed = half_output.data() + i * 12;
+      for (int r = 0; r < 3; ++r) {
+        // Each converted lane holds a half in its 16 lower bits.
+        int halfs[4];
+        math::StorePtrU(math::FloatToHalf(rows[r]), halfs);
+        packed[r * 4 + 0] = static_cast<uint16_t>(halfs[0]);
+        packed[r * 4 + 1] = static_cast<uint16_t>(halfs[1]);
+        packed[r * 4 + 2] = static_cast<uint16_t>(halfs[2]);
+        packed[r * 4 + 3] = static_cast<uint16_t>(halfs[3]);
+      }
+    }
+  }
+  return true;
+}
+}  // namespace geometry
+}  // namespace ozz
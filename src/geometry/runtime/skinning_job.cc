@@ -30,6 +30,7 @@
 #include <cassert>
 
 #include "ozz/base/maths/simd_math.h"
+#include "ozz/base/profile.h"
 
 namespace ozz {
 namespace geometry {
@@ -39,12 +40,14 @@ SkinningJob::SkinningJob()
       influences_count(0),
       joint_indices_stride(0),
       joint_weights_stride(0),
+      blend_factors_stride(0),
       in_positions_stride(0),
       in_normals_stride(0),
       in_tangents_stride(0),
       out_positions_stride(0),
       out_normals_stride(0),
-      out_tangents_stride(0) {}
+      out_tangents_stride(0),
+      streaming_stores(false) {}
 
 bool SkinningJob::Validate() const {
   // Start validation of all parameters.
@@ -107,9 +110,178 @@ bool SkinningJob::Validate() const {
     valid &= in_tangents.empty();
   }
 
+  // Checks dual quaternions, optional. If provided, they activate dual
+  // quaternion skinning and must match the matrices palette size.
+  if (!joint_dual_quaternions.empty()) {
+    valid &= joint_dual_quaternions.size() == joint_matrices.size();
+
+    // Checks blend factors, optional but require dual quaternions.
+    if (!blend_factors.empty()) {
+      valid &= blend_factors.size_bytes() >=
+               blend_factors_stride * vertex_count_minus_1 +
+                   sizeof(float) * vertex_count_at_least_1;
+    }
+  } else {
+    // Blend factors are not supported if dual quaternions are not there.
+    valid &= blend_factors.empty();
+  }
+
   return valid;
 }
 
+// Implements weighted blending of 2 to 4 palette matrices, the hottest part
+// of the skinning loops. On AVX2 targets, where 256 bits registers fit two
+// matrix columns, a specialized version blends two columns per instruction,
+// halving the instruction count compared to the 128 bits ColumnMultiply sums
+// that other targets fall back to. Matrix columns are contiguous in memory,
+// so wide unaligned loads fetch them directly from the palette.
+namespace {
+#if defined(OZZ_SIMD_AVX2)
+
+#if defined(OZZ_SIMD_FMA)
+#define OZZ_MADD256(_a, _b, _c) _mm256_fmadd_ps(_a, _b, _c)
+#else  // OZZ_SIMD_FMA
+#define OZZ_MADD256(_a, _b, _c) _mm256_add_ps(_mm256_mul_ps(_a, _b), _c)
+#endif  // OZZ_SIMD_FMA
+
+// Loads matrix columns _i and _i + 1.
+OZZ_INLINE __m256 LoadColumns2(const math::Float4x4& _m, size_t _i) {
+  return _mm256_loadu_ps(reinterpret_cast<const float*>(&_m.cols[_i]));
+}
+
+// Duplicates _w to both 128 bits lanes.
+OZZ_INLINE __m256 Splat256(math::_SimdFloat4 _w) {
+  return _mm256_insertf128_ps(_mm256_castps128_ps256(_w), _w, 1);
+}
+
+OZZ_INLINE math::Float4x4 StoreMatrix(__m256 _lo, __m256 _hi) {
+  math::Float4x4 blended;
+  _mm256_storeu_ps(reinterpret_cast<float*>(&blended.cols[0]), _lo);
+  _mm256_storeu_ps(reinterpret_cast<float*>(&blended.cols[2]), _hi);
+  return blended;
+}
+
+OZZ_INLINE math::Float4x4 BlendMatrices(const math::Float4x4& _m0,
+                                        math::_SimdFloat4 _w0,
+                                        const math::Float4x4& _m1,
+                                        math::_SimdFloat4 _w1) {
+  const __m256 w0 = Splat256(_w0);
+  const __m256 w1 = Splat256(_w1);
+  const __m256 lo = OZZ_MADD256(LoadColumns2(_m1, 0), w1,
+                                _mm256_mul_ps(LoadColumns2(_m0, 0), w0));
+  const __m256 hi = OZZ_MADD256(LoadColumns2(_m1, 2), w1,
+                                _mm256_mul_ps(LoadColumns2(_m0, 2), w0));
+  return StoreMatrix(lo, hi);
+}
+
+OZZ_INLINE math::Float4x4 BlendMatrices(
+    const math::Float4x4& _m0, math::_SimdFloat4 _w0,
+    const math::Float4x4& _m1, math::_SimdFloat4 _w1,
+    const math::Float4x4& _m2, math::_SimdFloat4 _w2) {
+  const __m256 w0 = Splat256(_w0);
+  const __m256 w1 = Splat256(_w1);
+  const __m256 w2 = Splat256(_w2);
+  const __m256 lo = OZZ_MADD256(
+      LoadColumns2(_m2, 0), w2,
+      OZZ_MADD256(LoadColumns2(_m1, 0), w1,
+                  _mm256_mul_ps(LoadColumns2(_m0, 0), w0)));
+  const __m256 hi = OZZ_MADD256(
+      LoadColumns2(_m2, 2), w2,
+      OZZ_MADD256(LoadColumns2(_m1, 2), w1,
+                  _mm256_mul_ps(LoadColumns2(_m0, 2), w0)));
+  return StoreMatrix(lo, hi);
+}
+
+OZZ_INLINE math::Float4x4 BlendMatrices(
+    const math::Float4x4& _m0, math::_SimdFloat4 _w0,
+    const math::Float4x4& _m1, math::_SimdFloat4 _w1,
+    const math::Float4x4& _m2, math::_SimdFloat4 _w2,
+    const math::Float4x4& _m3, math::_SimdFloat4 _w3) {
+  const __m256 w0 = Splat256(_w0);
+  const __m256 w1 = Splat256(_w1);
+  const __m256 w2 = Splat256(_w2);
+  const __m256 w3 = Splat256(_w3);
+  const __m256 lo = OZZ_MADD256(
+      LoadColumns2(_m3, 0), w3,
+      OZZ_MADD256(LoadColumns2(_m2, 0), w2,
+                  OZZ_MADD256(LoadColumns2(_m1, 0), w1,
+                              _mm256_mul_ps(LoadColumns2(_m0, 0), w0))));
+  const __m256 hi = OZZ_MADD256(
+      LoadColumns2(_m3, 2), w3,
+      OZZ_MADD256(LoadColumns2(_m2, 2), w2,
+                  OZZ_MADD256(LoadColumns2(_m1, 2), w1,
+                              _mm256_mul_ps(LoadColumns2(_m0, 2), w0))));
+  return StoreMatrix(lo, hi);
+}
+
+#undef OZZ_MADD256
+
+#else  // OZZ_SIMD_AVX2
+
+OZZ_INLINE math::Float4x4 BlendMatrices(const math::Float4x4& _m0,
+                                        math::_SimdFloat4 _w0,
+                                        const math::Float4x4& _m1,
+                                        math::_SimdFloat4 _w1) {
+  return math::ColumnMultiply(_m0, _w0) + math::ColumnMultiply(_m1, _w1);
+}
+
+OZZ_INLINE math::Float4x4 BlendMatrices(
+    const math::Float4x4& _m0, math::_SimdFloat4 _w0,
+    const math::Float4x4& _m1, math::_SimdFloat4 _w1,
+    const math::Float4x4& _m2, math::_SimdFloat4 _w2) {
+  return math::ColumnMultiply(_m0, _w0) + math::ColumnMultiply(_m1, _w1) +
+         math::ColumnMultiply(_m2, _w2);
+}
+
+OZZ_INLINE math::Float4x4 BlendMatrices(
+    const math::Float4x4& _m0, math::_SimdFloat4 _w0,
+    const math::Float4x4& _m1, math::_SimdFloat4 _w1,
+    const math::Float4x4& _m2, math::_SimdFloat4 _w2,
+    const math::Float4x4& _m3, math::_SimdFloat4 _w3) {
+  return math::ColumnMultiply(_m0, _w0) + math::ColumnMultiply(_m1, _w1) +
+         math::ColumnMultiply(_m2, _w2) + math::ColumnMultiply(_m3, _w3);
+}
+
+#endif  // OZZ_SIMD_AVX2
+
+// Stores the x, y and z components of _v to _f, with non-temporal stores
+// when _streaming is true. Streaming stores bypass the cache hierarchy, so
+// write-only output buffers don't evict the palette and source vertices: the
+// write-combining buffers coalesce the sequential 4 bytes stores. _streaming
+// is loop invariant, a predicted branch costs nothing compared to doubling
+// every skinning specialization. Non SSE targets fall back to regular
+// stores.
+OZZ_INLINE void StoreVertex3(math::_SimdFloat4 _v, float* _f,
+                             bool _streaming) {
+#if defined(OZZ_SIMD_SSEx)
+  if (_streaming) {
+    const __m128i vi = _mm_castps_si128(_v);
+    _mm_stream_si32(reinterpret_cast<int*>(_f + 0), _mm_cvtsi128_si32(vi));
+    _mm_stream_si32(reinterpret_cast<int*>(_f + 1),
+                    _mm_cvtsi128_si32(_mm_shuffle_epi32(vi, 1)));
+    _mm_stream_si32(reinterpret_cast<int*>(_f + 2),
+                    _mm_cvtsi128_si32(_mm_shuffle_epi32(vi, 2)));
+    return;
+  }
+#else   // OZZ_SIMD_SSEx
+  (void)_streaming;
+#endif  // OZZ_SIMD_SSEx
+  math::Store3PtrU(_v, _f);
+}
+
+// Makes streaming stores globally visible, to be issued once after the
+// skinning loop. Regular stores don't need fencing.
+OZZ_INLINE void EndStreamingStores(bool _streaming) {
+#if defined(OZZ_SIMD_SSEx)
+  if (_streaming) {
+    _mm_sfence();
+  }
+#else   // OZZ_SIMD_SSEx
+  (void)_streaming;
+#endif  // OZZ_SIMD_SSEx
+}
+}  // namespace
+
 // For performance optimization reasons, every skinning variants (positions,
 // positions + normals, 1 to n influences...) are implemented as separate
 // specialized functions.
@@ -153,7 +325,8 @@ bool SkinningJob::Validate() const {
 #define INIT_P()                                              \
   const uint16_t* joint_indices = _job.joint_indices.begin(); \
   const float* in_positions = _job.in_positions.begin();      \
-  float* out_positions = _job.out_positions.begin();
+  float* out_positions = _job.out_positions.begin();          \
+  const bool streaming = _job.streaming_stores;
 
 #define INIT_PN()                                    \
   INIT_P();                                          \
@@ -241,8 +414,7 @@ bool SkinningJob::Validate() const {
   const math::Float4x4& m0 = _job.joint_matrices[i0];                          \
   const math::Float4x4& m1 = _job.joint_matrices[i1];                          \
   const math::SimdFloat4 w1 = one - w0;                                        \
-  const math::Float4x4 transform =                                             \
-      math::ColumnMultiply(m0, w0) + math::ColumnMultiply(m1, w1);             \
+  const math::Float4x4 transform = BlendMatrices(m0, w0, m1, w1);              \
   PREPARE_##_it##_2()
 
 #define PREPARE_NOIT_2() PREPARE_NOIT()
@@ -250,8 +422,7 @@ bool SkinningJob::Validate() const {
 #define PREPARE_IT_2()                                                    \
   const math::Float4x4& mit0 = _job.joint_inverse_transpose_matrices[i0]; \
   const math::Float4x4& mit1 = _job.joint_inverse_transpose_matrices[i1]; \
-  const math::Float4x4 it_transform =                                     \
-      math::ColumnMultiply(mit0, w0) + math::ColumnMultiply(mit1, w1);
+  const math::Float4x4 it_transform = BlendMatrices(mit0, w0, mit1, w1);
 
 #define PREPARE_2_OUTER(_it) PREPARE_2_INNER(_it)
 
@@ -263,9 +434,8 @@ bool SkinningJob::Validate() const {
   const math::Float4x4& m1 = _job.joint_matrices[i1];             \
   const math::Float4x4& m2 = _job.joint_matrices[i2];             \
   const math::SimdFloat4 w2 = one - (w0 + w1);                    \
-  const math::Float4x4 transform = math::ColumnMultiply(m0, w0) + \
-                                   math::ColumnMultiply(m1, w1) + \
-                                   math::ColumnMultiply(m2, w2);  \
+  const math::Float4x4 transform =                                \
+      BlendMatrices(m0, w0, m1, w1, m2, w2);                      \
   PREPARE_##_it##_3()
 
 #define PREPARE_NOIT_3() PREPARE_NOIT()
@@ -274,9 +444,8 @@ bool SkinningJob::Validate() const {
   const math::Float4x4& mit0 = _job.joint_inverse_transpose_matrices[i0]; \
   const math::Float4x4& mit1 = _job.joint_inverse_transpose_matrices[i1]; \
   const math::Float4x4& mit2 = _job.joint_inverse_transpose_matrices[i2]; \
-  const math::Float4x4 it_transform = math::ColumnMultiply(mit0, w0) +    \
-                                      math::ColumnMultiply(mit1, w1) +    \
-                                      math::ColumnMultiply(mit2, w2);
+  const math::Float4x4 it_transform =                                     \
+      BlendMatrices(mit0, w0, mit1, w1, mit2, w2);
 
 #define PREPARE_3_INNER(_it)                                             \
   const math::SimdFloat4 w = math::simd_float4::LoadPtrU(joint_weights); \
@@ -300,8 +469,7 @@ bool SkinningJob::Validate() const {
   const math::Float4x4& m3 = _job.joint_matrices[i3];               \
   const math::SimdFloat4 w3 = one - (w0 + w1 + w2);                 \
   const math::Float4x4 transform =                                  \
-      math::ColumnMultiply(m0, w0) + math::ColumnMultiply(m1, w1) + \
-      math::ColumnMultiply(m2, w2) + math::ColumnMultiply(m3, w3);  \
+      BlendMatrices(m0, w0, m1, w1, m2, w2, m3, w3);                \
   PREPARE_##_it##_4()
 
 #define PREPARE_NOIT_4() PREPARE_NOIT()
@@ -312,8 +480,7 @@ bool SkinningJob::Validate() const {
   const math::Float4x4& mit2 = _job.joint_inverse_transpose_matrices[i2]; \
   const math::Float4x4& mit3 = _job.joint_inverse_transpose_matrices[i3]; \
   const math::Float4x4 it_transform =                                     \
-      math::ColumnMultiply(mit0, w0) + math::ColumnMultiply(mit1, w1) +   \
-      math::ColumnMultiply(mit2, w2) + math::ColumnMultiply(mit3, w3);
+      BlendMatrices(mit0, w0, mit1, w1, mit2, w2, mit3, w3);
 
 #define PREPARE_4_INNER(_it)                                             \
   const math::SimdFloat4 w = math::simd_float4::LoadPtrU(joint_weights); \
@@ -380,36 +547,36 @@ bool SkinningJob::Validate() const {
 #define TRANSFORM_P_INNER()                                                \
   const math::SimdFloat4 in_p = math::simd_float4::LoadPtrU(in_positions); \
   const math::SimdFloat4 out_p = TransformPoint(transform, in_p);          \
-  math::Store3PtrU(out_p, out_positions);
+  StoreVertex3(out_p, out_positions, streaming);
 
 #define TRANSFORM_PN_INNER()                                             \
   TRANSFORM_P_INNER();                                                   \
   const math::SimdFloat4 in_n = math::simd_float4::LoadPtrU(in_normals); \
   const math::SimdFloat4 out_n = TransformVector(it_transform, in_n);    \
-  math::Store3PtrU(out_n, out_normals);
+  StoreVertex3(out_n, out_normals, streaming);
 
 #define TRANSFORM_PNT_INNER()                                             \
   TRANSFORM_PN_INNER();                                                   \
   const math::SimdFloat4 in_t = math::simd_float4::LoadPtrU(in_tangents); \
   const math::SimdFloat4 out_t = TransformVector(it_transform, in_t);     \
-  math::Store3PtrU(out_t, out_tangents);
+  StoreVertex3(out_t, out_tangents, streaming);
 
 #define TRANSFORM_P_OUTER()                                                 \
   const math::SimdFloat4 in_p = math::simd_float4::Load3PtrU(in_positions); \
   const math::SimdFloat4 out_p = TransformPoint(transform, in_p);           \
-  math::Store3PtrU(out_p, out_positions);
+  StoreVertex3(out_p, out_positions, streaming);
 
 #define TRANSFORM_PN_OUTER()                                              \
   TRANSFORM_P_OUTER();                                                    \
   const math::SimdFloat4 in_n = math::simd_float4::Load3PtrU(in_normals); \
   const math::SimdFloat4 out_n = TransformVector(it_transform, in_n);     \
-  math::Store3PtrU(out_n, out_normals);
+  StoreVertex3(out_n, out_normals, streaming);
 
 #define TRANSFORM_PNT_OUTER()                                              \
   TRANSFORM_PN_OUTER();                                                    \
   const math::SimdFloat4 in_t = math::simd_float4::Load3PtrU(in_tangents); \
   const math::SimdFloat4 out_t = TransformVector(it_transform, in_t);      \
-  math::Store3PtrU(out_t, out_tangents);
+  StoreVertex3(out_t, out_tangents, streaming);
 
 // Instantiates all skinning function variants.
 SKINNING_FN(P, NOIT, 1)
@@ -438,6 +605,159 @@ SKINNING_FN(PNT, NOIT, N)
 SKINNING_FN(PN, IT, N)
 SKINNING_FN(PNT, IT, N)
 
+// Implements dual quaternion skinning. Transformations are accumulated as
+// weighted dual quaternions instead of weighted matrices, which interpolates
+// rigid transformations and avoids linear blending artifacts (candy wrapper,
+// volume loss). The function is templated on normals (_N), tangents (_T) and
+// blending (_B) support, rather than expanded per influences count like the
+// matrix palette variants: dual quaternion accumulation boils down to two
+// multiply-adds per influence that an inner loop handles efficiently. When
+// blending is enabled, the linear blend result is also computed and mixed with
+// the dual quaternion one, per vertex, according to blend_factors.
+template <bool _N, bool _T, bool _B>
+void SkinningDualQuaternion(const SkinningJob& _job) {
+  assert(_job.vertex_count && !_job.in_positions.empty() &&
+         !_job.joint_dual_quaternions.empty());
+  assert(_N == !_job.in_normals.empty() && _T == !_job.in_tangents.empty());
+  assert(_B == !_job.blend_factors.empty());
+
+  const math::SimdFloat4 zero = math::simd_float4::zero();
+  const math::SimdFloat4 one = math::simd_float4::one();
+  const math::SimdFloat4 two = one + one;
+
+  // Inverse transpose matrices are only needed by the linear blend side of the
+  // blended path, as dual quaternion rotations transform vectors correctly.
+  const bool it = _B && !_job.joint_inverse_transpose_matrices.empty();
+  const span<const math::Float4x4>& it_matrices =
+      it ? _job.joint_inverse_transpose_matrices : _job.joint_matrices;
+
+  const bool streaming = _job.streaming_stores;
+  const uint16_t* joint_indices = _job.joint_indices.begin();
+  const float* joint_weights = _job.joint_weights.begin();
+  const float* blend_factors = _job.blend_factors.begin();
+  const float* in_positions = _job.in_positions.begin();
+  const float* in_normals = _job.in_normals.begin();
+  const float* in_tangents = _job.in_tangents.begin();
+  float* out_positions = _job.out_positions.begin();
+  float* out_normals = _job.out_normals.begin();
+  float* out_tangents = _job.out_tangents.begin();
+
+  const int last = _job.influences_count - 1;
+  for (int i = 0; i < _job.vertex_count; ++i) {
+    // Accumulates weighted dual quaternions, and weighted matrices when the
+    // linear blend result is needed.
+    const uint16_t i0 = joint_indices[0];
+    const SkinningJob::DualQuaternion& dq0 = _job.joint_dual_quaternions[i0];
+    const math::SimdFloat4 w0 =
+        last == 0 ? one : math::simd_float4::Load1PtrU(joint_weights);
+    math::SimdFloat4 wsum = w0;
+    math::SimdFloat4 real = dq0.real.xyzw * w0;
+    math::SimdFloat4 dual = dq0.dual.xyzw * w0;
+    math::Float4x4 transform;
+    math::Float4x4 it_transform;
+    (void)transform;
+    (void)it_transform;
+    if (_B) {
+      transform = math::ColumnMultiply(_job.joint_matrices[i0], w0);
+      if (_N) {
+        it_transform = math::ColumnMultiply(it_matrices[i0], w0);
+      }
+    }
+    for (int j = 1; j <= last; ++j) {
+      const uint16_t ij = joint_indices[j];
+      math::SimdFloat4 w;
+      if (j == last) {
+        // Weights are normalized, so the last one can be restored.
+        w = one - wsum;
+      } else {
+        w = math::simd_float4::Load1PtrU(joint_weights + j);
+        wsum = wsum + w;
+      }
+      if (_B) {
+        transform =
+            transform + math::ColumnMultiply(_job.joint_matrices[ij], w);
+        if (_N) {
+          it_transform =
+              it_transform + math::ColumnMultiply(it_matrices[ij], w);
+        }
+      }
+      // Negates the weight when the quaternion lies on the opposite
+      // hemisphere of the first influence, so blending doesn't go the long
+      // way around.
+      const SkinningJob::DualQuaternion& dq = _job.joint_dual_quaternions[ij];
+      w = math::Select(
+          math::CmpLt(math::Dot4(dq.real.xyzw, dq0.real.xyzw), zero), -w, w);
+      real = math::MAdd(dq.real.xyzw, w, real);
+      dual = math::MAdd(dq.dual.xyzw, w, dual);
+    }
+
+    // Normalizes the blended dual quaternion. Both parts are divided by the
+    // norm of the real part.
+    const math::SimdFloat4 inv_len =
+        math::SplatX(math::RSqrtEstNR(math::Dot4(real, real)));
+    const math::SimdQuaternion rotation = {real * inv_len};
+    const math::SimdFloat4 ndual = dual * inv_len;
+
+    // Extracts the translation part of the normalized dual quaternion:
+    // t = 2 * (real.w * dual.xyz - dual.w * real.xyz + real.xyz x dual.xyz).
+    const math::SimdFloat4 translation =
+        (math::SplatW(rotation.xyzw) * ndual -
+         math::SplatW(ndual) * rotation.xyzw +
+         math::Cross3(rotation.xyzw, ndual)) *
+        two;
+
+    const math::SimdFloat4 bf =
+        _B ? math::simd_float4::Load1PtrU(blend_factors) : zero;
+
+    const math::SimdFloat4 in_p = math::simd_float4::Load3PtrU(in_positions);
+    math::SimdFloat4 out_p = TransformVector(rotation, in_p) + translation;
+    if (_B) {
+      out_p = math::Lerp(TransformPoint(transform, in_p), out_p, bf);
+    }
+    StoreVertex3(out_p, out_positions, streaming);
+
+    if (_N) {
+      const math::SimdFloat4 in_n = math::simd_float4::Load3PtrU(in_normals);
+      math::SimdFloat4 out_n = TransformVector(rotation, in_n);
+      if (_B) {
+        out_n = math::Lerp(TransformVector(it_transform, in_n), out_n, bf);
+      }
+      StoreVertex3(out_n, out_normals, streaming);
+    }
+
+    if (_T) {
+      const math::SimdFloat4 in_t = math::simd_float4::Load3PtrU(in_tangents);
+      math::SimdFloat4 out_t = TransformVector(rotation, in_t);
+      if (_B) {
+        out_t = math::Lerp(TransformVector(it_transform, in_t), out_t, bf);
+      }
+      StoreVertex3(out_t, out_tangents, streaming);
+    }
+
+    // Strides buffers to the next vertex.
+    joint_indices =
+        NEXT(const uint16_t*, joint_indices, _job.joint_indices_stride);
+    if (last != 0) {
+      joint_weights =
+          NEXT(const float*, joint_weights, _job.joint_weights_stride);
+    }
+    if (_B) {
+      blend_factors =
+          NEXT(const float*, blend_factors, _job.blend_factors_stride);
+    }
+    in_positions = NEXT(const float*, in_positions, _job.in_positions_stride);
+    out_positions = NEXT(float*, out_positions, _job.out_positions_stride);
+    if (_N) {
+      in_normals = NEXT(const float*, in_normals, _job.in_normals_stride);
+      out_normals = NEXT(float*, out_normals, _job.out_normals_stride);
+    }
+    if (_T) {
+      in_tangents = NEXT(const float*, in_tangents, _job.in_tangents_stride);
+      out_tangents = NEXT(float*, out_tangents, _job.out_tangents_stride);
+    }
+  }
+}
+
 // Defines a matrix of skinning function pointers. This matrix will then be
 // indexed according to skinning jobs parameters.
 typedef void (*SkiningFct)(const SkinningJob&);
@@ -467,20 +787,50 @@ static const SkiningFct kSkinningFct[2][5][3] = {
          &SKINNING_FN_NAME(PNT, IT, N)},
     }};
 
+// Defines the matrix of dual quaternion skinning function pointers, indexed
+// with blending and transformed components. Tangents require normals, so
+// remaining template combinations are unreachable once the job is validated.
+static const SkiningFct kDualQuaternionFct[2][3] = {
+    {&SkinningDualQuaternion<false, false, false>,
+     &SkinningDualQuaternion<true, false, false>,
+     &SkinningDualQuaternion<true, true, false>},
+    {&SkinningDualQuaternion<false, false, true>,
+     &SkinningDualQuaternion<true, false, true>,
+     &SkinningDualQuaternion<true, true, true>}};
+
 // Implements job Run function.
 bool SkinningJob::Run() const {
   // Exit with an error if job is invalid.
   if (!Validate()) {
     return false;
   }
+  RunValidated();
+  return true;
+}
+
+void SkinningJob::RunValidated() const {
+  assert(Validate() && "Job is expected to be valid.");
+  OZZ_PROFILE_JOB("SkinningJob", vertex_count);
 
   // Early out if no vertex. This isn't an error.
   // Skinning function algorithm doesn't support the case.
   if (vertex_count == 0) {
-    return true;
+    return;
   }
 
   // Find skinning function index.
+  const size_t fct = !in_normals.empty() + !in_tangents.empty();
+  assert(fct < OZZ_ARRAY_SIZE(kSkinningFct[0][0]));
+
+  // Providing dual quaternions selects the dual quaternion skinning variants.
+  if (!joint_dual_quaternions.empty()) {
+    const size_t blend = !blend_factors.empty();
+    assert(blend < OZZ_ARRAY_SIZE(kDualQuaternionFct));
+    kDualQuaternionFct[blend][fct](*this);
+    EndStreamingStores(streaming_stores);
+    return;
+  }
+
   const size_t it = !joint_inverse_transpose_matrices.empty();
   assert(it < OZZ_ARRAY_SIZE(kSkinningFct));
   const size_t inf =
@@ -488,12 +838,100 @@ bool SkinningJob::Run() const {
           ? OZZ_ARRAY_SIZE(kSkinningFct[0]) - 1
           : influences_count - 1;
   assert(inf < OZZ_ARRAY_SIZE(kSkinningFct[0]));
-  const size_t fct = !in_normals.empty() + !in_tangents.empty();
-  assert(fct < OZZ_ARRAY_SIZE(kSkinningFct[0][0]));
 
   // Calls skinning function. Cannot fail because job is valid.
   kSkinningFct[it][inf][fct](*this);
 
+  // Makes streaming stores globally visible before returning to the caller.
+  EndStreamingStores(streaming_stores);
+}
+
+bool ToDualQuaternions(
+    const span<const math::Float4x4>& _matrices,
+    const span<SkinningJob::DualQuaternion>& _dual_quaternions) {
+  if (_dual_quaternions.size() != _matrices.size()) {
+    return false;
+  }
+  const math::SimdFloat4 zero = math::simd_float4::zero();
+  const math::SimdFloat4 half = math::simd_float4::Load1(.5f);
+  for (size_t i = 0; i < _matrices.size(); ++i) {
+    // Decomposes the matrix, discarding its scale part as dual quaternions
+    // can only represent rigid transformations.
+    math::SimdFloat4 translation, quaternion, scale;
+    if (!ToAffine(_matrices[i], &translation, &quaternion, &scale)) {
+      return false;
+    }
+    const math::SimdQuaternion real = {quaternion};
+    const math::SimdQuaternion tq = {math::SetW(translation, zero)};
+    const math::SimdQuaternion dual = {(tq * real).xyzw * half};
+    _dual_quaternions[i].real = real;
+    _dual_quaternions[i].dual = dual;
+  }
+  return true;
+}
+
+namespace {
+
+// Pops the first _offset_bytes bytes from _span, so it starts at the first
+// element of a vertex range. No-op on empty (optional) buffers.
+template <typename _Ty>
+void OffsetSpan(size_t _offset_bytes, span<_Ty>* _span) {
+  if (_span->empty() || _offset_bytes == 0) {
+    return;
+  }
+  const size_t offset = _offset_bytes / sizeof(_Ty);
+  assert(offset <= _span->size());
+  *_span = _span->subspan(offset, _span->size() - offset);
+}
+}  // namespace
+
+bool SkinningJob::Split(span<SkinningJob> _jobs) const {
+  // Exit with an error if job cannot be split.
+  if (_jobs.empty() || !Validate()) {
+    return false;
+  }
+
+  // Offsetting typed spans requires strides to be multiples of their buffer
+  // element size.
+  const bool splittable =
+      joint_indices_stride % sizeof(uint16_t) == 0 &&
+      joint_weights_stride % sizeof(float) == 0 &&
+      blend_factors_stride % sizeof(float) == 0 &&
+      in_positions_stride % sizeof(float) == 0 &&
+      in_normals_stride % sizeof(float) == 0 &&
+      in_tangents_stride % sizeof(float) == 0 &&
+      out_positions_stride % sizeof(float) == 0 &&
+      out_normals_stride % sizeof(float) == 0 &&
+      out_tangents_stride % sizeof(float) == 0;
+  if (!splittable) {
+    return false;
+  }
+
+  const size_t count = _jobs.size();
+  size_t begin = 0;
+  for (size_t i = 0; i < count; ++i) {
+    // Evenly distributes vertices across sub jobs.
+    const size_t end = static_cast<size_t>(vertex_count) * (i + 1) / count;
+
+    SkinningJob& job = _jobs[i];
+    job = *this;
+    job.vertex_count = static_cast<int>(end - begin);
+
+    // Pops the vertices processed by the previous sub jobs. Trailing buffer
+    // elements are deliberately kept, Validate only cares for minimum sizes.
+    OffsetSpan(begin * joint_indices_stride, &job.joint_indices);
+    OffsetSpan(begin * joint_weights_stride, &job.joint_weights);
+    OffsetSpan(begin * blend_factors_stride, &job.blend_factors);
+    OffsetSpan(begin * in_positions_stride, &job.in_positions);
+    OffsetSpan(begin * in_normals_stride, &job.in_normals);
+    OffsetSpan(begin * in_tangents_stride, &job.in_tangents);
+    OffsetSpan(begin * out_positions_stride, &job.out_positions);
+    OffsetSpan(begin * out_normals_stride, &job.out_normals);
+    OffsetSpan(begin * out_tangents_stride, &job.out_tangents);
+    assert(job.Validate());
+
+    begin = end;
+  }
   return true;
 }
 }  // namespace geometry
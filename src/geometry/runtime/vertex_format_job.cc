@@ -0,0 +1,402 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/geometry/runtime/vertex_format_job.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "ozz/base/maths/math_ex.h"
+#include "ozz/base/maths/simd_math.h"
+
+namespace ozz {
+namespace geometry {
+
+namespace {
+
+// Number of vertices processed per block by the fused job. Sizes the stack
+// buffers holding intermediate float attributes to a few KB, small enough to
+// stay in L1 across the unpack, skin and repack stages.
+enum { kConvertSkinningBlockSize = 64 };
+
+// Decodes one packed vertex attribute to 3 floats.
+OZZ_INLINE void UnpackVertex(VertexFormat::Value _format, const byte* _src,
+                             float* _dst) {
+  switch (_format) {
+    case VertexFormat::kFloat3: {
+      std::memcpy(_dst, _src, sizeof(float) * 3);
+    } break;
+    case VertexFormat::kHalf4: {
+      uint16_t half[3];
+      std::memcpy(half, _src, sizeof(half));
+      _dst[0] = math::HalfToFloat(half[0]);
+      _dst[1] = math::HalfToFloat(half[1]);
+      _dst[2] = math::HalfToFloat(half[2]);
+    } break;
+    case VertexFormat::kSnorm16x4: {
+      int16_t snorm[3];
+      std::memcpy(snorm, _src, sizeof(snorm));
+      // -32768 and -32767 both decode to -1, per gpu snorm convention.
+      _dst[0] = math::Max(snorm[0] * (1.f / 32767.f), -1.f);
+      _dst[1] = math::Max(snorm[1] * (1.f / 32767.f), -1.f);
+      _dst[2] = math::Max(snorm[2] * (1.f / 32767.f), -1.f);
+    } break;
+    default: {  // kSnorm10_10_10_2
+      uint32_t packed;
+      std::memcpy(&packed, _src, sizeof(packed));
+      for (int i = 0; i < 3; ++i) {
+        // Sign extends the 10 bits field from the msb of a 32 bits shift.
+        const int32_t snorm =
+            static_cast<int32_t>(packed << (22 - 10 * i)) >> 22;
+        _dst[i] = math::Max(snorm * (1.f / 511.f), -1.f);
+      }
+    } break;
+  }
+}
+
+// Rounds and clamps _value to a signed normalized integer of _max amplitude.
+OZZ_INLINE int32_t ToSnorm(float _value, float _max) {
+  const float clamped = math::Clamp(-1.f, _value, 1.f);
+  return static_cast<int32_t>(std::floor(clamped * _max + .5f));
+}
+
+// Encodes 3 floats to one packed vertex attribute. The 4th component of 4
+// components formats is written as 0.
+OZZ_INLINE void PackVertex(VertexFormat::Value _format, const float* _src,
+                           byte* _dst) {
+  switch (_format) {
+    case VertexFormat::kFloat3: {
+      std::memcpy(_dst, _src, sizeof(float) * 3);
+    } break;
+    case VertexFormat::kHalf4: {
+      const uint16_t half[4] = {math::FloatToHalf(_src[0]),
+                                math::FloatToHalf(_src[1]),
+                                math::FloatToHalf(_src[2]), 0};
+      std::memcpy(_dst, half, sizeof(half));
+    } break;
+    case VertexFormat::kSnorm16x4: {
+      const int16_t snorm[4] = {
+          static_cast<int16_t>(ToSnorm(_src[0], 32767.f)),
+          static_cast<int16_t>(ToSnorm(_src[1], 32767.f)),
+          static_cast<int16_t>(ToSnorm(_src[2], 32767.f)), 0};
+      std::memcpy(_dst, snorm, sizeof(snorm));
+    } break;
+    default: {  // kSnorm10_10_10_2
+      const uint32_t packed = (ToSnorm(_src[0], 511.f) & 0x3ff) |
+                              ((ToSnorm(_src[1], 511.f) & 0x3ff) << 10) |
+                              ((ToSnorm(_src[2], 511.f) & 0x3ff) << 20);
+      std::memcpy(_dst, &packed, sizeof(packed));
+    } break;
+  }
+}
+
+// Validates a packed stream against a vertex count, following SkinningJob
+// buffer size conventions.
+bool ValidatePackedStream(size_t _size_bytes, size_t _stride,
+                          VertexFormat::Value _format, int _vertex_count) {
+  const size_t format_size = VertexFormatSize(_format);
+  const int vertex_count_minus_1 = _vertex_count > 0 ? _vertex_count - 1 : 0;
+  const int vertex_count_at_least_1 = _vertex_count > 0;
+  return _stride >= format_size &&
+         _size_bytes >= _stride * vertex_count_minus_1 +
+                            format_size * vertex_count_at_least_1;
+}
+}  // namespace
+
+size_t VertexFormatSize(VertexFormat::Value _format) {
+  switch (_format) {
+    case VertexFormat::kFloat3:
+      return sizeof(float) * 3;
+    case VertexFormat::kHalf4:
+    case VertexFormat::kSnorm16x4:
+      return sizeof(uint16_t) * 4;
+    default:  // kSnorm10_10_10_2
+      return sizeof(uint32_t);
+  }
+}
+
+UnpackVerticesJob::UnpackVerticesJob()
+    : vertex_count(0),
+      format(VertexFormat::kFloat3),
+      input_stride(0),
+      output_stride(0) {}
+
+bool UnpackVerticesJob::Validate() const {
+  bool valid = true;
+  valid &= vertex_count >= 0;
+  valid &= ValidatePackedStream(input.size_bytes(), input_stride, format,
+                                vertex_count);
+  valid &= ValidatePackedStream(output.size_bytes(), output_stride,
+                                VertexFormat::kFloat3, vertex_count);
+  return valid;
+}
+
+bool UnpackVerticesJob::Run() const {
+  if (!Validate()) {
+    return false;
+  }
+  const byte* src = input.data();
+  float* dst = output.data();
+  for (int i = 0; i < vertex_count; ++i) {
+    UnpackVertex(format, src, dst);
+    src = PointerStride(src, input_stride);
+    dst = PointerStride(dst, output_stride);
+  }
+  return true;
+}
+
+PackVerticesJob::PackVerticesJob()
+    : vertex_count(0),
+      format(VertexFormat::kFloat3),
+      input_stride(0),
+      output_stride(0) {}
+
+bool PackVerticesJob::Validate() const {
+  bool valid = true;
+  valid &= vertex_count >= 0;
+  valid &= ValidatePackedStream(input.size_bytes(), input_stride,
+                                VertexFormat::kFloat3, vertex_count);
+  valid &= ValidatePackedStream(output.size_bytes(), output_stride, format,
+                                vertex_count);
+  return valid;
+}
+
+bool PackVerticesJob::Run() const {
+  if (!Validate()) {
+    return false;
+  }
+  const float* src = input.data();
+  byte* dst = output.data();
+  for (int i = 0; i < vertex_count; ++i) {
+    PackVertex(format, src, dst);
+    src = PointerStride(src, input_stride);
+    dst = PointerStride(dst, output_stride);
+  }
+  return true;
+}
+
+ConvertSkinningJob::ConvertSkinningJob()
+    : in_positions_format(VertexFormat::kFloat3),
+      in_positions_stride(0),
+      in_normals_format(VertexFormat::kFloat3),
+      in_normals_stride(0),
+      in_tangents_format(VertexFormat::kFloat3),
+      in_tangents_stride(0),
+      out_positions_format(VertexFormat::kFloat3),
+      out_positions_stride(0),
+      out_normals_format(VertexFormat::kFloat3),
+      out_normals_stride(0),
+      out_tangents_format(VertexFormat::kFloat3),
+      out_tangents_stride(0) {}
+
+bool ConvertSkinningJob::Validate() const {
+  bool valid = true;
+
+  // Vertex attribute streams of the skinning setup are managed per block.
+  valid &= skinning.in_positions.empty() && skinning.out_positions.empty();
+  valid &= skinning.in_normals.empty() && skinning.out_normals.empty();
+  valid &= skinning.in_tangents.empty() && skinning.out_tangents.empty();
+
+  const int vertex_count = skinning.vertex_count;
+  valid &= vertex_count >= 0;
+
+  // Positions are mandatory.
+  valid &= ValidatePackedStream(in_positions.size_bytes(), in_positions_stride,
+                                in_positions_format, vertex_count);
+  valid &= !out_positions.empty();
+  valid &= ValidatePackedStream(out_positions.size_bytes(),
+                                out_positions_stride, out_positions_format,
+                                vertex_count);
+
+  // Normals are optional, tangents require normals, and every provided input
+  // needs its output. Same rules as SkinningJob.
+  if (!in_normals.empty()) {
+    valid &= ValidatePackedStream(in_normals.size_bytes(), in_normals_stride,
+                                  in_normals_format, vertex_count);
+    valid &= !out_normals.empty();
+    valid &= ValidatePackedStream(out_normals.size_bytes(), out_normals_stride,
+                                  out_normals_format, vertex_count);
+    if (!in_tangents.empty()) {
+      valid &= ValidatePackedStream(in_tangents.size_bytes(),
+                                    in_tangents_stride, in_tangents_format,
+                                    vertex_count);
+      valid &= !out_tangents.empty();
+      valid &= ValidatePackedStream(out_tangents.size_bytes(),
+                                    out_tangents_stride, out_tangents_format,
+                                    vertex_count);
+    }
+  } else {
+    valid &= in_tangents.empty();
+  }
+
+  // Influence streams are offset per block, their strides must be multiples
+  // of their element size, like SkinningJob::Split requires.
+  valid &= skinning.joint_indices_stride % sizeof(uint16_t) == 0;
+  valid &= skinning.joint_weights_stride % sizeof(float) == 0;
+  valid &= skinning.blend_factors_stride % sizeof(float) == 0;
+
+  if (!valid) {
+    return false;
+  }
+
+  // Validates the skinning setup on a first (dry) block, so errors are
+  // reported upfront rather than from the block loop.
+  float dry[kConvertSkinningBlockSize * 3];
+  SkinningJob block = skinning;
+  block.vertex_count = math::Min(vertex_count, +kConvertSkinningBlockSize);
+  block.in_positions = {dry, OZZ_ARRAY_SIZE(dry)};
+  block.in_positions_stride = sizeof(float) * 3;
+  block.out_positions = {dry, OZZ_ARRAY_SIZE(dry)};
+  block.out_positions_stride = sizeof(float) * 3;
+  if (!in_normals.empty()) {
+    block.in_normals = {dry, OZZ_ARRAY_SIZE(dry)};
+    block.in_normals_stride = sizeof(float) * 3;
+    block.out_normals = {dry, OZZ_ARRAY_SIZE(dry)};
+    block.out_normals_stride = sizeof(float) * 3;
+    if (!in_tangents.empty()) {
+      block.in_tangents = {dry, OZZ_ARRAY_SIZE(dry)};
+      block.in_tangents_stride = sizeof(float) * 3;
+      block.out_tangents = {dry, OZZ_ARRAY_SIZE(dry)};
+      block.out_tangents_stride = sizeof(float) * 3;
+    }
+  }
+  return block.Validate();
+}
+
+bool ConvertSkinningJob::Run() const {
+  if (!Validate()) {
+    return false;
+  }
+
+  // Per block intermediate attribute buffers, tightly packed 3 floats per
+  // vertex.
+  float in_pos[kConvertSkinningBlockSize * 3];
+  float in_nrm[kConvertSkinningBlockSize * 3];
+  float in_tan[kConvertSkinningBlockSize * 3];
+  float out_pos[kConvertSkinningBlockSize * 3];
+  float out_nrm[kConvertSkinningBlockSize * 3];
+  float out_tan[kConvertSkinningBlockSize * 3];
+
+  const bool has_normals = !in_normals.empty();
+  const bool has_tangents = !in_tangents.empty();
+
+  for (int begin = 0; begin < skinning.vertex_count;
+       begin += kConvertSkinningBlockSize) {
+    const int count = math::Min(skinning.vertex_count - begin,
+                                +kConvertSkinningBlockSize);
+
+    // Unpacks the block's attributes to the float layout skinning consumes.
+    const byte* src_pos =
+        PointerStride(in_positions.data(), in_positions_stride * begin);
+    for (int i = 0; i < count; ++i) {
+      UnpackVertex(in_positions_format, src_pos, in_pos + i * 3);
+      src_pos = PointerStride(src_pos, in_positions_stride);
+    }
+    if (has_normals) {
+      const byte* src_nrm =
+          PointerStride(in_normals.data(), in_normals_stride * begin);
+      for (int i = 0; i < count; ++i) {
+        UnpackVertex(in_normals_format, src_nrm, in_nrm + i * 3);
+        src_nrm = PointerStride(src_nrm, in_normals_stride);
+      }
+    }
+    if (has_tangents) {
+      const byte* src_tan =
+          PointerStride(in_tangents.data(), in_tangents_stride * begin);
+      for (int i = 0; i < count; ++i) {
+        UnpackVertex(in_tangents_format, src_tan, in_tan + i * 3);
+        src_tan = PointerStride(src_tan, in_tangents_stride);
+      }
+    }
+
+    // Skins the block, offsetting influence streams to the block range.
+    SkinningJob block = skinning;
+    block.vertex_count = count;
+    const size_t indices_offset =
+        skinning.joint_indices_stride * begin / sizeof(uint16_t);
+    block.joint_indices = skinning.joint_indices.subspan(
+        indices_offset, skinning.joint_indices.size() - indices_offset);
+    if (skinning.influences_count > 1) {
+      const size_t weights_offset =
+          skinning.joint_weights_stride * begin / sizeof(float);
+      block.joint_weights = skinning.joint_weights.subspan(
+          weights_offset, skinning.joint_weights.size() - weights_offset);
+    }
+    if (!skinning.blend_factors.empty()) {
+      const size_t factors_offset =
+          skinning.blend_factors_stride * begin / sizeof(float);
+      block.blend_factors = skinning.blend_factors.subspan(
+          factors_offset, skinning.blend_factors.size() - factors_offset);
+    }
+    block.in_positions = {in_pos, static_cast<size_t>(count) * 3};
+    block.in_positions_stride = sizeof(float) * 3;
+    block.out_positions = {out_pos, static_cast<size_t>(count) * 3};
+    block.out_positions_stride = sizeof(float) * 3;
+    if (has_normals) {
+      block.in_normals = {in_nrm, static_cast<size_t>(count) * 3};
+      block.in_normals_stride = sizeof(float) * 3;
+      block.out_normals = {out_nrm, static_cast<size_t>(count) * 3};
+      block.out_normals_stride = sizeof(float) * 3;
+    }
+    if (has_tangents) {
+      block.in_tangents = {in_tan, static_cast<size_t>(count) * 3};
+      block.in_tangents_stride = sizeof(float) * 3;
+      block.out_tangents = {out_tan, static_cast<size_t>(count) * 3};
+      block.out_tangents_stride = sizeof(float) * 3;
+    }
+    if (!block.Run()) {
+      return false;
+    }
+
+    // Repacks skinned attributes to the output formats.
+    byte* dst_pos =
+        PointerStride(out_positions.data(), out_positions_stride * begin);
+    for (int i = 0; i < count; ++i) {
+      PackVertex(out_positions_format, out_pos + i * 3, dst_pos);
+      dst_pos = PointerStride(dst_pos, out_positions_stride);
+    }
+    if (has_normals) {
+      byte* dst_nrm =
+          PointerStride(out_normals.data(), out_normals_stride * begin);
+      for (int i = 0; i < count; ++i) {
+        PackVertex(out_normals_format, out_nrm + i * 3, dst_nrm);
+        dst_nrm = PointerStride(dst_nrm, out_normals_stride);
+      }
+    }
+    if (has_tangents) {
+      byte* dst_tan =
+          PointerStride(out_tangents.data(), out_tangents_stride * begin);
+      for (int i = 0; i < count; ++i) {
+        PackVertex(out_tangents_format, out_tan + i * 3, dst_tan);
+        dst_tan = PointerStride(dst_tan, out_tangents_stride);
+      }
+    }
+  }
+  return true;
+}
+}  // namespace geometry
+}  // namespace ozz
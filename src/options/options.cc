@@ -386,7 +386,8 @@ template class TypedOption<float>;
 template class TypedOption<const char*>;
 
 Parser::Parser()
-    : options_count_(0),
+    : lookup_dirty_(true),
+      options_count_(0),
       builtin_options_count_(0),
       executable_path_begin_(""),
       executable_path_end_(executable_path_begin_ + 1),
@@ -446,7 +447,14 @@ ParseResult Parser::Parse(int _argc, const char* const* _argv) {
     options_[i]->RestoreDefault();
   }
 
-  // Iterates all arguments and all options.
+  // Rebuilds the hashed option lookup if registration changed it since the
+  // last parse, so matching a token is a single lookup rather than a scan of
+  // all registered options.
+  if (lookup_dirty_) {
+    BuildLookup();
+  }
+
+  // Iterates all arguments.
   ParseResult result = kSuccess;
   for (int i = 0; i < argc_trunc; ++i) {
     const char* argv = _argv[i];
@@ -456,14 +464,12 @@ ParseResult Parser::Parse(int _argc, const char* const* _argv) {
       continue;
     }
 
-    int j = 0;
-    for (; j < options_count_; ++j) {
-      if (options_[j]->Parse(argv)) {
-        break;  // Also breaks if argument is duplicated.
-      }
-    }
+    // Option::Parse re-validates the full token (name, separator, value), the
+    // lookup only selects the candidate. It also fails on duplicated
+    // arguments.
+    Option* option = FindOption(argv);
     // An invalid (or duplicated) command line argument is a fatal failure.
-    if (j == options_count_) {
+    if (!option || !option->Parse(argv)) {
       std::cout << "Invalid command line argument:\"" << argv << "\"."
                 << std::endl;
       result = kExitFailure;
@@ -615,6 +621,7 @@ bool Parser::RegisterOption(Option* _option) {
   // Adds the option and maintains lexical order.
   options_[options_count_++] = _option;
   std::inplace_merge(options_, options_end() - 1, options_end(), &sort_options);
+  lookup_dirty_ = true;
 
   return true;
 }
@@ -627,11 +634,61 @@ bool Parser::UnregisterOption(Option* _option) {
   // Finds and removes _option from the collection.
   Option** it = std::remove(options_, options_end(), _option);
   if (it != options_end()) {
+    lookup_dirty_ = true;
     return --options_count_ == builtin_options_count_;
   }
   return false;
 }
 
+namespace {
+// Lower cases an option name, as option matching is case insensitive.
+ozz::string LowerName(const char* _begin, const char* _end) {
+  ozz::string name(_begin, _end);
+  for (size_t i = 0; i < name.size(); ++i) {
+    name[i] =
+        static_cast<char>(std::tolower(static_cast<unsigned char>(name[i])));
+  }
+  return name;
+}
+}  // namespace
+
+void Parser::BuildLookup() {
+  lookup_.clear();
+  for (int i = 0; i < options_count_; ++i) {
+    Option* option = options_[i];
+    const char* name = option->name();
+    lookup_[LowerName(name, name + std::strlen(name))] = option;
+  }
+  lookup_dirty_ = false;
+}
+
+Option* Parser::FindOption(const char* _argv) const {
+  // All options start with --.
+  if (_argv[0] != '-' || _argv[1] != '-') {
+    return nullptr;
+  }
+  // The option name spans until the value separator, or the token end for
+  // implicit booleans.
+  const char* begin = _argv + 2;
+  const char* end = begin;
+  for (; *end != '\0' && *end != '='; ++end) {
+  }
+  const ozz::string name = LowerName(begin, end);
+  ozz::unordered_map<ozz::string, Option*, internal::StringHash>::const_iterator
+      it = lookup_.find(name);
+  if (it != lookup_.end()) {
+    return it->second;
+  }
+  // Tests for the --no* explicit boolean form.
+  if (name.size() > 2 && name[0] == 'n' && name[1] == 'o') {
+    it = lookup_.find(ozz::string(name, 2));
+    if (it != lookup_.end()) {
+      return it->second;
+    }
+  }
+  return nullptr;
+}
+
 int Parser::max_options() const {
   return sizeof(options_) / sizeof(options_[0]) - builtin_options_count_;
 }
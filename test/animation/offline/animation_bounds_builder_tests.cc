@@ -0,0 +1,194 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/offline/animation_bounds_builder.h"
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/offline/raw_skeleton.h"
+#include "ozz/animation/offline/skeleton_builder.h"
+#include "ozz/animation/runtime/animation_bounds.h"
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/io/archive.h"
+#include "ozz/base/io/stream.h"
+#include "ozz/base/maths/gtest_math_helper.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+using ozz::animation::AnimationBounds;
+using ozz::animation::Skeleton;
+using ozz::animation::offline::AnimationBoundsBuilder;
+using ozz::animation::offline::RawAnimation;
+using ozz::animation::offline::RawSkeleton;
+using ozz::animation::offline::SkeletonBuilder;
+
+namespace {
+
+// Builds a 2 joints chain: a root and a "head" offset 1 unit along y.
+ozz::unique_ptr<Skeleton> BuildTestSkeleton() {
+  RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  RawSkeleton::Joint& root = raw_skeleton.roots[0];
+  root.name = "root";
+  root.children.resize(1);
+  root.children[0].name = "head";
+  root.children[0].transform.translation = ozz::math::Float3::y_axis();
+
+  SkeletonBuilder builder;
+  return builder(raw_skeleton);
+}
+
+// Builds a 1s clip whose root translates along x, from zero to 2 units, at
+// constant speed. The head stays 1 unit above the root.
+RawAnimation BuildMovingRawAnimation() {
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(2);
+  const RawAnimation::TranslationKey key0 = {0.f, ozz::math::Float3::zero()};
+  raw_animation.tracks[0].translations.push_back(key0);
+  const RawAnimation::TranslationKey key1 = {1.f,
+                                             ozz::math::Float3(2.f, 0.f, 0.f)};
+  raw_animation.tracks[0].translations.push_back(key1);
+  const RawAnimation::TranslationKey head_key = {0.f,
+                                                 ozz::math::Float3::y_axis()};
+  raw_animation.tracks[1].translations.push_back(head_key);
+  return raw_animation;
+}
+}  // namespace
+
+TEST(Error, AnimationBoundsBuilder) {
+  ozz::unique_ptr<Skeleton> skeleton = BuildTestSkeleton();
+  ASSERT_TRUE(skeleton);
+  const RawAnimation raw_animation = BuildMovingRawAnimation();
+
+  {  // Invalid animation fails.
+    RawAnimation invalid;
+    invalid.duration = -1.f;
+    AnimationBoundsBuilder builder;
+    EXPECT_FALSE(builder(*skeleton, invalid));
+  }
+
+  {  // Mismatching track count fails.
+    RawAnimation mismatched;
+    mismatched.duration = 1.f;
+    mismatched.tracks.resize(1);
+    AnimationBoundsBuilder builder;
+    EXPECT_FALSE(builder(*skeleton, mismatched));
+  }
+
+  {  // Non positive interval count fails.
+    AnimationBoundsBuilder builder;
+    builder.num_intervals = 0;
+    EXPECT_FALSE(builder(*skeleton, raw_animation));
+  }
+
+  {  // Non positive sample rate fails.
+    AnimationBoundsBuilder builder;
+    builder.sample_rate = 0.f;
+    EXPECT_FALSE(builder(*skeleton, raw_animation));
+  }
+
+  {  // Negative margin fails.
+    AnimationBoundsBuilder builder;
+    builder.margin = -1.f;
+    EXPECT_FALSE(builder(*skeleton, raw_animation));
+  }
+}
+
+TEST(Build, AnimationBoundsBuilder) {
+  ozz::unique_ptr<Skeleton> skeleton = BuildTestSkeleton();
+  ASSERT_TRUE(skeleton);
+  const RawAnimation raw_animation = BuildMovingRawAnimation();
+
+  AnimationBoundsBuilder builder;
+  builder.num_intervals = 4;
+  ozz::unique_ptr<AnimationBounds> bounds = builder(*skeleton, raw_animation);
+  ASSERT_TRUE(bounds);
+  EXPECT_EQ(bounds->num_intervals(), 4);
+
+  // An empty bounds object returns an invalid box.
+  const AnimationBounds empty;
+  EXPECT_FALSE(empty.GetBounds(0.f).is_valid());
+
+  // First interval covers root moving from x 0 to .5, head 1 unit above.
+  const ozz::math::Box first = bounds->GetBounds(0.f);
+  ASSERT_TRUE(first.is_valid());
+  EXPECT_FLOAT3_EQ(first.min, 0.f, 0.f, 0.f);
+  EXPECT_FLOAT3_EQ(first.max, .5f, 1.f, 0.f);
+
+  // Ratios are clamped, the last interval ends at x 2.
+  const ozz::math::Box last = bounds->GetBounds(46.f);
+  ASSERT_TRUE(last.is_valid());
+  EXPECT_FLOAT3_EQ(last.min, 1.5f, 0.f, 0.f);
+  EXPECT_FLOAT3_EQ(last.max, 2.f, 1.f, 0.f);
+
+  // A ranged query merges every intersected interval, unordered.
+  const ozz::math::Box range = bounds->GetBounds(.9f, .3f);
+  ASSERT_TRUE(range.is_valid());
+  EXPECT_FLOAT3_EQ(range.min, .5f, 0.f, 0.f);
+  EXPECT_FLOAT3_EQ(range.max, 2.f, 1.f, 0.f);
+
+  // Margin uniformly expands boxes.
+  builder.margin = .25f;
+  ozz::unique_ptr<AnimationBounds> padded = builder(*skeleton, raw_animation);
+  ASSERT_TRUE(padded);
+  const ozz::math::Box padded_first = padded->GetBounds(0.f);
+  EXPECT_FLOAT3_EQ(padded_first.min, -.25f, -.25f, -.25f);
+  EXPECT_FLOAT3_EQ(padded_first.max, .75f, 1.25f, .25f);
+}
+
+TEST(Serialize, AnimationBoundsBuilder) {
+  ozz::unique_ptr<Skeleton> skeleton = BuildTestSkeleton();
+  ASSERT_TRUE(skeleton);
+  const RawAnimation raw_animation = BuildMovingRawAnimation();
+
+  AnimationBoundsBuilder builder;
+  builder.num_intervals = 4;
+  ozz::unique_ptr<AnimationBounds> bounds = builder(*skeleton, raw_animation);
+  ASSERT_TRUE(bounds);
+
+  ozz::io::MemoryStream stream;
+  {
+    ozz::io::OArchive o(&stream);
+    o << *bounds;
+  }
+
+  AnimationBounds loaded;
+  stream.Seek(0, ozz::io::Stream::kSet);
+  {
+    ozz::io::IArchive i(&stream);
+    i >> loaded;
+  }
+
+  ASSERT_EQ(loaded.num_intervals(), bounds->num_intervals());
+  for (int i = 0; i < loaded.num_intervals(); ++i) {
+    const float ratio = (i + .5f) / loaded.num_intervals();
+    const ozz::math::Box built = bounds->GetBounds(ratio);
+    const ozz::math::Box reloaded = loaded.GetBounds(ratio);
+    EXPECT_FLOAT3_EQ(reloaded.min, built.min.x, built.min.y, built.min.z);
+    EXPECT_FLOAT3_EQ(reloaded.max, built.max.x, built.max.y, built.max.z);
+  }
+}
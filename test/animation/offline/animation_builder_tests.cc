@@ -25,15 +25,22 @@
 //                                                                            //
 //----------------------------------------------------------------------------//
 
+#include <cmath>
+
 #include "gtest/gtest.h"
 #include "ozz/animation/offline/animation_builder.h"
 #include "ozz/animation/offline/raw_animation.h"
 #include "ozz/animation/runtime/animation.h"
 #include "ozz/animation/runtime/sampling_job.h"
 #include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/io/archive.h"
+#include "ozz/base/io/stream.h"
 #include "ozz/base/maths/gtest_math_helper.h"
 #include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/maths/transform.h"
 #include "ozz/base/memory/unique_ptr.h"
+#include "ozz/base/scheduler.h"
+#include "ozz/base/span.h"
 
 using ozz::animation::Animation;
 using ozz::animation::offline::AnimationBuilder;
@@ -216,6 +223,258 @@ TEST(Name, AnimationBuilder) {
   }
 }
 
+TEST(AnimatedJoints, AnimationBuilder) {
+  AnimationBuilder builder;
+
+  {  // Empty animation has no animated joints.
+    RawAnimation raw_animation;
+    raw_animation.duration = 1.f;
+    ozz::unique_ptr<Animation> anim(builder(raw_animation));
+    ASSERT_TRUE(anim);
+    EXPECT_EQ(anim->animated_joints().size(), 0u);
+  }
+
+  {  // Constant and empty channels leave bits clear, non constant ones set
+     // their track bit.
+    RawAnimation raw_animation;
+    raw_animation.duration = 1.f;
+    raw_animation.tracks.resize(10);
+
+    // Track 0 has empty channels only.
+    // Track 1 has a single key per channel.
+    const RawAnimation::TranslationKey t_key0 = {
+        0.f, ozz::math::Float3(1.f, 2.f, 3.f)};
+    raw_animation.tracks[1].translations.push_back(t_key0);
+
+    // Track 2 has constant channels, multiple keys with the same value.
+    raw_animation.tracks[2].translations.push_back(t_key0);
+    const RawAnimation::TranslationKey t_key1 = {.5f, t_key0.value};
+    raw_animation.tracks[2].translations.push_back(t_key1);
+
+    // Track 3 has a non constant translation channel.
+    raw_animation.tracks[3].translations.push_back(t_key0);
+    const RawAnimation::TranslationKey t_key2 = {
+        .5f, ozz::math::Float3(4.f, 5.f, 6.f)};
+    raw_animation.tracks[3].translations.push_back(t_key2);
+
+    // Track 9 has a non constant rotation channel.
+    const RawAnimation::RotationKey r_key0 = {
+        0.f, ozz::math::Quaternion::identity()};
+    raw_animation.tracks[9].rotations.push_back(r_key0);
+    const RawAnimation::RotationKey r_key1 = {
+        1.f, ozz::math::Quaternion(0.f, .70710677f, 0.f, .70710677f)};
+    raw_animation.tracks[9].rotations.push_back(r_key1);
+
+    ozz::unique_ptr<Animation> anim(builder(raw_animation));
+    ASSERT_TRUE(anim);
+
+    const ozz::span<const ozz::byte> animated = anim->animated_joints();
+    ASSERT_EQ(animated.size(), 2u);
+    EXPECT_EQ(animated[0] & (1 << 0), 0);  // Empty
+    EXPECT_EQ(animated[0] & (1 << 1), 0);  // Single key
+    EXPECT_EQ(animated[0] & (1 << 2), 0);  // Constant
+    EXPECT_NE(animated[0] & (1 << 3), 0);  // Animated translation
+    EXPECT_NE(animated[1] & (1 << 1), 0);  // Animated rotation
+  }
+}
+
+TEST(RigSignature, AnimationBuilder) {
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(2);
+
+  {  // No signature by default.
+    AnimationBuilder builder;
+    ozz::unique_ptr<Animation> anim(builder(raw_animation));
+    ASSERT_TRUE(anim);
+    EXPECT_STREQ(anim->rig(), "");
+  }
+
+  {  // Built animations are stamped with the builder signature.
+    AnimationBuilder builder;
+    builder.rig_signature = "biped 2 joints";
+    ozz::unique_ptr<Animation> anim(builder(raw_animation));
+    ASSERT_TRUE(anim);
+    EXPECT_STREQ(anim->rig(), "biped 2 joints");
+  }
+}
+
+TEST(PermuteTracks, AnimationBuilder) {
+  // Builds a 5 tracks animation where each track translates along x by its
+  // own index + 1, and ramps y up to 4 times that, so every sample
+  // identifies its track. Track 1 is constant (not animated).
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.name = "permutable";
+  raw_animation.tracks.resize(5);
+  for (int t = 0; t < 5; ++t) {
+    const float x = static_cast<float>(t + 1);
+    const float ramp = t == 1 ? 0.f : x * 4.f;
+    const RawAnimation::TranslationKey key0 = {0.f,
+                                               ozz::math::Float3(x, 0.f, 0.f)};
+    raw_animation.tracks[t].translations.push_back(key0);
+    const RawAnimation::TranslationKey key1 = {
+        1.f, ozz::math::Float3(x, ramp, 0.f)};
+    raw_animation.tracks[t].translations.push_back(key1);
+  }
+
+  AnimationBuilder builder;
+  builder.iframe_interval = .5f;  // Iframes must be remapped too.
+  builder.rig_signature = "rig a";
+  ozz::unique_ptr<Animation> anim(builder(raw_animation));
+  ASSERT_TRUE(anim);
+
+  {  // Invalid permutations fail, leaving the animation unchanged.
+    const uint16_t short_permutation[] = {0, 1, 2, 3};
+    EXPECT_FALSE(anim->PermuteTracks(ozz::make_span(short_permutation)));
+    const uint16_t duplicated[] = {0, 0, 2, 3, 4};
+    EXPECT_FALSE(anim->PermuteTracks(ozz::make_span(duplicated)));
+    const uint16_t out_of_range[] = {0, 1, 2, 3, 5};
+    EXPECT_FALSE(anim->PermuteTracks(ozz::make_span(out_of_range)));
+    EXPECT_EQ(anim->num_tracks(), 5);
+    EXPECT_STREQ(anim->name(), "permutable");
+  }
+
+  // Reverses track order: new track i is old track 4 - i.
+  const uint16_t reverse[] = {4, 3, 2, 1, 0};
+  ASSERT_TRUE(anim->PermuteTracks(ozz::make_span(reverse)));
+
+  // Everything but tracks content is preserved.
+  EXPECT_EQ(anim->num_tracks(), 5);
+  EXPECT_FLOAT_EQ(anim->duration(), 1.f);
+  EXPECT_STREQ(anim->name(), "permutable");
+  EXPECT_STREQ(anim->rig(), "rig a");
+
+  // Animated joints bitmask follows the permutation: old track 1 (constant)
+  // is now track 3.
+  ASSERT_EQ(anim->animated_joints().size(), 1u);
+  EXPECT_EQ(anim->animated_joints()[0], 0x17);
+
+  ozz::animation::SamplingJob::Context context(5);
+  ozz::math::SoaTransform output[2];
+  ozz::animation::SamplingJob job;
+  job.animation = anim.get();
+  job.context = &context;
+  job.output = output;
+
+  // Samples sequentially, then seeks straight to .9 on a cold context, which
+  // restores from a rebuilt iframe.
+  const float ratios[] = {0.f, .5f, 1.f, .9f};
+  for (size_t i = 0; i < OZZ_ARRAY_SIZE(ratios); ++i) {
+    const float ratio = ratios[i];
+    if (ratio == .9f) {
+      context.Invalidate();
+    }
+    job.ratio = ratio;
+    ASSERT_TRUE(job.Run());
+
+    // New track i matches old track 4 - i, x = 5 - i, y ramps accordingly.
+    EXPECT_SOAFLOAT3_EQ_EST(output[0].translation, 5.f, 4.f, 3.f, 2.f,
+                            20.f * ratio, 16.f * ratio, 12.f * ratio, 0.f, 0.f,
+                            0.f, 0.f, 0.f);
+    EXPECT_SOAFLOAT3_EQ_EST(output[1].translation, 1.f, 0.f, 0.f, 0.f,
+                            4.f * ratio, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f);
+  }
+}
+
+TEST(MakeAdditive, AnimationBuilder) {
+  // Builds a 5 tracks absolute animation where each track translates along x
+  // by its own index + 1 and ramps y up to 4 times that. Rotations and
+  // scales are left to their identity tracks.
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.name = "absolute";
+  raw_animation.tracks.resize(5);
+  for (int t = 0; t < 5; ++t) {
+    const float x = static_cast<float>(t + 1);
+    const RawAnimation::TranslationKey key0 = {0.f,
+                                               ozz::math::Float3(x, 0.f, 0.f)};
+    raw_animation.tracks[t].translations.push_back(key0);
+    const RawAnimation::TranslationKey key1 = {
+        1.f, ozz::math::Float3(x, x * 4.f, 0.f)};
+    raw_animation.tracks[t].translations.push_back(key1);
+  }
+
+  AnimationBuilder builder;
+  builder.iframe_interval = .5f;
+  ozz::unique_ptr<Animation> anim(builder(raw_animation));
+  ASSERT_TRUE(anim);
+
+  // Per track reference pose the clip is rebased against: translated by .5
+  // along x, rotated by pi/2 around y, scaled by 2.
+  ozz::math::Transform reference[5];
+  for (int t = 0; t < 5; ++t) {
+    reference[t] = ozz::math::Transform::identity();
+    reference[t].translation.x = .5f;
+    reference[t].rotation =
+        ozz::math::Quaternion(0.f, ozz::math::kSqrt2_2, 0.f,
+                              ozz::math::kSqrt2_2);
+    reference[t].scale = ozz::math::Float3(2.f, 2.f, 2.f);
+  }
+
+  {  // Invalid reference poses fail, leaving the animation unchanged.
+    EXPECT_FALSE(
+        anim->MakeAdditive(ozz::span<const ozz::math::Transform>(reference, 4)));
+    ozz::math::Transform null_scale[5];
+    for (int t = 0; t < 5; ++t) {
+      null_scale[t] = ozz::math::Transform::identity();
+    }
+    null_scale[2].scale.y = 0.f;
+    EXPECT_FALSE(anim->MakeAdditive(ozz::make_span(null_scale)));
+    EXPECT_EQ(anim->num_tracks(), 5);
+    EXPECT_STREQ(anim->name(), "absolute");
+  }
+
+  ASSERT_TRUE(anim->MakeAdditive(ozz::make_span(reference)));
+
+  // Everything but keyframe values is preserved.
+  EXPECT_EQ(anim->num_tracks(), 5);
+  EXPECT_FLOAT_EQ(anim->duration(), 1.f);
+  EXPECT_STREQ(anim->name(), "absolute");
+
+  ozz::animation::SamplingJob::Context context(5);
+  ozz::math::SoaTransform output[2];
+  ozz::animation::SamplingJob job;
+  job.animation = anim.get();
+  job.context = &context;
+  job.output = output;
+
+  // Samples sequentially, then seeks straight to .9 on a cold context, which
+  // restores from an iframe of transcoded keys.
+  const float ratios[] = {0.f, .5f, 1.f, .9f};
+  for (size_t i = 0; i < OZZ_ARRAY_SIZE(ratios); ++i) {
+    const float ratio = ratios[i];
+    if (ratio == .9f) {
+      context.Invalidate();
+    }
+    job.ratio = ratio;
+    ASSERT_TRUE(job.Run());
+
+    // Track t translation delta is (t + .5, ramp, 0). Soa padding lanes keep
+    // their identity value, the additive identity.
+    EXPECT_SOAFLOAT3_EQ_EST(output[0].translation, .5f, 1.5f, 2.5f, 3.5f,
+                            4.f * ratio, 8.f * ratio, 12.f * ratio,
+                            16.f * ratio, 0.f, 0.f, 0.f, 0.f);
+    EXPECT_SOAFLOAT3_EQ_EST(output[1].translation, 4.5f, 0.f, 0.f, 0.f,
+                            20.f * ratio, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f);
+
+    // Identity rotations rebased against a pi/2 rotation give a -pi/2 delta,
+    // identity scales divided by 2 give .5.
+    EXPECT_SOAQUATERNION_EQ_EST(
+        output[0].rotation, 0.f, 0.f, 0.f, 0.f, -ozz::math::kSqrt2_2,
+        -ozz::math::kSqrt2_2, -ozz::math::kSqrt2_2, -ozz::math::kSqrt2_2, 0.f,
+        0.f, 0.f, 0.f, ozz::math::kSqrt2_2, ozz::math::kSqrt2_2,
+        ozz::math::kSqrt2_2, ozz::math::kSqrt2_2);
+    EXPECT_SOAQUATERNION_EQ_EST(output[1].rotation, 0.f, 0.f, 0.f, 0.f,
+                                -ozz::math::kSqrt2_2, 0.f, 0.f, 0.f, 0.f, 0.f,
+                                0.f, 0.f, ozz::math::kSqrt2_2, 1.f, 1.f, 1.f);
+    EXPECT_SOAFLOAT3_EQ_EST(output[0].scale, .5f, .5f, .5f, .5f, .5f, .5f,
+                            .5f, .5f, .5f, .5f, .5f, .5f);
+    EXPECT_SOAFLOAT3_EQ_EST(output[1].scale, .5f, 1.f, 1.f, 1.f, .5f, 1.f,
+                            1.f, 1.f, .5f, 1.f, 1.f, 1.f);
+  }
+}
+
 TEST(Move, AnimationBuilder) {
   AnimationBuilder builder;
   RawAnimation raw_animation;
@@ -252,6 +511,335 @@ TEST(Move, AnimationBuilder) {
   }
 }
 
+TEST(BuildBatch, AnimationBuilder) {
+  AnimationBuilder builder;
+
+  // Prepares a batch of raw animations of different sizes, with an invalid
+  // one (negative duration) in the middle.
+  const size_t kNumAnimations = 17;
+  const size_t kInvalid = 7;
+  ozz::vector<RawAnimation> raw_animations(kNumAnimations);
+  for (size_t i = 0; i < kNumAnimations; ++i) {
+    RawAnimation& raw_animation = raw_animations[i];
+    raw_animation.duration = 1.f + i;
+    raw_animation.tracks.resize(1 + i % 5);
+    for (size_t j = 0; j < raw_animation.tracks.size(); ++j) {
+      const RawAnimation::TranslationKey key = {
+          .5f * i, ozz::math::Float3(1.f * i, 2.f * i, 1.f * j)};
+      raw_animation.tracks[j].translations.push_back(key);
+    }
+  }
+  raw_animations[kInvalid].duration = -1.f;
+
+  // Builds the batch, with default (hardware) and explicit thread counts.
+  for (size_t num_threads = 0; num_threads < 4; ++num_threads) {
+    const ozz::vector<ozz::unique_ptr<Animation>> animations =
+        builder(make_span(raw_animations), num_threads);
+    ASSERT_EQ(animations.size(), kNumAnimations);
+
+    for (size_t i = 0; i < kNumAnimations; ++i) {
+      if (i == kInvalid) {  // Failed entries are nullptr.
+        EXPECT_FALSE(animations[i]);
+        continue;
+      }
+      // Batched animations match serially built ones.
+      ASSERT_TRUE(animations[i]);
+      const ozz::unique_ptr<Animation> serial = builder(raw_animations[i]);
+      ASSERT_TRUE(serial);
+      EXPECT_FLOAT_EQ(animations[i]->duration(), serial->duration());
+      EXPECT_EQ(animations[i]->num_tracks(), serial->num_tracks());
+      EXPECT_EQ(animations[i]->size(), serial->size());
+    }
+  }
+
+  {  // Empty batch.
+    const ozz::vector<ozz::unique_ptr<Animation>> animations =
+        builder(ozz::span<const RawAnimation>());
+    EXPECT_TRUE(animations.empty());
+  }
+}
+
+TEST(ParallelBuild, AnimationBuilder) {
+  // Prepares a single clip with enough keys to exercise the parallel sort
+  // path (chunked sort + pairwise merges).
+  const size_t kNumTracks = 4;
+  const size_t kNumKeys = 10000;
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(kNumTracks);
+  for (size_t i = 0; i < kNumTracks; ++i) {
+    RawAnimation::JointTrack& track = raw_animation.tracks[i];
+    for (size_t k = 0; k < kNumKeys; ++k) {
+      const float time = raw_animation.duration * k / (kNumKeys - 1);
+      const RawAnimation::TranslationKey key = {
+          time, ozz::math::Float3(std::cos(1.f * k + i), 1.f * i, 1.f * k)};
+      track.translations.push_back(key);
+    }
+  }
+
+  // Serial reference build.
+  AnimationBuilder builder;
+  const ozz::unique_ptr<Animation> reference = builder(raw_animation);
+  ASSERT_TRUE(reference);
+
+  // Parallel build produces a strictly identical animation.
+  ozz::ThreadPoolScheduler scheduler;
+  builder.scheduler = &scheduler;
+  const ozz::unique_ptr<Animation> parallel = builder(raw_animation);
+  ASSERT_TRUE(parallel);
+  EXPECT_FLOAT_EQ(parallel->duration(), reference->duration());
+  EXPECT_EQ(parallel->num_tracks(), reference->num_tracks());
+  EXPECT_EQ(parallel->size(), reference->size());
+  EXPECT_EQ(parallel->translations_values().size(),
+            reference->translations_values().size());
+
+  {  // Parallel validation rejects invalid clips like the serial one.
+    RawAnimation invalid = raw_animation;
+    invalid.tracks[kNumTracks - 1].translations[kNumKeys / 2].time = 2.f;
+    EXPECT_FALSE(invalid.Validate());
+    EXPECT_FALSE(builder(invalid));
+
+    invalid.duration = -1.f;
+    EXPECT_FALSE(builder(invalid));
+  }
+}
+
+TEST(StreamingBuild, AnimationBuilder) {
+  AnimationBuilder builder;
+
+  // Prepares a reference raw animation.
+  RawAnimation raw_animation;
+  raw_animation.name = "streamed";
+  raw_animation.duration = 2.f;
+  raw_animation.tracks.resize(7);
+  for (size_t i = 0; i < raw_animation.tracks.size(); ++i) {
+    const RawAnimation::TranslationKey tkey = {.4f * (i % 4),
+                                               ozz::math::Float3(1.f * i, 2.f * i, 3.f * i)};
+    raw_animation.tracks[i].translations.push_back(tkey);
+    const RawAnimation::ScaleKey skey = {1.f, ozz::math::Float3(2.f, 2.f, 2.f)};
+    raw_animation.tracks[i].scales.push_back(skey);
+  }
+
+  // Provides tracks from the reference animation, one at a time.
+  struct Provider : public AnimationBuilder::TrackProvider {
+    explicit Provider(const RawAnimation& _animation)
+        : animation(_animation) {}
+    virtual bool GetTrack(int _track_index,
+                          RawAnimation::JointTrack* _track) override {
+      EXPECT_EQ(_track_index, expected_index++);
+      *_track = animation.tracks[_track_index];
+      return true;
+    }
+    const RawAnimation& animation;
+    int expected_index = 0;
+  } provider(raw_animation);
+
+  // Streamed and regular builds produce the same animation.
+  const ozz::unique_ptr<Animation> streamed =
+      builder("streamed", raw_animation.duration,
+              static_cast<int>(raw_animation.tracks.size()), &provider);
+  ASSERT_TRUE(streamed);
+  const ozz::unique_ptr<Animation> reference = builder(raw_animation);
+  ASSERT_TRUE(reference);
+  EXPECT_STREQ(streamed->name(), reference->name());
+  EXPECT_FLOAT_EQ(streamed->duration(), reference->duration());
+  EXPECT_EQ(streamed->num_tracks(), reference->num_tracks());
+  EXPECT_EQ(streamed->size(), reference->size());
+
+  {  // Invalid arguments.
+    EXPECT_FALSE(builder(nullptr, 1.f, 1, &provider));
+    EXPECT_FALSE(builder("name", 1.f, 1, nullptr));
+    EXPECT_FALSE(builder("name", 0.f, 1, &provider));
+    EXPECT_FALSE(builder("name", 1.f, -1, &provider));
+  }
+
+  {  // Aborting provider fails the build.
+    struct Aborter : public AnimationBuilder::TrackProvider {
+      virtual bool GetTrack(int, RawAnimation::JointTrack*) override {
+        return false;
+      }
+    } aborter;
+    EXPECT_FALSE(builder("name", 1.f, 1, &aborter));
+  }
+
+  {  // Invalid provided track fails the build.
+    struct Invalid : public AnimationBuilder::TrackProvider {
+      virtual bool GetTrack(int, RawAnimation::JointTrack* _track) override {
+        // Key time is out of the animation duration range.
+        const RawAnimation::TranslationKey key = {2.f,
+                                                  ozz::math::Float3::zero()};
+        _track->translations.push_back(key);
+        return true;
+      }
+    } invalid;
+    EXPECT_FALSE(builder("name", 1.f, 1, &invalid));
+  }
+}
+
+TEST(TranslationQuantization, AnimationBuilder) {
+  AnimationBuilder builder;
+
+  // Values with no exact half float representation.
+  const float values[] = {.1f, -.3f, 1e-3f, 65504.f, -1001.f, .2500001f};
+  for (float value : values) {
+    RawAnimation raw_animation;
+    raw_animation.duration = 1.f;
+    raw_animation.tracks.resize(1);
+    const RawAnimation::TranslationKey key = {
+        0.f, ozz::math::Float3(value, value, value)};
+    raw_animation.tracks[0].translations.push_back(key);
+
+    const ozz::unique_ptr<Animation> animation = builder(raw_animation);
+    ASSERT_TRUE(animation);
+
+    ozz::animation::SamplingJob job;
+    ozz::animation::SamplingJob::Context context(1);
+    ozz::math::SoaTransform output[1];
+    job.animation = animation.get();
+    job.context = &context;
+    job.output = output;
+    job.ratio = 0.f;
+    ASSERT_TRUE(job.Run());
+
+    // Compression rounds to the nearest representable half float, so
+    // quantization error cannot exceed half the distance between the 2
+    // representable values surrounding the original one.
+    const float lower =
+        ozz::math::HalfToFloat(ozz::math::FloatToHalf(value));
+    const float upper = ozz::math::HalfToFloat(
+        static_cast<uint16_t>(ozz::math::FloatToHalf(value) + 1));
+    const float sampled = ozz::math::GetX(output[0].translation.x);
+    EXPECT_LE(std::abs(sampled - value),
+              std::abs(upper - lower) * .5f);
+  }
+}
+
+TEST(Deduplicate, AnimationBuilder) {
+  AnimationBuilder builder;
+
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(2);
+
+  // Track 0 is constant (rest-pose like), densely sampled as a DCC exporter
+  // would do. Track 1 varies, with a constant run in its middle.
+  for (size_t i = 0; i < 30; ++i) {
+    const RawAnimation::TranslationKey key = {i / 29.f,
+                                              ozz::math::Float3(4.f, 5.f, 6.f)};
+    raw_animation.tracks[0].translations.push_back(key);
+    const RawAnimation::RotationKey rkey = {
+        i / 29.f, ozz::math::Quaternion::identity()};
+    raw_animation.tracks[0].rotations.push_back(rkey);
+  }
+  const float values[] = {0.f, 1.f, 2.f, 2.f, 2.f, 2.f, 3.f};
+  for (size_t i = 0; i < OZZ_ARRAY_SIZE(values); ++i) {
+    const RawAnimation::TranslationKey key = {
+        i / 6.f, ozz::math::Float3(values[i], 0.f, 0.f)};
+    raw_animation.tracks[1].translations.push_back(key);
+  }
+
+  // Builds with and without deduplication.
+  const ozz::unique_ptr<Animation> plain = builder(raw_animation);
+  ASSERT_TRUE(plain);
+  builder.deduplicate = true;
+  const ozz::unique_ptr<Animation> dedup = builder(raw_animation);
+  ASSERT_TRUE(dedup);
+  builder.deduplicate = false;
+
+  // Constant tracks collapsed to their boundary keys.
+  EXPECT_LT(dedup->size(), plain->size());
+
+  // Sampled values are strictly unchanged.
+  ozz::animation::SamplingJob job;
+  ozz::animation::SamplingJob::Context context(2);
+  ozz::math::SoaTransform plain_output[1];
+  ozz::math::SoaTransform dedup_output[1];
+  for (float ratio = 0.f; ratio <= 1.f; ratio += .05f) {
+    job.ratio = ratio;
+    job.animation = plain.get();
+    job.context = &context;
+    job.output = plain_output;
+    ASSERT_TRUE(job.Run());
+    context.Invalidate();
+    job.animation = dedup.get();
+    job.output = dedup_output;
+    ASSERT_TRUE(job.Run());
+    context.Invalidate();
+
+    EXPECT_TRUE(ozz::math::AreAllTrue(
+        plain_output[0].translation.x == dedup_output[0].translation.x));
+    EXPECT_TRUE(ozz::math::AreAllTrue(
+        plain_output[0].translation.y == dedup_output[0].translation.y));
+    EXPECT_TRUE(ozz::math::AreAllTrue(
+        plain_output[0].translation.z == dedup_output[0].translation.z));
+    EXPECT_TRUE(ozz::math::AreAllTrue(
+        plain_output[0].rotation.x == dedup_output[0].rotation.x));
+    EXPECT_TRUE(ozz::math::AreAllTrue(
+        plain_output[0].rotation.w == dedup_output[0].rotation.w));
+  }
+}
+
+TEST(SamplingProfile, AnimationBuilder) {
+  AnimationBuilder builder;
+
+  // A single track whose translation interval spans the whole clip.
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(1);
+  const RawAnimation::TranslationKey key0 = {0.f, ozz::math::Float3::zero()};
+  raw_animation.tracks[0].translations.push_back(key0);
+  const RawAnimation::TranslationKey key1 = {1.f,
+                                             ozz::math::Float3(4.f, 0.f, 0.f)};
+  raw_animation.tracks[0].translations.push_back(key1);
+
+  // Reference build, no profile.
+  const ozz::unique_ptr<Animation> plain = builder(raw_animation);
+  ASSERT_TRUE(plain);
+  const size_t plain_keys = plain->translations_ctrl().ratios.size();
+
+  {  // Negative densities fail the build.
+    builder.sampling_profile = {1.f, -1.f};
+    EXPECT_FALSE(builder(raw_animation));
+  }
+
+  {  // An all-zero profile has no hot range, hence no effect.
+    builder.sampling_profile = {0.f, 0.f, 0.f, 0.f};
+    const ozz::unique_ptr<Animation> flat = builder(raw_animation);
+    ASSERT_TRUE(flat);
+    EXPECT_EQ(flat->translations_ctrl().ratios.size(), plain_keys);
+  }
+
+  // Hot first quarter: the whole-clip interval of every (padded) track is
+  // split at the hot range end.
+  builder.sampling_profile = {1.f, 0.f, 0.f, 0.f};
+  const ozz::unique_ptr<Animation> packed = builder(raw_animation);
+  ASSERT_TRUE(packed);
+  EXPECT_EQ(packed->translations_ctrl().ratios.size(), plain_keys + 4);
+
+  // Sampled values are preserved.
+  ozz::animation::SamplingJob job;
+  ozz::animation::SamplingJob::Context context(1);
+  ozz::math::SoaTransform plain_output[1];
+  ozz::math::SoaTransform packed_output[1];
+  for (float ratio = 0.f; ratio <= 1.f; ratio += .05f) {
+    job.ratio = ratio;
+    job.animation = plain.get();
+    job.context = &context;
+    job.output = plain_output;
+    ASSERT_TRUE(job.Run());
+    context.Invalidate();
+    job.animation = packed.get();
+    job.output = packed_output;
+    ASSERT_TRUE(job.Run());
+    context.Invalidate();
+
+    EXPECT_SOAFLOAT3_EQ_EST(plain_output[0].translation, 4.f * ratio, 0.f, 0.f,
+                            0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f);
+    EXPECT_SOAFLOAT3_EQ_EST(packed_output[0].translation, 4.f * ratio, 0.f,
+                            0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f);
+  }
+}
+
 TEST(Sort, AnimationBuilder) {
   // Instantiates a builder objects with default parameters.
   AnimationBuilder builder;
@@ -486,4 +1074,89 @@ TEST(ManyKeys, SamplingJob) {
     EXPECT_SOAFLOAT3_EQ_EST(output[0].translation, 20.f, 0.f, -1.f, 3.f, 20.f,
                             0.f, -1.f, 3.f, 20.f, 0.f, -1.f, 3.f);
   }
-}
\ No newline at end of file
+}
+TEST(EnforceLoop, AnimationBuilder) {
+  // A single track translating from 1 to 5 on x, not loop-safe.
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(1);
+  const RawAnimation::TranslationKey first_key = {
+      0.f, ozz::math::Float3(1.f, 0.f, 0.f)};
+  const RawAnimation::TranslationKey mid_key = {
+      .5f, ozz::math::Float3(5.f, 0.f, 0.f)};
+  const RawAnimation::TranslationKey last_key = {
+      1.f, ozz::math::Float3(5.f, 0.f, 0.f)};
+  raw_animation.tracks[0].translations.push_back(first_key);
+  raw_animation.tracks[0].translations.push_back(mid_key);
+  raw_animation.tracks[0].translations.push_back(last_key);
+
+  AnimationBuilder builder;
+  ozz::math::SoaTransform output[1];
+
+  {  // Mismatching seam values are detected as non looping.
+    ozz::unique_ptr<Animation> animation = builder(raw_animation);
+    ASSERT_TRUE(animation);
+    EXPECT_FALSE(animation->looping());
+
+    // Non looping animations clamp out-of-range ratios, as always.
+    ozz::animation::SamplingJob job;
+    ozz::animation::SamplingJob::Context context(1);
+    job.animation = animation.get();
+    job.context = &context;
+    job.output = output;
+    job.ratio = 1.25f;
+    ASSERT_TRUE(job.Run());
+    EXPECT_SOAFLOAT3_EQ_EST(output[0].translation, 5.f, 0.f, 0.f, 0.f, 0.f,
+                            0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f);
+  }
+
+  {  // Raw tracks that already loop are detected, without enforcement.
+    RawAnimation looping_raw = raw_animation;
+    looping_raw.tracks[0].translations[2].value = first_key.value;
+    ozz::unique_ptr<Animation> animation = builder(looping_raw);
+    ASSERT_TRUE(animation);
+    EXPECT_TRUE(animation->looping());
+  }
+
+  {  // Enforcement forces the last key to the first's value.
+    builder.enforce_loop = true;
+    ozz::unique_ptr<Animation> animation = builder(raw_animation);
+    ASSERT_TRUE(animation);
+    EXPECT_TRUE(animation->looping());
+
+    ozz::animation::SamplingJob job;
+    ozz::animation::SamplingJob::Context context(1);
+    job.animation = animation.get();
+    job.context = &context;
+    job.output = output;
+
+    // Both seam sides now sample the same pose.
+    job.ratio = 1.f;
+    ASSERT_TRUE(job.Run());
+    EXPECT_SOAFLOAT3_EQ_EST(output[0].translation, 1.f, 0.f, 0.f, 0.f, 0.f,
+                            0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f);
+
+    // Out-of-range ratios wrap across the seam instead of clamping: .25
+    // (wherever it wrapped from) interpolates keys at 0 (value 1) and .5
+    // (value 5) halfway.
+    const float ratios[] = {.25f, 1.25f, -.75f};
+    for (size_t i = 0; i < OZZ_ARRAY_SIZE(ratios); ++i) {
+      job.ratio = ratios[i];
+      ASSERT_TRUE(job.Run());
+      EXPECT_SOAFLOAT3_EQ_EST(output[0].translation, 3.f, 0.f, 0.f, 0.f, 0.f,
+                              0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f);
+    }
+
+    // Loop safety survives serialization.
+    ozz::io::MemoryStream stream;
+    {
+      ozz::io::OArchive o(&stream);
+      o << *animation;
+    }
+    stream.Seek(0, ozz::io::Stream::kSet);
+    ozz::io::IArchive i(&stream);
+    Animation loaded;
+    i >> loaded;
+    EXPECT_TRUE(loaded.looping());
+  }
+}
@@ -0,0 +1,130 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/animation_builder.h"
+#include "ozz/animation/offline/animation_joint_filter.h"
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/base/maths/gtest_math_helper.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+using ozz::animation::Animation;
+using ozz::animation::offline::AnimationBuilder;
+using ozz::animation::offline::AnimationJointFilter;
+using ozz::animation::offline::RawAnimation;
+
+TEST(Error, AnimationJointFilter) {
+  AnimationJointFilter filter;
+
+  {  // nullptr output.
+    RawAnimation input;
+    EXPECT_TRUE(input.Validate());
+    EXPECT_FALSE(filter(input, nullptr));
+  }
+
+  {  // Invalid input animation.
+    RawAnimation input;
+    input.duration = -1.f;
+    EXPECT_FALSE(input.Validate());
+
+    RawAnimation output;
+    output.duration = -1.f;
+    output.tracks.resize(1);
+    EXPECT_FALSE(filter(input, &output));
+    EXPECT_FLOAT_EQ(output.duration, RawAnimation().duration);
+    EXPECT_EQ(output.num_tracks(), 0);
+  }
+
+  {  // Out of range joint index.
+    RawAnimation input;
+    input.tracks.resize(2);
+    EXPECT_TRUE(input.Validate());
+
+    RawAnimation output;
+    filter.joints = {2};
+    EXPECT_FALSE(filter(input, &output));
+    filter.joints = {-1};
+    EXPECT_FALSE(filter(input, &output));
+  }
+}
+
+TEST(Filter, AnimationJointFilter) {
+  // Prepares an input with 3 animated tracks.
+  RawAnimation input;
+  input.name = "filtered";
+  input.duration = 1.f;
+  input.tracks.resize(3);
+  for (size_t i = 0; i < input.tracks.size(); ++i) {
+    for (size_t k = 0; k < 10; ++k) {
+      const RawAnimation::TranslationKey tkey = {
+          .1f * k, ozz::math::Float3(1.f * i, 1.f * k, 0.f)};
+      input.tracks[i].translations.push_back(tkey);
+      const RawAnimation::ScaleKey skey = {.1f * k,
+                                           ozz::math::Float3(1.f + i + k,
+                                                             1.f, 1.f)};
+      input.tracks[i].scales.push_back(skey);
+    }
+  }
+  ASSERT_TRUE(input.Validate());
+
+  // Keeps only track 1.
+  AnimationJointFilter filter;
+  filter.joints = {1};
+  RawAnimation output;
+  ASSERT_TRUE(filter(input, &output));
+
+  // Duration, name and track count are preserved.
+  EXPECT_STREQ(output.name.c_str(), input.name.c_str());
+  EXPECT_FLOAT_EQ(output.duration, input.duration);
+  ASSERT_EQ(output.num_tracks(), input.num_tracks());
+
+  // Kept track is copied as is.
+  EXPECT_EQ(output.tracks[1].translations.size(),
+            input.tracks[1].translations.size());
+  EXPECT_EQ(output.tracks[1].scales.size(), input.tracks[1].scales.size());
+
+  // Other tracks are collapsed to a constant first-key value.
+  for (size_t i = 0; i < output.tracks.size(); i += 2) {
+    const RawAnimation::JointTrack& track = output.tracks[i];
+    ASSERT_EQ(track.translations.size(), 1u);
+    EXPECT_FLOAT3_EQ(track.translations[0].value, 1.f * i, 0.f, 0.f);
+    ASSERT_EQ(track.scales.size(), 1u);
+    EXPECT_FLOAT3_EQ(track.scales[0].value, 1.f + i, 1.f, 1.f);
+    EXPECT_TRUE(track.rotations.empty());  // Empty input track stays empty.
+  }
+
+  // Both the filtered raw animation and its runtime build are smaller.
+  EXPECT_LT(output.size(), input.size());
+  AnimationBuilder builder;
+  const ozz::unique_ptr<Animation> full = builder(input);
+  ASSERT_TRUE(full);
+  const ozz::unique_ptr<Animation> filtered = builder(output);
+  ASSERT_TRUE(filtered);
+  EXPECT_LT(filtered->size(), full->size());
+  EXPECT_EQ(filtered->num_tracks(), full->num_tracks());
+}
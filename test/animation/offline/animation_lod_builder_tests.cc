@@ -0,0 +1,177 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/offline/animation_lod_builder.h"
+
+#include "gtest/gtest.h"
+
+#include "ozz/base/memory/unique_ptr.h"
+
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/offline/raw_skeleton.h"
+#include "ozz/animation/offline/skeleton_builder.h"
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/animation/runtime/animation_lod.h"
+#include "ozz/animation/runtime/animation_utils.h"
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/maths/soa_transform.h"
+
+using ozz::animation::Animation;
+using ozz::animation::AnimationLod;
+using ozz::animation::Skeleton;
+using ozz::animation::offline::AnimationLodBuilder;
+using ozz::animation::offline::RawAnimation;
+using ozz::animation::offline::RawSkeleton;
+using ozz::animation::offline::SkeletonBuilder;
+
+namespace {
+// Builds a single joint skeleton.
+ozz::unique_ptr<Skeleton> BuildSkeleton() {
+  RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  raw_skeleton.roots[0].name = "root";
+  SkeletonBuilder skeleton_builder;
+  return skeleton_builder(raw_skeleton);
+}
+}  // namespace
+
+TEST(Error, AnimationLodBuilder) {
+  AnimationLodBuilder lod_builder;
+  ozz::unique_ptr<Skeleton> skeleton = BuildSkeleton();
+  ASSERT_TRUE(skeleton);
+
+  {  // Invalid input animation.
+    RawAnimation input;
+    input.duration = -1.f;
+    EXPECT_FALSE(input.Validate());
+
+    const ozz::vector<ozz::unique_ptr<Animation>> lods =
+        lod_builder(input, *skeleton);
+    EXPECT_TRUE(lods.empty());
+  }
+
+  {  // Animation doesn't match skeleton, optimizer fails.
+    RawAnimation input;
+    input.duration = 1.f;
+    input.tracks.resize(2);
+    EXPECT_TRUE(input.Validate());
+
+    const ozz::vector<ozz::unique_ptr<Animation>> lods =
+        lod_builder(input, *skeleton);
+    EXPECT_TRUE(lods.empty());
+  }
+}
+
+TEST(Build, AnimationLodBuilder) {
+  ozz::unique_ptr<Skeleton> skeleton = BuildSkeleton();
+  ASSERT_TRUE(skeleton);
+
+  // Densely sampled linear translation track, so coarser levels can shed
+  // interpolable keyframes.
+  RawAnimation input;
+  input.duration = 1.f;
+  input.tracks.resize(1);
+  for (int i = 0; i < 60; ++i) {
+    const float time = input.duration * static_cast<float>(i) / 59.f;
+    const RawAnimation::TranslationKey key = {
+        time, ozz::math::Float3(time * 10.f, 0.f, 0.f)};
+    input.tracks[0].translations.push_back(key);
+  }
+  ASSERT_TRUE(input.Validate());
+
+  AnimationLodBuilder lod_builder;
+  ozz::vector<ozz::unique_ptr<Animation>> lods = lod_builder(input, *skeleton);
+
+  // Default builder settings produce 3 nested resolutions.
+  ASSERT_EQ(lods.size(), 3u);
+
+  for (size_t i = 0; i < lods.size(); ++i) {
+    ASSERT_TRUE(lods[i]);
+
+    // All levels share duration and track count.
+    EXPECT_FLOAT_EQ(lods[i]->duration(), input.duration);
+    EXPECT_EQ(lods[i]->num_tracks(), 1);
+
+    // Key density decreases (at least doesn't grow) with the level index.
+    if (i > 0) {
+      EXPECT_LE(CountTranslationKeyframes(*lods[i], 0),
+                CountTranslationKeyframes(*lods[i - 1], 0));
+    }
+  }
+
+  // Level 0 is the full input resolution, coarse levels decimate the linear
+  // track down to its boundary keys.
+  EXPECT_EQ(CountTranslationKeyframes(*lods[0], 0), 60);
+  EXPECT_LT(CountTranslationKeyframes(*lods[2], 0), 60);
+
+  // Every level samples the same (linear) motion.
+  AnimationLod lod(std::move(lods));
+  ASSERT_EQ(lod.num_levels(), 3);
+
+  ozz::animation::SamplingJob::Context context(1);
+  ozz::math::SoaTransform output[1];
+  for (int level = 0; level < lod.num_levels(); ++level) {
+    ozz::animation::SamplingJob job;
+    job.animation = lod.Select(level);
+    job.context = &context;
+    job.ratio = .46f;
+    job.output = output;
+    ASSERT_TRUE(job.Run());
+
+    float x[4];
+    ozz::math::StorePtrU(output[0].translation.x, x);
+    EXPECT_NEAR(x[0], 4.6f, 5e-3f);  // Within compression tolerance.
+  }
+}
+
+TEST(Select, AnimationLod) {
+  {  // Empty set.
+    AnimationLod lod;
+    EXPECT_EQ(lod.num_levels(), 0);
+    EXPECT_EQ(lod.Select(0), nullptr);
+    EXPECT_EQ(lod.Select(-1), nullptr);
+  }
+
+  {  // Level is clamped to the available range.
+    ozz::unique_ptr<Skeleton> skeleton = BuildSkeleton();
+    ASSERT_TRUE(skeleton);
+
+    RawAnimation input;
+    input.duration = 1.f;
+    input.tracks.resize(1);
+    ASSERT_TRUE(input.Validate());
+
+    AnimationLodBuilder lod_builder;
+    AnimationLod lod(lod_builder(input, *skeleton));
+    ASSERT_EQ(lod.num_levels(), 3);
+
+    EXPECT_EQ(lod.Select(-1), lod.Select(0));
+    EXPECT_EQ(lod.Select(46), lod.Select(2));
+    EXPECT_NE(lod.Select(0), lod.Select(2));
+  }
+}
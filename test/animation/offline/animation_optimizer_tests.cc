@@ -670,3 +670,96 @@ TEST(OptimizeOverride, AnimationOptimizer) {
     input.tracks[4].scales.clear();
   }
 }
+
+TEST(Search, AnimationOptimizer) {
+  // Prepares a single joint skeleton.
+  RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  SkeletonBuilder skeleton_builder;
+  ozz::unique_ptr<Skeleton> skeleton(skeleton_builder(raw_skeleton));
+  ASSERT_TRUE(skeleton);
+
+  AnimationOptimizer optimizer;
+
+  // Disables vertex distance.
+  optimizer.setting.distance = 0.f;
+
+  // Single translation track with variations of decreasing amplitude, so
+  // every key has a different importance to the search.
+  RawAnimation input;
+  input.duration = 1.f;
+  input.tracks.resize(1);
+  const float amplitudes[] = {0.f,   1.f,  -.8f, .6f, -.4f, .3f,
+                              -.2f,  .15f, -.1f, .05f, 0.f};
+  const size_t num_keys = OZZ_ARRAY_SIZE(amplitudes);
+  for (size_t i = 0; i < num_keys; ++i) {
+    const RawAnimation::TranslationKey key = {
+        i / (num_keys - 1.f),
+        ozz::math::Float3(static_cast<float>(i), amplitudes[i], 0.f)};
+    input.tracks[0].translations.push_back(key);
+  }
+  ASSERT_TRUE(input.Validate());
+
+  // Counts keyframes of all tracks.
+  auto count_keyframes = [](const RawAnimation& _animation) {
+    size_t total = 0;
+    for (size_t i = 0; i < _animation.tracks.size(); ++i) {
+      total += _animation.tracks[i].translations.size() +
+               _animation.tracks[i].rotations.size() +
+               _animation.tracks[i].scales.size();
+    }
+    return total;
+  };
+
+  {  // nullptr output.
+    EXPECT_FALSE(optimizer(input, *skeleton, 100, nullptr));
+  }
+
+  {  // Mismatching skeleton.
+    Skeleton empty_skeleton;
+    RawAnimation output;
+    EXPECT_FALSE(optimizer(input, empty_skeleton, 100, &output));
+  }
+
+  {  // Budget bigger than the input, lossless factor is selected.
+    RawAnimation output;
+    float factor = -1.f;
+    ASSERT_TRUE(optimizer(input, *skeleton, 100, &output, &factor));
+    EXPECT_FLOAT_EQ(factor, 0.f);
+    EXPECT_EQ(count_keyframes(output), num_keys);
+  }
+
+  {  // Tight budget, honored with a non 0 factor.
+    RawAnimation output;
+    float factor = -1.f;
+    ASSERT_TRUE(optimizer(input, *skeleton, 6, &output, &factor));
+    EXPECT_GT(factor, 0.f);
+    EXPECT_LE(count_keyframes(output), 6u);
+    EXPECT_GT(count_keyframes(output), 2u);
+
+    // First and last keys survive decimation.
+    const RawAnimation::JointTrack::Translations& translations =
+        output.tracks[0].translations;
+    EXPECT_FLOAT_EQ(translations.front().time, 0.f);
+    EXPECT_FLOAT_EQ(translations.back().time, 1.f);
+  }
+
+  {  // A looser budget retains at least as many keys as a tighter one.
+    RawAnimation tight, loose;
+    ASSERT_TRUE(optimizer(input, *skeleton, 4, &tight));
+    ASSERT_TRUE(optimizer(input, *skeleton, 8, &loose));
+    EXPECT_LE(count_keyframes(tight), 4u);
+    EXPECT_LE(count_keyframes(loose), 8u);
+    EXPECT_LE(count_keyframes(tight), count_keyframes(loose));
+  }
+
+  {  // Unreachable budget still succeeds, as decimated as possible. The
+     // track decimates down to its first key, whose removal no tolerance can
+     // trigger.
+    RawAnimation output;
+    float factor = -1.f;
+    ASSERT_TRUE(optimizer(input, *skeleton, 0, &output, &factor));
+    EXPECT_GT(factor, 0.f);
+    EXPECT_EQ(output.tracks[0].translations.size(), 1u);
+  }
+}
@@ -0,0 +1,277 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/motion_extractor.h"
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/offline/raw_skeleton.h"
+#include "ozz/animation/offline/raw_track.h"
+#include "ozz/animation/offline/skeleton_builder.h"
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/maths/gtest_math_helper.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+using ozz::animation::Skeleton;
+using ozz::animation::offline::MotionExtractor;
+using ozz::animation::offline::RawAnimation;
+using ozz::animation::offline::RawFloat3Track;
+using ozz::animation::offline::RawQuaternionTrack;
+using ozz::animation::offline::RawSkeleton;
+using ozz::animation::offline::SkeletonBuilder;
+
+namespace {
+
+// Builds a single root skeleton with a (10, 0, 5) rest pose translation.
+ozz::unique_ptr<Skeleton> BuildSkeleton() {
+  RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  raw_skeleton.roots[0].name = "root";
+  raw_skeleton.roots[0].transform = ozz::math::Transform::identity();
+  raw_skeleton.roots[0].transform.translation = ozz::math::Float3(10.f, 0.f, 5.f);
+
+  SkeletonBuilder builder;
+  return builder(raw_skeleton);
+}
+}  // namespace
+
+TEST(Error, MotionExtractor) {
+  MotionExtractor extractor;
+  ozz::unique_ptr<Skeleton> skeleton(BuildSkeleton());
+  ASSERT_TRUE(skeleton);
+
+  RawAnimation input;
+  input.tracks.resize(1);
+  RawFloat3Track motion_position;
+  RawQuaternionTrack motion_rotation;
+  RawAnimation output;
+
+  {  // nullptr outputs.
+    EXPECT_FALSE(
+        extractor(input, *skeleton, nullptr, &motion_rotation, &output));
+    EXPECT_FALSE(
+        extractor(input, *skeleton, &motion_position, nullptr, &output));
+    EXPECT_FALSE(extractor(input, *skeleton, &motion_position,
+                           &motion_rotation, nullptr));
+  }
+
+  {  // Invalid animation.
+    RawAnimation invalid = input;
+    invalid.duration = -1.f;
+    EXPECT_FALSE(extractor(invalid, *skeleton, &motion_position,
+                           &motion_rotation, &output));
+  }
+
+  {  // Root joint out of animation range.
+    extractor.root_joint = 1;
+    EXPECT_FALSE(extractor(input, *skeleton, &motion_position,
+                           &motion_rotation, &output));
+    extractor.root_joint = -1;
+    EXPECT_FALSE(extractor(input, *skeleton, &motion_position,
+                           &motion_rotation, &output));
+    extractor.root_joint = 0;
+  }
+
+  {  // Root joint out of skeleton range.
+    RawAnimation big = input;
+    big.tracks.resize(2);
+    extractor.root_joint = 1;
+    EXPECT_FALSE(
+        extractor(big, *skeleton, &motion_position, &motion_rotation, &output));
+    extractor.root_joint = 0;
+  }
+
+  {  // Valid.
+    EXPECT_TRUE(extractor(input, *skeleton, &motion_position, &motion_rotation,
+                          &output));
+  }
+}
+
+TEST(Position, MotionExtractor) {
+  MotionExtractor extractor;
+  ozz::unique_ptr<Skeleton> skeleton(BuildSkeleton());
+  ASSERT_TRUE(skeleton);
+
+  RawAnimation input;
+  input.duration = 2.f;
+  input.tracks.resize(1);
+  const RawAnimation::TranslationKey keys[] = {
+      {0.f, ozz::math::Float3(1.f, 2.f, 3.f)},
+      {1.f, ozz::math::Float3(3.f, 4.f, 9.f)}};
+  input.tracks[0].translations.assign(keys, keys + 2);
+
+  RawFloat3Track motion_position;
+  RawQuaternionTrack motion_rotation;
+  RawAnimation output;
+
+  {  // Absolute reference, x and z components (default).
+    extractor.position_settings = {true, false, true,
+                                   MotionExtractor::Reference::kAbsolute};
+    ASSERT_TRUE(extractor(input, *skeleton, &motion_position, &motion_rotation,
+                          &output));
+
+    ASSERT_EQ(motion_position.keyframes.size(), 2u);
+    EXPECT_FLOAT_EQ(motion_position.keyframes[0].ratio, 0.f);
+    EXPECT_FLOAT3_EQ(motion_position.keyframes[0].value, 1.f, 0.f, 3.f);
+    EXPECT_FLOAT_EQ(motion_position.keyframes[1].ratio, .5f);
+    EXPECT_FLOAT3_EQ(motion_position.keyframes[1].value, 3.f, 0.f, 9.f);
+
+    // Extracted components are removed from the output root track.
+    ASSERT_EQ(output.tracks[0].translations.size(), 2u);
+    EXPECT_FLOAT3_EQ(output.tracks[0].translations[0].value, 0.f, 2.f, 0.f);
+    EXPECT_FLOAT3_EQ(output.tracks[0].translations[1].value, 0.f, 4.f, 0.f);
+  }
+
+  {  // Skeleton rest pose reference, x component only.
+    extractor.position_settings = {true, false, false,
+                                   MotionExtractor::Reference::kSkeleton};
+    ASSERT_TRUE(extractor(input, *skeleton, &motion_position, &motion_rotation,
+                          &output));
+
+    // Motion is relative to rest pose x translation (10).
+    ASSERT_EQ(motion_position.keyframes.size(), 2u);
+    EXPECT_FLOAT3_EQ(motion_position.keyframes[0].value, -9.f, 0.f, 0.f);
+    EXPECT_FLOAT3_EQ(motion_position.keyframes[1].value, -7.f, 0.f, 0.f);
+    EXPECT_FLOAT3_EQ(output.tracks[0].translations[0].value, 10.f, 2.f, 3.f);
+    EXPECT_FLOAT3_EQ(output.tracks[0].translations[1].value, 10.f, 4.f, 9.f);
+  }
+
+  {  // Animation first frame reference, all components.
+    extractor.position_settings = {true, true, true,
+                                   MotionExtractor::Reference::kAnimation};
+    ASSERT_TRUE(extractor(input, *skeleton, &motion_position, &motion_rotation,
+                          &output));
+
+    // Motion starts at 0 and accumulates the displacement from first frame.
+    ASSERT_EQ(motion_position.keyframes.size(), 2u);
+    EXPECT_FLOAT3_EQ(motion_position.keyframes[0].value, 0.f, 0.f, 0.f);
+    EXPECT_FLOAT3_EQ(motion_position.keyframes[1].value, 2.f, 2.f, 6.f);
+    EXPECT_FLOAT3_EQ(output.tracks[0].translations[0].value, 1.f, 2.f, 3.f);
+    EXPECT_FLOAT3_EQ(output.tracks[0].translations[1].value, 1.f, 2.f, 3.f);
+  }
+
+  {  // In-place extraction.
+    extractor.position_settings = {true, false, true,
+                                   MotionExtractor::Reference::kAbsolute};
+    RawAnimation in_place = input;
+    ASSERT_TRUE(extractor(in_place, *skeleton, &motion_position,
+                          &motion_rotation, &in_place));
+    EXPECT_FLOAT3_EQ(in_place.tracks[0].translations[0].value, 0.f, 2.f, 0.f);
+    EXPECT_FLOAT3_EQ(in_place.tracks[0].translations[1].value, 0.f, 4.f, 0.f);
+  }
+
+  {  // Empty root track extracts no motion.
+    RawAnimation empty;
+    empty.tracks.resize(1);
+    ASSERT_TRUE(extractor(empty, *skeleton, &motion_position, &motion_rotation,
+                          &output));
+    ASSERT_EQ(motion_position.keyframes.size(), 1u);
+    EXPECT_FLOAT3_EQ(motion_position.keyframes[0].value, 0.f, 0.f, 0.f);
+    EXPECT_TRUE(output.tracks[0].translations.empty());
+  }
+}
+
+TEST(Rotation, MotionExtractor) {
+  MotionExtractor extractor;
+  ozz::unique_ptr<Skeleton> skeleton(BuildSkeleton());
+  ASSERT_TRUE(skeleton);
+
+  // Rotation keys combine a yaw (y axis) and a pitch (x axis) rotation. Yaw
+  // is the motion to extract, pitch must remain in the animation.
+  const ozz::math::Quaternion yaw = ozz::math::Quaternion::FromAxisAngle(
+      ozz::math::Float3::y_axis(), ozz::math::kPi_2);
+  const ozz::math::Quaternion pitch = ozz::math::Quaternion::FromAxisAngle(
+      ozz::math::Float3::x_axis(), .3f);
+
+  RawAnimation input;
+  input.duration = 1.f;
+  input.tracks.resize(1);
+  const RawAnimation::RotationKey keys[] = {
+      {0.f, pitch}, {1.f, yaw * pitch}};
+  input.tracks[0].rotations.assign(keys, keys + 2);
+
+  RawFloat3Track motion_position;
+  RawQuaternionTrack motion_rotation;
+  RawAnimation output;
+
+  {  // Absolute reference, twist around y axis (default).
+    extractor.rotation_settings = {false, true, false,
+                                   MotionExtractor::Reference::kAbsolute};
+    ASSERT_TRUE(extractor(input, *skeleton, &motion_position, &motion_rotation,
+                          &output));
+
+    // First key has no yaw, second is the pi/2 yaw.
+    ASSERT_EQ(motion_rotation.keyframes.size(), 2u);
+    EXPECT_QUATERNION_EQ(motion_rotation.keyframes[0].value, 0.f, 0.f, 0.f,
+                         1.f);
+    EXPECT_QUATERNION_EQ(motion_rotation.keyframes[1].value, 0.f, .70710677f,
+                         0.f, .70710677f);
+
+    // The pitch remains in the output root track.
+    ASSERT_EQ(output.tracks[0].rotations.size(), 2u);
+    EXPECT_QUATERNION_EQ(output.tracks[0].rotations[0].value, pitch.x, pitch.y,
+                         pitch.z, pitch.w);
+    EXPECT_QUATERNION_EQ(output.tracks[0].rotations[1].value, pitch.x, pitch.y,
+                         pitch.z, pitch.w);
+
+    // Motion * remainder reconstructs the original rotation.
+    for (size_t i = 0; i < 2; ++i) {
+      const ozz::math::Quaternion back = motion_rotation.keyframes[i].value *
+                                         output.tracks[0].rotations[i].value;
+      EXPECT_QUATERNION_EQ(back, keys[i].value.x, keys[i].value.y,
+                           keys[i].value.z, keys[i].value.w);
+    }
+  }
+
+  {  // Animation first frame reference.
+    extractor.rotation_settings = {false, true, false,
+                                   MotionExtractor::Reference::kAnimation};
+    ASSERT_TRUE(extractor(input, *skeleton, &motion_position, &motion_rotation,
+                          &output));
+
+    // First frame has no yaw, so reference is identity and motion matches the
+    // absolute case.
+    ASSERT_EQ(motion_rotation.keyframes.size(), 2u);
+    EXPECT_QUATERNION_EQ(motion_rotation.keyframes[0].value, 0.f, 0.f, 0.f,
+                         1.f);
+    EXPECT_QUATERNION_EQ(motion_rotation.keyframes[1].value, 0.f, .70710677f,
+                         0.f, .70710677f);
+  }
+
+  {  // No axis selected extracts no rotation.
+    extractor.rotation_settings = {false, false, false,
+                                   MotionExtractor::Reference::kAbsolute};
+    ASSERT_TRUE(extractor(input, *skeleton, &motion_position, &motion_rotation,
+                          &output));
+    ASSERT_EQ(motion_rotation.keyframes.size(), 1u);
+    EXPECT_QUATERNION_EQ(motion_rotation.keyframes[0].value, 0.f, 0.f, 0.f,
+                         1.f);
+    ASSERT_EQ(output.tracks[0].rotations.size(), 2u);
+    EXPECT_QUATERNION_EQ(output.tracks[0].rotations[1].value,
+                         keys[1].value.x, keys[1].value.y, keys[1].value.z,
+                         keys[1].value.w);
+  }
+}
@@ -0,0 +1,218 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/offline/paged_animation_builder.h"
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/animation/runtime/paged_animation.h"
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/base/io/archive.h"
+#include "ozz/base/io/stream.h"
+#include "ozz/base/maths/gtest_math_helper.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+using ozz::animation::Animation;
+using ozz::animation::PagedAnimation;
+using ozz::animation::PagedSamplingJob;
+using ozz::animation::SamplingJob;
+using ozz::animation::offline::AnimationBuilder;
+using ozz::animation::offline::PagedAnimationBuilder;
+using ozz::animation::offline::RawAnimation;
+
+namespace {
+
+// Builds a 3.5s clip with keyframes spread over the whole duration.
+RawAnimation BuildLongRawAnimation() {
+  RawAnimation raw_animation;
+  raw_animation.duration = 3.5f;
+  raw_animation.tracks.resize(1);
+  for (int i = 0; i <= 35; ++i) {
+    const float time = i * .1f;
+    const RawAnimation::TranslationKey t_key = {
+        time, ozz::math::Float3(time * 2.f, 46.f, -time)};
+    raw_animation.tracks[0].translations.push_back(t_key);
+  }
+  const RawAnimation::RotationKey r_key0 = {
+      0.f, ozz::math::Quaternion::identity()};
+  raw_animation.tracks[0].rotations.push_back(r_key0);
+  const RawAnimation::RotationKey r_key1 = {
+      3.5f, ozz::math::Quaternion::FromAxisAngle(ozz::math::Float3::y_axis(),
+                                                 ozz::math::kPi_2)};
+  raw_animation.tracks[0].rotations.push_back(r_key1);
+  return raw_animation;
+}
+}  // namespace
+
+TEST(Error, PagedAnimationBuilder) {
+  PagedAnimationBuilder builder;
+
+  {  // Building an invalid animation fails.
+    RawAnimation raw_animation;
+    raw_animation.duration = -1.f;  // Invalid duration.
+    EXPECT_FALSE(builder(raw_animation));
+  }
+
+  {  // Building with a non positive page duration fails.
+    RawAnimation raw_animation;
+    raw_animation.duration = 1.f;
+    raw_animation.tracks.resize(1);
+    builder.page_duration = 0.f;
+    EXPECT_FALSE(builder(raw_animation));
+    builder.page_duration = -1.f;
+    EXPECT_FALSE(builder(raw_animation));
+  }
+}
+
+TEST(Build, PagedAnimationBuilder) {
+  const RawAnimation raw_animation = BuildLongRawAnimation();
+
+  PagedAnimationBuilder builder;
+  builder.page_duration = 1.f;
+  ozz::unique_ptr<PagedAnimation> paged = builder(raw_animation);
+  ASSERT_TRUE(paged);
+
+  // 3.5s at 1s per page gives 4 pages, the last one covering the remainder.
+  EXPECT_EQ(paged->num_pages(), 4u);
+  EXPECT_FLOAT_EQ(paged->duration(), 3.5f);
+  EXPECT_FLOAT_EQ(paged->page_duration(), 1.f);
+  EXPECT_EQ(paged->num_tracks(), 1);
+  EXPECT_FLOAT_EQ(paged->page(0).duration(), 1.f);
+  EXPECT_FLOAT_EQ(paged->page(3).duration(), .5f);
+
+  {  // Remap turns a clip ratio into a page lookup and an in-page ratio.
+    const PagedAnimation::PagedRatio begin = paged->Remap(0.f);
+    EXPECT_EQ(begin.page, 0u);
+    EXPECT_FLOAT_EQ(begin.ratio, 0.f);
+
+    // 2.5s is the beginning of the 3rd page.
+    const PagedAnimation::PagedRatio mid = paged->Remap(2.5f / 3.5f);
+    EXPECT_EQ(mid.page, 2u);
+    EXPECT_NEAR(mid.ratio, .5f, 1e-6f);
+
+    const PagedAnimation::PagedRatio end = paged->Remap(1.f);
+    EXPECT_EQ(end.page, 3u);
+    EXPECT_FLOAT_EQ(end.ratio, 1.f);
+
+    // Out of range ratios are clamped.
+    EXPECT_EQ(paged->Remap(-1.f).page, 0u);
+    EXPECT_EQ(paged->Remap(46.f).page, 3u);
+  }
+}
+
+TEST(Sample, PagedAnimationBuilder) {
+  const RawAnimation raw_animation = BuildLongRawAnimation();
+
+  // Builds both the paged and the flat versions of the same clip.
+  PagedAnimationBuilder paged_builder;
+  paged_builder.page_duration = 1.f;
+  ozz::unique_ptr<PagedAnimation> paged = paged_builder(raw_animation);
+  ASSERT_TRUE(paged);
+
+  AnimationBuilder builder;
+  ozz::unique_ptr<Animation> flat = builder(raw_animation);
+  ASSERT_TRUE(flat);
+
+  SamplingJob::Context paged_context(1);
+  SamplingJob::Context flat_context(1);
+
+  // Samples both versions across the clip, page transitions included, and
+  // expects the same poses.
+  for (int i = 0; i <= 100; ++i) {
+    const float ratio = i / 100.f;
+
+    ozz::math::SoaTransform paged_output[1];
+    PagedSamplingJob paged_job;
+    paged_job.ratio = ratio;
+    paged_job.animation = paged.get();
+    paged_job.context = &paged_context;
+    paged_job.output = paged_output;
+    ASSERT_TRUE(paged_job.Run());
+
+    ozz::math::SoaTransform flat_output[1];
+    SamplingJob flat_job;
+    flat_job.ratio = ratio;
+    flat_job.animation = flat.get();
+    flat_job.context = &flat_context;
+    flat_job.output = flat_output;
+    ASSERT_TRUE(flat_job.Run());
+
+    // Compares transforms as scalars, as pages requantize boundary keys.
+    float paged_floats[40];
+    float flat_floats[40];
+    static_assert(sizeof(paged_output) == sizeof(paged_floats),
+                  "Unexpected SoaTransform size");
+    std::memcpy(paged_floats, paged_output, sizeof(paged_floats));
+    std::memcpy(flat_floats, flat_output, sizeof(flat_floats));
+    for (size_t j = 0; j < 40; ++j) {
+      EXPECT_NEAR(paged_floats[j], flat_floats[j], 1e-2f) << "ratio " << ratio;
+    }
+  }
+}
+
+TEST(Serialize, PagedAnimationBuilder) {
+  const RawAnimation raw_animation = BuildLongRawAnimation();
+
+  PagedAnimationBuilder builder;
+  builder.page_duration = 1.f;
+  ozz::unique_ptr<PagedAnimation> o_paged = builder(raw_animation);
+  ASSERT_TRUE(o_paged);
+
+  // Streams out.
+  ozz::io::MemoryStream stream;
+  ozz::io::OArchive o(&stream, ozz::GetNativeEndianness());
+  o << *o_paged;
+
+  // Streams in.
+  stream.Seek(0, ozz::io::Stream::kSet);
+  ozz::io::IArchive i(&stream);
+  PagedAnimation i_paged;
+  i >> i_paged;
+
+  EXPECT_FLOAT_EQ(i_paged.duration(), o_paged->duration());
+  EXPECT_FLOAT_EQ(i_paged.page_duration(), o_paged->page_duration());
+  EXPECT_EQ(i_paged.num_tracks(), o_paged->num_tracks());
+  ASSERT_EQ(i_paged.num_pages(), o_paged->num_pages());
+  for (size_t p = 0; p < i_paged.num_pages(); ++p) {
+    EXPECT_FLOAT_EQ(i_paged.page(p).duration(), o_paged->page(p).duration());
+    EXPECT_EQ(i_paged.page(p).num_tracks(), o_paged->page(p).num_tracks());
+  }
+
+  // The deserialized copy samples identically.
+  SamplingJob::Context context(1);
+  ozz::math::SoaTransform output[1];
+  PagedSamplingJob job;
+  job.ratio = .46f;
+  job.animation = &i_paged;
+  job.context = &context;
+  job.output = output;
+  EXPECT_TRUE(job.Run());
+}
@@ -0,0 +1,212 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/offline/pose_database_builder.h"
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/offline/raw_skeleton.h"
+#include "ozz/animation/offline/skeleton_builder.h"
+#include "ozz/animation/runtime/pose_database.h"
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/io/archive.h"
+#include "ozz/base/io/stream.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+using ozz::animation::PoseDatabase;
+using ozz::animation::Skeleton;
+using ozz::animation::offline::PoseDatabaseBuilder;
+using ozz::animation::offline::RawAnimation;
+using ozz::animation::offline::RawSkeleton;
+using ozz::animation::offline::SkeletonBuilder;
+
+namespace {
+
+// Builds a 2 joints chain: a root and a "foot" offset 1 unit along y.
+ozz::unique_ptr<Skeleton> BuildTestSkeleton() {
+  RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  RawSkeleton::Joint& root = raw_skeleton.roots[0];
+  root.name = "root";
+  root.children.resize(1);
+  root.children[0].name = "foot";
+  root.children[0].transform.translation = ozz::math::Float3::y_axis();
+
+  SkeletonBuilder builder;
+  return builder(raw_skeleton);
+}
+
+// Builds a 1s clip whose root translates along _direction, from zero to
+// _direction, at constant speed.
+RawAnimation BuildMovingRawAnimation(const ozz::math::Float3& _direction) {
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(2);
+  const RawAnimation::TranslationKey key0 = {0.f, ozz::math::Float3::zero()};
+  raw_animation.tracks[0].translations.push_back(key0);
+  const RawAnimation::TranslationKey key1 = {1.f, _direction};
+  raw_animation.tracks[0].translations.push_back(key1);
+  const RawAnimation::TranslationKey foot_key = {0.f,
+                                                 ozz::math::Float3::y_axis()};
+  raw_animation.tracks[1].translations.push_back(foot_key);
+  return raw_animation;
+}
+}  // namespace
+
+TEST(Error, PoseDatabaseBuilder) {
+  ozz::unique_ptr<Skeleton> skeleton = BuildTestSkeleton();
+  ASSERT_TRUE(skeleton);
+  const RawAnimation raw_animation =
+      BuildMovingRawAnimation(ozz::math::Float3::x_axis());
+  const RawAnimation* animations[] = {&raw_animation};
+
+  {  // Empty animation set fails.
+    PoseDatabaseBuilder builder;
+    builder.joints.push_back(1);
+    EXPECT_FALSE(builder(*skeleton, {}));
+  }
+
+  {  // No tracked joints fails.
+    PoseDatabaseBuilder builder;
+    EXPECT_FALSE(builder(*skeleton, animations));
+  }
+
+  {  // Out of range tracked joint fails.
+    PoseDatabaseBuilder builder;
+    builder.joints.push_back(2);
+    EXPECT_FALSE(builder(*skeleton, animations));
+  }
+
+  {  // Non positive sample rate fails.
+    PoseDatabaseBuilder builder;
+    builder.joints.push_back(1);
+    builder.sample_rate = 0.f;
+    EXPECT_FALSE(builder(*skeleton, animations));
+  }
+
+  {  // Mismatching track count fails.
+    RawAnimation mismatched;
+    mismatched.duration = 1.f;
+    mismatched.tracks.resize(1);
+    const RawAnimation* mismatched_set[] = {&mismatched};
+    PoseDatabaseBuilder builder;
+    builder.joints.push_back(1);
+    EXPECT_FALSE(builder(*skeleton, mismatched_set));
+  }
+}
+
+TEST(Query, PoseDatabaseBuilder) {
+  ozz::unique_ptr<Skeleton> skeleton = BuildTestSkeleton();
+  ASSERT_TRUE(skeleton);
+
+  // 2 clips moving the foot along different axes, so their features don't
+  // overlap.
+  const RawAnimation walk_x =
+      BuildMovingRawAnimation(ozz::math::Float3::x_axis());
+  const RawAnimation walk_z =
+      BuildMovingRawAnimation(ozz::math::Float3::z_axis());
+  const RawAnimation* animations[] = {&walk_x, &walk_z};
+
+  PoseDatabaseBuilder builder;
+  builder.sample_rate = 10.f;
+  builder.joints.push_back(1);  // Foot.
+  ozz::unique_ptr<PoseDatabase> database = builder(*skeleton, animations);
+  ASSERT_TRUE(database);
+
+  // 6 features (foot position and velocity), 11 frames per 1s clip at 10Hz.
+  EXPECT_EQ(database->num_features(), 6);
+  EXPECT_EQ(database->num_entries(), 22);
+
+  {  // Query size must match features.
+    const float query[3] = {};
+    PoseDatabase::Match match;
+    EXPECT_FALSE(database->Nearest(query, &match));
+  }
+
+  {  // The foot of walk_x at half the clip is at (.5, 1, 0), moving along x.
+    const float query[6] = {.5f, 1.f, 0.f, 1.f, 0.f, 0.f};
+    PoseDatabase::Match match;
+    ASSERT_TRUE(database->Nearest(query, &match));
+    EXPECT_EQ(match.animation, 0);
+    EXPECT_FLOAT_EQ(match.ratio, .5f);
+    EXPECT_NEAR(match.distance_sq, 0.f, 1e-10f);
+  }
+
+  {  // Same position along z matches walk_z instead.
+    const float query[6] = {0.f, 1.f, .8f, 0.f, 0.f, 1.f};
+    PoseDatabase::Match match;
+    ASSERT_TRUE(database->Nearest(query, &match));
+    EXPECT_EQ(match.animation, 1);
+    EXPECT_FLOAT_EQ(match.ratio, .8f);
+  }
+
+  {  // A pose between two frames matches the closest frame.
+    const float query[6] = {.68f, 1.f, 0.f, 1.f, 0.f, 0.f};
+    PoseDatabase::Match match;
+    ASSERT_TRUE(database->Nearest(query, &match));
+    EXPECT_EQ(match.animation, 0);
+    EXPECT_FLOAT_EQ(match.ratio, .7f);
+  }
+}
+
+TEST(Serialize, PoseDatabaseBuilder) {
+  ozz::unique_ptr<Skeleton> skeleton = BuildTestSkeleton();
+  ASSERT_TRUE(skeleton);
+  const RawAnimation walk_x =
+      BuildMovingRawAnimation(ozz::math::Float3::x_axis());
+  const RawAnimation* animations[] = {&walk_x};
+
+  PoseDatabaseBuilder builder;
+  builder.sample_rate = 10.f;
+  builder.joints.push_back(1);
+  ozz::unique_ptr<PoseDatabase> o_database = builder(*skeleton, animations);
+  ASSERT_TRUE(o_database);
+
+  // Streams out.
+  ozz::io::MemoryStream stream;
+  ozz::io::OArchive o(&stream, ozz::GetNativeEndianness());
+  o << *o_database;
+
+  // Streams in.
+  stream.Seek(0, ozz::io::Stream::kSet);
+  ozz::io::IArchive i(&stream);
+  PoseDatabase i_database;
+  i >> i_database;
+
+  EXPECT_EQ(i_database.num_features(), o_database->num_features());
+  EXPECT_EQ(i_database.num_entries(), o_database->num_entries());
+
+  // The deserialized copy matches identically.
+  const float query[6] = {.3f, 1.f, 0.f, 1.f, 0.f, 0.f};
+  PoseDatabase::Match o_match;
+  PoseDatabase::Match i_match;
+  ASSERT_TRUE(o_database->Nearest(query, &o_match));
+  ASSERT_TRUE(i_database.Nearest(query, &i_match));
+  EXPECT_EQ(i_match.animation, o_match.animation);
+  EXPECT_FLOAT_EQ(i_match.ratio, o_match.ratio);
+  EXPECT_FLOAT_EQ(i_match.distance_sq, o_match.distance_sq);
+}
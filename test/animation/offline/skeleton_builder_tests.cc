@@ -30,6 +30,7 @@
 #include "gtest/gtest.h"
 #include "ozz/animation/offline/raw_skeleton.h"
 #include "ozz/animation/offline/skeleton_builder.h"
+#include "ozz/animation/runtime/local_to_model_job.h"
 #include "ozz/animation/runtime/skeleton.h"
 #include "ozz/base/maths/gtest_math_helper.h"
 #include "ozz/base/maths/simd_math.h"
@@ -548,6 +549,135 @@ TEST(JointOrder, SkeletonBuilder) {
   EXPECT_STREQ(skeleton->joint_names()[6], "j6");
 }
 
+TEST(SubtreeRanges, SkeletonBuilder) {
+  // Instantiates a builder objects with default parameters.
+  SkeletonBuilder builder;
+
+  /*
+   8 joints, same raw skeleton as the JointOrder test.
+
+        *
+        |
+        j0
+     /  |  \
+   j1   j3  j7
+    |  / \
+   j2 j4 j5
+         |
+         j6
+  */
+  RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  RawSkeleton::Joint& root = raw_skeleton.roots[0];
+  root.name = "j0";
+
+  root.children.resize(3);
+  root.children[0].name = "j1";
+  root.children[1].name = "j3";
+  root.children[2].name = "j7";
+
+  root.children[0].children.resize(1);
+  root.children[0].children[0].name = "j2";
+
+  root.children[1].children.resize(2);
+  root.children[1].children[0].name = "j4";
+  root.children[1].children[1].name = "j5";
+
+  root.children[1].children[1].children.resize(1);
+  root.children[1].children[1].children[0].name = "j6";
+
+  ozz::unique_ptr<Skeleton> skeleton(builder(raw_skeleton));
+  ASSERT_TRUE(skeleton);
+  ASSERT_EQ(skeleton->num_joints(), 8);
+
+  // Joints are stored in depth-first order (j0 j1 j2 j3 j4 j5 j6 j7), so the
+  // subtree rooted at joint i is the contiguous range
+  // [i, joint_subtree_ends()[i]).
+  const int16_t expected_ends[] = {8, 3, 3, 7, 5, 7, 7, 8};
+  const int16_t expected_depths[] = {0, 1, 2, 1, 2, 2, 3, 1};
+  ASSERT_EQ(skeleton->joint_subtree_ends().size(),
+            OZZ_ARRAY_SIZE(expected_ends));
+  ASSERT_EQ(skeleton->joint_depths().size(), OZZ_ARRAY_SIZE(expected_depths));
+  for (size_t i = 0; i < OZZ_ARRAY_SIZE(expected_ends); ++i) {
+    EXPECT_EQ(skeleton->joint_subtree_ends()[i], expected_ends[i]);
+    EXPECT_EQ(skeleton->joint_depths()[i], expected_depths[i]);
+  }
+
+  // Leaf joints subtrees are single element ranges.
+  EXPECT_EQ(skeleton->joint_subtree_ends()[2], 3);
+  EXPECT_EQ(skeleton->joint_subtree_ends()[7], 8);
+}
+
+TEST(MinimizeParentDistance, SkeletonBuilder) {
+  // Instantiates a builder with the reordering optimization enabled.
+  SkeletonBuilder builder;
+  builder.minimize_parent_distance = true;
+
+  /*
+   8 joints, same raw skeleton as the JointOrder test.
+
+        *
+        |
+        j0
+     /  |  \
+   j1   j3  j7
+    |  / \
+   j2 j4 j5
+         |
+         j6
+  */
+  RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  RawSkeleton::Joint& root = raw_skeleton.roots[0];
+  root.name = "j0";
+
+  root.children.resize(3);
+  root.children[0].name = "j1";
+  root.children[1].name = "j3";
+  root.children[2].name = "j7";
+
+  root.children[0].children.resize(1);
+  root.children[0].children[0].name = "j2";
+
+  root.children[1].children.resize(2);
+  root.children[1].children[0].name = "j4";
+  root.children[1].children[1].name = "j5";
+
+  root.children[1].children[1].children.resize(1);
+  root.children[1].children[1].children[0].name = "j6";
+
+  EXPECT_TRUE(raw_skeleton.Validate());
+  EXPECT_EQ(raw_skeleton.num_joints(), 8);
+
+  ozz::unique_ptr<Skeleton> skeleton(builder(raw_skeleton));
+  ASSERT_TRUE(skeleton);
+  EXPECT_EQ(skeleton->num_joints(), 8);
+
+  // Sibling sub-hierarchies are visited from the smallest to the biggest:
+  // j7 (1 joint), then j1 (2 joints), then j3 (4 joints).
+  EXPECT_EQ(skeleton->joint_parents()[0], Skeleton::kNoParent);
+  EXPECT_STREQ(skeleton->joint_names()[0], "j0");
+  EXPECT_EQ(skeleton->joint_parents()[1], 0);
+  EXPECT_STREQ(skeleton->joint_names()[1], "j7");
+  EXPECT_EQ(skeleton->joint_parents()[2], 0);
+  EXPECT_STREQ(skeleton->joint_names()[2], "j1");
+  EXPECT_EQ(skeleton->joint_parents()[3], 2);
+  EXPECT_STREQ(skeleton->joint_names()[3], "j2");
+  EXPECT_EQ(skeleton->joint_parents()[4], 0);
+  EXPECT_STREQ(skeleton->joint_names()[4], "j3");
+  EXPECT_EQ(skeleton->joint_parents()[5], 4);
+  EXPECT_STREQ(skeleton->joint_names()[5], "j4");
+  EXPECT_EQ(skeleton->joint_parents()[6], 4);
+  EXPECT_STREQ(skeleton->joint_names()[6], "j5");
+  EXPECT_EQ(skeleton->joint_parents()[7], 6);
+  EXPECT_STREQ(skeleton->joint_names()[7], "j6");
+
+  // Output remains depth-first ordered: parents always come before children.
+  for (int i = 1; i < skeleton->num_joints(); ++i) {
+    EXPECT_LT(skeleton->joint_parents()[i], i);
+  }
+}
+
 TEST(MultiRoots, SkeletonBuilder) {
   // Instantiates a builder objects with default parameters.
   SkeletonBuilder builder;
@@ -679,6 +809,74 @@ TEST(RestPose, SkeletonBuilder) {
   EXPECT_SIMDFLOAT_EQ(scales[3], 1.f, 1.f, 1.f, 0.f);
 }
 
+TEST(BindPose, SkeletonBuilder) {
+  using ozz::math::Float3;
+  using ozz::math::Quaternion;
+  using ozz::math::Transform;
+
+  // Instantiates a builder objects with default parameters.
+  SkeletonBuilder builder;
+
+  /*
+   3 joints
+
+     *
+     |
+    j0
+    / \
+   j1 j2
+  */
+
+  RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  RawSkeleton::Joint& root = raw_skeleton.roots[0];
+  root.name = "j0";
+  root.transform = Transform::identity();
+  root.transform.translation = Float3(1.f, 2.f, 3.f);
+
+  root.children.resize(2);
+  root.children[0].name = "j1";
+  root.children[0].transform = Transform::identity();
+  root.children[0].transform.rotation = Quaternion(0.f, 1.f, 0.f, 0.f);
+  root.children[0].transform.translation = Float3(4.f, 5.f, 6.f);
+  root.children[1].name = "j2";
+  root.children[1].transform = Transform::identity();
+  root.children[1].transform.translation = Float3(7.f, 8.f, 9.f);
+  root.children[1].transform.scale = Float3(2.f, 4.f, 8.f);
+
+  EXPECT_TRUE(raw_skeleton.Validate());
+
+  ozz::unique_ptr<Skeleton> skeleton(builder(raw_skeleton));
+  ASSERT_TRUE(skeleton);
+
+  ASSERT_EQ(skeleton->joint_bind_poses().size(),
+            static_cast<size_t>(skeleton->num_joints()));
+  ASSERT_EQ(skeleton->joint_inverse_bind_poses().size(),
+            static_cast<size_t>(skeleton->num_joints()));
+
+  // Bind pose matrices match a local-to-model conversion of the rest pose,
+  // which is what consumers used to compute at load time.
+  ozz::math::Float4x4 models[3];
+  ozz::animation::LocalToModelJob job;
+  job.skeleton = skeleton.get();
+  job.input = skeleton->joint_rest_poses();
+  job.output = models;
+  ASSERT_TRUE(job.Run());
+
+  for (int i = 0; i < skeleton->num_joints(); ++i) {
+    const ozz::math::Float4x4& bind = skeleton->joint_bind_poses()[i];
+    EXPECT_TRUE(std::memcmp(&bind, &models[i], sizeof(bind)) == 0);
+
+    // Inverse bind pose times bind pose is identity.
+    const ozz::math::Float4x4 identity =
+        skeleton->joint_inverse_bind_poses()[i] * bind;
+    EXPECT_SIMDFLOAT_EQ_EST(identity.cols[0], 1.f, 0.f, 0.f, 0.f);
+    EXPECT_SIMDFLOAT_EQ_EST(identity.cols[1], 0.f, 1.f, 0.f, 0.f);
+    EXPECT_SIMDFLOAT_EQ_EST(identity.cols[2], 0.f, 0.f, 1.f, 0.f);
+    EXPECT_SIMDFLOAT_EQ_EST(identity.cols[3], 0.f, 0.f, 0.f, 1.f);
+  }
+}
+
 TEST(MaxJoints, SkeletonBuilder) {
   // Instantiates a builder objects with default parameters.
   SkeletonBuilder builder;
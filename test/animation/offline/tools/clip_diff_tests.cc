@@ -0,0 +1,153 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "animation/offline/tools/clip_diff.h"
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/animation_builder.h"
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/base/io/stream.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+using ozz::animation::Animation;
+using ozz::animation::offline::AnimationBuilder;
+using ozz::animation::offline::ClipDiff;
+using ozz::animation::offline::DiffBuiltClips;
+using ozz::animation::offline::DiffClips;
+using ozz::animation::offline::HashClip;
+using ozz::animation::offline::HashJointTrack;
+using ozz::animation::offline::MatchesFileContent;
+using ozz::animation::offline::RawAnimation;
+
+namespace {
+// Builds a 2 tracks clip with a recognizable translation key.
+RawAnimation BuildClip(float _duration, float _x) {
+  RawAnimation raw;
+  raw.name = "clip";
+  raw.duration = _duration;
+  raw.tracks.resize(2);
+  const RawAnimation::TranslationKey key = {0.f,
+                                            ozz::math::Float3(_x, 0.f, 0.f)};
+  raw.tracks[1].translations.push_back(key);
+  return raw;
+}
+}  // namespace
+
+TEST(Hashes, ClipDiff) {
+  const RawAnimation a = BuildClip(1.f, 4.f);
+  const RawAnimation b = BuildClip(1.f, 4.f);
+  const RawAnimation c = BuildClip(1.f, 6.f);
+
+  // Hashes are deterministic and content driven.
+  EXPECT_EQ(HashClip(a), HashClip(b));
+  EXPECT_NE(HashClip(a), HashClip(c));
+  EXPECT_EQ(HashJointTrack(a.tracks[0]), HashJointTrack(c.tracks[0]));
+  EXPECT_NE(HashJointTrack(a.tracks[1]), HashJointTrack(c.tracks[1]));
+}
+
+TEST(Diff, ClipDiff) {
+  const RawAnimation a = BuildClip(1.f, 4.f);
+
+  {  // Identical clips.
+    const ClipDiff diff = DiffClips(a, a);
+    EXPECT_FALSE(diff.Changed());
+    EXPECT_TRUE(diff.modified_tracks.empty());
+  }
+
+  {  // Modified track is reported.
+    const ClipDiff diff = DiffClips(a, BuildClip(1.f, 6.f));
+    EXPECT_TRUE(diff.Changed());
+    ASSERT_EQ(diff.modified_tracks.size(), 1u);
+    EXPECT_EQ(diff.modified_tracks[0], 1);
+    EXPECT_FALSE(diff.duration_changed);
+    EXPECT_FALSE(diff.name_changed);
+  }
+
+  {  // Duration and structure changes are reported.
+    RawAnimation b = BuildClip(2.f, 4.f);
+    b.name = "other";
+    b.tracks.resize(3);
+    const ClipDiff diff = DiffClips(a, b);
+    EXPECT_TRUE(diff.Changed());
+    EXPECT_TRUE(diff.duration_changed);
+    EXPECT_TRUE(diff.name_changed);
+    EXPECT_EQ(diff.num_tracks[0], 2);
+    EXPECT_EQ(diff.num_tracks[1], 3);
+  }
+}
+
+TEST(DiffBuilt, ClipDiff) {
+  AnimationBuilder builder;
+  const ozz::unique_ptr<Animation> a = builder(BuildClip(1.f, 4.f));
+  const ozz::unique_ptr<Animation> b = builder(BuildClip(1.f, 4.1f));
+  const ozz::unique_ptr<Animation> c = builder(BuildClip(2.f, 4.f));
+  ASSERT_TRUE(a && b && c);
+
+  float max_error = -1.f;
+
+  // Identical clips sample identically.
+  EXPECT_TRUE(DiffBuiltClips(*a, *a, 11, &max_error));
+  EXPECT_FLOAT_EQ(max_error, 0.f);
+
+  // Nearly identical clips report a small sampled error.
+  EXPECT_TRUE(DiffBuiltClips(*a, *b, 11, &max_error));
+  EXPECT_GT(max_error, 5e-2f);
+  EXPECT_LT(max_error, 2e-1f);
+
+  // Metadata mismatch isn't comparable.
+  EXPECT_FALSE(DiffBuiltClips(*a, *c, 11, &max_error));
+
+  // Invalid arguments.
+  EXPECT_FALSE(DiffBuiltClips(*a, *a, 1, &max_error));
+  EXPECT_FALSE(DiffBuiltClips(*a, *a, 11, nullptr));
+}
+
+TEST(MatchesFile, ClipDiff) {
+  const char* filename = "clip_diff_matches_file.bin";
+  const char content[] = "emit if changed content";
+  {
+    ozz::io::File file(filename, "wb");
+    ASSERT_TRUE(file.opened());
+    ASSERT_EQ(file.Write(content, sizeof(content)), sizeof(content));
+  }
+
+  ozz::io::MemoryStream stream;
+  ASSERT_EQ(stream.Write(content, sizeof(content)), sizeof(content));
+
+  // Identical content matches, stream position is restored.
+  stream.Seek(4, ozz::io::Stream::kSet);
+  EXPECT_TRUE(MatchesFileContent(&stream, filename));
+  EXPECT_EQ(stream.Tell(), 4);
+
+  // Different content or missing file doesn't match.
+  const char different = '!';
+  stream.Seek(0, ozz::io::Stream::kSet);
+  ASSERT_EQ(stream.Write(&different, 1), 1u);
+  EXPECT_FALSE(MatchesFileContent(&stream, filename));
+  EXPECT_FALSE(MatchesFileContent(&stream, "doesn_t_exist.bin"));
+}
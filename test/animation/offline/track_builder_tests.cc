@@ -31,7 +31,12 @@
 #include "ozz/animation/offline/raw_track.h"
 #include "ozz/animation/offline/track_builder.h"
 #include "ozz/animation/runtime/track.h"
+#include "ozz/animation/runtime/track_bundle.h"
+#include "ozz/animation/runtime/track_bundle_sampling_job.h"
 #include "ozz/animation/runtime/track_sampling_job.h"
+#include "ozz/animation/runtime/track_soa.h"
+#include "ozz/animation/runtime/track_soa_sampling_job.h"
+#include "ozz/base/containers/vector.h"
 #include "ozz/base/maths/gtest_math_helper.h"
 #include "ozz/base/memory/unique_ptr.h"
 
@@ -40,8 +45,15 @@ using ozz::animation::Float3Track;
 using ozz::animation::Float4Track;
 using ozz::animation::FloatTrack;
 using ozz::animation::FloatTrackSamplingJob;
+using ozz::animation::FloatTrackBundle;
+using ozz::animation::FloatTrackBundleSamplingJob;
+using ozz::animation::FloatTrackSoA;
+using ozz::animation::TrackSoASamplingJob;
 using ozz::animation::QuaternionTrack;
+using ozz::animation::QuaternionTrackBundle;
+using ozz::animation::QuaternionTrackBundleSamplingJob;
 using ozz::animation::offline::RawFloatTrack;
+using ozz::animation::offline::RawQuaternionTrack;
 using ozz::animation::offline::RawTrackInterpolation;
 using ozz::animation::offline::TrackBuilder;
 
@@ -1082,3 +1094,370 @@ TEST(Quaternion, TrackBuilder) {
     EXPECT_QUATERNION_EQ(result, 0.f, .70710677f, 0.f, .70710677f);
   }
 }
+
+TEST(SoA, TrackBuilder) {
+  TrackBuilder builder;
+
+  {  // Building an empty set of tracks fails.
+    EXPECT_TRUE(!builder(ozz::span<const RawFloatTrack>()));
+  }
+
+  {  // Building a set with an invalid track fails.
+    RawFloatTrack raw_tracks[2];
+    const RawFloatTrack::Keyframe invalid_key = {RawTrackInterpolation::kLinear,
+                                                 1.8f, 0.f};
+    raw_tracks[1].keyframes.push_back(invalid_key);
+    EXPECT_TRUE(!builder(ozz::make_span(raw_tracks)));
+  }
+
+  // Builds a set of 6 tracks, so SoA sampling exercises both full simd groups
+  // and remaining tracks: empty, constant, linear, step and mixed tracks with
+  // different keyframe ratios.
+  RawFloatTrack raw_tracks[6];
+  const RawFloatTrack::Keyframe keys[] = {
+      // Track 1, constant.
+      {RawTrackInterpolation::kLinear, .5f, 46.f},
+      // Track 2, linear.
+      {RawTrackInterpolation::kLinear, 0.f, 0.f},
+      {RawTrackInterpolation::kLinear, 1.f, 1.f},
+      // Track 3, step.
+      {RawTrackInterpolation::kStep, .2f, 2.f},
+      {RawTrackInterpolation::kStep, .6f, 6.f},
+      // Track 4, mixed.
+      {RawTrackInterpolation::kLinear, .1f, 1.f},
+      {RawTrackInterpolation::kStep, .5f, 5.f},
+      {RawTrackInterpolation::kLinear, .9f, 9.f},
+      // Track 5, linear with ratios no other track has.
+      {RawTrackInterpolation::kLinear, .3f, -3.f},
+      {RawTrackInterpolation::kLinear, .7f, -7.f}};
+  raw_tracks[1].keyframes.push_back(keys[0]);
+  raw_tracks[2].keyframes.assign(keys + 1, keys + 3);
+  raw_tracks[3].keyframes.assign(keys + 3, keys + 5);
+  raw_tracks[4].keyframes.assign(keys + 5, keys + 8);
+  raw_tracks[5].keyframes.assign(keys + 8, keys + 10);
+
+  ozz::unique_ptr<FloatTrackSoA> tracks(builder(ozz::make_span(raw_tracks)));
+  ASSERT_TRUE(tracks);
+  EXPECT_EQ(tracks->num_tracks(), OZZ_ARRAY_SIZE(raw_tracks));
+  EXPECT_EQ(tracks->ratios().size() * tracks->num_tracks(),
+            tracks->values().size());
+
+  {  // Sampling a null set of tracks is invalid.
+    float results[6];
+    TrackSoASamplingJob job;
+    job.results = results;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+  {  // Sampling with a too small result is invalid.
+    float results[5];
+    TrackSoASamplingJob job;
+    job.tracks = tracks.get();
+    job.results = results;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  // SoA sampling matches every track sampled individually, whatever the
+  // ratio.
+  for (int i = -1; i < 102; ++i) {
+    const float ratio = i / 100.f;
+
+    float results[6];
+    TrackSoASamplingJob job;
+    job.ratio = ratio;
+    job.tracks = tracks.get();
+    job.results = results;
+    ASSERT_TRUE(job.Run());
+
+    for (size_t t = 0; t < OZZ_ARRAY_SIZE(raw_tracks); ++t) {
+      ozz::unique_ptr<FloatTrack> track(builder(raw_tracks[t]));
+      ASSERT_TRUE(track);
+
+      float expected;
+      FloatTrackSamplingJob single_job;
+      single_job.ratio = ratio;
+      single_job.track = track.get();
+      single_job.result = &expected;
+      ASSERT_TRUE(single_job.Run());
+
+      EXPECT_FLOAT_EQ(expected, results[t]);
+    }
+  }
+}
+
+TEST(Bundle, TrackBuilder) {
+  TrackBuilder builder;
+
+  {  // Building an empty set of tracks fails.
+    EXPECT_FALSE(builder.Bundle(ozz::span<const RawFloatTrack>()));
+  }
+
+  {  // Building an invalid track fails.
+    RawFloatTrack raw_tracks[1];
+    const RawFloatTrack::Keyframe key = {RawTrackInterpolation::kLinear, 46.f,
+                                         0.f};
+    raw_tracks[0].keyframes.push_back(key);
+    EXPECT_FALSE(raw_tracks[0].Validate());
+    EXPECT_FALSE(builder.Bundle(ozz::make_span(raw_tracks)));
+  }
+
+  {  // Building tracks with different key counts fails.
+    RawFloatTrack raw_tracks[2];
+    const RawFloatTrack::Keyframe key = {RawTrackInterpolation::kLinear, .5f,
+                                         46.f};
+    raw_tracks[0].keyframes.push_back(key);
+    const RawFloatTrack::Keyframe key2 = {RawTrackInterpolation::kLinear, .7f,
+                                          0.f};
+    raw_tracks[0].keyframes.push_back(key2);
+    raw_tracks[1].keyframes.push_back(key);
+    EXPECT_FALSE(builder.Bundle(ozz::make_span(raw_tracks)));
+  }
+
+  {  // Building tracks with different key ratios fails.
+    RawFloatTrack raw_tracks[2];
+    const RawFloatTrack::Keyframe key = {RawTrackInterpolation::kLinear, .5f,
+                                         46.f};
+    const RawFloatTrack::Keyframe key2 = {RawTrackInterpolation::kLinear, .7f,
+                                          46.f};
+    const RawFloatTrack::Keyframe key3 = {RawTrackInterpolation::kLinear, .6f,
+                                          46.f};
+    raw_tracks[0].keyframes.push_back(key);
+    raw_tracks[0].keyframes.push_back(key2);
+    raw_tracks[1].keyframes.push_back(key);
+    raw_tracks[1].keyframes.push_back(key3);
+    EXPECT_FALSE(builder.Bundle(ozz::make_span(raw_tracks)));
+  }
+
+  {  // Building tracks with different key interpolations fails.
+    RawFloatTrack raw_tracks[2];
+    const RawFloatTrack::Keyframe key = {RawTrackInterpolation::kLinear, 0.f,
+                                         46.f};
+    const RawFloatTrack::Keyframe key2 = {RawTrackInterpolation::kLinear, .5f,
+                                          46.f};
+    const RawFloatTrack::Keyframe key3 = {RawTrackInterpolation::kStep, .5f,
+                                          46.f};
+    raw_tracks[0].keyframes.push_back(key);
+    raw_tracks[0].keyframes.push_back(key2);
+    raw_tracks[1].keyframes.push_back(key);
+    raw_tracks[1].keyframes.push_back(key3);
+    EXPECT_FALSE(builder.Bundle(ozz::make_span(raw_tracks)));
+  }
+
+  {  // Building co-exported tracks succeeds, sampling matches per-track
+     // sampling.
+    RawFloatTrack raw_tracks[3];
+    const float values[3] = {0.f, 46.f, -27.f};
+    for (size_t i = 0; i < 3; ++i) {
+      const RawFloatTrack::Keyframe key0 = {RawTrackInterpolation::kLinear,
+                                            0.f, values[i]};
+      raw_tracks[i].keyframes.push_back(key0);
+      const RawFloatTrack::Keyframe key1 = {RawTrackInterpolation::kStep, .5f,
+                                            values[i] * 2.f};
+      raw_tracks[i].keyframes.push_back(key1);
+      const RawFloatTrack::Keyframe key2 = {RawTrackInterpolation::kLinear,
+                                            .8f, values[i] - 1.f};
+      raw_tracks[i].keyframes.push_back(key2);
+    }
+
+    ozz::unique_ptr<FloatTrackBundle> bundle(
+        builder.Bundle(ozz::make_span(raw_tracks)));
+    ASSERT_TRUE(bundle);
+    EXPECT_EQ(bundle->num_tracks(), 3u);
+
+    // Timeline is stored once, whatever the number of tracks.
+    EXPECT_EQ(bundle->ratios().size(), 4u);  // 3 keys + patched end key.
+    EXPECT_EQ(bundle->values().size(), 12u);
+
+    // Samples the bundle and compares with per-track sampling.
+    float results[3];
+    FloatTrackBundleSamplingJob sampling;
+    sampling.bundle = bundle.get();
+    sampling.results = ozz::make_span(results);
+    for (int i = -1; i < 102; ++i) {
+      sampling.ratio = i * .01f;
+      ASSERT_TRUE(sampling.Run());
+      for (size_t t = 0; t < 3; ++t) {
+        ozz::unique_ptr<FloatTrack> track(builder(raw_tracks[t]));
+        ASSERT_TRUE(track);
+        FloatTrackSamplingJob ref_sampling;
+        ref_sampling.track = track.get();
+        float ref_result;
+        ref_sampling.result = &ref_result;
+        ref_sampling.ratio = sampling.ratio;
+        ASSERT_TRUE(ref_sampling.Run());
+        EXPECT_FLOAT_EQ(results[t], ref_result);
+      }
+    }
+
+    {  // Too small results buffer fails validation.
+      FloatTrackBundleSamplingJob invalid;
+      invalid.bundle = bundle.get();
+      invalid.results = ozz::make_span(results).first(2);
+      EXPECT_FALSE(invalid.Validate());
+      EXPECT_FALSE(invalid.Run());
+    }
+  }
+
+  {  // Quaternion bundles apply the same fixup as single quaternion tracks.
+    RawQuaternionTrack raw_tracks[2];
+    const RawQuaternionTrack::Keyframe key0 = {
+        RawTrackInterpolation::kLinear, 0.f,
+        ozz::math::Quaternion(.70710677f, 0.f, 0.f, .70710677f)};
+    const RawQuaternionTrack::Keyframe key1 = {
+        RawTrackInterpolation::kLinear, 1.f,
+        ozz::math::Quaternion(-.70710677f, 0.f, 0.f, -.70710677f)};
+    raw_tracks[0].keyframes.push_back(key0);
+    raw_tracks[0].keyframes.push_back(key1);
+    const RawQuaternionTrack::Keyframe key2 = {
+        RawTrackInterpolation::kLinear, 0.f,
+        ozz::math::Quaternion(0.f, .70710677f, 0.f, .70710677f)};
+    raw_tracks[1].keyframes.push_back(key2);
+    raw_tracks[1].keyframes.push_back(key1);
+
+    ozz::unique_ptr<QuaternionTrackBundle> bundle(
+        builder.Bundle(ozz::make_span(raw_tracks)));
+    ASSERT_TRUE(bundle);
+
+    ozz::math::Quaternion results[2];
+    QuaternionTrackBundleSamplingJob sampling;
+    sampling.bundle = bundle.get();
+    sampling.results = ozz::make_span(results);
+    for (int i = 0; i < 11; ++i) {
+      sampling.ratio = i * .1f;
+      ASSERT_TRUE(sampling.Run());
+      for (size_t t = 0; t < 2; ++t) {
+        ozz::unique_ptr<QuaternionTrack> track(builder(raw_tracks[t]));
+        ASSERT_TRUE(track);
+        ozz::animation::QuaternionTrackSamplingJob ref_sampling;
+        ref_sampling.track = track.get();
+        ozz::math::Quaternion ref_result;
+        ref_sampling.result = &ref_result;
+        ref_sampling.ratio = sampling.ratio;
+        ASSERT_TRUE(ref_sampling.Run());
+        EXPECT_QUATERNION_EQ(results[t], ref_result.x, ref_result.y,
+                             ref_result.z, ref_result.w);
+      }
+    }
+  }
+}
+
+TEST(MoveBuild, TrackBuilder) {
+  TrackBuilder builder;
+
+  {  // Consumed input keyframes don't need to be sorted.
+    RawFloatTrack raw_track;
+    raw_track.name = "track1";
+    const RawFloatTrack::Keyframe key0 = {RawTrackInterpolation::kLinear, .7f,
+                                          46.f};
+    raw_track.keyframes.push_back(key0);
+    const RawFloatTrack::Keyframe key1 = {RawTrackInterpolation::kLinear, .2f,
+                                          4.f};
+    raw_track.keyframes.push_back(key1);
+    EXPECT_FALSE(raw_track.Validate());
+
+    // Builds track, consuming the raw one.
+    ozz::unique_ptr<FloatTrack> track(builder(std::move(raw_track)));
+    ASSERT_TRUE(track);
+    EXPECT_STREQ(track->name(), "track1");
+
+    // Samples to verify build output, begin/end keys patching included.
+    FloatTrackSamplingJob sampling;
+    float result;
+    sampling.track = track.get();
+    sampling.result = &result;
+
+    sampling.ratio = 0.f;
+    ASSERT_TRUE(sampling.Run());
+    EXPECT_FLOAT_EQ(result, 4.f);
+
+    sampling.ratio = .2f;
+    ASSERT_TRUE(sampling.Run());
+    EXPECT_FLOAT_EQ(result, 4.f);
+
+    sampling.ratio = .7f;
+    ASSERT_TRUE(sampling.Run());
+    EXPECT_FLOAT_EQ(result, 46.f);
+
+    sampling.ratio = 1.f;
+    ASSERT_TRUE(sampling.Run());
+    EXPECT_FLOAT_EQ(result, 46.f);
+  }
+
+  {  // Remaining validity requirements still hold for a consumed input.
+    RawFloatTrack raw_track;
+    const RawFloatTrack::Keyframe key = {RawTrackInterpolation::kLinear, .5f,
+                                         0.f};
+    raw_track.keyframes.push_back(key);
+    raw_track.keyframes.push_back(key);  // Duplicated ratio.
+    EXPECT_TRUE(!builder(std::move(raw_track)));
+  }
+
+  {  // Quaternion move path applies fixup (hemisphere consistency).
+    RawQuaternionTrack raw_track;
+    const RawQuaternionTrack::Keyframe key0 = {
+        RawTrackInterpolation::kLinear, 0.f,
+        ozz::math::Quaternion(.70710677f, 0.f, 0.f, .70710677f)};
+    raw_track.keyframes.push_back(key0);
+    const RawQuaternionTrack::Keyframe key1 = {
+        RawTrackInterpolation::kLinear, 1.f,
+        ozz::math::Quaternion(-.70710677f, -0.f, -0.f, -.70710677f)};
+    raw_track.keyframes.push_back(key1);
+
+    ozz::unique_ptr<QuaternionTrack> track(builder(std::move(raw_track)));
+    ASSERT_TRUE(track);
+
+    ozz::math::Quaternion result;
+    ozz::animation::QuaternionTrackSamplingJob sampling;
+    sampling.track = track.get();
+    sampling.result = &result;
+    sampling.ratio = .5f;
+    ASSERT_TRUE(sampling.Run());
+    EXPECT_QUATERNION_EQ(result, .70710677f, 0.f, 0.f, .70710677f);
+  }
+}
+
+TEST(BulkBuild, TrackBuilder) {
+  TrackBuilder builder;
+
+  // 3 tracks: valid, invalid ratio, valid but unsorted.
+  ozz::vector<RawFloatTrack> raw_tracks(3);
+  raw_tracks[0].name = "t0";
+  const RawFloatTrack::Keyframe key0 = {RawTrackInterpolation::kLinear, .5f,
+                                        23.f};
+  raw_tracks[0].keyframes.push_back(key0);
+  const RawFloatTrack::Keyframe bad_key = {RawTrackInterpolation::kLinear, 2.f,
+                                           0.f};
+  raw_tracks[1].keyframes.push_back(bad_key);
+  const RawFloatTrack::Keyframe key2a = {RawTrackInterpolation::kLinear, .8f,
+                                         46.f};
+  raw_tracks[2].keyframes.push_back(key2a);
+  const RawFloatTrack::Keyframe key2b = {RawTrackInterpolation::kLinear, .2f,
+                                         4.f};
+  raw_tracks[2].keyframes.push_back(key2b);
+
+  ozz::unique_ptr<FloatTrack> tracks[3];
+
+  {  // Too small output span builds nothing.
+    EXPECT_EQ(builder(ozz::make_span(raw_tracks),
+                      ozz::span<ozz::unique_ptr<FloatTrack>>(tracks, 2)),
+              0u);
+    EXPECT_FALSE(tracks[0]);
+  }
+
+  // Bulk builds all valid tracks, failed ones leave their output empty.
+  EXPECT_EQ(builder(ozz::make_span(raw_tracks), ozz::make_span(tracks)), 2u);
+  ASSERT_TRUE(tracks[0]);
+  EXPECT_FALSE(tracks[1]);
+  ASSERT_TRUE(tracks[2]);
+  EXPECT_STREQ(tracks[0]->name(), "t0");
+
+  // Samples to verify build output.
+  FloatTrackSamplingJob sampling;
+  float result;
+  sampling.track = tracks[2].get();
+  sampling.result = &result;
+  sampling.ratio = .8f;
+  ASSERT_TRUE(sampling.Run());
+  EXPECT_FLOAT_EQ(result, 46.f);
+}
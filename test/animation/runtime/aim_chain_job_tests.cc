@@ -0,0 +1,229 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "gtest/gtest.h"
+#include "ozz/animation/runtime/aim_chain_job.h"
+#include "ozz/animation/runtime/ik_aim_job.h"
+#include "ozz/base/maths/gtest_math_helper.h"
+#include "ozz/base/maths/simd_math.h"
+#include "ozz/base/maths/simd_quaternion.h"
+
+// Verifies that the forward vector aims at the target once corrections are
+// applied to the chain.
+void _ExpectAimed(const ozz::animation::AimChainJob& _job) {
+  // Rebuilds the corrected model-space matrix of the first (aimed) joint.
+  // Chain joints are ordered from the aimed joint up to its ancestors.
+  const size_t last = _job.joints.size() - 1;
+  ozz::math::Float4x4 corrected =
+      _job.joints[last] *
+      ozz::math::Float4x4::FromQuaternion(_job.joint_corrections[last].xyzw);
+  for (size_t i = last; i > 0; --i) {
+    const ozz::math::Float4x4 local =
+        Invert(_job.joints[i]) * _job.joints[i - 1];
+    corrected =
+        corrected * local *
+        ozz::math::Float4x4::FromQuaternion(_job.joint_corrections[i - 1].xyzw);
+  }
+
+  // Compares corrected forward direction with the offset to target direction.
+  const ozz::math::SimdFloat4 forward_ms =
+      ozz::math::Normalize3(TransformVector(corrected, _job.forward));
+  const ozz::math::SimdFloat4 offset_ms =
+      TransformPoint(corrected, _job.offset);
+  const ozz::math::SimdFloat4 to_target_ms =
+      ozz::math::Normalize3(_job.target - offset_ms);
+
+  const ozz::math::SimdFloat4 cos_angle =
+      ozz::math::Dot3(forward_ms, to_target_ms);
+  EXPECT_GT(ozz::math::GetX(cos_angle), 1.f - 1e-3f);
+}
+
+TEST(JobValidity, AimChainJob) {
+  const ozz::math::Float4x4 joints[2] = {
+      ozz::math::Float4x4::Translation(ozz::math::simd_float4::y_axis()),
+      ozz::math::Float4x4::identity()};
+  ozz::math::SimdQuaternion corrections[2];
+  const ozz::math::SimdFloat4 ups[2] = {ozz::math::simd_float4::y_axis(),
+                                        ozz::math::simd_float4::y_axis()};
+  const float weights[2] = {.5f, .5f};
+
+  {  // Default is invalid
+    ozz::animation::AimChainJob job;
+    EXPECT_FALSE(job.Validate());
+  }
+
+  {  // Empty chain
+    ozz::animation::AimChainJob job;
+    job.joint_corrections = corrections;
+    EXPECT_FALSE(job.Validate());
+  }
+
+  {  // Too small corrections output
+    ozz::animation::AimChainJob job;
+    job.joints = joints;
+    job.joint_corrections = ozz::span<ozz::math::SimdQuaternion>(corrections, 1);
+    EXPECT_FALSE(job.Validate());
+  }
+
+  {  // Wrong up vectors size
+    ozz::animation::AimChainJob job;
+    job.joints = joints;
+    job.joint_corrections = corrections;
+    job.joint_ups = ozz::span<const ozz::math::SimdFloat4>(ups, 1);
+    EXPECT_FALSE(job.Validate());
+  }
+
+  {  // Wrong weights size
+    ozz::animation::AimChainJob job;
+    job.joints = joints;
+    job.joint_corrections = corrections;
+    job.joint_weights = ozz::span<const float>(weights, 1);
+    EXPECT_FALSE(job.Validate());
+  }
+
+  {  // Unnormalized forward
+    ozz::animation::AimChainJob job;
+    job.joints = joints;
+    job.joint_corrections = corrections;
+    job.forward = ozz::math::simd_float4::Load(0.f, 2.f, 0.f, 0.f);
+    EXPECT_FALSE(job.Validate());
+  }
+
+  {  // Valid
+    ozz::animation::AimChainJob job;
+    job.joints = joints;
+    job.joint_corrections = corrections;
+    EXPECT_TRUE(job.Validate());
+  }
+
+  {  // Valid with ups and weights
+    ozz::animation::AimChainJob job;
+    job.joints = joints;
+    job.joint_corrections = corrections;
+    job.joint_ups = ups;
+    job.joint_weights = weights;
+    EXPECT_TRUE(job.Validate());
+  }
+}
+
+TEST(SingleJoint, AimChainJob) {
+  // A single joint chain must behave exactly like IKAimJob with a full
+  // weight.
+  const ozz::math::Float4x4 joint =
+      ozz::math::Float4x4::Translation(ozz::math::simd_float4::y_axis());
+  const ozz::math::SimdFloat4 target =
+      ozz::math::simd_float4::Load(1.f, 2.f, 3.f, 0.f);
+
+  ozz::animation::AimChainJob job;
+  job.target = target;
+  job.joints = ozz::span<const ozz::math::Float4x4>(&joint, 1);
+  ozz::math::SimdQuaternion correction;
+  job.joint_corrections = ozz::span<ozz::math::SimdQuaternion>(&correction, 1);
+  bool reached;
+  job.reached = &reached;
+  ASSERT_TRUE(job.Run());
+  _ExpectAimed(job);
+  EXPECT_TRUE(reached);
+
+  // Runs the equivalent aim job.
+  ozz::animation::IKAimJob aim_job;
+  aim_job.target = target;
+  aim_job.joint = &joint;
+  ozz::math::SimdQuaternion aim_correction;
+  aim_job.joint_correction = &aim_correction;
+  ASSERT_TRUE(aim_job.Run());
+
+  EXPECT_SIMDQUATERNION_EQ_EST(correction, ozz::math::GetX(aim_correction.xyzw),
+                               ozz::math::GetY(aim_correction.xyzw),
+                               ozz::math::GetZ(aim_correction.xyzw),
+                               ozz::math::GetW(aim_correction.xyzw));
+}
+
+TEST(Chain, AimChainJob) {
+  // A 3 joints spine chain along y axis, ordered from the aimed joint (head)
+  // down to its ancestors.
+  const ozz::math::Float4x4 joints[3] = {
+      ozz::math::Float4x4::Translation(
+          ozz::math::simd_float4::Load(0.f, 2.f, 0.f, 0.f)),
+      ozz::math::Float4x4::Translation(ozz::math::simd_float4::y_axis()),
+      ozz::math::Float4x4::identity()};
+  ozz::math::SimdQuaternion corrections[3];
+  const float weights[3] = {.3f, .4f, 1.f};
+  bool reached;
+
+  ozz::animation::AimChainJob job;
+  job.joints = joints;
+  job.joint_corrections = corrections;
+  job.joint_weights = weights;
+  job.reached = &reached;
+
+  {  // Target on the forward axis, no correction needed.
+    job.target = ozz::math::simd_float4::Load(2.f, 2.f, 0.f, 0.f);
+    ASSERT_TRUE(job.Run());
+    _ExpectAimed(job);
+    EXPECT_TRUE(reached);
+    for (size_t i = 0; i < OZZ_ARRAY_SIZE(corrections); ++i) {
+      EXPECT_SIMDQUATERNION_EQ_TOL(corrections[i], 0.f, 0.f, 0.f, 1.f, 2e-3f);
+    }
+  }
+
+  {  // Target behind the chain, every joint contributes.
+    job.target = ozz::math::simd_float4::Load(-3.f, 2.f, 1.f, 0.f);
+    ASSERT_TRUE(job.Run());
+    _ExpectAimed(job);
+    EXPECT_TRUE(reached);
+    // Weighted intermediate joints all rotated.
+    for (size_t i = 0; i < OZZ_ARRAY_SIZE(corrections); ++i) {
+      EXPECT_LT(ozz::math::GetW(ozz::math::Abs(corrections[i].xyzw)), .999f);
+    }
+  }
+
+  {  // Offset aiming.
+    job.offset = ozz::math::simd_float4::Load(0.f, .1f, .2f, 0.f);
+    job.target = ozz::math::simd_float4::Load(0.f, 2.f, 3.f, 0.f);
+    ASSERT_TRUE(job.Run());
+    _ExpectAimed(job);
+    EXPECT_TRUE(reached);
+    job.offset = ozz::math::simd_float4::zero();
+  }
+
+  {  // 0 chain weight, no correction.
+    job.chain_weight = 0.f;
+    job.target = ozz::math::simd_float4::Load(-3.f, 2.f, 1.f, 0.f);
+    ASSERT_TRUE(job.Run());
+    for (size_t i = 0; i < OZZ_ARRAY_SIZE(corrections); ++i) {
+      EXPECT_SIMDQUATERNION_EQ_TOL(corrections[i], 0.f, 0.f, 0.f, 1.f, 2e-3f);
+    }
+    job.chain_weight = 1.f;
+  }
+
+  {  // Degenerated target, at the aimed joint position. Just expecting it's
+     // not crashing.
+    job.target = joints[0].cols[3];
+    ASSERT_TRUE(job.Run());
+  }
+}
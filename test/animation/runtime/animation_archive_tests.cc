@@ -30,6 +30,7 @@
 #include "ozz/animation/offline/raw_animation.h"
 #include "ozz/animation/runtime/animation.h"
 #include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/base/containers/vector.h"
 #include "ozz/base/io/archive.h"
 #include "ozz/base/io/stream.h"
 #include "ozz/base/maths/gtest_math_helper.h"
@@ -82,6 +83,7 @@ TEST(Filled, AnimationSerialize) {
     raw_animation.tracks[0].scales.push_back(s_key);
 
     AnimationBuilder builder;
+    builder.rig_signature = "test rig";
     o_animation = builder(raw_animation);
     ASSERT_TRUE(o_animation);
   }
@@ -103,6 +105,7 @@ TEST(Filled, AnimationSerialize) {
 
     ASSERT_FLOAT_EQ(o_animation->duration(), i_animation.duration());
     ASSERT_EQ(o_animation->num_tracks(), i_animation.num_tracks());
+    EXPECT_STREQ(i_animation.rig(), "test rig");
     EXPECT_EQ(o_animation->size(), i_animation.size());
 
     // Needs to sample to test the animation.
@@ -178,3 +181,215 @@ TEST(AlreadyInitialized, AnimationSerialize) {
     ASSERT_EQ(i_animation.num_tracks(), 2);
   }
 }
+
+TEST(RawImage, AnimationSerialize) {
+  // Builds a valid animation.
+  ozz::unique_ptr<Animation> o_animation;
+  {
+    RawAnimation raw_animation;
+    raw_animation.duration = 1.f;
+    raw_animation.name = "raw image anim";
+    raw_animation.tracks.resize(2);
+
+    RawAnimation::TranslationKey t_key0 = {0.f,
+                                           ozz::math::Float3(93.f, 58.f, 46.f)};
+    raw_animation.tracks[0].translations.push_back(t_key0);
+    RawAnimation::TranslationKey t_key1 = {.9f,
+                                           ozz::math::Float3(46.f, 58.f, 93.f)};
+    raw_animation.tracks[0].translations.push_back(t_key1);
+
+    RawAnimation::RotationKey r_key = {
+        0.7f, ozz::math::Quaternion(0.f, 1.f, 0.f, 0.f)};
+    raw_animation.tracks[1].rotations.push_back(r_key);
+
+    RawAnimation::ScaleKey s_key = {0.1f, ozz::math::Float3(99.f, 26.f, 14.f)};
+    raw_animation.tracks[1].scales.push_back(s_key);
+
+    AnimationBuilder builder;
+    builder.rig_signature = "raw image rig";
+    o_animation = builder(raw_animation);
+    ASSERT_TRUE(o_animation);
+  }
+
+  // Stores the relocatable image to a float buffer, which guarantees the
+  // alignment a mapped file would also provide.
+  const size_t raw_size = o_animation->raw_size();
+  ozz::vector<float> image((raw_size + sizeof(float) - 1) / sizeof(float));
+  const ozz::span<ozz::byte> image_buffer = {
+      reinterpret_cast<ozz::byte*>(image.data()), raw_size};
+
+  // Too small buffer is rejected.
+  EXPECT_FALSE(o_animation->SaveRaw(image_buffer.first(raw_size - 1)));
+  ASSERT_TRUE(o_animation->SaveRaw(image_buffer));
+
+  {  // Invalid images are rejected, leaving the animation empty.
+    Animation i_animation;
+    EXPECT_FALSE(i_animation.LoadRaw({}));
+    EXPECT_FALSE(i_animation.LoadRaw(image_buffer.first(raw_size - 1)));
+    EXPECT_EQ(i_animation.num_tracks(), 0);
+  }
+
+  Animation i_animation;
+  ASSERT_TRUE(i_animation.LoadRaw(image_buffer));
+
+  // The image is referenced in place, not copied.
+  const ozz::byte* timepoints =
+      reinterpret_cast<const ozz::byte*>(i_animation.timepoints().data());
+  EXPECT_TRUE(timepoints >= image_buffer.data() &&
+              timepoints < image_buffer.data() + raw_size);
+
+  EXPECT_FLOAT_EQ(o_animation->duration(), i_animation.duration());
+  EXPECT_EQ(o_animation->num_tracks(), i_animation.num_tracks());
+  EXPECT_STREQ(o_animation->name(), i_animation.name());
+  EXPECT_STREQ(o_animation->rig(), i_animation.rig());
+
+  // Samples both animations, they must give the same result.
+  ozz::animation::SamplingJob::Context context(1);
+  for (float t = 0.f; t < 1.f; t += .3f) {
+    ozz::math::SoaTransform o_output[1];
+    ozz::animation::SamplingJob o_job;
+    o_job.animation = o_animation.get();
+    o_job.context = &context;
+    o_job.ratio = t;
+    o_job.output = o_output;
+    ASSERT_TRUE(o_job.Run());
+    context.Invalidate();
+
+    ozz::math::SoaTransform i_output[1];
+    ozz::animation::SamplingJob i_job;
+    i_job.animation = &i_animation;
+    i_job.context = &context;
+    i_job.ratio = t;
+    i_job.output = i_output;
+    ASSERT_TRUE(i_job.Run());
+    context.Invalidate();
+
+    EXPECT_TRUE(ozz::math::AreAllTrue(o_output[0].translation.x ==
+                                      i_output[0].translation.x));
+    EXPECT_TRUE(ozz::math::AreAllTrue(o_output[0].translation.y ==
+                                      i_output[0].translation.y));
+    EXPECT_TRUE(ozz::math::AreAllTrue(o_output[0].translation.z ==
+                                      i_output[0].translation.z));
+    EXPECT_TRUE(
+        ozz::math::AreAllTrue(o_output[0].rotation.x == i_output[0].rotation.x));
+    EXPECT_TRUE(
+        ozz::math::AreAllTrue(o_output[0].rotation.w == i_output[0].rotation.w));
+    EXPECT_TRUE(
+        ozz::math::AreAllTrue(o_output[0].scale.x == i_output[0].scale.x));
+  }
+
+  // The source animation can be destroyed, only the image must outlive the
+  // bound animation.
+  o_animation.reset();
+  EXPECT_EQ(i_animation.num_tracks(), 2);
+}
+
+TEST(PlacementLoad, AnimationSerialize) {
+  // Builds a valid animation.
+  ozz::unique_ptr<Animation> o_animation;
+  {
+    RawAnimation raw_animation;
+    raw_animation.duration = 1.f;
+    raw_animation.name = "placement anim";
+    raw_animation.tracks.resize(1);
+
+    RawAnimation::TranslationKey t_key0 = {0.f,
+                                           ozz::math::Float3(93.f, 58.f, 46.f)};
+    raw_animation.tracks[0].translations.push_back(t_key0);
+    RawAnimation::TranslationKey t_key1 = {.9f,
+                                           ozz::math::Float3(46.f, 58.f, 93.f)};
+    raw_animation.tracks[0].translations.push_back(t_key1);
+
+    AnimationBuilder builder;
+    o_animation = builder(raw_animation);
+    ASSERT_TRUE(o_animation);
+  }
+
+  ozz::io::MemoryStream stream;
+  {
+    ozz::io::OArchive o(&stream);
+    o << *o_animation;
+  }
+
+  stream.Seek(0, ozz::io::Stream::kSet);
+  ozz::io::IArchive i(&stream);
+
+  // SizeOf probes the archive without moving the read position, probing
+  // twice reports the same size.
+  const size_t size = Animation::SizeOf(i);
+  ASSERT_GT(size, 0u);
+  EXPECT_EQ(Animation::SizeOf(i), size);
+
+  // A float buffer guarantees the required alignment.
+  ozz::vector<float> buffer((size + sizeof(float) - 1) / sizeof(float) + 4);
+  const ozz::span<ozz::byte> bytes = {
+      reinterpret_cast<ozz::byte*>(buffer.data()), size + sizeof(float)};
+
+  {  // Too small and misaligned buffers are rejected, leaving the archive
+     // read position untouched.
+    Animation i_animation;
+    EXPECT_FALSE(i_animation.Load(i, bytes.first(size - 1)));
+    EXPECT_FALSE(i_animation.Load(i, bytes.subspan(1, size)));
+    EXPECT_EQ(i_animation.num_tracks(), 0);
+    EXPECT_EQ(Animation::SizeOf(i), size);
+  }
+
+  Animation i_animation;
+  ASSERT_TRUE(i_animation.Load(i, bytes.first(size)));
+
+  // The animation data block lives in the caller-provided buffer.
+  const ozz::byte* timepoints =
+      reinterpret_cast<const ozz::byte*>(i_animation.timepoints().data());
+  EXPECT_TRUE(timepoints >= bytes.data() && timepoints < bytes.data() + size);
+
+  EXPECT_FLOAT_EQ(o_animation->duration(), i_animation.duration());
+  EXPECT_EQ(o_animation->num_tracks(), i_animation.num_tracks());
+  EXPECT_STREQ(o_animation->name(), i_animation.name());
+
+  // Samples both animations, they must give the same result.
+  ozz::animation::SamplingJob::Context context(1);
+  for (float t = 0.f; t < 1.f; t += .3f) {
+    ozz::math::SoaTransform o_output[1];
+    ozz::animation::SamplingJob o_job;
+    o_job.animation = o_animation.get();
+    o_job.context = &context;
+    o_job.ratio = t;
+    o_job.output = o_output;
+    ASSERT_TRUE(o_job.Run());
+    context.Invalidate();
+
+    ozz::math::SoaTransform i_output[1];
+    ozz::animation::SamplingJob i_job;
+    i_job.animation = &i_animation;
+    i_job.context = &context;
+    i_job.ratio = t;
+    i_job.output = i_output;
+    ASSERT_TRUE(i_job.Run());
+    context.Invalidate();
+
+    EXPECT_TRUE(ozz::math::AreAllTrue(o_output[0].translation.x ==
+                                      i_output[0].translation.x));
+    EXPECT_TRUE(ozz::math::AreAllTrue(o_output[0].translation.y ==
+                                      i_output[0].translation.y));
+    EXPECT_TRUE(ozz::math::AreAllTrue(o_output[0].translation.z ==
+                                      i_output[0].translation.z));
+  }
+
+  {  // The next object in the archive is not an animation.
+    ozz::io::MemoryStream other_stream;
+    {
+      // Enough data for the probe to read a whole (mismatching) tag.
+      ozz::io::OArchive o(&other_stream);
+      o << 46;
+      o << 99;
+      o << 58;
+      o << 93;
+      o << 26;
+    }
+    other_stream.Seek(0, ozz::io::Stream::kSet);
+    ozz::io::IArchive other(&other_stream);
+    EXPECT_EQ(Animation::SizeOf(other), 0u);
+    Animation invalid;
+    EXPECT_FALSE(invalid.Load(other, bytes.first(size)));
+  }
+}
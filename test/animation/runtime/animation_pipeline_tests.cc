@@ -0,0 +1,277 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include <atomic>
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/offline/animation_builder.h"
+#include "ozz/animation/offline/raw_skeleton.h"
+#include "ozz/animation/offline/skeleton_builder.h"
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/animation/runtime/animation_pipeline.h"
+#include "ozz/animation/runtime/local_to_model_job.h"
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/maths/gtest_math_helper.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/memory/unique_ptr.h"
+#include "ozz/base/scheduler.h"
+
+using ozz::animation::AnimationPipeline;
+
+TEST(Validity, AnimationPipeline) {
+  auto nop = [](int) { return true; };
+
+  {  // Default is valid, no stage and no instance.
+    AnimationPipeline pipeline;
+    EXPECT_TRUE(pipeline.Validate());
+    EXPECT_TRUE(pipeline.Run());
+  }
+
+  {  // Negative instance count.
+    AnimationPipeline pipeline;
+    pipeline.num_instances = -1;
+    EXPECT_FALSE(pipeline.Validate());
+    EXPECT_FALSE(pipeline.Run());
+  }
+
+  {  // nullptr stage function / name.
+    AnimationPipeline::Stage stages[] = {
+        AnimationPipeline::MakeStage("nop", nop)};
+    AnimationPipeline pipeline;
+    pipeline.num_instances = 1;
+    pipeline.stages = stages;
+
+    stages[0].fn = nullptr;
+    EXPECT_FALSE(pipeline.Validate());
+    EXPECT_FALSE(pipeline.Run());
+
+    stages[0] = AnimationPipeline::MakeStage(nullptr, nop);
+    EXPECT_FALSE(pipeline.Validate());
+
+    stages[0] = AnimationPipeline::MakeStage("nop", nop);
+    EXPECT_TRUE(pipeline.Validate());
+    EXPECT_TRUE(pipeline.Run());
+  }
+}
+
+TEST(Fusion, AnimationPipeline) {
+  const int num_instances = 100;
+
+  // Each instance records the stages it went through. Fused stages must
+  // execute in declaration order for each instance.
+  ozz::vector<int> sequences(num_instances, 0);
+  auto first = [&sequences](int _instance) {
+    sequences[_instance] = sequences[_instance] * 10 + 1;
+    return true;
+  };
+  auto second = [&sequences](int _instance) {
+    sequences[_instance] = sequences[_instance] * 10 + 2;
+    return true;
+  };
+  auto third = [&sequences](int _instance) {
+    sequences[_instance] = sequences[_instance] * 10 + 3;
+    return true;
+  };
+
+  const AnimationPipeline::Stage stages[] = {
+      AnimationPipeline::MakeStage("first", first),
+      AnimationPipeline::MakeStage("second", second),
+      AnimationPipeline::MakeStage("third", third)};
+
+  AnimationPipeline pipeline;
+  pipeline.num_instances = num_instances;
+  pipeline.stages = stages;
+
+  {  // Serial execution.
+    ASSERT_TRUE(pipeline.Run());
+    for (int i = 0; i < num_instances; ++i) {
+      EXPECT_EQ(sequences[i], 123);
+    }
+  }
+
+  {  // Parallel execution fuses stages the same way.
+    std::fill(sequences.begin(), sequences.end(), 0);
+    ozz::ThreadPoolScheduler scheduler(3);
+    pipeline.scheduler = &scheduler;
+    ASSERT_TRUE(pipeline.Run());
+    for (int i = 0; i < num_instances; ++i) {
+      EXPECT_EQ(sequences[i], 123);
+    }
+  }
+}
+
+TEST(Barrier, AnimationPipeline) {
+  const int num_instances = 100;
+
+  // The barrier stage must observe the first stage completed for all
+  // instances, whatever the instance it runs for.
+  std::atomic<int> num_processed(0);
+  std::atomic<bool> barrier_valid(true);
+  auto produce = [&num_processed](int) {
+    num_processed.fetch_add(1);
+    return true;
+  };
+  auto consume_all = [&num_processed, &barrier_valid, num_instances](int) {
+    if (num_processed.load() != num_instances) {
+      barrier_valid.store(false);
+    }
+    return true;
+  };
+
+  const AnimationPipeline::Stage stages[] = {
+      AnimationPipeline::MakeStage("produce", produce),
+      AnimationPipeline::MakeStage("consume all", consume_all, true)};
+
+  ozz::ThreadPoolScheduler scheduler(3);
+  AnimationPipeline pipeline;
+  pipeline.num_instances = num_instances;
+  pipeline.stages = stages;
+  pipeline.scheduler = &scheduler;
+
+  ASSERT_TRUE(pipeline.Run());
+  EXPECT_TRUE(barrier_valid);
+}
+
+TEST(Failure, AnimationPipeline) {
+  const int num_instances = 10;
+
+  // Stage failure fails the run and skips remaining fused stages for the
+  // failing instance only.
+  std::atomic<int> num_chained(0);
+  auto faulty = [](int _instance) { return _instance != 3; };
+  auto chained = [&num_chained](int) {
+    num_chained.fetch_add(1);
+    return true;
+  };
+
+  const AnimationPipeline::Stage stages[] = {
+      AnimationPipeline::MakeStage("faulty", faulty),
+      AnimationPipeline::MakeStage("chained", chained)};
+
+  AnimationPipeline pipeline;
+  pipeline.num_instances = num_instances;
+  pipeline.stages = stages;
+
+  EXPECT_FALSE(pipeline.Run());
+  EXPECT_EQ(num_chained, num_instances - 1);
+}
+
+TEST(SampleToModel, AnimationPipeline) {
+  // Builds a 2 joints chain skeleton and a constant animation.
+  ozz::animation::offline::RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  raw_skeleton.roots[0].name = "j0";
+  raw_skeleton.roots[0].children.resize(1);
+  raw_skeleton.roots[0].children[0].name = "j1";
+  ozz::animation::offline::SkeletonBuilder skeleton_builder;
+  ozz::unique_ptr<ozz::animation::Skeleton> skeleton =
+      skeleton_builder(raw_skeleton);
+  ASSERT_TRUE(skeleton);
+
+  ozz::animation::offline::RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(2);
+  const ozz::animation::offline::RawAnimation::TranslationKey key0 = {
+      0.f, ozz::math::Float3(1.f, 2.f, 3.f)};
+  raw_animation.tracks[0].translations.push_back(key0);
+  const ozz::animation::offline::RawAnimation::TranslationKey key1 = {
+      0.f, ozz::math::Float3(10.f, 0.f, 0.f)};
+  raw_animation.tracks[1].translations.push_back(key1);
+  ozz::animation::offline::AnimationBuilder animation_builder;
+  ozz::unique_ptr<ozz::animation::Animation> animation =
+      animation_builder(raw_animation);
+  ASSERT_TRUE(animation);
+
+  // Per instance buffers, the typical sample -> local-to-model chain.
+  const int num_instances = 4;
+  ozz::vector<ozz::animation::SamplingJob::Context> contexts(num_instances);
+  ozz::vector<ozz::math::SoaTransform> locals(num_instances);
+  ozz::vector<ozz::math::Float4x4> models(num_instances * 2);
+  for (int i = 0; i < num_instances; ++i) {
+    contexts[i].Resize(animation->num_tracks());
+  }
+
+  auto sample = [&](int _instance) {
+    ozz::animation::SamplingJob job;
+    job.animation = animation.get();
+    job.context = &contexts[_instance];
+    job.ratio = 0.f;
+    job.output = {&locals[_instance], 1};
+    return job.Run();
+  };
+  auto local_to_model = [&](int _instance) {
+    ozz::animation::LocalToModelJob job;
+    job.skeleton = skeleton.get();
+    job.input = {&locals[_instance], 1};
+    job.output = {&models[_instance * 2], 2};
+    return job.Run();
+  };
+
+  const AnimationPipeline::Stage stages[] = {
+      AnimationPipeline::MakeStage("sample", sample),
+      AnimationPipeline::MakeStage("local to model", local_to_model)};
+
+  ozz::ThreadPoolScheduler scheduler(2);
+  AnimationPipeline pipeline;
+  pipeline.num_instances = num_instances;
+  pipeline.stages = stages;
+  pipeline.scheduler = &scheduler;
+
+  ASSERT_TRUE(pipeline.Run());
+
+  // Compares with a reference chain executed manually for instance 0, all
+  // instances running the very same jobs.
+  ozz::math::SoaTransform ref_local;
+  ozz::math::Float4x4 ref_models[2];
+  {
+    ozz::animation::SamplingJob::Context context(animation->num_tracks());
+    ozz::animation::SamplingJob sampling_job;
+    sampling_job.animation = animation.get();
+    sampling_job.context = &context;
+    sampling_job.ratio = 0.f;
+    sampling_job.output = {&ref_local, 1};
+    ASSERT_TRUE(sampling_job.Run());
+
+    ozz::animation::LocalToModelJob ltm_job;
+    ltm_job.skeleton = skeleton.get();
+    ltm_job.input = {&ref_local, 1};
+    ltm_job.output = ref_models;
+    ASSERT_TRUE(ltm_job.Run());
+  }
+
+  for (int i = 0; i < num_instances; ++i) {
+    for (int m = 0; m < 2; ++m) {
+      for (int c = 0; c < 4; ++c) {
+        EXPECT_TRUE(ozz::math::AreAllTrue(models[i * 2 + m].cols[c] ==
+                                          ref_models[m].cols[c]));
+      }
+    }
+  }
+}
@@ -0,0 +1,278 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/animation_registry.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/animation_builder.h"
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/memory/unique_ptr.h"
+#include "ozz/base/span.h"
+
+using ozz::animation::Animation;
+using ozz::animation::AnimationRegistry;
+using ozz::animation::SamplingJob;
+using ozz::animation::offline::AnimationBuilder;
+using ozz::animation::offline::RawAnimation;
+
+namespace {
+
+// Builds a minimal valid animation with the given duration.
+ozz::unique_ptr<Animation> BuildTestAnimation(float _duration) {
+  RawAnimation raw_animation;
+  raw_animation.duration = _duration;
+  raw_animation.tracks.resize(1);
+  AnimationBuilder builder;
+  return builder(raw_animation);
+}
+}  // namespace
+
+TEST(Validity, AnimationRegistry) {
+  AnimationRegistry registry;
+  EXPECT_EQ(registry.size(), 0u);
+
+  // Adding a nullptr resource fails.
+  EXPECT_EQ(registry.Add(nullptr), AnimationRegistry::kInvalidHandle);
+
+  // Invalid and never-returned handles resolve to nullptr.
+  EXPECT_EQ(registry.Get(AnimationRegistry::kInvalidHandle), nullptr);
+  EXPECT_EQ(registry.Get(46), nullptr);
+  EXPECT_EQ(registry.Get(0xffffffff), nullptr);
+
+  // Replacing through an invalid handle fails.
+  EXPECT_FALSE(registry.Replace(AnimationRegistry::kInvalidHandle,
+                                BuildTestAnimation(1.f)));
+  EXPECT_FALSE(registry.Replace(46, BuildTestAnimation(1.f)));
+
+  // Collecting an empty registry is a no-op.
+  registry.Collect();
+}
+
+TEST(AddGet, AnimationRegistry) {
+  AnimationRegistry registry;
+
+  ozz::unique_ptr<Animation> animation0 = BuildTestAnimation(1.f);
+  ozz::unique_ptr<Animation> animation1 = BuildTestAnimation(2.f);
+  const Animation* raw0 = animation0.get();
+  const Animation* raw1 = animation1.get();
+
+  const AnimationRegistry::Handle handle0 =
+      registry.Add(std::move(animation0));
+  const AnimationRegistry::Handle handle1 =
+      registry.Add(std::move(animation1));
+  ASSERT_NE(handle0, AnimationRegistry::kInvalidHandle);
+  ASSERT_NE(handle1, AnimationRegistry::kInvalidHandle);
+  EXPECT_NE(handle0, handle1);
+  EXPECT_EQ(registry.size(), 2u);
+
+  // Handles resolve to the resources that were added.
+  EXPECT_EQ(registry.Get(handle0), raw0);
+  EXPECT_EQ(registry.Get(handle1), raw1);
+}
+
+TEST(ReplaceCollect, AnimationRegistry) {
+  AnimationRegistry registry;
+
+  const AnimationRegistry::Handle handle =
+      registry.Add(BuildTestAnimation(1.f));
+  ASSERT_NE(handle, AnimationRegistry::kInvalidHandle);
+  EXPECT_FLOAT_EQ(registry.Get(handle)->duration(), 1.f);
+
+  // Hot-reload style swap, the handle remains stable.
+  ozz::unique_ptr<Animation> reloaded = BuildTestAnimation(2.f);
+  const Animation* raw_reloaded = reloaded.get();
+  EXPECT_TRUE(registry.Replace(handle, std::move(reloaded)));
+  EXPECT_EQ(registry.Get(handle), raw_reloaded);
+  EXPECT_FLOAT_EQ(registry.Get(handle)->duration(), 2.f);
+  EXPECT_EQ(registry.size(), 1u);
+
+  // Retired resources survive at least two epochs.
+  registry.Collect();
+  registry.Collect();
+  registry.Collect();
+  EXPECT_EQ(registry.Get(handle), raw_reloaded);
+
+  // Destruction reclaims everything, collected or not.
+  EXPECT_TRUE(registry.Replace(handle, BuildTestAnimation(3.f)));
+}
+
+TEST(ReplaceAndMigrate, AnimationRegistry) {
+  AnimationRegistry registry;
+
+  const AnimationRegistry::Handle handle =
+      registry.Add(BuildTestAnimation(1.f));
+  const AnimationRegistry::Handle other_handle =
+      registry.Add(BuildTestAnimation(1.f));
+  ASSERT_NE(handle, AnimationRegistry::kInvalidHandle);
+  ASSERT_NE(other_handle, AnimationRegistry::kInvalidHandle);
+
+  // Binds contexts by sampling: two on the animation being reloaded, one on
+  // another animation that must be left untouched.
+  SamplingJob::Context contexts[3];
+  ozz::math::SoaTransform output[1];
+  for (size_t i = 0; i < 3; ++i) {
+    contexts[i].Resize(1);
+    SamplingJob job;
+    job.animation = registry.Get(i == 2 ? other_handle : handle);
+    job.context = &contexts[i];
+    job.ratio = .5f;
+    job.output = output;
+    ASSERT_TRUE(job.Run());
+  }
+  const Animation* other_animation = registry.Get(other_handle);
+
+  // Null context entries are allowed, so fixed size arrays can be used for
+  // instance slots that aren't all live.
+  SamplingJob::Context* context_ptrs[4] = {&contexts[0], nullptr, &contexts[1],
+                                           &contexts[2]};
+
+  // Replacing through an invalid handle fails without touching any context.
+  EXPECT_FALSE(ozz::animation::ReplaceAndMigrate(
+      registry, AnimationRegistry::kInvalidHandle, BuildTestAnimation(1.f),
+      ozz::make_span(context_ptrs)));
+  EXPECT_EQ(contexts[0].animation(), registry.Get(handle));
+
+  // Hot-reloads the animation. Contexts bound to the previous version are
+  // migrated to the new one, others are left untouched.
+  ozz::unique_ptr<Animation> reloaded = BuildTestAnimation(1.f);
+  const Animation* raw_reloaded = reloaded.get();
+  EXPECT_TRUE(ozz::animation::ReplaceAndMigrate(
+      registry, handle, std::move(reloaded), ozz::make_span(context_ptrs)));
+  EXPECT_EQ(registry.Get(handle), raw_reloaded);
+  EXPECT_EQ(contexts[0].animation(), raw_reloaded);
+  EXPECT_EQ(contexts[1].animation(), raw_reloaded);
+  EXPECT_EQ(contexts[2].animation(), other_animation);
+
+  registry.Collect();
+  registry.Collect();
+}
+
+TEST(ConcurrentReaders, AnimationRegistry) {
+  AnimationRegistry registry;
+
+  // Pre-adds a batch of resources.
+  const int kInitialCount = 64;
+  ozz::vector<AnimationRegistry::Handle> handles;
+  for (int i = 0; i < kInitialCount; ++i) {
+    handles.push_back(registry.Add(BuildTestAnimation(1.f)));
+    ASSERT_NE(handles.back(), AnimationRegistry::kInvalidHandle);
+  }
+
+  // Readers resolve handles while the main thread keeps inserting and
+  // swapping, checking resolved resources are always valid.
+  std::atomic<bool> stop(false);
+  std::atomic<bool> success(true);
+  ozz::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&registry, &handles, &stop, &success]() {
+      while (!stop.load(std::memory_order_relaxed)) {
+        for (int j = 0; j < kInitialCount; ++j) {
+          const Animation* animation = registry.Get(handles[j]);
+          if (animation == nullptr || animation->duration() <= 0.f) {
+            success.store(false, std::memory_order_relaxed);
+            return;
+          }
+        }
+      }
+    });
+  }
+
+  for (int i = 0; i < 64; ++i) {
+    EXPECT_NE(registry.Add(BuildTestAnimation(2.f)),
+              AnimationRegistry::kInvalidHandle);
+    EXPECT_TRUE(
+        registry.Replace(handles[i % kInitialCount], BuildTestAnimation(3.f)));
+  }
+  // No Collect() while readers are running, as readers here don't honor
+  // quiescent points. Retired resources remain valid until destruction.
+
+  stop = true;
+  for (size_t i = 0; i < readers.size(); ++i) {
+    readers[i].join();
+  }
+  EXPECT_TRUE(success);
+  EXPECT_EQ(registry.size(), size_t(kInitialCount) + 64);
+
+  registry.Collect();
+  registry.Collect();
+}
+
+TEST(NumaReplicas, AnimationRegistry) {
+  AnimationRegistry registry;
+
+  ozz::unique_ptr<Animation> animation = BuildTestAnimation(1.f);
+  const Animation* primary = animation.get();
+  const AnimationRegistry::Handle handle = registry.Add(std::move(animation));
+  ASSERT_NE(handle, AnimationRegistry::kInvalidHandle);
+
+  // Invalid duplications fail.
+  EXPECT_FALSE(registry.Duplicate(AnimationRegistry::kInvalidHandle, 1,
+                                  BuildTestAnimation(1.f)));
+  EXPECT_FALSE(registry.Duplicate(46, 1, BuildTestAnimation(1.f)));
+  EXPECT_FALSE(registry.Duplicate(handle, 1, nullptr));
+  EXPECT_FALSE(registry.Duplicate(handle, -1, BuildTestAnimation(1.f)));
+  EXPECT_FALSE(registry.Duplicate(handle, 46, BuildTestAnimation(1.f)));
+
+  // Without a replica, every node resolves to the primary resource.
+  EXPECT_EQ(registry.Get(handle, 0), primary);
+  EXPECT_EQ(registry.Get(handle, 1), primary);
+  EXPECT_EQ(registry.Get(handle, ozz::memory::Allocator::kAnyNode), primary);
+
+  // Duplicates on node 1.
+  ozz::unique_ptr<Animation> replica = BuildTestAnimation(1.f);
+  const Animation* raw_replica = replica.get();
+  EXPECT_TRUE(registry.Duplicate(handle, 1, std::move(replica)));
+
+  // Node 1 resolves to its replica, other nodes still get the primary.
+  EXPECT_EQ(registry.Get(handle, 1), raw_replica);
+  EXPECT_EQ(registry.Get(handle, 0), primary);
+  EXPECT_EQ(registry.Get(handle, ozz::memory::Allocator::kAnyNode), primary);
+  EXPECT_EQ(registry.Get(handle), primary);
+
+  // Local resolution follows the thread's declared node.
+  const int previous_node = ozz::animation::SetThreadNumaNode(1);
+  EXPECT_EQ(ozz::animation::ThreadNumaNode(), 1);
+  EXPECT_EQ(registry.GetLocal(handle), raw_replica);
+  ozz::animation::SetThreadNumaNode(0);
+  EXPECT_EQ(registry.GetLocal(handle), primary);
+  ozz::animation::SetThreadNumaNode(previous_node);
+  EXPECT_EQ(registry.GetLocal(handle), primary);
+
+  // Duplicating again swaps the replica, retiring the previous one.
+  ozz::unique_ptr<Animation> replica2 = BuildTestAnimation(1.f);
+  const Animation* raw_replica2 = replica2.get();
+  EXPECT_TRUE(registry.Duplicate(handle, 1, std::move(replica2)));
+  EXPECT_EQ(registry.Get(handle, 1), raw_replica2);
+  registry.Collect();
+  registry.Collect();
+  EXPECT_EQ(registry.Get(handle, 1), raw_replica2);
+}
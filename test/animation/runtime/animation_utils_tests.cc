@@ -27,6 +27,8 @@
 
 #include "ozz/animation/runtime/animation_utils.h"
 
+#include <cstring>
+
 #include "gtest/gtest.h"
 #include "ozz/base/maths/gtest_math_helper.h"
 
@@ -34,6 +36,9 @@
 
 #include "ozz/animation/offline/animation_builder.h"
 #include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/maths/soa_transform.h"
 
 using ozz::animation::Animation;
 using ozz::animation::offline::RawAnimation;
@@ -83,3 +88,263 @@ TEST(CountKeyframes, AnimationUtils) {
   EXPECT_EQ(ozz::animation::CountScaleKeyframes(*animation, 0), 2);
   EXPECT_EQ(ozz::animation::CountScaleKeyframes(*animation, 1), 2);
 }
+
+TEST(MemoryProfile, AnimationUtils) {
+  // Builds a valid animation.
+  ozz::unique_ptr<Animation> animation;
+
+  {
+    RawAnimation raw_animation;
+    raw_animation.duration = 1.f;
+    raw_animation.tracks.resize(2);
+
+    RawAnimation::TranslationKey t_key0 = {0.f,
+                                           ozz::math::Float3(93.f, 58.f, 46.f)};
+    raw_animation.tracks[0].translations.push_back(t_key0);
+    RawAnimation::TranslationKey t_key1 = {.9f,
+                                           ozz::math::Float3(46.f, 58.f, 93.f)};
+    raw_animation.tracks[0].translations.push_back(t_key1);
+    RawAnimation::TranslationKey t_key2 = {1.f,
+                                           ozz::math::Float3(46.f, 58.f, 99.f)};
+    raw_animation.tracks[0].translations.push_back(t_key2);
+
+    RawAnimation::RotationKey r_key = {
+        0.7f, ozz::math::Quaternion(0.f, 1.f, 0.f, 0.f)};
+    raw_animation.tracks[0].rotations.push_back(r_key);
+
+    RawAnimation::ScaleKey s_key = {0.1f, ozz::math::Float3(99.f, 26.f, 14.f)};
+    raw_animation.tracks[1].scales.push_back(s_key);
+
+    AnimationBuilder builder;
+    animation = builder(raw_animation);
+    ASSERT_TRUE(animation);
+  }
+
+  ozz::animation::MemoryProfile profile;
+  ozz::animation::ProfileMemory(*animation, &profile);
+
+  EXPECT_EQ(profile.animations, 1u);
+  EXPECT_EQ(profile.size, animation->size());
+
+  // Keyframe counts match CountKeyframes utilities, soa padding included.
+  EXPECT_EQ(profile.translations.keyframes, 9u);
+  EXPECT_EQ(profile.rotations.keyframes, 8u);
+  EXPECT_EQ(profile.scales.keyframes, 8u);
+
+  // Per track keyframes, 4 tracks due to SoA.
+  ASSERT_EQ(profile.translations.track_keyframes.size(), 4u);
+  EXPECT_EQ(profile.translations.track_keyframes[0], 3u);
+  EXPECT_EQ(profile.translations.track_keyframes[1], 2u);
+  EXPECT_EQ(profile.translations.track_keyframes[2], 2u);
+  EXPECT_EQ(profile.translations.track_keyframes[3], 2u);
+
+  // All keyframes are distributed over the time histogram.
+  ASSERT_EQ(profile.translations.time_histogram.size(),
+            static_cast<size_t>(ozz::animation::MemoryProfile::kTimeBuckets));
+  size_t histogram_sum = 0;
+  for (size_t count : profile.translations.time_histogram) {
+    histogram_sum += count;
+  }
+  EXPECT_EQ(histogram_sum, profile.translations.keyframes);
+  // Translation keys lie at ratios 0 (x4), .9 (x1) and 1 (x4).
+  EXPECT_EQ(profile.translations.time_histogram[0], 4u);
+  EXPECT_EQ(profile.translations.time_histogram[9], 5u);
+
+  // Compressed translation values are 3 half floats per keyframe.
+  EXPECT_EQ(profile.translations.values_size,
+            profile.translations.keyframes * 3 * sizeof(uint16_t));
+  EXPECT_EQ(profile.translations.size(),
+            profile.translations.values_size +
+                animation->translations_ctrl().size_bytes());
+
+  // Compression gains over raw keyframes.
+  EXPECT_GT(profile.raw_size, 0u);
+  EXPECT_GT(profile.compression_ratio(), 1.f);
+
+  // Aggregating the same animation again doubles every figure.
+  ozz::animation::ProfileMemory(*animation, &profile);
+  EXPECT_EQ(profile.animations, 2u);
+  EXPECT_EQ(profile.size, animation->size() * 2);
+  EXPECT_EQ(profile.translations.keyframes, 18u);
+  EXPECT_EQ(profile.translations.track_keyframes[0], 6u);
+}
+
+TEST(FixedRatio, AnimationUtils) {
+  using ozz::animation::kFixedRatioOne;
+
+  {  // Conversions to float are exact for remarkable values.
+    EXPECT_EQ(ozz::animation::FixedRatioToFloat(0), 0.f);
+    EXPECT_EQ(ozz::animation::FixedRatioToFloat(kFixedRatioOne / 4), .25f);
+    EXPECT_EQ(ozz::animation::FixedRatioToFloat(kFixedRatioOne / 2), .5f);
+    EXPECT_EQ(ozz::animation::FixedRatioToFloat(kFixedRatioOne), 1.f);
+  }
+
+  {  // Round trips from float and back.
+    EXPECT_EQ(ozz::animation::FloatToFixedRatio(0.f), 0u);
+    EXPECT_EQ(ozz::animation::FloatToFixedRatio(.5f), kFixedRatioOne / 2);
+    EXPECT_EQ(ozz::animation::FloatToFixedRatio(1.f), kFixedRatioOne);
+
+    // Out of range ratios are clamped.
+    EXPECT_EQ(ozz::animation::FloatToFixedRatio(-1.f), 0u);
+    EXPECT_EQ(ozz::animation::FloatToFixedRatio(46.f), kFixedRatioOne);
+  }
+
+  {  // Saturated stepping.
+    EXPECT_EQ(ozz::animation::StepFixedRatio(0, 100, false), 100u);
+    EXPECT_EQ(ozz::animation::StepFixedRatio(100, -46, false), 54u);
+
+    // Saturates at both range bounds.
+    EXPECT_EQ(ozz::animation::StepFixedRatio(100, -200, false), 0u);
+    EXPECT_EQ(ozz::animation::StepFixedRatio(kFixedRatioOne - 1, 2, false),
+              kFixedRatioOne);
+    EXPECT_EQ(ozz::animation::StepFixedRatio(kFixedRatioOne, 0, false),
+              kFixedRatioOne);
+  }
+
+  {  // Looping stepping wraps into [0, kFixedRatioOne[.
+    EXPECT_EQ(ozz::animation::StepFixedRatio(0, 100, true), 100u);
+    EXPECT_EQ(ozz::animation::StepFixedRatio(kFixedRatioOne - 1, 2, true), 1u);
+    EXPECT_EQ(ozz::animation::StepFixedRatio(100, -200, true),
+              kFixedRatioOne - 100);
+    EXPECT_EQ(ozz::animation::StepFixedRatio(kFixedRatioOne, 0, true), 0u);
+  }
+
+  {  // Integer accumulation is exact: stepping any number of equal deltas
+    // lands on the same tick whatever the grouping, which is what float
+    // accumulation cannot guarantee.
+    uint32_t ones = 0;
+    for (int i = 0; i < 100; ++i) {
+      ones = ozz::animation::StepFixedRatio(ones, 3, true);
+    }
+    EXPECT_EQ(ones, ozz::animation::StepFixedRatio(0, 300, true));
+  }
+}
+
+TEST(UpdateScheduler, AnimationUtils) {
+  ozz::animation::UpdateScheduler scheduler;
+  EXPECT_EQ(scheduler.num_instances(), 0);
+
+  int updates[4] = {};
+
+  {  // No instance, nothing to collect.
+    EXPECT_EQ(scheduler.Update(1.f, updates), 0);
+  }
+
+  scheduler.Resize(3, .1f);
+  EXPECT_EQ(scheduler.num_instances(), 3);
+  EXPECT_FLOAT_EQ(scheduler.period(1), .1f);
+
+  {  // Every instance is due right after a resize.
+    EXPECT_EQ(scheduler.Update(0.f, updates), 3);
+    EXPECT_FLOAT_EQ(scheduler.Alpha(0), 0.f);
+  }
+
+  {  // None is due before its period elapsed, alpha exposes staleness.
+    EXPECT_EQ(scheduler.Update(.06f, updates), 0);
+    EXPECT_FLOAT_EQ(scheduler.Alpha(0), .6f);
+    EXPECT_EQ(scheduler.Update(.06f, updates), 3);
+  }
+
+  // Different periods spread updates across frames.
+  scheduler.set_period(0, .05f);
+  scheduler.set_period(1, .1f);
+  scheduler.set_period(2, .2f);
+  EXPECT_FLOAT_EQ(scheduler.period(2), .2f);
+
+  {  // Only instance 0 (smallest period) is due after .05s.
+    EXPECT_EQ(scheduler.Update(.05f, updates), 1);
+    EXPECT_EQ(updates[0], 0);
+  }
+
+  {  // Most stale instances come first: 1 (.1s stale) before 0 (.05s).
+    EXPECT_EQ(scheduler.Update(.05f, updates), 2);
+    EXPECT_EQ(updates[0], 1);
+    EXPECT_EQ(updates[1], 0);
+  }
+
+  {  // An exhausted budget serves the most stale instance and postpones the
+     // others, which remain due.
+    EXPECT_EQ(scheduler.Update(.1f, {updates, updates + 1}), 1);
+    EXPECT_EQ(updates[0], 2);
+    EXPECT_FLOAT_EQ(scheduler.Alpha(2), 0.f);
+    // Alpha saturates to 1 for over-stale instances.
+    EXPECT_FLOAT_EQ(scheduler.Alpha(0), 1.f);
+    EXPECT_EQ(scheduler.Update(0.f, updates), 2);
+    EXPECT_EQ(updates[0] + updates[1], 1);  // Instances 0 and 1, any order.
+  }
+
+  {  // A zero period instance is due on every update.
+    scheduler.set_period(2, 0.f);
+    EXPECT_FLOAT_EQ(scheduler.Alpha(2), 1.f);
+    EXPECT_EQ(scheduler.Update(0.f, updates), 1);
+    EXPECT_EQ(updates[0], 2);
+  }
+}
+
+TEST(SampleAnimation, AnimationUtils) {
+  // Builds a valid animation.
+  ozz::unique_ptr<Animation> animation;
+  {
+    RawAnimation raw_animation;
+    raw_animation.duration = 1.f;
+    raw_animation.tracks.resize(2);
+    const RawAnimation::TranslationKey t_key0 = {
+        0.f, ozz::math::Float3(93.f, 58.f, 46.f)};
+    raw_animation.tracks[0].translations.push_back(t_key0);
+    const RawAnimation::TranslationKey t_key1 = {
+        1.f, ozz::math::Float3(46.f, 58.f, 93.f)};
+    raw_animation.tracks[0].translations.push_back(t_key1);
+
+    AnimationBuilder builder;
+    animation = builder(raw_animation);
+    ASSERT_TRUE(animation);
+  }
+
+  {  // Empty output is invalid.
+    EXPECT_FALSE(ozz::animation::SampleAnimation(*animation, 0.f, {}));
+  }
+
+  // Stateless sampling matches a stateful sampling job, whatever the access
+  // pattern.
+  ozz::animation::SamplingJob::Context context(animation->num_tracks());
+  const float ratios[] = {.7f, 0.f, .31f, 1.f, .29f};
+  for (size_t i = 0; i < OZZ_ARRAY_SIZE(ratios); ++i) {
+    ozz::math::SoaTransform reference;
+    ozz::animation::SamplingJob job;
+    job.animation = animation.get();
+    job.context = &context;
+    job.ratio = ratios[i];
+    job.output = {&reference, 1};
+    ASSERT_TRUE(job.Run());
+
+    ozz::math::SoaTransform output;
+    ASSERT_TRUE(
+        ozz::animation::SampleAnimation(*animation, ratios[i], {&output, 1}));
+    EXPECT_EQ(std::memcmp(&output, &reference, sizeof(output)), 0);
+  }
+
+  {  // Caller-provided buffer overload.
+    const size_t size = ozz::animation::SamplingJob::Context::RequiredSize(
+        animation->num_tracks());
+    ozz::vector<ozz::math::SimdFloat4> buffer(
+        (size + sizeof(ozz::math::SimdFloat4) - 1) /
+        sizeof(ozz::math::SimdFloat4));
+    const ozz::span<ozz::byte> buffer_span = {
+        reinterpret_cast<ozz::byte*>(buffer.data()), size};
+
+    // Too small or misaligned buffers are rejected.
+    ozz::math::SoaTransform output;
+    EXPECT_FALSE(ozz::animation::SampleAnimation(*animation, .5f, {&output, 1},
+                                                 buffer_span.first(size - 1)));
+    EXPECT_FALSE(ozz::animation::SampleAnimation(
+        *animation, .5f, {&output, 1},
+        {buffer_span.data() + 1, buffer_span.size() - 1}));
+
+    ozz::math::SoaTransform reference;
+    ASSERT_TRUE(
+        ozz::animation::SampleAnimation(*animation, .31f, {&reference, 1}));
+    ASSERT_TRUE(ozz::animation::SampleAnimation(*animation, .31f, {&output, 1},
+                                                buffer_span));
+    EXPECT_EQ(std::memcmp(&output, &reference, sizeof(output)), 0);
+  }
+}
@@ -0,0 +1,133 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/asset_prefaulter.h"
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/animation_builder.h"
+#include "ozz/animation/offline/paged_animation_builder.h"
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/animation/runtime/paged_animation.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+using ozz::animation::Animation;
+using ozz::animation::AssetPrefaulter;
+using ozz::animation::PagedAnimation;
+using ozz::animation::offline::AnimationBuilder;
+using ozz::animation::offline::PagedAnimationBuilder;
+using ozz::animation::offline::RawAnimation;
+
+TEST(Validity, AssetPrefaulter) {
+  AssetPrefaulter prefaulter;
+
+  // The invalid ticket is always done, so gating on it can't deadlock.
+  EXPECT_TRUE(prefaulter.IsDone(AssetPrefaulter::kInvalidTicket));
+
+  // An empty buffer is refused.
+  EXPECT_EQ(prefaulter.Warm(ozz::span<const ozz::byte>()),
+            AssetPrefaulter::kInvalidTicket);
+}
+
+TEST(Warm, AssetPrefaulter) {
+  // Warms the raw image of a built animation, as a mapped loading scenario
+  // would.
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(16);
+
+  AnimationBuilder builder;
+  ozz::unique_ptr<Animation> animation = builder(raw_animation);
+  ASSERT_TRUE(animation);
+
+  ozz::vector<ozz::byte> image(animation->raw_size());
+  ASSERT_TRUE(animation->SaveRaw(ozz::make_span(image)));
+
+  AssetPrefaulter prefaulter;
+  const AssetPrefaulter::Ticket first =
+      prefaulter.Warm(ozz::span<const ozz::byte>(ozz::make_span(image)));
+  const AssetPrefaulter::Ticket second =
+      prefaulter.Warm(ozz::span<const ozz::byte>(ozz::make_span(image)));
+  EXPECT_NE(first, AssetPrefaulter::kInvalidTicket);
+  EXPECT_NE(second, AssetPrefaulter::kInvalidTicket);
+
+  // Tickets complete in issuing order: the second done implies the first is.
+  prefaulter.Wait(second);
+  EXPECT_TRUE(prefaulter.IsDone(second));
+  EXPECT_TRUE(prefaulter.IsDone(first));
+  prefaulter.Wait(first);
+}
+
+TEST(Paged, AssetPrefaulter) {
+  // Builds a 4s clip paged at 1s, aka 4 pages.
+  RawAnimation raw_animation;
+  raw_animation.duration = 4.f;
+  raw_animation.tracks.resize(1);
+  const RawAnimation::TranslationKey key = {0.f, ozz::math::Float3::x_axis()};
+  raw_animation.tracks[0].translations.push_back(key);
+
+  PagedAnimationBuilder builder;
+  builder.page_duration = 1.f;
+  ozz::unique_ptr<PagedAnimation> paged = builder(raw_animation);
+  ASSERT_TRUE(paged);
+  ASSERT_EQ(paged->num_pages(), 4u);
+
+  // Stands for the mapped byte range backing each page.
+  ozz::vector<ozz::byte> backing(paged->num_pages() * 8192);
+  ozz::vector<ozz::span<const ozz::byte>> page_buffers;
+  for (size_t i = 0; i < paged->num_pages(); ++i) {
+    page_buffers.push_back(
+        ozz::span<const ozz::byte>(backing.data() + i * 8192, 8192));
+  }
+
+  AssetPrefaulter prefaulter;
+
+  {  // One buffer per page is required.
+    const AssetPrefaulter::Ticket ticket = prefaulter.Warm(
+        *paged, ozz::make_span(page_buffers).first(2), .5f, 1.f);
+    EXPECT_EQ(ticket, AssetPrefaulter::kInvalidTicket);
+  }
+
+  {  // Warms the 2 first playback seconds, from mid clip and wrapping over
+     // the clip end.
+    const AssetPrefaulter::Ticket ticket =
+        prefaulter.Warm(*paged, ozz::make_span(page_buffers), .9f, 2.f);
+    EXPECT_NE(ticket, AssetPrefaulter::kInvalidTicket);
+    prefaulter.Wait(ticket);
+    EXPECT_TRUE(prefaulter.IsDone(ticket));
+  }
+
+  {  // A whole clip warm-up.
+    const AssetPrefaulter::Ticket ticket =
+        prefaulter.Warm(*paged, ozz::make_span(page_buffers), 0.f,
+                        paged->duration());
+    EXPECT_NE(ticket, AssetPrefaulter::kInvalidTicket);
+    prefaulter.Wait(ticket);
+    EXPECT_TRUE(prefaulter.IsDone(ticket));
+  }
+}
@@ -0,0 +1,249 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/batch_partitioner.h"
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/animation_builder.h"
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/offline/raw_skeleton.h"
+#include "ozz/animation/offline/skeleton_builder.h"
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/animation/runtime/local_to_model_job.h"
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/maths/gtest_math_helper.h"
+#include "ozz/base/maths/simd_math.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+using ozz::animation::Animation;
+using ozz::animation::BatchPartitioner;
+using ozz::animation::LocalToModelBucketJob;
+using ozz::animation::LocalToModelJob;
+using ozz::animation::SamplingBucketJob;
+using ozz::animation::SamplingJob;
+using ozz::animation::Skeleton;
+using ozz::animation::offline::AnimationBuilder;
+using ozz::animation::offline::RawAnimation;
+using ozz::animation::offline::RawSkeleton;
+using ozz::animation::offline::SkeletonBuilder;
+
+namespace {
+
+// Builds a chain skeleton of _num_joints joints.
+ozz::unique_ptr<Skeleton> BuildChainSkeleton(int _num_joints) {
+  RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  RawSkeleton::Joint* joint = &raw_skeleton.roots[0];
+  joint->name = "j0";
+  for (int i = 1; i < _num_joints; ++i) {
+    joint->children.resize(1);
+    joint = &joint->children[0];
+    joint->name = "j";
+    joint->name += static_cast<char>('0' + i % 10);
+  }
+  SkeletonBuilder builder;
+  return builder(raw_skeleton);
+}
+
+// Builds a 1s animation for _skeleton, translating every joint from 0 to
+// _amplitude on x.
+ozz::unique_ptr<Animation> BuildAnimation(const Skeleton& _skeleton,
+                                          float _amplitude) {
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(_skeleton.num_joints());
+  for (size_t i = 0; i < raw_animation.tracks.size(); ++i) {
+    const RawAnimation::TranslationKey key0 = {0.f,
+                                               ozz::math::Float3(0.f, 0.f, 0.f)};
+    const RawAnimation::TranslationKey key1 = {
+        1.f, ozz::math::Float3(_amplitude, 0.f, 0.f)};
+    raw_animation.tracks[i].translations.push_back(key0);
+    raw_animation.tracks[i].translations.push_back(key1);
+  }
+  AnimationBuilder builder;
+  return builder(raw_animation);
+}
+}  // namespace
+
+TEST(Partition, BatchPartitioner) {
+  ozz::unique_ptr<Skeleton> small = BuildChainSkeleton(4);
+  ozz::unique_ptr<Skeleton> big = BuildChainSkeleton(9);
+  ozz::unique_ptr<Animation> small_walk = BuildAnimation(*small, 1.f);
+  ozz::unique_ptr<Animation> small_run = BuildAnimation(*small, 2.f);
+  ozz::unique_ptr<Animation> big_walk = BuildAnimation(*big, 3.f);
+
+  BatchPartitioner partitioner;
+
+  {  // Mismatched range sizes emit no bucket.
+    const Skeleton* skeletons[] = {small.get(), big.get()};
+    const Animation* animations[] = {small_walk.get()};
+    EXPECT_TRUE(partitioner
+                    .Partition(ozz::make_span(skeletons),
+                               {animations, OZZ_ARRAY_SIZE(animations)})
+                    .empty());
+  }
+
+  {  // Empty input emits no bucket.
+    EXPECT_TRUE(partitioner.Partition({}, {}).empty());
+    EXPECT_TRUE(partitioner.indices().empty());
+  }
+
+  // Interleaved instances of 3 (skeleton, animation) pairs.
+  const Skeleton* skeletons[] = {small.get(), big.get(), small.get(),
+                                 small.get(), big.get(), small.get()};
+  const Animation* animations[] = {small_walk.get(), big_walk.get(),
+                                   small_run.get(),  small_walk.get(),
+                                   big_walk.get(),   small_walk.get()};
+  const ozz::span<const BatchPartitioner::Bucket> buckets =
+      partitioner.Partition(ozz::make_span(skeletons),
+                            ozz::make_span(animations));
+  ASSERT_EQ(buckets.size(), 3u);
+
+  // Buckets cover all instances, each with a coherent key.
+  const ozz::span<const int> indices = partitioner.indices();
+  ASSERT_EQ(indices.size(), OZZ_ARRAY_SIZE(skeletons));
+  int covered = 0;
+  for (size_t b = 0; b < buckets.size(); ++b) {
+    const BatchPartitioner::Bucket& bucket = buckets[b];
+    covered += bucket.count;
+    for (int i = 0; i < bucket.count; ++i) {
+      const int index = indices[bucket.begin + i];
+      EXPECT_EQ(skeletons[index], bucket.skeleton);
+      EXPECT_EQ(animations[index], bucket.animation);
+      // Instances keep their relative order within a bucket.
+      if (i != 0) {
+        EXPECT_LT(indices[bucket.begin + i - 1], index);
+      }
+    }
+  }
+  EXPECT_EQ(covered, static_cast<int>(OZZ_ARRAY_SIZE(skeletons)));
+}
+
+TEST(BucketJobs, BatchPartitioner) {
+  ozz::unique_ptr<Skeleton> small = BuildChainSkeleton(4);
+  ozz::unique_ptr<Skeleton> big = BuildChainSkeleton(9);
+  ozz::unique_ptr<Animation> small_walk = BuildAnimation(*small, 1.f);
+  ozz::unique_ptr<Animation> big_walk = BuildAnimation(*big, 3.f);
+
+  const size_t kNumInstances = 100;
+  const Skeleton* skeletons[kNumInstances];
+  const Animation* animations[kNumInstances];
+  float ratios[kNumInstances];
+  ozz::vector<ozz::vector<ozz::math::SoaTransform>> locals(kNumInstances);
+  ozz::vector<ozz::vector<ozz::math::Float4x4>> models(kNumInstances);
+  ozz::vector<SamplingJob::Context> contexts(kNumInstances);
+  SamplingJob::Context* context_ptrs[kNumInstances];
+  ozz::span<ozz::math::SoaTransform> local_spans[kNumInstances];
+  // The small skeleton bucket holds 80 instances, crossing the internal
+  // gather chunk size.
+  ozz::span<const ozz::math::SoaTransform> const_local_spans[kNumInstances];
+  ozz::span<ozz::math::Float4x4> model_spans[kNumInstances];
+  for (size_t i = 0; i < kNumInstances; ++i) {
+    const bool is_big = i % 5 == 0;
+    const Skeleton* skeleton = is_big ? big.get() : small.get();
+    skeletons[i] = skeleton;
+    animations[i] = is_big ? big_walk.get() : small_walk.get();
+    ratios[i] = static_cast<float>(i) / kNumInstances;
+    locals[i].resize(skeleton->num_soa_joints());
+    models[i].resize(skeleton->num_joints());
+    contexts[i].Resize(skeleton->num_joints());
+    context_ptrs[i] = &contexts[i];
+    local_spans[i] = ozz::make_span(locals[i]);
+    const_local_spans[i] = local_spans[i];
+    model_spans[i] = ozz::make_span(models[i]);
+  }
+
+  BatchPartitioner partitioner;
+  const ozz::span<const BatchPartitioner::Bucket> buckets =
+      partitioner.Partition(ozz::make_span(skeletons),
+                            ozz::make_span(animations));
+  ASSERT_EQ(buckets.size(), 2u);
+
+  {  // An invalid bucket fails validation.
+    SamplingBucketJob job;
+    EXPECT_FALSE(job.Validate());
+    job.bucket = &buckets[0];
+    job.indices = partitioner.indices();
+    job.ratios = ozz::make_span(ratios);
+    job.contexts = ozz::make_span(context_ptrs);
+    // Output range count mismatch.
+    job.outputs = {local_spans, kNumInstances - 1};
+    EXPECT_FALSE(job.Validate());
+    job.outputs = ozz::make_span(local_spans);
+    EXPECT_TRUE(job.Validate());
+  }
+
+  // Samples and converts every instance, bucket per bucket.
+  for (size_t b = 0; b < buckets.size(); ++b) {
+    SamplingBucketJob sampling;
+    sampling.bucket = &buckets[b];
+    sampling.indices = partitioner.indices();
+    sampling.ratios = ozz::make_span(ratios);
+    sampling.contexts = ozz::make_span(context_ptrs);
+    sampling.outputs = ozz::make_span(local_spans);
+    EXPECT_TRUE(sampling.Run());
+
+    LocalToModelBucketJob local_to_model;
+    local_to_model.bucket = &buckets[b];
+    local_to_model.indices = partitioner.indices();
+    local_to_model.inputs = ozz::make_span(const_local_spans);
+    local_to_model.outputs = ozz::make_span(model_spans);
+    EXPECT_TRUE(local_to_model.Run());
+  }
+
+  // Every instance matches the single-instance job pipeline.
+  for (size_t i = 0; i < kNumInstances; ++i) {
+    const Skeleton* skeleton = skeletons[i];
+    ozz::vector<ozz::math::SoaTransform> ref_locals(
+        skeleton->num_soa_joints());
+    ozz::vector<ozz::math::Float4x4> ref_models(skeleton->num_joints());
+    SamplingJob::Context context(skeleton->num_joints());
+    SamplingJob sampling;
+    sampling.animation = animations[i];
+    sampling.context = &context;
+    sampling.ratio = ratios[i];
+    sampling.output = ozz::make_span(ref_locals);
+    ASSERT_TRUE(sampling.Run());
+    LocalToModelJob local_to_model;
+    local_to_model.skeleton = skeleton;
+    local_to_model.input = ozz::make_span(ref_locals);
+    local_to_model.output = ozz::make_span(ref_models);
+    ASSERT_TRUE(local_to_model.Run());
+
+    EXPECT_EQ(std::memcmp(locals[i].data(), ref_locals.data(),
+                          ref_locals.size() * sizeof(ref_locals[0])),
+              0);
+    EXPECT_EQ(std::memcmp(models[i].data(), ref_models.data(),
+                          ref_models.size() * sizeof(ref_models[0])),
+              0);
+  }
+}
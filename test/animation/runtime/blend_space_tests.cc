@@ -0,0 +1,192 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/blend_space.h"
+
+#include "gtest/gtest.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/platform.h"
+#include "ozz/base/span.h"
+
+using ozz::animation::BlendSpace;
+using ozz::animation::BlendingJob;
+using ozz::math::Float2;
+
+TEST(Validity, BlendSpace) {
+  {  // An empty 1d space is invalid.
+    const BlendSpace space{ozz::span<const float>()};
+    EXPECT_FALSE(space.valid());
+  }
+  {  // Duplicated 1d coordinates are invalid.
+    const float coordinates[] = {0.f, 1.f, 1.f};
+    const BlendSpace space{ozz::make_span(coordinates)};
+    EXPECT_FALSE(space.valid());
+  }
+  {  // Too few 2d points are invalid.
+    const Float2 coordinates[] = {Float2(0.f, 0.f), Float2(1.f, 0.f)};
+    const BlendSpace space{ozz::make_span(coordinates)};
+    EXPECT_FALSE(space.valid());
+  }
+  {  // Collinear 2d points are invalid.
+    const Float2 coordinates[] = {Float2(0.f, 0.f), Float2(1.f, 1.f),
+                                  Float2(2.f, 2.f)};
+    const BlendSpace space{ozz::make_span(coordinates)};
+    EXPECT_FALSE(space.valid());
+  }
+  {  // Duplicated 2d points are invalid.
+    const Float2 coordinates[] = {Float2(0.f, 0.f), Float2(1.f, 0.f),
+                                  Float2(0.f, 1.f), Float2(1.f, 0.f)};
+    const BlendSpace space{ozz::make_span(coordinates)};
+    EXPECT_FALSE(space.valid());
+  }
+  {  // Sampling with a mismatched weight count fails.
+    const float coordinates[] = {0.f, 1.f};
+    const BlendSpace space{ozz::make_span(coordinates)};
+    EXPECT_TRUE(space.valid());
+    float weights[3];
+    EXPECT_FALSE(space.Sample(Float2(0.f, 0.f), ozz::make_span(weights)));
+  }
+}
+
+TEST(Sample1d, BlendSpace) {
+  // Unsorted coordinates, weights are still matched in construction order.
+  const float coordinates[] = {1.f, 0.f, 3.f};
+  const BlendSpace space{ozz::make_span(coordinates)};
+  ASSERT_TRUE(space.valid());
+  EXPECT_EQ(space.num_points(), 3);
+
+  float weights[3];
+  BlendSpace::Cursor cursor;
+
+  // Midway between clips 1 (at 0) and 0 (at 1).
+  ASSERT_TRUE(
+      space.Sample(Float2(.5f, 0.f), ozz::make_span(weights), &cursor));
+  EXPECT_FLOAT_EQ(weights[0], .5f);
+  EXPECT_FLOAT_EQ(weights[1], .5f);
+  EXPECT_FLOAT_EQ(weights[2], 0.f);
+
+  // Quarter of the way between clips 0 (at 1) and 2 (at 3).
+  ASSERT_TRUE(
+      space.Sample(Float2(1.5f, 0.f), ozz::make_span(weights), &cursor));
+  EXPECT_FLOAT_EQ(weights[0], .75f);
+  EXPECT_FLOAT_EQ(weights[1], 0.f);
+  EXPECT_FLOAT_EQ(weights[2], .25f);
+
+  // Parameters outside the space are clamped to its boundary.
+  ASSERT_TRUE(
+      space.Sample(Float2(-46.f, 0.f), ozz::make_span(weights), &cursor));
+  EXPECT_FLOAT_EQ(weights[1], 1.f);
+  ASSERT_TRUE(
+      space.Sample(Float2(99.f, 0.f), ozz::make_span(weights), &cursor));
+  EXPECT_FLOAT_EQ(weights[2], 1.f);
+
+  {  // A single clip space always returns a full weight.
+    const float single[] = {2.f};
+    const BlendSpace single_space{ozz::make_span(single)};
+    ASSERT_TRUE(single_space.valid());
+    float weight[1];
+    ASSERT_TRUE(single_space.Sample(Float2(-1.f, 0.f),
+                                    ozz::make_span(weight)));
+    EXPECT_FLOAT_EQ(weight[0], 1.f);
+  }
+}
+
+TEST(Sample2d, BlendSpace) {
+  // 3x3 directional locomotion grid, a 9 clips blend space.
+  ozz::vector<Float2> coordinates;
+  for (int y = 0; y < 3; ++y) {
+    for (int x = 0; x < 3; ++x) {
+      coordinates.push_back(
+          Float2(static_cast<float>(x - 1), static_cast<float>(y - 1)));
+    }
+  }
+  const BlendSpace space{ozz::make_span(coordinates)};
+  ASSERT_TRUE(space.valid());
+  ASSERT_EQ(space.num_points(), 9);
+
+  float weights[9];
+  BlendSpace::Cursor cursor;
+
+  {  // A clip coordinate gets the full weight.
+    ASSERT_TRUE(
+        space.Sample(Float2(1.f, -1.f), ozz::make_span(weights), &cursor));
+    for (int i = 0; i < 9; ++i) {
+      EXPECT_NEAR(weights[i], i == 2 ? 1.f : 0.f, 1e-5f);
+    }
+  }
+
+  // Inside the hull, weights are convex and reproduce the parameter: the
+  // weighted sum of clip coordinates is the parameter itself. Successive
+  // nearby parameters also exercise the coherent cursor path.
+  const Float2 parameters[] = {Float2(.1f, .2f), Float2(.15f, .25f),
+                               Float2(-.6f, .3f), Float2(-.62f, .28f),
+                               Float2(.9f, -.85f), Float2(0.f, 0.f)};
+  for (size_t p = 0; p < OZZ_ARRAY_SIZE(parameters); ++p) {
+    ASSERT_TRUE(
+        space.Sample(parameters[p], ozz::make_span(weights), &cursor));
+    float sum = 0.f;
+    Float2 reconstructed(0.f, 0.f);
+    int contributions = 0;
+    for (int i = 0; i < 9; ++i) {
+      EXPECT_GE(weights[i], 0.f);
+      sum += weights[i];
+      reconstructed.x += weights[i] * coordinates[i].x;
+      reconstructed.y += weights[i] * coordinates[i].y;
+      contributions += weights[i] != 0.f;
+    }
+    EXPECT_NEAR(sum, 1.f, 1e-5f);
+    EXPECT_NEAR(reconstructed.x, parameters[p].x, 1e-5f);
+    EXPECT_NEAR(reconstructed.y, parameters[p].y, 1e-5f);
+    EXPECT_LE(contributions, 3);
+  }
+
+  {  // Parameters outside the hull are clamped to its boundary.
+    ASSERT_TRUE(
+        space.Sample(Float2(10.f, .5f), ozz::make_span(weights), &cursor));
+    float sum = 0.f;
+    Float2 reconstructed(0.f, 0.f);
+    for (int i = 0; i < 9; ++i) {
+      sum += weights[i];
+      reconstructed.x += weights[i] * coordinates[i].x;
+      reconstructed.y += weights[i] * coordinates[i].y;
+    }
+    EXPECT_NEAR(sum, 1.f, 1e-5f);
+    EXPECT_NEAR(reconstructed.x, 1.f, 1e-5f);
+    EXPECT_NEAR(reconstructed.y, .5f, 1e-5f);
+  }
+
+  {  // The layer overload writes weights straight to BlendingJob layers.
+    BlendingJob::Layer layers[9];
+    ASSERT_TRUE(space.Sample(Float2(0.f, -1.f), ozz::make_span(layers)));
+    float sum = 0.f;
+    for (int i = 0; i < 9; ++i) {
+      sum += layers[i].weight;
+    }
+    EXPECT_NEAR(sum, 1.f, 1e-5f);
+    EXPECT_NEAR(layers[1].weight, 1.f, 1e-5f);
+  }
+}
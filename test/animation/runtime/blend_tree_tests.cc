@@ -0,0 +1,180 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/raw_skeleton.h"
+#include "ozz/animation/offline/skeleton_builder.h"
+#include "ozz/animation/runtime/blend_tree.h"
+#include "ozz/animation/runtime/blending_job.h"
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/maths/gtest_math_helper.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+using ozz::animation::BlendTree;
+using ozz::animation::BlendingJob;
+using ozz::animation::Skeleton;
+using ozz::animation::offline::RawSkeleton;
+using ozz::animation::offline::SkeletonBuilder;
+
+namespace {
+// Builds a 2 joints skeleton, enough for a single soa block.
+ozz::unique_ptr<Skeleton> BuildSkeleton() {
+  RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  raw_skeleton.roots[0].name = "root";
+  raw_skeleton.roots[0].children.resize(1);
+  raw_skeleton.roots[0].children[0].name = "child";
+  SkeletonBuilder builder;
+  return builder(raw_skeleton);
+}
+}  // namespace
+
+TEST(Validity, BlendTree) {
+  ozz::unique_ptr<Skeleton> skeleton = BuildSkeleton();
+  const ozz::math::SoaTransform identity = ozz::math::SoaTransform::identity();
+  const ozz::math::SoaTransform input_transforms[1] = {identity};
+  ozz::math::SoaTransform output_transforms[1] = {identity};
+
+  BlendTree::Input inputs[1];
+  inputs[0].transform = input_transforms;
+
+  {  // Invalid threshold.
+    BlendTree tree(*skeleton, inputs, 0.f);
+    EXPECT_FALSE(tree.valid());
+    const float weights[1] = {1.f};
+    EXPECT_FALSE(tree.Run(weights, output_transforms));
+  }
+
+  {  // Input buffer smaller than the rest pose.
+    BlendTree::Input small_inputs[1];
+    small_inputs[0].transform = {input_transforms, input_transforms};
+    BlendTree tree(*skeleton, small_inputs);
+    EXPECT_FALSE(tree.valid());
+  }
+
+  {  // Valid tree, invalid evaluation arguments.
+    BlendTree tree(*skeleton, inputs);
+    EXPECT_TRUE(tree.valid());
+    EXPECT_EQ(tree.num_inputs(), 1);
+
+    // Weight count mismatch.
+    const float weights[2] = {1.f, 1.f};
+    EXPECT_FALSE(tree.Run(weights, output_transforms));
+
+    // Output smaller than the rest pose.
+    const float weight[1] = {1.f};
+    EXPECT_FALSE(tree.Run(
+        weight, {output_transforms, output_transforms}));
+
+    // Valid arguments.
+    EXPECT_TRUE(tree.Run(weight, output_transforms));
+  }
+
+  {  // Empty tree falls back to the rest pose.
+    BlendTree tree(*skeleton, ozz::span<const BlendTree::Input>());
+    EXPECT_TRUE(tree.valid());
+    EXPECT_EQ(tree.num_inputs(), 0);
+    EXPECT_TRUE(tree.Run(ozz::span<const float>(), output_transforms));
+    EXPECT_SOAFLOAT3_EQ_EST(output_transforms[0].translation, 0.f, 0.f, 0.f,
+                            0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f);
+  }
+}
+
+TEST(Run, BlendTree) {
+  ozz::unique_ptr<Skeleton> skeleton = BuildSkeleton();
+  const ozz::math::SoaTransform identity = ozz::math::SoaTransform::identity();
+
+  // 3 inputs: 2 blended layers (the 2nd per-joint weighted) and an additive
+  // overlay.
+  ozz::math::SoaTransform input_transforms[3][1] = {
+      {identity}, {identity}, {identity}};
+  input_transforms[0][0].translation = ozz::math::SoaFloat3::Load(
+      ozz::math::simd_float4::Load(0.f, 2.f, 4.f, 6.f),
+      ozz::math::simd_float4::Load(8.f, 10.f, 12.f, 14.f),
+      ozz::math::simd_float4::Load(16.f, 18.f, 20.f, 22.f));
+  input_transforms[1][0].translation = -input_transforms[0][0].translation;
+  input_transforms[2][0].translation = ozz::math::SoaFloat3::Load(
+      ozz::math::simd_float4::Load(1.f, 1.f, 1.f, 1.f),
+      ozz::math::simd_float4::Load(1.f, 1.f, 1.f, 1.f),
+      ozz::math::simd_float4::Load(1.f, 1.f, 1.f, 1.f));
+  const ozz::math::SimdFloat4 joint_weights[1] = {
+      ozz::math::simd_float4::Load(1.f, 0.f, 1.f, 0.f)};
+
+  BlendTree::Input inputs[3];
+  inputs[0].transform = input_transforms[0];
+  inputs[1].transform = input_transforms[1];
+  inputs[1].joint_weights = joint_weights;
+  inputs[2].transform = input_transforms[2];
+  inputs[2].additive = true;
+
+  BlendTree tree(*skeleton, inputs);
+  ASSERT_TRUE(tree.valid());
+  EXPECT_EQ(tree.num_inputs(), 3);
+
+  const float weights[3] = {.5f, .5f, 1.f};
+  ozz::math::SoaTransform tree_output[1] = {identity};
+  ASSERT_TRUE(tree.Run(weights, tree_output));
+
+  // Runs the equivalent hand-built job, the tree must match it exactly.
+  BlendingJob::Layer layers[2];
+  layers[0].weight = weights[0];
+  layers[0].transform = input_transforms[0];
+  layers[1].weight = weights[1];
+  layers[1].transform = input_transforms[1];
+  layers[1].joint_weights = joint_weights;
+  BlendingJob::Layer additive_layers[1];
+  additive_layers[0].weight = weights[2];
+  additive_layers[0].transform = input_transforms[2];
+
+  BlendingJob job;
+  job.layers = layers;
+  job.additive_layers = additive_layers;
+  job.rest_pose = skeleton->joint_rest_poses();
+  ozz::math::SoaTransform job_output[1] = {identity};
+  job.output = job_output;
+  ASSERT_TRUE(job.Run());
+
+  EXPECT_TRUE(ozz::math::AreAllTrue(
+      tree_output[0].translation == job_output[0].translation));
+  EXPECT_TRUE(ozz::math::AreAllTrue(
+      tree_output[0].rotation.x == job_output[0].rotation.x));
+  EXPECT_TRUE(ozz::math::AreAllTrue(
+      tree_output[0].rotation.y == job_output[0].rotation.y));
+  EXPECT_TRUE(ozz::math::AreAllTrue(
+      tree_output[0].rotation.z == job_output[0].rotation.z));
+  EXPECT_TRUE(ozz::math::AreAllTrue(
+      tree_output[0].rotation.w == job_output[0].rotation.w));
+  EXPECT_TRUE(
+      ozz::math::AreAllTrue(tree_output[0].scale == job_output[0].scale));
+
+  // Weights can be changed across evaluations without rebuilding.
+  const float weights2[3] = {1.f, 0.f, 0.f};
+  ASSERT_TRUE(tree.Run(weights2, tree_output));
+  EXPECT_SOAFLOAT3_EQ_EST(tree_output[0].translation, 0.f, 2.f, 4.f, 6.f, 8.f,
+                          10.f, 12.f, 14.f, 16.f, 18.f, 20.f, 22.f);
+}
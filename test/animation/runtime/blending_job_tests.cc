@@ -31,6 +31,7 @@
 #include "ozz/base/maths/gtest_math_helper.h"
 #include "ozz/base/maths/soa_transform.h"
 
+using ozz::animation::ApplyAdditiveJob;
 using ozz::animation::BlendingJob;
 
 TEST(JobValidity, BlendingJob) {
@@ -648,6 +649,107 @@ TEST(Threshold, BlendingJob) {
   }
 }
 
+namespace {
+// Ranged and full runs execute the very same per block arithmetic, so their
+// outputs can be compared bit for bit.
+bool Equals(const ozz::math::SoaTransform& _a,
+            const ozz::math::SoaTransform& _b) {
+  return memcmp(&_a, &_b, sizeof(_a)) == 0;
+}
+}  // namespace
+
+TEST(Range, BlendingJob) {
+  const ozz::math::SoaTransform identity = ozz::math::SoaTransform::identity();
+
+  // Prepares layers with distinct translations per soa block.
+  ozz::math::SoaTransform input_transforms[2][3] = {
+      {identity, identity, identity}, {identity, identity, identity}};
+  for (size_t l = 0; l < 2; ++l) {
+    for (size_t i = 0; i < 3; ++i) {
+      input_transforms[l][i].translation.x =
+          ozz::math::simd_float4::Load1(1.f + l * 2.f + i);
+    }
+  }
+  BlendingJob::Layer layers[2];
+  layers[0].weight = .5f;
+  layers[0].transform = input_transforms[0];
+  layers[1].weight = .5f;
+  layers[1].transform = input_transforms[1];
+
+  const ozz::math::SoaTransform rest_poses[3] = {identity, identity, identity};
+
+  // Reference, full range blending.
+  ozz::math::SoaTransform ref_output[3] = {identity, identity, identity};
+  BlendingJob job;
+  job.layers = layers;
+  job.rest_pose = rest_poses;
+  job.output = ref_output;
+  ASSERT_TRUE(job.Run());
+
+  {  // Blending each range separately matches the full blend, and the ranges
+     // don't touch each others' blocks.
+    ozz::math::SoaTransform output[3] = {identity, identity, identity};
+    job.output = output;
+    job.from = 0;
+    job.to = 2;
+    ASSERT_TRUE(job.Run());
+    EXPECT_TRUE(Equals(output[2], identity));
+
+    job.from = 2;
+    job.to = 3;
+    ASSERT_TRUE(job.Run());
+    for (size_t i = 0; i < 3; ++i) {
+      EXPECT_TRUE(Equals(output[i], ref_output[i]));
+    }
+  }
+
+  {  // Out of bounds ranges are clamped.
+    ozz::math::SoaTransform output[3] = {identity, identity, identity};
+    job.output = output;
+    job.from = -46;
+    job.to = 99;
+    ASSERT_TRUE(job.Run());
+    for (size_t i = 0; i < 3; ++i) {
+      EXPECT_TRUE(Equals(output[i], ref_output[i]));
+    }
+  }
+
+  {  // An empty range leaves the whole output untouched.
+    ozz::math::SoaTransform output[3] = {identity, identity, identity};
+    job.output = output;
+    job.from = 1;
+    job.to = 1;
+    ASSERT_TRUE(job.Run());
+    for (size_t i = 0; i < 3; ++i) {
+      EXPECT_TRUE(Equals(output[i], identity));
+    }
+  }
+
+  {  // Ranges also apply to the per-joint weighted (multi-pass) path.
+    ozz::math::SimdFloat4 joint_weights[3] = {
+        ozz::math::simd_float4::one(), ozz::math::simd_float4::one(),
+        ozz::math::simd_float4::one()};
+    layers[0].joint_weights = joint_weights;
+
+    ozz::math::SoaTransform weighted_ref[3] = {identity, identity, identity};
+    job.output = weighted_ref;
+    job.from = 0;
+    job.to = 3;
+    ASSERT_TRUE(job.Run());
+
+    ozz::math::SoaTransform output[3] = {identity, identity, identity};
+    job.output = output;
+    job.from = 1;
+    job.to = 3;
+    ASSERT_TRUE(job.Run());
+    EXPECT_TRUE(Equals(output[0], identity));
+    for (size_t i = 1; i < 3; ++i) {
+      EXPECT_TRUE(Equals(output[i], weighted_ref[i]));
+    }
+    layers[0].joint_weights = {};
+  }
+}
+
 TEST(AdditiveWeight, BlendingJob) {
   // Initialize inputs.
   ozz::math::SoaTransform input_transforms[2][1];
@@ -889,3 +991,133 @@ TEST(AdditiveJointWeight, BlendingJob) {
                             1.f / 20.f, 1.f / 11.f, 1.f, 1.f);
   }
 }
+
+TEST(JobValidity, ApplyAdditiveJob) {
+  const ozz::math::SoaTransform identity = ozz::math::SoaTransform::identity();
+  const ozz::math::SoaTransform input_transforms[2] = {identity, identity};
+  ozz::math::SoaTransform pose[2] = {identity, identity};
+
+  {  // Empty layers is a valid no-op.
+    ApplyAdditiveJob job;
+    job.pose = pose;
+    EXPECT_TRUE(job.Validate());
+    EXPECT_TRUE(job.Run());
+  }
+
+  {  // Layer with a nullptr transform buffer.
+    BlendingJob::Layer layers[1];
+    ApplyAdditiveJob job;
+    job.layers = layers;
+    job.pose = pose;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // Layer transform buffer smaller than the pose.
+    BlendingJob::Layer layers[1];
+    layers[0].transform = {input_transforms, input_transforms + 1};
+    ApplyAdditiveJob job;
+    job.layers = layers;
+    job.pose = pose;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // Valid job.
+    BlendingJob::Layer layers[1];
+    layers[0].transform = input_transforms;
+    ApplyAdditiveJob job;
+    job.layers = layers;
+    job.pose = pose;
+    EXPECT_TRUE(job.Validate());
+    EXPECT_TRUE(job.Run());
+  }
+}
+
+TEST(InPlace, ApplyAdditiveJob) {
+  // Initializes a base pose and an additive layer.
+  ozz::math::SoaTransform base_pose[1];
+  base_pose[0].translation = ozz::math::SoaFloat3::Load(
+      ozz::math::simd_float4::Load(0.f, 1.f, 2.f, 3.f),
+      ozz::math::simd_float4::Load(4.f, 5.f, 6.f, 7.f),
+      ozz::math::simd_float4::Load(8.f, 9.f, 10.f, 11.f));
+  base_pose[0].rotation = ozz::math::SoaQuaternion::identity();
+  base_pose[0].scale = ozz::math::SoaFloat3::Load(
+      ozz::math::simd_float4::one(), ozz::math::simd_float4::one(),
+      ozz::math::simd_float4::one());
+
+  ozz::math::SoaTransform additive_transforms[1];
+  additive_transforms[0].translation = ozz::math::SoaFloat3::Load(
+      ozz::math::simd_float4::Load(10.f, 10.f, 10.f, 10.f),
+      ozz::math::simd_float4::Load(20.f, 20.f, 20.f, 20.f),
+      ozz::math::simd_float4::Load(30.f, 30.f, 30.f, 30.f));
+  additive_transforms[0].rotation = ozz::math::SoaQuaternion::Load(
+      ozz::math::simd_float4::Load(.70710677f, 0.f, 0.f, 0.f),
+      ozz::math::simd_float4::Load(0.f, .70710677f, 0.f, 0.f),
+      ozz::math::simd_float4::Load(0.f, 0.f, 0.f, 0.f),
+      ozz::math::simd_float4::Load(.70710677f, .70710677f, 1.f, 1.f));
+  additive_transforms[0].scale = ozz::math::SoaFloat3::Load(
+      ozz::math::simd_float4::Load(2.f, 2.f, 2.f, 2.f),
+      ozz::math::simd_float4::Load(3.f, 3.f, 3.f, 3.f),
+      ozz::math::simd_float4::Load(4.f, 4.f, 4.f, 4.f));
+
+  BlendingJob::Layer layers[1];
+  layers[0].transform = additive_transforms;
+
+  // The in-place job must match a full blend with a single full-weight base
+  // layer and the same additive layer.
+  BlendingJob::Layer base_layers[1];
+  base_layers[0].weight = 1.f;
+  base_layers[0].transform = base_pose;
+
+  for (const float weight : {0.f, .5f, 1.f, -.5f}) {
+    layers[0].weight = weight;
+
+    ozz::math::SoaTransform reference[1];
+    BlendingJob blending_job;
+    blending_job.layers = base_layers;
+    blending_job.additive_layers = layers;
+    blending_job.rest_pose = base_pose;
+    blending_job.output = reference;
+    ASSERT_TRUE(blending_job.Run());
+
+    // Applies in place on a copy of the base pose.
+    ozz::math::SoaTransform pose[1] = {base_pose[0]};
+    ApplyAdditiveJob job;
+    job.layers = layers;
+    job.pose = pose;
+    ASSERT_TRUE(job.Run());
+
+    // The blending job normalizes rotations with an estimate, so comparison
+    // uses the estimated tolerance.
+    const ozz::math::SimdFloat4 eps = ozz::math::simd_float4::Load1(2e-3f);
+    EXPECT_TRUE(ozz::math::AreAllTrue(
+        pose[0].translation == reference[0].translation));
+    EXPECT_TRUE(ozz::math::AreAllTrue(
+        ozz::math::Abs(pose[0].rotation.x - reference[0].rotation.x) < eps));
+    EXPECT_TRUE(ozz::math::AreAllTrue(
+        ozz::math::Abs(pose[0].rotation.y - reference[0].rotation.y) < eps));
+    EXPECT_TRUE(ozz::math::AreAllTrue(
+        ozz::math::Abs(pose[0].rotation.z - reference[0].rotation.z) < eps));
+    EXPECT_TRUE(ozz::math::AreAllTrue(
+        ozz::math::Abs(pose[0].rotation.w - reference[0].rotation.w) < eps));
+    EXPECT_TRUE(ozz::math::AreAllTrue(pose[0].scale == reference[0].scale));
+  }
+
+  // Per-joint weights restrict the application to masked joints.
+  const ozz::math::SimdFloat4 joint_weights[1] = {
+      ozz::math::simd_float4::Load(1.f, 0.f, 1.f, 0.f)};
+  layers[0].weight = 1.f;
+  layers[0].joint_weights = joint_weights;
+
+  ozz::math::SoaTransform pose[1] = {base_pose[0]};
+  ApplyAdditiveJob job;
+  job.layers = layers;
+  job.pose = pose;
+  ASSERT_TRUE(job.Run());
+
+  EXPECT_SOAFLOAT3_EQ(pose[0].translation, 10.f, 1.f, 12.f, 3.f, 24.f, 5.f,
+                      26.f, 7.f, 38.f, 9.f, 40.f, 11.f);
+  EXPECT_SOAFLOAT3_EQ(pose[0].scale, 2.f, 1.f, 2.f, 1.f, 3.f, 1.f, 3.f, 1.f,
+                      4.f, 1.f, 4.f, 1.f);
+}
@@ -0,0 +1,334 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/character_update.h"
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/animation_builder.h"
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/offline/raw_skeleton.h"
+#include "ozz/animation/offline/skeleton_builder.h"
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/maths/gtest_math_helper.h"
+#include "ozz/base/maths/simd_math.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/maths/transform.h"
+#include "ozz/base/memory/unique_ptr.h"
+#include "ozz/base/scheduler.h"
+
+using ozz::animation::CharacterUpdate;
+
+namespace {
+
+// Builds a single joint skeleton whose rest pose translation is (5, 0, 0).
+ozz::unique_ptr<ozz::animation::Skeleton> BuildTestSkeleton() {
+  ozz::animation::offline::RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  raw_skeleton.roots[0].name = "j0";
+  raw_skeleton.roots[0].transform = ozz::math::Transform::identity();
+  raw_skeleton.roots[0].transform.translation =
+      ozz::math::Float3(5.f, 0.f, 0.f);
+  ozz::animation::offline::SkeletonBuilder builder;
+  return builder(raw_skeleton);
+}
+
+// Builds a single track animation with a constant _translation.
+ozz::unique_ptr<ozz::animation::Animation> BuildTestAnimation(
+    const ozz::math::Float3& _translation) {
+  ozz::animation::offline::RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(1);
+  const ozz::animation::offline::RawAnimation::TranslationKey key = {
+      0.f, _translation};
+  raw_animation.tracks[0].translations.push_back(key);
+  ozz::animation::offline::AnimationBuilder builder;
+  return builder(raw_animation);
+}
+}  // namespace
+
+TEST(Initialize, CharacterUpdate) {
+  ozz::unique_ptr<ozz::animation::Skeleton> skeleton = BuildTestSkeleton();
+  ASSERT_TRUE(skeleton);
+
+  {  // Not initialized, Run fails.
+    CharacterUpdate update;
+    EXPECT_FALSE(update.Run());
+  }
+
+  {  // No skeleton.
+    CharacterUpdate update;
+    CharacterUpdate::Setup setup;
+    setup.num_instances = 1;
+    setup.num_layers = 1;
+    EXPECT_FALSE(update.Initialize(setup));
+  }
+
+  {  // Negative instance count.
+    CharacterUpdate update;
+    CharacterUpdate::Setup setup;
+    setup.skeleton = skeleton.get();
+    setup.num_instances = -1;
+    setup.num_layers = 1;
+    EXPECT_FALSE(update.Initialize(setup));
+  }
+
+  {  // No layer.
+    CharacterUpdate update;
+    CharacterUpdate::Setup setup;
+    setup.skeleton = skeleton.get();
+    setup.num_instances = 1;
+    setup.num_layers = 0;
+    EXPECT_FALSE(update.Initialize(setup));
+  }
+
+  {  // Valid, no instance is fine.
+    CharacterUpdate update;
+    CharacterUpdate::Setup setup;
+    setup.skeleton = skeleton.get();
+    setup.num_instances = 0;
+    setup.num_layers = 1;
+    EXPECT_TRUE(update.Initialize(setup));
+    EXPECT_TRUE(update.Run());
+  }
+}
+
+TEST(Run, CharacterUpdate) {
+  ozz::unique_ptr<ozz::animation::Skeleton> skeleton = BuildTestSkeleton();
+  ASSERT_TRUE(skeleton);
+  ozz::unique_ptr<ozz::animation::Animation> animation1 =
+      BuildTestAnimation(ozz::math::Float3(1.f, 2.f, 3.f));
+  ASSERT_TRUE(animation1);
+  ozz::unique_ptr<ozz::animation::Animation> animation2 =
+      BuildTestAnimation(ozz::math::Float3(3.f, 2.f, 1.f));
+  ASSERT_TRUE(animation2);
+
+  CharacterUpdate update;
+  CharacterUpdate::Setup setup;
+  setup.skeleton = skeleton.get();
+  setup.num_instances = 3;
+  setup.num_layers = 2;
+  ASSERT_TRUE(update.Initialize(setup));
+
+  EXPECT_EQ(update.layers(0).size(), 2u);
+
+  // Instance 0 plays animation1 only, instance 1 has no active layer hence
+  // falls back to the rest pose, instance 2 blends both animations evenly.
+  update.layers(0)[0].animation = animation1.get();
+  update.layers(0)[0].weight = 1.f;
+  update.layers(2)[0].animation = animation1.get();
+  update.layers(2)[0].weight = .5f;
+  update.layers(2)[1].animation = animation2.get();
+  update.layers(2)[1].weight = .5f;
+
+  ASSERT_TRUE(update.Run());
+
+  // Animation rotation tracks are compressed, hence the estimated precision
+  // checks on sampled poses.
+  {  // Instance 0, animation pose.
+    const ozz::math::Float4x4 model = update.models(0)[0];
+    EXPECT_SIMDFLOAT_EQ_EST(model.cols[0], 1.f, 0.f, 0.f, 0.f);
+    EXPECT_SIMDFLOAT_EQ_EST(model.cols[1], 0.f, 1.f, 0.f, 0.f);
+    EXPECT_SIMDFLOAT_EQ_EST(model.cols[2], 0.f, 0.f, 1.f, 0.f);
+    EXPECT_SIMDFLOAT_EQ_EST(model.cols[3], 1.f, 2.f, 3.f, 1.f);
+  }
+
+  {  // Instance 1, rest pose.
+    const ozz::math::Float4x4 model = update.models(1)[0];
+    EXPECT_FLOAT4x4_EQ(model, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f,
+                       1.f, 0.f, 5.f, 0.f, 0.f, 1.f);
+  }
+
+  {  // Instance 2, even blend of both animations.
+    const ozz::math::Float4x4 model = update.models(2)[0];
+    EXPECT_SIMDFLOAT_EQ_EST(model.cols[0], 1.f, 0.f, 0.f, 0.f);
+    EXPECT_SIMDFLOAT_EQ_EST(model.cols[1], 0.f, 1.f, 0.f, 0.f);
+    EXPECT_SIMDFLOAT_EQ_EST(model.cols[2], 0.f, 0.f, 1.f, 0.f);
+    EXPECT_SIMDFLOAT_EQ_EST(model.cols[3], 2.f, 2.f, 2.f, 1.f);
+  }
+
+  // Timings are collected for executed stages, and no budget is configured
+  // hence none is exceeded.
+  for (int s = 0; s < CharacterUpdate::kNumStages; ++s) {
+    EXPECT_GE(update.duration(static_cast<CharacterUpdate::Stage>(s)), 0.f);
+    EXPECT_FALSE(update.exceeded(static_cast<CharacterUpdate::Stage>(s)));
+  }
+
+  {  // Same update runs unchanged through a scheduler.
+    ozz::ThreadPoolScheduler scheduler(2);
+    CharacterUpdate::Setup parallel_setup = setup;
+    parallel_setup.scheduler = &scheduler;
+    CharacterUpdate parallel_update;
+    ASSERT_TRUE(parallel_update.Initialize(parallel_setup));
+    parallel_update.layers(0)[0].animation = animation1.get();
+    parallel_update.layers(0)[0].weight = 1.f;
+    ASSERT_TRUE(parallel_update.Run());
+    const ozz::math::Float4x4 model = parallel_update.models(0)[0];
+    EXPECT_SIMDFLOAT_EQ_EST(model.cols[3], 1.f, 2.f, 3.f, 1.f);
+  }
+}
+
+TEST(PoseModifier, CharacterUpdate) {
+  ozz::unique_ptr<ozz::animation::Skeleton> skeleton = BuildTestSkeleton();
+  ASSERT_TRUE(skeleton);
+  ozz::unique_ptr<ozz::animation::Animation> animation =
+      BuildTestAnimation(ozz::math::Float3(1.f, 2.f, 3.f));
+  ASSERT_TRUE(animation);
+
+  CharacterUpdate update;
+  CharacterUpdate::Setup setup;
+  setup.skeleton = skeleton.get();
+  setup.num_instances = 1;
+  setup.num_layers = 1;
+
+  // The modifier overwrites the blended pose translation, standing in for an
+  // IK or procedural stage.
+  setup.pose_fn = [](void* _context, int _instance) {
+    CharacterUpdate* update = static_cast<CharacterUpdate*>(_context);
+    update->locals(_instance)[0].translation.x =
+        ozz::math::simd_float4::Load1(7.f);
+    return true;
+  };
+  setup.pose_context = &update;
+  ASSERT_TRUE(update.Initialize(setup));
+
+  update.layers(0)[0].animation = animation.get();
+  update.layers(0)[0].weight = 1.f;
+  ASSERT_TRUE(update.Run());
+
+  const ozz::math::Float4x4 model = update.models(0)[0];
+  EXPECT_SIMDFLOAT_EQ_EST(model.cols[3], 7.f, 2.f, 3.f, 1.f);
+}
+
+TEST(Budget, CharacterUpdate) {
+  ozz::unique_ptr<ozz::animation::Skeleton> skeleton = BuildTestSkeleton();
+  ASSERT_TRUE(skeleton);
+
+  CharacterUpdate update;
+  CharacterUpdate::Setup setup;
+  setup.skeleton = skeleton.get();
+  setup.num_instances = 1;
+  setup.num_layers = 1;
+
+  // The pose stage sleeps way beyond its 1us budget, so the check must flag
+  // it, while unchecked stages (0 budget) never are.
+  setup.pose_fn = [](void*, int) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    return true;
+  };
+  setup.budgets[CharacterUpdate::kPose] = 1.f;
+  ASSERT_TRUE(update.Initialize(setup));
+
+  ASSERT_TRUE(update.Run());
+  EXPECT_TRUE(update.exceeded(CharacterUpdate::kPose));
+  EXPECT_GT(update.duration(CharacterUpdate::kPose), 1.f);
+  EXPECT_FALSE(update.exceeded(CharacterUpdate::kSample));
+  EXPECT_FALSE(update.exceeded(CharacterUpdate::kBlend));
+  EXPECT_FALSE(update.exceeded(CharacterUpdate::kLocalToModel));
+}
+
+namespace {
+// Builds a single track animation translating linearly from the origin to
+// (10, 0, 0) over the clip duration.
+ozz::unique_ptr<ozz::animation::Animation> BuildRampAnimation() {
+  ozz::animation::offline::RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(1);
+  const ozz::animation::offline::RawAnimation::TranslationKey begin = {
+      0.f, ozz::math::Float3(0.f, 0.f, 0.f)};
+  raw_animation.tracks[0].translations.push_back(begin);
+  const ozz::animation::offline::RawAnimation::TranslationKey end = {
+      1.f, ozz::math::Float3(10.f, 0.f, 0.f)};
+  raw_animation.tracks[0].translations.push_back(end);
+  ozz::animation::offline::AnimationBuilder builder;
+  return builder(raw_animation);
+}
+}  // namespace
+
+TEST(FreezeThaw, CharacterUpdate) {
+  ozz::unique_ptr<ozz::animation::Skeleton> skeleton = BuildTestSkeleton();
+  ASSERT_TRUE(skeleton);
+  ozz::unique_ptr<ozz::animation::Animation> animation = BuildRampAnimation();
+  ASSERT_TRUE(animation);
+
+  CharacterUpdate update;
+  CharacterUpdate::Setup setup;
+  setup.skeleton = skeleton.get();
+  setup.num_instances = 2;
+  setup.num_layers = 1;
+  ASSERT_TRUE(update.Initialize(setup));
+
+  // Both instances play the ramp at the same ratio.
+  for (int i = 0; i < 2; ++i) {
+    update.layers(i)[0].animation = animation.get();
+    update.layers(i)[0].ratio = .2f;
+    update.layers(i)[0].weight = 1.f;
+  }
+  ASSERT_TRUE(update.Run());
+  EXPECT_FALSE(update.frozen(0));
+
+  // Captures the pose at freeze time.
+  const float frozen_x = ozz::math::GetX(update.locals(0)[0].translation.x);
+  EXPECT_NEAR(frozen_x, 2.f, 1e-2f);
+
+  update.Freeze(0);
+  EXPECT_TRUE(update.frozen(0));
+  update.Freeze(0);  // Freezing an already frozen instance is a no-op.
+  EXPECT_TRUE(update.frozen(0));
+
+  // Timelines keep advancing while instance 0 is frozen.
+  update.layers(0)[0].ratio = .8f;
+  update.layers(1)[0].ratio = .8f;
+  ASSERT_TRUE(update.Run());
+
+  // The frozen instance wasn't evaluated, the running one was.
+  EXPECT_SIMDFLOAT_EQ_EST(update.models(0)[0].cols[3], 2.f, 0.f, 0.f, 1.f);
+  EXPECT_SIMDFLOAT_EQ_EST(update.models(1)[0].cols[3], 8.f, 0.f, 0.f, 1.f);
+
+  // The snapshot is authoritative: scribbled buffers are restored on thaw,
+  // bit exact as the snapshot codec is lossless.
+  update.locals(0)[0].translation.x = ozz::math::simd_float4::Load1(99.f);
+  update.Thaw(0);
+  EXPECT_FALSE(update.frozen(0));
+  EXPECT_FLOAT_EQ(ozz::math::GetX(update.locals(0)[0].translation.x),
+                  frozen_x);
+
+  // Catch-up run resumes at the current timeline, matching the instance that
+  // never froze bit for bit (same animation, ratio and skeleton).
+  ASSERT_TRUE(update.Run());
+  EXPECT_EQ(std::memcmp(update.models(0).data(), update.models(1).data(),
+                        update.models(0).size_bytes()),
+            0);
+
+  // Thawing a running instance is a no-op.
+  update.Thaw(1);
+  EXPECT_FALSE(update.frozen(1));
+}
@@ -0,0 +1,140 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/dynamic_track.h"
+
+#include "gtest/gtest.h"
+#include "ozz/animation/runtime/track.h"
+#include "ozz/animation/runtime/track_sampling_job.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+using ozz::animation::DynamicFloatTrack;
+using ozz::animation::DynamicFloatTrackSamplingJob;
+using ozz::animation::FloatTrack;
+using ozz::animation::FloatTrackSamplingJob;
+
+namespace {
+// Samples _track at _ratio, expecting success.
+float Sample(const DynamicFloatTrack& _track, float _ratio) {
+  float result = -1.f;
+  DynamicFloatTrackSamplingJob job;
+  job.track = &_track;
+  job.result = &result;
+  job.ratio = _ratio;
+  EXPECT_TRUE(job.Run());
+  return result;
+}
+}  // namespace
+
+TEST(Default, DynamicTrack) {
+  // A default track has linear identity boundary keyframes, like the
+  // TrackBuilder output for an empty RawTrack.
+  DynamicFloatTrack track;
+  EXPECT_EQ(track.num_keys(), 2u);
+  EXPECT_FLOAT_EQ(track.ratios()[0], 0.f);
+  EXPECT_FLOAT_EQ(track.ratios()[1], 1.f);
+  EXPECT_STREQ(track.name(), "");
+
+  EXPECT_FLOAT_EQ(Sample(track, 0.f), 0.f);
+  EXPECT_FLOAT_EQ(Sample(track, .5f), 0.f);
+  EXPECT_FLOAT_EQ(Sample(track, 1.f), 0.f);
+}
+
+TEST(Edit, DynamicTrack) {
+  DynamicFloatTrack track;
+
+  // Boundary keyframes can be edited.
+  EXPECT_TRUE(track.SetValue(1, 4.f));
+
+  // Inserts between boundaries, keeping ratios sorted.
+  const size_t mid = track.AddKey(.5f, 2.f);
+  EXPECT_EQ(mid, 1u);
+  EXPECT_EQ(track.num_keys(), 3u);
+
+  EXPECT_FLOAT_EQ(Sample(track, .25f), 1.f);
+  EXPECT_FLOAT_EQ(Sample(track, .5f), 2.f);
+  EXPECT_FLOAT_EQ(Sample(track, .75f), 3.f);
+  EXPECT_FLOAT_EQ(Sample(track, 1.f), 4.f);
+
+  // A step keyframe holds its value until the next keyframe.
+  EXPECT_TRUE(track.SetStep(mid, true));
+  EXPECT_FLOAT_EQ(Sample(track, .75f), 2.f);
+  EXPECT_FLOAT_EQ(Sample(track, 1.f), 4.f);
+  EXPECT_TRUE(track.SetStep(mid, false));
+
+  // Moves the keyframe, preserving value and interpolation mode.
+  const size_t moved = track.MoveKey(mid, .75f);
+  ASSERT_EQ(moved, 1u);
+  EXPECT_FLOAT_EQ(track.ratios()[moved], .75f);
+  EXPECT_FLOAT_EQ(Sample(track, .75f), 2.f);
+
+  // Boundary keyframes cannot be removed nor moved, and out of range indices
+  // fail.
+  EXPECT_FALSE(track.RemoveKey(0));
+  EXPECT_FALSE(track.RemoveKey(2));
+  EXPECT_EQ(track.MoveKey(0, .5f), track.num_keys());
+  EXPECT_FALSE(track.RemoveKey(27));
+  EXPECT_FALSE(track.SetValue(27, 0.f));
+  EXPECT_FALSE(track.SetStep(27, true));
+
+  EXPECT_TRUE(track.RemoveKey(moved));
+  EXPECT_EQ(track.num_keys(), 2u);
+  EXPECT_FLOAT_EQ(Sample(track, .5f), 2.f);
+}
+
+TEST(BakeAssign, DynamicTrack) {
+  DynamicFloatTrack track;
+  track.set_name("edited");
+  EXPECT_TRUE(track.SetValue(1, 1.f));
+  track.AddKey(.5f, 3.f, true);
+
+  // Bakes to an immutable track for shipping.
+  ozz::unique_ptr<FloatTrack> baked = track.Bake<FloatTrack>();
+  ASSERT_TRUE(baked);
+  EXPECT_STREQ(baked->name(), "edited");
+  ASSERT_EQ(baked->ratios().size(), 3u);
+
+  // Baked and dynamic tracks sample identically.
+  const float ratios[] = {0.f, .25f, .5f, .75f, 1.f};
+  for (size_t i = 0; i < OZZ_ARRAY_SIZE(ratios); ++i) {
+    float baked_result = -1.f;
+    FloatTrackSamplingJob job;
+    job.track = baked.get();
+    job.result = &baked_result;
+    job.ratio = ratios[i];
+    ASSERT_TRUE(job.Run());
+    EXPECT_FLOAT_EQ(baked_result, Sample(track, ratios[i]));
+  }
+
+  // Assign brings a built track back to editing.
+  DynamicFloatTrack reedit;
+  reedit.Assign(*baked);
+  EXPECT_EQ(reedit.num_keys(), 3u);
+  EXPECT_STREQ(reedit.name(), "edited");
+  EXPECT_FLOAT_EQ(reedit.values()[1], 3.f);
+  EXPECT_NE(reedit.steps()[0] & 2, 0);
+}
@@ -446,6 +446,35 @@ TEST(Twist, IKAimJob) {
   }
 }
 
+TEST(Estimated, IKAimJob) {
+  ozz::animation::IKAimJob job;
+  ozz::math::SimdQuaternion quat;
+  job.joint_correction = &quat;
+  const ozz::math::Float4x4 joint = ozz::math::Float4x4::identity();
+  job.joint = &joint;
+
+  // Aims away from forward axis, with a twist angle, so every trigonometric
+  // code path is exercised.
+  job.target = ozz::math::simd_float4::Load(1.f, .5f, -.3f, 0.f);
+  job.forward = ozz::math::simd_float4::x_axis();
+  job.up = ozz::math::simd_float4::y_axis();
+  job.pole_vector = ozz::math::simd_float4::y_axis();
+  job.twist_angle = ozz::math::kPi_2;
+
+  // Full precision reference solve.
+  EXPECT_TRUE(job.Run());
+  const ozz::math::SimdQuaternion quat_ref = quat;
+
+  // Estimated solve must remain within 1e-3 radian from the reference, which
+  // is far less than quaternion components tolerance.
+  job.estimated = true;
+  EXPECT_TRUE(job.Run());
+  EXPECT_SIMDQUATERNION_EQ_TOL(quat, ozz::math::GetX(quat_ref.xyzw),
+                               ozz::math::GetY(quat_ref.xyzw),
+                               ozz::math::GetZ(quat_ref.xyzw),
+                               ozz::math::GetW(quat_ref.xyzw), 1e-3f);
+}
+
 TEST(AlignedTargetUp, IKAimJob) {
   ozz::animation::IKAimJob job;
   ozz::math::SimdQuaternion quat;
@@ -603,3 +632,140 @@ TEST(ZeroScale, IKAimJob) {
   EXPECT_TRUE(job.Run());
   EXPECT_SIMDQUATERNION_EQ_TOL(quat, 0.f, 0.f, 0.f, 1.f, 2e-3f);
 }
+
+TEST(BatchJobValidity, IKAimJob) {
+  const ozz::math::Float4x4 joints[2] = {ozz::math::Float4x4::identity(),
+                                         ozz::math::Float4x4::identity()};
+  ozz::math::SimdQuaternion corrections[2];
+  float weights[2] = {1.f, 1.f};
+  bool reached[2];
+
+  {  // Empty is valid
+    ozz::animation::IKAimBatchJob job;
+    EXPECT_TRUE(job.Validate());
+    EXPECT_TRUE(job.Run());
+  }
+
+  {  // Too small output corrections
+    ozz::animation::IKAimBatchJob job;
+    job.joints = joints;
+    job.joint_corrections =
+        ozz::span<ozz::math::SimdQuaternion>(corrections, 1);
+    EXPECT_FALSE(job.Validate());
+  }
+
+  {  // Wrong weights size
+    ozz::animation::IKAimBatchJob job;
+    job.joints = joints;
+    job.joint_corrections = corrections;
+    job.weights = ozz::span<const float>(weights, 1);
+    EXPECT_FALSE(job.Validate());
+  }
+
+  {  // Wrong reached size
+    ozz::animation::IKAimBatchJob job;
+    job.joints = joints;
+    job.joint_corrections = corrections;
+    job.reached = ozz::span<bool>(reached, 1);
+    EXPECT_FALSE(job.Validate());
+  }
+
+  {  // Invalid non normalized forward vector.
+    ozz::animation::IKAimBatchJob job;
+    job.joints = joints;
+    job.joint_corrections = corrections;
+    job.forward = ozz::math::simd_float4::Load(.5f, 0.f, 0.f, 0.f);
+    EXPECT_FALSE(job.Validate());
+  }
+
+  {  // Valid
+    ozz::animation::IKAimBatchJob job;
+    job.joints = joints;
+    job.joint_corrections = corrections;
+    job.weights = weights;
+    job.reached = reached;
+    EXPECT_TRUE(job.Validate());
+    EXPECT_TRUE(job.Run());
+  }
+}
+
+TEST(Batch, IKAimJob) {
+  // Instances all aim at the same shared target, from different positions
+  // and orientations, the head-tracking crowd scenario.
+  const size_t kInstances = 5;
+  ozz::math::Float4x4 joints[kInstances];
+  joints[0] = ozz::math::Float4x4::identity();
+  joints[1] = ozz::math::Float4x4::Translation(
+      ozz::math::simd_float4::Load(1.f, 2.f, 3.f, 0.f));
+  joints[2] = ozz::math::Float4x4::FromAxisAngle(
+      ozz::math::simd_float4::y_axis(),
+      ozz::math::simd_float4::Load1(ozz::math::kPi_2));
+  joints[3] = ozz::math::Float4x4::Translation(
+                  ozz::math::simd_float4::Load(-4.f, 0.f, 2.f, 0.f)) *
+              ozz::math::Float4x4::FromAxisAngle(
+                  ozz::math::simd_float4::z_axis(),
+                  ozz::math::simd_float4::Load1(ozz::math::kPi / 3.f));
+  // Aligned with the target, too close to find a direction.
+  joints[4] = ozz::math::Float4x4::Translation(
+      ozz::math::simd_float4::Load(5.f, 5.f, 5.f, 0.f));
+  const float weights[kInstances] = {1.f, .8f, .5f, .2f, 1.f};
+
+  // Solves all instances at once.
+  ozz::animation::IKAimBatchJob batch_job;
+  batch_job.target = ozz::math::simd_float4::Load(5.f, 5.f, 5.f, 0.f);
+  batch_job.pole_vector = ozz::math::simd_float4::y_axis();
+  batch_job.twist_angle = ozz::math::kPi / 4.f;
+  batch_job.joints = joints;
+  batch_job.weights = weights;
+  ozz::math::SimdQuaternion batch_corrections[kInstances];
+  bool batch_reached[kInstances];
+  batch_job.joint_corrections = batch_corrections;
+  batch_job.reached = batch_reached;
+  ASSERT_TRUE(batch_job.Run());
+
+  // Expects bit exact results compared to solving each instance separately.
+  for (size_t i = 0; i < kInstances; ++i) {
+    ozz::animation::IKAimJob job;
+    job.target = batch_job.target;
+    job.pole_vector = batch_job.pole_vector;
+    job.twist_angle = batch_job.twist_angle;
+    job.weight = weights[i];
+    job.joint = &joints[i];
+    ozz::math::SimdQuaternion correction;
+    bool reached;
+    job.joint_correction = &correction;
+    job.reached = &reached;
+    ASSERT_TRUE(job.Run());
+
+    EXPECT_SIMDQUATERNION_EQ_EST(batch_corrections[i],
+                                 ozz::math::GetX(correction.xyzw),
+                                 ozz::math::GetY(correction.xyzw),
+                                 ozz::math::GetZ(correction.xyzw),
+                                 ozz::math::GetW(correction.xyzw));
+    EXPECT_EQ(batch_reached[i], reached);
+  }
+
+  {  // Empty weights applies the shared weight to every instance.
+    ozz::animation::IKAimBatchJob job;
+    job.target = batch_job.target;
+    job.weight = .7f;
+    job.joints = ozz::span<const ozz::math::Float4x4>(joints, 1);
+    ozz::math::SimdQuaternion shared_correction;
+    job.joint_corrections = {&shared_correction, 1};
+    ASSERT_TRUE(job.Run());
+
+    ozz::animation::IKAimJob single_job;
+    single_job.target = batch_job.target;
+    single_job.weight = .7f;
+    single_job.joint = &joints[0];
+    ozz::math::SimdQuaternion correction;
+    single_job.joint_correction = &correction;
+    ASSERT_TRUE(single_job.Run());
+
+    EXPECT_SIMDQUATERNION_EQ_EST(shared_correction,
+                                 ozz::math::GetX(correction.xyzw),
+                                 ozz::math::GetY(correction.xyzw),
+                                 ozz::math::GetZ(correction.xyzw),
+                                 ozz::math::GetW(correction.xyzw));
+  }
+}
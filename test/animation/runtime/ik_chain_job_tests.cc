@@ -0,0 +1,328 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "gtest/gtest.h"
+#include "ozz/animation/runtime/ik_chain_job.h"
+#include "ozz/base/maths/gtest_math_helper.h"
+#include "ozz/base/maths/quaternion.h"
+#include "ozz/base/maths/simd_math.h"
+#include "ozz/base/maths/simd_quaternion.h"
+
+// Implement helper macro that verify that target was reached once ik job is
+// executed.
+#define EXPECT_CHAIN_REACHED(_job)   \
+                                     \
+  do {                               \
+    SCOPED_TRACE("");                \
+    _ExpectChainReached(_job, true); \
+  } while (void(0), 0)
+
+#define EXPECT_CHAIN_NOT_REACHED(_job) \
+                                       \
+  do {                                 \
+    SCOPED_TRACE("");                  \
+    _ExpectChainReached(_job, false);  \
+  } while (void(0), 0)
+
+void _ExpectChainReached(const ozz::animation::IKChainJob& _job,
+                         bool _reachable) {
+  // Rebuilds corrected model-space transforms, forward kinematics style, and
+  // checks the end effector lands on the target.
+  ozz::math::Float4x4 corrected =
+      _job.joints[0] *
+      ozz::math::Float4x4::FromQuaternion(_job.joint_corrections[0].xyzw);
+  for (size_t i = 1; i < _job.joints.size(); ++i) {
+    const ozz::math::Float4x4 local =
+        Invert(_job.joints[i - 1]) * _job.joints[i];
+    corrected = corrected * local;
+    if (i < _job.joints.size() - 1) {
+      corrected = corrected * ozz::math::Float4x4::FromQuaternion(
+                                  _job.joint_corrections[i].xyzw);
+    }
+  }
+
+  const ozz::math::SimdFloat4 diff =
+      ozz::math::Length3(corrected.cols[3] - _job.target);
+  EXPECT_EQ(ozz::math::GetX(diff) < 1e-2f, _reachable);
+
+  EXPECT_TRUE(_job.reached == nullptr || *_job.reached == _reachable);
+}
+
+TEST(JobValidity, IKChainJob) {
+  const ozz::math::Float4x4 joints[3] = {
+      ozz::math::Float4x4::identity(),
+      ozz::math::Float4x4::Translation(ozz::math::simd_float4::x_axis()),
+      ozz::math::Float4x4::Translation(
+          ozz::math::simd_float4::Load(2.f, 0.f, 0.f, 0.f))};
+  ozz::math::SimdQuaternion corrections[2];
+  const float limits[2] = {1.f, 1.f};
+
+  {  // Default is invalid
+    ozz::animation::IKChainJob job;
+    EXPECT_FALSE(job.Validate());
+  }
+
+  {  // Chain too short
+    ozz::animation::IKChainJob job;
+    job.joints = ozz::span<const ozz::math::Float4x4>(joints, 1);
+    job.joint_corrections = corrections;
+    EXPECT_FALSE(job.Validate());
+  }
+
+  {  // Chain too long
+    ozz::math::Float4x4 long_chain[ozz::animation::IKChainJob::kMaxChainLength +
+                                   1];
+    ozz::math::SimdQuaternion long_corrections
+        [ozz::animation::IKChainJob::kMaxChainLength];
+    for (size_t i = 0; i < OZZ_ARRAY_SIZE(long_chain); ++i) {
+      long_chain[i] = ozz::math::Float4x4::identity();
+    }
+    ozz::animation::IKChainJob job;
+    job.joints = long_chain;
+    job.joint_corrections = long_corrections;
+    EXPECT_FALSE(job.Validate());
+  }
+
+  {  // Too small corrections output
+    ozz::animation::IKChainJob job;
+    job.joints = joints;
+    job.joint_corrections = ozz::span<ozz::math::SimdQuaternion>(corrections, 1);
+    EXPECT_FALSE(job.Validate());
+  }
+
+  {  // Wrong limits size
+    ozz::animation::IKChainJob job;
+    job.joints = joints;
+    job.joint_corrections = corrections;
+    job.joint_limits = ozz::span<const float>(limits, 1);
+    EXPECT_FALSE(job.Validate());
+  }
+
+  {  // Invalid iterations count
+    ozz::animation::IKChainJob job;
+    job.joints = joints;
+    job.joint_corrections = corrections;
+    job.iterations = 0;
+    EXPECT_FALSE(job.Validate());
+  }
+
+  {  // Valid
+    ozz::animation::IKChainJob job;
+    job.joints = joints;
+    job.joint_corrections = corrections;
+    EXPECT_TRUE(job.Validate());
+  }
+
+  {  // Valid with limits
+    ozz::animation::IKChainJob job;
+    job.joints = joints;
+    job.joint_corrections = corrections;
+    job.joint_limits = limits;
+    EXPECT_TRUE(job.Validate());
+  }
+}
+
+TEST(SingleBone, IKChainJob) {
+  // A single bone of length 1, along x axis.
+  const ozz::math::Float4x4 joints[2] = {
+      ozz::math::Float4x4::identity(),
+      ozz::math::Float4x4::Translation(ozz::math::simd_float4::x_axis())};
+  ozz::math::SimdQuaternion corrections[1];
+  bool reached;
+
+  ozz::animation::IKChainJob job;
+  job.joints = joints;
+  job.joint_corrections = corrections;
+  job.reached = &reached;
+
+  {  // Target straight up, a quarter turn around z is expected.
+    job.target = ozz::math::simd_float4::y_axis();
+    ASSERT_TRUE(job.Run());
+    EXPECT_CHAIN_REACHED(job);
+    const ozz::math::Quaternion z_pi_2 = ozz::math::Quaternion::FromAxisAngle(
+        ozz::math::Float3::z_axis(), ozz::math::kPi_2);
+    EXPECT_SIMDQUATERNION_EQ_TOL(corrections[0], z_pi_2.x, z_pi_2.y, z_pi_2.z,
+                                 z_pi_2.w, 2e-3f);
+  }
+
+  {  // Target already reached, no correction is expected.
+    job.target = ozz::math::simd_float4::x_axis();
+    ASSERT_TRUE(job.Run());
+    EXPECT_CHAIN_REACHED(job);
+    EXPECT_SIMDQUATERNION_EQ_TOL(corrections[0], 0.f, 0.f, 0.f, 1.f, 2e-3f);
+  }
+
+  {  // Target out of reach, the bone still aims at it.
+    job.target = ozz::math::simd_float4::Load(0.f, 3.f, 0.f, 0.f);
+    ASSERT_TRUE(job.Run());
+    EXPECT_CHAIN_NOT_REACHED(job);
+    const ozz::math::Quaternion z_pi_2 = ozz::math::Quaternion::FromAxisAngle(
+        ozz::math::Float3::z_axis(), ozz::math::kPi_2);
+    EXPECT_SIMDQUATERNION_EQ_TOL(corrections[0], z_pi_2.x, z_pi_2.y, z_pi_2.z,
+                                 z_pi_2.w, 2e-3f);
+  }
+}
+
+TEST(MultiJoints, IKChainJob) {
+  // A 5 joints / 4 bones chain of length 4, along x axis.
+  ozz::math::Float4x4 joints[5];
+  for (size_t i = 0; i < OZZ_ARRAY_SIZE(joints); ++i) {
+    joints[i] = ozz::math::Float4x4::Translation(
+        ozz::math::simd_float4::Load(static_cast<float>(i), 0.f, 0.f, 0.f));
+  }
+  ozz::math::SimdQuaternion corrections[4];
+  bool reached;
+
+  ozz::animation::IKChainJob job;
+  job.joints = joints;
+  job.joint_corrections = corrections;
+  job.iterations = 50;
+  job.reached = &reached;
+
+  {  // Reachable target.
+    job.target = ozz::math::simd_float4::Load(2.f, 2.f, 0.f, 0.f);
+    ASSERT_TRUE(job.Run());
+    EXPECT_CHAIN_REACHED(job);
+  }
+
+  {  // Reachable target, out of the chain plane.
+    job.target = ozz::math::simd_float4::Load(1.f, 1.f, 2.f, 0.f);
+    ASSERT_TRUE(job.Run());
+    EXPECT_CHAIN_REACHED(job);
+  }
+
+  {  // Unreachable target.
+    job.target = ozz::math::simd_float4::Load(3.f, 4.f, 0.f, 0.f);
+    ASSERT_TRUE(job.Run());
+    EXPECT_CHAIN_NOT_REACHED(job);
+  }
+}
+
+TEST(JointLimits, IKChainJob) {
+  // A single bone of length 1, along x axis.
+  const ozz::math::Float4x4 joints[2] = {
+      ozz::math::Float4x4::identity(),
+      ozz::math::Float4x4::Translation(ozz::math::simd_float4::x_axis())};
+  ozz::math::SimdQuaternion corrections[1];
+  bool reached;
+
+  ozz::animation::IKChainJob job;
+  job.joints = joints;
+  job.joint_corrections = corrections;
+  job.target = ozz::math::simd_float4::y_axis();
+  job.reached = &reached;
+
+  {  // Limit bigger than the expected correction doesn't interfere.
+    const float limits[1] = {ozz::math::kPi_2 + .1f};
+    job.joint_limits = limits;
+    ASSERT_TRUE(job.Run());
+    EXPECT_CHAIN_REACHED(job);
+    const ozz::math::Quaternion z_pi_2 = ozz::math::Quaternion::FromAxisAngle(
+        ozz::math::Float3::z_axis(), ozz::math::kPi_2);
+    EXPECT_SIMDQUATERNION_EQ_TOL(corrections[0], z_pi_2.x, z_pi_2.y, z_pi_2.z,
+                                 z_pi_2.w, 2e-3f);
+  }
+
+  {  // Correction is clamped to the limit, so target cannot be reached.
+    const float limits[1] = {ozz::math::kPi_4};
+    job.joint_limits = limits;
+    ASSERT_TRUE(job.Run());
+    EXPECT_CHAIN_NOT_REACHED(job);
+    const ozz::math::Quaternion z_pi_4 = ozz::math::Quaternion::FromAxisAngle(
+        ozz::math::Float3::z_axis(), ozz::math::kPi_4);
+    EXPECT_SIMDQUATERNION_EQ_TOL(corrections[0], z_pi_4.x, z_pi_4.y, z_pi_4.z,
+                                 z_pi_4.w, 2e-3f);
+  }
+
+  {  // 0 limit locks the joint.
+    const float limits[1] = {0.f};
+    job.joint_limits = limits;
+    ASSERT_TRUE(job.Run());
+    EXPECT_CHAIN_NOT_REACHED(job);
+    EXPECT_SIMDQUATERNION_EQ_TOL(corrections[0], 0.f, 0.f, 0.f, 1.f, 2e-3f);
+  }
+}
+
+TEST(Weight, IKChainJob) {
+  // A single bone of length 1, along x axis.
+  const ozz::math::Float4x4 joints[2] = {
+      ozz::math::Float4x4::identity(),
+      ozz::math::Float4x4::Translation(ozz::math::simd_float4::x_axis())};
+  ozz::math::SimdQuaternion corrections[1];
+  bool reached;
+
+  ozz::animation::IKChainJob job;
+  job.joints = joints;
+  job.joint_corrections = corrections;
+  job.target = ozz::math::simd_float4::y_axis();
+  job.reached = &reached;
+
+  {  // 0 weight, no correction and target isn't reached.
+    job.weight = 0.f;
+    ASSERT_TRUE(job.Run());
+    EXPECT_SIMDQUATERNION_EQ(corrections[0], 0.f, 0.f, 0.f, 1.f);
+    EXPECT_FALSE(reached);
+  }
+
+  {  // Half weight, correction is an interpolation toward the full one.
+    job.weight = .5f;
+    ASSERT_TRUE(job.Run());
+    EXPECT_FALSE(reached);
+    const ozz::math::Quaternion z_pi_2 = ozz::math::Quaternion::FromAxisAngle(
+        ozz::math::Float3::z_axis(), ozz::math::kPi_2);
+    const ozz::math::Quaternion half = NLerp(
+        ozz::math::Quaternion::identity(), z_pi_2, job.weight);
+    EXPECT_SIMDQUATERNION_EQ_TOL(corrections[0], half.x, half.y, half.z,
+                                 half.w, 2e-3f);
+  }
+
+  {  // Weight above 1 is clamped.
+    job.weight = 2.f;
+    ASSERT_TRUE(job.Run());
+    EXPECT_CHAIN_REACHED(job);
+  }
+}
+
+TEST(ZeroLengthBoneChain, IKChainJob) {
+  // All joints at the same position.
+  const ozz::math::Float4x4 joints[3] = {ozz::math::Float4x4::identity(),
+                                         ozz::math::Float4x4::identity(),
+                                         ozz::math::Float4x4::identity()};
+  ozz::math::SimdQuaternion corrections[2];
+  bool reached;
+
+  ozz::animation::IKChainJob job;
+  job.joints = joints;
+  job.joint_corrections = corrections;
+  job.target = ozz::math::simd_float4::x_axis();
+  job.reached = &reached;
+  ASSERT_TRUE(job.Validate());
+
+  // Just expecting it's not crashing
+  ASSERT_TRUE(job.Run());
+  EXPECT_FALSE(reached);
+}
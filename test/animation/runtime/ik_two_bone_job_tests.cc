@@ -958,3 +958,241 @@ TEST(ZeroLengthBoneChain, IKTwoBoneJob) {
 
   EXPECT_NOT_REACHED(job);
 }
+
+TEST(Estimated, IKTwoBoneJob) {
+  // Setup initial pose
+  const ozz::math::Float4x4 start = ozz::math::Float4x4::identity();
+  const ozz::math::Float4x4 mid = ozz::math::Float4x4::FromAffine(
+      ozz::math::simd_float4::y_axis(),
+      ozz::math::SimdQuaternion::FromAxisAngle(
+          ozz::math::simd_float4::z_axis(),
+          ozz::math::simd_float4::Load1(ozz::math::kPi_2))
+          .xyzw,
+      ozz::math::simd_float4::one());
+  const ozz::math::Float4x4 end = ozz::math::Float4x4::Translation(
+      ozz::math::simd_float4::x_axis() + ozz::math::simd_float4::y_axis());
+  const ozz::math::SimdFloat4 mid_axis =
+      ozz::math::Cross3(start.cols[3] - mid.cols[3], end.cols[3] - mid.cols[3]);
+
+  // Prepares job with a target that bends the chain, and a twist angle, so
+  // every trigonometric code path is exercised.
+  ozz::animation::IKTwoBoneJob job;
+  job.pole_vector = ozz::math::simd_float4::y_axis();
+  job.target = ozz::math::simd_float4::Load(.3f, .5f, 0.f, 0.f);
+  job.twist_angle = ozz::math::kPi_2;
+  job.start_joint = &start;
+  job.mid_joint = &mid;
+  job.end_joint = &end;
+  job.mid_axis = mid_axis;
+  ozz::math::SimdQuaternion qstart;
+  job.start_joint_correction = &qstart;
+  ozz::math::SimdQuaternion qmid;
+  job.mid_joint_correction = &qmid;
+
+  // Full precision reference solve.
+  ASSERT_TRUE(job.Run());
+  const ozz::math::SimdQuaternion qstart_ref = qstart;
+  const ozz::math::SimdQuaternion qmid_ref = qmid;
+
+  // Estimated solve must remain within 1e-3 radian from the reference, which
+  // is far less than quaternion components tolerance.
+  job.estimated = true;
+  ASSERT_TRUE(job.Run());
+  EXPECT_SIMDQUATERNION_EQ_TOL(qstart, ozz::math::GetX(qstart_ref.xyzw),
+                               ozz::math::GetY(qstart_ref.xyzw),
+                               ozz::math::GetZ(qstart_ref.xyzw),
+                               ozz::math::GetW(qstart_ref.xyzw), 1e-3f);
+  EXPECT_SIMDQUATERNION_EQ_TOL(qmid, ozz::math::GetX(qmid_ref.xyzw),
+                               ozz::math::GetY(qmid_ref.xyzw),
+                               ozz::math::GetZ(qmid_ref.xyzw),
+                               ozz::math::GetW(qmid_ref.xyzw), 1e-3f);
+}
+
+TEST(BatchJobValidity, IKTwoBoneJob) {
+  // Setup initial pose
+  const ozz::math::Float4x4 start = ozz::math::Float4x4::identity();
+  const ozz::math::Float4x4 mid = ozz::math::Float4x4::FromAffine(
+      ozz::math::simd_float4::y_axis(),
+      ozz::math::SimdQuaternion::FromAxisAngle(
+          ozz::math::simd_float4::z_axis(),
+          ozz::math::simd_float4::Load1(ozz::math::kPi_2))
+          .xyzw,
+      ozz::math::simd_float4::one());
+  const ozz::math::Float4x4 end = ozz::math::Float4x4::Translation(
+      ozz::math::simd_float4::x_axis() + ozz::math::simd_float4::y_axis());
+
+  const ozz::math::SimdFloat4 targets[2] = {ozz::math::simd_float4::x_axis(),
+                                            ozz::math::simd_float4::y_axis()};
+  const ozz::math::Float4x4 starts[2] = {start, start};
+  const ozz::math::Float4x4 mids[2] = {mid, mid};
+  const ozz::math::Float4x4 ends[2] = {end, end};
+  ozz::math::SimdQuaternion corrections[2];
+  bool reached[2];
+
+  {  // Empty is valid
+    ozz::animation::IKTwoBoneBatchJob job;
+    EXPECT_TRUE(job.Validate());
+  }
+
+  {  // Missing joint matrices
+    ozz::animation::IKTwoBoneBatchJob job;
+    job.targets = targets;
+    job.start_joints = starts;
+    job.mid_joints = mids;
+    job.start_joint_corrections = corrections;
+    job.mid_joint_corrections = corrections;
+    EXPECT_FALSE(job.Validate());
+  }
+
+  {  // Joint matrices size mismatch
+    ozz::animation::IKTwoBoneBatchJob job;
+    job.targets = targets;
+    job.start_joints = starts;
+    job.mid_joints = mids;
+    job.end_joints = ozz::span<const ozz::math::Float4x4>(ends, 1);
+    job.start_joint_corrections = corrections;
+    job.mid_joint_corrections = corrections;
+    EXPECT_FALSE(job.Validate());
+  }
+
+  {  // Too small output corrections
+    ozz::animation::IKTwoBoneBatchJob job;
+    job.targets = targets;
+    job.start_joints = starts;
+    job.mid_joints = mids;
+    job.end_joints = ends;
+    job.start_joint_corrections =
+        ozz::span<ozz::math::SimdQuaternion>(corrections, 1);
+    job.mid_joint_corrections = corrections;
+    EXPECT_FALSE(job.Validate());
+  }
+
+  {  // Wrong reached size
+    ozz::animation::IKTwoBoneBatchJob job;
+    job.targets = targets;
+    job.start_joints = starts;
+    job.mid_joints = mids;
+    job.end_joints = ends;
+    job.start_joint_corrections = corrections;
+    job.mid_joint_corrections = corrections;
+    job.reached = ozz::span<bool>(reached, 1);
+    EXPECT_FALSE(job.Validate());
+  }
+
+  {  // Unnormalized mid axis
+    ozz::animation::IKTwoBoneBatchJob job;
+    job.mid_axis =
+        ozz::math::simd_float4::Load(0.f, .70710678f, 0.f, .70710678f);
+    job.targets = targets;
+    job.start_joints = starts;
+    job.mid_joints = mids;
+    job.end_joints = ends;
+    job.start_joint_corrections = corrections;
+    job.mid_joint_corrections = corrections;
+    EXPECT_TRUE(!job.Validate());
+  }
+
+  {  // Valid
+    ozz::animation::IKTwoBoneBatchJob job;
+    job.targets = targets;
+    job.start_joints = starts;
+    job.mid_joints = mids;
+    job.end_joints = ends;
+    job.start_joint_corrections = corrections;
+    job.mid_joint_corrections = corrections;
+    job.reached = reached;
+    EXPECT_TRUE(job.Validate());
+  }
+}
+
+TEST(Batch, IKTwoBoneJob) {
+  // Setup initial pose, shared by all chains.
+  const ozz::math::Float4x4 start = ozz::math::Float4x4::identity();
+  const ozz::math::Float4x4 mid = ozz::math::Float4x4::FromAffine(
+      ozz::math::simd_float4::y_axis(),
+      ozz::math::SimdQuaternion::FromAxisAngle(
+          ozz::math::simd_float4::z_axis(),
+          ozz::math::simd_float4::Load1(ozz::math::kPi_2))
+          .xyzw,
+      ozz::math::simd_float4::one());
+  const ozz::math::Float4x4 end = ozz::math::Float4x4::Translation(
+      ozz::math::simd_float4::x_axis() + ozz::math::simd_float4::y_axis());
+
+  const size_t kChains = 5;
+  const ozz::math::SimdFloat4 targets[kChains] = {
+      ozz::math::simd_float4::Load(1.f, 1.f, 0.f, 0.f),
+      ozz::math::simd_float4::Load(0.f, 2.f, 0.f, 0.f),
+      ozz::math::simd_float4::Load(1.f, 0.f, 1.f, 0.f),
+      ozz::math::simd_float4::Load(3.f, 0.f, 0.f, 0.f),
+      ozz::math::simd_float4::Load(0.f, 0.f, 0.f, 0.f)};
+  ozz::math::Float4x4 starts[kChains];
+  ozz::math::Float4x4 mids[kChains];
+  ozz::math::Float4x4 ends[kChains];
+  for (size_t i = 0; i < kChains; ++i) {
+    starts[i] = start;
+    mids[i] = mid;
+    ends[i] = end;
+  }
+
+  // Solves all chains at once.
+  ozz::animation::IKTwoBoneBatchJob batch_job;
+  batch_job.soften = .9f;
+  batch_job.twist_angle = ozz::math::kPi / 3.f;
+  batch_job.weight = .7f;
+  batch_job.targets = targets;
+  batch_job.start_joints = starts;
+  batch_job.mid_joints = mids;
+  batch_job.end_joints = ends;
+  ozz::math::SimdQuaternion batch_qstarts[kChains];
+  ozz::math::SimdQuaternion batch_qmids[kChains];
+  bool batch_reached[kChains];
+  batch_job.start_joint_corrections = batch_qstarts;
+  batch_job.mid_joint_corrections = batch_qmids;
+  batch_job.reached = batch_reached;
+  ASSERT_TRUE(batch_job.Run());
+
+  // Expects bit exact results compared to solving each chain separately.
+  for (size_t i = 0; i < kChains; ++i) {
+    ozz::animation::IKTwoBoneJob job;
+    job.soften = batch_job.soften;
+    job.twist_angle = batch_job.twist_angle;
+    job.weight = batch_job.weight;
+    job.target = targets[i];
+    job.start_joint = &starts[i];
+    job.mid_joint = &mids[i];
+    job.end_joint = &ends[i];
+    ozz::math::SimdQuaternion qstart;
+    ozz::math::SimdQuaternion qmid;
+    bool reached;
+    job.start_joint_correction = &qstart;
+    job.mid_joint_correction = &qmid;
+    job.reached = &reached;
+    ASSERT_TRUE(job.Run());
+
+    EXPECT_SIMDQUATERNION_EQ_EST(batch_qstarts[i], ozz::math::GetX(qstart.xyzw),
+                                 ozz::math::GetY(qstart.xyzw),
+                                 ozz::math::GetZ(qstart.xyzw),
+                                 ozz::math::GetW(qstart.xyzw));
+    EXPECT_SIMDQUATERNION_EQ_EST(batch_qmids[i], ozz::math::GetX(qmid.xyzw),
+                                 ozz::math::GetY(qmid.xyzw),
+                                 ozz::math::GetZ(qmid.xyzw),
+                                 ozz::math::GetW(qmid.xyzw));
+    EXPECT_EQ(batch_reached[i], reached);
+  }
+
+  {  // 0 weight early out, no reached output.
+    ozz::animation::IKTwoBoneBatchJob job;
+    job.weight = 0.f;
+    job.targets = targets;
+    job.start_joints = starts;
+    job.mid_joints = mids;
+    job.end_joints = ends;
+    job.start_joint_corrections = batch_qstarts;
+    job.mid_joint_corrections = batch_qmids;
+    ASSERT_TRUE(job.Run());
+    for (size_t i = 0; i < kChains; ++i) {
+      EXPECT_SIMDQUATERNION_EQ(batch_qstarts[i], 0.f, 0.f, 0.f, 1.f);
+      EXPECT_SIMDQUATERNION_EQ(batch_qmids[i], 0.f, 0.f, 0.f, 1.f);
+    }
+  }
+}
@@ -0,0 +1,168 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/job_capture.h"
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/animation_builder.h"
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/offline/raw_skeleton.h"
+#include "ozz/animation/offline/skeleton_builder.h"
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/animation/runtime/blending_job.h"
+#include "ozz/animation/runtime/local_to_model_job.h"
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/io/archive.h"
+#include "ozz/base/io/stream.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+using ozz::animation::JobCapture;
+
+TEST(Capture, JobCapture) {
+  // Builds minimal assets for the jobs to reference.
+  ozz::animation::offline::RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(2);
+  raw_skeleton.roots[0].name = "j0";
+  raw_skeleton.roots[1].name = "j1";
+  ozz::animation::offline::SkeletonBuilder skeleton_builder;
+  ozz::unique_ptr<ozz::animation::Skeleton> skeleton =
+      skeleton_builder(raw_skeleton);
+  ASSERT_TRUE(skeleton);
+
+  ozz::animation::offline::RawAnimation raw_animation;
+  raw_animation.duration = 2.f;
+  raw_animation.tracks.resize(2);
+  raw_animation.name = "captured";
+  ozz::animation::offline::AnimationBuilder animation_builder;
+  ozz::unique_ptr<ozz::animation::Animation> animation =
+      animation_builder(raw_animation);
+  ASSERT_TRUE(animation);
+
+  ozz::math::SoaTransform locals[1];
+  ozz::math::Float4x4 models[2];
+
+  JobCapture capture;
+  EXPECT_EQ(capture.num_jobs(), 0u);
+
+  {  // Sampling job.
+    ozz::animation::SamplingJob::Context context(animation->num_tracks());
+    ozz::animation::SamplingJob job;
+    job.animation = animation.get();
+    job.context = &context;
+    job.ratio = .5f;
+    job.output = locals;
+    capture.Capture(job);
+  }
+
+  {  // Blending job, with a normal and an additive layer.
+    ozz::animation::BlendingJob::Layer layers[1];
+    layers[0].transform = locals;
+    layers[0].weight = .46f;
+    ozz::animation::BlendingJob::Layer additive_layers[1];
+    additive_layers[0].transform = locals;
+    additive_layers[0].weight = .7f;
+    ozz::animation::BlendingJob job;
+    job.layers = layers;
+    job.additive_layers = additive_layers;
+    job.rest_pose = skeleton->joint_rest_poses();
+    job.output = locals;
+    capture.Capture(job);
+  }
+
+  {  // Local to model job, with a partial range.
+    ozz::animation::LocalToModelJob job;
+    job.skeleton = skeleton.get();
+    job.from = 1;
+    job.input = locals;
+    job.output = models;
+    capture.Capture(job);
+  }
+
+  EXPECT_EQ(capture.num_jobs(), 3u);
+
+  {  // Captured sampling descriptor records asset identity and shape.
+    ASSERT_EQ(capture.sampling_jobs().size(), 1u);
+    const JobCapture::Sampling& entry = capture.sampling_jobs()[0];
+    EXPECT_NE(entry.animation_id, 0u);
+    EXPECT_EQ(entry.num_tracks, 2);
+    EXPECT_FLOAT_EQ(entry.duration, 2.f);
+    EXPECT_FLOAT_EQ(entry.ratio, .5f);
+    EXPECT_EQ(entry.num_output_soa, 1);
+    EXPECT_FALSE(entry.has_joint_mask);
+  }
+
+  {  // Captured blending descriptor references its layers range.
+    ASSERT_EQ(capture.blending_jobs().size(), 1u);
+    const JobCapture::Blending& entry = capture.blending_jobs()[0];
+    EXPECT_EQ(entry.first_layer, 0);
+    EXPECT_EQ(entry.num_layers, 2);
+    ASSERT_EQ(capture.layers().size(), 2u);
+    EXPECT_FLOAT_EQ(capture.layers()[0].weight, .46f);
+    EXPECT_FALSE(capture.layers()[0].additive);
+    EXPECT_FLOAT_EQ(capture.layers()[1].weight, .7f);
+    EXPECT_TRUE(capture.layers()[1].additive);
+  }
+
+  {  // Captured local-to-model descriptor records skeleton identity and
+     // range.
+    ASSERT_EQ(capture.local_to_model_jobs().size(), 1u);
+    const JobCapture::LocalToModel& entry = capture.local_to_model_jobs()[0];
+    EXPECT_EQ(entry.skeleton_id, skeleton->structural_hash());
+    EXPECT_EQ(entry.num_joints, 2);
+    EXPECT_EQ(entry.from, 1);
+    EXPECT_FALSE(entry.from_excluded);
+  }
+
+  // Round trips through an archive.
+  ozz::io::MemoryStream stream;
+  {
+    ozz::io::OArchive oarchive(&stream);
+    oarchive << capture;
+  }
+  stream.Seek(0, ozz::io::Stream::kSet);
+  JobCapture loaded;
+  {
+    ozz::io::IArchive iarchive(&stream);
+    iarchive >> loaded;
+  }
+  EXPECT_EQ(loaded.num_jobs(), capture.num_jobs());
+  ASSERT_EQ(loaded.sampling_jobs().size(), 1u);
+  EXPECT_EQ(loaded.sampling_jobs()[0].animation_id,
+            capture.sampling_jobs()[0].animation_id);
+  ASSERT_EQ(loaded.layers().size(), 2u);
+  EXPECT_FLOAT_EQ(loaded.layers()[1].weight, .7f);
+  ASSERT_EQ(loaded.local_to_model_jobs().size(), 1u);
+  EXPECT_EQ(loaded.local_to_model_jobs()[0].skeleton_id,
+            skeleton->structural_hash());
+
+  // Clear discards everything.
+  capture.Clear();
+  EXPECT_EQ(capture.num_jobs(), 0u);
+  EXPECT_TRUE(capture.layers().empty());
+}
@@ -0,0 +1,159 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/joint_name_table.h"
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/raw_skeleton.h"
+#include "ozz/animation/offline/skeleton_builder.h"
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/memory/unique_ptr.h"
+#include "ozz/base/span.h"
+
+using ozz::animation::JointNameTable;
+using ozz::animation::Skeleton;
+using ozz::animation::offline::RawSkeleton;
+using ozz::animation::offline::SkeletonBuilder;
+
+namespace {
+
+// Builds a single chain skeleton from _names, depth-first joint order matches
+// _names order.
+ozz::unique_ptr<Skeleton> BuildSkeleton(
+    const ozz::span<const char* const>& _names) {
+  RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  RawSkeleton::Joint* joint = &raw_skeleton.roots[0];
+  for (size_t i = 0; i < _names.size(); ++i) {
+    joint->name = _names[i];
+    joint->transform = ozz::math::Transform::identity();
+    if (i + 1 < _names.size()) {
+      joint->children.resize(1);
+      joint = &joint->children[0];
+    }
+  }
+  SkeletonBuilder builder;
+  return builder(raw_skeleton);
+}
+}  // namespace
+
+TEST(Intern, JointNameTable) {
+  JointNameTable table;
+  EXPECT_EQ(table.count(), 0);
+
+  // Ids are dense, assigned in interning order.
+  const int hips = table.Intern("hips");
+  const int spine = table.Intern("spine");
+  const int head = table.Intern("head");
+  EXPECT_EQ(hips, 0);
+  EXPECT_EQ(spine, 1);
+  EXPECT_EQ(head, 2);
+  EXPECT_EQ(table.count(), 3);
+
+  // Interning an existing name returns the same id, from a name copy too.
+  char spine_copy[8];
+  std::strcpy(spine_copy, "spine");
+  EXPECT_EQ(table.Intern(spine_copy), spine);
+  EXPECT_EQ(table.count(), 3);
+
+  // Names and hashes are retained.
+  EXPECT_STREQ(table.name(head), "head");
+  EXPECT_EQ(table.hash(head), Skeleton::JointNameHash("head"));
+
+  // Find doesn't intern.
+  EXPECT_EQ(table.Find("spine"), spine);
+  EXPECT_EQ(table.Find("tail"), -1);
+  EXPECT_EQ(table.count(), 3);
+}
+
+TEST(ResolveJoints, JointNameTable) {
+  JointNameTable table;
+  const int hips = table.Intern("hips");
+  const int tail = table.Intern("tail");
+  const int head = table.Intern("head");
+  const int spine = table.Intern("spine");
+
+  // Two skeletons sharing most names, with different joint orderings.
+  const char* biped_names[] = {"hips", "spine", "head"};
+  ozz::unique_ptr<Skeleton> biped = BuildSkeleton(ozz::make_span(biped_names));
+  ASSERT_TRUE(biped);
+  const char* quadruped_names[] = {"hips", "tail", "spine"};
+  ozz::unique_ptr<Skeleton> quadruped =
+      BuildSkeleton(ozz::make_span(quadruped_names));
+  ASSERT_TRUE(quadruped);
+
+  {  // Too small output span fails.
+    int16_t joints[3];
+    EXPECT_FALSE(table.ResolveJoints(*biped, ozz::make_span(joints)));
+  }
+
+  {  // Whole table resolution, unmatched names map to -1.
+    int16_t joints[4];
+    ASSERT_TRUE(table.ResolveJoints(*biped, ozz::make_span(joints)));
+    EXPECT_EQ(joints[hips], biped->FindJoint("hips"));
+    EXPECT_EQ(joints[tail], -1);
+    EXPECT_EQ(joints[head], biped->FindJoint("head"));
+    EXPECT_EQ(joints[spine], biped->FindJoint("spine"));
+
+    // Same table resolves against another skeleton.
+    ASSERT_TRUE(table.ResolveJoints(*quadruped, ozz::make_span(joints)));
+    EXPECT_EQ(joints[hips], quadruped->FindJoint("hips"));
+    EXPECT_EQ(joints[tail], quadruped->FindJoint("tail"));
+    EXPECT_EQ(joints[head], -1);
+    EXPECT_EQ(joints[spine], quadruped->FindJoint("spine"));
+  }
+
+  {  // Gather variant accepts any id order and duplicates.
+    const int ids[] = {head, hips, head, tail};
+    int16_t joints[4];
+    ASSERT_TRUE(
+        table.ResolveJoints(*biped, ozz::make_span(ids), ozz::make_span(joints)));
+    EXPECT_EQ(joints[0], biped->FindJoint("head"));
+    EXPECT_EQ(joints[1], biped->FindJoint("hips"));
+    EXPECT_EQ(joints[2], biped->FindJoint("head"));
+    EXPECT_EQ(joints[3], -1);
+
+    // Out of range ids fail.
+    const int bad_ids[] = {hips, table.count()};
+    EXPECT_FALSE(table.ResolveJoints(*biped, ozz::make_span(bad_ids),
+                                     ozz::make_span(joints)));
+    const int neg_ids[] = {-1};
+    EXPECT_FALSE(table.ResolveJoints(*biped, ozz::make_span(neg_ids),
+                                     ozz::make_span(joints)));
+
+    // Too small output span fails.
+    EXPECT_FALSE(table.ResolveJoints(*biped, ozz::make_span(ids),
+                                     ozz::make_span(joints).first(3)));
+  }
+
+  // Interning after a resolution extends the table, ids remain stable.
+  const int neck = table.Intern("neck");
+  EXPECT_EQ(neck, 4);
+  EXPECT_EQ(table.Find("head"), head);
+}
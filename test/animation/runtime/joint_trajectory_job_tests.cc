@@ -0,0 +1,255 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/joint_trajectory_job.h"
+
+#include <algorithm>
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/animation_builder.h"
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/offline/raw_skeleton.h"
+#include "ozz/animation/offline/skeleton_builder.h"
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/animation/runtime/local_to_model_job.h"
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/maths/simd_math.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+using ozz::animation::Animation;
+using ozz::animation::JointTrajectoryJob;
+using ozz::animation::Skeleton;
+using ozz::animation::offline::AnimationBuilder;
+using ozz::animation::offline::RawAnimation;
+using ozz::animation::offline::RawSkeleton;
+using ozz::animation::offline::SkeletonBuilder;
+
+namespace {
+
+/* Builds the test skeleton.
+ 4 joints
+
+     *
+     |
+    root
+    / \
+ spine leg
+   |
+  hand
+*/
+ozz::unique_ptr<Skeleton> BuildSkeleton() {
+  RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  RawSkeleton::Joint& root = raw_skeleton.roots[0];
+  root.name = "root";
+  root.children.resize(2);
+  root.children[0].name = "spine";
+  root.children[0].children.resize(1);
+  root.children[0].children[0].name = "hand";
+  root.children[1].name = "leg";
+  SkeletonBuilder builder;
+  return builder(raw_skeleton);
+}
+
+// Builds an animation moving and rotating every joint of the skeleton.
+ozz::unique_ptr<Animation> BuildAnimation(const Skeleton& _skeleton) {
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(_skeleton.num_joints());
+  for (int i = 0; i < _skeleton.num_joints(); ++i) {
+    RawAnimation::JointTrack& track = raw_animation.tracks[i];
+    const float f = static_cast<float>(i);
+    const RawAnimation::TranslationKey t_key0 = {
+        0.f, ozz::math::Float3(f, 1.f, -f)};
+    const RawAnimation::TranslationKey t_key1 = {
+        1.f, ozz::math::Float3(f + 2.f, -1.f, f)};
+    track.translations.push_back(t_key0);
+    track.translations.push_back(t_key1);
+    const RawAnimation::RotationKey r_key0 = {0.f,
+                                              ozz::math::Quaternion::identity()};
+    const RawAnimation::RotationKey r_key1 = {
+        1.f, ozz::math::Quaternion::FromAxisAngle(
+                 ozz::math::Float3::y_axis(), ozz::math::kPi / (f + 2.f))};
+    track.rotations.push_back(r_key0);
+    track.rotations.push_back(r_key1);
+  }
+  AnimationBuilder builder;
+  return builder(raw_animation);
+}
+
+// Compares a trajectory transform with the full pipeline (sample + ltm)
+// model-space matrix, with a tolerance absorbing the different (but
+// equivalent) matrix construction paths.
+void ExpectMatrixNear(const ozz::math::Float4x4& _test,
+                      const ozz::math::Float4x4& _ref) {
+  for (int c = 0; c < 4; ++c) {
+    float test[4], ref[4];
+    ozz::math::StorePtrU(_test.cols[c], test);
+    ozz::math::StorePtrU(_ref.cols[c], ref);
+    for (int i = 0; i < 4; ++i) {
+      EXPECT_NEAR(test[i], ref[i], 1e-4f);
+    }
+  }
+}
+}  // namespace
+
+TEST(JobValidity, JointTrajectoryJob) {
+  ozz::unique_ptr<Skeleton> skeleton = BuildSkeleton();
+  ASSERT_TRUE(skeleton);
+  ozz::unique_ptr<Animation> animation = BuildAnimation(*skeleton);
+  ASSERT_TRUE(animation);
+
+  ozz::animation::SamplingJob::Context context(animation->num_tracks());
+  ozz::math::Float4x4 trajectory[4];
+
+  {  // Default job is invalid.
+    JointTrajectoryJob job;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  JointTrajectoryJob job;
+  job.animation = animation.get();
+  job.skeleton = skeleton.get();
+  job.context = &context;
+  job.joint = 0;
+  job.trajectory = trajectory;
+  EXPECT_TRUE(job.Validate());
+
+  {  // Empty trajectory output.
+    JointTrajectoryJob invalid = job;
+    invalid.trajectory = {};
+    EXPECT_FALSE(invalid.Validate());
+    EXPECT_FALSE(invalid.Run());
+  }
+
+  {  // Out of range joint.
+    JointTrajectoryJob invalid = job;
+    invalid.joint = -1;
+    EXPECT_FALSE(invalid.Validate());
+    invalid.joint = skeleton->num_joints();
+    EXPECT_FALSE(invalid.Validate());
+  }
+
+  {  // Too small context.
+    ozz::animation::SamplingJob::Context small_context;
+    JointTrajectoryJob invalid = job;
+    invalid.context = &small_context;
+    EXPECT_FALSE(invalid.Validate());
+  }
+}
+
+TEST(Trajectory, JointTrajectoryJob) {
+  ozz::unique_ptr<Skeleton> skeleton = BuildSkeleton();
+  ASSERT_TRUE(skeleton);
+  ozz::unique_ptr<Animation> animation = BuildAnimation(*skeleton);
+  ASSERT_TRUE(animation);
+
+  // Reference poses from the full pipeline, one per subsample.
+  const size_t kNumSamples = 8;
+  const float from = .2f;
+  const float to = .9f;
+  ozz::animation::SamplingJob::Context ref_context(animation->num_tracks());
+  ozz::vector<ozz::math::SoaTransform> locals(skeleton->num_soa_joints());
+  ozz::vector<ozz::math::Float4x4> models(skeleton->num_joints());
+  ozz::vector<ozz::math::Float4x4> references(kNumSamples *
+                                              skeleton->num_joints());
+  for (size_t s = 0; s < kNumSamples; ++s) {
+    ozz::animation::SamplingJob sampling;
+    sampling.animation = animation.get();
+    sampling.context = &ref_context;
+    sampling.ratio = from + (to - from) * s / (kNumSamples - 1);
+    sampling.output = ozz::make_span(locals);
+    ASSERT_TRUE(sampling.Run());
+    ozz::animation::LocalToModelJob ltm;
+    ltm.skeleton = skeleton.get();
+    ltm.input = ozz::make_span(locals);
+    ltm.output = ozz::make_span(models);
+    ASSERT_TRUE(ltm.Run());
+    std::copy(models.begin(), models.end(),
+              references.begin() + s * skeleton->num_joints());
+  }
+
+  // Every joint trajectory matches its full pipeline counterpart, leaves
+  // (hand) as well as joints with masked-out siblings (leg).
+  ozz::animation::SamplingJob::Context context(animation->num_tracks());
+  for (int joint = 0; joint < skeleton->num_joints(); ++joint) {
+    ozz::math::Float4x4 trajectory[kNumSamples];
+    JointTrajectoryJob job;
+    job.animation = animation.get();
+    job.skeleton = skeleton.get();
+    job.context = &context;
+    job.joint = joint;
+    job.from = from;
+    job.to = to;
+    job.trajectory = trajectory;
+    ASSERT_TRUE(job.Run());
+    for (size_t s = 0; s < kNumSamples; ++s) {
+      ExpectMatrixNear(trajectory[s],
+                       references[s * skeleton->num_joints() + joint]);
+    }
+  }
+
+  {  // A single sample outputs the transform at ratio from.
+    const int hand = skeleton->FindJoint("hand");
+    ASSERT_NE(hand, -1);
+    ozz::math::Float4x4 single[1];
+    JointTrajectoryJob job;
+    job.animation = animation.get();
+    job.skeleton = skeleton.get();
+    job.context = &context;
+    job.joint = hand;
+    job.from = from;
+    job.to = to;
+    job.trajectory = single;
+    ASSERT_TRUE(job.Run());
+    ExpectMatrixNear(single[0], references[hand]);
+  }
+
+  {  // A backward window samples backward.
+    const int leg = skeleton->FindJoint("leg");
+    ASSERT_NE(leg, -1);
+    ozz::math::Float4x4 trajectory[kNumSamples];
+    JointTrajectoryJob job;
+    job.animation = animation.get();
+    job.skeleton = skeleton.get();
+    job.context = &context;
+    job.joint = leg;
+    job.from = to;
+    job.to = from;
+    job.trajectory = trajectory;
+    ASSERT_TRUE(job.Run());
+    for (size_t s = 0; s < kNumSamples; ++s) {
+      ExpectMatrixNear(
+          trajectory[s],
+          references[(kNumSamples - 1 - s) * skeleton->num_joints() + leg]);
+    }
+  }
+}
@@ -0,0 +1,170 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/joint_weight_mask.h"
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/raw_skeleton.h"
+#include "ozz/animation/offline/skeleton_builder.h"
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/maths/gtest_math_helper.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+using ozz::animation::JointWeightMask;
+using ozz::animation::Skeleton;
+using ozz::animation::offline::RawSkeleton;
+using ozz::animation::offline::SkeletonBuilder;
+
+namespace {
+
+// Builds a 5 joints skeleton (2 soa entries): root -> (spine1 -> spine2,
+// arm_l, arm_r), aka depth-first order root, spine1, spine2, arm_l, arm_r.
+ozz::unique_ptr<Skeleton> BuildTestSkeleton() {
+  RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  RawSkeleton::Joint& root = raw_skeleton.roots[0];
+  root.name = "root";
+  root.transform = ozz::math::Transform::identity();
+  root.children.resize(3);
+  root.children[0].name = "spine1";
+  root.children[0].transform = ozz::math::Transform::identity();
+  root.children[0].children.resize(1);
+  root.children[0].children[0].name = "spine2";
+  root.children[0].children[0].transform = ozz::math::Transform::identity();
+  root.children[1].name = "arm_l";
+  root.children[1].transform = ozz::math::Transform::identity();
+  root.children[2].name = "arm_r";
+  root.children[2].transform = ozz::math::Transform::identity();
+  SkeletonBuilder builder;
+  return builder(raw_skeleton);
+}
+}  // namespace
+
+TEST(Validity, JointWeightMask) {
+  ozz::unique_ptr<Skeleton> skeleton = BuildTestSkeleton();
+  ASSERT_TRUE(skeleton);
+  const Skeleton empty;
+
+  JointWeightMask mask;
+  EXPECT_EQ(mask.num_joints(), 0);
+  EXPECT_EQ(mask.joint_weights().size(), 0u);
+
+  // Empty skeletons fail.
+  EXPECT_FALSE(mask.Initialize(empty, 1.f));
+  const float weights5[5] = {1.f, 1.f, 1.f, 1.f, 1.f};
+  EXPECT_FALSE(mask.Initialize(empty, ozz::make_span(weights5)));
+  EXPECT_FALSE(mask.Initialize(empty, "*", 1.f, 0.f));
+
+  // Scalar weights size must match the number of joints.
+  const float weights3[3] = {1.f, 1.f, 1.f};
+  EXPECT_FALSE(mask.Initialize(*skeleton, ozz::make_span(weights3)));
+
+  // A nullptr pattern fails.
+  EXPECT_FALSE(mask.Initialize(*skeleton, nullptr, 1.f, 0.f));
+  EXPECT_EQ(mask.num_joints(), 0);
+
+  // Combining uninitialized or mismatching masks fails.
+  JointWeightMask other;
+  EXPECT_FALSE(mask.Multiply(other));
+  EXPECT_FALSE(mask.Max(other));
+  EXPECT_TRUE(mask.Initialize(*skeleton, 1.f));
+  EXPECT_FALSE(mask.Multiply(other));
+  EXPECT_FALSE(mask.Max(other));
+}
+
+TEST(Initialize, JointWeightMask) {
+  ozz::unique_ptr<Skeleton> skeleton = BuildTestSkeleton();
+  ASSERT_TRUE(skeleton);
+
+  {  // Uniform mask. Padding lanes of the last soa entry are 0.
+    JointWeightMask mask;
+    EXPECT_TRUE(mask.Initialize(*skeleton, .5f));
+    EXPECT_EQ(mask.num_joints(), 5);
+    ASSERT_EQ(mask.joint_weights().size(), 2u);
+    EXPECT_SIMDFLOAT_EQ(mask.joint_weights()[0], .5f, .5f, .5f, .5f);
+    EXPECT_SIMDFLOAT_EQ(mask.joint_weights()[1], .5f, 0.f, 0.f, 0.f);
+  }
+
+  {  // Scalar weights are SoA-packed in joint order.
+    const float weights[5] = {.1f, .2f, .3f, .4f, .5f};
+    JointWeightMask mask;
+    EXPECT_TRUE(mask.Initialize(*skeleton, ozz::make_span(weights)));
+    ASSERT_EQ(mask.joint_weights().size(), 2u);
+    EXPECT_SIMDFLOAT_EQ(mask.joint_weights()[0], .1f, .2f, .3f, .4f);
+    EXPECT_SIMDFLOAT_EQ(mask.joint_weights()[1], .5f, 0.f, 0.f, 0.f);
+  }
+
+  {  // Pattern matching, depth-first order is root, spine1, spine2, arm_l,
+     // arm_r.
+    JointWeightMask mask;
+    EXPECT_TRUE(mask.Initialize(*skeleton, "spine*", 1.f, 0.f));
+    ASSERT_EQ(mask.joint_weights().size(), 2u);
+    EXPECT_SIMDFLOAT_EQ(mask.joint_weights()[0], 0.f, 1.f, 1.f, 0.f);
+    EXPECT_SIMDFLOAT_EQ(mask.joint_weights()[1], 0.f, 0.f, 0.f, 0.f);
+
+    // ? matches a single character.
+    EXPECT_TRUE(mask.Initialize(*skeleton, "arm_?", .75f, .25f));
+    EXPECT_SIMDFLOAT_EQ(mask.joint_weights()[0], .25f, .25f, .25f, .75f);
+    EXPECT_SIMDFLOAT_EQ(mask.joint_weights()[1], .75f, 0.f, 0.f, 0.f);
+  }
+}
+
+TEST(Combine, JointWeightMask) {
+  ozz::unique_ptr<Skeleton> skeleton = BuildTestSkeleton();
+  ASSERT_TRUE(skeleton);
+
+  JointWeightMask spine;
+  EXPECT_TRUE(spine.Initialize(*skeleton, "spine*", 1.f, 0.f));
+  JointWeightMask arms;
+  EXPECT_TRUE(arms.Initialize(*skeleton, "arm_*", 1.f, 0.f));
+
+  {  // Max unions masks, ex: blending an upper body layer on spine and arms.
+    JointWeightMask mask = spine;
+    EXPECT_TRUE(mask.Max(arms));
+    EXPECT_SIMDFLOAT_EQ(mask.joint_weights()[0], 0.f, 1.f, 1.f, 1.f);
+    EXPECT_SIMDFLOAT_EQ(mask.joint_weights()[1], 1.f, 0.f, 0.f, 0.f);
+  }
+
+  {  // Multiply intersects masks.
+    JointWeightMask mask = spine;
+    EXPECT_TRUE(mask.Multiply(arms));
+    EXPECT_SIMDFLOAT_EQ(mask.joint_weights()[0], 0.f, 0.f, 0.f, 0.f);
+    EXPECT_SIMDFLOAT_EQ(mask.joint_weights()[1], 0.f, 0.f, 0.f, 0.f);
+  }
+
+  {  // Invert complements a mask, keeping padding lanes to 0.
+    JointWeightMask mask = spine;
+    mask.Invert();
+    EXPECT_SIMDFLOAT_EQ(mask.joint_weights()[0], 1.f, 0.f, 0.f, 1.f);
+    EXPECT_SIMDFLOAT_EQ(mask.joint_weights()[1], 1.f, 0.f, 0.f, 0.f);
+
+    // Inverting twice is the identity.
+    mask.Invert();
+    EXPECT_SIMDFLOAT_EQ(mask.joint_weights()[0], 0.f, 1.f, 1.f, 0.f);
+    EXPECT_SIMDFLOAT_EQ(mask.joint_weights()[1], 0.f, 0.f, 0.f, 0.f);
+  }
+}
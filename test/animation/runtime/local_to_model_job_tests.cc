@@ -29,7 +29,9 @@
 #include "ozz/animation/offline/raw_skeleton.h"
 #include "ozz/animation/offline/skeleton_builder.h"
 #include "ozz/animation/runtime/local_to_model_job.h"
+#include "ozz/animation/runtime/local_to_model_job_t.h"
 #include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/compiled_job.h"
 #include "ozz/base/maths/gtest_math_helper.h"
 #include "ozz/base/maths/soa_transform.h"
 #include "ozz/base/memory/unique_ptr.h"
@@ -1008,6 +1010,144 @@ TEST(TransformationFromToExclude, LocalToModel) {
   }
 }
 
+TEST(TransformationMask, LocalToModel) {
+  // Builds the skeleton
+  /*
+   6 joints
+     j0
+    /  \
+   j1  j3
+    |  / \
+   j2 j4 j5
+  */
+  RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  RawSkeleton::Joint& root = raw_skeleton.roots[0];
+  root.name = "j0";
+
+  root.children.resize(2);
+  root.children[0].name = "j1";
+  root.children[1].name = "j3";
+
+  root.children[0].children.resize(1);
+  root.children[0].children[0].name = "j2";
+
+  root.children[1].children.resize(2);
+  root.children[1].children[0].name = "j4";
+  root.children[1].children[1].name = "j5";
+
+  EXPECT_TRUE(raw_skeleton.Validate());
+  EXPECT_EQ(raw_skeleton.num_joints(), 6);
+
+  SkeletonBuilder builder;
+  ozz::unique_ptr<Skeleton> skeleton(builder(raw_skeleton));
+  ASSERT_TRUE(skeleton);
+
+  // Initializes an input transformation.
+  ozz::math::SoaTransform input[2] = {
+      // Stores up to 8 inputs, needs 6.
+      {{ozz::math::simd_float4::Load(2.f, 0.f, 1.f, -2.f),
+        ozz::math::simd_float4::Load(2.f, 0.f, 2.f, -2.f),
+        ozz::math::simd_float4::Load(2.f, 0.f, 4.f, -2.f)},
+       {ozz::math::simd_float4::Load(0.f, 0.f, 0.f, 0.f),
+        ozz::math::simd_float4::Load(0.f, .70710677f, 0.f, 0.f),
+        ozz::math::simd_float4::Load(0.f, 0.f, 0.f, 0.f),
+        ozz::math::simd_float4::Load(1.f, .70710677f, 1.f, 1.f)},
+       {ozz::math::simd_float4::Load(1.f, 1.f, 1.f, 10.f),
+        ozz::math::simd_float4::Load(1.f, 1.f, 1.f, 10.f),
+        ozz::math::simd_float4::Load(1.f, 1.f, 1.f, 10.f)}},
+      {{ozz::math::simd_float4::Load(12.f, 0.f, 0.f, 0.f),
+        ozz::math::simd_float4::Load(46.f, 0.f, 0.f, 0.f),
+        ozz::math::simd_float4::Load(-12.f, 0.f, 0.f, 0.f)},
+       {ozz::math::simd_float4::Load(0.f, 0.f, 0.f, 0.f),
+        ozz::math::simd_float4::Load(0.f, 0.f, 0.f, 0.f),
+        ozz::math::simd_float4::Load(0.f, 0.f, 0.f, 0.f),
+        ozz::math::simd_float4::Load(1.f, 1.f, 1.f, 1.f)},
+       {ozz::math::simd_float4::Load(1.f, -.1f, 1.f, 1.f),
+        ozz::math::simd_float4::Load(1.f, -.1f, 1.f, 1.f),
+        ozz::math::simd_float4::Load(1.f, -.1f, 1.f, 1.f)}}};
+
+  {
+    // Full mask, all joints are processed like with an empty mask.
+    ozz::math::Float4x4 output[6];
+    const ozz::byte joint_mask[1] = {0x3};  // 6 joints aka 2 soa blocks.
+    LocalToModelJob job;
+    job.skeleton = skeleton.get();
+    job.input = input;
+    job.output = output;
+    job.joint_mask = joint_mask;
+    EXPECT_TRUE(job.Validate());
+    EXPECT_TRUE(job.Run());
+    EXPECT_FLOAT4x4_EQ(output[0], 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f,
+                       0.f, 1.f, 0.f, 2.f, 2.f, 2.f, 1.f);
+    EXPECT_FLOAT4x4_EQ(output[1], 0.f, 0.f, -1.f, 0.f, 0.f, 1.f, 0.f, 0.f, 1.f,
+                       0.f, 0.f, 0.f, 2.f, 2.f, 2.f, 1.f);
+    EXPECT_FLOAT4x4_EQ(output[2], 0.f, 0.f, -1.f, 0.f, 0.f, 1.f, 0.f, 0.f, 1.f,
+                       0.f, 0.f, 0.f, 6.f, 4.f, 1.f, 1.f);
+    EXPECT_FLOAT4x4_EQ(output[3], 10.f, 0.f, 0.f, 0.f, 0.f, 10.f, 0.f, 0.f, 0.f,
+                       0.f, 10.f, 0.f, 0.f, 0.f, 0.f, 1.f);
+    EXPECT_FLOAT4x4_EQ(output[4], 10.f, 0.f, 0.f, 0.f, 0.f, 10.f, 0.f, 0.f, 0.f,
+                       0.f, 10.f, 0.f, 120.f, 460.f, -120.f, 1.f);
+    EXPECT_FLOAT4x4_EQ(output[5], -1.f, 0.f, 0.f, 0.f, 0.f, -1.f, 0.f, 0.f, 0.f,
+                       0.f, -1.f, 0.f, 0.f, 0.f, 0.f, 1.f);
+  }
+
+  {
+    // First block only, second block output is left unchanged.
+    ozz::math::Float4x4 output[6] = {
+        ozz::math::Float4x4::identity(), ozz::math::Float4x4::identity(),
+        ozz::math::Float4x4::identity(), ozz::math::Float4x4::identity(),
+        ozz::math::Float4x4::identity(), ozz::math::Float4x4::identity()};
+    const ozz::byte joint_mask[1] = {0x1};
+    LocalToModelJob job;
+    job.skeleton = skeleton.get();
+    job.input = input;
+    job.output = output;
+    job.joint_mask = joint_mask;
+    EXPECT_TRUE(job.Validate());
+    EXPECT_TRUE(job.Run());
+    EXPECT_FLOAT4x4_EQ(output[0], 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f,
+                       0.f, 1.f, 0.f, 2.f, 2.f, 2.f, 1.f);
+    EXPECT_FLOAT4x4_EQ(output[1], 0.f, 0.f, -1.f, 0.f, 0.f, 1.f, 0.f, 0.f, 1.f,
+                       0.f, 0.f, 0.f, 2.f, 2.f, 2.f, 1.f);
+    EXPECT_FLOAT4x4_EQ(output[2], 0.f, 0.f, -1.f, 0.f, 0.f, 1.f, 0.f, 0.f, 1.f,
+                       0.f, 0.f, 0.f, 6.f, 4.f, 1.f, 1.f);
+    EXPECT_FLOAT4x4_EQ(output[3], 10.f, 0.f, 0.f, 0.f, 0.f, 10.f, 0.f, 0.f, 0.f,
+                       0.f, 10.f, 0.f, 0.f, 0.f, 0.f, 1.f);
+    EXPECT_FLOAT4x4_EQ(output[4], 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f,
+                       0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f);
+    EXPECT_FLOAT4x4_EQ(output[5], 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f,
+                       0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f);
+  }
+
+  {
+    // Mask composed with a partial update range. Outputs are primed with a
+    // full update, then only masked joints of j3 subtree are recomputed.
+    ozz::math::Float4x4 output[6];
+    LocalToModelJob job;
+    job.skeleton = skeleton.get();
+    job.input = input;
+    job.output = output;
+    EXPECT_TRUE(job.Run());
+
+    output[4] = output[5] = ozz::math::Float4x4::identity();
+
+    const ozz::byte joint_mask[1] = {0x1};
+    job.from = 3;
+    job.joint_mask = joint_mask;
+    EXPECT_TRUE(job.Validate());
+    EXPECT_TRUE(job.Run());
+
+    // j3 belongs to the first block and is recomputed, j4 and j5 are skipped.
+    EXPECT_FLOAT4x4_EQ(output[3], 10.f, 0.f, 0.f, 0.f, 0.f, 10.f, 0.f, 0.f, 0.f,
+                       0.f, 10.f, 0.f, 0.f, 0.f, 0.f, 1.f);
+    EXPECT_FLOAT4x4_EQ(output[4], 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f,
+                       0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f);
+    EXPECT_FLOAT4x4_EQ(output[5], 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f,
+                       0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f);
+  }
+}
+
 TEST(Empty, LocalToModel) {
   Skeleton skeleton;
 
@@ -1026,3 +1166,460 @@ TEST(Empty, LocalToModel) {
     EXPECT_TRUE(job.Run());
   }
 }
+
+TEST(Batch, LocalToModel) {
+  using ozz::animation::LocalToModelBatchJob;
+
+  // Builds a 4 joints chain skeleton: j0 - j1 - j2 - j3.
+  RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  RawSkeleton::Joint& j0 = raw_skeleton.roots[0];
+  j0.name = "j0";
+  j0.children.resize(1);
+  j0.children[0].name = "j1";
+  j0.children[0].children.resize(1);
+  j0.children[0].children[0].name = "j2";
+  j0.children[0].children[0].children.resize(1);
+  j0.children[0].children[0].children[0].name = "j3";
+  EXPECT_TRUE(raw_skeleton.Validate());
+
+  SkeletonBuilder builder;
+  ozz::unique_ptr<Skeleton> skeleton(builder(raw_skeleton));
+  ASSERT_TRUE(skeleton);
+  ASSERT_EQ(skeleton->num_joints(), 4);
+
+  // Two instances with different poses.
+  ozz::math::SoaTransform inputs[2][1] = {
+      {{{ozz::math::simd_float4::Load(1.f, 2.f, 3.f, 4.f),
+         ozz::math::simd_float4::zero(), ozz::math::simd_float4::zero()},
+        {ozz::math::simd_float4::zero(), ozz::math::simd_float4::zero(),
+         ozz::math::simd_float4::zero(), ozz::math::simd_float4::one()},
+        {ozz::math::simd_float4::one(), ozz::math::simd_float4::one(),
+         ozz::math::simd_float4::one()}}},
+      {{{ozz::math::simd_float4::Load(-1.f, -2.f, -3.f, -4.f),
+         ozz::math::simd_float4::zero(), ozz::math::simd_float4::zero()},
+        {ozz::math::simd_float4::zero(), ozz::math::simd_float4::zero(),
+         ozz::math::simd_float4::zero(), ozz::math::simd_float4::one()},
+        {ozz::math::simd_float4::one(), ozz::math::simd_float4::one(),
+         ozz::math::simd_float4::one()}}}};
+
+  ozz::math::Float4x4 outputs[2][4];
+  const ozz::span<const ozz::math::SoaTransform> input_spans[2] = {
+      inputs[0], inputs[1]};
+  const ozz::span<ozz::math::Float4x4> output_spans[2] = {outputs[0],
+                                                          outputs[1]};
+
+  {  // Mismatching instance counts.
+    LocalToModelBatchJob job;
+    job.skeleton = skeleton.get();
+    job.inputs = input_spans;
+    job.outputs = {output_spans, 1};
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // Valid batch.
+    LocalToModelBatchJob job;
+    job.skeleton = skeleton.get();
+    job.inputs = input_spans;
+    job.outputs = output_spans;
+    EXPECT_TRUE(job.Validate());
+    EXPECT_TRUE(job.Run());
+  }
+
+  // Compares with individual job runs.
+  for (int k = 0; k < 2; ++k) {
+    ozz::math::Float4x4 reference[4];
+    LocalToModelJob job;
+    job.skeleton = skeleton.get();
+    job.input = input_spans[k];
+    job.output = reference;
+    ASSERT_TRUE(job.Run());
+    for (int i = 0; i < 4; ++i) {
+      EXPECT_FLOAT4x4_EQ(
+          outputs[k][i], ozz::math::GetX(reference[i].cols[0]),
+          ozz::math::GetY(reference[i].cols[0]),
+          ozz::math::GetZ(reference[i].cols[0]),
+          ozz::math::GetW(reference[i].cols[0]),
+          ozz::math::GetX(reference[i].cols[1]),
+          ozz::math::GetY(reference[i].cols[1]),
+          ozz::math::GetZ(reference[i].cols[1]),
+          ozz::math::GetW(reference[i].cols[1]),
+          ozz::math::GetX(reference[i].cols[2]),
+          ozz::math::GetY(reference[i].cols[2]),
+          ozz::math::GetZ(reference[i].cols[2]),
+          ozz::math::GetW(reference[i].cols[2]),
+          ozz::math::GetX(reference[i].cols[3]),
+          ozz::math::GetY(reference[i].cols[3]),
+          ozz::math::GetZ(reference[i].cols[3]),
+          ozz::math::GetW(reference[i].cols[3]));
+    }
+  }
+}
+
+TEST(Graft, LocalToModel) {
+  using ozz::animation::LocalToModelGraftJob;
+
+  SkeletonBuilder builder;
+
+  // Builds a 2 joints base chain: j0 - j1.
+  RawSkeleton raw_base;
+  raw_base.roots.resize(1);
+  raw_base.roots[0].name = "j0";
+  raw_base.roots[0].children.resize(1);
+  raw_base.roots[0].children[0].name = "j1";
+  EXPECT_TRUE(raw_base.Validate());
+  ozz::unique_ptr<Skeleton> base(builder(raw_base));
+  ASSERT_TRUE(base);
+
+  // Builds a 2 joints grafted chain: g0 - g1.
+  RawSkeleton raw_graft;
+  raw_graft.roots.resize(1);
+  raw_graft.roots[0].name = "g0";
+  raw_graft.roots[0].children.resize(1);
+  raw_graft.roots[0].children[0].name = "g1";
+  EXPECT_TRUE(raw_graft.Validate());
+  ozz::unique_ptr<Skeleton> grafted(builder(raw_graft));
+  ASSERT_TRUE(grafted);
+
+  // j0 translates (2, 0, 0), j1 (0, 3, 0).
+  const ozz::math::SoaTransform base_input[1] = {
+      {{ozz::math::simd_float4::Load(2.f, 0.f, 0.f, 0.f),
+        ozz::math::simd_float4::Load(0.f, 3.f, 0.f, 0.f),
+        ozz::math::simd_float4::zero()},
+       {ozz::math::simd_float4::zero(), ozz::math::simd_float4::zero(),
+        ozz::math::simd_float4::zero(), ozz::math::simd_float4::one()},
+       {ozz::math::simd_float4::one(), ozz::math::simd_float4::one(),
+        ozz::math::simd_float4::one()}}};
+
+  // g0 translates (1, 0, 0), g1 (0, 0, 4).
+  const ozz::math::SoaTransform graft_input[1] = {
+      {{ozz::math::simd_float4::Load(1.f, 0.f, 0.f, 0.f),
+        ozz::math::simd_float4::zero(),
+        ozz::math::simd_float4::Load(0.f, 4.f, 0.f, 0.f)},
+       {ozz::math::simd_float4::zero(), ozz::math::simd_float4::zero(),
+        ozz::math::simd_float4::zero(), ozz::math::simd_float4::one()},
+       {ozz::math::simd_float4::one(), ozz::math::simd_float4::one(),
+        ozz::math::simd_float4::one()}}};
+
+  ozz::math::Float4x4 base_output[2];
+  ozz::math::Float4x4 graft_output[2];
+
+  LocalToModelGraftJob::Graft grafts[1];
+  grafts[0].skeleton = grafted.get();
+  grafts[0].joint = 1;
+  grafts[0].input = graft_input;
+  grafts[0].output = graft_output;
+
+  {  // Default job.
+    LocalToModelGraftJob job;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // No graft is a valid plain local-to-model.
+    LocalToModelGraftJob job;
+    job.skeleton = base.get();
+    job.input = base_input;
+    job.output = base_output;
+    EXPECT_TRUE(job.Validate());
+    EXPECT_TRUE(job.Run());
+  }
+
+  {  // Out of range attach joint.
+    LocalToModelGraftJob job;
+    job.skeleton = base.get();
+    job.input = base_input;
+    job.output = base_output;
+    LocalToModelGraftJob::Graft bad = grafts[0];
+    bad.joint = 2;
+    job.grafts = {&bad, 1};
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+    bad.joint = -1;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // nullptr graft skeleton.
+    LocalToModelGraftJob job;
+    job.skeleton = base.get();
+    job.input = base_input;
+    job.output = base_output;
+    LocalToModelGraftJob::Graft bad = grafts[0];
+    bad.skeleton = nullptr;
+    job.grafts = {&bad, 1};
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // Graft output too small.
+    LocalToModelGraftJob job;
+    job.skeleton = base.get();
+    job.input = base_input;
+    job.output = base_output;
+    LocalToModelGraftJob::Graft bad = grafts[0];
+    bad.output = {graft_output, 1};
+    job.grafts = {&bad, 1};
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // Valid composite evaluation, grafted chain rooted at j1.
+    LocalToModelGraftJob job;
+    job.skeleton = base.get();
+    job.input = base_input;
+    job.output = base_output;
+    job.grafts = grafts;
+    EXPECT_TRUE(job.Validate());
+    EXPECT_TRUE(job.Run());
+
+    EXPECT_FLOAT4x4_EQ(base_output[1], 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f,
+                       0.f, 0.f, 1.f, 0.f, 2.f, 3.f, 0.f, 1.f);
+    // Grafted matrices compose with the attach joint model-space one.
+    EXPECT_FLOAT4x4_EQ(graft_output[0], 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f,
+                       0.f, 0.f, 1.f, 0.f, 3.f, 3.f, 0.f, 1.f);
+    EXPECT_FLOAT4x4_EQ(graft_output[1], 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f,
+                       0.f, 0.f, 1.f, 0.f, 3.f, 3.f, 4.f, 1.f);
+  }
+}
+
+TEST(Dirty, LocalToModel) {
+  // Builds the 6 joints skeleton of the Transformation test.
+  /*
+   6 joints
+     j0
+    /  \
+   j1  j3
+    |  / \
+   j2 j4 j5
+  */
+  RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  RawSkeleton::Joint& root = raw_skeleton.roots[0];
+  root.name = "j0";
+  root.children.resize(2);
+  root.children[0].name = "j1";
+  root.children[1].name = "j3";
+  root.children[0].children.resize(1);
+  root.children[0].children[0].name = "j2";
+  root.children[1].children.resize(2);
+  root.children[1].children[0].name = "j4";
+  root.children[1].children[1].name = "j5";
+  EXPECT_TRUE(raw_skeleton.Validate());
+
+  SkeletonBuilder builder;
+  ozz::unique_ptr<Skeleton> skeleton(builder(raw_skeleton));
+  ASSERT_TRUE(skeleton);
+
+  ozz::math::SoaTransform input[2] = {ozz::math::SoaTransform::identity(),
+                                      ozz::math::SoaTransform::identity()};
+
+  // Full update reference.
+  ozz::math::Float4x4 output[6];
+  LocalToModelJob job;
+  job.skeleton = skeleton.get();
+  job.input = input;
+  job.output = output;
+  ASSERT_TRUE(job.Run());
+
+  // Modifies j1 and j3 translations (IK style post-process).
+  input[0].translation.x =
+      ozz::math::simd_float4::Load(0.f, 5.f, 0.f, -5.f);
+
+  // Propagates only the modified subtrees. Passing j2 (inside j1's subtree)
+  // checks that nested entries are skipped.
+  const int16_t modified[] = {1, 2, 3};
+  ASSERT_TRUE(job.RunDirty(modified));
+
+  // Compares against a full update.
+  ozz::math::Float4x4 reference[6];
+  job.output = reference;
+  ASSERT_TRUE(job.Run());
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_FLOAT4x4_EQ(output[i], ozz::math::GetX(reference[i].cols[0]),
+                       ozz::math::GetY(reference[i].cols[0]),
+                       ozz::math::GetZ(reference[i].cols[0]),
+                       ozz::math::GetW(reference[i].cols[0]),
+                       ozz::math::GetX(reference[i].cols[1]),
+                       ozz::math::GetY(reference[i].cols[1]),
+                       ozz::math::GetZ(reference[i].cols[1]),
+                       ozz::math::GetW(reference[i].cols[1]),
+                       ozz::math::GetX(reference[i].cols[2]),
+                       ozz::math::GetY(reference[i].cols[2]),
+                       ozz::math::GetZ(reference[i].cols[2]),
+                       ozz::math::GetW(reference[i].cols[2]),
+                       ozz::math::GetX(reference[i].cols[3]),
+                       ozz::math::GetY(reference[i].cols[3]),
+                       ozz::math::GetZ(reference[i].cols[3]),
+                       ozz::math::GetW(reference[i].cols[3]));
+  }
+}
+
+TEST(Compiled, LocalToModel) {
+  // Builds a 2 joints skeleton.
+  RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  RawSkeleton::Joint& root = raw_skeleton.roots[0];
+  root.name = "root";
+  root.children.resize(1);
+  root.children[0].name = "child";
+
+  SkeletonBuilder builder;
+  ozz::unique_ptr<Skeleton> skeleton(builder(raw_skeleton));
+  ASSERT_TRUE(skeleton);
+
+  ozz::math::SoaTransform input[1] = {ozz::math::SoaTransform::identity()};
+  input[0].translation.x = ozz::math::simd_float4::Load(2.f, 3.f, 0.f, 0.f);
+  ozz::math::Float4x4 output[2];
+
+  // Default handle isn't bound to any job.
+  {
+    const ozz::CompiledJob<LocalToModelJob> compiled;
+    EXPECT_FALSE(compiled.valid());
+    EXPECT_FALSE(compiled.Run());
+  }
+
+  // Compiling an invalid job fails, handle's Run does nothing.
+  {
+    LocalToModelJob job;
+    const ozz::CompiledJob<LocalToModelJob> compiled = ozz::Compile(job);
+    EXPECT_FALSE(compiled.valid());
+    EXPECT_FALSE(compiled.Run());
+  }
+
+  // Compiles once, runs every frame without re-validating.
+  {
+    LocalToModelJob job;
+    job.skeleton = skeleton.get();
+    job.input = input;
+    job.output = output;
+    ozz::CompiledJob<LocalToModelJob> compiled = ozz::Compile(job);
+    EXPECT_TRUE(compiled.valid());
+    for (int i = 0; i < 2; ++i) {
+      EXPECT_TRUE(compiled.Run());
+      EXPECT_FLOAT4x4_EQ(output[0], 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f,
+                         0.f, 0.f, 1.f, 0.f, 2.f, 0.f, 0.f, 1.f);
+      EXPECT_FLOAT4x4_EQ(output[1], 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f,
+                         0.f, 0.f, 1.f, 0.f, 5.f, 0.f, 0.f, 1.f);
+    }
+
+    // The handle owns a copy of the job, modifying the original job doesn't
+    // affect it.
+    job.skeleton = nullptr;
+    EXPECT_TRUE(compiled.valid());
+    EXPECT_TRUE(compiled.Run());
+
+    // Rebinding an invalid setup invalidates the handle.
+    EXPECT_FALSE(compiled.Rebind(job));
+    EXPECT_FALSE(compiled.Run());
+
+    // Rebinding a valid setup makes it functional again.
+    job.skeleton = skeleton.get();
+    EXPECT_TRUE(compiled.Rebind(job));
+    EXPECT_TRUE(compiled.Run());
+  }
+}
+
+TEST(TemplatedSize, LocalToModel) {
+  // Builds the 6 joints skeleton of the Transformation test.
+  /*
+   6 joints
+     j0
+    /  \
+   j1  j3
+    |  / \
+   j2 j4 j5
+  */
+  RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  RawSkeleton::Joint& root = raw_skeleton.roots[0];
+  root.name = "j0";
+  root.children.resize(2);
+  root.children[0].name = "j1";
+  root.children[1].name = "j3";
+  root.children[0].children.resize(1);
+  root.children[0].children[0].name = "j2";
+  root.children[1].children.resize(2);
+  root.children[1].children[0].name = "j4";
+  root.children[1].children[1].name = "j5";
+  EXPECT_TRUE(raw_skeleton.Validate());
+
+  SkeletonBuilder builder;
+  ozz::unique_ptr<Skeleton> skeleton(builder(raw_skeleton));
+  ASSERT_TRUE(skeleton);
+
+  ozz::math::SoaTransform input[2] = {ozz::math::SoaTransform::identity(),
+                                      ozz::math::SoaTransform::identity()};
+  input[0].translation.x = ozz::math::simd_float4::Load(1.f, 2.f, 3.f, 4.f);
+  input[0].rotation.y = ozz::math::simd_float4::Load(0.f, .70710677f, 0.f, 0.f);
+  input[0].rotation.w = ozz::math::simd_float4::Load(1.f, .70710677f, 1.f, 1.f);
+  input[1].scale.y = ozz::math::simd_float4::Load(-1.f, 2.f, 1.f, 1.f);
+
+  // Full update reference.
+  ozz::math::Float4x4 reference[6];
+  LocalToModelJob job;
+  job.skeleton = skeleton.get();
+  job.input = input;
+  job.output = reference;
+  ASSERT_TRUE(job.Run());
+
+  // The templated variant matches the generic one.
+  ozz::math::Float4x4 output[6];
+  ozz::animation::LocalToModelJobT<2> job_t;
+  job_t.skeleton = skeleton.get();
+  job_t.input = input;
+  job_t.output = output;
+  ASSERT_TRUE(job_t.Run());
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_FLOAT4x4_EQ(output[i], ozz::math::GetX(reference[i].cols[0]),
+                       ozz::math::GetY(reference[i].cols[0]),
+                       ozz::math::GetZ(reference[i].cols[0]),
+                       ozz::math::GetW(reference[i].cols[0]),
+                       ozz::math::GetX(reference[i].cols[1]),
+                       ozz::math::GetY(reference[i].cols[1]),
+                       ozz::math::GetZ(reference[i].cols[1]),
+                       ozz::math::GetW(reference[i].cols[1]),
+                       ozz::math::GetX(reference[i].cols[2]),
+                       ozz::math::GetY(reference[i].cols[2]),
+                       ozz::math::GetZ(reference[i].cols[2]),
+                       ozz::math::GetW(reference[i].cols[2]),
+                       ozz::math::GetX(reference[i].cols[3]),
+                       ozz::math::GetY(reference[i].cols[3]),
+                       ozz::math::GetZ(reference[i].cols[3]),
+                       ozz::math::GetW(reference[i].cols[3]));
+  }
+
+  {  // Partial updates fall back to the generic implementation.
+    job.from = 3;
+    ASSERT_TRUE(job.Run());
+    job_t.from = 3;
+    ASSERT_TRUE(job_t.Run());
+    for (int i = 3; i < 6; ++i) {
+      EXPECT_FLOAT4x4_EQ(output[i], ozz::math::GetX(reference[i].cols[0]),
+                         ozz::math::GetY(reference[i].cols[0]),
+                         ozz::math::GetZ(reference[i].cols[0]),
+                         ozz::math::GetW(reference[i].cols[0]),
+                         ozz::math::GetX(reference[i].cols[1]),
+                         ozz::math::GetY(reference[i].cols[1]),
+                         ozz::math::GetZ(reference[i].cols[1]),
+                         ozz::math::GetW(reference[i].cols[1]),
+                         ozz::math::GetX(reference[i].cols[2]),
+                         ozz::math::GetY(reference[i].cols[2]),
+                         ozz::math::GetZ(reference[i].cols[2]),
+                         ozz::math::GetW(reference[i].cols[2]),
+                         ozz::math::GetX(reference[i].cols[3]),
+                         ozz::math::GetY(reference[i].cols[3]),
+                         ozz::math::GetZ(reference[i].cols[3]),
+                         ozz::math::GetW(reference[i].cols[3]));
+    }
+  }
+
+  {  // Fails if the compile-time size doesn't match the skeleton.
+    ozz::animation::LocalToModelJobT<1> bad_size_job;
+    bad_size_job.skeleton = skeleton.get();
+    bad_size_job.input = input;
+    bad_size_job.output = output;
+    EXPECT_FALSE(bad_size_job.Run());
+  }
+}
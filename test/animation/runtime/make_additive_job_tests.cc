@@ -0,0 +1,177 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "gtest/gtest.h"
+#include "ozz/animation/runtime/blending_job.h"
+#include "ozz/animation/runtime/make_additive_job.h"
+#include "ozz/base/maths/gtest_math_helper.h"
+#include "ozz/base/maths/soa_transform.h"
+
+using ozz::animation::ApplyAdditiveJob;
+using ozz::animation::BlendingJob;
+using ozz::animation::MakeAdditiveJob;
+
+TEST(JobValidity, MakeAdditiveJob) {
+  const ozz::math::SoaTransform identity = ozz::math::SoaTransform::identity();
+  const ozz::math::SoaTransform input[2] = {identity, identity};
+  const ozz::math::SoaTransform reference[2] = {identity, identity};
+  ozz::math::SoaTransform output[2] = {identity, identity};
+
+  {  // Empty/default job.
+    MakeAdditiveJob job;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // Mismatching input and reference sizes.
+    MakeAdditiveJob job;
+    job.input = input;
+    job.reference = {reference, reference + 1};
+    job.output = output;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // Output range too small.
+    MakeAdditiveJob job;
+    job.input = input;
+    job.reference = reference;
+    job.output = {output, output + 1};
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // Valid job.
+    MakeAdditiveJob job;
+    job.input = input;
+    job.reference = reference;
+    job.output = output;
+    EXPECT_TRUE(job.Validate());
+    EXPECT_TRUE(job.Run());
+  }
+}
+
+TEST(JobResult, MakeAdditiveJob) {
+  const ozz::math::SoaTransform identity = ozz::math::SoaTransform::identity();
+
+  ozz::math::SoaTransform input = identity;
+  ozz::math::SoaTransform reference = identity;
+
+  input.translation = ozz::math::SoaFloat3::Load(
+      ozz::math::simd_float4::Load(5.f, 6.f, 7.f, 8.f),
+      ozz::math::simd_float4::zero(), ozz::math::simd_float4::zero());
+  reference.translation = ozz::math::SoaFloat3::Load(
+      ozz::math::simd_float4::Load(1.f, 2.f, 3.f, 4.f),
+      ozz::math::simd_float4::zero(), ozz::math::simd_float4::zero());
+  // Lane 0 input rotation is a half turn around y, reference is identity, so
+  // the delta is the input rotation itself.
+  input.rotation = ozz::math::SoaQuaternion::Load(
+      ozz::math::simd_float4::zero(),
+      ozz::math::simd_float4::Load(1.f, 0.f, 0.f, 0.f),
+      ozz::math::simd_float4::zero(),
+      ozz::math::simd_float4::Load(0.f, 1.f, 1.f, 1.f));
+  input.scale = ozz::math::SoaFloat3::Load(
+      ozz::math::simd_float4::Load(6.f, 6.f, 6.f, 6.f),
+      ozz::math::simd_float4::one(), ozz::math::simd_float4::one());
+  reference.scale = ozz::math::SoaFloat3::Load(
+      ozz::math::simd_float4::Load(2.f, 2.f, 2.f, 2.f),
+      ozz::math::simd_float4::one(), ozz::math::simd_float4::one());
+
+  ozz::math::SoaTransform output;
+  MakeAdditiveJob job;
+  job.input = {&input, 1};
+  job.reference = {&reference, 1};
+  job.output = {&output, 1};
+  ASSERT_TRUE(job.Run());
+
+  EXPECT_SOAFLOAT3_EQ(output.translation, 4.f, 4.f, 4.f, 4.f, 0.f, 0.f, 0.f,
+                      0.f, 0.f, 0.f, 0.f, 0.f);
+  EXPECT_SOAQUATERNION_EQ(output.rotation, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f,
+                          0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 1.f, 1.f, 1.f);
+  EXPECT_SOAFLOAT3_EQ(output.scale, 3.f, 3.f, 3.f, 3.f, 1.f, 1.f, 1.f, 1.f,
+                      1.f, 1.f, 1.f, 1.f);
+}
+
+TEST(RoundTrip, MakeAdditiveJob) {
+  // Applying the delta back onto the reference with ApplyAdditiveJob must
+  // reproduce the input pose.
+  const ozz::math::SoaTransform identity = ozz::math::SoaTransform::identity();
+
+  ozz::math::SoaTransform input = identity;
+  input.translation = ozz::math::SoaFloat3::Load(
+      ozz::math::simd_float4::Load(1.f, -2.f, 3.f, -4.f),
+      ozz::math::simd_float4::Load(5.f, 6.f, -7.f, 8.f),
+      ozz::math::simd_float4::Load(-9.f, 10.f, 11.f, 12.f));
+  input.rotation = ozz::math::SoaQuaternion::Load(
+      ozz::math::simd_float4::Load(.5f, 0.f, 0.f, .70710677f),
+      ozz::math::simd_float4::Load(.5f, .70710677f, 0.f, 0.f),
+      ozz::math::simd_float4::Load(.5f, 0.f, 0.f, 0.f),
+      ozz::math::simd_float4::Load(.5f, .70710677f, 1.f, .70710677f));
+  input.scale = ozz::math::SoaFloat3::Load(
+      ozz::math::simd_float4::Load(2.f, 1.f, 4.f, 1.f),
+      ozz::math::simd_float4::Load(1.f, 3.f, 1.f, 5.f),
+      ozz::math::simd_float4::Load(6.f, 1.f, 7.f, 1.f));
+
+  ozz::math::SoaTransform reference = identity;
+  reference.translation = ozz::math::SoaFloat3::Load(
+      ozz::math::simd_float4::Load(-1.f, 1.f, 2.f, 0.f),
+      ozz::math::simd_float4::Load(0.f, 2.f, 1.f, -1.f),
+      ozz::math::simd_float4::Load(1.f, 0.f, -2.f, 2.f));
+  reference.rotation = ozz::math::SoaQuaternion::Load(
+      ozz::math::simd_float4::Load(0.f, .70710677f, 0.f, 0.f),
+      ozz::math::simd_float4::Load(.70710677f, 0.f, 0.f, 0.f),
+      ozz::math::simd_float4::Load(0.f, 0.f, .70710677f, 0.f),
+      ozz::math::simd_float4::Load(.70710677f, .70710677f, .70710677f, 1.f));
+  reference.scale = ozz::math::SoaFloat3::Load(
+      ozz::math::simd_float4::Load(2.f, 2.f, 2.f, 2.f),
+      ozz::math::simd_float4::Load(4.f, 4.f, 4.f, 4.f),
+      ozz::math::simd_float4::Load(.5f, .5f, .5f, .5f));
+
+  ozz::math::SoaTransform delta;
+  MakeAdditiveJob make_additive;
+  make_additive.input = {&input, 1};
+  make_additive.reference = {&reference, 1};
+  make_additive.output = {&delta, 1};
+  ASSERT_TRUE(make_additive.Run());
+
+  ozz::math::SoaTransform applied = reference;
+  BlendingJob::Layer layer;
+  layer.transform = {&delta, 1};
+  layer.weight = 1.f;
+  ApplyAdditiveJob apply;
+  apply.layers = {&layer, 1};
+  apply.pose = {&applied, 1};
+  ASSERT_TRUE(apply.Run());
+
+  EXPECT_SOAFLOAT3_EQ_EST(applied.translation, 1.f, -2.f, 3.f, -4.f, 5.f, 6.f,
+                          -7.f, 8.f, -9.f, 10.f, 11.f, 12.f);
+  EXPECT_SOAQUATERNION_EQ_EST(applied.rotation, .5f, 0.f, 0.f, .70710677f,
+                              .5f, .70710677f, 0.f, 0.f, .5f, 0.f, 0.f, 0.f,
+                              .5f, .70710677f, 1.f, .70710677f);
+  EXPECT_SOAFLOAT3_EQ_EST(applied.scale, 2.f, 1.f, 4.f, 1.f, 1.f, 3.f, 1.f,
+                          5.f, 6.f, 1.f, 7.f, 1.f);
+}
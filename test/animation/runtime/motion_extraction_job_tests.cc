@@ -0,0 +1,136 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/raw_track.h"
+#include "ozz/animation/offline/track_builder.h"
+#include "ozz/animation/runtime/motion_extraction_job.h"
+#include "ozz/animation/runtime/track.h"
+#include "ozz/base/maths/gtest_math_helper.h"
+#include "ozz/base/maths/transform.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+using ozz::animation::Float3Track;
+using ozz::animation::MotionExtractionJob;
+using ozz::animation::QuaternionTrack;
+using ozz::animation::offline::RawFloat3Track;
+using ozz::animation::offline::RawQuaternionTrack;
+using ozz::animation::offline::RawTrackInterpolation;
+using ozz::animation::offline::TrackBuilder;
+
+TEST(JobValidity, MotionExtractionJob) {
+  {  // Default is invalid, missing delta output.
+    MotionExtractionJob job;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // Tracks are optional.
+    MotionExtractionJob job;
+    ozz::math::Transform delta;
+    job.delta = &delta;
+    EXPECT_TRUE(job.Validate());
+    EXPECT_TRUE(job.Run());
+    EXPECT_FLOAT3_EQ(delta.translation, 0.f, 0.f, 0.f);
+    EXPECT_QUATERNION_EQ(delta.rotation, 0.f, 0.f, 0.f, 1.f);
+    EXPECT_FLOAT3_EQ(delta.scale, 1.f, 1.f, 1.f);
+  }
+}
+
+TEST(Delta, MotionExtractionJob) {
+  TrackBuilder builder;
+
+  // Linear motion from (0, 0, 0) to (2, 0, 4).
+  RawFloat3Track raw_position;
+  const RawFloat3Track::Keyframe position_keys[] = {
+      {RawTrackInterpolation::kLinear, 0.f, ozz::math::Float3(0.f, 0.f, 0.f)},
+      {RawTrackInterpolation::kLinear, 1.f, ozz::math::Float3(2.f, 0.f, 4.f)}};
+  raw_position.keyframes.assign(position_keys, position_keys + 2);
+  ozz::unique_ptr<Float3Track> position_track = builder(raw_position);
+  ASSERT_TRUE(position_track);
+
+  // Linear rotation from identity to a pi/2 yaw.
+  RawQuaternionTrack raw_rotation;
+  const RawQuaternionTrack::Keyframe rotation_keys[] = {
+      {RawTrackInterpolation::kLinear, 0.f, ozz::math::Quaternion::identity()},
+      {RawTrackInterpolation::kLinear, 1.f,
+       ozz::math::Quaternion(0.f, .70710677f, 0.f, .70710677f)}};
+  raw_rotation.keyframes.assign(rotation_keys, rotation_keys + 2);
+  ozz::unique_ptr<QuaternionTrack> rotation_track = builder(raw_rotation);
+  ASSERT_TRUE(rotation_track);
+
+  ozz::math::Transform delta;
+  MotionExtractionJob job;
+  job.position_track = position_track.get();
+  job.rotation_track = rotation_track.get();
+  job.delta = &delta;
+
+  {  // No motion for a null ratio range.
+    job.from = .5f;
+    job.to = .5f;
+    ASSERT_TRUE(job.Run());
+    EXPECT_FLOAT3_EQ(delta.translation, 0.f, 0.f, 0.f);
+    EXPECT_QUATERNION_EQ(delta.rotation, 0.f, 0.f, 0.f, 1.f);
+  }
+
+  {  // Forward range.
+    job.from = .25f;
+    job.to = .75f;
+    ASSERT_TRUE(job.Run());
+    EXPECT_FLOAT3_EQ(delta.translation, 1.f, 0.f, 2.f);
+  }
+
+  {  // Whole track.
+    job.from = 0.f;
+    job.to = 1.f;
+    ASSERT_TRUE(job.Run());
+    EXPECT_FLOAT3_EQ(delta.translation, 2.f, 0.f, 4.f);
+    EXPECT_QUATERNION_EQ(delta.rotation, 0.f, .70710677f, 0.f, .70710677f);
+  }
+
+  {  // Looping range accumulates end of track plus beginning.
+    job.from = .75f;
+    job.to = .25f;
+    ASSERT_TRUE(job.Run());
+    EXPECT_FLOAT3_EQ(delta.translation, 1.f, 0.f, 2.f);
+  }
+
+  {  // Looping over the whole track, from the very end to the very beginning.
+    job.from = 1.f;
+    job.to = 0.f;
+    ASSERT_TRUE(job.Run());
+    EXPECT_FLOAT3_EQ(delta.translation, 0.f, 0.f, 0.f);
+    EXPECT_QUATERNION_EQ(delta.rotation, 0.f, 0.f, 0.f, 1.f);
+  }
+
+  {  // Ratios are clamped.
+    job.from = -1.f;
+    job.to = 2.f;
+    ASSERT_TRUE(job.Run());
+    EXPECT_FLOAT3_EQ(delta.translation, 2.f, 0.f, 4.f);
+  }
+}
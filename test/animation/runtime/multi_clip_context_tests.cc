@@ -0,0 +1,125 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/multi_clip_context.h"
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/animation_builder.h"
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/base/maths/gtest_math_helper.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+using ozz::animation::Animation;
+using ozz::animation::MultiClipContext;
+using ozz::animation::SamplingJob;
+using ozz::animation::offline::AnimationBuilder;
+using ozz::animation::offline::RawAnimation;
+
+namespace {
+// Builds a 1 track animation translating from _start to _start + 4 on x.
+ozz::unique_ptr<Animation> BuildTestAnimation(float _start) {
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(1);
+  const RawAnimation::TranslationKey key0 = {0.f,
+                                             ozz::math::Float3(_start, 0.f, 0.f)};
+  raw_animation.tracks[0].translations.push_back(key0);
+  const RawAnimation::TranslationKey key1 = {
+      1.f, ozz::math::Float3(_start + 4.f, 0.f, 0.f)};
+  raw_animation.tracks[0].translations.push_back(key1);
+  AnimationBuilder builder;
+  return builder(raw_animation);
+}
+
+// Samples _animation with the context selected from _contexts, returning the
+// sampled x translation of the first joint.
+float Sample(MultiClipContext* _contexts, const Animation& _animation,
+             float _ratio) {
+  ozz::math::SoaTransform output[1];
+  SamplingJob job;
+  job.animation = &_animation;
+  job.context = _contexts->Select(&_animation);
+  job.ratio = _ratio;
+  job.output = output;
+  EXPECT_TRUE(job.Run());
+  return ozz::math::GetX(output[0].translation.x);
+}
+}  // namespace
+
+TEST(Residency, MultiClipContext) {
+  ozz::unique_ptr<Animation> animation_a = BuildTestAnimation(0.f);
+  ozz::unique_ptr<Animation> animation_b = BuildTestAnimation(10.f);
+  ozz::unique_ptr<Animation> animation_c = BuildTestAnimation(20.f);
+  ASSERT_TRUE(animation_a && animation_b && animation_c);
+
+  MultiClipContext contexts(1, 2);
+  EXPECT_EQ(contexts.max_tracks(), 1);
+  EXPECT_EQ(contexts.num_clips(), 2u);
+
+  // First selections are cold, but stable: re-selecting the same animation
+  // returns the same context.
+  SamplingJob::Context* context_a = contexts.Select(animation_a.get());
+  ASSERT_TRUE(context_a != nullptr);
+  EXPECT_EQ(contexts.Select(animation_a.get()), context_a);
+
+  // Samples both clips, binding a resident context to each.
+  EXPECT_FLOAT_EQ_EST(1.f, Sample(&contexts, *animation_a, .25f));
+  EXPECT_FLOAT_EQ_EST(11.f, Sample(&contexts, *animation_b, .25f));
+  EXPECT_EQ(contexts.Select(animation_a.get()), context_a);
+  SamplingJob::Context* context_b = contexts.Select(animation_b.get());
+  EXPECT_TRUE(context_b != nullptr && context_b != context_a);
+
+  // Ping-pongs between the two resident clips: cursors survive switches, so
+  // no cache reset happens while sampling forward.
+  const size_t resets_a = context_a->statistics().cursor_resets;
+  const size_t resets_b = context_b->statistics().cursor_resets;
+  EXPECT_FLOAT_EQ_EST(2.f, Sample(&contexts, *animation_a, .5f));
+  EXPECT_FLOAT_EQ_EST(12.f, Sample(&contexts, *animation_b, .5f));
+  EXPECT_FLOAT_EQ_EST(3.f, Sample(&contexts, *animation_a, .75f));
+  EXPECT_FLOAT_EQ_EST(13.f, Sample(&contexts, *animation_b, .75f));
+  EXPECT_EQ(context_a->statistics().cursor_resets, resets_a);
+  EXPECT_EQ(context_b->statistics().cursor_resets, resets_b);
+
+  // A third clip recycles the least recently selected context (clip a, as
+  // clip b was sampled last), which loses its residency.
+  EXPECT_FLOAT_EQ_EST(22.f, Sample(&contexts, *animation_c, .5f));
+  EXPECT_EQ(contexts.Select(animation_c.get()), context_a);
+  EXPECT_FLOAT_EQ_EST(14.f, Sample(&contexts, *animation_b, 1.f));
+
+  // Re-selecting clip a is a cold start again.
+  SamplingJob::Context* recycled = contexts.Select(animation_a.get());
+  EXPECT_EQ(recycled->animation(), nullptr);
+  EXPECT_FLOAT_EQ_EST(4.f, Sample(&contexts, *animation_a, 1.f));
+
+  // Invalidate drops all residencies.
+  contexts.Invalidate();
+  EXPECT_EQ(context_a->animation(), nullptr);
+  EXPECT_EQ(context_b->animation(), nullptr);
+}
@@ -0,0 +1,204 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/page_streaming_manager.h"
+
+#include <algorithm>
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/paged_animation_builder.h"
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/runtime/paged_animation.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+using ozz::animation::PagedAnimation;
+using ozz::animation::PageStreamingManager;
+using ozz::animation::offline::PagedAnimationBuilder;
+using ozz::animation::offline::RawAnimation;
+
+namespace {
+
+// Builds a 4s clip paged at 1s, aka 4 pages.
+ozz::unique_ptr<PagedAnimation> BuildPagedAnimation() {
+  RawAnimation raw_animation;
+  raw_animation.duration = 4.f;
+  raw_animation.tracks.resize(1);
+  const RawAnimation::TranslationKey key = {0.f, ozz::math::Float3::x_axis()};
+  raw_animation.tracks[0].translations.push_back(key);
+
+  PagedAnimationBuilder builder;
+  builder.page_duration = 1.f;
+  return builder(raw_animation);
+}
+
+// Records streaming decisions, and the set of currently resident pages.
+class RecordingBackend : public PageStreamingManager::Backend {
+ public:
+  virtual void Prefetch(const PagedAnimation&, size_t _page) {
+    prefetched.push_back(_page);
+    resident.push_back(_page);
+  }
+  virtual void Evict(const PagedAnimation&, size_t _page) {
+    evicted.push_back(_page);
+    resident.erase(std::find(resident.begin(), resident.end(), _page));
+  }
+  bool IsResident(size_t _page) const {
+    return std::find(resident.begin(), resident.end(), _page) !=
+           resident.end();
+  }
+  ozz::vector<size_t> prefetched;
+  ozz::vector<size_t> evicted;
+  ozz::vector<size_t> resident;
+};
+}  // namespace
+
+TEST(Validity, PageStreamingManager) {
+  ozz::unique_ptr<PagedAnimation> paged = BuildPagedAnimation();
+  ASSERT_TRUE(paged);
+
+  PageStreamingManager manager;
+  RecordingBackend backend;
+
+  {  // A null backend is a no-op.
+    const PageStreamingManager::Instance instance = {paged.get(), 0.f, 1.f};
+    manager.Update(ozz::span<const PageStreamingManager::Instance>(&instance,
+                                                                   1),
+                   nullptr);
+    EXPECT_EQ(manager.num_resident(), 0u);
+  }
+
+  {  // Instances with a null animation are skipped.
+    const PageStreamingManager::Instance instance = {nullptr, 0.f, 1.f};
+    manager.Update(ozz::span<const PageStreamingManager::Instance>(&instance,
+                                                                   1),
+                   &backend);
+    EXPECT_EQ(manager.num_resident(), 0u);
+    EXPECT_TRUE(backend.prefetched.empty());
+  }
+}
+
+TEST(Prefetch, PageStreamingManager) {
+  ozz::unique_ptr<PagedAnimation> paged = BuildPagedAnimation();
+  ASSERT_TRUE(paged);
+
+  PageStreamingManager manager;
+  manager.deadline = .5f;
+  RecordingBackend backend;
+
+  {  // Cursor at the beginning of page 1, half a second ahead stays within
+     // pages 1 and 2.
+    const PageStreamingManager::Instance instance = {paged.get(), .25f, 1.f};
+    manager.Update(ozz::span<const PageStreamingManager::Instance>(&instance,
+                                                                   1),
+                   &backend);
+    EXPECT_TRUE(backend.IsResident(1));
+    EXPECT_TRUE(backend.IsResident(2));
+    EXPECT_FALSE(backend.IsResident(0));
+    EXPECT_FALSE(backend.IsResident(3));
+  }
+
+  {  // Already resident pages aren't prefetched again.
+    const size_t prefetches = backend.prefetched.size();
+    const PageStreamingManager::Instance instance = {paged.get(), .25f, 1.f};
+    manager.Update(ozz::span<const PageStreamingManager::Instance>(&instance,
+                                                                   1),
+                   &backend);
+    EXPECT_EQ(backend.prefetched.size(), prefetches);
+  }
+
+  {  // Doubling playback speed doubles the reach, up to page 3.
+    const PageStreamingManager::Instance instance = {paged.get(), .25f, 2.f};
+    manager.Update(ozz::span<const PageStreamingManager::Instance>(&instance,
+                                                                   1),
+                   &backend);
+    EXPECT_TRUE(backend.IsResident(3));
+  }
+
+  {  // Backward playback prefetches behind the cursor, wrapping to the last
+     // page as looping playback does.
+    PageStreamingManager bwd_manager;
+    bwd_manager.deadline = .5f;
+    RecordingBackend bwd_backend;
+    const PageStreamingManager::Instance instance = {paged.get(), 0.f, -1.f};
+    bwd_manager.Update(
+        ozz::span<const PageStreamingManager::Instance>(&instance, 1),
+        &bwd_backend);
+    EXPECT_TRUE(bwd_backend.IsResident(0));
+    EXPECT_TRUE(bwd_backend.IsResident(3));
+    EXPECT_FALSE(bwd_backend.IsResident(1));
+  }
+}
+
+TEST(Evict, PageStreamingManager) {
+  ozz::unique_ptr<PagedAnimation> paged = BuildPagedAnimation();
+  ASSERT_TRUE(paged);
+
+  PageStreamingManager manager;
+  manager.deadline = .5f;
+  manager.budget = 2;
+  RecordingBackend backend;
+
+  // Walks the cursor over the whole clip, page per page. The budget only
+  // allows 2 resident pages, so pages left behind get evicted as the cursor
+  // advances.
+  for (int i = 0; i < 4; ++i) {
+    const PageStreamingManager::Instance instance = {
+        paged.get(), (i + .25f) / 4.f, 1.f};
+    manager.Update(ozz::span<const PageStreamingManager::Instance>(&instance,
+                                                                   1),
+                   &backend);
+    EXPECT_LE(manager.num_resident(), 2u);
+  }
+
+  // The last update needed page 3 and, wrapping as looping playback does,
+  // page 0 again. Every other page was left behind and evicted.
+  EXPECT_TRUE(backend.IsResident(3));
+  EXPECT_TRUE(backend.IsResident(0));
+  EXPECT_FALSE(backend.IsResident(1));
+  EXPECT_FALSE(backend.IsResident(2));
+  EXPECT_EQ(backend.evicted.size(), 3u);
+
+  {  // Pages needed by the current update are never evicted, even above
+     // budget.
+    manager.budget = 0;
+    const PageStreamingManager::Instance instance = {paged.get(), .25f, 1.f};
+    manager.Update(ozz::span<const PageStreamingManager::Instance>(&instance,
+                                                                   1),
+                   &backend);
+    EXPECT_TRUE(backend.IsResident(1));
+    EXPECT_TRUE(backend.IsResident(2));
+    EXPECT_EQ(manager.num_resident(), 2u);
+  }
+
+  {  // Clear forgets residency state without evicting.
+    const size_t evictions = backend.evicted.size();
+    manager.Clear();
+    EXPECT_EQ(manager.num_resident(), 0u);
+    EXPECT_EQ(backend.evicted.size(), evictions);
+  }
+}
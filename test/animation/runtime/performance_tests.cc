@@ -0,0 +1,228 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+// Performance floors for the runtime jobs, guarding against accidental
+// order-of-magnitude deoptimization (a debug check left in a release path, a
+// lost inline...) rather than measuring absolute speed. Each test times a
+// job on a reference workload and compares it to a calibration loop measured
+// on the same machine and build: budgets are expressed as a number of
+// calibration operations per job run, so machine speed and build flavor
+// cancel out. Budgets leave around two orders of magnitude of margin over
+// measured costs, making the floors cheap to hold and regressions of the
+// kind they target impossible to miss.
+
+#include <chrono>
+#include <cstdio>
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/animation_builder.h"
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/offline/raw_skeleton.h"
+#include "ozz/animation/offline/skeleton_builder.h"
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/animation/runtime/blending_job.h"
+#include "ozz/animation/runtime/local_to_model_job.h"
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/maths/simd_math.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+using ozz::animation::Animation;
+using ozz::animation::BlendingJob;
+using ozz::animation::LocalToModelJob;
+using ozz::animation::SamplingJob;
+using ozz::animation::Skeleton;
+using ozz::animation::offline::AnimationBuilder;
+using ozz::animation::offline::RawAnimation;
+using ozz::animation::offline::RawSkeleton;
+using ozz::animation::offline::SkeletonBuilder;
+
+namespace {
+
+// Reference workload size, typical of a game character rig.
+const int kNumJoints = 64;
+const int kNumSoaJoints = (kNumJoints + 3) / 4;
+
+// Measures the best time of a single run of _fn, in seconds. The workload is
+// run in batches until enough time is accumulated for the clock resolution
+// not to matter, keeping the best batch so scheduling noise only ever
+// over-estimates performance, never fails the floor spuriously.
+template <typename _Fn>
+double SecondsPerRun(const _Fn& _fn) {
+  using clock = std::chrono::steady_clock;
+  const int kBatchRuns = 16;
+  const std::chrono::microseconds kMinTotal(10000);
+
+  _fn();  // Warm-up run, pays one-time costs (cold caches, lazy init).
+
+  double best = -1.;
+  clock::duration total(0);
+  do {
+    const clock::time_point begin = clock::now();
+    for (int i = 0; i < kBatchRuns; ++i) {
+      _fn();
+    }
+    const clock::duration elapsed = clock::now() - begin;
+    total += elapsed;
+    const double seconds =
+        std::chrono::duration<double>(elapsed).count() / kBatchRuns;
+    if (best < 0. || seconds < best) {
+      best = seconds;
+    }
+  } while (total < kMinTotal);
+  return best;
+}
+
+// Calibration operation: a dependent simd multiply-add over a pose-sized
+// array, representative of the mix of compute and memory accesses runtime
+// jobs perform. Returns the best time of a single operation, in seconds.
+double SecondsPerCalibrationOp() {
+  ozz::vector<ozz::math::SimdFloat4> data(kNumSoaJoints * 16,
+                                          ozz::math::simd_float4::one());
+  const int kOpsPerRun = 1024;
+  const double seconds = SecondsPerRun([&data] {
+    ozz::math::SimdFloat4 acc = ozz::math::simd_float4::zero();
+    for (int i = 0; i < kOpsPerRun; ++i) {
+      const ozz::math::SimdFloat4 value =
+          data[static_cast<size_t>(i) % data.size()];
+      acc = ozz::math::MAdd(value, value, acc);
+    }
+    data[0] = acc;  // Defeats dead code elimination.
+  });
+  return seconds / kOpsPerRun;
+}
+
+// Builds a kNumJoints tracks animation with a few keys per track, so
+// sampling exercises cursors, decompression and interpolation.
+ozz::unique_ptr<Animation> BuildPerfAnimation() {
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(kNumJoints);
+  for (int i = 0; i < kNumJoints; ++i) {
+    RawAnimation::JointTrack& track = raw_animation.tracks[i];
+    for (int k = 0; k < 4; ++k) {
+      const float time = k / 3.f;
+      const RawAnimation::TranslationKey t_key = {
+          time, ozz::math::Float3(static_cast<float>(i), time, 0.f)};
+      track.translations.push_back(t_key);
+      const RawAnimation::RotationKey r_key = {
+          time, ozz::math::Quaternion::FromEuler(time * .3f, 0.f, 0.f)};
+      track.rotations.push_back(r_key);
+    }
+  }
+  AnimationBuilder builder;
+  return builder(raw_animation);
+}
+
+// Builds a kNumJoints chain skeleton.
+ozz::unique_ptr<Skeleton> BuildPerfSkeleton() {
+  RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  RawSkeleton::Joint* joint = &raw_skeleton.roots[0];
+  char name[16];
+  for (int i = 0; i < kNumJoints; ++i) {
+    std::snprintf(name, sizeof(name), "j%d", i);
+    joint->name = name;
+    joint->transform = ozz::math::Transform::identity();
+    if (i + 1 < kNumJoints) {
+      joint->children.resize(1);
+      joint = &joint->children[0];
+    }
+  }
+  SkeletonBuilder builder;
+  return builder(raw_skeleton);
+}
+}  // namespace
+
+TEST(SamplingJob, Performance) {
+  ozz::unique_ptr<Animation> animation = BuildPerfAnimation();
+  ASSERT_TRUE(animation);
+  SamplingJob::Context context(kNumJoints);
+  ozz::vector<ozz::math::SoaTransform> output(kNumSoaJoints);
+
+  // Coherent forward playback, the dominant production pattern.
+  float ratio = 0.f;
+  const double seconds = SecondsPerRun([&animation, &context, &output, &ratio] {
+    ratio = ratio < 1.f ? ratio + .01f : 0.f;
+    SamplingJob job;
+    job.animation = animation.get();
+    job.context = &context;
+    job.ratio = ratio;
+    job.output = ozz::make_span(output);
+    EXPECT_TRUE(job.Run());
+  });
+
+  const double budget = 500000 * SecondsPerCalibrationOp();
+  EXPECT_LT(seconds, budget);
+}
+
+TEST(BlendingJob, Performance) {
+  const ozz::math::SoaTransform identity = ozz::math::SoaTransform::identity();
+  ozz::vector<ozz::math::SoaTransform> pose_a(kNumSoaJoints, identity);
+  ozz::vector<ozz::math::SoaTransform> pose_b(kNumSoaJoints, identity);
+  ozz::vector<ozz::math::SoaTransform> rest_pose(kNumSoaJoints, identity);
+  ozz::vector<ozz::math::SoaTransform> output(kNumSoaJoints);
+
+  BlendingJob::Layer layers[2];
+  layers[0].transform = ozz::make_span(pose_a);
+  layers[0].weight = .6f;
+  layers[1].transform = ozz::make_span(pose_b);
+  layers[1].weight = .4f;
+
+  const double seconds =
+      SecondsPerRun([&layers, &rest_pose, &output] {
+        BlendingJob job;
+        job.layers = layers;
+        job.rest_pose = ozz::make_span(rest_pose);
+        job.output = ozz::make_span(output);
+        EXPECT_TRUE(job.Run());
+      });
+
+  const double budget = 200000 * SecondsPerCalibrationOp();
+  EXPECT_LT(seconds, budget);
+}
+
+TEST(LocalToModelJob, Performance) {
+  ozz::unique_ptr<Skeleton> skeleton = BuildPerfSkeleton();
+  ASSERT_TRUE(skeleton);
+  ozz::vector<ozz::math::SoaTransform> input(
+      kNumSoaJoints, ozz::math::SoaTransform::identity());
+  ozz::vector<ozz::math::Float4x4> output(kNumJoints);
+
+  const double seconds = SecondsPerRun([&skeleton, &input, &output] {
+    LocalToModelJob job;
+    job.skeleton = skeleton.get();
+    job.input = ozz::make_span(input);
+    job.output = ozz::make_span(output);
+    EXPECT_TRUE(job.Run());
+  });
+
+  const double budget = 200000 * SecondsPerCalibrationOp();
+  EXPECT_LT(seconds, budget);
+}
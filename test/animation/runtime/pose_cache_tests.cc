@@ -0,0 +1,138 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/animation_builder.h"
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/animation/runtime/pose_cache.h"
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+using ozz::animation::Animation;
+using ozz::animation::PoseCache;
+using ozz::animation::SamplingJob;
+using ozz::animation::offline::AnimationBuilder;
+using ozz::animation::offline::RawAnimation;
+
+namespace {
+
+// Builds a 1 track animation whose translation x animates from 0 to 1.
+ozz::unique_ptr<Animation> BuildTestAnimation() {
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(1);
+  const RawAnimation::TranslationKey key0 = {0.f, ozz::math::Float3::zero()};
+  raw_animation.tracks[0].translations.push_back(key0);
+  const RawAnimation::TranslationKey key1 = {1.f, ozz::math::Float3::x_axis()};
+  raw_animation.tracks[0].translations.push_back(key1);
+
+  AnimationBuilder builder;
+  return builder(raw_animation);
+}
+}  // namespace
+
+TEST(Validity, PoseCache) {
+  ozz::unique_ptr<Animation> animation = BuildTestAnimation();
+  ASSERT_TRUE(animation);
+  ozz::math::SoaTransform output[1];
+
+  {  // Empty cache fails.
+    PoseCache cache;
+    EXPECT_FALSE(cache.Sample(*animation, 0.f, output));
+  }
+
+  PoseCache cache(4, 8);
+  EXPECT_EQ(cache.max_tracks(), 4);
+  EXPECT_EQ(cache.max_entries(), 8);
+
+  {  // Too small output fails.
+    EXPECT_FALSE(cache.Sample(*animation, 0.f, {output, size_t(0)}));
+  }
+
+  {  // Capacity is rounded up to a power of two.
+    PoseCache rounded(4, 5);
+    EXPECT_EQ(rounded.max_entries(), 8);
+  }
+
+  EXPECT_TRUE(cache.Sample(*animation, 0.f, output));
+}
+
+TEST(Share, PoseCache) {
+  ozz::unique_ptr<Animation> animation = BuildTestAnimation();
+  ASSERT_TRUE(animation);
+
+  PoseCache cache(4, 8);
+  cache.set_intervals(10);
+
+  // First instance pays the sampling, the next ones in the same interval get
+  // the exact same pose.
+  ozz::math::SoaTransform miss_output[1];
+  ASSERT_TRUE(cache.Sample(*animation, .5f, miss_output));
+  EXPECT_EQ(cache.misses(), 1u);
+  EXPECT_EQ(cache.hits(), 0u);
+
+  ozz::math::SoaTransform hit_output[1];
+  ASSERT_TRUE(cache.Sample(*animation, .52f, hit_output));
+  EXPECT_EQ(cache.misses(), 1u);
+  EXPECT_EQ(cache.hits(), 1u);
+  EXPECT_EQ(std::memcmp(hit_output, miss_output, sizeof(hit_output)), 0);
+
+  // Cached poses are sampled at the quantized ratio, matching a direct
+  // sampling of it.
+  SamplingJob::Context context(1);
+  ozz::math::SoaTransform direct_output[1];
+  SamplingJob job;
+  job.animation = animation.get();
+  job.ratio = .5f;
+  job.context = &context;
+  job.output = direct_output;
+  ASSERT_TRUE(job.Run());
+  EXPECT_EQ(std::memcmp(hit_output, direct_output, sizeof(hit_output)), 0);
+
+  // A different interval is a miss.
+  ASSERT_TRUE(cache.Sample(*animation, .8f, hit_output));
+  EXPECT_EQ(cache.misses(), 2u);
+
+  // A different lod with the same ratio is a distinct entry.
+  ASSERT_TRUE(cache.Sample(*animation, .8f, hit_output, {}, 1));
+  EXPECT_EQ(cache.misses(), 3u);
+  ASSERT_TRUE(cache.Sample(*animation, .8f, hit_output, {}, 1));
+  EXPECT_EQ(cache.hits(), 2u);
+
+  // Changing quantization invalidates cached poses.
+  cache.set_intervals(100);
+  ASSERT_TRUE(cache.Sample(*animation, .8f, hit_output));
+  EXPECT_EQ(cache.misses(), 4u);
+
+  cache.ResetStatistics();
+  EXPECT_EQ(cache.hits(), 0u);
+  EXPECT_EQ(cache.misses(), 0u);
+}
@@ -0,0 +1,396 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/pose_codec.h"
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/raw_skeleton.h"
+#include "ozz/animation/offline/skeleton_builder.h"
+#include "ozz/animation/runtime/pose_utils.h"
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/maths/quaternion.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+using ozz::animation::PoseCodec;
+using ozz::animation::PoseSnapshotCodec;
+using ozz::animation::Skeleton;
+using ozz::animation::offline::RawSkeleton;
+using ozz::animation::offline::SkeletonBuilder;
+
+namespace {
+
+// Builds a 5 joints skeleton (2 soa blocks, 3 padding lanes) with non
+// identity rest pose transforms.
+ozz::unique_ptr<Skeleton> BuildTestSkeleton() {
+  RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  RawSkeleton::Joint& root = raw_skeleton.roots[0];
+  root.name = "root";
+  root.transform = ozz::math::Transform::identity();
+  root.transform.translation = ozz::math::Float3(0.f, 1.f, 0.f);
+
+  root.children.resize(2);
+  root.children[0].name = "j0";
+  root.children[0].transform = ozz::math::Transform::identity();
+  root.children[0].transform.translation = ozz::math::Float3(.5f, 0.f, 0.f);
+  root.children[0].transform.rotation =
+      ozz::math::Quaternion::FromEuler(.5f, 0.f, 0.f);
+  root.children[1].name = "j1";
+  root.children[1].transform = ozz::math::Transform::identity();
+  root.children[1].transform.translation = ozz::math::Float3(-.5f, 0.f, 0.f);
+  root.children[1].transform.scale = ozz::math::Float3(2.f, 2.f, 2.f);
+
+  root.children[0].children.resize(2);
+  root.children[0].children[0].name = "j00";
+  root.children[0].children[0].transform = ozz::math::Transform::identity();
+  root.children[0].children[1].name = "j01";
+  root.children[0].children[1].transform = ozz::math::Transform::identity();
+  root.children[0].children[1].transform.translation =
+      ozz::math::Float3(0.f, 0.f, .2f);
+
+  SkeletonBuilder builder;
+  return builder(raw_skeleton);
+}
+
+// Builds a pose perturbed from the skeleton rest pose, so deltas are not 0.
+void BuildTestPose(const Skeleton& _skeleton,
+                   const ozz::span<ozz::math::SoaTransform>& _pose) {
+  ozz::animation::FillRestPose(_skeleton, _pose);
+  for (size_t i = 0; i < _pose.size(); ++i) {
+    const ozz::math::SimdFloat4 delta =
+        ozz::math::simd_float4::Load(.1f, -.2f, .15f, -.05f);
+    _pose[i].translation.x = _pose[i].translation.x + delta;
+    _pose[i].translation.z = _pose[i].translation.z - delta;
+    _pose[i].scale.y = _pose[i].scale.y + delta;
+    // Rotates all joints by the same arbitrary quaternion.
+    const ozz::math::Quaternion rotation =
+        ozz::math::Quaternion::FromEuler(.3f, -.2f, .1f);
+    const ozz::math::SoaQuaternion soa_rotation = {
+        ozz::math::simd_float4::Load1(rotation.x),
+        ozz::math::simd_float4::Load1(rotation.y),
+        ozz::math::simd_float4::Load1(rotation.z),
+        ozz::math::simd_float4::Load1(rotation.w)};
+    _pose[i].rotation = soa_rotation * _pose[i].rotation;
+  }
+}
+
+// Maximum absolute difference between 2 poses, per component kind. Padding
+// lanes of the last soa block are skipped, the codec doesn't transport them.
+void PoseError(const ozz::span<const ozz::math::SoaTransform>& _a,
+               const ozz::span<const ozz::math::SoaTransform>& _b,
+               int _num_joints, float* _translation, float* _rotation,
+               float* _scale) {
+  *_translation = *_rotation = *_scale = 0.f;
+  for (size_t i = 0; i < _a.size(); ++i) {
+    const float* a = reinterpret_cast<const float*>(&_a[i]);
+    const float* b = reinterpret_cast<const float*>(&_b[i]);
+    for (int c = 0; c < 40; ++c) {
+      if (static_cast<int>(i * 4) + (c & 3) >= _num_joints) {
+        continue;
+      }
+      const float error = std::abs(a[c] - b[c]);
+      float* max_error = c < 12 ? _translation : c < 28 ? _rotation : _scale;
+      *max_error = ozz::math::Max(*max_error, error);
+    }
+  }
+}
+}  // namespace
+
+TEST(Validity, PoseCodec) {
+  ozz::unique_ptr<Skeleton> skeleton = BuildTestSkeleton();
+  ASSERT_TRUE(skeleton);
+
+  {  // nullptr skeleton.
+    PoseCodec codec;
+    EXPECT_FALSE(codec.Initialize(nullptr));
+    EXPECT_EQ(codec.encoded_size(), 0u);
+  }
+
+  {  // No class.
+    PoseCodec codec;
+    const ozz::vector<uint8_t> joint_classes(skeleton->num_joints(), 0);
+    EXPECT_FALSE(
+        codec.Initialize(skeleton.get(), {}, ozz::make_span(joint_classes)));
+  }
+
+  {  // Out of range bit budget.
+    PoseCodec codec;
+    PoseCodec::Quantization quant;
+    quant.rotation_bits = 24;
+    const ozz::vector<uint8_t> joint_classes(skeleton->num_joints(), 0);
+    EXPECT_FALSE(
+        codec.Initialize(skeleton.get(), {&quant, 1}, ozz::make_span(joint_classes)));
+    quant.rotation_bits = 0;
+    EXPECT_FALSE(
+        codec.Initialize(skeleton.get(), {&quant, 1}, ozz::make_span(joint_classes)));
+  }
+
+  {  // Invalid range.
+    PoseCodec codec;
+    PoseCodec::Quantization quant;
+    quant.translation_range = 0.f;
+    const ozz::vector<uint8_t> joint_classes(skeleton->num_joints(), 0);
+    EXPECT_FALSE(
+        codec.Initialize(skeleton.get(), {&quant, 1}, ozz::make_span(joint_classes)));
+  }
+
+  {  // Joint class count mismatch and out of range class index.
+    PoseCodec codec;
+    const PoseCodec::Quantization quant;
+    const ozz::vector<uint8_t> too_few(skeleton->num_joints() - 1, 0);
+    EXPECT_FALSE(codec.Initialize(skeleton.get(), {&quant, 1}, ozz::make_span(too_few)));
+    const ozz::vector<uint8_t> bad_index(skeleton->num_joints(), 1);
+    EXPECT_FALSE(
+        codec.Initialize(skeleton.get(), {&quant, 1}, ozz::make_span(bad_index)));
+  }
+
+  {  // Valid default setup, encode/decode validate spans.
+    PoseCodec codec;
+    ASSERT_TRUE(codec.Initialize(skeleton.get()));
+    EXPECT_GT(codec.encoded_size(), 0u);
+
+    ozz::vector<ozz::math::SoaTransform> pose(skeleton->num_soa_joints());
+    ozz::vector<ozz::byte> encoded(codec.encoded_size());
+    BuildTestPose(*skeleton, ozz::make_span(pose));
+
+    EXPECT_FALSE(codec.Encode(ozz::make_span(pose), {}));
+    EXPECT_FALSE(codec.Encode({}, ozz::make_span(encoded)));
+    EXPECT_TRUE(codec.Encode(ozz::make_span(pose), ozz::make_span(encoded)));
+
+    EXPECT_FALSE(codec.Decode(ozz::make_span(encoded), {}));
+    EXPECT_FALSE(codec.Decode({}, ozz::make_span(pose)));
+    EXPECT_TRUE(codec.Decode(ozz::make_span(encoded), ozz::make_span(pose)));
+
+    // Uninitialized codec rejects everything.
+    PoseCodec uninitialized;
+    EXPECT_FALSE(uninitialized.Encode(ozz::make_span(pose), ozz::make_span(encoded)));
+    EXPECT_FALSE(uninitialized.Decode(ozz::make_span(encoded), ozz::make_span(pose)));
+  }
+}
+
+TEST(RoundTrip, PoseCodec) {
+  ozz::unique_ptr<Skeleton> skeleton = BuildTestSkeleton();
+  ASSERT_TRUE(skeleton);
+
+  PoseCodec codec;
+  ASSERT_TRUE(codec.Initialize(skeleton.get()));
+
+  ozz::vector<ozz::math::SoaTransform> pose(skeleton->num_soa_joints());
+  BuildTestPose(*skeleton, ozz::make_span(pose));
+
+  ozz::vector<ozz::byte> encoded(codec.encoded_size());
+  ASSERT_TRUE(codec.Encode(ozz::make_span(pose), ozz::make_span(encoded)));
+
+  ozz::vector<ozz::math::SoaTransform> decoded(skeleton->num_soa_joints());
+  ASSERT_TRUE(codec.Decode(ozz::make_span(encoded), ozz::make_span(decoded)));
+
+  // Decoded pose matches the source up to quantization error.
+  float translation_error, rotation_error, scale_error;
+  PoseError(ozz::make_span(pose), ozz::make_span(decoded),
+            skeleton->num_joints(), &translation_error,
+            &rotation_error, &scale_error);
+  // 16 bits over [-1, 1], 12 bits smallest-three, 8 bits over [-1, 1].
+  EXPECT_LT(translation_error, 2.f / ((1 << 16) - 1) + 1e-6f);
+  EXPECT_LT(rotation_error, 1e-3f);
+  EXPECT_LT(scale_error, 2.f / ((1 << 8) - 1) + 1e-6f);
+}
+
+TEST(BitExact, PoseCodec) {
+  ozz::unique_ptr<Skeleton> skeleton = BuildTestSkeleton();
+  ASSERT_TRUE(skeleton);
+
+  PoseCodec codec;
+  ASSERT_TRUE(codec.Initialize(skeleton.get()));
+
+  ozz::vector<ozz::math::SoaTransform> pose(skeleton->num_soa_joints());
+  BuildTestPose(*skeleton, ozz::make_span(pose));
+
+  // Encoding the same pose twice produces the same bytes, padding included.
+  ozz::vector<ozz::byte> encoded(codec.encoded_size(), 0xfd);
+  ozz::vector<ozz::byte> re_encoded(codec.encoded_size());
+  ASSERT_TRUE(codec.Encode(ozz::make_span(pose), ozz::make_span(encoded)));
+  ASSERT_TRUE(codec.Encode(ozz::make_span(pose), ozz::make_span(re_encoded)));
+  EXPECT_EQ(
+      std::memcmp(encoded.data(), re_encoded.data(), codec.encoded_size()), 0);
+
+  // Decode-encode is idempotent once quantized, the property rollback relies
+  // on.
+  ozz::vector<ozz::math::SoaTransform> decoded(skeleton->num_soa_joints());
+  ASSERT_TRUE(codec.Decode(ozz::make_span(encoded), ozz::make_span(decoded)));
+  ASSERT_TRUE(codec.Encode(ozz::make_span(decoded), ozz::make_span(re_encoded)));
+  ASSERT_TRUE(codec.Decode(ozz::make_span(re_encoded), ozz::make_span(pose)));
+  EXPECT_EQ(std::memcmp(pose.data(), decoded.data(),
+                        sizeof(ozz::math::SoaTransform) * pose.size()),
+            0);
+}
+
+TEST(JointClasses, PoseCodec) {
+  ozz::unique_ptr<Skeleton> skeleton = BuildTestSkeleton();
+  ASSERT_TRUE(skeleton);
+
+  // Root joints get a bigger budget than leaves.
+  PoseCodec::Quantization classes[2];
+  classes[0].translation_bits = 20;
+  classes[0].rotation_bits = 16;
+  classes[1].translation_bits = 8;
+  classes[1].rotation_bits = 8;
+  classes[1].scale_bits = 4;
+
+  ozz::vector<uint8_t> joint_classes(skeleton->num_joints(), 1);
+  joint_classes[0] = 0;  // Root.
+
+  PoseCodec codec;
+  ASSERT_TRUE(
+      codec.Initialize(skeleton.get(), classes, ozz::make_span(joint_classes)));
+
+  // Cheaper than encoding every joint with the big budget.
+  PoseCodec expensive;
+  ozz::vector<uint8_t> all_first(skeleton->num_joints(), 0);
+  ASSERT_TRUE(
+      expensive.Initialize(skeleton.get(), {classes, 1}, ozz::make_span(all_first)));
+  EXPECT_LT(codec.encoded_size(), expensive.encoded_size());
+
+  // Round trips within the coarsest class precision.
+  ozz::vector<ozz::math::SoaTransform> pose(skeleton->num_soa_joints());
+  BuildTestPose(*skeleton, ozz::make_span(pose));
+  ozz::vector<ozz::byte> encoded(codec.encoded_size());
+  ASSERT_TRUE(codec.Encode(ozz::make_span(pose), ozz::make_span(encoded)));
+  ozz::vector<ozz::math::SoaTransform> decoded(skeleton->num_soa_joints());
+  ASSERT_TRUE(codec.Decode(ozz::make_span(encoded), ozz::make_span(decoded)));
+
+  float translation_error, rotation_error, scale_error;
+  PoseError(ozz::make_span(pose), ozz::make_span(decoded),
+            skeleton->num_joints(), &translation_error,
+            &rotation_error, &scale_error);
+  EXPECT_LT(translation_error, 2.f / ((1 << 8) - 1) + 1e-6f);
+  EXPECT_LT(rotation_error, 1e-1f);
+  EXPECT_LT(scale_error, 2.f / ((1 << 4) - 1) + 1e-6f);
+}
+
+TEST(Validity, PoseSnapshotCodec) {
+  ozz::unique_ptr<Skeleton> skeleton = BuildTestSkeleton();
+  ASSERT_TRUE(skeleton);
+
+  ozz::vector<ozz::math::SoaTransform> pose(skeleton->num_soa_joints());
+  ozz::animation::FillRestPose(*skeleton, ozz::make_span(pose));
+
+  // Uninitialized codec.
+  {
+    PoseSnapshotCodec codec;
+    EXPECT_FALSE(codec.Initialize(nullptr));
+    EXPECT_EQ(codec.max_encoded_size(), 0u);
+    ozz::vector<ozz::byte> encoded(64);
+    EXPECT_EQ(codec.Encode(ozz::make_span(pose), ozz::make_span(encoded)), 0u);
+    EXPECT_FALSE(codec.Decode(ozz::make_span(encoded), ozz::make_span(pose)));
+  }
+
+  PoseSnapshotCodec codec;
+  ASSERT_TRUE(codec.Initialize(skeleton.get()));
+  EXPECT_GT(codec.max_encoded_size(), 0u);
+
+  // Pose smaller than the skeleton.
+  {
+    ozz::vector<ozz::byte> encoded(codec.max_encoded_size());
+    EXPECT_EQ(codec.Encode({pose.data(), pose.size() - 1},
+                           ozz::make_span(encoded)),
+              0u);
+  }
+
+  // Encoded buffer too small for the pose.
+  {
+    ozz::vector<ozz::math::SoaTransform> perturbed(skeleton->num_soa_joints());
+    BuildTestPose(*skeleton, ozz::make_span(perturbed));
+    ozz::vector<ozz::byte> encoded(4);
+    EXPECT_EQ(codec.Encode(ozz::make_span(perturbed), ozz::make_span(encoded)),
+              0u);
+  }
+
+  // Decoding a truncated stream fails.
+  {
+    ozz::vector<ozz::math::SoaTransform> perturbed(skeleton->num_soa_joints());
+    BuildTestPose(*skeleton, ozz::make_span(perturbed));
+    ozz::vector<ozz::byte> encoded(codec.max_encoded_size());
+    const size_t size =
+        codec.Encode(ozz::make_span(perturbed), ozz::make_span(encoded));
+    ASSERT_GT(size, 0u);
+    EXPECT_FALSE(
+        codec.Decode({encoded.data(), size - 1}, ozz::make_span(pose)));
+    // So does a trailing remain.
+    EXPECT_FALSE(
+        codec.Decode({encoded.data(), size + 1}, ozz::make_span(pose)));
+  }
+}
+
+TEST(RoundTrip, PoseSnapshotCodec) {
+  ozz::unique_ptr<Skeleton> skeleton = BuildTestSkeleton();
+  ASSERT_TRUE(skeleton);
+
+  PoseSnapshotCodec codec;
+  ASSERT_TRUE(codec.Initialize(skeleton.get()));
+
+  // The rest pose xors to all-zero blocks, the snapshot boils down to its
+  // occupancy masks.
+  {
+    ozz::vector<ozz::math::SoaTransform> pose(skeleton->num_soa_joints());
+    ozz::animation::FillRestPose(*skeleton, ozz::make_span(pose));
+    ozz::vector<ozz::byte> encoded(codec.max_encoded_size());
+    const size_t size =
+        codec.Encode(ozz::make_span(pose), ozz::make_span(encoded));
+    EXPECT_EQ(size, (pose.size() * 10 + 7) / 8);
+
+    // Decodes back bit-identical, over a garbage initialized pose.
+    ozz::vector<ozz::math::SoaTransform> decoded(skeleton->num_soa_joints());
+    std::memset(decoded.data(), 0xfd,
+                decoded.size() * sizeof(ozz::math::SoaTransform));
+    ASSERT_TRUE(codec.Decode({encoded.data(), size}, ozz::make_span(decoded)));
+    EXPECT_EQ(std::memcmp(pose.data(), decoded.data(),
+                          pose.size() * sizeof(ozz::math::SoaTransform)),
+              0);
+  }
+
+  // A fully perturbed pose round trips bit-identical too, the rollback
+  // requirement lossy codecs can't meet.
+  {
+    ozz::vector<ozz::math::SoaTransform> pose(skeleton->num_soa_joints());
+    BuildTestPose(*skeleton, ozz::make_span(pose));
+    ozz::vector<ozz::byte> encoded(codec.max_encoded_size());
+    const size_t size =
+        codec.Encode(ozz::make_span(pose), ozz::make_span(encoded));
+    ASSERT_GT(size, 0u);
+    EXPECT_LE(size, codec.max_encoded_size());
+
+    ozz::vector<ozz::math::SoaTransform> decoded(skeleton->num_soa_joints());
+    ASSERT_TRUE(codec.Decode({encoded.data(), size}, ozz::make_span(decoded)));
+    EXPECT_EQ(std::memcmp(pose.data(), decoded.data(),
+                          pose.size() * sizeof(ozz::math::SoaTransform)),
+              0);
+  }
+}
@@ -0,0 +1,187 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "gtest/gtest.h"
+#include "ozz/animation/runtime/pose_lerp_job.h"
+#include "ozz/base/maths/gtest_math_helper.h"
+#include "ozz/base/maths/soa_transform.h"
+
+using ozz::animation::PoseLerpJob;
+
+TEST(JobValidity, PoseLerpJob) {
+  const ozz::math::SoaTransform identity = ozz::math::SoaTransform::identity();
+  const ozz::math::SoaTransform from[2] = {identity, identity};
+  const ozz::math::SoaTransform to[2] = {identity, identity};
+  ozz::math::SoaTransform output[2] = {identity, identity};
+
+  {  // Empty/default job.
+    PoseLerpJob job;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // Mismatching input sizes.
+    PoseLerpJob job;
+    job.from = from;
+    job.to = {to, to + 1};
+    job.output = output;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // Output range too small.
+    PoseLerpJob job;
+    job.from = from;
+    job.to = to;
+    job.output = {output, output + 1};
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // Valid job.
+    PoseLerpJob job;
+    job.from = from;
+    job.to = to;
+    job.output = output;
+    EXPECT_TRUE(job.Validate());
+    EXPECT_TRUE(job.Run());
+  }
+
+  {  // Bigger output is valid.
+    PoseLerpJob job;
+    job.from = {from, from + 1};
+    job.to = {to, to + 1};
+    job.output = output;
+    EXPECT_TRUE(job.Validate());
+    EXPECT_TRUE(job.Run());
+  }
+}
+
+TEST(JobResult, PoseLerpJob) {
+  const ozz::math::SoaTransform identity = ozz::math::SoaTransform::identity();
+
+  ozz::math::SoaTransform from[2] = {identity, identity};
+  ozz::math::SoaTransform to[2] = {identity, identity};
+  ozz::math::SoaTransform output[2] = {identity, identity};
+
+  from[0].translation = ozz::math::SoaFloat3::Load(
+      ozz::math::simd_float4::Load(0.f, 2.f, 4.f, 6.f),
+      ozz::math::simd_float4::zero(), ozz::math::simd_float4::zero());
+  to[0].translation = ozz::math::SoaFloat3::Load(
+      ozz::math::simd_float4::Load(4.f, 6.f, 8.f, 10.f),
+      ozz::math::simd_float4::zero(), ozz::math::simd_float4::zero());
+  from[1].scale = ozz::math::SoaFloat3::Load(
+      ozz::math::simd_float4::one(), ozz::math::simd_float4::one(),
+      ozz::math::simd_float4::Load(2.f, 2.f, 2.f, 2.f));
+  to[1].scale = ozz::math::SoaFloat3::Load(
+      ozz::math::simd_float4::one(), ozz::math::simd_float4::one(),
+      ozz::math::simd_float4::Load(4.f, 4.f, 4.f, 4.f));
+  // Lane 0 rotation interpolates from identity to a quarter turn around y.
+  to[0].rotation = ozz::math::SoaQuaternion::Load(
+      ozz::math::simd_float4::zero(),
+      ozz::math::simd_float4::Load(.70710677f, 0.f, 0.f, 0.f),
+      ozz::math::simd_float4::zero(),
+      ozz::math::simd_float4::Load(.70710677f, 1.f, 1.f, 1.f));
+
+  PoseLerpJob job;
+  job.from = from;
+  job.to = to;
+  job.output = output;
+
+  {  // Alpha 0 outputs from pose.
+    job.alpha = 0.f;
+    ASSERT_TRUE(job.Run());
+    EXPECT_SOAFLOAT3_EQ(output[0].translation, 0.f, 2.f, 4.f, 6.f, 0.f, 0.f,
+                        0.f, 0.f, 0.f, 0.f, 0.f, 0.f);
+    EXPECT_SOAQUATERNION_EQ_EST(output[0].rotation, 0.f, 0.f, 0.f, 0.f, 0.f,
+                                0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 1.f, 1.f,
+                                1.f, 1.f);
+    EXPECT_SOAFLOAT3_EQ(output[1].scale, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f,
+                        1.f, 2.f, 2.f, 2.f, 2.f);
+  }
+
+  {  // Alpha 1 outputs to pose.
+    job.alpha = 1.f;
+    ASSERT_TRUE(job.Run());
+    EXPECT_SOAFLOAT3_EQ(output[0].translation, 4.f, 6.f, 8.f, 10.f, 0.f, 0.f,
+                        0.f, 0.f, 0.f, 0.f, 0.f, 0.f);
+    EXPECT_SOAQUATERNION_EQ_EST(output[0].rotation, 0.f, 0.f, 0.f, 0.f,
+                                .70710677f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f,
+                                .70710677f, 1.f, 1.f, 1.f);
+    EXPECT_SOAFLOAT3_EQ(output[1].scale, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f,
+                        1.f, 4.f, 4.f, 4.f, 4.f);
+  }
+
+  {  // Alpha .5 interpolates, rotation along the shortest path (nlerp).
+    job.alpha = .5f;
+    ASSERT_TRUE(job.Run());
+    EXPECT_SOAFLOAT3_EQ(output[0].translation, 2.f, 4.f, 6.f, 8.f, 0.f, 0.f,
+                        0.f, 0.f, 0.f, 0.f, 0.f, 0.f);
+    EXPECT_SOAQUATERNION_EQ_EST(output[0].rotation, 0.f, 0.f, 0.f, 0.f,
+                                .38268343f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f,
+                                .92387953f, 1.f, 1.f, 1.f);
+    EXPECT_SOAFLOAT3_EQ(output[1].scale, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f,
+                        1.f, 3.f, 3.f, 3.f, 3.f);
+  }
+
+  {  // Alpha is clamped to range [0, 1].
+    job.alpha = 2.f;
+    ASSERT_TRUE(job.Run());
+    EXPECT_SOAFLOAT3_EQ(output[0].translation, 4.f, 6.f, 8.f, 10.f, 0.f, 0.f,
+                        0.f, 0.f, 0.f, 0.f, 0.f, 0.f);
+  }
+
+  {  // Opposed quaternions interpolate along the shortest path, as if "to"
+     // sign was flipped.
+    ozz::math::SoaTransform nfrom = identity;
+    ozz::math::SoaTransform nto = identity;
+    nto.rotation = -nto.rotation;
+    ozz::math::SoaTransform noutput;
+
+    PoseLerpJob njob;
+    njob.alpha = .5f;
+    njob.from = {&nfrom, 1};
+    njob.to = {&nto, 1};
+    njob.output = {&noutput, 1};
+    ASSERT_TRUE(njob.Run());
+    EXPECT_SOAQUATERNION_EQ_EST(noutput.rotation, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f,
+                                0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 1.f, 1.f, 1.f,
+                                1.f);
+  }
+
+  {  // Output can alias inputs.
+    ozz::math::SoaTransform aliased[2] = {from[0], from[1]};
+    PoseLerpJob ajob;
+    ajob.alpha = 1.f;
+    ajob.from = aliased;
+    ajob.to = to;
+    ajob.output = aliased;
+    ASSERT_TRUE(ajob.Run());
+    EXPECT_SOAFLOAT3_EQ(aliased[0].translation, 4.f, 6.f, 8.f, 10.f, 0.f, 0.f,
+                        0.f, 0.f, 0.f, 0.f, 0.f, 0.f);
+  }
+}
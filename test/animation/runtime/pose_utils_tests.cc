@@ -0,0 +1,223 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/pose_utils.h"
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/raw_skeleton.h"
+#include "ozz/animation/offline/skeleton_builder.h"
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/gtest_helper.h"
+#include "ozz/base/maths/gtest_math_helper.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+using ozz::animation::Skeleton;
+using ozz::animation::offline::RawSkeleton;
+using ozz::animation::offline::SkeletonBuilder;
+
+namespace {
+
+// Builds a 4 joints skeleton (a single soa block, no padding lane) with
+// distinct rest pose transforms per joint.
+ozz::unique_ptr<Skeleton> BuildTestSkeleton() {
+  RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  RawSkeleton::Joint& root = raw_skeleton.roots[0];
+  root.name = "root";
+  root.transform = ozz::math::Transform::identity();
+  root.transform.translation = ozz::math::Float3::x_axis();
+
+  root.children.resize(3);
+  root.children[0].name = "j0";
+  root.children[0].transform = ozz::math::Transform::identity();
+  root.children[0].transform.translation = ozz::math::Float3::y_axis();
+  root.children[0].transform.rotation = -ozz::math::Quaternion::identity();
+  root.children[1].name = "j1";
+  root.children[1].transform = ozz::math::Transform::identity();
+  root.children[1].transform.translation = ozz::math::Float3::z_axis();
+  root.children[2].name = "j2";
+  root.children[2].transform = ozz::math::Transform::identity();
+  root.children[2].transform.translation = ozz::math::Float3(2.f, 2.f, 2.f);
+  root.children[2].transform.scale = ozz::math::Float3(3.f, 3.f, 3.f);
+
+  SkeletonBuilder builder;
+  return builder(raw_skeleton);
+}
+}  // namespace
+
+TEST(IdentityFill, PoseUtils) {
+  ozz::math::SoaTransform pose[2];
+  std::memset(pose, 0xfd, sizeof(pose));
+
+  ozz::animation::FillIdentityPose(pose);
+
+  const ozz::math::SoaTransform identity = ozz::math::SoaTransform::identity();
+  EXPECT_EQ(std::memcmp(&pose[0], &identity, sizeof(identity)), 0);
+  EXPECT_EQ(std::memcmp(&pose[1], &identity, sizeof(identity)), 0);
+
+  {  // Empty pose is a no-op.
+    ozz::animation::FillIdentityPose({});
+  }
+}
+
+TEST(RestPoseFill, PoseUtils) {
+  ozz::unique_ptr<Skeleton> skeleton = BuildTestSkeleton();
+  ASSERT_TRUE(skeleton);
+  ASSERT_EQ(skeleton->num_soa_joints(), 1);
+
+  ozz::math::SoaTransform pose[1];
+  std::memset(pose, 0xfd, sizeof(pose));
+
+  ozz::animation::FillRestPose(*skeleton, pose);
+  EXPECT_EQ(std::memcmp(pose, skeleton->joint_rest_poses().data(),
+                        sizeof(pose)),
+            0);
+
+  // Too small pose buffer asserts.
+  EXPECT_ASSERTION(ozz::animation::FillRestPose(*skeleton, {}),
+                   "Pose is too small.");
+}
+
+TEST(MaskedRestPoseFill, PoseUtils) {
+  ozz::unique_ptr<Skeleton> skeleton = BuildTestSkeleton();
+  ASSERT_TRUE(skeleton);
+
+  // Masks joints 0 and 3 in, 1 and 2 out.
+  const ozz::math::SimdInt4 mask[1] = {
+      ozz::math::simd_int4::Load(~0, 0, 0, ~0)};
+  ozz::math::SoaTransform pose[1];
+
+  ozz::animation::FillIdentityPose(pose);
+  ozz::animation::FillRestPose(*skeleton, mask, pose);
+
+  // Masked joints take rest pose values, others keep identity.
+  EXPECT_SOAFLOAT3_EQ(pose[0].translation, 1.f, 0.f, 0.f, 2.f, 0.f, 0.f, 0.f,
+                      2.f, 0.f, 0.f, 0.f, 2.f);
+  // Joint 1 rest rotation is -identity, but isn't masked in.
+  EXPECT_SOAQUATERNION_EQ(pose[0].rotation, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f,
+                          0.f, 0.f, 0.f, 0.f, 0.f, 1.f, 1.f, 1.f, 1.f);
+  EXPECT_SOAFLOAT3_EQ(pose[0].scale, 1.f, 1.f, 1.f, 3.f, 1.f, 1.f, 1.f, 3.f,
+                      1.f, 1.f, 1.f, 3.f);
+
+  // Too small mask asserts.
+  EXPECT_ASSERTION(ozz::animation::FillRestPose(*skeleton, {}, pose),
+                   "Pose or mask is too small.");
+}
+
+TEST(MaskedCopy, PoseUtils) {
+  const ozz::math::SoaTransform identity = ozz::math::SoaTransform::identity();
+
+  ozz::math::SoaTransform from[2] = {identity, identity};
+  from[0].translation = ozz::math::SoaFloat3::Load(
+      ozz::math::simd_float4::Load(1.f, 2.f, 3.f, 4.f),
+      ozz::math::simd_float4::zero(), ozz::math::simd_float4::zero());
+  from[0].rotation = ozz::math::SoaQuaternion::Load(
+      ozz::math::simd_float4::zero(), ozz::math::simd_float4::one(),
+      ozz::math::simd_float4::zero(), ozz::math::simd_float4::zero());
+  from[1].scale = ozz::math::SoaFloat3::Load(
+      ozz::math::simd_float4::Load(5.f, 6.f, 7.f, 8.f),
+      ozz::math::simd_float4::one(), ozz::math::simd_float4::one());
+
+  ozz::math::SoaTransform to[2];
+
+  {  // Translation and scale only, rotation is left untouched.
+    to[0] = to[1] = identity;
+    ozz::animation::CopyPose(
+        from, ozz::animation::kPoseTranslation | ozz::animation::kPoseScale,
+        to);
+    EXPECT_SOAFLOAT3_EQ(to[0].translation, 1.f, 2.f, 3.f, 4.f, 0.f, 0.f, 0.f,
+                        0.f, 0.f, 0.f, 0.f, 0.f);
+    EXPECT_SOAQUATERNION_EQ(to[0].rotation, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f,
+                            0.f, 0.f, 0.f, 0.f, 0.f, 1.f, 1.f, 1.f, 1.f);
+    EXPECT_SOAFLOAT3_EQ(to[1].scale, 5.f, 6.f, 7.f, 8.f, 1.f, 1.f, 1.f, 1.f,
+                        1.f, 1.f, 1.f, 1.f);
+  }
+
+  {  // Rotation only.
+    to[0] = to[1] = identity;
+    ozz::animation::CopyPose(from, ozz::animation::kPoseRotation, to);
+    EXPECT_SOAFLOAT3_EQ(to[0].translation, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f,
+                        0.f, 0.f, 0.f, 0.f, 0.f);
+    EXPECT_SOAQUATERNION_EQ(to[0].rotation, 0.f, 0.f, 0.f, 0.f, 1.f, 1.f, 1.f,
+                            1.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f);
+  }
+
+  {  // All components is a plain copy.
+    std::memset(to, 0xfd, sizeof(to));
+    ozz::animation::CopyPose(from, ozz::animation::kAllPoseComponents, to);
+    EXPECT_EQ(std::memcmp(to, from, sizeof(to)), 0);
+  }
+
+  {  // Bigger destination is valid, trailing transforms are left untouched.
+    ozz::math::SoaTransform big_to[2] = {identity, identity};
+    ozz::animation::CopyPose({from, from + 1},
+                             ozz::animation::kAllPoseComponents, big_to);
+    EXPECT_EQ(std::memcmp(&big_to[0], &from[0], sizeof(from[0])), 0);
+    EXPECT_EQ(std::memcmp(&big_to[1], &identity, sizeof(identity)), 0);
+  }
+}
+
+TEST(HalfCompression, PoseUtils) {
+  ozz::unique_ptr<Skeleton> skeleton = BuildTestSkeleton();
+  ASSERT_TRUE(skeleton);
+  ASSERT_EQ(skeleton->num_soa_joints(), 1);
+
+  ozz::math::SoaTransform pose[1];
+  ozz::animation::FillRestPose(*skeleton, pose);
+
+  ASSERT_EQ(ozz::animation::CompressedPoseSize(1), 40u);
+  uint16_t compressed[40];
+  ozz::animation::CompressPose(pose, compressed);
+
+  ozz::math::SoaTransform decompressed[1];
+  std::memset(decompressed, 0xfd, sizeof(decompressed));
+  ozz::animation::DecompressPose(compressed, decompressed);
+
+  // Test skeleton rest pose is made of small integral component values, all
+  // exactly representable as half floats, so the round trip is lossless.
+  EXPECT_EQ(std::memcmp(decompressed, pose, sizeof(pose)), 0);
+
+  // Round trips a pose with values that aren't representable as half floats.
+  // Half floats have 11 bits of mantissa, expects ~1e-3 relative precision.
+  pose[0].rotation.x = ozz::math::simd_float4::Load(.70710677f, 0.f, 0.f, 0.f);
+  pose[0].rotation.w = ozz::math::simd_float4::Load(.70710677f, 1.f, 1.f, 1.f);
+  pose[0].translation.x =
+      ozz::math::simd_float4::Load(-123.456f, .333333f, 1e-4f, 1e4f);
+  ozz::animation::CompressPose(pose, compressed);
+  ozz::animation::DecompressPose(compressed, decompressed);
+  EXPECT_SOAQUATERNION_EQ_EST(decompressed[0].rotation, .70710677f, 0.f, 0.f,
+                              0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f,
+                              .70710677f, 1.f, 1.f, 1.f);
+  const ozz::math::SimdFloat4 tx = decompressed[0].translation.x;
+  EXPECT_NEAR(ozz::math::GetX(tx), -123.456f, .1f);
+  EXPECT_NEAR(ozz::math::GetY(tx), .333333f, 1e-3f);
+  EXPECT_NEAR(ozz::math::GetZ(tx), 1e-4f, 1e-6f);
+  EXPECT_NEAR(ozz::math::GetW(tx), 1e4f, 10.f);
+}
@@ -0,0 +1,156 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+#include "ozz/animation/runtime/pose_variation_job.h"
+#include "ozz/base/maths/gtest_math_helper.h"
+#include "ozz/base/maths/soa_transform.h"
+
+using ozz::animation::PoseVariationJob;
+
+TEST(JobValidity, PoseVariationJob) {
+  const ozz::math::SoaTransform identity = ozz::math::SoaTransform::identity();
+  const ozz::math::SoaTransform input[2] = {identity, identity};
+  ozz::math::SoaTransform output[2] = {identity, identity};
+  const ozz::math::SimdFloat4 weights[2] = {ozz::math::simd_float4::one(),
+                                            ozz::math::simd_float4::one()};
+
+  {  // Empty/default job.
+    PoseVariationJob job;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // Output range too small.
+    PoseVariationJob job;
+    job.input = input;
+    job.output = {output, output + 1};
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // Weights range too small.
+    PoseVariationJob job;
+    job.input = input;
+    job.output = output;
+    job.joint_weights = {weights, weights + 1};
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // Valid job, with and without weights.
+    PoseVariationJob job;
+    job.input = input;
+    job.output = output;
+    EXPECT_TRUE(job.Validate());
+    EXPECT_TRUE(job.Run());
+    job.joint_weights = weights;
+    EXPECT_TRUE(job.Validate());
+    EXPECT_TRUE(job.Run());
+  }
+}
+
+namespace {
+// Expects _transform to be the identity, within normalization estimate
+// tolerance (the variation quaternion goes through NormalizeEst).
+void ExpectIdentityEst(const ozz::math::SoaTransform& _transform) {
+  EXPECT_SOAFLOAT3_EQ(_transform.translation, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f,
+                      0.f, 0.f, 0.f, 0.f, 0.f, 0.f);
+  EXPECT_SOAQUATERNION_EQ_EST(_transform.rotation, 0.f, 0.f, 0.f, 0.f, 0.f,
+                              0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 1.f, 1.f,
+                              1.f, 1.f);
+  EXPECT_SOAFLOAT3_EQ(_transform.scale, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f,
+                      1.f, 1.f, 1.f, 1.f, 1.f);
+}
+}  // namespace
+
+TEST(JobResult, PoseVariationJob) {
+  const ozz::math::SoaTransform identity = ozz::math::SoaTransform::identity();
+  const ozz::math::SoaTransform input[2] = {identity, identity};
+  ozz::math::SoaTransform output[2];
+  ozz::math::SoaTransform reference[2];
+
+  {  // Zero amplitudes preserve the input pose.
+    PoseVariationJob job;
+    job.input = input;
+    job.output = output;
+    job.seed = 27;
+    job.time = .5f;
+    ASSERT_TRUE(job.Run());
+    ExpectIdentityEst(output[0]);
+    ExpectIdentityEst(output[1]);
+  }
+
+  PoseVariationJob job;
+  job.input = input;
+  job.output = output;
+  job.seed = 27;
+  job.time = .5f;
+  job.rotation_amplitude = .1f;
+  job.translation_amplitude = .1f;
+
+  {  // The variation perturbs the pose and is deterministic: a re-run with
+     // the same seed and time reproduces it exactly.
+    ASSERT_TRUE(job.Run());
+    EXPECT_NE(std::memcmp(output, input, sizeof(input)), 0);
+
+    job.output = reference;
+    ASSERT_TRUE(job.Run());
+    EXPECT_EQ(std::memcmp(output, reference, sizeof(output)), 0);
+    job.output = output;
+  }
+
+  {  // Rotations stay normalized.
+    for (const ozz::math::SoaTransform& transform : output) {
+      EXPECT_TRUE(
+          ozz::math::AreAllTrue(ozz::math::IsNormalizedEst(transform.rotation)));
+    }
+  }
+
+  {  // A different seed decorrelates, a different time drifts.
+    job.seed = 99;
+    ASSERT_TRUE(job.Run());
+    EXPECT_NE(std::memcmp(output, reference, sizeof(output)), 0);
+
+    job.seed = 27;
+    job.time = .6f;
+    ASSERT_TRUE(job.Run());
+    EXPECT_NE(std::memcmp(output, reference, sizeof(output)), 0);
+  }
+
+  {  // Zero weights neutralize the variation, whatever the amplitudes.
+    const ozz::math::SimdFloat4 zero_weights[2] = {
+        ozz::math::simd_float4::zero(), ozz::math::simd_float4::zero()};
+    job.time = .5f;
+    job.joint_weights = zero_weights;
+    ASSERT_TRUE(job.Run());
+    ExpectIdentityEst(output[0]);
+    ExpectIdentityEst(output[1]);
+  }
+}
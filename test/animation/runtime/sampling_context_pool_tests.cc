@@ -0,0 +1,225 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/sampling_context_pool.h"
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/animation_builder.h"
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/base/maths/gtest_math_helper.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+using ozz::animation::Animation;
+using ozz::animation::SamplingContextPool;
+using ozz::animation::SamplingJob;
+using ozz::animation::offline::AnimationBuilder;
+using ozz::animation::offline::RawAnimation;
+
+namespace {
+// Builds a 2 tracks animation with a moving translation on the first track.
+ozz::unique_ptr<Animation> BuildTestAnimation() {
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(2);
+  const RawAnimation::TranslationKey key0 = {0.f,
+                                             ozz::math::Float3(1.f, 2.f, 3.f)};
+  raw_animation.tracks[0].translations.push_back(key0);
+  const RawAnimation::TranslationKey key1 = {1.f,
+                                             ozz::math::Float3(5.f, 6.f, 7.f)};
+  raw_animation.tracks[0].translations.push_back(key1);
+  AnimationBuilder builder;
+  return builder(raw_animation);
+}
+}  // namespace
+
+TEST(Eviction, SamplingContextPool) {
+  SamplingContextPool pool(5, 2);
+  EXPECT_EQ(pool.max_tracks(), 5);
+  EXPECT_EQ(pool.capacity(), 2u);
+  EXPECT_EQ(pool.num_backed(), 0u);
+
+  SamplingJob::Context contexts[3];
+  EXPECT_EQ(contexts[0].max_tracks(), 0);
+
+  // Cold touch backs the context, sized for the pool track count (aligned to
+  // soa size).
+  EXPECT_FALSE(pool.Touch(&contexts[0]));
+  EXPECT_EQ(contexts[0].max_tracks(), 8);
+  EXPECT_EQ(pool.num_backed(), 1u);
+
+  // Warm touch leaves it backed.
+  EXPECT_TRUE(pool.Touch(&contexts[0]));
+  EXPECT_EQ(pool.num_backed(), 1u);
+
+  // Second context fills the pool.
+  EXPECT_FALSE(pool.Touch(&contexts[1]));
+  EXPECT_EQ(pool.num_backed(), 2u);
+
+  // Third context evicts context 0, the least recently touched one, which is
+  // left empty.
+  EXPECT_FALSE(pool.Touch(&contexts[2]));
+  EXPECT_EQ(pool.num_backed(), 2u);
+  EXPECT_EQ(contexts[0].max_tracks(), 0);
+
+  // Re-touching context 0 evicts context 1 in turn.
+  EXPECT_FALSE(pool.Touch(&contexts[0]));
+  EXPECT_EQ(contexts[0].max_tracks(), 8);
+  EXPECT_EQ(contexts[1].max_tracks(), 0);
+  EXPECT_EQ(contexts[2].max_tracks(), 8);
+
+  // Releasing recycles the buffer, no eviction needed for the next touch.
+  pool.Release(&contexts[2]);
+  EXPECT_EQ(pool.num_backed(), 1u);
+  EXPECT_EQ(contexts[2].max_tracks(), 0);
+  EXPECT_FALSE(pool.Touch(&contexts[1]));
+  EXPECT_EQ(pool.num_backed(), 2u);
+  EXPECT_EQ(contexts[0].max_tracks(), 8);
+
+  // Releasing a context that isn't backed is a no-op.
+  pool.Release(&contexts[2]);
+  EXPECT_EQ(pool.num_backed(), 2u);
+
+  // Destruction detaches remaining contexts.
+}
+
+TEST(Sampling, SamplingContextPool) {
+  ozz::unique_ptr<Animation> animation = BuildTestAnimation();
+  ASSERT_TRUE(animation);
+
+  SamplingContextPool pool(animation->num_tracks(), 1);
+  SamplingJob::Context pooled;
+  SamplingJob::Context reference(animation->num_tracks());
+
+  ozz::math::SoaTransform output[1];
+  ozz::math::SoaTransform ref_output[1];
+  for (int i = 0; i <= 10; ++i) {
+    const float ratio = i / 10.f;
+
+    // Backed on the first touch only, warm afterwards.
+    EXPECT_EQ(pool.Touch(&pooled), i != 0);
+
+    SamplingJob job;
+    job.animation = animation.get();
+    job.context = &pooled;
+    job.ratio = ratio;
+    job.output = output;
+    ASSERT_TRUE(job.Run());
+
+    job.context = &reference;
+    job.output = ref_output;
+    ASSERT_TRUE(job.Run());
+
+    EXPECT_SOAFLOAT3_EQ_EST(output[0].translation, 1.f + ratio * 4.f, 0.f,
+                            0.f, 0.f, 2.f + ratio * 4.f, 0.f, 0.f, 0.f,
+                            3.f + ratio * 4.f, 0.f, 0.f, 0.f);
+  }
+
+  // A second context steals the single buffer, leaving the first one unable
+  // to sample until it's touched again.
+  SamplingJob::Context other;
+  EXPECT_FALSE(pool.Touch(&other));
+  SamplingJob job;
+  job.animation = animation.get();
+  job.context = &pooled;
+  job.ratio = 0.f;
+  job.output = output;
+  EXPECT_FALSE(job.Validate());
+  EXPECT_FALSE(job.Run());
+
+  // Touching backs it again, and sampling restarts from a cold context.
+  EXPECT_FALSE(pool.Touch(&pooled));
+  job.ratio = 1.f;
+  ASSERT_TRUE(job.Run());
+  EXPECT_SOAFLOAT3_EQ_EST(output[0].translation, 5.f, 0.f, 0.f, 0.f, 6.f, 0.f,
+                          0.f, 0.f, 7.f, 0.f, 0.f, 0.f);
+
+  pool.Release(&pooled);
+  pool.Release(&other);
+}
+
+TEST(ThreadLocal, SamplingContextPool) {
+  using ozz::animation::AcquireContext;
+  using ozz::animation::DrainContextPool;
+  using ozz::animation::ReleaseContext;
+
+  // Acquired contexts are allocated at power-of-two bucket granularity, so
+  // any capacity in the same bucket reuses the same context.
+  ozz::animation::SamplingJob::Context* context = AcquireContext(40);
+  ASSERT_TRUE(context != nullptr);
+  EXPECT_GE(context->max_tracks(), 40);
+  const int bucket_tracks = context->max_tracks();
+
+  // Releasing then re-acquiring a matching capacity is allocation-free and
+  // returns the very same context, without resizing it.
+  ReleaseContext(context);
+  ozz::animation::SamplingJob::Context* reacquired = AcquireContext(50);
+  EXPECT_EQ(reacquired, context);
+  EXPECT_EQ(reacquired->max_tracks(), bucket_tracks);
+
+  // A bigger request gets a bigger bucket.
+  ozz::animation::SamplingJob::Context* bigger =
+      AcquireContext(bucket_tracks + 1);
+  ASSERT_TRUE(bigger != nullptr);
+  EXPECT_GE(bigger->max_tracks(), bucket_tracks + 1);
+  EXPECT_NE(bigger, reacquired);
+
+  // Oversized requests aren't pooled but still served.
+  ozz::animation::SamplingJob::Context* huge = AcquireContext(100000);
+  ASSERT_TRUE(huge != nullptr);
+  EXPECT_GE(huge->max_tracks(), 100000);
+
+  // Releasing nullptr is a no-op.
+  ReleaseContext(nullptr);
+
+  ReleaseContext(reacquired);
+  ReleaseContext(bigger);
+  ReleaseContext(huge);
+
+  // An acquired context samples like any other.
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(4);
+  AnimationBuilder builder;
+  ozz::unique_ptr<Animation> animation = builder(raw_animation);
+  ASSERT_TRUE(animation);
+
+  context = AcquireContext(animation->num_tracks());
+  ozz::math::SoaTransform output[1];
+  ozz::animation::SamplingJob job;
+  job.animation = animation.get();
+  job.context = context;
+  job.ratio = 0.f;
+  job.output = output;
+  EXPECT_TRUE(job.Run());
+  ReleaseContext(context);
+
+  // Frees pooled contexts, so leak trackers stay quiet.
+  DrainContextPool();
+}
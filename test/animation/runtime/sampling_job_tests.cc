@@ -29,7 +29,10 @@
 #include "ozz/animation/offline/animation_builder.h"
 #include "ozz/animation/offline/raw_animation.h"
 #include "ozz/animation/runtime/animation.h"
+#include "ozz/animation/runtime/animation_utils.h"
 #include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/base/io/archive.h"
+#include "ozz/base/io/stream.h"
 #include "ozz/base/maths/gtest_math_helper.h"
 #include "ozz/base/maths/soa_transform.h"
 #include "ozz/base/memory/unique_ptr.h"
@@ -543,6 +546,113 @@ TEST(Sampling4Track2Keys, SamplingJob) {
                           1.f, 1.f, 1.f, -1.f, 1.f);
 }
 
+TEST(ClassifiedRotations, SamplingJob) {
+  // Verifies rotation track classification and the matching specialized
+  // decompression kernels, see Animation::rotation_classes().
+  AnimationBuilder builder;
+
+  ozz::math::SoaTransform output[1];
+
+  {  // All 4 tracks stay in the +w hemisphere arc: small-arc class.
+    SamplingJob::Context context(1);
+    RawAnimation raw_animation;
+    raw_animation.duration = 1.f;
+    raw_animation.tracks.resize(4);
+    const RawAnimation::RotationKey key0 = {0.f,
+                                            ozz::math::Quaternion::identity()};
+    const RawAnimation::RotationKey key1 = {
+        1.f, ozz::math::Quaternion(0.f, .3420201f, 0.f, .9396926f)};
+    for (size_t i = 0; i < 4; ++i) {
+      raw_animation.tracks[i].rotations.push_back(key0);
+      raw_animation.tracks[i].rotations.push_back(key1);
+    }
+    ozz::unique_ptr<Animation> animation(builder(raw_animation));
+    ASSERT_TRUE(animation);
+    ASSERT_EQ(animation->rotation_classes().size(), 1u);
+    EXPECT_EQ(animation->rotation_classes()[0], 1);  // kQuaternionClassSmallArc
+
+    SamplingJob job;
+    job.animation = animation.get();
+    job.context = &context;
+    job.output = output;
+    job.ratio = 1.f;
+    ASSERT_TRUE(job.Run());
+    EXPECT_SOAQUATERNION_EQ_EST(output[0].rotation, 0.f, 0.f, 0.f, 0.f,
+                                .3420201f, .3420201f, .3420201f, .3420201f, 0.f,
+                                0.f, 0.f, 0.f, .9396926f, .9396926f, .9396926f,
+                                .9396926f);
+  }
+
+  {  // All keys keep x as largest component, with mixed signs: uniform
+     // largest class, the kernel still restores signs.
+    SamplingJob::Context context(1);
+    RawAnimation raw_animation;
+    raw_animation.duration = 1.f;
+    raw_animation.tracks.resize(4);
+    const RawAnimation::RotationKey pos0 = {
+        0.f, ozz::math::Quaternion(.8660254f, 0.f, 0.f, .5f)};
+    const RawAnimation::RotationKey pos1 = {
+        1.f, ozz::math::Quaternion(.9659258f, 0.f, 0.f, .258819f)};
+    const RawAnimation::RotationKey neg0 = {
+        0.f, ozz::math::Quaternion(-.8660254f, 0.f, 0.f, .5f)};
+    const RawAnimation::RotationKey neg1 = {
+        1.f, ozz::math::Quaternion(-.9659258f, 0.f, 0.f, .258819f)};
+    for (size_t i = 0; i < 4; ++i) {
+      raw_animation.tracks[i].rotations.push_back((i & 1) ? neg0 : pos0);
+      raw_animation.tracks[i].rotations.push_back((i & 1) ? neg1 : pos1);
+    }
+    ozz::unique_ptr<Animation> animation(builder(raw_animation));
+    ASSERT_TRUE(animation);
+    ASSERT_EQ(animation->rotation_classes().size(), 1u);
+    EXPECT_EQ(animation->rotation_classes()[0],
+              2);  // kQuaternionClassUniform + 0
+
+    SamplingJob job;
+    job.animation = animation.get();
+    job.context = &context;
+    job.output = output;
+    job.ratio = 0.f;
+    ASSERT_TRUE(job.Run());
+    EXPECT_SOAQUATERNION_EQ_EST(output[0].rotation, .8660254f, -.8660254f,
+                                .8660254f, -.8660254f, 0.f, 0.f, 0.f, 0.f, 0.f,
+                                0.f, 0.f, 0.f, .5f, .5f, .5f, .5f);
+    job.ratio = 1.f;
+    ASSERT_TRUE(job.Run());
+    EXPECT_SOAQUATERNION_EQ_EST(output[0].rotation, .9659258f, -.9659258f,
+                                .9659258f, -.9659258f, 0.f, 0.f, 0.f, 0.f, 0.f,
+                                0.f, 0.f, 0.f, .258819f, .258819f, .258819f,
+                                .258819f);
+  }
+
+  {  // Mixed largest components across the group's tracks: general class.
+    SamplingJob::Context context(1);
+    RawAnimation raw_animation;
+    raw_animation.duration = 1.f;
+    raw_animation.tracks.resize(4);
+    const RawAnimation::RotationKey arc = {
+        0.f, ozz::math::Quaternion(0.f, .3420201f, 0.f, .9396926f)};
+    const RawAnimation::RotationKey axis = {
+        0.f, ozz::math::Quaternion(.8660254f, 0.f, 0.f, .5f)};
+    raw_animation.tracks[0].rotations.push_back(arc);
+    raw_animation.tracks[1].rotations.push_back(axis);
+    ozz::unique_ptr<Animation> animation(builder(raw_animation));
+    ASSERT_TRUE(animation);
+    ASSERT_EQ(animation->rotation_classes().size(), 1u);
+    EXPECT_EQ(animation->rotation_classes()[0],
+              0);  // kQuaternionClassGeneral
+
+    SamplingJob job;
+    job.animation = animation.get();
+    job.context = &context;
+    job.output = output;
+    job.ratio = .5f;
+    ASSERT_TRUE(job.Run());
+    EXPECT_SOAQUATERNION_EQ_EST(output[0].rotation, 0.f, .8660254f, 0.f, 0.f,
+                                .3420201f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f,
+                                .9396926f, .5f, 1.f, 1.f);
+  }
+}
+
 TEST(Cache, SamplingJob) {
   RawAnimation raw_animation;
   raw_animation.duration = 46.f;
@@ -623,6 +733,95 @@ TEST(Cache, SamplingJob) {
                           0.f, 0.f, -5.f, 0.f, 0.f, 0.f);
 }
 
+TEST(ContextMigrate, SamplingJob) {
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(1);  // Adds a joint.
+  raw_animation.tracks[0].translations.resize(2);
+
+  ozz::unique_ptr<Animation> animations[2];
+  {  // Initial animation version.
+    const RawAnimation::TranslationKey tkeys[2] = {
+        {0.f, ozz::math::Float3(1.f, 2.f, 4.f)},
+        {1.f, ozz::math::Float3(2.f, 4.f, 8.f)}};
+    raw_animation.tracks[0].translations[0] = tkeys[0];
+    raw_animation.tracks[0].translations[1] = tkeys[1];
+
+    AnimationBuilder builder;
+    animations[0] = builder(raw_animation);
+    ASSERT_TRUE(animations[0]);
+  }
+  {  // Same key layout, edited values, as produced by live-tuning a clip.
+    const RawAnimation::TranslationKey tkeys[2] = {
+        {0.f, ozz::math::Float3(-1.f, -2.f, -4.f)},
+        {1.f, ozz::math::Float3(-2.f, -4.f, -8.f)}};
+    raw_animation.tracks[0].translations[0] = tkeys[0];
+    raw_animation.tracks[0].translations[1] = tkeys[1];
+
+    AnimationBuilder builder;
+    animations[1] = builder(raw_animation);
+    ASSERT_TRUE(animations[1]);
+  }
+
+  ozz::unique_ptr<Animation> mismatched;
+  {  // Different key layout (a key was added).
+    const RawAnimation::TranslationKey tkey = {.5f,
+                                               ozz::math::Float3(0.f, 0.f, 0.f)};
+    raw_animation.tracks[0].translations.insert(
+        raw_animation.tracks[0].translations.begin() + 1, tkey);
+
+    AnimationBuilder builder;
+    mismatched = builder(raw_animation);
+    ASSERT_TRUE(mismatched);
+  }
+
+  // Migrating an unbound context fails.
+  {
+    SamplingJob::Context context(1);
+    EXPECT_FALSE(context.Migrate(*animations[1]));
+  }
+
+  SamplingJob::Context context(1);
+  ozz::math::SoaTransform output[1];
+
+  SamplingJob job;
+  job.animation = animations[0].get();
+  job.context = &context;
+  job.ratio = .5f;
+  job.output = output;
+
+  ASSERT_TRUE(job.Run());
+  EXPECT_SOAFLOAT3_EQ_EST(output[0].translation, 1.5f, 0.f, 0.f, 0.f, 3.f, 0.f,
+                          0.f, 0.f, 6.f, 0.f, 0.f, 0.f);
+  EXPECT_EQ(context.animation(), animations[0].get());
+
+  // Migrating to the animation the context is already bound to is a no-op.
+  EXPECT_TRUE(context.Migrate(*animations[0]));
+  EXPECT_EQ(context.animation(), animations[0].get());
+
+  // Migrates to the new version. Cursors survive, only decompressed values
+  // are refreshed: the next run at the same ratio doesn't reset cursors.
+  const size_t resets = context.statistics().cursor_resets;
+  EXPECT_TRUE(context.Migrate(*animations[1]));
+  EXPECT_EQ(context.animation(), animations[1].get());
+
+  job.animation = animations[1].get();
+  ASSERT_TRUE(job.Run());
+  EXPECT_SOAFLOAT3_EQ_EST(output[0].translation, -1.5f, 0.f, 0.f, 0.f, -3.f,
+                          0.f, 0.f, 0.f, -6.f, 0.f, 0.f, 0.f);
+  EXPECT_EQ(context.statistics().cursor_resets, resets);
+
+  // Migrating to a different key layout falls back to invalidation.
+  EXPECT_FALSE(context.Migrate(*mismatched));
+  EXPECT_EQ(context.animation(), nullptr);
+
+  // The invalidated context remains usable, at cold restart cost.
+  job.animation = mismatched.get();
+  ASSERT_TRUE(job.Run());
+  EXPECT_SOAFLOAT3_EQ_EST(output[0].translation, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f,
+                          0.f, 0.f, 0.f, 0.f, 0.f, 0.f);
+}
+
 TEST(CacheResize, SamplingJob) {
   RawAnimation raw_animation;
   raw_animation.duration = 46.f;
@@ -655,3 +854,736 @@ TEST(CacheResize, SamplingJob) {
   context.Resize(1);
   EXPECT_FALSE(job.Validate());
 }
+
+TEST(JobValidity, SamplingBatchJob) {
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(1);
+
+  AnimationBuilder builder;
+  ozz::unique_ptr<Animation> animation(builder(raw_animation));
+  ASSERT_TRUE(animation);
+
+  ozz::animation::SamplingJob::Context contexts[2];
+  contexts[0].Resize(1);
+  contexts[1].Resize(1);
+  ozz::animation::SamplingJob::Context* context_ptrs[2] = {&contexts[0],
+                                                           &contexts[1]};
+  const Animation* animations[2] = {animation.get(), animation.get()};
+  const float ratios[2] = {0.f, 1.f};
+  ozz::math::SoaTransform output[2];
+  const ozz::span<ozz::math::SoaTransform> outputs[2] = {
+      {output, 1}, {output + 1, 1}};
+
+  {  // Empty/default job is valid, it just has nothing to do.
+    ozz::animation::SamplingBatchJob job;
+    EXPECT_TRUE(job.Validate());
+    EXPECT_TRUE(job.Run());
+  }
+
+  {  // Mismatching range sizes.
+    ozz::animation::SamplingBatchJob job;
+    job.ratios = {ratios, 1};
+    job.animations = animations;
+    job.contexts = context_ptrs;
+    job.outputs = outputs;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // Invalid animation pointer.
+    const Animation* invalid_animations[2] = {animation.get(), nullptr};
+    ozz::animation::SamplingBatchJob job;
+    job.ratios = ratios;
+    job.animations = invalid_animations;
+    job.contexts = context_ptrs;
+    job.outputs = outputs;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // Invalid context size.
+    ozz::animation::SamplingJob::Context zero_context(0);
+    ozz::animation::SamplingJob::Context* invalid_contexts[2] = {&contexts[0],
+                                                                 &zero_context};
+    ozz::animation::SamplingBatchJob job;
+    job.ratios = ratios;
+    job.animations = animations;
+    job.contexts = invalid_contexts;
+    job.outputs = outputs;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // Valid job.
+    ozz::animation::SamplingBatchJob job;
+    job.ratios = ratios;
+    job.animations = animations;
+    job.contexts = context_ptrs;
+    job.outputs = outputs;
+    EXPECT_TRUE(job.Validate());
+    EXPECT_TRUE(job.Run());
+  }
+}
+
+TEST(Batch, SamplingBatchJob) {
+  // Building an animation with a single track.
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(1);
+  const RawAnimation::TranslationKey first = {0.f,
+                                              ozz::math::Float3(1.f, 2.f, 4.f)};
+  raw_animation.tracks[0].translations.push_back(first);
+  const RawAnimation::TranslationKey last = {1.f,
+                                             ozz::math::Float3(2.f, 4.f, 8.f)};
+  raw_animation.tracks[0].translations.push_back(last);
+
+  AnimationBuilder builder;
+  ozz::unique_ptr<Animation> animation(builder(raw_animation));
+  ASSERT_TRUE(animation);
+
+  // Each batch entry samples the same animation at a different ratio, with its
+  // own context and output.
+  ozz::animation::SamplingJob::Context contexts[3];
+  contexts[0].Resize(1);
+  contexts[1].Resize(1);
+  contexts[2].Resize(1);
+  ozz::animation::SamplingJob::Context* context_ptrs[3] = {
+      &contexts[0], &contexts[1], &contexts[2]};
+  const Animation* animations[3] = {animation.get(), animation.get(),
+                                    animation.get()};
+  const float ratios[3] = {0.f, .5f, 1.f};
+  ozz::math::SoaTransform output[3];
+  const ozz::span<ozz::math::SoaTransform> outputs[3] = {
+      {output, 1}, {output + 1, 1}, {output + 2, 1}};
+
+  ozz::animation::SamplingBatchJob job;
+  job.ratios = ratios;
+  job.animations = animations;
+  job.contexts = context_ptrs;
+  job.outputs = outputs;
+  EXPECT_TRUE(job.Validate());
+  EXPECT_TRUE(job.Run());
+
+  EXPECT_SOAFLOAT3_EQ_EST(output[0].translation, 1.f, 0.f, 0.f, 0.f, 2.f, 0.f,
+                          0.f, 0.f, 4.f, 0.f, 0.f, 0.f);
+  EXPECT_SOAFLOAT3_EQ_EST(output[1].translation, 1.5f, 0.f, 0.f, 0.f, 3.f, 0.f,
+                          0.f, 0.f, 6.f, 0.f, 0.f, 0.f);
+  EXPECT_SOAFLOAT3_EQ_EST(output[2].translation, 2.f, 0.f, 0.f, 0.f, 4.f, 0.f,
+                          0.f, 0.f, 8.f, 0.f, 0.f, 0.f);
+}
+
+TEST(ContextCopyFrom, SamplingJob) {
+  // Building an animation with a single animated track.
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(1);
+  const RawAnimation::TranslationKey first = {0.f,
+                                              ozz::math::Float3(1.f, 2.f, 4.f)};
+  raw_animation.tracks[0].translations.push_back(first);
+  const RawAnimation::TranslationKey middle = {.5f,
+                                               ozz::math::Float3(0.f, 0.f, 0.f)};
+  raw_animation.tracks[0].translations.push_back(middle);
+  const RawAnimation::TranslationKey last = {1.f,
+                                             ozz::math::Float3(2.f, 4.f, 8.f)};
+  raw_animation.tracks[0].translations.push_back(last);
+
+  AnimationBuilder builder;
+  ozz::unique_ptr<Animation> animation(builder(raw_animation));
+  ASSERT_TRUE(animation);
+
+  // Samples a master context at a given ratio.
+  SamplingJob::Context master(1);
+  ozz::math::SoaTransform master_output[1];
+  SamplingJob job;
+  job.animation = animation.get();
+  job.context = &master;
+  job.ratio = .6f;
+  job.output = master_output;
+  ASSERT_TRUE(job.Run());
+
+  // Clones the master context, including resizing from an empty context.
+  SamplingJob::Context clone;
+  clone.CopyFrom(master);
+  EXPECT_EQ(clone.max_soa_tracks(), master.max_soa_tracks());
+
+  // Samples from the cloned context at a nearby ratio.
+  ozz::math::SoaTransform clone_output[1];
+  job.context = &clone;
+  job.ratio = .65f;
+  job.output = clone_output;
+  ASSERT_TRUE(job.Run());
+
+  // A fresh context sampled at the same ratio must produce the same pose.
+  SamplingJob::Context fresh(1);
+  ozz::math::SoaTransform fresh_output[1];
+  job.context = &fresh;
+  job.output = fresh_output;
+  ASSERT_TRUE(job.Run());
+
+  EXPECT_SOAFLOAT3_EQ_EST(
+      clone_output[0].translation, ozz::math::GetX(fresh_output[0].translation.x),
+      0.f, 0.f, 0.f, ozz::math::GetX(fresh_output[0].translation.y), 0.f, 0.f,
+      0.f, ozz::math::GetX(fresh_output[0].translation.z), 0.f, 0.f, 0.f);
+}
+
+TEST(ContextArchive, SamplingJob) {
+  // Building an animation with a single animated track.
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(1);
+  const RawAnimation::TranslationKey first = {0.f,
+                                              ozz::math::Float3(1.f, 2.f, 4.f)};
+  raw_animation.tracks[0].translations.push_back(first);
+  const RawAnimation::TranslationKey middle = {.5f,
+                                               ozz::math::Float3(0.f, 0.f, 0.f)};
+  raw_animation.tracks[0].translations.push_back(middle);
+  const RawAnimation::TranslationKey last = {1.f,
+                                             ozz::math::Float3(2.f, 4.f, 8.f)};
+  raw_animation.tracks[0].translations.push_back(last);
+
+  AnimationBuilder builder;
+  ozz::unique_ptr<Animation> animation(builder(raw_animation));
+  ASSERT_TRUE(animation);
+
+  // Warms a context: samples the animation at the wanted start ratio.
+  SamplingJob::Context warmed(1);
+  ozz::math::SoaTransform warmed_output[1];
+  SamplingJob job;
+  job.animation = animation.get();
+  job.context = &warmed;
+  job.ratio = .6f;
+  job.output = warmed_output;
+  ASSERT_TRUE(job.Run());
+
+  // Serializes the warmed snapshot.
+  ozz::io::MemoryStream stream;
+  {
+    ozz::io::OArchive o(&stream);
+    o << warmed;
+  }
+
+  {  // Loads the snapshot and binds it to its animation.
+    stream.Seek(0, ozz::io::Stream::kSet);
+    ozz::io::IArchive i(&stream);
+    SamplingJob::Context loaded;
+    i >> loaded;
+    EXPECT_EQ(loaded.max_soa_tracks(), warmed.max_soa_tracks());
+    EXPECT_TRUE(loaded.Bind(*animation));
+
+    // First run at the snapshot's ratio costs the same as a steady-state
+    // one: no cursor reset, no decompression.
+    ozz::math::SoaTransform loaded_output[1];
+    job.context = &loaded;
+    job.output = loaded_output;
+    ASSERT_TRUE(job.Run());
+    EXPECT_EQ(loaded.statistics().cursor_resets, 0u);
+    EXPECT_EQ(loaded.statistics().entries_decompressed, 0u);
+
+    // Sampled pose matches the one the snapshot was warmed with.
+    EXPECT_SOAFLOAT3_EQ_EST(loaded_output[0].translation,
+                            ozz::math::GetX(warmed_output[0].translation.x),
+                            0.f, 0.f, 0.f,
+                            ozz::math::GetX(warmed_output[0].translation.y),
+                            0.f, 0.f, 0.f,
+                            ozz::math::GetX(warmed_output[0].translation.z),
+                            0.f, 0.f, 0.f);
+  }
+
+  {  // Binding a snapshot to a different animation fails.
+    RawAnimation mismatched_raw = raw_animation;
+    mismatched_raw.duration = 2.f;
+    ozz::unique_ptr<Animation> mismatched(builder(mismatched_raw));
+    ASSERT_TRUE(mismatched);
+
+    stream.Seek(0, ozz::io::Stream::kSet);
+    ozz::io::IArchive i(&stream);
+    SamplingJob::Context loaded;
+    i >> loaded;
+    EXPECT_FALSE(loaded.Bind(*mismatched));
+
+    // Binding is one shot, a failed bind invalidates the snapshot.
+    EXPECT_FALSE(loaded.Bind(*animation));
+  }
+}
+
+TEST(JointMask, SamplingJob) {
+  // Building an animation with 5 tracks (2 soa blocks).
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(5);
+  for (size_t i = 0; i < 5; ++i) {
+    const RawAnimation::TranslationKey first = {
+        0.f, ozz::math::Float3(static_cast<float>(i), 0.f, 0.f)};
+    raw_animation.tracks[i].translations.push_back(first);
+    const RawAnimation::TranslationKey last = {
+        1.f, ozz::math::Float3(static_cast<float>(i) + 1.f, 0.f, 0.f)};
+    raw_animation.tracks[i].translations.push_back(last);
+  }
+
+  AnimationBuilder builder;
+  ozz::unique_ptr<Animation> animation(builder(raw_animation));
+  ASSERT_TRUE(animation);
+
+  SamplingJob::Context context(5);
+  ozz::math::SoaTransform output[2];
+  output[1].translation = ozz::math::SoaFloat3::Load(
+      ozz::math::simd_float4::Load1(46.f), ozz::math::simd_float4::Load1(46.f),
+      ozz::math::simd_float4::Load1(46.f));
+
+  SamplingJob job;
+  job.animation = animation.get();
+  job.context = &context;
+  job.ratio = .5f;
+  job.output = output;
+
+  {  // Too small mask fails validation, mask needs 1 bit per soa track.
+    const ozz::byte mask[1] = {0};
+    job.joint_mask = ozz::span<const ozz::byte>(mask, size_t(0));
+    EXPECT_TRUE(job.Validate());  // Empty mask means no mask.
+  }
+
+  {  // Masks out the 2nd soa block, which must be left unchanged.
+    const ozz::byte mask[1] = {1};  // Soa track 0 only.
+    job.joint_mask = mask;
+    EXPECT_TRUE(job.Validate());
+    EXPECT_TRUE(job.Run());
+    EXPECT_SOAFLOAT3_EQ_EST(output[0].translation, .5f, 1.5f, 2.5f, 3.5f, 0.f,
+                            0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f);
+    EXPECT_SOAFLOAT3_EQ_EST(output[1].translation, 46.f, 46.f, 46.f, 46.f, 46.f,
+                            46.f, 46.f, 46.f, 46.f, 46.f, 46.f, 46.f);
+  }
+
+  {  // Unmasking the 2nd block decompresses and samples it, even though the
+     // cursor hasn't moved.
+    const ozz::byte mask[1] = {3};  // Both soa tracks.
+    job.joint_mask = mask;
+    EXPECT_TRUE(job.Validate());
+    EXPECT_TRUE(job.Run());
+    EXPECT_SOAFLOAT3_EQ_EST(output[0].translation, .5f, 1.5f, 2.5f, 3.5f, 0.f,
+                            0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f);
+    EXPECT_SOAFLOAT3_EQ_EST(output[1].translation, 4.5f, 0.f, 0.f, 0.f, 0.f,
+                            0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f);
+  }
+}
+
+TEST(Components, SamplingJob) {
+  // Builds an animation animating all components of a single track.
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(1);
+  const RawAnimation::TranslationKey tkeys[2] = {
+      {0.f, ozz::math::Float3(1.f, 2.f, 4.f)},
+      {1.f, ozz::math::Float3(2.f, 4.f, 8.f)}};
+  raw_animation.tracks[0].translations.push_back(tkeys[0]);
+  raw_animation.tracks[0].translations.push_back(tkeys[1]);
+  const RawAnimation::RotationKey rkeys[2] = {
+      {0.f, ozz::math::Quaternion::identity()},
+      {1.f, ozz::math::Quaternion(0.f, .70710677f, 0.f, .70710677f)}};
+  raw_animation.tracks[0].rotations.push_back(rkeys[0]);
+  raw_animation.tracks[0].rotations.push_back(rkeys[1]);
+  const RawAnimation::ScaleKey skeys[2] = {
+      {0.f, ozz::math::Float3(1.f, 1.f, 1.f)},
+      {1.f, ozz::math::Float3(3.f, 3.f, 3.f)}};
+  raw_animation.tracks[0].scales.push_back(skeys[0]);
+  raw_animation.tracks[0].scales.push_back(skeys[1]);
+
+  AnimationBuilder builder;
+  ozz::unique_ptr<Animation> animation(builder(raw_animation));
+  ASSERT_TRUE(animation);
+
+  SamplingJob::Context context(1);
+  ozz::math::SoaTransform output[1];
+
+  SamplingJob job;
+  job.animation = animation.get();
+  job.context = &context;
+  job.ratio = .5f;
+  job.output = output;
+
+  {  // Selecting no component fails validation.
+    job.components = 0;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+    job.components = SamplingJob::kAllComponents;
+  }
+
+  {  // Rotation only sampling leaves translations and scales untouched.
+    output[0] = ozz::math::SoaTransform::identity();
+    job.components = SamplingJob::kRotations;
+    EXPECT_TRUE(job.Validate());
+    EXPECT_TRUE(job.Run());
+    EXPECT_SOAQUATERNION_EQ_EST(output[0].rotation, 0.f, 0.f, 0.f, 0.f,
+                                .38268346f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f,
+                                .92387956f, 1.f, 1.f, 1.f);
+    EXPECT_SOAFLOAT3_EQ_EST(output[0].translation, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f,
+                            0.f, 0.f, 0.f, 0.f, 0.f, 0.f);
+    EXPECT_SOAFLOAT3_EQ_EST(output[0].scale, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f,
+                            1.f, 1.f, 1.f, 1.f, 1.f);
+  }
+
+  {  // Translation and scale cursors catch up once selected again, even
+     // though they didn't advance during the rotation only runs.
+    job.components = SamplingJob::kRotations;
+    job.ratio = .9f;
+    EXPECT_TRUE(job.Run());
+    job.components = SamplingJob::kAllComponents;
+    EXPECT_TRUE(job.Run());
+    EXPECT_SOAFLOAT3_EQ_EST(output[0].translation, 1.9f, 0.f, 0.f, 0.f, 3.8f,
+                            0.f, 0.f, 0.f, 7.6f, 0.f, 0.f, 0.f);
+    EXPECT_SOAFLOAT3_EQ_EST(output[0].scale, 2.8f, 1.f, 1.f, 1.f, 2.8f, 1.f,
+                            1.f, 1.f, 2.8f, 1.f, 1.f, 1.f);
+  }
+
+  {  // Translation and scale only, rotations are preserved this time.
+    output[0].rotation = ozz::math::SoaQuaternion::identity();
+    job.components = SamplingJob::kTranslations | SamplingJob::kScales;
+    job.ratio = .5f;
+    EXPECT_TRUE(job.Run());
+    EXPECT_SOAFLOAT3_EQ_EST(output[0].translation, 1.5f, 0.f, 0.f, 0.f, 3.f,
+                            0.f, 0.f, 0.f, 6.f, 0.f, 0.f, 0.f);
+    EXPECT_SOAFLOAT3_EQ_EST(output[0].scale, 2.f, 1.f, 1.f, 1.f, 2.f, 1.f, 1.f,
+                            1.f, 2.f, 1.f, 1.f, 1.f);
+    EXPECT_SOAQUATERNION_EQ_EST(output[0].rotation, 0.f, 0.f, 0.f, 0.f, 0.f,
+                                0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 1.f, 1.f,
+                                1.f, 1.f);
+  }
+}
+
+TEST(ContextExternalBuffer, SamplingJob) {
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(1);
+  const RawAnimation::TranslationKey first = {0.f,
+                                              ozz::math::Float3(1.f, 2.f, 4.f)};
+  raw_animation.tracks[0].translations.push_back(first);
+  const RawAnimation::TranslationKey last = {1.f,
+                                             ozz::math::Float3(2.f, 4.f, 8.f)};
+  raw_animation.tracks[0].translations.push_back(last);
+
+  AnimationBuilder builder;
+  ozz::unique_ptr<Animation> animation(builder(raw_animation));
+  ASSERT_TRUE(animation);
+
+  // Builds a context backed by a caller-provided buffer.
+  const size_t size = SamplingJob::Context::RequiredSize(1);
+  alignas(16) ozz::byte buffer[1024];
+  ASSERT_LE(size, sizeof(buffer));
+
+  SamplingJob::Context context;
+  context.Resize(1, {buffer, size});
+  EXPECT_EQ(context.max_tracks(), 4);
+
+  ozz::math::SoaTransform output[1];
+  SamplingJob job;
+  job.animation = animation.get();
+  job.context = &context;
+  job.ratio = .5f;
+  job.output = output;
+  EXPECT_TRUE(job.Validate());
+  EXPECT_TRUE(job.Run());
+  EXPECT_SOAFLOAT3_EQ_EST(output[0].translation, 1.5f, 0.f, 0.f, 0.f, 3.f, 0.f,
+                          0.f, 0.f, 6.f, 0.f, 0.f, 0.f);
+
+  // Resizing back to an allocated buffer doesn't deallocate the external one.
+  context.Resize(1);
+  EXPECT_TRUE(job.Run());
+}
+
+TEST(Crossfade, CrossfadeSamplingJob) {
+  using ozz::animation::CrossfadeSamplingJob;
+
+  AnimationBuilder builder;
+
+  // Builds "from" animation, translating from (1,2,4) to (2,4,8).
+  RawAnimation from_raw;
+  from_raw.duration = 1.f;
+  from_raw.tracks.resize(1);
+  const RawAnimation::TranslationKey from_first = {
+      0.f, ozz::math::Float3(1.f, 2.f, 4.f)};
+  from_raw.tracks[0].translations.push_back(from_first);
+  const RawAnimation::TranslationKey from_last = {
+      1.f, ozz::math::Float3(2.f, 4.f, 8.f)};
+  from_raw.tracks[0].translations.push_back(from_last);
+  ozz::unique_ptr<Animation> from_animation(builder(from_raw));
+  ASSERT_TRUE(from_animation);
+
+  // Builds "to" animation, with a constant translation.
+  RawAnimation to_raw;
+  to_raw.duration = 1.f;
+  to_raw.tracks.resize(1);
+  const RawAnimation::TranslationKey to_key = {
+      0.f, ozz::math::Float3(10.f, 20.f, 40.f)};
+  to_raw.tracks[0].translations.push_back(to_key);
+  ozz::unique_ptr<Animation> to_animation(builder(to_raw));
+  ASSERT_TRUE(to_animation);
+
+  SamplingJob::Context from_context(1);
+  SamplingJob::Context to_context(1);
+  ozz::math::SoaTransform output[1];
+
+  CrossfadeSamplingJob job;
+  job.from.ratio = .5f;  // Samples (1.5, 3, 6).
+  job.from.animation = from_animation.get();
+  job.from.context = &from_context;
+  job.to.ratio = 0.f;
+  job.to.animation = to_animation.get();
+  job.to.context = &to_context;
+  job.output = output;
+
+  {  // Invalid job, missing context.
+    CrossfadeSamplingJob invalid = job;
+    invalid.to.context = nullptr;
+    EXPECT_FALSE(invalid.Validate());
+    EXPECT_FALSE(invalid.Run());
+  }
+
+  {  // Fully weights "from" clip.
+    job.blend_ratio = 0.f;
+    ASSERT_TRUE(job.Validate());
+    ASSERT_TRUE(job.Run());
+    EXPECT_SOAFLOAT3_EQ_EST(output[0].translation, 1.5f, 0.f, 0.f, 0.f, 3.f,
+                            0.f, 0.f, 0.f, 6.f, 0.f, 0.f, 0.f);
+  }
+
+  {  // Fully weights "to" clip.
+    job.blend_ratio = 1.f;
+    ASSERT_TRUE(job.Run());
+    EXPECT_SOAFLOAT3_EQ_EST(output[0].translation, 10.f, 0.f, 0.f, 0.f, 20.f,
+                            0.f, 0.f, 0.f, 40.f, 0.f, 0.f, 0.f);
+  }
+
+  {  // Half way crossfade.
+    job.blend_ratio = .5f;
+    ASSERT_TRUE(job.Run());
+    EXPECT_SOAFLOAT3_EQ_EST(output[0].translation, 5.75f, 0.f, 0.f, 0.f, 11.5f,
+                            0.f, 0.f, 0.f, 23.f, 0.f, 0.f, 0.f);
+    EXPECT_SOAQUATERNION_EQ_EST(output[0].rotation, 0.f, 0.f, 0.f, 0.f, 0.f,
+                                0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 1.f, 1.f,
+                                1.f, 1.f);
+    EXPECT_SOAFLOAT3_EQ_EST(output[0].scale, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f,
+                            1.f, 1.f, 1.f, 1.f, 1.f);
+  }
+}
+
+TEST(Deterministic, SamplingJob) {
+  // Builds an animation with interpolated translations and rotations, so the
+  // deterministic kernels (decompression and interpolation) are all
+  // exercised.
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(2);
+
+  const RawAnimation::TranslationKey t0 = {0.f,
+                                           ozz::math::Float3(2.f, 4.f, 6.f)};
+  raw_animation.tracks[0].translations.push_back(t0);
+  const RawAnimation::TranslationKey t1 = {1.f,
+                                           ozz::math::Float3(6.f, 4.f, 2.f)};
+  raw_animation.tracks[0].translations.push_back(t1);
+
+  const RawAnimation::RotationKey r0 = {0.f,
+                                        ozz::math::Quaternion::identity()};
+  raw_animation.tracks[1].rotations.push_back(r0);
+  const RawAnimation::RotationKey r1 = {
+      1.f, ozz::math::Quaternion(0.f, .70710677f, 0.f, .70710677f)};
+  raw_animation.tracks[1].rotations.push_back(r1);
+
+  AnimationBuilder builder;
+  ozz::unique_ptr<Animation> animation(builder(raw_animation));
+  ASSERT_TRUE(animation);
+
+  // Samples with deterministic kernels, accumulating time with the
+  // fixed-point ratio helpers, as a lockstep simulation would.
+  SamplingJob::Context context(animation->num_tracks());
+  ozz::math::SoaTransform output[1];
+  SamplingJob job;
+  job.animation = animation.get();
+  job.context = &context;
+  job.output = output;
+  job.deterministic = true;
+
+  // References with default (estimated) kernels.
+  SamplingJob::Context ref_context(animation->num_tracks());
+  ozz::math::SoaTransform ref_output[1];
+  SamplingJob ref_job;
+  ref_job.animation = animation.get();
+  ref_job.context = &ref_context;
+  ref_job.output = ref_output;
+
+  const int delta = ozz::animation::kFixedRatioOne / 10;
+  for (uint32_t fixed = 0; fixed <= ozz::animation::kFixedRatioOne;
+       fixed = ozz::animation::StepFixedRatio(fixed, delta, false)) {
+    ref_job.ratio = job.ratio = ozz::animation::FixedRatioToFloat(fixed);
+    ASSERT_TRUE(job.Run());
+    ASSERT_TRUE(ref_job.Run());
+
+    // Deterministic kernels remain within the estimated kernels tolerance.
+    float det[40], est[40];
+    static_assert(sizeof(det) == sizeof(output), "Unexpected SoA size");
+    memcpy(det, output, sizeof(det));
+    memcpy(est, ref_output, sizeof(est));
+    for (size_t i = 0; i < OZZ_ARRAY_SIZE(det); ++i) {
+      EXPECT_NEAR(det[i], est[i], kFloatNearEstTolerance);
+    }
+
+    if (fixed == ozz::animation::kFixedRatioOne) {
+      break;  // StepFixedRatio saturates, exits after the last ratio.
+    }
+  }
+
+  // Deterministic sampling doesn't depend on context history: a fresh context
+  // jumping straight to the last ratio produces the exact same bits as the
+  // stepped one.
+  SamplingJob::Context fresh_context(animation->num_tracks());
+  ozz::math::SoaTransform fresh_output[1];
+  job.context = &fresh_context;
+  job.output = fresh_output;
+  ASSERT_TRUE(job.Run());
+  EXPECT_TRUE(memcmp(fresh_output, output, sizeof(output)) == 0);
+}
+
+TEST(Statistics, SamplingJob) {
+  // Builds an animation with enough keyframes for the cursor to move, sampled
+  // at various ratios to exercise every cursor path.
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(1);
+  for (int i = 0; i < 6; ++i) {
+    const RawAnimation::TranslationKey key = {
+        i / 5.f, ozz::math::Float3(1.f + i, 0.f, 0.f)};
+    raw_animation.tracks[0].translations.push_back(key);
+  }
+
+  AnimationBuilder builder;
+  ozz::unique_ptr<Animation> animation(builder(raw_animation));
+  ASSERT_TRUE(animation);
+
+  SamplingJob::Context context(animation->num_tracks());
+  ozz::math::SoaTransform output[1];
+  SamplingJob job;
+  job.animation = animation.get();
+  job.context = &context;
+  job.output = output;
+
+  {  // A fresh context counts nothing.
+    const SamplingJob::Context::Statistics& statistics = context.statistics();
+    EXPECT_EQ(statistics.cursor_resets, 0u);
+    EXPECT_EQ(statistics.keys_advanced, 0u);
+    EXPECT_EQ(statistics.keys_rewound, 0u);
+    EXPECT_EQ(statistics.entries_decompressed, 0u);
+  }
+
+  {  // First run resets the 3 component cursors and decompresses all
+     // entries.
+    job.ratio = 0.f;
+    ASSERT_TRUE(job.Run());
+    const SamplingJob::Context::Statistics& statistics = context.statistics();
+    EXPECT_EQ(statistics.cursor_resets, 3u);
+    EXPECT_EQ(statistics.entries_decompressed, 3u);
+    EXPECT_EQ(statistics.keys_rewound, 0u);
+  }
+
+  {  // Coherent forward sampling doesn't reset and advances keys as the
+     // cursor crosses them.
+    const size_t resets = context.statistics().cursor_resets;
+    job.ratio = .4f;
+    ASSERT_TRUE(job.Run());
+    job.ratio = .45f;
+    ASSERT_TRUE(job.Run());
+    EXPECT_EQ(context.statistics().cursor_resets, resets);
+  }
+
+  {  // A short rewind steps keys backward rather than resetting.
+    job.ratio = 1.f;
+    ASSERT_TRUE(job.Run());
+    const size_t resets = context.statistics().cursor_resets;
+    job.ratio = .7f;
+    ASSERT_TRUE(job.Run());
+    EXPECT_EQ(context.statistics().cursor_resets, resets);
+    EXPECT_GT(context.statistics().keys_rewound, 0u);
+  }
+
+  {  // Switching animations invalidates the context, hence resets cursors.
+    ozz::unique_ptr<Animation> other(builder(raw_animation));
+    ASSERT_TRUE(other);
+    const size_t resets = context.statistics().cursor_resets;
+    job.animation = other.get();
+    job.ratio = .5f;
+    ASSERT_TRUE(job.Run());
+    EXPECT_EQ(context.statistics().cursor_resets, resets + 3u);
+    job.animation = animation.get();
+  }
+
+  {  // Statistics can be cleared once reported.
+    context.ResetStatistics();
+    const SamplingJob::Context::Statistics& statistics = context.statistics();
+    EXPECT_EQ(statistics.cursor_resets, 0u);
+    EXPECT_EQ(statistics.keys_advanced, 0u);
+    EXPECT_EQ(statistics.keys_rewound, 0u);
+    EXPECT_EQ(statistics.entries_decompressed, 0u);
+  }
+}
+
+TEST(BackwardPlayback, SamplingJob) {
+  // Backward playback (rewind, tape-style replay) must be cost-symmetric with
+  // forward playback: the cursor steps keys backward through previous-key
+  // back-links, it doesn't re-seek from the beginning at each step.
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(2);
+  for (size_t t = 0; t < raw_animation.tracks.size(); ++t) {
+    for (int i = 0; i < 50; ++i) {
+      const RawAnimation::TranslationKey key = {
+          i / 49.f, ozz::math::Float3(1.f * i, 1.f * t, 0.f)};
+      raw_animation.tracks[t].translations.push_back(key);
+    }
+  }
+
+  AnimationBuilder builder;
+  ozz::unique_ptr<Animation> animation(builder(raw_animation));
+  ASSERT_TRUE(animation);
+
+  SamplingJob::Context context(animation->num_tracks());
+  ozz::math::SoaTransform output[1];
+  SamplingJob job;
+  job.animation = animation.get();
+  job.context = &context;
+  job.output = output;
+
+  // Scrubs forward, using ratios that don't land on keyframe times. Avoids
+  // ratio 0, as seeking toward the very beginning legitimately resets.
+  const float kBegin = .06f, kEnd = .98f;
+  const int kSteps = 30;
+  job.ratio = kBegin;
+  ASSERT_TRUE(job.Run());
+  context.ResetStatistics();
+  for (int i = 1; i <= kSteps; ++i) {
+    job.ratio = kBegin + (kEnd - kBegin) * i / kSteps;
+    ASSERT_TRUE(job.Run());
+  }
+  const size_t advanced = context.statistics().keys_advanced;
+  EXPECT_GT(advanced, 0u);
+  EXPECT_EQ(context.statistics().cursor_resets, 0u);
+  EXPECT_EQ(context.statistics().keys_rewound, 0u);
+
+  // Scrubs backward along the same ratios. The cursor returns to its kBegin
+  // state, rewinding exactly the keys the forward scrub advanced, without any
+  // reset.
+  context.ResetStatistics();
+  for (int i = kSteps - 1; i >= 0; --i) {
+    job.ratio = kBegin + (kEnd - kBegin) * i / kSteps;
+    ASSERT_TRUE(job.Run());
+
+    // Backward sampled values match a fresh context's, bit for bit.
+    SamplingJob::Context fresh_context(animation->num_tracks());
+    ozz::math::SoaTransform fresh_output[1];
+    SamplingJob fresh_job = job;
+    fresh_job.context = &fresh_context;
+    fresh_job.output = fresh_output;
+    ASSERT_TRUE(fresh_job.Run());
+    EXPECT_TRUE(memcmp(fresh_output, output, sizeof(output)) == 0);
+  }
+  EXPECT_EQ(context.statistics().cursor_resets, 0u);
+  EXPECT_EQ(context.statistics().keys_advanced, 0u);
+  EXPECT_EQ(context.statistics().keys_rewound, advanced);
+}
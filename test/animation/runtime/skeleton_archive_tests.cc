@@ -25,14 +25,19 @@
 //                                                                            //
 //----------------------------------------------------------------------------//
 
+#include <cstring>
+
 #include "gtest/gtest.h"
 #include "ozz/animation/offline/raw_skeleton.h"
 #include "ozz/animation/offline/skeleton_builder.h"
 #include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/containers/vector.h"
 #include "ozz/base/io/archive.h"
 #include "ozz/base/io/stream.h"
+#include "ozz/base/maths/simd_math.h"
 #include "ozz/base/maths/soa_transform.h"
 #include "ozz/base/memory/unique_ptr.h"
+#include "ozz/base/span.h"
 
 using ozz::animation::Skeleton;
 using ozz::animation::offline::RawSkeleton;
@@ -103,10 +108,18 @@ TEST(Filled, SkeletonSerialize) {
 
     // Compares skeletons.
     EXPECT_EQ(o_skeleton->num_joints(), i_skeleton.num_joints());
+    // Structural hash is recomputed at load time.
+    EXPECT_EQ(o_skeleton->structural_hash(), i_skeleton.structural_hash());
     for (int i = 0; i < i_skeleton.num_joints(); ++i) {
       EXPECT_EQ(i_skeleton.joint_parents()[i], o_skeleton->joint_parents()[i]);
       EXPECT_STREQ(i_skeleton.joint_names()[i], o_skeleton->joint_names()[i]);
     }
+    // Name lookup index is serialized too.
+    for (int i = 0; i < i_skeleton.num_joints(); ++i) {
+      EXPECT_EQ(i_skeleton.FindJoint(i_skeleton.joint_names()[i]), i);
+    }
+    EXPECT_EQ(i_skeleton.FindJoint("unknown"), -1);
+
     for (int i = 0; i < (i_skeleton.num_joints() + 3) / 4; ++i) {
       EXPECT_TRUE(
           ozz::math::AreAllTrue(i_skeleton.joint_rest_poses()[i].translation ==
@@ -118,6 +131,213 @@ TEST(Filled, SkeletonSerialize) {
           ozz::math::AreAllTrue(i_skeleton.joint_rest_poses()[i].scale ==
                                 o_skeleton->joint_rest_poses()[i].scale));
     }
+
+    // Bind pose matrices are serialized too.
+    for (int i = 0; i < i_skeleton.num_joints(); ++i) {
+      EXPECT_TRUE(std::memcmp(&i_skeleton.joint_bind_poses()[i],
+                              &o_skeleton->joint_bind_poses()[i],
+                              sizeof(ozz::math::Float4x4)) == 0);
+      EXPECT_TRUE(std::memcmp(&i_skeleton.joint_inverse_bind_poses()[i],
+                              &o_skeleton->joint_inverse_bind_poses()[i],
+                              sizeof(ozz::math::Float4x4)) == 0);
+    }
+  }
+}
+
+TEST(RawImage, SkeletonSerialize) {
+  ozz::unique_ptr<Skeleton> o_skeleton;
+  /* Builds output skeleton.
+   3 joints
+
+     *
+     |
+    root
+    / \
+   j0 j1
+  */
+  {
+    RawSkeleton raw_skeleton;
+    raw_skeleton.roots.resize(1);
+    RawSkeleton::Joint& root = raw_skeleton.roots[0];
+    root.name = "root";
+
+    root.children.resize(2);
+    root.children[0].name = "j0";
+    root.children[1].name = "j1";
+
+    SkeletonBuilder builder;
+    o_skeleton = builder(raw_skeleton);
+    ASSERT_TRUE(o_skeleton);
+  }
+
+  // Stores the relocatable image to a simd buffer, which guarantees the
+  // 16 bytes alignment a mapped file would also provide.
+  const size_t raw_size = o_skeleton->raw_size();
+  ozz::vector<ozz::math::SimdFloat4> image(
+      (raw_size + sizeof(ozz::math::SimdFloat4) - 1) /
+      sizeof(ozz::math::SimdFloat4));
+  const ozz::span<ozz::byte> image_buffer = {
+      reinterpret_cast<ozz::byte*>(image.data()), raw_size};
+
+  // Too small buffer is rejected.
+  EXPECT_FALSE(o_skeleton->SaveRaw(image_buffer.first(raw_size - 1)));
+  ASSERT_TRUE(o_skeleton->SaveRaw(image_buffer));
+
+  {  // Invalid images are rejected, leaving the skeleton empty.
+    Skeleton i_skeleton;
+    EXPECT_FALSE(i_skeleton.LoadRaw({}));
+    EXPECT_FALSE(i_skeleton.LoadRaw(image_buffer.first(raw_size - 1)));
+    EXPECT_EQ(i_skeleton.num_joints(), 0);
+  }
+
+  Skeleton i_skeleton;
+  ASSERT_TRUE(i_skeleton.LoadRaw(image_buffer));
+
+  // The image is referenced in place, not copied.
+  const ozz::byte* parents =
+      reinterpret_cast<const ozz::byte*>(i_skeleton.joint_parents().data());
+  EXPECT_TRUE(parents >= image_buffer.data() &&
+              parents < image_buffer.data() + raw_size);
+
+  // Compares skeletons.
+  EXPECT_EQ(o_skeleton->num_joints(), i_skeleton.num_joints());
+  EXPECT_EQ(o_skeleton->structural_hash(), i_skeleton.structural_hash());
+  for (int i = 0; i < i_skeleton.num_joints(); ++i) {
+    EXPECT_EQ(i_skeleton.joint_parents()[i], o_skeleton->joint_parents()[i]);
+    EXPECT_STREQ(i_skeleton.joint_names()[i], o_skeleton->joint_names()[i]);
+  }
+
+  // Name lookup index is part of the image.
+  for (int i = 0; i < i_skeleton.num_joints(); ++i) {
+    EXPECT_EQ(i_skeleton.FindJoint(i_skeleton.joint_names()[i]), i);
+  }
+  EXPECT_EQ(i_skeleton.FindJoint("unknown"), -1);
+
+  for (int i = 0; i < (i_skeleton.num_joints() + 3) / 4; ++i) {
+    EXPECT_TRUE(
+        ozz::math::AreAllTrue(i_skeleton.joint_rest_poses()[i].translation ==
+                              o_skeleton->joint_rest_poses()[i].translation));
+    EXPECT_TRUE(
+        ozz::math::AreAllTrue(i_skeleton.joint_rest_poses()[i].rotation ==
+                              o_skeleton->joint_rest_poses()[i].rotation));
+    EXPECT_TRUE(ozz::math::AreAllTrue(i_skeleton.joint_rest_poses()[i].scale ==
+                                      o_skeleton->joint_rest_poses()[i].scale));
+  }
+
+  // Bind pose matrices are part of the image too.
+  for (int i = 0; i < i_skeleton.num_joints(); ++i) {
+    EXPECT_TRUE(std::memcmp(&i_skeleton.joint_bind_poses()[i],
+                            &o_skeleton->joint_bind_poses()[i],
+                            sizeof(ozz::math::Float4x4)) == 0);
+    EXPECT_TRUE(std::memcmp(&i_skeleton.joint_inverse_bind_poses()[i],
+                            &o_skeleton->joint_inverse_bind_poses()[i],
+                            sizeof(ozz::math::Float4x4)) == 0);
+  }
+}
+
+TEST(PlacementLoad, SkeletonSerialize) {
+  ozz::unique_ptr<Skeleton> o_skeleton;
+  /* Builds output skeleton.
+   3 joints
+
+     *
+     |
+    root
+    / \
+   j0 j1
+  */
+  {
+    RawSkeleton raw_skeleton;
+    raw_skeleton.roots.resize(1);
+    RawSkeleton::Joint& root = raw_skeleton.roots[0];
+    root.name = "root";
+
+    root.children.resize(2);
+    root.children[0].name = "j0";
+    root.children[1].name = "j1";
+
+    SkeletonBuilder builder;
+    o_skeleton = builder(raw_skeleton);
+    ASSERT_TRUE(o_skeleton);
+  }
+
+  ozz::io::MemoryStream stream;
+  {
+    ozz::io::OArchive o(&stream);
+    o << *o_skeleton;
+  }
+
+  stream.Seek(0, ozz::io::Stream::kSet);
+  ozz::io::IArchive ia(&stream);
+
+  // SizeOf probes the archive without moving the read position, probing
+  // twice reports the same size.
+  const size_t size = Skeleton::SizeOf(ia);
+  ASSERT_GT(size, 0u);
+  EXPECT_EQ(Skeleton::SizeOf(ia), size);
+
+  // A simd buffer guarantees the required 16 bytes alignment.
+  ozz::vector<ozz::math::SimdFloat4> buffer(
+      (size + sizeof(ozz::math::SimdFloat4) - 1) /
+          sizeof(ozz::math::SimdFloat4) +
+      1);
+  const ozz::span<ozz::byte> bytes = {
+      reinterpret_cast<ozz::byte*>(buffer.data()), size + 4};
+
+  {  // Too small and misaligned buffers are rejected, leaving the archive
+     // read position untouched.
+    Skeleton i_skeleton;
+    EXPECT_FALSE(i_skeleton.Load(ia, bytes.first(size - 1)));
+    EXPECT_FALSE(i_skeleton.Load(ia, bytes.subspan(4, size)));
+    EXPECT_EQ(i_skeleton.num_joints(), 0);
+    EXPECT_EQ(Skeleton::SizeOf(ia), size);
+  }
+
+  Skeleton i_skeleton;
+  ASSERT_TRUE(i_skeleton.Load(ia, bytes.first(size)));
+
+  // The skeleton data block lives in the caller-provided buffer.
+  const ozz::byte* parents =
+      reinterpret_cast<const ozz::byte*>(i_skeleton.joint_parents().data());
+  EXPECT_TRUE(parents >= bytes.data() && parents < bytes.data() + size);
+
+  // Compares skeletons.
+  EXPECT_EQ(o_skeleton->num_joints(), i_skeleton.num_joints());
+  EXPECT_EQ(o_skeleton->structural_hash(), i_skeleton.structural_hash());
+  for (int i = 0; i < i_skeleton.num_joints(); ++i) {
+    EXPECT_EQ(i_skeleton.joint_parents()[i], o_skeleton->joint_parents()[i]);
+    EXPECT_STREQ(i_skeleton.joint_names()[i], o_skeleton->joint_names()[i]);
+  }
+
+  // Name lookup index works from the placement buffer too.
+  for (int i = 0; i < i_skeleton.num_joints(); ++i) {
+    EXPECT_EQ(i_skeleton.FindJoint(i_skeleton.joint_names()[i]), i);
+  }
+  EXPECT_EQ(i_skeleton.FindJoint("unknown"), -1);
+
+  for (int i = 0; i < (i_skeleton.num_joints() + 3) / 4; ++i) {
+    EXPECT_TRUE(
+        ozz::math::AreAllTrue(i_skeleton.joint_rest_poses()[i].translation ==
+                              o_skeleton->joint_rest_poses()[i].translation));
+    EXPECT_TRUE(
+        ozz::math::AreAllTrue(i_skeleton.joint_rest_poses()[i].rotation ==
+                              o_skeleton->joint_rest_poses()[i].rotation));
+    EXPECT_TRUE(ozz::math::AreAllTrue(i_skeleton.joint_rest_poses()[i].scale ==
+                                      o_skeleton->joint_rest_poses()[i].scale));
+  }
+
+  {  // An empty skeleton has no data block to place, SizeOf reports 0.
+    ozz::io::MemoryStream empty_stream;
+    {
+      ozz::io::OArchive o(&empty_stream);
+      Skeleton empty;
+      o << empty;
+    }
+    empty_stream.Seek(0, ozz::io::Stream::kSet);
+    ozz::io::IArchive ie(&empty_stream);
+    EXPECT_EQ(Skeleton::SizeOf(ie), 0u);
+    Skeleton invalid;
+    EXPECT_FALSE(invalid.Load(ie, bytes.first(size)));
   }
 }
 
@@ -0,0 +1,184 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/raw_skeleton.h"
+#include "ozz/animation/offline/skeleton_builder.h"
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/animation/runtime/skeleton_remapper.h"
+#include "ozz/base/maths/gtest_math_helper.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+using ozz::animation::Skeleton;
+using ozz::animation::SkeletonRemapper;
+using ozz::animation::offline::RawSkeleton;
+using ozz::animation::offline::SkeletonBuilder;
+
+namespace {
+
+// Builds the source skeleton: hips -> spine -> head.
+ozz::unique_ptr<Skeleton> BuildSourceSkeleton() {
+  RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  RawSkeleton::Joint& hips = raw_skeleton.roots[0];
+  hips.name = "hips";
+  hips.transform = ozz::math::Transform::identity();
+  hips.transform.translation = ozz::math::Float3(0.f, 1.f, 0.f);
+  hips.children.resize(1);
+  RawSkeleton::Joint& spine = hips.children[0];
+  spine.name = "spine";
+  spine.transform = ozz::math::Transform::identity();
+  spine.transform.translation = ozz::math::Float3(0.f, 2.f, 0.f);
+  spine.children.resize(1);
+  RawSkeleton::Joint& head = spine.children[0];
+  head.name = "head";
+  head.transform = ozz::math::Transform::identity();
+  head.transform.translation = ozz::math::Float3(0.f, 1.f, 0.f);
+  SkeletonBuilder builder;
+  return builder(raw_skeleton);
+}
+
+// Builds the destination skeleton, with different proportions, an extra
+// unmatched "tail" joint and a different joint ordering: hips -> (tail,
+// spine -> head), aka depth-first order hips, tail, spine, head.
+ozz::unique_ptr<Skeleton> BuildDestSkeleton() {
+  RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  RawSkeleton::Joint& hips = raw_skeleton.roots[0];
+  hips.name = "hips";
+  hips.transform = ozz::math::Transform::identity();
+  hips.transform.translation = ozz::math::Float3(0.f, .5f, 0.f);
+  hips.children.resize(2);
+  RawSkeleton::Joint& tail = hips.children[0];
+  tail.name = "tail";
+  tail.transform = ozz::math::Transform::identity();
+  tail.transform.translation = ozz::math::Float3(3.f, 0.f, 0.f);
+  RawSkeleton::Joint& spine = hips.children[1];
+  spine.name = "spine";
+  spine.transform = ozz::math::Transform::identity();
+  spine.transform.translation = ozz::math::Float3(0.f, 1.f, 0.f);
+  spine.children.resize(1);
+  RawSkeleton::Joint& head = spine.children[0];
+  head.name = "head";
+  head.transform = ozz::math::Transform::identity();
+  head.transform.translation = ozz::math::Float3(0.f, 2.f, 0.f);
+  SkeletonBuilder builder;
+  return builder(raw_skeleton);
+}
+}  // namespace
+
+TEST(Validity, SkeletonRemapper) {
+  ozz::unique_ptr<Skeleton> source = BuildSourceSkeleton();
+  ozz::unique_ptr<Skeleton> dest = BuildDestSkeleton();
+
+  {  // No joint name matches at all.
+    RawSkeleton raw_skeleton;
+    raw_skeleton.roots.resize(1);
+    raw_skeleton.roots[0].name = "unrelated";
+    SkeletonBuilder builder;
+    ozz::unique_ptr<Skeleton> unrelated = builder(raw_skeleton);
+
+    SkeletonRemapper remapper(*source, *unrelated);
+    EXPECT_FALSE(remapper.valid());
+    EXPECT_EQ(remapper.num_matches(), 0);
+
+    const ozz::math::SoaTransform identity =
+        ozz::math::SoaTransform::identity();
+    ozz::math::SoaTransform output[1] = {identity};
+    EXPECT_FALSE(remapper.Run(ozz::span<const ozz::math::SoaTransform>(
+                                  &identity, 1),
+                              output));
+  }
+
+  {  // Valid remapper, invalid pose buffer sizes.
+    SkeletonRemapper remapper(*source, *dest);
+    EXPECT_TRUE(remapper.valid());
+    EXPECT_EQ(remapper.num_matches(), 3);
+
+    const ozz::math::SoaTransform identity =
+        ozz::math::SoaTransform::identity();
+    ozz::math::SoaTransform output[1] = {identity};
+
+    // Source pose too small.
+    EXPECT_FALSE(
+        remapper.Run(ozz::span<const ozz::math::SoaTransform>(), output));
+
+    // Destination pose too small.
+    EXPECT_FALSE(remapper.Run(
+        ozz::span<const ozz::math::SoaTransform>(&identity, 1),
+        ozz::span<ozz::math::SoaTransform>()));
+
+    // Valid arguments.
+    EXPECT_TRUE(remapper.Run(
+        ozz::span<const ozz::math::SoaTransform>(&identity, 1), output));
+  }
+}
+
+TEST(Run, SkeletonRemapper) {
+  ozz::unique_ptr<Skeleton> source = BuildSourceSkeleton();
+  ozz::unique_ptr<Skeleton> dest = BuildDestSkeleton();
+
+  SkeletonRemapper remapper(*source, *dest);
+  ASSERT_TRUE(remapper.valid());
+
+  // Builds a source pose: translations and scales differ per joint, spine
+  // (source joint 1) is rotated a quarter turn around z.
+  ozz::math::SoaTransform source_pose[1];
+  source_pose[0].translation = ozz::math::SoaFloat3::Load(
+      ozz::math::simd_float4::Load(1.f, 4.f, 7.f, 0.f),
+      ozz::math::simd_float4::Load(2.f, 5.f, 8.f, 0.f),
+      ozz::math::simd_float4::Load(3.f, 6.f, 9.f, 0.f));
+  source_pose[0].rotation = ozz::math::SoaQuaternion::Load(
+      ozz::math::simd_float4::zero(), ozz::math::simd_float4::zero(),
+      ozz::math::simd_float4::Load(0.f, .70710678f, 0.f, 0.f),
+      ozz::math::simd_float4::Load(1.f, .70710678f, 1.f, 1.f));
+  source_pose[0].scale = ozz::math::SoaFloat3::Load(
+      ozz::math::simd_float4::Load(1.f, 2.f, 3.f, 1.f),
+      ozz::math::simd_float4::Load(1.f, 2.f, 3.f, 1.f),
+      ozz::math::simd_float4::Load(1.f, 2.f, 3.f, 1.f));
+
+  ozz::math::SoaTransform dest_pose[1];
+  ASSERT_TRUE(remapper.Run(source_pose, dest_pose));
+
+  // Destination joints are hips, tail, spine, head. Translation ratios are
+  // .5 (hips), .5 (spine) and 2 (head), from rest pose lengths. The unmatched
+  // tail falls back to its rest pose.
+  EXPECT_SOAFLOAT3_EQ_EST(dest_pose[0].translation,  // x, y, z per joint
+                          .5f, 3.f, 2.f, 14.f,       //
+                          1.f, 0.f, 2.5f, 16.f,      //
+                          1.5f, 0.f, 3.f, 18.f);
+  EXPECT_SOAQUATERNION_EQ_EST(dest_pose[0].rotation,        //
+                              0.f, 0.f, 0.f, 0.f,           //
+                              0.f, 0.f, 0.f, 0.f,           //
+                              0.f, 0.f, .70710678f, 0.f,    //
+                              1.f, 1.f, .70710678f, 1.f);
+  EXPECT_SOAFLOAT3_EQ_EST(dest_pose[0].scale,        //
+                          1.f, 1.f, 2.f, 3.f,        //
+                          1.f, 1.f, 2.f, 3.f,        //
+                          1.f, 1.f, 2.f, 3.f);
+}
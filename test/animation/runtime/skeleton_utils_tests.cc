@@ -36,6 +36,7 @@
 #include "ozz/base/gtest_helper.h"
 #include "ozz/base/maths/gtest_math_helper.h"
 #include "ozz/base/memory/unique_ptr.h"
+#include "ozz/base/span.h"
 
 using ozz::animation::Skeleton;
 using ozz::animation::offline::RawSkeleton;
@@ -93,6 +94,70 @@ TEST(JointRestPose, SkeletonUtils) {
   EXPECT_FLOAT3_EQ(rest_pose2.scale, 1.f, 1.f, 1.f);
 }
 
+TEST(JointRestPoses, SkeletonUtils) {
+  SkeletonBuilder builder;
+
+  // Builds a 6 joints chain with distinct translations, crossing a soa block
+  // boundary.
+  RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  RawSkeleton::Joint* joint = &raw_skeleton.roots[0];
+  for (int i = 0;; ++i) {
+    joint->name = "j";
+    joint->transform.translation =
+        ozz::math::Float3(static_cast<float>(i), 0.f, 0.f);
+    joint->transform.rotation = ozz::math::Quaternion::identity();
+    joint->transform.scale = ozz::math::Float3::one();
+    if (i == 5) {
+      break;
+    }
+    joint->children.resize(1);
+    joint = &joint->children[0];
+  }
+
+  ozz::unique_ptr<Skeleton> skeleton(builder(raw_skeleton));
+  ASSERT_TRUE(skeleton);
+  ASSERT_EQ(skeleton->num_joints(), 6);
+
+  ozz::math::Transform rest_poses[6];
+
+  {  // Out of range.
+    EXPECT_ASSERTION(GetJointLocalRestPoses(*skeleton, rest_poses, 1),
+                     "Joint range out of range.");
+    EXPECT_ASSERTION(
+        GetJointLocalRestPoses(*skeleton, ozz::make_span(rest_poses).first(1),
+                               -1),
+        "Joint range out of range.");
+  }
+
+  {  // Empty range is a no-op.
+    GetJointLocalRestPoses(*skeleton, {});
+  }
+
+  {  // Whole hierarchy, matches per-joint extraction.
+    GetJointLocalRestPoses(*skeleton, rest_poses);
+    for (int i = 0; i < 6; ++i) {
+      const ozz::math::Transform ref = GetJointLocalRestPose(*skeleton, i);
+      EXPECT_FLOAT3_EQ(rest_poses[i].translation, ref.translation.x,
+                       ref.translation.y, ref.translation.z);
+      EXPECT_QUATERNION_EQ(rest_poses[i].rotation, ref.rotation.x,
+                           ref.rotation.y, ref.rotation.z, ref.rotation.w);
+      EXPECT_FLOAT3_EQ(rest_poses[i].scale, ref.scale.x, ref.scale.y,
+                       ref.scale.z);
+    }
+  }
+
+  {  // Partial range, not aligned on soa block boundaries.
+    ozz::math::Transform partial[3];
+    GetJointLocalRestPoses(*skeleton, partial, 2);
+    for (int i = 0; i < 3; ++i) {
+      const ozz::math::Transform ref = GetJointLocalRestPose(*skeleton, i + 2);
+      EXPECT_FLOAT3_EQ(partial[i].translation, ref.translation.x,
+                       ref.translation.y, ref.translation.z);
+    }
+  }
+}
+
 /* Definition of the skeleton used by the tests.
  10 joints, 2 roots
 
@@ -435,4 +500,283 @@ TEST(Name, SkeletonUtils) {
 
   EXPECT_TRUE(FindJoint(*skeleton, "aj0") < 0);
   EXPECT_TRUE(FindJoint(*skeleton, "j0a") < 0);
-}
\ No newline at end of file
+
+  // Skeleton member function, backing the utility with its name index.
+  EXPECT_EQ(skeleton->FindJoint("j0"), 0);
+  EXPECT_EQ(skeleton->FindJoint("j10"), 1);
+  EXPECT_EQ(skeleton->FindJoint("j1"), 2);
+  EXPECT_EQ(skeleton->FindJoint("J0"), 3);
+  EXPECT_TRUE(skeleton->FindJoint("") < 0);
+  EXPECT_TRUE(skeleton->FindJoint("j") < 0);
+}
+TEST(JointPermutation, SkeletonUtils) {
+  using ozz::animation::BuildJointPermutation;
+
+  SkeletonBuilder builder;
+
+  // Builds 2 skeletons with the same joints in different orders.
+  RawSkeleton raw_source;
+  raw_source.roots.resize(3);
+  raw_source.roots[0].name = "j0";
+  raw_source.roots[1].name = "j1";
+  raw_source.roots[2].name = "j2";
+  ozz::unique_ptr<Skeleton> source(builder(raw_source));
+  ASSERT_TRUE(source);
+
+  RawSkeleton raw_target;
+  raw_target.roots.resize(3);
+  raw_target.roots[0].name = "j2";
+  raw_target.roots[1].name = "j0";
+  raw_target.roots[2].name = "j1";
+  ozz::unique_ptr<Skeleton> target(builder(raw_target));
+  ASSERT_TRUE(target);
+
+  uint16_t permutation[3];
+
+  {  // Too small output fails.
+    EXPECT_FALSE(BuildJointPermutation(*source, *target,
+                                       ozz::make_span(permutation).first(2)));
+  }
+
+  {  // Mismatching joint counts fail.
+    RawSkeleton raw_smaller;
+    raw_smaller.roots.resize(2);
+    raw_smaller.roots[0].name = "j0";
+    raw_smaller.roots[1].name = "j1";
+    ozz::unique_ptr<Skeleton> smaller(builder(raw_smaller));
+    ASSERT_TRUE(smaller);
+    EXPECT_FALSE(
+        BuildJointPermutation(*source, *smaller, ozz::make_span(permutation)));
+  }
+
+  {  // Mismatching joint names fail.
+    RawSkeleton raw_renamed;
+    raw_renamed.roots.resize(3);
+    raw_renamed.roots[0].name = "j0";
+    raw_renamed.roots[1].name = "j1";
+    raw_renamed.roots[2].name = "other";
+    ozz::unique_ptr<Skeleton> renamed(builder(raw_renamed));
+    ASSERT_TRUE(renamed);
+    EXPECT_FALSE(
+        BuildJointPermutation(*source, *renamed, ozz::make_span(permutation)));
+  }
+
+  // Maps every target joint to the source joint with the same name.
+  ASSERT_TRUE(
+      BuildJointPermutation(*source, *target, ozz::make_span(permutation)));
+  EXPECT_EQ(permutation[0], 2);
+  EXPECT_EQ(permutation[1], 0);
+  EXPECT_EQ(permutation[2], 1);
+
+  // Identity when orders already match.
+  ASSERT_TRUE(
+      BuildJointPermutation(*source, *source, ozz::make_span(permutation)));
+  EXPECT_EQ(permutation[0], 0);
+  EXPECT_EQ(permutation[1], 1);
+  EXPECT_EQ(permutation[2], 2);
+}
+
+TEST(PartitionJoints, SkeletonUtils) {
+  using ozz::animation::JointsRange;
+  using ozz::animation::PartitionJoints;
+
+  SkeletonBuilder builder;
+
+  {  // Empty skeleton.
+    RawSkeleton raw_skeleton;
+    ozz::unique_ptr<Skeleton> skeleton(builder(raw_skeleton));
+    ASSERT_TRUE(skeleton);
+
+    JointsRange ranges[2];
+    EXPECT_EQ(PartitionJoints(*skeleton, ranges), 0);
+  }
+
+  // Builds a skeleton with a 2 joints trunk and 3 subtrees:
+  // r0 - s0 - (j0 - j1) (j2) (j3 - j4)
+  RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  RawSkeleton::Joint& r0 = raw_skeleton.roots[0];
+  r0.name = "r0";
+  r0.children.resize(1);
+  RawSkeleton::Joint& s0 = r0.children[0];
+  s0.name = "s0";
+  s0.children.resize(3);
+  s0.children[0].name = "j0";
+  s0.children[0].children.resize(1);
+  s0.children[0].children[0].name = "j1";
+  s0.children[1].name = "j2";
+  s0.children[2].name = "j3";
+  s0.children[2].children.resize(1);
+  s0.children[2].children[0].name = "j4";
+
+  EXPECT_TRUE(raw_skeleton.Validate());
+  ozz::unique_ptr<Skeleton> skeleton(builder(raw_skeleton));
+  ASSERT_TRUE(skeleton);
+  ASSERT_EQ(skeleton->num_joints(), 7);
+
+  {  // Enough ranges for the full partition.
+    JointsRange ranges[4];
+    const int num_ranges = PartitionJoints(*skeleton, ranges);
+    ASSERT_EQ(num_ranges, 4);
+
+    // Trunk covers r0 and s0.
+    EXPECT_EQ(ranges[0].from, ozz::animation::Skeleton::kNoParent);
+    EXPECT_EQ(ranges[0].to, 1);
+
+    // Subtrees are disjoint and cover all remaining joints.
+    int covered = ranges[0].to + 1;
+    for (int i = 1; i < num_ranges; ++i) {
+      EXPECT_EQ(ranges[i].from, covered);
+      EXPECT_LE(ranges[i].from, ranges[i].to);
+      covered = ranges[i].to + 1;
+    }
+    EXPECT_EQ(covered, skeleton->num_joints());
+  }
+
+  {  // Not enough ranges for all subtrees, falls back to a smaller split.
+    JointsRange ranges[2];
+    const int num_ranges = PartitionJoints(*skeleton, ranges);
+    ASSERT_EQ(num_ranges, 2);
+    EXPECT_EQ(ranges[0].from, ozz::animation::Skeleton::kNoParent);
+    EXPECT_EQ(ranges[1].to, 6);
+  }
+}
+
+TEST(JointDepthsLodMask, SkeletonUtils) {
+  using ozz::animation::BuildLodJointMask;
+  using ozz::animation::GetJointDepths;
+
+  SkeletonBuilder builder;
+
+  {  // Empty skeleton.
+    RawSkeleton raw_skeleton;
+    ozz::unique_ptr<Skeleton> skeleton(builder(raw_skeleton));
+    ASSERT_TRUE(skeleton);
+
+    EXPECT_EQ(GetJointDepths(*skeleton, {}), -1);
+  }
+
+  // Builds a skeleton with a deep chain and shallow joints, such that the
+  // middle soa block only contains deep joints:
+  // r - d1 - d2 - d3 - d4 - d5 - d6 - d7 - d8
+  //   - f - g
+  //   - h
+  RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  RawSkeleton::Joint& r = raw_skeleton.roots[0];
+  r.name = "r";
+  r.children.resize(3);
+  RawSkeleton::Joint* chain = &r.children[0];
+  const char* chain_names[] = {"d1", "d2", "d3", "d4", "d5", "d6", "d7", "d8"};
+  for (size_t i = 0; i < OZZ_ARRAY_SIZE(chain_names); ++i) {
+    chain->name = chain_names[i];
+    if (i + 1 < OZZ_ARRAY_SIZE(chain_names)) {
+      chain->children.resize(1);
+      chain = &chain->children[0];
+    }
+  }
+  r.children[1].name = "f";
+  r.children[1].children.resize(1);
+  r.children[1].children[0].name = "g";
+  r.children[2].name = "h";
+
+  EXPECT_TRUE(raw_skeleton.Validate());
+  ozz::unique_ptr<Skeleton> skeleton(builder(raw_skeleton));
+  ASSERT_TRUE(skeleton);
+  ASSERT_EQ(skeleton->num_joints(), 12);
+
+  // Depth first ordering: r, d1...d8, f, g, h.
+  int16_t depths[12];
+  EXPECT_EQ(GetJointDepths(*skeleton, depths), 8);
+  const int16_t expected_depths[12] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 1, 2, 1};
+  for (size_t i = 0; i < OZZ_ARRAY_SIZE(expected_depths); ++i) {
+    EXPECT_EQ(depths[i], expected_depths[i]);
+  }
+
+  // 12 joints aka 3 soa blocks: {r, d1, d2, d3} {d4, d5, d6, d7} {d8, f, g, h}
+  ozz::byte mask[1];
+
+  {  // Level 0 only needs the first block.
+    EXPECT_EQ(BuildLodJointMask(*skeleton, depths, 0, mask), 1);
+    EXPECT_EQ(mask[0], 1);
+  }
+
+  {  // Level 1 selects blocks 0 (r, d1) and 2 (f, h). Block 2 lane mate d8
+    // has its parent d7 in block 1, which gets selected by the closure over
+    // parents, so that LocalToModelJob never reads a skipped matrix.
+    EXPECT_EQ(BuildLodJointMask(*skeleton, depths, 1, mask), 3);
+    EXPECT_EQ(mask[0], 7);
+  }
+
+  {  // Deepest level selects everything.
+    EXPECT_EQ(BuildLodJointMask(*skeleton, depths, 8, mask), 3);
+    EXPECT_EQ(mask[0], 7);
+  }
+}
+
+TEST(StructuralHash, SkeletonUtils) {
+  SkeletonBuilder builder;
+
+  // Two skeletons with the same hierarchy but different names and rest
+  // poses.
+  RawSkeleton raw_a;
+  raw_a.roots.resize(1);
+  raw_a.roots[0].name = "root_a";
+  raw_a.roots[0].transform = ozz::math::Transform::identity();
+  raw_a.roots[0].children.resize(2);
+  raw_a.roots[0].children[0].name = "left_a";
+  raw_a.roots[0].children[0].transform = ozz::math::Transform::identity();
+  raw_a.roots[0].children[1].name = "right_a";
+  raw_a.roots[0].children[1].transform = ozz::math::Transform::identity();
+
+  RawSkeleton raw_b = raw_a;
+  raw_b.roots[0].name = "root_b";
+  raw_b.roots[0].children[0].name = "left_b";
+  raw_b.roots[0].children[0].transform.translation =
+      ozz::math::Float3::x_axis();
+  raw_b.roots[0].children[1].name = "right_b";
+
+  ozz::unique_ptr<Skeleton> skeleton_a = builder(raw_a);
+  ozz::unique_ptr<Skeleton> skeleton_b = builder(raw_b);
+  ASSERT_TRUE(skeleton_a && skeleton_b);
+
+  EXPECT_EQ(skeleton_a->structural_hash(), skeleton_b->structural_hash());
+  EXPECT_TRUE(AreCompatible(*skeleton_a, *skeleton_b));
+
+  {  // Same joint count, different hierarchy.
+    RawSkeleton raw_chain;
+    raw_chain.roots.resize(1);
+    RawSkeleton::Joint& root = raw_chain.roots[0];
+    root.name = "root_a";
+    root.transform = ozz::math::Transform::identity();
+    root.children.resize(1);
+    root.children[0].name = "left_a";
+    root.children[0].transform = ozz::math::Transform::identity();
+    root.children[0].children.resize(1);
+    root.children[0].children[0].name = "right_a";
+    root.children[0].children[0].transform =
+        ozz::math::Transform::identity();
+
+    ozz::unique_ptr<Skeleton> chain = builder(raw_chain);
+    ASSERT_TRUE(chain);
+    EXPECT_NE(chain->structural_hash(), skeleton_a->structural_hash());
+    EXPECT_FALSE(AreCompatible(*chain, *skeleton_a));
+  }
+
+  {  // Different joint count.
+    RawSkeleton raw_root;
+    raw_root.roots.resize(1);
+    raw_root.roots[0].name = "root_a";
+    raw_root.roots[0].transform = ozz::math::Transform::identity();
+
+    ozz::unique_ptr<Skeleton> root_only = builder(raw_root);
+    ASSERT_TRUE(root_only);
+    EXPECT_NE(root_only->structural_hash(), skeleton_a->structural_hash());
+  }
+
+  {  // Default constructed skeletons are trivially compatible.
+    const Skeleton empty_a;
+    const Skeleton empty_b;
+    EXPECT_TRUE(AreCompatible(empty_a, empty_b));
+  }
+}
@@ -0,0 +1,147 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/speculative_sampler.h"
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/animation_builder.h"
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+using ozz::animation::Animation;
+using ozz::animation::SpeculativeSampler;
+using ozz::animation::offline::AnimationBuilder;
+using ozz::animation::offline::RawAnimation;
+
+namespace {
+
+// Builds a single track animation translating linearly from 0 to 10 on x.
+ozz::unique_ptr<Animation> BuildLinearAnimation() {
+  RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(1);
+  const RawAnimation::TranslationKey key0 = {0.f,
+                                             ozz::math::Float3(0.f, 0.f, 0.f)};
+  const RawAnimation::TranslationKey key1 = {1.f,
+                                             ozz::math::Float3(10.f, 0.f, 0.f)};
+  raw_animation.tracks[0].translations.push_back(key0);
+  raw_animation.tracks[0].translations.push_back(key1);
+  AnimationBuilder builder;
+  return builder(raw_animation);
+}
+
+// Extracts the first joint x translation of a soa pose.
+float PoseX(const ozz::math::SoaTransform& _pose) {
+  float x[4];
+  ozz::math::StorePtrU(_pose.translation.x, x);
+  return x[0];
+}
+}  // namespace
+
+TEST(Validity, SpeculativeSampler) {
+  ozz::unique_ptr<Animation> animation = BuildLinearAnimation();
+  ASSERT_TRUE(animation);
+
+  SpeculativeSampler sampler;
+  ozz::math::SoaTransform output[1];
+
+  // Sampler wasn't resized, too small for the animation.
+  EXPECT_EQ(sampler.Resolve(*animation, .5f, output),
+            SpeculativeSampler::kInvalid);
+  EXPECT_FALSE(sampler.Presample(*animation, .5f));
+
+  sampler.Resize(animation->num_tracks());
+
+  // Empty output is rejected.
+  EXPECT_EQ(sampler.Resolve(*animation, .5f, {}), SpeculativeSampler::kInvalid);
+
+  // Valid setup samples.
+  EXPECT_EQ(sampler.Resolve(*animation, .5f, output),
+            SpeculativeSampler::kSampled);
+  EXPECT_NEAR(PoseX(output[0]), 5.f, 5e-3f);
+}
+
+TEST(ConsumeCorrectSample, SpeculativeSampler) {
+  ozz::unique_ptr<Animation> animation = BuildLinearAnimation();
+  ASSERT_TRUE(animation);
+
+  SpeculativeSampler sampler;
+  sampler.Resize(animation->num_tracks());
+  ozz::math::SoaTransform output[1];
+
+  // Authoritative frame, then speculation for the predicted next ratio.
+  EXPECT_EQ(sampler.Resolve(*animation, .4f, output),
+            SpeculativeSampler::kSampled);
+  EXPECT_TRUE(sampler.Presample(*animation, .5f));
+
+  // Exact prediction is consumed as is.
+  EXPECT_EQ(sampler.Resolve(*animation, .5f, output),
+            SpeculativeSampler::kConsumed);
+  EXPECT_NEAR(PoseX(output[0]), 5.f, 5e-3f);
+
+  // Near miss is corrected with a lerp between last and speculated poses.
+  EXPECT_TRUE(sampler.Presample(*animation, .6f));
+  EXPECT_EQ(sampler.Resolve(*animation, .58f, output),
+            SpeculativeSampler::kCorrected);
+  EXPECT_NEAR(PoseX(output[0]), 5.8f, 1e-2f);
+
+  // A speculation is consumed by its Resolve, the next frame samples.
+  EXPECT_EQ(sampler.Resolve(*animation, .7f, output),
+            SpeculativeSampler::kSampled);
+  EXPECT_NEAR(PoseX(output[0]), 7.f, 5e-3f);
+
+  // Miss beyond the correction range falls back to a regular sample.
+  EXPECT_TRUE(sampler.Presample(*animation, .8f));
+  EXPECT_EQ(sampler.Resolve(*animation, .2f, output),
+            SpeculativeSampler::kSampled);
+  EXPECT_NEAR(PoseX(output[0]), 2.f, 5e-3f);
+
+  // Disabling correction leaves exact consume only.
+  sampler.max_correction = 0.f;
+  EXPECT_TRUE(sampler.Presample(*animation, .3f));
+  EXPECT_EQ(sampler.Resolve(*animation, .31f, output),
+            SpeculativeSampler::kSampled);
+  EXPECT_NEAR(PoseX(output[0]), 3.1f, 5e-3f);
+}
+
+TEST(AnimationMismatch, SpeculativeSampler) {
+  ozz::unique_ptr<Animation> animation = BuildLinearAnimation();
+  ozz::unique_ptr<Animation> other = BuildLinearAnimation();
+  ASSERT_TRUE(animation && other);
+
+  SpeculativeSampler sampler;
+  sampler.Resize(animation->num_tracks());
+  ozz::math::SoaTransform output[1];
+
+  // Speculation on another animation doesn't match, a regular sample runs.
+  EXPECT_TRUE(sampler.Presample(*other, .5f));
+  EXPECT_EQ(sampler.Resolve(*animation, .5f, output),
+            SpeculativeSampler::kSampled);
+  EXPECT_NEAR(PoseX(output[0]), 5.f, 5e-3f);
+}
@@ -0,0 +1,325 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/time_to_ratio_job.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/raw_track.h"
+#include "ozz/animation/offline/track_builder.h"
+#include "ozz/animation/runtime/track.h"
+#include "ozz/animation/runtime/track_triggering_job.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/maths/math_ex.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+using ozz::animation::TimeToRatioJob;
+
+namespace {
+
+// Scalar reference of a single instance update, the math playback controllers
+// implement per character.
+void Reference(TimeToRatioJob::LoopMode _mode, float _phase, float _dt,
+               float _speed, float _duration, float* _new_phase,
+               float* _ratio) {
+  const float raw = _phase + _dt * _speed / _duration;
+  switch (_mode) {
+    case TimeToRatioJob::kClamp: {
+      *_new_phase = ozz::math::Clamp(0.f, raw, 1.f);
+      *_ratio = *_new_phase;
+    } break;
+    case TimeToRatioJob::kLoop: {
+      *_new_phase = raw - std::floor(raw);
+      *_ratio = *_new_phase;
+    } break;
+    default: {  // kPingPong
+      *_new_phase = raw - 2.f * std::floor(raw / 2.f);
+      *_ratio = *_new_phase <= 1.f ? *_new_phase : 2.f - *_new_phase;
+    } break;
+  }
+}
+}  // namespace
+
+TEST(JobValidity, TimeToRatioJob) {
+  float phases[7] = {};
+  float durations[7] = {1.f, 2.f, 1.f, .5f, 1.f, 3.f, 1.f};
+  float speeds[7] = {1.f, 1.f, -1.f, 2.f, 0.f, 1.f, .5f};
+  float output_phases[7];
+  float ratios[7];
+  float trigger_tos[7];
+  ozz::byte wrap_flags[1];
+
+  {  // Default job is invalid.
+    TimeToRatioJob job;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  TimeToRatioJob job;
+  job.dt = .1f;
+  job.phases = phases;
+  job.durations = durations;
+  job.speeds = speeds;
+  job.output_phases = output_phases;
+  job.ratios = ratios;
+  job.trigger_tos = trigger_tos;
+  job.wrap_flags = wrap_flags;
+  EXPECT_TRUE(job.Validate());
+  EXPECT_TRUE(job.Run());
+
+  {  // Mismatching durations.
+    TimeToRatioJob invalid = job;
+    invalid.durations = {durations, 6};
+    EXPECT_FALSE(invalid.Validate());
+    EXPECT_FALSE(invalid.Run());
+  }
+
+  {  // Mismatching speeds, empty is supported though.
+    TimeToRatioJob invalid = job;
+    invalid.speeds = {speeds, 6};
+    EXPECT_FALSE(invalid.Validate());
+    invalid.speeds = {};
+    EXPECT_TRUE(invalid.Validate());
+  }
+
+  {  // Too small outputs.
+    TimeToRatioJob invalid = job;
+    invalid.output_phases = {output_phases, 6};
+    EXPECT_FALSE(invalid.Validate());
+    invalid.output_phases = output_phases;
+    invalid.ratios = {ratios, 6};
+    EXPECT_FALSE(invalid.Validate());
+  }
+
+  {  // Optional outputs, when provided, must fit every instance.
+    TimeToRatioJob invalid = job;
+    invalid.trigger_tos = {trigger_tos, 6};
+    EXPECT_FALSE(invalid.Validate());
+    invalid.trigger_tos = {};
+    invalid.wrap_flags = {};
+    EXPECT_TRUE(invalid.Validate());
+  }
+
+  {  // Triggering windows can't express ping-pong reflections.
+    TimeToRatioJob invalid = job;
+    invalid.loop_mode = TimeToRatioJob::kPingPong;
+    EXPECT_FALSE(invalid.Validate());
+    invalid.trigger_tos = {};
+    EXPECT_TRUE(invalid.Validate());
+  }
+}
+
+TEST(Modes, TimeToRatioJob) {
+  // 7 instances, one simd chunk and a partial one, with phases spread around
+  // both track boundaries.
+  const float phases[7] = {0.f, .5f, .95f, .1f, 1.f, .3f, .7f};
+  const float durations[7] = {1.f, 2.f, 1.f, .5f, 1.f, 3.f, 1.f};
+  const float speeds[7] = {1.f, 1.f, -1.f, 2.f, 1.f, 0.f, -.5f};
+
+  const TimeToRatioJob::LoopMode modes[] = {TimeToRatioJob::kClamp,
+                                            TimeToRatioJob::kLoop,
+                                            TimeToRatioJob::kPingPong};
+  const float dts[] = {.2f, -.3f, 1.7f};
+
+  for (const TimeToRatioJob::LoopMode mode : modes) {
+    for (const float dt : dts) {
+      float output_phases[7];
+      float ratios[7];
+
+      TimeToRatioJob job;
+      job.loop_mode = mode;
+      job.dt = dt;
+      job.phases = phases;
+      job.durations = durations;
+      job.speeds = speeds;
+      job.output_phases = output_phases;
+      job.ratios = ratios;
+      ASSERT_TRUE(job.Run());
+
+      for (size_t i = 0; i < 7; ++i) {
+        float ref_phase, ref_ratio;
+        Reference(mode, phases[i], dt, speeds[i], durations[i], &ref_phase,
+                  &ref_ratio);
+        EXPECT_FLOAT_EQ(output_phases[i], ref_phase) << " instance " << i;
+        EXPECT_FLOAT_EQ(ratios[i], ref_ratio) << " instance " << i;
+        EXPECT_TRUE(ratios[i] >= 0.f && ratios[i] <= 1.f);
+      }
+    }
+  }
+
+  {  // Empty speeds runs every instance at speed 1.
+    float output_phases[7];
+    float ratios[7];
+    TimeToRatioJob job;
+    job.dt = .2f;
+    job.phases = phases;
+    job.durations = durations;
+    job.output_phases = output_phases;
+    job.ratios = ratios;
+    ASSERT_TRUE(job.Run());
+    for (size_t i = 0; i < 7; ++i) {
+      float ref_phase, ref_ratio;
+      Reference(TimeToRatioJob::kLoop, phases[i], .2f, 1.f, durations[i],
+                &ref_phase, &ref_ratio);
+      EXPECT_FLOAT_EQ(ratios[i], ref_ratio) << " instance " << i;
+    }
+  }
+
+  {  // output_phases can alias phases.
+    float io_phases[7];
+    std::copy(phases, phases + 7, io_phases);
+    float ratios[7];
+    TimeToRatioJob job;
+    job.dt = .2f;
+    job.phases = io_phases;
+    job.durations = durations;
+    job.speeds = speeds;
+    job.output_phases = io_phases;
+    job.ratios = ratios;
+    ASSERT_TRUE(job.Run());
+    for (size_t i = 0; i < 7; ++i) {
+      float ref_phase, ref_ratio;
+      Reference(TimeToRatioJob::kLoop, phases[i], .2f, speeds[i], durations[i],
+                &ref_phase, &ref_ratio);
+      EXPECT_FLOAT_EQ(io_phases[i], ref_phase) << " instance " << i;
+    }
+  }
+}
+
+TEST(WrapFlags, TimeToRatioJob) {
+  const float durations[7] = {1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f};
+  float output_phases[7];
+  float ratios[7];
+  ozz::byte wrap_flags[1];
+
+  TimeToRatioJob job;
+  job.durations = durations;
+  job.output_phases = output_phases;
+  job.ratios = ratios;
+  job.wrap_flags = wrap_flags;
+
+  {  // Loop seams, forward and backward.
+    const float phases[7] = {0.f, .5f, .95f, .1f, .99f, .3f, .01f};
+    const float speeds[7] = {1.f, 1.f, 1.f, 1.f, 1.f, 1.f, -1.f};
+    job.loop_mode = TimeToRatioJob::kLoop;
+    job.dt = .1f;
+    job.phases = phases;
+    job.speeds = speeds;
+    ASSERT_TRUE(job.Run());
+    // Instances 2, 4 (crossed 1) and 6 (crossed 0 backward) wrapped.
+    EXPECT_EQ(static_cast<int>(wrap_flags[0]), 1 << 2 | 1 << 4 | 1 << 6);
+  }
+
+  {  // Clamp saturation flags boundary crossings, not instances already
+     // pushing against a boundary.
+    const float phases[7] = {0.f, .95f, 1.f, .5f, 0.f, .05f, 1.f};
+    const float speeds[7] = {1.f, 1.f, 1.f, 1.f, -1.f, -1.f, -1.f};
+    job.loop_mode = TimeToRatioJob::kClamp;
+    job.dt = .1f;
+    job.phases = phases;
+    job.speeds = speeds;
+    ASSERT_TRUE(job.Run());
+    // Instance 1 saturates to 1, instances 5 and 6... instance 6 moves away
+    // from the boundary. Instances 2 and 4 were already saturated.
+    EXPECT_EQ(static_cast<int>(wrap_flags[0]), 1 << 1 | 1 << 5);
+  }
+
+  {  // Ping-pong reflections at both ends of the cycle.
+    const float phases[7] = {0.f, .95f, 1.5f, 1.95f, .5f, 1.2f, .3f};
+    const float speeds[7] = {1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f};
+    job.loop_mode = TimeToRatioJob::kPingPong;
+    job.dt = .1f;
+    job.phases = phases;
+    job.speeds = speeds;
+    ASSERT_TRUE(job.Run());
+    // Instance 1 reflects at the end (crosses 1), instance 3 at the start
+    // (crosses 2, the end of the [0,2] cycle).
+    EXPECT_EQ(static_cast<int>(wrap_flags[0]), 1 << 1 | 1 << 3);
+  }
+}
+
+TEST(TriggerWindows, TimeToRatioJob) {
+  // Builds a track with a rising edge at .1 and a falling one at .5.
+  ozz::unique_ptr<ozz::animation::FloatTrack> track;
+  {
+    ozz::animation::offline::TrackBuilder builder;
+    ozz::animation::offline::RawFloatTrack raw_track;
+    const ozz::animation::offline::RawFloatTrack::Keyframe key0 = {
+        ozz::animation::offline::RawTrackInterpolation::kStep, 0.f, 0.f};
+    raw_track.keyframes.push_back(key0);
+    const ozz::animation::offline::RawFloatTrack::Keyframe key1 = {
+        ozz::animation::offline::RawTrackInterpolation::kStep, .1f, 1.f};
+    raw_track.keyframes.push_back(key1);
+    const ozz::animation::offline::RawFloatTrack::Keyframe key2 = {
+        ozz::animation::offline::RawTrackInterpolation::kStep, .5f, 0.f};
+    raw_track.keyframes.push_back(key2);
+    track = builder(raw_track);
+    ASSERT_TRUE(track);
+  }
+
+  // A single instance stepping across the loop seam.
+  const float phases[1] = {.9f};
+  const float durations[1] = {1.f};
+  float output_phases[1];
+  float ratios[1];
+  float trigger_tos[1];
+
+  TimeToRatioJob job;
+  job.loop_mode = TimeToRatioJob::kLoop;
+  job.dt = .3f;
+  job.phases = phases;
+  job.durations = durations;
+  job.output_phases = output_phases;
+  job.ratios = ratios;
+  job.trigger_tos = trigger_tos;
+  ASSERT_TRUE(job.Run());
+
+  // The sampling ratio wrapped, while the triggering window end didn't.
+  EXPECT_FLOAT_EQ(ratios[0], .2f);
+  EXPECT_FLOAT_EQ(trigger_tos[0], 1.2f);
+
+  // Runs triggering over the unwrapped window [.9, 1.2]: it crosses the seam
+  // once, firing the single rising edge at 1.1 (.1 on the next loop), with no
+  // double fire at the seam.
+  ozz::animation::TrackTriggeringJob triggering;
+  triggering.track = track.get();
+  triggering.threshold = .5f;
+  triggering.from = phases[0];
+  triggering.to = trigger_tos[0];
+  ozz::animation::TrackTriggeringJob::Iterator iterator;
+  triggering.iterator = &iterator;
+  ASSERT_TRUE(triggering.Run());
+
+  int edges = 0;
+  for (; iterator != triggering.end(); ++iterator, ++edges) {
+    EXPECT_TRUE(iterator->rising);
+    EXPECT_FLOAT_EQ(iterator->ratio, 1.1f);
+  }
+  EXPECT_EQ(edges, 1);
+}
@@ -30,11 +30,18 @@
 #include "gtest/gtest.h"
 #include "ozz/base/maths/gtest_math_helper.h"
 
+#include "ozz/base/containers/vector.h"
 #include "ozz/base/io/archive.h"
 #include "ozz/base/io/stream.h"
 #include "ozz/base/memory/unique_ptr.h"
 
+#include "ozz/animation/runtime/quantized_track.h"
+#include "ozz/animation/runtime/track_bundle.h"
+#include "ozz/animation/runtime/track_bundle_sampling_job.h"
+#include "ozz/animation/runtime/track_edge_index.h"
 #include "ozz/animation/runtime/track_sampling_job.h"
+#include "ozz/animation/runtime/track_soa.h"
+#include "ozz/animation/runtime/track_soa_sampling_job.h"
 
 #include "ozz/animation/offline/raw_track.h"
 #include "ozz/animation/offline/track_builder.h"
@@ -452,3 +459,285 @@ TEST(AlreadyInitialized, TrackSerialize) {
     ASSERT_TRUE(i_track.size() > size);
   }
 }
+
+TEST(PlacementLoad, TrackSerialize) {
+  // Builds a valid track.
+  ozz::unique_ptr<FloatTrack> o_track;
+  {
+    TrackBuilder builder;
+    RawFloatTrack raw_float_track;
+    raw_float_track.name = "placement track";
+
+    const RawFloatTrack::Keyframe key0 = {RawTrackInterpolation::kLinear, 0.f,
+                                          0.f};
+    raw_float_track.keyframes.push_back(key0);
+    const RawFloatTrack::Keyframe key1 = {RawTrackInterpolation::kStep, .5f,
+                                          46.f};
+    raw_float_track.keyframes.push_back(key1);
+
+    o_track = builder(raw_float_track);
+    ASSERT_TRUE(o_track);
+  }
+
+  ozz::io::MemoryStream stream;
+  {
+    ozz::io::OArchive o(&stream);
+    o << *o_track;
+  }
+
+  stream.Seek(0, ozz::io::Stream::kSet);
+  ozz::io::IArchive i(&stream);
+
+  // SizeOfTrack probes the archive without moving the read position, probing
+  // twice reports the same size.
+  const size_t size = ozz::animation::SizeOfTrack<FloatTrack>(i);
+  ASSERT_GT(size, 0u);
+  EXPECT_EQ(ozz::animation::SizeOfTrack<FloatTrack>(i), size);
+
+  // A float buffer guarantees the required alignment.
+  ozz::vector<float> buffer((size + sizeof(float) - 1) / sizeof(float) + 4);
+  const ozz::span<ozz::byte> bytes = {
+      reinterpret_cast<ozz::byte*>(buffer.data()), size + sizeof(float)};
+
+  {  // Too small and misaligned buffers are rejected, leaving the archive
+     // read position untouched.
+    FloatTrack i_track;
+    EXPECT_FALSE(ozz::animation::LoadTrack(i, &i_track, bytes.first(size - 1)));
+    EXPECT_FALSE(ozz::animation::LoadTrack(i, &i_track, bytes.subspan(1, size)));
+    EXPECT_EQ(i_track.ratios().size(), 0u);
+    EXPECT_EQ(ozz::animation::SizeOfTrack<FloatTrack>(i), size);
+  }
+
+  FloatTrack i_track;
+  ASSERT_TRUE(ozz::animation::LoadTrack(i, &i_track, bytes.first(size)));
+
+  // The track data block lives in the caller-provided buffer.
+  const ozz::byte* ratios =
+      reinterpret_cast<const ozz::byte*>(i_track.ratios().data());
+  EXPECT_TRUE(ratios >= bytes.data() && ratios < bytes.data() + size);
+
+  EXPECT_STREQ(o_track->name(), i_track.name());
+
+  // Samples and compares the two tracks.
+  FloatTrackSamplingJob sampling;
+  sampling.track = &i_track;
+  float result;
+  sampling.result = &result;
+
+  sampling.ratio = 0.f;
+  ASSERT_TRUE(sampling.Run());
+  EXPECT_FLOAT_EQ(result, 0.f);
+
+  sampling.ratio = .5f;
+  ASSERT_TRUE(sampling.Run());
+  EXPECT_FLOAT_EQ(result, 46.f);
+
+  {  // The next object in the archive is not a FloatTrack.
+    stream.Seek(0, ozz::io::Stream::kSet);
+    ozz::io::IArchive other(&stream);
+    EXPECT_EQ(ozz::animation::SizeOfTrack<Float3Track>(other), 0u);
+    Float3Track invalid;
+    EXPECT_FALSE(
+        ozz::animation::LoadTrack(other, &invalid, bytes.first(size)));
+  }
+}
+
+TEST(SoA, TrackSerialize) {
+  ozz::io::MemoryStream stream;
+
+  // Instantiates a builder objects with default parameters.
+  TrackBuilder builder;
+
+  RawFloatTrack raw_tracks[3];
+  const RawFloatTrack::Keyframe keys[] = {
+      {RawTrackInterpolation::kLinear, 0.f, 0.f},
+      {RawTrackInterpolation::kStep, .5f, 46.f},
+      {RawTrackInterpolation::kLinear, 1.f, 0.f}};
+  raw_tracks[1].keyframes.assign(keys, keys + 3);
+  raw_tracks[2].keyframes.push_back(keys[1]);
+
+  ozz::unique_ptr<ozz::animation::FloatTrackSoA> o_tracks(
+      builder(ozz::make_span(raw_tracks)));
+  ASSERT_TRUE(o_tracks);
+
+  // Streams out.
+  ozz::io::OArchive o(&stream, ozz::GetNativeEndianness());
+  o << *o_tracks;
+
+  // Streams in.
+  stream.Seek(0, ozz::io::Stream::kSet);
+  ozz::io::IArchive i(&stream);
+
+  ozz::animation::FloatTrackSoA i_tracks;
+  i >> i_tracks;
+
+  ASSERT_EQ(o_tracks->num_tracks(), i_tracks.num_tracks());
+  EXPECT_EQ(o_tracks->size(), i_tracks.size());
+
+  // Serialized and deserialized tracks sample the same.
+  for (int r = 0; r < 11; ++r) {
+    const float ratio = r / 10.f;
+
+    float o_results[3];
+    ozz::animation::TrackSoASamplingJob o_job;
+    o_job.ratio = ratio;
+    o_job.tracks = o_tracks.get();
+    o_job.results = o_results;
+    ASSERT_TRUE(o_job.Run());
+
+    float i_results[3];
+    ozz::animation::TrackSoASamplingJob i_job;
+    i_job.ratio = ratio;
+    i_job.tracks = &i_tracks;
+    i_job.results = i_results;
+    ASSERT_TRUE(i_job.Run());
+
+    EXPECT_FLOAT_EQ(o_results[0], i_results[0]);
+    EXPECT_FLOAT_EQ(o_results[1], i_results[1]);
+    EXPECT_FLOAT_EQ(o_results[2], i_results[2]);
+  }
+}
+
+TEST(EdgeIndex, TrackSerialize) {
+  // Builds a valid edge index.
+  ozz::unique_ptr<ozz::animation::TrackEdgeIndex> o_index;
+  {
+    TrackBuilder builder;
+    RawFloatTrack raw_float_track;
+
+    const RawFloatTrack::Keyframe key0 = {RawTrackInterpolation::kLinear, 0.f,
+                                          0.f};
+    raw_float_track.keyframes.push_back(key0);
+    const RawFloatTrack::Keyframe key1 = {RawTrackInterpolation::kStep, .5f,
+                                          46.f};
+    raw_float_track.keyframes.push_back(key1);
+    const RawFloatTrack::Keyframe key2 = {RawTrackInterpolation::kLinear, .7f,
+                                          0.f};
+    raw_float_track.keyframes.push_back(key2);
+
+    // Builds edge index
+    o_index = builder(raw_float_track, 1.f);
+    ASSERT_TRUE(o_index);
+  }
+
+  ozz::io::MemoryStream stream;
+
+  // Streams out.
+  ozz::io::OArchive o(&stream, ozz::GetNativeEndianness());
+  o << *o_index;
+
+  // Streams in.
+  stream.Seek(0, ozz::io::Stream::kSet);
+  ozz::io::IArchive i(&stream);
+
+  ozz::animation::TrackEdgeIndex i_index;
+  i >> i_index;
+
+  // Compares the two indices.
+  EXPECT_EQ(o_index->size(), i_index.size());
+  EXPECT_FLOAT_EQ(o_index->threshold(), i_index.threshold());
+  ASSERT_EQ(o_index->ratios().size(), i_index.ratios().size());
+  for (size_t e = 0; e < i_index.ratios().size(); ++e) {
+    EXPECT_FLOAT_EQ(o_index->ratios()[e], i_index.ratios()[e]);
+    EXPECT_EQ((o_index->risings()[e / 8] >> (e & 7)) & 1,
+              (i_index.risings()[e / 8] >> (e & 7)) & 1);
+  }
+}
+
+TEST(QuantizedFloat, TrackSerialize) {
+  TrackBuilder builder;
+
+  // Builds a valid quantized track.
+  RawFloatTrack raw_float_track;
+  const RawFloatTrack::Keyframe key0 = {RawTrackInterpolation::kLinear, 0.f,
+                                        0.f};
+  raw_float_track.keyframes.push_back(key0);
+  const RawFloatTrack::Keyframe key1 = {RawTrackInterpolation::kStep, .5f,
+                                        46.f};
+  raw_float_track.keyframes.push_back(key1);
+  const RawFloatTrack::Keyframe key2 = {RawTrackInterpolation::kLinear, .7f,
+                                        0.f};
+  raw_float_track.keyframes.push_back(key2);
+  ozz::unique_ptr<ozz::animation::QuantizedFloatTrack> o_track =
+      builder(raw_float_track, ozz::animation::QuantizedFloatTrack::kNormalized);
+  ASSERT_TRUE(o_track);
+
+  ozz::io::MemoryStream stream;
+
+  // Streams out.
+  ozz::io::OArchive o(&stream, ozz::GetNativeEndianness());
+  o << *o_track;
+
+  // Streams in.
+  stream.Seek(0, ozz::io::Stream::kSet);
+  ozz::io::IArchive i(&stream);
+
+  ozz::animation::QuantizedFloatTrack i_track;
+  i >> i_track;
+
+  EXPECT_EQ(o_track->size(), i_track.size());
+  EXPECT_EQ(o_track->format(), i_track.format());
+
+  // Samples and compares the two tracks.
+  ozz::animation::QuantizedFloatTrackSamplingJob o_sampling, i_sampling;
+  float o_result, i_result;
+  o_sampling.track = o_track.get();
+  o_sampling.result = &o_result;
+  i_sampling.track = &i_track;
+  i_sampling.result = &i_result;
+  for (int r = 0; r < 11; ++r) {
+    o_sampling.ratio = i_sampling.ratio = r * .1f;
+    ASSERT_TRUE(o_sampling.Run());
+    ASSERT_TRUE(i_sampling.Run());
+    EXPECT_FLOAT_EQ(o_result, i_result);
+  }
+}
+
+TEST(Bundle, TrackSerialize) {
+  TrackBuilder builder;
+
+  // Builds a valid bundle of 2 tracks sharing their timeline.
+  RawFloatTrack raw_tracks[2];
+  for (size_t i = 0; i < 2; ++i) {
+    const RawFloatTrack::Keyframe key0 = {RawTrackInterpolation::kLinear, 0.f,
+                                          46.f * i};
+    raw_tracks[i].keyframes.push_back(key0);
+    const RawFloatTrack::Keyframe key1 = {RawTrackInterpolation::kStep, .5f,
+                                          99.f * i};
+    raw_tracks[i].keyframes.push_back(key1);
+  }
+  ozz::unique_ptr<ozz::animation::FloatTrackBundle> o_bundle =
+      builder.Bundle(ozz::make_span(raw_tracks));
+  ASSERT_TRUE(o_bundle);
+
+  ozz::io::MemoryStream stream;
+
+  // Streams out.
+  ozz::io::OArchive o(&stream, ozz::GetNativeEndianness());
+  o << *o_bundle;
+
+  // Streams in.
+  stream.Seek(0, ozz::io::Stream::kSet);
+  ozz::io::IArchive i(&stream);
+
+  ozz::animation::FloatTrackBundle i_bundle;
+  i >> i_bundle;
+
+  EXPECT_EQ(o_bundle->size(), i_bundle.size());
+  EXPECT_EQ(o_bundle->num_tracks(), i_bundle.num_tracks());
+
+  // Samples and compares the two bundles.
+  ozz::animation::FloatTrackBundleSamplingJob o_sampling, i_sampling;
+  float o_results[2], i_results[2];
+  o_sampling.bundle = o_bundle.get();
+  o_sampling.results = ozz::make_span(o_results);
+  i_sampling.bundle = &i_bundle;
+  i_sampling.results = ozz::make_span(i_results);
+  for (int r = 0; r < 11; ++r) {
+    o_sampling.ratio = i_sampling.ratio = r * .1f;
+    ASSERT_TRUE(o_sampling.Run());
+    ASSERT_TRUE(i_sampling.Run());
+    EXPECT_FLOAT_EQ(o_results[0], i_results[0]);
+    EXPECT_FLOAT_EQ(o_results[1], i_results[1]);
+  }
+}
@@ -0,0 +1,209 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/track_binding.h"
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/raw_track.h"
+#include "ozz/animation/offline/track_builder.h"
+#include "ozz/animation/runtime/track_soa.h"
+#include "ozz/animation/runtime/track_soa_sampling_job.h"
+#include "ozz/base/memory/unique_ptr.h"
+#include "ozz/base/span.h"
+
+using ozz::animation::FloatTrackSoA;
+using ozz::animation::TrackBindingJob;
+using ozz::animation::TrackBindingSet;
+using ozz::animation::TrackSoASamplingJob;
+using ozz::animation::offline::RawFloatTrack;
+using ozz::animation::offline::RawTrackInterpolation;
+using ozz::animation::offline::TrackBuilder;
+
+namespace {
+
+// Builds a 3 named tracks aggregate: a linear ramp, a step track and a
+// constant one.
+ozz::unique_ptr<FloatTrackSoA> BuildTestTracks() {
+  RawFloatTrack raw_tracks[3];
+  raw_tracks[0].name = "ramp";
+  const RawFloatTrack::Keyframe ramp_keys[] = {
+      {RawTrackInterpolation::kLinear, 0.f, 0.f},
+      {RawTrackInterpolation::kLinear, 1.f, 1.f}};
+  raw_tracks[0].keyframes.assign(ramp_keys, ramp_keys + 2);
+  raw_tracks[1].name = "step";
+  const RawFloatTrack::Keyframe step_keys[] = {
+      {RawTrackInterpolation::kStep, .2f, 2.f},
+      {RawTrackInterpolation::kStep, .6f, 6.f}};
+  raw_tracks[1].keyframes.assign(step_keys, step_keys + 2);
+  raw_tracks[2].name = "constant";
+  const RawFloatTrack::Keyframe constant_key = {RawTrackInterpolation::kLinear,
+                                                .5f, 46.f};
+  raw_tracks[2].keyframes.push_back(constant_key);
+
+  TrackBuilder builder;
+  return builder(ozz::make_span(raw_tracks));
+}
+
+const char* kTrackNames[] = {"ramp", "step", "constant"};
+}  // namespace
+
+TEST(Bind, TrackBinding) {
+  TrackBindingSet bindings;
+  EXPECT_EQ(bindings.num_bindings(), 0u);
+  EXPECT_EQ(bindings.required_size(), 0u);
+
+  {  // Unresolved target name fails.
+    const TrackBindingSet::Target targets[] = {{"ramp", 0}, {"typo", 1}};
+    EXPECT_FALSE(
+        bindings.Bind(ozz::make_span(kTrackNames), ozz::make_span(targets)));
+    EXPECT_EQ(bindings.num_bindings(), 0u);
+  }
+
+  {  // Colliding offsets fail.
+    const TrackBindingSet::Target targets[] = {{"ramp", 3}, {"step", 3}};
+    EXPECT_FALSE(
+        bindings.Bind(ozz::make_span(kTrackNames), ozz::make_span(targets)));
+    EXPECT_EQ(bindings.num_bindings(), 0u);
+  }
+
+  {  // Binding no target at all is valid.
+    EXPECT_TRUE(bindings.Bind(ozz::make_span(kTrackNames), {}));
+    EXPECT_EQ(bindings.num_bindings(), 0u);
+    EXPECT_EQ(bindings.required_size(), 0u);
+  }
+
+  // A track can drive any number of properties, offsets can be sparse and
+  // unordered.
+  const TrackBindingSet::Target targets[] = {
+      {"constant", 4}, {"ramp", 0}, {"ramp", 2}};
+  ASSERT_TRUE(
+      bindings.Bind(ozz::make_span(kTrackNames), ozz::make_span(targets)));
+  EXPECT_EQ(bindings.num_bindings(), 3u);
+  EXPECT_EQ(bindings.required_size(), 5u);
+}
+
+TEST(Validate, TrackBinding) {
+  ozz::unique_ptr<FloatTrackSoA> tracks = BuildTestTracks();
+  ASSERT_TRUE(tracks);
+
+  TrackBindingSet bindings;
+  const TrackBindingSet::Target targets[] = {{"ramp", 0}, {"step", 1}};
+  ASSERT_TRUE(
+      bindings.Bind(ozz::make_span(kTrackNames), ozz::make_span(targets)));
+
+  float output[2];
+  {  // Missing tracks.
+    TrackBindingJob job;
+    job.bindings = &bindings;
+    job.output = output;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+  {  // Missing bindings.
+    TrackBindingJob job;
+    job.tracks = tracks.get();
+    job.output = output;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+  {  // Too small output.
+    TrackBindingJob job;
+    job.tracks = tracks.get();
+    job.bindings = &bindings;
+    job.output = {output, 1};
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+  {  // Bindings resolved against more tracks than evaluated ones.
+    const char* more_names[] = {"ramp", "step", "constant", "extra"};
+    TrackBindingSet more_bindings;
+    const TrackBindingSet::Target extra_target[] = {{"extra", 0}};
+    ASSERT_TRUE(more_bindings.Bind(ozz::make_span(more_names),
+                                   ozz::make_span(extra_target)));
+    TrackBindingJob job;
+    job.tracks = tracks.get();
+    job.bindings = &more_bindings;
+    job.output = output;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+  {  // Valid job.
+    TrackBindingJob job;
+    job.tracks = tracks.get();
+    job.bindings = &bindings;
+    job.output = output;
+    EXPECT_TRUE(job.Validate());
+    EXPECT_TRUE(job.Run());
+  }
+}
+
+TEST(Run, TrackBinding) {
+  ozz::unique_ptr<FloatTrackSoA> tracks = BuildTestTracks();
+  ASSERT_TRUE(tracks);
+
+  // Binds the 3 tracks to a sparse output block, leaving holes, with the
+  // ramp driving 2 properties.
+  TrackBindingSet bindings;
+  const TrackBindingSet::Target targets[] = {
+      {"step", 1}, {"ramp", 2}, {"constant", 3}, {"ramp", 5}};
+  ASSERT_TRUE(
+      bindings.Bind(ozz::make_span(kTrackNames), ozz::make_span(targets)));
+  ASSERT_EQ(bindings.required_size(), 6u);
+
+  TrackBindingJob job;
+  job.tracks = tracks.get();
+  job.bindings = &bindings;
+  float output[6];
+  job.output = output;
+
+  // Bound outputs match a full SoA sampling, unbound floats are untouched,
+  // whatever the ratio.
+  for (int i = -1; i < 102; ++i) {
+    const float ratio = i / 100.f;
+
+    float sampled[3];
+    TrackSoASamplingJob sampling;
+    sampling.ratio = ratio;
+    sampling.tracks = tracks.get();
+    sampling.results = sampled;
+    ASSERT_TRUE(sampling.Run());
+
+    const float kUntouched = -99.f;
+    for (size_t o = 0; o < OZZ_ARRAY_SIZE(output); ++o) {
+      output[o] = kUntouched;
+    }
+    job.ratio = ratio;
+    ASSERT_TRUE(job.Run());
+
+    EXPECT_FLOAT_EQ(output[0], kUntouched);
+    EXPECT_FLOAT_EQ(output[1], sampled[1]);
+    EXPECT_FLOAT_EQ(output[2], sampled[0]);
+    EXPECT_FLOAT_EQ(output[3], sampled[2]);
+    EXPECT_FLOAT_EQ(output[4], kUntouched);
+    EXPECT_FLOAT_EQ(output[5], sampled[0]);
+  }
+}
@@ -35,6 +35,7 @@
 #include "ozz/animation/offline/raw_track.h"
 #include "ozz/animation/offline/track_builder.h"
 
+#include "ozz/animation/runtime/quantized_track.h"
 #include "ozz/animation/runtime/track.h"
 
 using ozz::animation::FloatTrack;
@@ -43,6 +44,8 @@ using ozz::animation::Float3Track;
 using ozz::animation::Float4Track;
 using ozz::animation::QuaternionTrack;
 using ozz::animation::FloatTrackSamplingJob;
+using ozz::animation::QuantizedFloatTrack;
+using ozz::animation::QuantizedFloatTrackSamplingJob;
 using ozz::animation::offline::RawFloatTrack;
 using ozz::animation::offline::TrackBuilder;
 using ozz::animation::offline::RawTrackInterpolation;
@@ -465,3 +468,257 @@ TEST(Quaternion, TrackSamplingJob) {
   ASSERT_TRUE(sampling.Run());
   EXPECT_QUATERNION_EQ(result, 0.f, 0.f, 0.f, 1.f);
 }
+
+TEST(QuaternionMulti, TrackSamplingJob) {
+  TrackBuilder builder;
+
+  // Same track as the Quaternion test, mixing linear and step keys.
+  ozz::animation::offline::RawQuaternionTrack raw_track;
+  const ozz::animation::offline::RawQuaternionTrack::Keyframe key0 = {
+      RawTrackInterpolation::kLinear, 0.f,
+      ozz::math::Quaternion(.70710677f, 0.f, 0.f, .70710677f)};
+  raw_track.keyframes.push_back(key0);
+  const ozz::animation::offline::RawQuaternionTrack::Keyframe key1 = {
+      RawTrackInterpolation::kStep, .5f,
+      ozz::math::Quaternion(0.f, .70710677f, 0.f, .70710677f)};
+  raw_track.keyframes.push_back(key1);
+  const ozz::animation::offline::RawQuaternionTrack::Keyframe key2 = {
+      RawTrackInterpolation::kLinear, .7f,
+      ozz::math::Quaternion(.70710677f, 0.f, 0.f, .70710677f)};
+  raw_track.keyframes.push_back(key2);
+  const ozz::animation::offline::RawQuaternionTrack::Keyframe key3 = {
+      RawTrackInterpolation::kLinear, .9f, ozz::math::Quaternion::identity()};
+  raw_track.keyframes.push_back(key3);
+
+  ozz::unique_ptr<QuaternionTrack> track(builder(raw_track));
+  ASSERT_TRUE(track);
+
+  // A smoothing window worth of ratios, vectorized groups plus a scalar
+  // tail, crossing linear and step intervals.
+  const float ratios[] = {0.f, .1f, .4999999f, .5f, .6f, .7f, .8f, .9f, 1.f};
+  const size_t kNumRatios = OZZ_ARRAY_SIZE(ratios);
+  ozz::math::Quaternion results[kNumRatios];
+
+  ozz::animation::QuaternionTrackMultiSamplingJob multi;
+
+  // Missing track or too small results fail.
+  EXPECT_FALSE(multi.Run());
+  multi.track = track.get();
+  multi.ratios = ratios;
+  multi.results = ozz::span<ozz::math::Quaternion>(results, kNumRatios - 1);
+  EXPECT_FALSE(multi.Run());
+  multi.results = results;
+  ASSERT_TRUE(multi.Run());
+
+  // Every sample matches the single ratio job.
+  ozz::animation::QuaternionTrackSamplingJob single;
+  single.track = track.get();
+  ozz::math::Quaternion expected;
+  single.result = &expected;
+  for (size_t i = 0; i < kNumRatios; ++i) {
+    single.ratio = ratios[i];
+    ASSERT_TRUE(single.Run());
+    EXPECT_QUATERNION_EQ(results[i], expected.x, expected.y, expected.z,
+                         expected.w);
+  }
+
+  // The context is shared across the sampled ratios and runs.
+  ozz::animation::TrackSamplingContext context;
+  multi.context = &context;
+  ASSERT_TRUE(multi.Run());
+  EXPECT_QUATERNION_EQ(results[1], .61721331f, .15430345f, 0.f, .77151674f);
+
+  // Unsorted ratios are valid, just slower.
+  const float unsorted[] = {.9f, .1f, .8f, .1f};
+  multi.ratios = unsorted;
+  ASSERT_TRUE(multi.Run());
+  EXPECT_QUATERNION_EQ(results[1], .61721331f, .15430345f, 0.f, .77151674f);
+  EXPECT_QUATERNION_EQ(results[2], .38268333f, 0.f, 0.f, .92387962f);
+
+  // Empty ratios is a no-op.
+  multi.ratios = {};
+  EXPECT_TRUE(multi.Run());
+
+  // Default (empty) track samples identity for every ratio.
+  ozz::animation::offline::RawQuaternionTrack raw_default;
+  ozz::unique_ptr<QuaternionTrack> default_track(builder(raw_default));
+  ASSERT_TRUE(default_track);
+  // Builder patches empty tracks with identity keys, so strips them to get
+  // an empty runtime track through the default constructed one.
+  const QuaternionTrack empty_track;
+  multi.track = &empty_track;
+  multi.context = nullptr;
+  multi.ratios = ratios;
+  ASSERT_TRUE(multi.Run());
+  EXPECT_QUATERNION_EQ(results[4], 0.f, 0.f, 0.f, 1.f);
+}
+
+TEST(Context, TrackSamplingJob) {
+  TrackBuilder builder;
+
+  // Builds track
+  RawFloatTrack raw_track;
+  const RawFloatTrack::Keyframe key0 = {RawTrackInterpolation::kLinear, 0.f,
+                                        0.f};
+  raw_track.keyframes.push_back(key0);
+  const RawFloatTrack::Keyframe key1 = {RawTrackInterpolation::kStep, .5f, 46.f};
+  raw_track.keyframes.push_back(key1);
+  const RawFloatTrack::Keyframe key2 = {RawTrackInterpolation::kLinear, .7f,
+                                        0.f};
+  raw_track.keyframes.push_back(key2);
+  ozz::unique_ptr<FloatTrack> track(builder(raw_track));
+  ASSERT_TRUE(track);
+
+  float result;
+  FloatTrackSamplingJob sampling;
+  sampling.track = track.get();
+  sampling.result = &result;
+
+  float context_result;
+  ozz::animation::TrackSamplingContext context;
+  FloatTrackSamplingJob context_sampling;
+  context_sampling.track = track.get();
+  context_sampling.context = &context;
+  context_sampling.result = &context_result;
+
+  // Sequential forward sampling, the coherent case the context optimizes.
+  for (int i = 0; i < 101; ++i) {
+    const float ratio = i * .01f;
+    sampling.ratio = ratio;
+    ASSERT_TRUE(sampling.Run());
+    context_sampling.ratio = ratio;
+    ASSERT_TRUE(context_sampling.Run());
+    EXPECT_FLOAT_EQ(result, context_result);
+  }
+
+  // Backward and random seeks fall back to the binary search.
+  const float seeks[] = {1.f, .5f, .7f, 0.f, .69f, .2f, .5f - 1e-7f, 1.f, .3f};
+  for (size_t i = 0; i < OZZ_ARRAY_SIZE(seeks); ++i) {
+    sampling.ratio = seeks[i];
+    ASSERT_TRUE(sampling.Run());
+    context_sampling.ratio = seeks[i];
+    ASSERT_TRUE(context_sampling.Run());
+    EXPECT_FLOAT_EQ(result, context_result);
+  }
+
+  // Invalidating the context doesn't affect sampling results.
+  context.Invalidate();
+  sampling.ratio = context_sampling.ratio = .8f;
+  ASSERT_TRUE(sampling.Run());
+  ASSERT_TRUE(context_sampling.Run());
+  EXPECT_FLOAT_EQ(result, context_result);
+
+  // Reusing the context with a different track remains correct, as the cached
+  // interval is validated against the sampled track.
+  RawFloatTrack raw_track2;
+  const RawFloatTrack::Keyframe key3 = {RawTrackInterpolation::kLinear, .9f,
+                                        99.f};
+  raw_track2.keyframes.push_back(key3);
+  ozz::unique_ptr<FloatTrack> track2(builder(raw_track2));
+  ASSERT_TRUE(track2);
+  sampling.track = context_sampling.track = track2.get();
+  sampling.ratio = context_sampling.ratio = .5f;
+  ASSERT_TRUE(sampling.Run());
+  ASSERT_TRUE(context_sampling.Run());
+  EXPECT_FLOAT_EQ(result, context_result);
+}
+
+TEST(Quantized, TrackSamplingJob) {
+  TrackBuilder builder;
+
+  {  // Default track values are identity.
+    RawFloatTrack raw_track;
+    ozz::unique_ptr<QuantizedFloatTrack> track(
+        builder(raw_track, QuantizedFloatTrack::kFloat16));
+    ASSERT_TRUE(track);
+
+    float result;
+    QuantizedFloatTrackSamplingJob sampling;
+
+    {  // Invalid, no track.
+      sampling.result = &result;
+      EXPECT_FALSE(sampling.Validate());
+      EXPECT_FALSE(sampling.Run());
+    }
+
+    {  // Invalid, no result.
+      sampling.track = track.get();
+      sampling.result = nullptr;
+      EXPECT_FALSE(sampling.Validate());
+      EXPECT_FALSE(sampling.Run());
+    }
+
+    sampling.track = track.get();
+    sampling.result = &result;
+    sampling.ratio = .5f;
+    ASSERT_TRUE(sampling.Run());
+    EXPECT_FLOAT_EQ(result, 0.f);
+  }
+
+  // Builds a mixed linear/step track.
+  RawFloatTrack raw_track;
+  const RawFloatTrack::Keyframe key0 = {RawTrackInterpolation::kLinear, 0.f,
+                                        0.f};
+  raw_track.keyframes.push_back(key0);
+  const RawFloatTrack::Keyframe key1 = {RawTrackInterpolation::kStep, .5f,
+                                        46.f};
+  raw_track.keyframes.push_back(key1);
+  const RawFloatTrack::Keyframe key2 = {RawTrackInterpolation::kLinear, .7f,
+                                        -12.f};
+  raw_track.keyframes.push_back(key2);
+
+  // Builds reference and quantized tracks.
+  ozz::unique_ptr<FloatTrack> ref_track(builder(raw_track));
+  ASSERT_TRUE(ref_track);
+  const QuantizedFloatTrack::Format formats[] = {
+      QuantizedFloatTrack::kFloat16, QuantizedFloatTrack::kNormalized};
+  for (size_t f = 0; f < OZZ_ARRAY_SIZE(formats); ++f) {
+    ozz::unique_ptr<QuantizedFloatTrack> track(builder(raw_track, formats[f]));
+    ASSERT_TRUE(track);
+    EXPECT_EQ(track->format(), formats[f]);
+
+    // Quantized storage is half the size of float storage.
+    EXPECT_EQ(track->values().size_bytes(),
+              ref_track->values().size_bytes() / 2);
+
+    float ref_result;
+    FloatTrackSamplingJob ref_sampling;
+    ref_sampling.track = ref_track.get();
+    ref_sampling.result = &ref_result;
+
+    float result;
+    QuantizedFloatTrackSamplingJob sampling;
+    sampling.track = track.get();
+    sampling.result = &result;
+
+    float context_result;
+    ozz::animation::TrackSamplingContext context;
+    QuantizedFloatTrackSamplingJob context_sampling;
+    context_sampling.track = track.get();
+    context_sampling.context = &context;
+    context_sampling.result = &context_result;
+
+    // Samples both tracks, quantized results shall match within quantization
+    // precision, with or without a context.
+    for (int i = -1; i < 102; ++i) {
+      const float ratio = i * .01f;
+      ref_sampling.ratio = ratio;
+      ASSERT_TRUE(ref_sampling.Run());
+      sampling.ratio = ratio;
+      ASSERT_TRUE(sampling.Run());
+      EXPECT_NEAR(ref_result, result, .1f);
+      context_sampling.ratio = ratio;
+      ASSERT_TRUE(context_sampling.Run());
+      EXPECT_FLOAT_EQ(result, context_result);
+    }
+
+    // Step discontinuity is preserved exactly (key values are decompressed,
+    // not interpolated).
+    sampling.ratio = .5f;
+    ASSERT_TRUE(sampling.Run());
+    EXPECT_NEAR(result, 46.f, .05f);
+    sampling.ratio = .7f;
+    ASSERT_TRUE(sampling.Run());
+    EXPECT_NEAR(result, -12.f, .05f);
+  }
+}
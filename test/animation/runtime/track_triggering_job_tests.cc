@@ -25,16 +25,23 @@
 //                                                                            //
 //----------------------------------------------------------------------------//
 
+#include <algorithm>
+
 #include "gtest/gtest.h"
 #include "ozz/animation/offline/raw_track.h"
 #include "ozz/animation/offline/track_builder.h"
 #include "ozz/animation/runtime/track.h"
+#include "ozz/animation/runtime/track_edge_index.h"
 #include "ozz/animation/runtime/track_triggering_job.h"
 #include "ozz/base/gtest_helper.h"
 #include "ozz/base/maths/gtest_math_helper.h"
 #include "ozz/base/memory/unique_ptr.h"
 
 using ozz::animation::FloatTrack;
+using ozz::animation::MultiTrackEdgeTriggeringJob;
+using ozz::animation::TrackEdgeIndex;
+using ozz::animation::TrackEdgePrefilterJob;
+using ozz::animation::TrackEdgeTriggeringJob;
 using ozz::animation::TrackTriggeringJob;
 using ozz::animation::offline::RawFloatTrack;
 using ozz::animation::offline::RawTrackInterpolation;
@@ -98,6 +105,379 @@ TEST(JobValidity, TrackTriggeringJob) {
   }
 }
 
+TEST(JobValidity, TrackEdgeTriggeringJob) {
+  // Builds edge index
+  ozz::animation::offline::RawFloatTrack raw_track;
+  TrackBuilder builder;
+  ozz::unique_ptr<TrackEdgeIndex> index(builder(raw_track, 1.f));
+  ASSERT_TRUE(index);
+
+  TrackTriggeringJob::Edge buffer[8];
+
+  {  // Default is invalid
+    TrackEdgeTriggeringJob job;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // No index
+    TrackEdgeTriggeringJob job;
+    ozz::span<TrackTriggeringJob::Edge> edges = ozz::make_span(buffer);
+    job.edges = &edges;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // No edges output
+    TrackEdgeTriggeringJob job;
+    job.index = index.get();
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // Valid
+    TrackEdgeTriggeringJob job;
+    job.index = index.get();
+    ozz::span<TrackTriggeringJob::Edge> edges = ozz::make_span(buffer);
+    job.edges = &edges;
+    EXPECT_TRUE(job.Validate());
+    EXPECT_TRUE(job.Run());
+    EXPECT_EQ(edges.size(), 0u);  // Default track has no edge.
+  }
+}
+
+TEST(JobValidity, MultiTrackEdgeTriggeringJob) {
+  // Builds edge index
+  ozz::animation::offline::RawFloatTrack raw_track;
+  TrackBuilder builder;
+  ozz::unique_ptr<TrackEdgeIndex> index(builder(raw_track, 1.f));
+  ASSERT_TRUE(index);
+
+  MultiTrackEdgeTriggeringJob::TrackEdge buffer[8];
+
+  {  // Default is invalid
+    MultiTrackEdgeTriggeringJob job;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // No edges output
+    MultiTrackEdgeTriggeringJob job;
+    const TrackEdgeIndex* indices[] = {index.get()};
+    job.indices = ozz::make_span(indices);
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // nullptr index
+    MultiTrackEdgeTriggeringJob job;
+    const TrackEdgeIndex* indices[] = {index.get(), nullptr};
+    job.indices = ozz::make_span(indices);
+    ozz::span<MultiTrackEdgeTriggeringJob::TrackEdge> edges =
+        ozz::make_span(buffer);
+    job.edges = &edges;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // Empty indices is valid
+    MultiTrackEdgeTriggeringJob job;
+    ozz::span<MultiTrackEdgeTriggeringJob::TrackEdge> edges =
+        ozz::make_span(buffer);
+    job.edges = &edges;
+    EXPECT_TRUE(job.Validate());
+    EXPECT_TRUE(job.Run());
+    EXPECT_EQ(edges.size(), 0u);
+  }
+
+  {  // Valid
+    MultiTrackEdgeTriggeringJob job;
+    const TrackEdgeIndex* indices[] = {index.get()};
+    job.indices = ozz::make_span(indices);
+    ozz::span<MultiTrackEdgeTriggeringJob::TrackEdge> edges =
+        ozz::make_span(buffer);
+    job.edges = &edges;
+    EXPECT_TRUE(job.Validate());
+    EXPECT_TRUE(job.Run());
+    EXPECT_EQ(edges.size(), 0u);  // Default track has no edge.
+  }
+}
+
+TEST(JobValidity, TrackEdgePrefilterJob) {
+  // Builds edge index
+  ozz::animation::offline::RawFloatTrack raw_track;
+  TrackBuilder builder;
+  ozz::unique_ptr<TrackEdgeIndex> index(builder(raw_track, 1.f));
+  ASSERT_TRUE(index);
+
+  const TrackEdgeIndex* indices[2] = {index.get(), index.get()};
+  const float froms[2] = {0.f, 0.f};
+  const float tos[2] = {1.f, 1.f};
+  ozz::byte candidates[1];
+
+  {  // Default is valid, it just has nothing to do.
+    TrackEdgePrefilterJob job;
+    EXPECT_TRUE(job.Validate());
+    EXPECT_TRUE(job.Run());
+  }
+
+  {  // Mismatching range sizes.
+    TrackEdgePrefilterJob job;
+    job.indices = ozz::make_span(indices);
+    job.froms = ozz::span<const float>(froms, 1);
+    job.tos = ozz::make_span(tos);
+    job.candidates = candidates;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // Too small candidates bitset.
+    TrackEdgePrefilterJob job;
+    job.indices = ozz::make_span(indices);
+    job.froms = ozz::make_span(froms);
+    job.tos = ozz::make_span(tos);
+    job.candidates = ozz::span<ozz::byte>(candidates, size_t(0));
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // nullptr index.
+    TrackEdgePrefilterJob job;
+    const TrackEdgeIndex* invalid_indices[2] = {index.get(), nullptr};
+    job.indices = ozz::make_span(invalid_indices);
+    job.froms = ozz::make_span(froms);
+    job.tos = ozz::make_span(tos);
+    job.candidates = candidates;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // Valid.
+    TrackEdgePrefilterJob job;
+    job.indices = ozz::make_span(indices);
+    job.froms = ozz::make_span(froms);
+    job.tos = ozz::make_span(tos);
+    job.candidates = candidates;
+    EXPECT_TRUE(job.Validate());
+    EXPECT_TRUE(job.Run());
+    EXPECT_EQ(candidates[0] & 3, 0);  // Default track has no edge.
+  }
+}
+
+TEST(Prefilter, TrackEdgePrefilterJob) {
+  TrackBuilder builder;
+
+  // Square wave track with edges at .5 and 1.
+  ozz::animation::offline::RawFloatTrack raw_track;
+  const ozz::animation::offline::RawFloatTrack::Keyframe key0 = {
+      RawTrackInterpolation::kStep, 0.f, 0.f};
+  raw_track.keyframes.push_back(key0);
+  const ozz::animation::offline::RawFloatTrack::Keyframe key1 = {
+      RawTrackInterpolation::kStep, .5f, 2.f};
+  raw_track.keyframes.push_back(key1);
+  const ozz::animation::offline::RawFloatTrack::Keyframe key2 = {
+      RawTrackInterpolation::kStep, 1.f, 0.f};
+  raw_track.keyframes.push_back(key2);
+  ozz::unique_ptr<TrackEdgeIndex> index(builder(raw_track, 1.f));
+  ASSERT_TRUE(index);
+
+  // Flat track, no edge at all.
+  ozz::animation::offline::RawFloatTrack raw_flat;
+  ozz::unique_ptr<TrackEdgeIndex> flat_index(builder(raw_flat, 1.f));
+  ASSERT_TRUE(flat_index);
+
+  {  // Edge-less tracks are always filtered out, whatever the window.
+    EXPECT_EQ(flat_index->edge_buckets(), 0u);
+  }
+
+  // 10 entries (crosses the byte boundary of the bitset) alternating both
+  // tracks, with windows moving along the tracks.
+  const size_t kNumEntries = 10;
+  const TrackEdgeIndex* indices[kNumEntries];
+  float froms[kNumEntries];
+  float tos[kNumEntries];
+  for (size_t i = 0; i < kNumEntries; ++i) {
+    indices[i] = (i & 1) ? flat_index.get() : index.get();
+    froms[i] = i * .1f;
+    tos[i] = i * .1f + .05f;
+  }
+
+  ozz::byte candidates[(kNumEntries + 7) / 8];
+  TrackEdgePrefilterJob job;
+  job.indices = ozz::make_span(indices);
+  job.froms = ozz::make_span(froms);
+  job.tos = ozz::make_span(tos);
+  job.candidates = candidates;
+  ASSERT_TRUE(job.Run());
+
+  // The prefilter is conservative: an entry whose bit is cleared must have no
+  // edge at all in its window, verified against the exact triggering job.
+  size_t num_candidates = 0;
+  for (size_t i = 0; i < kNumEntries; ++i) {
+    const bool candidate = (candidates[i / 8] >> (i & 7)) & 1;
+    num_candidates += candidate;
+
+    TrackEdgeTriggeringJob exact;
+    exact.from = froms[i];
+    exact.to = tos[i];
+    exact.index = indices[i];
+    TrackTriggeringJob::Edge buffer[8];
+    ozz::span<TrackTriggeringJob::Edge> edges = ozz::make_span(buffer);
+    exact.edges = &edges;
+    ASSERT_TRUE(exact.Run());
+    if (!candidate) {
+      EXPECT_EQ(edges.size(), 0u);
+    }
+  }
+  // Flat track entries never pass the filter, so at most half the entries do.
+  EXPECT_LE(num_candidates, kNumEntries / 2);
+
+  {  // Sweeps windows of various lengths and offsets over the square track,
+     // checking conservativeness (no false negative) everywhere, including
+     // multi loop, backward and empty windows.
+    const float ranges[][2] = {{0.f, 1.f},    {1.f, 0.f},   {0.f, .49f},
+                               {.51f, .99f},  {.45f, .55f}, {-.25f, .25f},
+                               {.9f, 1.6f},   {0.f, 2.f},   {3.75f, .25f},
+                               {.5f, .5f},    {.2f, .3f},   {-2.4f, -2.3f}};
+    for (size_t r = 0; r < OZZ_ARRAY_SIZE(ranges); ++r) {
+      const TrackEdgeIndex* single_index[1] = {index.get()};
+      const float from = ranges[r][0];
+      const float to = ranges[r][1];
+      ozz::byte candidate_bit[1];
+      TrackEdgePrefilterJob sweep;
+      sweep.indices = ozz::make_span(single_index);
+      sweep.froms = ozz::span<const float>(&from, 1);
+      sweep.tos = ozz::span<const float>(&to, 1);
+      sweep.candidates = candidate_bit;
+      ASSERT_TRUE(sweep.Run());
+
+      TrackEdgeTriggeringJob exact;
+      exact.from = from;
+      exact.to = to;
+      exact.index = index.get();
+      TrackTriggeringJob::Edge buffer[16];
+      ozz::span<TrackTriggeringJob::Edge> edges = ozz::make_span(buffer);
+      exact.edges = &edges;
+      ASSERT_TRUE(exact.Run());
+      if (!(candidate_bit[0] & 1)) {
+        EXPECT_EQ(edges.size(), 0u);
+      }
+    }
+  }
+}
+
+TEST(Merge, MultiTrackEdgeTriggeringJob) {
+  TrackBuilder builder;
+
+  // First track, square wave with edges at .5 and 1.
+  ozz::animation::offline::RawFloatTrack raw_track0;
+  const ozz::animation::offline::RawFloatTrack::Keyframe key00 = {
+      RawTrackInterpolation::kStep, 0.f, 0.f};
+  raw_track0.keyframes.push_back(key00);
+  const ozz::animation::offline::RawFloatTrack::Keyframe key01 = {
+      RawTrackInterpolation::kStep, .5f, 2.f};
+  raw_track0.keyframes.push_back(key01);
+  const ozz::animation::offline::RawFloatTrack::Keyframe key02 = {
+      RawTrackInterpolation::kStep, 1.f, 0.f};
+  raw_track0.keyframes.push_back(key02);
+  ozz::unique_ptr<TrackEdgeIndex> index0(builder(raw_track0, 1.f));
+  ASSERT_TRUE(index0);
+
+  // Second track, square wave with edges at .25, .5 (same ratio as track 0)
+  // and .75.
+  ozz::animation::offline::RawFloatTrack raw_track1;
+  const ozz::animation::offline::RawFloatTrack::Keyframe key10 = {
+      RawTrackInterpolation::kStep, 0.f, 0.f};
+  raw_track1.keyframes.push_back(key10);
+  const ozz::animation::offline::RawFloatTrack::Keyframe key11 = {
+      RawTrackInterpolation::kStep, .25f, 2.f};
+  raw_track1.keyframes.push_back(key11);
+  const ozz::animation::offline::RawFloatTrack::Keyframe key12 = {
+      RawTrackInterpolation::kStep, .5f, 0.f};
+  raw_track1.keyframes.push_back(key12);
+  const ozz::animation::offline::RawFloatTrack::Keyframe key13 = {
+      RawTrackInterpolation::kStep, .75f, 2.f};
+  raw_track1.keyframes.push_back(key13);
+  ozz::unique_ptr<TrackEdgeIndex> index1(builder(raw_track1, 1.f));
+  ASSERT_TRUE(index1);
+
+  const TrackEdgeIndex* indices[] = {index0.get(), index1.get()};
+
+  MultiTrackEdgeTriggeringJob job;
+  job.indices = ozz::make_span(indices);
+
+  MultiTrackEdgeTriggeringJob::TrackEdge buffer[64];
+
+  const float ranges[][2] = {{0.f, 1.f},   {1.f, 0.f},  {0.f, .5f},
+                             {.25f, .75f}, {0.f, 2.f},  {2.f, 0.f},
+                             {-1.f, 1.f},  {.5f, .5f},  {.25f, 3.25f},
+                             {3.75f, .25f}};
+  for (size_t i = 0; i < OZZ_ARRAY_SIZE(ranges); ++i) {
+    job.from = ranges[i][0];
+    job.to = ranges[i][1];
+
+    // Collects reference edges from each track independently.
+    ozz::vector<MultiTrackEdgeTriggeringJob::TrackEdge> ref_edges;
+    for (size_t t = 0; t < OZZ_ARRAY_SIZE(indices); ++t) {
+      TrackEdgeTriggeringJob single;
+      single.from = job.from;
+      single.to = job.to;
+      single.index = indices[t];
+      TrackTriggeringJob::Edge single_buffer[32];
+      ozz::span<TrackTriggeringJob::Edge> single_edges =
+          ozz::make_span(single_buffer);
+      single.edges = &single_edges;
+      ASSERT_TRUE(single.Run());
+      for (size_t e = 0; e < single_edges.size(); ++e) {
+        const MultiTrackEdgeTriggeringJob::TrackEdge edge = {
+            single_edges[e].ratio, single_edges[e].rising, static_cast<int>(t)};
+        ref_edges.push_back(edge);
+      }
+    }
+
+    // Sorts reference edges as the job specifies: from "from" to "to", edges
+    // at the very same ratio ordered by track index. std::stable_sort
+    // preserves per-track order for equal (ratio, track) keys.
+    const bool forward = job.to >= job.from;
+    std::stable_sort(
+        ref_edges.begin(), ref_edges.end(),
+        [forward](const MultiTrackEdgeTriggeringJob::TrackEdge& _a,
+                  const MultiTrackEdgeTriggeringJob::TrackEdge& _b) {
+          if (_a.ratio != _b.ratio) {
+            return forward ? _a.ratio < _b.ratio : _a.ratio > _b.ratio;
+          }
+          return _a.track < _b.track;
+        });
+
+    // Bulk retrieval shall find the same edges, merged and sorted.
+    ozz::span<MultiTrackEdgeTriggeringJob::TrackEdge> edges =
+        ozz::make_span(buffer);
+    job.edges = &edges;
+    ASSERT_TRUE(job.Run());
+    ASSERT_EQ(edges.size(), ref_edges.size());
+    for (size_t e = 0; e < edges.size(); ++e) {
+      EXPECT_FLOAT_EQ(edges[e].ratio, ref_edges[e].ratio);
+      EXPECT_EQ(edges[e].rising, ref_edges[e].rising);
+      EXPECT_EQ(edges[e].track, ref_edges[e].track);
+    }
+
+    // A too small buffer fails, but is filled (and sorted) to its capacity.
+    if (!ref_edges.empty()) {
+      ozz::span<MultiTrackEdgeTriggeringJob::TrackEdge> small =
+          ozz::make_span(buffer).first(ref_edges.size() - 1);
+      job.edges = &small;
+      ASSERT_FALSE(job.Run());
+      ASSERT_EQ(small.size(), ref_edges.size() - 1);
+      for (size_t e = 1; e < small.size(); ++e) {
+        const bool ordered = forward
+                                 ? small[e - 1].ratio <= small[e].ratio
+                                 : small[e - 1].ratio >= small[e].ratio;
+        EXPECT_TRUE(ordered);
+      }
+    }
+  }
+}
+
 TEST(Default, TrackEdgeTriggerJob) {
   FloatTrack default_track;
   TrackTriggeringJob job;
@@ -927,12 +1307,74 @@ void TestEdgesExpectation(
   }
 }
 
+void TestEdgeIndexEquivalence(
+    const ozz::animation::offline::RawFloatTrack& _raw_track,
+    float _threshold) {
+  // Builds track and its precomputed edge index.
+  ozz::unique_ptr<FloatTrack> track(TrackBuilder()(_raw_track));
+  ASSERT_TRUE(track);
+  ozz::unique_ptr<TrackEdgeIndex> index(TrackBuilder()(_raw_track, _threshold));
+  ASSERT_TRUE(index);
+  EXPECT_FLOAT_EQ(index->threshold(), _threshold);
+
+  TrackTriggeringJob ref_job;
+  ref_job.track = track.get();
+  ref_job.threshold = _threshold;
+
+  TrackEdgeTriggeringJob job;
+  job.index = index.get();
+
+  const float ranges[][2] = {
+      {0.f, 1.f},  {1.f, 0.f},   {0.f, .5f},   {.25f, .75f}, {.75f, .25f},
+      {0.f, 2.f},  {2.f, 0.f},   {-1.f, 1.f},  {1.5f, -.5f}, {.25f, 3.25f},
+      {.5f, .5f},  {46.f, 46.f}, {1.f, 2.f},   {-1.f, -2.f}, {.5f, 1.f},
+      {1.f, 1.5f}, {0.f, 4.f},   {3.75f, .25f}};
+  for (size_t i = 0; i < OZZ_ARRAY_SIZE(ranges); ++i) {
+    ref_job.from = job.from = ranges[i][0];
+    ref_job.to = job.to = ranges[i][1];
+
+    // Collects reference edges from the iterator based job.
+    ozz::vector<TrackTriggeringJob::Edge> ref_edges;
+    TrackTriggeringJob::Iterator iterator;
+    ref_job.iterator = &iterator;
+    ASSERT_TRUE(ref_job.Run());
+    for (; iterator != ref_job.end(); ++iterator) {
+      ref_edges.push_back(*iterator);
+    }
+
+    // Bulk retrieval shall find the exact same edges, in the same order.
+    TrackTriggeringJob::Edge buffer[256];
+    ozz::span<TrackTriggeringJob::Edge> edges = ozz::make_span(buffer);
+    job.edges = &edges;
+    ASSERT_TRUE(job.Run());
+    ASSERT_EQ(edges.size(), ref_edges.size());
+    for (size_t e = 0; e < edges.size(); ++e) {
+      EXPECT_FLOAT_EQ(edges[e].ratio, ref_edges[e].ratio);
+      EXPECT_EQ(edges[e].rising, ref_edges[e].rising);
+    }
+
+    // A too small buffer fails, but is filled to its capacity.
+    if (!ref_edges.empty()) {
+      ozz::span<TrackTriggeringJob::Edge> small =
+          ozz::make_span(buffer).first(ref_edges.size() - 1);
+      job.edges = &small;
+      ASSERT_FALSE(job.Run());
+      ASSERT_EQ(small.size(), ref_edges.size() - 1);
+      for (size_t e = 0; e < small.size(); ++e) {
+        EXPECT_FLOAT_EQ(small[e].ratio, ref_edges[e].ratio);
+        EXPECT_EQ(small[e].rising, ref_edges[e].rising);
+      }
+    }
+  }
+}
+
 template <size_t _size>
 inline void TestEdgesExpectation(
     const ozz::animation::offline::RawFloatTrack& _raw_track, float _threshold,
     const TrackTriggeringJob::Edge (&_expected)[_size]) {
   static_assert(_size >= 2, "Minimum 2 edges.");
   TestEdgesExpectation(_raw_track, _threshold, _expected, _size);
+  TestEdgeIndexEquivalence(_raw_track, _threshold);
 }
 
 TEST(SquareStep, TrackEdgeTriggerJob) {
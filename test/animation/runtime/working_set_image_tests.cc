@@ -0,0 +1,191 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/animation/runtime/working_set_image.h"
+
+#include "gtest/gtest.h"
+#include "ozz/animation/offline/animation_builder.h"
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/base/maths/gtest_math_helper.h"
+#include "ozz/base/maths/simd_math.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/memory/unique_ptr.h"
+
+using ozz::animation::Animation;
+using ozz::animation::SamplingJob;
+using ozz::animation::WorkingSetImage;
+using ozz::animation::offline::AnimationBuilder;
+using ozz::animation::offline::RawAnimation;
+
+namespace {
+
+// Builds a single track animation translating from _x to 2 * _x over
+// _duration seconds, so animations built with different arguments are
+// distinguishable.
+ozz::unique_ptr<Animation> BuildTestAnimation(float _x, float _duration) {
+  RawAnimation raw_animation;
+  raw_animation.duration = _duration;
+  raw_animation.tracks.resize(1);
+  const RawAnimation::TranslationKey t_key0 = {0.f,
+                                               ozz::math::Float3(_x, 0.f, 0.f)};
+  raw_animation.tracks[0].translations.push_back(t_key0);
+  const RawAnimation::TranslationKey t_key1 = {
+      _duration, ozz::math::Float3(2.f * _x, 0.f, 0.f)};
+  raw_animation.tracks[0].translations.push_back(t_key1);
+  AnimationBuilder builder;
+  return builder(raw_animation);
+}
+
+// Samples _animation at _ratio with _context, returning the x component of
+// the first track translation.
+float Sample(const Animation& _animation, float _ratio,
+             SamplingJob::Context* _context) {
+  ozz::math::SoaTransform output[1];
+  SamplingJob job;
+  job.animation = &_animation;
+  job.context = _context;
+  job.ratio = _ratio;
+  job.output = output;
+  EXPECT_TRUE(job.Run());
+  return ozz::math::GetX(output[0].translation.x);
+}
+
+// Allocates a 16 bytes aligned buffer of at least _size bytes.
+struct AlignedBuffer {
+  explicit AlignedBuffer(size_t _size)
+      : storage((_size + sizeof(ozz::math::SimdFloat4) - 1) /
+                sizeof(ozz::math::SimdFloat4)),
+        buffer{reinterpret_cast<ozz::byte*>(storage.data()), _size} {}
+  ozz::vector<ozz::math::SimdFloat4> storage;
+  ozz::span<ozz::byte> buffer;
+};
+}  // namespace
+
+TEST(ContextRawImage, WorkingSetImage) {
+  ozz::unique_ptr<Animation> animation = BuildTestAnimation(2.f, 1.f);
+  ASSERT_TRUE(animation);
+
+  // Warms a context at mid timeline. Values are compared against this warm
+  // sampling rather than raw key values, as compression is lossy.
+  SamplingJob::Context o_context(animation->num_tracks());
+  const float warm_value = Sample(*animation, .5f, &o_context);
+  EXPECT_NEAR(warm_value, 3.f, 1e-2f);
+
+  const size_t raw_size = o_context.raw_size();
+  AlignedBuffer image(raw_size);
+
+  // Too small buffer is rejected.
+  EXPECT_FALSE(o_context.SaveRaw(image.buffer.first(raw_size - 1)));
+  ASSERT_TRUE(o_context.SaveRaw(image.buffer));
+
+  {  // Invalid images are rejected, leaving the context invalidated.
+    SamplingJob::Context i_context;
+    EXPECT_FALSE(i_context.LoadRaw({}));
+    EXPECT_FALSE(i_context.LoadRaw(image.buffer.first(raw_size - 1)));
+    EXPECT_EQ(i_context.animation(), nullptr);
+  }
+
+  SamplingJob::Context i_context;
+  ASSERT_TRUE(i_context.LoadRaw(image.buffer));
+  EXPECT_EQ(i_context.max_tracks(), o_context.max_tracks());
+
+  // Binding checks the animation matches the one the context was warmed
+  // with, here with a different duration.
+  ozz::unique_ptr<Animation> mismatching = BuildTestAnimation(2.f, 2.f);
+  ASSERT_TRUE(mismatching);
+  EXPECT_FALSE(i_context.Bind(*mismatching));
+  ASSERT_TRUE(i_context.LoadRaw(image.buffer));
+  ASSERT_TRUE(i_context.Bind(*animation));
+
+  // The first run at the warmed ratio is a steady-state one: no cursor
+  // reset, hence no re-decompression, and the exact same output as the warm
+  // process.
+  EXPECT_FLOAT_EQ(Sample(*animation, .5f, &i_context), warm_value);
+  EXPECT_EQ(i_context.statistics().cursor_resets, 0u);
+
+  // The context keeps sampling from the image pages.
+  EXPECT_FLOAT_EQ(Sample(*animation, 1.f, &i_context),
+                  Sample(*animation, 1.f, &o_context));
+}
+
+TEST(RoundTrip, WorkingSetImage) {
+  // The warm process working set: two animations, contexts warmed at
+  // different ratios.
+  ozz::unique_ptr<Animation> walk = BuildTestAnimation(1.f, 1.f);
+  ozz::unique_ptr<Animation> run = BuildTestAnimation(10.f, 2.f);
+  ASSERT_TRUE(walk && run);
+  SamplingJob::Context walk_context(walk->num_tracks());
+  SamplingJob::Context run_context(run->num_tracks());
+  const float warm_walk = Sample(*walk, .25f, &walk_context);
+  const float warm_run = Sample(*run, .75f, &run_context);
+  EXPECT_NEAR(warm_walk, 1.25f, 1e-2f);
+  EXPECT_NEAR(warm_run, 17.5f, 1e-1f);
+
+  const WorkingSetImage::Entry entries[] = {{0xabcdu, &walk_context},
+                                            {0x1234u, &run_context}};
+  const size_t size = WorkingSetImage::RequiredSize(ozz::make_span(entries));
+  AlignedBuffer image(size);
+
+  // Too small buffer and null contexts are rejected.
+  EXPECT_FALSE(
+      WorkingSetImage::Write(ozz::make_span(entries), image.buffer.first(size - 1)));
+  const WorkingSetImage::Entry null_entries[] = {{0xabcdu, nullptr}};
+  EXPECT_FALSE(WorkingSetImage::Write(ozz::make_span(null_entries), image.buffer));
+
+  ASSERT_TRUE(WorkingSetImage::Write(ozz::make_span(entries), image.buffer));
+
+  {  // Invalid images are rejected, leaving the image empty.
+    WorkingSetImage i_image;
+    EXPECT_FALSE(i_image.Attach({}));
+    EXPECT_FALSE(i_image.Attach(image.buffer.first(size / 2)));
+    EXPECT_EQ(i_image.count(), 0);
+  }
+
+  // The attaching process resolves entry keys to its own animations, then
+  // binds contexts straight into the image.
+  WorkingSetImage i_image;
+  ASSERT_TRUE(i_image.Attach(image.buffer));
+  ASSERT_EQ(i_image.count(), 2);
+  EXPECT_EQ(i_image.key(0), 0xabcdu);
+  EXPECT_EQ(i_image.key(1), 0x1234u);
+
+  SamplingJob::Context i_walk_context, i_run_context;
+  ASSERT_TRUE(i_image.Bind(0, *walk, &i_walk_context));
+  ASSERT_TRUE(i_image.Bind(1, *run, &i_run_context));
+
+  // Binding to an animation that doesn't match the warmed one fails.
+  SamplingJob::Context mismatched_context;
+  EXPECT_FALSE(i_image.Bind(0, *run, &mismatched_context));
+
+  // Bound contexts resume at their warmed ratio, with no cold start.
+  EXPECT_FLOAT_EQ(Sample(*walk, .25f, &i_walk_context), warm_walk);
+  EXPECT_EQ(i_walk_context.statistics().cursor_resets, 0u);
+  EXPECT_FLOAT_EQ(Sample(*run, .75f, &i_run_context), warm_run);
+  EXPECT_EQ(i_run_context.statistics().cursor_resets, 0u);
+}
@@ -28,10 +28,12 @@
 #include "gtest/gtest.h"
 #include "ozz/base/containers/array.h"
 #include "ozz/base/containers/deque.h"
+#include "ozz/base/containers/fixed_vector.h"
 #include "ozz/base/containers/list.h"
 #include "ozz/base/containers/map.h"
 #include "ozz/base/containers/queue.h"
 #include "ozz/base/containers/set.h"
+#include "ozz/base/containers/small_vector.h"
 #include "ozz/base/containers/stack.h"
 #include "ozz/base/containers/string.h"
 #include "ozz/base/containers/unordered_map.h"
@@ -354,3 +356,105 @@ TEST(string, Containers) {
   str2.clear();
   EXPECT_EQ(str2.size(), 0u);
 }
+
+namespace {
+
+// Counts constructions and destructions, to check containers with manual
+// element lifetime management leak nothing.
+struct Counted {
+  Counted() : value(0) { ++count; }
+  explicit Counted(int _value) : value(_value) { ++count; }
+  Counted(const Counted& _other) : value(_other.value) { ++count; }
+  Counted(Counted&& _other) : value(_other.value) { ++count; }
+  Counted& operator=(const Counted&) = default;
+  ~Counted() { --count; }
+
+  int value;
+  static int count;
+};
+int Counted::count = 0;
+}  // namespace
+
+TEST(FixedVector, Containers) {
+  {
+    typedef ozz::fixed_vector<Counted, 4> Container;
+    Container container;
+    EXPECT_TRUE(container.empty());
+    EXPECT_EQ(container.capacity(), 4u);
+
+    container.push_back(Counted(1));
+    container.emplace_back(2);
+    container.push_back(Counted(3));
+    EXPECT_EQ(container.size(), 3u);
+    EXPECT_EQ(container[0].value, 1);
+    EXPECT_EQ(container[1].value, 2);
+    EXPECT_EQ(container.back().value, 3);
+    EXPECT_EQ(Counted::count, 3);
+
+    container.pop_back();
+    EXPECT_EQ(Counted::count, 2);
+
+    container.resize(4, Counted(46));
+    EXPECT_EQ(container[3].value, 46);
+
+    // Capacity overflow asserts.
+    EXPECT_ASSERTION(container.push_back(Counted(99)), "Capacity exceeded.");
+
+    // Copy and move.
+    Container container2 = container;
+    EXPECT_EQ(container2.size(), 4u);
+    EXPECT_EQ(container2[2].value, 46);
+    Container container3 = std::move(container2);
+    EXPECT_EQ(container3.size(), 4u);
+    EXPECT_TRUE(container2.empty());
+
+    // Spans over inline storage.
+    ozz::span<const Counted> span = ozz::make_span(container);
+    EXPECT_EQ(span.size(), 4u);
+    EXPECT_EQ(span.data(), container.data());
+  }
+  // Everything was destroyed.
+  EXPECT_EQ(Counted::count, 0);
+}
+
+TEST(SmallVector, Containers) {
+  {
+    typedef ozz::small_vector<Counted, 2> Container;
+    Container container;
+    EXPECT_TRUE(container.empty());
+    EXPECT_TRUE(container.is_inline());
+
+    // Stays inline up to the inline capacity.
+    container.push_back(Counted(1));
+    container.emplace_back(2);
+    EXPECT_TRUE(container.is_inline());
+    EXPECT_EQ(container.size(), 2u);
+
+    // Spills to the heap beyond, preserving elements.
+    container.push_back(Counted(3));
+    EXPECT_FALSE(container.is_inline());
+    EXPECT_EQ(container[0].value, 1);
+    EXPECT_EQ(container[1].value, 2);
+    EXPECT_EQ(container[2].value, 3);
+    EXPECT_EQ(Counted::count, 3);
+
+    // Moving a spilled vector steals the heap buffer.
+    const Counted* data = container.data();
+    Container container2 = std::move(container);
+    EXPECT_EQ(container2.data(), data);
+    EXPECT_TRUE(container.empty());
+    EXPECT_TRUE(container.is_inline());
+
+    // Copy, resize and spans.
+    Container container3 = container2;
+    EXPECT_EQ(container3.size(), 3u);
+    EXPECT_EQ(container3[2].value, 3);
+    container3.resize(1);
+    EXPECT_EQ(container3.size(), 1u);
+    ozz::span<const Counted> span = ozz::make_span(container3);
+    EXPECT_EQ(span.size(), 1u);
+    EXPECT_EQ(span.data(), container3.data());
+  }
+  // Everything was destroyed.
+  EXPECT_EQ(Counted::count, 0);
+}
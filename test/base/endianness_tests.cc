@@ -101,3 +101,45 @@ TEST(Swap, Endianness) {
     EXPECT_EQ(uo[1], 0x3507086946261458ull);
   }
 }
+
+TEST(BulkSwap, Endianness) {
+  // Swaps arrays long enough to exercise the simd bulk paths (32 and 16
+  // bytes at a time) and their scalar trailing elements, checking each
+  // element against the single element swap.
+  {  // 2 bytes elements, 38 bytes.
+    uint16_t uo[19];
+    uint16_t expected[OZZ_ARRAY_SIZE(uo)];
+    for (size_t i = 0; i < OZZ_ARRAY_SIZE(uo); ++i) {
+      uo[i] = static_cast<uint16_t>(0x4699 + i * 0x0153);
+      expected[i] = ozz::EndianSwap(uo[i]);
+    }
+    ozz::EndianSwap(uo, OZZ_ARRAY_SIZE(uo));
+    for (size_t i = 0; i < OZZ_ARRAY_SIZE(uo); ++i) {
+      EXPECT_EQ(uo[i], expected[i]);
+    }
+  }
+  {  // 4 bytes elements, 44 bytes.
+    uint32_t uo[11];
+    uint32_t expected[OZZ_ARRAY_SIZE(uo)];
+    for (size_t i = 0; i < OZZ_ARRAY_SIZE(uo); ++i) {
+      uo[i] = 0x46992715u + static_cast<uint32_t>(i) * 0x01530917u;
+      expected[i] = ozz::EndianSwap(uo[i]);
+    }
+    ozz::EndianSwap(uo, OZZ_ARRAY_SIZE(uo));
+    for (size_t i = 0; i < OZZ_ARRAY_SIZE(uo); ++i) {
+      EXPECT_EQ(uo[i], expected[i]);
+    }
+  }
+  {  // 8 bytes elements, 72 bytes.
+    uint64_t uo[9];
+    uint64_t expected[OZZ_ARRAY_SIZE(uo)];
+    for (size_t i = 0; i < OZZ_ARRAY_SIZE(uo); ++i) {
+      uo[i] = 0x4699271511190417ull + i * 0x0153091726354453ull;
+      expected[i] = ozz::EndianSwap(uo[i]);
+    }
+    ozz::EndianSwap(uo, OZZ_ARRAY_SIZE(uo));
+    for (size_t i = 0; i < OZZ_ARRAY_SIZE(uo); ++i) {
+      EXPECT_EQ(uo[i], expected[i]);
+    }
+  }
+}
@@ -0,0 +1,144 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "gtest/gtest.h"
+#include "ozz/base/io/archive.h"
+#include "ozz/base/io/archive_bundle.h"
+#include "ozz/base/io/stream.h"
+
+using ozz::io::ArchiveBundle;
+using ozz::io::ArchiveBundleWriter;
+
+// Two tagged objects to exercise per-entry tag checks.
+struct BundledInt {
+  void Save(ozz::io::OArchive& _archive) const { _archive << value; }
+  void Load(ozz::io::IArchive& _archive, uint32_t /*_version*/) {
+    _archive >> value;
+  }
+  int32_t value = 0;
+};
+
+struct BundledFloat {
+  void Save(ozz::io::OArchive& _archive) const { _archive << value; }
+  void Load(ozz::io::IArchive& _archive, uint32_t /*_version*/) {
+    _archive >> value;
+  }
+  float value = 0.f;
+};
+
+namespace ozz {
+namespace io {
+OZZ_IO_TYPE_VERSION(1, BundledInt)
+OZZ_IO_TYPE_TAG("ozz-test-bundle-i", BundledInt)
+OZZ_IO_TYPE_VERSION(1, BundledFloat)
+OZZ_IO_TYPE_TAG("ozz-test-bundle-f", BundledFloat)
+}  // namespace io
+}  // namespace ozz
+
+TEST(WriteRead, ArchiveBundle) {
+  ozz::io::MemoryStream stream;
+
+  {  // Writes a bundle of 3 objects.
+    ArchiveBundleWriter writer(&stream);
+
+    BundledInt i_object;
+    i_object.value = 46;
+    EXPECT_TRUE(writer.Add("int", i_object));
+
+    // Duplicated names are rejected.
+    EXPECT_FALSE(writer.Add("int", i_object));
+
+    BundledFloat f_object;
+    f_object.value = 93.f;
+    EXPECT_TRUE(writer.Add("float", f_object));
+
+    i_object.value = 99;
+    EXPECT_TRUE(writer.Add("int2", i_object));
+
+    EXPECT_TRUE(writer.Close());
+
+    // Closed bundles don't accept more objects.
+    EXPECT_FALSE(writer.Add("late", i_object));
+    EXPECT_FALSE(writer.Close());
+  }
+
+  stream.Seek(0, ozz::io::Stream::kSet);
+  ArchiveBundle bundle(&stream);
+  ASSERT_TRUE(bundle.valid());
+  ASSERT_EQ(bundle.size(), 3u);
+  EXPECT_STREQ(bundle.name(0), "int");
+  EXPECT_STREQ(bundle.name(1), "float");
+  EXPECT_STREQ(bundle.name(2), "int2");
+
+  // Objects can be read in any order.
+  BundledFloat f_object;
+  EXPECT_TRUE(bundle.Get("float", &f_object));
+  EXPECT_FLOAT_EQ(f_object.value, 93.f);
+
+  BundledInt i_object;
+  EXPECT_TRUE(bundle.Get("int2", &i_object));
+  EXPECT_EQ(i_object.value, 99);
+  EXPECT_TRUE(bundle.Get("int", &i_object));
+  EXPECT_EQ(i_object.value, 46);
+
+  // Unknown names are rejected.
+  EXPECT_FALSE(bundle.Get("unknown", &i_object));
+
+  // Type mismatch is detected by the entry's archive tag.
+  EXPECT_FALSE(bundle.Get("float", &i_object));
+}
+
+TEST(Empty, ArchiveBundle) {
+  ozz::io::MemoryStream stream;
+  {
+    ArchiveBundleWriter writer(&stream);
+    // Closed by destructor.
+  }
+
+  stream.Seek(0, ozz::io::Stream::kSet);
+  ArchiveBundle bundle(&stream);
+  EXPECT_TRUE(bundle.valid());
+  EXPECT_EQ(bundle.size(), 0u);
+
+  BundledInt object;
+  EXPECT_FALSE(bundle.Get("anything", &object));
+}
+
+TEST(Invalid, ArchiveBundle) {
+  // A stream that doesn't start with a bundle tag is rejected.
+  ozz::io::MemoryStream stream;
+  const char garbage[] = "this is not a bundle at all";
+  stream.Write(garbage, sizeof(garbage));
+  stream.Seek(0, ozz::io::Stream::kSet);
+
+  ArchiveBundle bundle(&stream);
+  EXPECT_FALSE(bundle.valid());
+  EXPECT_EQ(bundle.size(), 0u);
+
+  BundledInt object;
+  EXPECT_FALSE(bundle.Get("anything", &object));
+}
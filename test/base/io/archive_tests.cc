@@ -32,7 +32,9 @@
 
 #include "gtest/gtest.h"
 
+#include "ozz/base/containers/vector.h"
 #include "ozz/base/gtest_helper.h"
+#include "ozz/base/io/crc32c.h"
 
 #include "archive_tests_objects.h"
 
@@ -256,6 +258,40 @@ TEST(ClassArrays, Archive) {
   }
 }
 
+TEST(RawArrays, Archive) {
+  // Serializes with both endiannesses. The native one exercises the raw
+  // (single stream access) path, the other one the element-wise fallback.
+  // Both must read back the same values, whatever path wrote them.
+  for (int e = 0; e < 2; ++e) {
+    ozz::Endianness endianess = e == 0 ? ozz::kBigEndian : ozz::kLittleEndian;
+
+    ozz::io::MemoryStream stream;
+    ASSERT_TRUE(stream.opened());
+
+    // Write raw structs.
+    ozz::io::OArchive o(&stream, endianess);
+    const RawSerializable ow[] = {{46, 93}, {-99, 0}, {58, 14}, {-26, 4600}};
+    o << ozz::io::MakeArray(ow);
+
+    // The native endianness raw path stores the array's exact memory layout,
+    // right after the archive's 1 byte endianness header.
+    if (endianess == ozz::GetNativeEndianness()) {
+      EXPECT_EQ(stream.Size(), 1 + sizeof(ow));
+      stream.Seek(1, ozz::io::Stream::kSet);
+      RawSerializable stored[OZZ_ARRAY_SIZE(ow)];
+      EXPECT_EQ(stream.Read(stored, sizeof(stored)), sizeof(stored));
+      EXPECT_EQ(std::memcmp(ow, stored, sizeof(ow)), 0);
+    }
+
+    // Read raw structs.
+    stream.Seek(0, ozz::io::Stream::kSet);
+    ozz::io::IArchive i(&stream);
+    RawSerializable iw[OZZ_ARRAY_SIZE(ow)];
+    i >> ozz::io::MakeArray(iw);
+    EXPECT_EQ(std::memcmp(ow, iw, sizeof(ow)), 0);
+  }
+}
+
 TEST(Tag, Archive) {
   ozz::io::MemoryStream stream;
   ASSERT_TRUE(stream.opened());
@@ -309,3 +345,170 @@ TEST(TagEOF, Archive) {
 
   EXPECT_FALSE(i.TestTag<Tagged2>());
 }
+
+TEST(TypeTable, Archive) {
+  const int n_writes = 10;
+
+  // Writes the same objects with and without the type table format, the
+  // latter repeats tag strings per object and must be bigger.
+  ozz::io::MemoryStream legacy_stream;
+  {
+    ozz::io::OArchive o(&legacy_stream, ozz::GetNativeEndianness());
+    for (int i = 0; i < n_writes; ++i) {
+      Tagged1 ot1;
+      Tagged2 ot2;
+      o << ot1;
+      o << ot2;
+    }
+  }
+  ozz::io::MemoryStream stream;
+  {
+    ozz::io::OArchive o(&stream, ozz::GetNativeEndianness(), true);
+    for (int i = 0; i < n_writes; ++i) {
+      Tagged1 ot1;
+      Tagged2 ot2;
+      o << ot1;
+      o << ot2;
+    }
+  }
+  EXPECT_LT(stream.Size(), legacy_stream.Size());
+
+  // Reads back, TestTag and tag validation behave as with the legacy format.
+  stream.Seek(0, ozz::io::Stream::kSet);
+  ozz::io::IArchive i(&stream);
+
+  OZZ_IF_DEBUG(Tagged2 it2);
+  EXPECT_FALSE(i.TestTag<Tagged2>());
+  EXPECT_ASSERTION(i >> it2, "Type tag does not match archive content.");
+
+  int n_read = 0;
+  while (i.TestTag<Tagged1>()) {
+    Tagged1 it1;
+    Tagged2 rit2;
+    i >> it1;
+    i >> rit2;
+    ++n_read;
+  }
+  EXPECT_EQ(n_read, n_writes);
+  EXPECT_FALSE(i.TestTag<Tagged1>());
+  EXPECT_FALSE(i.TestTag<Tagged2>());
+}
+
+TEST(TypeTableEndianness, Archive) {
+  // Type ids are swapped like any primitive, so the format round trips
+  // whatever the archive endianness.
+  for (int e = 0; e < 2; ++e) {
+    const ozz::Endianness endianness =
+        e == 0 ? ozz::kLittleEndian : ozz::kBigEndian;
+    ozz::io::MemoryStream stream;
+    {
+      ozz::io::OArchive o(&stream, endianness, true);
+      for (int i = 0; i < 3; ++i) {
+        Tagged1 ot;
+        o << ot;
+      }
+    }
+    stream.Seek(0, ozz::io::Stream::kSet);
+    ozz::io::IArchive i(&stream);
+    for (int n = 0; n < 3; ++n) {
+      EXPECT_TRUE(i.TestTag<Tagged1>());
+      Tagged1 it;
+      EXPECT_NO_FATAL_FAILURE(i >> it);
+    }
+    EXPECT_FALSE(i.TestTag<Tagged1>());
+  }
+}
+
+TEST(CRC32C, Archive) {
+  // Known answer test vectors, from rfc3720.
+  const char digits[] = "123456789";
+  EXPECT_EQ(ozz::io::CRC32C(0, digits, 9), 0xe3069283u);
+  const char zeros[32] = {};
+  EXPECT_EQ(ozz::io::CRC32C(0, zeros, 32), 0x8a9136aau);
+
+  // Incremental calls compose, whatever the split.
+  for (size_t split = 0; split <= 9; ++split) {
+    const uint32_t crc = ozz::io::CRC32C(0, digits, split);
+    EXPECT_EQ(ozz::io::CRC32C(crc, digits + split, 9 - split), 0xe3069283u);
+  }
+}
+
+TEST(Checksum, Archive) {
+  // An array bigger than the checksum granularity exercises the crc words
+  // interleaved in the stream, on top of the one written by FlushChecksum.
+  ozz::vector<int32_t> big(32 * 1024);
+  for (size_t i = 0; i < big.size(); ++i) {
+    big[i] = static_cast<int32_t>(i * 7);
+  }
+
+  // Round trips whatever the archive endianness.
+  for (int e = 0; e < 2; ++e) {
+    const ozz::Endianness endianness =
+        e == 0 ? ozz::kLittleEndian : ozz::kBigEndian;
+    ozz::io::MemoryStream stream;
+    {
+      ozz::io::OArchive o(&stream, endianness, false, true);
+      const int32_t o46 = 46;
+      o << o46;
+      Tagged1 ot;
+      o << ot;
+      o << ozz::io::MakeArray(big.data(), big.size());
+      o.FlushChecksum();
+    }
+
+    stream.Seek(0, ozz::io::Stream::kSet);
+    ozz::io::IArchive i(&stream);
+    int32_t i46 = 0;
+    i >> i46;
+    EXPECT_EQ(i46, 46);
+    // TestTag rewinds don't disturb checksum verification.
+    EXPECT_FALSE(i.TestTag<Tagged2>());
+    EXPECT_TRUE(i.TestTag<Tagged1>());
+    Tagged1 it;
+    EXPECT_NO_FATAL_FAILURE(i >> it);
+    ozz::vector<int32_t> read(big.size());
+    i >> ozz::io::MakeArray(read.data(), read.size());
+    EXPECT_EQ(std::memcmp(big.data(), read.data(), big.size() * sizeof(int32_t)),
+              0);
+    EXPECT_TRUE(i.checksum_valid());
+    EXPECT_TRUE(i.ValidateChecksum());
+  }
+}
+
+TEST(ChecksumCorruption, Archive) {
+  ozz::vector<int32_t> big(32 * 1024);
+  for (size_t i = 0; i < big.size(); ++i) {
+    big[i] = static_cast<int32_t>(i * 3);
+  }
+
+  ozz::io::MemoryStream stream;
+  {
+    ozz::io::OArchive o(&stream, ozz::GetNativeEndianness(), false, true);
+    o << ozz::io::MakeArray(big.data(), big.size());
+    const int32_t o46 = 46;
+    o << o46;
+    o.FlushChecksum();
+  }
+
+  // Corrupts a single payload byte, deep inside the first checksum chunk.
+  const int offset = 1000;
+  uint8_t corrupted;
+  stream.Seek(offset, ozz::io::Stream::kSet);
+  ASSERT_EQ(stream.Read(&corrupted, 1), 1u);
+  corrupted = static_cast<uint8_t>(corrupted ^ 0xff);
+  stream.Seek(offset, ozz::io::Stream::kSet);
+  ASSERT_EQ(stream.Write(&corrupted, 1), 1u);
+
+  // Reading streams on, but the corruption is reported as soon as the crc
+  // word closing the corrupted chunk is crossed.
+  stream.Seek(0, ozz::io::Stream::kSet);
+  ozz::io::IArchive i(&stream);
+  EXPECT_TRUE(i.checksum_valid());
+  ozz::vector<int32_t> read(big.size());
+  i >> ozz::io::MakeArray(read.data(), read.size());
+  EXPECT_FALSE(i.checksum_valid());
+  int32_t i46 = 0;
+  i >> i46;
+  EXPECT_EQ(i46, 46);  // Data past the corrupted chunk still streams.
+  EXPECT_FALSE(i.ValidateChecksum());
+}
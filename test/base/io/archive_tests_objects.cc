@@ -51,6 +51,25 @@ void Extern<Extrusive>::Load(IArchive& _archive, Extrusive* _test,
   EXPECT_EQ(_version, 0u);
   _archive >> ozz::io::MakeArray(&_test->i, _count);
 }
+
+// Element-wise path, used when the archive endianness requires swapping.
+// Serializes the same bytes as the raw path.
+void Extern<RawSerializable>::Save(OArchive& _archive,
+                                   const RawSerializable* _test,
+                                   size_t _count) {
+  for (size_t i = 0; i < _count; ++i) {
+    _archive << _test[i].i;
+    _archive << _test[i].j;
+  }
+}
+void Extern<RawSerializable>::Load(IArchive& _archive, RawSerializable* _test,
+                                   size_t _count, uint32_t _version) {
+  EXPECT_EQ(_version, 0u);
+  for (size_t i = 0; i < _count; ++i) {
+    _archive >> _test[i].i;
+    _archive >> _test[i].j;
+  }
+}
 }  // namespace io
 }  // namespace ozz
 
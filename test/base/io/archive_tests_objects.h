@@ -49,6 +49,13 @@ struct Extrusive {
   uint64_t i;
 };
 
+// Padding free struct whose serialized form is its exact memory layout,
+// eligible to raw (single stream access) array serialization.
+struct RawSerializable {
+  int16_t i;
+  uint16_t j;
+};
+
 namespace ozz {
 namespace io {
 // Give Intrusive type a version.
@@ -64,6 +71,18 @@ struct Extern<Extrusive> {
   static void Load(IArchive& _archive, Extrusive* _test, size_t _count,
                    uint32_t _version);
 };
+
+// RawSerializable is not versionable and raw. The element-wise path below
+// must serialize the very same bytes as the raw one.
+OZZ_IO_TYPE_NOT_VERSIONABLE(RawSerializable)
+OZZ_IO_TYPE_RAW(RawSerializable)
+template <>
+struct Extern<RawSerializable> {
+  static void Save(OArchive& _archive, const RawSerializable* _test,
+                   size_t _count);
+  static void Load(IArchive& _archive, RawSerializable* _test, size_t _count,
+                   uint32_t _version);
+};
 }  // namespace io
 }  // namespace ozz
 
@@ -0,0 +1,138 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "gtest/gtest.h"
+#include "ozz/base/io/archive.h"
+#include "ozz/base/io/async_loader.h"
+#include "ozz/base/io/stream.h"
+
+using ozz::io::AsyncLoader;
+
+// A minimal tagged object to exercise file-based archive loading.
+struct Tagged {
+  void Save(ozz::io::OArchive& _archive) const { _archive << value; }
+  void Load(ozz::io::IArchive& _archive, uint32_t /*_version*/) {
+    _archive >> value;
+  }
+  float value = 0.f;
+};
+
+namespace ozz {
+namespace io {
+OZZ_IO_TYPE_VERSION(1, Tagged)
+OZZ_IO_TYPE_TAG("ozz-test-async", Tagged)
+}  // namespace io
+}  // namespace ozz
+
+namespace {
+// Archives _object, with its tag, to the file at _path.
+template <typename _Ty>
+bool WriteFile(const char* _path, const _Ty& _object) {
+  ozz::io::File file(_path, "wb");
+  if (!file.opened()) {
+    return false;
+  }
+  ozz::io::OArchive archive(&file);
+  archive << _object;
+  return true;
+}
+}  // namespace
+
+TEST(LoadWait, AsyncLoader) {
+  const char* path = "async_loader_test.ozz";
+  Tagged saved;
+  saved.value = 46.f;
+  ASSERT_TRUE(WriteFile(path, saved));
+
+  AsyncLoader loader;
+  Tagged loaded;
+  const AsyncLoader::Ticket ticket = loader.Load(path, &loaded);
+  EXPECT_TRUE(loader.Wait(ticket));
+  EXPECT_EQ(loader.status(ticket), AsyncLoader::kSuccess);
+  EXPECT_FLOAT_EQ(loaded.value, 46.f);
+}
+
+TEST(Failures, AsyncLoader) {
+  AsyncLoader loader;
+
+  {  // File doesn't exist.
+    Tagged loaded;
+    const AsyncLoader::Ticket ticket =
+        loader.Load("does_not_exist.ozz", &loaded);
+    EXPECT_FALSE(loader.Wait(ticket));
+    EXPECT_EQ(loader.status(ticket), AsyncLoader::kFailed);
+  }
+
+  {  // File doesn't start with the expected tag.
+    const char* path = "async_loader_bad_tag.ozz";
+    {
+      ozz::io::File file(path, "wb");
+      ASSERT_TRUE(file.opened());
+      const char garbage[] = "not an ozz archive";
+      file.Write(garbage, sizeof(garbage));
+    }
+    Tagged loaded;
+    const AsyncLoader::Ticket ticket = loader.Load(path, &loaded);
+    EXPECT_FALSE(loader.Wait(ticket));
+  }
+}
+
+TEST(CompletionQueue, AsyncLoader) {
+  const char* path = "async_loader_queue_test.ozz";
+  Tagged saved;
+  saved.value = 93.f;
+  ASSERT_TRUE(WriteFile(path, saved));
+
+  AsyncLoader loader;
+
+  // Schedules a batch of requests, the failing one in the middle.
+  const size_t kNumRequests = 5;
+  Tagged loaded[kNumRequests];
+  AsyncLoader::Ticket tickets[kNumRequests];
+  for (size_t i = 0; i < kNumRequests; ++i) {
+    const bool fails = i == 2;
+    tickets[i] = loader.Load(fails ? "does_not_exist.ozz" : path, &loaded[i]);
+  }
+  loader.WaitAll();
+
+  // Requests complete in scheduling order (single worker), and are popped in
+  // completion order.
+  for (size_t i = 0; i < kNumRequests; ++i) {
+    AsyncLoader::Ticket ticket;
+    bool success;
+    ASSERT_TRUE(loader.PopCompleted(&ticket, &success));
+    EXPECT_EQ(ticket, tickets[i]);
+    EXPECT_EQ(success, i != 2);
+  }
+  EXPECT_FALSE(loader.PopCompleted());
+
+  for (size_t i = 0; i < kNumRequests; ++i) {
+    if (i != 2) {
+      EXPECT_FLOAT_EQ(loaded[i].value, 93.f);
+    }
+  }
+}
@@ -0,0 +1,209 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/io/archive.h"
+#include "ozz/base/io/compressed_stream.h"
+#include "ozz/base/io/stream.h"
+
+using ozz::io::CompressedStream;
+
+namespace {
+// Builds a repetitive, hence compressible, payload.
+ozz::vector<char> CompressibleData(size_t _size) {
+  const char pattern[] = "ozz-animation keyframe stream ";
+  ozz::vector<char> data(_size);
+  for (size_t i = 0; i < _size; ++i) {
+    data[i] = pattern[i % (sizeof(pattern) - 1)];
+  }
+  return data;
+}
+
+// Builds a pseudo random, hence incompressible, payload.
+ozz::vector<char> IncompressibleData(size_t _size) {
+  ozz::vector<char> data(_size);
+  uint32_t state = 46;
+  for (size_t i = 0; i < _size; ++i) {
+    state = state * 1664525u + 1013904223u;
+    data[i] = static_cast<char>(state >> 24);
+  }
+  return data;
+}
+
+// Compresses _data into _stream and checks round trip through small and
+// large reads.
+void TestRoundTrip(const ozz::vector<char>& _data) {
+  ozz::io::MemoryStream stream;
+
+  {  // Writes through the compressing end, in uneven chunks.
+    CompressedStream compressed(&stream, CompressedStream::kWrite);
+    ASSERT_TRUE(compressed.opened());
+    size_t offset = 0;
+    for (size_t chunk = 1; offset < _data.size(); chunk = chunk * 3 + 1) {
+      const size_t remaining = _data.size() - offset;
+      const size_t size = chunk < remaining ? chunk : remaining;
+      EXPECT_EQ(compressed.Write(_data.data() + offset, size), size);
+      offset += size;
+    }
+    EXPECT_EQ(compressed.Tell(), static_cast<int>(_data.size()));
+    EXPECT_TRUE(compressed.Flush());
+  }
+
+  // Reads back through the decompressing end.
+  stream.Seek(0, ozz::io::Stream::kSet);
+  CompressedStream compressed(&stream, CompressedStream::kRead);
+  ASSERT_TRUE(compressed.opened());
+  EXPECT_EQ(compressed.Size(), _data.size());
+
+  ozz::vector<char> read(_data.size());
+  EXPECT_EQ(compressed.Read(read.data(), read.size()), read.size());
+  EXPECT_TRUE(std::memcmp(read.data(), _data.data(), _data.size()) == 0);
+
+  // Reading past the end returns a short count.
+  char extra;
+  EXPECT_EQ(compressed.Read(&extra, 1), 0u);
+}
+}  // namespace
+
+TEST(Compressible, CompressedStream) {
+  // Multi-block payload, repetitive data must end up smaller than the source.
+  const ozz::vector<char> data = CompressibleData(200 * 1024);
+
+  ozz::io::MemoryStream stream;
+  {
+    CompressedStream compressed(&stream, CompressedStream::kWrite);
+    EXPECT_EQ(compressed.Write(data.data(), data.size()), data.size());
+  }  // Flushed by destructor.
+  EXPECT_LT(stream.Size(), data.size());
+
+  TestRoundTrip(data);
+}
+
+TEST(Incompressible, CompressedStream) {
+  // Random data doesn't compress, blocks are stored raw and round trip still
+  // succeeds.
+  TestRoundTrip(IncompressibleData(100 * 1024));
+}
+
+TEST(Empty, CompressedStream) {
+  ozz::io::MemoryStream stream;
+  {
+    CompressedStream compressed(&stream, CompressedStream::kWrite);
+    EXPECT_TRUE(compressed.opened());
+  }
+
+  stream.Seek(0, ozz::io::Stream::kSet);
+  CompressedStream compressed(&stream, CompressedStream::kRead);
+  EXPECT_TRUE(compressed.opened());
+  EXPECT_EQ(compressed.Size(), 0u);
+  char any;
+  EXPECT_EQ(compressed.Read(&any, 1), 0u);
+}
+
+TEST(Invalid, CompressedStream) {
+  // A stream that doesn't start with a container header is rejected.
+  ozz::io::MemoryStream stream;
+  const char garbage[] = "this is not a compressed container";
+  stream.Write(garbage, sizeof(garbage));
+  stream.Seek(0, ozz::io::Stream::kSet);
+
+  CompressedStream compressed(&stream, CompressedStream::kRead);
+  EXPECT_FALSE(compressed.opened());
+  char any;
+  EXPECT_EQ(compressed.Read(&any, 1), 0u);
+}
+
+TEST(Seek, CompressedStream) {
+  const ozz::vector<char> data = CompressibleData(150 * 1024);
+
+  ozz::io::MemoryStream stream;
+  {
+    CompressedStream compressed(&stream, CompressedStream::kWrite);
+    EXPECT_EQ(compressed.Write(data.data(), data.size()), data.size());
+  }
+
+  stream.Seek(0, ozz::io::Stream::kSet);
+  CompressedStream compressed(&stream, CompressedStream::kRead);
+  ASSERT_TRUE(compressed.opened());
+
+  // Forward seek across blocks.
+  const int forward = 130 * 1024 + 17;
+  EXPECT_EQ(compressed.Seek(forward, ozz::io::Stream::kSet), 0);
+  EXPECT_EQ(compressed.Tell(), forward);
+  char read[16];
+  EXPECT_EQ(compressed.Read(read, sizeof(read)), sizeof(read));
+  EXPECT_TRUE(std::memcmp(read, data.data() + forward, sizeof(read)) == 0);
+
+  // Backward seek restarts from the first block.
+  const int backward = 46;
+  EXPECT_EQ(compressed.Seek(backward, ozz::io::Stream::kSet), 0);
+  EXPECT_EQ(compressed.Tell(), backward);
+  EXPECT_EQ(compressed.Read(read, sizeof(read)), sizeof(read));
+  EXPECT_TRUE(std::memcmp(read, data.data() + backward, sizeof(read)) == 0);
+
+  // Relative and end-relative seeks.
+  EXPECT_EQ(compressed.Seek(-8, ozz::io::Stream::kCurrent), 0);
+  EXPECT_EQ(compressed.Tell(), backward + static_cast<int>(sizeof(read)) - 8);
+  EXPECT_EQ(compressed.Seek(0, ozz::io::Stream::kEnd), 0);
+  EXPECT_EQ(compressed.Tell(), static_cast<int>(data.size()));
+
+  // Out of range seeks are rejected.
+  EXPECT_NE(compressed.Seek(-1, ozz::io::Stream::kSet), 0);
+  EXPECT_NE(compressed.Seek(1, ozz::io::Stream::kEnd), 0);
+}
+
+TEST(Archive, CompressedStream) {
+  // An archive layered over a compressed stream round trips, including the
+  // backward seek done by IArchive::TestTag.
+  ozz::io::MemoryStream stream;
+
+  const ozz::vector<char> data = CompressibleData(80 * 1024);
+  {
+    CompressedStream compressed(&stream, CompressedStream::kWrite);
+    ozz::io::OArchive archive(&compressed);
+    archive << int32_t(46);
+    archive << ozz::io::MakeArray(data.data(), data.size());
+    archive << 93.f;
+  }
+
+  stream.Seek(0, ozz::io::Stream::kSet);
+  CompressedStream compressed(&stream, CompressedStream::kRead);
+  ozz::io::IArchive archive(&compressed);
+
+  int32_t i;
+  archive >> i;
+  EXPECT_EQ(i, 46);
+  ozz::vector<char> read(data.size());
+  archive >> ozz::io::MakeArray(read.data(), read.size());
+  EXPECT_TRUE(std::memcmp(read.data(), data.data(), data.size()) == 0);
+  float f;
+  archive >> f;
+  EXPECT_FLOAT_EQ(f, 93.f);
+}
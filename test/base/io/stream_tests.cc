@@ -185,3 +185,53 @@ TEST(MemoryStream, Stream) {
     TestTooBigStream(&stream);
   }
 }
+
+TEST(BufferedStream, Stream) {
+  {  // Generic stream conformance, over a memory backend.
+    ozz::io::MemoryStream backend;
+    ozz::io::BufferedStream stream(&backend);
+    TestStream(&stream);
+  }
+  {
+    ozz::io::MemoryStream backend;
+    ozz::io::BufferedStream stream(&backend);
+    TestSeek(&stream);
+  }
+  {  // Small writes are coalesced, the backend sees them after a flush.
+    ozz::io::MemoryStream backend;
+    ozz::io::BufferedStream stream(&backend, 64);
+    for (int i = 0; i < 8; ++i) {
+      EXPECT_EQ(stream.Write(&i, sizeof(i)), sizeof(i));
+    }
+    EXPECT_EQ(backend.Size(), 0u);
+    EXPECT_EQ(stream.Size(), 8 * sizeof(int));
+    EXPECT_EQ(stream.Tell(), static_cast<int>(8 * sizeof(int)));
+    EXPECT_TRUE(stream.Flush());
+    EXPECT_EQ(backend.Size(), 8 * sizeof(int));
+
+    // Overflowing the buffer flushes it.
+    int big[32];
+    for (int i = 0; i < 32; ++i) {
+      big[i] = 8 + i;
+    }
+    EXPECT_EQ(stream.Write(big, sizeof(big)), sizeof(big));
+    EXPECT_EQ(stream.Size(), 40 * sizeof(int));
+
+    // Reads flush first and see everything that was written.
+    EXPECT_EQ(stream.Seek(0, ozz::io::Stream::kSet), 0);
+    for (int i = 0; i < 40; ++i) {
+      int read = -1;
+      EXPECT_EQ(stream.Read(&read, sizeof(read)), sizeof(read));
+      EXPECT_EQ(read, i);
+    }
+  }
+  {  // Destruction flushes pending writes.
+    ozz::io::MemoryStream backend;
+    {
+      ozz::io::BufferedStream stream(&backend);
+      const int to_write = 46;
+      EXPECT_EQ(stream.Write(&to_write, sizeof(to_write)), sizeof(to_write));
+    }
+    EXPECT_EQ(backend.Size(), sizeof(int));
+  }
+}
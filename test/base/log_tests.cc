@@ -27,6 +27,9 @@
 
 #include "ozz/base/log.h"
 
+#include <sstream>
+#include <thread>
+
 #include "gtest/gtest.h"
 #include "ozz/base/gtest_helper.h"
 
@@ -55,6 +58,52 @@ TEST(Standard, Log) { TestLogLevel(ozz::log::kStandard); }
 
 TEST(Verbose, Log) { TestLogLevel(ozz::log::kVerbose); }
 
+void TestAsyncFunction(const char* _log) {
+  ozz::log::AsyncSink sink;
+  ozz::log::Log() << _log << std::endl;
+  // Message below the logging level must not be queued nor output.
+  ozz::log::LogV() << "filtered" << std::endl;
+  // The sink drains all pending messages when going out of scope.
+}
+
+TEST(Async, Log) {
+  ozz::log::SetLevel(ozz::log::kStandard);
+  EXPECT_LOG_LOG(TestAsyncFunction("async"), "async");
+}
+
+TEST(AsyncMultiThreaded, Log) {
+  ozz::log::SetLevel(ozz::log::kStandard);
+
+  // Captures clog output. Redirection must span sink lifetime, as messages
+  // are output from the sink's thread.
+  std::ostringstream local;
+  std::streambuf* previous = std::clog.rdbuf(local.rdbuf());
+  {
+    ozz::log::AsyncSink sink(1024);
+    std::thread threads[4];
+    for (size_t i = 0; i < OZZ_ARRAY_SIZE(threads); ++i) {
+      threads[i] = std::thread([]() {
+        for (int m = 0; m < 100; ++m) {
+          ozz::log::Log() << "message" << std::endl;
+        }
+      });
+    }
+    for (size_t i = 0; i < OZZ_ARRAY_SIZE(threads); ++i) {
+      threads[i].join();
+    }
+    // Sink destruction drains pending messages.
+  }
+  std::clog.rdbuf(previous);
+
+  // All messages must have been output, one line each.
+  const std::string output = local.str();
+  size_t lines = 0;
+  for (size_t i = 0; i < output.size(); ++i) {
+    lines += output[i] == '\n';
+  }
+  EXPECT_EQ(lines, 400u);
+}
+
 TEST(FloatPrecision, Log) {
   const float number = 46.9352099f;
   ozz::log::Log log;
@@ -146,3 +146,82 @@ TEST(BoxBuild, ozz_math) {
   EXPECT_FLOAT3_EQ(multi_valid.min, -27.f, -1.f, 0.f);
   EXPECT_FLOAT3_EQ(multi_valid.max, 1.f, 58.f, 46.f);
 }
+
+TEST(BoxTranslationsBuild, ozz_math) {
+  {  // Empty span builds an invalid box.
+    EXPECT_FALSE(
+        ozz::math::TranslationsBox(ozz::span<const ozz::math::Float4x4>())
+            .is_valid());
+  }
+
+  // 6 matrices, covering the 4 matrices main loop and the remainder.
+  const ozz::math::Float4x4 matrices[6] = {
+      ozz::math::Float4x4::Translation(
+          ozz::math::simd_float4::Load(0.f, 0.f, 0.f, 0.f)),
+      ozz::math::Float4x4::Translation(
+          ozz::math::simd_float4::Load(1.f, -1.f, 1.f, 0.f)),
+      ozz::math::Float4x4::Translation(
+          ozz::math::simd_float4::Load(-2.f, 4.f, -1.f, 0.f)),
+      ozz::math::Float4x4::Translation(
+          ozz::math::simd_float4::Load(3.f, 0.f, 5.f, 0.f)),
+      ozz::math::Float4x4::Translation(
+          ozz::math::simd_float4::Load(0.f, 6.f, -3.f, 0.f)),
+      ozz::math::Float4x4::Translation(
+          ozz::math::simd_float4::Load(-1.f, 2.f, 0.f, 0.f))};
+
+  const ozz::math::Box box = ozz::math::TranslationsBox(ozz::make_span(matrices));
+  EXPECT_TRUE(box.is_valid());
+  EXPECT_FLOAT3_EQ(box.min, -2.f, -1.f, -3.f);
+  EXPECT_FLOAT3_EQ(box.max, 3.f, 6.f, 5.f);
+}
+
+TEST(BoxMergeSpan, ozz_math) {
+  {  // Empty span merges to an invalid box.
+    EXPECT_FALSE(ozz::math::Merge(ozz::span<const ozz::math::Box>()).is_valid());
+  }
+
+  const ozz::math::Box boxes[3] = {
+      ozz::math::Box(ozz::math::Float3(-1.f, -2.f, -3.f),
+                     ozz::math::Float3(1.f, 2.f, 3.f)),
+      ozz::math::Box(),  // Invalid, ignored.
+      ozz::math::Box(ozz::math::Float3(0.f, 5.f, -8.f),
+                     ozz::math::Float3(1.f, 6.f, 0.f))};
+
+  const ozz::math::Box merged = ozz::math::Merge(ozz::make_span(boxes));
+  EXPECT_TRUE(merged.is_valid());
+  EXPECT_FLOAT3_EQ(merged.min, -1.f, -2.f, -8.f);
+  EXPECT_FLOAT3_EQ(merged.max, 1.f, 6.f, 3.f);
+
+  {  // Only invalid boxes merge to an invalid box.
+    const ozz::math::Box invalids[2];
+    EXPECT_FALSE(ozz::math::Merge(ozz::make_span(invalids)).is_valid());
+  }
+}
+
+TEST(BoxTransformSpan, ozz_math) {
+  const ozz::math::Float4x4 translation = ozz::math::Float4x4::Translation(
+      ozz::math::simd_float4::Load(2.f, 2.f, 2.f, 0.f));
+
+  ozz::math::Box boxes[2] = {
+      ozz::math::Box(ozz::math::Float3(1.f, 2.f, 3.f),
+                     ozz::math::Float3(4.f, 5.f, 6.f)),
+      ozz::math::Box(ozz::math::Float3(-10.f, -10.f, -10.f),
+                     ozz::math::Float3(10.f, 10.f, 10.f))};
+
+  ozz::math::Box transformed[2];
+  ozz::math::TransformBoxes(translation, ozz::make_span(boxes),
+                            ozz::make_span(transformed));
+  for (size_t i = 0; i < 2; ++i) {
+    const ozz::math::Box ref = ozz::math::TransformBox(translation, boxes[i]);
+    EXPECT_FLOAT3_EQ(transformed[i].min, ref.min.x, ref.min.y, ref.min.z);
+    EXPECT_FLOAT3_EQ(transformed[i].max, ref.max.x, ref.max.y, ref.max.z);
+  }
+  EXPECT_FLOAT3_EQ(transformed[0].min, 3.f, 4.f, 5.f);
+  EXPECT_FLOAT3_EQ(transformed[0].max, 6.f, 7.f, 8.f);
+
+  // In place transformation is supported.
+  ozz::math::TransformBoxes(translation, ozz::make_span(boxes),
+                            ozz::make_span(boxes));
+  EXPECT_FLOAT3_EQ(boxes[0].min, 3.f, 4.f, 5.f);
+  EXPECT_FLOAT3_EQ(boxes[0].max, 6.f, 7.f, 8.f);
+}
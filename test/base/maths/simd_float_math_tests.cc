@@ -645,6 +645,31 @@ TEST(TrigonometryFloat, ozz_simd_math) {
   EXPECT_SIMDFLOAT_EQ(ozz::math::ATanX(tan), 0.f, .57735f, -1.73205f, 1.f);
 }
 
+TEST(TrigonometryEstFloat, ozz_simd_math) {
+  using ozz::math::kPi;
+  using ozz::math::kPi_2;
+
+  // Estimated functions are only valid within [-pi, pi] range.
+  const SimdFloat4 angle =
+      ozz::math::simd_float4::Load(kPi, kPi / 6.f, -kPi_2, -.75f * kPi);
+  const SimdFloat4 cos =
+      ozz::math::simd_float4::Load(-1.f, .86602539f, 0.f, .5f);
+
+  EXPECT_SIMDFLOAT_EQ_EST(ozz::math::CosEst(angle), -1.f, .86602539f, 0.f,
+                          -.70710677f);
+  EXPECT_SIMDFLOAT_EQ_EST(ozz::math::CosEstX(angle), -1.f, kPi / 6.f, -kPi_2,
+                          -.75f * kPi);
+
+  EXPECT_SIMDFLOAT_EQ_EST(ozz::math::SinEst(angle), 0.f, .5f, -1.f,
+                          -.70710677f);
+  EXPECT_SIMDFLOAT_EQ_EST(ozz::math::SinEstX(angle), 0.f, kPi / 6.f, -kPi_2,
+                          -.75f * kPi);
+
+  EXPECT_SIMDFLOAT_EQ_EST(ozz::math::ACosEst(cos), kPi, kPi / 6.f, kPi_2,
+                          kPi / 3.f);
+  EXPECT_SIMDFLOAT_EQ_EST(ozz::math::ACosEstX(cos), kPi, .86602539f, 0.f, .5f);
+}
+
 TEST(LogicalFloat, ozz_simd_math) {
   const SimdFloat4 a = ozz::math::simd_float4::Load(0.f, 1.f, 2.f, 3.f);
   const SimdFloat4 b = ozz::math::simd_float4::Load(1.f, -1.f, -3.f, -4.f);
@@ -365,6 +365,22 @@ TEST(QuaternionAxisAngle, ozz_simd_math) {
   EXPECT_SIMDQUATERNION_EQ(qany, .4365425f, .017589169f, -.30435428f,
                            .84645736f);
   EXPECT_SIMDFLOAT_EQ(ToAxisAngle(qany), .819865f, .033034f, -.571604f, 1.123f);
+
+  // Estimated variant, within its [-2pi, 2pi] angle validity range.
+  EXPECT_ASSERTION(
+      SimdQuaternion::FromAxisAngleEst(ozz::math::simd_float4::zero(),
+                                       ozz::math::simd_float4::zero()),
+      "axis is not normalized.");
+  EXPECT_SIMDQUATERNION_EQ_EST(
+      SimdQuaternion::FromAxisAngleEst(ozz::math::simd_float4::y_axis(), pi_2),
+      0.f, .70710677f, 0.f, .70710677f);
+  EXPECT_SIMDQUATERNION_EQ_EST(
+      SimdQuaternion::FromAxisAngleEst(ozz::math::simd_float4::y_axis(),
+                                       -pi_2),
+      0.f, -.70710677f, 0.f, .70710677f);
+  EXPECT_SIMDQUATERNION_EQ_EST(
+      SimdQuaternion::FromAxisAngleEst(any_axis, any_angle), .4365425f,
+      .017589169f, -.30435428f, .84645736f);
 }
 
 TEST(QuaternionAxisCosAngle, ozz_simd_math) {
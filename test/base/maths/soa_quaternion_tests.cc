@@ -180,3 +180,76 @@ TEST(SoaQuaternionArithmetic, ozz_soa_math) {
   const SimdInt4 same_ab = Compare(a, b, ozz::math::simd_float4::Load1(.99f));
   EXPECT_SIMDINT_EQ(same_ab, 0, 0, 0xffffffff, 0);
 }
+
+TEST(SoaQuaternionBatch, ozz_soa_math) {
+  // 3 blocks with different magnitudes and orientations, odd count to
+  // exercise the batch kernels remainder path.
+  const SoaQuaternion input[3] = {
+      SoaQuaternion::Load(
+          ozz::math::simd_float4::Load(.70710677f, 0.f, 2.f, 3.f),
+          ozz::math::simd_float4::Load(0.f, 0.f, 6.f, 6.f),
+          ozz::math::simd_float4::Load(0.f, 0.f, 10.f, 10.f),
+          ozz::math::simd_float4::Load(.70710677f, 1.f, 14.f, 13.6f)),
+      SoaQuaternion::Load(
+          ozz::math::simd_float4::Load(0.f, .5f, -2.f, 1.f),
+          ozz::math::simd_float4::Load(.70710677f, .5f, 0.f, 2.f),
+          ozz::math::simd_float4::Load(0.f, .5f, 2.f, 3.f),
+          ozz::math::simd_float4::Load(.70710677f, .5f, 4.f, 4.f)),
+      SoaQuaternion::Load(
+          ozz::math::simd_float4::Load(1.f, -1.f, .1f, 0.f),
+          ozz::math::simd_float4::Load(2.f, 1.f, .2f, 0.f),
+          ozz::math::simd_float4::Load(3.f, -1.f, .3f, 0.f),
+          ozz::math::simd_float4::Load(4.f, 1.f, .4f, 2.f))};
+  const SoaQuaternion to[3] = {
+      SoaQuaternion::Load(
+          ozz::math::simd_float4::Load(0.f, .70710677f, 0.f, -.382683432f),
+          ozz::math::simd_float4::Load(0.f, 0.f, .70710677f, 0.f),
+          ozz::math::simd_float4::Load(0.f, 0.f, 0.f, 0.f),
+          ozz::math::simd_float4::Load(1.f, .70710677f, .70710677f,
+                                       .9238795f)),
+      SoaQuaternion::identity(), SoaQuaternion::identity()};
+
+  {  // NormalizeN matches per block Normalize, including the odd tail.
+    SoaQuaternion output[3];
+    ozz::math::NormalizeN(ozz::make_span(input), ozz::make_span(output));
+    for (size_t i = 0; i < 3; ++i) {
+      const SoaQuaternion expected = Normalize(input[i]);
+      EXPECT_TRUE(ozz::math::AreAllTrue(output[i] == expected));
+      EXPECT_TRUE(ozz::math::AreAllTrue(IsNormalized(output[i])));
+    }
+  }
+
+  {  // NormalizeEstN matches per block NormalizeEst.
+    SoaQuaternion output[3];
+    ozz::math::NormalizeEstN(ozz::make_span(input), ozz::make_span(output));
+    for (size_t i = 0; i < 3; ++i) {
+      const SoaQuaternion expected = NormalizeEst(input[i]);
+      EXPECT_TRUE(ozz::math::AreAllTrue(output[i] == expected));
+      EXPECT_TRUE(ozz::math::AreAllTrue(IsNormalizedEst(output[i])));
+    }
+  }
+
+  {  // NLerpN matches per block NLerp.
+    const ozz::math::SimdFloat4 f =
+        ozz::math::simd_float4::Load(0.f, 1.f, 1.f, .2f);
+    SoaQuaternion output[3];
+    ozz::math::NLerpN(ozz::make_span(input), ozz::make_span(to), f,
+                      ozz::make_span(output));
+    for (size_t i = 0; i < 3; ++i) {
+      const SoaQuaternion expected = NLerp(input[i], to[i], f);
+      EXPECT_TRUE(ozz::math::AreAllTrue(output[i] == expected));
+    }
+  }
+
+  {  // NLerpEstN matches per block NLerpEst, and supports aliasing its first
+     // input.
+    const ozz::math::SimdFloat4 f = ozz::math::simd_float4::Load1(.2f);
+    SoaQuaternion output[3] = {input[0], input[1], input[2]};
+    ozz::math::NLerpEstN(ozz::make_span(output).subspan(0, 3),
+                         ozz::make_span(to), f, ozz::make_span(output));
+    for (size_t i = 0; i < 3; ++i) {
+      const SoaQuaternion expected = NLerpEst(input[i], to[i], f);
+      EXPECT_TRUE(ozz::math::AreAllTrue(output[i] == expected));
+    }
+  }
+}
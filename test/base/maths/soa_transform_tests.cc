@@ -31,8 +31,12 @@
 
 #include "ozz/base/gtest_helper.h"
 #include "ozz/base/maths/gtest_math_helper.h"
+#include "ozz/base/maths/soa_transform_conversion.h"
+#include "ozz/base/maths/transform.h"
+#include "ozz/base/span.h"
 
 using ozz::math::SoaTransform;
+using ozz::math::Transform;
 
 TEST(SoaTransformConstant, ozz_soa_math) {
   EXPECT_SOAFLOAT3_EQ(SoaTransform::identity().translation, 0.f, 0.f, 0.f, 0.f,
@@ -43,3 +47,88 @@ TEST(SoaTransformConstant, ozz_soa_math) {
   EXPECT_SOAFLOAT3_EQ(SoaTransform::identity().scale, 1.f, 1.f, 1.f, 1.f, 1.f,
                       1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f);
 }
+
+namespace {
+// Builds a distinguishable aos transform for lane/joint _i.
+Transform BuildTestTransform(int _i) {
+  const float f = static_cast<float>(_i);
+  Transform transform;
+  transform.translation = ozz::math::Float3(f, f + 1.f, f + 2.f);
+  transform.rotation = ozz::math::Quaternion(f * .1f, f * .1f + .01f,
+                                             f * .1f + .02f, f * .1f + .03f);
+  transform.scale = ozz::math::Float3(-f, -f - 1.f, -f - 2.f);
+  return transform;
+}
+}  // namespace
+
+TEST(SoaTransformScatterGather, ozz_soa_math) {
+  SoaTransform block = SoaTransform::identity();
+
+  // Scatters a different transform to each lane, checking lanes already
+  // written are left untouched.
+  for (int lane = 0; lane < 4; ++lane) {
+    ozz::math::ScatterTransform(BuildTestTransform(lane), lane, &block);
+    for (int i = 0; i < lane; ++i) {
+      const Transform back = ozz::math::GatherTransform(block, i);
+      const float f = static_cast<float>(i);
+      EXPECT_FLOAT3_EQ(back.translation, f, f + 1.f, f + 2.f);
+      EXPECT_QUATERNION_EQ(back.rotation, f * .1f, f * .1f + .01f,
+                           f * .1f + .02f, f * .1f + .03f);
+      EXPECT_FLOAT3_EQ(back.scale, -f, -f - 1.f, -f - 2.f);
+    }
+    // Lanes beyond the last scattered one still hold the identity.
+    for (int i = lane + 1; i < 4; ++i) {
+      const Transform back = ozz::math::GatherTransform(block, i);
+      EXPECT_FLOAT3_EQ(back.translation, 0.f, 0.f, 0.f);
+      EXPECT_QUATERNION_EQ(back.rotation, 0.f, 0.f, 0.f, 1.f);
+      EXPECT_FLOAT3_EQ(back.scale, 1.f, 1.f, 1.f);
+    }
+  }
+
+  EXPECT_SOAFLOAT3_EQ(block.translation, 0.f, 1.f, 2.f, 3.f, 1.f, 2.f, 3.f,
+                      4.f, 2.f, 3.f, 4.f, 5.f);
+  EXPECT_SOAQUATERNION_EQ(block.rotation, 0.f, .1f, .2f, .3f, .01f, .11f, .21f,
+                          .31f, .02f, .12f, .22f, .32f, .03f, .13f, .23f, .33f);
+  EXPECT_SOAFLOAT3_EQ(block.scale, 0.f, -1.f, -2.f, -3.f, -1.f, -2.f, -3.f,
+                      -4.f, -2.f, -3.f, -4.f, -5.f);
+}
+
+TEST(SoaTransformPackUnpack, ozz_soa_math) {
+  // 6 transforms span 2 blocks, the 2nd one being incomplete.
+  Transform transforms[6];
+  for (int i = 0; i < 6; ++i) {
+    transforms[i] = BuildTestTransform(i);
+  }
+  SoaTransform blocks[2];
+  ozz::math::PackSoaTransforms(ozz::span<const Transform>(transforms),
+                               ozz::make_span(blocks));
+
+  EXPECT_SOAFLOAT3_EQ(blocks[0].translation, 0.f, 1.f, 2.f, 3.f, 1.f, 2.f, 3.f,
+                      4.f, 2.f, 3.f, 4.f, 5.f);
+  EXPECT_SOAQUATERNION_EQ(blocks[0].rotation, 0.f, .1f, .2f, .3f, .01f, .11f,
+                          .21f, .31f, .02f, .12f, .22f, .32f, .03f, .13f, .23f,
+                          .33f);
+  EXPECT_SOAFLOAT3_EQ(blocks[0].scale, 0.f, -1.f, -2.f, -3.f, -1.f, -2.f, -3.f,
+                      -4.f, -2.f, -3.f, -4.f, -5.f);
+
+  // Padding lanes of the incomplete last block are identity.
+  EXPECT_SOAFLOAT3_EQ(blocks[1].translation, 4.f, 5.f, 0.f, 0.f, 5.f, 6.f, 0.f,
+                      0.f, 6.f, 7.f, 0.f, 0.f);
+  EXPECT_SOAQUATERNION_EQ(blocks[1].rotation, .4f, .5f, 0.f, 0.f, .41f, .51f,
+                          0.f, 0.f, .42f, .52f, 0.f, 0.f, .43f, .53f, 1.f,
+                          1.f);
+  EXPECT_SOAFLOAT3_EQ(blocks[1].scale, -4.f, -5.f, 1.f, 1.f, -5.f, -6.f, 1.f,
+                      1.f, -6.f, -7.f, 1.f, 1.f);
+
+  // Unpacks back and compares with the source transforms.
+  Transform back[6];
+  ozz::math::UnpackSoaTransforms(ozz::span<const SoaTransform>(blocks),
+                                 ozz::make_span(back));
+  for (int i = 0; i < 6; ++i) {
+    const float f = static_cast<float>(i);
+    EXPECT_FLOAT3_EQ(back[i].translation, f, f + 1.f, f + 2.f);
+    EXPECT_QUATERNION_EQ(back[i].rotation, f * .1f, f * .1f + .01f,
+                         f * .1f + .02f, f * .1f + .03f);
+    EXPECT_FLOAT3_EQ(back[i].scale, -f, -f - 1.f, -f - 2.f);
+  }
+}
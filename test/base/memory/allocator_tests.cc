@@ -152,3 +152,83 @@ TEST(AllocatorOverride, Memory) {
 
   EXPECT_EQ(ozz::memory::SetDefaulAllocator(previous), current);
 }
+
+TEST(Tracking, Memory) {
+  using ozz::memory::AllocationStats;
+  using ozz::memory::AllocationTag;
+
+  ozz::memory::Allocator* allocator = ozz::memory::default_allocator();
+
+  // Blocks allocated while tracking is disabled (the default) don't alter
+  // statistics, even when freed after tracking was enabled.
+  void* untracked = allocator->Allocate(64, 16);
+
+  EXPECT_FALSE(ozz::memory::SetAllocationTracking(true));
+  allocator->Deallocate(untracked);
+
+  const AllocationStats clean =
+      ozz::memory::GetAllocationStats(AllocationTag::kDefault);
+  EXPECT_EQ(clean.live_bytes, 0u);
+  EXPECT_EQ(clean.peak_bytes, 0u);
+  EXPECT_EQ(clean.live_count, 0u);
+  EXPECT_EQ(clean.total_count, 0u);
+
+  {  // Tagged allocations are attributed to the scope tag, and live/peak
+     // bytes follow allocations and deallocations.
+    const ozz::memory::AllocationScope scope(AllocationTag::kBuilder);
+    void* first = allocator->Allocate(100, 16);
+    void* second = allocator->Allocate(50, 16);
+    allocator->Deallocate(first);
+
+    const AllocationStats stats =
+        ozz::memory::GetAllocationStats(AllocationTag::kBuilder);
+    EXPECT_EQ(stats.live_bytes, 50u);
+    EXPECT_EQ(stats.peak_bytes, 150u);
+    EXPECT_EQ(stats.live_count, 1u);
+    EXPECT_EQ(stats.total_count, 2u);
+
+    {  // Nested scope retargets allocations, then restores the outer tag.
+      const ozz::memory::AllocationScope nested(AllocationTag::kAnimation);
+      void* block = allocator->Allocate(12, 16);
+      EXPECT_EQ(
+          ozz::memory::GetAllocationStats(AllocationTag::kAnimation).live_bytes,
+          12u);
+      allocator->Deallocate(block);
+    }
+    void* third = allocator->Allocate(1, 16);
+    EXPECT_EQ(ozz::memory::GetAllocationStats(AllocationTag::kBuilder)
+                  .total_count,
+              3u);
+    allocator->Deallocate(third);
+    allocator->Deallocate(second);
+  }
+
+  // Everything was freed, peak and totals survive.
+  const AllocationStats stats =
+      ozz::memory::GetAllocationStats(AllocationTag::kBuilder);
+  EXPECT_EQ(stats.live_bytes, 0u);
+  EXPECT_EQ(stats.peak_bytes, 150u);
+  EXPECT_EQ(stats.live_count, 0u);
+  EXPECT_EQ(stats.total_count, 3u);
+
+  // Re-enabling tracking resets statistics.
+  EXPECT_TRUE(ozz::memory::SetAllocationTracking(false));
+  EXPECT_FALSE(ozz::memory::SetAllocationTracking(true));
+  EXPECT_EQ(ozz::memory::GetAllocationStats(AllocationTag::kBuilder).peak_bytes,
+            0u);
+  EXPECT_TRUE(ozz::memory::SetAllocationTracking(false));
+}
+
+TEST(AllocateOnNode, Memory) {
+  // The default allocator ignores the node hint and forwards to Allocate,
+  // returning a usable block whatever the node.
+  const int nodes[] = {ozz::memory::Allocator::kAnyNode, 0, 1, 46};
+  for (size_t i = 0; i < OZZ_ARRAY_SIZE(nodes); ++i) {
+    void* p =
+        ozz::memory::default_allocator()->AllocateOnNode(12, 64, nodes[i]);
+    EXPECT_TRUE(p != nullptr);
+    EXPECT_TRUE(ozz::IsAligned(p, 64));
+    memset(p, 0, 12);
+    ozz::memory::default_allocator()->Deallocate(p);
+  }
+}
@@ -0,0 +1,173 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/base/memory/arena_allocator.h"
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+#include "ozz/base/containers/vector.h"
+
+TEST(Allocate, ArenaAllocator) {
+  ozz::memory::ArenaAllocator arena;
+
+  // No memory is reserved until the first allocation.
+  EXPECT_EQ(arena.reserved(), 0u);
+
+  // Allocations are served and aligned as requested.
+  void* p1 = arena.Allocate(12, 1024);
+  ASSERT_TRUE(p1 != nullptr);
+  EXPECT_TRUE(ozz::IsAligned(p1, 1024));
+  EXPECT_GT(arena.reserved(), 0u);
+
+  void* p2 = arena.Allocate(46, 64);
+  ASSERT_TRUE(p2 != nullptr);
+  EXPECT_TRUE(ozz::IsAligned(p2, 64));
+  EXPECT_NE(p1, p2);
+
+  // Allocated memory is usable.
+  std::memset(p1, 0xab, 12);
+  std::memset(p2, 0xcd, 46);
+
+  // Deallocate is a no-op, including for foreign and null pointers.
+  arena.Deallocate(p1);
+  arena.Deallocate(nullptr);
+
+  // Reset releases everything at once.
+  arena.Reset();
+  EXPECT_EQ(arena.reserved(), 0u);
+}
+
+TEST(Chunks, ArenaAllocator) {
+  // Uses a small chunk size to exercise chunk chaining.
+  const size_t kChunkSize = 256;
+  ozz::memory::ArenaAllocator arena(kChunkSize);
+
+  // Fills more than a single chunk worth of small allocations.
+  for (size_t i = 0; i < 100; ++i) {
+    void* p = arena.Allocate(16, 16);
+    ASSERT_TRUE(p != nullptr);
+    EXPECT_TRUE(ozz::IsAligned(p, 16));
+    std::memset(p, 0x55, 16);
+  }
+  EXPECT_GE(arena.reserved(), 100 * 16u);
+
+  // Allocations bigger than the chunk payload get a dedicated chunk, without
+  // wasting the current chunk remaining space.
+  const size_t reserved = arena.reserved();
+  void* big = arena.Allocate(kChunkSize * 4, 16);
+  ASSERT_TRUE(big != nullptr);
+  std::memset(big, 0x55, kChunkSize * 4);
+  EXPECT_GE(arena.reserved(), reserved + kChunkSize * 4);
+  void* small = arena.Allocate(16, 16);
+  ASSERT_TRUE(small != nullptr);
+  EXPECT_TRUE(ozz::IsAligned(small, 16));
+}
+
+TEST(Scope, ArenaAllocator) {
+  // Uses a small chunk size to exercise chunk release on rewind.
+  const size_t kChunkSize = 256;
+  ozz::memory::ArenaAllocator arena(kChunkSize);
+
+  // Warms the arena up with an allocation that outlives the scopes.
+  void* persistent = arena.Allocate(16, 16);
+  ASSERT_TRUE(persistent != nullptr);
+  std::memset(persistent, 0x5a, 16);
+  const size_t warm_reserved = arena.reserved();
+
+  {  // A scope that fits in the current chunk rewinds the cursor, so the
+     // same memory is served again by the next scope.
+    void* scoped1;
+    {
+      ozz::memory::ArenaAllocator::Scope scope(arena);
+      scoped1 = arena.Allocate(16, 16);
+      ASSERT_TRUE(scoped1 != nullptr);
+    }
+    EXPECT_EQ(arena.reserved(), warm_reserved);
+    void* scoped2;
+    {
+      ozz::memory::ArenaAllocator::Scope scope(arena);
+      scoped2 = arena.Allocate(16, 16);
+      ASSERT_TRUE(scoped2 != nullptr);
+    }
+    EXPECT_EQ(scoped1, scoped2);
+  }
+
+  {  // A scope that overflows into new chunks, oversized ones included,
+     // releases them back on rewind.
+    {
+      ozz::memory::ArenaAllocator::Scope scope(arena);
+      for (size_t i = 0; i < 100; ++i) {
+        void* p = arena.Allocate(16, 16);
+        ASSERT_TRUE(p != nullptr);
+        std::memset(p, 0x55, 16);
+      }
+      void* big = arena.Allocate(kChunkSize * 4, 16);
+      ASSERT_TRUE(big != nullptr);
+      std::memset(big, 0x55, kChunkSize * 4);
+      EXPECT_GT(arena.reserved(), warm_reserved);
+    }
+    EXPECT_EQ(arena.reserved(), warm_reserved);
+  }
+
+  {  // Scopes nest, each rewinding to its own capture point.
+    ozz::memory::ArenaAllocator::Scope outer(arena);
+    void* po = arena.Allocate(16, 16);
+    ASSERT_TRUE(po != nullptr);
+    {
+      ozz::memory::ArenaAllocator::Scope inner(arena);
+      void* pi = arena.Allocate(kChunkSize * 4, 16);
+      ASSERT_TRUE(pi != nullptr);
+    }
+    // The outer scope allocation survived the inner rewind.
+    std::memset(po, 0xa5, 16);
+    EXPECT_EQ(arena.reserved(), warm_reserved);
+  }
+
+  // The pre-scope allocation is still live.
+  for (size_t i = 0; i < 16; ++i) {
+    EXPECT_EQ(static_cast<unsigned char*>(persistent)[i], 0x5a);
+  }
+}
+
+TEST(DefaultAllocator, ArenaAllocator) {
+  // Binds ozz containers to the arena through the default allocator, as an
+  // importer would do for raw offline types.
+  ozz::memory::ArenaAllocator arena;
+  ozz::memory::Allocator* previous =
+      ozz::memory::SetDefaulAllocator(&arena);
+  {
+    // Containers allocated in this scope must not outlive the arena.
+    ozz::vector<ozz::vector<int>> vectors(100);
+    for (size_t i = 0; i < vectors.size(); ++i) {
+      vectors[i].resize(i + 1, static_cast<int>(i));
+    }
+    EXPECT_GE(arena.reserved(), 100 * sizeof(int));
+    EXPECT_EQ(vectors[99][99], 99);
+  }
+  ozz::memory::SetDefaulAllocator(previous);
+}
@@ -0,0 +1,117 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+#include "ozz/base/maths/simd_math.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/memory/pose_buffer_pool.h"
+
+using ozz::memory::PoseBufferPool;
+
+TEST(AcquireRelease, PoseBufferPool) {
+  PoseBufferPool pool;
+
+  {  // Empty acquisition.
+    ozz::span<ozz::byte> buffer = pool.Acquire(0);
+    EXPECT_TRUE(buffer.empty());
+    pool.Release(buffer);  // No-op.
+    EXPECT_EQ(pool.num_recycled(), 0u);
+  }
+
+  {  // Buffers are aligned and writable.
+    ozz::span<ozz::byte> buffer = pool.Acquire(123);
+    ASSERT_EQ(buffer.size(), 123u);
+    EXPECT_TRUE(ozz::IsAligned(buffer.data(), PoseBufferPool::kAlignment));
+    std::memset(buffer.data(), 0xab, buffer.size());
+    pool.Release(buffer);
+    EXPECT_EQ(pool.num_recycled(), 1u);
+  }
+
+  {  // Released buffers are recycled, most recently released first.
+    ozz::span<ozz::byte> buffer = pool.Acquire(100);
+    ozz::byte* const recycled = buffer.data();
+    pool.Release(buffer);
+
+    // Same bucket (rounds up to the same power of two size).
+    ozz::span<ozz::byte> again = pool.Acquire(128);
+    EXPECT_EQ(again.data(), recycled);
+
+    // Bucket is now empty, next acquisition allocates.
+    ozz::span<ozz::byte> other = pool.Acquire(100);
+    EXPECT_NE(other.data(), recycled);
+
+    pool.Release(again);
+    pool.Release(other);
+    EXPECT_EQ(pool.num_recycled(), 2u);
+  }
+
+  // Trim returns recycled buffers to the allocator.
+  pool.Trim();
+  EXPECT_EQ(pool.num_recycled(), 0u);
+}
+
+TEST(Typed, PoseBufferPool) {
+  PoseBufferPool pool;
+
+  // Typical usage: local-space and model-space pose buffers of an instance.
+  ozz::span<ozz::math::SoaTransform> locals =
+      pool.Acquire<ozz::math::SoaTransform>(17);
+  ozz::span<ozz::math::Float4x4> models = pool.Acquire<ozz::math::Float4x4>(65);
+  ASSERT_EQ(locals.size(), 17u);
+  ASSERT_EQ(models.size(), 65u);
+  EXPECT_TRUE(ozz::IsAligned(locals.data(), PoseBufferPool::kAlignment));
+  EXPECT_TRUE(ozz::IsAligned(models.data(), PoseBufferPool::kAlignment));
+  locals[16] = ozz::math::SoaTransform::identity();
+  models[64] = ozz::math::Float4x4::identity();
+
+  // Releasing through the typed variant recycles to the same buckets.
+  ozz::math::SoaTransform* const recycled = locals.data();
+  pool.Release(locals);
+  pool.Release(models);
+  EXPECT_EQ(pool.num_recycled(), 2u);
+
+  // A same-size instance reuses the recycled buffer.
+  ozz::span<ozz::math::SoaTransform> locals2 =
+      pool.Acquire<ozz::math::SoaTransform>(17);
+  EXPECT_EQ(locals2.data(), recycled);
+  pool.Release(locals2);
+}
+
+TEST(BigBuffers, PoseBufferPool) {
+  PoseBufferPool pool;
+
+  // Buffers too big to be bucketed aren't pooled, but acquisition still
+  // works, serving directly from the allocator.
+  const size_t big_size = (PoseBufferPool::kAlignment << 19) + 1;
+  ozz::span<ozz::byte> buffer = pool.Acquire(big_size);
+  ASSERT_EQ(buffer.size(), big_size);
+  EXPECT_TRUE(ozz::IsAligned(buffer.data(), PoseBufferPool::kAlignment));
+  pool.Release(buffer);
+  EXPECT_EQ(pool.num_recycled(), 0u);
+}
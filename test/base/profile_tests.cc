@@ -0,0 +1,92 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+// Enables instrumentation for this translation unit, whatever the build
+// option, as the macro gating is done in the header.
+#define OZZ_PROFILE
+
+#include "ozz/base/profile.h"
+
+#include "gtest/gtest.h"
+#include "ozz/base/containers/string.h"
+#include "ozz/base/containers/vector.h"
+
+namespace {
+
+// Records every event the sink receives.
+struct Event {
+  ozz::string name;
+  int count;
+  bool begin;
+};
+
+void Record(void* _context, const char* _name, int _count, bool _begin) {
+  const Event event = {_name, _count, _begin};
+  static_cast<ozz::vector<Event>*>(_context)->push_back(event);
+}
+}  // namespace
+
+TEST(Scope, Profile) {
+  // No sink registered (the default), zones are silently dropped.
+  { OZZ_PROFILE_JOB("unheard", 46); }
+
+  ozz::vector<Event> events;
+  ozz::SetProfileHandler(&Record, &events);
+
+  {  // A zone emits paired begin/end events, count on begin only.
+    { OZZ_PROFILE_JOB("job", 46); }
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_STREQ(events[0].name.c_str(), "job");
+    EXPECT_EQ(events[0].count, 46);
+    EXPECT_TRUE(events[0].begin);
+    EXPECT_STREQ(events[1].name.c_str(), "job");
+    EXPECT_FALSE(events[1].begin);
+  }
+
+  {  // Nested zones close in reverse opening order.
+    events.clear();
+    {
+      OZZ_PROFILE_JOB("outer", 2);
+      { OZZ_PROFILE_JOB("inner", 1); }
+    }
+    ASSERT_EQ(events.size(), 4u);
+    EXPECT_STREQ(events[0].name.c_str(), "outer");
+    EXPECT_STREQ(events[1].name.c_str(), "inner");
+    EXPECT_TRUE(events[1].begin);
+    EXPECT_STREQ(events[2].name.c_str(), "inner");
+    EXPECT_FALSE(events[2].begin);
+    EXPECT_STREQ(events[3].name.c_str(), "outer");
+    EXPECT_FALSE(events[3].begin);
+  }
+
+  {  // Unregistering stops emission.
+    events.clear();
+    ozz::SetProfileHandler(nullptr, nullptr);
+    { OZZ_PROFILE_JOB("job", 46); }
+    EXPECT_TRUE(events.empty());
+  }
+}
@@ -0,0 +1,125 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include <atomic>
+
+#include "gtest/gtest.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/scheduler.h"
+
+namespace {
+
+// Raw interface context, counting processed elements and invocations.
+struct Counters {
+  std::atomic<int> elements;
+  std::atomic<int> invocations;
+};
+
+void Count(void* _context, int _begin, int _end) {
+  Counters* counters = static_cast<Counters*>(_context);
+  counters->elements.fetch_add(_end - _begin);
+  counters->invocations.fetch_add(1);
+}
+
+// Runs the checks shared by all scheduler implementations.
+void TestScheduler(ozz::Scheduler* _scheduler) {
+  {  // Empty and invalid ranges don't invoke the function.
+    Counters counters = {{0}, {0}};
+    _scheduler->ParallelFor(0, 0, 1, &Count, &counters);
+    _scheduler->ParallelFor(46, 27, 1, &Count, &counters);
+    EXPECT_EQ(counters.invocations, 0);
+  }
+
+  {  // Every element of the range is processed exactly once.
+    ozz::vector<int> processed(10000, 0);
+    _scheduler->ParallelForFct(0, static_cast<int>(processed.size()), 8,
+                               [&processed](int _begin, int _end) {
+                                 for (int i = _begin; i < _end; ++i) {
+                                   ++processed[i];
+                                 }
+                               });
+    for (size_t i = 0; i < processed.size(); ++i) {
+      ASSERT_EQ(processed[i], 1);
+    }
+  }
+
+  {  // Subranges cover the range, don't overlap, and respect granularity.
+    Counters counters = {{0}, {0}};
+    _scheduler->ParallelFor(-100, 100, 10, &Count, &counters);
+    EXPECT_EQ(counters.elements, 200);
+    EXPECT_LE(counters.invocations, 20);
+  }
+
+  {  // A range smaller than granularity is processed in a single invocation.
+    Counters counters = {{0}, {0}};
+    _scheduler->ParallelFor(0, 10, 100, &Count, &counters);
+    EXPECT_EQ(counters.elements, 10);
+    EXPECT_EQ(counters.invocations, 1);
+  }
+
+  {  // Nested parallel-for.
+    std::atomic<int> total(0);
+    _scheduler->ParallelForFct(0, 4, 1, [_scheduler, &total](int _begin,
+                                                             int _end) {
+      for (int i = _begin; i < _end; ++i) {
+        _scheduler->ParallelForFct(
+            0, 100, 1, [&total](int _b, int _e) { total.fetch_add(_e - _b); });
+      }
+    });
+    EXPECT_EQ(total, 400);
+  }
+}
+}  // namespace
+
+TEST(Serial, Scheduler) {
+  ozz::SerialScheduler scheduler;
+  TestScheduler(&scheduler);
+}
+
+TEST(ThreadPool, Scheduler) {
+  {  // Default worker count is based on hardware concurrency.
+    ozz::ThreadPoolScheduler scheduler;
+    EXPECT_GT(scheduler.num_workers(), 0);
+    TestScheduler(&scheduler);
+  }
+
+  {  // Explicit worker count.
+    ozz::ThreadPoolScheduler scheduler(3);
+    EXPECT_EQ(scheduler.num_workers(), 3);
+    TestScheduler(&scheduler);
+  }
+
+  {  // Successive calls reuse persistent workers.
+    ozz::ThreadPoolScheduler scheduler(2);
+    std::atomic<int> total(0);
+    for (int i = 0; i < 100; ++i) {
+      scheduler.ParallelForFct(
+          0, 1000, 1, [&total](int _b, int _e) { total.fetch_add(_e - _b); });
+    }
+    EXPECT_EQ(total, 100000);
+  }
+}
@@ -160,6 +160,50 @@ TEST(SpanFill, Platform) {
   EXPECT_ASSERTION(ozz::fill_span<int>(src, 1), "Invalid alignment.");
 }
 
+TEST(AlignedSpan, Platform) {
+  const size_t kSize = 16;
+  alignas(64) int ai[kSize];
+
+  ozz::aligned_span<int, 64> empty;
+  EXPECT_TRUE(empty.begin() == nullptr);
+  EXPECT_EQ(empty.size(), 0u);
+
+  ozz::aligned_span<int, 64> as(ai, kSize);
+  EXPECT_EQ(as.data(), ai);
+  EXPECT_EQ(as.size(), kSize);
+  EXPECT_EQ(as.alignment, 64u);
+
+  // Misaligned buffers are refused.
+  EXPECT_ASSERTION((ozz::aligned_span<int, 64>(ai + 1, 1)),
+                   "Invalid alignment.");
+
+  // Converts freely to spans, so it's accepted anywhere a span is.
+  ozz::span<int> s = as;
+  EXPECT_EQ(s.data(), ai);
+  EXPECT_EQ(s.size(), kSize);
+  ozz::span<const int> cs = as;
+  EXPECT_EQ(cs.data(), ai);
+
+  // The guarantee can be kept while adding constness, or relaxed to a lesser
+  // alignment, but never increased.
+  ozz::aligned_span<const int, 16> relaxed(as);
+  EXPECT_EQ(relaxed.data(), ai);
+  EXPECT_EQ(relaxed.size(), kSize);
+
+  // First elements keep the data pointer, hence the alignment guarantee.
+  ozz::aligned_span<int, 64> first = as.first(8);
+  EXPECT_EQ(first.data(), ai);
+  EXPECT_EQ(first.size(), 8u);
+
+  // Promotes a span whose buffer is known to be aligned.
+  ozz::aligned_span<int, 64> promoted =
+      ozz::assume_aligned<64>(ozz::make_span(ai));
+  EXPECT_EQ(promoted.data(), ai);
+  EXPECT_EQ(promoted.size(), kSize);
+  EXPECT_ASSERTION(ozz::assume_aligned<64>(ozz::span<int>(ai + 1, 1)),
+                   "Invalid alignment.");
+}
+
 TEST(SpanRangeLoop, Platform) {
   const size_t kSize = 46;
   size_t ai[kSize];
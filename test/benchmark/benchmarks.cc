@@ -0,0 +1,440 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+// Microbenchmarks for ozz runtime jobs, across realistic skeleton sizes.
+// Emits machine-readable JSON (to stdout or to the --out file) so per-commit
+// throughput can be charted and performance regressions caught before they
+// land. Timings rely on std::chrono::steady_clock, the most portable
+// monotonic clock available, and report minimum, median and mean of
+// --iterations measures, minimum being the least noisy statistic on a shared
+// machine.
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+#include "ozz/animation/offline/animation_builder.h"
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/offline/raw_skeleton.h"
+#include "ozz/animation/offline/raw_track.h"
+#include "ozz/animation/offline/skeleton_builder.h"
+#include "ozz/animation/offline/track_builder.h"
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/animation/runtime/blending_job.h"
+#include "ozz/animation/runtime/ik_aim_job.h"
+#include "ozz/animation/runtime/ik_two_bone_job.h"
+#include "ozz/animation/runtime/local_to_model_job.h"
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/animation/runtime/track.h"
+#include "ozz/animation/runtime/track_sampling_job.h"
+#include "ozz/base/containers/string.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/maths/simd_quaternion.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/memory/unique_ptr.h"
+#include "ozz/geometry/runtime/skinning_job.h"
+#include "ozz/options/options.h"
+
+// Declares command line options.
+OZZ_OPTIONS_DECLARE_INT(iterations,
+                        "Number of timed iterations per benchmark", 50, false)
+OZZ_OPTIONS_DECLARE_STRING(
+    out, "Path of the output JSON file, empty for stdout", "", false)
+
+namespace {
+
+// Consumes benchmarked outputs, so the optimizer cannot discard the work.
+volatile float g_sink = 0.f;
+
+// A single benchmark measure, converted to json at exit.
+struct Measure {
+  ozz::string name;
+  int joints;
+  size_t iterations;
+  double min_ns;
+  double median_ns;
+  double mean_ns;
+};
+
+// Times _fct over the number of iterations set on the command line. Each
+// iteration invokes _fct _batch times and reports the elapsed time divided by
+// _batch, so jobs cheaper than the clock resolution remain measurable.
+template <typename _Fct>
+void Benchmark(const char* _name, int _joints, size_t _batch, const _Fct& _fct,
+               ozz::vector<Measure>* _measures) {
+  const size_t iterations =
+      static_cast<size_t>(ozz::math::Max(1, OPTIONS_iterations.value()));
+
+  // Warms up caches and branch predictors outside of the measures.
+  _fct();
+
+  ozz::vector<double> durations(iterations);
+  for (size_t i = 0; i < iterations; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t b = 0; b < _batch; ++b) {
+      _fct();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    durations[i] =
+        std::chrono::duration<double, std::nano>(end - start).count() /
+        static_cast<double>(_batch);
+  }
+  std::sort(durations.begin(), durations.end());
+
+  double sum = 0.;
+  for (size_t i = 0; i < iterations; ++i) {
+    sum += durations[i];
+  }
+
+  const Measure measure = {_name,
+                           _joints,
+                           iterations,
+                           durations.front(),
+                           durations[iterations / 2],
+                           sum / static_cast<double>(iterations)};
+  _measures->push_back(measure);
+}
+
+// Grows a balanced binary hierarchy below _joint, until the whole skeleton
+// reaches _num_joints. _index is _joint own (breadth-first) index.
+void GrowSkeleton(ozz::animation::offline::RawSkeleton::Joint* _joint,
+                  int _index, int _num_joints) {
+  char name[16];
+  std::snprintf(name, sizeof(name), "j%d", _index);
+  _joint->name = name;
+  _joint->transform = ozz::math::Transform::identity();
+  _joint->transform.translation = ozz::math::Float3(0.f, .1f, 0.f);
+
+  const int first_child = _index * 2 + 1;
+  const int num_children =
+      ozz::math::Clamp(0, _num_joints - first_child, 2);
+  _joint->children.resize(static_cast<size_t>(num_children));
+  for (int i = 0; i < num_children; ++i) {
+    GrowSkeleton(&_joint->children[static_cast<size_t>(i)], first_child + i,
+                 _num_joints);
+  }
+}
+
+ozz::unique_ptr<ozz::animation::Skeleton> BuildSkeleton(int _num_joints) {
+  ozz::animation::offline::RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  GrowSkeleton(&raw_skeleton.roots[0], 0, _num_joints);
+  ozz::animation::offline::SkeletonBuilder builder;
+  return builder(raw_skeleton);
+}
+
+// Builds an animation keying every joint, with enough keyframes per track to
+// exercise the compressed streams the way authored clips do.
+ozz::unique_ptr<ozz::animation::Animation> BuildAnimation(int _num_joints) {
+  const int kNumKeys = 30;
+  ozz::animation::offline::RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(static_cast<size_t>(_num_joints));
+  for (int j = 0; j < _num_joints; ++j) {
+    auto& track = raw_animation.tracks[static_cast<size_t>(j)];
+    for (int k = 0; k < kNumKeys; ++k) {
+      const float time = raw_animation.duration * k / (kNumKeys - 1);
+      const float phase = static_cast<float>(j) + time * 7.f;
+      const ozz::animation::offline::RawAnimation::TranslationKey tkey = {
+          time, ozz::math::Float3(std::cos(phase), .1f, std::sin(phase))};
+      track.translations.push_back(tkey);
+      const ozz::animation::offline::RawAnimation::RotationKey rkey = {
+          time, ozz::math::Quaternion::FromAxisAngle(
+                    ozz::math::Float3(0.f, 1.f, 0.f), std::sin(phase))};
+      track.rotations.push_back(rkey);
+    }
+  }
+  ozz::animation::offline::AnimationBuilder builder;
+  return builder(raw_animation);
+}
+
+// Benchmarks the sample -> blend -> local-to-model -> skinning chain for a
+// given skeleton size.
+void BenchmarkSkeletonSize(int _num_joints,
+                           ozz::vector<Measure>* _measures) {
+  auto skeleton = BuildSkeleton(_num_joints);
+  auto animation = BuildAnimation(_num_joints);
+  assert(skeleton && animation);
+
+  const size_t num_soa_joints =
+      static_cast<size_t>(skeleton->num_soa_joints());
+  const size_t num_joints = static_cast<size_t>(skeleton->num_joints());
+
+  ozz::animation::SamplingJob::Context context(animation->num_tracks());
+  ozz::vector<ozz::math::SoaTransform> locals(num_soa_joints);
+  ozz::vector<ozz::math::SoaTransform> locals2(num_soa_joints);
+  ozz::vector<ozz::math::SoaTransform> blended(num_soa_joints);
+  ozz::vector<ozz::math::Float4x4> models(num_joints);
+
+  {  // Forward playback sampling, the context optimized path.
+    float ratio = 0.f;
+    auto sample = [&]() {
+      ratio += 1.f / 97.f;  // Non-divisor step, so keyframes spread over runs.
+      if (ratio > 1.f) {
+        ratio -= 1.f;
+      }
+      ozz::animation::SamplingJob job;
+      job.animation = animation.get();
+      job.context = &context;
+      job.ratio = ratio;
+      job.output = make_span(locals);
+      (void)job.Run();
+      g_sink = g_sink + ozz::math::GetX(locals[0].translation.x);
+    };
+    Benchmark("SamplingJob", _num_joints, 1, sample, _measures);
+  }
+
+  {  // 2 layers blending, the common crossfade case.
+    locals2 = locals;
+    ozz::animation::BlendingJob::Layer layers[2];
+    layers[0].transform = make_span(locals);
+    layers[0].weight = .46f;
+    layers[1].transform = make_span(locals2);
+    layers[1].weight = .54f;
+    auto blend = [&]() {
+      ozz::animation::BlendingJob job;
+      job.layers = layers;
+      job.rest_pose = skeleton->joint_rest_poses();
+      job.output = make_span(blended);
+      (void)job.Run();
+      g_sink = g_sink + ozz::math::GetX(blended[0].translation.x);
+    };
+    Benchmark("BlendingJob", _num_joints, 1, blend, _measures);
+  }
+
+  {  // Whole hierarchy local to model-space conversion.
+    auto local_to_model = [&]() {
+      ozz::animation::LocalToModelJob job;
+      job.skeleton = skeleton.get();
+      job.input = make_span(blended);
+      job.output = make_span(models);
+      (void)job.Run();
+      g_sink = g_sink + ozz::math::GetX(models[num_joints - 1].cols[3]);
+    };
+    Benchmark("LocalToModelJob", _num_joints, 1, local_to_model, _measures);
+  }
+
+  {  // 4 influences matrix palette skinning, 10000 vertices.
+    const size_t kNumVertices = 10000;
+    const size_t kNumInfluences = 4;
+    ozz::vector<uint16_t> indices(kNumVertices * kNumInfluences);
+    for (size_t i = 0; i < indices.size(); ++i) {
+      indices[i] = static_cast<uint16_t>(i % num_joints);
+    }
+    ozz::vector<float> weights(kNumVertices * (kNumInfluences - 1), .25f);
+    ozz::vector<float> in_positions(kNumVertices * 3, 1.f);
+    ozz::vector<float> in_normals(kNumVertices * 3, .5f);
+    ozz::vector<float> out_positions(kNumVertices * 3);
+    ozz::vector<float> out_normals(kNumVertices * 3);
+    auto skin = [&]() {
+      ozz::geometry::SkinningJob job;
+      job.vertex_count = static_cast<int>(kNumVertices);
+      job.influences_count = static_cast<int>(kNumInfluences);
+      job.joint_matrices = make_span(models);
+      job.joint_indices = make_span(indices);
+      job.joint_indices_stride = sizeof(uint16_t) * kNumInfluences;
+      job.joint_weights = make_span(weights);
+      job.joint_weights_stride = sizeof(float) * (kNumInfluences - 1);
+      job.in_positions = make_span(in_positions);
+      job.in_positions_stride = sizeof(float) * 3;
+      job.in_normals = make_span(in_normals);
+      job.in_normals_stride = sizeof(float) * 3;
+      job.out_positions = make_span(out_positions);
+      job.out_positions_stride = sizeof(float) * 3;
+      job.out_normals = make_span(out_normals);
+      job.out_normals_stride = sizeof(float) * 3;
+      (void)job.Run();
+      g_sink = g_sink + out_positions[0];
+    };
+    Benchmark("SkinningJob", _num_joints, 1, skin, _measures);
+  }
+}
+
+// Benchmarks user-channel track sampling jobs, which don't depend on skeleton
+// size.
+void BenchmarkTrackJobs(ozz::vector<Measure>* _measures) {
+  const size_t kNumKeys = 100;
+  ozz::animation::offline::TrackBuilder builder;
+
+  ozz::animation::offline::RawFloat3Track raw_float3_track;
+  ozz::animation::offline::RawQuaternionTrack raw_quaternion_track;
+  for (size_t k = 0; k < kNumKeys; ++k) {
+    const float ratio = static_cast<float>(k) / (kNumKeys - 1);
+    const ozz::animation::offline::RawFloat3Track::Keyframe f3_key = {
+        ozz::animation::offline::RawTrackInterpolation::kLinear, ratio,
+        ozz::math::Float3(std::cos(ratio * 26.f), ratio, 0.f)};
+    raw_float3_track.keyframes.push_back(f3_key);
+    const ozz::animation::offline::RawQuaternionTrack::Keyframe q_key = {
+        ozz::animation::offline::RawTrackInterpolation::kLinear, ratio,
+        ozz::math::Quaternion::FromAxisAngle(ozz::math::Float3(0.f, 1.f, 0.f),
+                                             ratio * 3.f)};
+    raw_quaternion_track.keyframes.push_back(q_key);
+  }
+  auto float3_track = builder(raw_float3_track);
+  auto quaternion_track = builder(raw_quaternion_track);
+  assert(float3_track && quaternion_track);
+
+  {  // Forward playback float3 track sampling.
+    ozz::animation::TrackSamplingContext context;
+    float ratio = 0.f;
+    ozz::math::Float3 result;
+    auto sample = [&]() {
+      ratio += 1.f / 97.f;
+      if (ratio > 1.f) {
+        ratio -= 1.f;
+      }
+      ozz::animation::Float3TrackSamplingJob job;
+      job.track = float3_track.get();
+      job.context = &context;
+      job.ratio = ratio;
+      job.result = &result;
+      (void)job.Run();
+      g_sink = g_sink + result.x;
+    };
+    Benchmark("Float3TrackSamplingJob", 0, 16, sample, _measures);
+  }
+
+  {  // Forward playback quaternion track sampling.
+    ozz::animation::TrackSamplingContext context;
+    float ratio = 0.f;
+    ozz::math::Quaternion result;
+    auto sample = [&]() {
+      ratio += 1.f / 97.f;
+      if (ratio > 1.f) {
+        ratio -= 1.f;
+      }
+      ozz::animation::QuaternionTrackSamplingJob job;
+      job.track = quaternion_track.get();
+      job.context = &context;
+      job.ratio = ratio;
+      job.result = &result;
+      (void)job.Run();
+      g_sink = g_sink + result.w;
+    };
+    Benchmark("QuaternionTrackSamplingJob", 0, 16, sample, _measures);
+  }
+}
+
+// Benchmarks per-joint IK jobs, whose cost doesn't depend on skeleton size
+// either.
+void BenchmarkIKJobs(ozz::vector<Measure>* _measures) {
+  // A canonical 3 joints chain, as a leg would be.
+  const ozz::math::Float4x4 start =
+      ozz::math::Float4x4::Translation(ozz::math::simd_float4::y_axis());
+  const ozz::math::Float4x4 mid = ozz::math::Float4x4::Translation(
+      ozz::math::simd_float4::Load(0.f, .5f, 0.f, 0.f));
+  const ozz::math::Float4x4 end = ozz::math::Float4x4::Translation(
+      ozz::math::simd_float4::Load(0.f, .1f, 0.f, 0.f));
+
+  {  // Two bone IK, target moved every run to defeat early outs.
+    float angle = 0.f;
+    ozz::math::SimdQuaternion start_correction, mid_correction;
+    auto two_bone = [&]() {
+      angle += .01f;
+      ozz::animation::IKTwoBoneJob job;
+      job.target = ozz::math::simd_float4::Load(std::cos(angle), .3f,
+                                                std::sin(angle), 0.f);
+      job.start_joint = &start;
+      job.mid_joint = &mid;
+      job.end_joint = &end;
+      job.start_joint_correction = &start_correction;
+      job.mid_joint_correction = &mid_correction;
+      (void)job.Run();
+      g_sink = g_sink + ozz::math::GetX(start_correction.xyzw);
+    };
+    Benchmark("IKTwoBoneJob", 0, 16, two_bone, _measures);
+  }
+
+  {  // Aim IK, target moved every run as well.
+    float angle = 0.f;
+    ozz::math::SimdQuaternion correction;
+    auto aim = [&]() {
+      angle += .01f;
+      ozz::animation::IKAimJob job;
+      job.target = ozz::math::simd_float4::Load(std::cos(angle), .3f,
+                                                std::sin(angle), 0.f);
+      job.joint = &start;
+      job.joint_correction = &correction;
+      (void)job.Run();
+      g_sink = g_sink + ozz::math::GetX(correction.xyzw);
+    };
+    Benchmark("IKAimJob", 0, 16, aim, _measures);
+  }
+}
+
+// Writes all measures as a JSON document.
+bool WriteJson(const ozz::vector<Measure>& _measures, const char* _path) {
+  FILE* file = *_path == 0 ? stdout : std::fopen(_path, "wt");
+  if (!file) {
+    return false;
+  }
+  std::fprintf(file, "{\n  \"benchmarks\": [\n");
+  for (size_t i = 0; i < _measures.size(); ++i) {
+    const Measure& measure = _measures[i];
+    std::fprintf(file,
+                 "    {\"name\": \"%s\", \"joints\": %d, \"iterations\": %zu, "
+                 "\"min_ns\": %.1f, \"median_ns\": %.1f, \"mean_ns\": %.1f}%s\n",
+                 measure.name.c_str(), measure.joints, measure.iterations,
+                 measure.min_ns, measure.median_ns, measure.mean_ns,
+                 i + 1 < _measures.size() ? "," : "");
+  }
+  std::fprintf(file, "  ]\n}\n");
+  if (file != stdout) {
+    std::fclose(file);
+  }
+  return true;
+}
+}  // namespace
+
+int main(int _argc, char* _argv[]) {
+  // Parses the command line.
+  ozz::options::ParseResult parse_result = ozz::options::ParseCommandLine(
+      _argc, _argv, "1.0", "Benchmarks ozz runtime jobs, emitting JSON.");
+  if (parse_result != ozz::options::kSuccess) {
+    return parse_result == ozz::options::kExitSuccess ? EXIT_SUCCESS
+                                                      : EXIT_FAILURE;
+  }
+
+  ozz::vector<Measure> measures;
+
+  // Realistic skeleton sizes, from props to film quality characters.
+  const int kSkeletonSizes[] = {20, 64, 120, 400};
+  for (size_t i = 0; i < OZZ_ARRAY_SIZE(kSkeletonSizes); ++i) {
+    BenchmarkSkeletonSize(kSkeletonSizes[i], &measures);
+  }
+
+  BenchmarkTrackJobs(&measures);
+  BenchmarkIKJobs(&measures);
+
+  if (!WriteJson(measures, OPTIONS_out.value())) {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
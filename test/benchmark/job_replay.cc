@@ -0,0 +1,433 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+// Replays a JobCapture log, recorded from a production frame, against
+// synthetic assets rebuilt to the captured shapes (animation track counts,
+// skeleton joint counts, layer configurations...). The captured frame's jobs
+// are then re-executed and timed like the other benchmarks, so a spike
+// reported from production can be profiled offline on the exact job workload
+// that produced it. Buffer contents aren't captured, so timings measure the
+// workload shape, not the exact keyframe streams of the production assets.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+#include "ozz/animation/offline/animation_builder.h"
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/offline/raw_skeleton.h"
+#include "ozz/animation/offline/skeleton_builder.h"
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/animation/runtime/blending_job.h"
+#include "ozz/animation/runtime/job_capture.h"
+#include "ozz/animation/runtime/local_to_model_job.h"
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/containers/map.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/io/archive.h"
+#include "ozz/base/io/stream.h"
+#include "ozz/base/log.h"
+#include "ozz/base/maths/simd_math.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/memory/unique_ptr.h"
+#include "ozz/options/options.h"
+
+// Declares command line options.
+OZZ_OPTIONS_DECLARE_STRING(
+    capture,
+    "Path of the job capture file to replay. When empty, a small builtin "
+    "capture is replayed instead, which keeps the tool testable without a "
+    "production log.",
+    "", false)
+OZZ_OPTIONS_DECLARE_INT(iterations,
+                        "Number of timed iterations of the captured frame", 50,
+                        false)
+OZZ_OPTIONS_DECLARE_STRING(
+    out, "Path of the output JSON file, empty for stdout", "", false)
+
+namespace {
+
+// Consumes replayed outputs, so the optimizer cannot discard the work.
+volatile float g_sink = 0.f;
+
+// Grows a balanced binary hierarchy below _joint, until the whole skeleton
+// reaches _num_joints. _index is _joint own (breadth-first) index.
+void GrowSkeleton(ozz::animation::offline::RawSkeleton::Joint* _joint,
+                  int _index, int _num_joints) {
+  char name[16];
+  std::snprintf(name, sizeof(name), "j%d", _index);
+  _joint->name = name;
+  _joint->transform = ozz::math::Transform::identity();
+  _joint->transform.translation = ozz::math::Float3(0.f, .1f, 0.f);
+
+  const int first_child = _index * 2 + 1;
+  const int num_children = ozz::math::Clamp(0, _num_joints - first_child, 2);
+  _joint->children.resize(static_cast<size_t>(num_children));
+  for (int i = 0; i < num_children; ++i) {
+    GrowSkeleton(&_joint->children[static_cast<size_t>(i)], first_child + i,
+                 _num_joints);
+  }
+}
+
+ozz::unique_ptr<ozz::animation::Skeleton> BuildSkeleton(int _num_joints) {
+  ozz::animation::offline::RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  GrowSkeleton(&raw_skeleton.roots[0], 0, _num_joints);
+  ozz::animation::offline::SkeletonBuilder builder;
+  return builder(raw_skeleton);
+}
+
+// Builds an animation of the captured shape: track count, duration, and
+// enough keyframes per track to exercise the compressed streams the way
+// authored clips do.
+ozz::unique_ptr<ozz::animation::Animation> BuildAnimation(int _num_tracks,
+                                                          float _duration) {
+  const int kNumKeys = 30;
+  ozz::animation::offline::RawAnimation raw_animation;
+  raw_animation.duration = _duration;
+  raw_animation.tracks.resize(static_cast<size_t>(_num_tracks));
+  for (int j = 0; j < _num_tracks; ++j) {
+    auto& track = raw_animation.tracks[static_cast<size_t>(j)];
+    for (int k = 0; k < kNumKeys; ++k) {
+      const float time = raw_animation.duration * k / (kNumKeys - 1);
+      const float phase = static_cast<float>(j) + time * 7.f;
+      const ozz::animation::offline::RawAnimation::TranslationKey tkey = {
+          time, ozz::math::Float3(std::cos(phase), .1f, std::sin(phase))};
+      track.translations.push_back(tkey);
+      const ozz::animation::offline::RawAnimation::RotationKey rkey = {
+          time, ozz::math::Quaternion::FromAxisAngle(
+                    ozz::math::Float3(0.f, 1.f, 0.f), std::sin(phase))};
+      track.rotations.push_back(rkey);
+    }
+  }
+  ozz::animation::offline::AnimationBuilder builder;
+  return builder(raw_animation);
+}
+
+// A ready-to-run replayed frame: jobs point to synthetic assets and to
+// buffers owned here.
+struct ReplayFrame {
+  // One entry per captured sampling job, each with its own context as a
+  // production instance would have.
+  struct Sampling {
+    ozz::animation::SamplingJob job;
+    ozz::animation::SamplingJob::Context context;
+    ozz::vector<ozz::math::SoaTransform> output;
+  };
+
+  ozz::vector<ozz::unique_ptr<Sampling>> sampling;
+
+  struct Blending {
+    ozz::animation::BlendingJob job;
+    ozz::vector<ozz::animation::BlendingJob::Layer> layers;
+    ozz::vector<ozz::animation::BlendingJob::Layer> additive_layers;
+    ozz::vector<ozz::math::SoaTransform> output;
+  };
+  ozz::vector<ozz::unique_ptr<Blending>> blending;
+
+  struct LocalToModel {
+    ozz::animation::LocalToModelJob job;
+    ozz::vector<ozz::math::Float4x4> output;
+  };
+  ozz::vector<ozz::unique_ptr<LocalToModel>> local_to_model;
+
+  // Synthetic assets, shared by jobs capturing the same identities.
+  ozz::map<uint32_t, ozz::unique_ptr<ozz::animation::Animation>> animations;
+  ozz::map<uint32_t, ozz::unique_ptr<ozz::animation::Skeleton>> skeletons;
+
+  // Shared input buffers (identity poses, unit joint weights), sized to the
+  // biggest captured job.
+  ozz::vector<ozz::math::SoaTransform> shared_pose;
+  ozz::vector<ozz::math::SimdFloat4> shared_weights;
+
+  // Number of captured descriptors that could not be replayed (invalid
+  // capture, zero sized assets...).
+  size_t skipped = 0;
+};
+
+// Builds the replay frame from captured descriptors. Invalid descriptors are
+// counted and skipped.
+void BuildFrame(const ozz::animation::JobCapture& _capture,
+                ReplayFrame* _frame) {
+  // Finds the biggest captured buffer, to size shared input buffers.
+  size_t max_soa = 1;
+  for (const auto& entry : _capture.sampling_jobs()) {
+    max_soa = ozz::math::Max(max_soa,
+                             static_cast<size_t>(entry.num_output_soa));
+  }
+  for (const auto& entry : _capture.blending_jobs()) {
+    max_soa = ozz::math::Max(max_soa,
+                             static_cast<size_t>(entry.num_output_soa));
+  }
+  for (const auto& entry : _capture.local_to_model_jobs()) {
+    max_soa = ozz::math::Max(max_soa,
+                             static_cast<size_t>(entry.num_joints + 3) / 4);
+  }
+  _frame->shared_pose.resize(max_soa, ozz::math::SoaTransform::identity());
+  _frame->shared_weights.resize(max_soa, ozz::math::simd_float4::one());
+
+  for (const auto& entry : _capture.sampling_jobs()) {
+    if (entry.num_tracks <= 0 || entry.num_output_soa <= 0) {
+      ++_frame->skipped;
+      continue;
+    }
+    auto& animation = _frame->animations[entry.animation_id];
+    if (!animation) {
+      animation = BuildAnimation(entry.num_tracks,
+                                 ozz::math::Max(entry.duration, .01f));
+    }
+    auto replay = ozz::make_unique<ReplayFrame::Sampling>();
+    replay->context.Resize(animation->num_tracks());
+    replay->output.resize(static_cast<size_t>(entry.num_output_soa));
+    replay->job.animation = animation.get();
+    replay->job.context = &replay->context;
+    replay->job.ratio = entry.ratio;
+    replay->job.output = make_span(replay->output);
+    replay->job.deterministic = entry.deterministic;
+    replay->job.components = entry.components;
+    if (!replay->job.Validate()) {
+      ++_frame->skipped;
+      continue;
+    }
+    _frame->sampling.push_back(std::move(replay));
+  }
+
+  for (const auto& entry : _capture.blending_jobs()) {
+    if (entry.num_output_soa <= 0 || entry.num_layers <= 0) {
+      ++_frame->skipped;
+      continue;
+    }
+    auto replay = ozz::make_unique<ReplayFrame::Blending>();
+    const size_t num_soa = static_cast<size_t>(entry.num_output_soa);
+    for (int l = 0; l < entry.num_layers; ++l) {
+      const auto& captured =
+          _capture.layers()[static_cast<size_t>(entry.first_layer + l)];
+      ozz::animation::BlendingJob::Layer layer;
+      layer.weight = captured.weight;
+      layer.transform = make_span(_frame->shared_pose).first(num_soa);
+      if (captured.has_joint_weights) {
+        layer.joint_weights = make_span(_frame->shared_weights).first(num_soa);
+      }
+      auto& layers = captured.additive ? replay->additive_layers
+                                       : replay->layers;
+      layers.push_back(layer);
+    }
+    replay->output.resize(num_soa);
+    replay->job.threshold = entry.threshold;
+    replay->job.layers = make_span(replay->layers);
+    replay->job.additive_layers = make_span(replay->additive_layers);
+    replay->job.rest_pose = make_span(_frame->shared_pose).first(num_soa);
+    replay->job.output = make_span(replay->output);
+    if (!replay->job.Validate()) {
+      ++_frame->skipped;
+      continue;
+    }
+    _frame->blending.push_back(std::move(replay));
+  }
+
+  for (const auto& entry : _capture.local_to_model_jobs()) {
+    if (entry.num_joints <= 0) {
+      ++_frame->skipped;
+      continue;
+    }
+    auto& skeleton = _frame->skeletons[entry.skeleton_id];
+    if (!skeleton) {
+      skeleton = BuildSkeleton(entry.num_joints);
+    }
+    auto replay = ozz::make_unique<ReplayFrame::LocalToModel>();
+    replay->output.resize(static_cast<size_t>(skeleton->num_joints()));
+    replay->job.skeleton = skeleton.get();
+    replay->job.from = entry.from;
+    replay->job.to = entry.to;
+    replay->job.from_excluded = entry.from_excluded;
+    replay->job.input =
+        make_span(_frame->shared_pose)
+            .first(static_cast<size_t>(skeleton->num_soa_joints()));
+    replay->job.output = make_span(replay->output);
+    if (!replay->job.Validate()) {
+      ++_frame->skipped;
+      continue;
+    }
+    _frame->local_to_model.push_back(std::move(replay));
+  }
+}
+
+// Runs every replayed job once, in capture order per type (sampling, then
+// blending, then local-to-model), like a frame update would.
+void RunFrame(const ReplayFrame& _frame) {
+  for (const auto& replay : _frame.sampling) {
+    (void)replay->job.Run();
+    g_sink =
+        g_sink + ozz::math::GetX(replay->output.front().translation.x);
+  }
+  for (const auto& replay : _frame.blending) {
+    (void)replay->job.Run();
+    g_sink =
+        g_sink + ozz::math::GetX(replay->output.front().translation.x);
+  }
+  for (const auto& replay : _frame.local_to_model) {
+    (void)replay->job.Run();
+    g_sink = g_sink + ozz::math::GetX(replay->output.back().cols[3]);
+  }
+}
+
+// Loads a capture from _path.
+bool LoadCapture(const char* _path, ozz::animation::JobCapture* _capture) {
+  ozz::io::File file(_path, "rb");
+  if (!file.opened()) {
+    ozz::log::Err() << "Cannot open capture file \"" << _path << "\"."
+                    << std::endl;
+    return false;
+  }
+  ozz::io::IArchive archive(&file);
+  if (!archive.TestTag<ozz::animation::JobCapture>()) {
+    ozz::log::Err() << "Capture file \"" << _path
+                    << "\" doesn't contain a job capture." << std::endl;
+    return false;
+  }
+  archive >> *_capture;
+  return true;
+}
+
+// Builds a small capture in-process, replayed when no capture file is given.
+// This keeps the tool runnable (and its smoke test meaningful) without a
+// production log.
+void BuiltinCapture(ozz::animation::JobCapture* _capture) {
+  auto animation = BuildAnimation(64, 1.f);
+  auto skeleton = BuildSkeleton(64);
+
+  ozz::animation::SamplingJob::Context context(animation->num_tracks());
+  ozz::vector<ozz::math::SoaTransform> locals(
+      static_cast<size_t>(skeleton->num_soa_joints()));
+  ozz::vector<ozz::math::Float4x4> models(
+      static_cast<size_t>(skeleton->num_joints()));
+
+  ozz::animation::SamplingJob sampling;
+  sampling.animation = animation.get();
+  sampling.context = &context;
+  sampling.ratio = .3f;
+  sampling.output = make_span(locals);
+  _capture->Capture(sampling);
+  _capture->Capture(sampling);
+
+  ozz::animation::BlendingJob::Layer layers[2];
+  layers[0].transform = make_span(locals);
+  layers[0].weight = .46f;
+  layers[1].transform = make_span(locals);
+  layers[1].weight = .54f;
+  ozz::animation::BlendingJob blending;
+  blending.layers = layers;
+  blending.rest_pose = skeleton->joint_rest_poses();
+  blending.output = make_span(locals);
+  _capture->Capture(blending);
+
+  ozz::animation::LocalToModelJob local_to_model;
+  local_to_model.skeleton = skeleton.get();
+  local_to_model.input = make_span(locals);
+  local_to_model.output = make_span(models);
+  _capture->Capture(local_to_model);
+}
+
+// Writes replay measures as a JSON document.
+bool WriteJson(const ReplayFrame& _frame, size_t _iterations, double _min_ns,
+               double _median_ns, double _mean_ns, const char* _path) {
+  FILE* file = *_path == 0 ? stdout : std::fopen(_path, "wt");
+  if (!file) {
+    return false;
+  }
+  std::fprintf(
+      file,
+      "{\n  \"replay\": {\"sampling_jobs\": %zu, \"blending_jobs\": %zu, "
+      "\"local_to_model_jobs\": %zu, \"skipped\": %zu, \"iterations\": %zu, "
+      "\"frame_min_ns\": %.1f, \"frame_median_ns\": %.1f, "
+      "\"frame_mean_ns\": %.1f}\n}\n",
+      _frame.sampling.size(), _frame.blending.size(),
+      _frame.local_to_model.size(), _frame.skipped, _iterations, _min_ns,
+      _median_ns, _mean_ns);
+  if (file != stdout) {
+    std::fclose(file);
+  }
+  return true;
+}
+}  // namespace
+
+int main(int _argc, char* _argv[]) {
+  // Parses the command line.
+  ozz::options::ParseResult parse_result = ozz::options::ParseCommandLine(
+      _argc, _argv, "1.0",
+      "Replays a captured frame's job workload, for offline profiling.");
+  if (parse_result != ozz::options::kSuccess) {
+    return parse_result == ozz::options::kExitSuccess ? EXIT_SUCCESS
+                                                      : EXIT_FAILURE;
+  }
+
+  // Loads (or synthesizes) the capture and prepares the frame.
+  ozz::animation::JobCapture capture;
+  if (*OPTIONS_capture.value() != 0) {
+    if (!LoadCapture(OPTIONS_capture.value(), &capture)) {
+      return EXIT_FAILURE;
+    }
+  } else {
+    BuiltinCapture(&capture);
+  }
+
+  ReplayFrame frame;
+  BuildFrame(capture, &frame);
+
+  // Times the captured frame, reporting minimum, median and mean like the
+  // other benchmarks.
+  const size_t iterations =
+      static_cast<size_t>(ozz::math::Max(1, OPTIONS_iterations.value()));
+
+  // Warms up caches and branch predictors outside of the measures.
+  RunFrame(frame);
+
+  ozz::vector<double> durations(iterations);
+  for (size_t i = 0; i < iterations; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    RunFrame(frame);
+    const auto end = std::chrono::steady_clock::now();
+    durations[i] =
+        std::chrono::duration<double, std::nano>(end - start).count();
+  }
+  std::sort(durations.begin(), durations.end());
+
+  double sum = 0.;
+  for (size_t i = 0; i < iterations; ++i) {
+    sum += durations[i];
+  }
+
+  if (!WriteJson(frame, iterations, durations.front(),
+                 durations[iterations / 2],
+                 sum / static_cast<double>(iterations),
+                 OPTIONS_out.value())) {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,324 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+// Multi-core scaling benchmark for the full per-character animation pipeline
+// (sample -> blend -> local-to-model). A synthetic crowd of independent
+// characters is updated in parallel with ThreadPoolScheduler across a range
+// of thread counts, and throughput is reported as characters per millisecond
+// for each count. The resulting JSON scaling curves make contention
+// regressions (false sharing, allocator or scheduler contention) visible:
+// they show up as a curve flattening instead of growing with thread count,
+// which a single-threaded microbenchmark cannot catch.
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+#include "ozz/animation/offline/animation_builder.h"
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/offline/raw_skeleton.h"
+#include "ozz/animation/offline/skeleton_builder.h"
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/animation/runtime/blending_job.h"
+#include "ozz/animation/runtime/local_to_model_job.h"
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/maths/math_ex.h"
+#include "ozz/base/maths/simd_math.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "ozz/base/memory/unique_ptr.h"
+#include "ozz/base/scheduler.h"
+#include "ozz/options/options.h"
+
+// Declares command line options.
+OZZ_OPTIONS_DECLARE_INT(joints, "Number of joints per character", 64, false)
+OZZ_OPTIONS_DECLARE_INT(characters, "Number of characters in the crowd", 1024,
+                        false)
+OZZ_OPTIONS_DECLARE_INT(iterations,
+                        "Number of timed frames per thread count", 50, false)
+OZZ_OPTIONS_DECLARE_STRING(
+    out, "Path of the output JSON file, empty for stdout", "", false)
+
+namespace {
+
+// Consumes benchmarked outputs, so the optimizer cannot discard the work.
+volatile float g_sink = 0.f;
+
+// Grows a balanced binary hierarchy below _joint, until the whole skeleton
+// reaches _num_joints, the same procedural rig the millipede sample uses as
+// synthetic content. _index is _joint own (breadth-first) index.
+void GrowSkeleton(ozz::animation::offline::RawSkeleton::Joint* _joint,
+                  int _index, int _num_joints) {
+  char name[16];
+  std::snprintf(name, sizeof(name), "j%d", _index);
+  _joint->name = name;
+  _joint->transform = ozz::math::Transform::identity();
+  _joint->transform.translation = ozz::math::Float3(0.f, .1f, 0.f);
+
+  const int first_child = _index * 2 + 1;
+  const int num_children = ozz::math::Clamp(0, _num_joints - first_child, 2);
+  _joint->children.resize(static_cast<size_t>(num_children));
+  for (int i = 0; i < num_children; ++i) {
+    GrowSkeleton(&_joint->children[static_cast<size_t>(i)], first_child + i,
+                 _num_joints);
+  }
+}
+
+ozz::unique_ptr<ozz::animation::Skeleton> BuildSkeleton(int _num_joints) {
+  ozz::animation::offline::RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1);
+  GrowSkeleton(&raw_skeleton.roots[0], 0, _num_joints);
+  ozz::animation::offline::SkeletonBuilder builder;
+  return builder(raw_skeleton);
+}
+
+// Builds an animation keying every joint, with enough keyframes per track to
+// exercise the compressed streams the way authored clips do.
+ozz::unique_ptr<ozz::animation::Animation> BuildAnimation(int _num_joints) {
+  const int kNumKeys = 30;
+  ozz::animation::offline::RawAnimation raw_animation;
+  raw_animation.duration = 1.f;
+  raw_animation.tracks.resize(static_cast<size_t>(_num_joints));
+  for (int j = 0; j < _num_joints; ++j) {
+    auto& track = raw_animation.tracks[static_cast<size_t>(j)];
+    for (int k = 0; k < kNumKeys; ++k) {
+      const float time = raw_animation.duration * k / (kNumKeys - 1);
+      const float phase = static_cast<float>(j) + time * 7.f;
+      const ozz::animation::offline::RawAnimation::TranslationKey tkey = {
+          time, ozz::math::Float3(std::cos(phase), .1f, std::sin(phase))};
+      track.translations.push_back(tkey);
+      const ozz::animation::offline::RawAnimation::RotationKey rkey = {
+          time, ozz::math::Quaternion::FromAxisAngle(
+                    ozz::math::Float3(0.f, 1.f, 0.f), std::sin(phase))};
+      track.rotations.push_back(rkey);
+    }
+  }
+  ozz::animation::offline::AnimationBuilder builder;
+  return builder(raw_animation);
+}
+
+// Per character animation state. Each character owns its sampling context and
+// pose buffers, as an engine crowd would, so parallel updates write disjoint
+// memory and expose sharing issues introduced by the jobs themselves.
+struct Character {
+  ozz::animation::SamplingJob::Context context;
+  ozz::vector<ozz::math::SoaTransform> locals;
+  ozz::vector<ozz::math::SoaTransform> blended;
+  ozz::vector<ozz::math::Float4x4> models;
+  float ratio = 0.f;
+  float step = 0.f;
+};
+
+// Updates characters [_begin, _end[, running the full pipeline for each.
+void UpdateRange(const ozz::animation::Skeleton& _skeleton,
+                 const ozz::animation::Animation& _animation,
+                 const ozz::span<ozz::unique_ptr<Character>>& _characters,
+                 int _begin, int _end) {
+  for (int i = _begin; i < _end; ++i) {
+    Character& character = *_characters[static_cast<size_t>(i)];
+
+    // Advances playback, wrapping at the end of the clip.
+    character.ratio += character.step;
+    if (character.ratio > 1.f) {
+      character.ratio -= 1.f;
+    }
+
+    ozz::animation::SamplingJob sampling_job;
+    sampling_job.animation = &_animation;
+    sampling_job.context = &character.context;
+    sampling_job.ratio = character.ratio;
+    sampling_job.output = make_span(character.locals);
+    (void)sampling_job.Run();
+
+    // 2 layers crossfade between the sampled pose and the rest pose.
+    ozz::animation::BlendingJob::Layer layers[2];
+    layers[0].transform = make_span(character.locals);
+    layers[0].weight = .54f;
+    layers[1].transform = _skeleton.joint_rest_poses();
+    layers[1].weight = .46f;
+    ozz::animation::BlendingJob blending_job;
+    blending_job.layers = layers;
+    blending_job.rest_pose = _skeleton.joint_rest_poses();
+    blending_job.output = make_span(character.blended);
+    (void)blending_job.Run();
+
+    ozz::animation::LocalToModelJob ltm_job;
+    ltm_job.skeleton = &_skeleton;
+    ltm_job.input = make_span(character.blended);
+    ltm_job.output = make_span(character.models);
+    (void)ltm_job.Run();
+  }
+}
+
+// A scaling measure for a single thread count.
+struct Measure {
+  int threads;
+  size_t iterations;
+  double min_ms;
+  double median_ms;
+  double mean_ms;
+  double characters_per_ms;  // Computed from the minimum frame time.
+};
+
+// Times whole crowd updates with _scheduler and appends the measure.
+void BenchmarkThreadCount(
+    const ozz::animation::Skeleton& _skeleton,
+    const ozz::animation::Animation& _animation,
+    const ozz::span<ozz::unique_ptr<Character>>& _characters, int _threads,
+    ozz::Scheduler* _scheduler, ozz::vector<Measure>* _measures) {
+  const size_t iterations =
+      static_cast<size_t>(ozz::math::Max(1, OPTIONS_iterations.value()));
+  const int num_characters = static_cast<int>(_characters.size());
+
+  auto update = [&](int _begin, int _end) {
+    UpdateRange(_skeleton, _animation, _characters, _begin, _end);
+  };
+
+  // Warms up caches, branch predictors and pool threads outside of the
+  // measures.
+  _scheduler->ParallelForFct(0, num_characters, 1, update);
+
+  ozz::vector<double> durations(iterations);
+  for (size_t i = 0; i < iterations; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    _scheduler->ParallelForFct(0, num_characters, 1, update);
+    const auto end = std::chrono::steady_clock::now();
+    durations[i] =
+        std::chrono::duration<double, std::milli>(end - start).count();
+  }
+  std::sort(durations.begin(), durations.end());
+
+  double sum = 0.;
+  for (size_t i = 0; i < iterations; ++i) {
+    sum += durations[i];
+  }
+  g_sink = g_sink +
+           ozz::math::GetX(_characters[0]->models.back().cols[3]);
+
+  const Measure measure = {_threads,
+                           iterations,
+                           durations.front(),
+                           durations[iterations / 2],
+                           sum / static_cast<double>(iterations),
+                           num_characters / durations.front()};
+  _measures->push_back(measure);
+}
+
+// Writes all measures as a JSON document.
+bool WriteJson(const ozz::vector<Measure>& _measures, const char* _path) {
+  FILE* file = *_path == 0 ? stdout : std::fopen(_path, "wt");
+  if (!file) {
+    return false;
+  }
+  std::fprintf(file,
+               "{\n  \"joints\": %d,\n  \"characters\": %d,\n"
+               "  \"hardware_threads\": %u,\n  \"scaling\": [\n",
+               OPTIONS_joints.value(), OPTIONS_characters.value(),
+               std::thread::hardware_concurrency());
+  for (size_t i = 0; i < _measures.size(); ++i) {
+    const Measure& measure = _measures[i];
+    std::fprintf(
+        file,
+        "    {\"threads\": %d, \"iterations\": %zu, \"min_ms\": %.3f, "
+        "\"median_ms\": %.3f, \"mean_ms\": %.3f, "
+        "\"characters_per_ms\": %.1f}%s\n",
+        measure.threads, measure.iterations, measure.min_ms,
+        measure.median_ms, measure.mean_ms, measure.characters_per_ms,
+        i + 1 < _measures.size() ? "," : "");
+  }
+  std::fprintf(file, "  ]\n}\n");
+  if (file != stdout) {
+    std::fclose(file);
+  }
+  return true;
+}
+}  // namespace
+
+int main(int _argc, char* _argv[]) {
+  // Parses the command line.
+  ozz::options::ParseResult parse_result = ozz::options::ParseCommandLine(
+      _argc, _argv, "1.0",
+      "Benchmarks multi-core scaling of the animation pipeline, emitting "
+      "JSON.");
+  if (parse_result != ozz::options::kSuccess) {
+    return parse_result == ozz::options::kExitSuccess ? EXIT_SUCCESS
+                                                      : EXIT_FAILURE;
+  }
+
+  // Builds synthetic content.
+  const int num_joints = ozz::math::Max(1, OPTIONS_joints.value());
+  auto skeleton = BuildSkeleton(num_joints);
+  auto animation = BuildAnimation(num_joints);
+  assert(skeleton && animation);
+
+  // Builds the crowd. Characters play the same clip at desynchronized ratios
+  // and speeds, so sampling contexts don't follow identical key patterns.
+  const int num_characters = ozz::math::Max(1, OPTIONS_characters.value());
+  ozz::vector<ozz::unique_ptr<Character>> characters(
+      static_cast<size_t>(num_characters));
+  for (int i = 0; i < num_characters; ++i) {
+    auto character = ozz::make_unique<Character>();
+    character->context.Resize(animation->num_tracks());
+    character->locals.resize(
+        static_cast<size_t>(skeleton->num_soa_joints()));
+    character->blended.resize(
+        static_cast<size_t>(skeleton->num_soa_joints()));
+    character->models.resize(static_cast<size_t>(skeleton->num_joints()));
+    character->ratio = static_cast<float>(i) / num_characters;
+    character->step = 1.f / (97.f + i % 7);
+    characters[static_cast<size_t>(i)] = std::move(character);
+  }
+
+  ozz::vector<Measure> measures;
+
+  // Sweeps thread counts. Counts beyond hardware concurrency are measured
+  // too, exposing oversubscription costs.
+  const int kThreadCounts[] = {1, 2, 4, 8, 16, 32};
+  for (size_t i = 0; i < OZZ_ARRAY_SIZE(kThreadCounts); ++i) {
+    const int threads = kThreadCounts[i];
+    if (threads == 1) {
+      // Single threaded reference, free of any scheduling overhead.
+      ozz::SerialScheduler scheduler;
+      BenchmarkThreadCount(*skeleton, *animation, make_span(characters),
+                           threads, &scheduler, &measures);
+    } else {
+      // The calling thread participates, hence threads - 1 pool workers.
+      ozz::ThreadPoolScheduler scheduler(threads - 1);
+      BenchmarkThreadCount(*skeleton, *animation, make_span(characters),
+                           threads, &scheduler, &measures);
+    }
+  }
+
+  if (!WriteJson(measures, OPTIONS_out.value())) {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,126 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/geometry/offline/skinning_partition.h"
+
+#include "gtest/gtest.h"
+
+using ozz::geometry::offline::PartitionVertices;
+using ozz::geometry::offline::RemapIndices;
+using ozz::geometry::offline::ReorderVertices;
+using ozz::geometry::offline::SkinningPartition;
+
+TEST(Error, SkinningPartition) {
+  const int influences[] = {1, 2};
+  ozz::vector<uint32_t> remap;
+  ozz::vector<SkinningPartition> partitions;
+
+  // nullptr outputs.
+  EXPECT_FALSE(PartitionVertices(ozz::make_span(influences), nullptr,
+                                 &partitions));
+  EXPECT_FALSE(PartitionVertices(ozz::make_span(influences), &remap, nullptr));
+
+  // Invalid influences count.
+  const int invalid[] = {1, 0, 2};
+  EXPECT_FALSE(PartitionVertices(ozz::make_span(invalid), &remap, &partitions));
+
+  // Empty input is valid.
+  EXPECT_TRUE(PartitionVertices(ozz::span<const int>(), &remap, &partitions));
+  EXPECT_TRUE(remap.empty());
+  EXPECT_TRUE(partitions.empty());
+}
+
+TEST(Partition, SkinningPartition) {
+  // Interleaved influences counts, as DCC exporters produce.
+  const int influences[] = {4, 1, 2, 1, 4, 1, 2, 1, 1};
+  ozz::vector<uint32_t> remap;
+  ozz::vector<SkinningPartition> partitions;
+  ASSERT_TRUE(PartitionVertices(ozz::make_span(influences), &remap,
+                                &partitions));
+
+  // 3 partitions, by increasing influences count. Influences count 3 isn't
+  // used, so no empty partition is emitted for it.
+  ASSERT_EQ(partitions.size(), 3u);
+  EXPECT_EQ(partitions[0].influences_count, 1);
+  EXPECT_EQ(partitions[0].begin, 0u);
+  EXPECT_EQ(partitions[0].count, 5u);
+  EXPECT_EQ(partitions[1].influences_count, 2);
+  EXPECT_EQ(partitions[1].begin, 5u);
+  EXPECT_EQ(partitions[1].count, 2u);
+  EXPECT_EQ(partitions[2].influences_count, 4);
+  EXPECT_EQ(partitions[2].begin, 7u);
+  EXPECT_EQ(partitions[2].count, 2u);
+
+  // Remapping is stable: order is preserved inside each partition.
+  ASSERT_EQ(remap.size(), OZZ_ARRAY_SIZE(influences));
+  const uint32_t expected[] = {7, 0, 5, 1, 8, 2, 6, 3, 4};
+  for (size_t i = 0; i < remap.size(); ++i) {
+    EXPECT_EQ(remap[i], expected[i]);
+  }
+
+  {  // Rewrites a triangle index buffer.
+    uint16_t indices[] = {0, 1, 2, 2, 3, 8};
+    ASSERT_TRUE(RemapIndices(ozz::make_span(remap), ozz::make_span(indices)));
+    const uint16_t expected_indices[] = {7, 0, 5, 5, 1, 4};
+    for (size_t i = 0; i < OZZ_ARRAY_SIZE(indices); ++i) {
+      EXPECT_EQ(indices[i], expected_indices[i]);
+    }
+
+    // Out of range index fails.
+    uint16_t invalid_indices[] = {46};
+    EXPECT_FALSE(RemapIndices(ozz::make_span(remap),
+                              ozz::make_span(invalid_indices)));
+  }
+
+  {  // Reorders a strided vertex buffer.
+    struct Vertex {
+      float pos[3];
+    };
+    Vertex input[OZZ_ARRAY_SIZE(influences)];
+    for (size_t i = 0; i < OZZ_ARRAY_SIZE(input); ++i) {
+      input[i].pos[0] = 1.f * i;
+      input[i].pos[1] = 2.f * i;
+      input[i].pos[2] = 3.f * i;
+    }
+    Vertex output[OZZ_ARRAY_SIZE(influences)];
+    ASSERT_TRUE(ReorderVertices(
+        ozz::make_span(remap), sizeof(Vertex),
+        ozz::as_bytes(ozz::make_span(input)),
+        ozz::as_writable_bytes(ozz::make_span(output))));
+    for (size_t i = 0; i < OZZ_ARRAY_SIZE(input); ++i) {
+      EXPECT_FLOAT_EQ(output[remap[i]].pos[0], 1.f * i);
+      EXPECT_FLOAT_EQ(output[remap[i]].pos[1], 2.f * i);
+      EXPECT_FLOAT_EQ(output[remap[i]].pos[2], 3.f * i);
+    }
+
+    // Too small buffers fail.
+    EXPECT_FALSE(ReorderVertices(
+        ozz::make_span(remap), sizeof(Vertex),
+        ozz::as_bytes(ozz::make_span(input)).subspan(0, sizeof(Vertex)),
+        ozz::as_writable_bytes(ozz::make_span(output))));
+  }
+}
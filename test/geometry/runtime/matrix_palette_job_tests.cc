@@ -0,0 +1,180 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "gtest/gtest.h"
+#include "ozz/base/maths/gtest_math_helper.h"
+#include "ozz/base/maths/simd_math.h"
+#include "ozz/geometry/runtime/matrix_palette_job.h"
+
+using ozz::geometry::MatrixPaletteJob;
+
+TEST(JobValidity, MatrixPaletteJob) {
+  ozz::math::Float4x4 input[3];
+  ozz::math::Float4x4 inverse_bind_poses[2];
+  uint16_t joint_remap[2];
+  ozz::math::Float4x4 output[2];
+  float transposed_output[24];
+
+  {  // Default is invalid.
+    MatrixPaletteJob job;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+  {  // Valid job.
+    MatrixPaletteJob job;
+    job.input = input;
+    job.inverse_bind_poses = inverse_bind_poses;
+    job.output = output;
+    EXPECT_TRUE(job.Validate());
+  }
+  {  // Valid with transposed output only.
+    MatrixPaletteJob job;
+    job.input = input;
+    job.inverse_bind_poses = inverse_bind_poses;
+    job.transposed_output = transposed_output;
+    EXPECT_TRUE(job.Validate());
+  }
+  {  // Valid with both outputs and a remap.
+    MatrixPaletteJob job;
+    job.input = input;
+    job.inverse_bind_poses = inverse_bind_poses;
+    job.joint_remap = joint_remap;
+    job.output = output;
+    job.transposed_output = transposed_output;
+    EXPECT_TRUE(job.Validate());
+  }
+  {  // Invalid with no output.
+    MatrixPaletteJob job;
+    job.input = input;
+    job.inverse_bind_poses = inverse_bind_poses;
+    EXPECT_FALSE(job.Validate());
+  }
+  {  // Invalid with empty input.
+    MatrixPaletteJob job;
+    job.inverse_bind_poses = inverse_bind_poses;
+    job.output = output;
+    EXPECT_FALSE(job.Validate());
+  }
+  {  // Invalid with empty inverse bind poses.
+    MatrixPaletteJob job;
+    job.input = input;
+    job.output = output;
+    EXPECT_FALSE(job.Validate());
+  }
+  {  // Invalid with a too small remap.
+    MatrixPaletteJob job;
+    job.input = input;
+    job.inverse_bind_poses = inverse_bind_poses;
+    job.joint_remap = {joint_remap, 1};
+    job.output = output;
+    EXPECT_FALSE(job.Validate());
+  }
+  {  // Invalid with a too small input and no remap.
+    MatrixPaletteJob job;
+    job.input = {input, 1};
+    job.inverse_bind_poses = inverse_bind_poses;
+    job.output = output;
+    EXPECT_FALSE(job.Validate());
+  }
+  {  // Invalid with a too small output.
+    MatrixPaletteJob job;
+    job.input = input;
+    job.inverse_bind_poses = inverse_bind_poses;
+    job.output = {output, 1};
+    EXPECT_FALSE(job.Validate());
+  }
+  {  // Invalid with a too small transposed output.
+    MatrixPaletteJob job;
+    job.input = input;
+    job.inverse_bind_poses = inverse_bind_poses;
+    job.transposed_output = {transposed_output, 23};
+    EXPECT_FALSE(job.Validate());
+  }
+}
+
+TEST(JobResult, MatrixPaletteJob) {
+  // Skeleton model-space matrices. Only joints 0 and 2 are used by the mesh.
+  const ozz::math::Float4x4 input[3] = {
+      ozz::math::Float4x4::Translation(
+          ozz::math::simd_float4::Load(1.f, 2.f, 3.f, 0.f)),
+      ozz::math::Float4x4::Scaling(
+          ozz::math::simd_float4::Load(46.f, 46.f, 46.f, 0.f)),
+      {{ozz::math::simd_float4::Load(0.f, 1.f, 0.f, 0.f),
+        ozz::math::simd_float4::Load(-1.f, 0.f, 0.f, 0.f),
+        ozz::math::simd_float4::Load(0.f, 0.f, 1.f, 0.f),
+        ozz::math::simd_float4::Load(4.f, 5.f, 6.f, 1.f)}}};
+  const ozz::math::Float4x4 inverse_bind_poses[2] = {
+      ozz::math::Float4x4::Translation(
+          ozz::math::simd_float4::Load(-1.f, -2.f, -3.f, 0.f)),
+      ozz::math::Float4x4::Translation(
+          ozz::math::simd_float4::Load(10.f, 20.f, 30.f, 0.f))};
+  const uint16_t joint_remap[2] = {0, 2};
+
+  ozz::math::Float4x4 output[2];
+  float transposed_output[24];
+
+  MatrixPaletteJob job;
+  job.input = input;
+  job.inverse_bind_poses = inverse_bind_poses;
+  job.joint_remap = joint_remap;
+  job.output = output;
+  job.transposed_output = transposed_output;
+  ASSERT_TRUE(job.Run());
+
+  // Palette entry 0, translation and its inverse cancel out to identity.
+  EXPECT_FLOAT4x4_EQ(output[0], 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f,
+                     0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f);
+
+  // Palette entry 1, remapped to joint 2, rotation applied to the bind-pose
+  // translation: (10, 20, 30) rotates to (-20, 10, 30), offset by (4, 5, 6).
+  EXPECT_FLOAT4x4_EQ(output[1], 0.f, 1.f, 0.f, 0.f, -1.f, 0.f, 0.f, 0.f, 0.f,
+                     0.f, 1.f, 0.f, -16.f, 15.f, 36.f, 1.f);
+
+  // Transposed output stores the 3 first lines of the transposed matrices.
+  const float expected[24] = {// Entry 0, identity.
+                              1.f, 0.f, 0.f, 0.f,  //
+                              0.f, 1.f, 0.f, 0.f,  //
+                              0.f, 0.f, 1.f, 0.f,
+                              // Entry 1.
+                              0.f, -1.f, 0.f, -16.f,  //
+                              1.f, 0.f, 0.f, 15.f,    //
+                              0.f, 0.f, 1.f, 36.f};
+  for (size_t i = 0; i < OZZ_ARRAY_SIZE(expected); ++i) {
+    EXPECT_FLOAT_EQ(expected[i], transposed_output[i]);
+  }
+
+  {  // Without remap, entries map to the first skeleton joints.
+    MatrixPaletteJob direct_job = job;
+    direct_job.joint_remap = {};
+    direct_job.transposed_output = {};
+    ASSERT_TRUE(direct_job.Run());
+
+    // Palette entry 1 now uses joint 1 scaling matrix.
+    EXPECT_FLOAT4x4_EQ(output[1], 46.f, 0.f, 0.f, 0.f, 0.f, 46.f, 0.f, 0.f,
+                       0.f, 0.f, 46.f, 0.f, 460.f, 920.f, 1380.f, 1.f);
+  }
+}
@@ -0,0 +1,215 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "gtest/gtest.h"
+#include "ozz/geometry/runtime/pack_influences_job.h"
+
+using ozz::geometry::PackInfluencesJob;
+
+TEST(JobValidity, PackInfluencesJob) {
+  uint16_t joint_indices[6];
+  float joint_weights[3];
+  uint16_t packed_indices[6];
+  float packed_weights[3];
+
+  {  // Default is invalid.
+    PackInfluencesJob job;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+  {  // Valid job.
+    PackInfluencesJob job;
+    job.vertex_count = 3;
+    job.influences_count = 2;
+    job.joint_indices = joint_indices;
+    job.joint_indices_stride = sizeof(uint16_t) * 2;
+    job.joint_weights = joint_weights;
+    job.joint_weights_stride = sizeof(float);
+    job.packed_indices = packed_indices;
+    job.packed_weights = packed_weights;
+    EXPECT_TRUE(job.Validate());
+  }
+  {  // Valid with a single influence, weights aren't needed.
+    PackInfluencesJob job;
+    job.vertex_count = 3;
+    job.influences_count = 1;
+    job.joint_indices = joint_indices;
+    job.joint_indices_stride = sizeof(uint16_t);
+    job.packed_indices = packed_indices;
+    EXPECT_TRUE(job.Validate());
+  }
+  {  // Valid with 0 vertices.
+    PackInfluencesJob job;
+    job.influences_count = 2;
+    job.joint_indices = joint_indices;
+    job.joint_indices_stride = sizeof(uint16_t) * 2;
+    job.joint_weights = joint_weights;
+    job.joint_weights_stride = sizeof(float);
+    job.packed_indices = packed_indices;
+    job.packed_weights = packed_weights;
+    EXPECT_TRUE(job.Validate());
+  }
+  {  // Invalid with no influence.
+    PackInfluencesJob job;
+    job.vertex_count = 3;
+    job.joint_indices = joint_indices;
+    job.packed_indices = packed_indices;
+    EXPECT_FALSE(job.Validate());
+  }
+  {  // Invalid with a too small input indices buffer.
+    PackInfluencesJob job;
+    job.vertex_count = 3;
+    job.influences_count = 2;
+    job.joint_indices = {joint_indices, 5};
+    job.joint_indices_stride = sizeof(uint16_t) * 2;
+    job.joint_weights = joint_weights;
+    job.joint_weights_stride = sizeof(float);
+    job.packed_indices = packed_indices;
+    job.packed_weights = packed_weights;
+    EXPECT_FALSE(job.Validate());
+  }
+  {  // Invalid with a too small input weights buffer.
+    PackInfluencesJob job;
+    job.vertex_count = 3;
+    job.influences_count = 2;
+    job.joint_indices = joint_indices;
+    job.joint_indices_stride = sizeof(uint16_t) * 2;
+    job.joint_weights = {joint_weights, 2};
+    job.joint_weights_stride = sizeof(float);
+    job.packed_indices = packed_indices;
+    job.packed_weights = packed_weights;
+    EXPECT_FALSE(job.Validate());
+  }
+  {  // Invalid with a too small output indices buffer.
+    PackInfluencesJob job;
+    job.vertex_count = 3;
+    job.influences_count = 2;
+    job.joint_indices = joint_indices;
+    job.joint_indices_stride = sizeof(uint16_t) * 2;
+    job.joint_weights = joint_weights;
+    job.joint_weights_stride = sizeof(float);
+    job.packed_indices = {packed_indices, 5};
+    job.packed_weights = packed_weights;
+    EXPECT_FALSE(job.Validate());
+  }
+  {  // Invalid with a too small output weights buffer.
+    PackInfluencesJob job;
+    job.vertex_count = 3;
+    job.influences_count = 2;
+    job.joint_indices = joint_indices;
+    job.joint_indices_stride = sizeof(uint16_t) * 2;
+    job.joint_weights = joint_weights;
+    job.joint_weights_stride = sizeof(float);
+    job.packed_indices = packed_indices;
+    job.packed_weights = {packed_weights, 2};
+    EXPECT_FALSE(job.Validate());
+  }
+}
+
+TEST(JobResult, PackInfluencesJob) {
+  {  // 3 vertices, 2 influences, tightly interleaved streams.
+    const uint16_t joint_indices[] = {0, 1, 2, 3, 4, 5};
+    const float joint_weights[] = {.2f, .4f, .6f};
+    uint16_t packed_indices[6] = {};
+    float packed_weights[3] = {};
+
+    PackInfluencesJob job;
+    job.vertex_count = 3;
+    job.influences_count = 2;
+    job.joint_indices = joint_indices;
+    job.joint_indices_stride = sizeof(uint16_t) * 2;
+    job.joint_weights = joint_weights;
+    job.joint_weights_stride = sizeof(float);
+    job.packed_indices = packed_indices;
+    job.packed_weights = packed_weights;
+    ASSERT_TRUE(job.Run());
+
+    // Slot 0 then slot 1 entries, one per vertex.
+    EXPECT_EQ(packed_indices[0], 0);
+    EXPECT_EQ(packed_indices[1], 2);
+    EXPECT_EQ(packed_indices[2], 4);
+    EXPECT_EQ(packed_indices[3], 1);
+    EXPECT_EQ(packed_indices[4], 3);
+    EXPECT_EQ(packed_indices[5], 5);
+    EXPECT_FLOAT_EQ(packed_weights[0], .2f);
+    EXPECT_FLOAT_EQ(packed_weights[1], .4f);
+    EXPECT_FLOAT_EQ(packed_weights[2], .6f);
+  }
+
+  {  // Strided input, influences interleaved with other vertex attributes.
+    struct Vertex {
+      uint16_t indices[3];
+      uint16_t pad;
+      float weights[2];
+      float position[3];
+    };
+    const Vertex vertices[] = {
+        {{0, 1, 2}, 0, {.5f, .25f}, {0.f, 0.f, 0.f}},
+        {{3, 4, 5}, 0, {.75f, .125f}, {1.f, 1.f, 1.f}}};
+    uint16_t packed_indices[6] = {};
+    float packed_weights[4] = {};
+
+    PackInfluencesJob job;
+    job.vertex_count = 2;
+    job.influences_count = 3;
+    // Spans cover up to the last vertex influences, crossing vertex strides.
+    job.joint_indices = {vertices[0].indices, 17};
+    job.joint_indices_stride = sizeof(Vertex);
+    job.joint_weights = {vertices[0].weights, 9};
+    job.joint_weights_stride = sizeof(Vertex);
+    job.packed_indices = packed_indices;
+    job.packed_weights = packed_weights;
+    ASSERT_TRUE(job.Run());
+
+    EXPECT_EQ(packed_indices[0], 0);
+    EXPECT_EQ(packed_indices[1], 3);
+    EXPECT_EQ(packed_indices[2], 1);
+    EXPECT_EQ(packed_indices[3], 4);
+    EXPECT_EQ(packed_indices[4], 2);
+    EXPECT_EQ(packed_indices[5], 5);
+    EXPECT_FLOAT_EQ(packed_weights[0], .5f);
+    EXPECT_FLOAT_EQ(packed_weights[1], .75f);
+    EXPECT_FLOAT_EQ(packed_weights[2], .25f);
+    EXPECT_FLOAT_EQ(packed_weights[3], .125f);
+  }
+
+  {  // Single influence, only indices are packed.
+    const uint16_t joint_indices[] = {4, 6};
+    uint16_t packed_indices[2] = {};
+
+    PackInfluencesJob job;
+    job.vertex_count = 2;
+    job.influences_count = 1;
+    job.joint_indices = joint_indices;
+    job.joint_indices_stride = sizeof(uint16_t);
+    job.packed_indices = packed_indices;
+    ASSERT_TRUE(job.Run());
+
+    EXPECT_EQ(packed_indices[0], 4);
+    EXPECT_EQ(packed_indices[1], 6);
+  }
+}
@@ -0,0 +1,117 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "gtest/gtest.h"
+#include "ozz/base/maths/simd_math.h"
+#include "ozz/geometry/runtime/pose_pack_job.h"
+
+using ozz::geometry::PosePackJob;
+
+TEST(JobValidity, PosePackJob) {
+  ozz::math::Float4x4 input[2];
+  float output[24];
+  uint16_t half_output[24];
+
+  {  // Default is invalid.
+    PosePackJob job;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+  {  // Valid with float output.
+    PosePackJob job;
+    job.input = input;
+    job.output = output;
+    EXPECT_TRUE(job.Validate());
+  }
+  {  // Valid with half output only.
+    PosePackJob job;
+    job.input = input;
+    job.half_output = half_output;
+    EXPECT_TRUE(job.Validate());
+  }
+  {  // Valid with both outputs.
+    PosePackJob job;
+    job.input = input;
+    job.output = output;
+    job.half_output = half_output;
+    EXPECT_TRUE(job.Validate());
+  }
+  {  // Invalid with no output.
+    PosePackJob job;
+    job.input = input;
+    EXPECT_FALSE(job.Validate());
+  }
+  {  // Invalid with an empty input.
+    PosePackJob job;
+    job.output = output;
+    EXPECT_FALSE(job.Validate());
+  }
+  {  // Invalid with a too small output.
+    PosePackJob job;
+    job.input = input;
+    job.output = {output, 23};
+    EXPECT_FALSE(job.Validate());
+  }
+  {  // Invalid with a too small half output.
+    PosePackJob job;
+    job.input = input;
+    job.half_output = {half_output, 23};
+    EXPECT_FALSE(job.Validate());
+  }
+}
+
+TEST(JobResult, PosePackJob) {
+  // Translation and scale matrices have a predictable packed form.
+  ozz::math::Float4x4 input[2];
+  input[0] = ozz::math::Float4x4::Translation(
+      ozz::math::simd_float4::Load(1.f, 2.f, 3.f, 0.f));
+  input[1] = ozz::math::Float4x4::Scaling(
+      ozz::math::simd_float4::Load(2.f, 4.f, 8.f, 0.f));
+
+  float output[24];
+  uint16_t half_output[24];
+
+  PosePackJob job;
+  job.input = input;
+  job.output = output;
+  job.half_output = half_output;
+  ASSERT_TRUE(job.Run());
+
+  // Transposed translation matrix rows.
+  const float expected[24] = {1.f, 0.f, 0.f, 1.f,  //
+                              0.f, 1.f, 0.f, 2.f,  //
+                              0.f, 0.f, 1.f, 3.f,  //
+                              2.f, 0.f, 0.f, 0.f,  //
+                              0.f, 4.f, 0.f, 0.f,  //
+                              0.f, 0.f, 8.f, 0.f};
+  for (int i = 0; i < 24; ++i) {
+    EXPECT_FLOAT_EQ(output[i], expected[i]);
+
+    // All expected values are exactly representable as half floats.
+    EXPECT_FLOAT_EQ(ozz::math::HalfToFloat(half_output[i]), expected[i]);
+  }
+}
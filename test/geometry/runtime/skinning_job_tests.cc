@@ -25,14 +25,18 @@
 //                                                                            //
 //----------------------------------------------------------------------------//
 
+#include <cstring>
+
 #include "gtest/gtest.h"
 #include "ozz/base/containers/vector.h"
 #include "ozz/base/log.h"
 #include "ozz/base/maths/gtest_math_helper.h"
+#include "ozz/base/maths/math_constant.h"
 #include "ozz/base/maths/simd_math.h"
 #include "ozz/geometry/runtime/skinning_job.h"
 
 using ozz::geometry::SkinningJob;
+using ozz::geometry::ToDualQuaternions;
 
 TEST(JobValidity, SkinningJob) {
   ozz::math::Float4x4 matrices[2];
@@ -1198,3 +1202,361 @@ TEST(Benchmark, SkinningJob) {
     }
   }
 }
+
+TEST(Split, SkinningJob) {
+  const int vertex_count = 97;  // Doesn't divide evenly.
+  const int joint_count = 16;
+
+  // Prepares matrices, translated so output depends on joint indices.
+  ozz::vector<ozz::math::Float4x4> matrices(joint_count);
+  for (int i = 0; i < joint_count; ++i) {
+    matrices[i] = ozz::math::Float4x4::Translation(
+        ozz::math::simd_float4::Load(1.f * i, 2.f * i, 3.f * i, 0.f));
+  }
+
+  // Prepares vertices.
+  ozz::vector<BenchVertexIn> in_vertices(vertex_count + 1);
+  for (int i = 0; i < vertex_count; ++i) {
+    BenchVertexIn& vertex = in_vertices[i];
+    for (size_t j = 0; j < OZZ_ARRAY_SIZE(vertex.indices); ++j) {
+      vertex.indices[j] = (i + j) % joint_count;
+    }
+    for (size_t j = 0; j < OZZ_ARRAY_SIZE(vertex.weights); ++j) {
+      vertex.weights[j] = 1.f / OZZ_ARRAY_SIZE(vertex.weights);
+    }
+    for (int j = 0; j < 3; ++j) {
+      vertex.pos[j] = 1.f * i + j;
+      vertex.normals[j] = .1f * i + j;
+      vertex.tangents[j] = .2f * i + j;
+    }
+  }
+  ozz::vector<BenchVertexOut> ref_vertices(vertex_count + 1);
+  ozz::vector<BenchVertexOut> out_vertices(vertex_count + 1);
+
+  const float* in_vertices_end =
+      reinterpret_cast<const float*>(array_end(in_vertices));
+
+  SkinningJob job;
+  job.vertex_count = vertex_count;
+  job.influences_count = 4;
+  job.joint_matrices = make_span(matrices);
+  job.joint_indices = {in_vertices.data()->indices,
+                       reinterpret_cast<const uint16_t*>(in_vertices_end)};
+  job.joint_indices_stride = sizeof(BenchVertexIn);
+  job.joint_weights = {in_vertices.data()->weights, in_vertices_end};
+  job.joint_weights_stride = sizeof(BenchVertexIn);
+  job.in_positions = {in_vertices.data()->pos, in_vertices_end};
+  job.in_positions_stride = sizeof(BenchVertexIn);
+  job.in_normals = {in_vertices.data()->normals, in_vertices_end};
+  job.in_normals_stride = sizeof(BenchVertexIn);
+  job.in_tangents = {in_vertices.data()->tangents, in_vertices_end};
+  job.in_tangents_stride = sizeof(BenchVertexIn);
+
+  // Reference output, processed as a single job.
+  job.out_positions = {ref_vertices.data()->pos,
+                       reinterpret_cast<float*>(array_end(ref_vertices))};
+  job.out_positions_stride = sizeof(BenchVertexOut);
+  job.out_normals = {ref_vertices.data()->normals,
+                     reinterpret_cast<float*>(array_end(ref_vertices))};
+  job.out_normals_stride = sizeof(BenchVertexOut);
+  job.out_tangents = {ref_vertices.data()->tangents,
+                      reinterpret_cast<float*>(array_end(ref_vertices))};
+  job.out_tangents_stride = sizeof(BenchVertexOut);
+  ASSERT_TRUE(job.Run());
+
+  {  // Splitting an invalid job fails.
+    SkinningJob invalid;
+    SkinningJob sub_jobs[2];
+    EXPECT_FALSE(invalid.Split(ozz::make_span(sub_jobs)));
+  }
+
+  {  // Splitting to no sub job fails.
+    EXPECT_FALSE(job.Split({}));
+  }
+
+  // Splits and runs with various sub job counts, vertex_count included so
+  // some sub jobs get an empty range.
+  const size_t counts[] = {1, 2, 3, 7, vertex_count, vertex_count + 3};
+  for (size_t count : counts) {
+    // Redirects outputs to the buffer being tested.
+    job.out_positions = {out_vertices.data()->pos,
+                         reinterpret_cast<float*>(array_end(out_vertices))};
+    job.out_normals = {out_vertices.data()->normals,
+                       reinterpret_cast<float*>(array_end(out_vertices))};
+    job.out_tangents = {out_vertices.data()->tangents,
+                        reinterpret_cast<float*>(array_end(out_vertices))};
+
+    ozz::vector<SkinningJob> sub_jobs(count);
+    ASSERT_TRUE(job.Split(make_span(sub_jobs)));
+
+    // Sub jobs cover all vertices, once each.
+    int total = 0;
+    for (const SkinningJob& sub_job : sub_jobs) {
+      EXPECT_EQ(sub_job.influences_count, job.influences_count);
+      total += sub_job.vertex_count;
+      EXPECT_TRUE(sub_job.Run());
+    }
+    EXPECT_EQ(total, vertex_count);
+
+    // Outputs match the single job reference.
+    for (int i = 0; i < vertex_count; ++i) {
+      for (int j = 0; j < 3; ++j) {
+        EXPECT_FLOAT_EQ(out_vertices[i].pos[j], ref_vertices[i].pos[j]);
+        EXPECT_FLOAT_EQ(out_vertices[i].normals[j], ref_vertices[i].normals[j]);
+        EXPECT_FLOAT_EQ(out_vertices[i].tangents[j],
+                        ref_vertices[i].tangents[j]);
+      }
+    }
+  }
+}
+
+TEST(DualQuaternion, SkinningJob) {
+  // Rigid joint transformations (rotation and translation only), as required
+  // by dual quaternion skinning.
+  const ozz::math::Float4x4 matrices[3] = {
+      ozz::math::Float4x4::Translation(
+          ozz::math::simd_float4::Load(1.f, 2.f, 3.f, 0.f)),
+      ozz::math::Float4x4::FromAxisAngle(
+          ozz::math::simd_float4::x_axis(),
+          ozz::math::simd_float4::Load1(ozz::math::kPi_2)),
+      ozz::math::Float4x4::identity()};
+  SkinningJob::DualQuaternion dual_quaternions[3];
+
+  {  // Mismatching output size fails.
+    EXPECT_FALSE(ToDualQuaternions(ozz::make_span(matrices),
+                                   {dual_quaternions, 2}));
+  }
+  ASSERT_TRUE(ToDualQuaternions(ozz::make_span(matrices),
+                                ozz::make_span(dual_quaternions)));
+
+  uint16_t joint_indices[4] = {0, 0, 1, 0};
+  float joint_weights[2] = {.5f, .5f};
+  float blend_factors[2] = {0.f, 0.f};
+  const float in_positions[6] = {1.f, 2.f, 3.f, 0.f, 1.f, 0.f};
+  const float in_normals[6] = {0.f, 1.f, 0.f, 0.f, 0.f, 1.f};
+  float out_positions[6];
+  float out_normals[6];
+
+  SkinningJob base_job;
+  base_job.vertex_count = 2;
+  base_job.influences_count = 1;
+  base_job.joint_matrices = matrices;
+  base_job.joint_indices = {joint_indices, 2};
+  base_job.joint_indices_stride = sizeof(uint16_t) * 1;
+  base_job.in_positions = in_positions;
+  base_job.in_positions_stride = sizeof(float) * 3;
+  base_job.out_positions = out_positions;
+  base_job.out_positions_stride = sizeof(float) * 3;
+
+  {  // Mismatching dual quaternions and matrices palette sizes is invalid.
+    SkinningJob job = base_job;
+    job.joint_dual_quaternions = {dual_quaternions, 2};
+    EXPECT_FALSE(job.Validate());
+  }
+  {  // Blend factors without dual quaternions is invalid.
+    SkinningJob job = base_job;
+    job.blend_factors = blend_factors;
+    job.blend_factors_stride = sizeof(float);
+    EXPECT_FALSE(job.Validate());
+  }
+  {  // P1, dual quaternion and matrix paths transform rigidly the same.
+    uint16_t indices[2] = {0, 1};
+    SkinningJob job = base_job;
+    job.joint_indices = {indices, 2};
+    job.joint_dual_quaternions = dual_quaternions;
+    EXPECT_TRUE(job.Run());
+
+    // Vertex 0, translation joint.
+    EXPECT_NEAR(2.f, out_positions[0], 1e-3f);
+    EXPECT_NEAR(4.f, out_positions[1], 1e-3f);
+    EXPECT_NEAR(6.f, out_positions[2], 1e-3f);
+
+    // Vertex 1, rotation joint, 90 degrees around x.
+    EXPECT_NEAR(0.f, out_positions[3], 1e-3f);
+    EXPECT_NEAR(0.f, out_positions[4], 1e-3f);
+    EXPECT_NEAR(1.f, out_positions[5], 1e-3f);
+  }
+  {  // PN1, normals are rotated by the dual quaternion rotation part.
+    uint16_t indices[2] = {1, 1};
+    SkinningJob job = base_job;
+    job.joint_indices = {indices, 2};
+    job.joint_dual_quaternions = dual_quaternions;
+    job.in_normals = in_normals;
+    job.in_normals_stride = sizeof(float) * 3;
+    job.out_normals = out_normals;
+    job.out_normals_stride = sizeof(float) * 3;
+    EXPECT_TRUE(job.Run());
+
+    EXPECT_NEAR(0.f, out_normals[0], 1e-3f);
+    EXPECT_NEAR(0.f, out_normals[1], 1e-3f);
+    EXPECT_NEAR(1.f, out_normals[2], 1e-3f);
+    EXPECT_NEAR(0.f, out_normals[3], 1e-3f);
+    EXPECT_NEAR(-1.f, out_normals[4], 1e-3f);
+    EXPECT_NEAR(0.f, out_normals[5], 1e-3f);
+  }
+
+  // Half-weight blend of identity and 90 degrees rotation joints, the candy
+  // wrapper case. Vertex 1 is at (0, 1, 0).
+  uint16_t twist_indices[4] = {2, 2, 2, 1};
+  SkinningJob twist_job = base_job;
+  twist_job.influences_count = 2;
+  twist_job.joint_indices = {twist_indices, 4};
+  twist_job.joint_indices_stride = sizeof(uint16_t) * 2;
+  twist_job.joint_weights = {joint_weights, 2};
+  twist_job.joint_weights_stride = sizeof(float);
+  twist_job.joint_dual_quaternions = dual_quaternions;
+
+  {  // P2, dual quaternions interpolate the rotation (45 degrees), where
+     // linear blending would collapse the vertex towards the rotation axis.
+    SkinningJob job = twist_job;
+    EXPECT_TRUE(job.Run());
+
+    const float kSqrt2_2 = .70710678f;
+    EXPECT_NEAR(0.f, out_positions[3], 1e-3f);
+    EXPECT_NEAR(kSqrt2_2, out_positions[4], 1e-3f);
+    EXPECT_NEAR(kSqrt2_2, out_positions[5], 1e-3f);
+  }
+  {  // P2 with a 0 blend factor, the linear blend result is restored.
+    float ref_positions[6];
+    SkinningJob lbs_job = twist_job;
+    lbs_job.joint_dual_quaternions = {};
+    lbs_job.out_positions = ref_positions;
+    EXPECT_TRUE(lbs_job.Run());
+
+    SkinningJob job = twist_job;
+    job.blend_factors = blend_factors;
+    job.blend_factors_stride = sizeof(float);
+    EXPECT_TRUE(job.Run());
+
+    for (size_t i = 0; i < OZZ_ARRAY_SIZE(out_positions); ++i) {
+      EXPECT_FLOAT_EQ(ref_positions[i], out_positions[i]);
+    }
+  }
+  {  // P2 with a 1 blend factor, the dual quaternion result is restored.
+    float blend_ones[2] = {1.f, 1.f};
+    SkinningJob job = twist_job;
+    job.blend_factors = blend_ones;
+    job.blend_factors_stride = sizeof(float);
+    EXPECT_TRUE(job.Run());
+
+    const float kSqrt2_2 = .70710678f;
+    EXPECT_NEAR(0.f, out_positions[3], 1e-3f);
+    EXPECT_NEAR(kSqrt2_2, out_positions[4], 1e-3f);
+    EXPECT_NEAR(kSqrt2_2, out_positions[5], 1e-3f);
+  }
+}
+
+TEST(StreamingStores, SkinningJob) {
+  const int vertex_count = 53;
+  const int joint_count = 16;
+
+  // Prepares matrices, translated and rotated so all output components are
+  // exercised.
+  ozz::vector<ozz::math::Float4x4> matrices(joint_count);
+  for (int i = 0; i < joint_count; ++i) {
+    matrices[i] = ozz::math::Float4x4::Translation(
+                      ozz::math::simd_float4::Load(1.f * i, 2.f * i, 3.f * i,
+                                                   0.f)) *
+                  ozz::math::Float4x4::FromAxisAngle(
+                      ozz::math::simd_float4::y_axis(),
+                      ozz::math::simd_float4::Load1(.1f * i));
+  }
+  ozz::vector<SkinningJob::DualQuaternion> dual_quaternions(joint_count);
+  ASSERT_TRUE(ToDualQuaternions(make_span(matrices),
+                                make_span(dual_quaternions)));
+
+  // Prepares vertices.
+  ozz::vector<BenchVertexIn> in_vertices(vertex_count + 1);
+  for (int i = 0; i < vertex_count; ++i) {
+    BenchVertexIn& vertex = in_vertices[i];
+    for (size_t j = 0; j < OZZ_ARRAY_SIZE(vertex.indices); ++j) {
+      vertex.indices[j] = (i + j) % joint_count;
+    }
+    for (size_t j = 0; j < OZZ_ARRAY_SIZE(vertex.weights); ++j) {
+      vertex.weights[j] = 1.f / OZZ_ARRAY_SIZE(vertex.weights);
+    }
+    for (int j = 0; j < 3; ++j) {
+      vertex.pos[j] = 1.f * i + j;
+      vertex.normals[j] = .1f * i + j;
+      vertex.tangents[j] = .2f * i + j;
+    }
+  }
+  ozz::vector<BenchVertexOut> ref_vertices(vertex_count + 1);
+  ozz::vector<BenchVertexOut> out_vertices(vertex_count + 1);
+
+  const float* in_vertices_end =
+      reinterpret_cast<const float*>(array_end(in_vertices));
+
+  SkinningJob base_job;
+  base_job.vertex_count = vertex_count;
+  base_job.joint_matrices = make_span(matrices);
+  base_job.joint_indices = {in_vertices.data()->indices,
+                            reinterpret_cast<const uint16_t*>(in_vertices_end)};
+  base_job.joint_indices_stride = sizeof(BenchVertexIn);
+  base_job.joint_weights = {in_vertices.data()->weights, in_vertices_end};
+  base_job.joint_weights_stride = sizeof(BenchVertexIn);
+  base_job.in_positions = {in_vertices.data()->pos, in_vertices_end};
+  base_job.in_positions_stride = sizeof(BenchVertexIn);
+  base_job.in_normals = {in_vertices.data()->normals, in_vertices_end};
+  base_job.in_normals_stride = sizeof(BenchVertexIn);
+  base_job.in_tangents = {in_vertices.data()->tangents, in_vertices_end};
+  base_job.in_tangents_stride = sizeof(BenchVertexIn);
+  base_job.out_positions_stride = sizeof(BenchVertexOut);
+  base_job.out_normals_stride = sizeof(BenchVertexOut);
+  base_job.out_tangents_stride = sizeof(BenchVertexOut);
+
+  // Streaming stores must produce bit-equal outputs, across every code path:
+  // influences count, inverse transpose matrices and dual quaternions.
+  for (int i = 1; i <= 5; ++i) {
+    for (int variant = 0; variant < 3; ++variant) {
+      SkinningJob job = base_job;
+      job.influences_count = i;
+      if (variant == 1) {
+        job.joint_inverse_transpose_matrices = make_span(matrices);
+      } else if (variant == 2) {
+        job.joint_dual_quaternions = make_span(dual_quaternions);
+      }
+
+      // Reference output, with regular stores.
+      job.out_positions = {ref_vertices.data()->pos,
+                           reinterpret_cast<float*>(array_end(ref_vertices))};
+      job.out_normals = {ref_vertices.data()->normals,
+                         reinterpret_cast<float*>(array_end(ref_vertices))};
+      job.out_tangents = {ref_vertices.data()->tangents,
+                          reinterpret_cast<float*>(array_end(ref_vertices))};
+      ASSERT_TRUE(job.Run());
+
+      // Streaming stores output.
+      job.streaming_stores = true;
+      job.out_positions = {out_vertices.data()->pos,
+                           reinterpret_cast<float*>(array_end(out_vertices))};
+      job.out_normals = {out_vertices.data()->normals,
+                         reinterpret_cast<float*>(array_end(out_vertices))};
+      job.out_tangents = {out_vertices.data()->tangents,
+                          reinterpret_cast<float*>(array_end(out_vertices))};
+      ASSERT_TRUE(job.Run());
+
+      EXPECT_EQ(
+          std::memcmp(out_vertices.data(), ref_vertices.data(),
+                      sizeof(BenchVertexOut) * vertex_count),
+          0);
+    }
+  }
+
+  {  // The flag propagates to split sub jobs.
+    SkinningJob job = base_job;
+    job.influences_count = 4;
+    job.streaming_stores = true;
+    job.out_positions = {out_vertices.data()->pos,
+                         reinterpret_cast<float*>(array_end(out_vertices))};
+    job.out_normals = {out_vertices.data()->normals,
+                       reinterpret_cast<float*>(array_end(out_vertices))};
+    job.out_tangents = {out_vertices.data()->tangents,
+                        reinterpret_cast<float*>(array_end(out_vertices))};
+    SkinningJob sub_jobs[3];
+    ASSERT_TRUE(job.Split(ozz::make_span(sub_jobs)));
+    for (const SkinningJob& sub_job : sub_jobs) {
+      EXPECT_TRUE(sub_job.streaming_stores);
+    }
+  }
+}
@@ -0,0 +1,271 @@
+//----------------------------------------------------------------------------//
+//                                                                            //
+// ozz-animation is hosted at http://github.com/guillaumeblanc/ozz-animation  //
+// and distributed under the MIT License (MIT).                               //
+//                                                                            //
+// Copyright (c) Guillaume Blanc                                              //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// all copies or substantial portions of the Software.                        //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#include "ozz/geometry/runtime/vertex_format_job.h"
+
+#include "gtest/gtest.h"
+#include "ozz/base/containers/vector.h"
+#include "ozz/base/maths/simd_math.h"
+
+using ozz::byte;
+using ozz::geometry::ConvertSkinningJob;
+using ozz::geometry::PackVerticesJob;
+using ozz::geometry::SkinningJob;
+using ozz::geometry::UnpackVerticesJob;
+using ozz::geometry::VertexFormat;
+using ozz::geometry::VertexFormatSize;
+
+TEST(FormatSize, VertexFormatJob) {
+  EXPECT_EQ(VertexFormatSize(VertexFormat::kFloat3), 12u);
+  EXPECT_EQ(VertexFormatSize(VertexFormat::kHalf4), 8u);
+  EXPECT_EQ(VertexFormatSize(VertexFormat::kSnorm16x4), 8u);
+  EXPECT_EQ(VertexFormatSize(VertexFormat::kSnorm10_10_10_2), 4u);
+}
+
+TEST(Validity, VertexFormatJob) {
+  float floats[6] = {};
+  byte packed[8] = {};
+
+  {  // Default job is invalid (null strides).
+    UnpackVerticesJob job;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+  }
+
+  {  // Valid unpack setup.
+    UnpackVerticesJob job;
+    job.vertex_count = 1;
+    job.format = VertexFormat::kSnorm10_10_10_2;
+    job.input = {packed, 4};
+    job.input_stride = 4;
+    job.output = {floats, 3};
+    job.output_stride = 12;
+    EXPECT_TRUE(job.Validate());
+
+    // Input too small for vertex count.
+    job.vertex_count = 3;
+    EXPECT_FALSE(job.Validate());
+    EXPECT_FALSE(job.Run());
+
+    // Stride smaller than the format size.
+    job.vertex_count = 1;
+    job.input_stride = 2;
+    EXPECT_FALSE(job.Validate());
+  }
+
+  {  // Pack output too small.
+    PackVerticesJob job;
+    job.vertex_count = 1;
+    job.format = VertexFormat::kHalf4;
+    job.input = {floats, 3};
+    job.input_stride = 12;
+    job.output = {packed, 4};
+    job.output_stride = 8;
+    EXPECT_FALSE(job.Validate());
+    job.output = {packed, 8};
+    EXPECT_TRUE(job.Validate());
+  }
+}
+
+TEST(RoundTrip, VertexFormatJob) {
+  const float values[4 * 3] = {0.f,   1.f,  -1.f,  //
+                               .5f,   -.25f, .75f,  //
+                               -.5f,  .125f, 1.f,   //
+                               .875f, -1.f,  0.f};
+  const VertexFormat::Value formats[] = {
+      VertexFormat::kFloat3, VertexFormat::kHalf4, VertexFormat::kSnorm16x4,
+      VertexFormat::kSnorm10_10_10_2};
+  const float tolerances[] = {0.f, 1e-3f, 1e-4f, 2e-3f};
+
+  for (size_t f = 0; f < OZZ_ARRAY_SIZE(formats); ++f) {
+    byte packed[4 * 12] = {};
+    float unpacked[4 * 3] = {};
+
+    PackVerticesJob pack;
+    pack.vertex_count = 4;
+    pack.format = formats[f];
+    pack.input = values;
+    pack.input_stride = 12;
+    pack.output = packed;
+    pack.output_stride = VertexFormatSize(formats[f]);
+    ASSERT_TRUE(pack.Run());
+
+    UnpackVerticesJob unpack;
+    unpack.vertex_count = 4;
+    unpack.format = formats[f];
+    unpack.input = packed;
+    unpack.input_stride = VertexFormatSize(formats[f]);
+    unpack.output = unpacked;
+    unpack.output_stride = 12;
+    ASSERT_TRUE(unpack.Run());
+
+    for (size_t i = 0; i < OZZ_ARRAY_SIZE(values); ++i) {
+      EXPECT_NEAR(unpacked[i], values[i], tolerances[f]) << "format " << f;
+    }
+  }
+}
+
+TEST(ConvertSkin, VertexFormatJob) {
+  // 100 vertices crosses the internal block size, exercising block offsets.
+  const int vertex_count = 100;
+
+  // Packed positions (half4) and normals (10_10_10_2), built from a
+  // procedural float mesh.
+  ozz::vector<float> positions(vertex_count * 3);
+  ozz::vector<float> normals(vertex_count * 3);
+  for (int i = 0; i < vertex_count; ++i) {
+    positions[i * 3 + 0] = static_cast<float>(i) * .25f;
+    positions[i * 3 + 1] = static_cast<float>(i % 7) - 3.f;
+    positions[i * 3 + 2] = -static_cast<float>(i) * .125f;
+    normals[i * 3 + 0] = (i & 1) ? 1.f : 0.f;
+    normals[i * 3 + 1] = (i & 1) ? 0.f : -1.f;
+    normals[i * 3 + 2] = 0.f;
+  }
+  ozz::vector<byte> packed_positions(vertex_count * 8);
+  ozz::vector<byte> packed_normals(vertex_count * 4);
+  {
+    PackVerticesJob pack;
+    pack.vertex_count = vertex_count;
+    pack.format = VertexFormat::kHalf4;
+    pack.input = ozz::make_span(positions);
+    pack.input_stride = 12;
+    pack.output = ozz::make_span(packed_positions);
+    pack.output_stride = 8;
+    ASSERT_TRUE(pack.Run());
+    pack.format = VertexFormat::kSnorm10_10_10_2;
+    pack.input = ozz::make_span(normals);
+    pack.output = ozz::make_span(packed_normals);
+    pack.output_stride = 4;
+    ASSERT_TRUE(pack.Run());
+  }
+
+  // Single joint, translated.
+  const ozz::math::Float4x4 matrices[1] = {ozz::math::Float4x4::Translation(
+      ozz::math::simd_float4::Load(1.f, 2.f, 3.f, 0.f))};
+  ozz::vector<uint16_t> indices(vertex_count, 0);
+
+  ConvertSkinningJob job;
+  job.skinning.vertex_count = vertex_count;
+  job.skinning.influences_count = 1;
+  job.skinning.joint_matrices = matrices;
+  job.skinning.joint_indices = ozz::make_span(indices);
+  job.skinning.joint_indices_stride = sizeof(uint16_t);
+  job.in_positions_format = VertexFormat::kHalf4;
+  job.in_positions = ozz::make_span(packed_positions);
+  job.in_positions_stride = 8;
+  job.in_normals_format = VertexFormat::kSnorm10_10_10_2;
+  job.in_normals = ozz::make_span(packed_normals);
+  job.in_normals_stride = 4;
+  ozz::vector<byte> out_positions(vertex_count * 8);
+  ozz::vector<byte> out_normals(vertex_count * 4);
+  job.out_positions_format = VertexFormat::kHalf4;
+  job.out_positions = ozz::make_span(out_positions);
+  job.out_positions_stride = 8;
+  job.out_normals_format = VertexFormat::kSnorm10_10_10_2;
+  job.out_normals = ozz::make_span(out_normals);
+  job.out_normals_stride = 4;
+
+  {  // Feeding skinning vertex streams directly is rejected.
+    ConvertSkinningJob invalid = job;
+    invalid.skinning.in_positions = ozz::make_span(positions);
+    invalid.skinning.in_positions_stride = 12;
+    EXPECT_FALSE(invalid.Validate());
+  }
+
+  {  // Normals input without output is rejected.
+    ConvertSkinningJob invalid = job;
+    invalid.out_normals = {};
+    EXPECT_FALSE(invalid.Validate());
+  }
+
+  ASSERT_TRUE(job.Validate());
+  ASSERT_TRUE(job.Run());
+
+  // Reference path: unpack, skin and repack whole-mesh float streams.
+  ozz::vector<float> ref_out_positions(vertex_count * 3);
+  ozz::vector<float> ref_out_normals(vertex_count * 3);
+  {
+    SkinningJob skin;
+    skin.vertex_count = vertex_count;
+    skin.influences_count = 1;
+    skin.joint_matrices = matrices;
+    skin.joint_indices = ozz::make_span(indices);
+    skin.joint_indices_stride = sizeof(uint16_t);
+    // Unpacks from the packed streams, so quantization matches the fused
+    // path.
+    ozz::vector<float> in_pos(vertex_count * 3);
+    ozz::vector<float> in_nrm(vertex_count * 3);
+    UnpackVerticesJob unpack;
+    unpack.vertex_count = vertex_count;
+    unpack.format = VertexFormat::kHalf4;
+    unpack.input = ozz::make_span(packed_positions);
+    unpack.input_stride = 8;
+    unpack.output = ozz::make_span(in_pos);
+    unpack.output_stride = 12;
+    ASSERT_TRUE(unpack.Run());
+    unpack.format = VertexFormat::kSnorm10_10_10_2;
+    unpack.input = ozz::make_span(packed_normals);
+    unpack.input_stride = 4;
+    unpack.output = ozz::make_span(in_nrm);
+    ASSERT_TRUE(unpack.Run());
+    skin.in_positions = ozz::make_span(in_pos);
+    skin.in_positions_stride = 12;
+    skin.in_normals = ozz::make_span(in_nrm);
+    skin.in_normals_stride = 12;
+    skin.out_positions = ozz::make_span(ref_out_positions);
+    skin.out_positions_stride = 12;
+    skin.out_normals = ozz::make_span(ref_out_normals);
+    skin.out_normals_stride = 12;
+    ASSERT_TRUE(skin.Run());
+  }
+  ozz::vector<byte> ref_packed_positions(vertex_count * 8);
+  ozz::vector<byte> ref_packed_normals(vertex_count * 4);
+  {
+    PackVerticesJob pack;
+    pack.vertex_count = vertex_count;
+    pack.format = VertexFormat::kHalf4;
+    pack.input = ozz::make_span(ref_out_positions);
+    pack.input_stride = 12;
+    pack.output = ozz::make_span(ref_packed_positions);
+    pack.output_stride = 8;
+    ASSERT_TRUE(pack.Run());
+    pack.format = VertexFormat::kSnorm10_10_10_2;
+    pack.input = ozz::make_span(ref_out_normals);
+    pack.output = ozz::make_span(ref_packed_normals);
+    pack.output_stride = 4;
+    ASSERT_TRUE(pack.Run());
+  }
+
+  // The fused path produces bit identical packed outputs.
+  EXPECT_EQ(
+      memcmp(out_positions.data(), ref_packed_positions.data(),
+             out_positions.size()),
+      0);
+  EXPECT_EQ(
+      memcmp(out_normals.data(), ref_packed_normals.data(), out_normals.size()),
+      0);
+}